@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// Standard circuits, simulated with the NVQIR backend this benchmark is linked
+// against. The largest number of qubits is set per backend by
+// `CUDAQ_BENCHMARK_MAX_QUBITS`.
+
+#include <benchmark/benchmark.h>
+#include <cudaq.h>
+#include <cudaq/algorithm.h>
+#ifndef CUDAQ_BACKEND_STIM
+#include "cudaq/domains/chemistry/uccsd.h"
+#endif
+#include <random>
+
+namespace {
+
+#ifndef CUDAQ_BACKEND_STIM
+struct qft {
+  void operator()(std::size_t numQubits) __qpu__ {
+    cudaq::qvector q(numQubits);
+    x(q[0]);
+    for (std::size_t i = 0; i < numQubits; ++i) {
+      h(q[i]);
+      for (std::size_t j = i + 1; j < numQubits; ++j)
+        r1<cudaq::ctrl>(M_PI / (1ULL << (j - i)), q[j], q[i]);
+    }
+  }
+};
+
+/// Layers of random single-qubit rotations followed by a brick-wall of CNOTs.
+struct random_circuit {
+  void operator()(std::size_t numQubits,
+                  const std::vector<double> &angles) __qpu__ {
+    cudaq::qvector q(numQubits);
+    const std::size_t numLayers = angles.size() / (3 * numQubits);
+    for (std::size_t layer = 0; layer < numLayers; ++layer) {
+      const auto *theta = angles.data() + 3 * numQubits * layer;
+      for (std::size_t i = 0; i < numQubits; ++i) {
+        rx(theta[3 * i], q[i]);
+        ry(theta[3 * i + 1], q[i]);
+        rz(theta[3 * i + 2], q[i]);
+      }
+      for (std::size_t i = layer % 2; i + 1 < numQubits; i += 2)
+        x<cudaq::ctrl>(q[i], q[i + 1]);
+    }
+  }
+};
+
+/// QAOA for max-cut on a ring.
+struct qaoa_ring {
+  void operator()(std::size_t numQubits, const std::vector<double> &gammas,
+                  const std::vector<double> &betas) __qpu__ {
+    cudaq::qvector q(numQubits);
+    h(q);
+    for (std::size_t layer = 0; layer < gammas.size(); ++layer) {
+      for (std::size_t i = 0; i < numQubits; ++i) {
+        auto j = (i + 1) % numQubits;
+        x<cudaq::ctrl>(q[i], q[j]);
+        rz(2.0 * gammas[layer], q[j]);
+        x<cudaq::ctrl>(q[i], q[j]);
+      }
+      for (std::size_t i = 0; i < numQubits; ++i)
+        rx(2.0 * betas[layer], q[i]);
+    }
+    mz(q);
+  }
+};
+
+struct uccsd_ansatz {
+  void operator()(std::size_t numQubits, std::size_t numElectrons,
+                  const std::vector<double> &thetas) __qpu__ {
+    cudaq::qvector q(numQubits);
+    for (std::size_t i = 0; i < numElectrons; ++i)
+      x(q[i]);
+    cudaq::uccsd(q, thetas, numElectrons);
+  }
+};
+#endif
+
+/// Layers of random Clifford gates followed by a brick-wall of CNOTs.
+struct random_clifford {
+  void operator()(std::size_t numQubits,
+                  const std::vector<int> &gates) __qpu__ {
+    cudaq::qvector q(numQubits);
+    const std::size_t numLayers = gates.size() / numQubits;
+    for (std::size_t layer = 0; layer < numLayers; ++layer) {
+      for (std::size_t i = 0; i < numQubits; ++i) {
+        switch (gates[layer * numQubits + i]) {
+        case 0:
+          h(q[i]);
+          break;
+        case 1:
+          s(q[i]);
+          break;
+        default:
+          x(q[i]);
+        }
+      }
+      for (std::size_t i = layer % 2; i + 1 < numQubits; i += 2)
+        x<cudaq::ctrl>(q[i], q[i + 1]);
+    }
+    mz(q);
+  }
+};
+
+#ifndef CUDAQ_BACKEND_STIM
+std::vector<double> randomAngles(std::size_t count) {
+  std::mt19937 gen(13);
+  std::uniform_real_distribution<double> dist(-M_PI, M_PI);
+  std::vector<double> angles(count);
+  for (auto &angle : angles)
+    angle = dist(gen);
+  return angles;
+}
+
+void BM_QftState(benchmark::State &state) {
+  const std::size_t numQubits = state.range(0);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(cudaq::get_state(qft{}, numQubits));
+}
+BENCHMARK(BM_QftState)
+    ->RangeMultiplier(2)
+    ->Range(4, CUDAQ_BENCHMARK_MAX_QUBITS)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_RandomCircuitState(benchmark::State &state) {
+  const std::size_t numQubits = state.range(0);
+  const std::size_t numLayers = state.range(1);
+  const auto angles = randomAngles(3 * numQubits * numLayers);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        cudaq::get_state(random_circuit{}, numQubits, angles));
+  state.counters["gates"] = static_cast<double>(4 * numQubits * numLayers);
+}
+BENCHMARK(BM_RandomCircuitState)
+    ->ArgsProduct(
+        {benchmark::CreateRange(4, CUDAQ_BENCHMARK_MAX_QUBITS, 2), {10}})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_QaoaSample(benchmark::State &state) {
+  const std::size_t numQubits = state.range(0);
+  const std::size_t numLayers = 4;
+  const auto gammas = randomAngles(numLayers);
+  const auto betas = randomAngles(numLayers);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        cudaq::sample(1000, qaoa_ring{}, numQubits, gammas, betas));
+}
+BENCHMARK(BM_QaoaSample)
+    ->RangeMultiplier(2)
+    ->Range(4, CUDAQ_BENCHMARK_MAX_QUBITS)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_UccsdObserve(benchmark::State &state) {
+  const std::size_t numQubits = state.range(0);
+  const std::size_t numElectrons = numQubits / 2;
+  const auto thetas =
+      randomAngles(cudaq::uccsd_num_parameters(numElectrons, numQubits));
+  auto h = cudaq::spin_op::random(numQubits, 4 * numQubits, 13);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(cudaq::observe(uccsd_ansatz{}, h, numQubits,
+                                            numElectrons, thetas)
+                                 .expectation());
+}
+BENCHMARK(BM_UccsdObserve)
+    ->DenseRange(4, std::min(CUDAQ_BENCHMARK_MAX_QUBITS, 12), 4)
+    ->Unit(benchmark::kMillisecond);
+#endif
+
+void BM_RandomCliffordSample(benchmark::State &state) {
+  const std::size_t numQubits = state.range(0);
+  const std::size_t numLayers = 10;
+  std::mt19937 gen(13);
+  std::uniform_int_distribution<int> dist(0, 2);
+  std::vector<int> gates(numQubits * numLayers);
+  for (auto &gate : gates)
+    gate = dist(gen);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        cudaq::sample(1000, random_clifford{}, numQubits, gates));
+}
+BENCHMARK(BM_RandomCliffordSample)
+    ->RangeMultiplier(2)
+    ->Range(4, CUDAQ_BENCHMARK_MAX_QUBITS)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
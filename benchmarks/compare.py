@@ -0,0 +1,63 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+"""
+Compare two JSON outputs of a CUDA-Q benchmark, e.g., of two releases, and list
+the relative change of the time of every benchmark present in both. Exits with
+a non-zero status if any benchmark is slower than the given threshold.
+
+    python3 compare.py baseline.json contender.json --threshold 0.1
+"""
+
+import argparse
+import json
+import sys
+
+_UNITS = {'ns': 1e-9, 'us': 1e-6, 'ms': 1e-3, 's': 1.0}
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    # Keep the mean of repeated runs, if any, and skip the other aggregates.
+    return {
+        b['name']: b['real_time'] * _UNITS[b.get('time_unit', 'ns')]
+        for b in data['benchmarks']
+        if b.get('run_type') != 'aggregate' or b.get('aggregate_name') == 'mean'
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument('baseline')
+    parser.add_argument('contender')
+    parser.add_argument('--threshold',
+                        type=float,
+                        default=0.1,
+                        help='relative slowdown reported as a regression')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+    regressions = 0
+    for name in sorted(baseline.keys() & contender.keys()):
+        change = contender[name] / baseline[name] - 1.0
+        flag = ''
+        if change > args.threshold:
+            flag = '  <-- regression'
+            regressions += 1
+        print(f'{name:60s} {baseline[name]:12.3e}s {contender[name]:12.3e}s '
+              f'{change:+8.1%}{flag}')
+    for name in sorted(baseline.keys() - contender.keys()):
+        print(f'{name:60s} removed')
+    for name in sorted(contender.keys() - baseline.keys()):
+        print(f'{name:60s} added')
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
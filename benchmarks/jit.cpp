@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// Latency of building, JIT compiling and launching a kernel with the kernel
+// builder.
+
+#include <benchmark/benchmark.h>
+#include <cudaq.h>
+#include <cudaq/algorithm.h>
+#include <cudaq/builder.h>
+
+namespace {
+
+void BM_BuilderJitAndLaunch(benchmark::State &state) {
+  const std::size_t numQubits = state.range(0);
+  for (auto _ : state) {
+    auto [kernel, theta] = cudaq::make_kernel<double>();
+    auto q = kernel.qalloc(numQubits);
+    kernel.h(q[0]);
+    for (std::size_t i = 0; i + 1 < numQubits; ++i) {
+      kernel.ry(theta, q[i + 1]);
+      kernel.x<cudaq::ctrl>(q[i], q[i + 1]);
+    }
+    kernel.mz(q);
+    benchmark::DoNotOptimize(cudaq::sample(1, kernel, 0.5));
+  }
+}
+BENCHMARK(BM_BuilderJitAndLaunch)
+    ->DenseRange(2, 10, 4)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_BuilderLaunch(benchmark::State &state) {
+  const std::size_t numQubits = state.range(0);
+  auto [kernel, theta] = cudaq::make_kernel<double>();
+  auto q = kernel.qalloc(numQubits);
+  kernel.h(q[0]);
+  for (std::size_t i = 0; i + 1 < numQubits; ++i) {
+    kernel.ry(theta, q[i + 1]);
+    kernel.x<cudaq::ctrl>(q[i], q[i + 1]);
+  }
+  kernel.mz(q);
+  // JIT compile once, outside of the measured loop.
+  cudaq::sample(1, kernel, 0.5);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(cudaq::sample(1, kernel, 0.5));
+}
+BENCHMARK(BM_BuilderLaunch)->DenseRange(2, 10, 4);
+
+} // namespace
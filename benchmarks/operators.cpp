@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// Microbenchmarks of the operator algebra.
+
+#include "cudaq/operators.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void BM_SpinOpAdd(benchmark::State &state) {
+  const std::size_t numQubits = 20;
+  const std::size_t numTerms = state.range(0);
+  auto lhs = cudaq::spin_op::random(numQubits, numTerms, 13);
+  auto rhs = cudaq::spin_op::random(numQubits, numTerms, 17);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(lhs + rhs);
+  state.SetItemsProcessed(state.iterations() * numTerms);
+}
+BENCHMARK(BM_SpinOpAdd)->RangeMultiplier(4)->Range(16, 4096);
+
+void BM_SpinOpMultiply(benchmark::State &state) {
+  const std::size_t numQubits = 20;
+  const std::size_t numTerms = state.range(0);
+  auto lhs = cudaq::spin_op::random(numQubits, numTerms, 13);
+  auto rhs = cudaq::spin_op::random(numQubits, numTerms, 17);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(lhs * rhs);
+  state.SetItemsProcessed(state.iterations() * numTerms * numTerms);
+}
+BENCHMARK(BM_SpinOpMultiply)->RangeMultiplier(4)->Range(4, 256);
+
+void BM_SpinOpAccumulate(benchmark::State &state) {
+  const std::size_t numQubits = 20;
+  const std::size_t numTerms = state.range(0);
+  auto terms = cudaq::spin_op::random(numQubits, numTerms, 13);
+  for (auto _ : state) {
+    auto sum = cudaq::spin_op::empty();
+    for (const auto &term : terms)
+      sum += term;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * numTerms);
+}
+BENCHMARK(BM_SpinOpAccumulate)->RangeMultiplier(4)->Range(16, 4096);
+
+void BM_SpinOpGroupCommuting(benchmark::State &state) {
+  const std::size_t numQubits = 20;
+  const std::size_t numTerms = state.range(0);
+  auto op = cudaq::spin_op::random(numQubits, numTerms, 13);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(op.group_commuting());
+  state.SetItemsProcessed(state.iterations() * numTerms);
+}
+BENCHMARK(BM_SpinOpGroupCommuting)->RangeMultiplier(4)->Range(16, 4096);
+
+void BM_SpinOpToMatrix(benchmark::State &state) {
+  const std::size_t numQubits = state.range(0);
+  auto op = cudaq::spin_op::random(numQubits, 32, 13);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(op.to_sparse_matrix());
+}
+BENCHMARK(BM_SpinOpToMatrix)
+    ->DenseRange(4, 12, 4)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// Microbenchmarks of the assembly of sampling results and of the parsing of
+// output logs.
+
+#include "common/RecordLogParser.h"
+#include "common/SampleResult.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace {
+
+/// Return the counts of `numOutcomes` random outcomes of `numBits` bits.
+cudaq::CountsDictionary randomCounts(std::size_t numBits,
+                                     std::size_t numOutcomes) {
+  std::mt19937 gen(13);
+  std::bernoulli_distribution bit;
+  cudaq::CountsDictionary counts;
+  while (counts.size() < numOutcomes) {
+    std::string bits(numBits, '0');
+    for (auto &b : bits)
+      b = bit(gen) ? '1' : '0';
+    counts[bits] += 1 + gen() % 100;
+  }
+  return counts;
+}
+
+void BM_SampleResultConstruct(benchmark::State &state) {
+  const auto counts = randomCounts(32, state.range(0));
+  for (auto _ : state) {
+    cudaq::ExecutionResult result(counts);
+    benchmark::DoNotOptimize(cudaq::sample_result(std::move(result)));
+  }
+  state.SetItemsProcessed(state.iterations() * counts.size());
+}
+BENCHMARK(BM_SampleResultConstruct)->RangeMultiplier(8)->Range(64, 1 << 18);
+
+void BM_SampleResultFromPackedShots(benchmark::State &state) {
+  const std::size_t numShots = state.range(0);
+  std::mt19937_64 gen(13);
+  std::vector<std::uint64_t> words(numShots);
+  for (auto &w : words)
+    w = gen() & 0xFFFFF;
+  for (auto _ : state) {
+    cudaq::ExecutionResult result;
+    result.appendPackedResults(cudaq::PackedShots(20, std::vector(words)));
+    benchmark::DoNotOptimize(cudaq::sample_result(std::move(result)));
+  }
+  state.SetItemsProcessed(state.iterations() * numShots);
+}
+BENCHMARK(BM_SampleResultFromPackedShots)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20);
+
+void BM_SampleResultMerge(benchmark::State &state) {
+  const cudaq::sample_result lhs(
+      cudaq::ExecutionResult(randomCounts(32, state.range(0))));
+  const cudaq::sample_result rhs(
+      cudaq::ExecutionResult(randomCounts(32, state.range(0))));
+  for (auto _ : state) {
+    auto merged = lhs;
+    merged += rhs;
+    benchmark::DoNotOptimize(merged);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SampleResultMerge)->RangeMultiplier(8)->Range(64, 1 << 18);
+
+void BM_SampleResultMarginal(benchmark::State &state) {
+  const cudaq::sample_result result(
+      cudaq::ExecutionResult(randomCounts(48, state.range(0))));
+  const std::vector<std::size_t> indices{1, 5, 9, 17, 23, 30, 41, 47};
+  for (auto _ : state)
+    benchmark::DoNotOptimize(result.get_marginal(indices));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SampleResultMarginal)->RangeMultiplier(8)->Range(64, 1 << 18);
+
+void BM_RecordLogParse(benchmark::State &state) {
+  const std::size_t numShots = state.range(0);
+  std::string log = "HEADER\tschema_name\tordered\n";
+  for (std::size_t shot = 0; shot < numShots; ++shot)
+    log += "START\nOUTPUT\tINT\t" + std::to_string(shot) + "\ti64\nEND\t0\n";
+  for (auto _ : state) {
+    cudaq::RecordLogParser parser;
+    parser.parse(log);
+    benchmark::DoNotOptimize(parser.getBufferPtr());
+  }
+  state.SetItemsProcessed(state.iterations() * numShots);
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_RecordLogParse)->RangeMultiplier(8)->Range(64, 1 << 18);
+
+} // namespace
@@ -0,0 +1,179 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "cudaq/ADT/GraphCSR.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include <algorithm>
+#include <optional>
+
+namespace cudaq {
+
+/// Search for an embedding of the undirected graph `pattern` into the
+/// undirected graph `target`: a map of the nodes of `pattern` onto distinct
+/// nodes of `target` such that both nodes of every edge of `pattern` are mapped
+/// onto the nodes of an edge of `target`. (This is a subgraph monomorphism,
+/// i.e., `target` may have more edges between the mapped nodes.)
+///
+/// The search is a depth-first search in the style of VF2. The nodes of
+/// `pattern` are matched in an order where each node has as many already
+/// matched neighbours as possible, so the candidates for a node are the
+/// neighbours of the match of one of these. Candidates are pruned by degree and
+/// by the number of free neighbours they have left. The number of candidates
+/// tried is bounded, so that the search time is bounded for graphs without
+/// embedding.
+class SubgraphMatcher {
+public:
+  using Node = GraphCSR::Node;
+
+  SubgraphMatcher(const GraphCSR &pattern, const GraphCSR &target)
+      : pattern(pattern), target(target) {}
+
+  /// Returns the match of each node of `pattern`, or `std::nullopt` if there is
+  /// no embedding or if none was found within `maxCandidates` candidates. The
+  /// nodes of `pattern` without edges are not matched, they are left invalid.
+  std::optional<mlir::SmallVector<Node>> match(std::size_t maxCandidates) {
+    const unsigned numPatternNodes = pattern.getNumNodes();
+    const unsigned numTargetNodes = target.getNumNodes();
+    if (pattern.getNumEdges() > target.getNumEdges())
+      return std::nullopt;
+
+    computeOrder();
+    if (order.size() > numTargetNodes)
+      return std::nullopt;
+
+    sortedTargetNeighbours.assign(numTargetNodes, {});
+    for (unsigned t = 0; t < numTargetNodes; ++t) {
+      for (auto v : target.getNeighbours(Node(t)))
+        sortedTargetNeighbours[t].push_back(v.index);
+      llvm::sort(sortedTargetNeighbours[t]);
+    }
+
+    matches.assign(numPatternNodes, Node());
+    targetUsed = llvm::BitVector(numTargetNodes);
+    remainingCandidates = maxCandidates;
+    if (!search(0))
+      return std::nullopt;
+    return matches;
+  }
+
+private:
+  /// Order the nodes of `pattern` which have edges: each one is the node with
+  /// the most already ordered neighbours, then the highest degree.
+  void computeOrder() {
+    const unsigned numPatternNodes = pattern.getNumNodes();
+    order.clear();
+    parents.assign(numPatternNodes, Node());
+    mlir::SmallVector<unsigned> orderedNeighbours(numPatternNodes, 0);
+    llvm::BitVector ordered(numPatternNodes);
+    while (true) {
+      std::optional<unsigned> next;
+      for (unsigned u = 0; u < numPatternNodes; ++u) {
+        if (ordered.test(u) || degree(pattern, u) == 0)
+          continue;
+        if (!next || orderedNeighbours[u] > orderedNeighbours[*next] ||
+            (orderedNeighbours[u] == orderedNeighbours[*next] &&
+             degree(pattern, u) > degree(pattern, *next)))
+          next = u;
+      }
+      if (!next)
+        return;
+      ordered.set(*next);
+      order.push_back(Node(*next));
+      for (auto v : pattern.getNeighbours(Node(*next))) {
+        if (ordered.test(v.index))
+          continue;
+        if (orderedNeighbours[v.index]++ == 0)
+          parents[v.index] = Node(*next);
+      }
+    }
+  }
+
+  static unsigned degree(const GraphCSR &graph, unsigned node) {
+    return graph.getNeighbours(Node(node)).size();
+  }
+
+  bool areTargetNeighbours(unsigned t0, unsigned t1) const {
+    return std::binary_search(sortedTargetNeighbours[t0].begin(),
+                              sortedTargetNeighbours[t0].end(), t1);
+  }
+
+  /// Returns true if pattern node `u` can be matched with target node `t`,
+  /// given the current partial matches.
+  bool isFeasible(Node u, unsigned t) const {
+    if (targetUsed.test(t) || degree(target, t) < degree(pattern, u.index))
+      return false;
+    unsigned unmatchedNeighbours = 0;
+    for (auto w : pattern.getNeighbours(u)) {
+      if (!matches[w.index].isValid())
+        ++unmatchedNeighbours;
+      else if (!areTargetNeighbours(matches[w.index].index, t))
+        return false;
+    }
+    // Look ahead: the unmatched neighbours of `u` need distinct free
+    // neighbours of `t`.
+    unsigned freeNeighbours = 0;
+    for (auto v : sortedTargetNeighbours[t])
+      if (!targetUsed.test(v))
+        ++freeNeighbours;
+    return freeNeighbours >= unmatchedNeighbours;
+  }
+
+  bool search(unsigned depth) {
+    if (depth == order.size())
+      return true;
+    Node u = order[depth];
+    auto tryCandidate = [&](unsigned t, bool &exhausted) {
+      if (remainingCandidates == 0) {
+        exhausted = true;
+        return false;
+      }
+      --remainingCandidates;
+      if (!isFeasible(u, t))
+        return false;
+      matches[u.index] = Node(t);
+      targetUsed.set(t);
+      if (search(depth + 1))
+        return true;
+      exhausted = remainingCandidates == 0;
+      matches[u.index] = Node();
+      targetUsed.reset(t);
+      return false;
+    };
+
+    bool exhausted = false;
+    if (Node parent = parents[u.index]; parent.isValid()) {
+      for (auto t : sortedTargetNeighbours[matches[parent.index].index])
+        if (tryCandidate(t, exhausted) || exhausted)
+          return !exhausted;
+      return false;
+    }
+    for (unsigned t = 0, end = target.getNumNodes(); t < end; ++t)
+      if (tryCandidate(t, exhausted) || exhausted)
+        return !exhausted;
+    return false;
+  }
+
+  const GraphCSR &pattern;
+  const GraphCSR &target;
+
+  /// The nodes of `pattern` with edges, in the order they are matched.
+  mlir::SmallVector<Node> order;
+  /// An earlier neighbour in `order` of each node, if any. The candidates of a
+  /// node are the neighbours of the match of this node.
+  mlir::SmallVector<Node> parents;
+  mlir::SmallVector<mlir::SmallVector<unsigned>> sortedTargetNeighbours;
+
+  mlir::SmallVector<Node> matches;
+  llvm::BitVector targetUsed;
+  std::size_t remainingCandidates = 0;
+};
+
+} // namespace cudaq
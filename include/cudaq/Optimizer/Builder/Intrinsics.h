@@ -9,6 +9,7 @@
 #pragma once
 
 #include "cudaq/Optimizer/Builder/Factory.h"
+#include "mlir/IR/SymbolTable.h"
 
 namespace cudaq {
 namespace cc {
@@ -111,6 +112,22 @@ public:
     return genCStringLiteral(loc, module, buffer);
   }
 
+  /// Variants of the above, which look the global up in the symbol table of
+  /// \p module held by \p symbolTables. Creating many strings then does not
+  /// scan the module for each of them.
+  mlir::LLVM::GlobalOp
+  genCStringLiteral(mlir::Location loc, mlir::ModuleOp module,
+                    mlir::SymbolTableCollection &symbolTables,
+                    llvm::StringRef cstring);
+  mlir::LLVM::GlobalOp
+  genCStringLiteralAppendNul(mlir::Location loc, mlir::ModuleOp module,
+                             mlir::SymbolTableCollection &symbolTables,
+                             llvm::StringRef cstring) {
+    auto buffer = cstring.str();
+    buffer += '\0';
+    return genCStringLiteral(loc, module, symbolTables, buffer);
+  }
+
   cc::GlobalOp genVectorOfConstants(mlir::Location loc, mlir::ModuleOp module,
                                     llvm::StringRef name,
                                     mlir::DenseElementsAttr values,
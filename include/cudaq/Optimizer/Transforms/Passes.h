@@ -20,8 +20,11 @@ namespace cudaq::opt {
 
 /// Add a pass pipeline to transform call between kernels to direct calls that
 /// do not go through the runtime layers, inline all calls, and detect if calls
-/// to kernels remain in the fully inlined into entry point kernel.
-void addAggressiveInlining(mlir::OpPassManager &pm, bool fatalCheck = false);
+/// to kernels remain in the fully inlined into entry point kernel. If
+/// `maxInlinedOps` is not 0, the calls which would grow the module by more
+/// operations are kept as calls.
+void addAggressiveInlining(mlir::OpPassManager &pm, bool fatalCheck = false,
+                           unsigned maxInlinedOps = 0);
 void registerAggressiveInliningPipeline();
 
 void registerPhaseFoldingPipeline();
@@ -110,6 +113,15 @@ inline std::unique_ptr<mlir::Pass> createQuantumMemToReg() {
   return createMemToReg(m2rOpt);
 }
 
+/// Code size threshold of the loop unrolling for targets which do not need
+/// straight-line code, such as simulators executing full QIR. Loops which
+/// would unroll into more operations are kept as loops.
+static constexpr unsigned loopPreservingMaxUnrolledOps = 4096;
+
+/// Total number of operations the loop unrolling may add to a function for the
+/// same targets. The loops beyond this budget are kept as loops as well.
+static constexpr unsigned loopPreservingUnrollBudget = 65536;
+
 /// Name of `quake.wire_set` generated prior to mapping
 static constexpr const char topologyAgnosticWiresetName[] = "wires";
 
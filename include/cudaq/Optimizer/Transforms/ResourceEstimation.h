@@ -0,0 +1,60 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "mlir/Support/TypeID.h"
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace mlir {
+class Operation;
+}
+
+namespace cudaq::opt {
+/// The resources used by one execution of a kernel, as counted by the resource
+/// counter simulator.
+struct StaticResources {
+  /// The number of gates, keyed by gate name and number of controls.
+  std::map<std::pair<std::string, std::size_t>, std::size_t> gateCounts;
+
+  /// The number of qubits allocated by the kernel.
+  std::size_t numQubits = 0;
+
+  /// The circuit depth, i.e., the number of layers of gates on disjoint qubits.
+  /// It is only known if the qubits of all the gates can be determined at
+  /// compilation time.
+  std::optional<std::size_t> depth;
+};
+
+/// The analysis of a kernel, a `func.func` in reference semantics, with static
+/// control flow: all its loops have a constant number of iterations and all its
+/// conditions are constant. The resources of such a kernel are computed without
+/// executing it, by multiplying the counts of the loop bodies by their number
+/// of iterations. The depth, however, is computed by layering the gates on
+/// their qubits, only iterating the loops until the layering of an iteration
+/// can be extrapolated to the remaining iterations.
+struct ResourceEstimation {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(ResourceEstimation)
+
+  ResourceEstimation(mlir::Operation *op) { performAnalysis(op); }
+
+  /// Returns the resources of the kernel, or `std::nullopt` if its control
+  /// flow is not static.
+  const std::optional<StaticResources> &getResources() const {
+    return resources;
+  }
+
+private:
+  void performAnalysis(mlir::Operation *operation);
+
+  std::optional<StaticResources> resources;
+};
+} // namespace cudaq::opt
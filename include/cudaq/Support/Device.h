@@ -11,6 +11,9 @@
 #include "cudaq/ADT/GraphCSR.h"
 #include "cudaq/Support/Graph.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <cmath>
+#include <map>
+#include <optional>
 
 namespace cudaq {
 
@@ -23,10 +26,26 @@ public:
   using Qubit = GraphCSR::Node;
   using Path = mlir::SmallVector<Qubit>;
 
+  /// The calibration data of a two-qubit connection.
+  struct EdgeCalibration {
+    /// The error rate of two-qubit gates, between 0 and 1.
+    std::optional<double> error;
+    /// The duration of two-qubit gates, in any unit used consistently.
+    std::optional<double> duration;
+  };
+
+  /// The quantity minimized by routing.
+  enum class RoutingCost { distance, error, duration };
+
   /// Read device connectivity info from a file. The input format is the same
-  /// as the Graph dump() format.
+  /// as the Graph dump() format. Calibration data of connections may follow,
+  /// one connection per line, with either or both keys:
+  ///
+  ///   0 -- 1: error = 0.012, duration = 350
+  ///
   static Device file(llvm::StringRef filename) {
     Device device;
+    std::map<std::pair<unsigned, unsigned>, EdgeCalibration> edgeCalibrations;
 
     llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> fileBuffer =
         llvm::MemoryBuffer::getFile(filename);
@@ -53,7 +72,9 @@ public:
         line = line.ltrim();
         if (!line.consumeInteger(/*Radix=*/10, v1)) {
           line = line.ltrim();
-          if (line.consume_front("--> {")) {
+          if (line.consume_front("--") && !line.starts_with(">")) {
+            parseCalibration(v1, line, edgeCalibrations);
+          } else if (line.consume_front("> {")) {
             line = line.ltrim();
             unsigned v2 = 0;
             while (!line.consumeInteger(10, v2)) {
@@ -76,6 +97,12 @@ public:
     }
 
     device.computeAllPairShortestPaths();
+    for (auto &[edge, calibration] : edgeCalibrations)
+      if (edge.first < device.getNumQubits() &&
+          edge.second < device.getNumQubits() &&
+          device.areConnected(Qubit(edge.first), Qubit(edge.second)))
+        device.setCalibration(Qubit(edge.first), Qubit(edge.second),
+                              calibration);
     return device;
   }
 
@@ -168,6 +195,9 @@ public:
   /// Returns the number of physical qubits in the device.
   unsigned getNumQubits() const { return topology.getNumNodes(); }
 
+  /// Returns the graph of the qubits and their connections.
+  const GraphCSR &getTopology() const { return topology; }
+
   /// Returns the distance between two qubits.
   unsigned getDistance(Qubit src, Qubit dst) const {
     unsigned pairID = getPairID(src.index, dst.index);
@@ -182,6 +212,85 @@ public:
     return getDistance(q0, q1) == 1;
   }
 
+  /// Set the calibration data of the connection between `q0` and `q1`.
+  void setCalibration(Qubit q0, Qubit q1, const EdgeCalibration &calibration) {
+    assert(areConnected(q0, q1) && "Qubits are not connected");
+    calibrations.resize(shortestPaths.size());
+    calibrations[getPairID(q0.index, q1.index)] = calibration;
+  }
+
+  /// Returns the calibration data of the connection between `q0` and `q1`.
+  EdgeCalibration getCalibration(Qubit q0, Qubit q1) const {
+    auto pairID = getPairID(q0.index, q1.index);
+    return pairID < calibrations.size() ? calibrations[pairID]
+                                        : EdgeCalibration{};
+  }
+
+  /// Weight the connections by their calibration data, so that
+  /// `getRoutingCost` reflects `cost`. Connections without data for `cost`
+  /// weigh as much as the average connection. Returns false, and keeps
+  /// routing by distance, if no connection has data for `cost`.
+  bool setRoutingCost(RoutingCost cost) {
+    weightedDistances.clear();
+    if (cost == RoutingCost::distance)
+      return true;
+
+    // The weight of an edge. The error rates of successive gates compound,
+    // so their weights are the log of the success probability.
+    std::size_t numQubits = getNumQubits();
+    mlir::SmallVector<std::optional<double>> weights(shortestPaths.size());
+    double totalWeight = 0.0;
+    unsigned numWeights = 0;
+    for (unsigned u = 0; u < numQubits; ++u)
+      for (auto v : getNeighbours(Qubit(u))) {
+        if (v.index < u)
+          continue;
+        auto calibration = getCalibration(Qubit(u), v);
+        auto &weight = weights[getPairID(u, v.index)];
+        if (cost == RoutingCost::error && calibration.error)
+          weight = -std::log1p(-std::min(*calibration.error, 1.0 - 1e-9));
+        else if (cost == RoutingCost::duration && calibration.duration)
+          weight = *calibration.duration;
+        if (weight) {
+          totalWeight += *weight;
+          ++numWeights;
+        }
+      }
+    if (numWeights == 0 || totalWeight <= 0.0)
+      return false;
+    meanEdgeWeight = totalWeight / numWeights;
+
+    // Compute the lightest paths between all the qubits (Floyd-Warshall).
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    weightedDistances.assign(shortestPaths.size(), infinity);
+    for (unsigned u = 0; u < numQubits; ++u) {
+      weightedDistances[getPairID(u, u)] = 0.0;
+      for (auto v : getNeighbours(Qubit(u)))
+        weightedDistances[getPairID(u, v.index)] =
+            weights[getPairID(u, v.index)].value_or(meanEdgeWeight);
+    }
+    for (unsigned k = 0; k < numQubits; ++k)
+      for (unsigned u = 0; u < numQubits; ++u)
+        for (unsigned v = u + 1; v < numQubits; ++v) {
+          double throughK = weightedDistances[getPairID(u, k)] +
+                            weightedDistances[getPairID(k, v)];
+          auto &distance = weightedDistances[getPairID(u, v)];
+          distance = std::min(distance, throughK);
+        }
+    return true;
+  }
+
+  /// Returns the cost of bringing two qubits together and applying a gate to
+  /// them, relative to the cost of the gate on an average connection. By
+  /// distance, this is the number of swaps needed, `getDistance() - 1`.
+  double getRoutingCost(Qubit src, Qubit dst) const {
+    if (weightedDistances.empty())
+      return static_cast<double>(getDistance(src, dst)) - 1.0;
+    return weightedDistances[getPairID(src.index, dst.index)] /
+               meanEdgeWeight -
+           1.0;
+  }
+
   /// Returns a shortest path between two qubits.
   Path getShortestPath(Qubit src, Qubit dst) const {
     unsigned pairID = getPairID(src.index, dst.index);
@@ -206,6 +315,34 @@ public:
 private:
   using PathRef = mlir::ArrayRef<Qubit>;
 
+  /// Parse the calibration data of the connection between `v1` and the qubit
+  /// following in `line`, e.g., "1: error = 0.012, duration = 350".
+  static void parseCalibration(
+      unsigned v1, llvm::StringRef line,
+      std::map<std::pair<unsigned, unsigned>, EdgeCalibration> &calibrations) {
+    unsigned v2 = 0;
+    line = line.ltrim();
+    if (line.consumeInteger(/*Radix=*/10, v2))
+      return;
+    line = line.ltrim();
+    if (!line.consume_front(":"))
+      return;
+    auto &calibration = calibrations[std::minmax(v1, v2)];
+    while (!line.empty()) {
+      auto [entry, rest] = line.split(',');
+      line = rest;
+      auto [key, value] = entry.split('=');
+      double number = 0.0;
+      if (value.trim().getAsDouble(number))
+        continue;
+      key = key.trim();
+      if (key == "error")
+        calibration.error = number;
+      else if (key == "duration")
+        calibration.duration = number;
+    }
+  }
+
   /// Returns a unique id for a pair of values (`u` and `v`). `getPairID(u, v)`
   /// will be equal to `getPairID(v, u)`.
   unsigned getPairID(unsigned u, unsigned v) const {
@@ -248,6 +385,14 @@ private:
 
   /// Storage for `PathRef`'s in `shortestPaths`
   mlir::SmallVector<Qubit> pathsData;
+
+  /// Calibration data of the connections, indexed by pair ID.
+  mlir::SmallVector<EdgeCalibration> calibrations;
+
+  /// Lightest path weights between every pair of qubits, indexed by pair ID,
+  /// or empty when routing by distance.
+  mlir::SmallVector<double> weightedDistances;
+  double meanEdgeWeight = 1.0;
 };
 
 } // namespace cudaq
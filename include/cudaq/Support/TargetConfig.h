@@ -25,6 +25,7 @@ enum TargetFeatureFlag : unsigned {
   flagsMqpu = 0x0008,
   flagsDepAnalysis = 0x0010,
   flagsQPP = 0x0020,
+  flagsMixed = 0x0040,
 };
 
 /// @brief Configuration argument type annotation
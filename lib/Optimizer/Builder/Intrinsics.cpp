@@ -683,6 +683,26 @@ LLVM::GlobalOp IRBuilder::genCStringLiteral(Location loc, ModuleOp module,
                                 /*alignment=*/0);
 }
 
+LLVM::GlobalOp
+IRBuilder::genCStringLiteral(Location loc, ModuleOp module,
+                             SymbolTableCollection &symbolTables,
+                             llvm::StringRef cstring) {
+  auto *ctx = getContext();
+  auto uniqName = "cstr." + hashStringByContent(cstring);
+  if (auto stringLit = symbolTables.lookupSymbolIn<LLVM::GlobalOp>(
+          module, StringAttr::get(ctx, uniqName)))
+    return stringLit;
+  auto cstringTy = opt::factory::getStringType(ctx, cstring.size());
+  auto stringAttr = getStringAttr(cstring);
+  OpBuilder::InsertionGuard guard(*this);
+  setInsertionPointToEnd(module.getBody());
+  auto global = create<LLVM::GlobalOp>(loc, cstringTy, /*isConstant=*/true,
+                                       LLVM::Linkage::Private, uniqName,
+                                       stringAttr, /*alignment=*/0);
+  symbolTables.getSymbolTable(module).insert(global);
+  return global;
+}
+
 std::string IRBuilder::hashStringByContent(StringRef sref) {
   // For shorter names just use the string content in hex. (Consider replacing
   // this with a more compact, readable base-64 encoding.)
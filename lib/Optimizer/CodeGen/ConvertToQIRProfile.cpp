@@ -210,8 +210,10 @@ private:
 
 struct AddFuncAttribute : public OpRewritePattern<LLVM::LLVMFuncOp> {
   explicit AddFuncAttribute(MLIRContext *ctx, const FunctionAnalysisInfo &info,
-                            llvm::StringRef convertTo_)
-      : OpRewritePattern(ctx), infoMap(info), convertTo(convertTo_) {}
+                            llvm::StringRef convertTo_,
+                            SymbolTableCollection &symbolTables)
+      : OpRewritePattern(ctx), infoMap(info), convertTo(convertTo_),
+        symbolTables(symbolTables) {}
 
   LogicalResult matchAndRewrite(LLVM::LLVMFuncOp op,
                                 PatternRewriter &rewriter) const override {
@@ -290,8 +292,8 @@ struct AddFuncAttribute : public OpRewritePattern<LLVM::LLVMFuncOp> {
           // Note: it should be the case that this string literal has already
           // been added to the IR, so this step does not actually update the
           // module.
-          auto globl =
-              builder.genCStringLiteralAppendNul(loc, module, rec.second);
+          auto globl = builder.genCStringLiteralAppendNul(
+              loc, module, symbolTables, rec.second);
           auto addrOf = builder.create<LLVM::AddressOfOp>(
               loc, cudaq::opt::factory::getPointerType(globl.getType()),
               globl.getName());
@@ -310,6 +312,7 @@ struct AddFuncAttribute : public OpRewritePattern<LLVM::LLVMFuncOp> {
 
   const FunctionAnalysisInfo &infoMap;
   std::string convertTo;
+  SymbolTableCollection &symbolTables;
 };
 
 struct AddCallAttribute : public OpRewritePattern<LLVM::CallOp> {
@@ -357,8 +360,11 @@ struct QIRToQIRProfileFuncPass
     RewritePatternSet patterns(ctx);
     const auto &analysis = getAnalysis<FunctionProfileAnalysis>();
     const auto &funcAnalysisInfo = analysis.getAnalysisInfo();
+    // Look the register names up in the symbol table of the module, built on
+    // the first lookup, rather than scanning the module for each result.
+    SymbolTableCollection symbolTables;
     patterns.insert<AddFuncAttribute>(ctx, funcAnalysisInfo,
-                                      convertTo.getValue());
+                                      convertTo.getValue(), symbolTables);
     patterns.insert<AddCallAttribute>(ctx, funcAnalysisInfo);
     ConversionTarget target(*ctx);
     target.addLegalDialect<LLVM::LLVMDialect>();
@@ -605,6 +611,9 @@ void cudaq::opt::addQIRProfilePipeline(OpPassManager &pm,
   assert(convertTo == "qir-adaptive" || convertTo == "qir-base");
   pm.addPass(createQIRProfilePreparationPass());
   pm.addNestedPass<LLVM::LLVMFuncOp>(createConvertToQIRFuncPass(convertTo));
-  pm.addPass(createQIRToQIRProfilePass(convertTo));
+  // The peepholes only rewrite the bodies of the functions, using the
+  // declarations added by the preparation pass, so the functions are converted
+  // in parallel.
+  pm.addNestedPass<LLVM::LLVMFuncOp>(createQIRToQIRProfilePass(convertTo));
   addQIRProfileVerify(pm, convertTo);
 }
@@ -29,6 +29,20 @@ struct TargetCodegenPipelineOptions
   PassOptions::Option<std::string> target{
       *this, "convert-to", llvm::cl::desc("Conversion target specifier."),
       llvm::cl::init("")};
+  PassOptions::Option<unsigned> maxUnrolledOps{
+      *this, "max-unrolled-ops",
+      llvm::cl::desc("Maximum number of operations a loop is unrolled into (0 "
+                     "for no limit)."),
+      llvm::cl::init(0)};
+  PassOptions::Option<unsigned> unrollBudget{
+      *this, "unroll-budget",
+      llvm::cl::desc("Maximum number of operations loop unrolling may add to a "
+                     "function (0 for no limit)."),
+      llvm::cl::init(0)};
+  PassOptions::Option<bool> packBoolArrays{
+      *this, "pack-bool-arrays",
+      llvm::cl::desc("Log arrays of booleans as packed integer records."),
+      llvm::cl::init(false)};
 };
 } // namespace
 
@@ -62,6 +76,8 @@ void createCommonTargetCodegenPipeline(
     pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopNormalize());
     cudaq::opt::LoopUnrollOptions luo;
     luo.allowBreak = options.allowBreaksInLoops;
+    luo.maxUnrolledOps = options.maxUnrolledOps;
+    luo.unrollBudget = options.unrollBudget;
     pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopUnroll(luo));
     pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
   } else {
@@ -80,6 +96,8 @@ void createCommonTargetCodegenPipeline(
     pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopNormalize());
     cudaq::opt::LoopUnrollOptions luo;
     luo.allowBreak = options.allowBreaksInLoops;
+    luo.maxUnrolledOps = options.maxUnrolledOps;
+    luo.unrollBudget = options.unrollBudget;
     pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopUnroll(luo));
     pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
     pm.addNestedPass<func::FuncOp>(createCSEPass());
@@ -103,7 +121,8 @@ void createTargetCodegenPipeline(PassManager &pm,
                                  const TargetCodegenPipelineOptions &options) {
   createCommonTargetCodegenPipeline<isJIT>(pm, options);
   ::addQIRConversionPipeline(pm, options.target);
-  pm.addPass(cudaq::opt::createReturnToOutputLog());
+  pm.addPass(cudaq::opt::createReturnToOutputLog(
+      {.packBoolArrays = options.packBoolArrays}));
   pm.addPass(createConvertMathToFuncs());
   pm.addPass(createSymbolDCEPass());
   pm.addPass(cudaq::opt::createCCToLLVM());
@@ -116,8 +135,18 @@ void createTargetCodegenPipeline(PassManager &pm, StringRef convertTo) {
   auto convertFields = convertTo.split(':');
   TargetCodegenPipelineOptions opts;
   opts.allowBreaksInLoops = convertFields.first == "qir-adaptive";
-  opts.appendDeprecatedVerifier =
-      convertFields.first != "qir" && convertFields.first != "qir-full";
+  const bool isFullQIR =
+      convertFields.first == "qir" || convertFields.first == "qir-full";
+  opts.appendDeprecatedVerifier = !isFullQIR;
+  // Full QIR supports loops, so large loops need not be unrolled.
+  if (isFullQIR) {
+    opts.maxUnrolledOps = cudaq::opt::loopPreservingMaxUnrolledOps;
+    opts.unrollBudget = cudaq::opt::loopPreservingUnrollBudget;
+  }
+  // The features, e.g., `qir-adaptive:1.0:int_computations,packed_records`.
+  SmallVector<StringRef> features;
+  convertFields.second.split(':').second.split(features, ',');
+  opts.packBoolArrays = llvm::is_contained(features, "packed_records");
   opts.target = convertTo.str();
   createTargetCodegenPipeline<isJIT>(pm, opts);
 }
@@ -30,7 +30,8 @@ using namespace mlir;
 namespace {
 class ReturnRewrite : public OpRewritePattern<cudaq::cc::LogOutputOp> {
 public:
-  using OpRewritePattern::OpRewritePattern;
+  ReturnRewrite(MLIRContext *ctx, bool packBoolArrays)
+      : OpRewritePattern(ctx), packBoolArrays(packBoolArrays) {}
 
   // This is where the heavy lifting is done. We take the return op's operand(s)
   // and convert them to calls to the QIR output logging functions with the
@@ -45,8 +46,8 @@ public:
     return success();
   }
 
-  static void genOutputLog(Location loc, PatternRewriter &rewriter, Value val,
-                           std::optional<StringRef> prefix) {
+  void genOutputLog(Location loc, PatternRewriter &rewriter, Value val,
+                    std::optional<StringRef> prefix) const {
     Type valTy = val.getType();
     TypeSwitch<Type>(valTy)
         .Case([&](IntegerType intTy) {
@@ -117,15 +118,12 @@ public:
           rewriter.create<func::CallOp>(loc, TypeRange{},
                                         cudaq::opt::QIRArrayRecordOutput,
                                         ArrayRef<Value>{size, label});
-          std::string preStr = prefix ? prefix->str() : std::string{};
-          for (std::int32_t i = 0; i < sz; ++i) {
-            std::string offset = preStr + std::string("[") + std::to_string(i) +
-                                 std::string("]");
-            Value w = rewriter.create<cudaq::cc::ExtractValueOp>(
+          SmallVector<Value> elements;
+          for (std::int32_t i = 0; i < sz; ++i)
+            elements.push_back(rewriter.create<cudaq::cc::ExtractValueOp>(
                 loc, arrTy.getElementType(), val,
-                ArrayRef<cudaq::cc::ExtractValueArg>{i});
-            genOutputLog(loc, rewriter, w, offset);
-          }
+                ArrayRef<cudaq::cc::ExtractValueArg>{i}));
+          genArrayElements(loc, rewriter, elements, prefix);
         })
         .Case([&](cudaq::cc::StdvecType vecTy) {
           // For this type, we expect a cc.stdvec_init operation as the input.
@@ -142,7 +140,6 @@ public:
               rewriter.create<func::CallOp>(loc, TypeRange{},
                                             cudaq::opt::QIRArrayRecordOutput,
                                             ArrayRef<Value>{size, label});
-              std::string preStr = prefix ? prefix->str() : std::string{};
               Value rawBuffer = vecInit.getBuffer();
               auto eleTy = vecTy.getElementType();
               auto buffTy = cudaq::cc::PointerType::get(eleTy);
@@ -150,14 +147,13 @@ public:
                   cudaq::cc::PointerType::get(cudaq::cc::ArrayType::get(eleTy));
               Value buffer =
                   rewriter.create<cudaq::cc::CastOp>(loc, ptrArrTy, rawBuffer);
+              SmallVector<Value> elements;
               for (std::int32_t i = 0; i < sz; ++i) {
-                std::string offset = preStr + std::string("[") +
-                                     std::to_string(i) + std::string("]");
                 auto v = rewriter.create<cudaq::cc::ComputePtrOp>(
                     loc, buffTy, buffer, ArrayRef<cudaq::cc::ComputePtrArg>{i});
-                Value w = rewriter.create<cudaq::cc::LoadOp>(loc, v);
-                genOutputLog(loc, rewriter, w, offset);
+                elements.push_back(rewriter.create<cudaq::cc::LoadOp>(loc, v));
               }
+              genArrayElements(loc, rewriter, elements, prefix);
             }
         })
         .Default([&](Type) {
@@ -168,6 +164,50 @@ public:
         });
   }
 
+  /// Log the elements of an array. Each element gets its own record labeled
+  /// with its index, unless packing is enabled and this is a top-level array
+  /// of `i1`. In that case, the elements are packed, up to 64 at a time, into
+  /// integer records labeled with the range `[begin:end]` of the elements they
+  /// hold. Element `begin` is stored in the least significant bit.
+  void genArrayElements(Location loc, PatternRewriter &rewriter,
+                        ArrayRef<Value> elements,
+                        std::optional<StringRef> prefix) const {
+    if (packBoolArrays && !prefix && !elements.empty() &&
+        elements.front().getType() == rewriter.getI1Type()) {
+      constexpr std::size_t bitsPerRecord = 64;
+      auto i64Ty = rewriter.getI64Type();
+      for (std::size_t begin = 0; begin < elements.size();
+           begin += bitsPerRecord) {
+        std::size_t end = std::min(begin + bitsPerRecord, elements.size());
+        Value packed = rewriter.create<arith::ConstantIntOp>(loc, 0, 64);
+        for (std::size_t i = begin; i < end; ++i) {
+          Value bit = rewriter.create<cudaq::cc::CastOp>(
+              loc, i64Ty, elements[i], cudaq::cc::CastOpMode::Unsigned);
+          if (i != begin) {
+            Value shift =
+                rewriter.create<arith::ConstantIntOp>(loc, i - begin, 64);
+            bit = rewriter.create<arith::ShLIOp>(loc, bit, shift);
+          }
+          packed = rewriter.create<arith::OrIOp>(loc, packed, bit);
+        }
+        std::string labelStr = std::string("[") + std::to_string(begin) +
+                               std::string(":") + std::to_string(end) +
+                               std::string("]");
+        Value label = makeLabel(loc, rewriter, labelStr);
+        rewriter.create<func::CallOp>(loc, TypeRange{},
+                                      cudaq::opt::QIRIntegerRecordOutput,
+                                      ArrayRef<Value>{packed, label});
+      }
+      return;
+    }
+    std::string preStr = prefix ? prefix->str() : std::string{};
+    for (auto iter : llvm::enumerate(elements)) {
+      std::string offset = preStr + std::string("[") +
+                           std::to_string(iter.index()) + std::string("]");
+      genOutputLog(loc, rewriter, iter.value(), offset);
+    }
+  }
+
   static std::string
   translateType(Type ty, std::optional<std::int32_t> vecSz = std::nullopt) {
     if (auto intTy = dyn_cast<IntegerType>(ty)) {
@@ -207,6 +247,9 @@ public:
     auto i8PtrTy = cudaq::cc::PointerType::get(rewriter.getI8Type());
     return rewriter.create<cudaq::cc::CastOp>(loc, i8PtrTy, lit);
   }
+
+private:
+  bool packBoolArrays;
 };
 
 struct ReturnToOutputLogPass
@@ -231,7 +274,7 @@ struct ReturnToOutputLogPass
     }
 
     RewritePatternSet patterns(ctx);
-    patterns.insert<ReturnRewrite>(ctx);
+    patterns.insert<ReturnRewrite>(ctx, packBoolArrays);
     LLVM_DEBUG(llvm::dbgs() << "Before return to output logging:\n" << module);
     if (failed(applyPatternsAndFoldGreedily(module, std::move(patterns))))
       signalPassFailure();
@@ -24,28 +24,49 @@ using namespace mlir;
 static LogicalResult emitOperation(nlohmann::json &json,
                                    cudaq::Emitter &emitter, Operation &op);
 
-static LogicalResult emitEntryPoint(nlohmann::json &json,
-                                    cudaq::Emitter &emitter, func::FuncOp op) {
+/// Write \p json to the output, as a member of the instructions array, with
+/// the indentation it has in the whole document.
+static void emitInstruction(cudaq::Emitter &emitter,
+                            const nlohmann::json &json) {
+  constexpr StringRef indentation = "        ";
+  emitter.os << indentation;
+  // Strings are escaped, so all the line breaks are between JSON tokens.
+  for (char c : json.dump(4)) {
+    emitter.os << c;
+    if (c == '\n')
+      emitter.os << indentation;
+  }
+}
+
+/// Emit the entry point, streaming its instructions to the output as they are
+/// translated, in the format of `nlohmann::json::dump(4)`. The JSON of the
+/// whole program is never held in memory.
+static LogicalResult emitEntryPoint(cudaq::Emitter &emitter, func::FuncOp op) {
   if (op.getBody().getBlocks().size() != 1)
     op.emitError("Cannot translate kernels with more than 1 block to IQM Json. "
                  "Must be a straight-line representation.");
 
   cudaq::Emitter::Scope scope(emitter, /*isEntryPoint=*/true);
-  json["name"] = op.getName().str();
-  std::vector<nlohmann::json> instructions;
+  emitter.os << "{\n    \"instructions\": [";
+  bool empty = true;
   for (Operation &op : op.getOps()) {
     nlohmann::json instruction = nlohmann::json::object();
     if (failed(emitOperation(instruction, emitter, op)))
       return failure();
-    if (!instruction.empty())
-      instructions.push_back(instruction);
+    if (instruction.empty())
+      continue;
+    emitter.os << (empty ? "\n" : ",\n");
+    emitInstruction(emitter, instruction);
+    empty = false;
   }
-  json["instructions"] = instructions;
+  if (!empty)
+    emitter.os << "\n    ";
+  emitter.os << "],\n    \"name\": "
+             << nlohmann::json(op.getName().str()).dump() << "\n}";
   return success();
 }
 
-static LogicalResult emitOperation(nlohmann::json &json,
-                                   cudaq::Emitter &emitter, ModuleOp moduleOp) {
+static LogicalResult emitModule(cudaq::Emitter &emitter, ModuleOp moduleOp) {
   func::FuncOp entryPoint = nullptr;
   for (Operation &op : moduleOp) {
     if (op.hasAttr(cudaq::entryPointAttrName)) {
@@ -57,7 +78,7 @@ static LogicalResult emitOperation(nlohmann::json &json,
   }
   if (!entryPoint)
     return moduleOp.emitError("does not contain an entrypoint");
-  return emitEntryPoint(json, emitter, entryPoint);
+  return emitEntryPoint(emitter, entryPoint);
 }
 
 static LogicalResult emitOperation(nlohmann::json &json,
@@ -180,7 +201,6 @@ static LogicalResult emitOperation(nlohmann::json &json,
 static LogicalResult emitOperation(nlohmann::json &json,
                                    cudaq::Emitter &emitter, Operation &op) {
   return llvm::TypeSwitch<Operation *, LogicalResult>(&op)
-      .Case<ModuleOp>([&](auto op) { return emitOperation(json, emitter, op); })
       // Quake
       .Case<quake::AllocaOp>(
           [&](auto op) { return emitOperation(json, emitter, op); })
@@ -210,8 +230,10 @@ static LogicalResult emitOperation(nlohmann::json &json,
 }
 
 LogicalResult cudaq::translateToIQMJson(Operation *op, llvm::raw_ostream &os) {
-  nlohmann::json j;
   Emitter emitter(os);
+  if (auto moduleOp = dyn_cast<ModuleOp>(op))
+    return emitModule(emitter, moduleOp);
+  nlohmann::json j;
   auto ret = emitOperation(j, emitter, *op);
   os << j.dump(4);
   return ret;
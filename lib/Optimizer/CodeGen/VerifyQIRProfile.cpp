@@ -34,18 +34,9 @@ using namespace mlir;
 
 namespace {
 
-/// @brief Return true if the CallOp is on a FuncOp declaration that
-/// is annotated with the cudaq-fnid attribute.
-bool isDeviceCallFuncOp(LLVM::CallOp call) {
-  // Need the ModuleOp
-  auto mod = call->getParentOfType<ModuleOp>();
-  // Need the function name
-  auto funcNameAttr = call.getCalleeAttr();
-  if (!funcNameAttr)
-    return false;
-  auto funcName = funcNameAttr.getValue();
-  // Get the FuncOp declaration
-  auto calleeFunc = mod.lookupSymbol<LLVM::LLVMFuncOp>(funcName);
+/// @brief Return true if \p calleeFunc is a FuncOp declaration that is
+/// annotated with the cudaq-fnid attribute.
+bool isDeviceCallFuncOp(LLVM::LLVMFuncOp calleeFunc) {
   if (!calleeFunc)
     return false;
 
@@ -87,15 +78,25 @@ struct VerifyQIRProfilePass
       return;
     auto *ctx = &getContext();
     const bool isBaseProfile = convertTo.getValue() == "qir-base";
+    auto qubitTy = cudaq::opt::getQubitType(ctx);
+    auto module = func->getParentOfType<ModuleOp>();
+    // A kernel makes many calls to few functions. Look each callee up once,
+    // rather than scanning the module for every call.
+    DenseMap<StringAttr, bool> isDeviceCallee;
     func.walk([&](Operation *op) {
       if (auto call = dyn_cast<LLVM::CallOp>(op)) {
-        // Always accept device_call functions
-        if (isDeviceCallFuncOp(call))
-          return WalkResult::advance();
-
         auto funcNameAttr = call.getCalleeAttr();
         if (!funcNameAttr)
           return WalkResult::advance();
+        auto [iter, inserted] =
+            isDeviceCallee.try_emplace(funcNameAttr.getAttr(), false);
+        if (inserted)
+          iter->second = isDeviceCallFuncOp(
+              module.lookupSymbol<LLVM::LLVMFuncOp>(funcNameAttr.getAttr()));
+        // Always accept device_call functions
+        if (iter->second)
+          return WalkResult::advance();
+
         auto funcName = funcNameAttr.getValue();
         if (isBaseProfile && (!funcName.startswith("__quantum_") ||
                               funcName.equals(cudaq::opt::QIRCustomOp))) {
@@ -106,7 +107,6 @@ struct VerifyQIRProfilePass
 
         // Check that qubits are unique values.
         const std::size_t numOpnds = call.getNumOperands();
-        auto qubitTy = cudaq::opt::getQubitType(ctx);
         if (numOpnds > 0)
           for (std::size_t i = 0; i < numOpnds - 1; ++i)
             if (call.getOperand(i).getType() == qubitTy)
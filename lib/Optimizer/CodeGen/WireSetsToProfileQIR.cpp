@@ -99,7 +99,11 @@ using OutputNamesType =
 template <typename OP>
 struct GeneralRewrite : OpConversionPattern<OP> {
   using Base = OpConversionPattern<OP>;
-  using Base::Base;
+
+  explicit GeneralRewrite(TypeConverter &typeConverter,
+                          SymbolTableCollection &symbolTables,
+                          MLIRContext *ctxt, PatternBenefit benefit = 1)
+      : Base(typeConverter, ctxt, benefit), symbolTables(symbolTables) {}
 
   LogicalResult
   matchAndRewrite(OP qop, typename Base::OpAdaptor adaptor,
@@ -129,7 +133,8 @@ struct GeneralRewrite : OpConversionPattern<OP> {
       SmallVector<Type> argTys = {arrTy, qbTy};
       ModuleOp mod = qop->template getParentOfType<ModuleOp>();
       FlatSymbolRefAttr qisFuncSymbol;
-      if (auto f = mod.lookupSymbol<func::FuncOp>(funcName)) {
+      if (auto f = symbolTables.lookupSymbolIn<func::FuncOp>(
+              mod, StringAttr::get(ctx, funcName))) {
         auto fTy = f.getFunctionType();
         auto fSym = f.getSymNameAttr();
         qisFuncSymbol = FlatSymbolRefAttr::get(ctx, funcName);
@@ -162,6 +167,9 @@ struct GeneralRewrite : OpConversionPattern<OP> {
     }
     return failure();
   }
+
+private:
+  SymbolTableCollection &symbolTables;
 };
 
 namespace {
@@ -264,10 +272,11 @@ struct WireSetRewrite : OpConversionPattern<quake::WireSetOp> {
 struct MzRewrite : OpConversionPattern<quake::MzOp> {
   using Base = OpConversionPattern;
   explicit MzRewrite(TypeConverter &typeConverter, unsigned &counter,
-                     OutputNamesType &resultQubitVals, MLIRContext *ctxt,
+                     OutputNamesType &resultQubitVals,
+                     SymbolTableCollection &symbolTables, MLIRContext *ctxt,
                      PatternBenefit benefit = 1)
       : Base(typeConverter, ctxt, benefit), resultCount(counter),
-        resultQubitVals(resultQubitVals) {}
+        resultQubitVals(resultQubitVals), symbolTables(symbolTables) {}
 
   LogicalResult
   matchAndRewrite(quake::MzOp meas, OpAdaptor adaptor,
@@ -302,7 +311,8 @@ struct MzRewrite : OpConversionPattern<quake::MzOp> {
       auto mod = meas->getParentOfType<ModuleOp>();
       // NB: This is thread safe as it should never do an insertion, just a
       // lookup.
-      auto nameObj = irb.genCStringLiteralAppendNul(loc, mod, *regName);
+      auto nameObj =
+          irb.genCStringLiteralAppendNul(loc, mod, symbolTables, *regName);
       auto arrI8Ty = mlir::LLVM::LLVMArrayType::get(rewriter.getI8Type(),
                                                     regName->size() + 1);
       auto ptrArrTy = cudaq::cc::PointerType::get(arrI8Ty);
@@ -335,6 +345,7 @@ struct MzRewrite : OpConversionPattern<quake::MzOp> {
 private:
   unsigned &resultCount;
   OutputNamesType &resultQubitVals;
+  SymbolTableCollection &symbolTables;
 };
 
 struct DiscriminateRewrite : OpConversionPattern<quake::DiscriminateOp> {
@@ -342,9 +353,10 @@ struct DiscriminateRewrite : OpConversionPattern<quake::DiscriminateOp> {
 
   explicit DiscriminateRewrite(TypeConverter &typeConverter, bool adaptive,
                                DenseMap<Operation *, StringRef> &nameMap,
+                               SymbolTableCollection &symbolTables,
                                MLIRContext *ctxt, PatternBenefit benefit = 1)
       : Base(typeConverter, ctxt, benefit), isAdaptiveProfile(adaptive),
-        regNameMap(nameMap) {}
+        regNameMap(nameMap), symbolTables(symbolTables) {}
 
   LogicalResult
   matchAndRewrite(quake::DiscriminateOp disc, OpAdaptor adaptor,
@@ -357,7 +369,8 @@ struct DiscriminateRewrite : OpConversionPattern<quake::DiscriminateOp> {
     assert(iter != regNameMap.end() && "discriminate must be in map");
     // NB: This is thread safe as it should never do an insertion, just a
     // lookup.
-    auto nameObj = irb.genCStringLiteralAppendNul(loc, mod, iter->second);
+    auto nameObj =
+        irb.genCStringLiteralAppendNul(loc, mod, symbolTables, iter->second);
     auto arrI8Ty = mlir::LLVM::LLVMArrayType::get(rewriter.getI8Type(),
                                                   iter->second.size() + 1);
     auto ptrArrTy = cudaq::cc::PointerType::get(arrI8Ty);
@@ -386,6 +399,7 @@ struct DiscriminateRewrite : OpConversionPattern<quake::DiscriminateOp> {
 private:
   bool isAdaptiveProfile;
   DenseMap<Operation *, StringRef> &regNameMap;
+  SymbolTableCollection &symbolTables;
 };
 
 struct WireSetToProfileQIRPass
@@ -420,21 +434,27 @@ struct WireSetToProfileQIRPass
     QuakeTypeConverter quakeTypeConverter;
     unsigned resultCounter = 0;
     OutputNamesType resultQubitVals;
-    patterns.insert<BranchRewrite, CondBranchRewrite,
-                    GeneralRewrite<quake::HOp>, GeneralRewrite<quake::XOp>,
+    // The symbols of the module are looked up for each gate and measurement.
+    // They are all declared by the preparation pass, so the symbol table of the
+    // module is built once, on the first lookup, instead of scanning the module
+    // for each of them.
+    SymbolTableCollection symbolTables;
+    patterns.insert<BranchRewrite, CondBranchRewrite, BorrowWireRewrite,
+                    ResetRewrite, ReturnWireRewrite>(quakeTypeConverter,
+                                                     context);
+    patterns.insert<GeneralRewrite<quake::HOp>, GeneralRewrite<quake::XOp>,
                     GeneralRewrite<quake::YOp>, GeneralRewrite<quake::ZOp>,
                     GeneralRewrite<quake::SOp>, GeneralRewrite<quake::TOp>,
                     GeneralRewrite<quake::RxOp>, GeneralRewrite<quake::RyOp>,
                     GeneralRewrite<quake::RzOp>, GeneralRewrite<quake::R1Op>,
                     GeneralRewrite<quake::U3Op>, GeneralRewrite<quake::SwapOp>,
-                    GeneralRewrite<quake::PhasedRxOp>, BorrowWireRewrite,
-                    ResetRewrite, ReturnWireRewrite>(quakeTypeConverter,
-                                                     context);
+                    GeneralRewrite<quake::PhasedRxOp>>(quakeTypeConverter,
+                                                       symbolTables, context);
     patterns.insert<MzRewrite>(quakeTypeConverter, resultCounter,
-                               resultQubitVals, context);
+                               resultQubitVals, symbolTables, context);
     const bool isAdaptiveProfile = convertTo == "qir-adaptive";
     patterns.insert<DiscriminateRewrite>(quakeTypeConverter, isAdaptiveProfile,
-                                         regNameMap, context);
+                                         regNameMap, symbolTables, context);
     ConversionTarget target(*context);
     target.addLegalDialect<arith::ArithDialect, cudaq::cc::CCDialect,
                            func::FuncDialect, LLVM::LLVMDialect>();
@@ -556,6 +576,7 @@ struct WireSetToProfileQIRPrepPass
     createNewDecl(cudaq::opt::NVQIRInvokeWithControlBits, invokeCtrlTy);
 
     unsigned counter = 0;
+    SymbolTableCollection symbolTables;
     op.walk([&](quake::MzOp meas) {
       auto optName = meas.getRegisterName();
       std::string name;
@@ -568,10 +589,11 @@ struct WireSetToProfileQIRPrepPass
         meas.setRegisterName(name);
       }
       cudaq::IRBuilder irb(builder);
-      irb.genCStringLiteralAppendNul(meas.getLoc(), op, name);
+      irb.genCStringLiteralAppendNul(meas.getLoc(), op, symbolTables, name);
     });
     cudaq::IRBuilder irb(builder);
-    irb.genCStringLiteralAppendNul(builder.getUnknownLoc(), op, "?");
+    irb.genCStringLiteralAppendNul(builder.getUnknownLoc(), op, symbolTables,
+                                   "?");
 
     LLVM_DEBUG(llvm::dbgs() << "Module after prep:\n"; op->dump());
   }
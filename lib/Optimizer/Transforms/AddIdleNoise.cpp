@@ -0,0 +1,372 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Builder/Factory.h"
+#include "cudaq/Optimizer/Dialect/CC/CCOps.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Interfaces/CallInterfaces.h"
+#include <cmath>
+#include <map>
+#include <numeric>
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_ADDIDLENOISE
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "add-idle-noise"
+
+using namespace mlir;
+
+/// \file
+/// This pass schedules the quantum operations of a kernel as soon as possible,
+/// given the duration of each operation, and inserts amplitude and phase
+/// damping channels on the qubits that are idle while waiting for an operation.
+
+/// Returns the key of the Kraus channel \p name, as `REGISTER_KRAUS_CHANNEL`
+/// defines it in the runtime.
+static std::int64_t getKrausChannelKey(StringRef name) {
+  return static_cast<std::int64_t>(std::hash<std::string>{}(name.str()));
+}
+
+namespace {
+/// A qubit of the kernel: a `!quake.ref` allocation, or an element of a
+/// `!quake.veq` allocation.
+struct Qubit {
+  Value allocation;
+  std::optional<std::size_t> index;
+  /// The time at which the last operation on the qubit completes.
+  double availableAt = 0.0;
+  /// Whether the qubit may be in a state other than |0>, on which idle noise
+  /// has an effect.
+  bool used = false;
+  /// Whether the last operation on the qubit is a measurement.
+  bool measured = false;
+  bool deallocated = false;
+};
+
+class AddIdleNoisePass
+    : public cudaq::opt::impl::AddIdleNoiseBase<AddIdleNoisePass> {
+public:
+  using AddIdleNoiseBase::AddIdleNoiseBase;
+
+  void runOnOperation() override {
+    auto func = getOperation();
+    if (func.empty())
+      return;
+    qubits.clear();
+    registers.clear();
+    keys.clear();
+    probabilities.clear();
+    if (t1 < 0.0 || t2 < 0.0 || (t1 > 0.0 && t2 > 2.0 * t1)) {
+      func.emitError("invalid coherence times: T2 must not exceed 2 * T1");
+      signalPassFailure();
+      return;
+    }
+    if (failed(parseDurations(func))) {
+      signalPassFailure();
+      return;
+    }
+    // The rate of pure dephasing, 1 / T_phi = 1 / T2 - 1 / (2 * T1).
+    dephasingRate = t2 > 0.0 ? 1.0 / t2 - (t1 > 0.0 ? 0.5 / t1 : 0.0) : 0.0;
+    if (t1 == 0.0 && dephasingRate <= 0.0)
+      return;
+    if (!func.getBody().hasOneBlock()) {
+      LLVM_DEBUG(llvm::dbgs() << "unstructured control flow\n");
+      return;
+    }
+
+    Block &body = func.getBody().front();
+    entryBuilder = OpBuilder::atBlockBegin(&body);
+    Operation *lastOp = nullptr;
+    for (Operation &op : llvm::make_early_inc_range(body)) {
+      if (op.hasTrait<OpTrait::IsTerminator>())
+        break;
+      if (schedule(op))
+        lastOp = &op;
+    }
+
+    // All the qubits are measured together at the end of the kernel, so the
+    // qubits which are neither measured nor released are idle until then.
+    if (!lastOp)
+      return;
+    double makespan = 0.0;
+    for (auto &qubit : qubits)
+      makespan = std::max(makespan, qubit.availableAt);
+    OpBuilder builder(lastOp->getContext());
+    builder.setInsertionPointAfter(lastOp);
+    for (auto &qubit : qubits)
+      if (qubit.used && !qubit.measured && !qubit.deallocated)
+        insertIdleNoise(builder, lastOp->getLoc(), qubit,
+                        makespan - qubit.availableAt);
+  }
+
+private:
+  LogicalResult parseDurations(func::FuncOp func) {
+    for (StringRef entry : gateDurations) {
+      auto [name, value] = entry.split(':');
+      double duration;
+      if (name.empty() || value.getAsDouble(duration) || duration < 0.0) {
+        func.emitError("invalid gate duration '" + entry +
+                       "', expected <gate>:<duration>");
+        return failure();
+      }
+      durations[name] = duration;
+    }
+    return success();
+  }
+
+  double getDuration(StringRef name) const {
+    auto iter = durations.find(name);
+    return iter == durations.end() ? defaultDuration : iter->second;
+  }
+
+  /// Update the schedule with \p op, inserting the idle noise of its qubits
+  /// before it. Returns true if \p op is a quantum operation.
+  bool schedule(Operation &op) {
+    if (auto alloca = dyn_cast<quake::AllocaOp>(op)) {
+      addAllocation(alloca);
+      return true;
+    }
+    if (auto dealloc = dyn_cast<quake::DeallocOp>(op)) {
+      if (auto ids = getQubits(dealloc.getReference()))
+        for (auto id : *ids)
+          qubits[id].deallocated = true;
+      return false;
+    }
+    if (isa<quake::ExtractRefOp, quake::SubVeqOp, quake::RelaxSizeOp,
+            quake::ConcatOp, quake::DiscriminateOp, quake::ApplyNoiseOp>(op))
+      return false;
+    if (auto gate = dyn_cast<quake::OperatorInterface>(op)) {
+      scheduleGate(gate);
+      return true;
+    }
+    if (isa<quake::ResetOp>(op) || isa<quake::MeasurementInterface>(op)) {
+      bool isMeasurement = isa<quake::MeasurementInterface>(op);
+      SmallVector<std::size_t> ids;
+      for (auto operand : op.getOperands()) {
+        if (!isa<quake::RefType, quake::VeqType>(operand.getType()))
+          continue;
+        auto operandIds = getQubits(operand);
+        if (!operandIds) {
+          synchronize();
+          return true;
+        }
+        ids.append(operandIds->begin(), operandIds->end());
+      }
+      // Each qubit is measured, respectively reset, on its own.
+      auto name = op.getName().stripDialect();
+      OpBuilder builder(&op);
+      for (auto id : ids) {
+        place(builder, op.getLoc(), id, getDuration(name));
+        qubits[id].measured = isMeasurement;
+        // A reset qubit is in state |0> until its next operation.
+        qubits[id].used = isMeasurement;
+      }
+      return true;
+    }
+    // The duration of calls and control flow is unknown, and so is the time
+    // each qubit is idle during them. All the qubits are available after them.
+    if (op.getNumRegions() || isa<CallOpInterface>(op) ||
+        isa_and_nonnull<quake::QuakeDialect>(op.getDialect())) {
+      synchronize();
+      return true;
+    }
+    return false;
+  }
+
+  void scheduleGate(quake::OperatorInterface gate) {
+    SmallVector<std::size_t> controls;
+    for (auto control : gate.getControls()) {
+      auto ids = getQubits(control);
+      if (!ids)
+        return synchronize();
+      controls.append(ids->begin(), ids->end());
+    }
+    SmallVector<std::size_t> targets;
+    for (auto target : gate.getTargets()) {
+      auto ids = getQubits(target);
+      if (!ids)
+        return synchronize();
+      targets.append(ids->begin(), ids->end());
+    }
+
+    std::string name = gate->getName().stripDialect().str();
+    if (gate.isAdj() && isa<quake::SOp, quake::TOp>(gate.getOperation()))
+      name += "dg";
+    name.insert(0, controls.size(), 'c');
+    const double duration = getDuration(name);
+    OpBuilder builder(gate);
+    auto loc = gate.getLoc();
+
+    // A single-qubit gate applied to a `veq` is applied to each of its
+    // qubits in parallel.
+    if (controls.empty() && gate.getTargets().size() == 1 &&
+        isa<quake::VeqType>(gate.getTargets()[0].getType())) {
+      for (auto id : targets)
+        place(builder, loc, id, duration);
+      return;
+    }
+    controls.append(targets);
+    place(builder, loc, controls, duration);
+  }
+
+  /// Schedule an operation of \p duration on the qubits \p ids as soon as all
+  /// of them are available, and insert the noise of the qubits waiting for the
+  /// others with \p builder. Inserting the noise of a qubit only before its
+  /// next operation makes a single channel of each idle window, however many
+  /// layers of the circuit it spans.
+  void place(OpBuilder &builder, Location loc, ArrayRef<std::size_t> ids,
+             double duration) {
+    double start = 0.0;
+    for (auto id : ids)
+      start = std::max(start, qubits[id].availableAt);
+    for (auto id : ids) {
+      auto &qubit = qubits[id];
+      if (qubit.used)
+        insertIdleNoise(builder, loc, qubit, start - qubit.availableAt);
+      qubit.availableAt = start + duration;
+      qubit.used = true;
+      qubit.measured = false;
+    }
+  }
+
+  /// Make all the qubits available at the same time, without noise.
+  void synchronize() {
+    double makespan = 0.0;
+    for (auto &qubit : qubits)
+      makespan = std::max(makespan, qubit.availableAt);
+    for (auto &qubit : qubits) {
+      qubit.availableAt = makespan;
+      qubit.used = true;
+    }
+  }
+
+  void addAllocation(quake::AllocaOp alloca) {
+    auto result = alloca.getResult();
+    if (isa<quake::RefType>(result.getType())) {
+      registers[result] = {qubits.size(), 1};
+      qubits.push_back({result, std::nullopt});
+      return;
+    }
+    auto veqTy = dyn_cast<quake::VeqType>(result.getType());
+    std::optional<std::size_t> size;
+    if (veqTy && veqTy.hasSpecifiedSize())
+      size = veqTy.getSize();
+    else if (alloca.getSize())
+      size = cudaq::opt::factory::maybeValueOfIntConstant(alloca.getSize());
+    if (!size)
+      return;
+    registers[result] = {qubits.size(), *size};
+    for (std::size_t i = 0; i < *size; ++i)
+      qubits.push_back({result, i});
+  }
+
+  /// Returns the qubits of the `!quake.ref` or `!quake.veq` \p v, if they are
+  /// known at compilation time.
+  std::optional<SmallVector<std::size_t>> getQubits(Value v) {
+    auto iter = registers.find(v);
+    if (iter != registers.end()) {
+      auto [first, size] = iter->second;
+      SmallVector<std::size_t> ids(size);
+      std::iota(ids.begin(), ids.end(), first);
+      return ids;
+    }
+    if (auto extract = v.getDefiningOp<quake::ExtractRefOp>()) {
+      auto veq = registers.find(extract.getVeq());
+      if (veq == registers.end() || !extract.hasConstantIndex() ||
+          extract.getConstantIndex() >= veq->second.second)
+        return std::nullopt;
+      return SmallVector<std::size_t>{veq->second.first +
+                                      extract.getConstantIndex()};
+    }
+    if (auto relax = v.getDefiningOp<quake::RelaxSizeOp>())
+      return getQubits(relax.getInputVec());
+    if (auto concat = v.getDefiningOp<quake::ConcatOp>()) {
+      SmallVector<std::size_t> ids;
+      for (auto qubit : concat.getQbits()) {
+        auto qubitIds = getQubits(qubit);
+        if (!qubitIds)
+          return std::nullopt;
+        ids.append(qubitIds->begin(), qubitIds->end());
+      }
+      return ids;
+    }
+    return std::nullopt;
+  }
+
+  void insertIdleNoise(OpBuilder &builder, Location loc, Qubit &qubit,
+                       double idle) {
+    if (idle <= 0.0)
+      return;
+    auto *ctx = builder.getContext();
+    Value ref = qubit.allocation;
+    if (qubit.index)
+      ref = builder.create<quake::ExtractRefOp>(loc, ref, *qubit.index);
+    // The runtime applies a Kraus channel to the qubits of a single `veq`.
+    Value veq = builder.create<quake::ConcatOp>(
+        loc, quake::VeqType::get(ctx, 1), ValueRange{ref});
+    if (t1 > 0.0) {
+      // The population of |1> decays as exp(-t / T1).
+      builder.create<quake::ApplyNoiseOp>(
+          loc, getKey("amplitude_damping"),
+          ValueRange{getProbability(-std::expm1(-idle / t1))}, veq);
+      ++numChannels;
+    }
+    if (dephasingRate > 0.0) {
+      // The coherences decay as exp(-t / T_phi), i.e., by sqrt(1 - p).
+      builder.create<quake::ApplyNoiseOp>(
+          loc, getKey("phase_damping"),
+          ValueRange{getProbability(-std::expm1(-2.0 * idle * dephasingRate))},
+          veq);
+      ++numChannels;
+    }
+  }
+
+  /// Returns the key of the Kraus channel \p name, created once at the entry
+  /// of the kernel.
+  Value getKey(StringRef name) {
+    auto &key = keys[name];
+    if (!key)
+      key = entryBuilder.create<arith::ConstantIntOp>(
+          getOperation().getLoc(), getKrausChannelKey(name), 64);
+    return key;
+  }
+
+  /// Returns a pointer to the channel parameter \p probability. Each value is
+  /// stored once at the entry of the kernel and shared by all the channels
+  /// using it, e.g., by the qubits idle for the same time in a layer.
+  Value getProbability(double probability) {
+    auto &ptr = probabilities[probability];
+    if (!ptr) {
+      auto loc = getOperation().getLoc();
+      auto f64Ty = entryBuilder.getF64Type();
+      ptr = entryBuilder.create<cudaq::cc::AllocaOp>(loc, f64Ty);
+      entryBuilder.create<cudaq::cc::StoreOp>(
+          loc,
+          cudaq::opt::factory::createF64Constant(loc, entryBuilder,
+                                                 probability),
+          ptr);
+    }
+    return ptr;
+  }
+
+  llvm::StringMap<double> durations;
+  double dephasingRate = 0.0;
+  SmallVector<Qubit> qubits;
+  /// The first qubit and number of qubits of each allocation.
+  DenseMap<Value, std::pair<std::size_t, std::size_t>> registers;
+  OpBuilder entryBuilder{static_cast<MLIRContext *>(nullptr)};
+  llvm::StringMap<Value> keys;
+  std::map<double, Value> probabilities;
+};
+} // namespace
@@ -8,10 +8,12 @@
 
 #include "PassDetails.h"
 #include "cudaq/Optimizer/Builder/Runtime.h"
+#include "cudaq/Optimizer/Dialect/CC/CCOps.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
 #include "llvm/Support/Debug.h"
 #include "mlir/IR/Diagnostics.h"
 #include "mlir/IR/Operation.h"
+#include "mlir/IR/SymbolTable.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "mlir/Transforms/Passes.h"
@@ -19,6 +21,7 @@
 namespace cudaq::opt {
 #define GEN_PASS_DEF_CONVERTTODIRECTCALLS
 #define GEN_PASS_DEF_CHECKKERNELCALLS
+#define GEN_PASS_DEF_INLININGBUDGET
 #include "cudaq/Optimizer/Transforms/Passes.h.inc"
 } // namespace cudaq::opt
 
@@ -99,6 +102,79 @@ public:
   }
 };
 
+/// Bound the growth of the module by the inliner. The calls which would inline
+/// beyond the budget are rewritten to `cc.noinline_call` ops, so the inliner
+/// leaves them in place.
+class InliningBudget
+    : public cudaq::opt::impl::InliningBudgetBase<InliningBudget> {
+public:
+  using InliningBudgetBase::InliningBudgetBase;
+
+  void runOnOperation() override {
+    if (!maxInlinedOps)
+      return;
+    ModuleOp module = getOperation();
+    SymbolTable symbolTable(module);
+    std::size_t remaining = maxInlinedOps;
+    DenseMap<Operation *, std::optional<std::size_t>> sizes;
+    for (auto func : module.getOps<func::FuncOp>())
+      (void)inlinedSize(func, symbolTable, sizes, remaining);
+  }
+
+  /// Returns the number of operations \p func expands to once its calls are
+  /// inlined, deciding first which calls of its callees, then which of its own
+  /// calls, fit in the \p remaining budget. The callees of the latter are
+  /// visited first, so the cheapest calls are inlined.
+  static std::size_t
+  inlinedSize(func::FuncOp func, SymbolTable &symbolTable,
+              DenseMap<Operation *, std::optional<std::size_t>> &sizes,
+              std::size_t &remaining) {
+    auto iter = sizes.find(func);
+    if (iter != sizes.end())
+      return iter->second.value_or(0);
+    // Mark the function as being visited to detect the cycles.
+    sizes[func] = std::nullopt;
+
+    std::size_t size = 0;
+    SmallVector<std::pair<std::size_t, func::CallOp>> calls;
+    func.walk([&](Operation *op) {
+      ++size;
+      auto call = dyn_cast<func::CallOp>(op);
+      if (!call)
+        return;
+      auto callee = symbolTable.lookup<func::FuncOp>(call.getCallee());
+      if (!callee || callee.empty())
+        return;
+      auto calleeIter = sizes.find(callee);
+      if (calleeIter != sizes.end() && !calleeIter->second)
+        return;
+      calls.emplace_back(inlinedSize(callee, symbolTable, sizes, remaining),
+                         call);
+    });
+
+    llvm::stable_sort(calls, [](const auto &a, const auto &b) {
+      return a.first < b.first;
+    });
+    for (auto [cost, call] : calls) {
+      if (cost <= remaining) {
+        remaining -= cost;
+        size = llvm::SaturatingAdd(size, cost);
+        continue;
+      }
+      LLVM_DEBUG(llvm::dbgs() << "Keeping call to " << call.getCallee()
+                              << " of cost " << cost << '\n');
+      OpBuilder builder(call);
+      auto noInline = builder.create<cudaq::cc::NoInlineCallOp>(
+          call.getLoc(), call.getResultTypes(), call.getCallee(),
+          call.getOperands());
+      call.replaceAllUsesWith(noInline.getResults());
+      call.erase();
+    }
+    sizes[func] = size;
+    return size;
+  }
+};
+
 /// Check that all calls to quantum kernels have been inlined. This pass is
 /// deprecated.
 class CheckKernelCalls
@@ -136,14 +212,18 @@ static void defaultInlinerOptPipeline(OpPassManager &pm) {
 
 /// Run the passes in the correct order.
 /// 1) Convert calls between kernels to direct calls (on the QPU).
-/// 2) Aggressively inline all calls.
-/// 3) Detect if kernel inlining has failed and left behind calls to kernels.
+/// 2) If there is a code size budget, keep the calls beyond that budget.
+/// 3) Aggressively inline all (other) calls.
+/// 4) Detect if kernel inlining has failed and left behind calls to kernels.
 /// Such a failure is most likely a sign that there is a cycle in the call
 /// graph. [This check is a bad idea: this should be deferred to final codegen
 /// when translating the final Quake IR.]
-void cudaq::opt::addAggressiveInlining(OpPassManager &pm, bool fatalChecks) {
+void cudaq::opt::addAggressiveInlining(OpPassManager &pm, bool fatalChecks,
+                                       unsigned maxInlinedOps) {
   llvm::StringMap<OpPassManager> opPipelines;
   pm.addPass(cudaq::opt::createConvertToDirectCalls());
+  if (maxInlinedOps)
+    pm.addPass(cudaq::opt::createInliningBudget({maxInlinedOps}));
   pm.addPass(createInlinerPass(opPipelines, defaultInlinerOptPipeline));
   pm.addNestedPass<func::FuncOp>(cudaq::opt::createEraseVectorCopyCtor());
   if (fatalChecks)
@@ -159,6 +239,11 @@ struct AggressiveInliningPipelineOptions
       *this, "fatal-check",
       llvm::cl::desc("run checker and produce fatal errors immediately"),
       llvm::cl::init(false)};
+  PassOptions::Option<unsigned> maxInlinedOps{
+      *this, "max-inlined-ops",
+      llvm::cl::desc("Maximum number of operations inlining may add to the "
+                     "module (0 for no limit)."),
+      llvm::cl::init(0)};
 };
 } // namespace
 
@@ -167,6 +252,6 @@ void cudaq::opt::registerAggressiveInliningPipeline() {
       "aggressive-inlining",
       "Convert calls between kernels to direct calls and inline functions.",
       [](OpPassManager &pm, const AggressiveInliningPipelineOptions &opt) {
-        addAggressiveInlining(pm, opt.runFatalChecker);
+        addAggressiveInlining(pm, opt.runFatalChecker, opt.maxInlinedOps);
       });
 }
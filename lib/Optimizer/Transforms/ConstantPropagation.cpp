@@ -217,6 +217,75 @@ public:
   }
 };
 
+// A load from a constant global array at a constant offset is replaced by the
+// element's value. Large vector arguments are synthesized as constant globals,
+// so this keeps their elements constant as well.
+//
+//   cc.global constant private @g (dense<[1.0, 2.0]> : tensor<2xf64>) :
+//           !cc.array<f64 x 2>
+//   ...
+//   %0 = cc.address_of @g : !cc.ptr<!cc.array<f64 x 2>>
+//   %1 = cc.compute_ptr %0[1] : (!cc.ptr<!cc.array<f64 x 2>>) -> !cc.ptr<f64>
+//   %2 = cc.load %1 : !cc.ptr<f64>
+//   ─────────────────────────────────────────────────────────────────────────
+//   %2 = arith.constant 2.0 : f64
+//
+class ForwardConstantGlobalData : public OpRewritePattern<cudaq::cc::LoadOp> {
+public:
+  using OpRewritePattern::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(cudaq::cc::LoadOp load,
+                                PatternRewriter &rewriter) const override {
+    Type loadTy = load.getType();
+    if (!isa<IntegerType, FloatType>(loadTy))
+      return failure();
+    Value ptrVal = load.getPtrvalue();
+    std::int32_t index = 0;
+    if (auto comp = ptrVal.getDefiningOp<cudaq::cc::ComputePtrOp>()) {
+      if (comp.getNumOperands() != 1 ||
+          comp.getRawConstantIndices().size() != 1)
+        return failure();
+      index = comp.getRawConstantIndices()[0];
+      ptrVal = comp.getBase();
+    }
+    // Look through casts and spans wrapping the address of the global.
+    while (true) {
+      if (auto cast = ptrVal.getDefiningOp<cudaq::cc::CastOp>()) {
+        ptrVal = cast.getValue();
+        continue;
+      }
+      if (auto data = ptrVal.getDefiningOp<cudaq::cc::StdvecDataOp>())
+        if (auto init =
+                data.getStdvec().getDefiningOp<cudaq::cc::StdvecInitOp>()) {
+          ptrVal = init.getBuffer();
+          continue;
+        }
+      break;
+    }
+    auto addr = ptrVal.getDefiningOp<cudaq::cc::AddressOfOp>();
+    if (!addr)
+      return failure();
+    auto global = SymbolTable::lookupNearestSymbolFrom<cudaq::cc::GlobalOp>(
+        load, addr.getGlobalNameAttr());
+    if (!global || !global.getConstant() || !global.getValue())
+      return failure();
+    auto values = dyn_cast<DenseElementsAttr>(*global.getValue());
+    if (!values || values.getElementType() != loadTy || index < 0 ||
+        index >= values.getNumElements())
+      return failure();
+
+    Attribute attr = values.getValues<Attribute>()[index];
+    if (auto intTy = dyn_cast<IntegerType>(loadTy)) {
+      rewriter.replaceOpWithNewOp<arith::ConstantIntOp>(
+          load, cast<IntegerAttr>(attr).getInt(), intTy);
+      return success();
+    }
+    rewriter.replaceOpWithNewOp<arith::ConstantFloatOp>(
+        load, cast<FloatAttr>(attr).getValue(), cast<FloatType>(loadTy));
+    return success();
+  }
+};
+
 class ConstantPropagationPass
     : public cudaq::opt::impl::ConstantPropagationBase<
           ConstantPropagationPass> {
@@ -227,7 +296,8 @@ public:
     auto *ctx = &getContext();
     func::FuncOp func = getOperation();
     RewritePatternSet patterns(ctx);
-    patterns.insert<ForwardSingleDimensionData, ForwardConstSubArray>(ctx);
+    patterns.insert<ForwardSingleDimensionData, ForwardConstSubArray,
+                    ForwardConstantGlobalData>(ctx);
 
     LLVM_DEBUG(llvm::dbgs() << "Before constant prop:\n" << func << '\n');
 
@@ -0,0 +1,230 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Builder/Factory.h"
+#include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include <cmath>
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_GATECANCELLATION
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "gate-cancellation"
+
+using namespace mlir;
+
+namespace {
+/// The basis in which a gate is diagonal on one of its qubits.
+enum class Basis { None, X, Y, Z };
+
+/// How two gates on the same qubits can be combined.
+enum class Combination { None, Cancel, Merge };
+} // namespace
+
+/// Returns true if all the controls and targets of \p op are wires. Gates with
+/// `!quake.control` values are not threaded, so they are not handled.
+static bool hasOnlyWires(quake::OperatorInterface op) {
+  auto isWire = [](Value v) { return isa<quake::WireType>(v.getType()); };
+  return llvm::all_of(op.getControls(), isWire) &&
+         llvm::all_of(op.getTargets(), isWire);
+}
+
+/// Returns the controls followed by the targets of \p op. The `n`-th result of
+/// a gate in value-semantics form is the wire threaded from its `n`-th value.
+static SmallVector<Value> getQuantumOperands(quake::OperatorInterface op) {
+  SmallVector<Value> result(op.getControls().begin(), op.getControls().end());
+  result.append(op.getTargets().begin(), op.getTargets().end());
+  return result;
+}
+
+static Basis getBasis(quake::OperatorInterface op, unsigned position) {
+  if (position < op.getControls().size())
+    return Basis::Z;
+  Operation *gate = op.getOperation();
+  if (isa<quake::XOp, quake::RxOp>(gate))
+    return Basis::X;
+  if (isa<quake::YOp, quake::RyOp>(gate))
+    return Basis::Y;
+  if (isa<quake::ZOp, quake::SOp, quake::TOp, quake::R1Op, quake::RzOp>(gate))
+    return Basis::Z;
+  return Basis::None;
+}
+
+/// Returns how \p prev can be combined with \p op, assuming they are applied
+/// to the same qubits in the same positions.
+static Combination getCombination(quake::OperatorInterface prev,
+                                  quake::OperatorInterface op) {
+  if (prev->getName() != op->getName() ||
+      prev.getControls().size() != op.getControls().size() ||
+      prev.getTargets().size() != op.getTargets().size() ||
+      prev.getNegatedControls() != op.getNegatedControls())
+    return Combination::None;
+  Operation *gate = op.getOperation();
+  if (isa<quake::XOp, quake::YOp, quake::ZOp, quake::HOp, quake::SwapOp>(gate))
+    return Combination::Cancel;
+  if (isa<quake::SOp, quake::TOp>(gate))
+    return prev.isAdj() != op.isAdj() ? Combination::Cancel
+                                      : Combination::None;
+  if (isa<quake::R1Op, quake::RxOp, quake::RyOp, quake::RzOp>(gate) &&
+      prev.getParameters()[0].getType() == op.getParameters()[0].getType())
+    return Combination::Merge;
+  return Combination::None;
+}
+
+namespace {
+template <typename QOP>
+class CommutingCancellation : public OpRewritePattern<QOP> {
+public:
+  using Base = OpRewritePattern<QOP>;
+
+  CommutingCancellation(MLIRContext *ctx, unsigned window)
+      : Base(ctx), window(window) {}
+
+  LogicalResult matchAndRewrite(QOP qop,
+                                PatternRewriter &rewriter) const override {
+    auto op = cast<quake::OperatorInterface>(qop.getOperation());
+    if (!hasOnlyWires(op) || op.getTargets().empty())
+      return failure();
+
+    // Find a gate to combine with along the first wire, then check that all
+    // the other wires lead back to that same gate.
+    auto prev = lookBack(op, 0, {});
+    if (!prev) {
+      LLVM_DEBUG(llvm::dbgs() << "no gate to combine with: " << qop << '\n');
+      return failure();
+    }
+    for (unsigned i = 1, end = getQuantumOperands(op).size(); i < end; ++i)
+      if (lookBack(op, i, prev) != prev) {
+        LLVM_DEBUG(llvm::dbgs() << "wire " << i << " does not commute back to "
+                                << *prev << '\n');
+        return failure();
+      }
+
+    auto prevWires = getQuantumOperands(prev);
+    if (getCombination(prev, op) == Combination::Cancel) {
+      LLVM_DEBUG(llvm::dbgs() << "eliminated: " << qop << '\n'
+                              << *prev << '\n');
+      rewriter.replaceOp(qop, getQuantumOperands(op));
+      rewriter.replaceOp(prev, prevWires);
+      return success();
+    }
+
+    // Merge the rotation `prev` into `qop`. As in the canonical rotation
+    // merging, subtract the adjoint angle rather than negating it.
+    LLVM_DEBUG(llvm::dbgs() << "merged: " << *prev << '\n'
+                            << "into: " << qop << '\n');
+    auto loc = qop.getLoc();
+    Value angle1 = prev.getParameters()[0];
+    Value angle2 = op.getParameters()[0];
+    bool isAdj = op.isAdj();
+    Value newAngle = [&]() -> Value {
+      if (prev.isAdj() == op.isAdj())
+        return rewriter.create<arith::AddFOp>(loc, angle1, angle2);
+      if (prev.isAdj())
+        return rewriter.create<arith::SubFOp>(loc, angle2, angle1);
+      isAdj = false;
+      return rewriter.create<arith::SubFOp>(loc, angle1, angle2);
+    }();
+    rewriter.updateRootInPlace(qop, [&]() {
+      qop->setOperand(0, newAngle);
+      if (isAdj)
+        qop->setAttr("is_adj", rewriter.getUnitAttr());
+      else
+        qop->removeAttr("is_adj");
+    });
+    rewriter.replaceOp(prev, prevWires);
+    return success();
+  }
+
+private:
+  /// Follow the wire at \p position of \p op back through the gates that
+  /// commute with \p op. Returns the gate that \p op can be combined with,
+  /// if it is found at the same position before any gate that does not
+  /// commute. If \p partner is given, only that gate is accepted.
+  quake::OperatorInterface lookBack(quake::OperatorInterface op,
+                                    unsigned position,
+                                    quake::OperatorInterface partner) const {
+    Value wire = getQuantumOperands(op)[position];
+    auto basis = getBasis(op, position);
+    for (unsigned steps = 0; steps <= window; ++steps) {
+      auto def = wire.getDefiningOp<quake::OperatorInterface>();
+      if (!def || def->getBlock() != op->getBlock() || !hasOnlyWires(def))
+        return {};
+      unsigned resultNumber = cast<OpResult>(wire).getResultNumber();
+      if (resultNumber == position &&
+          (partner ? def == partner
+                   : getCombination(def, op) != Combination::None))
+        return def;
+      if (def == partner || basis == Basis::None ||
+          getBasis(def, resultNumber) != basis)
+        return {};
+      wire = getQuantumOperands(def)[resultNumber];
+    }
+    return {};
+  }
+
+  unsigned window;
+};
+
+/// Erase the rotations by a multiple of \p Period times pi, i.e., by an angle
+/// of 0 up to a full period.
+template <typename QOP, unsigned Period>
+class EraseIdentityRotation : public OpRewritePattern<QOP> {
+public:
+  using OpRewritePattern<QOP>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(QOP qop,
+                                PatternRewriter &rewriter) const override {
+    auto op = cast<quake::OperatorInterface>(qop.getOperation());
+    if (!hasOnlyWires(op))
+      return failure();
+    auto constant =
+        cudaq::opt::factory::getDoubleIfConstant(op.getParameters()[0]);
+    if (!constant)
+      return failure();
+    bool losesInfo = false;
+    constant->convert(APFloat::IEEEdouble(), APFloat::rmNearestTiesToEven,
+                      &losesInfo);
+    const double period = Period * M_PI;
+    double angle = std::fmod(std::abs(constant->convertToDouble()), period);
+    constexpr double tolerance = 1e-12;
+    if (angle > tolerance && period - angle > tolerance)
+      return failure();
+    LLVM_DEBUG(llvm::dbgs() << "erased: " << qop << '\n');
+    rewriter.replaceOp(qop, getQuantumOperands(op));
+    return success();
+  }
+};
+
+#define CANCEL(OP) CommutingCancellation<quake::OP>
+
+class GateCancellationPass
+    : public cudaq::opt::impl::GateCancellationBase<GateCancellationPass> {
+public:
+  using GateCancellationBase::GateCancellationBase;
+
+  void runOnOperation() override {
+    auto *ctx = &getContext();
+    auto func = getOperation();
+    RewritePatternSet patterns(ctx);
+    patterns.insert<GATE_OPS(CANCEL)>(ctx, window);
+    patterns.insert<EraseIdentityRotation<quake::R1Op, 2>,
+                    EraseIdentityRotation<quake::RxOp, 4>,
+                    EraseIdentityRotation<quake::RyOp, 4>,
+                    EraseIdentityRotation<quake::RzOp, 4>>(ctx);
+    if (failed(applyPatternsAndFoldGreedily(func, std::move(patterns))))
+      signalPassFailure();
+  }
+};
+} // namespace
@@ -30,7 +30,9 @@ namespace {
 /// The loop unrolling pass will fully unroll a `cc::LoopOp` when the loop is
 /// known to always execute a constant number of iterations. That is, the loop
 /// is a counted loop. (A threshold value can be used to bound the legal range
-/// of iterations. The default is 50.)
+/// of iterations. The default is 50. Another threshold can bound the number of
+/// operations the loop unrolls into, and a budget the number of operations all
+/// the unrollings add. By default, they are unbounded.)
 class LoopUnrollPass : public cudaq::opt::impl::LoopUnrollBase<LoopUnrollPass> {
 public:
   using LoopUnrollBase::LoopUnrollBase;
@@ -40,6 +42,7 @@ public:
     auto *op = getOperation();
     auto numLoops = countLoopOps(op);
     unsigned progress = 0;
+    std::size_t remainingBudget = unrollBudget;
     if (numLoops) {
       RewritePatternSet patterns(ctx);
       for (auto *dialect : ctx->getLoadedDialects())
@@ -48,7 +51,9 @@ public:
         op.getCanonicalizationPatterns(patterns, ctx);
       patterns.insert<UnrollCountedLoop>(ctx, threshold,
                                          /*signalFailure=*/false, allowBreak,
-                                         progress);
+                                         progress, maxUnrolledOps,
+                                         unrollBudget ? &remainingBudget
+                                                      : nullptr);
       FrozenRewritePatternSet frozen(std::move(patterns));
       // Iterate over the loops until a fixed-point is reached. Some loops can
       // only be unrolled if other loops are unrolled first and the constants
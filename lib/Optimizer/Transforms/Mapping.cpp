@@ -6,16 +6,22 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 
+#include "cudaq/ADT/SubgraphMatcher.h"
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
 #include "cudaq/Support/Device.h"
 #include "cudaq/Support/Placement.h"
+#include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Transforms/TopologicalSortUtils.h"
+#include <numeric>
+#include <random>
 
 #define DEBUG_TYPE "quantum-mapper"
 
@@ -49,6 +55,82 @@ void identityPlacement(Placement &placement) {
     placement.map(Placement::VirtualQ(i), Placement::DeviceQ(i));
 }
 
+/// Place the virtual qubits on distinct device qubits chosen at random.
+void randomPlacement(Placement &placement, std::uint64_t seed) {
+  SmallVector<unsigned> deviceQubits(placement.getNumDeviceQubits());
+  std::iota(deviceQubits.begin(), deviceQubits.end(), 0u);
+  std::mt19937_64 generator(seed);
+  std::shuffle(deviceQubits.begin(), deviceQubits.end(), generator);
+  for (unsigned i = 0, end = placement.getNumVirtualQubits(); i < end; ++i)
+    placement.map(Placement::VirtualQ(i), Placement::DeviceQ(deviceQubits[i]));
+}
+
+/// Place the virtual qubits so that the qubits of every two-qubit operation in
+/// `block` are connected on `device`, which lets routing insert no swaps.
+/// `wireMap` gives the virtual qubit of each wire. The search for such a
+/// placement tries at most `maxCandidates` matches of a virtual qubit. Returns
+/// false, leaving `placement` unchanged, if there is no need for a new
+/// placement or if none was found.
+bool matchingPlacement(Placement &placement, Block &block,
+                       const DenseMap<Value, Placement::VirtualQ> &wireMap,
+                       const Device &device, std::size_t maxCandidates) {
+  // Build the interaction graph of the virtual qubits.
+  llvm::SetVector<std::pair<unsigned, unsigned>> interactions;
+  for (Operation &op : block) {
+    if (!quake::isSupportedMappingOperation(&op) ||
+        op.hasTrait<QuantumMeasure>())
+      continue;
+    auto wireOperands = quake::getQuantumOperands(&op);
+    if (wireOperands.size() != 2)
+      continue;
+    auto q0 = wireMap.lookup(wireOperands[0]);
+    auto q1 = wireMap.lookup(wireOperands[1]);
+    if (!q0.isValid() || !q1.isValid() || q0 == q1)
+      continue;
+    interactions.insert(std::minmax(q0.index, q1.index));
+  }
+  if (llvm::all_of(interactions, [&](auto interaction) {
+        return device.areConnected(
+            placement.getPhy(Placement::VirtualQ(interaction.first)),
+            placement.getPhy(Placement::VirtualQ(interaction.second)));
+      }))
+    return false;
+
+  const unsigned numVirtualQubits = placement.getNumVirtualQubits();
+  cudaq::GraphCSR interactionGraph;
+  for (unsigned i = 0; i < numVirtualQubits; ++i)
+    interactionGraph.createNode();
+  for (auto [q0, q1] : interactions)
+    interactionGraph.addEdge(cudaq::GraphCSR::Node(q0),
+                             cudaq::GraphCSR::Node(q1));
+  auto matches = cudaq::SubgraphMatcher(interactionGraph, device.getTopology())
+                     .match(maxCandidates);
+  if (!matches) {
+    LLVM_DEBUG(llvm::dbgs() << "No placement matching the interaction graph\n");
+    return false;
+  }
+
+  // Place the qubits without interactions on the remaining device qubits,
+  // keeping their identity placement when it is free.
+  Placement matched(numVirtualQubits, placement.getNumDeviceQubits());
+  llvm::BitVector used(placement.getNumDeviceQubits());
+  for (auto [vr, phy] : llvm::enumerate(*matches))
+    if (phy.isValid()) {
+      matched.map(Placement::VirtualQ(vr), phy);
+      used.set(phy.index);
+    }
+  for (auto [vr, phy] : llvm::enumerate(*matches)) {
+    if (phy.isValid())
+      continue;
+    unsigned free =
+        vr < used.size() && !used.test(vr) ? vr : used.find_first_unset();
+    matched.map(Placement::VirtualQ(vr), Placement::DeviceQ(free));
+    used.set(free);
+  }
+  placement = matched;
+  return true;
+}
+
 //===----------------------------------------------------------------------===//
 // Routing
 //===----------------------------------------------------------------------===//
@@ -114,6 +196,9 @@ public:
   /// After routing, this contains the final values for all the qubits
   ArrayRef<Value> getPhyToWire() { return phyToWire; }
 
+  /// After routing, the number of swaps inserted.
+  std::size_t getNumSwaps() const { return numSwaps; }
+
 private:
   void visitUsers(ResultRange::user_range users,
                   SmallVectorImpl<VirtualOp> &layer,
@@ -150,6 +235,8 @@ private:
 
   SmallVector<Value> phyToWire;
 
+  std::size_t numSwaps = 0;
+
   /// Keeps track of how many times an operation was visited.
   DenseMap<Operation *, unsigned> visited;
 
@@ -295,7 +382,7 @@ double SabreRouter::computeLayerCost(ArrayRef<VirtualOp> layer) {
   for (VirtualOp const &virtOp : layer) {
     auto phy0 = placement.getPhy(virtOp.qubits[0]);
     auto phy1 = placement.getPhy(virtOp.qubits[1]);
-    cost += device.getDistance(phy0, phy1) - 1;
+    cost += device.getRoutingCost(phy0, phy1);
   }
   return cost / layer.size();
 }
@@ -391,6 +478,7 @@ void SabreRouter::route(Block &block, ArrayRef<quake::BorrowWireOp> sources) {
         DenseBoolArrayAttr{});
     phyToWire[q0.index] = swap.getResult(0);
     phyToWire[q1.index] = swap.getResult(1);
+    ++numSwaps;
   };
 
   std::size_t numSwapSearches = 0;
@@ -434,6 +522,24 @@ void SabreRouter::route(Block &block, ArrayRef<quake::BorrowWireOp> sources) {
   LLVM_DEBUG(logger.startLine() << '\n' << logLineComment << '\n';);
 }
 
+/// Return the depth of the quantum operations of `block`, which must be
+/// topologically sorted.
+std::size_t computeDepth(Block &block) {
+  DenseMap<Operation *, std::size_t> depths;
+  std::size_t depth = 0;
+  for (Operation &op : block) {
+    if (!quake::isSupportedMappingOperation(&op))
+      continue;
+    std::size_t opDepth = 0;
+    for (auto wire : quake::getQuantumOperands(&op))
+      if (auto *def = wire.getDefiningOp())
+        opDepth = std::max(opDepth, depths.lookup(def));
+    depths[&op] = ++opDepth;
+    depth = std::max(depth, opDepth);
+  }
+  return depth;
+}
+
 std::pair<bool, std::optional<Device>>
 deviceFromString(llvm::StringRef deviceString) {
   std::size_t deviceDim[2];
@@ -601,6 +707,23 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
 
   virtual LogicalResult initialize(MLIRContext *context) override {
     std::tie(deviceBypass, deviceInstance) = deviceFromString(device);
+    auto routingCost =
+        llvm::StringSwitch<std::optional<Device::RoutingCost>>(cost)
+            .Case("distance", Device::RoutingCost::distance)
+            .Case("error", Device::RoutingCost::error)
+            .Case("duration", Device::RoutingCost::duration)
+            .Default(std::nullopt);
+    if (!routingCost) {
+      llvm::errs() << "Unknown routing cost option: " << cost << '\n';
+      if (nonComposable) {
+        signalPassFailure();
+        return failure();
+      }
+      routingCost = Device::RoutingCost::distance;
+    }
+    if (deviceInstance && !deviceInstance->setRoutingCost(*routingCost))
+      LLVM_DEBUG(llvm::dbgs() << "No calibration data for the routing cost "
+                              << cost << ", routing by distance\n");
     if (deviceInstance || deviceBypass || !nonComposable) {
       return success();
     }
@@ -609,6 +732,58 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
     return failure();
   }
 
+  /// Route copies of `func` from `trials` initial placements in parallel:
+  /// `initial`, i.e., the identity or the matching placement, then random ones.
+  /// Return the placement whose routing inserts the fewest swaps, then has the
+  /// least depth, preferring earlier trials on ties so that results are
+  /// deterministic.
+  Placement selectPlacement(func::FuncOp func,
+                            ArrayRef<quake::BorrowWireOp> sources,
+                            const DenseMap<Value, Placement::VirtualQ> &wireMap,
+                            const Placement &initial) {
+    SmallVector<Placement> placements(trials, initial);
+    for (unsigned trial = 1; trial < trials; ++trial) {
+      placements[trial] = Placement(initial.getNumVirtualQubits(),
+                                    initial.getNumDeviceQubits());
+      randomPlacement(placements[trial],
+                      (static_cast<std::uint64_t>(seed) << 32) | trial);
+    }
+
+    SmallVector<std::pair<std::size_t, std::size_t>> costs(trials);
+    parallelForEach(
+        func.getContext(), llvm::seq(0u, static_cast<unsigned>(trials)),
+        [&](unsigned trial) {
+          IRMapping mapping;
+          auto trialFunc = cast<func::FuncOp>(func->clone(mapping));
+          DenseMap<Value, Placement::VirtualQ> trialWireMap;
+          for (auto [wire, virtualQ] : wireMap)
+            trialWireMap.insert({mapping.lookupOrDefault(wire), virtualQ});
+          SmallVector<quake::BorrowWireOp> trialSources;
+          for (auto source : sources)
+            trialSources.push_back(mapping.lookup(source.getResult())
+                                       .getDefiningOp<quake::BorrowWireOp>());
+
+          Block &block = trialFunc.getBody().front();
+          Placement placement = placements[trial];
+          SabreRouter router(*deviceInstance, trialWireMap, placement,
+                             extendedLayerSize, extendedLayerWeight,
+                             decayDelta, roundsDecayReset);
+          router.route(block, trialSources);
+          sortTopologically(&block);
+          costs[trial] = {router.getNumSwaps(), computeDepth(block)};
+          trialFunc.erase();
+        });
+
+    auto best = std::distance(costs.begin(), llvm::min_element(costs));
+    LLVM_DEBUG({
+      for (auto &&[trial, cost] : llvm::enumerate(costs))
+        llvm::dbgs() << "Mapping trial " << trial << ": " << cost.first
+                     << " swaps, depth " << cost.second << '\n';
+      llvm::dbgs() << "Selected mapping trial " << best << '\n';
+    });
+    return placements[best];
+  }
+
   /// Add `op` and all of its users into `opsToMoveToEnd`. `op` may not be
   /// nullptr.
   void addOpAndUsersToList(Operation *op,
@@ -858,6 +1033,12 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
     // Place
     Placement placement(sources.size(), deviceInstance->getNumQubits());
     identityPlacement(placement);
+    if (matchingLimit &&
+        matchingPlacement(placement, block, wireToVirtualQ, *deviceInstance,
+                          matchingLimit))
+      LLVM_DEBUG(llvm::dbgs() << "Placement matching the interaction graph\n");
+    if (trials > 1)
+      placement = selectPlacement(func, sources, wireToVirtualQ, placement);
 
     // Route
     SabreRouter router(*deviceInstance, wireToVirtualQ, placement,
@@ -961,6 +1142,10 @@ struct MappingPipelineOptions
   DECLARE_SUB_OPTION(MappingFuncOptions, extendedLayerWeight);
   DECLARE_SUB_OPTION(MappingFuncOptions, decayDelta);
   DECLARE_SUB_OPTION(MappingFuncOptions, roundsDecayReset);
+  DECLARE_SUB_OPTION(MappingFuncOptions, trials);
+  DECLARE_SUB_OPTION(MappingFuncOptions, seed);
+  DECLARE_SUB_OPTION(MappingFuncOptions, cost);
+  DECLARE_SUB_OPTION(MappingFuncOptions, matchingLimit);
   PassOptions::Option<bool> nonComposable{*this, "raise-fatal-errors"};
 };
 
@@ -988,6 +1173,10 @@ void registerMappingPipeline() {
         setIt(funcOpts.extendedLayerWeight, opt.extendedLayerWeight);
         setIt(funcOpts.decayDelta, opt.decayDelta);
         setIt(funcOpts.roundsDecayReset, opt.roundsDecayReset);
+        setIt(funcOpts.trials, opt.trials);
+        setIt(funcOpts.seed, opt.seed);
+        setIt(funcOpts.cost, opt.cost);
+        setIt(funcOpts.matchingLimit, opt.matchingLimit);
         setIt(funcOpts.nonComposable, opt.nonComposable);
         pm.addNestedPass<func::FuncOp>(cudaq::opt::createMappingFunc(funcOpts));
       });
@@ -7,12 +7,14 @@
  ******************************************************************************/
 
 #include "PassDetails.h"
+#include "cudaq/Optimizer/Builder/Factory.h"
 #include "cudaq/Optimizer/Dialect/CC/CCOps.h"
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "mlir/Transforms/Passes.h"
+#include <cmath>
 
 namespace cudaq::opt {
 #define GEN_PASS_DEF_PHASEFOLDING
@@ -57,7 +59,15 @@ static bool isSupportedValue(Value ref) {
   return true;
 }
 
-static bool isCircuitBreaker(Operation *op) {
+/// Returns true if \p op is one of the uncontrolled phase gates folded in
+/// Clifford+T mode: `t`, `s`, `z`, and `r1`.
+static bool isPhaseGate(Operation *op) {
+  if (!isa<quake::TOp, quake::SOp, quake::ZOp, quake::R1Op>(op))
+    return false;
+  return cast<quake::OperatorInterface>(op).getControls().empty();
+}
+
+static bool isCircuitBreaker(Operation *op, bool cliffordT) {
   // TODO: it may be cleaner to only accept non-null input to
   // ensure the null case is explicitly handled by users
   if (!op)
@@ -66,6 +76,9 @@ static bool isCircuitBreaker(Operation *op) {
   if (!isQuakeOperation(op))
     return true;
 
+  if (cliffordT && isPhaseGate(op))
+    return !isSupportedValue(quake::getQuantumOperands(op)[0]);
+
   if (isa<RAW_CIRCUIT_BREAKERS, quake::NullWireOp>(op))
     return true;
 
@@ -162,8 +175,8 @@ protected:
   bool isTerminationPoint(Operation *op) {
     // Currently, each operation can only be part of one subcircuit (hence the
     // check for the processed flag)
-    return (op->getBlock() != start->getBlock()) || isCircuitBreaker(op) ||
-           container->wasProcessed(op);
+    return (op->getBlock() != start->getBlock()) ||
+           isCircuitBreaker(op, cliffordT) || container->wasProcessed(op);
   }
 
   class NetlistWrapper {
@@ -277,6 +290,7 @@ protected:
   SmallVector<Operation *> ordered_ops = {};
   Operation *start = nullptr;
   size_t num_rot_gates = 0;
+  bool cliffordT = false;
 
   void allocWrapper(Value ref, Operation *anchor_point) {
     auto nlindex = container->getIndexOf(ref);
@@ -352,8 +366,11 @@ public:
   /// along each qubit, and walk forward, adjusting the termination boundary for
   /// any connected qubits, and removing gates after the termination
   /// boundary from the subcircuit.
-  Subcircuit(Operation *cnot, Netlist *netlist)
-      : container(netlist), start(cnot) {
+  ///
+  /// If `cliffordT` is set, the subcircuit may also contain the phase gates
+  /// `t`, `s`, `z`, and `r1`.
+  Subcircuit(Operation *cnot, Netlist *netlist, bool cliffordT)
+      : container(netlist), start(cnot), cliffordT(cliffordT) {
     assert(isCNOT(cnot));
     qubits = SmallVector<NetlistWrapper *>(netlist->size(), nullptr);
     calculateInitialSubcircuit();
@@ -541,6 +558,154 @@ public:
   size_t getNumCombined() { return numCombined; }
 };
 
+/// Returns the angle of the phase gate \p op as a multiple of pi/4, if it is
+/// one.
+static std::optional<std::int64_t> getPiOver4Multiple(Operation *op) {
+  auto opi = cast<quake::OperatorInterface>(op);
+  std::int64_t sign = opi.isAdj() ? -1 : 1;
+  if (isa<quake::TOp>(op))
+    return sign;
+  if (isa<quake::SOp>(op))
+    return 2 * sign;
+  if (isa<quake::ZOp>(op))
+    return 4;
+  auto angle = cudaq::opt::factory::getDoubleIfConstant(opi.getParameters()[0]);
+  if (!angle)
+    return std::nullopt;
+  bool losesInfo = false;
+  angle->convert(APFloat::IEEEdouble(), APFloat::rmNearestTiesToEven,
+                 &losesInfo);
+  double multiple = sign * angle->convertToDouble() / M_PI_4;
+  double rounded = std::round(multiple);
+  if (std::abs(multiple - rounded) > 1e-9)
+    return std::nullopt;
+  return static_cast<std::int64_t>(rounded);
+}
+
+template <typename OP>
+static void createGate(OpBuilder &builder, Location loc, Value target,
+                       bool isAdj = false) {
+  builder.create<OP>(loc, isAdj, ValueRange{}, ValueRange{}, target);
+}
+
+/// Creates the phase gate of angle \p multiple times pi/4 on \p target with
+/// the fewest Clifford+T gates, i.e., with one T gate exactly when \p multiple
+/// is odd.
+static void createCliffordTPhase(OpBuilder &builder, Location loc,
+                                 std::int64_t multiple, Value target) {
+  switch (((multiple % 8) + 8) % 8) {
+  case 1:
+    createGate<quake::TOp>(builder, loc, target);
+    break;
+  case 2:
+    createGate<quake::SOp>(builder, loc, target);
+    break;
+  case 3:
+    createGate<quake::SOp>(builder, loc, target);
+    createGate<quake::TOp>(builder, loc, target);
+    break;
+  case 4:
+    createGate<quake::ZOp>(builder, loc, target);
+    break;
+  case 5:
+    createGate<quake::ZOp>(builder, loc, target);
+    createGate<quake::TOp>(builder, loc, target);
+    break;
+  case 6:
+    createGate<quake::SOp>(builder, loc, target, /*isAdj=*/true);
+    break;
+  case 7:
+    createGate<quake::TOp>(builder, loc, target, /*isAdj=*/true);
+    break;
+  default:
+    break;
+  }
+}
+
+/// Collects the phase gates of a subcircuit by phase. Since the phase gates
+/// `t`, `s`, `z`, and `r1` all apply a phase to the |1> state, the gates at
+/// the same phase add up to a single phase gate, which is resynthesized into
+/// the fewest Clifford+T gates.
+class PhaseGateStorage {
+  SmallVector<std::pair<Phase, SmallVector<Operation *>>> groups;
+
+  /// Replaces the gates of a group by a phase gate at the last of them, which
+  /// (like for the rotations) ensures that all the angles are available.
+  void resynthesize(ArrayRef<Operation *> ops) {
+    auto *last = ops.back();
+    auto loc = last->getLoc();
+    Value target = cast<quake::OperatorInterface>(last).getTarget(0);
+    OpBuilder builder(last);
+
+    std::optional<std::int64_t> multiple = 0;
+    for (auto *op : ops) {
+      auto m = getPiOver4Multiple(op);
+      if (!m) {
+        multiple = std::nullopt;
+        break;
+      }
+      *multiple += *m;
+    }
+
+    if (multiple) {
+      createCliffordTPhase(builder, loc, *multiple, target);
+    } else {
+      // Some angle is not a multiple of pi/4, merge into one `r1`.
+      auto f64Ty = builder.getF64Type();
+      Value sum;
+      for (auto *op : ops) {
+        Value angle;
+        if (auto r1 = dyn_cast<quake::R1Op>(op)) {
+          angle = r1.getParameter();
+          if (angle.getType() != f64Ty)
+            angle = builder.create<arith::ExtFOp>(loc, f64Ty, angle);
+          if (r1.isAdj())
+            angle = builder.create<arith::NegFOp>(loc, angle);
+        } else {
+          angle = cudaq::opt::factory::createF64Constant(
+              loc, builder, *getPiOver4Multiple(op) * M_PI_4);
+        }
+        sum = sum ? builder.create<arith::AddFOp>(loc, sum, angle).getResult()
+                  : angle;
+      }
+      builder.create<quake::R1Op>(loc, ValueRange{sum}, ValueRange{}, target);
+    }
+
+    for (auto *op : ops)
+      op->erase();
+  }
+
+public:
+  void addPhaseGate(Operation *op, Phase phase) {
+    for (auto &[p, ops] : groups)
+      if (p == phase) {
+        ops.push_back(op);
+        return;
+      }
+    groups.push_back({phase, {op}});
+  }
+
+  /// @brief Resynthesizes each group of two or more phase gates
+  void resynthesize() {
+    for (auto &group : groups)
+      if (group.second.size() > 1)
+        resynthesize(group.second);
+  }
+};
+
+/// Counts the T gates (`t` and `t<adj>`) and CNOTs in \p func.
+static std::pair<std::size_t, std::size_t> countTAndCNOTs(func::FuncOp func) {
+  std::size_t numT = 0;
+  std::size_t numCNOT = 0;
+  func.walk([&](Operation *op) {
+    if (isa<quake::TOp>(op))
+      numT++;
+    else if (isCNOT(op))
+      numCNOT++;
+  });
+  return {numT, numCNOT};
+}
+
 class PhaseFoldingPass
     : public cudaq::opt::impl::PhaseFoldingBase<PhaseFoldingPass> {
   using PhaseFoldingBase::PhaseFoldingBase;
@@ -550,6 +715,7 @@ class PhaseFoldingPass
     SmallVector<PhaseVariable *> phase_vars;
     SmallVector<Phase> current_phases;
     PhaseStorage store;
+    PhaseGateStorage phaseGates;
     size_t i = 0;
     // Initialize the phases and phase variables for each qubit in the circuit,
     // the initial phase contains only the phase variable for that qubit
@@ -604,6 +770,9 @@ class PhaseFoldingPass
         auto target = op->getOperand(1);
         auto target_phase = getPhase(target);
         store.addOrCombineRotationForPhase(rzop, target_phase);
+      } else if (cliffordT && isPhaseGate(op)) {
+        auto target = cast<quake::OperatorInterface>(op).getTarget(0);
+        phaseGates.addPhaseGate(op, getPhase(target));
       } else if (auto swap = dyn_cast<quake::SwapOp>(op)) {
         // Swap phases
         auto target1 = op->getOperand(0);
@@ -614,6 +783,7 @@ class PhaseFoldingPass
         setPhase(target2, target1_phase);
       }
     }
+    phaseGates.resynthesize();
 
     for (auto phase_var : phase_vars)
       delete phase_var;
@@ -622,6 +792,9 @@ class PhaseFoldingPass
 public:
   void runOnOperation() override {
     auto func = getOperation();
+    auto [numTBefore, numCNOTBefore] = countTAndCNOTs(func);
+    numTGatesBefore += numTBefore;
+    numCNOTsBefore += numCNOTBefore;
     mlir::DefaultTimingManager tm;
     tm.setEnabled(false);
     auto root = tm.getRootTimer();
@@ -646,7 +819,7 @@ public:
         return;
 
       // Build a subcircuit from the CNOT
-      auto subcircuit = new Subcircuit(op, &nl);
+      auto subcircuit = new Subcircuit(op, &nl, cliffordT);
       // Ensure we're above thresholds
       if (subcircuit->getNumOps() < minimumBlockLength ||
           subcircuit->getRotationWeight() < minimumrzWeight) {
@@ -674,6 +847,10 @@ public:
 
     root.stop();
     tm.setDisplayMode(mlir::DefaultTimingManager::DisplayMode::Tree);
+
+    auto [numTAfter, numCNOTAfter] = countTAndCNOTs(func);
+    numTGatesAfter += numTAfter;
+    numCNOTsAfter += numCNOTAfter;
   }
 };
 
@@ -690,6 +867,11 @@ struct PhaseFoldingPipelineOptions
       llvm::cl::desc("Minimumn percentage of rz ops in subcircuit to run phase "
                      "folding. (default: 0.2)"),
       llvm::cl::init(0.2)};
+  PassOptions::Option<bool> cliffordT{
+      *this, "clifford-t",
+      llvm::cl::desc("Also fold and resynthesize the t, s, z, and r1 gates. "
+                     "(default: false)"),
+      llvm::cl::init(false)};
 };
 } // namespace
 
@@ -698,11 +880,11 @@ struct PhaseFoldingPipelineOptions
 /// expanded to eliminate control flow. This pipeline will raise an error if any
 /// loop in the module cannot be fully unrolled and signalFailure is set.
 static void createPhaseFoldingPipeline(OpPassManager &pm, unsigned min_length,
-                                       double min_rz_weight) {
+                                       double min_rz_weight, bool clifford_t) {
   pm.addNestedPass<func::FuncOp>(cudaq::opt::createFactorQuantumAllocations());
   pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
   pm.addNestedPass<func::FuncOp>(createCSEPass());
-  cudaq::opt::PhaseFoldingOptions pfo{min_length, min_rz_weight};
+  cudaq::opt::PhaseFoldingOptions pfo{min_length, min_rz_weight, clifford_t};
   pm.addNestedPass<func::FuncOp>(cudaq::opt::createPhaseFolding(pfo));
   pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
   pm.addNestedPass<func::FuncOp>(cudaq::opt::createCombineQuantumAllocations());
@@ -714,6 +896,6 @@ void cudaq::opt::registerPhaseFoldingPipeline() {
       "Performs the phase-polynomial based rotation merging optimization.",
       [](OpPassManager &pm, const PhaseFoldingPipelineOptions &pfpo) {
         createPhaseFoldingPipeline(pm, pfpo.minimumBlockLength,
-                                   pfpo.minimumrzWeight);
+                                   pfpo.minimumrzWeight, pfpo.cliffordT);
       });
 }
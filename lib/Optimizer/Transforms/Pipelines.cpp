@@ -29,6 +29,14 @@ struct TargetPrepPipelineOptions
       llvm::cl::init(false)};
 };
 
+struct TargetDeployPipelineOptions
+    : public PassPipelineOptions<TargetDeployPipelineOptions> {
+  PassOptions::Option<bool> gateCancellation{
+      *this, "gate-cancellation",
+      llvm::cl::desc("Cancel and merge gates across commuting gates."),
+      llvm::cl::init(true)};
+};
+
 struct TargetFinalizationPipelineOptions
     : public PassPipelineOptions<TargetFinalizationPipelineOptions> {
   PassOptions::Option<bool> allowBreaksInLoops{
@@ -121,21 +129,38 @@ void cudaq::opt::addDecompositionPass(OpPassManager &pm,
   pm.addPass(cudaq::opt::createDecompositionPass(opts));
 }
 
-static void createTargetDeployPipeline(OpPassManager &pm) {
+static void
+createTargetDeployPipeline(OpPassManager &pm,
+                           const TargetDeployPipelineOptions &options) {
   cudaq::opt::createClassicalOptimizationPipeline(pm);
   cudaq::opt::addDecompositionPass(pm, {std::string("U3ToRotations")});
   pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
   pm.addNestedPass<func::FuncOp>(
       cudaq::opt::createMultiControlDecompositionPass());
+  if (options.gateCancellation) {
+    // The gate cancellation works on wires, so convert the qubits to wires
+    // and back.
+    pm.addNestedPass<func::FuncOp>(
+        cudaq::opt::createFactorQuantumAllocations());
+    pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
+    pm.addNestedPass<func::FuncOp>(cudaq::opt::createQuantumMemToReg());
+    pm.addNestedPass<func::FuncOp>(cudaq::opt::createGateCancellation());
+    pm.addNestedPass<func::FuncOp>(cudaq::opt::createRegToMem());
+    pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
+    pm.addNestedPass<func::FuncOp>(
+        cudaq::opt::createCombineQuantumAllocations());
+  }
 }
 
 /// Register the standard deployment pipeline run for ALL target machines. This
 /// pipeline is run between the mid-level and low-level target-specific
 /// pipelines.
 static void registerTargetDeployPipeline() {
-  PassPipelineRegistration<>(
+  PassPipelineRegistration<TargetDeployPipelineOptions>(
       "jit-deploy-pipeline", "Standard deployment pipeline for all targets.",
-      [](OpPassManager &pm) { ::createTargetDeployPipeline(pm); });
+      [](OpPassManager &pm, const TargetDeployPipelineOptions &options) {
+        ::createTargetDeployPipeline(pm, options);
+      });
 }
 
 void cudaq::opt::createTargetFinalizePipeline(OpPassManager &pm) {
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_QUBITRESETBEFORERELEASE
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "reset-before-release"
+
+using namespace mlir;
+
+/// \file
+/// This pass resets the qubits before they are deallocated, so that passes
+/// mapping several virtual qubits to the same physical qubit, such as
+/// `dep-analysis`, hand each virtual qubit over in the |0> state.
+
+namespace {
+/// Return true if the deallocation is only followed by other deallocations and
+/// the return of the kernel. No other qubit is allocated afterwards, and the
+/// final state of these qubits may still be sampled, so they are not reset.
+static bool isReleasedOnExit(quake::DeallocOp dealloc) {
+  if (!isa<func::FuncOp>(dealloc->getParentOp()))
+    return false;
+  for (auto *op = dealloc->getNextNode(); op; op = op->getNextNode())
+    if (!isa<quake::DeallocOp, func::ReturnOp>(op))
+      return false;
+  return true;
+}
+
+class QubitResetBeforeReleasePass
+    : public cudaq::opt::impl::QubitResetBeforeReleaseBase<
+          QubitResetBeforeReleasePass> {
+public:
+  using QubitResetBeforeReleaseBase::QubitResetBeforeReleaseBase;
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    funcOp.walk([&](quake::DeallocOp dealloc) {
+      if (isReleasedOnExit(dealloc))
+        return;
+      auto qubits = dealloc.getReference();
+      if (!isa<quake::RefType, quake::VeqType>(qubits.getType()))
+        return;
+      // Nothing to do if the qubits were just reset.
+      if (auto reset = dyn_cast_if_present<quake::ResetOp>(
+              dealloc->getPrevNode()))
+        if (reset.getTargets() == qubits)
+          return;
+      OpBuilder builder(dealloc);
+      builder.create<quake::ResetOp>(dealloc.getLoc(), TypeRange{}, qubits);
+      ++numResets;
+    });
+  }
+};
+} // namespace
@@ -0,0 +1,621 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cudaq/Optimizer/Transforms/ResourceEstimation.h"
+#include "LoopAnalysis.h"
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Builder/Factory.h"
+#include "cudaq/Optimizer/Dialect/CC/CCOps.h"
+#include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Interfaces/CallInterfaces.h"
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_RESOURCEESTIMATION
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "resource-estimation"
+
+using namespace mlir;
+
+/// The maximum number of operations interpreted to compute the depth of a
+/// kernel. Beyond that, the depth is left unknown.
+static constexpr std::size_t depthBudget = 50'000'000;
+
+/// Returns the number of qubits in the `!quake.ref` or `!quake.veq` \p v, if it
+/// is known at compilation time.
+static std::optional<std::size_t> getNumQubits(Value v) {
+  if (isa<quake::RefType>(v.getType()))
+    return 1;
+  auto veqTy = dyn_cast<quake::VeqType>(v.getType());
+  if (!veqTy)
+    return std::nullopt;
+  if (veqTy.hasSpecifiedSize())
+    return veqTy.getSize();
+  if (auto relax = v.getDefiningOp<quake::RelaxSizeOp>())
+    return getNumQubits(relax.getInputVec());
+  if (auto alloca = v.getDefiningOp<quake::AllocaOp>())
+    if (alloca.getSize())
+      return cudaq::opt::factory::maybeValueOfIntConstant(alloca.getSize());
+  return std::nullopt;
+}
+
+/// Returns the name of the gate \p op as reported by the simulators.
+static std::string getGateName(quake::OperatorInterface op) {
+  auto name = op->getName().stripDialect().str();
+  if (op.isAdj() && isa<quake::SOp, quake::TOp>(op.getOperation()))
+    name += "dg";
+  return name;
+}
+
+namespace {
+/// Count the gates and qubits of a function with static control flow,
+/// multiplying the counts of the loop bodies by their number of iterations.
+class ResourceCounter {
+public:
+  ResourceCounter(cudaq::opt::StaticResources &resources)
+      : resources(resources) {}
+
+  LogicalResult countRegion(Region &region, std::size_t multiplier) {
+    if (region.empty())
+      return success();
+    if (!region.hasOneBlock()) {
+      LLVM_DEBUG(llvm::dbgs() << "unstructured control flow\n");
+      return failure();
+    }
+    for (auto &op : region.front())
+      if (failed(count(op, multiplier)))
+        return failure();
+    return success();
+  }
+
+private:
+  LogicalResult count(Operation &op, std::size_t multiplier) {
+    if (isa<CallOpInterface, quake::ApplyOp>(op)) {
+      LLVM_DEBUG(llvm::dbgs() << "call: " << op << '\n');
+      return failure();
+    }
+    if (auto alloca = dyn_cast<quake::AllocaOp>(op)) {
+      auto numQubits = getNumQubits(alloca.getResult());
+      if (!numQubits)
+        return failure();
+      resources.numQubits += *numQubits * multiplier;
+      return success();
+    }
+    if (auto reset = dyn_cast<quake::ResetOp>(op)) {
+      auto numQubits = getNumQubits(reset.getTargets());
+      if (!numQubits)
+        return failure();
+      resources.gateCounts[{"reset", 0}] += *numQubits * multiplier;
+      return success();
+    }
+#define QUAKE_OP(OP) quake::OP
+    if (isa<GATE_OPS(QUAKE_OP)>(op))
+      return countGate(cast<quake::OperatorInterface>(op), multiplier);
+#undef QUAKE_OP
+    if (auto loop = dyn_cast<cudaq::cc::LoopOp>(op)) {
+      cudaq::opt::LoopComponents components;
+      if (!cudaq::opt::isaMonotonicLoop(loop, /*allowEarlyExit=*/false,
+                                        &components))
+        return failure();
+      auto iterations = components.getIterationsConstant();
+      if (!iterations) {
+        LLVM_DEBUG(llvm::dbgs() << "unknown number of iterations: " << op);
+        return failure();
+      }
+      return success(
+          succeeded(countRegion(loop.getWhileRegion(), multiplier)) &&
+          succeeded(countRegion(loop.getBodyRegion(),
+                                multiplier * *iterations)) &&
+          succeeded(countRegion(loop.getStepRegion(), multiplier)) &&
+          succeeded(countRegion(loop.getElseRegion(), multiplier)));
+    }
+    if (auto ifOp = dyn_cast<cudaq::cc::IfOp>(op)) {
+      auto condition =
+          cudaq::opt::factory::maybeValueOfIntConstant(ifOp.getCondition());
+      if (!condition) {
+        LLVM_DEBUG(llvm::dbgs() << "non-constant condition: " << op << '\n');
+        return failure();
+      }
+      return countRegion(*condition ? ifOp.getThenRegion()
+                                    : ifOp.getElseRegion(),
+                         multiplier);
+    }
+    if (auto scope = dyn_cast<cudaq::cc::ScopeOp>(op))
+      return countRegion(scope.getInitRegion(), multiplier);
+    // Measurements are not counted, as their results can only be used by the
+    // classical computations.
+    if (isa<quake::MzOp, quake::DeallocOp, quake::DiscriminateOp,
+            quake::ExtractRefOp, quake::SubVeqOp, quake::RelaxSizeOp>(op))
+      return success();
+    if (isa<quake::QuakeDialect>(op.getDialect()) || op.getNumRegions()) {
+      LLVM_DEBUG(llvm::dbgs() << "unsupported operation: " << op << '\n');
+      return failure();
+    }
+    return success();
+  }
+
+  LogicalResult countGate(quake::OperatorInterface op,
+                          std::size_t multiplier) {
+    if (auto negated = op.getNegatedControls())
+      if (llvm::is_contained(*negated, true))
+        return failure();
+    std::size_t numControls = 0;
+    for (auto control : op.getControls()) {
+      auto numQubits = getNumQubits(control);
+      if (!numQubits)
+        return failure();
+      numControls += *numQubits;
+    }
+    // A single target gate is applied to each of the qubits of a `veq`.
+    std::size_t numApplications = 1;
+    auto targets = op.getTargets();
+    if (targets.size() == 1) {
+      auto numQubits = getNumQubits(targets[0]);
+      if (!numQubits)
+        return failure();
+      numApplications = *numQubits;
+    } else if (!llvm::all_of(targets.getTypes(), [](Type ty) {
+                 return isa<quake::RefType>(ty);
+               })) {
+      return failure();
+    }
+    resources.gateCounts[{getGateName(op), numControls}] +=
+        numApplications * multiplier;
+    return success();
+  }
+
+  cudaq::opt::StaticResources &resources;
+};
+
+/// A range of qubits, identified by their order of allocation.
+struct QubitRange {
+  std::size_t first;
+  std::size_t size;
+};
+
+/// Compute the depth of a function with static control flow by interpreting
+/// it: each gate is placed on the layer following the last layer of all of its
+/// qubits, as done by the scheduling of `DependencyAnalysis`. The iterations of
+/// a loop which always act on the same qubits are the same function of the
+/// layers of these qubits. Once an iteration shifts all these layers by the
+/// same number of layers as the previous one, every remaining iteration does
+/// too, and the loop is not iterated any further.
+class DepthInterpreter {
+public:
+  std::optional<std::size_t> run(func::FuncOp func) {
+    if (failed(interpretRegion(func.getBody())))
+      return std::nullopt;
+    return depth;
+  }
+
+private:
+  LogicalResult interpretRegion(Region &region) {
+    if (region.empty())
+      return success();
+    for (auto &op : region.front())
+      if (failed(interpret(op)))
+        return failure();
+    return success();
+  }
+
+  LogicalResult interpret(Operation &op) {
+    if (++numInterpreted > depthBudget) {
+      LLVM_DEBUG(llvm::dbgs() << "depth budget exhausted\n");
+      return failure();
+    }
+    if (auto alloca = dyn_cast<quake::AllocaOp>(op)) {
+      std::size_t size = *getNumQubits(alloca.getResult());
+      registers[alloca.getResult()] = {layers.size(), size};
+      layers.resize(layers.size() + size, 0);
+      return success();
+    }
+    if (auto reset = dyn_cast<quake::ResetOp>(op)) {
+      auto qubits = getQubits(reset.getTargets());
+      if (!qubits)
+        return failure();
+      for (std::size_t i = 0; i < qubits->size; i++)
+        place({qubits->first + i});
+      return success();
+    }
+#define QUAKE_OP(OP) quake::OP
+    if (isa<GATE_OPS(QUAKE_OP)>(op))
+      return interpretGate(cast<quake::OperatorInterface>(op));
+#undef QUAKE_OP
+    if (auto loop = dyn_cast<cudaq::cc::LoopOp>(op))
+      return interpretLoop(loop);
+    if (auto ifOp = dyn_cast<cudaq::cc::IfOp>(op)) {
+      auto condition = evaluate(ifOp.getCondition());
+      if (!condition)
+        return failure();
+      return interpretBranch(op, condition->isZero() ? ifOp.getElseRegion()
+                                                     : ifOp.getThenRegion());
+    }
+    if (auto scope = dyn_cast<cudaq::cc::ScopeOp>(op))
+      return interpretBranch(op, scope.getInitRegion());
+    return success();
+  }
+
+  LogicalResult interpretGate(quake::OperatorInterface op) {
+    SmallVector<std::size_t> controls;
+    for (auto control : op.getControls()) {
+      auto qubits = getQubits(control);
+      if (!qubits)
+        return failure();
+      for (std::size_t i = 0; i < qubits->size; i++)
+        controls.push_back(qubits->first + i);
+    }
+    SmallVector<QubitRange> targets;
+    for (auto target : op.getTargets()) {
+      auto qubits = getQubits(target);
+      if (!qubits)
+        return failure();
+      targets.push_back(*qubits);
+    }
+    if (targets.size() == 1) {
+      for (std::size_t i = 0; i < targets[0].size; i++) {
+        SmallVector<std::size_t> qubits = controls;
+        qubits.push_back(targets[0].first + i);
+        place(qubits);
+      }
+      return success();
+    }
+    for (auto target : targets)
+      controls.push_back(target.first);
+    place(controls);
+    return success();
+  }
+
+  /// Interpret the region executed by \p op and bind the results of \p op to
+  /// the values the region exits with.
+  LogicalResult interpretBranch(Operation &op, Region &region) {
+    if (failed(interpretRegion(region)))
+      return failure();
+    if (region.empty())
+      return success();
+    bind(op.getResults(), region.front().getTerminator()->getOperands());
+    return success();
+  }
+
+  LogicalResult interpretLoop(cudaq::cc::LoopOp loop) {
+    cudaq::opt::LoopComponents components;
+    if (loop.isPostConditional() ||
+        !cudaq::opt::isaMonotonicLoop(loop, /*allowEarlyExit=*/false,
+                                      &components))
+      return failure();
+    std::size_t iterations = *components.getIterationsConstant();
+    bool invariantQubits = !hasIterationDependentQubits(loop);
+    if (invariantQubits)
+      numTrackingLoops++;
+    auto untrack = llvm::make_scope_exit([&]() {
+      if (invariantQubits)
+        numTrackingLoops--;
+    });
+    Block &whileBlock = loop.getWhileRegion().front();
+    auto condition = cast<cudaq::cc::ConditionOp>(whileBlock.getTerminator());
+    SmallVector<std::optional<APInt>> args = evaluate(loop.getInitialArgs());
+    SmallVector<std::size_t> previousQubits;
+    SmallVector<std::size_t> previousLayers;
+    for (std::size_t iteration = 0; iteration < iterations; iteration++) {
+      bind(whileBlock.getArguments(), args);
+      Block &bodyBlock = loop.getBodyRegion().front();
+      bind(bodyBlock.getArguments(), evaluate(condition.getResults()));
+      std::size_t mark = touched.size();
+      if (failed(interpretRegion(loop.getBodyRegion())))
+        return failure();
+      args = evaluate(bodyBlock.getTerminator()->getOperands());
+      if (loop.hasStep()) {
+        Block &stepBlock = loop.getStepRegion().front();
+        bind(stepBlock.getArguments(), args);
+        if (failed(interpretRegion(loop.getStepRegion())))
+          return failure();
+        args = evaluate(stepBlock.getTerminator()->getOperands());
+      }
+      if (!invariantQubits)
+        continue;
+      SmallVector<std::size_t> qubits(touched.begin() + mark, touched.end());
+      llvm::sort(qubits);
+      qubits.erase(std::unique(qubits.begin(), qubits.end()), qubits.end());
+      touched.resize(mark);
+      touched.append(qubits.begin(), qubits.end());
+      SmallVector<std::size_t> currentLayers;
+      for (auto qubit : qubits)
+        currentLayers.push_back(layers[qubit]);
+      if (iteration > 0 && qubits == previousQubits &&
+          isUniformShift(previousLayers, currentLayers)) {
+        std::size_t shift =
+            qubits.empty() ? 0 : currentLayers[0] - previousLayers[0];
+        std::size_t remaining = iterations - iteration - 1;
+        for (auto qubit : qubits) {
+          layers[qubit] += shift * remaining;
+          depth = std::max(depth, layers[qubit]);
+        }
+        LLVM_DEBUG(llvm::dbgs() << "extrapolated " << remaining
+                                << " iterations of " << loop << '\n');
+        // The values the loop exits with are not known.
+        for (auto result : loop.getResults())
+          integers.erase(result);
+        return interpretRegion(loop.getElseRegion());
+      }
+      previousQubits = std::move(qubits);
+      previousLayers = std::move(currentLayers);
+    }
+    bind(whileBlock.getArguments(), args);
+    bind(loop.getResults(), condition.getResults());
+    if (loop.hasPythonElse())
+      bind(loop.getElseEntryBlock()->getArguments(), condition.getResults());
+    return interpretRegion(loop.getElseRegion());
+  }
+
+  static bool isUniformShift(ArrayRef<std::size_t> before,
+                             ArrayRef<std::size_t> after) {
+    for (std::size_t i = 1; i < before.size(); i++)
+      if (after[i] - before[i] != after[0] - before[0])
+        return false;
+    return true;
+  }
+
+  /// Returns true if the qubits of an iteration of \p loop may depend on the
+  /// iteration, i.e., if they are allocated in the loop or selected, directly
+  /// or by a condition, by a value which depends on the loop arguments.
+  static bool hasIterationDependentQubits(cudaq::cc::LoopOp loop) {
+    DenseSet<Value> visited;
+    auto result = loop.getBodyRegion().walk([&](Operation *op) {
+      if (isa<quake::AllocaOp>(op))
+        return WalkResult::interrupt();
+      if (isa<quake::ExtractRefOp, quake::SubVeqOp, cudaq::cc::IfOp>(op))
+        for (auto operand : op->getOperands())
+          if (dependsOnLoop(operand, loop, visited))
+            return WalkResult::interrupt();
+      return WalkResult::advance();
+    });
+    return result.wasInterrupted();
+  }
+
+  static bool dependsOnLoop(Value v, cudaq::cc::LoopOp loop,
+                            DenseSet<Value> &visited) {
+    if (!visited.insert(v).second)
+      return false;
+    if (auto arg = dyn_cast<BlockArgument>(v)) {
+      Operation *owner = arg.getOwner()->getParentOp();
+      if (owner == loop.getOperation())
+        return true;
+      if (!loop->isProperAncestor(owner))
+        return false;
+      auto inner = dyn_cast<cudaq::cc::LoopOp>(owner);
+      if (!inner)
+        return true;
+      // The arguments of a nested loop are its initial values and the values
+      // forwarded by its regions.
+      unsigned position = arg.getArgNumber();
+      if (position < inner.getInitialArgs().size() &&
+          dependsOnLoop(inner.getInitialArgs()[position], loop, visited))
+        return true;
+      for (auto &region : inner->getRegions())
+        for (auto &block : region) {
+          ValueRange forwarded = block.getTerminator()->getOperands();
+          if (isa<cudaq::cc::ConditionOp>(block.getTerminator()))
+            forwarded = forwarded.drop_front();
+          if (position < forwarded.size() &&
+              dependsOnLoop(forwarded[position], loop, visited))
+            return true;
+        }
+      return false;
+    }
+    Operation *def = v.getDefiningOp();
+    if (!loop->isProperAncestor(def))
+      return false;
+    if (def->getNumRegions())
+      return true;
+    return llvm::any_of(def->getOperands(), [&](Value operand) {
+      return dependsOnLoop(operand, loop, visited);
+    });
+  }
+
+  void place(ArrayRef<std::size_t> qubits) {
+    std::size_t layer = 0;
+    for (auto qubit : qubits)
+      layer = std::max(layer, layers[qubit]);
+    layer++;
+    for (auto qubit : qubits) {
+      layers[qubit] = layer;
+      if (numTrackingLoops)
+        touched.push_back(qubit);
+    }
+    depth = std::max(depth, layer);
+  }
+
+  std::optional<QubitRange> getQubits(Value v) {
+    auto iter = registers.find(v);
+    if (iter != registers.end())
+      return iter->second;
+    if (auto relax = v.getDefiningOp<quake::RelaxSizeOp>())
+      return getQubits(relax.getInputVec());
+    if (auto extract = v.getDefiningOp<quake::ExtractRefOp>()) {
+      auto veq = getQubits(extract.getVeq());
+      if (!veq)
+        return std::nullopt;
+      std::size_t index = extract.getRawIndex();
+      if (!extract.hasConstantIndex()) {
+        auto value = evaluate(extract.getIndex());
+        if (!value)
+          return std::nullopt;
+        index = value->getZExtValue();
+      }
+      if (index >= veq->size)
+        return std::nullopt;
+      return QubitRange{veq->first + index, 1};
+    }
+    if (auto subveq = v.getDefiningOp<quake::SubVeqOp>()) {
+      auto veq = getQubits(subveq.getVeq());
+      if (!veq)
+        return std::nullopt;
+      auto getBound = [&](Value bound,
+                          std::int64_t raw) -> std::optional<std::size_t> {
+        if (!bound)
+          return raw;
+        if (auto value = evaluate(bound))
+          return value->getZExtValue();
+        return std::nullopt;
+      };
+      auto lower = getBound(subveq.getLower(), subveq.getRawLower());
+      auto upper = getBound(subveq.getUpper(), subveq.getRawUpper());
+      if (!lower || !upper || *lower > *upper || *upper >= veq->size)
+        return std::nullopt;
+      return QubitRange{veq->first + *lower, *upper - *lower + 1};
+    }
+    LLVM_DEBUG(llvm::dbgs() << "unknown qubits: " << v << '\n');
+    return std::nullopt;
+  }
+
+  SmallVector<std::optional<APInt>> evaluate(ValueRange values) {
+    SmallVector<std::optional<APInt>> result;
+    for (auto v : values)
+      result.push_back(evaluate(v));
+    return result;
+  }
+
+  void bind(ValueRange keys, ArrayRef<std::optional<APInt>> values) {
+    for (auto [key, value] : llvm::zip(keys, values)) {
+      if (value)
+        integers[key] = *value;
+      else
+        integers.erase(key);
+    }
+  }
+
+  void bind(ValueRange keys, ValueRange values) {
+    bind(keys, evaluate(values));
+  }
+
+  /// Evaluate the integer \p v from the bound arguments and constants.
+  std::optional<APInt> evaluate(Value v) {
+    auto iter = integers.find(v);
+    if (iter != integers.end())
+      return iter->second;
+    Operation *def = v.getDefiningOp();
+    if (!def || !v.getType().isIntOrIndex())
+      return std::nullopt;
+    if (auto constant = dyn_cast<arith::ConstantOp>(def))
+      if (auto attr = dyn_cast<IntegerAttr>(constant.getValue()))
+        return attr.getValue();
+    unsigned width =
+        v.getType().isIndex() ? 64 : v.getType().getIntOrFloatBitWidth();
+    auto unary = [&](auto fn) -> std::optional<APInt> {
+      auto x = evaluate(def->getOperand(0));
+      if (!x)
+        return std::nullopt;
+      return fn(*x);
+    };
+    auto binary = [&](auto fn) -> std::optional<APInt> {
+      auto x = evaluate(def->getOperand(0));
+      auto y = evaluate(def->getOperand(1));
+      if (!x || !y)
+        return std::nullopt;
+      return fn(*x, *y);
+    };
+    if (isa<arith::AddIOp>(def))
+      return binary([](APInt x, APInt y) { return x + y; });
+    if (isa<arith::SubIOp>(def))
+      return binary([](APInt x, APInt y) { return x - y; });
+    if (isa<arith::MulIOp>(def))
+      return binary([](APInt x, APInt y) { return x * y; });
+    if (isa<arith::DivUIOp, arith::DivSIOp, arith::RemUIOp, arith::RemSIOp>(
+            def))
+      return binary([&](APInt x, APInt y) -> std::optional<APInt> {
+        if (y.isZero())
+          return std::nullopt;
+        if (isa<arith::DivUIOp>(def))
+          return x.udiv(y);
+        if (isa<arith::DivSIOp>(def))
+          return x.sdiv(y);
+        if (isa<arith::RemUIOp>(def))
+          return x.urem(y);
+        return x.srem(y);
+      });
+    if (isa<arith::ExtSIOp, arith::IndexCastOp>(def))
+      return unary([&](APInt x) { return x.sextOrTrunc(width); });
+    if (isa<arith::ExtUIOp, arith::IndexCastUIOp>(def))
+      return unary([&](APInt x) { return x.zextOrTrunc(width); });
+    if (isa<arith::TruncIOp>(def))
+      return unary([&](APInt x) { return x.trunc(width); });
+    if (auto cmp = dyn_cast<arith::CmpIOp>(def))
+      return binary([&](APInt x, APInt y) {
+        return APInt(1, arith::applyCmpPredicate(cmp.getPredicate(), x, y));
+      });
+    if (auto select = dyn_cast<arith::SelectOp>(def)) {
+      auto condition = evaluate(select.getCondition());
+      if (!condition)
+        return std::nullopt;
+      return evaluate(condition->isZero() ? select.getFalseValue()
+                                          : select.getTrueValue());
+    }
+    return std::nullopt;
+  }
+
+  DenseMap<Value, APInt> integers;
+  DenseMap<Value, QubitRange> registers;
+  /// The last layer of each qubit.
+  std::vector<std::size_t> layers;
+  /// The qubits of the gates that were placed, since the start of the current
+  /// iteration of the loops which act on invariant qubits.
+  SmallVector<std::size_t> touched;
+  unsigned numTrackingLoops = 0;
+  std::size_t depth = 0;
+  std::size_t numInterpreted = 0;
+};
+} // namespace
+
+void cudaq::opt::ResourceEstimation::performAnalysis(Operation *operation) {
+  auto func = dyn_cast<func::FuncOp>(operation);
+  if (!func || func.empty())
+    return;
+  StaticResources result;
+  ResourceCounter counter(result);
+  if (failed(counter.countRegion(func.getBody(), 1)))
+    return;
+  result.depth = DepthInterpreter().run(func);
+  resources = std::move(result);
+}
+
+namespace {
+class ResourceEstimationPass
+    : public cudaq::opt::impl::ResourceEstimationBase<ResourceEstimationPass> {
+public:
+  using ResourceEstimationBase::ResourceEstimationBase;
+
+  void runOnOperation() override {
+    auto func = getOperation();
+    if (func.empty())
+      return;
+    const auto &resources =
+        getAnalysis<cudaq::opt::ResourceEstimation>().getResources();
+    auto &os = llvm::outs();
+    if (!resources) {
+      os << "Resources of " << func.getName() << ": not static\n";
+    } else {
+      os << "Resources of " << func.getName() << ": " << resources->numQubits
+         << " qubits, depth ";
+      if (resources->depth)
+        os << *resources->depth;
+      else
+        os << "unknown";
+      os << '\n';
+      for (const auto &[gate, count] : resources->gateCounts)
+        os << "  " << gate.first << '(' << gate.second << "): " << count
+           << '\n';
+    }
+    markAllAnalysesPreserved();
+  }
+};
+} // namespace
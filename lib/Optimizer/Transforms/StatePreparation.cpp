@@ -18,6 +18,8 @@
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "mlir/Transforms/Passes.h"
+#include <bit>
+#include <map>
 #include <span>
 
 namespace cudaq::opt {
@@ -152,6 +154,132 @@ std::vector<double> getAlphaY(const std::span<double> data,
   }
   return angles;
 }
+
+/// @brief A gate of a sparse state preparation circuit: an X, y-rotation or
+/// z-rotation of `target`, controlled by `controls`.
+struct SparseStateGate {
+  enum class Kind { x, ry, rz };
+  Kind kind;
+  double angle = 0.;
+  std::vector<std::size_t> controls;
+  std::size_t target = 0;
+};
+
+/// @brief Return the gates preparing the state with the given nonzero
+/// amplitudes, indexed by basis state, where bit `i` of the index is the
+/// state of qubit `i`, up to a global phase. This follows the algorithm of
+/// `https://arxiv.org/abs/2006.00016`, which needs O(mn) CNOTs for m nonzero
+/// amplitudes on n qubits, rather than O(2^n): pairs of basis states are
+/// merged one at a time, reducing the state to |0...0>, and the inverse of
+/// the resulting circuit is returned.
+std::vector<SparseStateGate> decomposeSparseState(
+    const std::vector<std::pair<std::uint64_t, std::complex<double>>>
+        &amplitudes,
+    std::size_t numQubits, double phaseThreshold) {
+  using Kind = SparseStateGate::Kind;
+  std::map<std::uint64_t, std::complex<double>> state(amplitudes.begin(),
+                                                      amplitudes.end());
+  std::vector<SparseStateGate> reduction;
+  // Apply an X gate, permuting the basis states of the state.
+  const auto applyX = [&](std::vector<std::size_t> controls,
+                          std::size_t target) {
+    std::uint64_t controlMask = 0;
+    for (auto control : controls)
+      controlMask |= 1ULL << control;
+    std::map<std::uint64_t, std::complex<double>> permuted;
+    for (const auto &[basis, amplitude] : state)
+      permuted.emplace((basis & controlMask) == controlMask
+                           ? basis ^ (1ULL << target)
+                           : basis,
+                       amplitude);
+    state = std::move(permuted);
+    reduction.push_back({Kind::x, 0., std::move(controls), target});
+  };
+
+  while (state.size() > 1) {
+    // Merge the first basis state with its closest one.
+    std::uint64_t first = state.begin()->first;
+    std::uint64_t closest = 0;
+    int minDistance = std::numeric_limits<int>::max();
+    for (const auto &[basis, amplitude] : llvm::drop_begin(state)) {
+      const int distance = std::popcount(basis ^ first);
+      if (distance < minDistance) {
+        minDistance = distance;
+        closest = basis;
+      }
+    }
+    // Have both differ on a single qubit by flipping the other differing
+    // qubits of the basis state with that qubit set.
+    const std::uint64_t difference = first ^ closest;
+    const std::size_t dif = std::countr_zero(difference);
+    for (std::size_t q = 0; q < numQubits; ++q)
+      if (q != dif && ((difference >> q) & 1ULL))
+        applyX({dif}, q);
+    // The basis state with that qubit unset is left unchanged.
+    const std::uint64_t low = ((first >> dif) & 1ULL) ? closest : first;
+    const std::uint64_t high = low | (1ULL << dif);
+
+    // Select controls matching both basis states but no other.
+    std::vector<std::uint64_t> others;
+    for (const auto &[basis, amplitude] : state)
+      if (basis != low && basis != high)
+        others.push_back(basis);
+    std::vector<std::size_t> controls;
+    while (!others.empty()) {
+      std::size_t best = 0, bestCount = 0;
+      for (std::size_t q = 0; q < numQubits; ++q) {
+        if (q == dif)
+          continue;
+        std::size_t count = 0;
+        for (auto basis : others)
+          count += ((basis ^ low) >> q) & 1ULL;
+        if (count > bestCount) {
+          best = q;
+          bestCount = count;
+        }
+      }
+      controls.push_back(best);
+      std::erase_if(others, [&](std::uint64_t basis) {
+        return ((basis ^ low) >> best) & 1ULL;
+      });
+    }
+
+    // Rotate both amplitudes into the one of `low`. The controls on qubits in
+    // the |0> state are flipped around the rotations, which leaves the state
+    // unchanged otherwise.
+    std::vector<SparseStateGate> flips;
+    for (auto control : controls)
+      if (!((low >> control) & 1ULL))
+        flips.push_back({Kind::x, 0., {}, control});
+    reduction.insert(reduction.end(), flips.begin(), flips.end());
+    const auto lowAmplitude = state[low];
+    const auto highAmplitude = state[high];
+    const double phase = std::arg(lowAmplitude) - std::arg(highAmplitude);
+    if (std::abs(phase) > phaseThreshold)
+      reduction.push_back({Kind::rz, phase, controls, dif});
+    reduction.push_back(
+        {Kind::ry,
+         -2. * std::atan2(std::abs(highAmplitude), std::abs(lowAmplitude)),
+         controls, dif});
+    reduction.insert(reduction.end(), flips.begin(), flips.end());
+    state.erase(high);
+    state[low] = std::polar(
+        std::hypot(std::abs(lowAmplitude), std::abs(highAmplitude)),
+        (std::arg(lowAmplitude) + std::arg(highAmplitude)) / 2.);
+  }
+
+  // The state is now a basis state, up to a global phase.
+  const std::uint64_t remaining = state.begin()->first;
+  for (std::size_t q = 0; q < numQubits; ++q)
+    if ((remaining >> q) & 1ULL)
+      applyX({}, q);
+
+  // Invert the reduction.
+  std::reverse(reduction.begin(), reduction.end());
+  for (auto &gate : reduction)
+    gate.angle = -gate.angle;
+  return reduction;
+}
 } // namespace cudaq::details
 
 class StateGateBuilder {
@@ -172,6 +300,27 @@ public:
     rewriter.create<quake::XOp>(loc, qubitC, qubitT);
   };
 
+  /// @brief Apply a gate of a sparse state preparation circuit.
+  void applySparseStateGate(const cudaq::details::SparseStateGate &gate) {
+    SmallVector<mlir::Value> controls;
+    for (auto control : gate.controls)
+      controls.push_back(createQubitRef(control));
+    auto qubit = createQubitRef(gate.target);
+    switch (gate.kind) {
+    case cudaq::details::SparseStateGate::Kind::x:
+      rewriter.create<quake::XOp>(loc, ValueRange{controls}, ValueRange{qubit});
+      return;
+    case cudaq::details::SparseStateGate::Kind::ry:
+      rewriter.create<quake::RyOp>(loc, createAngleValue(gate.angle), controls,
+                                   qubit);
+      return;
+    case cudaq::details::SparseStateGate::Kind::rz:
+      rewriter.create<quake::RzOp>(loc, createAngleValue(gate.angle), controls,
+                                   qubit);
+      return;
+    }
+  }
+
 private:
   mlir::Value createQubitRef(std::size_t index) {
     if (qubitRefs.contains(index))
@@ -332,8 +481,9 @@ class StatePrepPattern : public OpRewritePattern<quake::InitializeStateOp> {
 public:
   using OpRewritePattern::OpRewritePattern;
 
-  explicit StatePrepPattern(MLIRContext *ctx, double phaseThreshold)
-      : OpRewritePattern(ctx), phaseThreshold(phaseThreshold) {}
+  explicit StatePrepPattern(MLIRContext *ctx, double phaseThreshold,
+                            bool sparse)
+      : OpRewritePattern(ctx), phaseThreshold(phaseThreshold), sparse(sparse) {}
 
   LogicalResult matchAndRewrite(quake::InitializeStateOp init,
                                 PatternRewriter &rewriter) const override {
@@ -378,10 +528,26 @@ public:
                 "Invalid initialization data for state preparation: size "
                 "must be a power of two.");
 
-          // Prepare state from vector data.
+          // Prepare state from vector data. States with few nonzero
+          // amplitudes are prepared with the sparse algorithm, whose circuits
+          // grow with the number of nonzero amplitudes rather than with the
+          // dimension.
           auto gateBuilder = StateGateBuilder(rewriter, loc, qubits);
-          auto decomposer = StateDecomposer(gateBuilder, vec, phaseThreshold);
-          decomposer.decompose();
+          const std::size_t numQubits = std::countr_zero(std::size_t(vecSize));
+          std::vector<std::pair<std::uint64_t, std::complex<double>>> nonzeros;
+          for (auto [i, amplitude] : llvm::enumerate(vec))
+            if (amplitude != 0.)
+              nonzeros.emplace_back(i, amplitude);
+          if (sparse && numQubits >= 3 && !nonzeros.empty() &&
+              nonzeros.size() * numQubits < std::size_t(vecSize)) {
+            for (const auto &gate : cudaq::details::decomposeSparseState(
+                     nonzeros, numQubits, phaseThreshold))
+              gateBuilder.applySparseStateGate(gate);
+          } else {
+            auto decomposer =
+                StateDecomposer(gateBuilder, vec, phaseThreshold);
+            decomposer.decompose();
+          }
 
           // Use prepared qubits instead of the initialized state.
           init.replaceAllUsesWith(qubits);
@@ -397,6 +563,7 @@ public:
 
 private:
   double phaseThreshold;
+  bool sparse;
 };
 
 class StatePreparationPass
@@ -413,7 +580,7 @@ public:
                             << func << "\n\n");
 
     RewritePatternSet patterns(ctx);
-    patterns.insert<StatePrepPattern>(ctx, phaseThreshold);
+    patterns.insert<StatePrepPattern>(ctx, phaseThreshold, sparse);
 
     if (failed(applyPatternsAndFoldGreedily(func, std::move(patterns)))) {
       func.emitOpError("State preparation failed");
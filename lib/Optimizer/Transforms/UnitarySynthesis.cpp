@@ -13,13 +13,17 @@
 #include "cudaq/Optimizer/Dialect/CC/CCOps.h"
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Debug.h"
 #include "mlir/Conversion/LLVMCommon/TypeConverter.h"
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/Dialect/LLVMIR/LLVMTypes.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "mlir/Transforms/Passes.h"
+#include <bit>
+#include <mutex>
 #include <unsupported/Eigen/KroneckerProduct>
 #include <unsupported/Eigen/MatrixFunctions>
 
@@ -351,8 +355,10 @@ struct TwoQubitOpKAK : public Decomposer {
     auto parentModule = customOp->getParentOfType<ModuleOp>();
     Location loc = customOp->getLoc();
     auto targets = customOp.getTargets();
-    auto funcTy =
-        FunctionType::get(parentModule.getContext(), targets.getTypes(), {});
+    /// NOTE: This may be a block of a larger unitary, acting on its first two
+    /// targets.
+    auto funcTy = FunctionType::get(parentModule.getContext(),
+                                    targets.take_front(2).getTypes(), {});
     auto insPt = rewriter.saveInsertionPoint();
     rewriter.setInsertionPointToStart(parentModule.getBody());
     auto func =
@@ -434,47 +440,300 @@ struct TwoQubitOpKAK : public Decomposer {
   }
 };
 
+/// Return the decomposer of the unitary \p matrix of dimension 2^n, n >= 1.
+std::shared_ptr<Decomposer> makeDecomposer(const Eigen::MatrixXcd &matrix);
+
+/// Result of the cosine-sine decomposition of a 2m x 2m unitary matrix (U):
+/// U = (l0 ⊕ l1) x | C -S | x (r0 ⊕ r1)
+///                 | S  C |
+/// where C and S are diagonal matrices with entries cos(theta_i / 2) and
+/// sin(theta_i / 2).
+struct CosineSineComponents {
+  Eigen::MatrixXcd l0;
+  Eigen::MatrixXcd l1;
+  Eigen::MatrixXcd r0;
+  Eigen::MatrixXcd r1;
+  std::vector<double> theta;
+};
+
+/// Compute the cosine-sine decomposition from the singular value decomposition
+/// of the top left block. The singular values are ordered by increasing cosine
+/// so that the QR decomposition of the bottom left block handles the columns
+/// with vanishing sine last.
+CosineSineComponents cosineSine(const Eigen::MatrixXcd &matrix) {
+  auto half = matrix.rows() / 2;
+  Eigen::MatrixXcd u00 = matrix.topLeftCorner(half, half);
+  Eigen::MatrixXcd u01 = matrix.topRightCorner(half, half);
+  Eigen::MatrixXcd u10 = matrix.bottomLeftCorner(half, half);
+  Eigen::MatrixXcd u11 = matrix.bottomRightCorner(half, half);
+  CosineSineComponents result;
+  result.theta.assign(half, 0.0);
+  /// A block diagonal matrix needs no rotation.
+  if (u01.isZero(TOL) && u10.isZero(TOL)) {
+    result.l0 = u00;
+    result.l1 = u11;
+    result.r0 = Eigen::MatrixXcd::Identity(half, half);
+    result.r1 = Eigen::MatrixXcd::Identity(half, half);
+    return result;
+  }
+  Eigen::JacobiSVD<Eigen::MatrixXcd> svd(u00, Eigen::ComputeFullU |
+                                                  Eigen::ComputeFullV);
+  result.l0 = svd.matrixU().rowwise().reverse();
+  result.r0 = svd.matrixV().rowwise().reverse().adjoint();
+  Eigen::VectorXd cosines = svd.singularValues().reverse();
+  /// The columns of `u10 * r0.adjoint()` are orthogonal, hence its R factor is
+  /// diagonal, with the sines up to a phase which is moved into `l1`.
+  Eigen::HouseholderQR<Eigen::MatrixXcd> qr(u10 * result.r0.adjoint());
+  result.l1 = qr.householderQ();
+  const Eigen::MatrixXcd &factorR = qr.matrixQR();
+  Eigen::MatrixXcd fromU11 = result.l1.adjoint() * u11;
+  Eigen::MatrixXcd fromU01 = -result.l0.adjoint() * u01;
+  result.r1.resize(half, half);
+  for (Eigen::Index i = 0; i < half; i++) {
+    double sine = std::abs(factorR(i, i));
+    if (sine > TOL) {
+      result.l1.col(i) *= factorR(i, i) / sine;
+      fromU11.row(i) *= std::conj(factorR(i, i) / sine);
+    } else {
+      sine = 0.0;
+    }
+    double cosine = std::min(cosines(i), 1.0);
+    result.theta[i] = 2.0 * std::atan2(sine, cosine);
+    /// Solve for `r1` from the better conditioned of the two right blocks.
+    if (cosine >= sine)
+      result.r1.row(i) = fromU11.row(i) / cosine;
+    else
+      result.r1.row(i) = fromU01.row(i) / sine;
+  }
+  return result;
+}
+
+/// Result of demultiplexing a block diagonal unitary matrix:
+/// a ⊕ b = (I ⊗ v) x (D ⊕ D.adjoint()) x (I ⊗ w)
+/// where D is diagonal with entries exp(-i phi_j / 2), i.e., the middle factor
+/// is a multiplexed Rz rotation.
+struct DemultiplexComponents {
+  Eigen::MatrixXcd v;
+  Eigen::MatrixXcd w;
+  std::vector<double> phi;
+};
+
+/// Diagonalize `a * b.adjoint() = v D^2 v.adjoint()`. The matrix is normal,
+/// hence its Schur form is diagonal and the Schur vectors are orthonormal even
+/// for degenerate eigenvalues.
+DemultiplexComponents demultiplex(const Eigen::MatrixXcd &a,
+                                  const Eigen::MatrixXcd &b) {
+  Eigen::ComplexSchur<Eigen::MatrixXcd> schur(a * b.adjoint());
+  DemultiplexComponents result;
+  result.v = schur.matrixU();
+  auto size = a.rows();
+  Eigen::VectorXcd diagonal(size);
+  result.phi.resize(size);
+  for (Eigen::Index i = 0; i < size; i++) {
+    diagonal(i) = std::sqrt(schur.matrixT()(i, i));
+    diagonal(i) /= std::abs(diagonal(i));
+    result.phi[i] = -2.0 * std::arg(diagonal(i));
+  }
+  result.w = diagonal.asDiagonal() * result.v.adjoint() * b;
+  return result;
+}
+
+struct MultiQubitOpQSD : public Decomposer {
+  Eigen::MatrixXcd targetMatrix;
+  std::size_t numQubits;
+  /// Decompositions of the unitaries on the last `numQubits - 1` qubits, in
+  /// circuit order. A null entry is the identity.
+  std::array<std::shared_ptr<Decomposer>, 4> blocks;
+  /// Angles of the multiplexed rotations on the first qubit, in circuit order:
+  /// Rz, Ry, Rz.
+  std::vector<double> rightPhi;
+  std::vector<double> theta;
+  std::vector<double> leftPhi;
+
+  /// This logic is based on the quantum Shannon decomposition.
+  /// Ref: https://arxiv.org/pdf/quant-ph/0406176
+  /// The cosine-sine decomposition splits the unitary into a multiplexed Ry
+  /// rotation between two block diagonal unitaries, each of which is in turn
+  /// demultiplexed into a multiplexed Rz rotation between two unitaries on one
+  /// qubit less. These are decomposed recursively, down to the 2-qubit KAK.
+  void decompose() override {
+    auto cs = cosineSine(targetMatrix);
+    theta = std::move(cs.theta);
+    auto right = demultiplex(cs.r0, cs.r1);
+    rightPhi = std::move(right.phi);
+    auto left = demultiplex(cs.l0, cs.l1);
+    leftPhi = std::move(left.phi);
+    std::array<Eigen::MatrixXcd *, 4> matrices = {&right.w, &right.v, &left.w,
+                                                  &left.v};
+    for (std::size_t i = 0; i < blocks.size(); i++)
+      if (!matrices[i]->isIdentity(TOL))
+        blocks[i] = makeDecomposer(*matrices[i]);
+  }
+
+  /// Emit a rotation of \p target by `angles[x]` when \p controls are in the
+  /// state `x`, the first control being the most significant bit. This uses
+  /// the Gray code sequence of `2^k` rotations and CNOTs for `k` controls.
+  /// Ref: https://arxiv.org/pdf/quant-ph/0404089
+  template <typename OP>
+  void emitMultiplexedRotation(PatternRewriter &rewriter, Location loc,
+                               ArrayRef<double> angles, Value target,
+                               ValueRange controls) {
+    std::size_t size = angles.size();
+    std::vector<double> alpha(size, 0.0);
+    bool isMultiplexed = false;
+    for (std::size_t i = 0; i < size; i++) {
+      std::size_t gray = i ^ (i >> 1);
+      for (std::size_t x = 0; x < size; x++)
+        alpha[i] += std::popcount(x & gray) % 2 ? -angles[x] : angles[x];
+      alpha[i] /= size;
+      if (i > 0 && isAboveThreshold(alpha[i]))
+        isMultiplexed = true;
+    }
+    FloatType floatTy = rewriter.getF64Type();
+    auto emitRotation = [&](double angle) {
+      if (!isAboveThreshold(angle))
+        return;
+      auto value = cudaq::opt::factory::createFloatConstant(loc, rewriter,
+                                                            angle, floatTy);
+      rewriter.create<OP>(loc, value, ValueRange{}, target);
+    };
+    if (!isMultiplexed) {
+      emitRotation(alpha[0]);
+      return;
+    }
+    std::size_t numControls = controls.size();
+    for (std::size_t i = 0; i < size; i++) {
+      emitRotation(alpha[i]);
+      std::size_t next = (i + 1) % size;
+      std::size_t changed = (i ^ (i >> 1)) ^ (next ^ (next >> 1));
+      auto control = controls[numControls - 1 - std::countr_zero(changed)];
+      rewriter.create<quake::XOp>(loc, control, target);
+    }
+  }
+
+  void emitDecomposedFuncOp(quake::CustomUnitarySymbolOp customOp,
+                            PatternRewriter &rewriter,
+                            std::string funcName) override {
+    static constexpr std::array<const char *, 4> suffixes = {"wr", "vr", "wl",
+                                                             "vl"};
+    for (std::size_t i = 0; i < blocks.size(); i++)
+      if (blocks[i])
+        blocks[i]->emitDecomposedFuncOp(customOp, rewriter,
+                                        funcName + suffixes[i]);
+    auto parentModule = customOp->getParentOfType<ModuleOp>();
+    Location loc = customOp->getLoc();
+    auto targets = customOp.getTargets();
+    auto funcTy = FunctionType::get(parentModule.getContext(),
+                                    targets.take_front(numQubits).getTypes(),
+                                    {});
+    auto insPt = rewriter.saveInsertionPoint();
+    rewriter.setInsertionPointToStart(parentModule.getBody());
+    auto func =
+        rewriter.create<func::FuncOp>(parentModule->getLoc(), funcName, funcTy);
+    func.setPrivate();
+    auto *block = func.addEntryBlock();
+    rewriter.setInsertionPointToStart(block);
+    auto arguments = func.getArguments();
+    Value first = arguments[0];
+    ValueRange rest = arguments.drop_front();
+    auto emitBlock = [&](std::size_t i) {
+      if (blocks[i])
+        rewriter.create<quake::ApplyOp>(
+            loc, TypeRange{},
+            SymbolRefAttr::get(rewriter.getContext(), funcName + suffixes[i]),
+            false, ValueRange{}, rest);
+    };
+    /// NOTE: Operator notation is right-to-left, whereas circuit notation is
+    /// left-to-right. Hence, operations are applied in reverse order.
+    emitBlock(0);
+    emitMultiplexedRotation<quake::RzOp>(rewriter, loc, rightPhi, first, rest);
+    emitBlock(1);
+    emitMultiplexedRotation<quake::RyOp>(rewriter, loc, theta, first, rest);
+    emitBlock(2);
+    emitMultiplexedRotation<quake::RzOp>(rewriter, loc, leftPhi, first, rest);
+    emitBlock(3);
+    rewriter.create<func::ReturnOp>(loc);
+    rewriter.restoreInsertionPoint(insPt);
+  }
+
+  MultiQubitOpQSD(const Eigen::MatrixXcd &vec) {
+    targetMatrix = vec;
+    numQubits = llvm::Log2_64(vec.rows());
+    decompose();
+  }
+};
+
+std::shared_ptr<Decomposer> makeDecomposer(const Eigen::MatrixXcd &matrix) {
+  switch (matrix.rows()) {
+  case 2:
+    return std::make_shared<OneQubitOpZYZ>(matrix);
+  case 4:
+    return std::make_shared<TwoQubitOpKAK>(matrix);
+  default:
+    return std::make_shared<MultiQubitOpQSD>(matrix);
+  }
+}
+
+/// The decompositions are pure functions of the matrices, hence they are shared
+/// by all the modules compiled in the process, keyed by the content of the
+/// matrices. A custom operation used by many kernels is thus only synthesized
+/// once.
+class DecompositionCache {
+public:
+  static DecompositionCache &get() {
+    static DecompositionCache cache;
+    return cache;
+  }
+
+  std::shared_ptr<Decomposer> lookup(StringRef key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto iter = entries.find(key);
+    return iter == entries.end() ? nullptr : iter->second;
+  }
+
+  void insert(StringRef key, std::shared_ptr<Decomposer> decomposer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries.size() >= maxEntries)
+      entries.clear();
+    entries[key] = std::move(decomposer);
+  }
+
+private:
+  static constexpr std::size_t maxEntries = 1024;
+  std::mutex mutex;
+  llvm::StringMap<std::shared_ptr<Decomposer>> entries;
+};
+
+/// The decompositions of the custom operations of a module, keyed by the name
+/// of their replacement function. A null entry marks a unitary which cannot be
+/// decomposed.
+using DecompositionMap = llvm::StringMap<std::shared_ptr<Decomposer>>;
+
+/// Return the name of the function that replaces the custom operations
+/// generated by `generatorName`.
+static std::string getReplacementName(StringRef generatorName) {
+  auto pair = generatorName.split(".rodata");
+  return pair.first.str() + ".kernel" + pair.second.str();
+}
+
 class CustomUnitaryPattern
     : public OpRewritePattern<quake::CustomUnitarySymbolOp> {
 public:
-  using OpRewritePattern::OpRewritePattern;
+  CustomUnitaryPattern(MLIRContext *ctx, const DecompositionMap &decompositions)
+      : OpRewritePattern(ctx), decompositions(decompositions) {}
 
   LogicalResult matchAndRewrite(quake::CustomUnitarySymbolOp customOp,
                                 PatternRewriter &rewriter) const override {
     auto parentModule = customOp->getParentOfType<ModuleOp>();
-    /// Get the global constant holding the concrete matrix corresponding to
-    /// this custom operation invocation
-    StringRef generatorName = customOp.getGenerator().getRootReference();
-    auto globalOp =
-        parentModule.lookupSymbol<cudaq::cc::GlobalOp>(generatorName);
     /// The decomposed sequence of quantum operations are in a function
-    auto pair = generatorName.split(".rodata");
-    std::string funcName = pair.first.str() + ".kernel" + pair.second.str();
+    std::string funcName =
+        getReplacementName(customOp.getGenerator().getRootReference());
     /// If the replacement function doesn't exist, create it here
     if (!parentModule.lookupSymbol<func::FuncOp>(funcName)) {
-      auto matrix = cudaq::opt::factory::readGlobalConstantArray(globalOp);
-      size_t dimension = std::sqrt(matrix.size());
-      auto unitary =
-          Eigen::Map<Eigen::MatrixXcd>(matrix.data(), dimension, dimension);
-      unitary.transposeInPlace();
-      if (!unitary.isUnitary(TOL)) {
-        customOp.emitWarning("The custom operation matrix must be unitary.");
+      auto iter = decompositions.find(funcName);
+      if (iter == decompositions.end() || !iter->second)
         return failure();
-      }
-      switch (dimension) {
-      case 2: {
-        auto zyz = OneQubitOpZYZ(unitary);
-        zyz.emitDecomposedFuncOp(customOp, rewriter, funcName);
-      } break;
-      case 4: {
-        auto kak = TwoQubitOpKAK(unitary);
-        kak.emitDecomposedFuncOp(customOp, rewriter, funcName);
-      } break;
-      default:
-        customOp.emitWarning(
-            "Decomposition of only 1 and 2 qubit custom operations supported.");
-        return failure();
-      }
+      iter->second->emitDecomposedFuncOp(customOp, rewriter, funcName);
     }
     rewriter.replaceOpWithNewOp<quake::ApplyOp>(
         customOp, TypeRange{},
@@ -482,6 +741,9 @@ public:
         customOp.getControls(), customOp.getTargets());
     return success();
   }
+
+private:
+  const DecompositionMap &decompositions;
 };
 
 class UnitarySynthesisPass
@@ -492,12 +754,69 @@ public:
   void runOnOperation() override {
     auto *ctx = &getContext();
     auto module = getOperation();
+
+    // Collect the concrete matrices of the custom operations which do not have
+    // a replacement function yet, once per generator.
+    struct Unitary {
+      std::string funcName;
+      Operation *customOp;
+      std::vector<std::complex<double>> matrix;
+      std::shared_ptr<Decomposer> decomposer;
+      StringRef warning;
+    };
+    SmallVector<Unitary> unitaries;
+    llvm::StringSet<> seen;
+    module.walk([&](quake::CustomUnitarySymbolOp customOp) {
+      StringRef generatorName = customOp.getGenerator().getRootReference();
+      auto funcName = getReplacementName(generatorName);
+      if (!seen.insert(funcName).second ||
+          module.lookupSymbol<func::FuncOp>(funcName))
+        return;
+      auto globalOp = module.lookupSymbol<cudaq::cc::GlobalOp>(generatorName);
+      auto matrix = cudaq::opt::factory::readGlobalConstantArray(globalOp);
+      unitaries.push_back(
+          {funcName, customOp, std::move(matrix), nullptr, {}});
+    });
+
+    // The decompositions are independent numerical problems, hence they are
+    // computed in parallel and only emitted sequentially, by the patterns,
+    // since they insert functions into the module.
+    parallelForEach(ctx, unitaries, [](Unitary &u) {
+      auto &cache = DecompositionCache::get();
+      StringRef key(reinterpret_cast<const char *>(u.matrix.data()),
+                    u.matrix.size() * sizeof(std::complex<double>));
+      if ((u.decomposer = cache.lookup(key)))
+        return;
+      std::size_t dimension = std::sqrt(u.matrix.size());
+      if (dimension < 2 || !llvm::isPowerOf2_64(dimension)) {
+        u.warning = "The custom operation matrix must be of dimension 2^n.";
+        return;
+      }
+      std::string keyStorage = key.str();
+      auto unitary =
+          Eigen::Map<Eigen::MatrixXcd>(u.matrix.data(), dimension, dimension);
+      unitary.transposeInPlace();
+      if (!unitary.isUnitary(TOL)) {
+        u.warning = "The custom operation matrix must be unitary.";
+        return;
+      }
+      u.decomposer = makeDecomposer(unitary);
+      cache.insert(keyStorage, u.decomposer);
+    });
+
+    DecompositionMap decompositions;
+    for (auto &u : unitaries) {
+      if (!u.warning.empty())
+        u.customOp->emitWarning(u.warning);
+      decompositions[u.funcName] = std::move(u.decomposer);
+    }
+
     for (Operation &op : *module.getBody()) {
       auto func = dyn_cast<func::FuncOp>(op);
       if (!func)
         continue;
       RewritePatternSet patterns(ctx);
-      patterns.insert<CustomUnitaryPattern>(ctx);
+      patterns.insert<CustomUnitaryPattern>(ctx, decompositions);
       LLVM_DEBUG(llvm::dbgs() << "Before unitary synthesis: " << func << '\n');
       if (failed(applyPatternsAndFoldGreedily(func.getOperation(),
                                               std::move(patterns))))
@@ -34,7 +34,8 @@ static std::unordered_map<std::string, cudaq::config::TargetFeatureFlag>
                         {"mgpu", cudaq::config::flagsMgpu},
                         {"mqpu", cudaq::config::flagsMqpu},
                         {"dep-analysis", cudaq::config::flagsDepAnalysis},
-                        {"qpp", cudaq::config::flagsQPP}};
+                        {"qpp", cudaq::config::flagsQPP},
+                        {"mixed", cudaq::config::flagsMixed}};
 }
 
 /// @brief Convert the backend config entry into nvq++ compatible script.
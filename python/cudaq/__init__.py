@@ -143,11 +143,13 @@ from .runtime.observe import observe_async
 from .runtime.run import run
 from .runtime.run import run_async
 from .runtime.translate import translate
-from .runtime.state import (get_state, get_state_async, to_cupy)
+from .runtime.state import (get_state, get_state_async, overlap_matrix,
+                             to_cupy)
 from .runtime.draw import draw
 from .runtime.unitary import get_unitary
 from .runtime.resource_count import estimate_resources
 from .runtime.vqe import vqe  # Removed! Use VQE from CUDA-QX
+from .runtime.utils import await_result as _await_result
 from .kernel.register_op import register_operation
 from .mlir._mlir_libs._quakeDialects import cudaq_runtime
 
@@ -176,6 +178,7 @@ pauli_word = cudaq_runtime.pauli_word
 Tensor = cudaq_runtime.Tensor
 SimulationPrecision = cudaq_runtime.SimulationPrecision
 Resources = cudaq_runtime.Resources
+JITCacheStatistics = cudaq_runtime.JITCacheStatistics
 
 # to be deprecated
 qreg = cudaq_runtime.qvector
@@ -196,6 +199,7 @@ from .dynamics.schedule import Schedule
 from .dynamics.evolution import evolve, evolve_async
 from .dynamics.integrators import *
 from .dynamics.helpers import IntermediateResultSave
+from .dynamics.operator_action import OperatorAction, apply_operator
 
 InitialStateType = cudaq_runtime.InitialStateType
 
@@ -213,7 +217,12 @@ has_target = cudaq_runtime.has_target
 get_target = cudaq_runtime.get_target
 get_targets = cudaq_runtime.get_targets
 set_random_seed = cudaq_runtime.set_random_seed
+get_jit_cache_statistics = cudaq_runtime.get_jit_cache_statistics
+reset_jit_cache_statistics = cudaq_runtime.reset_jit_cache_statistics
+set_jit_cache_capacity = cudaq_runtime.set_jit_cache_capacity
+clear_jit_cache = cudaq_runtime.clear_jit_cache
 mpi = cudaq_runtime.mpi
+profiler = cudaq_runtime.profiler
 num_available_gpus = cudaq_runtime.num_available_gpus
 set_noise = cudaq_runtime.set_noise
 unset_noise = cudaq_runtime.unset_noise
@@ -244,7 +253,11 @@ ObserveResult = cudaq_runtime.ObserveResult
 AsyncObserveResult = cudaq_runtime.AsyncObserveResult
 EvolveResult = cudaq_runtime.EvolveResult
 AsyncEvolveResult = cudaq_runtime.AsyncEvolveResult
+EvolveStepResult = cudaq_runtime.EvolveStepResult
+RingBufferSink = cudaq_runtime.RingBufferSink
 AsyncStateResult = cudaq_runtime.AsyncStateResult
+for _asyncResult in (AsyncObserveResult, AsyncEvolveResult, AsyncStateResult):
+    _asyncResult.__await__ = _await_result
 displaySVG = display_trace.displaySVG
 getSVGstring = display_trace.getSVGstring
 
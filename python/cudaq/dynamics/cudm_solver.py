@@ -7,7 +7,8 @@
 # ============================================================================ #
 
 from __future__ import annotations
-from typing import Sequence, Mapping, Optional
+import math
+from typing import Callable, Sequence, Mapping, Optional
 
 from .schedule import Schedule
 from ..operators import Operator
@@ -117,9 +118,12 @@ def determine_batch_size(hamiltonians: Sequence[Operator] |
                          Sequence[SuperOperator],
                          collapse_operators: Sequence[Operator] |
                          Sequence[Sequence[Operator]],
-                         max_batch_size: Optional[int] = None) -> int:
+                         max_batch_size: Optional[int] = None,
+                         memory_batch_size: Optional[int] = None) -> int:
     """
-    Determine the batch size for the dynamics evolution
+    Determine the batch size for the dynamics evolution.
+    If `max_batch_size` is not provided, the batch size is capped by
+    `memory_batch_size`, the number of batch members that fit in device memory.
     """
     can_be_batched = bindings.checkSuperOpBatchingCompatibility(
         hamiltonians) if isinstance(
@@ -146,6 +150,8 @@ def determine_batch_size(hamiltonians: Sequence[Operator] |
     if max_batch_size is None:
         # Use the number of super-operators as the batch size.
         max_batch_size = len(hamiltonians)
+        if memory_batch_size is not None:
+            max_batch_size = min(max_batch_size, memory_batch_size)
 
     return max_batch_size
 
@@ -191,7 +197,10 @@ def evolve_dynamics(
     store_intermediate_results: IntermediateResultSave = IntermediateResultSave.
     NONE,
     integrator: Optional[BaseIntegrator] = None,
-    max_batch_size: Optional[int] = None
+    max_batch_size: Optional[int] = None,
+    sink: Optional[Callable[[cudaq_runtime.EvolveStepResult], None]] = None,
+    sink_batch_offset: int = 0,
+    shots_count: Optional[int] = None
 ) -> cudaq_runtime.EvolveResult | Sequence[cudaq_runtime.EvolveResult]:
     # Reset the schedule
     schedule.reset()
@@ -202,7 +211,7 @@ def evolve_dynamics(
             "store_intermediate_results must be an instance of IntermediateResultSave"
         )
     # Check that the integrator can support distributed state if this is a distributed simulation.
-    if cudaq_runtime.mpi.is_initialized() and cudaq_runtime.mpi.num_ranks(
+    if bindings.getNumRanks(
     ) > 1 and integrator is not None and not integrator.support_distributed_state(
     ):
         raise ValueError(
@@ -223,11 +232,49 @@ def evolve_dynamics(
 
     is_super_op = isinstance(hamiltonian, SuperOperator) or (isinstance(
         hamiltonian, Sequence) and isinstance(hamiltonian[0], SuperOperator))
+
+    # With a number of shots, an open system with a state vector is unravelled
+    # into as many quantum trajectories, evolved as a batch of state vectors.
+    num_trajectories = None
+    if shots_count is not None and has_collapse_operators and not is_super_op and not isinstance(
+            hamiltonian, Sequence):
+        single_state = initial_state[0] if isinstance(
+            initial_state, Sequence) and len(
+                initial_state) == 1 else initial_state
+        if isinstance(single_state, InitialState) or (
+                isinstance(single_state, cudaq_runtime.State) and
+                single_state.getTensor().get_num_elements() == math.prod(
+                    hilbert_space_dims)):
+            if shots_count < 1:
+                raise ValueError(
+                    f"Invalid shots_count {shots_count} for quantum trajectories. It must be at least 1."
+                )
+            if bindings.getNumRanks() > 1:
+                raise ValueError(
+                    "Quantum trajectories are not supported in distributed mode."
+                )
+            num_trajectories = shots_count
+            initial_state = single_state
+            has_collapse_operators = False
+
+    # Unless the batch size is specified, split the batch members into batches
+    # that fit in device memory.
+    memory_batch_size = None
+    if max_batch_size is None and isinstance(
+            initial_state, Sequence) and len(initial_state) > 1:
+        num_stored_states = len(
+            schedule._steps
+        ) if store_intermediate_results == IntermediateResultSave.ALL else 1
+        memory_batch_size = bindings.maxBatchSizeInDeviceMemory(
+            initial_state[0], list(hilbert_space_dims), has_collapse_operators,
+            num_stored_states)
+
     if isinstance(hamiltonian, Sequence):
         # Batch Hamiltonian or super-operators
         batch_size_to_run = determine_batch_size(hamiltonian,
                                                  collapse_operators,
-                                                 max_batch_size)
+                                                 max_batch_size,
+                                                 memory_batch_size)
         if batch_size_to_run < len(hamiltonian):
             # Need to split the simulation into smaller batches.
             ham_batches, collapse_batches, initial_state_batches = split_simulation_batches(
@@ -241,10 +288,18 @@ def evolve_dynamics(
                 batch_initial_states = initial_state_batches[batch_idx]
 
                 # Run the simulation for the current batch.
-                result = evolve_dynamics(batch_hamiltonian, dimensions,
-                                         schedule, batch_initial_states,
-                                         batch_collapse_ops, observables,
-                                         store_intermediate_results, integrator)
+                result = evolve_dynamics(
+                    batch_hamiltonian,
+                    dimensions,
+                    schedule,
+                    batch_initial_states,
+                    batch_collapse_ops,
+                    observables,
+                    store_intermediate_results,
+                    integrator,
+                    sink=sink,
+                    sink_batch_offset=sink_batch_offset +
+                    batch_idx * batch_size_to_run)
                 if isinstance(result, Sequence):
                     # If the result is a sequence, append each result.
                     all_results.extend(result)
@@ -252,6 +307,27 @@ def evolve_dynamics(
                     all_results.append(result)
             # Return the results for all batches.
             return all_results
+    elif memory_batch_size is not None and memory_batch_size < len(
+            initial_state):
+        # Batch of initial states that does not fit in device memory at once.
+        all_results = []
+        for i in range(0, len(initial_state), memory_batch_size):
+            result = evolve_dynamics(hamiltonian,
+                                     dimensions,
+                                     schedule,
+                                     initial_state[i:i + memory_batch_size],
+                                     collapse_operators,
+                                     observables,
+                                     store_intermediate_results,
+                                     integrator,
+                                     memory_batch_size,
+                                     sink=sink,
+                                     sink_batch_offset=sink_batch_offset + i)
+            if isinstance(result, Sequence):
+                all_results.extend(result)
+            else:
+                all_results.append(result)
+        return all_results
 
     # Main simulation flow for single evolution or fully-batched evolution.
     if is_super_op:
@@ -261,15 +337,33 @@ def evolve_dynamics(
                               collapse_operators)
 
     hilbert_space_dims_list = list(hilbert_space_dims)
-    expectation_op = [
-        bindings.CuDensityMatExpectation(MatrixOperator(observable),
-                                         hilbert_space_dims_list)
-        for observable in observables
-    ]
+    # All the observables are evaluated together, with a single copy of their
+    # values to the host per step.
+    expectation_op = bindings.CuDensityMatFusedExpectation(
+        [MatrixOperator(observable) for observable in observables],
+        hilbert_space_dims_list)
 
     batch_size = 1
     is_batched_evolve = False
-    if isinstance(initial_state, Sequence) and len(initial_state) > 1:
+    quantum_jumps = None
+    if num_trajectories is not None:
+        if isinstance(initial_state, InitialState):
+            initial_state = bindings.createInitialState(initial_state,
+                                                        dimensions, False)
+        else:
+            initial_state = bindings.initializeState(initial_state,
+                                                     hilbert_space_dims_list,
+                                                     False, 1)
+        if num_trajectories > 1:
+            initial_state = bindings.createBatchedState(
+                [initial_state] * num_trajectories, hilbert_space_dims_list,
+                False)
+        quantum_jumps = bindings.QuantumJumps(
+            bindings.Schedule(schedule._steps, list(schedule._parameters)),
+            hilbert_space_dims_list, MatrixOperator(hamiltonian),
+            [MatrixOperator(c_op) for c_op in collapse_operators],
+            num_trajectories)
+    elif isinstance(initial_state, Sequence) and len(initial_state) > 1:
         batch_size = len(initial_state)
         initial_state = bindings.createBatchedState(initial_state,
                                                     hilbert_space_dims_list,
@@ -288,13 +382,14 @@ def evolve_dynamics(
                                                      has_collapse_operators, 1)
     integrator.set_state(initial_state, schedule._steps[0])
 
+    sink_pipeline = bindings.EvolveSinkPipeline(
+        sink) if sink is not None else None
     exp_vals = [[] for _ in range(batch_size)]
     intermediate_states = [[] for _ in range(batch_size)]
 
     # Get MPI state for distributed mode handling
-    is_mpi_init = cudaq_runtime.mpi.is_initialized()
-    mpi_rank = cudaq_runtime.mpi.rank() if is_mpi_init else 0
-    mpi_num_ranks = cudaq_runtime.mpi.num_ranks() if is_mpi_init else 1
+    mpi_rank = bindings.getRank()
+    mpi_num_ranks = bindings.getNumRanks()
 
     # We requires an even partition for distributed batched states.
     if batch_size > 1 and batch_size % mpi_num_ranks != 0:
@@ -307,49 +402,70 @@ def evolve_dynamics(
         if step_idx > 0:
             with ScopeTimer("evolve.integrator.integrate") as timer:
                 integrator.integrate(schedule.current_step)
+            if quantum_jumps is not None:
+                t, state = integrator.get_state()
+                if quantum_jumps.apply(state, t):
+                    integrator.set_state(state, t)
         # If we store intermediate values, compute them for each step.
         # Otherwise, just for the last step.
-        if store_intermediate_results != IntermediateResultSave.NONE or step_idx == (
-                len(schedule) - 1):
+        # The sink receives the results of every step.
+        is_last_step = step_idx == (len(schedule) - 1)
+        store_results = store_intermediate_results != IntermediateResultSave.NONE or is_last_step
+        if store_results or sink_pipeline is not None:
             step_exp_vals = [[] for _ in range(batch_size)]
             _, state = integrator.get_state()
-            for obs_idx, obs in enumerate(expectation_op):
-                obs.prepare(state)
-                exp_val = obs.compute(state, schedule.current_step)
+            if quantum_jumps is not None:
+                # The observables are averaged over the normalized trajectories.
+                state = bindings.QuantumJumps.normalized(state)
+            for exp_val in expectation_op.compute(state,
+                                                  schedule.current_step):
+                if quantum_jumps is not None:
+                    exp_val = [sum(exp_val) / len(exp_val)]
                 for i in range(batch_size):
                     step_exp_vals[i].append(exp_val[i])
 
-            for i in range(batch_size):
-                exp_vals[i].append(step_exp_vals[i])
+            if store_results:
+                for i in range(batch_size):
+                    exp_vals[i].append(step_exp_vals[i])
             # Store all intermediate states if requested. Otherwise, only the last state.
-            if store_intermediate_results == IntermediateResultSave.ALL or step_idx == (
-                    len(schedule) - 1):
-                split_states = bindings.splitBatchedState(state)
+            store_states = store_intermediate_results == IntermediateResultSave.ALL or is_last_step
+            if store_states or sink_pipeline is not None:
+                split_states = [
+                    state
+                ] if quantum_jumps is not None else bindings.splitBatchedState(
+                    state)
                 # In distributed mode, the split operation only returns the
                 # local states held by this rank. The number of split states
                 # may be less than batch_size.
                 local_num_states = len(split_states)
-                if local_num_states == batch_size:
-                    # Non-distributed mode: all states are local
-                    for i in range(batch_size):
-                        intermediate_states[i].append(split_states[i])
-                else:
-                    # Distributed mode: only some states are local.
-                    # Calculate the batch offset for this rank based on even
-                    # distribution of states across ranks.
-                    states_per_rank = batch_size // mpi_num_ranks
-                    batch_offset = mpi_rank * states_per_rank
-                    for i, split_state in enumerate(split_states):
-                        global_idx = batch_offset + i
-                        if global_idx < batch_size:
-                            intermediate_states[global_idx].append(split_state)
-
+                # Non-distributed mode: all states are local. In distributed
+                # mode, calculate the batch offset for this rank based on even
+                # distribution of states across ranks.
+                batch_offset = 0 if local_num_states == batch_size else mpi_rank * (
+                    batch_size // mpi_num_ranks)
+                for i, split_state in enumerate(split_states):
+                    global_idx = batch_offset + i
+                    if global_idx >= batch_size:
+                        continue
+                    if sink_pipeline is not None:
+                        sink_pipeline.push(sink_batch_offset + global_idx,
+                                           step_idx,
+                                           schedule.current_step.real,
+                                           split_state,
+                                           step_exp_vals[global_idx])
+                    if store_states:
+                        # The state of a single evolution is sharded across
+                        # the ranks, it may be assembled on rank 0.
+                        intermediate_states[global_idx].append(
+                            bindings.gatherResultState(split_state))
+
+    if sink_pipeline is not None:
+        sink_pipeline.finish()
     bindings.clearContext()
 
     # In distributed mode, only create results for states that have data.
     # Check if we're in distributed mode and filter accordingly.
-    is_distributed = cudaq_runtime.mpi.is_initialized(
-    ) and cudaq_runtime.mpi.num_ranks() > 1
+    is_distributed = mpi_num_ranks > 1
 
     if is_distributed:
         # In distributed mode, each rank only has local states.
@@ -333,7 +333,8 @@ def evolve(
     bool = IntermediateResultSave.NONE,
     integrator: Optional[BaseIntegrator] = None,
     shots_count: Optional[int] = None,
-    max_batch_size: Optional[int] = None
+    max_batch_size: Optional[int] = None,
+    sink: Optional[Callable[[cudaq_runtime.EvolveStepResult], None]] = None
 ) -> cudaq_runtime.EvolveResult | Sequence[cudaq_runtime.EvolveResult]:
     """
     Computes the time evolution of one or more initial state(s) under the defined 
@@ -360,7 +361,16 @@ def evolve(
             and otherwise only the final expectation values at the end of the 
             evolution are computed.
         shots_count: Optional integer, if provided, it is the number of shots to use
-            for QPU execution.
+            for QPU execution. On the `dynamics` target, an open system whose initial
+            state is a state vector is then unravelled into `shots_count` quantum
+            trajectories, evolved as a batch of state vectors, instead of evolving
+            its density matrix. The expectation values are averaged over the
+            trajectories.
+        sink: Optional callable receiving an `EvolveStepResult` with the state data
+            and the expectation values of every step of each evolution, as they are
+            produced, from a separate thread (`dynamics` target only). Use it with
+            `store_intermediate_results` set to `NONE` to stream the results of long
+            evolutions instead of keeping them in memory, e.g., with a `RingBufferSink`.
 
     Returns:
         A single evolution result if a single initial state is provided, or a sequence
@@ -416,12 +426,18 @@ def evolve(
                 f"Valid `initial_state` must be provided for target {target_name}"
             )
 
-    if target_name == "dynamics" and shots_count is not None:
-        warnings.warn(f"`shots_count` will be ignored on target {target_name}")
+    if target_name == "dynamics" and shots_count is not None and len(
+            collapse_operators) == 0:
+        warnings.warn(
+            f"`shots_count` will be ignored on target {target_name} without `collapse_operators`"
+        )
 
     if target_name != "dynamics" and max_batch_size is not None:
         warnings.warn(f"`batch_size` will be ignored on target {target_name}")
 
+    if target_name != "dynamics" and sink is not None:
+        warnings.warn(f"`sink` will be ignored on target {target_name}")
+
     if max_batch_size is not None and max_batch_size < 1:
         raise ValueError(
             f"Invalid max_batch_size {max_batch_size}. It must be at least 1.")
@@ -436,10 +452,9 @@ def evolve(
         if not isinstance(initial_state, Sequence):
             initial_state = [initial_state] * len(hamiltonian)
 
-        if len(hamiltonian) != len(initial_state):
+        if len(initial_state) == 0:
             raise ValueError(
-                "If `hamiltonian` is a sequence, then `initial_state` must be a sequence of the same length."
-            )
+                "If `initial_state` is a sequence, then it must not be empty.")
 
         if isinstance(hamiltonian[0], Operator):
             if len(collapse_operators) == 0:
@@ -456,6 +471,19 @@ def evolve(
                         "If `hamiltonian` is a sequence, then `collapse_operators` must be a sequence of lists of collapse operators (nested sequence)."
                     )
 
+        # Hamiltonians and initial states of the same length are paired,
+        # otherwise every Hamiltonian evolves every initial state.
+        if len(hamiltonian) != len(initial_state):
+            num_states = len(initial_state)
+            hamiltonian = [ham for ham in hamiltonian for _ in range(num_states)]
+            if isinstance(hamiltonian[0], Operator):
+                collapse_operators = [
+                    collapse_ops for collapse_ops in collapse_operators
+                    for _ in range(num_states)
+                ]
+            initial_state = list(initial_state) * (len(hamiltonian) //
+                                                   num_states)
+
     if target_name == "dynamics":
         try:
             from .cudm_solver import evolve_dynamics
@@ -466,7 +494,9 @@ def evolve(
         return evolve_dynamics(hamiltonian, dimensions, schedule, initial_state,
                                collapse_operators, observables,
                                store_intermediate_results, integrator,
-                               max_batch_size)
+                               max_batch_size,
+                               sink=sink,
+                               shots_count=shots_count)
     else:
         if isinstance(initial_state, Sequence):
             return [
@@ -672,8 +702,11 @@ def evolve_async(
                 f"Valid `initial_state` must be provided for target {target_name}"
             )
 
-    if target_name == "dynamics" and shots_count is not None:
-        warnings.warn(f"`shots_count` will be ignored on target {target_name}")
+    if target_name == "dynamics" and shots_count is not None and len(
+            collapse_operators) == 0:
+        warnings.warn(
+            f"`shots_count` will be ignored on target {target_name} without `collapse_operators`"
+        )
 
     if isinstance(initial_state, Sequence):
         return [
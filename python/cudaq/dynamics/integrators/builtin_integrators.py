@@ -47,6 +47,14 @@ class cuDensityMatTimeStepper(BaseTimeStepper[State]):
     def compute_inplace(self, state: State, t: float, outState: State):
         self.stepper.compute(state, t, outState)
 
+    # Add the action at time `t` on the device array `array` to the device
+    # array `out_array`, e.g., `torch` tensors or `cupy` arrays, exchanged
+    # through DLPack without copy. The computation is only enqueued on the
+    # legacy default CUDA stream, which is synchronized with the streams of
+    # the arrays by the DLPack protocol.
+    def compute_dlpack(self, array, t: float, out_array, dims, batch_size=1):
+        self.stepper.compute_dlpack(array, t, out_array, dims, batch_size)
+
 
 class cuDensityMatSuperOpTimeStepper(cuDensityMatTimeStepper):
     # Time-stepper which takes super-operator as system dynamics
@@ -135,3 +143,59 @@ class RungeKuttaIntegrator(BaseIntegrator[State]):
 
     def integrate(self, t):
         self.rk_integrator.integrate(t)
+
+
+class DormandPrinceIntegrator(RungeKuttaIntegrator):
+    # Adaptive step size integrator with the embedded 5(4) Dormand-Prince pair.
+    # The step size is chosen so that the local error estimate of each step is
+    # within `atol + rtol * |y|`.
+    rtol = 1e-6
+    atol = 1e-8
+    max_step_size = None
+
+    def __init__(self, **kwargs):
+        if not has_cupy:
+            raise ImportError('CuPy is required to use integrators.')
+        BaseIntegrator.__init__(self, **kwargs)
+        self.rk_integrator = bindings.integrators.dormand_prince(
+            rtol=self.rtol, atol=self.atol, max_step_size=self.max_step_size)
+
+    def __post_init__(self):
+        if "rtol" in self.integrator_options:
+            self.rtol = self.integrator_options["rtol"]
+        if "atol" in self.integrator_options:
+            self.atol = self.integrator_options["atol"]
+        if self.rtol < 0 or self.atol < 0 or (self.rtol == 0 and
+                                              self.atol == 0):
+            raise ValueError(
+                "The 'rtol' and 'atol' parameters must be non-negative and "
+                "not both zero.")
+        if "max_step_size" in self.integrator_options:
+            self.max_step_size = self.integrator_options["max_step_size"]
+
+
+class KrylovIntegrator(RungeKuttaIntegrator):
+    # Krylov subspace exponential integrator for time-independent systems.
+    # Each step is computed with at most `max_subspace_dim` operator
+    # applications, to within `tolerance` relative to the norm of the state.
+    tolerance = 1e-10
+    max_subspace_dim = 30
+
+    def __init__(self, **kwargs):
+        if not has_cupy:
+            raise ImportError('CuPy is required to use integrators.')
+        BaseIntegrator.__init__(self, **kwargs)
+        self.rk_integrator = bindings.integrators.krylov(
+            tolerance=self.tolerance, max_subspace_dim=self.max_subspace_dim)
+
+    def __post_init__(self):
+        if "tolerance" in self.integrator_options:
+            self.tolerance = self.integrator_options["tolerance"]
+            if self.tolerance <= 0:
+                raise ValueError(
+                    "The 'tolerance' parameter must be a positive number.")
+        if "max_subspace_dim" in self.integrator_options:
+            self.max_subspace_dim = self.integrator_options["max_subspace_dim"]
+            if self.max_subspace_dim < 2:
+                raise ValueError(
+                    "The 'max_subspace_dim' parameter must be at least 2.")
@@ -116,26 +116,28 @@ class CUDATorchDiffEqIntegrator(BaseIntegrator[cudaq_runtime.State]):
         # Note: this RHS compute is on the hot path of the integrator;
         # hence, we minimize overhead as much as possible.
         # In particular, avoid data conversion between different frameworks.
-        # For example, `dlpack` conversion between `torch` and `cupy` incurs non-trivial overhead (potentially involve CUDA runtime calls).
-        # Get device pointer of the input torch tensor
-        device_ptr = vec.data_ptr()
-        size = vec.numel()
-
+        # The tensors are exchanged with the time stepper through DLPack,
+        # without copy, and the action is only enqueued on the default CUDA
+        # stream, without host synchronization.
         if self._dimensions_list is None:
             self._dimensions_list = list(self.dimensions)
 
-        # Wrap the device pointer as a `cudaq::state` (no copy)
-        temp_state = bindings.initializeState(device_ptr, size,
-                                              self._dimensions_list,
-                                              self.batchSize)
-        # Pre-allocate output tensor (torch tensor)
+        # Pre-allocate output tensor (torch tensor), which the action is
+        # accumulated into
         result_vec = torch.zeros_like(vec)
-        # Wrap the output tensor device pointer as a `cudaq::state` (no copy)
-        result_state = bindings.initializeState(result_vec.data_ptr(), size,
-                                                self._dimensions_list,
-                                                self.batchSize)
-        # Compute the RHS into the output state
-        self.stepper.compute_inplace(temp_state, t_scalar, result_state)
+        if hasattr(self.stepper, 'compute_dlpack'):
+            self.stepper.compute_dlpack(vec.detach(), t_scalar, result_vec,
+                                        self._dimensions_list, self.batchSize)
+        else:
+            # Wrap the device pointers as `cudaq::state` (no copy)
+            temp_state = bindings.initializeState(vec.data_ptr(), vec.numel(),
+                                                  self._dimensions_list,
+                                                  self.batchSize)
+            result_state = bindings.initializeState(result_vec.data_ptr(),
+                                                    result_vec.numel(),
+                                                    self._dimensions_list,
+                                                    self.batchSize)
+            self.stepper.compute_inplace(temp_state, t_scalar, result_state)
         return result_vec
 
     def _create_wrapped_rhs_func(self):
@@ -0,0 +1,102 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+
+from __future__ import annotations
+import numpy
+from typing import Any, Mapping
+
+from ..mlir._mlir_libs._quakeDialects import cudaq_runtime
+from ..operators import NumericType, Operator
+
+
+class OperatorAction:
+    """
+    The action of an operator on a batch of state vectors, computed on the GPU
+    by cuDensityMat without forming the matrix of the operator. This requires
+    the `dynamics` target. The operator is converted once, and its action is
+    prepared for the shape of the first batch it is applied to, so that
+    applying it repeatedly, e.g., in an iterative solver, is cheap.
+    """
+
+    def __init__(self, operator: Operator, dimensions: Mapping[int, int]):
+        """
+        Arguments:
+            operator: The operator to apply.
+            dimensions: A mapping that specifies the number of levels, that is
+                the dimension, of each degree of freedom the operator acts on.
+        """
+        if cudaq_runtime.get_target().name != "dynamics":
+            raise RuntimeError(
+                "OperatorAction requires the 'dynamics' target.")
+        try:
+            import cupy
+        except ImportError:
+            raise ImportError("OperatorAction requires CuPy.")
+        from . import nvqir_dynamics_bindings as bindings
+        self._bindings = bindings
+        self._dimensions = [dimensions[d] for d in range(len(dimensions))]
+        self._dimension = int(numpy.prod(self._dimensions))
+        self._operator = cudaq_runtime.MatrixOperator(operator)
+        self._action = None
+
+    def __call__(self,
+                 vectors: Any,
+                 time: float = 0.0,
+                 **parameters: NumericType) -> Any:
+        """
+        Apply the operator to `vectors`, a single state vector or a
+        two-dimensional array holding one state vector per row, in the order of
+        the states given to `evolve`. CuPy arrays are used in place on the
+        device, and the result is returned as a CuPy array; other arrays are
+        copied to the device, and the result is returned as a NumPy array.
+
+        Arguments:
+            vectors: The state vectors to apply the operator to.
+            time: The time at which the operator is evaluated.
+            parameters: The values of the parameters of the operator.
+        """
+        import cupy
+        on_device = isinstance(vectors, cupy.ndarray)
+        input_vectors = cupy.ascontiguousarray(vectors, dtype=cupy.complex128)
+        if input_vectors.ndim not in (1, 2) or input_vectors.shape[-1] != \
+                self._dimension:
+            raise ValueError(
+                f"Expected vectors of dimension {self._dimension}, got an "
+                f"array of shape {input_vectors.shape}.")
+        batch_size = 1 if input_vectors.ndim == 1 else input_vectors.shape[0]
+        output_vectors = cupy.zeros_like(input_vectors)
+
+        complex_parameters = {
+            name: complex(value) for name, value in parameters.items()
+        }
+        if self._action is None:
+            self._action = self._bindings.CuDensityMatOperatorAction(
+                self._operator, self._dimensions, complex_parameters)
+        # The states borrow the device buffers of the arrays.
+        input_state = self._bindings.initializeState(
+            input_vectors.data.ptr, input_vectors.size, self._dimensions,
+            batch_size)
+        output_state = self._bindings.initializeState(
+            output_vectors.data.ptr, output_vectors.size, self._dimensions,
+            batch_size)
+        self._action.compute(input_state, output_state, time,
+                             complex_parameters)
+        return output_vectors if on_device else cupy.asnumpy(output_vectors)
+
+
+def apply_operator(operator: Operator,
+                   vectors: Any,
+                   dimensions: Mapping[int, int],
+                   time: float = 0.0,
+                   **parameters: NumericType) -> Any:
+    """
+    Apply `operator` to `vectors` on the GPU without forming its matrix. See
+    `OperatorAction`, which is to be preferred to apply the same operator
+    several times.
+    """
+    return OperatorAction(operator, dimensions)(vectors, time, **parameters)
@@ -353,17 +353,21 @@ class PyStack(object):
 
 def recover_kernel_decorator(name):
     from .kernel_decorator import isa_kernel_decorator
-    for frameinfo in inspect.stack():
-        frame = frameinfo.frame
-        if name in frame.f_locals:
-            if isa_kernel_decorator(frame.f_locals[name]):
-                return frame.f_locals[name]
-            return None
-        if name in frame.f_globals:
-            if isa_kernel_decorator(frame.f_globals[name]):
-                return frame.f_globals[name]
-            return None
-    return None
+    frame = inspect.currentframe()
+    try:
+        while frame is not None:
+            if name in frame.f_locals:
+                if isa_kernel_decorator(frame.f_locals[name]):
+                    return frame.f_locals[name]
+                return None
+            if name in frame.f_globals:
+                if isa_kernel_decorator(frame.f_globals[name]):
+                    return frame.f_globals[name]
+                return None
+            frame = frame.f_back
+        return None
+    finally:
+        del frame
 
 
 class PyASTBridge(ast.NodeVisitor):
@@ -450,6 +454,12 @@ class PyASTBridge(ast.NodeVisitor):
         self.verbose = 'verbose' in kwargs and kwargs['verbose']
         self.currentNode = None
         self.firstLiftedPos = None
+        # The resolution of the non-local symbols and the types do not change
+        # while this function is compiled, and are looked up for most nodes.
+        self.recoveredValues = {}
+        self.recoveredDecorators = {}
+        self.integerTypes = {}
+        self.floatTypes = {}
 
     def debug_msg(self, msg, node=None):
         if self.verbose:
@@ -544,12 +554,34 @@ class PyASTBridge(ast.NodeVisitor):
         eleTys = cc.StructType.getTypes(ty)
         return any((self.containsList(t) for t in eleTys))
 
+    def recoverValue(self, name):
+        """
+        Return the Python value of the non-local symbol `name`, or None, from
+        the enclosing context of the kernel.
+        """
+        if name not in self.recoveredValues:
+            self.recoveredValues[name] = recover_value_of_or_none(name, None)
+        return self.recoveredValues[name]
+
+    def recoverKernelDecorator(self, name):
+        """
+        Return the kernel decorator bound to the non-local symbol `name`, or
+        None.
+        """
+        if name not in self.recoveredDecorators:
+            self.recoveredDecorators[name] = recover_kernel_decorator(name)
+        return self.recoveredDecorators[name]
+
     def getIntegerType(self, width=64):
         """
         Return an MLIR `IntegerType` of the given bit width (defaults to 64
         bits).
         """
-        return IntegerType.get_signless(width)
+        ty = self.integerTypes.get(width)
+        if ty is None:
+            ty = IntegerType.get_signless(width, context=self.ctx)
+            self.integerTypes[width] = ty
+        return ty
 
     def getIntegerAttr(self, type, value):
         """
@@ -564,14 +596,19 @@ class PyASTBridge(ast.NodeVisitor):
         # Note:
         # `numpy.float64` is the same as `float` type, with width of 64 bit.
         # `numpy.float32` type has width of 32 bit.
+        ty = self.floatTypes.get(width)
+        if ty is not None:
+            return ty
         if width == 64:
-            return F64Type.get()
+            ty = F64Type.get(context=self.ctx)
         elif width == 32:
-            return F32Type.get()
+            ty = F32Type.get(context=self.ctx)
         else:
             self.emitFatalError(
                 f'unsupported width {width} requested for float type',
                 self.currentNode)
+        self.floatTypes[width] = ty
+        return ty
 
     def getFloatAttr(self, type, value):
         """
@@ -2574,7 +2611,7 @@ class PyASTBridge(ast.NodeVisitor):
                 name = f"{path}.{name}"
                 decorator = resolve_qualified_symbol(name)
             else:
-                decorator = recover_kernel_decorator(name)
+                decorator = self.recoverKernelDecorator(name)
 
             if decorator and not name in self.symbolTable:
                 if name not in self.liftedArgs:
@@ -3587,8 +3624,7 @@ class PyASTBridge(ast.NodeVisitor):
                             numParams = channel_class.num_parameters
                             key = self.getConstantInt(hash(channel_class))
                         elif isinstance(node.args[0], ast.Name):
-                            arg = recover_value_of_or_none(
-                                node.args[0].id, None)
+                            arg = self.recoverValue(node.args[0].id)
                             if (arg and isinstance(arg, type) and issubclass(
                                     arg, cudaq_runtime.KrausChannel)):
                                 if not hasattr(arg, 'num_parameters'):
@@ -3909,7 +3945,7 @@ class PyASTBridge(ast.NodeVisitor):
             elif isinstance(pyval, ast.Call):
                 if isinstance(pyval.func, ast.Name):
                     # supported for calls but not here: 'range', 'enumerate'
-                    decorator = recover_kernel_decorator(pyval.func.id)
+                    decorator = self.recoverKernelDecorator(pyval.func.id)
                     if decorator:
                         # Not necessarily unitary
                         resTy = decorator.handle_call_results()
@@ -5280,7 +5316,7 @@ class PyASTBridge(ast.NodeVisitor):
             return
 
         # Check if a non-local symbol, and process it.
-        value = recover_value_of_or_none(node.id, None)
+        value = self.recoverValue(node.id)
         if is_recovered_value_ok(value):
             from .kernel_decorator import isa_kernel_decorator
             from .kernel_builder import isa_dynamic_kernel
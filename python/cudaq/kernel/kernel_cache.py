@@ -0,0 +1,193 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+"""
+On-disk cache of the Quake modules generated from decorated kernels, enabled by
+setting `CUDAQ_PYTHON_KERNEL_CACHE_DIR` to a directory. A new interpreter
+session defining the same kernel loads the module from the cache rather than
+running the AST bridge again.
+
+Entries are keyed by a hash of everything the generated code depends on: the
+kernel source and location, the types of the symbols it refers to, the values
+of the module attributes it reads, the registered operations and data classes
+it uses, the target and the CUDA-Q version. Entries are written to a temporary
+file and renamed into place, so concurrent processes never read a partial
+entry, and unreadable entries are ignored.
+"""
+
+import ast
+import hashlib
+import json
+import os
+import tempfile
+import types
+
+import numpy as np
+
+from cudaq.mlir._mlir_libs._quakeDialects import cudaq_runtime
+from cudaq.mlir.ir import FunctionType, TypeAttr
+from .utils import (globalRegisteredOperations, globalRegisteredTypes,
+                    nvqppPrefix, recover_func_op, recover_value_of_or_none,
+                    resolve_qualified_symbol)
+
+CACHE_DIR_ENV_VAR = 'CUDAQ_PYTHON_KERNEL_CACHE_DIR'
+
+
+def cache_directory():
+    """
+    Return the cache directory, or `None` if the cache is disabled.
+    """
+    return os.environ.get(CACHE_DIR_ENV_VAR) or None
+
+
+def _referenced_names(astModule):
+    """
+    Return the names and the dotted attribute chains (e.g., `np.pi`) that the
+    kernel refers to.
+    """
+
+    def dotted(node):
+        if isinstance(node, ast.Name):
+            return node.id
+        if isinstance(node, ast.Attribute):
+            base = dotted(node.value)
+            return f'{base}.{node.attr}' if base else None
+        return None
+
+    names = set()
+    for node in ast.walk(astModule):
+        if isinstance(node, (ast.Name, ast.Attribute)):
+            name = dotted(node)
+            if name:
+                names.add(name)
+    return sorted(names)
+
+
+def _describe(name, value):
+    """
+    Describe what the code generated for a reference to `value` depends on.
+    Symbols are lifted to kernel arguments, hence only their type matters,
+    while module attributes are folded into the code, hence their value
+    matters.
+    """
+    from .kernel_decorator import isa_kernel_decorator
+    if value is None:
+        return None
+    if isa_kernel_decorator(value):
+        if not value.qkeModule:
+            return 'kernel'
+        funcOp = recover_func_op(value.qkeModule, nvqppPrefix + value.uniqName)
+        funcTy = FunctionType(
+            TypeAttr(funcOp.attributes['function_type']).value)
+        inputs = [str(t) for t in funcTy.inputs[:value.formal_arity()]]
+        return f'kernel {inputs} {[str(t) for t in funcTy.results]}'
+    if isinstance(value, types.ModuleType):
+        return f'module {value.__name__}'
+    if isinstance(value, type):
+        return f'class {value.__module__}.{value.__qualname__} ' + repr(
+            getattr(value, '__annotations__', {}))
+    if callable(value):
+        return (f'callable {getattr(value, "__module__", "")}.'
+                f'{getattr(value, "__qualname__", type(value).__qualname__)}')
+    if '.' in name and isinstance(value, (bool, int, float, complex, str)):
+        return f'{_type_name(value)} {value!r}'
+    return _type_name(value)
+
+
+def _type_name(value):
+    """
+    Return the type of `value`, including the element types of lists and
+    arrays, which decide the type of the kernel argument it is lifted to.
+    """
+    name = f'{type(value).__module__}.{type(value).__qualname__}'
+    if isinstance(value, np.ndarray):
+        return f'{name}[{value.dtype}, {value.ndim}]'
+    if isinstance(value, (list, tuple)):
+        return f'{name}[{sorted({_type_name(v) for v in value})}]'
+    return name
+
+
+def _resolve_attribute(name):
+    """
+    Resolve the dotted `name` by attribute lookups from its first component.
+    """
+    parts = name.split('.')
+    value = recover_value_of_or_none(parts[0], None)
+    try:
+        for attr in parts[1:]:
+            value = getattr(value, attr)
+    except AttributeError:
+        return None
+    return value
+
+
+def cache_key(decorator):
+    """
+    Return the cache key of the Quake module of `decorator`.
+    """
+    target = cudaq_runtime.get_target()
+    symbols = []
+    for name in _referenced_names(decorator.astModule):
+        value = (resolve_qualified_symbol(name) or
+                 _resolve_attribute(name)) if '.' in name else (
+                     recover_value_of_or_none(name, None))
+        symbols.append((name, _describe(name, value)))
+        root = name.split('.')[0]
+        if root in globalRegisteredOperations:
+            unitary = np.asarray(globalRegisteredOperations[root])
+            symbols.append(
+                (root, hashlib.sha256(unitary.tobytes()).hexdigest()))
+        if globalRegisteredTypes.isRegisteredClass(root):
+            _, attributes = globalRegisteredTypes.getClassAttributes(root)
+            symbols.append((root, repr(attributes)))
+    content = json.dumps([
+        cudaq_runtime.__version__, target.name,
+        str(target.get_precision()), decorator.name, decorator.funcSrc,
+        list(decorator.location), decorator.kernelModuleName,
+        repr(decorator.signature), symbols
+    ])
+    return hashlib.sha256(content.encode()).hexdigest()
+
+
+def load(key):
+    """
+    Return the cache entry for `key`, or `None` if there is none.
+    """
+    path = os.path.join(cache_directory(), key + '.json')
+    try:
+        with open(path) as f:
+            return json.load(f)
+    except (OSError, ValueError):
+        return None
+
+
+def store(key, decorator):
+    """
+    Store the Quake module of `decorator` under `key`. Failures are ignored,
+    the cache being only an optimization.
+    """
+    directory = cache_directory()
+    entry = {
+        'uniqName': decorator.uniqName,
+        'module': decorator.qkeModule.operation.get_asm(enable_debug_info=True),
+        'liftedArgs': decorator.liftedArgs,
+        'firstLiftedPos': decorator.firstLiftedPos
+    }
+    try:
+        os.makedirs(directory, exist_ok=True)
+        fd, tmpPath = tempfile.mkstemp(dir=directory, suffix='.tmp')
+    except OSError:
+        return
+    try:
+        with os.fdopen(fd, 'w') as f:
+            json.dump(entry, f)
+        os.replace(tmpPath, os.path.join(directory, key + '.json'))
+    except OSError:
+        try:
+            os.remove(tmpPath)
+        except OSError:
+            pass
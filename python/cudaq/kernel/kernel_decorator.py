@@ -23,6 +23,7 @@ from cudaq.mlir.ir import (Block, ComplexType, F32Type, F64Type, FunctionType,
 from .analysis import HasReturnNodeVisitor
 from .ast_bridge import (compile_to_mlir, PyASTBridge)
 from .captured_data import CapturedDataStorage
+from . import kernel_cache
 from .utils import (emitFatalError, emitErrorIfInvalidPauli, globalAstRegistry,
                     globalRegisteredTypes, mlirTypeFromPyType, mlirTypeToPyType,
                     nvqppPrefix, getMLIRContext, recover_func_op,
@@ -47,6 +48,35 @@ class DecoratorCapture:
         "name: " + self.decorator.name + ", resolved: " + str(self.resolved)
 
 
+# The maximum number of argument signatures for which a decorator retains the
+# conversions of the arguments (see `PyKernelDecorator.launch_plan`).
+LAUNCH_PLAN_CACHE_SIZE = 16
+
+_SCALAR_ARGUMENT_TYPES = (bool, int, float, complex, np.int8, np.int16,
+                          np.int32, np.int64, np.float32, np.float64,
+                          np.complex64, np.complex128)
+
+
+def launch_signature(value):
+    """
+    Return a hashable description of what the conversion of the kernel
+    argument `value` depends on, or `None` if the conversion must be computed
+    for every call (e.g., for kernels, strings, and data classes). The type of
+    a list is that of its first element, like in `mlirTypeFromPyType`.
+    """
+    valueTy = type(value)
+    if valueTy in _SCALAR_ARGUMENT_TYPES:
+        return valueTy
+    if valueTy == list:
+        if not value:
+            return (list,)
+        eleSig = launch_signature(value[0])
+        return None if eleSig is None else (list, eleSig)
+    if valueTy == np.ndarray and value.ndim == 1 and value.size:
+        return (np.ndarray, value.dtype)
+    return None
+
+
 class PyKernelDecorator(object):
     """
     The `PyKernelDecorator` serves as a standard Python decorator that takes 
@@ -144,7 +174,7 @@ class PyKernelDecorator(object):
             # Get any global variables from parent scope.  We filter only types
             # we accept: integers and floats.  Note here we assume that the
             # parent scope is 2 stack frames up
-            self.parentFrame = inspect.stack()[2].frame
+            self.parentFrame = inspect.currentframe().f_back.f_back
             if overrideGlobalScopedVars:
                 self.globalScopedVars = {
                     k: v for k, v in overrideGlobalScopedVars.items()
@@ -242,10 +272,60 @@ class PyKernelDecorator(object):
             globalAstRegistry[self.name] = (self.astModule, self.location)
         self.pre_compile()
 
+    # Entry of the on-disk kernel cache (see `kernel_cache.py`) whose Quake
+    # module is parsed on first use.
+    _cachedKernel = None
+    _qkeModule = None
+    _argTypes = None
+    # Conversions of the arguments by argument signature and the MLIR type of
+    # the result, valid for the current `qkeModule`.
+    _launchPlans = None
+    _resultType = None
+
+    @property
+    def qkeModule(self):
+        if self._cachedKernel:
+            self.load_cached_kernel()
+        return self._qkeModule
+
+    @qkeModule.setter
+    def qkeModule(self, module):
+        self._cachedKernel = None
+        self._qkeModule = module
+        self._launchPlans = None
+        self._resultType = None
+
+    @property
+    def argTypes(self):
+        if self._cachedKernel:
+            self.load_cached_kernel()
+        return self._argTypes
+
+    @argTypes.setter
+    def argTypes(self, argTypes):
+        if self._cachedKernel:
+            self.load_cached_kernel()
+        self._argTypes = argTypes
+        self._launchPlans = None
+
+    def load_cached_kernel(self):
+        """
+        Parse the Quake module of the kernel cache entry, renaming the kernel
+        to the unique name of this decorator.
+        """
+        entry = self._cachedKernel
+        self._cachedKernel = None
+        self._qkeModule = Module.parse(entry['module'].replace(
+            entry['uniqName'], self.uniqName),
+                                       context=getMLIRContext())
+        funcOp = recover_func_op(self._qkeModule, nvqppPrefix + self.uniqName)
+        self._argTypes = FunctionType(
+            TypeAttr(funcOp.attributes['function_type']).value).inputs
+
     def __del__(self):
         # explicitly call `del` on the MLIR `ModuleOp` wrappers.
-        if self.qkeModule:
-            del self.qkeModule
+        if self._qkeModule:
+            del self._qkeModule
         if self.nvqModule:
             del self.nvqModule
 
@@ -282,22 +362,37 @@ class PyKernelDecorator(object):
             return
 
         # Otherwise, `precompile` the kernel to portable MLIR.
-        if self.qkeModule:
+        if self._qkeModule or self._cachedKernel:
             raise RuntimeError(self.name + " was already compiled")
         self.capturedDataStorage = None
         self.uniqueId = id(self)
         self.uniqName = self.name + ".." + hex(self.uniqueId)
-        self.qkeModule, self.argTypes, extraMetadata, self.liftedArgs, self.firstLiftedPos = compile_to_mlir(
-            id(self),
-            self.astModule,
-            self.capturedDataStorage,
-            verbose=self.verbose,
-            returnType=self.returnType,
-            location=self.location,
-            parentVariables=self.globalScopedVars,
-            preCompile=True,
-            kernelName=self.name,
-            kernelModuleName=self.kernelModuleName)
+
+        # Reuse the module generated by a previous session, if any. It is only
+        # parsed once needed.
+        cacheKey = None
+        if kernel_cache.cache_directory() and not self.verbose:
+            cacheKey = kernel_cache.cache_key(self)
+            entry = kernel_cache.load(cacheKey)
+            if entry:
+                self.liftedArgs = entry['liftedArgs']
+                self.firstLiftedPos = entry['firstLiftedPos']
+                self._cachedKernel = entry
+
+        if not self._cachedKernel:
+            self.qkeModule, self.argTypes, extraMetadata, self.liftedArgs, self.firstLiftedPos = compile_to_mlir(
+                id(self),
+                self.astModule,
+                self.capturedDataStorage,
+                verbose=self.verbose,
+                returnType=self.returnType,
+                location=self.location,
+                parentVariables=self.globalScopedVars,
+                preCompile=True,
+                kernelName=self.name,
+                kernelModuleName=self.kernelModuleName)
+            if cacheKey:
+                kernel_cache.store(cacheKey, self)
 
         if (cudaq_runtime.is_current_target_full_qir() and
                 not self.signatureWithCallables()):
@@ -586,31 +681,72 @@ class PyKernelDecorator(object):
         """
         Resolve all the arguments at the call site for this decorator.
         """
+        processedArgs, _ = self.process_call_arguments(args)
+
+        # Specialize quake code via argument synthesis, lower to full QIR.
+        specialized_module = self.convert_to_full_qir(processedArgs)
+        return specialized_module, processedArgs
+
+    def process_call_arguments(self, args):
+        """
+        Convert the arguments `args` and the lifted arguments to the values
+        passed to the kernel. Returns the values and whether they were
+        converted by a launch plan, in which case none of them refers to
+        another kernel.
+        """
+        # Get the values associated with the lifted arguments in the current
+        # context.
+        values = list(args)
+        if self.liftedArgs:
+            values += [recover_value_of(a, None) for a in self.liftedArgs]
+
+        plan = self.launch_plan(values)
+        if plan is not None:
+            return [convert(v) for convert, v in zip(plan, values)], True
+
         # Process all the normal arguments
         processedArgs = []
         callingModule = recover_calling_module()
         self.process_arguments_to_call(processedArgs, callingModule, args)
 
         # Process any lifted arguments
-        if self.liftedArgs:
-            for j, a in enumerate(self.liftedArgs):
-                i = self.firstLiftedPos + j
-                # get the value associated with the variable named "a" in the
-                # current context.
-                a_value = recover_value_of(a, None)
-                self.process_argument(processedArgs, i, a_value, callingModule)
+        for j, a_value in enumerate(values[len(args):]):
+            i = self.firstLiftedPos + j
+            self.process_argument(processedArgs, i, a_value, callingModule)
+        return processedArgs, False
 
-        # Specialize quake code via argument synthesis, lower to full QIR.
-        specialized_module = self.convert_to_full_qir(processedArgs)
-        return specialized_module, processedArgs
+    def launch_plan(self, values):
+        """
+        Return the conversions of the argument `values`, which are computed
+        once per signature of the arguments (see `launch_signature`), or `None`
+        if the arguments must be processed one at a time.
+        """
+        if self.argTypes is None or len(values) != len(self.argTypes):
+            return None
+        key = tuple(launch_signature(v) for v in values)
+        if None in key:
+            return None
+        if self._launchPlans is None:
+            self._launchPlans = {}
+        plan = self._launchPlans.get(key)
+        if plan is None:
+            plan = [
+                self.argument_converter(i, v) for i, v in enumerate(values)
+            ]
+            if len(self._launchPlans) >= LAUNCH_PLAN_CACHE_SIZE:
+                self._launchPlans.pop(next(iter(self._launchPlans)))
+            self._launchPlans[key] = plan
+        return plan
 
     def get_none_type(self):
         return NoneType.get(self.qkeModule.context)
 
     def handle_call_results(self):
-        if not self.returnType:
-            return self.get_none_type()
-        return mlirTypeFromPyType(self.returnType, self.qkeModule.context)
+        if self._resultType is None:
+            self._resultType = (mlirTypeFromPyType(self.returnType,
+                                                   self.qkeModule.context)
+                                if self.returnType else self.get_none_type())
+        return self._resultType
 
     def launch_args_required(self):
         """
@@ -638,7 +774,13 @@ class PyKernelDecorator(object):
         if handler.call_processed(self.kernelFunction, args) is True:
             return
 
-        specialized_module, processedArgs = self.handle_call_arguments(*args)
+        processedArgs, planned = self.process_call_arguments(args)
+        if planned:
+            # The launch specializes a clone of the module, and there are no
+            # other kernels to merge into it, so skip lowering a copy.
+            specialized_module = self.qkeModule
+        else:
+            specialized_module = self.convert_to_full_qir(processedArgs)
         mlirTy = self.handle_call_results()
         result = cudaq_runtime.marshal_and_launch_module(
             self.uniqName, specialized_module, mlirTy, *processedArgs)
@@ -682,10 +824,19 @@ class PyKernelDecorator(object):
             return
 
         arg = self.convertStringsToPauli(arg)
+        processedArgs.append(self.argument_converter(i, arg)(arg))
+
+    def argument_converter(self, i, arg):
+        """
+        Return the function converting the `i`-th argument `arg` to the value
+        passed to the kernel. The conversion only depends on the type of `arg`
+        (see `launch_signature`).
+        """
+        argType = self.argTypes[i]
         mlirType = mlirTypeFromPyType(type(arg),
                                       getMLIRContext(),
                                       argInstance=arg,
-                                      argTypeToCompareTo=self.argTypes[i])
+                                      argTypeToCompareTo=argType)
 
         # Check error conditions before proceeding.
         if cc.CallableType.isinstance(mlirType):
@@ -693,17 +844,14 @@ class PyKernelDecorator(object):
                 f"Argument has callable type but the argument ({arg}) is not "
                 f"a kernel decorator.")
 
-        if self.isCastablePyType(mlirType, self.argTypes[i]):
-            processedArgs.append(
-                self.castPyType(mlirType, self.argTypes[i], arg))
-            mlirType = self.argTypes[i]
-            return
+        if self.isCastablePyType(mlirType, argType):
+            return lambda value: self.castPyType(mlirType, argType, value)
 
-        if mlirType != self.argTypes[i]:
+        if mlirType != argType:
             emitFatalError(
                 f"Invalid runtime argument type. Argument of type "
                 f"{mlirTypeToPyType(mlirType)} was provided, but "
-                f"{mlirTypeToPyType(self.argTypes[i])} was expected.")
+                f"{mlirTypeToPyType(argType)} was expected.")
 
         # Convert `numpy` arrays to lists
         if cc.StdvecType.isinstance(mlirType) and hasattr(arg, "tolist"):
@@ -712,9 +860,8 @@ class PyKernelDecorator(object):
                     f"CUDA-Q kernels only support array arguments from NumPy "
                     f"that are one dimensional (input argument {i} has shape ="
                     f" {arg.shape}).")
-            processedArgs.append(arg.tolist())
-        else:
-            processedArgs.append(arg)
+            return lambda value: value.tolist()
+        return lambda value: value
 
     def process_arguments_to_call(self, processedArgs, resMod, args):
         for i, arg in enumerate(args):
@@ -739,6 +886,11 @@ def kernel(function=None, **kwargs):
     and should be compile and executed on an available quantum coprocessor.
 
     Verbose logging can be enabled via `verbose=True`. 
+
+    If the `CUDAQ_PYTHON_KERNEL_CACHE_DIR` environment variable is set to a
+    directory, the Quake code generated for the kernel is stored there, and
+    later sessions defining the same kernel load it rather than generating it
+    again.
     """
     if function:
         return PyKernelDecorator(function)
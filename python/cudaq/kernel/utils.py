@@ -210,24 +210,26 @@ def recover_value_of_or_none(name, resMod):
     if resMod:
         return resMod.__dict__.get(name, None)
 
-    def drop_front():
-        drop = 0
-        for frameinfo in inspect.stack():
-            frame = frameinfo.frame
-            if 'self' in frame.f_locals:
-                if isa_kernel_decorator(frame.f_locals['self']):
-                    return drop
-            drop = drop + 1
-        return drop
-
-    drop = drop_front()
-    for frameinfo in inspect.stack()[drop:]:
-        frame = frameinfo.frame
-        if name in frame.f_locals:
-            return frame.f_locals[name]
-        if name in frame.f_globals:
-            return frame.f_globals[name]
-    return None
+    # Walk the frames directly, since `inspect.stack()` also reads the source
+    # context of every frame, which dominates the compilation of kernels with
+    # many symbols.
+    frame = inspect.currentframe()
+    try:
+        # Skip the frames up to the innermost `PyKernelDecorator` method.
+        while frame is not None and not isa_kernel_decorator(
+                frame.f_locals.get('self', None)):
+            frame = frame.f_back
+        if frame is not None:
+            frame = frame.f_back
+        while frame is not None:
+            if name in frame.f_locals:
+                return frame.f_locals[name]
+            if name in frame.f_globals:
+                return frame.f_globals[name]
+            frame = frame.f_back
+        return None
+    finally:
+        del frame
 
 
 def is_recovered_value_ok(result):
@@ -18,7 +18,8 @@ def define(id: str,
            expected_dimensions: Sequence[int],
            create: typing.Callable[...,
                                    numpy.typing.NDArray[numpy.complexfloating]],
-           override: bool = False) -> None:
+           override: bool = False,
+           time_dependent: bool = False) -> None:
     """
     Defines a matrix operator element with the given id.
     After definition, an the defined elementary operator can be instantiated by
@@ -49,8 +50,15 @@ def define(id: str,
             argument called `dimensions` (or `dims` for short), if the operator acts
             on multiple degrees of freedom.
         override: if True it allows override the definition. (default: False)
+        time_dependent: if True, the matrix is recomputed each time the operator
+            is evaluated. By default, the matrix is only recomputed when the
+            operator is evaluated for different dimensions or values of the
+            parameters of `create`.
+            Set this to True if `create` depends on any other state. (default: False)
     """
     MatrixOperatorElement.define(id, expected_dimensions, create, override)
+    if time_dependent:
+        MatrixOperatorElement.set_time_dependent(id)
 
 
 def instantiate(op_id: str,
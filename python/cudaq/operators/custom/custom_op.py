@@ -70,6 +70,10 @@ def _defineCustomOperator(cls,
 
     cls._define(id, expected_dimensions, generator_wrapper, override,
                 **parameters)
+    # Matrices are memoized per value of the declared parameters, but a
+    # function taking `**kwargs` may use any parameter.
+    if arg_spec.varkw is not None:
+        cls.set_time_dependent(id)
 
 
 def _evaluate(self: MatrixOperatorElement, **kwargs: NumericType):
@@ -7,7 +7,7 @@
 # ============================================================================ #
 
 from cudaq.mlir._mlir_libs._quakeDialects import cudaq_runtime
-from .utils import __isBroadcast, __createArgumentSet
+from .utils import __isBroadcast, __createArgumentSet, __broadcastParameters
 from cudaq.kernel.kernel_decorator import (mk_decorator, isa_kernel_decorator)
 from cudaq.kernel.kernel_builder import isa_dynamic_kernel
 
@@ -68,7 +68,10 @@ def observe(kernel,
     argument sets and a list of `observe_result` instances will be returned.
     If both the input `spin_operator` and `arguments` are broadcast lists, a
     nested list of results over `arguments` then `spin_operator` will be
-    returned.
+    returned. If the kernel takes a single `list[float]`, given a 2D `ndarray`
+    with one row per argument set, or only `float` arguments, each given an
+    `ndarray`, the broadcast runs in C++ without converting the argument sets
+    to Python objects.
 
     Args:
       kernel (:class:`Kernel`): The :class:`Kernel` to evaluate the 
@@ -150,11 +153,18 @@ def observe(kernel,
                            str(len(args)) + " given and " +
                            str(decorator.formal_arity()) + " expected.")
     if __isBroadcast(kernel, *args):
-        results = __broadcastObserve(kernel,
-                                     localOp,
-                                     *args,
-                                     shots_count=shots_count,
-                                     qpu_id=qpu_id)
+        parameters = __broadcastParameters(decorator, *args)
+        if parameters is not None:
+            results = cudaq_runtime.observe_broadcast_impl(
+                decorator.uniqName, decorator.qkeModule,
+                decorator.get_none_type(), localOp, parameters, shots_count,
+                qpu_id)
+        else:
+            results = __broadcastObserve(kernel,
+                                         localOp,
+                                         *args,
+                                         shots_count=shots_count,
+                                         qpu_id=qpu_id)
 
         if isinstance(spin_operator, list):
             results = [[
@@ -9,6 +9,7 @@
 from cudaq.mlir._mlir_libs._quakeDialects import cudaq_runtime
 from cudaq.mlir.ir import UnitAttr
 from cudaq.kernel.kernel_decorator import (mk_decorator, isa_kernel_decorator)
+from .utils import await_result
 import numpy as np
 
 # Maintain a dictionary of queued `async` run kernels. This dictionary is used
@@ -34,6 +35,11 @@ class AsyncRunResult:
         self.getCalled = True
         return result
 
+    def is_ready(self):
+        return self.impl.is_ready()
+
+    __await__ = await_result
+
     def __del__(self):
         # FIXME: This potentially leaks memory intentionally. It is possible
         # that the AsyncRunResult object gets deleted *before* the `async` run
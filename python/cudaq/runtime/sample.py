@@ -10,7 +10,8 @@ from cudaq.mlir._mlir_libs._quakeDialects import cudaq_runtime
 from cudaq.kernel.kernel_builder import PyKernel
 from cudaq.kernel.kernel_decorator import (mk_decorator, isa_kernel_decorator)
 from cudaq.kernel.utils import nvqppPrefix
-from .utils import __isBroadcast, __createArgumentSet
+from .utils import (__isBroadcast, __createArgumentSet, __broadcastParameters,
+                    await_result)
 
 # Maintain a dictionary of queued `async` sample kernels.This dictionary is used
 # to keep the `mlir::ModuleOp` alive so the interpreter doesn't garbage collect
@@ -46,6 +47,11 @@ class AsyncSampleResult:
         self.getCalled = True
         return result
 
+    def is_ready(self):
+        return self.impl.is_ready()
+
+    __await__ = await_result
+
     def __del__(self):
         # FIXME : This potentially leaks memory intentionally. It is possible
         # that the `AsyncSampleResult` object gets deleted *before* the `async`
@@ -139,7 +145,10 @@ def sample(kernel,
     Each argument in `arguments` provided can be a list or `ndarray` of
     arguments of the specified kernel argument type, and in this case, the
     `sample` functionality will be broadcasted over all argument sets and a list
-    of `sample_result` instances will be returned.
+    of `sample_result` instances will be returned. If the kernel takes a single
+    `list[float]`, given a 2D `ndarray` with one row per argument set, or only
+    `float` arguments, each given an `ndarray`, the broadcast runs in C++
+    without converting the argument sets to Python objects.
 
     Args:
       kernel (:class:`Kernel`): The :class:`Kernel` to execute `shots_count`
@@ -173,10 +182,20 @@ def sample(kernel,
         cudaq_runtime.set_noise(noise_model)
 
     if __isBroadcast(kernel, *args):
-        res = __broadcastSample(kernel,
-                                *args,
-                                shots_count=shots_count,
-                                explicit_measurements=explicit_measurements)
+        decorator = (kernel if isa_kernel_decorator(kernel) else
+                     mk_decorator(kernel))
+        parameters = __broadcastParameters(decorator, *args)
+        if parameters is not None:
+            res = cudaq_runtime.sample_broadcast_impl(decorator.uniqName,
+                                                      decorator.qkeModule,
+                                                      decorator.get_none_type(),
+                                                      parameters, shots_count,
+                                                      explicit_measurements)
+        else:
+            res = __broadcastSample(kernel,
+                                    *args,
+                                    shots_count=shots_count,
+                                    explicit_measurements=explicit_measurements)
         cudaq_runtime.unset_noise()
         return res
 
@@ -101,7 +101,29 @@ def to_cupy(state, dtype=None):
 
     arrays = []
     for tensor in state.getTensors():
-        mem = cp.cuda.UnownedMemory(tensor.data(), 1024, owner=None)
+        # The arrays alias the state data, and keep the state alive.
+        mem = cp.cuda.UnownedMemory(tensor.data(),
+                                    tensor.get_num_elements() *
+                                    tensor.get_element_size(),
+                                    owner=state)
         memptr = cp.cuda.MemoryPointer(mem, offset=0)
         arrays.append(cp.ndarray(tensor.extents, dtype=dtype, memptr=memptr))
     return arrays
+
+
+def overlap_matrix(bras, kets):
+    """
+    Compute the overlap of each of the `bras` with each of the `kets`, as
+    :meth:`State.overlap` does for one pair of states. On GPU simulators, the
+    overlaps are computed in a single batch, e.g., as a matrix product of the
+    state vectors, rather than one pair at a time.
+
+    Args:
+      bras (List[:class:`State`]): The states of the rows of the matrix.
+      kets (List[:class:`State`]): The states of the columns of the matrix.
+
+    Returns:
+      `numpy.ndarray`: The `len(bras)` x `len(kets)` matrix whose element
+      `(i, j)` is the overlap of `bras[i]` with `kets[j]`.
+    """
+    return cudaq_runtime.overlap_matrix(list(bras), list(kets))
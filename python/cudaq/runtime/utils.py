@@ -11,10 +11,17 @@ from cudaq.kernel.kernel_builder import PyKernel
 from cudaq.kernel.kernel_decorator import isa_kernel_decorator
 from cudaq.mlir._mlir_libs._quakeDialects import cudaq_runtime
 from cudaq.mlir.dialects import cc
+from cudaq.mlir.ir import F64Type
 
+import asyncio
 import numpy as np
 from typing import List
 
+# Bounds, in seconds, of the delay between two readiness checks of an awaited
+# asynchronous result.
+ASYNC_POLL_MIN_DELAY = 1e-3
+ASYNC_POLL_MAX_DELAY = 0.1
+
 
 def __isBroadcast(kernel, *args):
     # kernel could be a PyKernel or kernel decorator
@@ -118,3 +125,51 @@ def __createArgumentSet(*args):
 
         argSet.append(tuple(currentArgs))
     return argSet
+
+
+def __broadcastParameters(decorator, *args):
+    """
+    Return the argument sets of a broadcast as a 2D array of `float64`
+    parameters, one row per argument set, such that the broadcast can be run in
+    C++ without converting each argument set to Python objects. This applies
+    when the kernel takes either a single `list[float]`, given a 2D array, or
+    only `float` arguments, each given a 1D array of values. Otherwise, return
+    `None`.
+    """
+    if (not decorator.qkeModule or decorator.liftedArgs or
+            not all(isinstance(a, np.ndarray) and a.dtype.kind in 'fiu'
+                    for a in args)):
+        return None
+    argTypes = decorator.argTypes
+    if len(args) != len(argTypes):
+        return None
+    if (len(argTypes) == 1 and cc.StdvecType.isinstance(argTypes[0]) and
+            F64Type.isinstance(cc.StdvecType.getElementType(argTypes[0])) and
+            args[0].ndim == 2):
+        return np.ascontiguousarray(args[0], dtype=np.float64)
+    if (all(F64Type.isinstance(t) for t in argTypes) and
+            all(a.ndim == 1 and len(a) == len(args[0]) for a in args)):
+        return np.ascontiguousarray(np.column_stack(args), dtype=np.float64)
+    return None
+
+
+async def wait_for_result(result):
+    """
+    Wait until the asynchronous `result` is ready and return its value, without
+    blocking the running event loop. The readiness is checked from timers of the
+    loop, at intervals growing from `ASYNC_POLL_MIN_DELAY` to
+    `ASYNC_POLL_MAX_DELAY` seconds, so that one loop can await any number of
+    results without a thread per result.
+    """
+    delay = ASYNC_POLL_MIN_DELAY
+    while not result.is_ready():
+        await asyncio.sleep(delay)
+        delay = min(2 * delay, ASYNC_POLL_MAX_DELAY)
+    return result.get()
+
+
+def await_result(result):
+    """
+    The `__await__` method of the asynchronous result types.
+    """
+    return wait_for_result(result).__await__()
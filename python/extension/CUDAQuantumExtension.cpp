@@ -16,6 +16,7 @@
 #include "runtime/common/py_ExecutionContext.h"
 #include "runtime/common/py_NoiseModel.h"
 #include "runtime/common/py_ObserveResult.h"
+#include "runtime/common/py_Profiler.h"
 #include "runtime/common/py_Resources.h"
 #include "runtime/common/py_SampleResult.h"
 #include "runtime/cudaq/algorithms/py_draw.h"
@@ -104,6 +105,7 @@ PYBIND11_MODULE(_quakeDialects, m) {
   bindRuntimeTarget(cudaqRuntime, *holder.get());
   bindMeasureCounts(cudaqRuntime);
   bindResources(cudaqRuntime);
+  bindProfiler(cudaqRuntime);
   bindObserveResult(cudaqRuntime);
   bindComplexMatrix(cudaqRuntime);
   bindScalarWrapper(cudaqRuntime);
@@ -237,6 +239,27 @@ PYBIND11_MODULE(_quakeDialects, m) {
       "ORCA's backends",
       py::arg("input_state"), py::arg("loop_lengths"), py::arg("bs_angles"),
       py::arg("n_samples") = 10000, py::arg("qpu_id") = 0);
+  orcaSubmodule.def(
+      "sample_batch",
+      py::overload_cast<std::vector<std::size_t> &, std::vector<std::size_t> &,
+                        const std::vector<std::vector<double>> &,
+                        std::vector<double> &, int, std::size_t>(
+          &orca::sample_batch),
+      "Performs one Time Bin Interferometer (TBI) boson sampling experiment "
+      "per set of beam splitter angles on ORCA's backends",
+      py::arg("input_state"), py::arg("loop_lengths"),
+      py::arg("bs_angle_sets"), py::arg("ps_angles"),
+      py::arg("n_samples") = 10000, py::arg("qpu_id") = 0);
+  orcaSubmodule.def(
+      "sample_batch",
+      py::overload_cast<std::vector<std::size_t> &, std::vector<std::size_t> &,
+                        const std::vector<std::vector<double>> &, int,
+                        std::size_t>(&orca::sample_batch),
+      "Performs one Time Bin Interferometer (TBI) boson sampling experiment "
+      "per set of beam splitter angles on ORCA's backends",
+      py::arg("input_state"), py::arg("loop_lengths"),
+      py::arg("bs_angle_sets"), py::arg("n_samples") = 10000,
+      py::arg("qpu_id") = 0);
 
   auto photonicsSubmodule = cudaqRuntime.def_submodule("photonics");
   photonicsSubmodule.def(
@@ -72,6 +72,33 @@ void bindEvolveResult(py::module &mod) {
           "if no intermediate results were requested, or if no observables "
           "were specified in the call.\n");
 
+  py::class_<evolve_step_result>(
+      mod, "EvolveStepResult",
+      "The results of one step of the schedule of an evolution, as received "
+      "by the `sink` of :func:`evolve`.\n")
+      .def_readonly("batch_index", &evolve_step_result::batch_index,
+                    "Index of the evolution in a batched evolution.\n")
+      .def_readonly("step_index", &evolve_step_result::step_index,
+                    "Index of the step in the schedule.\n")
+      .def_readonly("time", &evolve_step_result::time,
+                    "Time of the step.\n")
+      .def_readonly("state", &evolve_step_result::state,
+                    "State vector or density matrix data, in host memory.\n")
+      .def_readonly("expectation_values",
+                    &evolve_step_result::expectation_values,
+                    "Expectation values of the observables.\n");
+
+  py::class_<ring_buffer_sink>(
+      mod, "RingBufferSink",
+      "A `sink` for :func:`evolve` keeping the results of the last "
+      "`capacity` steps of each evolution.\n")
+      .def(py::init<std::size_t>(), py::arg("capacity"))
+      .def("__call__", &ring_buffer_sink::operator())
+      .def("get_results", &ring_buffer_sink::get_results,
+           py::arg("batch_index") = 0,
+           "Get the results of the last steps of an evolution, oldest "
+           "first.\n");
+
   py::class_<async_evolve_result>(
       mod, "AsyncEvolveResult",
       "Stores the execution data from an invocation of :func:`evolve_async`.\n")
@@ -79,7 +106,15 @@ void bindEvolveResult(py::module &mod) {
           "get", [](async_evolve_result &self) { return self.get(); },
           py::call_guard<py::gil_scoped_release>(),
           "Retrieve the evolution result from the asynchronous evolve "
-          "execution\n.");
+          "execution\n.")
+      .def(
+          "is_ready",
+          [](async_evolve_result &self) {
+            return !self.valid() || self.wait_for(std::chrono::seconds(0)) ==
+                                       std::future_status::ready;
+          },
+          "Return true if the evolution result is available, i.e., if `get` "
+          "would not wait.\n");
 }
 
 } // namespace cudaq
@@ -11,6 +11,7 @@
 #include "cudaq/platform.h"
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
 #include <fmt/core.h>
+#include <memory>
 #include <pybind11/complex.h>
 #include <pybind11/stl.h>
 
@@ -38,6 +39,8 @@ void bindExecutionContext(py::module &mod) {
       .def_readwrite("batchIteration", &cudaq::ExecutionContext::batchIteration)
       .def_readwrite("numberTrajectories",
                      &cudaq::ExecutionContext::numberTrajectories)
+      .def_readonly("truncationError",
+                    &cudaq::ExecutionContext::truncationError)
       .def_readwrite("explicitMeasurements",
                      &cudaq::ExecutionContext::explicitMeasurements)
       .def_readwrite("allowJitEngineCaching",
@@ -47,9 +50,10 @@ void bindExecutionContext(py::module &mod) {
       .def("unset_jit_engine",
            [&](cudaq::ExecutionContext &execCtx) {
              if (execCtx.jitEng) {
-               auto *p =
-                   reinterpret_cast<mlir::ExecutionEngine *>(execCtx.jitEng);
-               delete p;
+               // Release the context's reference, the engine may also be held
+               // by the JIT execution cache.
+               using EngineRef = std::shared_ptr<mlir::ExecutionEngine>;
+               delete reinterpret_cast<EngineRef *>(execCtx.jitEng);
                execCtx.jitEng = nullptr;
                execCtx.allowJitEngineCaching = false;
              }
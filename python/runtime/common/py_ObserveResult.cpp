@@ -176,6 +176,10 @@ for more information on this programming pattern.)#")
            py::call_guard<py::gil_scoped_release>(),
            "Returns the :class:`ObserveResult` from the asynchronous observe "
            "execution.")
+      .def("is_ready", &async_observe_result::is_ready,
+           py::call_guard<py::gil_scoped_release>(),
+           "Returns true if the result is available, i.e., if `get` would not "
+           "wait.")
       .def("__str__", [](async_observe_result &self) {
         std::stringstream ss;
         ss << self;
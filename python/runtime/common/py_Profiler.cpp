@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include <pybind11/stl.h>
+
+#include "py_Profiler.h"
+
+#include "common/Profiler.h"
+
+namespace cudaq {
+
+void bindProfiler(py::module &mod) {
+  using namespace cudaq::profiler;
+  auto profilerSubmodule = mod.def_submodule(
+      "profiler", "Record the phases of kernel launches (JIT passes, argument "
+                  "synthesis, simulation, sampling, ...) with their wall time "
+                  "and counters.");
+
+  py::enum_<Phase>(profilerSubmodule, "Phase",
+                   "The phases of a kernel launch.")
+      .value("launch", Phase::launch)
+      .value("jit_passes", Phase::jit_passes)
+      .value("jit_pass", Phase::jit_pass)
+      .value("argument_synthesis", Phase::argument_synthesis)
+      .value("simulator_flush", Phase::simulator_flush)
+      .value("sample_conversion", Phase::sample_conversion)
+      .value("result_assembly", Phase::result_assembly);
+
+  py::class_<Event>(profilerSubmodule, "Event", "A recorded phase.")
+      .def_readonly("phase", &Event::phase)
+      .def_readonly("name", &Event::name,
+                    "The name of the kernel or component, if any.")
+      .def_readonly("start_ns", &Event::startNs,
+                    "Start time in nanoseconds since the profiler epoch.")
+      .def_readonly("duration_ns", &Event::durationNs)
+      .def_readonly("thread_id", &Event::threadId)
+      .def_readonly("depth", &Event::depth,
+                    "Nesting depth of the phase on its thread.")
+      .def_readonly("counters", &Event::counters,
+                    "Counters of the phase, e.g., `gates` or "
+                    "`bytes_allocated`.")
+      .def("__repr__", [](const Event &event) {
+        return std::string("Event(") + getPhaseName(event.phase) + ", '" +
+               event.name + "', " + std::to_string(event.durationNs) + " ns)";
+      });
+
+  profilerSubmodule.def(
+      "enable",
+      [](bool passes) {
+        setRecordPasses(passes);
+        setEnabled(true);
+      },
+      py::arg("passes") = false,
+      "Start recording phases. If `passes` is set, also record each pass of "
+      "the JIT pipelines, with the number of operations before and after it "
+      "(`ops_before` and `ops_after` counters).");
+  profilerSubmodule.def(
+      "disable", []() { setEnabled(false); }, "Stop recording phases.");
+  profilerSubmodule.def("is_enabled", &isEnabled,
+                        "Return true if phases are being recorded.");
+  profilerSubmodule.def("get_events", &getEvents,
+                        "Return the phases recorded so far, in completion "
+                        "order.");
+  profilerSubmodule.def("clear", &clear,
+                        "Discard the phases recorded so far.");
+  profilerSubmodule.def(
+      "to_chrome_trace", &toChromeTrace,
+      "Return the recorded phases as a Chrome trace (JSON), which can be "
+      "loaded in Perfetto or `chrome://tracing`.");
+  profilerSubmodule.def("write_chrome_trace", &writeChromeTrace,
+                        py::arg("path"),
+                        "Write the recorded phases as a Chrome trace to "
+                        "`path`.");
+}
+
+} // namespace cudaq
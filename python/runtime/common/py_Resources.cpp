@@ -46,6 +46,10 @@ This includes all gate counts.)#")
       .def(
           "count", [](Resources &self) { return self.count(); },
           "Get the total number of occurrences of all gates")
+      .def_property_readonly(
+          "depth", [](Resources &self) { return self.getDepth(); },
+          "The circuit depth, or `None` if it is unknown. The depth is only "
+          "known when the resources are estimated at compilation time.\n")
       .def(
           "__str__",
           [](Resources &self) {
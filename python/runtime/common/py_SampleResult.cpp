@@ -6,6 +6,7 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/stl.h>
 
@@ -13,10 +14,97 @@
 
 #include "common/SampleResult.h"
 
+#include <algorithm>
 #include <sstream>
 
 namespace cudaq {
 
+/// @brief Return a read-only array viewing the packed words of `shots` with
+/// elements of type `T`, without copying them. The array keeps `owner` alive.
+template <typename T>
+static py::array_t<T> packedShotsView(const PackedShots &shots,
+                                      py::object owner) {
+  const auto wordsPerShot = shots.wordsPerShot();
+  const auto elementsPerShot = wordsPerShot * sizeof(std::uint64_t) / sizeof(T);
+  std::vector<ssize_t> shape = {static_cast<ssize_t>(shots.size()),
+                                static_cast<ssize_t>(elementsPerShot)};
+  std::vector<ssize_t> strides = {
+      static_cast<ssize_t>(sizeof(std::uint64_t) * wordsPerShot),
+      static_cast<ssize_t>(sizeof(T))};
+  py::array_t<T> array(shape, strides,
+                       reinterpret_cast<const T *>(shots.words.data()), owner);
+  py::detail::array_proxy(array.ptr())->flags &=
+      ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+  return array;
+}
+
+/// @brief Return the (shots x bits) array of the sequential data of the given
+/// register, one `uint8` per bit.
+static py::array_t<std::uint8_t>
+sequentialBits(const sample_result &self, const std::string &registerName) {
+  if (self.has_packed_sequential_data(registerName)) {
+    const auto &shots = self.packed_sequential_data(registerName);
+    py::array_t<std::uint8_t> array(
+        {static_cast<ssize_t>(shots.size()),
+         static_cast<ssize_t>(shots.numBits)});
+    auto *bits = array.mutable_data();
+    for (std::size_t s = 0; s < shots.size(); ++s)
+      for (std::size_t b = 0; b < shots.numBits; ++b)
+        *bits++ = shots.bit(s, b);
+    return array;
+  }
+  const auto data = self.sequential_data(registerName);
+  const std::size_t numBits = data.empty() ? 0 : data.front().size();
+  py::array_t<std::uint8_t> array(
+      {static_cast<ssize_t>(data.size()), static_cast<ssize_t>(numBits)});
+  auto *bits = array.mutable_data();
+  for (const auto &bitString : data) {
+    if (bitString.size() != numBits)
+      throw std::runtime_error("sequential data of register " + registerName +
+                               " has bit strings of different lengths");
+    for (char c : bitString)
+      *bits++ = c == '1';
+  }
+  return array;
+}
+
+/// @brief Return the outcomes of the given register as integers, where bit
+/// `i` is character `i` of the bit string, in increasing order, and their
+/// counts.
+static py::tuple histogram(const sample_result &self,
+                           const std::string &registerName) {
+  std::vector<std::pair<std::uint64_t, std::size_t>> hist;
+  if (self.has_packed_sequential_data(registerName)) {
+    const auto &shots = self.packed_sequential_data(registerName);
+    if (shots.numBits > 64)
+      throw std::runtime_error("histogram is only supported for registers of "
+                               "at most 64 bits");
+    auto packedHist = shots.histogram();
+    hist.assign(packedHist.begin(), packedHist.end());
+  } else {
+    for (const auto &[bitString, count] : self.to_map(registerName)) {
+      if (bitString.size() > 64)
+        throw std::runtime_error("histogram is only supported for registers "
+                                 "of at most 64 bits");
+      std::uint64_t outcome = 0;
+      for (std::size_t i = 0; i < bitString.size(); ++i)
+        if (bitString[i] == '1')
+          outcome |= std::uint64_t(1) << i;
+      hist.emplace_back(outcome, count);
+    }
+  }
+  std::sort(hist.begin(), hist.end());
+  py::array_t<std::uint64_t> outcomes(static_cast<ssize_t>(hist.size()));
+  py::array_t<std::uint64_t> counts(static_cast<ssize_t>(hist.size()));
+  auto *outcomesData = outcomes.mutable_data();
+  auto *countsData = counts.mutable_data();
+  for (std::size_t i = 0; i < hist.size(); ++i) {
+    outcomesData[i] = hist[i].first;
+    countsData[i] = hist[i].second;
+  }
+  return py::make_tuple(outcomes, counts);
+}
+
 void bindMeasureCounts(py::module &mod) {
   using namespace cudaq;
 
@@ -167,6 +255,74 @@ Returns:
            "Return the data from the given register (`register_name`) as it "
            "was collected sequentially. A list of measurement results, not "
            "collated into a map.\n")
+      .def(
+          "get_packed_sequential_data",
+          [](py::object self, const std::string &registerName) {
+            return packedShotsView<std::uint64_t>(
+                self.cast<sample_result &>().packed_sequential_data(
+                    registerName),
+                self);
+          },
+          py::arg("register_name") = GlobalRegisterName,
+          R"#(Return the data from the given register (`register_name`) as it 
+was collected sequentially, in bit-packed form and without copying it.
+
+Bit `i` of a shot's bit string is stored in bit `i % 64` of word `i // 64` of 
+the shot's row.
+
+Args:
+  register_name (Optional[str]): The optional measurement register name. 
+		Defaults to the '__global__' register.
+Returns:
+  :class:`numpy.ndarray`: 
+	A read-only `uint64` array with one row per shot.)#")
+      .def(
+          "get_packed_sequential_bytes",
+          [](py::object self, const std::string &registerName) {
+            return packedShotsView<std::uint8_t>(
+                self.cast<sample_result &>().packed_sequential_data(
+                    registerName),
+                self);
+          },
+          py::arg("register_name") = GlobalRegisterName,
+          R"#(Return the data from the given register (`register_name`) as it 
+was collected sequentially, in bit-packed form and without copying it.
+
+Bit `i` of a shot's bit string is stored in bit `i % 8` of byte `i // 8` of 
+the shot's row, such that `numpy.unpackbits(data, axis=1, bitorder='little')` 
+unpacks the bits. Rows are padded to a multiple of 8 bytes.
+
+Args:
+  register_name (Optional[str]): The optional measurement register name. 
+		Defaults to the '__global__' register.
+Returns:
+  :class:`numpy.ndarray`: 
+	A read-only `uint8` array with one row per shot.)#")
+      .def("get_sequential_bits", &sequentialBits,
+           py::arg("register_name") = GlobalRegisterName,
+           R"#(Return the data from the given register (`register_name`) as it 
+was collected sequentially, as an array with one row per shot and one column 
+per bit. No Python object is created per shot.
+
+Args:
+  register_name (Optional[str]): The optional measurement register name. 
+		Defaults to the '__global__' register.
+Returns:
+  :class:`numpy.ndarray`: 
+	A `uint8` array of shape `(shots, bits)` holding 0 or 1.)#")
+      .def("get_histogram", &histogram,
+           py::arg("register_name") = GlobalRegisterName,
+           R"#(Return the measurement counts of the given register 
+(`register_name`) as arrays. Each outcome is an integer whose bit `i` is 
+character `i` of the measured bit string. No Python object is created per 
+outcome.
+
+Args:
+  register_name (Optional[str]): The optional measurement register name. 
+		Defaults to the '__global__' register.
+Returns:
+  Tuple[:class:`numpy.ndarray`, :class:`numpy.ndarray`]: 
+	The `uint64` outcomes, in increasing order, and their `uint64` counts.)#")
       .def(
           "get_register_counts",
           [&](sample_result &self, const std::string &registerName) {
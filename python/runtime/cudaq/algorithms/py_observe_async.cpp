@@ -17,6 +17,7 @@
 #include "mlir/CAPI/IR.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include <fmt/core.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 namespace py = pybind11;
@@ -84,23 +85,65 @@ static async_observe_result pyObserveAsync(const std::string &shortName,
       spin_operator, platform, shots, shortName, qpu_id);
 }
 
+// FIXME(OperatorCpp): Remove this when the operator class is implemented in
+// C++
+static spin_op toSpinOp(py::object &obj) {
+  if (py::hasattr(obj, "_to_spinop"))
+    return obj.attr("_to_spinop")().cast<spin_op>();
+  return obj.cast<spin_op>();
+}
+
 static async_observe_result
 observe_async_impl(const std::string &shortName, MlirModule module,
                    MlirType returnTy, py::object &spin_operator_obj,
                    std::size_t qpu_id, int shots, py::args args) {
-  // FIXME(OperatorCpp): Remove this when the operator class is implemented in
-  // C++
-  spin_op spin_operator = [](py::object &obj) -> spin_op {
-    if (py::hasattr(obj, "_to_spinop"))
-      return obj.attr("_to_spinop")().cast<spin_op>();
-    return obj.cast<spin_op>();
-  }(spin_operator_obj);
+  spin_op spin_operator = toSpinOp(spin_operator_obj);
   auto mod = unwrap(module);
   auto retTy = unwrap(returnTy);
   return pyObserveAsync(shortName, mod, retTy, spin_operator, qpu_id, shots,
                         args);
 }
 
+/// @brief Run `cudaq::observe` on the provided kernel and spin operator for
+/// each row of `parameters`, the arguments of one execution. The arguments are
+/// packed from the array and the kernel launched for every row without
+/// returning to Python.
+static std::vector<observe_result> observe_broadcast_impl(
+    const std::string &shortName, MlirModule module, MlirType returnTy,
+    py::object &spin_operator_obj,
+    py::array_t<double, py::array::c_style | py::array::forcecast> parameters,
+    int shots, std::size_t qpu_id) {
+  if (parameters.ndim() != 2)
+    throw std::runtime_error("parameters must be a 2D array.");
+  spin_op spin_operator = toSpinOp(spin_operator_obj);
+  auto mod = unwrap(module);
+  auto retTy = unwrap(returnTy);
+  auto fnOp = getKernelFuncOp(mod, shortName);
+  const std::size_t numSets = parameters.shape(0);
+  const std::size_t numParameters = parameters.shape(1);
+  const double *data = parameters.data();
+  auto &platform = get_platform();
+
+  // Should only have C++ going on here, safe to release the GIL
+  py::gil_scoped_release release;
+  std::vector<observe_result> results;
+  results.reserve(numSets);
+  for (std::size_t i = 0; i < numSets; ++i) {
+    auto opaques = marshal_parameters_for_module_launch(
+        fnOp, data + i * numParameters, numParameters);
+    results.emplace_back(
+        details::runObservation(
+            [&]() {
+              [[maybe_unused]] auto result =
+                  clean_launch_module(shortName, mod, retTy, opaques);
+            },
+            spin_operator, platform, shots, shortName, qpu_id, nullptr, i,
+            numSets)
+            .value());
+  }
+  return results;
+}
+
 /// @brief Run `cudaq::observe` on the provided kernel and spin operator.
 static observe_result
 pyObservePar(const PyParType &type, const std::string &shortName,
@@ -130,7 +173,7 @@ pyObservePar(const PyParType &type, const std::string &shortName,
           return pyObserveAsync(shortName, module, returnTy, op, i, shots,
                                 args);
         },
-        spin_operator, nQpus);
+        spin_operator, nQpus, details::observeChunksPerQpu(shots), shots);
   }
 
   if (!mpi::is_initialized())
@@ -142,21 +185,23 @@ pyObservePar(const PyParType &type, const std::string &shortName,
   auto rank = mpi::rank();
   auto nRanks = mpi::num_ranks();
 
-  // Each rank gets a subset of the spin terms
-  auto spins = spin_operator.distribute_terms(nRanks);
-
-  // Get this rank's set of spins to compute
-  auto localH = spins[rank];
+  // Each rank only builds its own subset of the spin terms, of balanced
+  // estimated cost.
+  auto localH = details::commutingGroupsChunk(
+      spin_op::canonicalize(spin_operator), nRanks, rank, shots);
 
   // Distribute locally, i.e. to the local nodes QPUs
-  auto localRankResult = details::distributeComputations(
-      [&](std::size_t i, const spin_op &op) {
-        return pyObserveAsync(shortName, module, returnTy, op, i, shots, args);
-      },
-      localH, nQpus);
-
-  // combine all the data via an all_reduce
-  auto exp_val = localRankResult.expectation();
+  double exp_val = 0.0;
+  if (localH.num_terms() > 0)
+    exp_val = details::distributeComputations(
+                  [&](std::size_t i, const spin_op &op) {
+                    return pyObserveAsync(shortName, module, returnTy, op, i,
+                                          shots, args);
+                  },
+                  localH, nQpus, details::observeChunksPerQpu(shots), shots)
+                  .expectation();
+
+  // Sum the partial expectation values of all ranks.
   auto globalExpVal = mpi::all_reduce(exp_val, std::plus<double>());
   return observe_result{globalExpVal, spin_operator};
 }
@@ -197,6 +242,10 @@ void cudaq::bindObserveAsync(py::module &mod) {
   mod.def("observe_async_impl", observe_async_impl,
           "See the python documentation for `observe_async`.");
 
+  mod.def("observe_broadcast_impl", observe_broadcast_impl,
+          "Broadcast `observe` over the rows of a 2D array of parameters. See "
+          "the python documentation for `observe`.");
+
   mod.def("isValidObserveKernel_impl", isValidObserveKernel_impl,
           "Test to see if the kernel is suited for use with observe.");
 
@@ -12,6 +12,7 @@
 #include "runtime/cudaq/platform/py_alt_launch_kernel.h"
 #include "utils/OpaqueArguments.h"
 #include "mlir/Bindings/Python/PybindAdaptors.h"
+#include <cstdlib>
 #include <future>
 #include <pybind11/complex.h>
 #include <pybind11/functional.h>
@@ -93,7 +94,11 @@ static std::vector<py::object> pyReadResults(details::RunResultSpan results,
                                              std::size_t shots_count,
                                              const std::string &name) {
   auto returnTy = recoverReturnType(mod, name);
-  return readRunResults(mod, returnTy, results, shots_count);
+  auto ret = readRunResults(mod, returnTy, results, shots_count);
+  // The results are converted from the buffer of the parser, whose ownership
+  // was handed to the span.
+  std::free(results.data);
+  return ret;
 }
 
 /// @brief Run `cudaq::run` on the provided kernel.
@@ -187,28 +192,28 @@ static async_run_result run_async_impl(const std::string &shortName,
     // Release GIL to allow c++ threads, all code inside the scope is c++, so
     // there is no need to re-acquire the GIL inside the thread.
     py::gil_scoped_release gil_release{};
-    QuantumTask wrapped = detail::make_copyable_function(
-        [sp = std::move(spanPromise), ep = std::move(errorPromise),
-         noise_model = std::move(noise_model), qpu_id, name = shortName,
-         opaques = std::move(opaques), shots_count, retTy,
-         mod = mod.clone()]() mutable {
-          auto &platform = get_platform();
-
-          // Launch the kernel in the appropriate context.
-          if (noise_model.has_value())
-            platform.set_noise(&noise_model.value());
-          try {
-            auto span = pyRunTheKernel(name, platform, mod, retTy, shots_count,
-                                       qpu_id, opaques);
-            sp.set_value(span);
-            ep.set_value("");
-          } catch (std::runtime_error &e) {
-            auto message = std::string(e.what());
-            sp.set_value({});
-            ep.set_value(message);
-          }
-          platform.reset_noise();
-        });
+    QuantumTask wrapped = [sp = std::move(spanPromise),
+                           ep = std::move(errorPromise),
+                           noise_model = std::move(noise_model), qpu_id,
+                           name = shortName, opaques = std::move(opaques),
+                           shots_count, retTy, mod = mod.clone()]() mutable {
+      auto &platform = get_platform();
+
+      // Launch the kernel in the appropriate context.
+      if (noise_model.has_value())
+        platform.set_noise(&noise_model.value());
+      try {
+        auto span = pyRunTheKernel(name, platform, mod, retTy, shots_count,
+                                   qpu_id, opaques);
+        sp.set_value(span);
+        ep.set_value("");
+      } catch (std::runtime_error &e) {
+        auto message = std::string(e.what());
+        sp.set_value({});
+        ep.set_value(message);
+      }
+      platform.reset_noise();
+    };
     platform.enqueueAsyncTask(qpu_id, wrapped);
   }
 
@@ -272,7 +277,16 @@ void cudaq::bindPyRunAsync(py::module &mod) {
             delete self.results;
             return ret;
           },
-          "FIXME: documentation goes here");
+          "FIXME: documentation goes here")
+      .def(
+          "is_ready",
+          [](async_run_result &self) {
+            return !self.ready.valid() ||
+                   self.ready.wait_for(std::chrono::seconds(0)) ==
+                       std::future_status::ready;
+          },
+          "Return true if the results are available, i.e., if `get` would not "
+          "wait.");
 
   mod.def("run_async_impl", run_async_impl,
           R"#(
@@ -15,6 +15,7 @@
 #include "mlir/CAPI/IR.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include <fmt/core.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 namespace py = pybind11;
@@ -55,6 +56,44 @@ static async_sample_result sample_async_impl(
       platform, kernelName, shots_count, explicit_measurements, qpu_id);
 }
 
+/// @brief Run `cudaq::sample` on the provided kernel for each row of
+/// `parameters`, the arguments of one execution. The arguments are packed from
+/// the array and the kernel launched for every row without returning to
+/// Python.
+static std::vector<sample_result> sample_broadcast_impl(
+    const std::string &shortName, MlirModule module, MlirType returnTy,
+    py::array_t<double, py::array::c_style | py::array::forcecast> parameters,
+    std::size_t shots_count, bool explicit_measurements) {
+  if (parameters.ndim() != 2)
+    throw std::runtime_error("parameters must be a 2D array.");
+  mlir::ModuleOp mod = unwrap(module);
+  auto retTy = unwrap(returnTy);
+  auto fnOp = getKernelFuncOp(mod, shortName);
+  const std::size_t numSets = parameters.shape(0);
+  const std::size_t numParameters = parameters.shape(1);
+  const double *data = parameters.data();
+  auto &platform = get_platform();
+
+  // Should only have C++ going on here, safe to release the GIL
+  py::gil_scoped_release release;
+  std::vector<sample_result> results;
+  results.reserve(numSets);
+  for (std::size_t i = 0; i < numSets; ++i) {
+    auto opaques = marshal_parameters_for_module_launch(
+        fnOp, data + i * numParameters, numParameters);
+    results.emplace_back(
+        details::runSampling(
+            [&]() {
+              [[maybe_unused]] auto result =
+                  clean_launch_module(shortName, mod, retTy, opaques);
+            },
+            platform, shortName, shots_count, explicit_measurements,
+            /*qpu_id=*/0, nullptr, i, numSets)
+            .value());
+  }
+  return results;
+}
+
 void cudaq::bindSampleAsync(py::module &mod) {
   // Async. result wrapper for Python kernels, which also holds the Python MLIR
   // context.
@@ -88,6 +127,10 @@ programming pattern.
            py::call_guard<py::gil_scoped_release>(),
            "Return the :class:`SampleResult` from the asynchronous sample "
            "execution.\n")
+      .def("is_ready", &async_sample_result::is_ready,
+           py::call_guard<py::gil_scoped_release>(),
+           "Return true if the result is available, i.e., if `get` would not "
+           "wait.\n")
       .def(
           "__str__",
           [](async_sample_result &res) {
@@ -98,4 +141,7 @@ programming pattern.
           "FIXME: document");
 
   mod.def("sample_async_impl", sample_async_impl, "FIXME: document");
+  mod.def("sample_broadcast_impl", sample_broadcast_impl,
+          "Broadcast `sample` over the rows of a 2D array of parameters. See "
+          "the python documentation for `sample`.");
 }
@@ -12,9 +12,12 @@
 #include "common/FmtCore.h"
 #include "common/Logger.h"
 #include "cudaq/algorithms/get_state.h"
+#include "runtime/cudaq/operators/py_helpers.h"
 #include "runtime/cudaq/platform/py_alt_launch_kernel.h"
+#include "utils/DLPack.h"
 #include "utils/OpaqueArguments.h"
 #include "mlir/Bindings/Python/PybindAdaptors.h"
+#include <pybind11/stl.h>
 
 using namespace cudaq;
 
@@ -202,6 +205,68 @@ state pyGetStateLibraryMode(py::object kernel, py::args args) {
   });
 }
 
+namespace {
+using namespace cudaq::dlpack;
+
+/// The exported tensor, which keeps the state data alive until the consumer
+/// releases it.
+struct DLPackStateExport {
+  state owner;
+  std::vector<int64_t> shape;
+  DLManagedTensor tensor;
+};
+} // namespace
+
+/// @brief Return the single device tensor of the given state, for the
+/// zero-copy export protocols.
+static SimulationState::Tensor getDeviceTensor(const state &self,
+                                               const std::string &protocol) {
+  if (!self.is_on_gpu())
+    throw std::runtime_error(protocol + " requires a state on the GPU.");
+  if (self.get_num_tensors() != 1)
+    throw std::runtime_error(protocol + " is only supported for vector and "
+                             "matrix state data.");
+  return self.get_tensor();
+}
+
+/// @brief Export the device data of the given state as a DLPack capsule,
+/// without copy. The capsule holds a reference to the state data.
+static py::capsule toDLPack(const state &self) {
+  auto tensor = getDeviceTensor(self, "__dlpack__");
+  auto *ctx = new DLPackStateExport{
+      self, std::vector<int64_t>(tensor.extents.begin(), tensor.extents.end()),
+      DLManagedTensor{}};
+  auto &dlTensor = ctx->tensor.dl_tensor;
+  dlTensor.data = tensor.data;
+  dlTensor.device = {kDLCUDA, self.get_device_id()};
+  dlTensor.ndim = static_cast<int32_t>(ctx->shape.size());
+  dlTensor.dtype = {kDLComplex,
+                    static_cast<uint8_t>(8 * tensor.element_size()), 1};
+  dlTensor.shape = ctx->shape.data();
+  // Compact row-major
+  dlTensor.strides = nullptr;
+  dlTensor.byte_offset = 0;
+  ctx->tensor.manager_ctx = ctx;
+  ctx->tensor.deleter = [](DLManagedTensor *self) {
+    delete static_cast<DLPackStateExport *>(self->manager_ctx);
+  };
+  // Consumers rename the capsule once they take ownership of the tensor,
+  // otherwise it is released with the capsule.
+  auto *capsule =
+      PyCapsule_New(&ctx->tensor, "dltensor", [](PyObject *capsule) {
+        if (!PyCapsule_IsValid(capsule, "dltensor"))
+          return;
+        auto *managed = static_cast<DLManagedTensor *>(
+            PyCapsule_GetPointer(capsule, "dltensor"));
+        managed->deleter(managed);
+      });
+  if (!capsule) {
+    delete ctx;
+    throw py::error_already_set();
+  }
+  return py::reinterpret_steal<py::capsule>(capsule);
+}
+
 static py::buffer_info getCupyBufferInfo(py::buffer cupy_buffer) {
   // Note: cupy 13.5+ arrays will bind (overload resolution) to a py::buffer
   // type. However, we cannot access the underlying buffer info via a
@@ -512,8 +577,61 @@ void cudaq::bindPyState(py::module &mod, LinkedLibraryHolder &holder) {
               throw std::runtime_error("invalid cupy element type " + typeStr);
           },
           "Return a state from CuPy device array.")
+      .def_static(
+          "from_sparse_data",
+          [](std::size_t numQubits, const py::dict &amplitudes) {
+            sparse_state_data data{numQubits, {}};
+            data.amplitudes.reserve(amplitudes.size());
+            for (auto [index, amplitude] : amplitudes)
+              data.amplitudes.emplace_back(
+                  index.cast<std::size_t>(),
+                  amplitude.cast<std::complex<double>>());
+            return state::from_data(data);
+          },
+          py::arg("num_qubits"), py::arg("amplitudes"),
+          "Return a state of `num_qubits` qubits from its nonzero amplitudes, "
+          "given as a dictionary from basis state index to amplitude. The "
+          "simulator initializes its state without a dense copy on the host.")
       .def("is_on_gpu", &state::is_on_gpu,
            "Return True if this state is on the GPU.")
+      .def_property_readonly(
+          "__cuda_array_interface__",
+          [](const state &self) {
+            auto tensor = getDeviceTensor(self, "__cuda_array_interface__");
+            py::dict info;
+            info["shape"] = py::tuple(py::cast(tensor.extents));
+            info["typestr"] =
+                self.get_precision() == SimulationState::precision::fp32
+                    ? "<c8"
+                    : "<c16";
+            info["data"] = py::make_tuple(
+                reinterpret_cast<std::intptr_t>(tensor.data), false);
+            info["strides"] = py::none();
+            info["version"] = 3;
+            return info;
+          },
+          "The CUDA array interface of the device data of this state. "
+          "Consumers, e.g., `cupy.asarray(state)`, access the data without "
+          "copy and keep this state alive.")
+      .def(
+          "__dlpack__",
+          [](const state &self, py::object stream, py::kwargs) {
+            // The simulator has synchronized the device once the state is
+            // returned, hence there is no pending work to order `stream`
+            // after.
+            return toDLPack(self);
+          },
+          py::arg("stream") = py::none(),
+          "Export the device data of this state as a DLPack capsule, without "
+          "copy, e.g., for `torch.from_dlpack(state)`. The exported tensor "
+          "keeps the state data alive.")
+      .def(
+          "__dlpack_device__",
+          [](const state &self) {
+            getDeviceTensor(self, "__dlpack_device__");
+            return py::make_tuple(kDLCUDA, self.get_device_id());
+          },
+          "Return the DLPack device type and id of the data of this state.")
       .def(
           "getTensor",
           [](state &self, std::size_t idx) { return self.get_tensor(idx); },
@@ -854,7 +972,15 @@ for more information on this programming pattern.)#")
           "get", [](async_state_result &self) { return self.get(); },
           py::call_guard<py::gil_scoped_release>(),
           "Return the :class:`State` from the asynchronous `get_state` "
-          "accessor execution.\n");
+          "accessor execution.\n")
+      .def(
+          "is_ready",
+          [](async_state_result &self) {
+            return !self.valid() || self.wait_for(std::chrono::seconds(0)) ==
+                                       std::future_status::ready;
+          },
+          "Return true if the :class:`State` is available, i.e., if `get` "
+          "would not wait.\n");
 
   mod.def(
       "get_state_async_impl",
@@ -872,6 +998,15 @@ for more information on this programming pattern.)#")
       },
       "See the python documentation for get_state_async.");
 
+  mod.def(
+      "overlap_matrix",
+      [](const std::vector<state> &bras, const std::vector<state> &kets) {
+        auto overlaps = cudaq::overlap_matrix(bras, kets);
+        return details::cmat_to_numpy(overlaps);
+      },
+      py::arg("bras"), py::arg("kets"),
+      "See the python documentation for overlap_matrix.");
+
   mod.def("get_state_library_mode", &pyGetStateLibraryMode,
           "Run `cudaq.get_state` in library mode on the provided kernel "
           "and args.");
@@ -8,13 +8,19 @@
 
 #include "BatchingUtils.h"
 #include "CuDensityMatContext.h"
+#include "CuDensityMatEvolveSink.h"
 #include "CuDensityMatExpectation.h"
+#include "CuDensityMatOperatorAction.h"
 #include "CuDensityMatState.h"
 #include "CuDensityMatTimeStepper.h"
 #include "CuDensityMatUtils.h"
+#include "cudaq.h"
 #include "cudaq/algorithms/base_integrator.h"
 #include "cudaq/algorithms/integrator.h"
 #include "cudaq/schedule.h"
+#include "utils/DLPack.h"
+#include <map>
+#include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -27,6 +33,55 @@ cudaq::CuDensityMatState *asCudmState(cudaq::state &cudaqState) {
     throw std::runtime_error("Invalid state.");
   return cudmState;
 }
+
+// A device buffer borrowed from a DLPack producer, e.g., a `torch` tensor or a
+// `cupy` array, which is released with this object.
+class BorrowedDLPackBuffer {
+public:
+  BorrowedDLPackBuffer(const py::object &array, const std::string &name) {
+    if (!py::hasattr(array, "__dlpack__") ||
+        !py::hasattr(array, "__dlpack_device__"))
+      throw std::invalid_argument(name + " does not support DLPack.");
+    const auto device = array.attr("__dlpack_device__")().cast<py::tuple>();
+    if (device[0].cast<int32_t>() != cudaq::dlpack::kDLCUDA)
+      throw std::invalid_argument(name + " must be on a CUDA device.");
+    // The producer makes the data ready on the legacy default stream, which
+    // the computations are enqueued on, without a host synchronization.
+    m_capsule = array.attr("__dlpack__")(py::arg("stream") = 1);
+    auto *tensor = static_cast<cudaq::dlpack::DLManagedTensor *>(
+        PyCapsule_GetPointer(m_capsule.ptr(), "dltensor"));
+    if (!tensor || PyCapsule_SetName(m_capsule.ptr(), "used_dltensor") != 0)
+      throw py::error_already_set();
+    m_tensor.reset(tensor);
+
+    const auto &dlTensor = tensor->dl_tensor;
+    if (dlTensor.dtype.code != cudaq::dlpack::kDLComplex ||
+        dlTensor.dtype.bits != 128 || dlTensor.dtype.lanes != 1)
+      throw std::invalid_argument(name + " must be an array of complex128.");
+    // Compact row-major, ignoring the strides of the extents of size 1.
+    int64_t expectedStride = 1;
+    for (int32_t i = dlTensor.ndim - 1; i >= 0; --i) {
+      if (dlTensor.strides && dlTensor.shape[i] != 1 &&
+          dlTensor.strides[i] != expectedStride)
+        throw std::invalid_argument(name + " must be contiguous.");
+      expectedStride *= dlTensor.shape[i];
+    }
+    size = expectedStride;
+    data = static_cast<char *>(dlTensor.data) + dlTensor.byte_offset;
+  }
+
+  void *data = nullptr;
+  std::size_t size = 0;
+
+private:
+  py::object m_capsule;
+  std::unique_ptr<cudaq::dlpack::DLManagedTensor,
+                  void (*)(cudaq::dlpack::DLManagedTensor *)>
+      m_tensor{nullptr, [](cudaq::dlpack::DLManagedTensor *tensor) {
+                 if (tensor->deleter)
+                   tensor->deleter(tensor);
+               }};
+};
 } // namespace
 
 // Internal dynamics bindings
@@ -39,6 +94,30 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
         : cudaq::CuDensityMatTimeStepper(handle, liouvillian),
           m_schedule(schedule) {}
     cudaq::schedule m_schedule;
+
+    // Return a state wrapping the device buffer `data`, without copy.
+    // The states of the buffers given to `compute_dlpack` are kept by data
+    // pointer, size and batch size, since an integrator usually recycles a few
+    // buffers, e.g., through the caching allocator of `torch`.
+    cudaq::CuDensityMatState &borrowState(void *data, std::size_t size,
+                                          const std::vector<int64_t> &dims,
+                                          int64_t batchSize) {
+      const auto key = std::make_tuple(data, size, batchSize);
+      if (auto iter = m_borrowedStates.find(key);
+          iter != m_borrowedStates.end())
+        return *iter->second;
+      auto state = std::make_unique<cudaq::CuDensityMatState>(
+          size, data, /*borrowed=*/true);
+      state->initialize_cudm(
+          cudaq::dynamics::Context::getCurrentContext()->getHandle(), dims,
+          batchSize);
+      return *m_borrowedStates.emplace(key, std::move(state)).first->second;
+    }
+
+    static constexpr std::size_t maxBorrowedStates = 16;
+    std::map<std::tuple<void *, std::size_t, int64_t>,
+             std::unique_ptr<cudaq::CuDensityMatState>>
+        m_borrowedStates;
   };
 
   // Time stepper bindings
@@ -48,10 +127,7 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
              cudaq::sum_op<cudaq::matrix_handler> hamiltonian,
              std::vector<cudaq::sum_op<cudaq::matrix_handler>> collapse_ops,
              bool is_master_equation) {
-            std::unordered_map<std::string, std::complex<double>> params;
-            for (const auto &param : schedule.get_parameters()) {
-              params[param] = schedule.get_value_function()(param, 0.0);
-            }
+            const auto params = schedule.get_parameter_values(0.0);
             auto liouvillian = cudaq::dynamics::Context::getCurrentContext()
                                    ->getOpConverter()
                                    .constructLiouvillian(
@@ -64,10 +140,7 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
       .def(py::init([](cudaq::schedule schedule,
                        std::vector<int64_t> modeExtents,
                        cudaq::super_op superOp) {
-        std::unordered_map<std::string, std::complex<double>> params;
-        for (const auto &param : schedule.get_parameters()) {
-          params[param] = schedule.get_value_function()(param, 0.0);
-        }
+        const auto params = schedule.get_parameter_values(0.0);
         auto liouvillian =
             cudaq::dynamics::Context::getCurrentContext()
                 ->getOpConverter()
@@ -84,10 +157,7 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
                            std::vector<cudaq::sum_op<cudaq::matrix_handler>>>
                            &list_collapse_ops,
                        bool is_master_equation) {
-        std::unordered_map<std::string, std::complex<double>> params;
-        for (const auto &param : schedule.get_parameters()) {
-          params[param] = schedule.get_value_function()(param, 0.0);
-        }
+        const auto params = schedule.get_parameter_values(0.0);
         auto liouvillian =
             cudaq::dynamics::Context::getCurrentContext()
                 ->getOpConverter()
@@ -100,10 +170,7 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
       .def(py::init([](cudaq::schedule schedule,
                        std::vector<int64_t> modeExtents,
                        const std::vector<cudaq::super_op> &superOps) {
-        std::unordered_map<std::string, std::complex<double>> params;
-        for (const auto &param : schedule.get_parameters()) {
-          params[param] = schedule.get_value_function()(param, 0.0);
-        }
+        const auto params = schedule.get_parameter_values(0.0);
         auto liouvillian =
             cudaq::dynamics::Context::getCurrentContext()
                 ->getOpConverter()
@@ -115,20 +182,14 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
       .def("compute",
            [](PyCuDensityMatTimeStepper &self, cudaq::state &inputState,
               double t) {
-             std::unordered_map<std::string, std::complex<double>> params;
-             for (const auto &param : self.m_schedule.get_parameters()) {
-               params[param] = self.m_schedule.get_value_function()(param, t);
-             }
+             const auto params = self.m_schedule.get_parameter_values(t);
              return self.compute(inputState, t, params);
            })
       .def("compute",
            [](PyCuDensityMatTimeStepper &self, cudaq::state &inputState,
               double t, cudaq::state &outputState) {
              // Compute into the provided output state
-             std::unordered_map<std::string, std::complex<double>> params;
-             for (const auto &param : self.m_schedule.get_parameters()) {
-               params[param] = self.m_schedule.get_value_function()(param, t);
-             }
+             const auto params = self.m_schedule.get_parameter_values(t);
 
              auto *inputSimState =
                  cudaq::state_helper::getSimulationState(&inputState);
@@ -143,12 +204,34 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
              if (!castInputSimState || !castOutputSimState)
                throw std::runtime_error("Invalid input or output state.");
 
-             assert(castInputSimState->getBatchSize() ==
-                    castOutputSimState->getBatchSize());
-             self.computeImpl(castInputSimState->get_impl(),
-                              castOutputSimState->get_impl(), t, params,
-                              castInputSimState->getBatchSize());
-           });
+             self.computeImpl(*castInputSimState, *castOutputSimState, t,
+                              params);
+           })
+      .def(
+          "compute_dlpack",
+          [](PyCuDensityMatTimeStepper &self, const py::object &input,
+             double t, const py::object &output,
+             const std::vector<int64_t> &modeExtents, int64_t batchSize) {
+            const auto params = self.m_schedule.get_parameter_values(t);
+            BorrowedDLPackBuffer inputBuffer(input, "The input array");
+            BorrowedDLPackBuffer outputBuffer(output, "The output array");
+            if (inputBuffer.size != outputBuffer.size)
+              throw std::invalid_argument(
+                  "The input and output arrays must have the same size.");
+            if (self.m_borrowedStates.size() + 2 >
+                PyCuDensityMatTimeStepper::maxBorrowedStates)
+              self.m_borrowedStates.clear();
+            auto &inputState = self.borrowState(
+                inputBuffer.data, inputBuffer.size, modeExtents, batchSize);
+            auto &outputState = self.borrowState(
+                outputBuffer.data, outputBuffer.size, modeExtents, batchSize);
+            self.computeImpl(inputState, outputState, t, params,
+                             /*synchronize=*/false);
+          },
+          "Add the action of the Liouvillian at time `t` on the device array "
+          "`input` to the device array `output`, both exchanged through "
+          "DLPack without copy. The computation is enqueued on the legacy "
+          "default CUDA stream, without host synchronization.");
 
   // System dynamics data class
   py::class_<cudaq::SystemDynamics>(m, "SystemDynamics")
@@ -186,6 +269,64 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
         return expVals;
       });
 
+  // Expectation calculation of several observables at once
+  py::class_<cudaq::CuDensityMatFusedExpectation>(
+      m, "CuDensityMatFusedExpectation")
+      .def(py::init(
+          [](std::vector<cudaq::sum_op<cudaq::matrix_handler>> &observables,
+             const std::vector<int64_t> &modeExtents) {
+            auto &opConverter = cudaq::dynamics::Context::getCurrentContext()
+                                    ->getOpConverter();
+            std::vector<cudensitymatOperator_t> ops;
+            for (auto &obs : observables)
+              ops.emplace_back(opConverter.convertToCudensitymatOperator(
+                  {}, obs, modeExtents));
+            return cudaq::CuDensityMatFusedExpectation(
+                cudaq::dynamics::Context::getCurrentContext()->getHandle(),
+                ops);
+          }))
+      .def("prepare",
+           [](cudaq::CuDensityMatFusedExpectation &self, cudaq::state &state) {
+             auto *cudmState = asCudmState(state);
+             assert(cudmState->is_initialized());
+             self.prepare(cudmState->get_impl());
+           })
+      .def("compute", [](cudaq::CuDensityMatFusedExpectation &self,
+                         cudaq::state &state, double t) {
+        auto *cudmState = asCudmState(state);
+        std::vector<std::vector<double>> expVals;
+        for (const auto &results : self.compute(cudmState->get_impl(), t,
+                                                cudmState->getBatchSize())) {
+          auto &obsExpVals = expVals.emplace_back();
+          for (const auto &result : results)
+            obsExpVals.emplace_back(result.real());
+        }
+        return expVals;
+      });
+
+  // Action of an operator on (batched) states
+  py::class_<cudaq::CuDensityMatOperatorAction>(m,
+                                                "CuDensityMatOperatorAction")
+      .def(py::init(
+          [](cudaq::sum_op<cudaq::matrix_handler> &op,
+             const std::vector<int64_t> &modeExtents,
+             const std::unordered_map<std::string, std::complex<double>>
+                 &params) {
+            return cudaq::CuDensityMatOperatorAction(
+                cudaq::dynamics::Context::getCurrentContext()->getHandle(),
+                cudaq::dynamics::Context::getCurrentContext()
+                    ->getOpConverter()
+                    .convertToCudensitymatOperator(params, op, modeExtents));
+          }))
+      .def("compute",
+           [](cudaq::CuDensityMatOperatorAction &self, cudaq::state &inputState,
+              cudaq::state &outputState, double t,
+              const std::unordered_map<std::string, std::complex<double>>
+                  &params) {
+             self.compute(*asCudmState(inputState), *asCudmState(outputState),
+                          t, params);
+           });
+
   // Schedule class
   py::class_<cudaq::schedule>(m, "Schedule")
       .def(py::init<const std::vector<double> &,
@@ -296,6 +437,83 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
       },
       py::arg("super_operators"));
 
+  // Helper to determine how many states like the given one can be evolved as
+  // a batch in the free device memory.
+  m.def(
+      "maxBatchSizeInDeviceMemory",
+      [](const cudaq::state &state, const std::vector<int64_t> &modeExtents,
+         bool asDensityMat, std::size_t numStoredStates) {
+        std::size_t stateVecSize = 1;
+        for (auto extent : modeExtents)
+          stateVecSize *= extent;
+        const bool isDensityMat =
+            asDensityMat ||
+            state.get_tensor().get_num_elements() != stateVecSize;
+        return cudaq::__internal__::maxBatchSizeInDeviceMemory(
+            modeExtents, isDensityMat, numStoredStates);
+      },
+      py::arg("state"), py::arg("dimensions"), py::arg("as_density_matrix"),
+      py::arg("num_stored_states"));
+
+  // Quantum jumps of the trajectories of a stochastic unravelling of the master
+  // equation, evolved as a batch of state vectors.
+  py::class_<cudaq::CuDensityMatQuantumJumps>(m, "QuantumJumps")
+      .def(py::init(
+          [](cudaq::schedule schedule, std::vector<int64_t> modeExtents,
+             cudaq::sum_op<cudaq::matrix_handler> hamiltonian,
+             std::vector<cudaq::sum_op<cudaq::matrix_handler>> collapse_ops,
+             std::size_t num_trajectories) {
+            return std::make_unique<cudaq::CuDensityMatQuantumJumps>(
+                cudaq::SystemDynamics(modeExtents, hamiltonian, collapse_ops),
+                schedule, num_trajectories, cudaq::get_random_seed());
+          }))
+      .def("apply",
+           [](cudaq::CuDensityMatQuantumJumps &self, cudaq::state &state,
+              double t) { return self.apply(*asCudmState(state), t); })
+      .def_static("normalized", [](cudaq::state &state) {
+        return cudaq::state(
+            cudaq::CuDensityMatQuantumJumps::normalized(*asCudmState(state))
+                .release());
+      });
+
+  // Helpers to query the distribution of the states of an evolution across the
+  // MPI ranks.
+  m.def("getNumRanks", []() {
+    return cudaq::dynamics::Context::getCurrentContext()->getNumRanks();
+  });
+  m.def("getRank", []() {
+    return cudaq::dynamics::Context::getCurrentContext()->getRank();
+  });
+
+  // Helper to assemble a resulting state of a distributed evolution on rank 0,
+  // if requested. The other ranks keep their slice of the state.
+  m.def("gatherResultState", [](cudaq::state &state) {
+    auto *cudmState = asCudmState(state);
+    if (!cudaq::dynamics::Context::getCurrentContext()->shouldGatherStates() ||
+        !cudmState->isDistributedSlice())
+      return state;
+    auto gatheredState = cudaq::CuDensityMatState::gatherToRoot(*cudmState);
+    return gatheredState ? cudaq::state(gatheredState.release()) : state;
+  });
+
+  // Helper to deliver the results of the steps of an evolution to a Python
+  // sink. The sink is called from a worker thread, hence the GIL must be
+  // released while waiting for it, including on destruction.
+  struct SinkPipelineDeleter {
+    void operator()(cudaq::dynamics::EvolveSinkPipeline *pipeline) const {
+      py::gil_scoped_release release;
+      delete pipeline;
+    }
+  };
+  py::class_<cudaq::dynamics::EvolveSinkPipeline,
+             std::unique_ptr<cudaq::dynamics::EvolveSinkPipeline,
+                             SinkPipelineDeleter>>(m, "EvolveSinkPipeline")
+      .def(py::init<cudaq::evolve_sink>(), py::arg("sink"))
+      .def("push", &cudaq::dynamics::EvolveSinkPipeline::push,
+           py::call_guard<py::gil_scoped_release>())
+      .def("finish", &cudaq::dynamics::EvolveSinkPipeline::finish,
+           py::call_guard<py::gil_scoped_release>());
+
   auto integratorsSubmodule = m.def_submodule("integrators");
 
   // Runge-Kutta integrator
@@ -317,4 +535,42 @@ PYBIND11_MODULE(nvqir_dynamics_bindings, m) {
       .def("getState", [](cudaq::integrators::runge_kutta &self) {
         return self.getState();
       });
+
+  // Dormand-Prince adaptive step size integrator
+  py::class_<cudaq::integrators::dormand_prince>(integratorsSubmodule,
+                                                 "dormand_prince")
+      .def(py::init<double, double, std::optional<double>>(), py::kw_only(),
+           py::arg("rtol") = 1e-6, py::arg("atol") = 1e-8,
+           py::arg("max_step_size") = py::none())
+      .def("setState",
+           [](cudaq::integrators::dormand_prince &self, cudaq::state &state,
+              double t) { self.setState(state, t); })
+      .def("setSystem",
+           [](cudaq::integrators::dormand_prince &self,
+              cudaq::SystemDynamics system, cudaq::schedule schedule) {
+             cudaq::integrator_helper::init_system_dynamics(self, system,
+                                                            schedule);
+           })
+      .def("integrate", &cudaq::integrators::dormand_prince::integrate)
+      .def("getState", [](cudaq::integrators::dormand_prince &self) {
+        return self.getState();
+      });
+
+  // Krylov subspace exponential integrator
+  py::class_<cudaq::integrators::krylov>(integratorsSubmodule, "krylov")
+      .def(py::init<double, int>(), py::kw_only(),
+           py::arg("tolerance") = 1e-10,
+           py::arg("max_subspace_dim") =
+               cudaq::integrators::krylov::default_max_subspace_dim)
+      .def("setState", [](cudaq::integrators::krylov &self, cudaq::state &state,
+                          double t) { self.setState(state, t); })
+      .def("setSystem",
+           [](cudaq::integrators::krylov &self, cudaq::SystemDynamics system,
+              cudaq::schedule schedule) {
+             cudaq::integrator_helper::init_system_dynamics(self, system,
+                                                            schedule);
+           })
+      .def("integrate", &cudaq::integrators::krylov::integrate)
+      .def("getState",
+           [](cudaq::integrators::krylov &self) { return self.getState(); });
 }
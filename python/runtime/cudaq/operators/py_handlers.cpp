@@ -111,7 +111,13 @@ void bindOperatorHandlers(py::module &mod) {
           py::arg("callback"), py::arg("overwrite") = false,
           "Defines a matrix operator with the given name and dimensions whose"
           "matrix representation can be obtained by invoking the given "
-          "callback function.");
+          "callback function.")
+      .def_static("set_time_dependent", &matrix_handler::set_time_dependent,
+                  py::arg("operator_id"), py::arg("is_time_dependent") = true,
+                  "Marks the operator with the given id as depending on state "
+                  "other than its dimensions and parameters, such that its "
+                  "matrix is recomputed on every evaluation instead of being "
+                  "memoized.");
 
   py::class_<boson_handler>(mod, "BosonOperatorElement")
       .def_property_readonly(
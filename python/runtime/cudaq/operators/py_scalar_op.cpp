@@ -51,6 +51,42 @@ void bindScalarOperator(py::module &mod) {
            "Creates a scalar operator where the given callback function is "
            "invoked during evaluation.")
       .def(py::init<const scalar_operator &>(), "Copy constructor.")
+      .def_static(
+          "piecewise_linear",
+          [](const std::vector<double> &knots,
+             const std::vector<std::complex<double>> &values,
+             const std::string &parameter) {
+            return scalar_operator(
+                time_function::piecewise_linear(knots, values, parameter));
+          },
+          py::arg("knots"), py::arg("values"), py::arg("parameter") = "t",
+          "Creates a scalar operator whose value is the linear interpolation "
+          "of the given values at the given points. The `dynamics` target "
+          "evaluates it on the GPU.")
+      .def_static(
+          "cubic_spline",
+          [](const std::vector<double> &knots,
+             const std::vector<std::complex<double>> &values,
+             const std::string &parameter) {
+            return scalar_operator(
+                time_function::cubic_spline(knots, values, parameter));
+          },
+          py::arg("knots"), py::arg("values"), py::arg("parameter") = "t",
+          "Creates a scalar operator whose value is the natural cubic spline "
+          "interpolation of the given values at the given points. The "
+          "`dynamics` target evaluates it on the GPU.")
+      .def_static(
+          "sinusoid",
+          [](std::complex<double> amplitude, double frequency, double phase,
+             const std::string &parameter) {
+            return scalar_operator(time_function::sinusoid(
+                amplitude, frequency, phase, parameter));
+          },
+          py::arg("amplitude"), py::arg("frequency"), py::arg("phase") = 0.0,
+          py::arg("parameter") = "t",
+          "Creates a scalar operator with value `amplitude * sin(frequency * "
+          "parameter + phase)`. The `dynamics` target evaluates it on the "
+          "GPU.")
 
       // evaluations
 
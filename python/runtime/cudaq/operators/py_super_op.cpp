@@ -71,6 +71,30 @@ void bindSuperOperatorWrapper(py::module &mod) {
           "multiplication of the second operator operand to the "
           "density matrix. The sum is distributed into a linear combination of "
           "super-operator actions.")
+      .def(
+          "to_sparse_matrix",
+          [](const super_op &self, dimension_map &dimensions,
+             const parameter_map &params, bool invert_order) {
+            return self.to_sparse_matrix(dimensions, params, invert_order);
+          },
+          py::arg("dimensions") = dimension_map(),
+          py::arg("parameters") = parameter_map(),
+          py::arg("invert_order") = false,
+          "Return the sparse matrix of the super-operator acting on the "
+          "density matrix vectorized row by row, as by `numpy.ravel`. This "
+          "representation is a `Tuple[list[complex], list[int], list[int]]`, "
+          "encoding the non-zero values, rows, and columns of the matrix, "
+          "and is supported by `scipy.sparse.csr_array`.")
+      .def_static(
+          "lindblad_sparse_matrix", &super_op::lindblad_sparse_matrix,
+          py::arg("hamiltonian"), py::arg("collapse_operators"),
+          py::arg("dimensions") = dimension_map(),
+          py::arg("parameters") = parameter_map(),
+          py::arg("invert_order") = false,
+          "Return the sparse matrix of the Liouvillian of the Lindblad master "
+          "equation with the given Hamiltonian and collapse operators, acting "
+          "on the density matrix vectorized row by row, in the same "
+          "representation as `to_sparse_matrix`.")
       .def(
           "__iter__",
           [](super_op &self) {
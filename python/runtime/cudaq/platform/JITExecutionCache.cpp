@@ -6,49 +6,109 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 #include "JITExecutionCache.h"
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
 
 using namespace mlir;
 
 namespace cudaq {
 
-static constexpr int NUM_JIT_CACHE_ITEMS_TO_RETAIN = 100;
+static constexpr std::size_t DEFAULT_JIT_CACHE_MB = 256;
 
-JITExecutionCache::~JITExecutionCache() {
-  std::scoped_lock<std::mutex> lock(mutex);
-  for (auto &[k, v] : cacheMap)
-    delete v.execEngine;
-  cacheMap.clear();
-}
-bool JITExecutionCache::hasJITEngine(std::size_t hashkey) {
-  std::scoped_lock<std::mutex> lock(mutex);
-  return cacheMap.count(hashkey);
+JITExecutionCache::JITExecutionCache(std::size_t capacityBytes) {
+  stats.capacityBytes = capacityBytes;
 }
 
-void JITExecutionCache::cache(std::size_t hash, ExecutionEngine *jit) {
-  std::scoped_lock<std::mutex> lock(mutex);
-
-  lruList.push_back(hash);
-
-  // If adding a new item would exceed our cache limit, then remove the least
-  // recently used item (at the head of the list).
-  if (cacheMap.size() >= NUM_JIT_CACHE_ITEMS_TO_RETAIN) {
+void JITExecutionCache::evictFor(std::size_t extraBytes) {
+  // Remove the least recently used items (at the head of the list) until the
+  // new bytes fit.
+  while (!lruList.empty() &&
+         stats.sizeBytes + extraBytes > stats.capacityBytes) {
     auto hashToRemove = lruList.begin();
     auto it = cacheMap.find(*hashToRemove);
-    delete it->second.execEngine;
+    stats.sizeBytes -= it->second.sizeBytes;
+    ++stats.evictions;
     lruList.erase(hashToRemove);
     cacheMap.erase(it);
   }
-
-  cacheMap.insert({hash, {jit, std::prev(lruList.end())}});
 }
-ExecutionEngine *JITExecutionCache::getJITEngine(std::size_t hash) {
+
+std::shared_ptr<ExecutionEngine> JITExecutionCache::lookup(std::size_t hash) {
   std::scoped_lock<std::mutex> lock(mutex);
-  auto &item = cacheMap.at(hash);
+  auto it = cacheMap.find(hash);
+  if (it == cacheMap.end()) {
+    ++stats.misses;
+    return nullptr;
+  }
+  ++stats.hits;
 
   // Move item.lruListIt to the end of the list to indicate that it is being
   // used right now.
-  lruList.splice(lruList.end(), lruList, item.lruListIt);
+  lruList.splice(lruList.end(), lruList, it->second.lruListIt);
+
+  return it->second.execEngine;
+}
+
+void JITExecutionCache::cache(std::size_t hash,
+                              std::shared_ptr<ExecutionEngine> jit,
+                              std::size_t sizeBytes) {
+  std::scoped_lock<std::mutex> lock(mutex);
+  // Another thread may have compiled the same module concurrently, keep the
+  // engine already cached.
+  if (cacheMap.count(hash) || sizeBytes > stats.capacityBytes)
+    return;
+
+  evictFor(sizeBytes);
+  lruList.push_back(hash);
+  cacheMap.insert(
+      {hash, {std::move(jit), sizeBytes, std::prev(lruList.end())}});
+  stats.sizeBytes += sizeBytes;
+}
+
+void JITExecutionCache::setCapacity(std::size_t capacityBytes) {
+  std::scoped_lock<std::mutex> lock(mutex);
+  stats.capacityBytes = capacityBytes;
+  evictFor(0);
+}
+
+JITExecutionCache::Statistics JITExecutionCache::getStatistics() {
+  std::scoped_lock<std::mutex> lock(mutex);
+  Statistics result = stats;
+  result.entries = cacheMap.size();
+  return result;
+}
+
+void JITExecutionCache::resetStatistics() {
+  std::scoped_lock<std::mutex> lock(mutex);
+  stats.hits = stats.misses = stats.evictions = 0;
+}
+
+void JITExecutionCache::clear() {
+  // Release the engines outside of the lock, their destruction may be slow.
+  std::unordered_map<std::size_t, MapItemType> released;
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+    released.swap(cacheMap);
+    lruList.clear();
+    stats.sizeBytes = 0;
+  }
+}
 
-  return item.execEngine;
+JITExecutionCache &getJITExecutionCache() {
+  static JITExecutionCache jitCache = [] {
+    std::size_t capacityMB = DEFAULT_JIT_CACHE_MB;
+    if (const char *env = std::getenv("CUDAQ_JIT_EXECUTION_CACHE_MB")) {
+      try {
+        capacityMB = std::stoull(env);
+      } catch (...) {
+        throw std::runtime_error(
+            "Invalid CUDAQ_JIT_EXECUTION_CACHE_MB value '" + std::string(env) +
+            "'. Expected a number of megabytes.");
+      }
+    }
+    return JITExecutionCache(capacityMB << 20);
+  }();
+  return jitCache;
 }
 } // namespace cudaq
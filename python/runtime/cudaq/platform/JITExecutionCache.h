@@ -9,6 +9,10 @@
 #pragma once
 
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -16,29 +20,71 @@ namespace cudaq {
 
 /// @brief The JITExecutionCache is a utility class for
 /// storing ExecutionEngine pointers keyed on the hash
-/// for the string representation of the original MLIR ModuleOp.
+/// for the string representation of the specialized MLIR ModuleOp.
+///
+/// The cache is bounded by an estimate of the memory used by its engines,
+/// given by the caller when an engine is inserted, rather than by a number of
+/// engines, and evicts the least recently used engines first. Engines are
+/// shared with the callers, so that an engine evicted (or cleared) while it
+/// runs on another thread stays alive until that launch completes. All
+/// members are thread safe.
 class JITExecutionCache {
+public:
+  struct Statistics {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t entries = 0;
+    /// The estimated size of the cached engines.
+    std::size_t sizeBytes = 0;
+    std::size_t capacityBytes = 0;
+  };
+
 protected:
   // Implement a Least Recently Used cache based on the JIT hash.
   std::list<std::size_t> lruList;
 
-  // A given JIT hash has an associated MapItemType, which contains pointers to
-  // the execution engine and to the LRU iterator that is used to track which
-  // engine is the least recently used.
+  // A given JIT hash has an associated MapItemType, which contains the
+  // execution engine, its estimated size, and the LRU iterator that is used to
+  // track which engine is the least recently used.
   struct MapItemType {
-    mlir::ExecutionEngine *execEngine = nullptr;
+    std::shared_ptr<mlir::ExecutionEngine> execEngine;
+    std::size_t sizeBytes = 0;
     std::list<std::size_t>::iterator lruListIt;
   };
   std::unordered_map<std::size_t, MapItemType> cacheMap;
 
+  Statistics stats;
+
   std::mutex mutex;
 
+  /// @brief Evict least recently used engines until `extraBytes` more bytes
+  /// fit in the capacity. The mutex must be held.
+  void evictFor(std::size_t extraBytes);
+
 public:
-  JITExecutionCache() = default;
-  ~JITExecutionCache();
+  explicit JITExecutionCache(std::size_t capacityBytes);
 
-  void cache(std::size_t hash, mlir::ExecutionEngine *);
-  bool hasJITEngine(std::size_t hash);
-  mlir::ExecutionEngine *getJITEngine(std::size_t hash);
+  /// @brief Return the engine cached for the given hash, or null on a miss.
+  std::shared_ptr<mlir::ExecutionEngine> lookup(std::size_t hash);
+
+  /// @brief Cache an engine of the given estimated size. Engines larger than
+  /// the capacity are not cached.
+  void cache(std::size_t hash, std::shared_ptr<mlir::ExecutionEngine> engine,
+             std::size_t sizeBytes);
+
+  /// @brief Change the capacity, evicting engines as needed.
+  void setCapacity(std::size_t capacityBytes);
+
+  Statistics getStatistics();
+  void resetStatistics();
+
+  /// @brief Release all the cached engines.
+  void clear();
 };
+
+/// @brief The process-wide cache of the engines JIT compiled for Python
+/// kernel launches. Its initial capacity is `CUDAQ_JIT_EXECUTION_CACHE_MB`
+/// megabytes, 256 by default.
+JITExecutionCache &getJITExecutionCache();
 } // namespace cudaq
@@ -12,6 +12,7 @@
 #include "common/ArgumentConversion.h"
 #include "common/ArgumentWrapper.h"
 #include "common/Environment.h"
+#include "common/PassProfiler.h"
 #include "cudaq/Optimizer/Builder/Marshal.h"
 #include "cudaq/Optimizer/Builder/Runtime.h"
 #include "cudaq/Optimizer/CAPI/Dialects.h"
@@ -47,8 +48,6 @@
 namespace py = pybind11;
 using namespace mlir;
 
-static std::unique_ptr<cudaq::JITExecutionCache> jitCache;
-
 static std::function<std::string()> getTransportLayer = []() -> std::string {
   throw std::runtime_error("binding for kernel launch is incomplete");
 };
@@ -678,11 +677,18 @@ static void appendTheResultValue(ModuleOp module, const std::string &name,
 
 // Launching the module \p mod will modify its content, such as by argument
 // synthesis into the entry-point kernel. Make a clone before we launch to
-// preserve (cache) the IR, and erase the clone after the kernel is done.
+// preserve (cache) the IR, and erase the clone after the kernel is done. If
+// \p releaseGIL, the caller holds the GIL and it is released once the clone is
+// made: the clone is private to this launch, so other Python threads may run,
+// and launch kernels of their own, while it is compiled and executed.
 static cudaq::KernelThunkResultType
 pyLaunchModule(const std::string &name, ModuleOp mod,
-               const std::vector<void *> &rawArgs, Type resultTy) {
+               const std::vector<void *> &rawArgs, Type resultTy,
+               bool releaseGIL = false) {
   auto clone = mod.clone();
+  std::optional<py::gil_scoped_release> release;
+  if (releaseGIL)
+    release.emplace();
   auto res = cudaq::streamlinedLaunchModule(name, clone, rawArgs, resultTy);
   clone.erase();
   return res;
@@ -905,6 +911,29 @@ cudaq::marshal_arguments_for_module_launch(ModuleOp mod, py::args runtimeArgs,
   return args;
 }
 
+cudaq::OpaqueArguments
+cudaq::marshal_parameters_for_module_launch(func::FuncOp kernelFunc,
+                                            const double *parameters,
+                                            std::size_t numParameters) {
+  auto argTys = kernelFunc.getFunctionType().getInputs();
+  cudaq::OpaqueArguments args;
+  if (argTys.size() == 1)
+    if (auto vecTy = dyn_cast<cc::StdvecType>(argTys[0]))
+      if (isa<Float64Type>(vecTy.getElementType())) {
+        addArgument(args, std::vector<double>(parameters,
+                                              parameters + numParameters));
+        return args;
+      }
+  if (argTys.size() != numParameters ||
+      !llvm::all_of(argTys, [](Type ty) { return isa<Float64Type>(ty); }))
+    throw std::runtime_error(
+        "broadcasting over an array of parameters requires a kernel taking a "
+        "single list[float] or one float per parameter.");
+  for (std::size_t i = 0; i < numParameters; ++i)
+    addArgument(args, double(parameters[i]));
+  return args;
+}
+
 py::object cudaq::marshal_and_launch_module(const std::string &name,
                                             MlirModule module,
                                             MlirType returnType,
@@ -914,7 +943,10 @@ py::object cudaq::marshal_and_launch_module(const std::string &name,
   auto mod = unwrap(module);
   Type retTy = unwrap(returnType);
   auto args = marshal_arguments_for_module_launch(mod, runtimeArgs, kernelFunc);
-  [[maybe_unused]] auto resultPtr = clean_launch_module(name, mod, retTy, args);
+  auto rawArgs = appendResultToArgsVector(args, retTy, mod, name);
+  Type resTy = isa<NoneType>(retTy) ? Type{} : retTy;
+  [[maybe_unused]] auto resultPtr =
+      pyLaunchModule(name, mod, rawArgs, resTy, /*releaseGIL=*/true);
   // FIXME: handle dynamic sized results!
 
   if (isa<NoneType>(retTy))
@@ -965,6 +997,8 @@ static MlirModule synthesizeKernel(py::object kernel, py::args runtimeArgs) {
       [](cudaq::OpaqueArguments &, py::object &, unsigned) { return false; });
 
   ScopedTraceWithContext(cudaq::TIMING_JIT, "synthesizeKernel", name);
+  cudaq::profiler::ScopedPhase phase(
+      cudaq::profiler::Phase::argument_synthesis, name);
   auto rawArgs = appendResultToArgsVector(args, {}, mod, name);
   auto cloned = mod.clone();
   auto context = cloned.getContext();
@@ -1022,7 +1056,13 @@ static MlirModule synthesizeKernel(py::object kernel, py::args runtimeArgs) {
   pm.addNestedPass<func::FuncOp>(cudaq::opt::createClassicalMemToReg());
   pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
   pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopNormalize());
-  pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopUnroll());
+  // Simulators do not need straight-line code, so large loops are kept.
+  cudaq::opt::LoopUnrollOptions luo;
+  if (isSimulator) {
+    luo.maxUnrolledOps = cudaq::opt::loopPreservingMaxUnrolledOps;
+    luo.unrollBudget = cudaq::opt::loopPreservingUnrollBudget;
+  }
+  pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopUnroll(luo));
   pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
   pm.addPass(createSymbolDCEPass());
 
@@ -1036,6 +1076,7 @@ static MlirModule synthesizeKernel(py::object kernel, py::args runtimeArgs) {
         }
         return mlir::failure();
       });
+  cudaq::profiler::instrumentPasses(pm);
   DefaultTimingManager tm;
   tm.setEnabled(cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES));
   auto timingScope = tm.getRootScope(); // starts the timer
@@ -1055,6 +1096,7 @@ static MlirModule synthesizeKernel(py::object kernel, py::args runtimeArgs) {
 }
 
 static void executeMLIRPassManager(ModuleOp mod, PassManager &pm) {
+  cudaq::profiler::ScopedPhase phase(cudaq::profiler::Phase::jit_passes);
   auto enablePrintMLIREachPass =
       cudaq::getEnvBool("CUDAQ_MLIR_PRINT_EACH_PASS", false);
   auto context = mod.getContext();
@@ -1073,6 +1115,7 @@ static void executeMLIRPassManager(ModuleOp mod, PassManager &pm) {
         }
         return mlir::failure();
       });
+  cudaq::profiler::instrumentPasses(pm);
   DefaultTimingManager tm;
   tm.setEnabled(cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES));
   auto timingScope = tm.getRootScope(); // starts the timer
@@ -1134,7 +1177,6 @@ static std::size_t get_launch_args_required(MlirModule module,
 
 void cudaq::bindAltLaunchKernel(py::module &mod,
                                 std::function<std::string()> &&getTL) {
-  jitCache = std::make_unique<JITExecutionCache>();
   getTransportLayer = std::move(getTL);
 
   mod.def("lower_to_codegen", lower_to_codegen,
@@ -1152,6 +1194,48 @@ void cudaq::bindAltLaunchKernel(py::module &mod,
           "by the calling code. This allows the calling code to invoke the "
           "entry point with a regular C++ call.");
 
+  py::class_<JITExecutionCache::Statistics>(
+      mod, "JITCacheStatistics",
+      "Counters of the cache of JIT compiled kernels.")
+      .def_readonly("hits", &JITExecutionCache::Statistics::hits)
+      .def_readonly("misses", &JITExecutionCache::Statistics::misses)
+      .def_readonly("evictions", &JITExecutionCache::Statistics::evictions)
+      .def_readonly("entries", &JITExecutionCache::Statistics::entries)
+      .def_readonly("size_bytes", &JITExecutionCache::Statistics::sizeBytes,
+                    "The estimated memory used by the cached kernels.")
+      .def_readonly("capacity_bytes",
+                    &JITExecutionCache::Statistics::capacityBytes)
+      .def("__repr__", [](const JITExecutionCache::Statistics &stats) {
+        return fmt::format("JITCacheStatistics(hits={}, misses={}, "
+                           "evictions={}, entries={}, size_bytes={}, "
+                           "capacity_bytes={})",
+                           stats.hits, stats.misses, stats.evictions,
+                           stats.entries, stats.sizeBytes, stats.capacityBytes);
+      });
+
+  mod.def(
+      "get_jit_cache_statistics",
+      []() { return getJITExecutionCache().getStatistics(); },
+      "Return the counters of the cache of JIT compiled kernels.");
+  mod.def(
+      "reset_jit_cache_statistics",
+      []() { getJITExecutionCache().resetStatistics(); },
+      "Reset the hit, miss and eviction counters of the cache of JIT compiled "
+      "kernels.");
+  mod.def(
+      "set_jit_cache_capacity",
+      [](std::size_t capacityBytes) {
+        getJITExecutionCache().setCapacity(capacityBytes);
+      },
+      py::arg("capacity_bytes"),
+      "Set the memory budget, in bytes, of the cache of JIT compiled kernels, "
+      "evicting the least recently used kernels as needed. A capacity of 0 "
+      "disables the cache. The initial capacity is given in megabytes by the "
+      "CUDAQ_JIT_EXECUTION_CACHE_MB environment variable, 256 by default.");
+  mod.def(
+      "clear_jit_cache", []() { getJITExecutionCache().clear(); },
+      "Release all the JIT compiled kernels held by the cache.");
+
   mod.def("pyAltLaunchAnalogKernel", pyAltLaunchAnalogKernel,
           "Launch an analog Hamiltonian simulation kernel with given JSON "
           "payload.");
@@ -44,7 +44,9 @@ void bindAltLaunchKernel(py::module &mod, std::function<std::string()> &&);
 /// the python arguments to the kernel. Pre-condition: all arguments must be
 /// resolved at this `callsite` \e prior to launching this module. In particular
 /// this means \p module is ready for beta reduction of callables. If the kernel
-/// has a result, it has type \p returnType. \p module must be modifiable.
+/// has a result, it has type \p returnType. \p module must be modifiable. The
+/// caller must hold the GIL, which is released while the kernel is compiled and
+/// executed.
 py::object marshal_and_launch_module(const std::string &kernelName,
                                      MlirModule module, MlirType returnType,
                                      py::args runtimeArgs);
@@ -59,4 +61,13 @@ OpaqueArguments
 marshal_arguments_for_module_launch(mlir::ModuleOp mod, py::args runtimeArgs,
                                     mlir::func::FuncOp kernelFunc);
 
+/// Pack the \p numParameters values at \p parameters as the arguments of
+/// \p kernelFunc, which must take either a single `list[float]` or one `float`
+/// per parameter. This is used to broadcast a kernel over the rows of an array
+/// of parameters without converting them to Python objects.
+OpaqueArguments
+marshal_parameters_for_module_launch(mlir::func::FuncOp kernelFunc,
+                                     const double *parameters,
+                                     std::size_t numParameters);
+
 } // namespace cudaq
@@ -15,7 +15,7 @@ using namespace mlir;
 // This is a helper function to help reduce duplicated code across
 // PyRemoteSimulatorQPU.
 static void launchVqeImpl(cudaq::ExecutionContext *executionContextPtr,
-                          std::unique_ptr<cudaq::RemoteRuntimeClient> &m_client,
+                          cudaq::BaseRemoteSimulatorQPU &qpu,
                           const std::string &m_simName, const std::string &name,
                           const void *kernelArgs, cudaq::gradient *gradient,
                           const cudaq::spin_op &H, cudaq::optimizer &optimizer,
@@ -34,9 +34,13 @@ static void launchVqeImpl(cudaq::ExecutionContext *executionContextPtr,
     ctx->shots = shots;
 
   std::string errorMsg;
-  const bool requestOkay = m_client->sendRequest(
-      *mlirContext, *executionContextPtr, gradient, &optimizer, n_params,
-      m_simName, name, /*kernelFunc=*/nullptr, wrapper->rawArgs, /*argSize=*/0,
+  const bool requestOkay = qpu.sendWithFailover(
+      [&](cudaq::RemoteRuntimeClient &client, std::string *errorMsg) {
+        return client.sendRequest(*mlirContext, *executionContextPtr, gradient,
+                                  &optimizer, n_params, m_simName, name,
+                                  /*kernelFunc=*/nullptr, wrapper->rawArgs,
+                                  /*argSize=*/0, errorMsg);
+      },
       &errorMsg);
   if (!requestOkay)
     throw std::runtime_error("Failed to launch VQE. Error: " + errorMsg);
@@ -46,7 +50,7 @@ static void launchVqeImpl(cudaq::ExecutionContext *executionContextPtr,
 // PyRemoteSimulatorQPU.
 static void
 launchKernelImpl(cudaq::ExecutionContext *executionContextPtr,
-                 std::unique_ptr<cudaq::RemoteRuntimeClient> &remote_client,
+                 cudaq::BaseRemoteSimulatorQPU &qpu,
                  const std::string &sim_name, const std::string &name,
                  void (*kernelFunc)(void *), void *args,
                  std::uint64_t voidStarSize, std::uint64_t resultOffset,
@@ -65,17 +69,22 @@ launchKernelImpl(cudaq::ExecutionContext *executionContextPtr,
   cudaq::ExecutionContext &executionContext =
       executionContextPtr ? *executionContextPtr : defaultContext;
   std::string errorMsg;
-  const bool requestOkay = remote_client->sendRequest(
-      *mlirContext, executionContext,
-      /*vqe_gradient=*/nullptr, /*vqe_optimizer=*/nullptr, /*vqe_n_params=*/0,
-      sim_name, name, kernelFunc, wrapper->rawArgs, voidStarSize, &errorMsg);
+  const bool requestOkay = qpu.sendWithFailover(
+      [&](cudaq::RemoteRuntimeClient &client, std::string *errorMsg) {
+        return client.sendRequest(
+            *mlirContext, executionContext,
+            /*vqe_gradient=*/nullptr, /*vqe_optimizer=*/nullptr,
+            /*vqe_n_params=*/0, sim_name, name, kernelFunc, wrapper->rawArgs,
+            voidStarSize, errorMsg);
+      },
+      &errorMsg);
   if (!requestOkay)
     throw std::runtime_error("Failed to launch kernel. Error: " + errorMsg);
 }
 
 static void launchKernelStreamlineImpl(
     cudaq::ExecutionContext *executionContextPtr,
-    std::unique_ptr<cudaq::RemoteRuntimeClient> &remote_client,
+    cudaq::BaseRemoteSimulatorQPU &qpu,
     const std::string &sim_name, const std::string &name,
     const std::vector<void *> &rawArgs) {
   if (rawArgs.empty())
@@ -99,10 +108,15 @@ static void launchKernelStreamlineImpl(
   // Remove the first argument (the MLIR ModuleOp) from the list of arguments.
   actualArgs.erase(actualArgs.begin());
 
-  const bool requestOkay = remote_client->sendRequest(
-      *mlirContext, executionContext,
-      /*vqe_gradient=*/nullptr, /*vqe_optimizer=*/nullptr, /*vqe_n_params=*/0,
-      sim_name, name, nullptr, nullptr, 0, &errorMsg, &actualArgs);
+  const bool requestOkay = qpu.sendWithFailover(
+      [&](cudaq::RemoteRuntimeClient &client, std::string *errorMsg) {
+        return client.sendRequest(
+            *mlirContext, executionContext,
+            /*vqe_gradient=*/nullptr, /*vqe_optimizer=*/nullptr,
+            /*vqe_n_params=*/0, sim_name, name, nullptr, nullptr, 0, errorMsg,
+            &actualArgs);
+      },
+      &errorMsg);
   if (!requestOkay)
     throw std::runtime_error("Failed to launch kernel. Error: " + errorMsg);
 }
@@ -123,7 +137,7 @@ public:
     CUDAQ_INFO(
         "{}: Launch VQE kernel named '{}' remote QPU {} (simulator = {})",
         Derived::class_name, name, this->qpu_id, this->m_simName);
-    ::launchVqeImpl(this->getExecutionContextForMyThread(), this->m_client,
+    ::launchVqeImpl(this->getExecutionContextForMyThread(), *this,
                     this->m_simName, name, kernelArgs, gradient, H, optimizer,
                     n_params, shots);
   }
@@ -135,7 +149,7 @@ public:
                const std::vector<void *> &rawArgs) override {
     CUDAQ_INFO("{}: Launch kernel named '{}' remote QPU {} (simulator = {})",
                Derived::class_name, name, this->qpu_id, this->m_simName);
-    ::launchKernelImpl(this->getExecutionContextForMyThread(), this->m_client,
+    ::launchKernelImpl(this->getExecutionContextForMyThread(), *this,
                        this->m_simName, name,
                        make_degenerate_kernel_type(kernelFunc), args,
                        voidStarSize, resultOffset, rawArgs);
@@ -148,9 +162,8 @@ public:
     CUDAQ_INFO("{}: Streamline launch kernel named '{}' remote QPU {} "
                "(simulator = {})",
                Derived::class_name, name, this->qpu_id, this->m_simName);
-    ::launchKernelStreamlineImpl(this->getExecutionContextForMyThread(),
-                                 this->m_client, this->m_simName, name,
-                                 rawArgs);
+    ::launchKernelStreamlineImpl(this->getExecutionContextForMyThread(), *this,
+                                 this->m_simName, name, rawArgs);
   }
 };
 
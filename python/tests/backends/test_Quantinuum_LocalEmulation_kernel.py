@@ -420,6 +420,37 @@ def test_quantinuum_state_preparation():
     assert not '111' in counts
 
 
+def test_repeated_emulation():
+    """Repeated launches reuse the cached lowering and JIT-compiled code."""
+
+    @cudaq.kernel
+    def conditional(angle: float):
+        qubits = cudaq.qvector(2)
+        ry(angle, qubits[0])
+        if mz(qubits[0]):
+            x(qubits[1])
+        mz(qubits[1])
+
+    for angle in [np.pi, 0., np.pi, 0.]:
+        counts = cudaq.sample(conditional, angle, shots_count=50)
+        # Both qubits are measured in the same state.
+        want = '1' if angle > 0. else '0'
+        assert len(counts) == 1
+        assert set(counts.most_probable()) == {want}
+
+    @cudaq.kernel
+    def bell():
+        qubits = cudaq.qvector(2)
+        h(qubits[0])
+        x.ctrl(qubits[0], qubits[1])
+        mz(qubits)
+
+    for _ in range(3):
+        counts = cudaq.sample(bell)
+        assert len(counts) == 2
+        assert counts.count('00') + counts.count('11') == 1000
+
+
 # leave for gdb debugging
 if __name__ == "__main__":
     loc = os.path.abspath(__file__)
@@ -440,6 +440,16 @@ def test_polling_interval(polling_interval_ms):
     cudaq.reset_target()
 
 
+@pytest.mark.parametrize("max_concurrent_requests", [1, 4])
+def test_max_concurrent_requests(max_concurrent_requests):
+    cudaq.set_target("braket",
+                     max_concurrent_requests=max_concurrent_requests)
+    test_qvector_kernel()
+    # Observe submits one task per term of the Hamiltonian
+    test_observe()
+    cudaq.reset_target()
+
+
 def test_exp_pauli():
 
     @cudaq.kernel
@@ -64,6 +64,36 @@ def test_stim_sample():
     assert ('1' * 250 in counts)
 
 
+def test_stim_packed_sample():
+
+    @cudaq.kernel
+    def kernel():
+        qubits = cudaq.qvector(100)
+        h(qubits[0])
+        for i in range(1, 100):
+            cx(qubits[i - 1], qubits[i])
+        mz(qubits)
+
+    counts = cudaq.sample(kernel, shots_count=1000)
+    packed = counts.get_packed_sequential_data()
+    assert packed.dtype == np.uint64
+    assert packed.shape == (1000, 2)
+    assert not packed.flags.writeable
+    allOnes = np.array([2**64 - 1, 2**36 - 1], dtype=np.uint64)
+    zeros = np.all(packed == 0, axis=1)
+    ones = np.all(packed == allOnes, axis=1)
+    assert np.all(zeros | ones)
+    assert np.count_nonzero(ones) == counts.count('1' * 100)
+
+    packedBytes = counts.get_packed_sequential_bytes()
+    assert packedBytes.dtype == np.uint8
+    assert packedBytes.shape == (1000, 16)
+    assert not packedBytes.flags.writeable
+    bits = np.unpackbits(packedBytes, axis=1, bitorder='little')[:, :100]
+    assert np.array_equal(bits, counts.get_sequential_bits())
+    assert np.array_equal(np.all(bits == 1, axis=1), ones)
+
+
 def test_stim_all_mz_types():
     # Create the kernel we'd like to execute on Stim
     @cudaq.kernel
@@ -99,6 +99,32 @@ def test_state_vector_to_cupy():
     assert np.isclose(stateInCuPy[2], 0., atol=1e-3)
 
 
+def test_state_vector_zero_copy_export():
+    cudaq.set_target('nvidia')
+    kernel = cudaq.make_kernel()
+    q = kernel.qalloc(2)
+    kernel.h(q[0])
+    kernel.cx(q[0], q[1])
+    state = cudaq.get_state(kernel)
+
+    device_ptr = state.getTensor().data()
+    from_cai = cp.asarray(state)
+    from_dlpack = cp.from_dlpack(state)
+    assert state.__dlpack_device__()[0] == 2
+    # Both views alias the state data.
+    for array in [from_cai, from_dlpack]:
+        assert array.data.ptr == device_ptr
+        assert array.shape == (4,)
+        assert np.isclose(array[0], 1. / np.sqrt(2.), atol=1e-3)
+        assert np.isclose(array[3], 1. / np.sqrt(2.), atol=1e-3)
+
+    # The views keep the state data alive.
+    del state
+    assert np.isclose(from_cai[0], 1. / np.sqrt(2.), atol=1e-3)
+    assert np.isclose(from_dlpack[3], 1. / np.sqrt(2.), atol=1e-3)
+    cudaq.reset_target()
+
+
 def test_cupy_to_state():
     cudaq.set_target('nvidia')
     cp_data = cp.array([.707107, 0, 0, .707107], dtype=cp.complex64)
@@ -594,6 +594,31 @@ def test_issue_1218():
     assert "1111" in counts
 
 
+def test_sample_result_arrays():
+    kernel = cudaq.make_kernel()
+    qubits = kernel.qalloc(4)
+    kernel.x(qubits[0])
+    kernel.h(qubits[2])
+    kernel.x(qubits[3])
+    kernel.mz(qubits)
+
+    shots_count = 1000
+    result = cudaq.sample(kernel, shots_count=shots_count)
+    bits = result.get_sequential_bits()
+    assert bits.dtype == np.uint8
+    assert bits.shape == (shots_count, 4)
+    assert [
+        ''.join(str(b) for b in row) for row in bits
+    ] == result.get_sequential_data()
+
+    # Bit `i` of an outcome is qubit `i`.
+    outcomes, counts = result.get_histogram()
+    assert outcomes.dtype == np.uint64 and counts.dtype == np.uint64
+    assert list(outcomes) == [0b1001, 0b1101]
+    assert list(counts) == [result['1001'], result['1101']]
+    assert counts.sum() == shots_count
+
+
 # leave for gdb debugging
 if __name__ == "__main__":
     loc = os.path.abspath(__file__)
@@ -238,6 +238,26 @@ def test_state_vector_async():
         result = cudaq.get_state_async(kernel, 0.0, 0.0, qpu_id=12)
 
 
+def test_state_overlap_matrix():
+    """Tests `cudaq.overlap_matrix` against the pairwise overlaps."""
+    kernel, theta = cudaq.make_kernel(float)
+    qubits = kernel.qalloc(3)
+    kernel.ry(theta, qubits[0])
+    kernel.cx(qubits[0], qubits[1])
+    kernel.rx(theta, qubits[2])
+
+    bras = [cudaq.get_state(kernel, angle) for angle in [0.1, 0.7, 1.3]]
+    kets = [cudaq.get_state(kernel, angle) for angle in [0.2, 1.9]]
+    overlaps = cudaq.overlap_matrix(bras, kets)
+    assert overlaps.shape == (3, 2)
+    for i, bra in enumerate(bras):
+        for j, ket in enumerate(kets):
+            assert np.isclose(overlaps[i, j], bra.overlap(ket), atol=1e-6)
+
+    # The diagonal of the overlaps of the states with themselves is one.
+    assert np.allclose(np.diag(cudaq.overlap_matrix(bras, bras)), 1.0)
+
+
 # leave for gdb debugging
 if __name__ == "__main__":
     loc = os.path.abspath(__file__)
@@ -83,6 +83,33 @@ def test_density_matrix_indexing():
     TestDensityMatrixIndexing().run_tests(CUDATorchDiffEqRK4Integrator)
 
 
+def test_time_stepper_dlpack():
+    from cudaq.dynamics import nvqir_dynamics_bindings as bindings
+    from cudaq.dynamics.integrators.builtin_integrators import cuDensityMatTimeStepper
+    from cudaq.operators import MatrixOperator, boson, spin
+    dimensions = {0: 2, 1: 3}
+    hamiltonian = spin.x(0) * boson.number(1) + 0.5 * boson.annihilate(1)
+    stepper = cuDensityMatTimeStepper(bindings.Schedule([0.0], []),
+                                      MatrixOperator(hamiltonian), [],
+                                      [2, 3], False)
+    generator = torch.Generator().manual_seed(13)
+    vector = torch.randn(6, dtype=torch.complex128,
+                         generator=generator).cuda()
+    expected = -1j * torch.from_numpy(
+        hamiltonian.to_matrix(dimensions)).cuda() @ vector
+    result = torch.zeros_like(vector)
+    # The action is accumulated into the output, and reused for the second
+    # call.
+    for _ in range(2):
+        stepper.compute_dlpack(vector, 0.0, result, [2, 3])
+    torch.cuda.synchronize()
+    torch.testing.assert_close(result, 2 * expected)
+    with pytest.raises(ValueError):
+        stepper.compute_dlpack(vector.cpu(), 0.0, result, [2, 3])
+    with pytest.raises(ValueError):
+        stepper.compute_dlpack(vector, 0.0, result.real.contiguous(), [2, 3])
+
+
 # leave for gdb debugging
 if __name__ == "__main__":
     loc = os.path.abspath(__file__)
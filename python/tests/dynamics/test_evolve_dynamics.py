@@ -24,7 +24,9 @@ def do_something():
     cudaq.reset_target()
 
 
-all_integrator_classes = [RungeKuttaIntegrator, ScipyZvodeIntegrator]
+all_integrator_classes = [
+    RungeKuttaIntegrator, DormandPrinceIntegrator, ScipyZvodeIntegrator
+]
 all_models = [
     TestCavityModel, TestCavityModelTimeDependentHam,
     TestCavityModelTimeDependentCollapseOp, TestCompositeSystems,
@@ -81,6 +83,59 @@ def test_euler_integrator():
     np.testing.assert_allclose(expected_answer, expt, 1e-3)
 
 
+def test_krylov_integrator():
+    """
+    Test the Krylov exponential integrator on a time-independent system
+    """
+    N = 10
+    steps = np.linspace(0, 10, 101)
+    schedule = Schedule(steps, ["t"])
+    hamiltonian = operators.number(0)
+    dimensions = {0: N}
+    # initial state
+    psi0_ = cp.zeros(N, dtype=cp.complex128)
+    psi0_[-1] = 1.0
+    psi0 = cudaq.State.from_data(psi0_)
+    decay_rate = 0.1
+    evolution_result = cudaq.evolve(
+        hamiltonian,
+        dimensions,
+        schedule,
+        psi0,
+        observables=[hamiltonian],
+        collapse_operators=[np.sqrt(decay_rate) * boson.annihilate(0)],
+        store_intermediate_results=cudaq.IntermediateResultSave.
+        EXPECTATION_VALUE,
+        integrator=KrylovIntegrator())
+
+    expt = []
+    for exp_vals in evolution_result.expectation_values():
+        expt.append(exp_vals[0].expectation())
+    expected_answer = (N - 1) * np.exp(-decay_rate * steps)
+    np.testing.assert_allclose(expected_answer, expt, 1e-6)
+
+
+def test_krylov_integrator_time_dependent():
+    """
+    Test that the Krylov integrator rejects time-dependent systems
+    """
+    N = 10
+    steps = np.linspace(0, 1, 11)
+    schedule = Schedule(steps, ["t"])
+    hamiltonian = ScalarOperator(lambda t: np.cos(t)) * operators.number(0)
+    dimensions = {0: N}
+    psi0_ = cp.zeros(N, dtype=cp.complex128)
+    psi0_[-1] = 1.0
+    psi0 = cudaq.State.from_data(psi0_)
+    with pytest.raises(ValueError, match="time-independent"):
+        cudaq.evolve(hamiltonian,
+                     dimensions,
+                     schedule,
+                     psi0,
+                     observables=[operators.number(0)],
+                     integrator=KrylovIntegrator())
+
+
 def test_save_all_intermediate_states():
     """
     Test save all option for intermediate states
@@ -154,6 +209,124 @@ def test_batching_bugs():
         assert len(evolution_result.intermediate_states()) == len(steps)
 
 
+def test_batched_hamiltonian_state_product():
+    """
+    Test that every Hamiltonian evolves every initial state when their numbers differ
+    """
+    steps = np.linspace(0, 1, 10)
+    schedule = Schedule(steps, ["t"])
+    dimensions = {0: 2}
+    frequencies = [0.1, 0.2]
+    hamiltonians = [2.0 * np.pi * f * spin.x(0) for f in frequencies]
+    signs = [1.0, -1.0, 1.0]
+    initial_states = [
+        cudaq.State.from_data(
+            cp.array([1.0, 0.0] if sign > 0 else [0.0, 1.0],
+                     dtype=cp.complex128)) for sign in signs
+    ]
+    evolution_results = cudaq.evolve(
+        hamiltonians,
+        dimensions,
+        schedule,
+        initial_states,
+        observables=[spin.z(0)],
+        store_intermediate_results=cudaq.IntermediateResultSave.
+        EXPECTATION_VALUE,
+        integrator=RungeKuttaIntegrator(max_step_size=0.01))
+    assert len(evolution_results) == len(frequencies) * len(signs)
+    for i, f in enumerate(frequencies):
+        for j, sign in enumerate(signs):
+            result = evolution_results[i * len(signs) + j]
+            expt = [
+                exp_vals[0].expectation()
+                for exp_vals in result.expectation_values()
+            ]
+            expected_answer = sign * np.cos(2 * 2.0 * np.pi * f * steps)
+            np.testing.assert_allclose(expected_answer, expt, atol=1e-3)
+
+
+def test_evolve_sink():
+    """
+    Test that the results of every step are streamed to the sink
+    """
+    steps = np.linspace(0, 1, 10)
+    schedule = Schedule(steps, ["t"])
+    hamiltonian = 2.0 * np.pi * 0.1 * spin.x(0)
+    psi0 = cudaq.State.from_data(cp.array([1.0, 0.0], dtype=cp.complex128))
+    streamed = []
+    evolution_result = cudaq.evolve(
+        hamiltonian, {0: 2},
+        schedule,
+        psi0,
+        observables=[spin.z(0)],
+        store_intermediate_results=cudaq.IntermediateResultSave.NONE,
+        integrator=RungeKuttaIntegrator(max_step_size=0.001),
+        sink=streamed.append)
+    assert len(evolution_result.expectation_values()) == 1
+    assert [step.step_index for step in streamed] == list(range(len(steps)))
+    expected_answer = np.cos(2 * 2.0 * np.pi * 0.1 * steps)
+    np.testing.assert_allclose(
+        expected_answer, [step.expectation_values[0] for step in streamed],
+        atol=1e-3)
+    for step in streamed:
+        assert step.batch_index == 0
+        data = np.array(step.state)
+        np.testing.assert_allclose(
+            abs(data[0])**2 - abs(data[1])**2,
+            step.expectation_values[0],
+            atol=1e-9)
+
+    # Only keep the last steps of each evolution of a batch.
+    last_steps = cudaq.RingBufferSink(3)
+    cudaq.evolve([hamiltonian, 2.0 * hamiltonian], {0: 2},
+                 schedule,
+                 psi0,
+                 observables=[spin.z(0)],
+                 integrator=RungeKuttaIntegrator(max_step_size=0.001),
+                 sink=last_steps)
+    for batch_index in range(2):
+        kept = last_steps.get_results(batch_index)
+        assert [step.step_index for step in kept] == [7, 8, 9]
+
+
+def test_quantum_trajectories():
+    """
+    Test the quantum trajectory unravelling of a decaying cavity
+    """
+    cudaq.set_random_seed(13)
+    N = 10
+    steps = np.linspace(0, 10, 101)
+    schedule = Schedule(steps, ["t"])
+    hamiltonian = operators.number(0)
+    dimensions = {0: N}
+    psi0_ = cp.zeros(N, dtype=cp.complex128)
+    psi0_[-1] = 1.0
+    psi0 = cudaq.State.from_data(psi0_)
+    decay_rate = 0.1
+    num_trajectories = 2000
+    evolution_result = cudaq.evolve(
+        hamiltonian,
+        dimensions,
+        schedule,
+        psi0,
+        observables=[hamiltonian],
+        collapse_operators=[np.sqrt(decay_rate) * boson.annihilate(0)],
+        store_intermediate_results=cudaq.IntermediateResultSave.
+        EXPECTATION_VALUE,
+        integrator=RungeKuttaIntegrator(),
+        shots_count=num_trajectories)
+
+    expt = []
+    for exp_vals in evolution_result.expectation_values():
+        expt.append(exp_vals[0].expectation())
+    # The final state is the normalized batch of trajectories.
+    assert evolution_result.final_state().getTensor().get_num_elements(
+    ) == N * num_trajectories
+    # The photon number of a single trajectory is binomially distributed.
+    expected_answer = (N - 1) * np.exp(-decay_rate * steps)
+    np.testing.assert_allclose(expected_answer, expt, atol=0.2)
+
+
 def test_precision_info():
     """
     Test that the target info is correct: double precision for dynamics
@@ -0,0 +1,64 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+import os, pytest
+import numpy as np
+import cudaq
+from cudaq import boson, spin
+
+if cudaq.num_available_gpus() == 0:
+    pytest.skip("Skipping GPU tests", allow_module_level=True)
+
+cp = pytest.importorskip("cupy")
+
+
+@pytest.fixture(autouse=True)
+def do_something():
+    cudaq.set_target("dynamics")
+    yield
+    cudaq.reset_target()
+
+
+def random_vectors(shape):
+    rng = np.random.default_rng(13)
+    return rng.normal(size=shape) + 1j * rng.normal(size=shape)
+
+
+def test_single_vector():
+    dimensions = {0: 2, 1: 3}
+    operator = spin.x(0) * boson.number(1) + 0.5 * boson.annihilate(1)
+    vector = random_vectors(6)
+    expected = operator.to_matrix(dimensions) @ vector
+    result = cudaq.apply_operator(operator, vector, dimensions)
+    assert isinstance(result, np.ndarray)
+    np.testing.assert_allclose(result, expected, atol=1e-12)
+
+
+def test_batched_vectors_on_device():
+    dimensions = {0: 2, 1: 2, 2: 2}
+    operator = spin.z(0) * spin.z(1) + spin.x(2) + 2.0 * spin.y(1)
+    vectors = random_vectors((5, 8))
+    matrix = operator.to_matrix(dimensions)
+    action = cudaq.OperatorAction(operator, dimensions)
+    # The action is applied several times with the same shape and workspace.
+    for _ in range(2):
+        result = action(cp.asarray(vectors))
+        assert isinstance(result, cp.ndarray)
+        np.testing.assert_allclose(cp.asnumpy(result), vectors @ matrix.T,
+                                   atol=1e-12)
+
+
+def test_invalid_dimension():
+    action = cudaq.OperatorAction(spin.x(0), {0: 2})
+    with pytest.raises(ValueError):
+        action(np.ones(4, dtype=np.complex128))
+
+
+# leave for gdb debugging
+if __name__ == "__main__":
+    loc = os.path.abspath(__file__)
+    pytest.main([loc, "-rP"])
@@ -0,0 +1,70 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+import asyncio
+import os
+
+import numpy as np
+import pytest
+
+import cudaq
+from cudaq import spin
+
+
+@cudaq.kernel
+def ansatz(theta: float):
+    q = cudaq.qvector(2)
+    x(q[0])
+    ry(theta, q[1])
+    x.ctrl(q[1], q[0])
+
+
+@cudaq.kernel
+def bell() -> int:
+    q = cudaq.qvector(2)
+    h(q[0])
+    x.ctrl(q[0], q[1])
+    return mz(q[0]) + mz(q[1])
+
+
+hamiltonian = 5.907 - 2.1433 * spin.x(0) * spin.x(1) - 2.1433 * spin.y(
+    0) * spin.y(1) + .21829 * spin.z(0) - 6.125 * spin.z(1)
+
+
+def test_await_results():
+
+    async def main():
+        angles = np.linspace(-np.pi, np.pi, 8)
+        energies = await asyncio.gather(
+            *[cudaq.observe_async(ansatz, hamiltonian, t) for t in angles])
+        counts = await cudaq.sample_async(ansatz, 0.59, shots_count=100)
+        state = await cudaq.get_state_async(ansatz, 0.59)
+        results = await cudaq.run_async(bell, shots_count=10)
+        return angles, energies, counts, state, results
+
+    angles, energies, counts, state, results = asyncio.run(main())
+    for theta, energy in zip(angles, energies):
+        assert np.isclose(energy.expectation(),
+                          cudaq.observe(ansatz, hamiltonian,
+                                        theta).expectation())
+    assert sum(counts.values()) == 100
+    assert np.allclose(np.array(state),
+                       np.array(cudaq.get_state(ansatz, 0.59)))
+    assert len(results) == 10 and all(r in (0, 2) for r in results)
+
+
+def test_is_ready():
+    future = cudaq.sample_async(ansatz, 0.59)
+    while not future.is_ready():
+        pass
+    assert sum(future.get().values()) == 1000
+
+
+# leave for gdb debugging
+if __name__ == "__main__":
+    loc = os.path.abspath(__file__)
+    pytest.main([loc, "-rP"])
@@ -0,0 +1,75 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+import os
+
+import pytest
+
+import cudaq
+
+
+@pytest.fixture(autouse=True)
+def do_something():
+    cudaq.clear_jit_cache()
+    cudaq.reset_jit_cache_statistics()
+    capacity = cudaq.get_jit_cache_statistics().capacity_bytes
+    yield
+    cudaq.set_jit_cache_capacity(capacity)
+    cudaq.clear_jit_cache()
+
+
+@cudaq.kernel
+def rotate(theta: float):
+    q = cudaq.qubit()
+    ry(theta, q)
+    mz(q)
+
+
+def test_jit_cache_hits():
+    cudaq.sample(rotate, 0.5)
+    stats = cudaq.get_jit_cache_statistics()
+    assert stats.hits == 0
+    assert stats.misses == 1
+    assert stats.entries == 1
+    assert 0 < stats.size_bytes <= stats.capacity_bytes
+
+    # The same arguments reuse the engine, other arguments compile another one.
+    cudaq.sample(rotate, 0.5)
+    cudaq.sample(rotate, 1.5)
+    stats = cudaq.get_jit_cache_statistics()
+    assert stats.hits == 1
+    assert stats.misses == 2
+    assert stats.entries == 2
+
+
+def test_jit_cache_capacity():
+    for i in range(4):
+        cudaq.sample(rotate, 0.1 * i)
+    stats = cudaq.get_jit_cache_statistics()
+    assert stats.entries == 4
+
+    # Shrinking the budget evicts the least recently used engines.
+    cudaq.sample(rotate, 0.0)
+    cudaq.set_jit_cache_capacity(stats.size_bytes // 2)
+    stats = cudaq.get_jit_cache_statistics()
+    assert stats.evictions >= 2
+    assert stats.size_bytes <= stats.capacity_bytes
+    cudaq.sample(rotate, 0.0)
+    assert cudaq.get_jit_cache_statistics().hits == 2
+
+    # A capacity of 0 disables the cache.
+    cudaq.set_jit_cache_capacity(0)
+    stats = cudaq.get_jit_cache_statistics()
+    assert stats.entries == 0
+    cudaq.sample(rotate, 0.0)
+    assert cudaq.get_jit_cache_statistics().entries == 0
+
+
+# leave for gdb debugging
+if __name__ == "__main__":
+    loc = os.path.abspath(__file__)
+    pytest.main([loc, "-rP"])
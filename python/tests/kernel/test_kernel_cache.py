@@ -0,0 +1,66 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+import os
+
+import numpy as np
+import pytest
+
+import cudaq
+
+angles = [0.25, 1.5]
+
+
+def bell(theta: float):
+    q = cudaq.qvector(2)
+    ry(theta, q[0])
+    x.ctrl(q[0], q[1])
+    rz(angles[1], q[1])
+    mz(q)
+
+
+def test_kernel_cache(tmp_path, monkeypatch):
+    monkeypatch.setenv('CUDAQ_PYTHON_KERNEL_CACHE_DIR', str(tmp_path))
+    compiled = cudaq.kernel(bell)
+    assert len(os.listdir(tmp_path)) == 1
+
+    # Another definition of the same kernel, e.g., in a new session, loads the
+    # module from the cache once it is needed.
+    cached = cudaq.kernel(bell)
+    assert cached._cachedKernel is not None
+    assert cached.uniqName != compiled.uniqName
+    assert str(cached) == str(compiled).replace(compiled.uniqName,
+                                                cached.uniqName)
+    assert cached._cachedKernel is None
+    assert np.allclose(np.array(cudaq.get_state(cached, 0.7)),
+                       np.array(cudaq.get_state(compiled, 0.7)))
+
+    # Captured values are lifted to arguments, hence not part of the key.
+    global angles
+    saved = angles
+    angles = [0.5, 3.0]
+    try:
+        recompiled = cudaq.kernel(bell)
+        assert recompiled._cachedKernel is not None
+        assert np.allclose(np.array(cudaq.get_state(recompiled, 0.7)),
+                           np.array(cudaq.get_state(compiled, 0.7)))
+    finally:
+        angles = saved
+    assert len(os.listdir(tmp_path)) == 1
+
+
+def test_kernel_cache_disabled(tmp_path, monkeypatch):
+    monkeypatch.delenv('CUDAQ_PYTHON_KERNEL_CACHE_DIR', raising=False)
+    kernel = cudaq.kernel(bell)
+    assert kernel._cachedKernel is None
+    assert not os.listdir(tmp_path)
+
+
+# leave for gdb debugging
+if __name__ == "__main__":
+    loc = os.path.abspath(__file__)
+    pytest.main([loc, "-rP"])
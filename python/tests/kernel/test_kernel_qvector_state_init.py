@@ -452,3 +452,36 @@ def test_invalid_arg_error_msg():
 
         counts = cudaq.sample(kernel, c)
     assert 'Invalid runtime argument type.' in repr(e)
+
+
+# sparse
+
+
+def test_kernel_sparse_state():
+    cudaq.reset_target()
+
+    amplitudes = {0: 1. / np.sqrt(2.), 0b1011: 1j / np.sqrt(2.)}
+    state = cudaq.State.from_sparse_data(4, amplitudes)
+    dense = np.zeros(16, dtype=np.complex128)
+    for index, amplitude in amplitudes.items():
+        dense[index] = amplitude
+    assert state.num_qubits() == 4
+    assert np.allclose(np.array(state), dense)
+    assert np.isclose(state.overlap(cudaq.State.from_data(dense)), 1.)
+
+    @cudaq.kernel
+    def kernel(vec: cudaq.State):
+        q = cudaq.qvector(vec)
+
+    counts = cudaq.sample(kernel, state)
+    assert '0000' in counts
+    assert '1101' in counts
+    assert len(counts) == 2
+
+
+def test_kernel_sparse_state_invalid():
+    cudaq.reset_target()
+
+    with pytest.raises(RuntimeError) as e:
+        cudaq.State.from_sparse_data(2, {4: 1.})
+    assert 'out of range' in repr(e)
@@ -0,0 +1,67 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+import os
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+
+import cudaq
+from cudaq import spin
+
+
+@cudaq.kernel
+def ansatz(theta: float):
+    q = cudaq.qvector(2)
+    x(q[0])
+    ry(theta, q[1])
+    x.ctrl(q[1], q[0])
+
+
+@cudaq.kernel
+def bell(theta: float):
+    q = cudaq.qvector(2)
+    ry(theta, q[0])
+    x.ctrl(q[0], q[1])
+
+
+hamiltonian = 5.907 - 2.1433 * spin.x(0) * spin.x(1) - 2.1433 * spin.y(
+    0) * spin.y(1) + .21829 * spin.z(0) - 6.125 * spin.z(1)
+
+
+def test_observe_threads():
+    angles = np.linspace(-np.pi, np.pi, 16)
+
+    def energy(theta):
+        return cudaq.observe(ansatz, hamiltonian, theta).expectation()
+
+    expected = [energy(t) for t in angles]
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        energies = list(pool.map(energy, angles))
+    assert np.allclose(energies, expected)
+
+
+def test_sample_and_state_threads():
+
+    def work(theta):
+        counts = cudaq.sample(bell, theta, shots_count=100)
+        state = np.array(cudaq.get_state(bell, theta))
+        return sum(counts.values()), state
+
+    angles = [0.0, np.pi / 2, np.pi, 0.0, np.pi / 2, np.pi]
+    with ThreadPoolExecutor(max_workers=3) as pool:
+        results = list(pool.map(work, angles))
+    for theta, (shots, state) in zip(angles, results):
+        assert shots == 100
+        assert np.isclose(abs(state[0])**2, np.cos(theta / 2)**2)
+
+
+# leave for gdb debugging
+if __name__ == "__main__":
+    loc = os.path.abspath(__file__)
+    pytest.main([loc, "-rP"])
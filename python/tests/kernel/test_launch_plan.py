@@ -0,0 +1,88 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+import os
+
+import numpy as np
+import pytest
+
+import cudaq
+from cudaq import spin
+from cudaq.kernel.kernel_decorator import cudaq_runtime, launch_signature
+
+
+@pytest.fixture(autouse=True)
+def do_something():
+    yield
+    cudaq.__clearKernelRegistries()
+
+
+def test_launch_signature():
+    assert launch_signature(1) == int
+    assert launch_signature(True) == bool
+    assert launch_signature(np.float32(1.0)) == np.float32
+    assert launch_signature([1.0, 2]) == (list, float)
+    assert launch_signature([[1], []]) == (list, (list, int))
+    assert launch_signature([]) == (list,)
+    assert launch_signature(np.zeros(3)) == (np.ndarray, np.float64)
+    assert launch_signature(np.zeros((2, 2))) is None
+    assert launch_signature("XY") is None
+    assert launch_signature(["XY"]) is None
+
+
+def test_launch_plan_reuse(monkeypatch):
+
+    @cudaq.kernel
+    def kernel(theta: float, angles: list[float]) -> int:
+        q = cudaq.qvector(2)
+        ry(theta, q[0])
+        for a in angles:
+            rz(a, q[1])
+        x.ctrl(q[0], q[1])
+        return len(angles)
+
+    assert kernel(0.5, [0.1, 0.2]) == 2
+    assert len(kernel._launchPlans) == 1
+
+    # Calls with arguments of the same types launch the module of the
+    # decorator without copying it.
+    def no_clone(module):
+        raise AssertionError("module cloned on the launch path")
+
+    monkeypatch.setattr(cudaq_runtime, 'cloneModule', no_clone)
+    assert kernel(1.5, [0.3, 0.4, 0.5]) == 3
+    assert kernel(1, np.array([0.1])) == 1
+    assert len(kernel._launchPlans) == 2
+    monkeypatch.undo()
+
+    # Invalid arguments are still diagnosed, and do not get a plan.
+    with pytest.raises(RuntimeError) as e:
+        kernel(0.5, [1j])
+    assert 'Invalid runtime argument type' in repr(e)
+    assert len(kernel._launchPlans) == 2
+
+
+def test_launch_plan_results():
+
+    @cudaq.kernel
+    def kernel(n: int, angles: list[float]):
+        q = cudaq.qvector(n)
+        for i, a in enumerate(angles):
+            ry(a, q[i])
+
+    counts = cudaq.sample(kernel, 2, [np.pi, 0.0])
+    assert counts.most_probable() == '10'
+    energy = cudaq.observe(kernel, spin.z(1), 2, [0, np.pi]).expectation()
+    assert np.isclose(energy, -1.0)
+    counts = cudaq.sample(kernel, 2, np.array([np.pi, np.pi]))
+    assert counts.most_probable() == '11'
+
+
+# leave for gdb debugging
+if __name__ == "__main__":
+    loc = os.path.abspath(__file__)
+    pytest.main([loc, "-rP"])
@@ -206,6 +206,52 @@ def test_broadcast_py39Plus():
     assert len(energies) == 50
 
 
+def test_broadcast_parameter_array():
+    """Test that broadcasting over NumPy arrays, which runs in C++, matches
+    broadcasting over lists."""
+
+    @cudaq.kernel
+    def thetas_kernel(thetas: list[float]):
+        q = cudaq.qvector(2)
+        x(q[0])
+        ry(thetas[0], q[1])
+        rx(thetas[1], q[0])
+        x.ctrl(q[1], q[0])
+
+    @cudaq.kernel
+    def angles_kernel(theta: float, phi: float):
+        q = cudaq.qvector(2)
+        x(q[0])
+        ry(theta, q[1])
+        rx(phi, q[0])
+        x.ctrl(q[1], q[0])
+
+    hamiltonian = 5.907 - 2.1433 * spin.x(0) * spin.x(1) - 2.1433 * spin.y(
+        0) * spin.y(1) + .21829 * spin.z(0) - 6.125 * spin.z(1)
+    angles = np.random.uniform(low=-np.pi, high=np.pi, size=(20, 2))
+    expected = [
+        r.expectation() for r in cudaq.observe(angles_kernel, hamiltonian,
+                                               angles[:, 0].tolist(),
+                                               angles[:, 1].tolist())
+    ]
+
+    results = cudaq.observe(thetas_kernel, hamiltonian, angles)
+    assert np.allclose([r.expectation() for r in results], expected)
+    results = cudaq.observe(angles_kernel, hamiltonian, angles[:, 0],
+                            angles[:, 1])
+    assert np.allclose([r.expectation() for r in results], expected)
+
+    # Per-term results are available for lists of operators.
+    terms = [spin.z(0), spin.z(1)]
+    results = cudaq.observe(thetas_kernel, terms, angles)
+    assert len(results) == 20 and len(results[0]) == 2
+    for row, termResults in zip(angles, results):
+        single = cudaq.observe(thetas_kernel, spin.z(1), row.tolist())
+        assert np.isclose(termResults[1].expectation(), single.expectation())
+
+    assert cudaq.observe(thetas_kernel, hamiltonian, np.zeros((0, 2))) == []
+
+
 def test_observe_list():
     """Test that we can observe a list of spin_ops."""
     hamiltonianList = [
@@ -0,0 +1,105 @@
+# ============================================================================ #
+# Copyright (c) 2026 NVIDIA Corporation & Affiliates.                          #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+import json
+import os
+
+import pytest
+
+import cudaq
+
+
+@pytest.fixture(autouse=True)
+def do_something():
+    # Launches reusing a cached engine skip argument synthesis.
+    cudaq.clear_jit_cache()
+    cudaq.profiler.clear()
+    cudaq.profiler.enable()
+    yield
+    cudaq.profiler.disable()
+    cudaq.profiler.clear()
+
+
+@cudaq.kernel
+def bell(theta: float):
+    q = cudaq.qvector(2)
+    ry(theta, q[0])
+    x.ctrl(q[0], q[1])
+    mz(q)
+
+
+def test_profiler_phases():
+    cudaq.sample(bell, 0.5)
+    events = cudaq.profiler.get_events()
+    phases = {event.phase for event in events}
+    assert cudaq.profiler.Phase.launch in phases
+    assert cudaq.profiler.Phase.argument_synthesis in phases
+    assert cudaq.profiler.Phase.sample_conversion in phases
+
+    flushes = [
+        event for event in events
+        if event.phase == cudaq.profiler.Phase.simulator_flush
+    ]
+    assert sum(event.counters.get("gates", 0) for event in flushes) >= 2
+    for event in events:
+        assert event.duration_ns >= 0
+
+    # Phases nest within the launch of the kernel.
+    launch = next(event for event in events
+                  if event.phase == cudaq.profiler.Phase.launch)
+    assert launch.name == "bell"
+    assert launch.counters.get("bytes_allocated", 0) > 0
+
+
+def test_profiler_disabled():
+    cudaq.profiler.disable()
+    assert not cudaq.profiler.is_enabled()
+    cudaq.sample(bell, 0.5)
+    assert len(cudaq.profiler.get_events()) == 0
+
+
+def test_profiler_jit_passes():
+    cudaq.profiler.enable(passes=True)
+    cudaq.sample(bell, 0.5)
+    passes = [
+        event for event in cudaq.profiler.get_events()
+        if event.phase == cudaq.profiler.Phase.jit_pass
+    ]
+    assert len(passes) > 0
+    for event in passes:
+        assert event.name
+        assert event.counters["ops_before"] > 0
+        assert "ops_after" in event.counters
+    assert any(event.name.startswith("canonicalize") for event in passes)
+
+    # Passes are not recorded by default.
+    cudaq.clear_jit_cache()
+    cudaq.profiler.clear()
+    cudaq.profiler.enable()
+    cudaq.sample(bell, 0.5)
+    assert not any(event.phase == cudaq.profiler.Phase.jit_pass
+                   for event in cudaq.profiler.get_events())
+
+
+def test_profiler_chrome_trace(tmp_path):
+    cudaq.sample(bell, 0.5)
+    trace = json.loads(cudaq.profiler.to_chrome_trace())
+    assert len(trace["traceEvents"]) == len(cudaq.profiler.get_events())
+    for event in trace["traceEvents"]:
+        assert event["ph"] == "X"
+        assert "ts" in event and "dur" in event
+
+    path = os.path.join(tmp_path, "trace.json")
+    cudaq.profiler.write_chrome_trace(path)
+    with open(path) as f:
+        assert json.load(f)["traceEvents"]
+
+
+# leave for gdb debugging
+if __name__ == "__main__":
+    loc = os.path.abspath(__file__)
+    pytest.main([loc, "-rP"])
@@ -170,6 +170,22 @@ def test_broadcastPy39Plus():
         assert len(c) == 2
 
 
+def test_broadcast_parameter_array():
+
+    @cudaq.kernel
+    def circuit(theta: float, phi: float):
+        q = cudaq.qvector(2)
+        ry(theta, q[0])
+        ry(phi, q[1])
+        mz(q)
+
+    thetas = np.array([0, np.pi, np.pi])
+    phis = np.array([np.pi, 0, np.pi])
+    allCounts = cudaq.sample(circuit, thetas, phis, shots_count=100)
+    assert [c.most_probable() for c in allCounts] == ['01', '10', '11']
+    assert all(c.get_total_shots() == 100 for c in allCounts)
+
+
 def test_sample_async():
 
     @cudaq.kernel()
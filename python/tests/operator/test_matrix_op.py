@@ -281,6 +281,58 @@ def test_trimming():
             assert term.evaluate_coefficient() == term.degrees[0] + 1.
 
 
+def test_sparse_matrix():
+    dims = {0: 3, 1: 2, 2: 4}
+    params = {"displacement": 0.3 + 0.1j}
+    hamiltonian = number(0) * momentum(2) - 0.5 * displace(
+        1) + position(0) * parity(1)
+    for invert_order in [False, True]:
+        mat = hamiltonian.to_matrix(dims, params, invert_order)
+        data, rows, cols = hamiltonian.to_sparse_matrix(dims, params,
+                                                        invert_order)
+        sparse = np.zeros(mat.shape, dtype=complex)
+        for i, value in enumerate(data):
+            sparse[rows[i], cols[i]] += value
+        assert np.allclose(mat, sparse)
+        for term in hamiltonian:
+            term_dims = [dims[d] for d in term.degrees]
+            data, rows, cols = term.to_sparse_matrix(
+                dims, invert_order, displacement=0.3 + 0.1j)
+            sparse = np.zeros((np.prod(term_dims), np.prod(term_dims)),
+                              dtype=complex)
+            for i, value in enumerate(data):
+                sparse[rows[i], cols[i]] += value
+            assert np.allclose(
+                term.to_matrix(dims, params, invert_order), sparse)
+
+def test_super_op_sparse_matrix():
+    dims = {0: 3, 1: 2}
+    hamiltonian = number(0) * position(1) + 0.5 * momentum(0) * identity(1)
+    collapse_op = position(0) * number(1) + 0.1 * momentum(0) * parity(1)
+    rho = np.arange(36, dtype=complex).reshape(6, 6) * (1 + 0.5j)
+
+    def apply(sparse):
+        data, rows, cols = sparse
+        result = np.zeros(36, dtype=complex)
+        for i, value in enumerate(data):
+            result[rows[i]] += value * rho.ravel()[cols[i]]
+        return result.reshape(6, 6)
+
+    H = hamiltonian.to_matrix(dims)
+    L = collapse_op.to_matrix(dims)
+    super_op = SuperOperator.left_multiply(hamiltonian)
+    super_op += SuperOperator.right_multiply(collapse_op)
+    assert np.allclose(apply(super_op.to_sparse_matrix(dims)),
+                       H @ rho + rho @ L)
+
+    L_dag_L = L.conj().T @ L
+    expected = -1j * (H @ rho - rho @ H) + L @ rho @ L.conj().T - 0.5 * (
+        L_dag_L @ rho + rho @ L_dag_L)
+    liouvillian = SuperOperator.lindblad_sparse_matrix(hamiltonian,
+                                                       [collapse_op], dims)
+    assert np.allclose(apply(liouvillian), expected)
+
+
 def test_equality():
     prod1 = position(0) * momentum(0)
     prod2 = position(1) * momentum(1)
@@ -641,6 +693,34 @@ def test_custom_operators():
     assert np.allclose(diff2.to_matrix(dims), matrix1 - matrix0)
 
 
+def test_memoized_definitions():
+    num_calls = 0
+
+    def scaled_number(dim: int, scale: complex):
+        nonlocal num_calls
+        num_calls += 1
+        return scale * number_matrix(dim)
+
+    define("memoized_number", [-1], scaled_number)
+    op = instantiate("memoized_number", 0)
+    for _ in range(3):
+        assert np.allclose(op.to_matrix({0: 3}, scale=2.),
+                           2. * number_matrix(3))
+    assert num_calls == 1
+    assert np.allclose(op.to_matrix({0: 3}, scale=3.), 3. * number_matrix(3))
+    assert np.allclose(op.to_matrix({0: 4}, scale=3.), 3. * number_matrix(4))
+    assert num_calls == 3
+
+    define("memoized_number",
+           [-1],
+           scaled_number,
+           override=True,
+           time_dependent=True)
+    for _ in range(3):
+        op.to_matrix({0: 3}, scale=2.)
+    assert num_calls == 6
+
+
 def test_parameter_docs():
 
     # built-in operators
@@ -353,6 +353,28 @@ def test_arithmetics():
     assert np.allclose(op4.to_matrix(dims, t=2.0), [[2, 1], [1, 2]])
 
 
+def test_closed_form_functions():
+    ramp = ScalarOperator.piecewise_linear([0., 1., 3.], [0., 2., 2. + 4j])
+    assert not ramp.is_constant()
+    assert np.isclose(ramp.evaluate(t=-1.), 0.)
+    assert np.isclose(ramp.evaluate(t=0.5), 1.)
+    assert np.isclose(ramp.evaluate(t=2.), 2. + 2j)
+    assert np.isclose(ramp.evaluate(t=5.), 2. + 4j)
+    assert "t" in ramp.parameters
+
+    knots = np.linspace(0., np.pi, 21)
+    spline = ScalarOperator.cubic_spline(knots, np.sin(knots), parameter="tau")
+    assert np.isclose(spline.evaluate(tau=0.75), np.sin(0.75), atol=1e-4)
+
+    drive = ScalarOperator.sinusoid(0.5, 2., 0.25)
+    assert np.isclose(drive.evaluate(t=0.3), 0.5 * np.sin(2. * 0.3 + 0.25))
+    assert np.isclose((2. * drive + 1.).evaluate(t=0.3),
+                      np.sin(2. * 0.3 + 0.25) + 1.)
+
+    with pytest.raises(ValueError):
+        ScalarOperator.piecewise_linear([1., 0.], [0., 1.])
+
+
 # for debugging
 if __name__ == "__main__":
     test_parameter_docs()
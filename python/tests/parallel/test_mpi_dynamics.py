@@ -18,6 +18,8 @@ skipIfUnsupported = pytest.mark.skipif(
 @pytest.fixture(scope="module", autouse=True)
 def setup_mpi():
     """Setup and teardown MPI and dynamics target for the module."""
+    # Assemble the resulting states of single (non-batched) evolutions on rank 0.
+    os.environ["CUDAQ_DYNAMICS_GATHER_STATES"] = "1"
     cudaq.mpi.initialize()
     cudaq.set_target('dynamics')
     yield
@@ -71,6 +73,44 @@ def testMpiRun():
     assert evolution_result is not None
 
 
+@skipIfUnsupported
+def testMpiGatherDensityMatrix():
+    """Test that the sharded density matrix of a Lindblad evolution is assembled on rank 0."""
+    rank = cudaq.mpi.rank()
+    num_ranks = cudaq.mpi.num_ranks()
+
+    N = 4
+    dimensions = {i: 2 for i in range(N)}
+    hamiltonian = spin.empty()
+    for i in range(N - 1):
+        hamiltonian += 2 * np.pi * 0.1 * spin.x(i) * spin.x(i + 1)
+    collapse_ops = [np.sqrt(0.1) * spin.minus(i) for i in range(N)]
+
+    steps = np.linspace(0.0, 1.0, 11)
+    schedule = Schedule(steps, ["time"])
+    evolution_result = cudaq.evolve(
+        hamiltonian,
+        dimensions,
+        schedule,
+        cudaq.dynamics.InitialState.UNIFORM,
+        observables=[spin.z(0)],
+        collapse_operators=collapse_ops,
+        store_intermediate_results=cudaq.IntermediateResultSave.NONE,
+        integrator=RungeKuttaIntegrator())
+
+    # The expectation values are reduced across all ranks.
+    exp_val = evolution_result.expectation_values()[0][0].expectation()
+    all_exp_vals = cudaq.mpi.all_gather(num_ranks, [exp_val])
+    np.testing.assert_allclose(all_exp_vals, [exp_val] * num_ranks, atol=1e-12)
+
+    # The other ranks keep their slice of the density matrix.
+    if rank == 0:
+        rho = np.array(cudaq.StateMemoryView(
+            evolution_result.final_state())).reshape((2**N, 2**N))
+        np.testing.assert_allclose(np.trace(rho), 1.0, atol=1e-8)
+        np.testing.assert_allclose(rho, rho.conj().T, atol=1e-8)
+
+
 @skipIfUnsupported
 def testMpiBatchedStatesStoreAll():
     """
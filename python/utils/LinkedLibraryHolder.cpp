@@ -14,6 +14,8 @@
 #include "cudaq/platform.h"
 #include "cudaq/target_control.h"
 #include "nvqir/CircuitSimulator.h"
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <regex>
 #include <sstream>
@@ -40,32 +42,22 @@ static constexpr const char IS_FP64_SIMULATION[] =
 /// @brief A utility function to check availability of Nvidia GPUs and return
 /// their count.
 int countGPUs() {
-  int retCode = std::system("nvidia-smi >/dev/null 2>&1");
-  if (0 != retCode) {
-    CUDAQ_INFO("nvidia-smi: command not found");
+  FILE *pipe = popen("nvidia-smi -L 2>/dev/null", "r");
+  if (!pipe) {
+    CUDAQ_INFO("Failed to invoke 'nvidia-smi'");
     return -1;
   }
 
-  char tmpFile[] = "/tmp/.cmd.capture.XXXXXX";
-  int fileDescriptor = mkstemp(tmpFile);
-  if (-1 == fileDescriptor) {
-    CUDAQ_INFO("Failed to create a temporary file to capture output");
-    return -1;
-  }
-
-  std::string command = "nvidia-smi -L 2>/dev/null | wc -l >> ";
-  command.append(tmpFile);
-  retCode = std::system(command.c_str());
-  if (0 != retCode) {
-    CUDAQ_INFO("Encountered error while invoking 'nvidia-smi'");
+  int count = 0;
+  char line[512];
+  while (std::fgets(line, sizeof(line), pipe))
+    if (std::strchr(line, '\n'))
+      ++count;
+  if (0 != pclose(pipe)) {
+    CUDAQ_INFO("nvidia-smi: command not found");
     return -1;
   }
-
-  std::stringstream buffer;
-  buffer << std::ifstream(tmpFile).rdbuf();
-  close(fileDescriptor);
-  unlink(tmpFile);
-  return std::stoi(buffer.str());
+  return count;
 }
 
 void parseRuntimeTarget(const std::filesystem::path &cudaqLibPath,
@@ -119,60 +111,47 @@ void parseRuntimeTarget(const std::filesystem::path &cudaqLibPath,
   target.precision = precision;
 }
 
-/// @brief Search the targets folder in the install for available targets.
-void findAvailableTargets(
+/// @brief Search the targets folder in the install for the configuration
+/// files of the available targets.
+void findTargetConfigFiles(
     const std::filesystem::path &targetPath,
-    std::unordered_map<std::string, RuntimeTarget> &targets,
-    std::unordered_map<std::string, RuntimeTarget> &simulationTargets) {
-
-  // directory_iterator ordering is unspecified, so sort it to make it
-  // repeatable and consistent.
-  std::vector<std::filesystem::directory_entry> targetEntries;
-  for (const auto &entry : std::filesystem::directory_iterator{targetPath})
-    targetEntries.push_back(entry);
-  std::sort(targetEntries.begin(), targetEntries.end(),
-            [](const std::filesystem::directory_entry &a,
-               const std::filesystem::directory_entry &b) {
-              return a.path().filename() < b.path().filename();
-            });
-
-  // Loop over all target files
-  for (const auto &configFile : targetEntries) {
-    auto path = configFile.path();
+    std::map<std::string, std::filesystem::path> &configFiles) {
+  for (const auto &entry : std::filesystem::directory_iterator{targetPath}) {
+    auto path = entry.path();
     // They must have a .yml suffix
-    const std::string configFileExt = ".yml";
-    if (path.extension().string() == configFileExt) {
-      auto fileName = path.filename().string();
-      auto targetName =
-          std::regex_replace(fileName, std::regex(configFileExt), "");
-      // Open the file and look for the platform, simulator, and description
-      std::ifstream inFile(path.string());
-      const std::string configFileContent(
-          (std::istreambuf_iterator<char>(inFile)),
-          std::istreambuf_iterator<char>());
-      cudaq::config::TargetConfig config;
-      llvm::yaml::Input Input(configFileContent.c_str());
-      Input >> config;
-      CUDAQ_INFO("Found Target {} with config file {}", targetName, fileName);
-      const std::string defaultTargetConfigStr =
-          cudaq::config::processRuntimeArgs(config, {});
-      RuntimeTarget target;
-      target.config = config;
-      target.name = targetName;
-      target.description = config.Description;
-      auto cudaqLibPath = targetPath.parent_path() / "lib";
-      parseRuntimeTarget(cudaqLibPath, target, defaultTargetConfigStr);
-      CUDAQ_INFO("Found Target: {} -> (sim={}, platform={})", targetName,
-                 target.simulatorName, target.platformName);
-      // Add the target.
-      targets.emplace(targetName, target);
-
-      simulationTargets.emplace(targetName, target);
-    }
+    if (path.extension().string() != ".yml")
+      continue;
+    auto targetName = path.stem().string();
+    CUDAQ_INFO("Found Target {} with config file {}", targetName,
+               path.filename().string());
+    configFiles.emplace(targetName, path);
   }
 }
 
-LinkedLibraryHolder::LinkedLibraryHolder() : availablePlatforms{"default"} {
+/// @brief Parse the configuration file of the given target.
+RuntimeTarget parseTargetConfig(const std::string &targetName,
+                                const std::filesystem::path &configFile,
+                                const std::filesystem::path &cudaqLibPath) {
+  // Open the file and look for the platform, simulator, and description
+  std::ifstream inFile(configFile.string());
+  const std::string configFileContent((std::istreambuf_iterator<char>(inFile)),
+                                      std::istreambuf_iterator<char>());
+  cudaq::config::TargetConfig config;
+  llvm::yaml::Input Input(configFileContent.c_str());
+  Input >> config;
+  const std::string defaultTargetConfigStr =
+      cudaq::config::processRuntimeArgs(config, {});
+  RuntimeTarget target;
+  target.config = config;
+  target.name = targetName;
+  target.description = config.Description;
+  parseRuntimeTarget(cudaqLibPath, target, defaultTargetConfigStr);
+  CUDAQ_INFO("Parsed Target: {} -> (sim={}, platform={})", targetName,
+             target.simulatorName, target.platformName);
+  return target;
+}
+
+LinkedLibraryHolder::LinkedLibraryHolder() {
   CUDAQ_INFO("Init infrastructure for pythonic builder.");
 
   if (!cudaq::__internal__::canModifyTarget())
@@ -194,9 +173,9 @@ LinkedLibraryHolder::LinkedLibraryHolder() : availablePlatforms{"default"} {
     cudaqLibPath = cudaqLibPath.parent_path().parent_path() / "lib";
   }
 
-  // Populate the map of available targets.
+  // Find the available targets, their configurations are parsed on first use.
   auto targetPath = cudaqLibPath.parent_path() / "targets";
-  findAvailableTargets(targetPath, targets, simulationTargets);
+  findTargetConfigFiles(targetPath, targetConfigFiles);
 
   CUDAQ_INFO("Init: Library Path is {}.", cudaqLibPath.string());
 
@@ -216,30 +195,13 @@ LinkedLibraryHolder::LinkedLibraryHolder() : availablePlatforms{"default"} {
   }
 
   // Load all the defaults
-  for (auto &p : libPaths) {
-    void *libHandle = dlopen(p.string().c_str(), RTLD_GLOBAL | RTLD_NOW);
-    libHandles.emplace(p.string(), libHandle);
-
-    if (!libHandle) {
-      char *error_msg = dlerror();
-      CUDAQ_INFO("Failed to load '{}': ERROR '{}'", p.string(),
-                 (error_msg ? std::string(error_msg) : "unknown."));
-    }
-  }
+  for (auto &p : libPaths)
+    loadLibrary(p);
 
-  // directory_iterator ordering is unspecified, so sort it to make it
-  // repeatable and consistent.
-  std::vector<std::filesystem::directory_entry> entries;
-  for (const auto &entry : std::filesystem::directory_iterator{cudaqLibPath})
-    entries.push_back(entry);
-  std::sort(entries.begin(), entries.end(),
-            [](const std::filesystem::directory_entry &a,
-               const std::filesystem::directory_entry &b) {
-              return a.path().filename() < b.path().filename();
-            });
-
-  // Search for all simulators and create / store them
-  for (const auto &library : entries) {
+  // Search for all simulators and platforms. Their libraries are only loaded
+  // once they are used.
+  for (const auto &library :
+       std::filesystem::directory_iterator{cudaqLibPath}) {
     auto path = library.path();
     auto fileName = path.filename().string();
     if (fileName.find("nvqir-") != std::string::npos) {
@@ -251,34 +213,8 @@ LinkedLibraryHolder::LinkedLibraryHolder() : availablePlatforms{"default"} {
       auto idx = simName.find_last_of(".");
       simName = simName.substr(0, idx);
 
-      // Store the dlopen handles
-      auto iter = libHandles.find(path.string());
-      bool loadFailed = false;
-      if (iter == libHandles.end()) {
-        void *simLibHandle =
-            dlopen(path.string().c_str(), RTLD_GLOBAL | RTLD_NOW);
-        // Add simulator lib if successfully loaded.
-        // Note: there could be potential dlopen failures due to missing
-        // dependencies.
-        if (simLibHandle)
-          libHandles.emplace(path.string(), simLibHandle);
-        else {
-          loadFailed = true;
-          // Retrieve the error message
-          char *error_msg = dlerror();
-          CUDAQ_INFO("Failed to load NVQIR backend '{}' from {}. Error: {}",
-                     simName, path.string(),
-                     (error_msg ? std::string(error_msg) : "unknown."));
-        }
-      }
-
-      if (!loadFailed) {
-        // Load the plugin and get the CircuitSimulator.
-        // Skip adding simulator name to the availableSimulators list if failed
-        // to load.
-        CUDAQ_INFO("Found simulator plugin {}.", simName);
-        availableSimulators.push_back(simName);
-      }
+      CUDAQ_INFO("Found simulator plugin {}.", simName);
+      simulatorLibraries.emplace(simName, path);
     } else if (fileName.find("cudaq-platform-") != std::string::npos) {
       // store all available platforms.
       // Extract and process the platform name
@@ -288,12 +224,7 @@ LinkedLibraryHolder::LinkedLibraryHolder() : availablePlatforms{"default"} {
       // Remove the suffix from the library
       auto idx = platformName.find_last_of(".");
       platformName = platformName.substr(0, idx);
-      auto iter = libHandles.find(path.string());
-      if (iter == libHandles.end())
-        libHandles.emplace(path.string(), dlopen(path.string().c_str(),
-                                                 RTLD_GLOBAL | RTLD_NOW));
-      // Load the plugin and get the CircuitSimulator.
-      availablePlatforms.push_back(platformName);
+      platformLibraries.emplace(platformName, path);
       CUDAQ_INFO("Found platform plugin {}.", platformName);
     }
   }
@@ -303,15 +234,18 @@ LinkedLibraryHolder::LinkedLibraryHolder() : availablePlatforms{"default"} {
   // Otherwise, if GPU(s) available and other dependencies are satisfied, set
   // default to 'nvidia', else to 'qpp-cpu'
   defaultTarget = "qpp-cpu";
-  if (countGPUs() > 0) {
+  auto env = std::getenv("CUDAQ_DEFAULT_SIMULATOR");
+  if (env)
+    CUDAQ_INFO("'CUDAQ_DEFAULT_SIMULATOR' = {}", env);
+  if (env && hasTarget(env)) {
+    CUDAQ_INFO("Valid target");
+    defaultTarget = env;
+  } else if (countGPUs() > 0) {
     // Before setting the defaultTarget to nvidia, make sure the simulator is
     // available.
     const std::string nvidiaTarget = "nvidia";
-    auto iter = targets.find(nvidiaTarget);
-    if (iter != targets.end()) {
-      auto target = iter->second;
-      if (std::find(availableSimulators.begin(), availableSimulators.end(),
-                    target.simulatorName) != availableSimulators.end())
+    if (auto *target = findTarget(nvidiaTarget)) {
+      if (loadSimulator(target->simulatorName))
         defaultTarget = nvidiaTarget;
       else
         CUDAQ_INFO(
@@ -322,15 +256,6 @@ LinkedLibraryHolder::LinkedLibraryHolder() : availablePlatforms{"default"} {
                  "target not found.");
     }
   }
-  auto env = std::getenv("CUDAQ_DEFAULT_SIMULATOR");
-  if (env) {
-    CUDAQ_INFO("'CUDAQ_DEFAULT_SIMULATOR' = {}", env);
-    auto iter = simulationTargets.find(env);
-    if (iter != simulationTargets.end()) {
-      CUDAQ_INFO("Valid target");
-      defaultTarget = iter->second.name;
-    }
-  }
 
   // Initialize current target to default, may be overridden by command line
   // argument or set_target() API
@@ -340,6 +265,40 @@ LinkedLibraryHolder::LinkedLibraryHolder() : availablePlatforms{"default"} {
   resetTarget();
 }
 
+bool LinkedLibraryHolder::loadLibrary(const std::filesystem::path &path) {
+  auto iter = libHandles.find(path.string());
+  if (iter != libHandles.end())
+    return iter->second != nullptr;
+
+  void *libHandle = dlopen(path.string().c_str(), RTLD_GLOBAL | RTLD_NOW);
+  // Note: there could be potential dlopen failures due to missing
+  // dependencies.
+  if (!libHandle) {
+    char *error_msg = dlerror();
+    CUDAQ_INFO("Failed to load '{}': ERROR '{}'", path.string(),
+               (error_msg ? std::string(error_msg) : "unknown."));
+  }
+  libHandles.emplace(path.string(), libHandle);
+  return libHandle != nullptr;
+}
+
+bool LinkedLibraryHolder::loadSimulator(const std::string &simName) {
+  auto iter = simulatorLibraries.find(simName);
+  return iter != simulatorLibraries.end() && loadLibrary(iter->second);
+}
+
+RuntimeTarget *LinkedLibraryHolder::findTarget(const std::string &name) const {
+  auto iter = targets.find(name);
+  if (iter != targets.end())
+    return &iter->second;
+
+  auto configFile = targetConfigFiles.find(name);
+  if (configFile == targetConfigFiles.end())
+    return nullptr;
+  auto target = parseTargetConfig(name, configFile->second, cudaqLibPath);
+  return &targets.emplace(name, std::move(target)).first->second;
+}
+
 LinkedLibraryHolder::~LinkedLibraryHolder() {
   for (auto &[name, handle] : libHandles) {
     if (handle)
@@ -349,9 +308,7 @@ LinkedLibraryHolder::~LinkedLibraryHolder() {
 
 nvqir::CircuitSimulator *
 LinkedLibraryHolder::getSimulator(const std::string &simName) {
-  auto end = availableSimulators.end();
-  auto iter = std::find(availableSimulators.begin(), end, simName);
-  if (iter == end)
+  if (!loadSimulator(simName))
     throw std::runtime_error("Invalid simulator requested: " + simName);
 
   return getUniquePluginInstance<nvqir::CircuitSimulator>(
@@ -360,10 +317,12 @@ LinkedLibraryHolder::getSimulator(const std::string &simName) {
 
 quantum_platform *
 LinkedLibraryHolder::getPlatform(const std::string &platformName) {
-  auto end = availablePlatforms.end();
-  auto iter = std::find(availablePlatforms.begin(), end, platformName);
-  if (iter == end)
-    throw std::runtime_error("Invalid platform requested: " + platformName);
+  // The default platform is linked in, the others are loaded on first use.
+  if (platformName != "default") {
+    auto iter = platformLibraries.find(platformName);
+    if (iter == platformLibraries.end() || !loadLibrary(iter->second))
+      throw std::runtime_error("Invalid platform requested: " + platformName);
+  }
 
   return getUniquePluginInstance<quantum_platform>(
       std::string("getQuantumPlatform_") + platformName);
@@ -372,27 +331,19 @@ LinkedLibraryHolder::getPlatform(const std::string &platformName) {
 void LinkedLibraryHolder::resetTarget() { setTarget(defaultTarget); }
 
 RuntimeTarget LinkedLibraryHolder::getTarget(const std::string &name) const {
-  auto iter = targets.find(name);
-  if (iter == targets.end())
+  auto *target = findTarget(name);
+  if (!target)
     throw std::runtime_error("Invalid target name (" + name + ").");
 
-  return iter->second;
+  return *target;
 }
 
 RuntimeTarget LinkedLibraryHolder::getTarget() const {
-  auto iter = targets.find(currentTarget);
-  if (iter == targets.end())
-    throw std::runtime_error("Invalid target name (" + currentTarget + ").");
-
-  return iter->second;
+  return getTarget(currentTarget);
 }
 
 bool LinkedLibraryHolder::hasTarget(const std::string &name) {
-  auto iter = targets.find(name);
-  if (iter == targets.end())
-    return false;
-
-  return true;
+  return targetConfigFiles.count(name);
 }
 
 void LinkedLibraryHolder::setTarget(
@@ -403,8 +354,8 @@ void LinkedLibraryHolder::setTarget(
   if (!cudaq::__internal__::canModifyTarget())
     return;
 
-  auto iter = targets.find(targetName);
-  if (iter == targets.end())
+  auto *targetPtr = findTarget(targetName);
+  if (!targetPtr)
     throw std::runtime_error("Invalid target name (" + targetName + ").");
 
   std::vector<std::string> argv;
@@ -413,7 +364,7 @@ void LinkedLibraryHolder::setTarget(
     argv.emplace_back(v);
   }
 
-  auto &target = iter->second;
+  auto &target = *targetPtr;
   if (!target.config.WarningMsg.empty()) {
     fmt::print(fmt::fg(fmt::color::red), "[warning] ");
     // Output the warning message if any
@@ -430,12 +381,14 @@ void LinkedLibraryHolder::setTarget(
   if (simName.empty()) {
     // This target doesn't have a simulator defined, e.g., hardware targets.
     // We still need a simulator in case of local emulation.
-    auto &defaultTargetInfo = targets[defaultTarget];
-    simName = defaultTargetInfo.simulatorName;
+    auto *defaultTargetInfo = findTarget(defaultTarget);
+    if (defaultTargetInfo) {
+      simName = defaultTargetInfo->simulatorName;
 
-    // The precision should match the underlying local simulator that we
-    // selected.
-    target.precision = defaultTargetInfo.precision;
+      // The precision should match the underlying local simulator that we
+      // selected.
+      target.precision = defaultTargetInfo->precision;
+    }
 
     // This is really a user error: e.g., using `CUDAQ_DEFAULT_SIMULATOR`
     // environment variable (meant for simulator) to change the default target
@@ -481,8 +434,8 @@ void LinkedLibraryHolder::setTarget(
 
 std::vector<RuntimeTarget> LinkedLibraryHolder::getTargets() const {
   std::vector<RuntimeTarget> ret;
-  for (auto &[name, target] : targets)
-    ret.emplace_back(target);
+  for (auto &[name, configFile] : targetConfigFiles)
+    ret.emplace_back(*findTarget(name));
   return ret;
 }
 
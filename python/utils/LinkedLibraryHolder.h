@@ -44,17 +44,19 @@ protected:
   /// @brief Map of path strings to loaded library handles.
   std::unordered_map<std::string, void *> libHandles;
 
-  /// @brief Vector of available simulators
-  std::vector<std::string> availableSimulators;
+  /// @brief Map of available simulators to their libraries, which are loaded
+  /// on first use.
+  std::map<std::string, std::filesystem::path> simulatorLibraries;
 
-  /// @brief Vector of available platforms
-  std::vector<std::string> availablePlatforms;
+  /// @brief Map of available platforms, other than the default one, to their
+  /// libraries, which are loaded on first use.
+  std::map<std::string, std::filesystem::path> platformLibraries;
 
-  /// @brief Map of available targets.
-  std::unordered_map<std::string, RuntimeTarget> targets;
+  /// @brief Map of available targets to their configuration files.
+  std::map<std::string, std::filesystem::path> targetConfigFiles;
 
-  /// @brief Map of simulation targets
-  std::unordered_map<std::string, RuntimeTarget> simulationTargets;
+  /// @brief Map of the targets whose configuration has been parsed.
+  mutable std::unordered_map<std::string, RuntimeTarget> targets;
 
   /// @brief Store the name of the default target
   std::string defaultTarget;
@@ -62,6 +64,18 @@ protected:
   /// @brief Store the name of the current target
   std::string currentTarget;
 
+  /// @brief Load the given library, unless already loaded. Return false if it
+  /// cannot be loaded.
+  bool loadLibrary(const std::filesystem::path &path);
+
+  /// @brief Load the library of the given simulator. Return false if there is
+  /// no such simulator or its library cannot be loaded.
+  bool loadSimulator(const std::string &simName);
+
+  /// @brief Return the target with the given name, parsing its configuration
+  /// on first use, or null if there is no such target.
+  RuntimeTarget *findTarget(const std::string &name) const;
+
 public:
   LinkedLibraryHolder();
   ~LinkedLibraryHolder();
@@ -0,0 +1,388 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "AnalogEmulator.h"
+#include "Logger.h"
+#include "common/EigenDense.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+using namespace std::complex_literals;
+
+// Piecewise linear interpolation of a time series, constant beyond its ends.
+double interpolate(const cudaq::ahs::TimeSeries &series, double t) {
+  if (series.values.empty())
+    return 0.0;
+  if (series.values.size() != series.times.size())
+    throw std::invalid_argument(
+        "time series must have as many values as time points");
+  if (t <= series.times.front())
+    return series.values.front();
+  if (t >= series.times.back())
+    return series.values.back();
+  const auto upper =
+      std::upper_bound(series.times.begin(), series.times.end(), t) -
+      series.times.begin();
+  const double t0 = series.times[upper - 1];
+  const double t1 = series.times[upper];
+  const double v0 = series.values[upper - 1];
+  const double v1 = series.values[upper];
+  return t1 > t0 ? v0 + (v1 - v0) * (t - t0) / (t1 - t0) : v1;
+}
+
+double norm(const std::vector<std::complex<double>> &v) {
+  double sum = 0.0;
+  for (const auto &x : v)
+    sum += std::norm(x);
+  return std::sqrt(sum);
+}
+
+// The Lanczos iteration is restarted with half the time step if it has not
+// converged within this many operator applications.
+constexpr int maxKrylovDim = 40;
+constexpr double krylovTolerance = 1e-10;
+} // namespace
+
+namespace cudaq::ahs {
+
+LocalEmulator::LocalEmulator(const Program &program, double blockadeRatio,
+                             double c6, double maxStepPhase)
+    : m_filling(program.setup.ahs_register.filling) {
+  const auto &sites = program.setup.ahs_register.sites;
+  if (m_filling.size() != sites.size())
+    throw std::invalid_argument(
+        "atom filling must have as many entries as atom sites");
+  for (std::size_t i = 0; i < sites.size(); ++i)
+    if (m_filling[i])
+      m_atoms.push_back(i);
+  const std::size_t numAtoms = m_atoms.size();
+  if (numAtoms > 64)
+    throw std::runtime_error(
+        "Local emulation supports at most 64 atoms (requested " +
+        std::to_string(numAtoms) + ").");
+
+  const auto &hamiltonian = program.hamiltonian;
+  if (hamiltonian.drivingFields.size() > 1 ||
+      hamiltonian.localDetuning.size() > 1)
+    throw std::invalid_argument("Local emulation supports a single driving "
+                                "field and a single local detuning.");
+  const DrivingField drive = hamiltonian.drivingFields.empty()
+                                 ? DrivingField()
+                                 : hamiltonian.drivingFields.front();
+  for (const auto *field : {&drive.amplitude, &drive.phase, &drive.detuning})
+    if (field->pattern.patternStr != "uniform")
+      throw std::invalid_argument(
+          "the driving field must have a uniform pattern");
+  const PhysicalField localDetuning = hamiltonian.localDetuning.empty()
+                                          ? PhysicalField()
+                                          : hamiltonian.localDetuning.front()
+                                                .magnitude;
+  std::vector<double> pattern(numAtoms, 1.0);
+  if (localDetuning.pattern.patternStr.empty()) {
+    if (localDetuning.pattern.patternVals.size() != sites.size())
+      throw std::invalid_argument(
+          "the local detuning pattern must have one value per atom site");
+    for (std::size_t k = 0; k < numAtoms; ++k)
+      pattern[k] = localDetuning.pattern.patternVals[m_atoms[k]];
+  }
+  double maxPattern = 0.0;
+  for (auto h : pattern)
+    maxPattern = std::max(maxPattern, std::abs(h));
+
+  // Tabulate the waveforms. They are linear between the time points of the
+  // program, so the intervals where they are constant take a single step, the
+  // others are split into steps over which the drive accumulates at most
+  // `maxStepPhase`.
+  std::vector<double> times;
+  for (const auto *series :
+       {&drive.amplitude.time_series, &drive.phase.time_series,
+        &drive.detuning.time_series, &localDetuning.time_series})
+    times.insert(times.end(), series->times.begin(), series->times.end());
+  std::sort(times.begin(), times.end());
+  times.erase(std::unique(times.begin(), times.end()), times.end());
+  auto waveforms = [&](double t) {
+    return std::array<double, 4>{interpolate(drive.amplitude.time_series, t),
+                                 interpolate(drive.phase.time_series, t),
+                                 interpolate(drive.detuning.time_series, t),
+                                 interpolate(localDetuning.time_series, t)};
+  };
+  auto driveStrength = [&](const std::array<double, 4> &w) {
+    return std::max(std::abs(w[0]),
+                    std::abs(w[2]) + maxPattern * std::abs(w[3]));
+  };
+  double maxDrive = 0.0;
+  for (std::size_t i = 0; i + 1 < times.size(); ++i) {
+    const auto start = waveforms(times[i]);
+    const auto end = waveforms(times[i + 1]);
+    const double length = times[i + 1] - times[i];
+    const double rate = std::max(driveStrength(start), driveStrength(end));
+    maxDrive = std::max(maxDrive, rate);
+    const std::size_t numSteps =
+        start == end ? 1
+                     : std::max<std::size_t>(
+                           1, std::ceil(length * rate / maxStepPhase));
+    const double dt = length / numSteps;
+    for (std::size_t s = 0; s < numSteps; ++s) {
+      const auto mid = waveforms(times[i] + (s + 0.5) * dt);
+      m_steps.push_back(dt);
+      m_amplitude.push_back(mid[0]);
+      m_phase.push_back(mid[1]);
+      m_detuning.push_back(mid[2]);
+      m_localDetuning.push_back(mid[3]);
+    }
+  }
+
+  // Blockade graph of the atoms
+  const double threshold = maxDrive > 0.0
+                               ? blockadeRatio * maxDrive
+                               : std::numeric_limits<double>::infinity();
+  std::vector<std::vector<double>> interaction(
+      numAtoms, std::vector<double>(numAtoms, 0.0));
+  std::vector<std::uint64_t> blockade(numAtoms, 0);
+  for (std::size_t j = 0; j < numAtoms; ++j) {
+    for (std::size_t k = j + 1; k < numAtoms; ++k) {
+      const auto &x = sites[m_atoms[j]];
+      const auto &y = sites[m_atoms[k]];
+      double distance2 = 0.0;
+      for (std::size_t d = 0; d < std::min(x.size(), y.size()); ++d)
+        distance2 += (x[d] - y[d]) * (x[d] - y[d]);
+      if (distance2 == 0.0)
+        throw std::invalid_argument("atom sites must be distinct");
+      const double v = c6 / (distance2 * distance2 * distance2);
+      interaction[j][k] = interaction[k][j] = v;
+      if (v > threshold) {
+        blockade[j] |= std::uint64_t(1) << k;
+        blockade[k] |= std::uint64_t(1) << j;
+      }
+    }
+  }
+
+  // Enumerate the independent sets of the blockade graph
+  auto extend = [&](auto &self, std::size_t k, std::uint64_t mask) -> void {
+    if (k == numAtoms) {
+      m_basis.push_back(mask);
+      return;
+    }
+    self(self, k + 1, mask);
+    if ((mask & blockade[k]) == 0)
+      self(self, k + 1, mask | (std::uint64_t(1) << k));
+  };
+  extend(extend, 0, 0);
+  std::sort(m_basis.begin(), m_basis.end());
+  if (m_basis.size() > std::numeric_limits<std::uint32_t>::max())
+    throw std::runtime_error("The blockade subspace is too large to emulate.");
+  CUDAQ_INFO("Emulating {} atoms in a blockade subspace of dimension {} over "
+             "{} time steps.",
+             numAtoms, m_basis.size(), m_steps.size());
+
+  const std::size_t dim = m_basis.size();
+  m_offsets.reserve(2 * dim + 1);
+  m_numExcited.resize(dim);
+  m_localPattern.resize(dim);
+  m_interaction.resize(dim);
+  // Blockaded states reached by exciting an atom of a basis state, with that
+  // basis state and the inverse of their energy difference
+  std::vector<std::tuple<std::uint64_t, std::uint32_t, double>> blockaded;
+  for (std::size_t i = 0; i < dim; ++i) {
+    const auto mask = m_basis[i];
+    // Transitions de-exciting an atom, then those exciting an atom
+    for (bool excited : {true, false}) {
+      m_offsets.push_back(m_transitions.size());
+      for (std::size_t k = 0; k < numAtoms; ++k) {
+        const auto bit = std::uint64_t(1) << k;
+        if (((mask & bit) != 0) != excited)
+          continue;
+        if (!excited && (mask & blockade[k])) {
+          double energy = 0.0;
+          for (std::size_t j = 0; j < numAtoms; ++j)
+            if (mask & (std::uint64_t(1) << j))
+              energy += interaction[j][k];
+          blockaded.emplace_back(mask | bit, i, 1.0 / energy);
+          continue;
+        }
+        m_transitions.push_back(std::lower_bound(m_basis.begin(),
+                                                 m_basis.end(), mask ^ bit) -
+                                m_basis.begin());
+        if (excited) {
+          m_numExcited[i] += 1.0;
+          m_localPattern[i] += pattern[k];
+          for (std::size_t j = 0; j < k; ++j)
+            if (mask & (std::uint64_t(1) << j))
+              m_interaction[i] += interaction[j][k];
+        }
+      }
+    }
+  }
+  m_offsets.push_back(m_transitions.size());
+
+  // Second order coupling of the basis states through the blockaded states
+  // (Schrieffer-Wolff transformation), with the symmetrized energy
+  // denominators. It is proportional to the squared Rabi frequency.
+  std::sort(blockaded.begin(), blockaded.end());
+  std::vector<std::vector<std::pair<std::uint32_t, double>>> coupling(dim);
+  for (std::size_t begin = 0, end = 0; begin < blockaded.size(); begin = end) {
+    while (end < blockaded.size() &&
+           std::get<0>(blockaded[end]) == std::get<0>(blockaded[begin]))
+      ++end;
+    for (auto a = begin; a < end; ++a)
+      for (auto b = begin; b < end; ++b)
+        coupling[std::get<1>(blockaded[a])].emplace_back(
+            std::get<1>(blockaded[b]),
+            0.5 * (std::get<2>(blockaded[a]) + std::get<2>(blockaded[b])));
+  }
+  m_virtualOffsets.reserve(dim + 1);
+  for (auto &row : coupling) {
+    m_virtualOffsets.push_back(m_virtualTransitions.size());
+    std::sort(row.begin(), row.end());
+    for (std::size_t t = 0; t < row.size(); ++t) {
+      if (t > 0 && row[t].first == row[t - 1].first) {
+        m_virtualWeights.back() += row[t].second;
+        continue;
+      }
+      m_virtualTransitions.push_back(row[t].first);
+      m_virtualWeights.push_back(row[t].second);
+    }
+  }
+  m_virtualOffsets.push_back(m_virtualTransitions.size());
+}
+
+void LocalEmulator::apply(std::size_t step,
+                          const std::vector<std::complex<double>> &in,
+                          std::vector<std::complex<double>> &out) const {
+  const auto raise = 0.5 * m_amplitude[step] * std::exp(-1i * m_phase[step]);
+  const auto lower = std::conj(raise);
+  const double detuning = m_detuning[step];
+  const double localDetuning = m_localDetuning[step];
+  const double secondOrder = -std::norm(raise);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    std::complex<double> fromGround = 0.0;
+    for (auto t = m_offsets[2 * i]; t < m_offsets[2 * i + 1]; ++t)
+      fromGround += in[m_transitions[t]];
+    std::complex<double> fromExcited = 0.0;
+    for (auto t = m_offsets[2 * i + 1]; t < m_offsets[2 * i + 2]; ++t)
+      fromExcited += in[m_transitions[t]];
+    std::complex<double> virtualTransitions = 0.0;
+    for (auto t = m_virtualOffsets[i]; t < m_virtualOffsets[i + 1]; ++t)
+      virtualTransitions += m_virtualWeights[t] * in[m_virtualTransitions[t]];
+    out[i] = (m_interaction[i] - detuning * m_numExcited[i] -
+              localDetuning * m_localPattern[i]) *
+                 in[i] +
+             raise * fromGround + lower * fromExcited +
+             secondOrder * virtualTransitions;
+  }
+}
+
+void LocalEmulator::propagate(std::size_t step, double dt,
+                              std::vector<std::complex<double>> &state) const {
+  const double stateNorm = norm(state);
+  if (stateNorm == 0.0)
+    return;
+  // Lanczos basis and the tridiagonal projection of the Hamiltonian
+  std::vector<std::vector<std::complex<double>>> krylov;
+  krylov.reserve(maxKrylovDim);
+  krylov.emplace_back(state);
+  for (auto &x : krylov.back())
+    x /= stateNorm;
+  std::vector<double> alpha;
+  std::vector<double> beta;
+  std::vector<std::complex<double>> w(state.size());
+  Eigen::VectorXcd coefficients;
+  double scale = 0.0;
+  for (int m = 0;; ++m) {
+    apply(step, krylov[m], w);
+    std::complex<double> overlap = 0.0;
+    for (std::size_t i = 0; i < w.size(); ++i)
+      overlap += std::conj(krylov[m][i]) * w[i];
+    alpha.push_back(overlap.real());
+    for (std::size_t i = 0; i < w.size(); ++i) {
+      w[i] -= alpha[m] * krylov[m][i];
+      if (m > 0)
+        w[i] -= beta[m - 1] * krylov[m - 1][i];
+    }
+    const double residual = norm(w);
+
+    // exp(-i T dt) e_1 from the eigen decomposition of the tridiagonal matrix
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver;
+    Eigen::VectorXd diagonal =
+        Eigen::Map<Eigen::VectorXd>(alpha.data(), alpha.size());
+    Eigen::VectorXd subDiagonal =
+        Eigen::Map<Eigen::VectorXd>(beta.data(), beta.size());
+    solver.computeFromTridiagonal(diagonal, subDiagonal);
+    const Eigen::MatrixXd &q = solver.eigenvectors();
+    Eigen::VectorXcd phases =
+        (-1i * dt * solver.eigenvalues().cast<std::complex<double>>())
+            .array()
+            .exp();
+    coefficients =
+        q.cast<std::complex<double>>() *
+        phases.cwiseProduct(q.row(0).transpose().cast<std::complex<double>>());
+
+    // The Krylov subspace is invariant when the residual vanishes, up to
+    // rounding errors, or spans the whole space.
+    scale = std::max(scale, std::abs(alpha[m]) + residual);
+    if (dt * residual * std::abs(coefficients(m)) < krylovTolerance ||
+        residual < 100 * std::numeric_limits<double>::epsilon() * scale ||
+        m + 1 == static_cast<int>(state.size()))
+      break;
+    if (m + 1 == maxKrylovDim) {
+      propagate(step, 0.5 * dt, state);
+      propagate(step, 0.5 * dt, state);
+      return;
+    }
+    beta.push_back(residual);
+    for (auto &x : w)
+      x /= residual;
+    krylov.emplace_back(w);
+  }
+
+  std::fill(state.begin(), state.end(), 0.0);
+  for (std::size_t j = 0; j < krylov.size(); ++j) {
+    const auto c = stateNorm * coefficients(j);
+    for (std::size_t i = 0; i < state.size(); ++i)
+      state[i] += c * krylov[j][i];
+  }
+}
+
+std::vector<std::complex<double>> LocalEmulator::evolve() const {
+  // The first basis state, with no excitation, is the initial state.
+  std::vector<std::complex<double>> state(m_basis.size(), 0.0);
+  state[0] = 1.0;
+  for (std::size_t step = 0; step < m_steps.size(); ++step)
+    propagate(step, m_steps[step], state);
+  return state;
+}
+
+std::vector<ShotMeasurement> LocalEmulator::sample(std::size_t shots,
+                                                   std::size_t seed) const {
+  const auto state = evolve();
+  std::vector<double> probabilities(state.size());
+  for (std::size_t i = 0; i < state.size(); ++i)
+    probabilities[i] = std::norm(state[i]);
+  std::mt19937_64 generator(seed ? seed : std::random_device()());
+  std::discrete_distribution<std::size_t> distribution(probabilities.begin(),
+                                                       probabilities.end());
+  std::vector<ShotMeasurement> measurements(shots);
+  for (auto &measurement : measurements) {
+    const auto mask = m_basis[distribution(generator)];
+    std::vector<int> post(m_filling.size(), 0);
+    for (std::size_t k = 0; k < m_atoms.size(); ++k)
+      post[m_atoms[k]] = (mask >> k) & 1 ? 0 : 1;
+    measurement.shotMetadata.shotStatus = "Success";
+    measurement.shotResult.preSequence = m_filling;
+    measurement.shotResult.postSequence = std::move(post);
+  }
+  return measurements;
+}
+
+} // namespace cudaq::ahs
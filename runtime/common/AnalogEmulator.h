@@ -0,0 +1,118 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/AnalogHamiltonian.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace cudaq {
+namespace ahs {
+
+/// @brief Noise-free local emulator of Analog Hamiltonian Simulation programs.
+// The program is emulated with the Hamiltonian
+//   H(t) = sum_k Omega(t)/2 (exp(i phi(t)) |g_k><r_k| + h.c.)
+//          - sum_k (Delta(t) + h_k Delta_local(t)) n_k
+//          + sum_{j<k} C6 / |x_j - x_k|^6 n_j n_k
+// in SI units (meters, seconds, rad/s), starting from all atoms in the ground
+// state. The waveforms are tabulated once at the midpoints of the time steps
+// and the state is propagated over each step with the exponential of the
+// Hamiltonian at the midpoint, computed with the Lanczos method.
+// Pairs of atoms whose interaction is much stronger than the drive (see
+// `blockadeRatio`) can never be excited together, the emulation is hence
+// restricted to the configurations without such pairs: the independent sets
+// of the blockade graph. This reduces the dimension of the state from `2^N`
+// to, e.g., about `1.6^N` for a chain of `N` atoms. The coupling through the
+// excluded states is kept to second order in the Rabi frequency.
+class LocalEmulator {
+public:
+  /// @brief The `C6` interaction coefficient of the `70S` Rydberg state of
+  /// Rubidium 87, in `rad m^6 / s`.
+  static constexpr double default_c6 = 5.42e-24;
+  /// @brief The default ratio of the interaction to the strongest drive (Rabi
+  /// frequency or detuning) above which a pair of atoms is blockaded.
+  static constexpr double default_blockade_ratio = 10.0;
+  /// @brief The default maximum phase that the drive may accumulate within a
+  /// time step.
+  static constexpr double default_max_step_phase = 0.25;
+
+  /// @brief Constructor
+  // (1) The program to emulate
+  // (2) Ratio of the interaction to the strongest drive above which a pair of
+  // atoms is blockaded. Set to infinity to emulate the full Hilbert space.
+  // (3) The `C6` interaction coefficient
+  // (4) Maximum phase accumulated by the drive within a time step: this limits
+  // the time steps where the waveforms vary.
+  LocalEmulator(const Program &program,
+                double blockadeRatio = default_blockade_ratio,
+                double c6 = default_c6,
+                double maxStepPhase = default_max_step_phase);
+
+  /// @brief The dimension of the emulated (blockade) subspace.
+  std::size_t dimension() const { return m_basis.size(); }
+
+  /// @brief The basis of the emulated subspace, in increasing order.
+  // Bit `k` of a basis state is set if the `k`-th filled site is in the
+  // Rydberg state.
+  const std::vector<std::uint64_t> &basis() const { return m_basis; }
+
+  /// @brief Evolve the initial (ground) state over the program duration.
+  // Returns the final state, expanded on `basis()`.
+  std::vector<std::complex<double>> evolve() const;
+
+  /// @brief Evolve the program and sample the final state.
+  // Shots are reported in the format of the AHS program results: the
+  // pre-sequence is the filling of the sites and the post-sequence is `1` for
+  // atoms in the ground state and `0` for vacant sites and atoms in the
+  // Rydberg state. A zero `seed` selects a random seed.
+  std::vector<ShotMeasurement> sample(std::size_t shots,
+                                      std::size_t seed) const;
+
+private:
+  // Apply the Hamiltonian at the given time step to `in`.
+  void apply(std::size_t step, const std::vector<std::complex<double>> &in,
+             std::vector<std::complex<double>> &out) const;
+  // Replace `state` by `exp(-i H dt) state` for the Hamiltonian at the given
+  // time step.
+  void propagate(std::size_t step, double dt,
+                 std::vector<std::complex<double>> &state) const;
+
+  std::vector<int> m_filling;
+  // Positions of the filled sites in the register
+  std::vector<std::size_t> m_atoms;
+  std::vector<std::uint64_t> m_basis;
+  // Sparse transitions of the drive: the basis states obtained by de-exciting
+  // an atom of basis state `i` are `m_transitions[m_offsets[2 * i]...]`, up to
+  // `m_offsets[2 * i + 1]`, followed by those obtained by exciting an atom, up
+  // to `m_offsets[2 * i + 2]`.
+  std::vector<std::size_t> m_offsets;
+  std::vector<std::uint32_t> m_transitions;
+  // Diagonal terms of each basis state: the number of excitations, the local
+  // detuning pattern summed over the excited atoms and the interaction energy.
+  std::vector<double> m_numExcited;
+  std::vector<double> m_localPattern;
+  std::vector<double> m_interaction;
+  // Second order coupling of the basis states through the blockaded states,
+  // in units of the squared Rabi frequency: the coupling of basis state `i` to
+  // `m_virtualTransitions[t]` is `m_virtualWeights[t]` for `t` from
+  // `m_virtualOffsets[i]` to `m_virtualOffsets[i + 1]`.
+  std::vector<std::size_t> m_virtualOffsets;
+  std::vector<std::uint32_t> m_virtualTransitions;
+  std::vector<double> m_virtualWeights;
+  // Tabulated time steps and waveforms (at the midpoint of each step)
+  std::vector<double> m_steps;
+  std::vector<double> m_amplitude;
+  std::vector<double> m_phase;
+  std::vector<double> m_detuning;
+  std::vector<double> m_localDetuning;
+};
+
+} // namespace ahs
+} // namespace cudaq
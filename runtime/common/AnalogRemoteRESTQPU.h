@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include "common/AnalogEmulator.h"
 #include "common/BaseRemoteRESTQPU.h"
+#include <future>
 
 namespace cudaq {
 
@@ -20,7 +22,7 @@ public:
   virtual bool isRemote() override { return true; }
 
   /// @brief Check if this is an emulated target
-  virtual bool isEmulated() override { return false; }
+  virtual bool isEmulated() override { return emulate; }
 
   /// @brief Launch a kernel with the given arguments
   void launchKernel(const std::string &kernelName,
@@ -40,9 +42,10 @@ public:
       throw std::runtime_error(
           "Arbitrary kernel execution is not supported on this target.");
 
-    if (emulate)
-      throw std::runtime_error(
-          "Local emulation is not yet supported on this target.");
+    if (emulate) {
+      emulateKernel(kernelName, static_cast<char *>(args));
+      return {};
+    }
 
     CUDAQ_INFO("Launching remote kernel ({})", kernelName);
     std::vector<cudaq::KernelExecution> codes;
@@ -67,6 +70,48 @@ public:
     }
     return {};
   }
+
+protected:
+  /// @brief Convert the shots of a local emulation to the results of this
+  /// target. By default, the shots are processed by the server helper as the
+  /// results of an AHS task.
+  virtual sample_result
+  processEmulatedShots(const std::vector<ahs::ShotMeasurement> &shots) {
+    nlohmann::json results;
+    results["measurements"] = shots;
+    std::string jobId;
+    return serverHelper->processResults(results, jobId);
+  }
+
+private:
+  /// @brief Emulate the analog Hamiltonian program locally.
+  // The blockade ratio of the emulator can be set with the `blockade_ratio`
+  // target argument.
+  void emulateKernel(const std::string &kernelName,
+                     const std::string &programJson) {
+    if (!executionContext)
+      return;
+    CUDAQ_INFO("Emulating analog kernel ({}) locally", kernelName);
+    const ahs::Program program = nlohmann::json::parse(programJson);
+    double blockadeRatio = ahs::LocalEmulator::default_blockade_ratio;
+    auto iter = backendConfig.find("blockade_ratio");
+    if (iter != backendConfig.end() && !iter->second.empty())
+      blockadeRatio = std::stod(iter->second);
+    const std::size_t shots = executionContext->shots;
+    // Fetch the thread-specific seed outside and then pass it inside.
+    const std::size_t seed = cudaq::get_random_seed();
+    cudaq::details::future future(std::async(
+        std::launch::async,
+        [this, program, blockadeRatio, shots, seed]() -> sample_result {
+          ahs::LocalEmulator emulator(program, blockadeRatio);
+          return processEmulatedShots(emulator.sample(shots, seed));
+        }));
+    if (executionContext->asyncExec) {
+      executionContext->asyncResult = async_sample_result(std::move(future));
+      return;
+    }
+    executionContext->result = future.get();
+  }
 };
 
 } // namespace cudaq
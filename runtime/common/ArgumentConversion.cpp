@@ -15,7 +15,9 @@
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Todo.h"
 #include "cudaq/qis/pauli_word.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/TypeSwitch.h"
+#include "llvm/Support/xxhash.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Complex/IR/Complex.h"
 #include "mlir/IR/BuiltinAttributes.h"
@@ -696,8 +698,74 @@ Value genRecursiveSpan(OpBuilder &builder, cudaq::cc::StdvecType ty, void *p,
   return builder.create<cudaq::cc::ReifySpanOp>(loc, ty, conArr);
 }
 
+/// Flat vectors of integers or floating-point values with at least this many
+/// elements are synthesized as a constant global rather than a constant array.
+static constexpr std::size_t denseVectorThreshold = 1024;
+
+/// Builds a private constant `cc.global` directly from the host buffer of a
+/// large flat vector of integers or floating-point values, without creating an
+/// attribute per element. The global is named after a hash of its contents, so
+/// identical arguments share one global and the synthesized module is the same
+/// from one launch to the next. The kernel may write to its argument, so the
+/// global is copied into a stack buffer, as for the smaller vectors. Returns a
+/// null value if the vector is not a candidate.
+static Value genDenseVector(OpBuilder &builder, cudaq::cc::StdvecType vecTy,
+                            void *p, ModuleOp substMod) {
+  auto eleTy = vecTy.getElementType();
+  if (!isa<IntegerType, Float32Type, Float64Type>(eleTy))
+    return {};
+  unsigned width = eleTy.getIntOrFloatBitWidth();
+  if (width != 8 && width != 16 && width != 32 && width != 64)
+    return {};
+  typedef const char *VectorType[3];
+  VectorType *vecPtr = static_cast<VectorType *>(p);
+  std::size_t bytes = (*vecPtr)[1] - (*vecPtr)[0];
+  std::size_t vecSize = bytes / (width / 8);
+  if (vecSize < denseVectorThreshold)
+    return {};
+
+  ArrayRef<char> rawData((*vecPtr)[0], bytes);
+  auto tensorTy = RankedTensorType::get(vecSize, eleTy);
+  auto values = DenseElementsAttr::getFromRawBuffer(tensorTy, rawData);
+  auto hash = llvm::xxHash64(StringRef(rawData.data(), bytes));
+  std::string name = "__nvqpp__vector_arg.";
+  name += isa<FloatType>(eleTy) ? "f" : "i";
+  name += std::to_string(width) + "." + llvm::utohexstr(hash);
+  // A global of the same name is reused only if it holds the same values, so a
+  // hash collision gets a name of its own.
+  std::string uniqueName = name;
+  for (unsigned suffix = 1;; ++suffix) {
+    auto existing = substMod.lookupSymbol<cudaq::cc::GlobalOp>(uniqueName);
+    if (!existing || existing.getValue() == Attribute{values})
+      break;
+    uniqueName = name + "." + std::to_string(suffix);
+  }
+  auto loc = builder.getUnknownLoc();
+  cudaq::IRBuilder irBuilder(builder);
+  auto global =
+      irBuilder.genVectorOfConstants(loc, substMod, uniqueName, values, eleTy);
+  if (failed(irBuilder.loadIntrinsic(substMod, cudaq::llvmMemCopyIntrinsic)))
+    return {};
+  auto addr = builder.create<cudaq::cc::AddressOfOp>(
+      loc, cudaq::cc::PointerType::get(global.getGlobalType()), uniqueName);
+  auto buffer =
+      builder.create<cudaq::cc::AllocaOp>(loc, global.getGlobalType());
+  auto ptrI8Ty = cudaq::cc::PointerType::get(builder.getI8Type());
+  auto toPtr = builder.create<cudaq::cc::CastOp>(loc, ptrI8Ty, buffer);
+  auto fromPtr = builder.create<cudaq::cc::CastOp>(loc, ptrI8Ty, addr);
+  auto numBytes = builder.create<arith::ConstantIntOp>(loc, bytes, 64);
+  auto notVolatile = builder.create<arith::ConstantIntOp>(loc, 0, 1);
+  builder.create<func::CallOp>(
+      loc, std::nullopt, cudaq::llvmMemCopyIntrinsic,
+      ValueRange{toPtr, fromPtr, numBytes, notVolatile});
+  auto size = builder.create<arith::ConstantIntOp>(loc, vecSize, 64);
+  return builder.create<cudaq::cc::StdvecInitOp>(loc, vecTy, buffer, size);
+}
+
 Value genConstant(OpBuilder &builder, cudaq::cc::StdvecType vecTy, void *p,
                   ModuleOp substMod, llvm::DataLayout &layout) {
+  if (Value dense = genDenseVector(builder, vecTy, p, substMod))
+    return dense;
   if (isSupportedRecursiveSpan(vecTy))
     return genRecursiveSpan(builder, vecTy, p, substMod, layout);
   typedef const char *VectorType[3];
@@ -15,9 +15,12 @@
 #include "common/Executor.h"
 #include "common/ExtraPayloadProvider.h"
 #include "common/FmtCore.h"
+#include "common/KernelArchive.h"
 #include "common/Logger.h"
+#include "common/PassProfiler.h"
 #include "common/Resources.h"
 #include "common/RestClient.h"
+#include "common/ResultCache.h"
 #include "common/RuntimeMLIR.h"
 #include "common/cudaq_fmt.h"
 #include "cudaq.h"
@@ -33,6 +36,7 @@
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Optimizer/Transforms/AddMetadata.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
+#include "cudaq/Optimizer/Transforms/ResourceEstimation.h"
 #include "cudaq/Support/Plugin.h"
 #include "cudaq/Support/TargetConfigYaml.h"
 #include "cudaq/operators.h"
@@ -40,11 +44,13 @@
 #include "cudaq/platform/quantum_platform.h"
 #include "nvqpp_config.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Base64.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SHA256.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
@@ -58,10 +64,15 @@
 #include "mlir/Tools/mlir-translate/Translation.h"
 #include "mlir/Transforms/Passes.h"
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <netinet/in.h>
+#include <optional>
 #include <regex>
+#include <set>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <unordered_map>
 
 namespace nvqir {
 // QIR helper to retrieve the output log.
@@ -124,9 +135,77 @@ protected:
   /// to be printed. This is similar to `-mlir-pass-statistics` in `cudaq-opt`
   bool enablePassStatistics = false;
 
+  /// @brief Flag indicating whether kernels with only floating-point
+  /// arguments run the target pass pipeline once, with symbolic arguments,
+  /// rather than once per set of argument values.
+  bool parametricCompilation = false;
+
+  /// @brief The output of the target pass pipeline for parametric kernels,
+  /// keyed by the pipeline and the kernel module before argument synthesis.
+  /// A null entry marks a kernel that is not parametric.
+  std::unordered_map<std::string, std::optional<std::string>>
+      parametricPipelineCache;
+  std::mutex parametricPipelineCacheMutex;
+
+  /// @brief Flag indicating whether the code lowered for a launch is reused by
+  /// the launches of the same kernel with the same arguments.
+  bool loweringCache = true;
+
+  /// @brief The result of lowering a launch.
+  struct LoweringCacheEntry {
+    std::vector<cudaq::KernelExecution> codes;
+    /// @brief The JIT engines of the codes, when emulating.
+    std::vector<std::shared_ptr<mlir::ExecutionEngine>> jitEngines;
+    /// @brief Whether the kernel has conditionals on measurement results, when
+    /// emulating.
+    bool hasConditionalsOnMeasureResults = false;
+  };
+
+  /// @brief The code lowered for previous launches, keyed by the fingerprint
+  /// of the kernel module after argument synthesis and of the target
+  /// configuration.
+  std::unordered_map<std::string, LoweringCacheEntry> loweringCacheEntries;
+  std::mutex loweringCacheMutex;
+
+  /// @brief The maximum number of entries of the lowering cache. The cache is
+  /// cleared when it is full.
+  static constexpr std::size_t loweringCacheCapacity = 256;
+
+  /// @brief The kernels precompiled for this target, or null if the binary
+  /// was not built with a kernel archive. See `KernelArchive`.
+  std::unique_ptr<cudaq::KernelArchive> kernelArchive;
+
   /// @brief If we are emulating locally, keep track
-  /// of JIT engines for invoking the kernels.
-  std::vector<mlir::ExecutionEngine *> jitEngines;
+  /// of JIT engines for invoking the kernels. The engines are shared with the
+  /// lowering cache.
+  std::vector<std::shared_ptr<mlir::ExecutionEngine>> jitEngines;
+
+  /// @brief The cache of the results of remote sampling jobs, or null if it is
+  /// not enabled. See `ResultCache::createFromEnvironment`.
+  std::unique_ptr<cudaq::ResultCache> resultCache;
+
+  /// @brief Flag indicating whether the resources of the kernel being launched
+  /// were estimated at compilation time, so it does not need to be executed by
+  /// the resource counter.
+  bool staticResourceCount = false;
+
+  /// @brief The result cache key of sampling the given codes, which covers
+  /// everything sent to the server: the codes, the number of shots and the
+  /// target configuration.
+  std::string
+  getResultCacheKey(const std::vector<cudaq::KernelExecution> &codes,
+                    std::size_t shots) {
+    nlohmann::json content{{"target", qpuName},
+                           {"shots", shots},
+                           {"config", serverHelper->getConfig()}};
+    for (const auto &code : codes)
+      content["codes"].push_back({{"name", code.name},
+                                  {"code", code.code},
+                                  {"output_names", code.output_names},
+                                  {"reorder", code.mapping_reorder_idx},
+                                  {"user_data", code.user_data}});
+    return cudaq::ResultCache::key(content.dump());
+  }
 
   /// @brief Invoke the kernel in the JIT engine
   void invokeJITKernel(mlir::ExecutionEngine *jit,
@@ -140,13 +219,6 @@ protected:
     reinterpret_cast<void (*)()>(*funcPtr)();
   }
 
-  /// @brief Invoke the kernel in the JIT engine and then delete the JIT engine.
-  void invokeJITKernelAndRelease(mlir::ExecutionEngine *jit,
-                                 const std::string &kernelName) {
-    invokeJITKernel(jit, kernelName);
-    delete jit;
-  }
-
   std::tuple<mlir::ModuleOp, std::unique_ptr<mlir::MLIRContext>, void *>
   extractQuakeCodeAndContext(const std::string &kernelName, void *data) {
     auto context = cudaq::getOwningMLIRContext();
@@ -290,6 +362,15 @@ public:
         getEnvBool("CUDAQ_MLIR_PRINT_EACH_PASS", enablePrintMLIREachPass);
     enablePassStatistics =
         getEnvBool("CUDAQ_MLIR_PASS_STATISTICS", enablePassStatistics);
+    parametricCompilation =
+        getEnvBool("CUDAQ_PARAMETRIC_COMPILATION", parametricCompilation);
+    loweringCache = getEnvBool("CUDAQ_LOWERING_CACHE", loweringCache);
+    resultCache = cudaq::ResultCache::createFromEnvironment();
+    if (auto iter = backendConfig.find("kernel_archive");
+        iter != backendConfig.end() && !emulate)
+      kernelArchive = std::make_unique<cudaq::KernelArchive>(
+          iter->second, mutableBackend,
+          getEnvBool("CUDAQ_KERNEL_ARCHIVE_RECORD", false));
 
     // If the very verbose enablePrintMLIREachPass flag is set, then
     // multi-threading must be disabled.
@@ -343,6 +424,8 @@ public:
       // 3. Appply the target-agnostic deployment passes. Any additional
       // restructuring to get ready for decomposition.
       passPipelineConfig += ",jit-deploy-pipeline";
+      if (!getEnvBool("CUDAQ_GATE_CANCELLATION", true))
+        passPipelineConfig += "{gate-cancellation=false}";
 
       // 4. Apply the target-specific mid-level passes. This decomposed quantum
       // gates for a specific target machine, etc.
@@ -464,6 +547,232 @@ public:
                                            mlir::MLIRContext *,
                                            mlir::func::FuncOp);
 
+  /// @brief Synthesize the runtime arguments into the kernel, from `rawArgs`
+  /// if given, otherwise from the packed `updatedArgs`.
+  void synthesizeArguments(const std::string &kernelName,
+                           mlir::ModuleOp moduleOp,
+                           const std::vector<void *> &rawArgs,
+                           void *updatedArgs, mlir::MLIRContext *contextPtr) {
+    cudaq::profiler::ScopedPhase phase(
+        cudaq::profiler::Phase::argument_synthesis, kernelName);
+    mlir::PassManager pm(contextPtr);
+    // Store kernel and substitution strings on the stack.
+    // We pass string references to the `createArgumentSynthesisPass`.
+    mlir::SmallVector<std::string> kernels;
+    mlir::SmallVector<std::string> substs;
+    if (!rawArgs.empty()) {
+      CUDAQ_INFO("Run Argument Synth.\n");
+      // For quantum devices, we generate a collection of `init` and
+      // `num_qubits` functions and their substitutions created
+      // from a kernel and arguments that generated a state argument.
+      cudaq::opt::ArgumentConverter argCon(kernelName, moduleOp);
+      argCon.gen(rawArgs);
+
+      for (auto *kInfo : argCon.getKernelSubstitutions()) {
+        std::string kernName =
+            cudaq::runtime::cudaqGenPrefixName + kInfo->getKernelName().str();
+        kernels.emplace_back(kernName);
+        std::string substBuff;
+        llvm::raw_string_ostream ss(substBuff);
+        ss << kInfo->getSubstitutionModule();
+        substs.emplace_back(substBuff);
+      }
+
+      // Collect references for the argument synthesis.
+      mlir::SmallVector<mlir::StringRef> kernelRefs{kernels.begin(),
+                                                    kernels.end()};
+      mlir::SmallVector<mlir::StringRef> substRefs{substs.begin(),
+                                                   substs.end()};
+      pm.addPass(opt::createArgumentSynthesisPass(kernelRefs, substRefs));
+      pm.addNestedPass<mlir::func::FuncOp>(mlir::createCanonicalizerPass());
+      pm.addPass(
+          cudaq::opt::createLambdaLifting({.constantPropagation = true}));
+      // We must inline these lambda calls before apply specialization as it
+      // does not perform control/adjoint specialization across function call
+      // boundary.
+      cudaq::opt::addAggressiveInlining(pm);
+      pm.addPass(cudaq::opt::createApplySpecialization(
+          {.constantPropagation = true}));
+      cudaq::opt::addAggressiveInlining(pm);
+      pm.addNestedPass<mlir::func::FuncOp>(
+          opt::createReplaceStateWithKernel());
+      cudaq::opt::addAggressiveInlining(pm);
+      pm.addPass(mlir::createSymbolDCEPass());
+    } else if (updatedArgs) {
+      CUDAQ_INFO("Run Quake Synth.\n");
+      pm.addPass(cudaq::opt::createQuakeSynthesizer(kernelName, updatedArgs));
+    }
+    pm.addPass(mlir::createCanonicalizerPass());
+    if (disableMLIRthreading || enablePrintMLIREachPass)
+      moduleOp.getContext()->disableMultithreading();
+    if (enablePrintMLIREachPass)
+      pm.enableIRPrinting();
+    cudaq::profiler::instrumentPasses(pm);
+    if (failed(pm.run(moduleOp)))
+      throw std::runtime_error("Could not successfully apply quake-synth.");
+  }
+
+  /// @brief Return true if the kernel only takes floating-point scalars and
+  /// vectors, which cannot change the structure of the lowered kernel, e.g.,
+  /// the number of qubits, but only the gate parameters.
+  static bool isParametricKernel(mlir::func::FuncOp func) {
+    return llvm::all_of(func.getArgumentTypes(), [](mlir::Type ty) {
+      if (auto vecTy = dyn_cast<cudaq::cc::StdvecType>(ty))
+        ty = vecTy.getElementType();
+      return isa<mlir::FloatType>(ty);
+    });
+  }
+
+  /// @brief Lower a parametric kernel through the target pass pipeline with
+  /// symbolic arguments, or reuse the cached output of a previous launch, and
+  /// only then synthesize the arguments. On success, replaces `moduleOp` with
+  /// the lowered and synthesized module and returns true. Returns false, and
+  /// leaves `moduleOp` untouched, if the pipeline does not apply to symbolic
+  /// arguments or if some gate parameters are not constant after synthesis;
+  /// the kernel is then lowered as usual.
+  template <typename PipelineRunner>
+  bool lowerParametricKernel(const std::string &kernelName,
+                             mlir::ModuleOp &moduleOp,
+                             mlir::func::FuncOp epFunc,
+                             const std::vector<void *> &rawArgs,
+                             void *updatedArgs, mlir::MLIRContext *contextPtr,
+                             PipelineRunner &&runPassPipeline) {
+    auto candidate = moduleOp.clone();
+    if (moduleOp->hasAttr(runtime::pythonUniqueAttrName))
+      detail::mergeAllCallableClosures(candidate, kernelName, rawArgs);
+    for (auto &op : candidate)
+      if (auto f = dyn_cast<mlir::func::FuncOp>(op))
+        if (f.getName() != epFunc.getName())
+          f.setPrivate();
+
+    std::string key = passPipelineConfig + '\n';
+    {
+      llvm::raw_string_ostream os(key);
+      candidate.print(os);
+    }
+    auto setCacheEntry = [&](std::optional<std::string> entry) {
+      std::scoped_lock<std::mutex> lock(parametricPipelineCacheMutex);
+      parametricPipelineCache[key] = std::move(entry);
+    };
+
+    std::optional<std::string> lowered;
+    bool cached = false;
+    {
+      std::scoped_lock<std::mutex> lock(parametricPipelineCacheMutex);
+      if (auto it = parametricPipelineCache.find(key);
+          it != parametricPipelineCache.end()) {
+        cached = true;
+        lowered = it->second;
+      }
+    }
+    if (cached && !lowered) {
+      candidate.erase();
+      return false;
+    }
+
+    mlir::ModuleOp result;
+    if (lowered) {
+      CUDAQ_INFO("Reusing the lowered parametric kernel {}.", kernelName);
+      candidate.erase();
+      result =
+          parseSourceString<mlir::ModuleOp>(*lowered, contextPtr).release();
+      if (!result)
+        throw std::runtime_error("Failed to parse the lowered parametric "
+                                 "kernel " +
+                                 kernelName + ".");
+    } else {
+      try {
+        runPassPipeline(passPipelineConfig, candidate);
+      } catch (const std::exception &e) {
+        CUDAQ_INFO("Kernel {} cannot be lowered with symbolic arguments: {}",
+                   kernelName, e.what());
+        candidate.erase();
+        setCacheEntry(std::nullopt);
+        return false;
+      }
+      std::string loweredText;
+      llvm::raw_string_ostream os(loweredText);
+      candidate.print(os);
+      setCacheEntry(std::move(os.str()));
+      result = candidate;
+    }
+
+    synthesizeArguments(kernelName, result, rawArgs, updatedArgs, contextPtr);
+    // The pipeline usually needs constant gate parameters, which the regular
+    // path guarantees by synthesizing the arguments first.
+    const bool constantParameters =
+        !result
+             .walk([](quake::OperatorInterface op) {
+               for (auto param : op.getParameters())
+                 if (!param.getDefiningOp<mlir::arith::ConstantOp>())
+                   return mlir::WalkResult::interrupt();
+               return mlir::WalkResult::advance();
+             })
+             .wasInterrupted();
+    if (!constantParameters) {
+      CUDAQ_INFO("Kernel {} has gate parameters that are not constant after "
+                 "synthesis, it is not parametric.",
+                 kernelName);
+      result.erase();
+      setCacheEntry(std::nullopt);
+      return false;
+    }
+    moduleOp = result;
+    return true;
+  }
+
+  /// @brief Return the key of the lowering cache for \p moduleOp, or an empty
+  /// string if the lowering of the current launch cannot be reused.
+  /// Observation and resource counting have side effects beyond the code they
+  /// produce. Emulated sampling and runs also cache the JIT engines.
+  std::string getLoweringCacheKey(mlir::ModuleOp moduleOp) {
+    if (!loweringCache || !executionContext ||
+        executionContext->name == "observe" ||
+        executionContext->name == "resource-count" ||
+        executionContext->name == "tracer")
+      return {};
+    if (emulate && executionContext->name != "sample" &&
+        executionContext->name != "run")
+      return {};
+    std::string fingerprint;
+    {
+      llvm::raw_string_ostream os(fingerprint);
+      os << passPipelineConfig << '\n'
+         << codegenTranslation << '\n'
+         << postCodeGenPasses << '\n'
+         << executionContext->name << '\n';
+      moduleOp.print(os);
+    }
+    return llvm::toHex(llvm::SHA256::hash(llvm::arrayRefFromStringRef(
+                           llvm::StringRef(fingerprint))),
+                       /*LowerCase=*/true);
+  }
+
+  /// @brief Return the lowering cached for \p key, if any, and record the hit
+  /// or miss in the profile.
+  std::optional<LoweringCacheEntry>
+  lookupLoweringCache(const std::string &kernelName, const std::string &key) {
+    cudaq::profiler::ScopedPhase phase(cudaq::profiler::Phase::jit_passes,
+                                       kernelName);
+    std::scoped_lock<std::mutex> lock(loweringCacheMutex);
+    auto iter = loweringCacheEntries.find(key);
+    if (iter == loweringCacheEntries.end()) {
+      phase.addCounter("lowering_cache_misses", 1);
+      return std::nullopt;
+    }
+    CUDAQ_INFO("Reusing the code lowered for a previous launch of {}.",
+               kernelName);
+    phase.addCounter("lowering_cache_hits", 1);
+    return iter->second;
+  }
+
+  void storeLoweringCache(const std::string &key, LoweringCacheEntry entry) {
+    std::scoped_lock<std::mutex> lock(loweringCacheMutex);
+    if (loweringCacheEntries.size() >= loweringCacheCapacity)
+      loweringCacheEntries.clear();
+    loweringCacheEntries.emplace(key, std::move(entry));
+  }
+
   std::vector<cudaq::KernelExecution>
   lowerQuakeCodePart2(const std::string &kernelName, void *kernelArgs,
                       const std::vector<void *> &rawArgs,
@@ -479,6 +788,8 @@ public:
     // Lambda to apply a specific pipeline to the given ModuleOp
     auto runPassPipeline = [&](const std::string &pipeline,
                                mlir::ModuleOp moduleOpIn) {
+      cudaq::profiler::ScopedPhase phase(cudaq::profiler::Phase::jit_passes,
+                                         kernelName);
       mlir::PassManager pm(contextPtr);
       std::string errMsg;
       llvm::raw_string_ostream os(errMsg);
@@ -491,6 +802,7 @@ public:
         moduleOpIn.getContext()->disableMultithreading();
       if (enablePrintMLIREachPass)
         pm.enableIRPrinting();
+      cudaq::profiler::instrumentPasses(pm);
       if (failed(pm.run(moduleOpIn)))
         throw std::runtime_error("Remote rest platform Quake lowering failed.");
     };
@@ -498,8 +810,33 @@ public:
     auto epFunc =
         moduleOp.template lookupSymbol<mlir::func::FuncOp>(origFn.getName());
     const bool isPython = moduleOp->hasAttr(runtime::pythonUniqueAttrName);
-    if (!rawArgs.empty() || updatedArgs) {
-      mlir::PassManager pm(contextPtr);
+
+    // Delay combining measurements for backends that cannot handle
+    // subveqs and multiple measurements until we created the emulation code.
+    auto combineMeasurements =
+        passPipelineConfig.find("combine-measurements") != std::string::npos;
+    if (emulate && combineMeasurements) {
+      std::regex combine("(.*),([ ]*)combine-measurements(.*)");
+      std::string replacement("$1$3");
+      passPipelineConfig =
+          std::regex_replace(passPipelineConfig, combine, replacement);
+      CUDAQ_INFO("Delaying combine-measurements pass due to emulation. "
+                 "Updating pipeline to {}",
+                 passPipelineConfig);
+    }
+
+    // Parametric kernels are lowered from the cached pipeline output, and the
+    // analysis of conditional measurements then uses the module before
+    // lowering.
+    auto analyzedModule = moduleOp;
+    const bool parametric =
+        parametricCompilation && isParametricKernel(epFunc) &&
+        lowerParametricKernel(kernelName, moduleOp, epFunc, rawArgs,
+                              updatedArgs, contextPtr, runPassPipeline);
+    if (parametric) {
+      epFunc =
+          moduleOp.template lookupSymbol<mlir::func::FuncOp>(origFn.getName());
+    } else if (!rawArgs.empty() || updatedArgs) {
       if (isPython)
         detail::mergeAllCallableClosures(moduleOp, kernelName, rawArgs);
 
@@ -509,64 +846,46 @@ public:
           if (f != epFunc)
             f.setPrivate();
 
-      if (!rawArgs.empty()) {
-        CUDAQ_INFO("Run Argument Synth.\n");
-        // For quantum devices, we generate a collection of `init` and
-        // `num_qubits` functions and their substitutions created
-        // from a kernel and arguments that generated a state argument.
-        cudaq::opt::ArgumentConverter argCon(kernelName, moduleOp);
-        argCon.gen(rawArgs);
-
-        // Store kernel and substitution strings on the stack.
-        // We pass string references to the `createArgumentSynthesisPass`.
-        mlir::SmallVector<std::string> kernels;
-        mlir::SmallVector<std::string> substs;
-        for (auto *kInfo : argCon.getKernelSubstitutions()) {
-          std::string kernName =
-              cudaq::runtime::cudaqGenPrefixName + kInfo->getKernelName().str();
-          kernels.emplace_back(kernName);
-          std::string substBuff;
-          llvm::raw_string_ostream ss(substBuff);
-          ss << kInfo->getSubstitutionModule();
-          substs.emplace_back(substBuff);
+      synthesizeArguments(kernelName, moduleOp, rawArgs, updatedArgs,
+                          contextPtr);
+    }
+
+    // Launches of the same kernel with the same arguments lower to the same
+    // code.
+    const std::string loweringKey =
+        parametric ? std::string{} : getLoweringCacheKey(moduleOp);
+    if (!loweringKey.empty())
+      if (auto entry = lookupLoweringCache(kernelName, loweringKey)) {
+        auto &codes = entry->codes;
+        if (executionContext->name == "sample" && !codes.empty())
+          executionContext->reorderIdx = codes.front().mapping_reorder_idx;
+        else
+          executionContext->reorderIdx.clear();
+        if (emulate) {
+          // Reuse the JIT engines compiled for the cached codes.
+          jitEngines = std::move(entry->jitEngines);
+          if (entry->hasConditionalsOnMeasureResults)
+            executionContext->hasConditionalsOnMeasureResults = true;
         }
+        return std::move(codes);
+      }
 
-        // Collect references for the argument synthesis.
-        mlir::SmallVector<mlir::StringRef> kernelRefs{kernels.begin(),
-                                                      kernels.end()};
-        mlir::SmallVector<mlir::StringRef> substRefs{substs.begin(),
-                                                     substs.end()};
-        pm.addPass(opt::createArgumentSynthesisPass(kernelRefs, substRefs));
-        pm.addNestedPass<mlir::func::FuncOp>(mlir::createCanonicalizerPass());
-        pm.addPass(
-            cudaq::opt::createLambdaLifting({.constantPropagation = true}));
-        // We must inline these lambda calls before apply specialization as it
-        // does not perform control/adjoint specialization across function call
-        // boundary.
-        cudaq::opt::addAggressiveInlining(pm);
-        pm.addPass(cudaq::opt::createApplySpecialization(
-            {.constantPropagation = true}));
-        cudaq::opt::addAggressiveInlining(pm);
-        pm.addNestedPass<mlir::func::FuncOp>(
-            opt::createReplaceStateWithKernel());
-        cudaq::opt::addAggressiveInlining(pm);
-        pm.addPass(mlir::createSymbolDCEPass());
-      } else if (updatedArgs) {
-        CUDAQ_INFO("Run Quake Synth.\n");
-        pm.addPass(cudaq::opt::createQuakeSynthesizer(kernelName, updatedArgs));
+    // Then look for the launch among the kernels precompiled for the target.
+    if (!loweringKey.empty() && kernelArchive)
+      if (auto codes = kernelArchive->lookup(loweringKey)) {
+        CUDAQ_INFO("Using the precompiled code of {}.", kernelName);
+        if (executionContext->name == "sample" && !codes->empty())
+          executionContext->reorderIdx = codes->front().mapping_reorder_idx;
+        else
+          executionContext->reorderIdx.clear();
+        storeLoweringCache(loweringKey, LoweringCacheEntry{*codes});
+        return std::move(*codes);
       }
-      pm.addPass(mlir::createCanonicalizerPass());
-      if (disableMLIRthreading || enablePrintMLIREachPass)
-        moduleOp.getContext()->disableMultithreading();
-      if (enablePrintMLIREachPass)
-        pm.enableIRPrinting();
-      if (failed(pm.run(moduleOp)))
-        throw std::runtime_error("Could not successfully apply quake-synth.");
-    }
 
+    bool hasConditionalsOnMeasure = false;
     if (emulate && executionContext && executionContext->name == "sample") {
       // Populate conditional measurement flag in the context.
-      for (auto &artifact : moduleOp) {
+      for (auto &artifact : analyzedModule) {
         quake::detail::QuakeFunctionAnalysis analysis{&artifact};
         auto info = analysis.getAnalysisInfo();
         if (info.empty())
@@ -574,32 +893,39 @@ public:
         auto result = info[&artifact];
         if (result.hasConditionalsOnMeasure) {
           executionContext->hasConditionalsOnMeasureResults = true;
+          hasConditionalsOnMeasure = true;
           break;
         }
       }
     }
-    // Delay combining measurements for backends that cannot handle
-    // subveqs and multiple measurements until we created the emulation code.
-    auto combineMeasurements =
-        passPipelineConfig.find("combine-measurements") != std::string::npos;
-    if (emulate && combineMeasurements) {
-      std::regex combine("(.*),([ ]*)combine-measurements(.*)");
-      std::string replacement("$1$3");
-      passPipelineConfig =
-          std::regex_replace(passPipelineConfig, combine, replacement);
-      CUDAQ_INFO("Delaying combine-measurements pass due to emulation. "
-                 "Updating pipeline to {}",
-                 passPipelineConfig);
-    }
-
-    runPassPipeline(passPipelineConfig, moduleOp);
+    if (parametric)
+      analyzedModule.erase();
+    else
+      runPassPipeline(passPipelineConfig, moduleOp);
     // We need to run resource counting preprocessing after the pass pipeline as
     // the pre-processing might change the IR structure (may interfere with
     // other passes).
+    staticResourceCount = false;
     if (executionContext && executionContext->name == "resource-count") {
       // Each pass may run in a separate thread, so we have to make sure to
       // grab this reference in this thread
       auto resource_counts = nvqir::getResourceCounts();
+      // Kernels with static control flow are counted without executing them.
+      opt::ResourceEstimation estimation(epFunc);
+      if (const auto &resources = estimation.getResources()) {
+        CUDAQ_INFO("Estimated the resources of {} at compilation time.",
+                   kernelName);
+        for (const auto &[gate, count] : resources->gateCounts)
+          resource_counts->appendInstruction(gate.first, gate.second, count);
+        resource_counts->addQubit(resources->numQubits);
+        if (resources->depth)
+          resource_counts->setDepth(*resources->depth);
+        staticResourceCount = true;
+      }
+    }
+    if (executionContext && executionContext->name == "resource-count" &&
+        !staticResourceCount) {
+      auto resource_counts = nvqir::getResourceCounts();
       std::function<void(std::string, size_t, size_t)> f =
           [&](std::string gate, size_t nControls, size_t count) {
             CUDAQ_INFO("Appending: {}", gate);
@@ -612,6 +938,7 @@ public:
       pm.addPass(mlir::createCanonicalizerPass());
       if (enablePrintMLIREachPass)
         pm.enableIRPrinting();
+      cudaq::profiler::instrumentPasses(pm);
       if (failed(pm.run(moduleOp)))
         throw std::runtime_error(
             "Could not successfully apply resource count preprocess.");
@@ -647,9 +974,30 @@ public:
       mapping_reorder_idx.clear();
       runPassPipeline("canonicalize,cse", moduleOp);
       cudaq::spin_op &spin = executionContext->spin.value();
-      for (const auto &term : spin) {
-        if (term.is_identity())
-          continue;
+      auto measuredTerms = cudaq::spin_op::empty();
+      for (const auto &term : spin)
+        if (!term.is_identity())
+          measuredTerms += term;
+
+      // Measure each group of qubit-wise commuting terms with a single
+      // circuit, named after the term id of the group measurement basis. The
+      // counts are split up per term when the observe result is assembled
+      // (see cudaq::details::expand_group_results).
+      std::vector<cudaq::spin_op> groups;
+      if (getEnvBool("CUDAQ_OBSERVE_GROUP_TERMS", true))
+        groups = measuredTerms.group_commuting();
+      else
+        for (const auto &term : measuredTerms)
+          groups.emplace_back(term);
+
+      for (const auto &group : groups) {
+        auto basis = cudaq::spin_op::identity();
+        std::set<std::size_t> basisQubits;
+        for (const auto &term : group)
+          for (const auto &op : term)
+            if (op.as_pauli() != cudaq::pauli::I &&
+                basisQubits.insert(op.target()).second)
+              basis *= cudaq::spin_op_term(cudaq::spin_handler(op));
 
         // Get the ansatz
         [[maybe_unused]] auto ansatz =
@@ -665,11 +1013,12 @@ public:
         mlir::PassManager pm(contextPtr);
         pm.addNestedPass<mlir::func::FuncOp>(
             cudaq::opt::createObserveAnsatzPass(
-                term.get_binary_symplectic_form()));
+                basis.get_binary_symplectic_form()));
         if (disableMLIRthreading || enablePrintMLIREachPass)
           tmpModuleOp.getContext()->disableMultithreading();
         if (enablePrintMLIREachPass)
           pm.enableIRPrinting();
+        cudaq::profiler::instrumentPasses(pm);
         if (failed(pm.run(tmpModuleOp)))
           throw std::runtime_error("Could not apply measurements to ansatz.");
         // The full pass pipeline was run above, but the ansatz pass can
@@ -682,14 +1031,15 @@ public:
             runPassPipeline(pass, tmpModuleOp);
         if (!emulate && combineMeasurements)
           runPassPipeline("func.func(combine-measurements)", tmpModuleOp);
-        modules.emplace_back(term.get_term_id(), tmpModuleOp);
+        modules.emplace_back(basis.get_term_id(), tmpModuleOp);
       }
     } else {
       modules.emplace_back(kernelName, moduleOp);
     }
 
-    if (emulate ||
-        (executionContext && executionContext->name == "resource-count")) {
+    if (emulate || (executionContext &&
+                    executionContext->name == "resource-count" &&
+                    !staticResourceCount)) {
       // If we are in emulation mode, we need to first get a full QIR
       // representation of the code. Then we'll map to an LLVM Module, create a
       // JIT ExecutionEngine pointer and use that for execution
@@ -731,9 +1081,20 @@ public:
       nlohmann::json j =
           formOutputNames(codegenTranslation, moduleOpI, codeStr);
 
-      codes.emplace_back(name, codeStr, j, mapping_reorder_idx);
+      // The payload can be large, move it instead of copying it.
+      codes.emplace_back(name, std::move(codeStr), j, mapping_reorder_idx);
     }
 
+    if (!loweringKey.empty()) {
+      LoweringCacheEntry entry{codes};
+      if (emulate) {
+        entry.jitEngines = jitEngines;
+        entry.hasConditionalsOnMeasureResults = hasConditionalsOnMeasure;
+      }
+      storeLoweringCache(loweringKey, std::move(entry));
+      if (kernelArchive)
+        kernelArchive->add(loweringKey, codes);
+    }
     return codes;
   }
 
@@ -854,16 +1215,21 @@ public:
     // the circuit. If so, perform the trace here and then return.
     if (executionContext->name == "tracer" && jitEngines.size() == 1) {
       cudaq::getExecutionManager()->setExecutionContext(executionContext);
-      invokeJITKernelAndRelease(jitEngines[0], kernelName);
+      invokeJITKernel(jitEngines[0].get(), kernelName);
       cudaq::getExecutionManager()->resetExecutionContext();
       jitEngines.clear();
       return;
     }
 
     if (executionContext->name == "resource-count") {
+      if (staticResourceCount) {
+        staticResourceCount = false;
+        jitEngines.clear();
+        return;
+      }
       assert(jitEngines.size() == 1);
       cudaq::getExecutionManager()->setExecutionContext(executionContext);
-      invokeJITKernelAndRelease(jitEngines[0], kernelName);
+      invokeJITKernel(jitEngines[0].get(), kernelName);
       cudaq::getExecutionManager()->resetExecutionContext();
       jitEngines.clear();
       return;
@@ -921,14 +1287,21 @@ public:
 
               // If not executed via cudaq::run, we populate `counts` one shot
               // at a time.
+              // The shots are executed as the iterations of a batch, so that
+              // the simulator resets its state between shots instead of
+              // reallocating it.
               cudaq::sample_result counts;
               for (std::size_t shot = 0; shot < localShots; shot++) {
                 cudaq::ExecutionContext context("sample", 1);
                 context.hasConditionalsOnMeasureResults = true;
+                if (localShots > 1) {
+                  context.batchIteration = shot;
+                  context.totalIterations = localShots;
+                }
                 if (!isRun)
                   cudaq::getExecutionManager()->setExecutionContext(&context);
 
-                invokeJITKernel(localJIT[0], kernelName);
+                invokeJITKernel(localJIT[0].get(), kernelName);
                 if (!isRun) {
                   cudaq::getExecutionManager()->resetExecutionContext();
                   counts += context.result;
@@ -955,7 +1328,7 @@ public:
                 cudaq::ExecutionContext context("sample", localShots);
                 context.reorderIdx = reorderIdx;
                 cudaq::getExecutionManager()->setExecutionContext(&context);
-                invokeJITKernel(localJIT[i], kernelName);
+                invokeJITKernel(localJIT[i].get(), kernelName);
                 cudaq::getExecutionManager()->resetExecutionContext();
 
                 if (isObserve) {
@@ -975,10 +1348,8 @@ public:
               }
             }
 
-            // Clean up the JIT engines. This functor owns these engine
-            // instances.
-            for (auto *jitEngine : localJIT)
-              delete jitEngine;
+            // Release the JIT engines. They are still owned by the lowering
+            // cache if they were cached.
             localJIT.clear();
             return cudaq::sample_result(results);
           }));
@@ -995,8 +1366,30 @@ public:
           : isObserve ? cudaq::details::ExecutionContextType::observe
                       : cudaq::details::ExecutionContextType::sample;
 
-      future = executor->execute(codes, execType,
-                                 &executionContext->invocationResultBuffer);
+      // Identical sampling jobs, e.g., when rerunning a program, may reuse a
+      // cached result rather than being submitted again.
+      if (resultCache &&
+          execType == cudaq::details::ExecutionContextType::sample) {
+        auto key = getResultCacheKey(codes, localShots);
+        if (auto cached = resultCache->load(key)) {
+          CUDAQ_INFO("Using the cached result of {} for {}.", qpuName,
+                     kernelName);
+          std::promise<cudaq::sample_result> promise;
+          promise.set_value(std::move(*cached));
+          future = cudaq::details::future(promise.get_future());
+        } else {
+          future = executor->execute(codes, execType,
+                                     &executionContext->invocationResultBuffer);
+          if (!executionContext->asyncExec) {
+            executionContext->result = future.get();
+            resultCache->store(key, executionContext->result);
+            return;
+          }
+        }
+      } else {
+        future = executor->execute(codes, execType,
+                                   &executionContext->invocationResultBuffer);
+      }
     }
 
     // Keep this asynchronous if requested
@@ -11,8 +11,10 @@
 #include "common/ArgumentConversion.h"
 #include "common/ExecutionContext.h"
 #include "common/Logger.h"
+#include "common/RemoteEndpointPool.h"
 #include "common/RemoteKernelExecutor.h"
 #include "common/Resources.h"
+#include "common/RestClient.h"
 #include "common/RuntimeMLIR.h"
 #include "cudaq.h"
 #include "cudaq/Optimizer/Builder/Runtime.h"
@@ -38,6 +40,30 @@ protected:
   std::unique_ptr<mlir::MLIRContext> m_mlirContext;
   std::unique_ptr<RemoteRuntimeClient> m_client;
   bool in_resource_estimation = false;
+  /// The endpoints of the platform this QPU fails over to, if any, and the
+  /// index of the endpoint of `m_client` among them.
+  std::shared_ptr<RemoteEndpointPool> m_endpoints;
+  std::size_t m_endpoint = 0;
+  /// The clients of the other endpoints, created on the first failover.
+  std::unordered_map<std::size_t, std::unique_ptr<RemoteRuntimeClient>>
+      m_failoverClients;
+  std::optional<std::size_t> m_randomSeed;
+  std::mutex m_failoverMutex;
+
+  /// @brief Return the client of the given endpoint.
+  RemoteRuntimeClient &getEndpointClient(std::size_t endpoint) {
+    if (endpoint == m_endpoint)
+      return *m_client;
+    std::scoped_lock<std::mutex> lock(m_failoverMutex);
+    auto &client = m_failoverClients[endpoint];
+    if (!client) {
+      client = registry::get<RemoteRuntimeClient>("rest");
+      client->setConfig({{"url", m_endpoints->getUrl(endpoint)}});
+      if (m_randomSeed)
+        client->resetRemoteRandomSeed(*m_randomSeed);
+    }
+    return *client;
+  }
 
   /// @brief Return a pointer to the execution context for this thread. It will
   /// return `nullptr` if it was not found in `m_contexts`.
@@ -73,12 +99,71 @@ public:
     if (parts.size() % 2 != 0)
       throw std::invalid_argument("Unexpected backend configuration string. "
                                   "Expecting a ';'-separated key-value pairs.");
+    std::string url;
+    std::vector<std::string> endpoints;
     for (std::size_t i = 0; i < parts.size(); i += 2) {
-      if (parts[i] == "url")
-        m_client->setConfig({{"url", parts[i + 1]}});
+      if (parts[i] == "url") {
+        url = parts[i + 1];
+        m_client->setConfig({{"url", url}});
+      }
       if (parts[i] == "simulator")
         m_simName = parts[i + 1];
+      if (parts[i] == "endpoints")
+        endpoints = split(parts[i + 1], ',');
+    }
+
+    // Fail over to the other endpoints of the platform when the server of
+    // this QPU does not respond.
+    const auto iter = std::find(endpoints.begin(), endpoints.end(), url);
+    if (endpoints.size() < 2 || iter == endpoints.end())
+      return;
+    std::chrono::seconds retryInterval(10);
+    if (auto *envVal = std::getenv("CUDAQ_REMOTE_HEALTH_CHECK_INTERVAL"))
+      retryInterval = std::chrono::seconds(std::stoi(envVal));
+    m_endpoints = RemoteEndpointPool::getShared(
+        endpoints,
+        [](const std::string &url) {
+          // Servers respond to a ping on their root path.
+          RestClient restClient;
+          std::map<std::string, std::string> headers;
+          restClient.get(url, "", headers);
+          return true;
+        },
+        retryInterval);
+    m_endpoint = iter - endpoints.begin();
+  }
+
+  // A QPU whose server does not respond is not selected for new tasks.
+  bool isAvailable() const override {
+    return !m_endpoints || m_endpoints->isAvailable(m_endpoint);
+  }
+
+  /// @brief A request sent through the given client, which returns false and
+  /// sets the error message if it fails.
+  using RequestSender =
+      std::function<bool(RemoteRuntimeClient &client, std::string *errorMsg)>;
+
+  /// @brief Send a request to the server of this QPU if it responds, or else
+  /// to the server with the fewest requests in flight among the others that
+  /// respond. Return false if the request failed on a server that responds,
+  /// or if no server responds.
+  bool sendWithFailover(const RequestSender &send, std::string *errorMsg) {
+    if (!m_endpoints)
+      return send(*m_client, errorMsg);
+    std::vector<std::size_t> failedEndpoints;
+    while (auto endpoint =
+               m_endpoints->acquire(m_endpoint, failedEndpoints)) {
+      const bool okay = send(getEndpointClient(*endpoint), errorMsg);
+      if (m_endpoints->release(*endpoint, /*failed=*/!okay) || okay)
+        return okay;
+      CUDAQ_WARN("Remote server {} of QPU {} does not respond, failing over "
+                 "to another server.",
+                 m_endpoints->getUrl(*endpoint), qpu_id);
+      failedEndpoints.push_back(*endpoint);
     }
+    if (errorMsg && failedEndpoints.empty())
+      *errorMsg = "None of the remote servers responds.";
+    return false;
   }
 
   void enqueue(QuantumTask &task) override {
@@ -101,9 +186,13 @@ public:
       ctx->shots = shots;
 
     std::string errorMsg;
-    const bool requestOkay = m_client->sendRequest(
-        *m_mlirContext, *executionContextPtr, gradient, &optimizer, n_params,
-        m_simName, name, /*kernelFunc=*/nullptr, kernelArgs, /*argSize=*/0,
+    const bool requestOkay = sendWithFailover(
+        [&](RemoteRuntimeClient &client, std::string *errorMsg) {
+          return client.sendRequest(*m_mlirContext, *executionContextPtr,
+                                    gradient, &optimizer, n_params, m_simName,
+                                    name, /*kernelFunc=*/nullptr, kernelArgs,
+                                    /*argSize=*/0, errorMsg);
+        },
         &errorMsg);
     if (!requestOkay)
       throw std::runtime_error("Failed to launch VQE. Error: " + errorMsg);
@@ -208,11 +297,16 @@ public:
           kernelHasConditionalFeedback(name);
 
     std::string errorMsg;
-    const bool requestOkay = m_client->sendRequest(
-        *m_mlirContext, executionContext,
-        /*vqe_gradient=*/nullptr, /*vqe_optimizer=*/nullptr, /*vqe_n_params=*/0,
-        m_simName, name, make_degenerate_kernel_type(kernelFunc), args,
-        voidStarSize, &errorMsg, rawArgs, prefabMod);
+    const bool requestOkay = sendWithFailover(
+        [&](RemoteRuntimeClient &client, std::string *errorMsg) {
+          return client.sendRequest(
+              *m_mlirContext, executionContext,
+              /*vqe_gradient=*/nullptr, /*vqe_optimizer=*/nullptr,
+              /*vqe_n_params=*/0, m_simName, name,
+              make_degenerate_kernel_type(kernelFunc), args, voidStarSize,
+              errorMsg, rawArgs, prefabMod);
+        },
+        &errorMsg);
     if (!requestOkay)
       throw std::runtime_error("Failed to launch kernel. Error: " + errorMsg);
     if (isDirectInvocation &&
@@ -257,6 +351,10 @@ public:
 
   void onRandomSeedSet(std::size_t seed) override {
     m_client->resetRemoteRandomSeed(seed);
+    std::scoped_lock<std::mutex> lock(m_failoverMutex);
+    m_randomSeed = seed;
+    for (auto &[endpoint, client] : m_failoverClients)
+      client->resetRemoteRandomSeed(seed);
   }
 };
 
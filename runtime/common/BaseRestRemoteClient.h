@@ -12,6 +12,7 @@
 #include "common/Environment.h"
 #include "common/JsonConvert.h"
 #include "common/Logger.h"
+#include "common/PassProfiler.h"
 #include "common/RemoteKernelExecutor.h"
 #include "common/RestClient.h"
 #include "common/RuntimeMLIR.h"
@@ -44,6 +45,7 @@
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Pass/PassRegistry.h"
 #include "mlir/Transforms/Passes.h"
+#include <bit>
 #include <cxxabi.h>
 #include <dlfcn.h>
 #include <fstream>
@@ -205,6 +207,7 @@ public:
         moduleOp.getContext()->disableMultithreading();
         pm.enableIRPrinting();
       }
+      cudaq::profiler::instrumentPasses(pm);
       if (failed(pm.run(moduleOp)))
         throw std::runtime_error("Could not successfully apply " + passName +
                                  " synth.");
@@ -243,6 +246,7 @@ public:
           "Remote rest platform failed to add passes to pipeline (" + errMsg +
           ").");
 
+    cudaq::profiler::instrumentPasses(pm);
     mlir::DefaultTimingManager tm;
     tm.setEnabled(cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES));
     auto timingScope = tm.getRootScope(); // starts the timer
@@ -301,6 +305,7 @@ public:
     // For now, the server side expects full-QIR.
     opt::addAOTPipelineConvertToQIR(pm);
 
+    cudaq::profiler::instrumentPasses(pm);
     if (failed(pm.run(moduleOp)))
       throw std::runtime_error(
           "Remote rest platform: applying IR passes failed.");
@@ -454,6 +459,13 @@ public:
     //  Ref: https://gms.tf/when-curl-sends-100-continue.html
     std::map<std::string, std::string> headers{
         {"Expect:", ""}, {"Content-type", "application/json"}};
+    // Ask for the binary wire format, which carries state vectors as raw
+    // little-endian buffers rather than JSON arrays. Servers that do not
+    // support it reply in JSON.
+    if (std::endian::native == std::endian::little &&
+        getEnvBool("CUDAQ_CLIENT_BINARY_PAYLOAD", true))
+      headers["Accept"] =
+          std::string(cudaq::BinaryPayloadMediaType) + ", application/json";
     json requestJson = request;
     try {
       cudaq::RestClient restClient;
@@ -22,6 +22,7 @@
 #include <aws/sts/STSClient.h>
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <regex>
 #include <string>
@@ -31,26 +32,43 @@ namespace cudaq {
 /// @brief The Executor subclass for Amazon Braket
 class BraketExecutor : public Executor {
 protected:
-  Aws::SDKOptions options;
-
+  /// @brief Initializes the AWS SDK and shuts it down on destruction. The SDK
+  /// is initialized once for all the executors alive at the same time.
   class ScopedApi {
-    Aws::SDKOptions &options;
+    Aws::SDKOptions options;
 
   public:
-    ScopedApi(Aws::SDKOptions &options) : options(options) {
+    ScopedApi() {
       CUDAQ_DBG("Initializing AWS API");
       /// FIXME: Allow setting following flag via CUDA-Q frontend
       // options.loggingOptions.logLevel = Aws::Utils::Logging::LogLevel::Debug;
       Aws::InitAPI(options);
     }
     ~ScopedApi() { Aws::ShutdownAPI(options); }
+
+    /// @brief Return the initialized SDK, initializing it if needed.
+    static std::shared_ptr<ScopedApi> acquire();
   };
 
-  ScopedApi api;
+  /// @brief The clients of the AWS services used by the executor. The clients
+  /// are thread-safe and reused by all the executors targeting the same region
+  /// with the same concurrency.
+  struct Clients {
+    /// @brief Keep the SDK alive as long as the clients.
+    std::shared_ptr<ScopedApi> api;
+    std::unique_ptr<Aws::Braket::BraketClient> braket;
+    std::unique_ptr<Aws::STS::STSClient> sts;
+    std::unique_ptr<Aws::S3Crt::S3CrtClient> s3;
 
-  std::unique_ptr<Aws::Braket::BraketClient> braketClientPtr;
-  std::unique_ptr<Aws::STS::STSClient> stsClientPtr;
-  std::unique_ptr<Aws::S3Crt::S3CrtClient> s3ClientPtr;
+    /// @brief Return the clients for the given region, creating them if no
+    /// executor uses them. At most \p maxConcurrentRequests requests of each
+    /// client are in flight at the same time.
+    static std::shared_ptr<Clients> acquire(const std::string &region,
+                                            std::size_t maxConcurrentRequests);
+  };
+
+  std::shared_ptr<ScopedApi> api;
+  std::shared_ptr<Clients> clients;
 
   std::shared_future<std::string> defaultBucketFuture;
   char const *jobToken;
@@ -58,6 +76,10 @@ protected:
 
   std::chrono::microseconds pollingInterval = std::chrono::milliseconds{2000};
 
+  /// @brief The maximum number of concurrent requests to each AWS service,
+  /// e.g., task creations or result downloads.
+  std::size_t maxConcurrentRequests = 16;
+
   /// @brief Utility function to check the type of ServerHelper and use it to
   /// create job
   virtual ServerJobPayload
@@ -90,11 +90,20 @@ cudaq::parseCodeGenTranslation(const std::string &codegenTranslation) {
       } else if (option == "allow_all_instructions") {
         cudaq::info("Enable all instructions");
         config.allowAllInstructions = true;
+      } else if (option == "packed_records") {
+        cudaq::info("Enable packed output records");
+        config.packedRecords = true;
       } else {
         throw std::runtime_error(fmt::format(
             "Invalid option '{}' for '{}' codegen.", option, codeGenName));
       }
     }
+    // The booleans are packed into integers by the kernel itself.
+    if (config.packedRecords && !config.integerComputations)
+      throw std::runtime_error(fmt::format(
+          "Invalid codegen-emission '{}'. The 'packed_records' option requires "
+          "'int_computations'.",
+          codegenTranslation));
   } else {
     if (!codeGenOptions.empty())
       throw std::runtime_error(
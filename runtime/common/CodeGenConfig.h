@@ -48,6 +48,8 @@ struct CodeGenConfig {
   // True if we should bypass instruction validation, i.e., allow all
   // instructions.
   bool allowAllInstructions = false;
+  // True if arrays of booleans should be output as packed integer records.
+  bool packedRecords = false;
 };
 
 /// @brief Helper to parse `codegen` translation, with optional feature
@@ -7,6 +7,8 @@
  ******************************************************************************/
 
 #include "CustomOp.h"
+#include <cstring>
+#include <stdexcept>
 
 namespace cudaq {
 customOpRegistry &customOpRegistry::getInstance() {
@@ -15,6 +17,10 @@ customOpRegistry &customOpRegistry::getInstance() {
 }
 
 void customOpRegistry::clearRegisteredOperations() {
+  {
+    std::unique_lock<std::shared_mutex> lock(cacheMtx);
+    unitaryCache.clear();
+  }
   std::unique_lock<std::shared_mutex> lock(mtx);
   registeredOperations.clear();
 }
@@ -33,4 +39,67 @@ customOpRegistry::getOperation(const std::string &name) {
   }
   return *iter->second;
 }
+
+std::shared_ptr<const cached_unitary>
+customOpRegistry::getUnitary(const std::string &name,
+                             const std::vector<double> &parameters) {
+  // The key is the name followed by the bits of the parameters, so that
+  // parameters only match if they are identical.
+  std::string key = name;
+  key.push_back('\0');
+  const auto offset = key.size();
+  key.resize(offset + parameters.size() * sizeof(double));
+  if (!parameters.empty())
+    std::memcpy(key.data() + offset, parameters.data(),
+                parameters.size() * sizeof(double));
+
+  {
+    std::shared_lock<std::shared_mutex> lock(cacheMtx);
+    auto iter = unitaryCache.find(key);
+    if (iter != unitaryCache.end()) {
+      iter->second.referenced.store(true, std::memory_order_relaxed);
+      return iter->second.unitary;
+    }
+  }
+
+  auto unitary = std::make_shared<cached_unitary>();
+  unitary->fp64 = getOperation(name).unitary(parameters);
+  unitary->fp32.assign(unitary->fp64.begin(), unitary->fp64.end());
+
+  std::unique_lock<std::shared_mutex> lock(cacheMtx);
+  if (unitaryCacheCapacity == 0)
+    return unitary;
+  if (unitaryCache.size() >= unitaryCacheCapacity)
+    evictUnitaries();
+  auto [iter, inserted] = unitaryCache.try_emplace(std::move(key));
+  if (inserted)
+    iter->second.unitary = std::move(unitary);
+  return iter->second.unitary;
+}
+
+void customOpRegistry::evictUnitaries() {
+  std::size_t evicted = 0;
+  for (auto iter = unitaryCache.begin(); iter != unitaryCache.end();) {
+    if (!iter->second.referenced.exchange(false, std::memory_order_relaxed)) {
+      iter = unitaryCache.erase(iter);
+      ++evicted;
+    } else {
+      ++iter;
+    }
+  }
+  // Every entry was referenced since the last sweep, make room regardless.
+  while (!evicted && !unitaryCache.empty() &&
+         unitaryCache.size() >= unitaryCacheCapacity) {
+    unitaryCache.erase(unitaryCache.begin());
+  }
+}
+
+void customOpRegistry::setUnitaryCacheCapacity(std::size_t capacity) {
+  std::unique_lock<std::shared_mutex> lock(cacheMtx);
+  unitaryCacheCapacity = capacity;
+  if (capacity == 0)
+    unitaryCache.clear();
+  while (unitaryCache.size() > capacity)
+    evictUnitaries();
+}
 } // namespace cudaq
@@ -8,11 +8,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <complex>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -28,6 +31,24 @@ struct unitary_operation {
   virtual ~unitary_operation() {}
 };
 
+/// @brief The unitary of a custom operation for a given set of parameters, as
+/// a row-major 1D array in both simulation precisions.
+struct cached_unitary {
+  std::vector<std::complex<double>> fp64;
+  std::vector<std::complex<float>> fp32;
+
+  /// @brief Return the copy of the unitary in the given precision.
+  template <typename ScalarType>
+  const std::vector<std::complex<ScalarType>> &get() const {
+    static_assert(std::is_same_v<ScalarType, double> ||
+                  std::is_same_v<ScalarType, float>);
+    if constexpr (std::is_same_v<ScalarType, double>)
+      return fp64;
+    else
+      return fp32;
+  }
+};
+
 /// @brief Singleton class for managing and storing unitary operations.
 class customOpRegistry {
 public:
@@ -67,7 +88,39 @@ public:
   /// This will throw an exception if the operation is not registered.
   const unitary_operation &getOperation(const std::string &name);
 
+  /// Get the unitary of the operation with the given name for the given
+  /// parameters. Unitaries are cached by operation name and parameter values,
+  /// so that applying an operation repeatedly with the same parameters does
+  /// not recompute its matrix. This will throw an exception if the operation
+  /// is not registered.
+  std::shared_ptr<const cached_unitary>
+  getUnitary(const std::string &name, const std::vector<double> &parameters);
+
+  /// The default number of unitaries kept in the cache.
+  static constexpr std::size_t defaultUnitaryCacheCapacity = 1024;
+
+  /// Set the number of unitaries kept in the cache, 0 disables caching.
+  void setUnitaryCacheCapacity(std::size_t capacity);
+
 private:
+  /// @brief A cached unitary. The `referenced` flag is set by lookups, which
+  /// only hold a shared lock, and cleared by the eviction sweep.
+  struct UnitaryCacheEntry {
+    std::shared_ptr<const cached_unitary> unitary;
+    std::atomic<bool> referenced = false;
+  };
+
+  /// @brief Evict the entries not referenced since the last sweep, an
+  /// approximation of least-recently-used eviction that keeps lookups free of
+  /// writes to shared structures. Requires the unique lock.
+  void evictUnitaries();
+
+  /// @brief The cache of unitaries, keyed by operation name and parameters.
+  std::unordered_map<std::string, UnitaryCacheEntry> unitaryCache;
+  std::size_t unitaryCacheCapacity = defaultUnitaryCacheCapacity;
+  /// @brief Mutex to protect concurrent access to the unitary cache.
+  std::shared_mutex cacheMtx;
+
   /// @brief Keep track of a registry of user-provided unitary operations.
   std::unordered_map<std::string, std::unique_ptr<cudaq::unitary_operation>>
       registeredOperations;
@@ -8,13 +8,16 @@
 
 #include "common/Logger.h"
 #include "cudaq.h"
+#include <deque>
 #include <map>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // Shared mutex to guard concurrent access to global kernel data (e.g.,
-// `quakeRegistry`, `kernelRegistry`, `argsCreators`, `lambdaNames`).
+// `kernelTable`, `kernelRegistry`, `argsCreators`, `lambdaNames`).
 // These global variables might be accessed (write or read) concurrently, e.g.,
 // async. execution of kernels or via CUDA Quantum API (e.g.,
 // `get_quake_by_name`). Note: currently, we use a single mutex for all static
@@ -26,21 +29,124 @@ static std::shared_mutex globalRegistryMutex;
 // Registry that maps device code keys to strings of device code. The map is
 // created at program startup and can be used to find code to be
 // compiled/executed at runtime.
+//
+// Each key is interned when it is registered: it is assigned the next integer
+// id, which indexes a flat table holding the code and the facts the launch path
+// needs about it. The string API resolves a name to an id once and caches the
+// resolution, so repeated launches of a kernel do not scan the registry.
 //===----------------------------------------------------------------------===//
 
-static std::vector<std::pair<std::string, std::string>> quakeRegistry;
+namespace {
+struct KernelRecord {
+  std::string key;
+  std::string code;
+  bool hasConditionalFeedback = false;
+};
+} // namespace
+
+// A deque keeps references to the records stable as kernels are added.
+static std::deque<KernelRecord> kernelTable;
+static std::unordered_map<std::string, cudaq::registry::KernelId> kernelIds;
+// Cache of names (with optional mangled arguments) resolved to an unambiguous
+// kernel id. It is cleared when a kernel is added, since a new key may make a
+// prefix ambiguous.
+static std::unordered_map<std::string, cudaq::registry::KernelId>
+    resolvedNames;
+
+static bool codeHasConditionalFeedback(const std::string &code) {
+  return code.find("qubitMeasurementFeedback = true") != std::string::npos;
+}
 
 void cudaq::registry::__cudaq_deviceCodeHolderAdd(const char *key,
                                                   const char *code) {
   std::unique_lock<std::shared_mutex> lock(globalRegistryMutex);
-  auto it = std::find_if(quakeRegistry.begin(), quakeRegistry.end(),
-                         [&](const auto &pair) { return pair.first == key; });
-  if (it != quakeRegistry.end()) {
+  auto it = kernelIds.find(key);
+  if (it != kernelIds.end()) {
     CUDAQ_INFO("Replacing code for kernel {}", key);
-    it->second = code;
+    auto &record = kernelTable[it->second];
+    record.code = code;
+    record.hasConditionalFeedback = codeHasConditionalFeedback(record.code);
     return;
   }
-  quakeRegistry.emplace_back(key, code);
+  kernelIds.emplace(key, kernelTable.size());
+  auto &record = kernelTable.emplace_back();
+  record.key = key;
+  record.code = code;
+  record.hasConditionalFeedback = codeHasConditionalFeedback(record.code);
+  resolvedNames.clear();
+}
+
+namespace {
+enum class Resolution { Found, Ambiguous, NotFound };
+} // namespace
+
+// Resolve \p kernelName to a kernel id. An exact match of the key wins.
+// Otherwise the name is a prefix, with a '.' before the C++ mangled name
+// suffix, which must be unique. The caller must hold `globalRegistryMutex`.
+static Resolution
+resolveKernelId(const std::string &kernelName,
+                const std::optional<std::string> &knownMangledArgs,
+                cudaq::registry::KernelId &id) {
+  if (auto it = kernelIds.find(kernelName); it != kernelIds.end()) {
+    id = it->second;
+    return Resolution::Found;
+  }
+
+  auto kernelNamePrefix = kernelName + '.';
+  bool found = false;
+  for (cudaq::registry::KernelId i = 0, e = kernelTable.size(); i != e; ++i) {
+    const auto &key = kernelTable[i].key;
+    if (!key.starts_with(kernelNamePrefix))
+      continue;
+    // Prefix match. Record it and make sure that it is a unique prefix.
+    if (found)
+      return Resolution::Ambiguous;
+    found = true;
+    id = i;
+    if (knownMangledArgs.has_value() && key.ends_with(*knownMangledArgs))
+      break;
+  }
+  return found ? Resolution::Found : Resolution::NotFound;
+}
+
+std::optional<cudaq::registry::KernelId>
+cudaq::registry::getKernelId(const std::string &kernelName,
+                             std::optional<std::string> knownMangledArgs) {
+  auto cacheKey = kernelName;
+  if (knownMangledArgs.has_value())
+    cacheKey += '\n' + *knownMangledArgs;
+  {
+    std::shared_lock<std::shared_mutex> lock(globalRegistryMutex);
+    if (auto it = resolvedNames.find(cacheKey); it != resolvedNames.end())
+      return it->second;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(globalRegistryMutex);
+  KernelId id = 0;
+  switch (resolveKernelId(kernelName, knownMangledArgs, id)) {
+  case Resolution::Found:
+    resolvedNames.emplace(std::move(cacheKey), id);
+    return id;
+  case Resolution::Ambiguous:
+    throw std::runtime_error("Quake code for '" + kernelName +
+                             "' has multiple matches.\n");
+  case Resolution::NotFound:
+    break;
+  }
+  return std::nullopt;
+}
+
+std::string cudaq::registry::getQuakeCode(KernelId id) {
+  std::shared_lock<std::shared_mutex> lock(globalRegistryMutex);
+  if (id >= kernelTable.size())
+    throw std::runtime_error("kernel id " + std::to_string(id) +
+                             " is not registered");
+  return kernelTable[id].code;
+}
+
+bool cudaq::registry::hasConditionalFeedback(KernelId id) {
+  std::shared_lock<std::shared_mutex> lock(globalRegistryMutex);
+  return id < kernelTable.size() && kernelTable[id].hasConditionalFeedback;
 }
 
 //===----------------------------------------------------------------------===//
@@ -50,16 +156,16 @@ void cudaq::registry::__cudaq_deviceCodeHolderAdd(const char *key,
 // including adding the trampoline to call the runtime to launch the kernel.
 //===----------------------------------------------------------------------===//
 
-static std::vector<std::string> kernelRegistry;
+static std::unordered_set<std::string> kernelRegistry;
 
-static std::map<std::string, cudaq::KernelArgsCreator> argsCreators;
+static std::unordered_map<std::string, cudaq::KernelArgsCreator> argsCreators;
 static std::map<std::string, std::string> lambdaNames;
 static std::map<void *, std::pair<const char *, void *>> linkableKernelRegistry;
-static std::map<std::string, void *> runnableKernelRegistry;
+static std::unordered_map<std::string, void *> runnableKernelRegistry;
 
 void cudaq::registry::cudaqRegisterKernelName(const char *kernelName) {
   std::unique_lock<std::shared_mutex> lock(globalRegistryMutex);
-  kernelRegistry.emplace_back(kernelName);
+  kernelRegistry.emplace(kernelName);
 }
 
 void cudaq::registry::__cudaq_registerRunnableKernel(const char *kernelName,
@@ -69,6 +175,7 @@ void cudaq::registry::__cudaq_registerRunnableKernel(const char *kernelName,
 }
 
 void *cudaq::registry::getRunnableKernelOrNull(const std::string &kernelName) {
+  std::shared_lock<std::shared_mutex> lock(globalRegistryMutex);
   auto iter = runnableKernelRegistry.find(kernelName);
   return (iter != runnableKernelRegistry.end()) ? iter->second : nullptr;
 }
@@ -139,8 +246,7 @@ void cudaq::registry::cudaqRegisterLambdaName(const char *name,
 
 bool cudaq::detail::isKernelGenerated(const std::string &kernelName) {
   std::shared_lock<std::shared_mutex> lock(globalRegistryMutex);
-  return std::find(kernelRegistry.begin(), kernelRegistry.end(), kernelName) !=
-         kernelRegistry.end();
+  return kernelRegistry.contains(kernelName);
 }
 
 bool cudaq::__internal__::isLibraryMode(const std::string &kernelname) {
@@ -152,43 +258,30 @@ bool cudaq::__internal__::isLibraryMode(const std::string &kernelname) {
 namespace cudaq {
 
 KernelArgsCreator getArgsCreator(const std::string &kernelName) {
-  std::unique_lock<std::shared_mutex> lock(globalRegistryMutex);
-  return argsCreators[kernelName];
+  std::shared_lock<std::shared_mutex> lock(globalRegistryMutex);
+  auto iter = argsCreators.find(kernelName);
+  return iter != argsCreators.end() ? iter->second : nullptr;
 }
 
 std::string get_quake_by_name(const std::string &kernelName,
                               bool throwException,
                               std::optional<std::string> knownMangledArgs) {
-  // A prefix name has a '.' before the C++ mangled name suffix.
-  auto kernelNamePrefix = kernelName + '.';
-
-  // Find the quake code
-  std::optional<std::string> result;
-  std::shared_lock<std::shared_mutex> lock(globalRegistryMutex);
-
-  for (const auto &pair : quakeRegistry) {
-    if (pair.first == kernelName) {
-      // Exact match. Return the code.
-      return pair.second;
-    }
-
-    if (pair.first.starts_with(kernelNamePrefix)) {
-      // Prefix match. Record it and make sure that it is a unique prefix.
-      if (result.has_value()) {
-        if (throwException)
-          throw std::runtime_error("Quake code for '" + kernelName +
-                                   "' has multiple matches.\n");
-      } else {
-        result = pair.second;
-        if (knownMangledArgs.has_value() &&
-            pair.first.ends_with(*knownMangledArgs))
-          break;
-      }
-    }
+  std::optional<registry::KernelId> id;
+  try {
+    id = registry::getKernelId(kernelName, knownMangledArgs);
+  } catch (...) {
+    if (throwException)
+      throw;
+    // Ambiguous prefix. Fall back to the first match.
+    std::shared_lock<std::shared_mutex> lock(globalRegistryMutex);
+    auto kernelNamePrefix = kernelName + '.';
+    for (const auto &record : kernelTable)
+      if (record.key.starts_with(kernelNamePrefix))
+        return record.code;
   }
 
-  if (result.has_value())
-    return *result;
+  if (id.has_value())
+    return registry::getQuakeCode(*id);
   if (throwException)
     throw std::runtime_error("Quake code not found for '" + kernelName +
                              "'.\n");
@@ -206,8 +299,12 @@ std::string get_quake_by_name(const std::string &kernelName,
 }
 
 bool kernelHasConditionalFeedback(const std::string &kernelName) {
-  auto quakeCode = get_quake_by_name(kernelName, false);
-  return !quakeCode.empty() &&
-         quakeCode.find("qubitMeasurementFeedback = true") != std::string::npos;
+  std::optional<registry::KernelId> id;
+  try {
+    id = registry::getKernelId(kernelName);
+  } catch (...) {
+    return codeHasConditionalFeedback(get_quake_by_name(kernelName, false));
+  }
+  return id.has_value() && registry::hasConditionalFeedback(*id);
 }
 } // namespace cudaq
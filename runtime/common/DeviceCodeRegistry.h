@@ -42,6 +42,26 @@ void *__cudaq_getLinkableKernelDeviceFunction(std::intptr_t);
 /// compiler API as an `extern C` function.
 const char *getLinkableKernelNameOrNull(std::intptr_t);
 
+/// Integer id of a kernel whose device code is registered. Ids are assigned in
+/// registration order and stay valid for the lifetime of the program.
+using KernelId = std::size_t;
+
+/// Return the id of the kernel registered as \p kernelName, or as the unique
+/// key with the prefix `kernelName.`, which may be disambiguated with
+/// \p knownMangledArgs. Returns `std::nullopt` if there is no such kernel and
+/// throws if the prefix matches several kernels. Resolutions are cached, so
+/// repeated lookups of the same name are a single hash lookup.
+std::optional<KernelId>
+getKernelId(const std::string &kernelName,
+            std::optional<std::string> knownMangledArgs = std::nullopt);
+
+/// Return the Quake code of the kernel with id \p id.
+std::string getQuakeCode(KernelId id);
+
+/// Return true if the Quake code of the kernel with id \p id uses measurement
+/// results in conditional feedback. This is determined at registration.
+bool hasConditionalFeedback(KernelId id);
+
 /// Given the address of the host-side kernel function, determine the associated
 /// `runnable` kernel entry point.
 void *getRunnableKernelOrNull(const std::string &kernelName);
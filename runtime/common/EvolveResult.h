@@ -11,8 +11,14 @@
 #include "common/ObserveResult.h"
 #include "cudaq/operators.h"
 #include "cudaq/qis/state.h"
+#include <complex>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <stdexcept>
 
 namespace cudaq {
 
@@ -143,4 +149,69 @@ public:
   }
   evolve_result(const sample_result &sr) : sampling_result(sr) {}
 };
+
+/// @brief The results of one step of the schedule of an evolution, as received
+/// by an `evolve_sink`.
+struct evolve_step_result {
+  // Index of the evolution in a batched evolution, in the order of the
+  // returned `evolve_result` objects.
+  std::size_t batch_index = 0;
+  // Index of the step in the schedule.
+  std::size_t step_index = 0;
+  // Time of the step.
+  double time = 0.0;
+  // State vector or density matrix data, copied to host memory. In distributed
+  // mode, the data of the state held by this rank.
+  std::vector<std::complex<double>> state;
+  // Expectation values of the observables.
+  std::vector<double> expectation_values;
+};
+
+/// @brief Receives the results of every step of an evolution as they are
+/// produced.
+// The sink is called in order for each batch member, from a separate thread,
+// while the integration continues: the state data is copied out of device
+// memory on a separate CUDA stream. The results passed to a sink are not
+// stored in the `evolve_result` unless also requested with
+// `IntermediateResultSave`, so that long evolutions can stream their results,
+// e.g., to a file, and only keep the final state in memory.
+using evolve_sink = std::function<void(const evolve_step_result &)>;
+
+/// @brief An `evolve_sink` keeping the results of the last `capacity` steps of
+/// each batch member.
+// Copies of the sink share the same buffer, so that the results can be read
+// from the object that was passed to `evolve`.
+class ring_buffer_sink {
+  struct buffer {
+    std::size_t capacity;
+    std::map<std::size_t, std::deque<evolve_step_result>> results;
+    std::mutex mutex;
+  };
+  std::shared_ptr<buffer> m_buffer;
+
+public:
+  ring_buffer_sink(std::size_t capacity)
+      : m_buffer(std::make_shared<buffer>()) {
+    if (capacity == 0)
+      throw std::invalid_argument("ring_buffer_sink capacity must be positive");
+    m_buffer->capacity = capacity;
+  }
+
+  void operator()(const evolve_step_result &result) {
+    std::scoped_lock lock(m_buffer->mutex);
+    auto &results = m_buffer->results[result.batch_index];
+    if (results.size() == m_buffer->capacity)
+      results.pop_front();
+    results.push_back(result);
+  }
+
+  /// @brief Get the results of the last steps of a batch member, oldest first.
+  std::vector<evolve_step_result> get_results(std::size_t batch_index = 0) {
+    std::scoped_lock lock(m_buffer->mutex);
+    auto iter = m_buffer->results.find(batch_index);
+    if (iter == m_buffer->results.end())
+      return {};
+    return {iter->second.begin(), iter->second.end()};
+  }
+};
 } // namespace cudaq
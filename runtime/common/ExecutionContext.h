@@ -10,6 +10,7 @@
 
 #include "Future.h"
 #include "NoiseModel.h"
+#include "PerfCounters.h"
 #include "SampleResult.h"
 #include "Trace.h"
 #include "cudaq/algorithms/optimizer.h"
@@ -45,6 +46,11 @@ public:
   /// @brief The number of execution shots
   std::size_t shots = 0;
 
+  /// @brief The number of shots already collected by earlier executions of
+  /// the kernel when a simulator produces the requested shots over several
+  /// executions.
+  std::size_t shotsCompleted = 0;
+
   /// @brief An optional spin operator
   std::optional<cudaq::spin_op> spin;
 
@@ -57,6 +63,10 @@ public:
   /// @brief An optimization result
   std::optional<cudaq::optimization_result> optResult = std::nullopt;
 
+  /// @brief The performance counters of the execution, set by the simulator
+  /// when their collection is enabled.
+  std::optional<perf_counters> perfCounters = std::nullopt;
+
   /// @brief The kernel being executed in this context has conditional
   /// statements on measure results.
   bool hasConditionalsOnMeasureResults = false;
@@ -130,10 +140,28 @@ public:
   /// calculation on simulation backends that support trajectory simulation.
   std::optional<std::size_t> numberTrajectories = std::nullopt;
 
+  /// @brief The truncation error, i.e., one minus the fidelity, of the
+  /// approximate state of the last execution on simulation backends that
+  /// truncate it, e.g., MPS with a truncation error budget.
+  std::optional<double> truncationError = std::nullopt;
+
   /// @brief Whether or not to simply concatenate measurements in execution
   /// order.
   bool explicitMeasurements = false;
 
+  /// @brief Set for the executions of a `sample` broadcast over argument
+  /// sets, whose results the simulator may defer until the last execution on
+  /// the QPU, so as to simulate them as one batch.
+  bool batchedSampling = false;
+
+  /// @brief Set by the simulator if the result of this execution was
+  /// deferred, it is then part of the `deferredResults` of the last execution.
+  bool resultDeferred = false;
+
+  /// @brief The results of the deferred executions on the QPU, in execution
+  /// order, set on the last execution of a batched sampling.
+  std::vector<sample_result> deferredResults;
+
   /// @brief Probability of occurrence of each error mechanism (column) in
   /// Measurement Syndrome Matrix (0-1 range).
   std::optional<std::vector<double>> msm_probabilities;
@@ -152,9 +180,10 @@ public:
   bool allowJitEngineCaching = false;
 
   /// For performance, a launcher may cache the JIT execution engine and use it
-  /// for multiple discrete calls. This is actually a pointer to a
-  /// `mlir::ExecutionEngine` object, but we hide that because of problems with
-  /// the structure and organization of the runtime libraries.
+  /// for multiple discrete calls. This is actually a pointer to a heap
+  /// allocated `std::shared_ptr<mlir::ExecutionEngine>`, but we hide that
+  /// because of problems with the structure and organization of the runtime
+  /// libraries.
   void *jitEng = nullptr;
 };
 } // namespace cudaq
@@ -8,6 +8,7 @@
 
 #include "Executor.h"
 #include "common/Logger.h"
+#include <algorithm>
 
 namespace cudaq {
 details::future Executor::execute(std::vector<KernelExecution> &codesToExecute,
@@ -19,22 +20,18 @@ details::future Executor::execute(std::vector<KernelExecution> &codesToExecute,
   CUDAQ_INFO("Executor creating {} jobs to execute with the {} helper.",
              codesToExecute.size(), serverHelper->name());
 
-  // Create the Job Payload, composed of job post path, headers,
-  // and the job json messages themselves
-  auto [jobPostPath, headers, jobs] = serverHelper->createJob(codesToExecute);
-
   auto config = serverHelper->getConfig();
-
   std::vector<details::future::Job> ids;
-  for (std::size_t i = 0; auto &job : jobs) {
-    CUDAQ_INFO("Job (name={}) created, posting to {}", codesToExecute[i].name,
-               jobPostPath);
+
+  // Post a job and return its id.
+  auto postJob = [&](const std::string &jobPostPath, RestHeaders &headers,
+                     ServerMessage &job, const std::string &name) {
+    CUDAQ_INFO("Job (name={}) created, posting to {}", name, jobPostPath);
 
     // Post it, get the response
     auto response = client.post(jobPostPath, "", job, headers, true, false,
                                 serverHelper->getCookies());
-    CUDAQ_INFO("Job (name={}) posted, response was {}", codesToExecute[i].name,
-               response.dump());
+    CUDAQ_INFO("Job (name={}) posted, response was {}", name, response.dump());
 
     // Add the job id and the job name.
     auto task_id = serverHelper->extractJobId(response);
@@ -44,13 +41,52 @@ details::future Executor::execute(std::vector<KernelExecution> &codesToExecute,
       task_id = tmp[0].at("task_id");
     }
     CUDAQ_INFO("Task ID is {}", task_id);
-    ids.emplace_back(task_id, codesToExecute[i].name);
-    config["output_names." + task_id] = codesToExecute[i].output_names.dump();
+    return task_id;
+  };
+
+  // Submit several circuits per job if the server supports it, which saves
+  // queueing time and requests. The QIR output of `run` is not split.
+  const auto batchSize = serverHelper->getMaxCircuitsPerJob();
+  if (batchSize > 1 && codesToExecute.size() > 1 &&
+      execType != details::ExecutionContextType::run) {
+    for (std::size_t first = 0; first < codesToExecute.size();
+         first += batchSize) {
+      const auto last = std::min(first + batchSize, codesToExecute.size());
+      std::vector<KernelExecution> batch(codesToExecute.begin() + first,
+                                         codesToExecute.begin() + last);
+      CUDAQ_INFO("Executor batching {} circuits in one job.", batch.size());
+      auto [jobPostPath, headers, jobs] = serverHelper->createBatchJob(batch);
+      if (jobs.size() != 1)
+        throw std::runtime_error(serverHelper->name() +
+                                 " must create one message per batched job.");
 
-    nlohmann::json jReorder = codesToExecute[i].mapping_reorder_idx;
-    config["reorderIdx." + task_id] = jReorder.dump();
+      auto task_id = postJob(jobPostPath, headers, jobs[0], batch[0].name);
+      std::vector<std::string> names;
+      for (std::size_t i = 0; i < batch.size(); ++i) {
+        auto key = ServerHelper::getBatchCircuitKey(task_id, i);
+        names.push_back(batch[i].name);
+        config["output_names." + key] = batch[i].output_names.dump();
+        nlohmann::json jReorder = batch[i].mapping_reorder_idx;
+        config["reorderIdx." + key] = jReorder.dump();
+      }
+      config["batch." + task_id] = nlohmann::json(names).dump();
+      ids.emplace_back(task_id, batch[0].name);
+    }
+  } else {
+    // Create the Job Payload, composed of job post path, headers,
+    // and the job json messages themselves
+    auto [jobPostPath, headers, jobs] = serverHelper->createJob(codesToExecute);
+
+    for (std::size_t i = 0; auto &job : jobs) {
+      auto task_id = postJob(jobPostPath, headers, job, codesToExecute[i].name);
+      ids.emplace_back(task_id, codesToExecute[i].name);
+      config["output_names." + task_id] = codesToExecute[i].output_names.dump();
 
-    i++;
+      nlohmann::json jReorder = codesToExecute[i].mapping_reorder_idx;
+      config["reorderIdx." + task_id] = jReorder.dump();
+
+      i++;
+    }
   }
 
   config.insert({"shots", std::to_string(shots)});
@@ -9,37 +9,165 @@
 #include "Future.h"
 #include "Logger.h"
 #include "ObserveResult.h"
-#include "RestClient.h"
 #include "ServerHelper.h"
-#include <thread>
+#ifdef CUDAQ_RESTCLIENT_AVAILABLE
+#include "JobPoller.h"
+#include <algorithm>
+#endif
 
 namespace cudaq::details {
 
-sample_result future::get() {
-  if (wrapsFutureSampling)
-    return inFuture.get();
+/// The status requests of the jobs of a future, polled by the shared poller.
+/// The server helper is only used by the poller thread until the responses are
+/// collected.
+struct PendingServerJobs {
+  std::shared_ptr<ServerHelper> serverHelper;
+  std::vector<std::string> jobIds;
+  /// A single response for all the jobs if they are batched, else one response
+  /// per job.
+  std::vector<std::future<ServerMessage>> responses;
+  bool batched = false;
+};
 
 #ifdef CUDAQ_RESTCLIENT_AVAILABLE
-  RestClient client;
-  auto serverHelper = registry::get<ServerHelper>(qpuName);
+// Longest delay between two status requests of a job the server gave no
+// progress hints for. This bounds the latency once the job is done.
+constexpr std::chrono::seconds maxPollingInterval(2);
+
+/// Start polling the jobs until they are all done. The jobs are polled
+/// concurrently by the shared poller, with a single batched request if the
+/// server supports it.
+static std::shared_ptr<PendingServerJobs>
+pollJobs(const std::string &qpuName,
+         std::map<std::string, std::string> &serverConfig,
+         std::vector<future::Job> &jobs) {
+  auto pending = std::make_shared<PendingServerJobs>();
+  std::shared_ptr<ServerHelper> serverHelper =
+      registry::get<ServerHelper>(qpuName);
   serverHelper->initialize(serverConfig);
-  auto headers = serverHelper->getHeaders();
-  std::vector<ExecutionResult> results;
+  pending->serverHelper = serverHelper;
+
+  JobPoller::Request baseRequest;
+  baseRequest.headers = serverHelper->getHeaders();
+  baseRequest.cookies = serverHelper->getCookies();
+  auto &poller = JobPoller::get();
+
+  for (auto &id : jobs)
+    pending->jobIds.push_back(id.first);
+  auto jobsGetPath = jobs.size() > 1
+                         ? serverHelper->constructGetJobsPath(pending->jobIds)
+                         : "";
+  if (!jobsGetPath.empty()) {
+    CUDAQ_INFO("Future retrieving results for {} jobs from {}.", jobs.size(),
+               jobsGetPath);
+    auto request = baseRequest;
+    request.url = jobsGetPath;
+    request.isDone = [serverHelper,
+                      jobIds = pending->jobIds](ServerMessage &response) {
+      auto jobResponses = serverHelper->splitGetJobsResponse(response, jobIds);
+      return std::all_of(
+          jobResponses.begin(), jobResponses.end(),
+          [&](ServerMessage &r) { return serverHelper->jobIsDone(r); });
+    };
+    request.nextInterval = [serverHelper, jobIds = pending->jobIds,
+                            backoff = JobPoller::Backoff(maxPollingInterval)](
+                               ServerMessage &response) mutable {
+      auto jobResponses = serverHelper->splitGetJobsResponse(response, jobIds);
+      // The batch is done with the last of its jobs, so wait for the job
+      // furthest from done.
+      JobProgress progress;
+      for (auto &r : jobResponses) {
+        if (serverHelper->jobIsDone(r))
+          continue;
+        auto hint = serverHelper->getJobProgress(r);
+        if (hint.queuePosition)
+          progress.queuePosition =
+              std::max(progress.queuePosition.value_or(0), *hint.queuePosition);
+        if (hint.estimatedTimeLeft)
+          progress.estimatedTimeLeft =
+              std::max(progress.estimatedTimeLeft.value_or(
+                           std::chrono::microseconds(0)),
+                       *hint.estimatedTimeLeft);
+      }
+      return backoff.next(
+          serverHelper->nextResultPollingInterval(jobResponses.front()),
+          progress.queuePosition, progress.estimatedTimeLeft);
+    };
+    pending->responses.push_back(poller.poll(std::move(request)));
+    pending->batched = true;
+    return pending;
+  }
+
   for (auto &id : jobs) {
     CUDAQ_INFO("Future retrieving results for {}.", id.first);
+    auto request = baseRequest;
+    request.isDone = [serverHelper](ServerMessage &response) {
+      return serverHelper->jobIsDone(response);
+    };
+    // Prefer a request the server answers once the job is done, over polling.
+    request.url = serverHelper->constructWaitForJobPath(id.first);
+    if (!request.url.empty()) {
+      CUDAQ_INFO("Future waiting for the job at {}.", request.url);
+      request.nextInterval = [serverHelper](ServerMessage &response) {
+        return serverHelper->nextResultPollingInterval(response);
+      };
+      pending->responses.push_back(poller.poll(std::move(request)));
+      continue;
+    }
+    request.url = serverHelper->constructGetJobPath(id.first);
+    CUDAQ_INFO("Future got job retrieval path as {}.", request.url);
+    request.nextInterval = [serverHelper,
+                            backoff = JobPoller::Backoff(maxPollingInterval)](
+                               ServerMessage &response) mutable {
+      auto progress = serverHelper->getJobProgress(response);
+      return backoff.next(serverHelper->nextResultPollingInterval(response),
+                          progress.queuePosition, progress.estimatedTimeLeft);
+    };
+    pending->responses.push_back(poller.poll(std::move(request)));
+  }
+  return pending;
+}
 
-    auto jobGetPath = serverHelper->constructGetJobPath(id.first);
-
-    CUDAQ_INFO("Future got job retrieval path as {}.", jobGetPath);
-    auto resultResponse =
-        client.get(jobGetPath, "", headers, false, serverHelper->getCookies());
-    while (!serverHelper->jobIsDone(resultResponse)) {
-      auto polling_interval =
-          serverHelper->nextResultPollingInterval(resultResponse);
-      std::this_thread::sleep_for(polling_interval);
-      resultResponse = client.get(jobGetPath, "", headers, false,
-                                  serverHelper->getCookies());
+/// Wait until all the jobs are done, and return their final status responses
+/// in the order of the jobs.
+static std::vector<ServerMessage> waitForJobs(PendingServerJobs &pending) {
+  if (pending.batched) {
+    auto response = pending.responses.front().get();
+    return pending.serverHelper->splitGetJobsResponse(response, pending.jobIds);
+  }
+
+  // Wait for all the jobs, even if one of them fails, since the server helper
+  // must not be used by the poller while the results are processed.
+  std::vector<ServerMessage> responses;
+  std::exception_ptr error;
+  for (auto &response : pending.responses) {
+    try {
+      responses.push_back(response.get());
+    } catch (...) {
+      if (!error)
+        error = std::current_exception();
     }
+  }
+  if (error)
+    std::rethrow_exception(error);
+  return responses;
+}
+#endif
+
+sample_result future::get() {
+  if (wrapsFutureSampling)
+    return inFuture.get();
+
+#ifdef CUDAQ_RESTCLIENT_AVAILABLE
+  if (!pendingJobs)
+    pendingJobs = pollJobs(qpuName, serverConfig, jobs);
+  auto pending = std::move(pendingJobs);
+  auto serverHelper = pending->serverHelper;
+  auto responses = waitForJobs(*pending);
+  std::vector<ExecutionResult> results;
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    auto &id = jobs[i];
+    auto &resultResponse = responses[i];
 
     if (resultType == ExecutionContextType::run) {
       QirServerHelper *qirServerHelper =
@@ -58,6 +186,32 @@ sample_result future::get() {
       return sample_result();
     }
 
+    if (auto batch = serverConfig.find("batch." + id.first);
+        batch != serverConfig.end()) {
+      auto names = nlohmann::json::parse(batch->second)
+                       .get<std::vector<std::string>>();
+      auto circuitResults =
+          serverHelper->processBatchResults(resultResponse, id.first);
+      if (circuitResults.size() != names.size())
+        throw std::runtime_error(
+            "Batched job " + id.first + " returned " +
+            std::to_string(circuitResults.size()) + " results for " +
+            std::to_string(names.size()) + " circuits.");
+      for (std::size_t k = 0; k < names.size(); ++k) {
+        auto &c = circuitResults[k];
+        if (isObserve()) {
+          results.emplace_back(c.to_map(), names[k]);
+          results.back().sequentialData = c.sequential_data();
+          continue;
+        }
+        for (auto &regName : c.register_names()) {
+          results.emplace_back(c.to_map(regName), regName);
+          results.back().sequentialData = c.sequential_data(regName);
+        }
+      }
+      continue;
+    }
+
     auto c = serverHelper->processResults(resultResponse, id.first);
     if (isObserve()) {
       // Use the job name instead of the global register.
@@ -88,6 +242,25 @@ sample_result future::get() {
 #endif
 }
 
+bool future::is_ready() {
+  if (wrapsFutureSampling)
+    return !inFuture.valid() || inFuture.wait_for(std::chrono::seconds(0)) ==
+                                    std::future_status::ready;
+
+#ifdef CUDAQ_RESTCLIENT_AVAILABLE
+  if (!pendingJobs)
+    pendingJobs = pollJobs(qpuName, serverConfig, jobs);
+  return std::all_of(pendingJobs->responses.begin(),
+                     pendingJobs->responses.end(), [](auto &response) {
+                       return response.wait_for(std::chrono::seconds(0)) ==
+                              std::future_status::ready;
+                     });
+#else
+  throw std::runtime_error("cudaq::details::future::is_ready() requires REST "
+                           "Client but CUDA-Q was built without it.");
+#endif
+}
+
 future &future::operator=(future &other) {
   jobs = other.jobs;
   qpuName = other.qpuName;
@@ -98,6 +271,7 @@ future &future::operator=(future &other) {
     inFuture = std::move(other.inFuture);
   }
   inFutureRawOutput = other.inFutureRawOutput;
+  pendingJobs = std::move(other.pendingJobs);
   return *this;
 }
 
@@ -111,6 +285,7 @@ future &future::operator=(future &&other) {
     inFuture = std::move(other.inFuture);
   }
   inFutureRawOutput = other.inFutureRawOutput;
+  pendingJobs = std::move(other.pendingJobs);
   return *this;
 }
 
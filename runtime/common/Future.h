@@ -13,6 +13,7 @@
 #include <functional>
 #include <future>
 #include <map>
+#include <memory>
 
 namespace cudaq {
 namespace details {
@@ -22,6 +23,8 @@ namespace details {
 // differently when propagating it back to the runtime.
 enum class ExecutionContextType : int { sample = 1, observe, run };
 
+struct PendingServerJobs;
+
 /// @brief The future type models the expected result of a
 /// CUDA-Q kernel execution under a specific execution context.
 /// This type is returned from asynchronous execution calls. It
@@ -62,6 +65,9 @@ protected:
   /// from the server. This is used for `run` calls.
   std::vector<char> *inFutureRawOutput = nullptr;
 
+  /// @brief The status requests of the server jobs, once they are polled.
+  std::shared_ptr<PendingServerJobs> pendingJobs;
+
 public:
   /// @brief The constructor
   future() = default;
@@ -93,6 +99,10 @@ public:
 
   sample_result get();
 
+  /// @brief Return true if `get` would not wait. The first call starts polling
+  /// the status of the server jobs, if any, in the background.
+  bool is_ready();
+
   friend std::ostream &operator<<(std::ostream &, future &);
   friend std::istream &operator>>(std::istream &, future &);
 
@@ -156,6 +166,7 @@ public:
         return observe_result(data.expectation(checkRegName), *spinOp, data);
 
       // this assumes we ran in shots mode.
+      data = details::expand_group_results(data, *spinOp);
       double sum = 0.0;
       for (const auto &term : spinOp.value()) {
         if (term.is_identity())
@@ -181,6 +192,9 @@ public:
     return T();
   }
 
+  /// @brief Return true if the data is ready, i.e., if `get` would not wait.
+  bool is_ready() { return result.is_ready(); }
+
   template <typename U>
   friend std::ostream &operator<<(std::ostream &, async_result<U> &);
 
@@ -7,9 +7,13 @@
  ******************************************************************************/
 
 #include "JIT.h"
+#include "Environment.h"
 #include "ExecutionContext.h"
+#include "JITObjectCache.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/JITEventListener.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h"
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 #include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
@@ -27,10 +31,49 @@
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_ostream.h"
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
+#include <cstdlib>
 #include <cxxabi.h>
+#include <optional>
+#include <thread>
 
 #define DEBUG_TYPE "cudaq-qpud"
 
+namespace {
+/// The JIT configuration, from the environment:
+/// - `CUDAQ_JIT_LAZY`: compile each function when it is first called rather
+///   than the whole module upfront (default on). The IR of a kernel holds
+///   all the functions of the headers it includes, most of which are never
+///   called.
+/// - `CUDAQ_JIT_COMPILE_THREADS`: the number of threads compiling functions
+///   in the background (default: up to 4, 0 compiles on the calling thread).
+/// - `CUDAQ_JIT_OPT_LEVEL`: the code generation optimization level, from 0
+///   to 3 (default: the LLVM default). Simulated kernels spend their time in
+///   the simulator, hence 0 saves compilation time at little cost.
+struct JITOptions {
+  bool lazy = true;
+  unsigned numCompileThreads = 0;
+  std::optional<llvm::CodeGenOpt::Level> optLevel;
+
+  JITOptions() {
+    lazy = cudaq::getEnvBool("CUDAQ_JIT_LAZY", lazy);
+    numCompileThreads = std::min(4u, std::thread::hardware_concurrency());
+    if (const char *threads = std::getenv("CUDAQ_JIT_COMPILE_THREADS"))
+      if (llvm::StringRef(threads).getAsInteger(10, numCompileThreads))
+        throw std::runtime_error("Invalid CUDAQ_JIT_COMPILE_THREADS value '" +
+                                 std::string(threads) +
+                                 "'. Expected a number of threads.");
+    if (const char *level = std::getenv("CUDAQ_JIT_OPT_LEVEL")) {
+      unsigned value = 0;
+      if (llvm::StringRef(level).getAsInteger(10, value) || value > 3)
+        throw std::runtime_error("Invalid CUDAQ_JIT_OPT_LEVEL value '" +
+                                 std::string(level) +
+                                 "'. Expected a level from 0 to 3.");
+      optLevel = static_cast<llvm::CodeGenOpt::Level>(value);
+    }
+  }
+};
+} // namespace
+
 std::unique_ptr<llvm::orc::LLJIT>
 cudaq::invokeWrappedKernel(std::string_view irString,
                            const std::string &entryPointFn, void *args,
@@ -103,6 +146,29 @@ cudaq::invokeWrappedKernel(std::string_view irString,
   mlir::ExecutionEngine::setupTargetTriple(llvmModule.get());
   auto dataLayout = llvmModule->getDataLayout();
 
+  // Object files are cached on disk across processes when
+  // `CUDAQ_JIT_CACHE_DIR` is set, keyed by the IR, the kernel (which decides
+  // the linkage fix-ups above), the target and the optimization level.
+  static const JITOptions options;
+  static const auto objectCache = JITObjectCache::createFromEnvironment();
+  auto targetMachineBuilder =
+      llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost());
+  if (options.optLevel)
+    targetMachineBuilder.setCodeGenOptLevel(*options.optLevel);
+  if (objectCache) {
+    std::string cacheKey;
+    llvm::raw_string_ostream os(cacheKey);
+    os << LLVM_VERSION_STRING << '\n'
+       << targetMachineBuilder.getTargetTriple().str() << '\n'
+       << targetMachineBuilder.getCPU() << '\n'
+       << targetMachineBuilder.getFeatures().getString() << '\n'
+       << (options.optLevel ? static_cast<int>(*options.optLevel) : -1) << '\n'
+       << entryPointFn << '\n'
+       << irString;
+    llvmModule->setModuleIdentifier(
+        JITObjectCache::moduleIdentifier(os.str()));
+  }
+
   // Create the object layer
   auto objectLinkingLayerCreator = [&](llvm::orc::ExecutionSession &session,
                                        const llvm::Triple &tt) {
@@ -114,15 +180,41 @@ cudaq::invokeWrappedKernel(std::string_view irString,
     return objectLayer;
   };
 
-  // Create the LLJIT with the object link layer
-  auto jit = llvm::cantFail(
-      llvm::orc::LLJITBuilder()
-          .setObjectLinkingLayerCreator(objectLinkingLayerCreator)
-          .create());
-
-  // Add a ThreadSafemodule to the engine and return.
-  llvm::orc::ThreadSafeModule tsm(std::move(llvmModule), std::move(ctx));
-  llvm::cantFail(jit->addIRModule(std::move(tsm)));
+  // Create the LLJIT with the object link layer. Cached objects are keyed by
+  // the whole module, so the module is compiled eagerly when the cache is
+  // enabled: the functions extracted for lazy compilation are not stable
+  // cache keys, and a cached module costs no compilation anyway.
+  auto configure = [&](auto &jitBuilder) {
+    jitBuilder.setObjectLinkingLayerCreator(objectLinkingLayerCreator)
+        .setJITTargetMachineBuilder(targetMachineBuilder)
+        .setNumCompileThreads(options.numCompileThreads);
+    if (objectCache)
+      jitBuilder.setCompileFunctionCreator(
+          [](llvm::orc::JITTargetMachineBuilder builder)
+              -> llvm::Expected<
+                  std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+            return std::make_unique<llvm::orc::ConcurrentIRCompiler>(
+                std::move(builder), objectCache.get());
+          });
+  };
+  std::unique_ptr<llvm::orc::LLJIT> jit;
+  if (options.lazy && !objectCache) {
+    // Compile each function on its first call.
+    llvm::orc::LLLazyJITBuilder jitBuilder;
+    configure(jitBuilder);
+    auto lazyJit = llvm::cantFail(jitBuilder.create());
+    lazyJit->setPartitionFunction(
+        llvm::orc::CompileOnDemandLayer::compileRequested);
+    llvm::orc::ThreadSafeModule tsm(std::move(llvmModule), std::move(ctx));
+    llvm::cantFail(lazyJit->addLazyIRModule(std::move(tsm)));
+    jit = std::move(lazyJit);
+  } else {
+    llvm::orc::LLJITBuilder jitBuilder;
+    configure(jitBuilder);
+    jit = llvm::cantFail(jitBuilder.create());
+    llvm::orc::ThreadSafeModule tsm(std::move(llvmModule), std::move(ctx));
+    llvm::cantFail(jit->addIRModule(std::move(tsm)));
+  }
 
   // Resolve symbols that are statically linked in the current process.
   llvm::orc::JITDylib &mainJD = jit->getMainJITDylib();
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "JITObjectCache.h"
+#include "Logger.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+
+// Entries must carry this prefix for `llvm::pruneCache` to consider them.
+static constexpr const char entryPrefix[] = "llvmcache-";
+static constexpr const char identifierPrefix[] = "cudaq-jit-";
+static constexpr std::uint64_t defaultMaxSizeBytes = std::uint64_t(1) << 30;
+
+cudaq::JITObjectCache::JITObjectCache(std::string directory,
+                                      std::uint64_t maxSizeBytes)
+    : directory(std::move(directory)), maxSizeBytes(maxSizeBytes) {
+  if (auto ec = llvm::sys::fs::create_directories(this->directory))
+    throw std::runtime_error("Unable to create the JIT cache directory " +
+                             this->directory + ": " + ec.message());
+}
+
+std::unique_ptr<cudaq::JITObjectCache>
+cudaq::JITObjectCache::createFromEnvironment() {
+  const char *directory = std::getenv("CUDAQ_JIT_CACHE_DIR");
+  if (!directory || !*directory)
+    return nullptr;
+  std::uint64_t maxSizeBytes = defaultMaxSizeBytes;
+  if (const char *maxSize = std::getenv("CUDAQ_JIT_CACHE_MAX_SIZE")) {
+    // Reuse the LLVM cache policy syntax, i.e., a byte count with an optional
+    // 'k', 'm' or 'g' suffix.
+    auto policy = llvm::parseCachePruningPolicy(
+        std::string("cache_size_bytes=") + maxSize);
+    if (!policy) {
+      llvm::consumeError(policy.takeError());
+      throw std::runtime_error(
+          "Invalid CUDAQ_JIT_CACHE_MAX_SIZE value '" + std::string(maxSize) +
+          "'. Expected a size in bytes, with an optional k, m or g suffix.");
+    }
+    maxSizeBytes = policy->MaxSizeBytes;
+  }
+  CUDAQ_INFO("Using the JIT object cache in {} (max size {} bytes).",
+             directory, maxSizeBytes);
+  return std::make_unique<JITObjectCache>(directory, maxSizeBytes);
+}
+
+std::string cudaq::JITObjectCache::moduleIdentifier(std::string_view content) {
+  return identifierPrefix +
+         llvm::toHex(llvm::SHA256::hash(llvm::arrayRefFromStringRef(
+                         llvm::StringRef(content.data(), content.size()))),
+                     /*LowerCase=*/true);
+}
+
+std::string
+cudaq::JITObjectCache::entryPath(const llvm::Module *module) const {
+  // Modules added by the JIT itself, e.g., its platform support, are not
+  // keyed by their content.
+  llvm::StringRef identifier = module->getModuleIdentifier();
+  if (!identifier.consume_front(identifierPrefix))
+    return {};
+  llvm::SmallString<256> path(directory);
+  llvm::sys::path::append(path, entryPrefix + identifier);
+  return path.str().str();
+}
+
+void cudaq::JITObjectCache::notifyObjectCompiled(
+    const llvm::Module *module, llvm::MemoryBufferRef object) {
+  const auto path = entryPath(module);
+  if (path.empty())
+    return;
+  // Write a private temporary file and rename it into place, which is atomic:
+  // other processes either see the complete entry or no entry at all.
+  int fd;
+  llvm::SmallString<256> tmpPath;
+  if (llvm::sys::fs::createUniqueFile(path + ".%%%%%%%%.tmp", fd, tmpPath)) {
+    CUDAQ_INFO("Unable to create a temporary JIT cache entry in {}.",
+               directory);
+    return;
+  }
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << object.getBuffer();
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(tmpPath);
+      CUDAQ_INFO("Unable to write the JIT cache entry {}.", path);
+      return;
+    }
+  }
+  if (llvm::sys::fs::rename(tmpPath, path)) {
+    llvm::sys::fs::remove(tmpPath);
+    return;
+  }
+  CUDAQ_INFO("Stored the JIT cache entry {}.", path);
+  prune();
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+cudaq::JITObjectCache::getObject(const llvm::Module *module) {
+  const auto path = entryPath(module);
+  if (path.empty())
+    return nullptr;
+  auto fd = llvm::sys::fs::openNativeFileForRead(path);
+  if (!fd) {
+    llvm::consumeError(fd.takeError());
+    return nullptr;
+  }
+  auto buffer = llvm::MemoryBuffer::getOpenFile(
+      *fd, path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+  // Mark the entry as recently used: pruning evicts the oldest entries first,
+  // and access times are not reliably updated by the file system.
+  llvm::sys::fs::setLastAccessAndModificationTime(
+      *fd, std::chrono::system_clock::now());
+  llvm::sys::fs::closeFile(*fd);
+  if (!buffer || (*buffer)->getBufferSize() == 0)
+    return nullptr;
+  CUDAQ_INFO("Loaded the JIT cache entry {}.", path);
+  return std::move(*buffer);
+}
+
+void cudaq::JITObjectCache::prune() {
+  llvm::CachePruningPolicy policy;
+  policy.MaxSizeBytes = maxSizeBytes;
+  policy.Interval = std::chrono::seconds(60);
+  // Entries are content-addressed and never stale, only the size limit
+  // applies.
+  policy.Expiration = std::chrono::seconds(0);
+  llvm::pruneCache(directory, policy);
+}
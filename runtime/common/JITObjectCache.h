@@ -0,0 +1,65 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cudaq {
+
+/// @brief An on-disk, content-addressed cache of the object files produced by
+/// the JIT, shared by all the processes that use the same cache directory.
+///
+/// Entries are keyed by a hash of the LLVM IR and of everything else that
+/// affects code generation (LLVM version, target triple, CPU and features),
+/// so a new process JIT'ing the same kernel loads the object file rather than
+/// compiling it again. The key is carried by the module identifier, see
+/// `moduleIdentifier`, and only modules named that way are cached, which
+/// leaves the cache stateless. Entries are written to a temporary file and
+/// renamed into place, hence concurrent readers and writers never see a
+/// partial object. The directory is pruned, least
+/// recently used entries first, once it exceeds its size limit.
+class JITObjectCache : public llvm::ObjectCache {
+public:
+  /// @brief Create a cache in `directory`, holding at most `maxSizeBytes`
+  /// bytes of object files.
+  JITObjectCache(std::string directory, std::uint64_t maxSizeBytes);
+
+  /// @brief Create the cache configured by the `CUDAQ_JIT_CACHE_DIR` and
+  /// `CUDAQ_JIT_CACHE_MAX_SIZE` environment variables, or return null if
+  /// `CUDAQ_JIT_CACHE_DIR` is not set.
+  static std::unique_ptr<JITObjectCache> createFromEnvironment();
+
+  /// @brief The module identifier that makes a module cacheable. `content`
+  /// must uniquely identify the generated code, e.g., the IR and the code
+  /// generation options.
+  static std::string moduleIdentifier(std::string_view content);
+
+  void notifyObjectCompiled(const llvm::Module *module,
+                            llvm::MemoryBufferRef object) override;
+
+  std::unique_ptr<llvm::MemoryBuffer>
+  getObject(const llvm::Module *module) override;
+
+  /// @brief Remove entries until the cache fits its size limit. This is
+  /// done at most once per interval, across all processes, after a store.
+  void prune();
+
+private:
+  /// @brief The path of the entry of the given module, or an empty string if
+  /// the module is not cacheable.
+  std::string entryPath(const llvm::Module *module) const;
+
+  std::string directory;
+  std::uint64_t maxSizeBytes;
+};
+
+} // namespace cudaq
@@ -0,0 +1,318 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "JobPoller.h"
+#include "Logger.h"
+#include "RestClient.h"
+#include <algorithm>
+#include <atomic>
+#include <curl/curl.h>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cudaq {
+// Same as the RestClient.
+constexpr long validHttpCode = 205;
+
+// Limit the connections opened to each server, further requests are queued
+// by libcurl.
+constexpr long maxConnectionsPerHost = 16;
+
+// Upper bound on the time the poller thread sleeps without checking for new
+// requests, should a wake up be missed.
+constexpr std::chrono::milliseconds maxWait(1000);
+
+// Smallest delay the backoff grows from, so that it grows even if the server
+// asks for no delay at all.
+constexpr std::chrono::microseconds minGrowthInterval(100);
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Entry {
+  JobPoller::Request request;
+  JobPoller::Callback onDone;
+  CURL *easy = nullptr;
+  curl_slist *headerList = nullptr;
+  std::string responseBody;
+  Clock::time_point due;
+
+  ~Entry() {
+    if (easy)
+      curl_easy_cleanup(easy);
+    if (headerList)
+      curl_slist_free_all(headerList);
+  }
+};
+
+std::size_t writeResponse(char *data, std::size_t size, std::size_t count,
+                          void *userData) {
+  static_cast<std::string *>(userData)->append(data, size * count);
+  return size * count;
+}
+} // namespace
+
+struct JobPoller::Impl {
+  CURLM *multi = nullptr;
+  std::string caBundle;
+
+  /// Requests submitted but not picked up by the poller thread yet.
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Entry>> incoming;
+  bool stop = false;
+  std::atomic<std::size_t> numPending = 0;
+
+  /// Only accessed by the poller thread.
+  std::vector<std::unique_ptr<Entry>> waiting;
+  std::unordered_map<CURL *, std::unique_ptr<Entry>> inFlight;
+
+  std::thread worker;
+
+  void run();
+  void start(std::unique_ptr<Entry> entry);
+  void finish(std::unique_ptr<Entry> entry, CURLcode result);
+  void complete(std::unique_ptr<Entry> entry, nlohmann::json response,
+                std::exception_ptr error);
+};
+
+void JobPoller::Impl::start(std::unique_ptr<Entry> entry) {
+  if (!entry->easy) {
+    entry->easy = curl_easy_init();
+    if (!entry->easy) {
+      complete(std::move(entry), {},
+               std::make_exception_ptr(std::runtime_error(
+                   "Unable to create a handle to poll the job status.")));
+      return;
+    }
+    auto &request = entry->request;
+    if (request.headers.empty())
+      request.headers.emplace("Content-type", "application/json");
+    for (const auto &[name, value] : request.headers)
+      entry->headerList =
+          curl_slist_append(entry->headerList, (name + ": " + value).c_str());
+    std::string cookies;
+    for (const auto &[name, value] : request.cookies)
+      cookies += (cookies.empty() ? "" : "; ") + name + "=" + value;
+
+    CURL *easy = entry->easy;
+    curl_easy_setopt(easy, CURLOPT_URL, request.url.c_str());
+    curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, entry->headerList);
+    if (!cookies.empty())
+      curl_easy_setopt(easy, CURLOPT_COOKIE, cookies.c_str());
+    curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, request.enableSsl ? 1L : 0L);
+    curl_easy_setopt(easy, CURLOPT_SSL_VERIFYHOST, request.enableSsl ? 2L : 0L);
+    if (!caBundle.empty())
+      curl_easy_setopt(easy, CURLOPT_CAINFO, caBundle.c_str());
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    // Multiplex the requests to a server over one HTTP/2 connection when the
+    // server supports it.
+    curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, writeResponse);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, &entry->responseBody);
+  }
+  entry->responseBody.clear();
+  CURL *easy = entry->easy;
+  curl_multi_add_handle(multi, easy);
+  inFlight.emplace(easy, std::move(entry));
+}
+
+void JobPoller::Impl::finish(std::unique_ptr<Entry> entry, CURLcode result) {
+  long statusCode = 0;
+  curl_easy_getinfo(entry->easy, CURLINFO_RESPONSE_CODE, &statusCode);
+  if (result != CURLE_OK || statusCode > validHttpCode || statusCode == 0) {
+    std::string message =
+        "HTTP GET Error - status code " + std::to_string(statusCode) + ": " +
+        (result != CURLE_OK ? curl_easy_strerror(result) : "") + ": " +
+        entry->responseBody;
+    complete(std::move(entry), {},
+             std::make_exception_ptr(std::runtime_error(message)));
+    return;
+  }
+
+  nlohmann::json response;
+  try {
+    response = nlohmann::json::parse(entry->responseBody);
+    if (!entry->request.isDone(response)) {
+      entry->due = Clock::now() + entry->request.nextInterval(response);
+      waiting.push_back(std::move(entry));
+      return;
+    }
+  } catch (...) {
+    complete(std::move(entry), {}, std::current_exception());
+    return;
+  }
+  complete(std::move(entry), std::move(response), nullptr);
+}
+
+void JobPoller::Impl::complete(std::unique_ptr<Entry> entry,
+                               nlohmann::json response,
+                               std::exception_ptr error) {
+  --numPending;
+  try {
+    entry->onDone(std::move(response), error);
+  } catch (const std::exception &e) {
+    CUDAQ_WARN("Job status callback for {} failed: {}", entry->request.url,
+               e.what());
+  }
+}
+
+void JobPoller::Impl::run() {
+  while (true) {
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+      if (stop)
+        break;
+      for (auto &entry : incoming)
+        waiting.push_back(std::move(entry));
+      incoming.clear();
+    }
+
+    // Send the status requests that are due.
+    auto now = Clock::now();
+    auto due = std::stable_partition(
+        waiting.begin(), waiting.end(),
+        [&](const std::unique_ptr<Entry> &entry) { return entry->due > now; });
+    std::vector<std::unique_ptr<Entry>> toStart(
+        std::make_move_iterator(due), std::make_move_iterator(waiting.end()));
+    waiting.erase(due, waiting.end());
+    for (auto &entry : toStart)
+      start(std::move(entry));
+
+    int running = 0;
+    curl_multi_perform(multi, &running);
+    int remaining = 0;
+    while (CURLMsg *message = curl_multi_info_read(multi, &remaining)) {
+      if (message->msg != CURLMSG_DONE)
+        continue;
+      CURL *easy = message->easy_handle;
+      auto result = message->data.result;
+      curl_multi_remove_handle(multi, easy);
+      auto it = inFlight.find(easy);
+      auto entry = std::move(it->second);
+      inFlight.erase(it);
+      finish(std::move(entry), result);
+    }
+
+    // Sleep until a transfer progresses, a request is due, or a new request
+    // is submitted.
+    auto wait = maxWait;
+    for (const auto &entry : waiting)
+      wait = std::min(wait, std::chrono::ceil<std::chrono::milliseconds>(
+                                entry->due - Clock::now()));
+    if (wait.count() > 0 || !inFlight.empty())
+      curl_multi_poll(multi, nullptr, 0,
+                      std::max<int>(wait.count(), 0), nullptr);
+  }
+
+  // Fail the jobs still pending.
+  auto error = std::make_exception_ptr(
+      std::runtime_error("The job poller was shut down before the job was "
+                         "done."));
+  for (auto &[easy, entry] : inFlight) {
+    curl_multi_remove_handle(multi, easy);
+    waiting.push_back(std::move(entry));
+  }
+  inFlight.clear();
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+    for (auto &entry : incoming)
+      waiting.push_back(std::move(entry));
+    incoming.clear();
+  }
+  for (auto &entry : waiting)
+    complete(std::move(entry), {}, error);
+  waiting.clear();
+}
+
+JobPoller::JobPoller() : impl(std::make_unique<Impl>()) {
+  curl_global_init(CURL_GLOBAL_DEFAULT);
+  impl->multi = curl_multi_init();
+  if (!impl->multi)
+    throw std::runtime_error("Unable to create the job poller handle.");
+  curl_multi_setopt(impl->multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+                    maxConnectionsPerHost);
+  curl_multi_setopt(impl->multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+  impl->caBundle = RestClient::findCABundle();
+  impl->worker = std::thread([this] { impl->run(); });
+}
+
+JobPoller::~JobPoller() {
+  {
+    std::scoped_lock<std::mutex> lock(impl->mutex);
+    impl->stop = true;
+  }
+  curl_multi_wakeup(impl->multi);
+  impl->worker.join();
+  curl_multi_cleanup(impl->multi);
+  curl_global_cleanup();
+}
+
+void JobPoller::poll(Request request, Callback onDone) {
+  auto entry = std::make_unique<Entry>();
+  entry->request = std::move(request);
+  entry->onDone = std::move(onDone);
+  entry->due = Clock::now();
+  ++impl->numPending;
+  {
+    std::scoped_lock<std::mutex> lock(impl->mutex);
+    impl->incoming.push_back(std::move(entry));
+  }
+  curl_multi_wakeup(impl->multi);
+}
+
+std::future<nlohmann::json> JobPoller::poll(Request request) {
+  auto promise = std::make_shared<std::promise<nlohmann::json>>();
+  auto result = promise->get_future();
+  poll(std::move(request),
+       [promise](nlohmann::json response, std::exception_ptr error) {
+         if (error)
+           promise->set_exception(error);
+         else
+           promise->set_value(std::move(response));
+       });
+  return result;
+}
+
+JobPoller::Backoff::Backoff(std::chrono::microseconds maxInterval)
+    : maxInterval(maxInterval) {}
+
+std::chrono::microseconds
+JobPoller::Backoff::next(std::chrono::microseconds minInterval,
+                         std::optional<std::size_t> queuePosition,
+                         std::optional<std::chrono::microseconds> timeLeft) {
+  auto upper = std::max(minInterval, maxInterval);
+  std::chrono::microseconds delay;
+  if (timeLeft) {
+    delay = *timeLeft / 2;
+    current = minInterval;
+  } else if (queuePosition && *queuePosition > 0) {
+    delay = minInterval * static_cast<std::int64_t>(*queuePosition + 1);
+    current = minInterval;
+  } else {
+    // Grow by half for each request, once the job runs or without hints.
+    current = current.count() == 0
+                  ? std::max(minInterval, minGrowthInterval)
+                  : current + current / 2;
+    delay = current;
+  }
+  current = std::clamp(current, minInterval, upper);
+  return std::clamp(delay, minInterval, upper);
+}
+
+std::size_t JobPoller::getNumPending() const { return impl->numPending; }
+
+JobPoller &JobPoller::get() {
+  static JobPoller poller;
+  return poller;
+}
+} // namespace cudaq
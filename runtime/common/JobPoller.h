@@ -0,0 +1,94 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+#include "nlohmann/json.hpp"
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace cudaq {
+
+/// @brief The JobPoller polls the status of remote jobs until they are done.
+/// All the outstanding status requests are multiplexed over a single libcurl
+/// multi handle by one background thread, so that waiting on many jobs, on
+/// any number of servers, does not tie up a thread per job. Each job is
+/// polled again after the interval its server asks for, and its completion
+/// is reported through a callback. All members are thread safe.
+class JobPoller {
+public:
+  /// @brief A job status request, repeated until `isDone` returns true.
+  struct Request {
+    std::string url;
+    std::map<std::string, std::string> headers;
+    std::map<std::string, std::string> cookies;
+    bool enableSsl = false;
+    /// Return true if the job is done, given its status response.
+    std::function<bool(nlohmann::json &)> isDone;
+    /// Return the delay before the next status request, given the last
+    /// status response.
+    std::function<std::chrono::microseconds(nlohmann::json &)> nextInterval;
+  };
+
+  /// @brief Adaptive delay between the status requests of a job. Without
+  /// hints, the delay grows geometrically from the minimum interval of the
+  /// server, so that long jobs do not burn through the request quota. With an
+  /// estimate of the time left, the next request is sent halfway to the
+  /// expected completion; with a queue position, the delay scales with the
+  /// number of jobs ahead. The delay is never shorter than the minimum
+  /// interval, nor longer than the maximum one unless the minimum is.
+  class Backoff {
+  public:
+    explicit Backoff(std::chrono::microseconds maxInterval);
+
+    /// @brief Return the delay before the next status request.
+    std::chrono::microseconds
+    next(std::chrono::microseconds minInterval,
+         std::optional<std::size_t> queuePosition = std::nullopt,
+         std::optional<std::chrono::microseconds> timeLeft = std::nullopt);
+
+  private:
+    std::chrono::microseconds maxInterval;
+    /// The delay grown so far while no hints were given.
+    std::chrono::microseconds current{0};
+  };
+
+  /// @brief Called on the poller thread with the final status response, or
+  /// with the exception that ended the polling (e.g., an HTTP error).
+  using Callback =
+      std::function<void(nlohmann::json response, std::exception_ptr error)>;
+
+  JobPoller();
+  ~JobPoller();
+  JobPoller(const JobPoller &) = delete;
+  JobPoller &operator=(const JobPoller &) = delete;
+
+  /// @brief Poll the job of `request`, and call `onDone` once it is done.
+  /// Callbacks must not block, since they delay the polling of other jobs.
+  void poll(Request request, Callback onDone);
+
+  /// @brief Poll the job of `request`, and return its final status response.
+  std::future<nlohmann::json> poll(Request request);
+
+  /// @brief Return the number of jobs not done yet.
+  std::size_t getNumPending() const;
+
+  /// @brief Return the process-wide poller.
+  static JobPoller &get();
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl;
+};
+
+} // namespace cudaq
@@ -59,7 +59,7 @@ namespace cudaq {
 inline void to_json(json &j, const ExecutionResult &result) {
   j = json{{"counts", result.counts},
            {"registerName", result.registerName},
-           {"sequentialData", result.sequentialData}};
+           {"sequentialData", result.getSequentialData()}};
   if (result.expectationValue.has_value())
     j["expectationValue"] = result.expectationValue.value();
 }
@@ -75,8 +75,17 @@ inline void from_json(const json &j, ExecutionResult &result) {
   }
 }
 
-// `ExecutionContext` serialization.
-inline void to_json(json &j, const ExecutionContext &context) {
+/// Media type of the binary (CBOR) wire format, which the client requests with
+/// an `Accept` header. Unlike JSON, it carries state vectors as raw
+/// little-endian buffers.
+inline constexpr const char *BinaryPayloadMediaType = "application/cbor";
+
+// `ExecutionContext` serialization. With `binaryBuffers`, the state vector is
+// stored as a raw buffer in the precision of the simulator, which can only be
+// encoded in the binary wire format.
+inline void serialize_execution_context(json &j,
+                                        const ExecutionContext &context,
+                                        bool binaryBuffers) {
   j = json{{"name", context.name},
            {"shots", context.shots},
            {"hasConditionalsOnMeasureResults",
@@ -116,9 +125,32 @@ inline void to_json(json &j, const ExecutionContext &context) {
         context.simulationState->isArrayLike()
             ? context.simulationState->getNumElements()
             : 1ULL << context.simulationState->getNumQubits();
-    if (context.simulationState->isDeviceData()) {
-      if (context.simulationState->getPrecision() ==
-          cudaq::SimulationState::precision::fp32) {
+    const bool isFp32 = context.simulationState->getPrecision() ==
+                        cudaq::SimulationState::precision::fp32;
+    if (binaryBuffers) {
+      const std::size_t elementSize = isFp32 ? sizeof(std::complex<float>)
+                                             : sizeof(std::complex<double>);
+      std::vector<std::uint8_t> bytes;
+      if (context.simulationState->isDeviceData()) {
+        bytes.resize(hostDataSize * elementSize);
+        if (isFp32)
+          context.simulationState->toHost(
+              reinterpret_cast<std::complex<float> *>(bytes.data()),
+              hostDataSize);
+        else
+          context.simulationState->toHost(
+              reinterpret_cast<std::complex<double> *>(bytes.data()),
+              hostDataSize);
+      } else {
+        auto *ptr = static_cast<const std::uint8_t *>(
+            context.simulationState->getTensor().data);
+        bytes.assign(ptr, ptr + context.simulationState->getNumElements() *
+                                    elementSize);
+      }
+      j["simulationData"]["precision"] = isFp32 ? "fp32" : "fp64";
+      j["simulationData"]["data"] = json::binary(std::move(bytes));
+    } else if (context.simulationState->isDeviceData()) {
+      if (isFp32) {
         std::vector<std::complex<float>> hostData(hostDataSize);
         context.simulationState->toHost(hostData.data(), hostData.size());
         std::vector<std::complex<double>> converted(hostData.begin(),
@@ -154,6 +186,17 @@ inline void to_json(json &j, const ExecutionContext &context) {
     j["invocationResultBuffer"] = context.invocationResultBuffer;
 }
 
+inline void to_json(json &j, const ExecutionContext &context) {
+  serialize_execution_context(j, context, /*binaryBuffers=*/false);
+}
+
+/// Serialize `context` for the binary wire format.
+inline json to_binary_json(const ExecutionContext &context) {
+  json j;
+  serialize_execution_context(j, context, /*binaryBuffers=*/true);
+  return j;
+}
+
 inline void from_json(const json &j, ExecutionContext &context) {
   j.at("shots").get_to(context.shots);
   j.at("hasConditionalsOnMeasureResults")
@@ -182,9 +225,7 @@ inline void from_json(const json &j, ExecutionContext &context) {
 
   if (j.contains("simulationData")) {
     std::vector<std::size_t> stateDim;
-    std::vector<std::complex<double>> stateData;
     j["simulationData"]["dim"].get_to(stateDim);
-    j["simulationData"]["data"].get_to(stateData);
 
     // Note: before `SimulationState` was added, `simulationData` contains a
     // flat pair of dimensions and data, whereby an empty dimension array
@@ -192,16 +233,52 @@ inline void from_json(const json &j, ExecutionContext &context) {
     if (!stateDim.empty()) {
       // Create the simulation specific SimulationState
       auto *simulator = cudaq::get_simulator();
-      if (simulator->isSinglePrecision()) {
-        // If the host (local) simulator is single-precision, convert the type
-        // before loading the state vector.
-        std::vector<std::complex<float>> converted(stateData.begin(),
-                                                   stateData.end());
-        context.simulationState = simulator->createStateFromData(
-            std::make_pair(converted.data(), stateDim[0]));
+      const auto &data = j["simulationData"]["data"];
+      if (data.is_binary()) {
+        // Raw buffer of the binary wire format, in the precision of the
+        // remote simulator.
+        auto &bytes = const_cast<json::binary_t &>(data.get_binary());
+        const bool isFp32 =
+            j["simulationData"].value("precision", "fp64") == "fp32";
+        const std::size_t elementSize = isFp32 ? sizeof(std::complex<float>)
+                                               : sizeof(std::complex<double>);
+        if (bytes.size() < stateDim[0] * elementSize)
+          throw std::runtime_error("Truncated state vector data.");
+        if (isFp32) {
+          auto *ptr = reinterpret_cast<std::complex<float> *>(bytes.data());
+          if (simulator->isSinglePrecision()) {
+            context.simulationState = simulator->createStateFromData(
+                std::make_pair(ptr, stateDim[0]));
+          } else {
+            std::vector<std::complex<double>> converted(ptr, ptr + stateDim[0]);
+            context.simulationState = simulator->createStateFromData(
+                std::make_pair(converted.data(), stateDim[0]));
+          }
+        } else {
+          auto *ptr = reinterpret_cast<std::complex<double> *>(bytes.data());
+          if (simulator->isSinglePrecision()) {
+            std::vector<std::complex<float>> converted(ptr, ptr + stateDim[0]);
+            context.simulationState = simulator->createStateFromData(
+                std::make_pair(converted.data(), stateDim[0]));
+          } else {
+            context.simulationState = simulator->createStateFromData(
+                std::make_pair(ptr, stateDim[0]));
+          }
+        }
       } else {
-        context.simulationState = simulator->createStateFromData(
-            std::make_pair(stateData.data(), stateDim[0]));
+        std::vector<std::complex<double>> stateData;
+        data.get_to(stateData);
+        if (simulator->isSinglePrecision()) {
+          // If the host (local) simulator is single-precision, convert the
+          // type before loading the state vector.
+          std::vector<std::complex<float>> converted(stateData.begin(),
+                                                     stateData.end());
+          context.simulationState = simulator->createStateFromData(
+              std::make_pair(converted.data(), stateDim[0]));
+        } else {
+          context.simulationState = simulator->createStateFromData(
+              std::make_pair(stateData.data(), stateDim[0]));
+        }
       }
     }
   }
@@ -238,7 +315,8 @@ enum class OptimizerEnum {
   SPSA,
   ADAM,
   GRAD_DESC,
-  SGD
+  SGD,
+  CMAES
 };
 
 NLOHMANN_JSON_SERIALIZE_ENUM(
@@ -246,7 +324,7 @@ NLOHMANN_JSON_SERIALIZE_ENUM(
     {JSON_ENUM(OptimizerEnum, COBYLA), JSON_ENUM(OptimizerEnum, NELDERMEAD),
      JSON_ENUM(OptimizerEnum, LBFGS), JSON_ENUM(OptimizerEnum, SPSA),
      JSON_ENUM(OptimizerEnum, ADAM), JSON_ENUM(OptimizerEnum, GRAD_DESC),
-     JSON_ENUM(OptimizerEnum, SGD)});
+     JSON_ENUM(OptimizerEnum, SGD), JSON_ENUM(OptimizerEnum, CMAES)});
 
 inline OptimizerEnum get_optimizer_type(const cudaq::optimizer &p) {
   if (dynamic_cast<const cudaq::optimizers::cobyla *>(&p))
@@ -263,8 +341,13 @@ inline OptimizerEnum get_optimizer_type(const cudaq::optimizer &p) {
     return OptimizerEnum::GRAD_DESC;
   if (dynamic_cast<const cudaq::optimizers::sgd *>(&p))
     return OptimizerEnum::SGD;
-  // This shouldn't happen, but gracefully handle it if it does.
-  return OptimizerEnum::COBYLA;
+  if (dynamic_cast<const cudaq::optimizers::cmaes *>(&p))
+    return OptimizerEnum::CMAES;
+  // Substituting another optimizer would silently change the results.
+  throw std::invalid_argument(
+      "This optimizer cannot be run on the remote server. Set "
+      "CUDAQ_CLIENT_REMOTE_CAPABILITY_OVERRIDE=0 to run the optimization "
+      "loop on the client instead.");
 }
 
 inline void to_json(json &j, const cudaq::optimizers::BaseEnsmallen &p) {
@@ -317,6 +400,17 @@ inline void to_json(json &j, const cudaq::optimizers::base_nlopt &p) {
   TO_JSON_OPT_HELPER(f_tol);
 }
 
+inline void to_json(json &j, const cudaq::optimizers::cmaes &p) {
+  TO_JSON_OPT_HELPER(max_eval);
+  TO_JSON_OPT_HELPER(initial_parameters);
+  TO_JSON_OPT_HELPER(lower_bounds);
+  TO_JSON_OPT_HELPER(upper_bounds);
+  TO_JSON_OPT_HELPER(f_tol);
+  TO_JSON_OPT_HELPER(population_size);
+  TO_JSON_OPT_HELPER(sigma);
+  TO_JSON_OPT_HELPER(seed);
+}
+
 inline void to_json(json &j, const cudaq::optimizer &p) {
   if (auto *p2 = dynamic_cast<const cudaq::optimizers::lbfgs *>(&p))
     j = json(*p2);
@@ -332,6 +426,8 @@ inline void to_json(json &j, const cudaq::optimizer &p) {
   else if (auto *base_nlopt =
                dynamic_cast<const cudaq::optimizers::base_nlopt *>(&p))
     j = json(*base_nlopt);
+  else if (auto *p2 = dynamic_cast<const cudaq::optimizers::cmaes *>(&p))
+    j = json(*p2);
 }
 
 inline void from_json(const nlohmann::json &j,
@@ -387,6 +483,17 @@ inline void from_json(const nlohmann::json &j,
   FROM_JSON_OPT_HELPER(f_tol);
 }
 
+inline void from_json(const nlohmann::json &j, cudaq::optimizers::cmaes &p) {
+  FROM_JSON_OPT_HELPER(max_eval);
+  FROM_JSON_OPT_HELPER(initial_parameters);
+  FROM_JSON_OPT_HELPER(lower_bounds);
+  FROM_JSON_OPT_HELPER(upper_bounds);
+  FROM_JSON_OPT_HELPER(f_tol);
+  FROM_JSON_OPT_HELPER(population_size);
+  FROM_JSON_OPT_HELPER(sigma);
+  FROM_JSON_OPT_HELPER(seed);
+}
+
 inline std::unique_ptr<cudaq::optimizer>
 make_optimizer_from_json(const nlohmann::json &j,
                          const OptimizerEnum optimizer_type) {
@@ -426,6 +533,11 @@ make_optimizer_from_json(const nlohmann::json &j,
     from_json(j, *ret_ptr);
     return ret_ptr;
   }
+  case OptimizerEnum::CMAES: {
+    auto ret_ptr = std::make_unique<cudaq::optimizers::cmaes>();
+    from_json(j, *ret_ptr);
+    return ret_ptr;
+  }
   }
   // This shouldn't happen, but gracefully handle it if it does.
   return std::make_unique<cudaq::optimizers::cobyla>();
@@ -433,11 +545,17 @@ make_optimizer_from_json(const nlohmann::json &j,
 
 // ----- cudaq::gradient serialization/deserialization support below
 
-enum class GradientEnum { CENTRAL_DIFF, FORWARD_DIFF, PARAMETER_SHIFT };
+enum class GradientEnum {
+  CENTRAL_DIFF,
+  FORWARD_DIFF,
+  PARAMETER_SHIFT,
+  ADJOINT
+};
 NLOHMANN_JSON_SERIALIZE_ENUM(GradientEnum,
                              {JSON_ENUM(GradientEnum, CENTRAL_DIFF),
                               JSON_ENUM(GradientEnum, FORWARD_DIFF),
-                              JSON_ENUM(GradientEnum, PARAMETER_SHIFT)});
+                              JSON_ENUM(GradientEnum, PARAMETER_SHIFT),
+                              JSON_ENUM(GradientEnum, ADJOINT)});
 
 inline GradientEnum get_gradient_type(const cudaq::gradient &p) {
   if (dynamic_cast<const cudaq::gradients::central_difference *>(&p))
@@ -446,8 +564,13 @@ inline GradientEnum get_gradient_type(const cudaq::gradient &p) {
     return GradientEnum::FORWARD_DIFF;
   if (dynamic_cast<const cudaq::gradients::parameter_shift *>(&p))
     return GradientEnum::PARAMETER_SHIFT;
-  // This shouldn't happen, but handle it gracefully if it does.
-  return GradientEnum::CENTRAL_DIFF;
+  if (dynamic_cast<const cudaq::gradients::adjoint *>(&p))
+    return GradientEnum::ADJOINT;
+  // Substituting another gradient would silently change the results.
+  throw std::invalid_argument(
+      "This gradient cannot be run on the remote server. Set "
+      "CUDAQ_CLIENT_REMOTE_CAPABILITY_OVERRIDE=0 to run the optimization "
+      "loop on the client instead.");
 }
 
 // These do not attempt to serialize or deserialize the quantum kernel
@@ -457,6 +580,7 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(cudaq::gradients::central_difference, step);
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(cudaq::gradients::forward_difference, step);
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(cudaq::gradients::parameter_shift,
                                    shiftScalar);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(cudaq::gradients::adjoint, step);
 
 inline void to_json(json &j, const cudaq::gradient &p) {
   if (auto *central_difference =
@@ -468,6 +592,8 @@ inline void to_json(json &j, const cudaq::gradient &p) {
   else if (auto *parameter_shift =
                dynamic_cast<const cudaq::gradients::parameter_shift *>(&p))
     j = json(*parameter_shift);
+  else if (auto *adjoint = dynamic_cast<const cudaq::gradients::adjoint *>(&p))
+    j = json(*adjoint);
 }
 
 inline std::unique_ptr<cudaq::gradient>
@@ -489,6 +615,11 @@ make_gradient_from_json(const nlohmann::json &j,
     from_json(j, *ret_ptr);
     return ret_ptr;
   }
+  case GradientEnum::ADJOINT: {
+    auto ret_ptr = std::make_unique<cudaq::gradients::adjoint>();
+    from_json(j, *ret_ptr);
+    return ret_ptr;
+  }
   }
   // This shouldn't happen, but handle it gracefully if it does.
   return std::make_unique<cudaq::gradients::central_difference>();
@@ -572,7 +703,7 @@ public:
   //     e.g., changing the simulator names (.so files), changing signatures of
   //     QIR functions, etc.
   static constexpr std::size_t REST_PAYLOAD_VERSION = 1;
-  static constexpr std::size_t REST_PAYLOAD_MINOR_VERSION = 1;
+  static constexpr std::size_t REST_PAYLOAD_MINOR_VERSION = 2;
   RestRequest(ExecutionContext &context, int versionNumber)
       : executionContext(context), version(versionNumber),
         clientVersion(CUDA_QUANTUM_VERSION) {}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "KernelArchive.h"
+#include "Logger.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+// Bumped whenever the layout of the entries changes.
+static constexpr int archiveVersion = 1;
+
+cudaq::KernelArchive::KernelArchive(std::string path, std::string target,
+                                    bool record)
+    : path(std::move(path)), target(std::move(target)), record(record) {
+  std::ifstream file(this->path);
+  if (!file) {
+    if (!record)
+      CUDAQ_WARN("Kernel archive {} not found, kernels are compiled at "
+                 "runtime.",
+                 this->path);
+    return;
+  }
+  auto archive = nlohmann::json::parse(file, nullptr,
+                                       /*allow_exceptions=*/false);
+  if (archive.is_discarded() || !archive.contains("entries"))
+    throw std::runtime_error("Malformed kernel archive " + this->path + ".");
+  if (archive.value("version", 0) != archiveVersion ||
+      archive.value("target", "") != this->target) {
+    CUDAQ_WARN("Ignoring the kernel archive {}, which was recorded for target "
+               "'{}' by another version of CUDA-Q, or for another target than "
+               "'{}'.",
+               this->path, archive.value("target", ""), this->target);
+    return;
+  }
+  for (auto &[key, codes] : archive["entries"].items())
+    entries.emplace(key, std::move(codes));
+  CUDAQ_INFO("Loaded {} precompiled kernel launches from {}.", entries.size(),
+             this->path);
+}
+
+std::optional<std::vector<cudaq::KernelExecution>>
+cudaq::KernelArchive::lookup(const std::string &key) const {
+  std::scoped_lock<std::mutex> lock(mutex);
+  auto iter = entries.find(key);
+  if (iter == entries.end())
+    return std::nullopt;
+  std::vector<KernelExecution> codes;
+  for (auto &c : iter->second) {
+    auto name = c.at("name").get<std::string>();
+    auto code = c.at("code").get<std::string>();
+    auto outputNames = c.at("output_names");
+    auto reorder = c.at("mapping_reorder_idx").get<std::vector<std::size_t>>();
+    codes.emplace_back(name, code, outputNames, reorder);
+  }
+  return codes;
+}
+
+void cudaq::KernelArchive::add(const std::string &key,
+                               const std::vector<KernelExecution> &codes) {
+  if (!record)
+    return;
+  nlohmann::json entry = nlohmann::json::array();
+  for (const auto &c : codes)
+    entry.push_back({{"name", c.name},
+                     {"code", c.code},
+                     {"output_names", c.output_names},
+                     {"mapping_reorder_idx", c.mapping_reorder_idx}});
+  std::scoped_lock<std::mutex> lock(mutex);
+  if (!entries.emplace(key, std::move(entry)).second)
+    return;
+  save();
+}
+
+std::size_t cudaq::KernelArchive::size() const {
+  std::scoped_lock<std::mutex> lock(mutex);
+  return entries.size();
+}
+
+void cudaq::KernelArchive::save() const {
+  nlohmann::json archive{{"version", archiveVersion},
+                         {"target", target},
+                         {"entries", nlohmann::json::object()}};
+  for (const auto &[key, codes] : entries)
+    archive["entries"][key] = codes;
+
+  // Write a temporary file and rename it into place, so that readers never
+  // see a partial archive.
+  const auto tmpPath = path + "." + std::to_string(::getpid()) + ".tmp";
+  {
+    std::ofstream file(tmpPath);
+    file << archive.dump();
+    if (!file) {
+      CUDAQ_WARN("Unable to write the kernel archive {}.", path);
+      std::filesystem::remove(tmpPath);
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    CUDAQ_WARN("Unable to write the kernel archive {}: {}", path,
+               ec.message());
+    std::filesystem::remove(tmpPath);
+    return;
+  }
+  CUDAQ_INFO("Recorded {} precompiled kernel launches in {}.", entries.size(),
+             path);
+}
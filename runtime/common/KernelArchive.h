@@ -0,0 +1,58 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "common/ServerHelper.h"
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief A file of kernels precompiled for a target, i.e., the codes sent to
+/// the server for each kernel launch, keyed by the lowering cache key of the
+/// launch (which covers the target pipeline, the code generation and the
+/// kernel with its synthesized arguments).
+///
+/// A binary built with `nvq++ --kernel-archive <file>` loads the archive when
+/// its target is set, and launches found in it skip the Quake lowering and
+/// the code generation entirely. The archive is recorded by running the
+/// binary once with `CUDAQ_KERNEL_ARCHIVE_RECORD=1`, e.g., as a build step on
+/// the known target, which adds the codes of every launch to the file. An
+/// archive recorded for another target is ignored.
+class KernelArchive {
+public:
+  /// @brief Load the archive at `path` for `target`, or start an empty one if
+  /// the file does not exist. If `record` is set, `add` writes new entries to
+  /// the file.
+  KernelArchive(std::string path, std::string target, bool record);
+
+  /// @brief Return the codes stored under `key`, if any.
+  std::optional<std::vector<KernelExecution>>
+  lookup(const std::string &key) const;
+
+  /// @brief Store the codes of `key` and write the archive, if recording.
+  void add(const std::string &key, const std::vector<KernelExecution> &codes);
+
+  /// @brief Return the number of entries.
+  std::size_t size() const;
+
+private:
+  /// @brief Write the archive, atomically.
+  void save() const;
+
+  std::string path;
+  std::string target;
+  bool record;
+  mutable std::mutex mutex;
+  std::unordered_map<std::string, nlohmann::json> entries;
+};
+
+} // namespace cudaq
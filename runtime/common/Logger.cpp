@@ -10,17 +10,23 @@
 #include "FmtCore.h"
 #include "Timing.h"
 #include "fmt/args.h"
-#include <filesystem>
+#include <algorithm>
+#include <cstdlib>
 #include <set>
+#include <spdlog/async.h>
 #include <spdlog/cfg/env.h>
 #include <spdlog/cfg/helpers.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 #include <sstream>
 
 namespace cudaq {
 
+std::atomic<int> details::activeLogLevel =
+    static_cast<int>(details::LogLevel::warn);
+
 // This must be a function rather than a global variable to avoid a startup
 // ordering issue that would otherwise occur if we simply made this a global
 // variable and then accessed it in the initializeLogger function.
@@ -30,6 +36,12 @@ static std::set<int> &g_timingList() {
   return timingList;
 }
 
+// Mirror the level of the default logger in `activeLogLevel`. This must follow
+// every change of the spdlog level or of the default logger.
+static void updateActiveLogLevel() {
+  details::activeLogLevel = static_cast<int>(spdlog::get_level());
+}
+
 bool isTimingTagEnabled(int tag) {
   // Note: this function is called very frequently, so it needs to be fast. It
   // is assumed that g_timingList() contains a small number of elements
@@ -42,7 +54,7 @@ bool isTimingTagEnabled(int tag) {
 /// level and optionally dump to file if specified.
 __attribute__((constructor)) void initializeLogger() {
   // Default to no logging
-  spdlog::set_level(spdlog::level::warn);
+  details::setLogLevel(details::LogLevel::warn);
 
   // but someone can specify CUDAQ_LOG_LEVEL=info (for example)
   // as an environment variable. Can also stack them
@@ -50,14 +62,42 @@ __attribute__((constructor)) void initializeLogger() {
   auto envVal = spdlog::details::os::getenv("CUDAQ_LOG_LEVEL");
   if (!envVal.empty()) {
     spdlog::cfg::helpers::load_levels(envVal);
+    updateActiveLogLevel();
+  }
+
+  // With CUDAQ_LOG_ASYNC set, messages are queued to a ring buffer and
+  // written by a background thread, so that logging does not change the
+  // timing of the logging threads. The oldest messages are dropped rather
+  // than blocking when the buffer is full.
+  const bool async = [] {
+    auto val = spdlog::details::os::getenv("CUDAQ_LOG_ASYNC");
+    return !val.empty() && val != "0" && val != "false" && val != "off";
+  }();
+  if (async) {
+    std::size_t queueSize = 8192;
+    auto sizeVal = spdlog::details::os::getenv("CUDAQ_LOG_ASYNC_QUEUE_SIZE");
+    if (!sizeVal.empty())
+      queueSize = std::max<std::size_t>(std::stoul(sizeVal), 1);
+    spdlog::init_thread_pool(queueSize, 1);
+    // Write the messages still queued at exit, before the registry (created
+    // above) is destroyed.
+    std::atexit([] { spdlog::shutdown(); });
   }
 
   envVal = spdlog::details::os::getenv("CUDAQ_LOG_FILE");
   if (!envVal.empty()) {
-    auto fileLogger = spdlog::basic_logger_mt("cudaqFileLogger", envVal);
+    auto fileLogger =
+        async ? spdlog::create_async_nb<spdlog::sinks::basic_file_sink_mt>(
+                    "cudaqFileLogger", envVal)
+              : spdlog::basic_logger_mt("cudaqFileLogger", envVal);
     spdlog::set_default_logger(fileLogger);
     spdlog::flush_on(spdlog::get_level());
+  } else if (async) {
+    spdlog::set_default_logger(
+        spdlog::create_async_nb<spdlog::sinks::stdout_color_sink_mt>(
+            "cudaqAsyncLogger"));
   }
+  updateActiveLogLevel();
 
   // Parse comma separated integers into g_timingList. Process integer values
   // like this: "1,3,5,7-10,12".
@@ -90,6 +130,14 @@ __attribute__((constructor)) void initializeLogger() {
 }
 
 namespace details {
+void setLogLevel(const LogLevel logLevel) {
+  spdlog::set_level(static_cast<spdlog::level::level_enum>(logLevel));
+  // The file logger writes each message it logs to disk right away.
+  if (auto fileLogger = spdlog::get("cudaqFileLogger"))
+    fileLogger->flush_on(spdlog::get_level());
+  updateActiveLogLevel();
+}
+
 void trace(const std::string_view msg) { spdlog::trace(msg); }
 void info(const std::string_view msg) { spdlog::info(msg); }
 void warn(const std::string_view msg) { spdlog::warn(msg); }
@@ -111,12 +159,8 @@ static_assert(static_cast<int>(LogLevel::info) ==
 static_assert(static_cast<int>(LogLevel::warn) ==
                   static_cast<int>(spdlog::level::warn),
               "log level enum mismatch");
-bool should_log(const LogLevel logLevel) {
-  return spdlog::should_log(static_cast<spdlog::level::level_enum>(logLevel));
-}
 std::string pathToFileName(const std::string_view fullFilePath) {
-  const std::filesystem::path file(fullFilePath);
-  return file.filename().string();
+  return std::string(fullFilePath.substr(fullFilePath.find_last_of('/') + 1));
 }
 } // namespace details
 } // namespace cudaq
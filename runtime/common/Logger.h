@@ -9,6 +9,14 @@
 #pragma once
 
 #include "common/cudaq_fmt.h"
+#include <atomic>
+
+/// Messages below this level (0: trace, 1: debug, 2: info, 3: warn) are
+/// removed at compile time by the logging macros, e.g., define it to 3 to
+/// remove the info messages of a translation unit from hot paths.
+#ifndef CUDAQ_LOG_ACTIVE_LEVEL
+#define CUDAQ_LOG_ACTIVE_LEVEL 0
+#endif
 
 namespace cudaq {
 
@@ -21,7 +29,16 @@ namespace details {
 // This enum must match spdlog::level enums. This is checked via static_assert
 // in Logger.cpp.
 enum class LogLevel { trace, debug, info, warn };
-bool should_log(const LogLevel logLevel);
+/// The level of the default logger, mirrored here so that disabled messages
+/// only cost an atomic load.
+extern std::atomic<int> activeLogLevel;
+inline bool should_log(const LogLevel logLevel) {
+  return static_cast<int>(logLevel) >=
+         activeLogLevel.load(std::memory_order_relaxed);
+}
+/// Set the level of the default logger. Levels must be changed through this
+/// function, rather than spdlog, for `should_log` to follow them.
+void setLogLevel(const LogLevel logLevel);
 void trace(const std::string_view msg);
 void info(const std::string_view msg);
 void debug(const std::string_view msg);
@@ -46,15 +63,10 @@ std::string pathToFileName(const std::string_view fullFilePath);
          const char *funcName = __builtin_FUNCTION(),                          \
          const char *fileName = __builtin_FILE(),                              \
          int lineNo = __builtin_LINE()) {                                      \
-      if (details::should_log(details::LogLevel::NAME)) {                      \
-        auto msg = cudaq_fmt::format(message, args...);                        \
-        std::string name = funcName;                                           \
-        auto start = name.find_first_of(" ");                                  \
-        name = name.substr(start + 1, name.find_first_of("(") - start - 1);    \
-        msg = "[" + details::pathToFileName(fileName) + ":" +                  \
-              std::to_string(lineNo) + "] " + msg;                             \
-        details::NAME(msg);                                                    \
-      }                                                                        \
+      if (details::should_log(details::LogLevel::NAME))                        \
+        details::NAME("[" + details::pathToFileName(fileName) + ":" +          \
+                      std::to_string(lineNo) + "] " +                          \
+                      cudaq_fmt::format(message, args...));                    \
     }                                                                          \
   };                                                                           \
   template <typename... Args>                                                  \
@@ -272,16 +284,22 @@ public:
 
 // The following macros avoid the unnecessary processing cost of argument
 // evaluation and string formation until after the log level check is done.
+// Levels below CUDAQ_LOG_ACTIVE_LEVEL fold the check to false at compile time.
+#define CUDAQ_LOG_LEVEL_ENABLED(LEVEL)                                         \
+  (static_cast<int>(::cudaq::details::LogLevel::LEVEL) >=                      \
+       CUDAQ_LOG_ACTIVE_LEVEL &&                                               \
+   ::cudaq::details::should_log(::cudaq::details::LogLevel::LEVEL))
+
 #define CUDAQ_WARN(...)                                                        \
   do {                                                                         \
-    if (::cudaq::details::should_log(::cudaq::details::LogLevel::warn)) {      \
+    if (CUDAQ_LOG_LEVEL_ENABLED(warn)) {                                       \
       ::cudaq::warn(__VA_ARGS__);                                              \
     }                                                                          \
   } while (false)
 
 #define CUDAQ_INFO(...)                                                        \
   do {                                                                         \
-    if (::cudaq::details::should_log(::cudaq::details::LogLevel::info)) {      \
+    if (CUDAQ_LOG_LEVEL_ENABLED(info)) {                                       \
       ::cudaq::info(__VA_ARGS__);                                              \
     }                                                                          \
   } while (false)
@@ -289,7 +307,7 @@ public:
 #ifdef CUDAQ_DEBUG
 #define CUDAQ_DBG(...)                                                         \
   do {                                                                         \
-    if (::cudaq::details::should_log(::cudaq::details::LogLevel::debug)) {     \
+    if (CUDAQ_LOG_LEVEL_ENABLED(debug)) {                                      \
       ::cudaq::debug(__VA_ARGS__);                                             \
     }                                                                          \
   } while (false)
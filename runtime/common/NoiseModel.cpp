@@ -11,6 +11,8 @@
 #include "Logger.h"
 #include "common/CustomOp.h"
 #include "common/EigenDense.h"
+#include <algorithm>
+#include <iterator>
 #include <numeric>
 #include <optional>
 
@@ -231,12 +233,12 @@ void noise_model::add_channel(const std::string &quantumOp,
         std::to_string(channelDim) + " on " + std::to_string(nQubits) +
         " qubits.");
 
-  auto key = std::make_pair(quantumOp, qubits);
-  auto iter = noiseModel.find(key);
-  if (iter == noiseModel.end()) {
+  auto &qubitChannels = noiseModel[quantumOp].qubitChannels;
+  auto iter = qubitChannels.find(qubits);
+  if (iter == qubitChannels.end()) {
     CUDAQ_INFO("Adding new kraus_channel to noise_model ({}, {})", quantumOp,
                qubits);
-    noiseModel.insert({key, {channel}});
+    qubitChannels.insert({qubits, {channel}});
     return;
   }
 
@@ -247,9 +249,8 @@ void noise_model::add_channel(const std::string &quantumOp,
   iter->second.push_back(channel);
 }
 
-void noise_model::add_all_qubit_channel(const std::string &quantumOp,
-                                        const kraus_channel &channel,
-                                        int numControls) {
+std::string noise_model::resolveControlledOp(const std::string &quantumOp,
+                                            int &numControls) {
   auto actualGateName = quantumOp;
   const bool isCustomOp =
       customOpRegistry::getInstance().isOperationRegistered(actualGateName);
@@ -272,13 +273,21 @@ void noise_model::add_all_qubit_channel(const std::string &quantumOp,
       !isCustomOp)
     throw std::runtime_error(
         "Invalid quantum op for noise_model::add_channel (" + quantumOp + ").");
-  GateIdentifier key(actualGateName, numControls);
-  auto iter = defaultNoiseModel.find(key);
-  if (iter == defaultNoiseModel.end()) {
+  return actualGateName;
+}
+
+void noise_model::add_all_qubit_channel(const std::string &quantumOp,
+                                        const kraus_channel &channel,
+                                        int numControls) {
+  const auto actualGateName = resolveControlledOp(quantumOp, numControls);
+  auto &allQubitChannels = noiseModel[actualGateName].allQubitChannels;
+  auto iter = allQubitChannels.find(numControls);
+  if (iter == allQubitChannels.end()) {
     CUDAQ_INFO("Adding new all-qubit kraus_channel to noise_model ({}, number "
                "of control bits = {})",
                actualGateName, numControls);
-    defaultNoiseModel.insert({key, {channel}});
+    allQubitChannels.emplace(static_cast<std::size_t>(numControls),
+                             std::vector<kraus_channel>{channel});
     return;
   }
 
@@ -289,6 +298,75 @@ void noise_model::add_all_qubit_channel(const std::string &quantumOp,
   iter->second.push_back(channel);
 }
 
+// Return the Pauli of each branch of a single-qubit unitary mixture, as one of
+// 'I', 'X', 'Y', or 'Z', or an empty string if the channel is not a mixture of
+// Pauli operators.
+static std::string getPauliBranches(const kraus_channel &channel) {
+  if (!channel.is_unitary_mixture() || channel.dimension() != 2)
+    return {};
+  constexpr double eps = 1e-9;
+  const auto isZero = [](std::complex<double> c) { return std::abs(c) < eps; };
+  std::string paulis;
+  for (const auto &op : channel.unitary_ops) {
+    if (isZero(op[1]) && isZero(op[2]) && isZero(op[0] - op[3]))
+      paulis += 'I';
+    else if (isZero(op[1]) && isZero(op[2]) && isZero(op[0] + op[3]))
+      paulis += 'Z';
+    else if (isZero(op[0]) && isZero(op[3]) && isZero(op[1] - op[2]))
+      paulis += 'X';
+    else if (isZero(op[0]) && isZero(op[3]) && isZero(op[1] + op[2]))
+      paulis += 'Y';
+    else
+      return {};
+  }
+  return paulis;
+}
+
+void noise_model::add_crosstalk_channel(const std::string &quantumOp,
+                                        const coupling_map &couplingMap,
+                                        const kraus_channel &channel,
+                                        int numControls) {
+  const auto actualGateName = resolveControlledOp(quantumOp, numControls);
+  if (channel.empty() || channel.dimension() != 2)
+    throw std::runtime_error("Dimension mismatch - crosstalk kraus_channel "
+                             "must be a single-qubit channel.");
+
+  CrosstalkNoise noise{{channel, getPauliBranches(channel)}, {}, {}};
+  for (auto [q0, q1] : couplingMap) {
+    if (q0 == q1)
+      continue;
+    auto &n0 = noise.neighbours[q0];
+    if (std::find(n0.begin(), n0.end(), q1) == n0.end()) {
+      n0.push_back(q1);
+      noise.neighbours[q1].push_back(q0);
+    }
+  }
+  for (auto &[qubit, neighbours] : noise.neighbours)
+    std::sort(neighbours.begin(), neighbours.end());
+
+  // Precompute the spectators of all single qubits and coupled pairs.
+  for (const auto &[qubit, neighbours] : noise.neighbours) {
+    noise.spectators.emplace(std::vector<std::size_t>{qubit}, neighbours);
+    for (auto other : neighbours) {
+      std::vector<std::size_t> spectators;
+      std::set_union(neighbours.begin(), neighbours.end(),
+                     noise.neighbours.at(other).begin(),
+                     noise.neighbours.at(other).end(),
+                     std::back_inserter(spectators));
+      std::erase_if(spectators,
+                    [&](std::size_t q) { return q == qubit || q == other; });
+      noise.spectators.emplace(std::vector<std::size_t>{qubit, other},
+                               std::move(spectators));
+    }
+  }
+
+  CUDAQ_INFO("Adding new crosstalk kraus_channel to noise_model ({}, number "
+             "of control bits = {}, {} coupled qubits)",
+             actualGateName, numControls, noise.neighbours.size());
+  noiseModel[actualGateName].crosstalkChannels[numControls].push_back(
+      std::move(noise));
+}
+
 void noise_model::add_channel(const std::string &quantumOp,
                               const PredicateFuncTy &pred) {
   if (std::find(std::begin(availableOps), std::end(availableOps), quantumOp) ==
@@ -296,11 +374,11 @@ void noise_model::add_channel(const std::string &quantumOp,
       !customOpRegistry::getInstance().isOperationRegistered(quantumOp))
     throw std::runtime_error(
         "Invalid quantum op for noise_model::add_channel (" + quantumOp + ").");
-  auto iter = gatePredicates.find(quantumOp);
-  if (iter == gatePredicates.end()) {
+  auto &opNoise = noiseModel[quantumOp];
+  if (!opNoise.predicate) {
     CUDAQ_INFO("Adding new callback kraus_channel to noise_model for {}.",
                quantumOp);
-    gatePredicates.insert({quantumOp, pred});
+    opNoise.predicate = pred;
     return;
   }
 
@@ -308,39 +386,52 @@ void noise_model::add_channel(const std::string &quantumOp,
                          quantumOp + " gate.");
 }
 
-std::vector<kraus_channel>
-noise_model::get_channels(const std::string &quantumOp,
-                          const std::vector<std::size_t> &targetQubits,
-                          const std::vector<std::size_t> &controlQubits,
-                          const std::vector<double> &params) const {
-  std::vector<std::size_t> qubits{controlQubits.begin(), controlQubits.end()};
-  qubits.insert(qubits.end(), targetQubits.begin(), targetQubits.end());
+void noise_model::for_each_channel(
+    std::string_view quantumOp, const std::vector<std::size_t> &targetQubits,
+    const std::vector<std::size_t> &controlQubits,
+    const std::vector<double> &params,
+    const std::function<void(const kraus_channel &)> &apply) const {
+  const auto combineQubits = [&]() {
+    std::vector<std::size_t> qubits;
+    qubits.reserve(controlQubits.size() + targetQubits.size());
+    qubits.insert(qubits.end(), controlQubits.begin(), controlQubits.end());
+    qubits.insert(qubits.end(), targetQubits.begin(), targetQubits.end());
+    return qubits;
+  };
+
+  // Most gates don't have any noise, so check this first before doing any
+  // other work.
+  auto opIter = noiseModel.find(quantumOp);
+  if (opIter == noiseModel.end()) {
+    CUDAQ_INFO("No kraus_channel available for {} on {}.", quantumOp,
+               combineQubits());
+    return;
+  }
+  const auto &opNoise = opIter->second;
+  const auto qubits = combineQubits();
+  const auto dim = 1UL << qubits.size();
   const auto verifyChannelDimension =
-      [&](const std::vector<kraus_channel> &channels) {
-        auto nQubits = qubits.size();
-        auto dim = 1UL << nQubits;
+      [dim](const std::vector<kraus_channel> &channels) {
         return std::all_of(
             channels.begin(), channels.end(), [dim](const auto &channel) {
               return channel.empty() || channel.dimension() == dim;
             });
       };
+  bool foundChannel = false;
 
-  std::vector<kraus_channel> resultChannels;
   // Search qubit-specific noise settings
-  auto key = std::make_pair(quantumOp, qubits);
-  auto iter = noiseModel.find(key);
+  auto iter = opNoise.qubitChannels.find(qubits);
   // Note: we've validated the channel dimension in the 'add_channel' method.
-  if (iter != noiseModel.end()) {
+  if (iter != opNoise.qubitChannels.end()) {
     CUDAQ_INFO("Found kraus_channel for {} on {}.", quantumOp, qubits);
-    const auto &krausChannel = iter->second;
-    resultChannels.insert(resultChannels.end(), krausChannel.begin(),
-                          krausChannel.end());
+    for (const auto &krausChannel : iter->second)
+      apply(krausChannel);
+    foundChannel = foundChannel || !iter->second.empty();
   }
 
   // Look up default noise channel
-  auto defaultIter =
-      defaultNoiseModel.find(GateIdentifier(quantumOp, controlQubits.size()));
-  if (defaultIter != defaultNoiseModel.end()) {
+  auto defaultIter = opNoise.allQubitChannels.find(controlQubits.size());
+  if (defaultIter != opNoise.allQubitChannels.end()) {
     CUDAQ_INFO(
         "Found default kraus_channel setting for {} with {} control bits.",
         quantumOp, controlQubits.size());
@@ -350,32 +441,83 @@ noise_model::get_channels(const std::string &quantumOp,
           fmt::format("Dimension mismatch: all-qubit kraus_channel with for "
                       "{} with {} control qubits encountered unexpected "
                       "kraus operator dimension (expecting dimension of {}).",
-                      quantumOp, controlQubits.size(), 1UL << qubits.size()));
+                      quantumOp, controlQubits.size(), dim));
 
-    const auto &krausChannel = defaultIter->second;
-    resultChannels.insert(resultChannels.end(), krausChannel.begin(),
-                          krausChannel.end());
+    for (const auto &krausChannel : defaultIter->second)
+      apply(krausChannel);
+    foundChannel = foundChannel || !defaultIter->second.empty();
   }
 
   // Look up predicate-specific noise settings
-  auto predIter = gatePredicates.find(quantumOp);
-  if (predIter != gatePredicates.end()) {
+  if (opNoise.predicate) {
     CUDAQ_INFO("Found callback kraus_channel setting for {}.", quantumOp);
-    const auto krausChannel = predIter->second(qubits, params);
+    const auto krausChannel = opNoise.predicate(qubits, params);
     if (!verifyChannelDimension({krausChannel}))
       throw std::runtime_error(fmt::format(
           "Dimension mismatch: kraus_channel with for "
           "{} on qubits {} with gate parameters {} encountered unexpected "
           "kraus operator dimension (expecting dimension of {}, got {}).",
-          quantumOp, qubits, params, 1UL << qubits.size(),
-          krausChannel.dimension()));
-    if (!krausChannel.empty())
-      resultChannels.emplace_back(krausChannel);
+          quantumOp, qubits, params, dim, krausChannel.dimension()));
+    if (!krausChannel.empty()) {
+      apply(krausChannel);
+      foundChannel = true;
+    }
   }
 
-  if (resultChannels.empty())
+  if (!foundChannel)
     CUDAQ_INFO("No kraus_channel available for {} on {}.", quantumOp, qubits);
+}
+
+void noise_model::for_each_crosstalk_channel(
+    std::string_view quantumOp, const std::vector<std::size_t> &targetQubits,
+    const std::vector<std::size_t> &controlQubits,
+    const std::function<void(const crosstalk_channel &,
+                             const std::vector<std::size_t> &)> &apply) const {
+  auto opIter = noiseModel.find(quantumOp);
+  if (opIter == noiseModel.end())
+    return;
+  auto iter = opIter->second.crosstalkChannels.find(controlQubits.size());
+  if (iter == opIter->second.crosstalkChannels.end())
+    return;
 
+  std::vector<std::size_t> qubits;
+  qubits.reserve(controlQubits.size() + targetQubits.size());
+  qubits.insert(qubits.end(), controlQubits.begin(), controlQubits.end());
+  qubits.insert(qubits.end(), targetQubits.begin(), targetQubits.end());
+  std::vector<std::size_t> spectators;
+  for (const auto &noise : iter->second) {
+    if (auto cached = noise.spectators.find(qubits);
+        cached != noise.spectators.end()) {
+      if (!cached->second.empty())
+        apply(noise.crosstalk, cached->second);
+      continue;
+    }
+    // Operands that are not a single qubit or a coupled pair
+    spectators.clear();
+    for (auto qubit : qubits)
+      if (auto neighbours = noise.neighbours.find(qubit);
+          neighbours != noise.neighbours.end())
+        for (auto q : neighbours->second)
+          if (std::find(qubits.begin(), qubits.end(), q) == qubits.end())
+            spectators.push_back(q);
+    std::sort(spectators.begin(), spectators.end());
+    spectators.erase(std::unique(spectators.begin(), spectators.end()),
+                     spectators.end());
+    if (!spectators.empty())
+      apply(noise.crosstalk, spectators);
+  }
+}
+
+std::vector<kraus_channel>
+noise_model::get_channels(const std::string &quantumOp,
+                          const std::vector<std::size_t> &targetQubits,
+                          const std::vector<std::size_t> &controlQubits,
+                          const std::vector<double> &params) const {
+  std::vector<kraus_channel> resultChannels;
+  for_each_channel(quantumOp, targetQubits, controlQubits, params,
+                   [&](const kraus_channel &channel) {
+                     resultChannels.push_back(channel);
+                   });
   return resultChannels;
 }
 
@@ -14,6 +14,8 @@
 #include <cstdint>
 #include <functional>
 #include <math.h>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -317,68 +319,96 @@ public:
   using PredicateFuncTy = std::function<kraus_channel(
       const std::vector<std::size_t> &, const std::vector<double> &)>;
 
+  /// @brief A single-qubit Kraus channel applied, after an operation, to each
+  /// of its spectators, i.e., the qubits coupled to an operand of the
+  /// operation that are not operands themselves.
+  struct crosstalk_channel {
+    kraus_channel channel;
+    /// @brief If the channel is a mixture of Pauli operators, the Pauli of
+    /// each of its branches, as one of 'I', 'X', 'Y', or 'Z'. Empty otherwise.
+    /// Simulators can then sample the branches of all spectators at once and
+    /// apply them as a single multi-qubit Pauli operator.
+    std::string paulis;
+  };
+
+  /// @brief The connections between pairs of qubits of a device.
+  using coupling_map = std::vector<std::pair<std::size_t, std::size_t>>;
+
 protected:
-  /// @brief Noise Model data map key is a (quantum Op + qubits applied to)
-  using KeyT = std::pair<std::string, std::vector<std::size_t>>;
-
-  /// @brief unordered_map will need a custom hash function
-  struct KeyTHash {
-    template <class T, class U>
-    std::size_t operator()(const std::pair<T, U> &p) const {
-      auto hash = std::hash<T>{}(p.first);
-      hash ^= p.second.size();
-      for (auto &i : p.second) {
+  /// @brief Hash function for the qubits (controls followed by targets) that
+  /// a quantum operation is applied to.
+  struct QubitsHash {
+    std::size_t operator()(const std::vector<std::size_t> &qubits) const {
+      std::size_t hash = qubits.size();
+      for (auto &i : qubits) {
         hash ^= i + 0x9e3779b9 + (hash << 6) + (hash >> 2);
       }
       return hash;
     }
   };
 
-  /// @brief Useful typedef for the noise model data map
-  using NoiseModelOpMap =
-      std::unordered_map<KeyT, std::vector<kraus_channel>, KeyTHash>;
-
-  // The noise model is a mapping of quantum operation
-  // names to a Kraus channel applied after the operation is applied.
-  NoiseModelOpMap noiseModel;
-
-  /// @brief Gate identity for a match-all condition.
-  // In this case, it will match an operation with any qubits.
-  // The controlled versions of a gate are tracked by the number of control
-  // qubits.
-  struct GateIdentifier {
-    std::string name;
-    std::size_t numControls;
-    bool operator==(const GateIdentifier &other) const {
-      return other.name == name && other.numControls == numControls;
-    };
+  /// @brief Transparent hash function for quantum operation names, such that
+  /// the noise model can be queried with a `std::string_view` without
+  /// allocating a string for each applied gate.
+  struct OpNameHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view name) const {
+      return std::hash<std::string_view>{}(name);
+    }
   };
 
-  // In addition to specific (gate + operands) map, we have a default map,
-  // which tracks noise channels attached to all operations of that type.
-  // This map is keyed by the gate-name + number of control bits, e.g., x(1)
-  // means cnot.
-  struct GateIdentifierHash {
-    std::size_t operator()(const GateIdentifier &p) const {
-      const std::string fullName =
-          p.name + "(" + std::to_string(p.numControls) + ")";
-      return std::hash<std::string>{}(fullName);
-    }
+  /// @brief A crosstalk channel together with the device topology it is
+  /// defined against.
+  struct CrosstalkNoise {
+    crosstalk_channel crosstalk;
+    /// @brief The qubits coupled to each qubit.
+    std::unordered_map<std::size_t, std::vector<std::size_t>> neighbours;
+    /// @brief The spectators of each single qubit and of each pair of coupled
+    /// qubits (in both orders), i.e., of the most common operands.
+    std::unordered_map<std::vector<std::size_t>, std::vector<std::size_t>,
+                       QubitsHash>
+        spectators;
   };
 
-  /// @brief Useful typedef for the noise model data map
-  using DefaultNoiseModelOpMap =
-      std::unordered_map<GateIdentifier, std::vector<kraus_channel>,
-                         GateIdentifierHash>;
-  /// @brief  Matched-all noise channel map
-  DefaultNoiseModelOpMap defaultNoiseModel;
+  /// @brief All noise settings for a single quantum operation.
+  struct OpNoise {
+    /// @brief Kraus channels applied after the operation is applied to
+    /// specific qubits (controls followed by targets).
+    std::unordered_map<std::vector<std::size_t>, std::vector<kraus_channel>,
+                       QubitsHash>
+        qubitChannels;
+
+    /// @brief Kraus channels applied after the operation is applied to any
+    /// qubits. The controlled versions of a gate are tracked by the number of
+    /// control qubits, e.g., the channels for x with 1 control apply to cnot.
+    std::unordered_map<std::size_t, std::vector<kraus_channel>>
+        allQubitChannels;
+
+    /// @brief Callback generating the Kraus channel for the operation, if any.
+    PredicateFuncTy predicate;
+
+    /// @brief Crosstalk channels applied after the operation is applied to
+    /// any qubits, by number of control qubits.
+    std::unordered_map<std::size_t, std::vector<CrosstalkNoise>>
+        crosstalkChannels;
+  };
 
-  /// @brief Noise model by callback function map
-  std::unordered_map<std::string, PredicateFuncTy> gatePredicates;
+  // The noise model is a mapping of quantum operation names to the Kraus
+  // channels applied after the operation is applied. Each gate applied during
+  // simulation needs a single lookup by name; operations without any noise
+  // settings are not in the map.
+  std::unordered_map<std::string, OpNoise, OpNameHash, std::equal_to<>>
+      noiseModel;
 
   static constexpr const char *availableOps[] = {
       "x", "y", "z", "h", "s", "t", "rx", "ry", "rz", "r1", "u3", "mz"};
 
+  /// @brief Return the name of the operation `quantumOp` refers to, without
+  /// the control prefixes, e.g., 'x' for 'cx', and set `numControls` to the
+  /// number of controls if it is 0. Throw if the operation is unknown.
+  static std::string resolveControlledOp(const std::string &quantumOp,
+                                         int &numControls);
+
   // User registered kraus channels for fine grain application
   std::unordered_map<
       std::intptr_t,
@@ -392,10 +422,7 @@ public:
 
   /// @brief Return true if there are no kraus_channels in this noise model.
   /// @return
-  bool empty() const {
-    return noiseModel.empty() && defaultNoiseModel.empty() &&
-           gatePredicates.empty();
-  }
+  bool empty() const { return noiseModel.empty(); }
 
   /// @brief Add the Kraus channel to the specified one-qubit quantum
   /// operation. It applies to the quantumOp operation for the specified
@@ -520,6 +547,20 @@ public:
   void add_all_qubit_channel(const std::string &quantumOp,
                              const kraus_channel &channel, int numControls = 0);
 
+  /// @brief Add a crosstalk channel to a quantum operation on any qubits: the
+  /// single-qubit `channel` is applied, after the operation, to each qubit
+  /// that is coupled to one of its operands by `couplingMap` without being an
+  /// operand itself. The spectators of single qubits and of coupled pairs are
+  /// computed once, here.
+  /// @param quantumOp Quantum operation that the noise channel applies to.
+  /// @param couplingMap The connections between qubits of the device.
+  /// @param channel The single-qubit Kraus channel to apply.
+  /// @param numControls Number of control qubits for the gate, inferred from
+  /// the name as for `add_all_qubit_channel` if 0.
+  void add_crosstalk_channel(const std::string &quantumOp,
+                             const coupling_map &couplingMap,
+                             const kraus_channel &channel, int numControls = 0);
+
   /// @brief Add the provided kraus_channel to all
   /// specified quantum operations.
   template <typename... QuantumOp>
@@ -567,6 +608,25 @@ public:
                const std::vector<std::size_t> &controlQubits = {},
                const std::vector<double> &params = {}) const;
 
+  /// @brief Invoke `apply` for each kraus_channel that applies to the given
+  /// quantum operation, in the same order as returned by `get_channels`.
+  /// Contrary to `get_channels`, this does not copy the channels, and is hence
+  /// better suited to be called for each gate during simulation.
+  void for_each_channel(
+      std::string_view quantumOp, const std::vector<std::size_t> &targetQubits,
+      const std::vector<std::size_t> &controlQubits,
+      const std::vector<double> &params,
+      const std::function<void(const kraus_channel &)> &apply) const;
+
+  /// @brief Invoke `apply` for each crosstalk channel that applies to the
+  /// given quantum operation, with the spectator qubits to apply it to, in
+  /// increasing order. Channels without spectators are skipped.
+  void for_each_crosstalk_channel(
+      std::string_view quantumOp, const std::vector<std::size_t> &targetQubits,
+      const std::vector<std::size_t> &controlQubits,
+      const std::function<void(const crosstalk_channel &,
+                               const std::vector<std::size_t> &)> &apply) const;
+
   /// @brief Get all kraus_channels on the given qubits
   template <typename QuantumOp>
   std::vector<kraus_channel>
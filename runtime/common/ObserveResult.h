@@ -12,6 +12,9 @@
 #include "cudaq/operators.h"
 
 #include <cassert>
+#include <map>
+#include <set>
+#include <string>
 
 namespace cudaq {
 
@@ -115,4 +118,78 @@ public:
   void dump() { data.dump(); }
 };
 
+namespace details {
+
+/// @brief Targets that measure each group of qubit-wise commuting terms of an
+/// observable with a single circuit (see `spin_op::group_commuting`) store the
+/// counts of that circuit in a register named after the term id of the group
+/// measurement basis, e.g., `X0Z1Z2` for the terms `X0Z1` and `Z1Z2`. The
+/// measured bits are ordered by qubit index. Return `data` with an additional
+/// register for every non-identity term of `H` that was not measured on its
+/// own, containing the marginal counts of a group that measured it.
+inline sample_result expand_group_results(const sample_result &data,
+                                          const spin_op &H) {
+  // Decode the measurement basis from each register name.
+  const auto names = data.register_names();
+  const std::set<std::string> registerNames(names.begin(), names.end());
+  std::vector<std::pair<std::string, std::map<std::size_t, pauli>>> bases;
+  for (const auto &name : registerNames) {
+    std::map<std::size_t, pauli> basis;
+    std::size_t pos = 0;
+    while (pos < name.size()) {
+      const auto letter = name[pos];
+      const auto end = name.find_first_not_of("0123456789", pos + 1);
+      if (std::string("XYZ").find(letter) == std::string::npos ||
+          end == pos + 1)
+        break;
+      const auto target = std::stoul(name.substr(pos + 1, end - pos - 1));
+      basis[target] = letter == 'X'   ? pauli::X
+                      : letter == 'Y' ? pauli::Y
+                                      : pauli::Z;
+      pos = end == std::string::npos ? name.size() : end;
+    }
+    if (pos == name.size() && !basis.empty())
+      bases.emplace_back(name, std::move(basis));
+  }
+
+  sample_result expanded = data;
+  for (const auto &term : H) {
+    if (term.is_identity())
+      continue;
+    const auto termId = term.get_term_id();
+    if (registerNames.count(termId))
+      continue;
+
+    for (const auto &[name, basis] : bases) {
+      // The position of each qubit of the term in the group measurement.
+      std::vector<std::size_t> positions;
+      for (const auto &op : term) {
+        if (op.as_pauli() == pauli::I)
+          continue;
+        auto iter = basis.find(op.target());
+        if (iter == basis.end() || iter->second != op.as_pauli()) {
+          positions.clear();
+          break;
+        }
+        positions.push_back(std::distance(basis.begin(), iter));
+      }
+      if (positions.empty())
+        continue;
+
+      ExecutionResult result(data.get_marginal(positions, name).to_map(),
+                             termId);
+      for (const auto &shot : data.sequential_data(name)) {
+        std::string bits;
+        for (auto position : positions)
+          bits += shot[position];
+        result.sequentialData.push_back(std::move(bits));
+      }
+      expanded.append(result);
+      break;
+    }
+  }
+  return expanded;
+}
+
+} // namespace details
 } // namespace cudaq
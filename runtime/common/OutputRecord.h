@@ -0,0 +1,41 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace cudaq {
+
+/// The type of an output record, as in the `OUTPUT` records of a QIR output
+/// log.
+enum struct OutputRecordType : std::uint8_t {
+  RESULT,
+  BOOL,
+  INT,
+  DOUBLE,
+  TUPLE,
+  ARRAY
+};
+
+/// An output record of a kernel launched with `cudaq::run()` on a local
+/// simulator. This is the binary form of an `OUTPUT` record of the QIR output
+/// log: the value is kept in its type rather than formatted as text, so that
+/// `RecordLogParser` can store it without parsing it back.
+struct OutputRecord {
+  OutputRecordType type;
+  /// The value of `RESULT`, `BOOL`, and `INT` records, and the number of
+  /// elements of `TUPLE` and `ARRAY` records.
+  std::int64_t intValue = 0;
+  /// The value of `DOUBLE` records.
+  double doubleValue = 0.;
+  /// The label of the record, if any.
+  std::string label;
+};
+} // namespace cudaq
@@ -0,0 +1,79 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "Profiler.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Pass/PassInstrumentation.h"
+#include "mlir/Pass/PassManager.h"
+#include <memory>
+#include <vector>
+
+namespace cudaq::profiler {
+
+/// @brief Pass instrumentation recording a `jit_pass` phase for each pass run
+/// by a pass manager, named after the pass and the symbol it runs on, e.g.,
+/// `canonicalize @__nvqpp__mlirgen__kernel`.
+// The passes on nested operations, e.g., function passes, may run on the
+// threads of the MLIR context, and are then recorded on these threads.
+class PassPhaseInstrumentation : public mlir::PassInstrumentation {
+public:
+  void runBeforePass(mlir::Pass *pass, mlir::Operation *op) override {
+    auto name = pass->getArgument().str();
+    if (name.empty())
+      name = pass->getName().str();
+    if (auto symName = op->getAttrOfType<mlir::StringAttr>(
+            mlir::SymbolTable::getSymbolAttrName()))
+      name += " @" + symName.str();
+    auto &phase = activePhases().emplace_back(
+        std::make_unique<ScopedPhase>(Phase::jit_pass, name));
+    phase->addCounter("ops_before", countOperations(op));
+  }
+
+  void runAfterPass(mlir::Pass *, mlir::Operation *op) override {
+    endPhase(op);
+  }
+
+  void runAfterPassFailed(mlir::Pass *, mlir::Operation *op) override {
+    endPhase(op);
+  }
+
+private:
+  /// The phases of the passes running on the calling thread, innermost last.
+  static std::vector<std::unique_ptr<ScopedPhase>> &activePhases() {
+    static thread_local std::vector<std::unique_ptr<ScopedPhase>> phases;
+    return phases;
+  }
+
+  static std::int64_t countOperations(mlir::Operation *op) {
+    std::int64_t count = 0;
+    op->walk([&](mlir::Operation *) { ++count; });
+    return count;
+  }
+
+  static void endPhase(mlir::Operation *op) {
+    auto &phases = activePhases();
+    if (phases.empty())
+      return;
+    phases.back()->addCounter("ops_after", countOperations(op));
+    phases.pop_back();
+  }
+};
+
+/// @brief Record each pass run by `pm`, if the profiler is recording phases
+/// and passes. To be called when setting up the pass manager.
+inline void instrumentPasses(mlir::PassManager &pm) {
+  if (isEnabled() && isRecordingPasses())
+    pm.addInstrumentation(std::make_unique<PassPhaseInstrumentation>());
+}
+
+} // namespace cudaq::profiler
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PerfCounters.h"
+#include "Environment.h"
+
+namespace cudaq {
+
+std::atomic<bool> details::perfCountersEnabled =
+    getEnvBool("CUDAQ_PERF_COUNTERS", false);
+
+namespace {
+thread_local perf_counters lastPerfCounters;
+}
+
+perf_counters &perf_counters::operator+=(const perf_counters &other) {
+  for (const auto &[name, count] : other.gates)
+    gates[name] += count;
+  for (const auto &[arity, count] : other.gates_by_arity)
+    gates_by_arity[arity] += count;
+  flushes += other.flushes;
+  bytes_moved += other.bytes_moved;
+  noise_channels += other.noise_channels;
+  apply_gate_seconds += other.apply_gate_seconds;
+  sample_seconds += other.sample_seconds;
+  observe_seconds += other.observe_seconds;
+  return *this;
+}
+
+void set_perf_counters_enabled(bool enable) {
+  details::perfCountersEnabled.store(enable, std::memory_order_relaxed);
+}
+
+perf_counters get_perf_counters() { return lastPerfCounters; }
+
+void set_last_perf_counters(const perf_counters &counters) {
+  lastPerfCounters = counters;
+}
+
+} // namespace cudaq
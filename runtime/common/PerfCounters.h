@@ -0,0 +1,76 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <string>
+
+/// Performance counters collected by the circuit simulators for each
+/// execution (e.g., each shot batch of `cudaq::sample`, or each
+/// `cudaq::observe`), meant to be exported by monitoring tools. Contrary to the
+/// `CUDAQ_TIMING_TAGS` summary, which is logged when the simulator is
+/// destroyed, the counters are attached to the `ExecutionContext` of the
+/// execution, and the counters of the last execution on the calling thread are
+/// returned by `cudaq::get_perf_counters()`.
+///
+/// Collection is disabled by default, and then only costs an atomic load per
+/// execution. Setting `CUDAQ_PERF_COUNTERS` to a true value enables it at
+/// startup.
+namespace cudaq {
+
+/// @brief The counters of a simulated execution.
+struct perf_counters {
+  /// Number of gates applied, by gate name. Gates fused by the simulator are
+  /// counted once as `fused`.
+  std::map<std::string, std::size_t> gates;
+  /// Number of gates applied, by number of qubits (controls and targets).
+  std::map<std::size_t, std::size_t> gates_by_arity;
+  /// Number of times the gate queue was flushed with gates in it.
+  std::size_t flushes = 0;
+  /// Bytes of state read and written by gate applications. Only estimated by
+  /// state vector simulators.
+  std::size_t bytes_moved = 0;
+  /// Number of noise channels applied after gates, as per the noise model.
+  std::size_t noise_channels = 0;
+  /// Wall time spent applying gates, in seconds.
+  double apply_gate_seconds = 0.;
+  /// Wall time spent sampling the state, in seconds.
+  double sample_seconds = 0.;
+  /// Wall time spent computing expectation values, in seconds. This includes
+  /// the basis changes and the sampling of simulators that measure terms.
+  double observe_seconds = 0.;
+
+  /// @brief Accumulate the counters of `other`.
+  perf_counters &operator+=(const perf_counters &other);
+};
+
+namespace details {
+extern std::atomic<bool> perfCountersEnabled;
+}
+
+/// @brief Return true if performance counters are being collected.
+inline bool perf_counters_enabled() {
+  return details::perfCountersEnabled.load(std::memory_order_relaxed);
+}
+
+/// @brief Start or stop collecting performance counters. Executions already
+/// started keep their current setting.
+void set_perf_counters_enabled(bool enable);
+
+/// @brief Return the counters of the last execution on the calling thread, or
+/// empty counters if none was recorded.
+perf_counters get_perf_counters();
+
+/// @brief Record `counters` as those of the last execution on the calling
+/// thread. Called by the simulators once an execution is complete.
+void set_last_perf_counters(const perf_counters &counters);
+
+} // namespace cudaq
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "Profiler.h"
+#include "Environment.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace cudaq::profiler {
+
+std::atomic<bool> details::enabled = false;
+std::atomic<bool> details::recordPasses = false;
+
+namespace {
+const auto epoch = std::chrono::steady_clock::now();
+std::mutex eventsMutex;
+std::vector<Event> events;
+std::atomic<std::uint32_t> nextThreadId = 0;
+thread_local std::uint32_t threadId = nextThreadId++;
+thread_local ScopedPhase *currentPhase = nullptr;
+thread_local std::uint32_t currentDepth = 0;
+
+/// Enables the profiler if `CUDAQ_PROFILE_FILE` is set, and writes the trace
+/// on exit. Declared after the events, so that it is destroyed before them.
+struct ProfileFileWriter {
+  std::string path;
+  ProfileFileWriter() {
+    if (const char *env = std::getenv("CUDAQ_PROFILE_FILE"); env && *env) {
+      path = env;
+      setEnabled(true);
+    }
+    setRecordPasses(getEnvBool("CUDAQ_PROFILE_PASSES", false));
+  }
+  ~ProfileFileWriter() {
+    if (path.empty())
+      return;
+    try {
+      writeChromeTrace(path);
+    } catch (const std::exception &e) {
+      std::fprintf(stderr, "WARNING: %s\n", e.what());
+    }
+  }
+} profileFileWriter;
+
+void writeJsonString(std::ostream &os, std::string_view str) {
+  os << '"';
+  for (char c : str) {
+    switch (c) {
+    case '"':
+      os << "\\\"";
+      break;
+    case '\\':
+      os << "\\\\";
+      break;
+    case '\n':
+      os << "\\n";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+        os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+           << static_cast<int>(c) << std::dec << std::setfill(' ');
+      else
+        os << c;
+    }
+  }
+  os << '"';
+}
+} // namespace
+
+const char *getPhaseName(Phase phase) {
+  switch (phase) {
+  case Phase::launch:
+    return "launch";
+  case Phase::jit_passes:
+    return "jit_passes";
+  case Phase::jit_pass:
+    return "jit_pass";
+  case Phase::argument_synthesis:
+    return "argument_synthesis";
+  case Phase::simulator_flush:
+    return "simulator_flush";
+  case Phase::sample_conversion:
+    return "sample_conversion";
+  case Phase::result_assembly:
+    return "result_assembly";
+  }
+  return "unknown";
+}
+
+void setEnabled(bool enable) {
+  details::enabled.store(enable, std::memory_order_relaxed);
+}
+
+void setRecordPasses(bool record) {
+  details::recordPasses.store(record, std::memory_order_relaxed);
+}
+
+std::vector<Event> getEvents() {
+  std::scoped_lock<std::mutex> lock(eventsMutex);
+  return events;
+}
+
+void clear() {
+  std::scoped_lock<std::mutex> lock(eventsMutex);
+  events.clear();
+}
+
+std::string toChromeTrace() {
+  auto recorded = getEvents();
+  const auto pid = ::getpid();
+  std::ostringstream os;
+  // Timestamps are in microseconds, keep nanosecond resolution.
+  os << std::fixed << std::setprecision(3);
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (std::size_t i = 0; i < recorded.size(); ++i) {
+    const auto &event = recorded[i];
+    if (i)
+      os << ',';
+    os << "{\"name\":";
+    writeJsonString(os, event.name.empty() ? getPhaseName(event.phase)
+                                           : event.name);
+    os << ",\"cat\":\"" << getPhaseName(event.phase) << "\",\"ph\":\"X\""
+       << ",\"ts\":" << event.startNs / 1e3
+       << ",\"dur\":" << event.durationNs / 1e3 << ",\"pid\":" << pid
+       << ",\"tid\":" << event.threadId << ",\"args\":{";
+    bool first = true;
+    for (const auto &[counter, value] : event.counters) {
+      if (!first)
+        os << ',';
+      first = false;
+      writeJsonString(os, counter);
+      os << ':' << value;
+    }
+    os << "}}";
+  }
+  os << "]}";
+  return os.str();
+}
+
+void writeChromeTrace(const std::string &path) {
+  std::ofstream out(path);
+  out << toChromeTrace();
+  if (!out)
+    throw std::runtime_error("Unable to write the profile to " + path + ".");
+}
+
+void addCounter(std::string_view name, std::int64_t value) {
+  if (currentPhase)
+    currentPhase->addCounter(name, value);
+}
+
+void ScopedPhase::begin(Phase phase, std::string_view name) {
+  active = true;
+  event.phase = phase;
+  event.name = name;
+  event.threadId = threadId;
+  event.depth = currentDepth++;
+  parent = currentPhase;
+  currentPhase = this;
+  start = std::chrono::steady_clock::now();
+}
+
+void ScopedPhase::end() {
+  const auto stop = std::chrono::steady_clock::now();
+  event.startNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch)
+          .count();
+  event.durationNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+          .count();
+  currentPhase = parent;
+  --currentDepth;
+  std::scoped_lock<std::mutex> lock(eventsMutex);
+  events.push_back(std::move(event));
+}
+
+} // namespace cudaq::profiler
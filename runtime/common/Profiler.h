@@ -0,0 +1,134 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// The profiler records the phases of kernel launches, with their wall time
+/// and counters (e.g., bytes allocated, gates applied), so that per-launch
+/// breakdowns can be inspected programmatically or exported as a Chrome trace
+/// (also readable by Perfetto). Unlike the `CUDAQ_TIMING_TAGS` traces, which
+/// are printed, events are kept in memory until retrieved or cleared.
+///
+/// The profiler is disabled by default, and then only costs an atomic load per
+/// phase. Setting `CUDAQ_PROFILE_FILE` enables it at startup and writes the
+/// Chrome trace to that file at exit. Each pass of the JIT pipelines is only
+/// recorded on request (`setRecordPasses` or `CUDAQ_PROFILE_PASSES=1`), since
+/// counting the operations of the IR around each pass adds to compile time.
+namespace cudaq::profiler {
+
+/// @brief The phases of a kernel launch, from the outermost to the innermost.
+enum class Phase : std::uint8_t {
+  launch,
+  jit_passes,
+  /// A pass of a JIT pipeline, with the number of operations of the IR it
+  /// runs on before (`ops_before`) and after (`ops_after`) it.
+  jit_pass,
+  argument_synthesis,
+  simulator_flush,
+  sample_conversion,
+  result_assembly
+};
+
+/// @brief Return the name of `phase`, used as the category of trace events.
+const char *getPhaseName(Phase phase);
+
+/// @brief A completed phase.
+struct Event {
+  Phase phase;
+  /// The name given to the phase by the instrumented code, e.g., the kernel.
+  std::string name;
+  /// Start time, in nanoseconds since the profiler epoch.
+  std::int64_t startNs = 0;
+  std::int64_t durationNs = 0;
+  /// A small integer identifying the recording thread.
+  std::uint32_t threadId = 0;
+  /// Nesting depth of the phase on its thread, 0 for the outermost phase.
+  std::uint32_t depth = 0;
+  std::map<std::string, std::int64_t> counters;
+};
+
+namespace details {
+extern std::atomic<bool> enabled;
+extern std::atomic<bool> recordPasses;
+} // namespace details
+
+/// @brief Return true if phases are being recorded.
+inline bool isEnabled() {
+  return details::enabled.load(std::memory_order_relaxed);
+}
+
+/// @brief Start or stop recording phases. Phases already started when
+/// recording stops are still recorded.
+void setEnabled(bool enable);
+
+/// @brief Return true if the passes of the JIT pipelines are recorded, as
+/// `jit_pass` phases, while phases are being recorded.
+inline bool isRecordingPasses() {
+  return details::recordPasses.load(std::memory_order_relaxed);
+}
+
+/// @brief Start or stop recording the passes of the JIT pipelines set up from
+/// now on.
+void setRecordPasses(bool record);
+
+/// @brief Return the events recorded so far, in completion order.
+std::vector<Event> getEvents();
+
+/// @brief Discard the events recorded so far.
+void clear();
+
+/// @brief Return the recorded events in the Chrome trace event format.
+std::string toChromeTrace();
+
+/// @brief Write the recorded events in the Chrome trace event format to
+/// `path`.
+void writeChromeTrace(const std::string &path);
+
+/// @brief Add `value` to the counter `name` of the innermost phase in
+/// progress on the calling thread. Does nothing if there is no such phase.
+void addCounter(std::string_view name, std::int64_t value);
+
+/// @brief Record a phase for the lifetime of this object.
+class ScopedPhase {
+public:
+  explicit ScopedPhase(Phase phase, std::string_view name = {}) {
+    if (isEnabled())
+      begin(phase, name);
+  }
+  ScopedPhase(const ScopedPhase &) = delete;
+  ScopedPhase &operator=(const ScopedPhase &) = delete;
+  ~ScopedPhase() {
+    if (active)
+      end();
+  }
+
+  /// @brief Add `value` to the counter `name` of this phase.
+  void addCounter(std::string_view name, std::int64_t value) {
+    if (active)
+      event.counters[std::string(name)] += value;
+  }
+
+private:
+  void begin(Phase phase, std::string_view name);
+  void end();
+
+  bool active = false;
+  Event event;
+  std::chrono::steady_clock::time_point start;
+  ScopedPhase *parent = nullptr;
+};
+
+} // namespace cudaq::profiler
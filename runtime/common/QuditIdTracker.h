@@ -63,6 +63,24 @@ public:
 
   /// @brief Return the number of qudits allocated.
   std::size_t numAllocated() { return currentId - recycledQudits.size(); }
+
+  /// @brief Return one past the highest index handed out, i.e. the number of
+  /// indices that are either allocated or recycled.
+  std::size_t numIndices() const { return currentId; }
+
+  /// @brief Forget the recycled indices above the highest allocated index,
+  /// so that they are handed out again as new indices. This does not change
+  /// the order in which indices are handed out.
+  void trimRecycledIndices() {
+    // The recycled indices are sorted in descending order.
+    std::size_t numTrailing = 0;
+    while (numTrailing < recycledQudits.size() &&
+           recycledQudits[numTrailing] == currentId - 1 - numTrailing)
+      ++numTrailing;
+    recycledQudits.erase(recycledQudits.begin(),
+                         recycledQudits.begin() + numTrailing);
+    currentId -= numTrailing;
+  }
 };
 
 } // namespace cudaq
@@ -21,11 +21,10 @@ void cudaq::RecordLogParser::parse(const std::string &outputLog) {
 
   // Collect log from a single shot and process it only if it is successful.
   bool processingShot = false;
-  // Maintain the starting index of each shot's data
-  std::size_t shotStart = 0;
+  // The records of the current shot, split into their entries once.
+  std::vector<std::vector<std::string>> shotRecords;
 
-  for (std::size_t idx = 0; idx < lines.size(); ++idx) {
-    const auto &line = lines[idx];
+  for (const auto &line : lines) {
     std::vector<std::string> entries = cudaq::split(line, '\t');
     if (entries.empty())
       continue;
@@ -37,10 +36,10 @@ void cudaq::RecordLogParser::parse(const std::string &outputLog) {
       handleMetadata(entries);
     else if (recordType == "START") {
       processingShot = true;
-      shotStart = 0;
+      shotRecords.clear();
     } else if (recordType == "OUTPUT") {
       if (processingShot)
-        shotStart = shotStart == 0 ? idx : shotStart;
+        shotRecords.push_back(std::move(entries));
       else
         handleOutput(entries);
     } else if (recordType == "END") {
@@ -49,14 +48,14 @@ void cudaq::RecordLogParser::parse(const std::string &outputLog) {
       if (entries[1] == "0") {
         if (processingShot) {
           // Successful shot, process it
-          for (std::size_t j = shotStart; j < idx; ++j)
-            handleOutput(cudaq::split(lines[j], '\t'));
+          for (const auto &record : shotRecords)
+            handleOutput(record);
         }
       } else {
         CUDAQ_DBG("Discarding shot data due to non-zero END status.");
       }
       processingShot = false;
-      shotStart = 0;
+      shotRecords.clear();
       containerMeta.reset();
     } else {
       throw std::runtime_error("Invalid record type: " + recordType);
@@ -95,6 +94,15 @@ void cudaq::RecordLogParser::handleMetadata(
   }
 }
 
+void cudaq::RecordLogParser::parse(
+    const std::vector<OutputRecord> &outputRecords) {
+  ScopedTraceWithContext(cudaq::TIMING_RUN, "RecordLogParser::parse");
+  // The records of a local simulator are all successful, and their values are
+  // already typed: they are stored without going through text.
+  for (const auto &record : outputRecords)
+    handleOutput(record.type, record, record.label);
+}
+
 void cudaq::RecordLogParser::handleOutput(
     const std::vector<std::string> &entries) {
   if (entries.size() < 3)
@@ -105,7 +113,47 @@ void cudaq::RecordLogParser::handleOutput(
   const std::string &recValue = entries[2];
   std::string recLabel = (entries.size() == 4) ? entries[3] : "";
   cudaq::trim(recLabel);
-  if (recType == "RESULT") {
+  OutputRecordType type;
+  if (recType == "RESULT")
+    type = OutputRecordType::RESULT;
+  else if (recType == "ARRAY")
+    type = OutputRecordType::ARRAY;
+  else if (recType == "TUPLE")
+    type = OutputRecordType::TUPLE;
+  else if (recType == "BOOL")
+    type = OutputRecordType::BOOL;
+  else if (recType == "INT")
+    type = OutputRecordType::INT;
+  else if (recType == "DOUBLE")
+    type = OutputRecordType::DOUBLE;
+  else
+    throw std::runtime_error("Invalid data");
+  handleOutput(type, recValue, recLabel);
+}
+
+namespace {
+std::size_t getElementCount(const std::string &recValue) {
+  return std::stoul(recValue);
+}
+
+std::size_t getElementCount(const cudaq::OutputRecord &record) {
+  return record.intValue;
+}
+
+std::int64_t getIntValue(const std::string &recValue) {
+  return std::stoll(recValue);
+}
+
+std::int64_t getIntValue(const cudaq::OutputRecord &record) {
+  return record.intValue;
+}
+} // namespace
+
+template <typename Value>
+void cudaq::RecordLogParser::handleOutput(OutputRecordType recType,
+                                          const Value &recValue,
+                                          const std::string &recLabel) {
+  if (recType == OutputRecordType::RESULT) {
     // Sample-type QIR output, where we have an array of `RESULT` per shot. For
     // example,
     //  START
@@ -176,9 +224,9 @@ void cudaq::RecordLogParser::handleOutput(
     containerMeta.processedElements++;
     return;
   }
-  if (recType == "ARRAY") {
+  if (recType == OutputRecordType::ARRAY) {
     containerMeta.m_type = ContainerType::ARRAY;
-    containerMeta.elementCount = std::stoul(recValue);
+    containerMeta.elementCount = getElementCount(recValue);
     if (!recLabel.empty()) {
       schema = RecordSchemaType::LABELED;
       containerMeta.extractArrayInfo(recLabel);
@@ -186,9 +234,9 @@ void cudaq::RecordLogParser::handleOutput(
     }
     return;
   }
-  if (recType == "TUPLE") {
+  if (recType == OutputRecordType::TUPLE) {
     containerMeta.m_type = ContainerType::TUPLE;
-    containerMeta.elementCount = std::stoul(recValue);
+    containerMeta.elementCount = getElementCount(recValue);
     if (!recLabel.empty()) {
       schema = RecordSchemaType::LABELED;
       containerMeta.extractTupleInfo(recLabel);
@@ -196,23 +244,23 @@ void cudaq::RecordLogParser::handleOutput(
     }
     return;
   }
-  if (recType == "BOOL")
+  if (recType == OutputRecordType::BOOL)
     currentOutput = OutputType::BOOL;
-  else if (recType == "INT")
+  else if (recType == OutputRecordType::INT)
     currentOutput = OutputType::INT;
-  else if (recType == "DOUBLE")
-    currentOutput = OutputType::DOUBLE;
-  else if (recType == "RESULT")
-    currentOutput = OutputType::RESULT;
   else
-    throw std::runtime_error("Invalid data");
+    currentOutput = OutputType::DOUBLE;
   if ((containerMeta.elementCount > 0) &&
       (schema == RecordSchemaType::LABELED)) {
-    if (containerMeta.m_type == ContainerType::ARRAY)
-      processArrayEntry(recValue, recLabel);
-    else if (containerMeta.m_type == ContainerType::TUPLE)
+    std::size_t numElements = 1;
+    if (containerMeta.m_type == ContainerType::ARRAY) {
+      if (currentOutput == OutputType::INT && containerMeta.arrayType == "i1")
+        numElements = processPackedArrayEntry(recValue, recLabel);
+      else
+        processArrayEntry(recValue, recLabel);
+    } else if (containerMeta.m_type == ContainerType::TUPLE)
       processTupleEntry(recValue, recLabel);
-    containerMeta.processedElements++;
+    containerMeta.processedElements += numElements;
     if (containerMeta.processedElements == containerMeta.elementCount) {
       containerMeta.reset();
     }
@@ -273,7 +321,8 @@ void cudaq::RecordLogParser::preallocateTuple() {
   containerMeta.tupleOffsets = dataLayoutInfo.second;
 }
 
-void cudaq::RecordLogParser::processSingleRecord(const std::string &recValue,
+template <typename Value>
+void cudaq::RecordLogParser::processSingleRecord(const Value &recValue,
                                                  const std::string &recLabel) {
   auto label = recLabel;
   // For result type, we don't use the record label (register name) as the type
@@ -292,7 +341,8 @@ void cudaq::RecordLogParser::processSingleRecord(const std::string &recValue,
   dh.addRecord(bufferHandler, recValue);
 }
 
-void cudaq::RecordLogParser::processArrayEntry(const std::string &recValue,
+template <typename Value>
+void cudaq::RecordLogParser::processArrayEntry(const Value &recValue,
                                                const std::string &recLabel) {
   std::size_t index = containerMeta.extractIndex(recLabel);
   if (index >= containerMeta.elementCount)
@@ -301,7 +351,24 @@ void cudaq::RecordLogParser::processArrayEntry(const std::string &recValue,
   dh.insertIntoArray(bufferHandler, containerMeta.dataOffset, index, recValue);
 }
 
-void cudaq::RecordLogParser::processTupleEntry(const std::string &recValue,
+template <typename Value>
+std::size_t
+cudaq::RecordLogParser::processPackedArrayEntry(const Value &recValue,
+                                                const std::string &recLabel) {
+  auto [begin, end] = containerMeta.extractRange(recLabel);
+  if (end > containerMeta.elementCount)
+    throw std::runtime_error("Array index out of bounds");
+  if (end - begin > 64)
+    throw std::runtime_error("Packed array record holds more than 64 bits");
+  const auto bits = static_cast<std::uint64_t>(getIntValue(recValue));
+  for (std::size_t i = begin; i < end; ++i)
+    bufferHandler.insertIntoArray<bool>(containerMeta.dataOffset, i,
+                                        (bits >> (i - begin)) & 1);
+  return end - begin;
+}
+
+template <typename Value>
+void cudaq::RecordLogParser::processTupleEntry(const Value &recValue,
                                                const std::string &recLabel) {
   std::size_t index = containerMeta.extractIndex(recLabel);
   if (index >= containerMeta.elementCount)
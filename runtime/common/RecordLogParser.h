@@ -8,13 +8,17 @@
 
 #pragma once
 
+#include "common/OutputRecord.h"
 #include "cudaq/utils/cudaq_utils.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
 #include <cstring>
 #include <functional>
 #include <optional>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace cudaq {
 
@@ -77,48 +81,66 @@ public:
 
 /// A helper class to manage the underlying memory buffer used by
 /// 'RecordLogParser'. For container types, i.e. composite records, the buffer
-/// acts as outer vector with pointers to inner buffers.
+/// acts as outer vector with pointers to inner buffers. The buffer is
+/// allocated with `malloc`, so that its ownership can be released to the
+/// caller, e.g., as the `data` of a `RunResultSpan`.
 class BufferHandler {
 public:
   BufferHandler() = default;
-  ~BufferHandler() = default;
+  ~BufferHandler() { std::free(buffer); }
   /// Copying and assignment not permitted
   BufferHandler(BufferHandler &other) = delete;
   BufferHandler &operator=(BufferHandler &other) = delete;
   BufferHandler(const BufferHandler &) = delete;
   BufferHandler &operator=(const BufferHandler &) = delete;
-  BufferHandler(BufferHandler &&) = default;
-  BufferHandler &operator=(BufferHandler &&) = default;
-
-  void *getBufferPtr() const {
-    return reinterpret_cast<void *>(const_cast<char *>(buffer.data()));
+  BufferHandler(BufferHandler &&other)
+      : buffer(std::exchange(other.buffer, nullptr)),
+        size(std::exchange(other.size, 0)),
+        capacity(std::exchange(other.capacity, 0)) {}
+  BufferHandler &operator=(BufferHandler &&other) {
+    if (this != &other) {
+      std::free(buffer);
+      buffer = std::exchange(other.buffer, nullptr);
+      size = std::exchange(other.size, 0);
+      capacity = std::exchange(other.capacity, 0);
+    }
+    return *this;
   }
 
-  std::size_t getBufferSize() const { return buffer.size(); }
+  void *getBufferPtr() const { return buffer; }
+
+  std::size_t getBufferSize() const { return size; }
 
-  void resizeBuffer(std::size_t more) { buffer.resize(buffer.size() + more); }
+  void resizeBuffer(std::size_t more) { resize(size + more); }
+
+  /// Release the ownership of the buffer, which must be deallocated with
+  /// `free`, and leave this handler empty.
+  char *releaseBuffer() {
+    size = capacity = 0;
+    return std::exchange(buffer, nullptr);
+  }
 
   template <typename T>
   void addPrimitiveRecord(T value) {
-    std::size_t position = buffer.size();
-    buffer.resize(position + sizeof(T));
-    std::memcpy(buffer.data() + position, &value, sizeof(T));
+    std::size_t position = size;
+    resize(position + sizeof(T));
+    std::memcpy(buffer + position, &value, sizeof(T));
   }
 
   template <typename T>
   size_t allocateArrayRecord(size_t arrSize) {
-    size_t vectorOffset = buffer.size();
+    size_t vectorOffset = size;
     if constexpr (std::is_same_v<T, bool>) {
       auto *allocation = new std::vector<bool>(arrSize);
       if (!allocation)
         throw std::runtime_error("Memory allocation failed");
       auto byteLength = sizeof(*allocation);
-      buffer.resize(vectorOffset + byteLength);
-      std::memcpy(buffer.data() + vectorOffset, allocation, byteLength);
+      resize(vectorOffset + byteLength);
+      std::memcpy(buffer + vectorOffset, allocation, byteLength);
       return vectorOffset;
     }
 
-    buffer.resize(vectorOffset + 3 * sizeof(T *));
+    resize(vectorOffset + 3 * sizeof(T *));
     size_t byteLength = arrSize * sizeof(T);
     T *innerBuffer = static_cast<T *>(malloc(byteLength));
     if (!innerBuffer)
@@ -129,7 +151,7 @@ public:
     T *end0Ptr = innerBuffer + arrSize;
     T *end1Ptr = end0Ptr;
     /// Store the pointers into the outer vector (buffer)
-    T **ptrLoc = reinterpret_cast<T **>(buffer.data() + vectorOffset);
+    T **ptrLoc = reinterpret_cast<T **>(buffer + vectorOffset);
     ptrLoc[0] = startPtr;
     ptrLoc[1] = end0Ptr;
     ptrLoc[2] = end1Ptr;
@@ -139,10 +161,10 @@ public:
   template <typename T>
   void insertIntoArray(size_t offset, std::size_t index, T value) {
     if constexpr (std::is_same_v<T, bool>) {
-      auto v = reinterpret_cast<std::vector<bool> *>(buffer.data() + offset);
+      auto v = reinterpret_cast<std::vector<bool> *>(buffer + offset);
       (*v)[index] = value;
     } else {
-      T **ptrLoc = reinterpret_cast<T **>(buffer.data() + offset);
+      T **ptrLoc = reinterpret_cast<T **>(buffer + offset);
       ptrLoc[0][index] = value;
     }
   }
@@ -150,18 +172,36 @@ public:
   /// NOTE: This is used only if data layout (alignment) is missing
   template <typename T>
   size_t allocateTupleRecord() {
-    size_t position = buffer.size();
-    buffer.resize(position + sizeof(T));
+    size_t position = size;
+    resize(position + sizeof(T));
     return position;
   }
 
   template <typename T>
   void insertIntoTuple(size_t offset, T value) {
-    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    std::memcpy(buffer + offset, &value, sizeof(T));
   }
 
 private:
-  std::vector<char> buffer;
+  /// Resize the buffer to `newSize` bytes. The added bytes are zeroed, and
+  /// the capacity grows geometrically as records are appended.
+  void resize(std::size_t newSize) {
+    if (newSize > capacity) {
+      const std::size_t newCapacity = std::max(newSize, 2 * capacity);
+      char *newBuffer = static_cast<char *>(std::realloc(buffer, newCapacity));
+      if (!newBuffer)
+        throw std::runtime_error("Memory allocation failed");
+      buffer = newBuffer;
+      capacity = newCapacity;
+    }
+    if (newSize > size)
+      std::memset(buffer + size, 0, newSize - size);
+    size = newSize;
+  }
+
+  char *buffer = nullptr;
+  std::size_t size = 0;
+  std::size_t capacity = 0;
 };
 
 //===----------------------------------------------------------------------===//
@@ -225,6 +265,21 @@ public:
     throw std::runtime_error("Index not found in label");
   }
 
+  /// Parse string like "[0:64]" for the range of elements of a packed array
+  /// record, returns the first element and the end of the range.
+  std::pair<std::size_t, std::size_t> extractRange(const std::string &label) {
+    auto colon = label.find(':');
+    if ((label.size() < 5) || (label[0] != '[') ||
+        (label[label.size() - 1] != ']') || (colon == std::string::npos))
+      throw std::runtime_error("Range not found in label");
+    std::size_t begin = std::stoul(label.substr(1, colon - 1));
+    std::size_t end =
+        std::stoul(label.substr(colon + 1, label.size() - colon - 2));
+    if (end < begin)
+      throw std::runtime_error("Invalid range in label");
+    return {begin, end};
+  }
+
   ContainerType m_type = ContainerType::ARRAY;
   std::size_t elementCount = 0;
   std::size_t processedElements = 0;
@@ -249,6 +304,13 @@ public:
   virtual size_t allocateTuple(BufferHandler &bh) = 0;
   virtual void insertIntoTuple(BufferHandler &bh, std::size_t offset,
                                const std::string &value) = 0;
+  /// Overloads for the typed values of binary output records
+  virtual void addRecord(BufferHandler &bh, const OutputRecord &record) = 0;
+  virtual void insertIntoArray(BufferHandler &bh, std::size_t offset,
+                               std::size_t index,
+                               const OutputRecord &record) = 0;
+  virtual void insertIntoTuple(BufferHandler &bh, std::size_t offset,
+                               const OutputRecord &record) = 0;
 };
 
 template <typename T>
@@ -256,6 +318,12 @@ class DataHandler : public DataHandlerBase {
 private:
   std::unique_ptr<details::TypeConverterBase<T>> converter;
 
+  static T convert(const OutputRecord &record) {
+    if (record.type == OutputRecordType::DOUBLE)
+      return static_cast<T>(record.doubleValue);
+    return static_cast<T>(record.intValue);
+  }
+
 public:
   DataHandler(std::unique_ptr<details::TypeConverterBase<T>> conv)
       : converter(std::move(conv)) {}
@@ -276,6 +344,17 @@ public:
                        const std::string &value) override {
     bh.insertIntoTuple<T>(offset, converter->convert(value));
   }
+  void addRecord(BufferHandler &bh, const OutputRecord &record) override {
+    bh.addPrimitiveRecord<T>(convert(record));
+  }
+  void insertIntoArray(BufferHandler &bh, std::size_t offset, std::size_t index,
+                       const OutputRecord &record) override {
+    bh.insertIntoArray<T>(offset, index, convert(record));
+  }
+  void insertIntoTuple(BufferHandler &bh, std::size_t offset,
+                       const OutputRecord &record) override {
+    bh.insertIntoTuple<T>(offset, convert(record));
+  }
 };
 
 } // namespace details
@@ -306,6 +385,10 @@ public:
   /// length may be queried and returned as a result.
   void parse(const std::string &outputLog);
 
+  /// Store the binary output records of a local simulator in the data buffer.
+  /// Their values are already typed, so that they are not parsed.
+  void parse(const std::vector<OutputRecord> &outputRecords);
+
   /// Get a pointer to the data buffer. Note that the data buffer will be
   /// deallocated as soon as the RecordLogParser object is deconstructed.
   void *getBufferPtr() const { return bufferHandler.getBufferPtr(); }
@@ -313,6 +396,10 @@ public:
   /// Get the size of the data buffer (in bytes).
   std::size_t getBufferSize() const { return bufferHandler.getBufferSize(); }
 
+  /// Release the ownership of the data buffer to the caller, which is then
+  /// responsible to deallocate it with `free`.
+  char *releaseBuffer() { return bufferHandler.releaseBuffer(); }
+
 private:
   /// Process different types of records
   void handleHeader(const std::vector<std::string> &);
@@ -320,16 +407,27 @@ private:
   /// Central dispatcher that handles different output types including scalar
   /// values, arrays, and tuples.
   void handleOutput(const std::vector<std::string> &);
+  /// Handle an output record whose value is either text or a binary record
+  template <typename Value>
+  void handleOutput(OutputRecordType, const Value &, const std::string &);
   /// Allocate inner buffer for array records - one per shot
   void preallocateArray();
   /// Allocate contiguous memory for tuple records - one per shot
   void preallocateTuple();
   /// Process scalar values and non-labeled array/tuple entries
-  void processSingleRecord(const std::string &, const std::string &);
+  template <typename Value>
+  void processSingleRecord(const Value &, const std::string &);
   /// Extract index from label (out-of-order allowed), convert value to
   /// appropriate type and store in the pre-allocated buffer
-  void processArrayEntry(const std::string &, const std::string &);
-  void processTupleEntry(const std::string &, const std::string &);
+  template <typename Value>
+  void processArrayEntry(const Value &, const std::string &);
+  /// Unpack the range of elements of a boolean array held by a packed `INT`
+  /// record, e.g., `OUTPUT INT 5 [0:3]`, where the element at the beginning of
+  /// the range is the least significant bit. Returns the number of elements.
+  template <typename Value>
+  std::size_t processPackedArrayEntry(const Value &, const std::string &);
+  template <typename Value>
+  void processTupleEntry(const Value &, const std::string &);
   /// Get data handler for the specified type
   details::DataHandlerBase &getDataHandler(const std::string &dataType);
 
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "RemoteEndpointPool.h"
+#include <unordered_map>
+
+namespace cudaq {
+
+RemoteEndpointPool::RemoteEndpointPool(std::vector<std::string> urls,
+                                       HealthCheck healthCheck,
+                                       std::chrono::milliseconds retryInterval)
+    : healthCheck(std::move(healthCheck)), retryInterval(retryInterval) {
+  for (auto &url : urls)
+    endpoints.push_back(Endpoint{std::move(url)});
+}
+
+std::shared_ptr<RemoteEndpointPool>
+RemoteEndpointPool::getShared(const std::vector<std::string> &urls,
+                              HealthCheck healthCheck,
+                              std::chrono::milliseconds retryInterval) {
+  static std::mutex poolsMutex;
+  static std::unordered_map<std::string, std::weak_ptr<RemoteEndpointPool>>
+      pools;
+  std::string key;
+  for (const auto &url : urls)
+    key += url + '\n';
+  std::scoped_lock lock(poolsMutex);
+  auto &pool = pools[key];
+  if (auto shared = pool.lock())
+    return shared;
+  auto shared = std::make_shared<RemoteEndpointPool>(
+      urls, std::move(healthCheck), retryInterval);
+  pool = shared;
+  return shared;
+}
+
+bool RemoteEndpointPool::isAvailable(std::size_t endpoint) const {
+  std::scoped_lock lock(mutex);
+  const auto &state = endpoints[endpoint];
+  return state.healthy || std::chrono::steady_clock::now() >= state.nextCheck;
+}
+
+std::size_t RemoteEndpointPool::getNumInFlight(std::size_t endpoint) const {
+  std::scoped_lock lock(mutex);
+  return endpoints[endpoint].numInFlight;
+}
+
+std::optional<std::size_t>
+RemoteEndpointPool::acquire(std::size_t preferred,
+                            const std::vector<std::size_t> &excluded) {
+  std::unique_lock lock(mutex);
+  std::vector<bool> skipped(endpoints.size(), false);
+  for (auto endpoint : excluded)
+    if (endpoint < endpoints.size())
+      skipped[endpoint] = true;
+
+  while (true) {
+    const auto now = std::chrono::steady_clock::now();
+    const auto isCandidate = [&](std::size_t i) {
+      return !skipped[i] &&
+             (endpoints[i].healthy || now >= endpoints[i].nextCheck);
+    };
+    std::optional<std::size_t> selected;
+    if (preferred < endpoints.size() && isCandidate(preferred)) {
+      selected = preferred;
+    } else {
+      for (std::size_t i = 0; i < endpoints.size(); ++i)
+        if (isCandidate(i) &&
+            (!selected ||
+             endpoints[i].numInFlight < endpoints[*selected].numInFlight))
+          selected = i;
+    }
+    if (!selected)
+      return std::nullopt;
+    if (!endpoints[*selected].healthy && !checkHealth(lock, *selected)) {
+      skipped[*selected] = true;
+      continue;
+    }
+    ++endpoints[*selected].numInFlight;
+    return selected;
+  }
+}
+
+bool RemoteEndpointPool::release(std::size_t endpoint, bool failed) {
+  std::unique_lock lock(mutex);
+  auto &state = endpoints[endpoint];
+  if (state.numInFlight > 0)
+    --state.numInFlight;
+  if (!failed)
+    return true;
+  return checkHealth(lock, endpoint);
+}
+
+bool RemoteEndpointPool::checkHealth(std::unique_lock<std::mutex> &lock,
+                                     std::size_t endpoint) {
+  // Other requests do not check the endpoint while this check runs.
+  endpoints[endpoint].nextCheck =
+      std::chrono::steady_clock::now() + retryInterval;
+  const auto url = endpoints[endpoint].url;
+  lock.unlock();
+  bool healthy = false;
+  try {
+    healthy = healthCheck(url);
+  } catch (...) {
+  }
+  lock.lock();
+  auto &state = endpoints[endpoint];
+  state.healthy = healthy;
+  if (!healthy)
+    state.nextCheck = std::chrono::steady_clock::now() + retryInterval;
+  return healthy;
+}
+
+} // namespace cudaq
@@ -0,0 +1,87 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief The server endpoints of a remote platform, shared by its QPUs, with
+/// their health and their number of requests in flight.
+///
+/// Each QPU sends its requests to its own endpoint while it is healthy, and
+/// fails over to the healthy endpoint with the fewest requests in flight
+/// otherwise. An endpoint is marked unhealthy when a request to it fails and
+/// its health check fails as well, i.e., when the failure is not the request's
+/// own, e.g., when its server is down or unreachable. Unhealthy endpoints are
+/// checked again once `retryInterval` has elapsed.
+class RemoteEndpointPool {
+public:
+  /// @brief Return true if the server at the given URL responds.
+  using HealthCheck = std::function<bool(const std::string &url)>;
+
+  RemoteEndpointPool(std::vector<std::string> urls, HealthCheck healthCheck,
+                     std::chrono::milliseconds retryInterval);
+
+  /// @brief Return the pool of the given endpoints shared by all the QPUs
+  /// configured with them, creating it if needed.
+  static std::shared_ptr<RemoteEndpointPool>
+  getShared(const std::vector<std::string> &urls, HealthCheck healthCheck,
+            std::chrono::milliseconds retryInterval);
+
+  std::size_t size() const { return endpoints.size(); }
+  const std::string &getUrl(std::size_t endpoint) const {
+    return endpoints[endpoint].url;
+  }
+
+  /// @brief Return false if the endpoint is unhealthy and not yet due for a
+  /// new health check.
+  bool isAvailable(std::size_t endpoint) const;
+
+  /// @brief Return the number of requests in flight to the endpoint.
+  std::size_t getNumInFlight(std::size_t endpoint) const;
+
+  /// @brief Select the endpoint of a request: `preferred` if it is healthy,
+  /// otherwise the healthy endpoint with the fewest requests in flight, except
+  /// the endpoints in `excluded`. The unhealthy endpoints due for a health
+  /// check are checked on the way. Return `std::nullopt` if there is no
+  /// healthy endpoint. The request must be released once it completes.
+  std::optional<std::size_t>
+  acquire(std::size_t preferred, const std::vector<std::size_t> &excluded = {});
+
+  /// @brief Release a request to the endpoint. If the request failed, check
+  /// the health of the endpoint. Return false if the endpoint is unhealthy,
+  /// i.e., if the request may be sent to another endpoint.
+  bool release(std::size_t endpoint, bool failed = false);
+
+private:
+  struct Endpoint {
+    std::string url;
+    bool healthy = true;
+    std::size_t numInFlight = 0;
+    /// The time of the next health check, if unhealthy.
+    std::chrono::steady_clock::time_point nextCheck;
+  };
+
+  /// @brief Run the health check of the endpoint, without holding the lock,
+  /// and update its health.
+  bool checkHealth(std::unique_lock<std::mutex> &lock, std::size_t endpoint);
+
+  std::vector<Endpoint> endpoints;
+  HealthCheck healthCheck;
+  std::chrono::milliseconds retryInterval;
+  mutable std::mutex mutex;
+};
+
+} // namespace cudaq
@@ -12,43 +12,49 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 
 namespace cudaq {
-std::size_t
-Resources::InstructionHash::operator()(const Instruction &instruction) const {
-  std::size_t seed = 0;
+bool Resources::Instruction::operator==(const Instruction &other) const {
+  return name == other.name && nControls == other.nControls;
+}
 
-  seed ^= std::hash<std::string>()(instruction.name) +
-          std::hash<std::size_t>()(instruction.nControls) + 0x9e3779b9 +
-          (seed << 6) + (seed >> 2);
-  return seed;
+std::optional<Resources::GateKindId>
+Resources::findGate(std::string_view name) const {
+  auto iter = gateIds.find(name);
+  if (iter == gateIds.end())
+    return std::nullopt;
+  return iter->second;
 }
 
-bool Resources::Instruction::operator==(const Instruction &other) const {
-  return name == other.name && nControls == other.nControls;
+Resources::GateKindId Resources::internGate(std::string_view name) {
+  if (auto id = findGate(name))
+    return *id;
+
+  GateKindId id = gateNames.size();
+  gateNames.emplace_back(name);
+  gateIds.emplace(gateNames.back(), id);
+  instructions.emplace_back();
+  return id;
 }
 
 std::size_t Resources::count(const Instruction &instruction) const {
-  auto iter = instructions.find(instruction);
-  if (iter == instructions.end())
-    return 0;
-
-  return iter->second;
+  return count_controls(instruction.name, instruction.nControls);
 }
 
 std::size_t Resources::count_controls(const std::string &name,
                                       std::size_t nControls) const {
-  auto iter = instructions.find({name, nControls});
-  if (iter == instructions.end())
+  auto id = findGate(name);
+  if (!id || nControls >= instructions[*id].size())
     return 0;
 
-  return iter->second;
+  return instructions[*id][nControls];
 }
 
 std::size_t Resources::count(const std::string &name) const {
   std::size_t result = 0;
-  for (auto &[instruction, count] : instructions)
-    if (instruction.name == name)
+  if (auto id = findGate(name))
+    for (auto count : instructions[*id])
       result += count;
 
   return result;
@@ -58,52 +64,187 @@ std::size_t Resources::count() const { return totalGates; }
 
 void Resources::appendInstruction(const std::string &name,
                                   std::size_t nControls, std::size_t count) {
-  Instruction instruction(name, nControls);
-  auto iter = instructions.find(instruction);
-  if (iter != instructions.end()) {
-    iter->second += count;
-  } else {
-    instructions.insert({instruction, count});
-  }
+  appendInstruction(internGate(name), nControls, count);
+}
 
+void Resources::appendInstruction(GateKindId gate, std::size_t nControls,
+                                  std::size_t count) {
+  auto &counts = instructions[gate];
+  if (nControls >= counts.size())
+    counts.resize(nControls + 1, 0);
+  counts[nControls] += count;
   totalGates += count;
 }
 
+void Resources::merge(const Resources &other) {
+  for (GateKindId otherId = 0; otherId < other.gateNames.size(); ++otherId) {
+    const auto &counts = other.instructions[otherId];
+    auto id = internGate(other.gateNames[otherId]);
+    for (std::size_t nControls = 0; nControls < counts.size(); ++nControls)
+      if (counts[nControls])
+        appendInstruction(id, nControls, counts[nControls]);
+  }
+  numQubits += other.numQubits;
+}
+
 void Resources::dump(std::ostream &os) const {
   os << "Total # of gates: " << totalGates;
   os << ", total # of qubits: " << numQubits;
+  if (depth)
+    os << ", circuit depth: " << *depth;
   os << "\n";
   os << "{ ";
   os << "\n  ";
-  std::size_t counter = 0;
-  for (auto &result : instructions) {
-    std::string gatestr(result.first.nControls, 'c');
-    gatestr += result.first.name;
-    os << gatestr << " :  " << result.second;
-    bool isLast = counter == instructions.size() - 1;
-    counter++;
-    os << "\n" << (!isLast ? "  " : "");
-  }
-  os << "}\n";
+  bool first = true;
+  for (GateKindId id = 0; id < gateNames.size(); ++id)
+    for (std::size_t nControls = 0; nControls < instructions[id].size();
+         ++nControls) {
+      if (!instructions[id][nControls])
+        continue;
+      std::string gatestr(nControls, 'c');
+      gatestr += gateNames[id];
+      os << (first ? "" : "\n  ") << gatestr << " :  "
+         << instructions[id][nControls];
+      first = false;
+    }
+  os << (first ? "" : "\n") << "}\n";
 }
 
 void Resources::dump() const { dump(std::cout); }
 
 void Resources::clear() {
+  gateNames.clear();
+  gateIds.clear();
   instructions.clear();
   numQubits = 0;
   totalGates = 0;
+  depth.reset();
 }
 
-void Resources::addQubit() { numQubits++; }
+void Resources::addQubit(std::size_t count) { numQubits += count; }
 
 std::unordered_map<std::string, std::size_t> Resources::gateCounts() const {
   std::unordered_map<std::string, std::size_t> gateCounts;
-  for (auto &result : instructions) {
-    std::string gatestr(result.first.nControls, 'c');
-    gatestr += result.first.name;
-    gateCounts[gatestr] = result.second;
-  }
+  for (GateKindId id = 0; id < gateNames.size(); ++id)
+    for (std::size_t nControls = 0; nControls < instructions[id].size();
+         ++nControls) {
+      if (!instructions[id][nControls])
+        continue;
+      std::string gatestr(nControls, 'c');
+      gatestr += gateNames[id];
+      gateCounts[gatestr] = instructions[id][nControls];
+    }
   return gateCounts;
 }
+
+namespace {
+template <typename Count>
+std::size_t maxCount(const std::vector<Resources> &branches, Count &&count) {
+  std::size_t result = 0;
+  for (const auto &branch : branches)
+    result = std::max(result, count(branch));
+  return result;
+}
+
+template <typename Count>
+double meanCount(const std::vector<Resources> &branches,
+                 const std::vector<double> &probabilities, Count &&count) {
+  double result = 0.;
+  for (std::size_t i = 0; i < branches.size(); ++i)
+    result += probabilities[i] * count(branches[i]);
+  return result;
+}
+
+template <typename Count>
+std::map<std::size_t, double>
+distribution(const std::vector<Resources> &branches,
+             const std::vector<double> &probabilities, Count &&count) {
+  std::map<std::size_t, double> result;
+  for (std::size_t i = 0; i < branches.size(); ++i)
+    result[count(branches[i])] += probabilities[i];
+  return result;
+}
+} // namespace
+
+ResourceStatistics::ResourceStatistics(std::vector<Resources> &&branches,
+                                       std::vector<double> &&probabilities)
+    : branches(std::move(branches)), probabilities(std::move(probabilities)) {
+  if (this->branches.size() != this->probabilities.size())
+    throw std::runtime_error("ResourceStatistics requires one probability per "
+                             "branch.");
+}
+
+const Resources &ResourceStatistics::get_branch(std::size_t idx) const {
+  if (idx >= branches.size())
+    throw std::runtime_error("Invalid branch index " + std::to_string(idx) +
+                             ", the statistics have " +
+                             std::to_string(branches.size()) + " branches.");
+  return branches[idx];
+}
+
+double ResourceStatistics::get_probability(std::size_t idx) const {
+  get_branch(idx);
+  return probabilities[idx];
+}
+
+std::size_t ResourceStatistics::max_count() const {
+  return maxCount(branches, [](const Resources &r) { return r.count(); });
+}
+
+std::size_t ResourceStatistics::max_count(const std::string &name) const {
+  return maxCount(branches,
+                  [&](const Resources &r) { return r.count(name); });
+}
+
+std::size_t
+ResourceStatistics::max_count_controls(const std::string &name,
+                                       std::size_t nControls) const {
+  return maxCount(branches, [&](const Resources &r) {
+    return r.count_controls(name, nControls);
+  });
+}
+
+double ResourceStatistics::mean_count() const {
+  return meanCount(branches, probabilities,
+                   [](const Resources &r) { return r.count(); });
+}
+
+double ResourceStatistics::mean_count(const std::string &name) const {
+  return meanCount(branches, probabilities,
+                   [&](const Resources &r) { return r.count(name); });
+}
+
+double ResourceStatistics::mean_count_controls(const std::string &name,
+                                               std::size_t nControls) const {
+  return meanCount(branches, probabilities, [&](const Resources &r) {
+    return r.count_controls(name, nControls);
+  });
+}
+
+std::map<std::size_t, double> ResourceStatistics::count_distribution() const {
+  return distribution(branches, probabilities,
+                      [](const Resources &r) { return r.count(); });
+}
+
+std::map<std::size_t, double>
+ResourceStatistics::count_distribution(const std::string &name) const {
+  return distribution(branches, probabilities,
+                      [&](const Resources &r) { return r.count(name); });
+}
+
+void ResourceStatistics::dump(std::ostream &os) const {
+  os << "# of branches: " << branches.size();
+  os << ", max # of gates: " << max_count();
+  os << ", mean # of gates: " << mean_count() << "\n";
+  os << "{ ";
+  os << "\n  ";
+  bool first = true;
+  for (const auto &[count, probability] : count_distribution()) {
+    os << (first ? "" : "\n  ") << count << " :  " << probability;
+    first = false;
+  }
+  os << (first ? "" : "\n") << "}\n";
+}
+
+void ResourceStatistics::dump() const { dump(std::cout); }
 } // namespace cudaq
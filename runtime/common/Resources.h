@@ -9,7 +9,11 @@
 #pragma once
 
 #include "Trace.h"
+#include <cstdint>
+#include <map>
+#include <optional>
 #include <ostream>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -21,11 +25,18 @@ class Resources {
 public:
   struct Instruction;
 
+  /// @brief Identifier of an interned gate name. Counting through an interned
+  /// identifier avoids hashing the gate name for every counted gate.
+  using GateKindId = std::uint32_t;
+
 private:
-  /// @brief We want an unordered_map on Instructions, so define
-  /// the hash function here
-  struct InstructionHash {
-    std::size_t operator()(const Instruction &instruction) const;
+  /// @brief Transparent hash function for gate names, such that the interned
+  /// gates can be looked up with a `std::string_view`.
+  struct GateNameHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view name) const {
+      return std::hash<std::string_view>{}(name);
+    }
   };
 
 public:
@@ -72,6 +83,20 @@ public:
   void appendInstruction(const std::string &name, std::size_t nControls,
                          std::size_t count = 1);
 
+  /// @brief Append \p count instructions of the interned gate \p gate with
+  /// \p nControls controls to the resource estimate.
+  void appendInstruction(GateKindId gate, std::size_t nControls,
+                         std::size_t count = 1);
+
+  /// @brief Return the identifier of the gate with the given name, interning
+  /// the name if it is not known yet. Identifiers stay valid until `clear()`.
+  GateKindId internGate(std::string_view name);
+
+  /// @brief Add all the counts of \p other to this resource estimate, e.g., to
+  /// combine counts that were accumulated separately by several threads. The
+  /// circuit depth is left unchanged.
+  void merge(const Resources &other);
+
   /// @brief Dump resource count to the given output stream
   void dump(std::ostream &os) const;
   void dump() const;
@@ -79,16 +104,33 @@ public:
   /// @brief Clear the resource usage counts
   void clear();
 
-  /// @brief Register the usage of an additional qubit
-  void addQubit();
+  /// @brief Register the usage of \p count additional qubits
+  void addQubit(std::size_t count = 1);
+
+  /// @brief Set the circuit depth of the kernel
+  void setDepth(std::size_t d) { depth = d; }
+
+  /// @brief Return the circuit depth of the kernel, if it is known. It is only
+  /// computed when the resources are estimated at compilation time.
+  std::optional<std::size_t> getDepth() const { return depth; }
 
   /// @brief Returns a dictionary mapping gate names to counts
   std::unordered_map<std::string, std::size_t> gateCounts() const;
 
 private:
-  /// @brief Map of Instructions in the current kernel to the
-  /// number of times the Instruction is used.
-  std::unordered_map<Instruction, std::size_t, InstructionHash> instructions;
+  /// @brief Return the identifier of the given gate, if it was interned.
+  std::optional<GateKindId> findGate(std::string_view name) const;
+
+  /// @brief The interned gate names, indexed by `GateKindId`.
+  std::vector<std::string> gateNames;
+
+  /// @brief Map of interned gate names to their identifier.
+  std::unordered_map<std::string, GateKindId, GateNameHash, std::equal_to<>>
+      gateIds;
+
+  /// @brief The number of times each Instruction is used in the current
+  /// kernel, indexed by gate identifier and then by number of controls.
+  std::vector<std::vector<std::size_t>> instructions;
 
   /// @brief Keep track of the total number of gates. We keep this
   /// here so we don't have to keep recomputing it.
@@ -96,6 +138,75 @@ private:
 
   /// @brief Keep track of the total number of qubits used.
   std::size_t numQubits = 0;
+
+  /// @brief The circuit depth, if known.
+  std::optional<std::size_t> depth;
+};
+
+/// @brief The ResourceStatistics type aggregates the resources a kernel uses
+/// over several of its measurement-outcome branches. Each branch is estimated
+/// as a separate `Resources` and carries the probability of taking it, such
+/// that the mean counts are the expected counts of the kernel.
+class ResourceStatistics {
+public:
+  ResourceStatistics() = default;
+
+  /// @brief The constructor, takes the resources of each branch and the
+  /// probability of each branch.
+  ResourceStatistics(std::vector<Resources> &&branches,
+                     std::vector<double> &&probabilities);
+
+  /// @brief Return the number of branches.
+  std::size_t num_branches() const { return branches.size(); }
+
+  /// @brief Return the resources of the branch with the given index.
+  const Resources &get_branch(std::size_t idx) const;
+
+  /// @brief Return the probability of the branch with the given index.
+  double get_probability(std::size_t idx) const;
+
+  /// @brief Return the maximum total number of operations over all branches.
+  std::size_t max_count() const;
+
+  /// @brief Return the maximum number of instructions with the given name over
+  /// all branches.
+  std::size_t max_count(const std::string &name) const;
+
+  /// @brief Return the maximum number of instructions with the given name and
+  /// number of control qubits over all branches.
+  std::size_t max_count_controls(const std::string &name,
+                                 std::size_t nControls) const;
+
+  /// @brief Return the expected total number of operations.
+  double mean_count() const;
+
+  /// @brief Return the expected number of instructions with the given name.
+  double mean_count(const std::string &name) const;
+
+  /// @brief Return the expected number of instructions with the given name and
+  /// number of control qubits.
+  double mean_count_controls(const std::string &name,
+                             std::size_t nControls) const;
+
+  /// @brief Return the distribution of the total number of operations, i.e.,
+  /// the probability of each total number of operations.
+  std::map<std::size_t, double> count_distribution() const;
+
+  /// @brief Return the distribution of the number of instructions with the
+  /// given name.
+  std::map<std::size_t, double>
+  count_distribution(const std::string &name) const;
+
+  /// @brief Dump the statistics to the given output stream
+  void dump(std::ostream &os) const;
+  void dump() const;
+
+private:
+  /// @brief The resources of each branch.
+  std::vector<Resources> branches;
+
+  /// @brief The probability of each branch.
+  std::vector<double> probabilities;
 };
 
 } // namespace cudaq
@@ -10,35 +10,239 @@
 #include "FmtCore.h"
 #include "Logger.h"
 #include "cudaq/utils/cudaq_utils.h"
+#include <array>
 #include <cpr/cpr.h>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <zlib.h>
 
 namespace cudaq {
 constexpr long validHttpCode = 205;
 
-RestClient::RestClient() : sslOptions(std::make_unique<cpr::SslOptions>()) {
-  auto caInfo = [&]() -> std::string {
-    if (auto *curlCABundleStr = getenv("CURL_CA_BUNDLE")) {
-      if (std::filesystem::exists(curlCABundleStr))
-        return curlCABundleStr;
-      else
-        CUDAQ_INFO(
-            "{} does not exist. Will fall back on CUDA-Q installed certs",
-            curlCABundleStr);
+// Number of idle sessions kept per method and server.
+constexpr std::size_t maxIdleSessions = 8;
+
+namespace {
+/// Sessions kept alive between requests, shared by all the clients, so that
+/// their connections (and TLS sessions) are reused instead of paying a
+/// handshake per request. Sessions are keyed by the method and the origin of
+/// their requests, since a cpr session keeps the body of its last request.
+class SessionPool {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::vector<std::shared_ptr<cpr::Session>>>
+      idle;
+
+public:
+  std::shared_ptr<cpr::Session> acquire(const std::string &key) {
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+      auto &sessions = idle[key];
+      if (!sessions.empty()) {
+        auto session = std::move(sessions.back());
+        sessions.pop_back();
+        return session;
+      }
+    }
+    auto session = std::make_shared<cpr::Session>();
+    // Use HTTP/2 when the server negotiates it, HTTP/1.1 otherwise.
+    session->SetHttpVersion(
+        cpr::HttpVersion{cpr::HttpVersionCode::VERSION_2_0_TLS});
+    return session;
+  }
+
+  void release(const std::string &key, std::shared_ptr<cpr::Session> session) {
+    // Do not send the cookies of this response with the next request.
+    curl_easy_setopt(session->GetCurlHolder()->handle, CURLOPT_COOKIELIST,
+                     "ALL");
+    std::scoped_lock<std::mutex> lock(mutex);
+    auto &sessions = idle[key];
+    if (sessions.size() < maxIdleSessions)
+      sessions.push_back(std::move(session));
+  }
+};
+
+// Leaked, so that no request is made on a destroyed pool during exit.
+SessionPool &getSessionPool() {
+  static auto *pool = new SessionPool;
+  return *pool;
+}
+
+/// A session from the pool, returned to it on destruction.
+class PooledSession {
+  std::string key;
+  std::shared_ptr<cpr::Session> session;
+
+public:
+  PooledSession(std::string_view method, const std::string &url,
+                const cpr::Header &headers, bool enableSsl,
+                const cpr::SslOptions &sslOptions,
+                const std::map<std::string, std::string> &cookies) {
+    // The origin is the scheme, host and port of the URL.
+    auto hostStart = url.find("://");
+    auto pathStart =
+        url.find('/', hostStart == std::string::npos ? 0 : hostStart + 3);
+    key = std::string(method) + " " + url.substr(0, pathStart);
+    session = getSessionPool().acquire(key);
+
+    cpr::Cookies cprCookies;
+    for (const auto &kv : cookies)
+      cprCookies.emplace_back({kv.first, kv.second});
+    session->SetUrl(cpr::Url{url});
+    session->SetHeader(headers);
+    session->SetParameters(cpr::Parameters{});
+    session->SetVerifySsl(cpr::VerifySsl(enableSsl));
+    session->SetSslOptions(sslOptions);
+    session->SetCookies(cprCookies);
+  }
+  PooledSession(const PooledSession &) = delete;
+  PooledSession &operator=(const PooledSession &) = delete;
+  ~PooledSession() { getSessionPool().release(key, std::move(session)); }
+
+  cpr::Session *operator->() { return session.get(); }
+};
+
+/// Return the minimum size of the request bodies to compress, from
+/// `CUDAQ_REST_COMPRESS_MIN_BYTES`. 0 (the default) disables compression,
+/// since not all servers accept compressed requests.
+std::size_t getCompressionThreshold() {
+  static const std::size_t threshold = [] {
+    const char *env = std::getenv("CUDAQ_REST_COMPRESS_MIN_BYTES");
+    if (!env || !*env)
+      return std::size_t(0);
+    try {
+      return std::size_t(std::stoull(env));
+    } catch (...) {
+      throw std::runtime_error("Invalid CUDAQ_REST_COMPRESS_MIN_BYTES value '" +
+                               std::string(env) + "'. Expected a size.");
     }
-    std::filesystem::path cudaqLibPath{cudaq::getCUDAQLibraryPath()};
-    auto certPath = cudaqLibPath.parent_path().parent_path() / "cacert.pem";
-    if (std::filesystem::exists(certPath))
-      return certPath.string();
-    CUDAQ_INFO(
-        "{} does not exist, so we will rely on CURL finding the correct "
-        "certificate authority bundles. If this does not work, try setting "
-        "the CURL_CA_BUNDLE environment variable to a valid path to a CA "
-        "Bundle file, like one downloaded from here: "
-        "https://curl.se/ca/cacert.pem.",
-        certPath.string());
-    return "";
   }();
+  return threshold;
+}
+
+/// A stream buffer serializing the body of a request. The body is kept as is
+/// until it reaches the compression threshold, and is compressed in the gzip
+/// format on the fly from then on, so that the uncompressed body of a large
+/// request is never held in memory.
+class BodyBuffer : public std::streambuf {
+public:
+  explicit BodyBuffer(std::size_t threshold) : threshold(threshold) {
+    setp(chunk.data(), chunk.data() + chunk.size());
+  }
+  BodyBuffer(const BodyBuffer &) = delete;
+  BodyBuffer &operator=(const BodyBuffer &) = delete;
+  ~BodyBuffer() override {
+    if (compressing)
+      deflateEnd(&stream);
+  }
+
+  /// Return the body, and whether it is compressed.
+  std::pair<std::string, bool> finish() {
+    flushChunk();
+    if (!compressing)
+      return {std::move(body), false};
+    deflateData(nullptr, 0, Z_FINISH);
+    deflateEnd(&stream);
+    compressing = false;
+    return {std::move(body), true};
+  }
+
+protected:
+  int_type overflow(int_type c) override {
+    flushChunk();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  int sync() override {
+    flushChunk();
+    return 0;
+  }
+
+private:
+  void flushChunk() {
+    write(pbase(), pptr() - pbase());
+    setp(chunk.data(), chunk.data() + chunk.size());
+  }
+
+  void write(const char *data, std::size_t size) {
+    if (compressing) {
+      deflateData(data, size, Z_NO_FLUSH);
+      return;
+    }
+    body.append(data, size);
+    if (threshold == 0 || body.size() < threshold)
+      return;
+    // 15 window bits, plus 16 to write a gzip header.
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+      throw std::runtime_error("Unable to initialize the request compression.");
+    compressing = true;
+    std::string uncompressed = std::move(body);
+    body.clear();
+    deflateData(uncompressed.data(), uncompressed.size(), Z_NO_FLUSH);
+  }
 
+  void deflateData(const char *data, std::size_t size, int flush) {
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    stream.avail_in = size;
+    std::array<char, 16384> output;
+    do {
+      stream.next_out = reinterpret_cast<Bytef *>(output.data());
+      stream.avail_out = output.size();
+      if (deflate(&stream, flush) == Z_STREAM_ERROR)
+        throw std::runtime_error("Unable to compress the request.");
+      body.append(output.data(), output.size() - stream.avail_out);
+    } while (stream.avail_out == 0);
+  }
+
+  std::size_t threshold;
+  bool compressing = false;
+  z_stream stream{};
+  std::array<char, 16384> chunk;
+  /// The body, compressed once `compressing` is set.
+  std::string body;
+};
+
+/// Return the body of a request with `data`, compressed if it is large
+/// enough, in which case the encoding is added to `headers`.
+cpr::Body makeBody(const nlohmann::json &data, cpr::Header &headers) {
+  BodyBuffer buffer(getCompressionThreshold());
+  std::ostream os(&buffer);
+  os << data;
+  auto [body, compressed] = buffer.finish();
+  if (compressed)
+    headers["Content-Encoding"] = "gzip";
+  return cpr::Body(std::move(body));
+}
+} // namespace
+
+std::string RestClient::findCABundle() {
+  if (auto *curlCABundleStr = getenv("CURL_CA_BUNDLE")) {
+    if (std::filesystem::exists(curlCABundleStr))
+      return curlCABundleStr;
+    else
+      CUDAQ_INFO("{} does not exist. Will fall back on CUDA-Q installed certs",
+                 curlCABundleStr);
+  }
+  std::filesystem::path cudaqLibPath{cudaq::getCUDAQLibraryPath()};
+  auto certPath = cudaqLibPath.parent_path().parent_path() / "cacert.pem";
+  if (std::filesystem::exists(certPath))
+    return certPath.string();
+  CUDAQ_INFO("{} does not exist, so we will rely on CURL finding the correct "
+             "certificate authority bundles. If this does not work, try "
+             "setting the CURL_CA_BUNDLE environment variable to a valid path "
+             "to a CA Bundle file, like one downloaded from here: "
+             "https://curl.se/ca/cacert.pem.",
+             certPath.string());
+  return "";
+}
+
+RestClient::RestClient() : sslOptions(std::make_unique<cpr::SslOptions>()) {
+  auto caInfo = findCABundle();
   if (!caInfo.empty())
     sslOptions->SetOption(cpr::ssl::CaInfo(std::move(caInfo)));
 }
@@ -61,17 +265,16 @@ RestClient::post(const std::string_view remoteUrl, const std::string_view path,
   for (auto &kv : headers)
     cprHeaders.insert({kv.first, kv.second});
 
-  cpr::Cookies cprCookies;
-  for (const auto &kv : cookies)
-    cprCookies.emplace_back({kv.first, kv.second});
-
   // Allow caller to disable logging for things like passwords/tokens
   if (enableLogging)
     CUDAQ_INFO("Posting to {}/{} with data = {}", remoteUrl, path, post.dump());
 
   auto actualPath = std::string(remoteUrl) + std::string(path);
-  auto r = cpr::Post(cpr::Url{actualPath}, cpr::Body(post.dump()), cprHeaders,
-                     cpr::VerifySsl(enableSsl), *sslOptions, cprCookies);
+  auto body = makeBody(post, cprHeaders);
+  PooledSession session("POST", actualPath, cprHeaders, enableSsl, *sslOptions,
+                        cookies);
+  session->SetBody(std::move(body));
+  auto r = session->Post();
 
   if (r.status_code > validHttpCode || r.status_code == 0)
     throw std::runtime_error("HTTP POST Error - status code " +
@@ -83,6 +286,11 @@ RestClient::post(const std::string_view remoteUrl, const std::string_view path,
     for (const auto &cookie : r.cookies)
       (*cookiesOut)[cookie.GetName()] = cookie.GetValue();
 
+  // Servers may reply in the binary (CBOR) format if the request accepts it.
+  if (auto iter = r.header.find("Content-Type");
+      iter != r.header.end() &&
+      iter->second.find("application/cbor") != std::string::npos)
+    return nlohmann::json::from_cbor(r.text);
   return nlohmann::json::parse(r.text);
 }
 
@@ -97,17 +305,17 @@ void RestClient::put(const std::string_view remoteUrl,
   cpr::Header cprHeaders;
   for (auto &kv : headers)
     cprHeaders.insert({kv.first, kv.second});
-  cpr::Cookies cprCookies;
-  for (const auto &kv : cookies)
-    cprCookies.emplace_back({kv.first, kv.second});
   // Allow caller to disable logging for things like passwords/tokens
   if (enableLogging)
     CUDAQ_INFO("Putting to {}/{} with data = {}", remoteUrl, path,
                putData.dump());
 
   auto actualPath = std::string(remoteUrl) + std::string(path);
-  auto r = cpr::Put(cpr::Url{actualPath}, cpr::Body(putData.dump()), cprHeaders,
-                    cpr::VerifySsl(enableSsl), *sslOptions, cprCookies);
+  auto body = makeBody(putData, cprHeaders);
+  PooledSession session("PUT", actualPath, cprHeaders, enableSsl, *sslOptions,
+                        cookies);
+  session->SetBody(std::move(body));
+  auto r = session->Put();
 
   if (r.status_code > validHttpCode || r.status_code == 0)
     throw std::runtime_error("HTTP PUT Error - status code " +
@@ -125,13 +333,10 @@ std::string RestClient::getRawText(
   cpr::Header cprHeaders;
   for (auto &kv : headers)
     cprHeaders.insert({kv.first, kv.second});
-  cpr::Cookies cprCookies;
-  for (const auto &kv : cookies)
-    cprCookies.emplace_back({kv.first, kv.second});
-  cpr::Parameters cprParams;
   auto actualPath = std::string(remoteUrl) + std::string(path);
-  auto r = cpr::Get(cpr::Url{actualPath}, cprHeaders, cprParams,
-                    cpr::VerifySsl(enableSsl), *sslOptions, cprCookies);
+  PooledSession session("GET", actualPath, cprHeaders, enableSsl, *sslOptions,
+                        cookies);
+  auto r = session->Get();
 
   if (r.status_code > validHttpCode || r.status_code == 0)
     throw std::runtime_error("HTTP GET Error - status code " +
@@ -156,15 +361,12 @@ void RestClient::del(const std::string_view remoteUrl,
   cpr::Header cprHeaders;
   for (auto &kv : headers)
     cprHeaders.insert({kv.first, kv.second});
-  cpr::Cookies cprCookies;
-  for (const auto &kv : cookies)
-    cprCookies.emplace_back({kv.first, kv.second});
-  cpr::Parameters cprParams;
   auto actualPath = std::string(remoteUrl) + std::string(path);
   if (enableLogging)
     CUDAQ_INFO("Delete resource at path {}/{}", remoteUrl, path);
-  auto r = cpr::Delete(cpr::Url{actualPath}, cprHeaders, cprParams,
-                       cpr::VerifySsl(enableSsl), *sslOptions, cprCookies);
+  PooledSession session("DELETE", actualPath, cprHeaders, enableSsl,
+                        *sslOptions, cookies);
+  auto r = session->Delete();
 
   if (r.status_code > validHttpCode || r.status_code == 0)
     throw std::runtime_error("HTTP DELETE Error - status code " +
@@ -176,12 +378,9 @@ void RestClient::download(const std::string_view remoteUrl,
                           const std::string &filePath, bool enableLogging,
                           bool enableSsl,
                           const std::map<std::string, std::string> &cookies) {
-  cpr::Cookies cprCookies;
-  for (const auto &kv : cookies)
-    cprCookies.emplace_back({kv.first, kv.second});
-  auto r = cpr::Get(cpr::Url{std::string(remoteUrl)}, cpr::Header{},
-                    cpr::Parameters{}, cpr::VerifySsl(enableSsl), *sslOptions,
-                    cprCookies);
+  PooledSession session("GET", std::string(remoteUrl), cpr::Header{},
+                        enableSsl, *sslOptions, cookies);
+  auto r = session->Get();
 
   if (r.status_code > validHttpCode || r.status_code == 0)
     throw std::runtime_error("HTTP Download Error - status code " +
@@ -39,6 +39,10 @@ public:
   /// @brief Destructor
   ~RestClient();
 
+  /// @brief Return the certificate authority bundle to use for transfers, or
+  /// an empty string to rely on the one found by CURL.
+  static std::string findCABundle();
+
   /// Post the message to the remote path at the provided URL and potentially
   /// update the cookies map from the server response.
   // This can be use for authentication post requests, whereby the server sends
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "ResultCache.h"
+#include "Environment.h"
+#include "Logger.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+#include "nlohmann/json.hpp"
+#include <cstdlib>
+#include <stdexcept>
+
+static constexpr const char entrySuffix[] = ".json";
+static constexpr std::chrono::seconds defaultTimeToLive(24 * 60 * 60);
+
+cudaq::ResultCache::ResultCache(std::string directory,
+                                std::chrono::seconds timeToLive, bool bypass)
+    : directory(std::move(directory)), timeToLive(timeToLive),
+      bypass(bypass) {
+  if (auto ec = llvm::sys::fs::create_directories(this->directory))
+    throw std::runtime_error("Unable to create the result cache directory " +
+                             this->directory + ": " + ec.message());
+}
+
+std::unique_ptr<cudaq::ResultCache>
+cudaq::ResultCache::createFromEnvironment() {
+  const char *directory = std::getenv("CUDAQ_RESULT_CACHE_DIR");
+  if (!directory || !*directory)
+    return nullptr;
+  auto timeToLive = defaultTimeToLive;
+  if (const char *ttl = std::getenv("CUDAQ_RESULT_CACHE_TTL")) {
+    std::int64_t seconds = 0;
+    if (llvm::StringRef(ttl).getAsInteger(10, seconds) || seconds < 0)
+      throw std::runtime_error(
+          "Invalid CUDAQ_RESULT_CACHE_TTL value '" + std::string(ttl) +
+          "'. Expected a number of seconds, or 0 for no expiration.");
+    timeToLive = std::chrono::seconds(seconds);
+  }
+  const bool bypass = getEnvBool("CUDAQ_RESULT_CACHE_BYPASS", false);
+  CUDAQ_INFO("Using the result cache in {} (time to live {} s{}).", directory,
+             timeToLive.count(), bypass ? ", bypassed" : "");
+  return std::make_unique<ResultCache>(directory, timeToLive, bypass);
+}
+
+std::string cudaq::ResultCache::key(std::string_view content) {
+  return llvm::toHex(llvm::SHA256::hash(llvm::arrayRefFromStringRef(
+                         llvm::StringRef(content.data(), content.size()))),
+                     /*LowerCase=*/true);
+}
+
+std::string cudaq::ResultCache::entryPath(const std::string &key) const {
+  llvm::SmallString<256> path(directory);
+  llvm::sys::path::append(path, key + entrySuffix);
+  return path.str().str();
+}
+
+std::optional<cudaq::sample_result>
+cudaq::ResultCache::load(const std::string &key) const {
+  if (bypass)
+    return std::nullopt;
+  const auto path = entryPath(key);
+  llvm::sys::fs::file_status status;
+  if (llvm::sys::fs::status(path, status))
+    return std::nullopt;
+  if (timeToLive.count() > 0 &&
+      std::chrono::system_clock::now() - status.getLastModificationTime() >
+          timeToLive) {
+    CUDAQ_INFO("The result cache entry {} expired.", path);
+    return std::nullopt;
+  }
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return std::nullopt;
+
+  auto entry = nlohmann::json::parse((*buffer)->getBuffer().str(), nullptr,
+                                     /*allow_exceptions=*/false);
+  if (entry.is_discarded() || !entry.contains("results")) {
+    CUDAQ_INFO("Ignoring the malformed result cache entry {}.", path);
+    return std::nullopt;
+  }
+  std::vector<ExecutionResult> results;
+  for (auto &r : entry["results"]) {
+    ExecutionResult result;
+    r.at("counts").get_to(result.counts);
+    r.at("registerName").get_to(result.registerName);
+    r.at("sequentialData").get_to(result.sequentialData);
+    if (r.contains("expectationValue"))
+      result.expectationValue = r["expectationValue"].get<double>();
+    results.emplace_back(std::move(result));
+  }
+  CUDAQ_INFO("Loaded the result cache entry {}.", path);
+  return sample_result(results);
+}
+
+void cudaq::ResultCache::store(const std::string &key,
+                               const sample_result &result) const {
+  nlohmann::json results = nlohmann::json::array();
+  for (const auto &regName : result.register_names()) {
+    nlohmann::json r{{"counts", result.to_map(regName)},
+                     {"registerName", regName},
+                     {"sequentialData", result.sequential_data(regName)}};
+    if (result.has_expectation(regName))
+      r["expectationValue"] = result.expectation(regName);
+    results.push_back(std::move(r));
+  }
+  const auto contents = nlohmann::json{{"results", results}}.dump();
+
+  // Write a private temporary file and rename it into place, which is atomic:
+  // other processes either see the complete entry or the previous one.
+  const auto path = entryPath(key);
+  int fd;
+  llvm::SmallString<256> tmpPath;
+  if (llvm::sys::fs::createUniqueFile(path + ".%%%%%%%%.tmp", fd, tmpPath)) {
+    CUDAQ_INFO("Unable to create a temporary result cache entry in {}.",
+               directory);
+    return;
+  }
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << contents;
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(tmpPath);
+      CUDAQ_INFO("Unable to write the result cache entry {}.", path);
+      return;
+    }
+  }
+  if (llvm::sys::fs::rename(tmpPath, path)) {
+    llvm::sys::fs::remove(tmpPath);
+    return;
+  }
+  CUDAQ_INFO("Stored the result cache entry {}.", path);
+}
@@ -0,0 +1,64 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "common/SampleResult.h"
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace cudaq {
+
+/// @brief An opt-in, on-disk, content-addressed cache of the results of
+/// remote sampling jobs, shared by all the processes that use the same cache
+/// directory.
+///
+/// Entries are keyed by a hash of everything that determines the submitted
+/// jobs, i.e., the compiled code, the number of shots and the target
+/// configuration, see `key`. Rerunning an identical `sample` on a REST target
+/// then returns the stored result instead of paying for the hardware or the
+/// queue again. Entries older than the time to live are ignored, and are
+/// replaced by the next result stored under the same key. As for the JIT
+/// object cache, entries are written to a temporary file and renamed into
+/// place, hence readers never see a partial result.
+class ResultCache {
+public:
+  /// @brief Create a cache in `directory`, whose entries expire after
+  /// `timeToLive`, or never if it is zero. If `bypass` is set, lookups always
+  /// miss, but results are still stored, which refreshes the entries.
+  ResultCache(std::string directory, std::chrono::seconds timeToLive,
+              bool bypass = false);
+
+  /// @brief Create the cache configured by the `CUDAQ_RESULT_CACHE_DIR`,
+  /// `CUDAQ_RESULT_CACHE_TTL` (in seconds) and `CUDAQ_RESULT_CACHE_BYPASS`
+  /// environment variables, or return null if `CUDAQ_RESULT_CACHE_DIR` is not
+  /// set.
+  static std::unique_ptr<ResultCache> createFromEnvironment();
+
+  /// @brief The key of the result of the jobs described by `content`, which
+  /// must uniquely identify them.
+  static std::string key(std::string_view content);
+
+  /// @brief Return the unexpired result stored under `key`, if any.
+  std::optional<sample_result> load(const std::string &key) const;
+
+  /// @brief Store `result` under `key`.
+  void store(const std::string &key, const sample_result &result) const;
+
+private:
+  /// @brief The path of the entry with the given key.
+  std::string entryPath(const std::string &key) const;
+
+  std::string directory;
+  std::chrono::seconds timeToLive;
+  bool bypass;
+};
+
+} // namespace cudaq
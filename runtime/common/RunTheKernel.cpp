@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "RuntimeMLIR.h"
+#include "common/Environment.h"
 #include "common/ExecutionContext.h"
 #include "common/RecordLogParser.h"
 #include "cudaq.h"
@@ -27,7 +28,15 @@
 #include "mlir/Parser/Parser.h"
 #include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
 #include "mlir/Target/LLVMIR/TypeToLLVM.h"
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <random>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -113,6 +122,195 @@ static LayoutInfoType getLayoutInfo(const std::string &name, void *opt_module) {
   return {};
 }
 
+/// Environment variable that sets the number of threads that the shots of a
+/// `run` on a local simulator are sharded across.
+static constexpr const char runNumThreadsEnvVar[] = "CUDAQ_RUN_NUM_THREADS";
+
+/// Shards hold at least this many shots, so that small runs use fewer threads.
+static constexpr std::size_t minShotsPerThread = 64;
+
+static std::size_t getRunNumThreads(std::size_t shots) {
+  auto *envVal = std::getenv(runNumThreadsEnvVar);
+  if (!envVal)
+    return 1;
+  const int numThreads = std::atoi(envVal);
+  if (numThreads < 1)
+    throw std::runtime_error(
+        std::string("Invalid ") + runNumThreadsEnvVar +
+        " environment variable setting. Expecting a positive integer, got '" +
+        envVal + "'.");
+  return std::clamp<std::size_t>(shots / minShotsPerThread, 1, numThreads);
+}
+
+/// Environment variable that enables batching the shots of a `run` on a local
+/// simulator by the outcomes of their measurements.
+static constexpr const char runBranchBatchingEnvVar[] =
+    "CUDAQ_RUN_BRANCH_BATCHING";
+
+namespace {
+/// Record the output of the kernels that run on the calling thread in the
+/// binary output records of its simulator, rather than formatting it into its
+/// text output log, for the lifetime of this object.
+class BinaryOutputScope {
+public:
+  BinaryOutputScope() : simulator(nvqir::getCircuitSimulatorInternal()) {
+    simulator->outputRecords.clear();
+    simulator->recordBinaryOutput = true;
+  }
+  ~BinaryOutputScope() { simulator->recordBinaryOutput = false; }
+
+private:
+  nvqir::CircuitSimulator *simulator;
+};
+
+/// Have the measurements of the kernels that run on the calling thread follow
+/// the branches of `branching`, for the lifetime of this object.
+class MeasurementBranchingScope {
+public:
+  MeasurementBranchingScope(nvqir::MeasurementBranching &branching)
+      : simulator(nvqir::getCircuitSimulatorInternal()) {
+    simulator->setMeasurementBranching(&branching);
+  }
+  ~MeasurementBranchingScope() { simulator->setMeasurementBranching(nullptr); }
+
+private:
+  nvqir::CircuitSimulator *simulator;
+};
+} // namespace
+
+/// Run the given number of shots of the kernel on the calling thread. Their
+/// output is appended to the output records of the simulator of the thread.
+/// With a `branchingSeed`, the shots are batched by the outcomes of their
+/// measurements: the kernel is executed once per distinct branch of outcomes,
+/// and the output of each branch is repeated for each of its shots, which are
+/// then shuffled.
+static void runShots(const std::function<void()> &kernel,
+                     cudaq::quantum_platform &platform, std::size_t shots,
+                     std::size_t qpu_id,
+                     std::optional<std::uint64_t> branchingSeed) {
+  auto ctx = std::make_unique<cudaq::ExecutionContext>("run", 1, qpu_id);
+  const auto runOnce = [&]() {
+    // Set the execution context since as noise model is attached to this
+    // context.
+    platform.set_exec_ctx(ctx.get());
+    kernel();
+    // Reset the context to flush qubit deallocation.
+    platform.reset_exec_ctx();
+  };
+  if (!branchingSeed) {
+    for (std::size_t i = 0; i < shots; ++i)
+      runOnce();
+    return;
+  }
+
+  auto &records = nvqir::getCircuitSimulatorInternal()->outputRecords;
+  const std::size_t firstRecord = records.size();
+  // The records of leaf `i` are those in [leafRecords[i], leafRecords[i + 1]).
+  std::vector<std::size_t> leafRecords = {0};
+  nvqir::MeasurementBranching branching(shots, *branchingSeed);
+  {
+    MeasurementBranchingScope branchingScope(branching);
+    while (branching.nextLeaf()) {
+      runOnce();
+      leafRecords.push_back(records.size() - firstRecord);
+    }
+  }
+  CUDAQ_INFO("Ran {} shots as {} measurement branches.", shots,
+             branching.getLeafShots().size());
+
+  // Fold the leaves back into the shots.
+  std::vector<cudaq::OutputRecord> leaves(
+      std::make_move_iterator(records.begin() + firstRecord),
+      std::make_move_iterator(records.end()));
+  records.resize(firstRecord);
+  for (auto leaf : branching.getShotLeaves())
+    records.insert(records.end(), leaves.begin() + leafRecords[leaf],
+                   leaves.begin() + leafRecords[leaf + 1]);
+}
+
+/// Draw the random seeds of the simulators of the worker threads of a sharded
+/// run. When a random seed was set, the seeds are drawn from an engine seeded
+/// with it, so that sharded runs are reproducible but differ from each other.
+static std::vector<std::size_t> drawShardSeeds(std::size_t numSeeds) {
+  static std::mutex mutex;
+  static std::size_t engineSeed = 0;
+  static std::mt19937_64 engine;
+  std::vector<std::size_t> seeds(numSeeds);
+  const auto seed = cudaq::get_random_seed();
+  std::scoped_lock lock(mutex);
+  if (seed == 0) {
+    std::random_device device;
+    for (auto &s : seeds)
+      s = (static_cast<std::size_t>(device()) << 32) ^ device();
+    return seeds;
+  }
+  if (seed != engineSeed) {
+    engine.seed(seed);
+    engineSeed = seed;
+  }
+  for (auto &s : seeds)
+    s = engine();
+  return seeds;
+}
+
+/// Run the shots of the kernel sharded across `numThreads` threads. Each thread
+/// runs a contiguous range of shots on its own simulator, which is created
+/// (cloned, for an externally provided simulator) on its first use by the
+/// thread, with its own output records and random seed. The calling thread runs
+/// the first range on its simulator, whose output records then receive the
+/// records of the other threads in shot order. When `branching` is set, each
+/// thread batches its shots by measurement branches.
+static void runShotsInParallel(const std::function<void()> &kernel,
+                               cudaq::quantum_platform &platform,
+                               std::size_t shots, std::size_t qpu_id,
+                               std::size_t numThreads, bool branching) {
+  // The seeds of the simulators of the worker threads, followed by those of
+  // the measurement branching of each thread.
+  auto seeds = drawShardSeeds(2 * numThreads - 1);
+  const auto branchingSeed =
+      [&](std::size_t shard) -> std::optional<std::uint64_t> {
+    if (!branching)
+      return std::nullopt;
+    return seeds[numThreads - 1 + shard];
+  };
+  std::vector<std::vector<cudaq::OutputRecord>> outputRecords(numThreads);
+  std::vector<std::exception_ptr> errors(numThreads);
+  const auto firstShot = [&](std::size_t shard) {
+    return shard * shots / numThreads;
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(numThreads - 1);
+  for (std::size_t shard = 1; shard < numThreads; ++shard)
+    workers.emplace_back([&, shard]() {
+      try {
+        auto *simulator = nvqir::getCircuitSimulatorInternal();
+        simulator->setRandomSeed(seeds[shard - 1]);
+        BinaryOutputScope binaryOutput;
+        runShots(kernel, platform, firstShot(shard + 1) - firstShot(shard),
+                 qpu_id, branchingSeed(shard));
+        outputRecords[shard].swap(simulator->outputRecords);
+      } catch (...) {
+        errors[shard] = std::current_exception();
+      }
+    });
+  try {
+    runShots(kernel, platform, firstShot(1), qpu_id, branchingSeed(0));
+  } catch (...) {
+    errors[0] = std::current_exception();
+  }
+  for (auto &worker : workers)
+    worker.join();
+  for (auto &error : errors)
+    if (error)
+      std::rethrow_exception(error);
+
+  auto &records = nvqir::getCircuitSimulatorInternal()->outputRecords;
+  for (std::size_t shard = 1; shard < numThreads; ++shard)
+    records.insert(records.end(),
+                   std::make_move_iterator(outputRecords[shard].begin()),
+                   std::make_move_iterator(outputRecords[shard].end()));
+}
+
 cudaq::details::RunResultSpan cudaq::details::runTheKernel(
     std::function<void()> &&kernel, quantum_platform &platform,
     const std::string &kernel_name, const std::string &original_name,
@@ -127,8 +325,10 @@ cudaq::details::RunResultSpan cudaq::details::runTheKernel(
     throw std::runtime_error("`run` is not yet supported on this target.");
 
   // 2. Launch the kernel on the QPU.
-  if (platform.is_remote() || platform.is_emulated() ||
-      platform.get_remote_capabilities().isRemoteSimulator) {
+  const bool isLocal =
+      !platform.is_remote() && !platform.is_emulated() &&
+      !platform.get_remote_capabilities().isRemoteSimulator;
+  if (!isLocal) {
     // In a remote simulator execution or hardware emulation environment, set
     // the `run` context name and number of iterations (shots)
     auto ctx = std::make_unique<cudaq::ExecutionContext>("run", shots, qpu_id);
@@ -143,33 +343,50 @@ cudaq::details::RunResultSpan cudaq::details::runTheKernel(
                                 ctx->invocationResultBuffer.end());
     circuitSimulator->outputLog.swap(remoteOutputLog);
   } else {
-    auto ctx = std::make_unique<cudaq::ExecutionContext>("run", 1, qpu_id);
-    for (std::size_t i = 0; i < shots; ++i) {
-      // Set the execution context since as noise model is attached to this
-      // context.
-      platform.set_exec_ctx(ctx.get());
-      kernel();
-      // Reset the context to flush qubit deallocation.
-      platform.reset_exec_ctx();
-    }
+    // Python kernels are launched from their resident module, which is not
+    // shared across threads, and multi-QPU platforms already run on every QPU
+    // in parallel: their shots are not sharded. The output of the kernel is
+    // recorded in binary, since it does not need to be sent anywhere.
+    BinaryOutputScope binaryOutput;
+    const std::size_t numThreads =
+        opt_module || platform.supports_task_distribution()
+            ? 1
+            : getRunNumThreads(shots);
+    // Kernels that branch on measurements may have their shots batched by
+    // branches, when the simulator can replay a branch deterministically.
+    const bool branching =
+        cudaq::getEnvBool(runBranchBatchingEnvVar, false) &&
+        circuitSimulator->canBranchMeasurements(platform.get_noise(qpu_id) !=
+                                                nullptr);
+    if (numThreads > 1)
+      runShotsInParallel(kernel, platform, shots, qpu_id, numThreads,
+                         branching);
+    else
+      runShots(kernel, platform, shots, qpu_id,
+               branching ? std::optional<std::uint64_t>(drawShardSeeds(1)[0])
+                         : std::nullopt);
   }
 
   // 3a. Get the data layout information. Use the original kernel, since it has
   // the information while the kernel being called dropped it on the floor.
   auto layoutInfo = getLayoutInfo(kernel_name, opt_module);
 
-  // 3b. Pass the outputLog to the parser (target-specific?)
+  // 3b. Pass the output records, or the outputLog of remote and emulated
+  // targets, to the parser (target-specific?)
   cudaq::RecordLogParser parser(layoutInfo);
-  parser.parse(circuitSimulator->outputLog);
+  if (isLocal)
+    parser.parse(circuitSimulator->outputRecords);
+  else
+    parser.parse(circuitSimulator->outputLog);
 
-  // 4. Get the buffer and length of buffer (in bytes) from the parser.
-  auto *origBuffer = parser.getBufferPtr();
+  // 4. Take the ownership of the buffer and length of buffer (in bytes) from
+  // the parser, which wrote the results in place.
   std::size_t bufferSize = parser.getBufferSize();
-  char *buffer = static_cast<char *>(malloc(bufferSize));
-  std::memcpy(buffer, origBuffer, bufferSize);
+  char *buffer = parser.releaseBuffer();
 
-  // 5. Clear the outputLog (?)
+  // 5. Clear the outputLog and output records (?)
   circuitSimulator->outputLog.clear();
+  circuitSimulator->outputRecords.clear();
 
   // 6. Pass the span back as a RunResultSpan. NB: it is the responsibility of
   // the caller to free the buffer.
@@ -28,6 +28,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
 #include "mlir/ExecutionEngine/OptUtils.h"
 #include "mlir/InitAllTranslations.h"
@@ -93,12 +94,24 @@ cudaq::TranslateFromMLIRRegistration::TranslateFromMLIRRegistration(
 namespace {
 std::once_flag mlir_init_flag;
 MLIRContext *mlirContext;
+
+/// The threads running the passes of all the contexts. Each context would
+/// otherwise spawn its own pool, and a context is created per kernel launch.
+llvm::ThreadPool &getPassThreadPool() {
+  // Intentionally leaked, like the global context using it.
+  static auto *threadPool = new llvm::ThreadPool();
+  return *threadPool;
+}
+
 std::unique_ptr<MLIRContext> createMLIRContext() {
   // Per-context initialization
   DialectRegistry registry;
   cudaq::opt::registerCodeGenDialect(registry);
   cudaq::registerAllDialects(registry);
-  auto context = std::make_unique<MLIRContext>(registry);
+  auto context =
+      std::make_unique<MLIRContext>(registry, MLIRContext::Threading::DISABLED);
+  if (!cudaq::getEnvBool("CUDAQ_MLIR_DISABLE_THREADING", false))
+    context->setThreadPool(getPassThreadPool());
   context->loadAllAvailableDialects();
   registerLLVMDialectTranslation(*context);
   return context;
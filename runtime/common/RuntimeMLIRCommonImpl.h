@@ -11,6 +11,7 @@
 #include "CodeGenConfig.h"
 #include "Environment.h"
 #include "Logger.h"
+#include "PassProfiler.h"
 #include "Timing.h"
 #include "cudaq/Frontend/nvqpp/AttributeNames.h"
 #include "cudaq/Optimizer/Builder/Intrinsics.h"
@@ -477,6 +478,15 @@ mlir::LogicalResult verifyLLVMInstructions(llvm::Module *llvmModule,
   return mlir::success();
 }
 
+/// @brief Write the Base64 encoding of `data` to `output` chunk by chunk,
+/// rather than through a temporary string of the whole encoding.
+static void writeBase64(llvm::StringRef data, llvm::raw_ostream &output) {
+  // A multiple of 3 bytes, so that only the last chunk is padded.
+  constexpr std::size_t chunkSize = 3 * 4096;
+  for (std::size_t pos = 0; pos < data.size(); pos += chunkSize)
+    output << llvm::encodeBase64(data.substr(pos, chunkSize));
+}
+
 /// @brief Function to lower MLIR to a specific QIR profile
 /// @param op MLIR operation
 /// @param output Output stream
@@ -488,6 +498,8 @@ mlir::LogicalResult qirProfileTranslationFunction(
     llvm::raw_string_ostream &output, const std::string &additionalPasses,
     bool printIR, bool printIntermediateMLIR, bool printStats) {
   ScopedTraceWithContext(cudaq::TIMING_JIT, "qirProfileTranslationFunction");
+  cudaq::profiler::ScopedPhase phase(cudaq::profiler::Phase::jit_passes,
+                                     qirProfile);
 
   auto config = parseCodeGenTranslation(qirProfile);
   if (!config.isQIRProfile)
@@ -517,6 +529,7 @@ mlir::LogicalResult qirProfileTranslationFunction(
   if (!additionalPasses.empty() &&
       failed(parsePassPipeline(additionalPasses, pm, errOs)))
     return mlir::failure();
+  cudaq::profiler::instrumentPasses(pm);
   mlir::DefaultTimingManager tm;
   tm.setEnabled(cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES));
   auto timingScope = tm.getRootScope(); // starts the timer
@@ -641,7 +654,7 @@ mlir::LogicalResult qirProfileTranslationFunction(
   llvm::SmallString<1024> bitCodeMem;
   llvm::raw_svector_ostream os(bitCodeMem);
   llvm::WriteBitcodeToFile(*llvmModule, os);
-  output << llvm::encodeBase64(bitCodeMem.str());
+  writeBase64(bitCodeMem.str(), output);
   return mlir::success();
 }
 
@@ -682,6 +695,7 @@ void registerToOpenQASMTranslation() {
         if (printStats)
           pm.enableStatistics();
         cudaq::opt::addPipelineTranslateToOpenQASM(pm);
+        cudaq::profiler::instrumentPasses(pm);
         mlir::DefaultTimingManager tm;
         tm.setEnabled(cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES));
         auto timingScope = tm.getRootScope(); // starts the timer
@@ -713,6 +727,7 @@ void registerToIQMJsonTranslation() {
         if (printStats)
           pm.enableStatistics();
         cudaq::opt::addPipelineTranslateToIQMJson(pm);
+        cudaq::profiler::instrumentPasses(pm);
         mlir::DefaultTimingManager tm;
         tm.setEnabled(cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES));
         auto timingScope = tm.getRootScope(); // starts the timer
@@ -835,6 +850,8 @@ mlir::ExecutionEngine *createQIRJITEngine(mlir::ModuleOp &moduleOp,
           llvm::LLVMContext &llvmContext) -> std::unique_ptr<llvm::Module> {
     ScopedTraceWithContext(cudaq::TIMING_JIT,
                            "createQIRJITEngine::llvmModuleBuilder");
+    cudaq::profiler::ScopedPhase phase(cudaq::profiler::Phase::jit_passes,
+                                       "createQIRJITEngine");
     llvmContext.setOpaquePointers(false);
 
     auto *context = module->getContext();
@@ -873,6 +890,7 @@ mlir::ExecutionEngine *createQIRJITEngine(mlir::ModuleOp &moduleOp,
           return mlir::failure();
         });
 
+    cudaq::profiler::instrumentPasses(pm);
     mlir::DefaultTimingManager tm;
     tm.setEnabled(cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES));
     auto timingScope = tm.getRootScope(); // starts the timer
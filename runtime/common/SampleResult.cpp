@@ -17,6 +17,10 @@
 #include <map>
 #include <vector>
 
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
 static std::string longToBitString(int size, long x) {
   std::string s(size, '0');
   int counter = 0;
@@ -56,6 +60,109 @@ static std::string extractNameFromData(std::vector<std::size_t> &data,
 
 namespace cudaq {
 
+std::string PackedShots::toBitString(std::uint64_t packed,
+                                     std::size_t numBits) {
+  std::string bits(numBits, '0');
+  for (std::size_t i = 0; i < numBits; ++i)
+    if ((packed >> i) & 1)
+      bits[i] = '1';
+  return bits;
+}
+
+PackedShots PackedShots::fromBitStrings(const std::vector<std::string> &shots) {
+  PackedShots packed(shots.empty() ? 0 : shots.front().size());
+  packed.words.resize(shots.size() * packed.wordsPerShot(), 0);
+  for (std::size_t s = 0; s < shots.size(); ++s) {
+    if (shots[s].size() != packed.numBits)
+      throw std::runtime_error("PackedShots::fromBitStrings requires bit "
+                               "strings of the same length.");
+    auto *out = packed.words.data() + s * packed.wordsPerShot();
+    for (std::size_t i = 0; i < packed.numBits; ++i)
+      if (shots[s][i] == '1')
+        out[i / 64] |= 1ULL << (i % 64);
+  }
+  return packed;
+}
+
+std::string PackedShots::to_string(std::size_t shotIdx) const {
+  std::string bits(numBits, '0');
+  const auto *data = shot(shotIdx);
+  for (std::size_t i = 0; i < numBits; ++i)
+    if ((data[i / 64] >> (i % 64)) & 1)
+      bits[i] = '1';
+  return bits;
+}
+
+std::unordered_map<std::uint64_t, std::size_t> PackedShots::histogram() const {
+  if (numBits > 64)
+    throw std::runtime_error("PackedShots::histogram is only supported for "
+                             "shots of at most 64 bits.");
+  std::unordered_map<std::uint64_t, std::size_t> hist;
+  for (auto w : words)
+    hist[w]++;
+  return hist;
+}
+
+/// @brief Concatenate the bits of each shot in `lhs` with those of the
+/// corresponding shot in `rhs`.
+static PackedShots concatenateShots(const PackedShots &lhs,
+                                    const PackedShots &rhs) {
+  const auto nShots = lhs.size();
+  PackedShots result(lhs.numBits + rhs.numBits);
+  result.words.resize(nShots * result.wordsPerShot(), 0);
+  for (std::size_t s = 0; s < nShots; ++s) {
+    auto *out = result.words.data() + s * result.wordsPerShot();
+    const auto *left = lhs.shot(s);
+    const auto *right = rhs.shot(s);
+    std::copy(left, left + lhs.wordsPerShot(), out);
+    for (std::size_t b = 0; b < rhs.numBits; ++b) {
+      const auto outBit = lhs.numBits + b;
+      if ((right[b / 64] >> (b % 64)) & 1)
+        out[outBit / 64] |= 1ULL << (outBit % 64);
+    }
+  }
+  return result;
+}
+
+/// @brief Encode the first `numBits` characters of `bits` as an integer,
+/// character `i` mapping to bit `i` as in `PackedShots`.
+static std::uint64_t toPacked(const std::string &bits, std::size_t numBits) {
+  std::uint64_t packed = 0;
+  for (std::size_t i = 0; i < numBits; ++i)
+    if (bits[i] == '1')
+      packed |= 1ULL << i;
+  return packed;
+}
+
+/// @brief Gather the bits of `packed` selected by `mask` into the low bits of
+/// the result, in order (i.e., the `pext` instruction of BMI2).
+static std::uint64_t gatherBits(std::uint64_t packed, std::uint64_t mask) {
+#ifdef __BMI2__
+  return _pext_u64(packed, mask);
+#else
+  std::uint64_t result = 0;
+  for (std::uint64_t bit = 1; mask; bit <<= 1) {
+    if (packed & mask & -mask)
+      result |= bit;
+    mask &= mask - 1;
+  }
+  return result;
+#endif
+}
+
+/// @brief Rebuild the counts dictionary from bit-packed shots.
+static CountsDictionary countsFromShots(const PackedShots &shots) {
+  CountsDictionary counts;
+  if (shots.numBits <= 64) {
+    for (auto &[packed, count] : shots.histogram())
+      counts.emplace(PackedShots::toBitString(packed, shots.numBits), count);
+    return counts;
+  }
+  for (std::size_t i = 0; i < shots.size(); ++i)
+    counts[shots.to_string(i)]++;
+  return counts;
+}
+
 ExecutionResult::ExecutionResult(CountsDictionary c) : counts(c) {}
 ExecutionResult::ExecutionResult(std::string name) : registerName(name) {}
 ExecutionResult::ExecutionResult(double e) : expectationValue(e) {}
@@ -69,17 +176,20 @@ ExecutionResult::ExecutionResult(CountsDictionary c, double e)
     : counts(c), expectationValue(e) {}
 ExecutionResult::ExecutionResult(const ExecutionResult &other)
     : counts(other.counts), expectationValue(other.expectationValue),
-      registerName(other.registerName), sequentialData(other.sequentialData) {}
+      registerName(other.registerName), sequentialData(other.sequentialData),
+      packedSequentialData(other.packedSequentialData) {}
 
 ExecutionResult &ExecutionResult::operator=(const ExecutionResult &other) {
   counts = other.counts;
   expectationValue = other.expectationValue;
   registerName = other.registerName;
   sequentialData = other.sequentialData;
+  packedSequentialData = other.packedSequentialData;
   return *this;
 }
 
 void ExecutionResult::appendResult(std::string bitString, std::size_t count) {
+  materializeSequentialData();
   auto [iter, inserted] = counts.emplace(std::move(bitString), count);
   if (!inserted)
     iter->second += count;
@@ -87,6 +197,53 @@ void ExecutionResult::appendResult(std::string bitString, std::size_t count) {
   sequentialData.insert(sequentialData.end(), count, iter->first);
 }
 
+void ExecutionResult::appendPackedResults(PackedShots &&shots) {
+  if (shots.empty())
+    return;
+
+  for (auto &[bits, count] : countsFromShots(shots)) {
+    auto [iter, inserted] = counts.emplace(bits, count);
+    if (!inserted)
+      iter->second += count;
+  }
+
+  if (sequentialData.empty() && packedSequentialData.empty()) {
+    packedSequentialData = std::move(shots);
+  } else if (sequentialData.empty() &&
+             packedSequentialData.numBits == shots.numBits) {
+    packedSequentialData.words.insert(packedSequentialData.words.end(),
+                                      shots.words.begin(), shots.words.end());
+  } else {
+    materializeSequentialData();
+    sequentialData.reserve(sequentialData.size() + shots.size());
+    for (std::size_t i = 0; i < shots.size(); ++i)
+      sequentialData.emplace_back(shots.to_string(i));
+  }
+}
+
+void ExecutionResult::materializeSequentialData() {
+  if (packedSequentialData.empty())
+    return;
+  sequentialData.reserve(sequentialData.size() + packedSequentialData.size());
+  for (std::size_t i = 0; i < packedSequentialData.size(); ++i)
+    sequentialData.emplace_back(packedSequentialData.to_string(i));
+  packedSequentialData.clear();
+}
+
+std::size_t ExecutionResult::getNumSequentialShots() const {
+  return sequentialData.size() + packedSequentialData.size();
+}
+
+std::vector<std::string> ExecutionResult::getSequentialData() const {
+  if (packedSequentialData.empty())
+    return sequentialData;
+  std::vector<std::string> result = sequentialData;
+  result.reserve(result.size() + packedSequentialData.size());
+  for (std::size_t i = 0; i < packedSequentialData.size(); ++i)
+    result.emplace_back(packedSequentialData.to_string(i));
+  return result;
+}
+
 bool ExecutionResult::operator==(const ExecutionResult &result) const {
   return registerName == result.registerName && counts == result.counts;
 }
@@ -198,13 +355,28 @@ void sample_result::append(const ExecutionResult &result, bool concatenate) {
     auto &existingExecResult = iter->second;
     if (concatenate) {
       // Stitch the bitstrings together
-      if (this->totalShots == result.sequentialData.size()) {
-        existingExecResult.counts.clear();
-        for (std::size_t i = 0; i < this->totalShots; i++) {
-          std::string newStr =
-              existingExecResult.sequentialData[i] + result.sequentialData[i];
-          existingExecResult.counts[newStr]++;
-          existingExecResult.sequentialData[i] = std::move(newStr);
+      if (this->totalShots == result.getNumSequentialShots()) {
+        if (existingExecResult.sequentialData.empty() &&
+            result.sequentialData.empty() &&
+            existingExecResult.packedSequentialData.size() ==
+                this->totalShots) {
+          // Both are bit-packed, stitch them without creating bit strings
+          // for every shot.
+          auto stitched = concatenateShots(
+              existingExecResult.packedSequentialData,
+              result.packedSequentialData);
+          existingExecResult.counts = countsFromShots(stitched);
+          existingExecResult.packedSequentialData = std::move(stitched);
+        } else {
+          existingExecResult.materializeSequentialData();
+          const auto newData = result.getSequentialData();
+          existingExecResult.counts.clear();
+          for (std::size_t i = 0; i < this->totalShots; i++) {
+            std::string newStr =
+                existingExecResult.sequentialData[i] + newData[i];
+            existingExecResult.counts[newStr]++;
+            existingExecResult.sequentialData[i] = std::move(newStr);
+          }
         }
       }
     } else {
@@ -226,26 +398,36 @@ bool sample_result::operator==(const sample_result &counts) const {
 sample_result &sample_result::operator+=(const sample_result &other) {
 
   for (auto &otherResults : other.sampleResults) {
-    auto regName = otherResults.first;
+    const auto &regName = otherResults.first;
     auto foundIter = sampleResults.find(regName);
     if (foundIter == sampleResults.end()) {
       sampleResults.insert({regName, otherResults.second});
     } else {
       // We already have a sample result with this name, so now lets just merge
-      // them.
-      auto &sr = sampleResults[regName];
-      for (auto &[bits, count] : otherResults.second.counts) {
-        auto &ourCounts = sr.counts;
-        if (ourCounts.count(bits))
-          ourCounts[bits] += count;
-        else
-          ourCounts.insert({bits, count});
+      // them, with a single lookup per outcome.
+      auto &sr = foundIter->second;
+      auto &ourCounts = sr.counts;
+      ourCounts.reserve(ourCounts.size() + otherResults.second.counts.size());
+      for (auto &[bits, count] : otherResults.second.counts)
+        ourCounts[bits] += count;
+
+      const auto &otherResult = otherResults.second;
+      const auto &otherPacked = otherResult.packedSequentialData;
+      if (sr.sequentialData.empty() && otherResult.sequentialData.empty() &&
+          (sr.packedSequentialData.empty() ||
+           sr.packedSequentialData.numBits == otherPacked.numBits)) {
+        if (!otherPacked.empty()) {
+          sr.packedSequentialData.numBits = otherPacked.numBits;
+          sr.packedSequentialData.words.insert(
+              sr.packedSequentialData.words.end(), otherPacked.words.begin(),
+              otherPacked.words.end());
+        }
+      } else if (otherResult.getNumSequentialShots() > 0) {
+        sr.materializeSequentialData();
+        const auto otherData = otherResult.getSequentialData();
+        sr.sequentialData.insert(sr.sequentialData.end(), otherData.begin(),
+                                 otherData.end());
       }
-
-      if (!otherResults.second.sequentialData.empty())
-        sr.sequentialData.insert(sr.sequentialData.end(),
-                                 otherResults.second.sequentialData.begin(),
-                                 otherResults.second.sequentialData.end());
     }
     if (regName == GlobalRegisterName)
       totalShots += other.totalShots;
@@ -298,6 +480,22 @@ sample_result::sequential_data(const std::string_view registerName) const {
   return retrieve_result(registerName.data()).getSequentialData();
 }
 
+const PackedShots &sample_result::packed_sequential_data(
+    const std::string_view registerName) const {
+  const auto &result = retrieve_result(std::string(registerName));
+  if (!result.sequentialData.empty())
+    throw std::runtime_error("sequential data of register " +
+                             std::string(registerName) +
+                             " is not available in bit-packed form");
+  return result.packedSequentialData;
+}
+
+bool sample_result::has_packed_sequential_data(
+    const std::string_view registerName) const {
+  const auto &result = retrieve_result(std::string(registerName));
+  return result.sequentialData.empty() && !result.packedSequentialData.empty();
+}
+
 CountsDictionary::iterator sample_result::begin() {
   return retrieve_result(GlobalRegisterName).counts.begin();
 }
@@ -404,20 +602,41 @@ sample_result::get_marginal(const std::vector<std::size_t> &marginalIndices,
 
   std::sort(mutableIndices.begin(), mutableIndices.end());
 
+  auto checkIndices = [&](const std::string &bits) {
+    if (!mutableIndices.empty() && mutableIndices.back() >= bits.size())
+      throw std::runtime_error("Invalid marginal index (" +
+                               std::to_string(mutableIndices.back()) +
+                               ", size=" + std::to_string(bits.size()));
+  };
+
   ExecutionResult sr;
-  for (auto &[bits, count] : counts) {
-    std::string newBits;
-    for ([[maybe_unused]] auto &m : mutableIndices)
-      newBits += "0";
-    for (int counter = 0; auto &index : mutableIndices) {
-      if (index > bits.size())
-        throw std::runtime_error("Invalid marginal index (" +
-                                 std::to_string(index) +
-                                 ", size=" + std::to_string(bits.size()));
+  const bool unique = std::adjacent_find(mutableIndices.begin(),
+                                         mutableIndices.end()) ==
+                      mutableIndices.end();
+  if (unique && !mutableIndices.empty() && mutableIndices.back() < 64) {
+    // Gather the marginal bits of every outcome as an integer and only create
+    // the bit strings of the distinct marginal outcomes.
+    std::uint64_t mask = 0;
+    for (auto index : mutableIndices)
+      mask |= 1ULL << index;
+    const auto numBits = mutableIndices.back() + 1;
+    std::unordered_map<std::uint64_t, std::size_t> marginal;
+    for (auto &[bits, count] : counts) {
+      checkIndices(bits);
+      marginal[gatherBits(toPacked(bits, numBits), mask)] += count;
+    }
+    for (auto &[packed, count] : marginal)
+      sr.appendResult(PackedShots::toBitString(packed, mutableIndices.size()),
+                      count);
+    return sample_result(sr);
+  }
 
+  for (auto &[bits, count] : counts) {
+    checkIndices(bits);
+    std::string newBits(mutableIndices.size(), '0');
+    for (int counter = 0; auto &index : mutableIndices)
       newBits[counter++] = bits[index];
-    }
-    sr.appendResult(newBits, count);
+    sr.appendResult(std::move(newBits), count);
   }
 
   return sample_result(sr);
@@ -428,6 +647,15 @@ void sample_result::clear() {
   totalShots = 0;
 }
 
+void sample_result::discard_sequential_data() {
+  for (auto &[name, result] : sampleResults) {
+    result.sequentialData.clear();
+    result.sequentialData.shrink_to_fit();
+    result.packedSequentialData.clear();
+    result.packedSequentialData.words.shrink_to_fit();
+  }
+}
+
 /// @brief This is a helper function to sort the keys of an unordered map
 /// without making any deep copies.
 template <typename T>
@@ -503,6 +731,20 @@ void sample_result::reorder(const std::vector<std::size_t> &idx,
   result.counts = newCounts;
 
   // Now process the sequential data
+  if (!result.packedSequentialData.empty()) {
+    const auto &shots = result.packedSequentialData;
+    if (idx.size() != shots.numBits)
+      throw std::runtime_error("Calling reorder() with invalid parameter idx");
+    PackedShots reordered(shots.numBits);
+    reordered.words.resize(shots.words.size(), 0);
+    for (std::size_t s = 0; s < shots.size(); ++s) {
+      auto *out = reordered.words.data() + s * reordered.wordsPerShot();
+      for (std::size_t i = 0; i < idx.size(); ++i)
+        if (shots.bit(s, idx[i]))
+          out[i / 64] |= 1ULL << (i % 64);
+    }
+    result.packedSequentialData = std::move(reordered);
+  }
   for (auto &s : result.sequentialData) {
     std::string newBits(s);
     int i = 0;
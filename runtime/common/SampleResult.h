@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -20,6 +21,69 @@ using CountsDictionary = std::unordered_map<std::string, std::size_t>;
 
 inline static const std::string GlobalRegisterName = "__global__";
 
+/// The `PackedShots` type stores a sequence of measured bit strings in a
+/// compact, bit-packed form. Each shot occupies `wordsPerShot()` contiguous
+/// 64-bit words, where character `i` of the shot's bit string is stored in bit
+/// `i % 64` of word `i / 64`.
+struct PackedShots {
+  /// Number of bits per shot
+  std::size_t numBits = 0;
+
+  /// Shot-major packed words
+  std::vector<std::uint64_t> words;
+
+  PackedShots() = default;
+  explicit PackedShots(std::size_t nBits) : numBits(nBits) {}
+  PackedShots(std::size_t nBits, std::vector<std::uint64_t> &&data)
+      : numBits(nBits), words(std::move(data)) {}
+
+  /// @brief Return the number of 64-bit words used by a single shot.
+  std::size_t wordsPerShot() const { return (numBits + 63) / 64; }
+
+  /// @brief Return the number of shots stored.
+  std::size_t size() const {
+    return numBits == 0 ? 0 : words.size() / wordsPerShot();
+  }
+
+  /// @brief Return true if no shots are stored.
+  bool empty() const { return words.empty(); }
+
+  /// @brief Return a pointer to the packed words of the given shot.
+  const std::uint64_t *shot(std::size_t shotIdx) const {
+    return words.data() + shotIdx * wordsPerShot();
+  }
+
+  /// @brief Return the value of bit `bitIdx` of the given shot.
+  bool bit(std::size_t shotIdx, std::size_t bitIdx) const {
+    return (shot(shotIdx)[bitIdx / 64] >> (bitIdx % 64)) & 1;
+  }
+
+  /// @brief Append a shot given by its packed words.
+  void append(const std::uint64_t *shotWords) {
+    words.insert(words.end(), shotWords, shotWords + wordsPerShot());
+  }
+
+  /// @brief Return the bit string of the given shot.
+  std::string to_string(std::size_t shotIdx) const;
+
+  /// @brief Return the integer-keyed histogram of the stored shots. Only
+  /// valid for shots of at most 64 bits.
+  std::unordered_map<std::uint64_t, std::size_t> histogram() const;
+
+  /// @brief Convert a single-word packed value of `numBits` bits to its bit
+  /// string.
+  static std::string toBitString(std::uint64_t packed, std::size_t numBits);
+
+  /// @brief Pack the given bit strings, all of the same length.
+  static PackedShots fromBitStrings(const std::vector<std::string> &shots);
+
+  /// @brief Clear all data.
+  void clear() {
+    numBits = 0;
+    words.clear();
+  }
+};
+
 /// The `ExecutionResult` models the result of a typical
 /// quantum state sampling task. It will contain the
 /// observed measurement bit strings and corresponding number
@@ -38,6 +102,12 @@ struct ExecutionResult {
   /// @brief Sequential bit strings observed (not collated into a map)
   std::vector<std::string> sequentialData;
 
+  /// @brief Sequential bit strings observed, in bit-packed form. Simulators may
+  /// fill this (via `appendPackedResults`) instead of `sequentialData`, in
+  /// which case the bit strings are only created when requested. At most one
+  /// of `sequentialData` and `packedSequentialData` holds data.
+  PackedShots packedSequentialData;
+
   /// @brief Serialize this sample result to a vector of integers.
   /// Encoding: 1st element is size of the register name N, then next N
   /// represent register name, next is the number of bitstrings M,
@@ -80,11 +150,17 @@ struct ExecutionResult {
   /// @param other
   ExecutionResult(const ExecutionResult &other);
 
+  /// @brief Move constructor
+  ExecutionResult(ExecutionResult &&other) = default;
+
   /// @brief Set this ExecutionResult equal to the provided one
   /// @param other
   /// @return
   ExecutionResult &operator=(const ExecutionResult &other);
 
+  /// @brief Move assignment
+  ExecutionResult &operator=(ExecutionResult &&other) = default;
+
   /// @brief Return true if the given `ExecutionResult` is the same as this one.
   /// @param result
   /// @return
@@ -95,7 +171,22 @@ struct ExecutionResult {
   /// @param count
   void appendResult(std::string bitString, std::size_t count);
 
-  std::vector<std::string> getSequentialData() const { return sequentialData; }
+  /// @brief Append the given bit-packed shots to this `ExecutionResult`. The
+  /// counts are updated from the integer-keyed histogram of the shots, so that
+  /// bit strings are created once per distinct outcome, while the sequential
+  /// data is retained in packed form.
+  /// @param shots
+  void appendPackedResults(PackedShots &&shots);
+
+  /// @brief Convert any bit-packed sequential data into `sequentialData`.
+  void materializeSequentialData();
+
+  /// @brief Return the number of sequential shots stored.
+  std::size_t getNumSequentialShots() const;
+
+  /// @brief Return the sequential bit strings, materializing them from the
+  /// packed representation if needed.
+  std::vector<std::string> getSequentialData() const;
 };
 
 /// @brief The sample_result abstraction wraps a set of `ExecutionResult`s for
@@ -213,6 +304,17 @@ public:
   std::vector<std::string> sequential_data(
       const std::string_view registerName = GlobalRegisterName) const;
 
+  /// @brief Return the sequential data of the given register in bit-packed
+  /// form, without copying it. Throws if the data of this register has been
+  /// stored as bit strings.
+  const PackedShots &packed_sequential_data(
+      const std::string_view registerName = GlobalRegisterName) const;
+
+  /// @brief Return true if the sequential data of the given register is
+  /// stored in bit-packed form.
+  bool has_packed_sequential_data(
+      const std::string_view registerName = GlobalRegisterName) const;
+
   /// @brief Return the number of observed bit strings
   /// @return
   std::size_t
@@ -227,6 +329,9 @@ public:
   /// @brief Clear this sample_result.
   void clear();
 
+  /// @brief Drop the sequential data of all registers, keeping the counts.
+  void discard_sequential_data();
+
   /// @brief Extract the ExecutionResults as a std::unordered<string, size_t>
   /// map.
   /// @param registerName
@@ -15,7 +15,9 @@
 #include "SampleResult.h"
 #include "common/RecordLogParser.h"
 #include "nlohmann/json.hpp"
+#include <chrono>
 #include <filesystem>
+#include <optional>
 
 namespace cudaq {
 
@@ -35,6 +37,9 @@ struct KernelExecution {
   KernelExecution(std::string &n, std::string &c, nlohmann::json &o,
                   std::vector<std::size_t> &m)
       : name(n), code(c), output_names(o), mapping_reorder_idx(m) {}
+  KernelExecution(std::string &n, std::string &&c, nlohmann::json &o,
+                  std::vector<std::size_t> &m)
+      : name(n), code(std::move(c)), output_names(o), mapping_reorder_idx(m) {}
   KernelExecution(std::string &n, std::string &c, nlohmann::json &o,
                   std::vector<std::size_t> &m, nlohmann::json &ud)
       : name(n), code(c), output_names(o), mapping_reorder_idx(m),
@@ -64,6 +69,16 @@ struct ResultInfoType {
 /// @brief Results information, indexed by 0-based result number
 using OutputNamesType = std::map<std::size_t, ResultInfoType>;
 
+/// @brief Hints on the progress of a remote job, as reported by its server.
+/// They let the result polling wait longer while the job is far from done,
+/// and poll again promptly when it is about to finish.
+struct JobProgress {
+  /// The number of jobs ahead of this one in the queue, 0 once it runs.
+  std::optional<std::size_t> queuePosition;
+  /// The estimated time until the job is done.
+  std::optional<std::chrono::microseconds> estimatedTimeLeft;
+};
+
 /// @brief The ServerHelper is a Plugin type that abstracts away the
 /// server-specific information needed for submitting quantum jobs
 /// to a remote server. It enables clients to create server-specific job
@@ -137,9 +152,43 @@ public:
     return std::chrono::microseconds(100);
   }
 
+  /// @brief Return the progress hints found in a job status response. By
+  /// default, none: the polling interval then grows geometrically from the
+  /// `nextResultPollingInterval`.
+  virtual JobProgress getJobProgress(ServerMessage &getJobResponse) {
+    return {};
+  }
+
+  /// @brief Get the path of a job status request that the server holds until
+  /// the job is done, or until a server-side timeout (long polling), or an
+  /// empty string if the server has no such endpoint (the default). The
+  /// response must be the same as for `constructGetJobPath`. Such requests
+  /// are pushed back to the client as soon as the job is done, and are
+  /// repeated after `nextResultPollingInterval` if it is not.
+  virtual std::string constructWaitForJobPath(std::string &jobId) {
+    return "";
+  }
+
   /// @brief Return true if the job is done.
   virtual bool jobIsDone(ServerMessage &getJobResponse) = 0;
 
+  /// @brief Get the path required to retrieve the status of several jobs
+  /// with a single request, or an empty string if the server has no such
+  /// endpoint (the default), in which case the jobs are polled one by one.
+  virtual std::string
+  constructGetJobsPath(const std::vector<std::string> &jobIds) {
+    return "";
+  }
+
+  /// @brief Split the response to a `constructGetJobsPath` request into the
+  /// `constructGetJobPath` response of each job, in the order of `jobIds`.
+  virtual std::vector<ServerMessage>
+  splitGetJobsResponse(ServerMessage &getJobsResponse,
+                       const std::vector<std::string> &jobIds) {
+    throw std::runtime_error(name() +
+                             " does not support batched job retrieval.");
+  }
+
   /// @brief Given a successful job and the success response,
   /// retrieve the results and map them to a sample_result.
   /// @param postJobResponse
@@ -148,6 +197,36 @@ public:
   virtual cudaq::sample_result processResults(ServerMessage &postJobResponse,
                                               std::string &jobId) = 0;
 
+  /// @brief Return the maximum number of circuits the server accepts in a
+  /// single job. By default, 1: each circuit is submitted as its own job.
+  /// Helpers returning more must implement `createBatchJob` and
+  /// `processBatchResults`.
+  virtual std::size_t getMaxCircuitsPerJob() { return 1; }
+
+  /// @brief Create the payload of a single job executing all the
+  /// `circuitCodes`, at most `getMaxCircuitsPerJob()` of them. The payload
+  /// holds one job message.
+  virtual ServerJobPayload
+  createBatchJob(std::vector<KernelExecution> &circuitCodes) {
+    throw std::runtime_error(name() + " does not support batched jobs.");
+  }
+
+  /// @brief Given a successful batched job and the success response, return
+  /// the results of each of its circuits, in submission order. The output
+  /// names and reordering indices of circuit `i` are indexed by
+  /// `getBatchCircuitKey(jobId, i)`.
+  virtual std::vector<cudaq::sample_result>
+  processBatchResults(ServerMessage &getJobResponse, std::string &jobId) {
+    throw std::runtime_error(name() + " does not support batched jobs.");
+  }
+
+  /// @brief Return the key of circuit `index` of the batched job `jobId` in
+  /// `outputNames` and `reorderIdx`.
+  static std::string getBatchCircuitKey(const std::string &jobId,
+                                        std::size_t index) {
+    return jobId + "/" + std::to_string(index);
+  }
+
   /// @brief Adjust the compiler pass pipeline (if desired)
   virtual void updatePassPipeline(const std::filesystem::path &platformPath,
                                   std::string &passPipeline) {}
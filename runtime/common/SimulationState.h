@@ -14,6 +14,8 @@
 #include <complex>
 #include <memory>
 #include <optional>
+#include <stdexcept>
+#include <string>
 #include <variant>
 #include <vector>
 
@@ -27,6 +29,16 @@ enum class InitialState { ZERO, UNIFORM };
 // Note: tensor data is expected in column-major.
 using TensorStateData =
     std::vector<std::pair<const void *, std::vector<std::size_t>>>;
+
+/// @brief Sparse state vector data: the nonzero amplitudes of a state of
+/// `num_qubits` qubits, indexed by basis state. Each basis state is listed at
+/// most once, and amplitudes not listed are zero.
+/// Simulators initialize their state from it without a dense intermediate on
+/// the host.
+struct sparse_state_data {
+  std::size_t num_qubits = 0;
+  std::vector<std::pair<std::size_t, std::complex<double>>> amplitudes;
+};
 /// @brief state_data is a variant type
 /// encoding different forms of user state vector data
 /// we support.
@@ -34,7 +46,8 @@ using state_data = std::variant<std::vector<std::complex<double>>,
                                 std::vector<std::complex<float>>,
                                 std::pair<std::complex<double> *, std::size_t>,
                                 std::pair<std::complex<float> *, std::size_t>,
-                                complex_matrix, TensorStateData>;
+                                complex_matrix, TensorStateData,
+                                sparse_state_data>;
 
 /// @brief The `SimulationState` interface provides and extension point
 /// for concrete circuit simulation sub-types to describe their
@@ -95,6 +108,52 @@ protected:
   virtual std::unique_ptr<SimulationState>
   createFromSizeAndPtr(std::size_t, void *, std::size_t dataType) = 0;
 
+  /// @brief Throw if a basis state of `data` is out of range or repeated, and
+  /// return the dimension of the state.
+  static std::size_t validateSparseData(const sparse_state_data &data) {
+    if (data.num_qubits >= 64)
+      throw std::runtime_error("[sim-state] too many qubits for sparse state "
+                               "data (" +
+                               std::to_string(data.num_qubits) + ").");
+    const std::size_t dim = 1ULL << data.num_qubits;
+    std::vector<std::size_t> indices;
+    indices.reserve(data.amplitudes.size());
+    for (const auto &[index, amplitude] : data.amplitudes) {
+      if (index >= dim)
+        throw std::runtime_error("[sim-state] sparse state data index " +
+                                 std::to_string(index) + " out of range for " +
+                                 std::to_string(data.num_qubits) + " qubits.");
+      indices.push_back(index);
+    }
+    std::sort(indices.begin(), indices.end());
+    if (std::adjacent_find(indices.begin(), indices.end()) != indices.end())
+      throw std::runtime_error(
+          "[sim-state] repeated index in sparse state data.");
+    return dim;
+  }
+
+  /// @brief Subclass-specific creator method for new SimulationState instances
+  /// from sparse data. By default, the data is expanded into a dense vector
+  /// of the precision of the state; simulators override this to write the
+  /// nonzero amplitudes into their own storage directly.
+  virtual std::unique_ptr<SimulationState>
+  createFromSparseData(const sparse_state_data &data) {
+    const std::size_t dim = validateSparseData(data);
+    const auto expand = [&]<typename T>(std::vector<std::complex<T>> vec) {
+      vec.resize(dim);
+      for (const auto &[index, amplitude] : data.amplitudes)
+        vec[index] = amplitude;
+      return vec;
+    };
+    // The expanded data is owned by the new state, as for a vector.
+    if (getPrecision() == precision::fp32) {
+      auto vec = expand(std::vector<std::complex<float>>{});
+      return createFromSizeAndPtr(dim, vec.data(), 1);
+    }
+    auto vec = expand(std::vector<std::complex<double>>{});
+    return createFromSizeAndPtr(dim, vec.data(), 0);
+  }
+
 public:
   /// @brief Runtime-known precision for the simulation data
   enum class precision { fp32, fp64 };
@@ -123,6 +182,8 @@ public:
   /// from the user provided data set.
   virtual std::unique_ptr<cudaq::SimulationState>
   createFromData(const state_data &data) {
+    if (const auto *sparse = std::get_if<sparse_state_data>(&data))
+      return createFromSparseData(*sparse);
     if (std::holds_alternative<TensorStateData>(data)) {
       if (isArrayLike())
         throw std::runtime_error(
@@ -176,6 +237,23 @@ public:
   /// the provided `other` state, e.g. `|<this | other>|`.
   virtual std::complex<double> overlap(const SimulationState &other) = 0;
 
+  /// @brief Compute the overlap of each of the `bras` with each of the `kets`,
+  /// as `overlap` does, and return them as a row-major `bras.size()` x
+  /// `kets.size()` matrix. This is called on any one of the states. The
+  /// overlaps are computed pair by pair by default; simulation states
+  /// override this to compute them all at once, e.g., with a single matrix
+  /// product.
+  virtual std::vector<std::complex<double>>
+  overlapMatrix(const std::vector<SimulationState *> &bras,
+                const std::vector<SimulationState *> &kets) {
+    std::vector<std::complex<double>> overlaps;
+    overlaps.reserve(bras.size() * kets.size());
+    for (auto *bra : bras)
+      for (auto *ket : kets)
+        overlaps.push_back(bra->overlap(*ket));
+    return overlaps;
+  }
+
   /// @brief Return the amplitude of the given computational
   /// basis state.
   virtual std::complex<double>
@@ -226,6 +304,10 @@ public:
   /// @brief Return true if this `SimulationState` wraps data on the GPU.
   virtual bool isDeviceData() const { return false; }
 
+  /// @brief Return the CUDA device holding the data of this state. Only
+  /// meaningful if `isDeviceData()` is true.
+  virtual int getDeviceId() const { return 0; }
+
   /// @brief Return true if this `SimulationState` wraps contiguous memory
   /// (array-like).
   //  If true, `operator()` can be used to index elements in a multi-dimensional
@@ -251,6 +333,27 @@ public:
         "SimulationState::toHost complex64 not implemented.");
   }
 
+  /// @brief Transfer the `numElements` elements from `offset`, in the order
+  /// of `toHost`, from device to host, so that a slice of a large state is
+  /// read without transferring the rest of it.
+  virtual void toHostRange(std::complex<double> *clientAllocatedData,
+                           std::size_t offset, std::size_t numElements) const {
+    if (offset == 0 && numElements == getNumElements())
+      return toHost(clientAllocatedData, numElements);
+    throw std::runtime_error(
+        "SimulationState::toHostRange complex128 not implemented.");
+  }
+
+  /// @brief Transfer the `numElements` elements from `offset`, in the order
+  /// of `toHost`, from device to host.
+  virtual void toHostRange(std::complex<float> *clientAllocatedData,
+                           std::size_t offset, std::size_t numElements) const {
+    if (offset == 0 && numElements == getNumElements())
+      return toHost(clientAllocatedData, numElements);
+    throw std::runtime_error(
+        "SimulationState::toHostRange complex64 not implemented.");
+  }
+
   /// @brief Destructor
   virtual ~SimulationState() {}
 };
@@ -11,4 +11,6 @@
 #include "algorithms/get_state.h"
 #include "algorithms/observe.h"
 #include "algorithms/optimizer.h"
+#include "algorithms/pool_gradients.h"
+#include "algorithms/readout_mitigation.h"
 #include "algorithms/vqe.h"
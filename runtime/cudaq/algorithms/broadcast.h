@@ -10,6 +10,9 @@
 
 #include "cudaq/host_config.h"
 #include "cudaq/platform.h"
+#include <atomic>
+#include <exception>
+#include <optional>
 
 namespace cudaq {
 
@@ -31,23 +34,62 @@ auto make_argset(const std::vector<Args> &...args) {
 }
 
 namespace details {
+/// @brief The type of the functions broadcast over argument sets. They take,
+/// in order, the QPU id, the index of the execution on that QPU, the number
+/// of executions on that QPU, and the arguments of the execution. Since QPUs
+/// claim executions dynamically, the number of executions is only a lower
+/// bound, which is exact for the last execution on the QPU.
 template <typename ReturnType, typename... Args>
 using BroadcastFunctorType = const std::function<ReturnType(
     std::size_t, std::size_t, std::size_t, Args &...)>;
 
+/// @brief A TaskPool hands out the indices of a set of tasks to the QPUs
+/// executing them, in batches claimed on demand rather than in equal ranges
+/// fixed up front. A QPU that runs out of work claims more, so that neither
+/// slower QPUs nor more expensive tasks set the overall run time. Each batch
+/// is a `1 / (2 * numQpus)` share of the remaining tasks (guided scheduling),
+/// so that batches are large while the pool is full, and single tasks
+/// balance the tail.
+class TaskPool {
+public:
+  TaskPool(std::size_t numTasks, std::size_t numQpus)
+      : numTasks(numTasks), numQpus(std::max<std::size_t>(numQpus, 1)) {}
+
+  /// @brief Claim the next batch of tasks, as a `[begin, end)` range. The
+  /// range is empty once all tasks are claimed, or the pool is cancelled.
+  std::pair<std::size_t, std::size_t> claim() {
+    std::size_t begin = next.load(std::memory_order_relaxed);
+    while (begin < numTasks) {
+      const std::size_t batch =
+          std::max<std::size_t>(1, (numTasks - begin) / (2 * numQpus));
+      if (next.compare_exchange_weak(begin, begin + batch))
+        return {begin, begin + batch};
+    }
+    return {numTasks, numTasks};
+  }
+
+  /// @brief Stop handing out tasks, e.g., once a task has failed.
+  void cancel() { next.store(numTasks); }
+
+private:
+  const std::size_t numTasks;
+  const std::size_t numQpus;
+  std::atomic<std::size_t> next = 0;
+};
+
 /// @brief Given the input BroadcastFunctorType, apply it to all argument sets
 /// in the provided ArgumentSet `params`. Distribute the work over the provided
-/// number of QPUs.
+/// number of QPUs, which claim argument sets from a shared TaskPool as they
+/// become idle. If `executionIndices` is given, it is set to the indices of
+/// the argument sets executed by each QPU, in execution order.
 template <typename ResType, typename... Args>
-std::vector<ResType>
-broadcastFunctionOverArguments(std::size_t numQpus, quantum_platform &platform,
-                               BroadcastFunctorType<ResType, Args...> &apply,
-                               ArgumentSet<Args...> &params) {
-  using FutureCollection = std::vector<std::future<std::vector<ResType>>>;
-
+std::vector<ResType> broadcastFunctionOverArguments(
+    std::size_t numQpus, quantum_platform &platform,
+    BroadcastFunctorType<ResType, Args...> &apply,
+    ArgumentSet<Args...> &params,
+    std::vector<std::vector<std::size_t>> *executionIndices = nullptr) {
   // Assert all arg vectors are the same size
   auto N = std::get<0>(params).size();
-  auto nExecsPerQpu = N / numQpus + (N % numQpus != 0);
 
   // Validate the input deck
   cudaq::tuple_for_each(params, [&](auto &&element) {
@@ -59,24 +101,30 @@ broadcastFunctionOverArguments(std::size_t numQpus, quantum_platform &platform,
   // Fetch the thread-specific seed outside the functor and then pass it inside.
   std::size_t seed = cudaq::get_random_seed();
 
-  FutureCollection futures;
+  TaskPool pool(N, numQpus);
+  std::vector<std::optional<ResType>> results(N);
+  if (executionIndices)
+    executionIndices->assign(numQpus, {});
+  std::vector<std::future<void>> futures;
   for (std::size_t qpuId = 0; qpuId < numQpus; qpuId++) {
-    std::promise<std::vector<ResType>> _promise;
+    std::promise<void> _promise;
     futures.emplace_back(_promise.get_future());
-    std::function<void()> functor = detail::make_copyable_function(
-        [&params, &apply, qpuId, nExecsPerQpu, seed,
-         promise = std::move(_promise)]() mutable {
-          // Compute the lower and upper bounds of the
-          // argument set that should be computed on the current QPU
-          auto lowerBound = qpuId * nExecsPerQpu;
-          auto upperBound = lowerBound + nExecsPerQpu;
-
-          // Store the results
-          std::vector<ResType> results;
-
-          // Loop over all sets of arguments, the ith element of each vector
-          // in the ArgumentSet tuple
-          for (std::size_t i = lowerBound, counter = 0; i < upperBound; i++) {
+    QuantumTask functor = [&params, &apply, &pool, &results, executionIndices,
+                           qpuId, seed,
+                           promise = std::move(_promise)]() mutable {
+      try {
+        std::size_t counter = 0;
+        auto batch = pool.claim();
+        while (batch.first < batch.second) {
+          const auto [lowerBound, upperBound] = batch;
+          for (std::size_t i = lowerBound; i < upperBound; i++) {
+            // Claim the next batch before running the last argument set
+            // of this one, to know whether it is the last on this QPU.
+            if (i + 1 == upperBound)
+              batch = pool.claim();
+            const bool isLast =
+                i + 1 == upperBound && batch.first == batch.second;
+
             // Construct the current set of arguments as a new tuple
             // We want a tuple so we can use std::apply with the
             // existing sample()/observe() functions.
@@ -84,12 +132,14 @@ broadcastFunctionOverArguments(std::size_t numQpus, quantum_platform &platform,
                 currentArgs;
 
             // Fill the argument tuple with the QPU id, current argument
-            // iteration, and the total number of arguments that will be applied
+            // iteration, and the number of arguments that will be applied
             // on this QPU.
             std::get<0>(currentArgs) = qpuId;
             std::get<1>(currentArgs) = counter;
-            std::get<2>(currentArgs) = nExecsPerQpu;
+            std::get<2>(currentArgs) = counter + (isLast ? 1 : 2);
             counter++;
+            if (executionIndices)
+              (*executionIndices)[qpuId].push_back(i);
 
             // If seed is 0, then it has not been set.
             if (seed > 0)
@@ -97,31 +147,44 @@ broadcastFunctionOverArguments(std::size_t numQpus, quantum_platform &platform,
 
             // Fill the argument tuple with the actual arguments.
             cudaq::tuple_for_each_with_idx(
-                params, [&]<typename IDX_TYPE>(auto &&element, IDX_TYPE &&idx) {
+                params,
+                [&]<typename IDX_TYPE>(auto &&element, IDX_TYPE &&idx) {
                   std::get<IDX_TYPE::value + 3>(currentArgs) = element[i];
                 });
 
             // Call observe/sample with the current set of arguments
-            // (provided as a tuple)
-            auto result = std::apply(apply, currentArgs);
-
-            // Store the result.
-            results.push_back(result);
+            // (provided as a tuple), and store the result.
+            results[i].emplace(std::apply(apply, currentArgs));
           }
-
-          // Set the promised results.
-          promise.set_value(results);
-        });
+        }
+        promise.set_value();
+      } catch (...) {
+        pool.cancel();
+        promise.set_exception(std::current_exception());
+      }
+    };
 
     platform.enqueueAsyncTask(qpuId, functor);
   }
 
-  // Get all the async-generated results and return.
-  std::vector<ResType> allResults;
+  // Wait for all QPUs, which reference the pool and the results, before
+  // reporting the first failure.
+  std::exception_ptr error;
   for (auto &f : futures) {
-    auto res = f.get();
-    allResults.insert(allResults.end(), res.begin(), res.end());
+    try {
+      f.get();
+    } catch (...) {
+      if (!error)
+        error = std::current_exception();
+    }
   }
+  if (error)
+    std::rethrow_exception(error);
+
+  std::vector<ResType> allResults;
+  allResults.reserve(N);
+  for (auto &result : results)
+    allResults.push_back(std::move(*result));
 
   return allResults;
 }
@@ -12,6 +12,8 @@
 #include "cudaq/algorithms/draw.h"
 #include "common/FmtCore.h"
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -678,3 +680,34 @@ std::string cudaq::__internal__::draw(const Trace &trace) {
   const auto layers = layers_from_trace(trace);
   return string_diagram_from_trace(trace, layers);
 }
+
+namespace {
+/// The number of cached traces beyond which the cache is cleared.
+constexpr std::size_t maxCachedTraces = 64;
+std::mutex traceCacheMutex;
+std::map<std::pair<std::string, std::size_t>, Trace> traceCache;
+} // namespace
+
+std::optional<Trace>
+cudaq::__internal__::getCachedTrace(const std::string &kernelName,
+                                    std::size_t argsHash) {
+  std::scoped_lock<std::mutex> lock(traceCacheMutex);
+  auto iter = traceCache.find({kernelName, argsHash});
+  if (iter == traceCache.end())
+    return std::nullopt;
+  return iter->second;
+}
+
+void cudaq::__internal__::cacheTrace(const std::string &kernelName,
+                                     std::size_t argsHash,
+                                     const Trace &trace) {
+  std::scoped_lock<std::mutex> lock(traceCacheMutex);
+  if (traceCache.size() >= maxCachedTraces)
+    traceCache.clear();
+  traceCache.insert_or_assign({kernelName, argsHash}, trace);
+}
+
+void cudaq::__internal__::clearTraceCache() {
+  std::scoped_lock<std::mutex> lock(traceCacheMutex);
+  traceCache.clear();
+}
@@ -12,6 +12,10 @@
 #include "cudaq/platform.h"
 #include <concepts>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
 
 namespace cudaq {
 
@@ -21,6 +25,45 @@ std::string draw(const Trace &trace);
 
 std::string getLaTeXString(const Trace &trace);
 
+/// @brief Return the trace cached for the kernel `kernelName` and the
+/// arguments hashing to `argsHash`, if any.
+std::optional<Trace> getCachedTrace(const std::string &kernelName,
+                                    std::size_t argsHash);
+
+/// @brief Cache `trace` as the trace of the kernel `kernelName` for the
+/// arguments hashing to `argsHash`.
+void cacheTrace(const std::string &kernelName, std::size_t argsHash,
+                const Trace &trace);
+
+/// @brief Discard the cached traces.
+void clearTraceCache();
+
+/// @brief Combine the hash of `arg` into `seed`. Return false if `arg` is not
+/// of a hashable type, i.e., an arithmetic type, a string, or a range of
+/// hashable elements.
+template <typename T>
+bool hashTraceArgument(std::size_t &seed, const T &arg) {
+  using ArgType = std::remove_cvref_t<T>;
+  if constexpr (std::is_arithmetic_v<ArgType> ||
+                std::is_same_v<ArgType, std::string>) {
+    seed ^= std::hash<ArgType>{}(arg) + 0x9e3779b97f4a7c15ULL + (seed << 6) +
+            (seed >> 2);
+    return true;
+  } else if constexpr (requires {
+                       arg.begin();
+                       arg.end();
+                       arg.size();
+                     }) {
+    seed ^= arg.size();
+    for (const auto &element : arg)
+      if (!hashTraceArgument(seed, element))
+        return false;
+    return true;
+  } else {
+    return false;
+  }
+}
+
 } // namespace __internal__
 
 namespace contrib {
@@ -40,6 +83,20 @@ cudaq::Trace traceFromKernel(KernelFunctor &&kernel, Args &&...args) {
     return Trace();
   }
 
+  // The trace of a stateless kernel only depends on its arguments, it is
+  // cached when they can be hashed.
+  constexpr bool statelessKernel =
+      std::is_empty_v<std::remove_cvref_t<KernelFunctor>>;
+  std::size_t argsHash = 0;
+  bool cacheable = false;
+  if constexpr (statelessKernel) {
+    cacheable = (__internal__::hashTraceArgument(argsHash, args) && ...);
+    if (cacheable)
+      if (auto cached = __internal__::getCachedTrace(
+              typeid(KernelFunctor).name(), argsHash))
+        return *std::move(cached);
+  }
+
   // Create an execution context, indicate this is for tracing the execution
   // path
   ExecutionContext context("tracer");
@@ -49,6 +106,9 @@ cudaq::Trace traceFromKernel(KernelFunctor &&kernel, Args &&...args) {
   kernel(args...);
   platform.reset_exec_ctx();
 
+  if (cacheable)
+    __internal__::cacheTrace(typeid(KernelFunctor).name(), argsHash,
+                             context.kernelTrace);
   return context.kernelTrace;
 }
 
@@ -77,6 +77,13 @@ convertOps(const std::initializer_list<OpTy> &ops) {
 //===----------------------------------------------------------------------===//
 // Single evolution API
 // This API is used to evolve a single Hamiltonian with a single initial state.
+// The results of every step of the schedule are also passed to the optional
+// `sink` as they are produced, independently of `store_intermediate_results`.
+// If `shots_count` is provided for an open system whose initial state is a
+// state vector, the master equation is unravelled into `shots_count` quantum
+// trajectories, evolved as a batch of state vectors. The expectation values are
+// averaged over the trajectories and the states are the batches of normalized
+// trajectories.
 //===----------------------------------------------------------------------===//
 
 template <operator_type HamTy,
@@ -90,13 +97,15 @@ evolve(const HamTy &hamiltonian, const cudaq::dimension_map &dimensions,
        std::initializer_list<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> shots_count = std::nullopt) {
+       std::optional<int> shots_count = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveSingle(
       cudaq::__internal__::convertOp(hamiltonian), dimensions, schedule,
       initial_state, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
-      cudaq::__internal__::convertOps(observables), store_intermediate_results);
+      cudaq::__internal__::convertOps(observables), store_intermediate_results,
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -115,13 +124,15 @@ evolve(const HamTy &hamiltonian, const cudaq::dimension_map &dimensions,
        std::initializer_list<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> shots_count = std::nullopt) {
+       std::optional<int> shots_count = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveSingle(
       cudaq::__internal__::convertOp(hamiltonian), dimensions, schedule,
       initial_state, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
-      cudaq::__internal__::convertOps(observables), store_intermediate_results);
+      cudaq::__internal__::convertOps(observables), store_intermediate_results,
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -139,13 +150,15 @@ evolve_result evolve(const HamTy &hamiltonian,
                      const std::vector<ObserveOpTy> &observables = {},
                      IntermediateResultSave store_intermediate_results =
                          IntermediateResultSave::None,
-                     std::optional<int> shots_count = std::nullopt) {
+                     std::optional<int> shots_count = std::nullopt,
+                     const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveSingle(
       cudaq::__internal__::convertOp(hamiltonian), dimensions, schedule,
       initial_state, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
-      cudaq::__internal__::convertOps(observables), store_intermediate_results);
+      cudaq::__internal__::convertOps(observables), store_intermediate_results,
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -163,13 +176,15 @@ evolve_result evolve(const HamTy &hamiltonian,
                      const std::vector<ObserveOpTy> &observables = {},
                      IntermediateResultSave store_intermediate_results =
                          IntermediateResultSave::None,
-                     std::optional<int> shots_count = std::nullopt) {
+                     std::optional<int> shots_count = std::nullopt,
+                     const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveSingle(
       cudaq::__internal__::convertOp(hamiltonian), dimensions, schedule,
       initial_state, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
-      cudaq::__internal__::convertOps(observables), store_intermediate_results);
+      cudaq::__internal__::convertOps(observables), store_intermediate_results,
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -190,11 +205,13 @@ evolve_result evolve(const super_op &super_op,
                      const std::initializer_list<ObserveOpTy> &observables = {},
                      IntermediateResultSave store_intermediate_results =
                          IntermediateResultSave::None,
-                     std::optional<int> shots_count = std::nullopt) {
+                     std::optional<int> shots_count = std::nullopt,
+                     const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveSingle(
       super_op, dimensions, schedule, initial_state, integrator,
-      cudaq::__internal__::convertOps(observables), store_intermediate_results);
+      cudaq::__internal__::convertOps(observables), store_intermediate_results,
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -210,11 +227,13 @@ evolve_result evolve(const super_op &super_op,
                      const std::initializer_list<ObserveOpTy> &observables = {},
                      IntermediateResultSave store_intermediate_results =
                          IntermediateResultSave::None,
-                     std::optional<int> shots_count = std::nullopt) {
+                     std::optional<int> shots_count = std::nullopt,
+                     const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveSingle(
       super_op, dimensions, schedule, initial_state, integrator,
-      cudaq::__internal__::convertOps(observables), store_intermediate_results);
+      cudaq::__internal__::convertOps(observables), store_intermediate_results,
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -230,11 +249,13 @@ evolve_result evolve(const super_op &super_op,
                      const std::vector<ObserveOpTy> &observables = {},
                      IntermediateResultSave store_intermediate_results =
                          IntermediateResultSave::None,
-                     std::optional<int> shots_count = std::nullopt) {
+                     std::optional<int> shots_count = std::nullopt,
+                     const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveSingle(
       super_op, dimensions, schedule, initial_state, integrator,
-      cudaq::__internal__::convertOps(observables), store_intermediate_results);
+      cudaq::__internal__::convertOps(observables), store_intermediate_results,
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -250,11 +271,13 @@ evolve_result evolve(const super_op &super_op,
                      const std::vector<ObserveOpTy> &observables = {},
                      IntermediateResultSave store_intermediate_results =
                          IntermediateResultSave::None,
-                     std::optional<int> shots_count = std::nullopt) {
+                     std::optional<int> shots_count = std::nullopt,
+                     const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveSingle(
       super_op, dimensions, schedule, initial_state, integrator,
-      cudaq::__internal__::convertOps(observables), store_intermediate_results);
+      cudaq::__internal__::convertOps(observables), store_intermediate_results,
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -281,14 +304,15 @@ evolve(const HamTy &hamiltonian, const cudaq::dimension_map &dimensions,
        std::initializer_list<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> shots_count = std::nullopt) {
+       std::optional<int> shots_count = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveBatched(
       cudaq::__internal__::convertOp(hamiltonian), dimensions, schedule,
       initial_states, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      shots_count);
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -307,14 +331,15 @@ evolve(const HamTy &hamiltonian, const cudaq::dimension_map &dimensions,
        const std::vector<ObserveOpTy> &observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> shots_count = std::nullopt) {
+       std::optional<int> shots_count = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveBatched(
       cudaq::__internal__::convertOp(hamiltonian), dimensions, schedule,
       initial_states, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      shots_count);
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -338,7 +363,8 @@ evolve(const std::initializer_list<HamTy> &hamiltonians,
        std::initializer_list<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> batch_size = std::nullopt) {
+       std::optional<int> batch_size = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   if (batch_size.has_value() && batch_size.value() < 1)
     throw std::invalid_argument(
@@ -349,7 +375,7 @@ evolve(const std::initializer_list<HamTy> &hamiltonians,
       initial_states, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      batch_size);
+      batch_size, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -368,7 +394,8 @@ evolve(const std::initializer_list<HamTy> &hamiltonians,
        std::vector<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> batch_size = std::nullopt) {
+       std::optional<int> batch_size = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   if (batch_size.has_value() && batch_size.value() < 1)
     throw std::invalid_argument(
@@ -379,7 +406,7 @@ evolve(const std::initializer_list<HamTy> &hamiltonians,
       initial_states, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      batch_size);
+      batch_size, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -398,7 +425,8 @@ evolve(const std::vector<HamTy> &hamiltonians,
        std::initializer_list<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> batch_size = std::nullopt) {
+       std::optional<int> batch_size = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   if (batch_size.has_value() && batch_size.value() < 1)
     throw std::invalid_argument(
@@ -409,7 +437,7 @@ evolve(const std::vector<HamTy> &hamiltonians,
       initial_states, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      batch_size);
+      batch_size, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -428,7 +456,8 @@ evolve(const std::vector<HamTy> &hamiltonians,
        const std::vector<ObserveOpTy> &observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> batch_size = std::nullopt) {
+       std::optional<int> batch_size = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   if (batch_size.has_value() && batch_size.value() < 1)
     throw std::invalid_argument(
@@ -439,7 +468,7 @@ evolve(const std::vector<HamTy> &hamiltonians,
       initial_states, integrator,
       cudaq::__internal__::convertOps(collapse_operators),
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      batch_size);
+      batch_size, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -458,12 +487,13 @@ evolve(const super_op &super_op, const cudaq::dimension_map &dimensions,
        std::initializer_list<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> shots_count = std::nullopt) {
+       std::optional<int> shots_count = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveBatched(
       super_op, dimensions, schedule, initial_states, integrator,
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      shots_count);
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -478,12 +508,13 @@ evolve(const super_op &super_op, const cudaq::dimension_map &dimensions,
        base_integrator &integrator, std::vector<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> shots_count = std::nullopt) {
+       std::optional<int> shots_count = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   return cudaq::__internal__::evolveBatched(
       super_op, dimensions, schedule, initial_states, integrator,
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      shots_count);
+      shots_count, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -502,7 +533,8 @@ evolve(const std::vector<super_op> &super_ops,
        std::initializer_list<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> batch_size = std::nullopt) {
+       std::optional<int> batch_size = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   if (batch_size.has_value() && batch_size.value() < 1)
     throw std::invalid_argument(
@@ -512,7 +544,7 @@ evolve(const std::vector<super_op> &super_ops,
   return cudaq::__internal__::evolveBatched(
       super_ops, dimensions, schedule, initial_states, integrator,
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      batch_size);
+      batch_size, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
@@ -528,7 +560,8 @@ evolve(const std::vector<super_op> &super_ops,
        std::vector<ObserveOpTy> observables = {},
        IntermediateResultSave store_intermediate_results =
            IntermediateResultSave::None,
-       std::optional<int> batch_size = std::nullopt) {
+       std::optional<int> batch_size = std::nullopt,
+       const evolve_sink &sink = {}) {
 #if defined(CUDAQ_ANALOG_TARGET)
   if (batch_size.has_value() && batch_size.value() < 1)
     throw std::invalid_argument(
@@ -538,7 +571,7 @@ evolve(const std::vector<super_op> &super_ops,
   return cudaq::__internal__::evolveBatched(
       super_ops, dimensions, schedule, initial_states, integrator,
       cudaq::__internal__::convertOps(observables), store_intermediate_results,
-      batch_size);
+      batch_size, sink);
 #else
   static_assert(
       false, "cudaq::evolve is only supported on the 'dynamics' target. Please "
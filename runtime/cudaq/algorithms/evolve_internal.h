@@ -101,16 +101,16 @@ evolve_async(state initial_state, QuantumKernel &&kernel,
   std::promise<evolve_result> promise;
   auto f = promise.get_future();
 
-  QuantumTask wrapped = detail::make_copyable_function(
-      [p = std::move(promise), func = std::forward<QuantumKernel>(kernel),
-       initial_state, observables, noise_model, shots_count,
-       &platform]() mutable {
-        if (noise_model.has_value())
-          platform.set_noise(&noise_model.value());
-        p.set_value(evolve(initial_state, func, observables, shots_count));
-        if (noise_model.has_value())
-          platform.set_noise(nullptr);
-      });
+  QuantumTask wrapped = [p = std::move(promise),
+                         func = std::forward<QuantumKernel>(kernel),
+                         initial_state, observables, noise_model, shots_count,
+                         &platform]() mutable {
+    if (noise_model.has_value())
+      platform.set_noise(&noise_model.value());
+    p.set_value(evolve(initial_state, func, observables, shots_count));
+    if (noise_model.has_value())
+      platform.set_noise(nullptr);
+  };
 
   platform.enqueueAsyncTask(qpu_id, wrapped);
   return f;
@@ -127,16 +127,16 @@ evolve_async(state initial_state, std::vector<QuantumKernel> kernels,
   std::promise<evolve_result> promise;
   auto f = promise.get_future();
 
-  QuantumTask wrapped = detail::make_copyable_function(
-      [p = std::move(promise), kernels, initial_state, observables, noise_model,
-       shots_count, &platform, save_intermediate_states]() mutable {
-        if (noise_model.has_value())
-          platform.set_noise(&noise_model.value());
-        p.set_value(evolve(initial_state, kernels, observables, shots_count,
-                           save_intermediate_states));
-        if (noise_model.has_value())
-          platform.set_noise(nullptr);
-      });
+  QuantumTask wrapped = [p = std::move(promise), kernels, initial_state,
+                         observables, noise_model, shots_count, &platform,
+                         save_intermediate_states]() mutable {
+    if (noise_model.has_value())
+      platform.set_noise(&noise_model.value());
+    p.set_value(evolve(initial_state, kernels, observables, shots_count,
+                       save_intermediate_states));
+    if (noise_model.has_value())
+      platform.set_noise(nullptr);
+  };
 
   platform.enqueueAsyncTask(qpu_id, wrapped);
   return f;
@@ -155,10 +155,9 @@ evolve_async(std::function<evolve_result()> evolveFunctor,
   std::promise<evolve_result> promise;
   auto f = promise.get_future();
 
-  QuantumTask wrapped = detail::make_copyable_function(
-      [p = std::move(promise), evolveFunctor]() mutable {
-        p.set_value(evolveFunctor());
-      });
+  QuantumTask wrapped = [p = std::move(promise), evolveFunctor]() mutable {
+    p.set_value(evolveFunctor());
+  };
 
   platform.enqueueAsyncTask(qpu_id, wrapped);
   return f;
@@ -175,7 +174,8 @@ evolve_result evolveSingle(
     const std::vector<sum_op<cudaq::matrix_handler>> &observables = {},
     IntermediateResultSave store_intermediate_results =
         IntermediateResultSave::None,
-    std::optional<int> shots_count = std::nullopt);
+    std::optional<int> shots_count = std::nullopt,
+    const evolve_sink &sink = {});
 
 evolve_result evolveSingle(
     const sum_op<cudaq::matrix_handler> &hamiltonian,
@@ -185,7 +185,8 @@ evolve_result evolveSingle(
     const std::vector<sum_op<cudaq::matrix_handler>> &observables = {},
     IntermediateResultSave store_intermediate_results =
         IntermediateResultSave::None,
-    std::optional<int> shots_count = std::nullopt);
+    std::optional<int> shots_count = std::nullopt,
+    const evolve_sink &sink = {});
 
 std::vector<evolve_result> evolveBatched(
     const sum_op<cudaq::matrix_handler> &hamiltonian,
@@ -195,7 +196,8 @@ std::vector<evolve_result> evolveBatched(
     const std::vector<sum_op<cudaq::matrix_handler>> &observables = {},
     IntermediateResultSave store_intermediate_results =
         IntermediateResultSave::None,
-    std::optional<int> shots_count = std::nullopt);
+    std::optional<int> shots_count = std::nullopt,
+    const evolve_sink &sink = {});
 
 evolve_result
 evolveSingle(const super_op &superOp, const cudaq::dimension_map &dimensionsMap,
@@ -204,7 +206,8 @@ evolveSingle(const super_op &superOp, const cudaq::dimension_map &dimensionsMap,
              const std::vector<sum_op<cudaq::matrix_handler>> &observables = {},
              IntermediateResultSave store_intermediate_results =
                  IntermediateResultSave::None,
-             std::optional<int> shotsCount = std::nullopt);
+             std::optional<int> shotsCount = std::nullopt,
+             const evolve_sink &sink = {});
 
 evolve_result
 evolveSingle(const super_op &superOp, const cudaq::dimension_map &dimensionsMap,
@@ -213,7 +216,8 @@ evolveSingle(const super_op &superOp, const cudaq::dimension_map &dimensionsMap,
              const std::vector<sum_op<cudaq::matrix_handler>> &observables = {},
              IntermediateResultSave store_intermediate_results =
                  IntermediateResultSave::None,
-             std::optional<int> shotsCount = std::nullopt);
+             std::optional<int> shotsCount = std::nullopt,
+             const evolve_sink &sink = {});
 
 std::vector<evolve_result> evolveBatched(
     const super_op &superOp, const cudaq::dimension_map &dimensions,
@@ -222,7 +226,8 @@ std::vector<evolve_result> evolveBatched(
     const std::vector<sum_op<cudaq::matrix_handler>> &observables = {},
     IntermediateResultSave store_intermediate_results =
         IntermediateResultSave::None,
-    std::optional<int> shots_count = std::nullopt);
+    std::optional<int> shots_count = std::nullopt,
+    const evolve_sink &sink = {});
 
 std::vector<evolve_result> evolveBatched(
     const std::vector<sum_op<cudaq::matrix_handler>> &hamiltonians,
@@ -233,7 +238,8 @@ std::vector<evolve_result> evolveBatched(
     const std::vector<sum_op<cudaq::matrix_handler>> &observables = {},
     IntermediateResultSave store_intermediate_results =
         IntermediateResultSave::None,
-    std::optional<int> batch_size = std::nullopt);
+    std::optional<int> batch_size = std::nullopt,
+    const evolve_sink &sink = {});
 
 std::vector<evolve_result> evolveBatched(
     const std::vector<super_op> &superOps,
@@ -242,7 +248,8 @@ std::vector<evolve_result> evolveBatched(
     const std::vector<sum_op<cudaq::matrix_handler>> &observables = {},
     IntermediateResultSave store_intermediate_results =
         IntermediateResultSave::None,
-    std::optional<int> batch_size = std::nullopt);
+    std::optional<int> batch_size = std::nullopt,
+    const evolve_sink &sink = {});
 
 evolve_result evolveSingle(const cudaq::rydberg_hamiltonian &hamiltonian,
                            const cudaq::schedule &schedule,
@@ -82,20 +82,20 @@ auto runGetStateAsync(KernelFunctor &&wrappedKernel,
   std::promise<state> promise;
   auto f = promise.get_future();
   // Wrapped it as a generic (returning void) function
-  QuantumTask wrapped = detail::make_copyable_function(
-      [p = std::move(promise), qpu_id, &platform,
-       func = std::forward<KernelFunctor>(wrappedKernel)]() mutable {
-        ExecutionContext context("extract-state");
-        // Indicate that this is an async exec
-        context.asyncExec = true;
-        context.qpuId = qpu_id;
-        // Set the platform and the qpu id.
-        platform.set_exec_ctx(&context);
-        func();
-        platform.reset_exec_ctx();
-        // Extract state data
-        p.set_value(state(context.simulationState.release()));
-      });
+  QuantumTask wrapped = [p = std::move(promise), qpu_id, &platform,
+                         func = std::forward<KernelFunctor>(
+                             wrappedKernel)]() mutable {
+    ExecutionContext context("extract-state");
+    // Indicate that this is an async exec
+    context.asyncExec = true;
+    context.qpuId = qpu_id;
+    // Set the platform and the qpu id.
+    platform.set_exec_ctx(&context);
+    func();
+    platform.reset_exec_ctx();
+    // Extract state data
+    p.set_value(state(context.simulationState.release()));
+  };
 
   platform.enqueueAsyncTask(qpu_id, wrapped);
   return f;
@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #pragma once
+#include "common/Environment.h"
 #include "common/KernelWrapper.h"
 #include "observe.h"
 #include <cudaq/builder.h>
@@ -48,6 +49,58 @@ protected:
     return cudaq::observe(ansatz_functor, h, x);
   }
 
+  // Compute the expected values of the spin_op h at each of the parameters
+  // xs. The evaluations are launched asynchronously over all the QPUs of the
+  // platform and, if MPI is initialized, split across the ranks. All ranks
+  // must then compute the gradient at the same parameters. Set
+  // `CUDAQ_GRADIENT_MPI=0` to keep each rank on its own evaluations, e.g.,
+  // for simulators distributing a single state across the ranks.
+  std::vector<double>
+  getExpectedValues(const std::vector<std::vector<double>> &xs,
+                    const spin_op &h) {
+    const bool useMpi = mpi::is_initialized() && mpi::num_ranks() > 1 &&
+                        getEnvBool("CUDAQ_GRADIENT_MPI", true);
+    const std::size_t nRanks = useMpi ? mpi::num_ranks() : 1;
+    const std::size_t chunk = (xs.size() + nRanks - 1) / nRanks;
+    const std::size_t begin =
+        std::min(xs.size(), (useMpi ? mpi::rank() : 0) * chunk);
+    const std::size_t end = std::min(xs.size(), begin + chunk);
+
+    std::vector<double> local(chunk, 0.0);
+    auto &platform = get_platform();
+    const std::size_t nQpus = platform.num_qpus();
+    if (nQpus <= 1) {
+      // Run the evaluations as one batch, like a broadcast observe: the
+      // simulator keeps its state allocated from one evaluation to the next.
+      // A batch of a single evaluation is not flagged as such, since its
+      // first evaluation would not be recognized as the last one.
+      const auto kernelName = cudaq::getKernelName(ansatz_functor);
+      const std::size_t batchSize = end - begin > 1 ? end - begin : 0;
+      for (std::size_t i = begin; i < end; ++i)
+        local[i - begin] =
+            details::runObservation(
+                [&]() { ansatz_functor(xs[i]); }, h, platform, /*shots=*/-1,
+                kernelName, /*qpu_id=*/0, nullptr, i - begin, batchSize)
+                .value()
+                .expectation();
+    } else {
+      std::vector<async_observe_result> results;
+      results.reserve(end - begin);
+      for (std::size_t i = begin; i < end; ++i)
+        results.emplace_back(
+            observe_async((i - begin) % nQpus, ansatz_functor, h, xs[i]));
+      for (std::size_t i = begin; i < end; ++i)
+        local[i - begin] = results[i - begin].get().expectation();
+    }
+    if (!useMpi)
+      return local;
+
+    std::vector<double> global(chunk * nRanks);
+    mpi::all_gather(global, local);
+    global.resize(xs.size());
+    return global;
+  }
+
   // Copy constructor. Derived classes should implement the clone() method.
   gradient(const gradient &o) {
     ansatz_functor = o.ansatz_functor;
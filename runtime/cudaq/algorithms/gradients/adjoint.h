@@ -0,0 +1,229 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/Trace.h"
+#include "cudaq/algorithms/draw.h"
+#include "cudaq/algorithms/gradient.h"
+#include "nvqir/Gates.h"
+#include <complex>
+
+namespace cudaq::gradients {
+namespace details {
+using state_vector = std::vector<std::complex<double>>;
+
+/// @brief Apply the row-major `matrix` to the targets of `inst`, on the
+/// amplitudes where all the controls of `inst` are set. If `project` is set,
+/// the other amplitudes are zeroed: this applies the derivative of a
+/// controlled gate.
+inline void apply(state_vector &state,
+                  const std::vector<std::complex<double>> &matrix,
+                  const Trace::Instruction &inst, bool adjoint = false,
+                  bool project = false) {
+  const std::size_t numTargets = inst.targets.size();
+  const std::size_t dim = 1ULL << numTargets;
+  std::size_t controlMask = 0;
+  for (const auto &control : inst.controls)
+    controlMask |= 1ULL << control.id;
+  // Offset of each row of the matrix in the state: the first target is the
+  // most significant bit of the row index.
+  std::vector<std::size_t> offsets(dim, 0);
+  std::size_t targetMask = 0;
+  for (std::size_t r = 0; r < dim; ++r)
+    for (std::size_t j = 0; j < numTargets; ++j)
+      if ((r >> (numTargets - 1 - j)) & 1)
+        offsets[r] |= 1ULL << inst.targets[j].id;
+  for (const auto &target : inst.targets)
+    targetMask |= 1ULL << target.id;
+
+  state_vector in(dim);
+  for (std::size_t i = 0; i < state.size(); ++i) {
+    if (i & targetMask)
+      continue;
+    if ((i & controlMask) != controlMask) {
+      if (project)
+        for (std::size_t r = 0; r < dim; ++r)
+          state[i | offsets[r]] = 0.0;
+      continue;
+    }
+    for (std::size_t r = 0; r < dim; ++r)
+      in[r] = state[i | offsets[r]];
+    for (std::size_t r = 0; r < dim; ++r) {
+      std::complex<double> sum = 0.0;
+      for (std::size_t c = 0; c < dim; ++c) {
+        const auto element =
+            adjoint ? std::conj(matrix[c * dim + r]) : matrix[r * dim + c];
+        sum += element * in[c];
+      }
+      state[i | offsets[r]] = sum;
+    }
+  }
+}
+
+/// @brief Return `h |state>`, qubit `q` being bit `q` of the state index.
+inline state_vector apply(const spin_op &h, const state_vector &state,
+                          std::size_t numQubits) {
+  state_vector result(state.size(), 0.0);
+  for (const auto &term : h) {
+    const auto coefficient = term.evaluate_coefficient();
+    const auto word = term.get_pauli_word(numQubits);
+    std::size_t flipMask = 0;
+    std::size_t signMask = 0;
+    std::complex<double> phase = coefficient;
+    for (std::size_t q = 0; q < numQubits; ++q) {
+      if (word[q] == 'X' || word[q] == 'Y')
+        flipMask |= 1ULL << q;
+      if (word[q] == 'Z' || word[q] == 'Y')
+        signMask |= 1ULL << q;
+      if (word[q] == 'Y')
+        phase *= std::complex<double>(0.0, 1.0);
+    }
+    for (std::size_t i = 0; i < state.size(); ++i) {
+      const bool negative = __builtin_popcountll(i & signMask) & 1;
+      result[i ^ flipMask] += (negative ? -phase : phase) * state[i];
+    }
+  }
+  return result;
+}
+} // namespace details
+
+/// @brief Adjoint differentiation of the expectation value of a spin operator.
+// The kernel is traced once and its gates are replayed on a state vector
+// `|psi> = U_N ... U_1 |0>`. The gates are then undone one at a time, in
+// reverse order, on both `|psi>` and `H|psi>`: the derivative of the
+// expectation value with respect to the angle of gate `U_k` is
+// `2 Re <psi| H U_N ... U_{k+1} dU_k U_{k-1} ... U_1 |0>`. The whole gradient
+// hence costs about three evaluations of the circuit, independently of the
+// number of parameters. The angles of the gates are related to the
+// parameters by tracing the kernel at shifted parameters, which does not
+// simulate it. The gate sequence of the kernel must not depend on the values
+// of the parameters, and the kernel must only contain gates with a known
+// matrix.
+class adjoint : public gradient {
+public:
+  using gradient::gradient;
+  /// @brief The step of the central difference of the gate angles with
+  /// respect to the parameters. This is exact for angles that are linear in
+  /// the parameters.
+  double step = 1e-4;
+
+  virtual std::unique_ptr<cudaq::gradient> clone() override {
+    auto newGrad = std::make_unique<adjoint>(*this);
+    newGrad->step = this->step;
+    return newGrad;
+  }
+
+  void compute(const std::vector<double> &x, std::vector<double> &dx,
+               const spin_op &h, double exp_h) override {
+    if (!cudaq::get_platform().is_simulator())
+      throw std::runtime_error(
+          "The adjoint gradient is only supported on simulator platforms.");
+    const auto trace = getTrace(x);
+    const std::vector<Trace::Instruction> gates(trace.begin(), trace.end());
+
+    // Derivatives of the gate angles with respect to the parameters: for each
+    // angle of each gate, the parameters it depends on and the derivative.
+    std::vector<std::vector<std::vector<std::pair<std::size_t, double>>>>
+        jacobian(gates.size());
+    for (std::size_t g = 0; g < gates.size(); ++g)
+      jacobian[g].resize(gates[g].params.size());
+    auto tmpX = x;
+    for (std::size_t i = 0; i < x.size(); i++) {
+      tmpX[i] += step;
+      const auto plus = getTrace(tmpX);
+      tmpX[i] -= 2 * step;
+      const auto minus = getTrace(tmpX);
+      tmpX[i] += step;
+      auto p = plus.begin();
+      auto m = minus.begin();
+      for (std::size_t g = 0; g < gates.size(); ++g, ++p, ++m) {
+        if (p == plus.end() || m == minus.end() || !sameGate(gates[g], *p) ||
+            !sameGate(gates[g], *m))
+          throw std::runtime_error(
+              "The adjoint gradient requires the gates of the kernel to not "
+              "depend on the values of the parameters.");
+        for (std::size_t a = 0; a < gates[g].params.size(); ++a) {
+          const double derivative =
+              (p->params[a] - m->params[a]) / (2. * step);
+          if (derivative != 0.0)
+            jacobian[g][a].emplace_back(i, derivative);
+        }
+      }
+    }
+
+    std::size_t numQubits = trace.getNumQudits();
+    for (const auto &term : h)
+      for (auto degree : term.degrees())
+        numQubits = std::max(numQubits, degree + 1);
+    details::state_vector psi(1ULL << numQubits, 0.0);
+    psi[0] = 1.0;
+    std::vector<std::vector<std::complex<double>>> matrices;
+    matrices.reserve(gates.size());
+    for (const auto &gate : gates) {
+      matrices.push_back(matrix(gate, gate.params));
+      details::apply(psi, matrices.back(), gate);
+    }
+    auto lambda = details::apply(h, psi, numQubits);
+
+    std::fill(dx.begin(), dx.end(), 0.0);
+    for (std::size_t g = gates.size(); g-- > 0;) {
+      details::apply(psi, matrices[g], gates[g], /*adjoint=*/true);
+      for (std::size_t a = 0; a < gates[g].params.size(); ++a) {
+        if (jacobian[g][a].empty())
+          continue;
+        // Derivative of the gate matrix with respect to this angle
+        auto angles = gates[g].params;
+        angles[a] += step;
+        auto derivative = matrix(gates[g], angles);
+        angles[a] -= 2 * step;
+        const auto minus = matrix(gates[g], angles);
+        for (std::size_t k = 0; k < derivative.size(); ++k)
+          derivative[k] = (derivative[k] - minus[k]) / (2. * step);
+        auto mu = psi;
+        details::apply(mu, derivative, gates[g], /*adjoint=*/false,
+                       /*project=*/true);
+        std::complex<double> overlap = 0.0;
+        for (std::size_t k = 0; k < mu.size(); ++k)
+          overlap += std::conj(lambda[k]) * mu[k];
+        for (const auto &[i, dAngle] : jacobian[g][a])
+          dx[i] += 2. * overlap.real() * dAngle;
+      }
+      details::apply(lambda, matrices[g], gates[g], /*adjoint=*/true);
+    }
+  }
+
+  /// @brief The adjoint method differentiates a kernel, it cannot be applied
+  /// to an arbitrary function.
+  std::vector<double>
+  compute(const std::vector<double> &x,
+          const std::function<double(std::vector<double>)> &func,
+          double funcAtX) override {
+    throw std::runtime_error(
+        "The adjoint gradient can only differentiate the expectation value of "
+        "a spin_op, use another gradient for arbitrary functions.");
+  }
+
+private:
+  Trace getTrace(const std::vector<double> &x) {
+    return cudaq::contrib::traceFromKernel(ansatz_functor, x);
+  }
+
+  static std::vector<std::complex<double>>
+  matrix(const Trace::Instruction &gate, const std::vector<double> &angles) {
+    return nvqir::getGateByName<double>(nvqir::getGateNameFromString(gate.name),
+                                        angles);
+  }
+
+  static bool sameGate(const Trace::Instruction &a,
+                       const Trace::Instruction &b) {
+    return a.name == b.name && a.params.size() == b.params.size() &&
+           a.controls == b.controls && a.targets == b.targets;
+  }
+};
+} // namespace cudaq::gradients
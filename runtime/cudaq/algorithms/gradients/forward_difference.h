@@ -28,15 +28,13 @@ public:
   /// @brief Compute the `forward_difference` gradient
   void compute(const std::vector<double> &x, std::vector<double> &dx,
                const spin_op &h, double funcAtX) override {
-    auto tmpX = x;
-    for (std::size_t i = 0; i < x.size(); i++) {
-      // increase value to x_i + dx_i
-      tmpX[i] += step;
-      auto px = getExpectedValue(tmpX, h);
-      // return value back to x_i
-      tmpX[i] -= step;
-      dx[i] = (px - funcAtX) / step;
-    }
+    // Evaluate all the shifted parameters together, at x_i + dx_i for each i.
+    std::vector<std::vector<double>> shifted(x.size(), x);
+    for (std::size_t i = 0; i < x.size(); i++)
+      shifted[i][i] += step;
+    const auto values = getExpectedValues(shifted, h);
+    for (std::size_t i = 0; i < x.size(); i++)
+      dx[i] = (values[i] - funcAtX) / step;
   }
 
   /// @brief Compute the `forward_difference` gradient for the arbitrary
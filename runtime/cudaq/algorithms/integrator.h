@@ -48,5 +48,81 @@ private:
   int m_order;
   std::optional<double> m_dt;
 };
+
+/// @brief Adaptive step size integrator using the embedded 5(4) `Runge-Kutta`
+/// pair of Dormand and Prince.
+// Each step is accepted if its local error estimate, the difference between
+// the 5th and the 4th order solutions, is within `atol + rtol * |y|`
+// element-wise in the root-mean-square norm. The step size grows or shrinks
+// according to that error estimate, so that small steps are only taken where
+// the dynamics is fast.
+class dormand_prince : public cudaq::base_integrator {
+public:
+  /// @brief Constructor
+  // (1) Relative tolerance
+  // (2) Absolute tolerance
+  // (3) Max step size: if provided, the integrator will never take steps
+  // larger than this value.
+  dormand_prince(double rtol = 1e-6, double atol = 1e-8,
+                 const std::optional<double> &max_step_size = {});
+  /// @brief Integrate toward a specified time point.
+  void integrate(double targetTime) override;
+  /// @brief Set the initial state of the integration
+  void setState(const cudaq::state &initialState, double t0) override;
+  /// @brief Get the current state of the integrator
+  // Returns the current time point and state.
+  std::pair<double, cudaq::state> getState() override;
+  /// @brief Clone the current integrator.
+  std::shared_ptr<base_integrator> clone() override;
+
+private:
+  double m_t = 0.0;
+  std::shared_ptr<cudaq::state> m_state;
+  double m_rtol;
+  double m_atol;
+  std::optional<double> m_maxDt;
+  // The step size estimated by the last step, reused by the next call to
+  // `integrate`.
+  std::optional<double> m_dt;
+  // The derivative at the current state: the last stage of an accepted step
+  // is the first stage of the next one.
+  std::shared_ptr<cudaq::state> m_derivative;
+};
+
+/// @brief Krylov subspace exponential integrator for time-independent systems.
+// Each step computes `exp(tL) y` for the Liouvillian `L` of the system, i.e.,
+// `exp(-iHt)|psi>` for a closed system, by projecting `L` onto the Krylov
+// subspace spanned by `y, Ly, L^2y, ...` (Arnoldi iteration). The subspace
+// grows until the error estimate of the step is within the tolerance, so that
+// a single step usually reaches the next time point of the schedule. If the
+// maximum subspace dimension is reached first, the step is shortened instead.
+// The system must be time-independent: all its coefficients must be constant
+// and none of its elementary operators may depend on schedule parameters.
+class krylov : public cudaq::base_integrator {
+public:
+  /// @brief The default maximum dimension of the Krylov subspace.
+  static constexpr int default_max_subspace_dim = 30;
+  /// @brief Constructor
+  // (1) Tolerance on the error of each step, relative to the norm of the state
+  // (2) Maximum dimension of the Krylov subspace, i.e., the maximum number of
+  // operator applications per step (and of states kept in memory).
+  krylov(double tolerance = 1e-10,
+         int max_subspace_dim = default_max_subspace_dim);
+  /// @brief Integrate toward a specified time point.
+  void integrate(double targetTime) override;
+  /// @brief Set the initial state of the integration
+  void setState(const cudaq::state &initialState, double t0) override;
+  /// @brief Get the current state of the integrator
+  // Returns the current time point and state.
+  std::pair<double, cudaq::state> getState() override;
+  /// @brief Clone the current integrator.
+  std::shared_ptr<base_integrator> clone() override;
+
+private:
+  double m_t = 0.0;
+  std::shared_ptr<cudaq::state> m_state;
+  double m_tolerance;
+  int m_maxSubspaceDim;
+};
 } // namespace integrators
 } // namespace cudaq
@@ -14,9 +14,18 @@
 #include "cudaq/concepts.h"
 #include "cudaq/host_config.h"
 #include "cudaq/operators.h"
+#include "cudaq/operators/serialization.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
 #include <functional>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <ranges>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace cudaq {
@@ -27,6 +36,7 @@ int num_ranks();
 bool is_initialized();
 template <typename T, typename Func>
 T all_reduce(const T &, const Func &);
+void all_gather(std::vector<double> &global, const std::vector<double> &local);
 } // namespace mpi
 
 /// @brief Return type for asynchronous observation.
@@ -62,6 +72,11 @@ struct observe_options {
   int shots = -1;
   cudaq::noise_model noise;
   std::optional<std::size_t> num_trajectories;
+  /// @brief If set, the shots are allocated adaptively to reach this standard
+  /// error of the expectation value with the fewest shots. Each group of
+  /// qubit-wise commuting terms is measured with `shots` pilot shots, and then
+  /// with additional shots in proportion to its estimated standard deviation.
+  std::optional<double> target_error;
 };
 
 namespace details {
@@ -118,7 +133,9 @@ runObservation(KernelFunctor &&k, const cudaq::spin_op &H,
   if (ctx->expectationValue.has_value())
     expectationValue = ctx->expectationValue.value_or(0.0);
   else {
-    // If not, we have everything we need to compute it.
+    // If not, we have everything we need to compute it, once the counts of
+    // jointly measured terms are split up.
+    data = details::expand_group_results(data, ctx->spin.value());
     double sum = 0.0;
     for (const auto &term : ctx->spin.value()) {
       if (term.is_identity())
@@ -141,6 +158,8 @@ auto runObservationAsync(KernelFunctor &&wrappedKernel, const spin_op &H,
                          quantum_platform &platform, int shots,
                          const std::string &kernelName,
                          std::size_t qpu_id = 0) {
+  if (qpu_id == any_qpu)
+    qpu_id = platform.select_qpu();
   if (qpu_id >= platform.num_qpus()) {
     throw std::invalid_argument("Provided qpu_id " + std::to_string(qpu_id) +
                                 " is invalid (must be < " +
@@ -175,32 +194,253 @@ auto runObservationAsync(KernelFunctor &&wrappedKernel, const spin_op &H,
       details::future(platform.enqueueAsyncTask(qpu_id, task)), &H);
 }
 
+/// @brief The estimated cost of observing the group of qubit-wise commuting
+/// terms `group`. With shots, the group is measured by a single execution of
+/// the kernel, whose cost dominates that of the basis change. Otherwise, the
+/// expectation value of each term is computed separately, at a cost growing
+/// with the number of X and Y operators that need a basis change.
+inline double observeCost(const spin_op &group, int shots) {
+  if (shots > 0)
+    return 1.0;
+  double cost = 0.0;
+  for (const auto &term : group) {
+    cost += 1.0;
+    for (const auto &op : term)
+      if (op.as_pauli() == pauli::X || op.as_pauli() == pauli::Y)
+        cost += 1.0;
+  }
+  return cost;
+}
+
+/// @brief Assign the `groups` of qubit-wise commuting terms to `numChunks`
+/// chunks, balancing their estimated cost with `shots`, and return the chunk
+/// of each group. The most expensive groups are assigned first, each to the
+/// chunk with the lowest cost so far.
+inline std::vector<std::size_t>
+assignCommutingGroups(const std::vector<spin_op> &groups,
+                      std::size_t numChunks, int shots) {
+  std::vector<double> costs;
+  costs.reserve(groups.size());
+  for (const auto &group : groups)
+    costs.push_back(observeCost(group, shots));
+  std::vector<std::size_t> order(groups.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+    return costs[lhs] > costs[rhs];
+  });
+  std::vector<double> chunkCosts(numChunks, 0.0);
+  std::vector<std::size_t> assignment(groups.size());
+  for (auto g : order) {
+    auto cheapest = std::min_element(chunkCosts.begin(), chunkCosts.end());
+    *cheapest += costs[g];
+    assignment[g] = cheapest - chunkCosts.begin();
+  }
+  return assignment;
+}
+
+/// @brief Distribute the terms of `op` into `numChunks` chunks of balanced
+/// estimated cost with `shots`. Groups of qubit-wise commuting terms are kept
+/// together, so that each chunk can still measure a group with a single
+/// circuit, unless there are fewer groups than chunks.
+inline std::vector<spin_op> distributeCommutingGroups(const spin_op &op,
+                                                      std::size_t numChunks,
+                                                      int shots = -1) {
+  auto groups = op.group_commuting();
+  if (groups.size() < numChunks)
+    return op.distribute_terms(numChunks);
+
+  auto assignment = assignCommutingGroups(groups, numChunks, shots);
+  std::vector<spin_op> chunks(numChunks, spin_op::empty());
+  for (std::size_t g = 0; g < groups.size(); ++g)
+    chunks[assignment[g]] += groups[g];
+  return chunks;
+}
+
+/// @brief Return the chunk `chunk` of the distribution of the terms of `op`
+/// into `numChunks` chunks by `distributeCommutingGroups`, without building
+/// the other chunks.
+inline spin_op commutingGroupsChunk(const spin_op &op, std::size_t numChunks,
+                                    std::size_t chunk, int shots = -1) {
+  auto groups = op.group_commuting();
+  if (groups.size() < numChunks)
+    return op.distribute_terms(numChunks)[chunk];
+
+  auto assignment = assignCommutingGroups(groups, numChunks, shots);
+  auto result = spin_op::empty();
+  for (std::size_t g = 0; g < groups.size(); ++g)
+    if (assignment[g] == chunk)
+      result += groups[g];
+  return result;
+}
+
+/// @brief Shot-frugal observation of `H` towards the standard error
+/// `targetError`. Each group of qubit-wise commuting terms is first measured
+/// with `pilotShots` shots. The standard deviation of a single shot of group
+/// `g`, `w_g = sqrt(sum_k |c_k|^2 (1 - <P_k>^2))`, is estimated from this
+/// pilot batch, ignoring the correlations between the terms. The total shots
+/// `N_g = w_g (sum_h w_h) / targetError^2` minimize the shots for which
+/// `sum_g w_g^2 / N_g` reaches `targetError^2`, the remaining shots of each
+/// group are then measured in a second batch.
+template <typename KernelFunctor>
+observe_result
+runAdaptiveObservation(KernelFunctor &&k, const spin_op &H,
+                       quantum_platform &platform, std::size_t pilotShots,
+                       double targetError, const std::string &kernelName,
+                       std::optional<std::size_t> numTrajectories = {}) {
+  if (pilotShots == 0)
+    throw std::invalid_argument(
+        "Adaptive observe requires a positive number of pilot shots.");
+  if (targetError <= 0.0)
+    throw std::invalid_argument(
+        "Adaptive observe requires a positive target error.");
+
+  const auto canonH = spin_op::canonicalize(H);
+  double identity = 0.0;
+  auto measured = spin_op::empty();
+  for (const auto &term : canonH) {
+    if (term.is_identity())
+      identity += term.evaluate_coefficient().real();
+    else
+      measured += term;
+  }
+
+  const auto observeGroup = [&](const spin_op &group, std::size_t shots) {
+    return runObservation(k, group, platform, static_cast<int>(shots),
+                          kernelName, /*qpu_id=*/0, /*futureResult=*/nullptr,
+                          /*batchIteration=*/0, /*totalBatchIters=*/0,
+                          numTrajectories)
+        .value();
+  };
+
+  // Pilot batch
+  auto groups = measured.group_commuting();
+  std::vector<observe_result> pilots;
+  std::vector<double> deviations;
+  double totalDeviation = 0.0;
+  for (const auto &group : groups) {
+    pilots.push_back(observeGroup(group, pilotShots));
+    // The variance of each term is floored at that of a single shot, so that
+    // a group is not starved by a pilot batch that happens to be pure.
+    double variance = 0.0;
+    for (const auto &term : group) {
+      const double e = pilots.back().expectation(term);
+      variance += std::norm(term.evaluate_coefficient()) *
+                  std::max(1.0 - e * e, 1.0 / pilotShots);
+    }
+    deviations.push_back(std::sqrt(variance));
+    totalDeviation += deviations.back();
+  }
+
+  // Second batch, combined with the pilot batch
+  double expectation = identity;
+  sample_result data;
+  for (std::size_t g = 0; g < groups.size(); ++g) {
+    const auto shots = static_cast<std::size_t>(std::ceil(
+        deviations[g] * totalDeviation / (targetError * targetError)));
+    double value = pilots[g].expectation();
+    data += pilots[g].raw_data();
+    if (shots > pilotShots) {
+      const auto extraShots = shots - pilotShots;
+      auto extra = observeGroup(groups[g], extraShots);
+      value = (pilotShots * value + extraShots * extra.expectation()) / shots;
+      data += extra.raw_data();
+    }
+    expectation += value;
+  }
+  return observe_result(expectation, canonH, data);
+}
+
 /// @brief Distribute the expectation value computations among the
 /// available platform QPUs. The `asyncLauncher` functor takes as input the
 /// QPU index and the `spin_op` chunk and returns an `async_observe_result`.
+///
+/// The terms are split into `chunksPerQpu` chunks per QPU, which are handed
+/// out from a shared pool: each QPU runs one chunk at a time and, once done,
+/// is given the next pending chunk, so that faster QPUs take on more of the
+/// terms. The chunks are balanced by their estimated cost with `shots`. All
+/// chunks are launched from the calling thread.
 inline auto distributeComputations(
     std::function<async_observe_result(std::size_t, const spin_op &)>
         &&asyncLauncher,
-    const spin_op &H, std::size_t nQpus) {
+    const spin_op &H, std::size_t nQpus, std::size_t chunksPerQpu = 1,
+    int shots = -1) {
 
   auto op = cudaq::spin_op::canonicalize(H);
-  // Distribute the given spin_op into subsets for each QPU
-  auto spins = op.distribute_terms(nQpus);
-
-  // Observe each sub-spin_op asynchronously
-  std::vector<async_observe_result> asyncResults;
-  for (std::size_t i = 0; auto &op : spins) {
-    asyncResults.emplace_back(asyncLauncher(i, op));
-    i++;
+  // Distribute the given spin_op into chunks, dropping empty ones.
+  auto spins = distributeCommutingGroups(op, nQpus * chunksPerQpu, shots);
+  if (std::any_of(spins.begin(), spins.end(),
+                  [](const spin_op &s) { return s.num_terms() > 0; }))
+    std::erase_if(spins, [](const spin_op &s) { return s.num_terms() == 0; });
+
+  // Chunks completed by the QPUs, as (QPU, chunk) pairs.
+  std::mutex lock;
+  std::condition_variable cv;
+  std::vector<std::pair<std::size_t, std::size_t>> completed;
+  std::vector<std::optional<observe_result>> results(spins.size());
+  std::exception_ptr error;
+  std::vector<std::future<void>> waiters;
+  std::size_t nextChunk = 0, numRunning = 0;
+
+  // Observe the next chunk on the given QPU asynchronously, and wait for the
+  // result on a separate thread.
+  auto launchNext = [&](std::size_t qpuId) {
+    if (error || nextChunk == spins.size())
+      return;
+    const auto chunk = nextChunk++;
+    auto asyncResult = asyncLauncher(qpuId, spins[chunk]);
+    ++numRunning;
+    waiters.emplace_back(std::async(
+        std::launch::async,
+        [&, qpuId, chunk, asyncResult = std::move(asyncResult)]() mutable {
+          std::exception_ptr chunkError;
+          std::optional<observe_result> chunkResult;
+          try {
+            chunkResult = asyncResult.get();
+          } catch (...) {
+            chunkError = std::current_exception();
+          }
+          std::lock_guard<std::mutex> guard(lock);
+          results[chunk] = std::move(chunkResult);
+          if (chunkError && !error)
+            error = chunkError;
+          completed.emplace_back(qpuId, chunk);
+          cv.notify_one();
+        }));
+  };
+
+  try {
+    for (std::size_t qpuId = 0; qpuId < nQpus; qpuId++) {
+      std::lock_guard<std::mutex> guard(lock);
+      launchNext(qpuId);
+    }
+    std::unique_lock<std::mutex> guard(lock);
+    while (numRunning > 0) {
+      cv.wait(guard, [&] { return !completed.empty(); });
+      for (auto [qpuId, chunk] : std::exchange(completed, {})) {
+        --numRunning;
+        launchNext(qpuId);
+      }
+    }
+  } catch (...) {
+    // A launch failed, wait for the running chunks before propagating.
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      nextChunk = spins.size();
+    }
+    for (auto &waiter : waiters)
+      waiter.wait();
+    throw;
   }
+  for (auto &waiter : waiters)
+    waiter.get();
+  if (error)
+    std::rethrow_exception(error);
 
-  // Wait for the results, should be executing
-  // in parallel on the available QPUs.
+  // Combine the results of all chunks.
   double result = 0.0;
   sample_result data;
-  for (auto &asyncResult : asyncResults) {
-    auto res = asyncResult.get();
-    auto incomingData = res.raw_data();
+  for (auto &chunkResult : results) {
+    auto incomingData = chunkResult->raw_data();
     result += incomingData.expectation();
     data += incomingData;
   }
@@ -208,6 +448,36 @@ inline auto distributeComputations(
   return observe_result(result, op, data);
 }
 
+/// @brief The number of terms of a packed operator built as a `spin_op` and
+/// observed at a time.
+inline constexpr std::size_t packedObserveChunkTerms = std::size_t(1) << 16;
+
+/// @brief Observe the terms of the packed operator `H` with indices in
+/// `[first, last)` chunk by chunk with `observeChunk`, which takes a chunk as
+/// a canonical `spin_op` and returns its expectation value. Only one chunk of
+/// the terms is held as a `spin_op` at a time, and only the pages of `H` that
+/// hold these terms are read. Return the sum of the expectation values.
+template <typename ChunkObserver>
+double observePackedTerms(const packed_spin_op_view &H, std::size_t first,
+                          std::size_t last, ChunkObserver &&observeChunk) {
+  double expVal = 0.0;
+  for (std::size_t begin = first; begin < last;
+       begin += packedObserveChunkTerms) {
+    const auto end = std::min(last, begin + packedObserveChunkTerms);
+    expVal += observeChunk(spin_op::canonicalize(H.to_spin_op(begin, end)));
+  }
+  return expVal;
+}
+
+/// @brief The number of chunks per QPU to split the terms of a distributed
+/// `observe` into. With shots, each group of commuting terms is measured by
+/// a separate execution anyway, hence finer chunks balance the QPUs at no
+/// extra cost. Otherwise, each chunk prepares the state again, and the terms
+/// are split into one chunk per QPU.
+inline std::size_t observeChunksPerQpu(int shots) {
+  return shots > 0 ? 4 : 1;
+}
+
 } // namespace details
 
 /// \overload
@@ -301,7 +571,7 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel,
           return observe_async(shots, i, std::forward<QuantumKernel>(kernel),
                                op, std::forward<Args>(args)...);
         },
-        H, nQpus);
+        H, nQpus, details::observeChunksPerQpu(shots), shots);
   } else if (std::is_same_v<DistributionType, parallel::mpi>) {
 
     // This is an MPI distribution, where each node has N GPUs.
@@ -319,29 +589,27 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel,
     auto rank = mpi::rank();
     auto nRanks = mpi::num_ranks();
 
-    // Each rank gets a subset of the spin terms
-    auto spins = H.distribute_terms(nRanks);
-
-    // Get this rank's set of spins to compute
-    auto localH = spins[rank].canonicalize();
+    // Each rank only builds its own subset of the spin terms, of balanced
+    // estimated cost.
+    auto canonH = spin_op::canonicalize(H);
+    auto localH = details::commutingGroupsChunk(canonH, nRanks, rank, shots);
 
     // Distribute locally, i.e. to the local nodes QPUs
-    auto localRankResult = details::distributeComputations(
-        [&kernel, shots, ... args = std::forward<Args>(args)](
-            std::size_t i, const spin_op &op) mutable {
-          return observe_async(shots, i, std::forward<QuantumKernel>(kernel),
-                               op, std::forward<Args>(args)...);
-        },
-        localH, nQpus);
-
-    // combine all the data via an all_reduce
-    auto exp_val = localRankResult.expectation();
+    double exp_val = 0.0;
+    if (localH.num_terms() > 0)
+      exp_val =
+          details::distributeComputations(
+              [&kernel, shots, ... args = std::forward<Args>(args)](
+                  std::size_t i, const spin_op &op) mutable {
+                return observe_async(shots, i,
+                                     std::forward<QuantumKernel>(kernel), op,
+                                     std::forward<Args>(args)...);
+              },
+              localH, nQpus, details::observeChunksPerQpu(shots), shots)
+              .expectation();
+
+    // Sum the partial expectation values of all ranks.
     auto globalExpVal = mpi::all_reduce(exp_val, std::plus<double>());
-    // we need the canonicalized version of H -
-    // maybe we can get it from the context instead?
-    cudaq::spin_op canonH;
-    for (auto &&terms : spins)
-      canonH += std::move(terms);
     return observe_result(globalExpVal, canonH);
 
   } else
@@ -356,6 +624,58 @@ observe_result observe(QuantumKernel &&kernel, const spin_op &H,
                                    std::forward<QuantumKernel>(kernel), H,
                                    std::forward<Args>(args)...);
 }
+
+/// @brief Compute the expected value of the packed operator `H` with respect
+/// to `kernel(Args...)`, distributed among the MPI ranks. Each rank observes a
+/// contiguous range of the terms of `H`, in chunks that are distributed among
+/// its QPUs, and so never holds more than a chunk of the operator as a
+/// `spin_op`. The returned result holds the expectation value only.
+template <typename DistributionType, typename QuantumKernel, typename... Args>
+  requires ObserveCallValid<QuantumKernel, Args...>
+observe_result observe(std::size_t shots, QuantumKernel &&kernel,
+                       const packed_spin_op_view &H, Args &&...args) {
+  static_assert(std::is_same_v<DistributionType, parallel::mpi>,
+                "packed operators can only be distributed with parallel::mpi");
+  auto &platform = cudaq::get_platform();
+  if (!platform.supports_task_distribution())
+    throw std::runtime_error(
+        "The current quantum_platform does not support parallel distribution "
+        "of observe() expectation value computations.");
+  if (!mpi::is_initialized())
+    throw std::runtime_error("Cannot use mgmn multi-node observe() without "
+                             "MPI (did you initialize MPI?).");
+
+  const std::size_t rank = mpi::rank();
+  const std::size_t nRanks = mpi::num_ranks();
+  const auto nQpus = platform.num_qpus();
+  const auto first = H.num_terms() * rank / nRanks;
+  const auto last = H.num_terms() * (rank + 1) / nRanks;
+  const double exp_val = details::observePackedTerms(
+      H, first, last, [&](const spin_op &chunk) {
+        return details::distributeComputations(
+                   [&kernel, shots, &args...](std::size_t i,
+                                              const spin_op &op) mutable {
+                     return observe_async(shots, i,
+                                          std::forward<QuantumKernel>(kernel),
+                                          op, std::forward<Args>(args)...);
+                   },
+                   chunk, nQpus, details::observeChunksPerQpu(shots), shots)
+            .expectation();
+      });
+
+  // Sum the partial expectation values of all ranks.
+  auto globalExpVal = mpi::all_reduce(exp_val, std::plus<double>());
+  return observe_result(globalExpVal, spin_op::empty());
+}
+
+template <typename DistributionType, typename QuantumKernel, typename... Args>
+  requires ObserveCallValid<QuantumKernel, Args...>
+observe_result observe(QuantumKernel &&kernel, const packed_spin_op_view &H,
+                       Args &&...args) {
+  return observe<DistributionType>(/*shots=*/-1,
+                                   std::forward<QuantumKernel>(kernel), H,
+                                   std::forward<Args>(args)...);
+}
 /// \endcond
 
 /// \overload
@@ -378,7 +698,7 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel,
           return observe_async(shots, i, std::forward<QuantumKernel>(kernel),
                                op, std::forward<Args>(args)...);
         },
-        H, nQpus);
+        H, nQpus, details::observeChunksPerQpu(shots), shots);
 
   return details::runObservation(
              [&kernel, &args...]() mutable {
@@ -388,6 +708,51 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel,
       .value();
 }
 
+/// \overload
+/// \brief Compute the expected value of the packed operator `H`, e.g., mapped
+/// from a file by `packed_spin_op_file`, with respect to `kernel(Args...)`.
+/// Specify the number of shots. The terms are observed in chunks, so that
+/// only one chunk of the operator is held as a `spin_op` at a time. The
+/// returned result holds the expectation value only.
+template <typename QuantumKernel, typename... Args>
+  requires ObserveCallValid<QuantumKernel, Args...>
+observe_result observe(std::size_t shots, QuantumKernel &&kernel,
+                       const packed_spin_op_view &H, Args &&...args) {
+  auto &platform = cudaq::get_platform();
+  auto kernelName = cudaq::getKernelName(kernel);
+  const auto nQpus = platform.num_qpus();
+  // The kernel runs once per chunk, so neither it nor its arguments are
+  // forwarded.
+  const double expVal = details::observePackedTerms(
+      H, 0, H.num_terms(), [&](const spin_op &chunk) {
+        if (nQpus > 1)
+          return details::distributeComputations(
+                     [&kernel, shots, &args...](std::size_t i,
+                                                const spin_op &op) mutable {
+                       return observe_async(shots, i, kernel, op, args...);
+                     },
+                     chunk, nQpus, details::observeChunksPerQpu(shots), shots)
+              .expectation();
+        return details::runObservation(
+                   [&kernel, &args...]() mutable { kernel(args...); }, chunk,
+                   platform, static_cast<int>(shots), kernelName)
+            ->expectation();
+      });
+  return observe_result(expVal, spin_op::empty());
+}
+
+/// \overload
+/// \brief Compute the expected value of the packed operator `H` with respect
+/// to `kernel(Args...)`.
+template <typename QuantumKernel, typename... Args>
+  requires ObserveCallValid<QuantumKernel, Args...>
+observe_result observe(QuantumKernel &&kernel, const packed_spin_op_view &H,
+                       Args &&...args) {
+  return observe(static_cast<std::size_t>(-1),
+                 std::forward<QuantumKernel>(kernel), H,
+                 std::forward<Args>(args)...);
+}
+
 /// \brief Compute the expected value of `H` with respect to `kernel(Args...)`.
 /// Specify the observation options
 template <typename QuantumKernel, typename... Args>
@@ -400,6 +765,26 @@ observe_result observe(const observe_options &options, QuantumKernel &&kernel,
 
   platform.set_noise(&options.noise);
 
+  if (options.target_error.has_value()) {
+    if (shots <= 0) {
+      platform.reset_noise();
+      throw std::invalid_argument(
+          "Adaptive observe (target_error) requires a number of pilot shots.");
+    }
+    try {
+      // The kernel runs once per pass, so its arguments are not forwarded.
+      auto ret = details::runAdaptiveObservation(
+          [&kernel, &args...]() mutable { kernel(args...); },
+          H, platform, shots, *options.target_error, kernelName,
+          options.num_trajectories);
+      platform.reset_noise();
+      return ret;
+    } catch (...) {
+      platform.reset_noise();
+      throw;
+    }
+  }
+
   auto ret = details::runObservation(
                  [&kernel, &args...]() mutable {
                    kernel(std::forward<Args>(args)...);
@@ -9,6 +9,9 @@
 #pragma once
 
 #include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace cudaq {
 
@@ -26,10 +29,14 @@ private:
       std::function<double(const std::vector<double> &)>;
   using GradientSignature =
       std::function<double(const std::vector<double> &, std::vector<double> &)>;
+  using BatchSignature = std::function<std::vector<double>(
+      const std::vector<std::vector<double>> &)>;
 
   // The function we are optimizing
   GradientSignature _opt_func;
   bool _providesGradients = true;
+  // Optional evaluation of the function at many points at once
+  BatchSignature _batch_func;
 
 public:
   template <typename Callable>
@@ -54,10 +61,53 @@ public:
     }
   }
 
+  /// Constructor, additionally takes a function evaluating the objective at
+  /// many points at once, e.g., by distributing them over several QPUs. It
+  /// must return the values of the objective at each of the points. Population
+  /// based optimizers use it for all the candidates of an iteration.
+  template <typename Callable, typename BatchCallable>
+  optimizable_function(Callable &&callable, BatchCallable &&batchCallable)
+      : optimizable_function(std::forward<Callable>(callable)) {
+    static_assert(
+        std::is_invocable_r_v<std::vector<double>, BatchCallable,
+                              std::vector<std::vector<double>>>,
+        "Invalid batch optimization function. Must have signature "
+        "std::vector<double>(const std::vector<std::vector<double>>&).");
+    _batch_func = std::forward<BatchCallable>(batchCallable);
+  }
+
   bool providesGradients() { return _providesGradients; }
   double operator()(const std::vector<double> &x, std::vector<double> &dx) {
     return _opt_func(x, dx);
   }
+
+  /// Return true if the objective function can evaluate many points at once.
+  bool providesBatchEvaluation() const {
+    return static_cast<bool>(_batch_func);
+  }
+
+  /// Evaluate the objective function at each of the points `xs`, with the
+  /// batch evaluation if provided or one point at a time otherwise. Gradients
+  /// are not computed.
+  std::vector<double> operator()(const std::vector<std::vector<double>> &xs) {
+    if (_batch_func) {
+      auto values = _batch_func(xs);
+      if (values.size() != xs.size())
+        throw std::runtime_error("The batch optimization function returned " +
+                                 std::to_string(values.size()) +
+                                 " values for " + std::to_string(xs.size()) +
+                                 " points.");
+      return values;
+    }
+    std::vector<double> values;
+    values.reserve(xs.size());
+    std::vector<double> dx;
+    for (const auto &x : xs) {
+      dx.assign(_providesGradients ? x.size() : 0, 0.0);
+      values.push_back(_opt_func(x, dx));
+    }
+    return values;
+  }
 };
 
 ///
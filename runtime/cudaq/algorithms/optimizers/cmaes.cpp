@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cmaes.h"
+#include "cudaq.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace cudaq::optimizers {
+
+optimization_result cmaes::optimize(const int dim,
+                                    optimizable_function &&opt_function) {
+  if (dim <= 0)
+    throw std::invalid_argument("cmaes requires a positive dimension.");
+  const std::size_t n = dim;
+  auto mean = initial_parameters.value_or(std::vector<double>(n, 0.0));
+  if (mean.size() != n)
+    throw std::invalid_argument("cmaes: the initial parameters must have " +
+                                std::to_string(n) + " elements.");
+  for (const auto *bounds : {&lower_bounds, &upper_bounds})
+    if (bounds->has_value() && (*bounds)->size() != n)
+      throw std::invalid_argument("cmaes: the bounds must have " +
+                                  std::to_string(n) + " elements.");
+
+  // Strategy parameters, with the defaults of Hansen's tutorial and the
+  // learning rates of the separable variant.
+  const std::size_t lambda = std::max<std::size_t>(
+      2, population_size.value_or(4 + std::floor(3 * std::log(n))));
+  const std::size_t mu = std::max<std::size_t>(1, lambda / 2);
+  std::vector<double> weights(mu);
+  for (std::size_t i = 0; i < mu; ++i)
+    weights[i] = std::log(mu + 0.5) - std::log(i + 1.0);
+  const double weightSum = std::accumulate(weights.begin(), weights.end(), 0.);
+  double squaredSum = 0.0;
+  for (auto &w : weights) {
+    w /= weightSum;
+    squaredSum += w * w;
+  }
+  const double muEff = 1.0 / squaredSum;
+  const double cSigma = (muEff + 2) / (n + muEff + 5);
+  const double dSigma =
+      1 + 2 * std::max(0.0, std::sqrt((muEff - 1) / (n + 1)) - 1) + cSigma;
+  const double cc = (4 + muEff / n) / (n + 4 + 2 * muEff / n);
+  double c1 = 2 / ((n + 1.3) * (n + 1.3) + muEff) * (n + 2) / 3;
+  double cMu = std::min(1 - c1, 2 * (muEff - 2 + 1 / muEff) /
+                                    ((n + 2) * (n + 2) + muEff) * (n + 2) / 3);
+  if (c1 + cMu > 1) {
+    const double scale = 1 / (c1 + cMu);
+    c1 *= scale;
+    cMu *= scale;
+  }
+  const double chiN = std::sqrt(n) * (1 - 1 / (4. * n) + 1 / (21. * n * n));
+
+  const auto maxEval = static_cast<std::size_t>(
+      std::max(1, max_eval.value_or(static_cast<int>(1000 * n))));
+  const double tolerance = f_tol.value_or(1e-6);
+  double stepSize = sigma.value_or(0.5);
+  std::mt19937_64 generator(seed.value_or(cudaq::get_random_seed()));
+  std::normal_distribution<double> normal;
+
+  std::vector<double> variances(n, 1.0), pathSigma(n, 0.0), pathC(n, 0.0);
+  std::vector<std::vector<double>> candidates(lambda, std::vector<double>(n));
+  std::vector<std::vector<double>> steps(lambda, std::vector<double>(n));
+  std::vector<std::size_t> order(lambda);
+  double bestValue = std::numeric_limits<double>::max();
+  std::vector<double> bestParameters = mean;
+  std::size_t numEvals = 0;
+
+  for (std::size_t generation = 1; numEvals < maxEval; ++generation) {
+    // Sample the candidates, clipped to the bounds.
+    const std::size_t numCandidates = std::min(lambda, maxEval - numEvals);
+    candidates.resize(numCandidates);
+    for (auto &x : candidates)
+      for (std::size_t j = 0; j < n; ++j) {
+        x[j] = mean[j] + stepSize * std::sqrt(variances[j]) * normal(generator);
+        if (lower_bounds.has_value())
+          x[j] = std::max(x[j], (*lower_bounds)[j]);
+        if (upper_bounds.has_value())
+          x[j] = std::min(x[j], (*upper_bounds)[j]);
+      }
+    const auto values = opt_function(candidates);
+    numEvals += numCandidates;
+
+    order.resize(numCandidates);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+      return values[a] < values[b];
+    });
+    if (values[order.front()] < bestValue) {
+      bestValue = values[order.front()];
+      bestParameters = candidates[order.front()];
+    }
+    // A truncated last population does not update the distribution.
+    if (numCandidates < lambda ||
+        values[order.back()] - values[order.front()] < tolerance)
+      break;
+
+    // Move the mean to the weighted average of the best candidates.
+    std::vector<double> meanStep(n, 0.0);
+    for (std::size_t i = 0; i < mu; ++i)
+      for (std::size_t j = 0; j < n; ++j) {
+        steps[i][j] = (candidates[order[i]][j] - mean[j]) / stepSize;
+        meanStep[j] += weights[i] * steps[i][j];
+      }
+    for (std::size_t j = 0; j < n; ++j)
+      mean[j] += stepSize * meanStep[j];
+
+    // Evolution paths
+    double pathSigmaNorm = 0.0;
+    for (std::size_t j = 0; j < n; ++j) {
+      pathSigma[j] = (1 - cSigma) * pathSigma[j] +
+                     std::sqrt(cSigma * (2 - cSigma) * muEff) * meanStep[j] /
+                         std::sqrt(variances[j]);
+      pathSigmaNorm += pathSigma[j] * pathSigma[j];
+    }
+    pathSigmaNorm = std::sqrt(pathSigmaNorm);
+    const bool hSigma =
+        pathSigmaNorm /
+            std::sqrt(1 - std::pow(1 - cSigma, 2. * generation)) / chiN <
+        1.4 + 2. / (n + 1);
+    for (std::size_t j = 0; j < n; ++j)
+      pathC[j] = (1 - cc) * pathC[j] +
+                 (hSigma ? std::sqrt(cc * (2 - cc) * muEff) : 0.0) *
+                     meanStep[j];
+
+    // Adapt the (diagonal) covariance and the step size.
+    for (std::size_t j = 0; j < n; ++j) {
+      double rankMu = 0.0;
+      for (std::size_t i = 0; i < mu; ++i)
+        rankMu += weights[i] * steps[i][j] * steps[i][j];
+      variances[j] =
+          (1 - c1 - cMu) * variances[j] +
+          c1 * (pathC[j] * pathC[j] +
+                (hSigma ? 0.0 : cc * (2 - cc) * variances[j])) +
+          cMu * rankMu;
+    }
+    stepSize *= std::exp(cSigma / dSigma * (pathSigmaNorm / chiN - 1));
+    const double maxDeviation =
+        stepSize *
+        std::sqrt(*std::max_element(variances.begin(), variances.end()));
+    if (!std::isfinite(stepSize) || maxDeviation < 1e-12)
+      break;
+  }
+
+  return std::make_tuple(bestValue, bestParameters);
+}
+
+} // namespace cudaq::optimizers
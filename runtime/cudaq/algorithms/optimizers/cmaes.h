@@ -0,0 +1,47 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "cudaq/algorithms/optimizer.h"
+#include <cstddef>
+#include <optional>
+
+namespace cudaq::optimizers {
+
+/// @brief Gradient-free Covariance Matrix Adaptation Evolution Strategy.
+// Each iteration samples a population of candidates from a normal
+// distribution, evaluates them all together and moves the mean of the
+// distribution towards the best candidates, while adapting its step size and
+// covariance to the recent progress. The covariance is restricted to its
+// diagonal (separable CMA-ES, Ros and Hansen, 2008), whose cost is linear in
+// the number of parameters and which suits the weakly correlated parameters
+// of variational circuits. The candidates of an iteration are evaluated with
+// the batch evaluation of the objective function, if provided: `cudaq::vqe`
+// distributes them over the QPUs of the platform.
+class cmaes : public cudaq::optimizer {
+public:
+  std::optional<int> max_eval;
+  std::optional<std::vector<double>> initial_parameters;
+  std::optional<std::vector<double>> lower_bounds;
+  std::optional<std::vector<double>> upper_bounds;
+  /// @brief Stop once the values of a population are within this tolerance.
+  std::optional<double> f_tol;
+  /// @brief Number of candidates per iteration, `4 + 3 ln(dim)` by default.
+  std::optional<std::size_t> population_size;
+  /// @brief Initial standard deviation of the candidates around the mean.
+  std::optional<double> sigma;
+  /// @brief Seed of the sampling, the runtime random seed by default.
+  std::optional<std::size_t> seed;
+
+  bool requiresGradients() override { return false; }
+  optimization_result optimize(const int dim,
+                               optimizable_function &&opt_function) override;
+};
+
+} // namespace cudaq::optimizers
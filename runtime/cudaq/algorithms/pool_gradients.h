@@ -0,0 +1,99 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "cudaq/algorithms/observe.h"
+#include <complex>
+#include <vector>
+
+namespace cudaq {
+namespace details {
+
+/// @brief The commutators `i [H, P_k]` for each operator `P_k` of the pool,
+/// and the operator containing each of their distinct terms once.
+inline std::pair<std::vector<spin_op>, spin_op>
+poolCommutators(const spin_op &H, const std::vector<spin_op> &pool) {
+  const std::complex<double> i(0.0, 1.0);
+  std::vector<spin_op> commutators;
+  commutators.reserve(pool.size());
+  auto measured = spin_op::empty();
+  for (const auto &op : pool) {
+    spin_op commutator = i * (H * op - op * H);
+    commutator.canonicalize().trim(1e-12);
+    for (const auto &term : commutator)
+      if (!term.is_identity())
+        measured += term * (1.0 / term.evaluate_coefficient());
+    commutators.push_back(std::move(commutator));
+  }
+  return {std::move(commutators), std::move(measured)};
+}
+
+/// @brief Assemble the expectation value of each commutator from the per-term
+/// expectation values in `result`.
+inline std::vector<double>
+poolGradientsFromResult(const std::vector<spin_op> &commutators,
+                        observe_result &result) {
+  std::vector<double> gradients;
+  gradients.reserve(commutators.size());
+  for (const auto &commutator : commutators) {
+    double gradient = 0.0;
+    for (const auto &term : commutator)
+      gradient +=
+          term.evaluate_coefficient().real() *
+          (term.is_identity() ? 1.0 : result.expectation(term));
+    gradients.push_back(gradient);
+  }
+  return gradients;
+}
+} // namespace details
+
+/// @brief Screen an operator pool for ADAPT-VQE.
+///
+/// Returns, for each Hermitian operator `P_k` of the pool, the derivative
+/// `dE/dtheta = <psi| i [H, P_k] |psi>` at `theta = 0` of the energy of the
+/// state `exp(i theta P_k)|psi>`, where `|psi>` is prepared by
+/// `kernel(args...)`. The commutators of all the pool operators are measured
+/// together in a single observe of their distinct terms, rather than one
+/// observe per pool operator. The kernel may take the state of the current
+/// ansatz as a `cudaq::state` argument, so that the state is not re-simulated
+/// from `|0>`.
+template <typename QuantumKernel, typename... Args>
+  requires ObserveCallValid<QuantumKernel, Args...>
+std::vector<double> pool_gradients(QuantumKernel &&kernel, const spin_op &H,
+                                   const std::vector<spin_op> &pool,
+                                   Args &&...args) {
+  auto [commutators, measured] = details::poolCommutators(H, pool);
+  if (measured.num_terms() == 0) {
+    observe_result empty;
+    return details::poolGradientsFromResult(commutators, empty);
+  }
+  auto result = observe(std::forward<QuantumKernel>(kernel), measured,
+                        std::forward<Args>(args)...);
+  return details::poolGradientsFromResult(commutators, result);
+}
+
+/// @overload
+/// @brief Screen an operator pool for ADAPT-VQE, estimating the gradients from
+/// the given number of shots per group of qubit-wise commuting terms.
+template <typename QuantumKernel, typename... Args>
+  requires ObserveCallValid<QuantumKernel, Args...>
+std::vector<double> pool_gradients(std::size_t shots, QuantumKernel &&kernel,
+                                   const spin_op &H,
+                                   const std::vector<spin_op> &pool,
+                                   Args &&...args) {
+  auto [commutators, measured] = details::poolCommutators(H, pool);
+  if (measured.num_terms() == 0) {
+    observe_result empty;
+    return details::poolGradientsFromResult(commutators, empty);
+  }
+  auto result = observe(shots, std::forward<QuantumKernel>(kernel), measured,
+                        std::forward<Args>(args)...);
+  return details::poolGradientsFromResult(commutators, result);
+}
+} // namespace cudaq
@@ -0,0 +1,217 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "readout_mitigation.h"
+#include "common/EigenDense.h"
+#include "common/EigenSparse.h"
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+using SparseMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+/// Return the fraction of the shots of the given register of `result` in
+/// which each bit reads `bit`.
+std::vector<double> bitFrequencies(const cudaq::sample_result &result,
+                                   std::string_view registerName, char bit) {
+  std::vector<double> frequencies;
+  std::size_t numShots = 0;
+  for (const auto &[bits, count] : result.to_map(registerName)) {
+    if (frequencies.empty())
+      frequencies.resize(bits.size(), 0.0);
+    if (bits.size() != frequencies.size())
+      throw std::runtime_error("readout calibration requires bit strings of "
+                               "the same length");
+    for (std::size_t q = 0; q < bits.size(); ++q)
+      if (bits[q] == bit)
+        frequencies[q] += count;
+    numShots += count;
+  }
+  if (numShots == 0)
+    throw std::runtime_error("readout calibration requires a non-empty result");
+  for (auto &frequency : frequencies)
+    frequency /= numShots;
+  return frequencies;
+}
+
+std::size_t hammingDistance(const std::uint64_t *lhs, const std::uint64_t *rhs,
+                            std::size_t numWords) {
+  std::size_t distance = 0;
+  for (std::size_t w = 0; w < numWords; ++w)
+    distance += std::popcount(lhs[w] ^ rhs[w]);
+  return distance;
+}
+
+/// Build the calibration matrix restricted to the packed bit strings `bits`:
+/// element (i, j) is the probability to read `bits[i]` in state `bits[j]`,
+/// neglecting the transitions between bit strings more than
+/// `maxDistance` apart. Each column is normalized over the observed bit
+/// strings.
+SparseMatrix
+buildCalibrationMatrix(const cudaq::PackedShots &bits,
+                       const cudaq::readout_calibration &calibration,
+                       std::size_t maxDistance) {
+  const std::size_t numBits = bits.numBits;
+  const std::size_t numWords = bits.wordsPerShot();
+  const std::size_t numStates = bits.size();
+
+  // The log-probabilities that a bit in state `b` reads `b`, and the log-ratio
+  // of the probabilities that it reads the other value and `b`.
+  std::vector<double> logStay[2], logFlipRatio[2];
+  for (int b = 0; b < 2; ++b) {
+    const auto &flip =
+        b == 0 ? calibration.prob_1_given_0 : calibration.prob_0_given_1;
+    logStay[b].resize(numBits);
+    logFlipRatio[b].resize(numBits);
+    for (std::size_t q = 0; q < numBits; ++q) {
+      logStay[b][q] = std::log1p(-flip[q]);
+      logFlipRatio[b][q] = std::log(flip[q]) - logStay[b][q];
+    }
+  }
+  std::vector<double> logDiagonal(numStates, 0.0);
+  for (std::size_t j = 0; j < numStates; ++j)
+    for (std::size_t q = 0; q < numBits; ++q)
+      logDiagonal[j] += logStay[bits.bit(j, q)][q];
+
+  std::vector<std::vector<std::pair<std::size_t, double>>> rows(numStates);
+#pragma omp parallel for schedule(dynamic, 64)
+  for (std::size_t i = 0; i < numStates; ++i) {
+    const auto *read = bits.shot(i);
+    for (std::size_t j = 0; j < numStates; ++j) {
+      const auto *state = bits.shot(j);
+      if (hammingDistance(read, state, numWords) > maxDistance)
+        continue;
+      double logProb = logDiagonal[j];
+      for (std::size_t w = 0; w < numWords; ++w)
+        for (auto diff = read[w] ^ state[w]; diff; diff &= diff - 1) {
+          const std::size_t q = 64 * w + std::countr_zero(diff);
+          logProb += logFlipRatio[(state[w] >> (q % 64)) & 1][q];
+        }
+      if (logProb > -std::numeric_limits<double>::infinity())
+        rows[i].emplace_back(j, std::exp(logProb));
+    }
+  }
+
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (std::size_t i = 0; i < numStates; ++i)
+    for (auto [j, prob] : rows[i])
+      triplets.emplace_back(i, j, prob);
+  SparseMatrix matrix(numStates, numStates);
+  matrix.setFromTriplets(triplets.begin(), triplets.end());
+
+  Eigen::VectorXd columnSums =
+      Eigen::RowVectorXd::Ones(numStates) * matrix;
+  for (Eigen::Index i = 0; i < matrix.outerSize(); ++i)
+    for (SparseMatrix::InnerIterator it(matrix, i); it; ++it)
+      it.valueRef() /= columnSums[it.col()];
+  return matrix;
+}
+
+Eigen::VectorXd
+iterativeBayesianUnfolding(const SparseMatrix &matrix,
+                           const Eigen::VectorXd &observed,
+                           const cudaq::readout_mitigation_options &options) {
+  const SparseMatrix transposed = matrix.transpose();
+  Eigen::VectorXd probs = observed;
+  for (std::size_t iter = 0; iter < options.max_iterations; ++iter) {
+    Eigen::VectorXd predicted = matrix * probs;
+    Eigen::VectorXd ratios = Eigen::VectorXd::Zero(observed.size());
+    for (Eigen::Index i = 0; i < observed.size(); ++i)
+      if (predicted[i] > 0.0)
+        ratios[i] = observed[i] / predicted[i];
+    Eigen::VectorXd next = probs.cwiseProduct(transposed * ratios);
+    const double change = (next - probs).lpNorm<Eigen::Infinity>();
+    probs = std::move(next);
+    if (change < options.tolerance)
+      break;
+  }
+  return probs;
+}
+
+Eigen::VectorXd
+leastSquares(const SparseMatrix &matrix, const Eigen::VectorXd &observed,
+             const cudaq::readout_mitigation_options &options) {
+  Eigen::BiCGSTAB<SparseMatrix> solver;
+  solver.setTolerance(options.tolerance);
+  solver.setMaxIterations(options.max_iterations);
+  solver.compute(matrix);
+  Eigen::VectorXd probs = solver.solveWithGuess(observed, observed);
+  if (solver.info() == Eigen::NumericalIssue)
+    throw std::runtime_error(
+        "readout mitigation failed: calibration matrix is singular");
+  return probs;
+}
+} // namespace
+
+namespace cudaq {
+
+readout_calibration
+readout_calibration::from_counts(const sample_result &zeros,
+                                 const sample_result &ones,
+                                 std::string_view registerName) {
+  readout_calibration calibration;
+  calibration.prob_1_given_0 = bitFrequencies(zeros, registerName, '1');
+  calibration.prob_0_given_1 = bitFrequencies(ones, registerName, '0');
+  if (calibration.prob_1_given_0.size() != calibration.prob_0_given_1.size())
+    throw std::runtime_error("readout calibration requires results of the "
+                             "same number of bits");
+  return calibration;
+}
+
+std::unordered_map<std::string, double>
+mitigate_readout(const sample_result &result,
+                 const readout_calibration &calibration,
+                 const readout_mitigation_options &options,
+                 std::string_view registerName) {
+  const auto numBits = calibration.num_bits();
+  if (calibration.prob_0_given_1.size() != numBits)
+    throw std::runtime_error("invalid readout calibration: the error "
+                             "probabilities must cover the same bits");
+  for (std::size_t q = 0; q < numBits; ++q) {
+    const double p10 = calibration.prob_1_given_0[q];
+    const double p01 = calibration.prob_0_given_1[q];
+    if (p10 < 0.0 || p01 < 0.0 || p10 + p01 >= 1.0)
+      throw std::runtime_error(
+          "invalid readout calibration: the error probabilities of bit " +
+          std::to_string(q) + " must be non-negative and sum to less than 1");
+  }
+
+  std::vector<std::string> bitStrings;
+  std::vector<double> counts;
+  double numShots = 0.0;
+  for (const auto &[bits, count] : result.to_map(registerName)) {
+    if (bits.size() != numBits)
+      throw std::runtime_error("readout mitigation requires bit strings of " +
+                               std::to_string(numBits) + " bits");
+    bitStrings.push_back(bits);
+    counts.push_back(count);
+    numShots += count;
+  }
+  if (bitStrings.empty())
+    return {};
+
+  const auto packed = PackedShots::fromBitStrings(bitStrings);
+  const auto matrix =
+      buildCalibrationMatrix(packed, calibration, options.max_hamming_distance);
+  Eigen::VectorXd observed =
+      Eigen::Map<Eigen::VectorXd>(counts.data(), counts.size()) / numShots;
+  const auto probs =
+      options.method == readout_mitigation_method::least_squares
+          ? leastSquares(matrix, observed, options)
+          : iterativeBayesianUnfolding(matrix, observed, options);
+
+  std::unordered_map<std::string, double> mitigated;
+  mitigated.reserve(bitStrings.size());
+  for (std::size_t i = 0; i < bitStrings.size(); ++i)
+    mitigated.emplace(std::move(bitStrings[i]), probs[i]);
+  return mitigated;
+}
+
+} // namespace cudaq
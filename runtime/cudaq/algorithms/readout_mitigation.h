@@ -0,0 +1,75 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/SampleResult.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief The tensored readout calibration of a register: the readout errors
+/// of its bits, assumed to be independent. The probability to read the bit
+/// string `i` when the measured state is `j` is then the product of the
+/// probabilities to read each bit of `i` given the same bit of `j`.
+struct readout_calibration {
+  /// @brief The probability to read 1 for each bit in state 0.
+  std::vector<double> prob_1_given_0;
+  /// @brief The probability to read 0 for each bit in state 1.
+  std::vector<double> prob_0_given_1;
+
+  std::size_t num_bits() const { return prob_1_given_0.size(); }
+
+  /// @brief Estimate the calibration from the results of sampling a kernel
+  /// that prepares all qubits in state 0, `zeros`, and one that prepares all
+  /// of them in state 1, `ones`.
+  static readout_calibration
+  from_counts(const sample_result &zeros, const sample_result &ones,
+              std::string_view registerName = GlobalRegisterName);
+};
+
+enum class readout_mitigation_method {
+  /// Solve for the quasi-probabilities that reproduce the observed ones. The
+  /// result may have small negative entries.
+  least_squares,
+  /// Iterative Bayesian unfolding, which preserves non-negativity.
+  iterative_bayesian
+};
+
+/// @brief Options of `mitigate_readout`.
+struct readout_mitigation_options {
+  readout_mitigation_method method =
+      readout_mitigation_method::iterative_bayesian;
+  /// @brief Only the observed bit strings at most this Hamming distance apart
+  /// are coupled by the readout errors. The neglected transitions are
+  /// accounted for by renormalizing the calibration over the observed bit
+  /// strings.
+  std::size_t max_hamming_distance = 3;
+  /// @brief The maximal number of iterations of the solver.
+  std::size_t max_iterations = 100;
+  /// @brief The tolerance on the change, respectively the residual, of the
+  /// probabilities at which the solver stops.
+  double tolerance = 1e-8;
+};
+
+/// @brief Mitigate the readout errors described by `calibration` in the
+/// counts of the given register of `result`. The mitigated distribution is
+/// restricted to the observed bit strings, so that its cost scales with their
+/// number rather than with the dimension of the register, and is computed in
+/// parallel on the bit-packed bit strings. Return the mitigated probability of
+/// each observed bit string.
+std::unordered_map<std::string, double>
+mitigate_readout(const sample_result &result,
+                 const readout_calibration &calibration,
+                 const readout_mitigation_options &options = {},
+                 std::string_view registerName = GlobalRegisterName);
+
+} // namespace cudaq
@@ -11,6 +11,14 @@
 #include "common/ExecutionContext.h"
 #include "common/Resources.h"
 #include "cudaq/platform.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
 
 namespace nvqir {
 void switchToResourceCounterSimulator();
@@ -45,7 +53,13 @@ Resources run_estimate_resources(KernelFunctor &&wrappedKernel,
   // Set the platform
   platform.set_exec_ctx(ctx.get());
 
-  wrappedKernel();
+  try {
+    wrappedKernel();
+  } catch (...) {
+    platform.reset_exec_ctx();
+    nvqir::stopUsingResourceCounterSimulator();
+    throw;
+  }
 
   platform.reset_exec_ctx();
 
@@ -56,6 +70,150 @@ Resources run_estimate_resources(KernelFunctor &&wrappedKernel,
 
   return counts;
 }
+
+/// @brief Invoke `task(i)` for every `i` in `[0, numTasks)` from up to
+/// `numThreads` worker threads. The first exception thrown by a task is
+/// rethrown once all the workers joined.
+template <typename Task>
+void parallel_for_branches(std::size_t numTasks, std::size_t numThreads,
+                           Task &&task) {
+  numThreads = std::clamp<std::size_t>(numThreads, 1, numTasks);
+  if (numThreads == 1) {
+    for (std::size_t i = 0; i < numTasks; ++i)
+      task(i);
+    return;
+  }
+
+  std::atomic<std::size_t> next = 0;
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (std::size_t t = 0; t < numThreads; ++t)
+    threads.emplace_back([&]() {
+      for (auto i = next++; i < numTasks; i = next++) {
+        try {
+          task(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(errorMutex);
+          if (!error)
+            error = std::current_exception();
+          next = numTasks;
+        }
+      }
+    });
+  for (auto &thread : threads)
+    thread.join();
+  if (error)
+    std::rethrow_exception(error);
+}
+} // namespace details
+
+/// @brief Options controlling how `estimate_resource_statistics` explores the
+/// branches on mid-circuit measurement results of a kernel.
+struct branch_exploration_options {
+  /// @brief Enumerate every measurement-outcome branch of the kernel instead
+  /// of sampling random branches.
+  bool enumerate = false;
+
+  /// @brief The number of sampled branches or, when enumerating, the maximum
+  /// number of branches to enumerate.
+  std::size_t num_branches = 100;
+
+  /// @brief When enumerating, the maximum number of measurements along a
+  /// single branch. This bounds kernels looping on measurement results.
+  std::size_t max_measurements = 64;
+
+  /// @brief The number of worker threads estimating branches concurrently, 0
+  /// to use one thread per hardware thread.
+  std::size_t num_threads = 0;
+};
+
+namespace details {
+/// @brief Estimate the resources of several measurement-outcome branches of
+/// the input KernelFunctor in parallel. Every worker thread uses its own
+/// resource counter simulator and execution manager.
+template <typename KernelFunctor>
+ResourceStatistics
+run_estimate_resource_statistics(KernelFunctor &&wrappedKernel,
+                                 quantum_platform &platform,
+                                 const std::string &kernelName,
+                                 const branch_exploration_options &options) {
+  std::size_t numThreads = options.num_threads
+                               ? options.num_threads
+                               : std::thread::hardware_concurrency();
+  // Remote QPUs compile and count the kernel through a shared connection.
+  if (platform.is_remote())
+    numThreads = 1;
+
+  std::vector<Resources> branches;
+  std::vector<double> probabilities;
+
+  if (!options.enumerate) {
+    const std::size_t numBranches = options.num_branches;
+    const auto seed = cudaq::get_random_seed();
+    std::vector<std::optional<Resources>> results(numBranches);
+    parallel_for_branches(numBranches, numThreads, [&](std::size_t i) {
+      std::mt19937 gen(seed + i);
+      std::uniform_int_distribution<> rand(0, 1);
+      results[i].emplace(run_estimate_resources(
+          wrappedKernel, platform, kernelName, [&]() { return rand(gen); }));
+    });
+    for (auto &result : results)
+      branches.push_back(std::move(*result));
+    probabilities.assign(numBranches, 1. / numBranches);
+    return ResourceStatistics(std::move(branches), std::move(probabilities));
+  }
+
+  // Enumerate the branches breadth first. A branch is identified by a prefix
+  // of measurement outcomes, the measurements past the prefix return false.
+  // Each branch then spawns one new branch for each of these measurements.
+  std::vector<std::vector<bool>> wave{{}};
+  while (!wave.empty()) {
+    if (branches.size() + wave.size() > options.num_branches)
+      throw std::runtime_error(
+          "The kernel " + kernelName + " has more than " +
+          std::to_string(options.num_branches) +
+          " measurement-outcome branches. Increase `num_branches` or sample "
+          "the branches instead of enumerating them.");
+
+    std::vector<std::optional<Resources>> results(wave.size());
+    std::vector<std::vector<bool>> outcomes(wave.size());
+    parallel_for_branches(wave.size(), numThreads, [&](std::size_t i) {
+      auto &branchOutcomes = outcomes[i];
+      branchOutcomes = wave[i];
+      std::size_t next = 0;
+      auto choice = [&]() {
+        if (next < branchOutcomes.size())
+          return static_cast<bool>(branchOutcomes[next++]);
+        if (next++ >= options.max_measurements)
+          throw std::runtime_error(
+              "The kernel " + kernelName + " performs more than " +
+              std::to_string(options.max_measurements) +
+              " measurements on a single branch. Increase `max_measurements` "
+              "or sample the branches instead of enumerating them.");
+        branchOutcomes.push_back(false);
+        return false;
+      };
+      results[i].emplace(
+          run_estimate_resources(wrappedKernel, platform, kernelName, choice));
+    });
+
+    std::vector<std::vector<bool>> nextWave;
+    for (std::size_t i = 0; i < wave.size(); ++i) {
+      branches.push_back(std::move(*results[i]));
+      const int numOutcomes = outcomes[i].size();
+      probabilities.push_back(std::ldexp(1., -numOutcomes));
+      for (std::size_t j = wave[i].size(); j < outcomes[i].size(); ++j) {
+        auto &prefix = nextWave.emplace_back(outcomes[i].begin(),
+                                             outcomes[i].begin() + j);
+        prefix.push_back(true);
+      }
+    }
+    wave = std::move(nextWave);
+  }
+  return ResourceStatistics(std::move(branches), std::move(probabilities));
+}
 } // namespace details
 
 /// @brief Given any CUDA-Q kernel and its associated runtime arguments,
@@ -65,7 +223,9 @@ Resources run_estimate_resources(KernelFunctor &&wrappedKernel,
 /// types of operations in the kernel. By default, any measurement will return
 /// `true` or `false` with 50% probability. To estimate resources for specific
 /// paths based on measurements, supply a choice function to the overloaded
-/// version of this function.
+/// version of this function. On targets which compile the kernels with their
+/// arguments, a kernel with static control flow is not traced at all: its
+/// resources, including its circuit depth, are computed at compilation time.
 template <typename QuantumKernel, typename... Args>
   requires std::invocable<QuantumKernel &, Args...>
 Resources estimate_resources(QuantumKernel &&kernel, Args &&...args) {
@@ -101,4 +261,26 @@ Resources estimate_resources(std::function<bool()> choice,
       kernelName, choice);
 }
 
+/// @brief Given any CUDA-Q kernel and its associated runtime arguments,
+/// return statistics of the resources this kernel uses over the branches on
+/// its mid-circuit measurement results. Branches are either sampled, with
+/// every measurement returning `true` or `false` with 50% probability, or
+/// enumerated exhaustively. The branches are estimated concurrently by worker
+/// threads, each tracing the kernel with its own resource counter. The mean
+/// counts are the expected counts when every measurement outcome is equally
+/// likely.
+///
+/// @param options Selects sampling or enumeration of the branches, the number
+///                of branches and the number of worker threads.
+template <typename QuantumKernel, typename... Args>
+  requires std::invocable<QuantumKernel &, Args &...>
+ResourceStatistics
+estimate_resource_statistics(const branch_exploration_options &options,
+                             QuantumKernel &&kernel, Args &&...args) {
+  auto &platform = cudaq::get_platform();
+  auto kernelName = cudaq::getKernelName(kernel);
+  return details::run_estimate_resource_statistics(
+      [&]() { kernel(args...); }, platform, kernelName, options);
+}
+
 } // namespace cudaq
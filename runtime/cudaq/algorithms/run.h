@@ -201,7 +201,7 @@ run(std::size_t shots, cudaq::noise_model &noise_model, QuantumKernel &&kernel,
 /// QPU
 /// @tparam QuantumKernel Quantum kernel type (must return a non-void result)
 /// @tparam ...ARGS Quantum kernel argument types
-/// @param qpu_id QPU to launch
+/// @param qpu_id QPU to launch, or `cudaq::any_qpu` to let the platform choose
 /// @param shots Number of shots to run
 /// @param kernel Quantum kernel
 /// @param ...args Kernel arguments
@@ -215,6 +215,8 @@ run_async(std::size_t qpu_id, std::size_t shots, QuantumKernel &&kernel,
           ARGS &&...args) {
   auto &platform = cudaq::get_platform();
 
+  if (qpu_id == any_qpu)
+    qpu_id = platform.select_qpu();
   if (qpu_id >= platform.num_qpus())
     throw std::invalid_argument(
         "Provided qpu_id is invalid (must be <= to platform.num_qpus()).");
@@ -224,38 +226,38 @@ run_async(std::size_t qpu_id, std::size_t shots, QuantumKernel &&kernel,
       std::invoke_result_t<std::decay_t<QuantumKernel>, std::decay_t<ARGS>...>;
   std::promise<std::vector<ResultTy>> promise;
   auto fut = promise.get_future();
-  QuantumTask wrapped = detail::make_copyable_function(
-      [p = std::move(promise), qpu_id, shots, &platform, &kernel,
-       ... args = std::forward<ARGS>(args)]() mutable {
-        if (shots == 0) {
-          p.set_value({});
-          return;
-        }
+  QuantumTask wrapped = [p = std::move(promise), qpu_id, shots, &platform,
+                         &kernel,
+                         ... args = std::forward<ARGS>(args)]() mutable {
+    if (shots == 0) {
+      p.set_value({});
+      return;
+    }
 #ifdef CUDAQ_LIBRARY_MODE
-        // Direct kernel invocation loop for library mode
-        std::vector<ResultTy> res;
-        auto ctx = std::make_unique<cudaq::ExecutionContext>("run", 1, qpu_id);
-        res.reserve(shots);
-        for (std::size_t i = 0; i < shots; ++i) {
-          platform.set_exec_ctx(ctx.get());
-          res.emplace_back(kernel(std::forward<ARGS>(args)...));
-          platform.reset_exec_ctx();
-        }
-        p.set_value(std::move(res));
+    // Direct kernel invocation loop for library mode
+    std::vector<ResultTy> res;
+    auto ctx = std::make_unique<cudaq::ExecutionContext>("run", 1, qpu_id);
+    res.reserve(shots);
+    for (std::size_t i = 0; i < shots; ++i) {
+      platform.set_exec_ctx(ctx.get());
+      res.emplace_back(kernel(std::forward<ARGS>(args)...));
+      platform.reset_exec_ctx();
+    }
+    p.set_value(std::move(res));
 #else
-        const std::string kernelName{details::getKernelName(kernel)};
-        details::RunResultSpan span = details::runTheKernel(
-            [&]() mutable {
-              auto *runKernel =
-                  details::get_run_entry_point(qkernel{kernel}, kernelName);
-              (*runKernel)(std::forward<ARGS>(args)...);
-            },
-            platform, kernelName, kernelName, shots, qpu_id);
-        std::vector<ResultTy> results;
-        details::resultSpanToVectorViaOwnership<ResultTy>(results, span);
-        p.set_value(std::move(results));
+    const std::string kernelName{details::getKernelName(kernel)};
+    details::RunResultSpan span = details::runTheKernel(
+        [&]() mutable {
+          auto *runKernel =
+              details::get_run_entry_point(qkernel{kernel}, kernelName);
+          (*runKernel)(std::forward<ARGS>(args)...);
+        },
+        platform, kernelName, kernelName, shots, qpu_id);
+    std::vector<ResultTy> results;
+    details::resultSpanToVectorViaOwnership<ResultTy>(results, span);
+    p.set_value(std::move(results));
 #endif
-      });
+  };
   platform.enqueueAsyncTask(qpu_id, wrapped);
   return fut;
 }
@@ -264,7 +266,7 @@ run_async(std::size_t qpu_id, std::size_t shots, QuantumKernel &&kernel,
 /// specific QPU
 /// @tparam QuantumKernel Quantum kernel type (must return a non-void result)
 /// @tparam ...ARGS Quantum kernel argument types
-/// @param qpu_id QPU to launch
+/// @param qpu_id QPU to launch, or `cudaq::any_qpu` to let the platform choose
 /// @param shots Number of shots to run
 /// @param noise_model Noise model to use for noisy simulation
 /// @param kernel Quantum kernel
@@ -280,6 +282,8 @@ run_async(std::size_t qpu_id, std::size_t shots,
           ARGS &&...args) {
   auto &platform = cudaq::get_platform();
 
+  if (qpu_id == any_qpu)
+    qpu_id = platform.select_qpu();
   if (qpu_id >= platform.num_qpus())
     throw std::invalid_argument(
         "Provided qpu_id is invalid (must be <= to platform.num_qpus()).");
@@ -292,42 +296,42 @@ run_async(std::size_t qpu_id, std::size_t shots,
       std::invoke_result_t<std::decay_t<QuantumKernel>, std::decay_t<ARGS>...>;
   std::promise<std::vector<ResultTy>> promise;
   auto fut = promise.get_future();
-  QuantumTask wrapped = detail::make_copyable_function(
-      [p = std::move(promise), qpu_id, shots, &noise_model, &platform, &kernel,
-       ... args = std::forward<ARGS>(args)]() mutable {
-        if (shots == 0) {
-          p.set_value({});
-          return;
-        }
+  QuantumTask wrapped = [p = std::move(promise), qpu_id, shots, &noise_model,
+                         &platform, &kernel,
+                         ... args = std::forward<ARGS>(args)]() mutable {
+    if (shots == 0) {
+      p.set_value({});
+      return;
+    }
 #ifdef CUDAQ_LIBRARY_MODE
-        // Direct kernel invocation loop for library mode
-        platform.set_noise(&noise_model);
-        auto ctx = std::make_unique<cudaq::ExecutionContext>("run", 1, qpu_id);
-        std::vector<ResultTy> res;
-        res.reserve(shots);
-        for (std::size_t i = 0; i < shots; ++i) {
-          platform.set_exec_ctx(ctx.get());
-          res.emplace_back(kernel(std::forward<ARGS>(args)...));
-          platform.reset_exec_ctx();
-        }
-        platform.reset_noise();
-        p.set_value(std::move(res));
+    // Direct kernel invocation loop for library mode
+    platform.set_noise(&noise_model);
+    auto ctx = std::make_unique<cudaq::ExecutionContext>("run", 1, qpu_id);
+    std::vector<ResultTy> res;
+    res.reserve(shots);
+    for (std::size_t i = 0; i < shots; ++i) {
+      platform.set_exec_ctx(ctx.get());
+      res.emplace_back(kernel(std::forward<ARGS>(args)...));
+      platform.reset_exec_ctx();
+    }
+    platform.reset_noise();
+    p.set_value(std::move(res));
 #else
-        platform.set_noise(&noise_model);
-        const std::string kernelName{details::getKernelName(kernel)};
-        details::RunResultSpan span = details::runTheKernel(
-            [&]() mutable {
-              auto *runKernel =
-                  details::get_run_entry_point(qkernel{kernel}, kernelName);
-              (*runKernel)(std::forward<ARGS>(args)...);
-            },
-            platform, kernelName, kernelName, shots, qpu_id);
-        platform.reset_noise();
-        std::vector<ResultTy> results;
-        details::resultSpanToVectorViaOwnership<ResultTy>(results, span);
-        p.set_value(std::move(results));
+    platform.set_noise(&noise_model);
+    const std::string kernelName{details::getKernelName(kernel)};
+    details::RunResultSpan span = details::runTheKernel(
+        [&]() mutable {
+          auto *runKernel =
+              details::get_run_entry_point(qkernel{kernel}, kernelName);
+          (*runKernel)(std::forward<ARGS>(args)...);
+        },
+        platform, kernelName, kernelName, shots, qpu_id);
+    platform.reset_noise();
+    std::vector<ResultTy> results;
+    details::resultSpanToVectorViaOwnership<ResultTy>(results, span);
+    p.set_value(std::move(results));
 #endif
-      });
+  };
   platform.enqueueAsyncTask(qpu_id, wrapped);
   return fut;
 }
@@ -9,10 +9,12 @@
 #pragma once
 
 #include "common/ExecutionContext.h"
+#include "common/Profiler.h"
 #include "common/SampleResult.h"
 #include "cudaq/algorithms/broadcast.h"
 #include "cudaq/concepts.h"
 #include "cudaq/host_config.h"
+#include <functional>
 
 constexpr int DEFAULT_NUM_SHOTS = 1000;
 
@@ -33,14 +35,27 @@ concept SampleCallValid =
 
 namespace details {
 
+/// @brief The outcome of an execution of a `sample` broadcast, whose result
+/// the simulator may defer to the last execution on the QPU.
+struct BatchedSampling {
+  /// @brief Whether the result of the execution was deferred.
+  bool deferred = false;
+  /// @brief The results of the deferred executions on the QPU, in execution
+  /// order, returned by its last execution.
+  std::vector<sample_result> results;
+};
+
 /// @brief Take the input KernelFunctor (a lambda that captures runtime
 /// arguments and invokes the quantum kernel) and invoke the sampling process.
+/// If `batched` is given, the result of the execution may be deferred, an
+/// empty result is then returned.
 template <typename KernelFunctor>
 std::optional<sample_result>
 runSampling(KernelFunctor &&wrappedKernel, quantum_platform &platform,
             const std::string &kernelName, int shots, bool explicitMeasurements,
             std::size_t qpu_id = 0, details::future *futureResult = nullptr,
-            std::size_t batchIteration = 0, std::size_t totalBatchIters = 0) {
+            std::size_t batchIteration = 0, std::size_t totalBatchIters = 0,
+            BatchedSampling *batched = nullptr) {
 
   if (cudaq::kernelHasConditionalFeedback(kernelName))
     throw std::runtime_error(
@@ -60,6 +75,7 @@ runSampling(KernelFunctor &&wrappedKernel, quantum_platform &platform,
   ctx->batchIteration = batchIteration;
   ctx->totalIterations = totalBatchIters;
   ctx->explicitMeasurements = explicitMeasurements;
+  ctx->batchedSampling = batched != nullptr;
 
 #ifdef CUDAQ_LIBRARY_MODE
   // If we have a kernel that has its quake code registered, we
@@ -109,10 +125,21 @@ runSampling(KernelFunctor &&wrappedKernel, quantum_platform &platform,
     }
     platform.reset_exec_ctx();
 
+    if (batched) {
+      for (auto &result : ctx->deferredResults)
+        batched->results.push_back(std::move(result));
+      ctx->deferredResults.clear();
+      if (ctx->resultDeferred) {
+        batched->deferred = true;
+        return counts;
+      }
+    }
+
     // If target is hardware backend, need to launch only once, hence exit early
     if (isQuantumDevice)
       return ctx->result;
 
+    profiler::ScopedPhase phase(profiler::Phase::result_assembly, kernelName);
     if (counts.get_total_shots() == 0)
       counts = std::move(ctx->result); // optimize for first iteration
     else
@@ -132,6 +159,7 @@ runSampling(KernelFunctor &&wrappedKernel, quantum_platform &platform,
     // Reset the context for the next round,
     // don't need to reset on the last exec
     if (counts.get_total_shots() < static_cast<std::size_t>(shots)) {
+      ctx->shotsCompleted = counts.get_total_shots();
       platform.set_exec_ctx(ctx.get());
     }
   }
@@ -147,6 +175,8 @@ auto runSamplingAsync(KernelFunctor &&wrappedKernel, quantum_platform &platform,
                       const std::string &kernelName, int shots,
                       bool explicitMeasurements = false,
                       std::size_t qpu_id = 0) {
+  if (qpu_id == any_qpu)
+    qpu_id = platform.select_qpu();
   if (qpu_id >= platform.num_qpus()) {
     throw std::invalid_argument("Provided qpu_id " + std::to_string(qpu_id) +
                                 " is invalid (must be < " +
@@ -176,6 +206,59 @@ auto runSamplingAsync(KernelFunctor &&wrappedKernel, quantum_platform &platform,
   return async_sample_result(
       details::future(platform.enqueueAsyncTask(qpu_id, task)));
 }
+
+/// @brief Broadcast the sampling of the kernel over the argument sets
+/// `params`. The simulator may defer the results of the executions on a QPU
+/// to its last execution, so as to simulate them as one batch, these results
+/// are then put back in place of the deferred ones.
+template <typename QuantumKernel, typename... Args>
+std::vector<sample_result>
+runBroadcastSampling(QuantumKernel &kernel, quantum_platform &platform,
+                     std::size_t shots, bool explicitMeasurements,
+                     ArgumentSet<Args...> &params) {
+  auto numQpus = platform.num_qpus();
+
+  // The executions of each QPU whose result was deferred, and the results of
+  // these executions. Each is only accessed by the thread of its QPU.
+  std::vector<std::vector<std::size_t>> deferred(numQpus);
+  std::vector<std::vector<sample_result>> deferredResults(numQpus);
+
+  // Create the functor that will broadcast the sampling tasks across
+  // all requested argument sets provided.
+  BroadcastFunctorType<sample_result, Args...> functor =
+      [&](std::size_t qpuId, std::size_t counter, std::size_t N,
+          Args &...singleIterParameters) -> sample_result {
+    auto kernelName = cudaq::getKernelName(kernel);
+    BatchedSampling batched;
+    auto ret = runSampling(
+                   [&kernel, &singleIterParameters...]() mutable {
+                     kernel(std::forward<Args>(singleIterParameters)...);
+                   },
+                   platform, kernelName, shots, explicitMeasurements, qpuId,
+                   nullptr, counter, N, &batched)
+                   .value();
+    if (batched.deferred)
+      deferred[qpuId].push_back(counter);
+    for (auto &result : batched.results)
+      deferredResults[qpuId].push_back(std::move(result));
+    return ret;
+  };
+
+  // Broadcast the executions, then fill in the deferred results.
+  std::vector<std::vector<std::size_t>> executionIndices;
+  auto results = broadcastFunctionOverArguments<sample_result, Args...>(
+      numQpus, platform, functor, params, &executionIndices);
+  for (std::size_t qpuId = 0; qpuId < numQpus; ++qpuId) {
+    if (deferred[qpuId].size() != deferredResults[qpuId].size())
+      throw std::runtime_error(
+          "The results of the batched executions on QPU " +
+          std::to_string(qpuId) + " do not match their deferred executions.");
+    for (std::size_t k = 0; k < deferred[qpuId].size(); ++k)
+      results[executionIndices[qpuId][deferred[qpuId][k]]] =
+          std::move(deferredResults[qpuId][k]);
+  }
+  return results;
+}
 } // namespace details
 
 /// @brief Sample options to provide to the sample() / async_sample() functions
@@ -290,11 +373,76 @@ sample_result sample(const sample_options &options, QuantumKernel &&kernel,
   return ret;
 }
 
+/// @brief Options for streaming sampling with `cudaq::sample_stream`.
+struct sample_stream_options {
+  std::size_t shots = DEFAULT_NUM_SHOTS;
+  /// @brief Maximum number of shots sampled, and delivered, at once.
+  std::size_t chunk_shots = 1 << 16;
+  cudaq::noise_model noise;
+  bool explicit_measurements = false;
+};
+
+/// @brief Callback receiving the bit-packed shots of the global register of
+/// every chunk sampled by `cudaq::sample_stream`.
+using sample_chunk_callback = std::function<void(const PackedShots &)>;
+
+/// @brief Sample the given quantum kernel expression in chunks of at most
+/// `options.chunk_shots` shots, delivering the shots of every chunk to
+/// `onChunk` and returning the accumulated counts, without sequential data.
+///
+/// @param options Streaming sample options.
+/// @param onChunk The callback receiving the shots of every chunk, in order.
+/// May be empty to only accumulate the counts.
+/// @param kernel The kernel expression, must contain final measurements.
+/// @param args The variadic concrete arguments for evaluation of the kernel.
+/// @returns The counts dictionary.
+///
+/// @details The shots of a chunk are only valid during the callback, hence the
+///          memory used is proportional to the chunk size and the number of
+///          distinct bit strings observed, regardless of the number of shots.
+template <typename QuantumKernel, typename... Args>
+  requires SampleCallValid<QuantumKernel, Args...>
+sample_result sample_stream(const sample_stream_options &options,
+                            const sample_chunk_callback &onChunk,
+                            QuantumKernel &&kernel, Args &&...args) {
+  if (options.chunk_shots == 0)
+    throw std::runtime_error("The sampling option `chunk_shots` must be "
+                             "positive.");
+
+  if constexpr (has_name<QuantumKernel>::value) {
+    static_cast<cudaq::details::kernel_builder_base &>(kernel).jitCode();
+  }
+
+  auto &platform = cudaq::get_platform();
+  auto kernelName = cudaq::getKernelName(kernel);
+  platform.set_noise(&options.noise);
+  sample_result counts;
+  for (std::size_t done = 0; done < options.shots;) {
+    const auto shots = std::min(options.chunk_shots, options.shots - done);
+    auto chunk = details::runSampling(
+                     [&]() mutable { kernel(args...); }, platform, kernelName,
+                     shots, options.explicit_measurements)
+                     .value();
+    if (onChunk) {
+      if (chunk.has_packed_sequential_data())
+        onChunk(chunk.packed_sequential_data());
+      else
+        onChunk(PackedShots::fromBitStrings(chunk.sequential_data()));
+    }
+    chunk.discard_sequential_data();
+    counts += chunk;
+    done += shots;
+  }
+  platform.reset_noise();
+  return counts;
+}
+
 /// @brief Sample the given kernel expression asynchronously and return
 /// the mapping of observed bit strings to corresponding number of
 /// times observed.
 ///
-/// @param qpu_id The id of the QPU to run asynchronously on.
+/// @param qpu_id The id of the QPU to run asynchronously on, or
+/// `cudaq::any_qpu` to let the platform choose the QPU.
 /// @param kernel The kernel expression, must contain final measurements.
 /// @param args The variadic concrete arguments for evaluation of the kernel.
 /// @returns A `std::future` containing the resultant counts
@@ -330,7 +478,8 @@ async_sample_result sample_async(const std::size_t qpu_id,
 /// times observed.
 ///
 /// @param shots The number of samples to collect.
-/// @param qpu_id The id of the QPU to run asynchronously on.
+/// @param qpu_id The id of the QPU to run asynchronously on, or
+/// `cudaq::any_qpu` to let the platform choose the QPU.
 /// @param kernel The kernel expression, must contain final measurements.
 /// @param args The variadic concrete arguments for evaluation of the kernel.
 /// @returns A `std::future` containing the resultant counts
@@ -366,7 +515,8 @@ async_sample_result sample_async(std::size_t shots, std::size_t qpu_id,
 /// times observed.
 ///
 /// @param options Sample options.
-/// @param qpu_id The id of the QPU to run asynchronously on.
+/// @param qpu_id The id of the QPU to run asynchronously on, or
+/// `cudaq::any_qpu` to let the platform choose the QPU.
 /// @param kernel The kernel expression, must contain final measurements.
 /// @param args The variadic concrete arguments for evaluation of the kernel.
 /// @returns A `std::future` containing the resultant counts
@@ -431,29 +581,12 @@ template <typename QuantumKernel, typename... Args>
   requires SampleCallValid<QuantumKernel, Args...>
 std::vector<sample_result> sample(QuantumKernel &&kernel,
                                   ArgumentSet<Args...> &&params) {
-  // Get the platform and query the number of qpus
+  // Get the platform
   auto &platform = cudaq::get_platform();
-  auto numQpus = platform.num_qpus();
-
-  // Create the functor that will broadcast the sampling tasks across
-  // all requested argument sets provided.
-  details::BroadcastFunctorType<sample_result, Args...> functor =
-      [&](std::size_t qpuId, std::size_t counter, std::size_t N,
-          Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
-    auto ret = details::runSampling(
-                   [&kernel, &singleIterParameters...]() mutable {
-                     kernel(std::forward<Args>(singleIterParameters)...);
-                   },
-                   platform, kernelName, /*shots=*/DEFAULT_NUM_SHOTS,
-                   /*explicitMeasurements=*/false, qpuId, nullptr, counter, N)
-                   .value();
-    return ret;
-  };
 
   // Broadcast the executions and return the results.
-  return details::broadcastFunctionOverArguments<sample_result, Args...>(
-      numQpus, platform, functor, params);
+  return details::runBroadcastSampling(kernel, platform, DEFAULT_NUM_SHOTS,
+                                       /*explicitMeasurements=*/false, params);
 }
 
 /// @brief Run the standard sample functionality over a set of N
@@ -468,29 +601,12 @@ template <typename QuantumKernel, typename... Args>
   requires SampleCallValid<QuantumKernel, Args...>
 std::vector<sample_result> sample(std::size_t shots, QuantumKernel &&kernel,
                                   ArgumentSet<Args...> &&params) {
-  // Get the platform and query the number of QPUs
+  // Get the platform
   auto &platform = cudaq::get_platform();
-  auto numQpus = platform.num_qpus();
-
-  // Create the functor that will broadcast the sampling tasks across
-  // all requested argument sets provided.
-  details::BroadcastFunctorType<sample_result, Args...> functor =
-      [&](std::size_t qpuId, std::size_t counter, std::size_t N,
-          Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
-    auto ret = details::runSampling(
-                   [&kernel, &singleIterParameters...]() mutable {
-                     kernel(std::forward<Args>(singleIterParameters)...);
-                   },
-                   platform, kernelName, shots, /*explicitMeasurements=*/false,
-                   qpuId, nullptr, counter, N)
-                   .value();
-    return ret;
-  };
 
   // Broadcast the executions and return the results.
-  return details::broadcastFunctionOverArguments<sample_result, Args...>(
-      numQpus, platform, functor, params);
+  return details::runBroadcastSampling(kernel, platform, shots,
+                                       /*explicitMeasurements=*/false, params);
 }
 
 /// @brief Run the standard sample functionality over a set of N
@@ -506,33 +622,13 @@ template <typename QuantumKernel, typename... Args>
 std::vector<sample_result> sample(const sample_options &options,
                                   QuantumKernel &&kernel,
                                   ArgumentSet<Args...> &&params) {
-  // Get the platform and query the number of qpus
+  // Get the platform
   auto &platform = cudaq::get_platform();
-  auto numQpus = platform.num_qpus();
-  auto shots = options.shots;
-
   platform.set_noise(&options.noise);
 
-  // Create the functor that will broadcast the sampling tasks across
-  // all requested argument sets provided.
-  details::BroadcastFunctorType<sample_result, Args...> functor =
-      [&, explicit_mz = options.explicit_measurements](
-          std::size_t qpuId, std::size_t counter, std::size_t N,
-          Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
-    auto ret = details::runSampling(
-                   [&kernel, &singleIterParameters...]() mutable {
-                     kernel(std::forward<Args>(singleIterParameters)...);
-                   },
-                   platform, kernelName, shots, explicit_mz, qpuId, nullptr,
-                   counter, N)
-                   .value();
-    return ret;
-  };
-
   // Broadcast the executions and return the results.
-  auto ret = details::broadcastFunctionOverArguments<sample_result, Args...>(
-      numQpus, platform, functor, params);
+  auto ret = details::runBroadcastSampling(
+      kernel, platform, options.shots, options.explicit_measurements, params);
 
   platform.reset_noise();
   return ret;
@@ -549,29 +645,12 @@ template <typename QuantumKernel, typename... Args>
   requires SampleCallValid<QuantumKernel, Args...>
 [[deprecated("Use sample() overload instead")]] std::vector<sample_result>
 sample_n(QuantumKernel &&kernel, ArgumentSet<Args...> &&params) {
-  // Get the platform and query the number of qpus
+  // Get the platform
   auto &platform = cudaq::get_platform();
-  auto numQpus = platform.num_qpus();
-
-  // Create the functor that will broadcast the sampling tasks across
-  // all requested argument sets provided.
-  details::BroadcastFunctorType<sample_result, Args...> functor =
-      [&](std::size_t qpuId, std::size_t counter, std::size_t N,
-          Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
-    auto ret = details::runSampling(
-                   [&kernel, &singleIterParameters...]() mutable {
-                     kernel(std::forward<Args>(singleIterParameters)...);
-                   },
-                   platform, kernelName, /*shots=*/DEFAULT_NUM_SHOTS,
-                   /*explicitMeasurements=*/false, qpuId, nullptr, counter, N)
-                   .value();
-    return ret;
-  };
 
   // Broadcast the executions and return the results.
-  return details::broadcastFunctionOverArguments<sample_result, Args...>(
-      numQpus, platform, functor, params);
+  return details::runBroadcastSampling(kernel, platform, DEFAULT_NUM_SHOTS,
+                                       /*explicitMeasurements=*/false, params);
 }
 
 /// @brief Run the standard sample functionality over a set of N
@@ -587,28 +666,11 @@ template <typename QuantumKernel, typename... Args>
 [[deprecated("Use sample() overload instead")]] std::vector<sample_result>
 sample_n(std::size_t shots, QuantumKernel &&kernel,
          ArgumentSet<Args...> &&params) {
-  // Get the platform and query the number of qpus
+  // Get the platform
   auto &platform = cudaq::get_platform();
-  auto numQpus = platform.num_qpus();
-
-  // Create the functor that will broadcast the sampling tasks across
-  // all requested argument sets provided.
-  details::BroadcastFunctorType<sample_result, Args...> functor =
-      [&](std::size_t qpuId, std::size_t counter, std::size_t N,
-          Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
-    auto ret = details::runSampling(
-                   [&kernel, &singleIterParameters...]() mutable {
-                     kernel(std::forward<Args>(singleIterParameters)...);
-                   },
-                   platform, kernelName, shots, /*explicitMeasurements=*/false,
-                   qpuId, nullptr, counter, N)
-                   .value();
-    return ret;
-  };
 
   // Broadcast the executions and return the results.
-  return details::broadcastFunctionOverArguments<sample_result, Args...>(
-      numQpus, platform, functor, params);
+  return details::runBroadcastSampling(kernel, platform, shots,
+                                       /*explicitMeasurements=*/false, params);
 }
 } // namespace cudaq
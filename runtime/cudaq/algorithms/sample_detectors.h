@@ -0,0 +1,203 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "cudaq/algorithms/sample.h"
+#include <functional>
+#include <future>
+
+namespace cudaq {
+
+/// @brief A detector, or a logical observable, is the parity of a set of
+/// measurements. The measurements are identified by their position in the
+/// kernel's measurement record, i.e., in the order in which they are
+/// performed.
+using measurement_parity = std::vector<std::size_t>;
+
+/// @brief Options to provide to `sample_detectors()`.
+///
+/// @param shots number of shots to run for the given kernel
+/// @param chunk_size number of shots handed to the callback at once
+/// @param noise noise model to use for the sample operation
+/// @param detectors the detectors to evaluate for every shot
+/// @param observables the logical observables to evaluate for every shot
+struct detector_sampling_options {
+  std::size_t shots = DEFAULT_NUM_SHOTS;
+  std::size_t chunk_size = 1 << 16;
+  cudaq::noise_model noise;
+  std::vector<measurement_parity> detectors;
+  std::vector<measurement_parity> observables;
+};
+
+/// @brief A chunk of shots produced by `sample_detectors()`. Bit `i` of a
+/// shot's `detection_events` is set if detector `i` differs from its value in
+/// the noiseless circuit, and likewise for `observable_flips`.
+struct detector_samples {
+  /// Index of the first shot of this chunk
+  std::size_t first_shot = 0;
+
+  /// Detection events, one row per shot
+  PackedShots detection_events;
+
+  /// Flips of the logical observables, one row per shot
+  PackedShots observable_flips;
+};
+
+/// @brief Callback receiving the chunks of `sample_detectors()`.
+using detector_callback = std::function<void(const detector_samples &)>;
+
+namespace details {
+
+/// @brief Return the measurement record of the given sample result in
+/// bit-packed form.
+inline PackedShots getMeasurementRecord(const sample_result &result) {
+  if (result.has_packed_sequential_data())
+    return result.packed_sequential_data();
+  // Fall back to the bit strings of simulators without packed results.
+  const auto bitStrings = result.sequential_data();
+  PackedShots record(bitStrings.empty() ? 0 : bitStrings.front().size());
+  record.words.resize(bitStrings.size() * record.wordsPerShot(), 0);
+  for (std::size_t s = 0; s < bitStrings.size(); ++s) {
+    auto *shot = record.words.data() + s * record.wordsPerShot();
+    for (std::size_t b = 0; b < record.numBits; ++b)
+      if (bitStrings[s][b] == '1')
+        shot[b / 64] |= std::uint64_t(1) << (b % 64);
+  }
+  return record;
+}
+
+/// @brief Evaluate the given parities on every shot of the measurement
+/// record, relative to the reference values `reference` (one per parity).
+inline PackedShots
+evaluateParities(const PackedShots &record,
+                 const std::vector<measurement_parity> &parities,
+                 const std::vector<bool> &reference) {
+  for (const auto &parity : parities)
+    for (auto idx : parity)
+      if (idx >= record.numBits)
+        throw std::runtime_error(
+            "detector references measurement " + std::to_string(idx) +
+            ", but the kernel only performs " +
+            std::to_string(record.numBits) + " measurements");
+
+  PackedShots result(parities.size());
+  const auto wordsPerShot = result.wordsPerShot();
+  result.words.resize(record.size() * wordsPerShot, 0);
+  for (std::size_t s = 0; s < record.size(); ++s) {
+    const auto *in = record.shot(s);
+    auto *out = result.words.data() + s * wordsPerShot;
+    for (std::size_t p = 0; p < parities.size(); ++p) {
+      bool value = !reference.empty() && reference[p];
+      for (auto idx : parities[p])
+        value ^= (in[idx / 64] >> (idx % 64)) & 1;
+      if (value)
+        out[p / 64] |= std::uint64_t(1) << (p % 64);
+    }
+  }
+  return result;
+}
+
+/// @brief Return the value of each of the given parities on the first shot
+/// of the packed measurement record.
+inline std::vector<bool>
+getReferenceParities(const PackedShots &record,
+                     const std::vector<measurement_parity> &parities) {
+  if (record.size() == 0)
+    throw std::runtime_error("detector sampling requires a kernel with "
+                             "measurements");
+  const auto values = evaluateParities(record, parities, {});
+  std::vector<bool> reference(parities.size());
+  for (std::size_t p = 0; p < parities.size(); ++p)
+    reference[p] = values.bit(0, p);
+  return reference;
+}
+} // namespace details
+
+/// @brief Sample the given quantum kernel and stream the detection events and
+/// logical observable flips of every shot to `callback`, in chunks of
+/// `options.chunk_size` shots.
+///
+/// @param options Detector sampling options.
+/// @param callback Receives the chunks, in order.
+/// @param kernel The kernel expression, must contain measurements.
+/// @param args The variadic concrete arguments for evaluation of the kernel.
+///
+/// @details The reference value of the detectors and observables is taken
+///          from one noiseless execution of the kernel. Chunks are sampled
+///          with explicit measurements, so that the measurement record holds
+///          every measurement in execution order. The callback runs on a
+///          separate thread while the next chunk is sampled, so that the
+///          processing of a chunk, e.g., decoding, overlaps with sampling.
+///          At most one callback invocation is in flight at any time.
+template <typename QuantumKernel, typename... Args>
+  requires SampleCallValid<QuantumKernel, Args...>
+void sample_detectors(const detector_sampling_options &options,
+                      const detector_callback &callback, QuantumKernel &&kernel,
+                      Args &&...args) {
+  if (options.chunk_size == 0)
+    throw std::runtime_error("detector sampling requires a non-zero chunk "
+                             "size");
+
+  // Need the code to be lowered to llvm and the kernel to be registered
+  // so that we can check for conditional feedback / mid circ measurement
+  if constexpr (has_name<QuantumKernel>::value) {
+    static_cast<cudaq::details::kernel_builder_base &>(kernel).jitCode();
+  }
+
+  auto &platform = cudaq::get_platform();
+  auto kernelName = cudaq::getKernelName(kernel);
+  auto wrappedKernel = [&]() mutable { kernel(std::forward<Args>(args)...); };
+
+  // Noiseless reference values
+  platform.reset_noise();
+  const auto referenceRecord = details::getMeasurementRecord(
+      details::runSampling(wrappedKernel, platform, kernelName, /*shots=*/1,
+                           /*explicitMeasurements=*/true)
+          .value());
+  const auto detectorReference =
+      details::getReferenceParities(referenceRecord, options.detectors);
+  const auto observableReference =
+      details::getReferenceParities(referenceRecord, options.observables);
+
+  platform.set_noise(&options.noise);
+  std::future<void> pending;
+  try {
+    for (std::size_t first = 0; first < options.shots;
+         first += options.chunk_size) {
+      const auto chunkShots =
+          std::min(options.chunk_size, options.shots - first);
+      const auto record = details::getMeasurementRecord(
+          details::runSampling(wrappedKernel, platform, kernelName, chunkShots,
+                               /*explicitMeasurements=*/true)
+              .value());
+      detector_samples chunk;
+      chunk.first_shot = first;
+      chunk.detection_events = details::evaluateParities(
+          record, options.detectors, detectorReference);
+      chunk.observable_flips = details::evaluateParities(
+          record, options.observables, observableReference);
+      if (pending.valid())
+        pending.get();
+      pending = std::async(std::launch::async,
+                           [&callback, chunk = std::move(chunk)]() {
+                             callback(chunk);
+                           });
+    }
+    if (pending.valid())
+      pending.get();
+  } catch (...) {
+    if (pending.valid())
+      pending.wait();
+    platform.reset_noise();
+    throw;
+  }
+  platform.reset_noise();
+}
+
+} // namespace cudaq
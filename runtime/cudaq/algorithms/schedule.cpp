@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "cudaq/schedule.h"
+#include <algorithm>
 #include <optional>
 #include <stdexcept>
 
@@ -100,9 +101,57 @@ const std::vector<std::string> &schedule::get_parameters() const {
 
 // Get the value function of the schedule.
 const std::function<std::complex<double>(const std::string &,
-                                         const std::complex<double> &)>
+                                         const std::complex<double> &)> &
 schedule::get_value_function() const {
   return value_function;
 }
 
+// The number of time points recorded on the fly, beyond which the values at
+// new time points, e.g., of an adaptive integrator, are evaluated but not
+// recorded. Precomputed time points are always recorded.
+static constexpr std::size_t maxRecordedTimes = 1 << 16;
+
+void schedule::precompute_parameters(const std::vector<double> &times) const {
+  std::vector<double> missing;
+  {
+    std::scoped_lock lock(parameter_values->mutex);
+    for (auto t : times)
+      if (!parameter_values->values.contains(t))
+        missing.push_back(t);
+  }
+  std::sort(missing.begin(), missing.end());
+  missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+  if (missing.empty())
+    return;
+
+  // The callbacks run without the lock, as they may take a while, e.g., for
+  // Python callables.
+  std::vector<std::unordered_map<std::string, std::complex<double>>> values(
+      missing.size());
+  for (const auto &param : parameters)
+    for (std::size_t i = 0; i < missing.size(); ++i)
+      values[i][param] = value_function(param, missing[i]);
+
+  std::scoped_lock lock(parameter_values->mutex);
+  for (std::size_t i = 0; i < missing.size(); ++i)
+    parameter_values->values.try_emplace(missing[i], std::move(values[i]));
+}
+
+std::unordered_map<std::string, std::complex<double>>
+schedule::get_parameter_values(double t) const {
+  {
+    std::scoped_lock lock(parameter_values->mutex);
+    auto iter = parameter_values->values.find(t);
+    if (iter != parameter_values->values.end())
+      return iter->second;
+  }
+  std::unordered_map<std::string, std::complex<double>> values;
+  for (const auto &param : parameters)
+    values[param] = value_function(param, t);
+  std::scoped_lock lock(parameter_values->mutex);
+  if (parameter_values->values.size() < maxRecordedTimes)
+    parameter_values->values.try_emplace(t, values);
+  return values;
+}
+
 } // namespace cudaq
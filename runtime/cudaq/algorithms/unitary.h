@@ -12,7 +12,11 @@
 #include "cudaq/algorithms/draw.h"
 #include "cudaq/operators/matrix.h"
 #include "nvqir/Gates.h"
+#include <algorithm>
+#include <complex>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 namespace cudaq::contrib {
 
@@ -100,44 +104,134 @@ expand_gate_to_system(const complex_matrix &gate, std::size_t num_qudits,
   return result;
 }
 
+namespace details {
+/// @brief A gate of a trace, prepared to be applied to the columns of a
+/// unitary.
+struct column_gate {
+  /// The gate matrix on the targets, in row-major order.
+  std::vector<std::complex<double>> matrix;
+  /// The offset of each basis state of the targets in a column.
+  std::vector<std::size_t> offsets;
+  /// The bit positions of the targets and controls, in increasing order.
+  std::vector<std::size_t> fixedBits;
+  std::size_t controlMask = 0;
+};
+
+/// @brief Return `a * b`, without the special handling of infinities and NaNs
+/// of `std::complex`, which prevents vectorization.
+inline std::complex<double> multiply(std::complex<double> a,
+                                     std::complex<double> b) {
+  return {a.real() * b.real() - a.imag() * b.imag(),
+          a.real() * b.imag() + a.imag() * b.real()};
+}
+
+/// @brief Left-multiply the columns `[begin, end)` of the row-major unitary
+/// `data`, of dimension `dim`, by `gate`.
+inline void apply_to_columns(const column_gate &gate,
+                             std::complex<double> *data, std::size_t dim,
+                             std::size_t begin, std::size_t end) {
+  const std::size_t gateDim = gate.offsets.size();
+  std::vector<std::complex<double> *> rows(gateDim);
+  std::vector<std::complex<double>> scratch(gateDim);
+  // Visit each group of rows once, with all controls set, by inserting the
+  // target and control bits into a counter over the other bits.
+  for (std::size_t k = 0; k < (dim >> gate.fixedBits.size()); ++k) {
+    std::size_t base = k;
+    for (auto bit : gate.fixedBits)
+      base = ((base >> bit) << (bit + 1)) | (base & ((1ULL << bit) - 1));
+    base |= gate.controlMask;
+    for (std::size_t i = 0; i < gateDim; ++i)
+      rows[i] = data + (base | gate.offsets[i]) * dim;
+    if (gateDim == 2) {
+      const auto m = gate.matrix.data();
+      auto *row0 = rows[0];
+      auto *row1 = rows[1];
+      for (std::size_t col = begin; col < end; ++col) {
+        const auto a = row0[col];
+        const auto b = row1[col];
+        row0[col] = multiply(m[0], a) + multiply(m[1], b);
+        row1[col] = multiply(m[2], a) + multiply(m[3], b);
+      }
+      continue;
+    }
+    for (std::size_t col = begin; col < end; ++col) {
+      for (std::size_t i = 0; i < gateDim; ++i)
+        scratch[i] = rows[i][col];
+      for (std::size_t i = 0; i < gateDim; ++i) {
+        std::complex<double> sum = 0.;
+        for (std::size_t j = 0; j < gateDim; ++j)
+          sum += multiply(gate.matrix[i * gateDim + j], scratch[j]);
+        rows[i][col] = sum;
+      }
+    }
+  }
+}
+} // namespace details
+
 /// @brief Construct the full system unitary from a Trace of quantum
 /// instructions.
+///
+/// Rather than multiplying the expanded matrix of each gate, each gate is
+/// applied in place to all the basis states, i.e., columns of the unitary, as
+/// a batch of state vectors. Ranges of columns are independent, hence
+/// processed concurrently.
 /// @param trace The Trace object recording the sequence of quantum operations.
 /// @returns A complex_matrix representing the overall unitary of the traced
 /// kernel.
 inline complex_matrix unitary_from_trace(const Trace &trace) {
   auto num_qubits = trace.getNumQudits();
   std::size_t dim = 1ULL << num_qubits;
-  complex_matrix U = complex_matrix::identity(dim);
+  // Qubit 0 is the most significant bit of the row index.
+  const auto qubitBit = [&](std::size_t qubit) {
+    return num_qubits - 1 - qubit;
+  };
 
+  std::vector<details::column_gate> gates;
   for (const auto &inst : trace) {
     auto gate_name = nvqir::getGateNameFromString(inst.name);
-    auto gate_vec = nvqir::getGateByName<double>(gate_name, inst.params);
-    std::size_t gate_dim = static_cast<std::size_t>(std::sqrt(gate_vec.size()));
-    complex_matrix gate(gate_vec, {gate_dim, gate_dim});
-
-    // If there are control qubits, build the controlled-unitary
-    if (!inst.controls.empty()) {
-      gate = make_controlled_unitary(gate, inst.controls.size());
-      gate_dim = gate.rows();
+    auto &gate = gates.emplace_back();
+    gate.matrix = nvqir::getGateByName<double>(gate_name, inst.params);
+    // The first target is the most significant bit of the gate matrix.
+    const std::size_t numTargets = inst.targets.size();
+    gate.offsets.assign(1ULL << numTargets, 0);
+    for (std::size_t k = 0; k < numTargets; ++k) {
+      const auto bit = qubitBit(inst.targets[k].id);
+      gate.fixedBits.push_back(bit);
+      for (std::size_t i = 0; i < gate.offsets.size(); ++i)
+        if ((i >> (numTargets - 1 - k)) & 1ULL)
+          gate.offsets[i] |= 1ULL << bit;
     }
-
-    // Get vector of all qubit indices that this gate operates on
-    // The control qubits are expected to be at the start of the vector,
-    std::vector<std::size_t> inst_qubits;
-    inst_qubits.reserve(inst.controls.size() + inst.targets.size());
     for (const auto &control : inst.controls) {
-      inst_qubits.push_back(control.id);
-    }
-    for (const auto &target : inst.targets) {
-      inst_qubits.push_back(target.id);
+      const auto bit = qubitBit(control.id);
+      gate.fixedBits.push_back(bit);
+      gate.controlMask |= 1ULL << bit;
     }
+    std::sort(gate.fixedBits.begin(), gate.fixedBits.end());
+  }
 
-    // Expand gate to full system
-    auto full_gate = expand_gate_to_system(gate, num_qubits, inst_qubits);
-
-    // Left-multiply the system unitary
-    U = full_gate * U;
+  complex_matrix U = complex_matrix::identity(dim);
+  auto *data = U.get_data(complex_matrix::order::row_major);
+  const auto applyToColumns = [&](std::size_t begin, std::size_t end) {
+    for (const auto &gate : gates)
+      details::apply_to_columns(gate, data, dim, begin, end);
+  };
+
+  // Only spawn threads for unitaries large enough to amortize them.
+  constexpr std::size_t minColumnsPerThread = 64;
+  const std::size_t numThreads = std::clamp<std::size_t>(
+      std::min<std::size_t>(std::thread::hardware_concurrency(),
+                            dim / minColumnsPerThread),
+      1, dim);
+  if (numThreads == 1) {
+    applyToColumns(0, dim);
+  } else {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (std::size_t t = 0; t < numThreads; ++t)
+      threads.emplace_back(applyToColumns, t * dim / numThreads,
+                           (t + 1) * dim / numThreads);
+    for (auto &thread : threads)
+      thread.join();
   }
   return U;
 }
@@ -38,6 +38,32 @@ remote_vqe(cudaq::quantum_platform &platform, QuantumKernel &&kernel,
   return ctx->optResult.value_or(optimization_result{});
 }
 
+/// @brief Evaluate the objective of a gradient-free VQE at each of the
+/// parameters `xs`, e.g., the candidates of a population based optimizer. On
+/// platforms with several QPUs, the evaluations are launched with
+/// `observeAsync(qpu, x)` round-robin over the QPUs, otherwise they run one at
+/// a time with `observe(x)`.
+template <typename Observe, typename ObserveAsync>
+std::vector<double> observe_batch(const std::vector<std::vector<double>> &xs,
+                                  Observe &&observe,
+                                  ObserveAsync &&observeAsync) {
+  const auto nQpus = cudaq::get_platform().num_qpus();
+  std::vector<double> values;
+  values.reserve(xs.size());
+  if (nQpus <= 1) {
+    for (const auto &x : xs)
+      values.push_back(observe(x));
+    return values;
+  }
+  std::vector<async_observe_result> results;
+  results.reserve(xs.size());
+  for (std::size_t i = 0; i < xs.size(); ++i)
+    results.emplace_back(observeAsync(i % nQpus, xs[i]));
+  for (auto &result : results)
+    values.push_back(result.get().expectation());
+  return values;
+}
+
 static inline void print_arg_mapper_warning() {
   printf(
       "WARNING: Usage of ArgMapper type on this platform will result in "
@@ -112,11 +138,20 @@ optimization_result vqe(QuantumKernel &&kernel, cudaq::spin_op H,
                                     /*gradient=*/nullptr, n_params, /*shots=*/0,
                                     args...);
 
-  return optimizer.optimize(n_params, [&](const std::vector<double> &x,
-                                          std::vector<double> &grad_vec) {
-    double e = cudaq::observe(kernel, H, x, args...);
-    return e;
-  });
+  auto observe = [&](const std::vector<double> &x) {
+    return cudaq::observe(kernel, H, x, args...).expectation();
+  };
+  auto observeAsync = [&](std::size_t qpu, const std::vector<double> &x) {
+    return cudaq::observe_async(qpu, kernel, H, x, args...);
+  };
+  return optimizer.optimize(
+      n_params, optimizable_function(
+                    [&](const std::vector<double> &x,
+                        std::vector<double> &grad_vec) { return observe(x); },
+                    [&](const std::vector<std::vector<double>> &xs) {
+                      return __internal__::observe_batch(xs, observe,
+                                                         observeAsync);
+                    }));
 }
 
 ///
@@ -183,11 +218,20 @@ optimization_result vqe(std::size_t shots, QuantumKernel &&kernel,
                                     /*gradient=*/nullptr, n_params, shots,
                                     args...);
 
-  return optimizer.optimize(n_params, [&](const std::vector<double> &x,
-                                          std::vector<double> &grad_vec) {
-    double e = cudaq::observe(shots, kernel, H, x, args...);
-    return e;
-  });
+  auto observe = [&](const std::vector<double> &x) {
+    return cudaq::observe(shots, kernel, H, x, args...).expectation();
+  };
+  auto observeAsync = [&](std::size_t qpu, const std::vector<double> &x) {
+    return cudaq::observe_async(shots, qpu, kernel, H, x, args...);
+  };
+  return optimizer.optimize(
+      n_params, optimizable_function(
+                    [&](const std::vector<double> &x,
+                        std::vector<double> &grad_vec) { return observe(x); },
+                    [&](const std::vector<std::vector<double>> &xs) {
+                      return __internal__::observe_batch(xs, observe,
+                                                         observeAsync);
+                    }));
 }
 
 ///
@@ -344,16 +388,28 @@ optimization_result vqe(QuantumKernel &&kernel, cudaq::spin_op H,
   if (cudaq::get_platform().get_remote_capabilities().vqe)
     __internal__::print_arg_mapper_warning();
 
-  return optimizer.optimize(n_params, [&](const std::vector<double> &x,
-                                          std::vector<double> &grad_vec) {
-    auto args = argsMapper(x);
-    double energy = std::apply(
+  auto observe = [&](const std::vector<double> &x) {
+    return std::apply(
         [&](auto &&...arg) -> double {
           return cudaq::observe(kernel, H, arg...);
         },
-        args);
-    return energy;
-  });
+        argsMapper(x));
+  };
+  auto observeAsync = [&](std::size_t qpu, const std::vector<double> &x) {
+    return std::apply(
+        [&](auto &&...arg) {
+          return cudaq::observe_async(qpu, kernel, H, arg...);
+        },
+        argsMapper(x));
+  };
+  return optimizer.optimize(
+      n_params, optimizable_function(
+                    [&](const std::vector<double> &x,
+                        std::vector<double> &grad_vec) { return observe(x); },
+                    [&](const std::vector<std::vector<double>> &xs) {
+                      return __internal__::observe_batch(xs, observe,
+                                                         observeAsync);
+                    }));
 }
 
 ///
@@ -426,16 +482,28 @@ optimization_result vqe(std::size_t shots, QuantumKernel &&kernel,
   if (cudaq::get_platform().get_remote_capabilities().vqe)
     __internal__::print_arg_mapper_warning();
 
-  return optimizer.optimize(n_params, [&](const std::vector<double> &x,
-                                          std::vector<double> &grad_vec) {
-    auto args = argsMapper(x);
-    double energy = std::apply(
+  auto observe = [&](const std::vector<double> &x) {
+    return std::apply(
         [&](auto &&...arg) -> double {
           return cudaq::observe(shots, kernel, H, arg...);
         },
-        args);
-    return energy;
-  });
+        argsMapper(x));
+  };
+  auto observeAsync = [&](std::size_t qpu, const std::vector<double> &x) {
+    return std::apply(
+        [&](auto &&...arg) {
+          return cudaq::observe_async(shots, qpu, kernel, H, arg...);
+        },
+        argsMapper(x));
+  };
+  return optimizer.optimize(
+      n_params, optimizable_function(
+                    [&](const std::vector<double> &x,
+                        std::vector<double> &grad_vec) { return observe(x); },
+                    [&](const std::vector<std::vector<double>> &xs) {
+                      return __internal__::observe_batch(xs, observe,
+                                                         observeAsync);
+                    }));
 }
 
 ///
@@ -19,6 +19,8 @@
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
 #include "cudaq/platform/nvqpp_interface.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/ADT/bit.h"
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/Dialect/Math/IR/Math.h"
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
@@ -32,7 +34,9 @@
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Target/LLVMIR/ModuleTranslation.h"
 #include "mlir/Transforms/Passes.h"
+#include <list>
 #include <numeric>
+#include <unordered_set>
 
 using namespace mlir;
 
@@ -126,12 +130,124 @@ KernelBuilderType convertArgumentTypeToMLIR(cudaq::state *&) {
   });
 }
 
+namespace {
+/// Contexts of destroyed builders. Creating a context and loading its dialects
+/// is a large part of the construction time of small kernels, while a context
+/// can be reused once the modules built in it are erased. Each context is used
+/// by one builder at a time. The pool is intentionally leaked, so that no
+/// context is destroyed during static destruction.
+struct ContextPool {
+  static constexpr std::size_t capacity = 8;
+  std::mutex mutex;
+  std::vector<MLIRContext *> contexts;
+};
+ContextPool &getContextPool() {
+  static auto *pool = new ContextPool;
+  return *pool;
+}
+
+/// JIT engines compiled from builder kernels, keyed by a hash of the module
+/// with the kernel name abstracted away, so that rebuilding the same kernel,
+/// e.g., to run it with other arguments, does not compile it again. Engines are
+/// reference counted by the builders using them, and the least recently used
+/// entries are evicted beyond the capacity. The cache is intentionally leaked,
+/// as LLVM may be torn down before static destructors run.
+struct JitCache {
+  static constexpr std::size_t capacity = 16;
+  struct Entry {
+    std::shared_ptr<ExecutionEngine> engine;
+    std::string kernelName;
+  };
+  std::mutex mutex;
+  /// Keys from the most to the least recently used.
+  std::list<std::size_t> recent;
+  std::unordered_map<std::size_t,
+                     std::pair<Entry, std::list<std::size_t>::iterator>>
+      entries;
+  /// Engines used by builders, with the number of builders using them.
+  std::unordered_map<ExecutionEngine *,
+                     std::pair<std::shared_ptr<ExecutionEngine>, std::size_t>>
+      users;
+  /// Kernel names used by more than one builder.
+  std::unordered_set<std::string> sharedNames;
+
+  void acquire(const std::shared_ptr<ExecutionEngine> &engine) {
+    auto &[ptr, count] = users[engine.get()];
+    ptr = engine;
+    ++count;
+  }
+};
+JitCache &getJitCache() {
+  static auto *cache = new JitCache;
+  return *cache;
+}
+
+/// Append a random suffix to `prefix`, making the kernel name unique.
+std::string uniqueKernelName(std::string_view prefix) {
+  std::ostringstream os;
+  for (int i = 0; i < 12; ++i) {
+    int digit = rand() % 10;
+    os << digit;
+  }
+  return fmt::format("{}_{}", prefix, os.str());
+}
+
+ModuleOp getModule(ImplicitLocOpBuilder &builder) {
+  auto *op = builder.getBlock()->getParentOp();
+  if (auto module = dyn_cast<ModuleOp>(op))
+    return module;
+  return op->getParentOfType<ModuleOp>();
+}
+
+/// Rename the kernel `kernelName` of `module` to `newName`.
+void renameKernel(ModuleOp module, std::string &kernelName,
+                  const std::string &newName) {
+  if (auto kernel = module.lookupSymbol<func::FuncOp>(kernelName)) {
+    auto newNameAttr = StringAttr::get(module.getContext(), newName);
+    if (failed(SymbolTable::replaceAllSymbolUses(kernel, newNameAttr, module)))
+      throw std::runtime_error("cudaq::builder failed to rename the kernel.");
+    kernel.setSymName(newName);
+  }
+  kernelName = newName;
+}
+} // namespace
+
 MLIRContext *initializeContext() {
+  auto &pool = getContextPool();
+  {
+    std::scoped_lock<std::mutex> lock(pool.mutex);
+    if (!pool.contexts.empty()) {
+      auto *context = pool.contexts.back();
+      pool.contexts.pop_back();
+      return context;
+    }
+  }
   CUDAQ_INFO("Initializing the MLIR infrastructure.");
   return cudaq::getOwningMLIRContext().release();
 }
-void deleteContext(MLIRContext *context) { delete context; }
-void deleteJitEngine(ExecutionEngine *jit) { delete jit; }
+void deleteContext(MLIRContext *context) {
+  auto &pool = getContextPool();
+  {
+    std::scoped_lock<std::mutex> lock(pool.mutex);
+    if (pool.contexts.size() < ContextPool::capacity) {
+      pool.contexts.push_back(context);
+      return;
+    }
+  }
+  delete context;
+}
+void deleteJitEngine(ExecutionEngine *jit) {
+  auto &cache = getJitCache();
+  std::scoped_lock<std::mutex> lock(cache.mutex);
+  auto iter = cache.users.find(jit);
+  if (iter == cache.users.end()) {
+    delete jit;
+    return;
+  }
+  // The engine is deleted with its last reference, if not in the cache.
+  if (--iter->second.second == 0)
+    cache.users.erase(iter);
+}
 
 ImplicitLocOpBuilder *
 initializeBuilder(MLIRContext *context,
@@ -152,13 +268,7 @@ initializeBuilder(MLIRContext *context,
                  [&](auto &&element) { return element.create(context); });
 
   // Make the kernel_name unique,
-  std::ostringstream os;
-  for (int i = 0; i < 12; ++i) {
-    int digit = rand() % 10;
-    os << digit;
-  }
-
-  kernelName += fmt::format("_{}", os.str());
+  kernelName = uniqueKernelName(kernelName);
   CUDAQ_INFO("kernel_builder name set to {}", kernelName);
 
   FunctionType funcTy = opBuilder->getFunctionType(types, std::nullopt);
@@ -177,7 +287,14 @@ initializeBuilder(MLIRContext *context,
   opBuilder->setInsertionPoint(terminator);
   return opBuilder;
 }
-void deleteBuilder(ImplicitLocOpBuilder *builder) { delete builder; }
+void deleteBuilder(ImplicitLocOpBuilder *builder) {
+  // The context may be reused by another builder, erase the module built in
+  // it.
+  if (builder->getBlock())
+    if (auto module = getModule(*builder))
+      module.erase();
+  delete builder;
+}
 
 bool isArgStdVec(std::vector<QuakeValue> &args, std::size_t idx) {
   return args[idx].isStdVec();
@@ -763,6 +880,95 @@ void u3(ImplicitLocOpBuilder &builder, std::vector<QuakeValue> &parameters,
                               qubitValues);
 }
 
+namespace {
+/// How to create a gate appended in bulk.
+struct BulkGate {
+  void (*create)(ImplicitLocOpBuilder &, bool, ValueRange, ValueRange,
+                 ValueRange) = nullptr;
+  std::size_t numParameters = 0;
+  std::size_t numTargets = 1;
+};
+
+template <typename QuakeOp>
+void createBulkGate(ImplicitLocOpBuilder &builder, bool adjoint,
+                    ValueRange parameters, ValueRange controls,
+                    ValueRange targets) {
+  builder.create<QuakeOp>(adjoint, parameters, controls, targets);
+}
+
+BulkGate getBulkGate(StringRef name) {
+  return llvm::StringSwitch<BulkGate>(name)
+      .Case("h", {createBulkGate<quake::HOp>})
+      .Case("x", {createBulkGate<quake::XOp>})
+      .Case("y", {createBulkGate<quake::YOp>})
+      .Case("z", {createBulkGate<quake::ZOp>})
+      .Case("s", {createBulkGate<quake::SOp>})
+      .Case("t", {createBulkGate<quake::TOp>})
+      .Case("rx", {createBulkGate<quake::RxOp>, 1})
+      .Case("ry", {createBulkGate<quake::RyOp>, 1})
+      .Case("rz", {createBulkGate<quake::RzOp>, 1})
+      .Case("r1", {createBulkGate<quake::R1Op>, 1})
+      .Case("u3", {createBulkGate<quake::U3Op>, 3})
+      .Case("swap", {createBulkGate<quake::SwapOp>, 0, 2})
+      .Default({});
+}
+} // namespace
+
+void appendGates(ImplicitLocOpBuilder &builder, const QuakeValue &qubits,
+                 const std::vector<builder_gate> &gates) {
+  Value veq = qubits.getValue();
+  auto veqTy = dyn_cast<quake::VeqType>(veq.getType());
+  if (!veqTy)
+    throw std::runtime_error("append_gates must be given a qvector.");
+  CUDAQ_INFO("kernel_builder append {} gates", gates.size());
+
+  // Qubit references and constants are created on first use and reused by the
+  // following gates.
+  std::vector<Value> refs;
+  std::unordered_map<std::uint64_t, Value> constants;
+  auto getRef = [&](std::size_t index) {
+    if (veqTy.hasSpecifiedSize() && index >= veqTy.getSize())
+      throw std::runtime_error(fmt::format(
+          "append_gates: qubit index {} out of range for a qvector of {} "
+          "qubits.",
+          index, veqTy.getSize()));
+    if (index >= refs.size())
+      refs.resize(index + 1);
+    if (!refs[index])
+      refs[index] = builder.create<quake::ExtractRefOp>(veq, index);
+    return refs[index];
+  };
+  auto getConstant = [&](double value) {
+    auto &constant = constants[llvm::bit_cast<std::uint64_t>(value)];
+    if (!constant)
+      constant = builder.create<arith::ConstantFloatOp>(llvm::APFloat{value},
+                                                        builder.getF64Type());
+    return constant;
+  };
+
+  SmallVector<Value> parameters, controls, targets;
+  for (const auto &gate : gates) {
+    auto bulkGate = getBulkGate(gate.name);
+    if (!bulkGate.create)
+      throw std::runtime_error("append_gates: unsupported gate " + gate.name);
+    if (gate.parameters.size() != bulkGate.numParameters ||
+        gate.targets.size() != bulkGate.numTargets)
+      throw std::runtime_error(fmt::format(
+          "append_gates: gate {} takes {} parameters and {} targets.",
+          gate.name, bulkGate.numParameters, bulkGate.numTargets));
+    parameters.clear();
+    controls.clear();
+    targets.clear();
+    for (auto parameter : gate.parameters)
+      parameters.push_back(getConstant(parameter));
+    for (auto control : gate.controls)
+      controls.push_back(getRef(control));
+    for (auto target : gate.targets)
+      targets.push_back(getRef(target));
+    bulkGate.create(builder, gate.adjoint, parameters, controls, targets);
+  }
+}
+
 template <typename QuakeMeasureOp>
 QuakeValue applyMeasure(ImplicitLocOpBuilder &builder, Value value,
                         const std::string &regName) {
@@ -891,7 +1097,7 @@ void tagEntryPoint(ImplicitLocOpBuilder &builder, ModuleOp &module,
 std::tuple<bool, ExecutionEngine *>
 jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
         std::unordered_map<ExecutionEngine *, std::size_t> &jitHash,
-        std::string kernelName, std::vector<std::string> extraLibPaths,
+        std::string &kernelName, std::vector<std::string> extraLibPaths,
         StateVectorStorage &stateVectorStorage) {
 
   // Start of by getting the current ModuleOp
@@ -901,11 +1107,14 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
   auto currentModule = function->getParentOfType<ModuleOp>();
 
   // Create a unique hash from that ModuleOp
-  auto hash = llvm::hash_code{0};
-  currentModule.walk([&hash](Operation *op) {
-    hash = llvm::hash_combine(hash, OperationEquivalence::computeHash(op));
-  });
-  auto moduleHash = static_cast<size_t>(hash);
+  auto computeModuleHash = [&]() {
+    auto hash = llvm::hash_code{0};
+    currentModule.walk([&hash](Operation *op) {
+      hash = llvm::hash_combine(hash, OperationEquivalence::computeHash(op));
+    });
+    return static_cast<size_t>(hash);
+  };
+  auto moduleHash = computeModuleHash();
 
   if (jit) {
     // Have we added more instructions since the last time we jit the code? If
@@ -918,6 +1127,51 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
     }
   }
 
+  // Look for an engine compiled from the same code by another builder. The
+  // structural hash above depends on the identity of the values, hence the
+  // key is computed from the printed module instead, with the kernel name
+  // abstracted away.
+  std::size_t cacheKey = 0;
+  {
+    std::string code;
+    llvm::raw_string_ostream os(code);
+    currentModule->print(os);
+    os.flush();
+    const std::string placeholder = "__nvqpp__builder_kernel__";
+    for (auto pos = code.find(kernelName); pos != std::string::npos;
+         pos = code.find(kernelName, pos + placeholder.size()))
+      code.replace(pos, kernelName.size(), placeholder);
+    cacheKey = llvm::hash_combine(
+        llvm::hash_value(code), stateVectorStorage.empty(),
+        llvm::hash_combine_range(extraLibPaths.begin(), extraLibPaths.end()));
+  }
+  auto &cache = getJitCache();
+  {
+    std::scoped_lock<std::mutex> lock(cache.mutex);
+    auto iter = cache.entries.find(cacheKey);
+    if (iter != cache.entries.end()) {
+      auto &[entry, recentIter] = iter->second;
+      cache.recent.splice(cache.recent.begin(), cache.recent, recentIter);
+      CUDAQ_INFO("kernel_builder reusing the JIT engine of {}.",
+                 entry.kernelName);
+      // Adopt the name of the cached kernel, which the engine registered.
+      if (entry.kernelName != kernelName) {
+        cache.sharedNames.insert(entry.kernelName);
+        renameKernel(currentModule, kernelName, entry.kernelName);
+      }
+      cache.acquire(entry.engine);
+      jitHash.insert({entry.engine.get(), computeModuleHash()});
+      return std::make_tuple(true, entry.engine.get());
+    }
+    // Compiling would register the code under the kernel name, which must not
+    // change the kernel of the other builders sharing that name.
+    if (cache.sharedNames.contains(kernelName)) {
+      auto prefix = kernelName.substr(0, kernelName.rfind('_'));
+      renameKernel(currentModule, kernelName, uniqueKernelName(prefix));
+      moduleHash = computeModuleHash();
+    }
+  }
+
   CUDAQ_INFO("kernel_builder running jitCode.");
 
   auto module = currentModule.clone();
@@ -1047,6 +1301,23 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
 
   // Map this JIT Engine to its unique hash integer.
   jitHash.insert({jit, moduleHash});
+
+  // Share the engine through the cache.
+  {
+    std::scoped_lock<std::mutex> lock(cache.mutex);
+    std::shared_ptr<ExecutionEngine> engine(jit);
+    cache.acquire(engine);
+    auto iter = cache.entries.find(cacheKey);
+    if (iter == cache.entries.end()) {
+      cache.recent.push_front(cacheKey);
+      cache.entries.insert(
+          {cacheKey, {{engine, kernelName}, cache.recent.begin()}});
+      if (cache.entries.size() > JitCache::capacity) {
+        cache.entries.erase(cache.recent.back());
+        cache.recent.pop_back();
+      }
+    }
+  }
   return std::make_tuple(true, jit);
 }
 
@@ -74,6 +74,20 @@ concept KernelBuilderArgTypeIsValid =
           std::vector<cudaq::pauli_word>, cudaq::state *> &&                   \
       ...)
 
+/// @brief A gate appended to a `kernel_builder` in bulk with
+/// `kernel_builder::append_gates`. Controls and targets are indices of qubits
+/// in the `qvector` the gates are appended on.
+struct builder_gate {
+  /// The name of the gate: `h`, `x`, `y`, `z`, `s`, `t`, `rx`, `ry`, `rz`,
+  /// `r1`, `u3` or `swap`.
+  std::string name;
+  std::vector<double> parameters;
+  std::vector<std::size_t> controls;
+  std::vector<std::size_t> targets;
+  /// Apply the adjoint of the gate.
+  bool adjoint = false;
+};
+
 namespace details {
 /// Use parametric type: `initializations` must be vectors of complex float or
 /// double. No other type is allowed.
@@ -147,11 +161,11 @@ KernelBuilderType convertArgumentTypeToMLIR(std::vector<cudaq::pauli_word> &e);
 KernelBuilderType convertArgumentTypeToMLIR(cudaq::state *&e);
 
 /// @brief Initialize the `MLIRContext`, return the raw pointer which we'll wrap
-/// in an `unique_ptr`.
+/// in an `unique_ptr`. Contexts of destroyed builders are pooled and reused.
 mlir::MLIRContext *initializeContext();
 
 /// @brief Delete function for the context pointer, also given to the
-/// `unique_ptr`
+/// `unique_ptr`. The context is returned to the pool if it is not full.
 void deleteContext(mlir::MLIRContext *);
 
 /// @brief Initialize the `OpBuilder`, return the raw pointer which we'll wrap
@@ -162,10 +176,12 @@ mlir::ImplicitLocOpBuilder *initializeBuilder(mlir::MLIRContext *,
                                               std::string &kernelName);
 
 /// @brief Delete function for the builder pointer, also given to the
-/// `unique_ptr`
+/// `unique_ptr`. This also erases the module being built.
 void deleteBuilder(mlir::ImplicitLocOpBuilder *builder);
 
-/// @brief Delete function for the JIT pointer, also given to the `unique_ptr`
+/// @brief Delete function for the JIT pointer, also given to the `unique_ptr`.
+/// Engines are shared with the JIT cache, and only deleted once neither a
+/// builder nor the cache uses them.
 void deleteJitEngine(mlir::ExecutionEngine *jit);
 
 /// @brief Allocate a single `qubit`
@@ -241,6 +257,10 @@ void u3(mlir::ImplicitLocOpBuilder &builder,
         std::vector<QuakeValue> &parameters, std::vector<QuakeValue> &ctrls,
         QuakeValue &target, bool adjoint = false);
 
+/// @brief Append the given gates on the qubits of the `qvector` `qubits`.
+void appendGates(mlir::ImplicitLocOpBuilder &builder, const QuakeValue &qubits,
+                 const std::vector<builder_gate> &gates);
+
 /// @brief Return the name of this `kernel_builder`, it is also the name of the
 /// function
 std::string name(std::string_view kernelName);
@@ -249,11 +269,14 @@ std::string name(std::string_view kernelName);
 void applyPasses(mlir::PassManager &);
 
 /// @brief Create the `ExecutionEngine` and return a raw pointer, which we will
-/// wrap in a `unique_ptr`
+/// wrap in a `unique_ptr`. If an engine was already compiled from the same
+/// code by another builder, it is reused and the kernel is renamed to the
+/// kernel of that engine, hence `kernelName` may be updated.
 std::tuple<bool, mlir::ExecutionEngine *>
 jitCode(mlir::ImplicitLocOpBuilder &, mlir::ExecutionEngine *,
-        std::unordered_map<mlir::ExecutionEngine *, std::size_t> &, std::string,
-        std::vector<std::string>, StateVectorStorage &);
+        std::unordered_map<mlir::ExecutionEngine *, std::size_t> &,
+        std::string &kernelName, std::vector<std::string>,
+        StateVectorStorage &);
 
 /// @brief Invoke the function with the given kernel name.
 void invokeCode(mlir::ImplicitLocOpBuilder &builder, mlir::ExecutionEngine *jit,
@@ -908,6 +931,15 @@ public:
     details::forLoop(*opBuilder, start, end, body);
   }
 
+  /// @brief Append the given gates on the qubits of `qubits`, which must be a
+  /// `qvector`. This is faster than applying the gates one at a time for large
+  /// generated circuits, as each qubit reference and each constant parameter
+  /// is only created once.
+  void append_gates(const QuakeValue &qubits,
+                    const std::vector<builder_gate> &gates) {
+    details::appendGates(*opBuilder, qubits, gates);
+  }
+
   /// @brief Return the string representation of the quake code.
   std::string to_quake() const override {
     return details::to_quake(*opBuilder);
@@ -135,11 +135,10 @@ namespace details {
   TYPE allReduce(const TYPE &local, const BINARY<TYPE> &) {                    \
     static_assert(std::is_floating_point<TYPE>::value,                         \
                   "all_reduce argument must be a floating point number");      \
-    std::vector<double> result(1);                                             \
-    std::vector<double> localVec{static_cast<double>(local)};                  \
+    std::vector<double> data{static_cast<double>(local)};                      \
     auto *commPlugin = getMpiPlugin();                                         \
-    commPlugin->all_reduce(result, localVec, REDUCE_OP);                       \
-    return static_cast<TYPE>(result.front());                                  \
+    commPlugin->all_reduce(data, REDUCE_OP);                                   \
+    return static_cast<TYPE>(data.front());                                    \
   }
 
 CUDAQ_ALL_REDUCE_IMPL(float, std::plus, SUM)
@@ -33,6 +33,9 @@
 #define OMPI_SKIP_MPICXX 1
 #endif
 #include <mpi.h>
+#if defined(OPEN_MPI) && __has_include(<mpi-ext.h>)
+#include <mpi-ext.h>
+#endif
 
 namespace {
 bool initCalledByThis = false;
@@ -399,6 +402,39 @@ static int mpi_Recv(const cudaqDistributedCommunicator_t *comm, void *buffer,
                   unpackMpiCommunicator(comm), &recvStatus);
 }
 
+/// @brief Wrapper of MPI_Iallreduce, in place if the send buffer is null
+static int mpi_IAllreduce(const cudaqDistributedCommunicator_t *comm,
+                          const void *sendBuffer, void *recvBuffer,
+                          int32_t count, DataType dataType, ReduceOp opType,
+                          void *request) {
+  return MPI_Iallreduce(
+      sendBuffer ? sendBuffer : MPI_IN_PLACE, recvBuffer, count,
+      opType == MIN_LOC ? convertTypeMinLoc(dataType) : convertType(dataType),
+      convertType(opType), unpackMpiCommunicator(comm),
+      (MPI_Request *)request);
+}
+
+/// @brief Wrapper of MPI_Iallgather, in place if the send buffer is null
+static int mpi_IAllgather(const cudaqDistributedCommunicator_t *comm,
+                          const void *sendBuffer, void *recvBuffer,
+                          int32_t count, DataType dataType, void *request) {
+  return MPI_Iallgather(sendBuffer ? sendBuffer : MPI_IN_PLACE, count,
+                        convertType(dataType), recvBuffer, count,
+                        convertType(dataType), unpackMpiCommunicator(comm),
+                        (MPI_Request *)request);
+}
+
+/// @brief Query whether MPI accepts device buffers. Only Open MPI reports it,
+/// through its CUDA extension, other implementations are assumed not to.
+static int mpi_DeviceBufferSupport(int32_t *supported) {
+#if defined(MPIX_CUDA_AWARE_SUPPORT) && MPIX_CUDA_AWARE_SUPPORT
+  *supported = MPIX_Query_cuda_support();
+#else
+  *supported = 0;
+#endif
+  return MPI_SUCCESS;
+}
+
 /// @brief Return the underlying MPI_Comm as a type-erased object
 cudaqDistributedCommunicator_t *getMpiCommunicator() {
   static MPI_Comm pluginComm = MPI_COMM_WORLD;
@@ -437,6 +473,9 @@ cudaqDistributedInterface_t *getDistributedInterface() {
       mpi_TestRequest,
       mpi_Send,
       mpi_Recv,
+      mpi_IAllreduce,
+      mpi_IAllgather,
+      mpi_DeviceBufferSupport,
   };
   return &cudaqDistributedInterface;
 }
@@ -30,7 +30,7 @@ typedef struct {
   std::size_t commSize;
 } cudaqDistributedCommunicator_t;
 
-#define CUDAQ_DISTRIBUTED_INTERFACE_VERSION 1
+#define CUDAQ_DISTRIBUTED_INTERFACE_VERSION 2
 
 /// @brief Data type that we support
 // Plugin implementation need to convert it to MPI data type enum as needed.
@@ -133,5 +133,19 @@ typedef struct {
   /// @brief MPI_Recv
   int (*Recv)(const cudaqDistributedCommunicator_t *, void *, int, DataType,
               int, int32_t);
+  /// @brief MPI_Iallreduce, in place if the send buffer is null
+  /// @note The last argument is a request made by `CreateRequest`, which is
+  /// completed by `WaitRequest` or `TestRequest`. Since version 2.
+  int (*IAllreduce)(const cudaqDistributedCommunicator_t *, const void *,
+                    void *, int32_t, DataType, ReduceOp, void *);
+  /// @brief MPI_Iallgather, in place if the send buffer is null
+  /// @note The last argument is a request made by `CreateRequest`, which is
+  /// completed by `WaitRequest` or `TestRequest`. Since version 2.
+  int (*IAllgather)(const cudaqDistributedCommunicator_t *, const void *,
+                    void *, int32_t, DataType, void *);
+  /// @brief Set the flag to 1 if buffers in device (GPU) memory can be passed
+  /// to the communication functions, i.e., if MPI is CUDA-aware, else to 0.
+  /// @note Since version 2.
+  int (*DeviceBufferSupport)(int32_t *);
 } cudaqDistributedInterface_t;
 }
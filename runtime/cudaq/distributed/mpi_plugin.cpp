@@ -124,6 +124,11 @@ void MPIPlugin::all_reduce(std::vector<double> &global,
       m_comm, local.data(), global.data(), local.size(), FLOAT_64, op));
 }
 
+void MPIPlugin::all_reduce(std::vector<double> &data, ReduceOp op) {
+  HANDLE_MPI_ERROR(m_distributedInterface->AllreduceInPlace(
+      m_comm, data.data(), data.size(), FLOAT_64, op));
+}
+
 void MPIPlugin::finalize() {
   // Check if finalize has been called.
   int isFinalized{0};
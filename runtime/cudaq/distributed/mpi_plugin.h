@@ -76,6 +76,10 @@ public:
   void all_reduce(std::vector<double> &global, const std::vector<double> &local,
                   ReduceOp op);
 
+  /// @brief Combines vector data from all processes and distributes the
+  /// result back to all processes, in place.
+  void all_reduce(std::vector<double> &data, ReduceOp op);
+
   /// @brief Finalize MPI. This function
   /// is a no-op if there CUDA-Q has not been built
   /// against MPI.
@@ -10,4 +10,6 @@
 
 #include "chemistry/hwe.h"
 #include "chemistry/molecule.h"
+#include "chemistry/qubit_mapping.h"
+#include "chemistry/tapering.h"
 #include "chemistry/uccsd.h"
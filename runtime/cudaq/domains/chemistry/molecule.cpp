@@ -55,6 +55,11 @@ std::complex<double> &one_body_integrals::operator()(std::size_t p,
                    shape)(p, q);
 }
 
+const std::complex<double> &
+one_body_integrals::operator()(std::size_t p, std::size_t q) const {
+  return data.get()[p * shape[1] + q];
+}
+
 void one_body_integrals::dump() {
   std::cerr << xt::adapt(data.get(), shape[0] * shape[1], xt::no_ownership(),
                          shape)
@@ -76,6 +81,12 @@ std::complex<double> &two_body_integals::operator()(std::size_t p,
                    xt::no_ownership(), shape)(p, q, r, s);
 }
 
+const std::complex<double> &
+two_body_integals::operator()(std::size_t p, std::size_t q, std::size_t r,
+                              std::size_t s) const {
+  return data.get()[((p * shape[1] + q) * shape[2] + r) * shape[3] + s];
+}
+
 void two_body_integals::dump() {
   std::cerr << xt::adapt(data.get(), shape[0] * shape[1] * shape[2] * shape[3],
                          xt::no_ownership(), shape)
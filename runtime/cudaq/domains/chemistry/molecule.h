@@ -48,6 +48,7 @@ public:
   std::vector<std::size_t> shape;
   one_body_integrals(const std::vector<std::size_t> &shape);
   std::complex<double> &operator()(std::size_t i, std::size_t j);
+  const std::complex<double> &operator()(std::size_t i, std::size_t j) const;
   void dump();
 };
 
@@ -63,6 +64,8 @@ public:
   two_body_integals(const std::vector<std::size_t> &shape);
   std::complex<double> &operator()(std::size_t p, std::size_t q, std::size_t r,
                                    std::size_t s);
+  const std::complex<double> &operator()(std::size_t p, std::size_t q,
+                                         std::size_t r, std::size_t s) const;
   void dump();
 };
 
@@ -0,0 +1,331 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#include "qubit_mapping.h"
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace cudaq {
+namespace {
+
+/// Pauli strings over the qubits encoded as bit masks: `num_words` words of X
+/// components followed by `num_words` words of Z components (Y sets both).
+/// The strings are stored consecutively in a single buffer.
+struct pauli_strings {
+  std::size_t num_words = 0;
+  std::vector<std::uint64_t> masks;
+  std::vector<std::complex<double>> coefficients;
+
+  std::size_t size() const { return coefficients.size(); }
+  const std::uint64_t *operator[](std::size_t idx) const {
+    return masks.data() + 2 * num_words * idx;
+  }
+};
+
+/// Accumulates Pauli strings, combining the coefficients of identical strings.
+/// The distinct strings are kept in the order in which they are first added,
+/// and are indexed by an open addressing hash table.
+class pauli_accumulator {
+  static constexpr auto empty_slot = std::numeric_limits<std::size_t>::max();
+  std::size_t stride;
+  std::vector<std::size_t> slots;
+
+  std::size_t find_slot(const std::uint64_t *masks) const {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    for (std::size_t k = 0; k < stride; ++k) {
+      h ^= masks[k] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      h *= 0x100000001b3ULL;
+    }
+    std::size_t slot = h & (slots.size() - 1);
+    while (slots[slot] != empty_slot &&
+           !std::equal(masks, masks + stride, strings[slots[slot]]))
+      slot = (slot + 1) & (slots.size() - 1);
+    return slot;
+  }
+
+public:
+  pauli_strings strings;
+
+  pauli_accumulator(std::size_t num_words)
+      : stride(2 * num_words), slots(1024, empty_slot) {
+    strings.num_words = num_words;
+  }
+
+  void add(const std::uint64_t *masks, std::complex<double> coefficient) {
+    auto slot = find_slot(masks);
+    if (slots[slot] != empty_slot) {
+      strings.coefficients[slots[slot]] += coefficient;
+      return;
+    }
+    slots[slot] = strings.size();
+    strings.masks.insert(strings.masks.end(), masks, masks + stride);
+    strings.coefficients.push_back(coefficient);
+    if (2 * strings.size() > slots.size()) {
+      slots.assign(2 * slots.size(), empty_slot);
+      for (std::size_t idx = 0; idx < strings.size(); ++idx)
+        slots[find_slot(strings[idx])] = idx;
+    }
+  }
+
+  void add(const pauli_strings &other) {
+    for (std::size_t idx = 0; idx < other.size(); ++idx)
+      add(other[idx], other.coefficients[idx]);
+  }
+};
+
+/// The ladder operators of each mode `j` are mapped to
+/// `a+_j = (S_j - i T_j) / 2` and `a_j = (S_j + i T_j) / 2`, where the Pauli
+/// strings `S_j = X_U Z_P` and `T_j = X_U Z_(P ^ O)` are given by the sets of
+/// qubits `U` updated by a change of the occupation of the mode, `P` storing
+/// the parity of the modes below `j`, and `O` storing the occupation of the
+/// mode, up to the parity of the modes in `P`. Qubit `j` is in `U` and `O`
+/// but not in `P`, such that `T_j` is `Y` on qubit `j`.
+struct ladder_mapping {
+  std::size_t num_words;
+  // S_j and T_j for each mode j
+  pauli_strings strings;
+
+  ladder_mapping(std::size_t num_modes)
+      : num_words((num_modes + 63) / 64) {
+    strings.num_words = num_words;
+    strings.masks.resize(4 * num_words * num_modes, 0);
+  }
+
+  std::uint64_t *s(std::size_t mode) {
+    return strings.masks.data() + 4 * num_words * mode;
+  }
+  std::uint64_t *t(std::size_t mode) { return s(mode) + 2 * num_words; }
+  const std::uint64_t *s(std::size_t mode) const {
+    return strings.masks.data() + 4 * num_words * mode;
+  }
+  const std::uint64_t *t(std::size_t mode) const {
+    return s(mode) + 2 * num_words;
+  }
+
+  void set(std::uint64_t *masks, std::size_t qubit, bool z) const {
+    const auto word = (z ? num_words : 0) + qubit / 64;
+    masks[word] ^= std::uint64_t(1) << (qubit % 64);
+  }
+};
+
+ladder_mapping jordan_wigner_mapping(std::size_t num_modes) {
+  ladder_mapping mapping(num_modes);
+  for (std::size_t j = 0; j < num_modes; ++j) {
+    auto *s = mapping.s(j), *t = mapping.t(j);
+    mapping.set(s, j, false);
+    mapping.set(t, j, false);
+    for (std::size_t k = 0; k < j; ++k) {
+      mapping.set(s, k, true);
+      mapping.set(t, k, true);
+    }
+    mapping.set(t, j, true);
+  }
+  return mapping;
+}
+
+ladder_mapping bravyi_kitaev_mapping(std::size_t num_modes) {
+  ladder_mapping mapping(num_modes);
+  for (std::size_t j = 0; j < num_modes; ++j) {
+    auto *s = mapping.s(j), *t = mapping.t(j);
+    // The indices of the Fenwick tree start at 1.
+    for (std::size_t i = j + 1; i <= num_modes; i += i & (~i + 1)) {
+      mapping.set(s, i - 1, false);
+      mapping.set(t, i - 1, false);
+    }
+    for (std::size_t i = j; i > 0; i &= i - 1) {
+      mapping.set(s, i - 1, true);
+      mapping.set(t, i - 1, true);
+    }
+    const std::size_t parent = (j + 1) & j;
+    mapping.set(t, j, true);
+    for (std::size_t i = j; i != parent; i &= i - 1)
+      mapping.set(t, i - 1, true);
+  }
+  return mapping;
+}
+
+/// Multiplies the Pauli strings `a` and `b` into `product`, which may alias
+/// `a`, and returns the phase `k` of the product `i^k`.
+unsigned multiply(const std::uint64_t *a, const std::uint64_t *b,
+                  std::uint64_t *product, std::size_t num_words) {
+  unsigned phase = 0;
+  for (std::size_t w = 0; w < num_words; ++w) {
+    const auto ax = a[w], az = a[num_words + w];
+    const auto bx = b[w], bz = b[num_words + w];
+    // ZX = iY, XY = iZ, YZ = iX, and the reverse orders give -i.
+    const auto plus =
+        (~ax & az & bx & ~bz) | (ax & ~az & bx & bz) | (ax & az & ~bx & bz);
+    const auto minus =
+        (ax & ~az & ~bx & bz) | (ax & az & bx & ~bz) | (~ax & az & bx & bz);
+    phase += std::popcount(plus) + 3 * std::popcount(minus);
+    product[w] = ax ^ bx;
+    product[num_words + w] = az ^ bz;
+  }
+  return phase % 4;
+}
+
+/// Adds the Pauli strings of `coefficient * prod_k ladder_k` to the
+/// accumulator, where each ladder operator is given by its mode and whether
+/// it is a creation operator.
+void add_ladder_product(
+    const ladder_mapping &mapping,
+    const std::vector<std::pair<std::size_t, bool>> &ladders,
+    std::complex<double> coefficient, std::vector<std::uint64_t> &buffer,
+    std::vector<std::complex<double>> &coefficients,
+    pauli_accumulator &accumulator) {
+  const auto num_words = mapping.num_words;
+  const auto stride = 2 * num_words;
+  // i^k for the phase k accumulated by multiplying Pauli matrices
+  const std::complex<double> phases[4] = {{1., 0.}, {0., 1.}, {-1., 0.},
+                                          {0., -1.}};
+  const std::size_t num_strings = std::size_t(1) << ladders.size();
+  buffer.assign(stride * num_strings, 0);
+  coefficients.assign(num_strings, 0.);
+  coefficients[0] = coefficient;
+  // Expand the product one ladder operator at a time: the first `count`
+  // strings are multiplied with S in place, and with T into the next `count`
+  // strings.
+  std::size_t count = 1;
+  for (const auto &[mode, create] : ladders) {
+    const std::complex<double> t_factor(0., create ? -0.5 : 0.5);
+    for (std::size_t k = 0; k < count; ++k) {
+      auto *a = buffer.data() + stride * k;
+      coefficients[k + count] =
+          coefficients[k] * t_factor *
+          phases[multiply(a, mapping.t(mode), a + stride * count, num_words)];
+      coefficients[k] *=
+          0.5 * phases[multiply(a, mapping.s(mode), a, num_words)];
+    }
+    count *= 2;
+  }
+  for (std::size_t k = 0; k < num_strings; ++k)
+    accumulator.add(buffer.data() + stride * k, coefficients[k]);
+}
+
+spin_op map_to_qubits(const ladder_mapping &mapping,
+                      const one_body_integrals &one_body,
+                      const two_body_integals &two_body, double constant,
+                      double tolerance) {
+  const std::size_t n = one_body.shape[0];
+  if (one_body.shape.size() != 2 || one_body.shape[1] != n ||
+      two_body.shape.size() != 4 ||
+      std::any_of(two_body.shape.begin(), two_body.shape.end(),
+                  [n](std::size_t dim) { return dim != n; }))
+    throw std::invalid_argument(
+        "The one and two-body integrals must be given over the same number "
+        "of spatial orbitals.");
+
+  // Each block contains the terms whose first index is the spatial orbital
+  // p. The blocks are mapped concurrently, and merged in order: the result
+  // does not depend on the number of threads.
+  pauli_accumulator total(mapping.num_words);
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    std::vector<std::uint64_t> buffer;
+    std::vector<std::complex<double>> coefficients;
+    std::vector<std::pair<std::size_t, bool>> ladders;
+#if defined(_OPENMP)
+#pragma omp for ordered schedule(dynamic)
+#endif
+    for (std::size_t p = 0; p < n; ++p) {
+      pauli_accumulator block(mapping.num_words);
+      for (std::size_t q = 0; q < n; ++q) {
+        const auto h = one_body(p, q);
+        if (std::abs(h) <= tolerance)
+          continue;
+        for (std::size_t spin = 0; spin < 2; ++spin) {
+          ladders = {{2 * p + spin, true}, {2 * q + spin, false}};
+          add_ladder_product(mapping, ladders, h, buffer, coefficients,
+                             block);
+        }
+      }
+      for (std::size_t q = 0; q < n; ++q)
+        for (std::size_t r = 0; r < n; ++r)
+          for (std::size_t s = 0; s < n; ++s) {
+            const auto h = two_body(p, q, r, s);
+            if (std::abs(h) <= tolerance)
+              continue;
+            for (std::size_t sigma = 0; sigma < 2; ++sigma)
+              for (std::size_t tau = 0; tau < 2; ++tau) {
+                // a+_p a+_q vanishes for identical spin orbitals, and so
+                // does a_r a_s.
+                if (sigma == tau && (p == q || r == s))
+                  continue;
+                ladders = {{2 * p + sigma, true},
+                           {2 * q + tau, true},
+                           {2 * r + tau, false},
+                           {2 * s + sigma, false}};
+                add_ladder_product(mapping, ladders, 0.5 * h, buffer,
+                                   coefficients, block);
+              }
+          }
+#if defined(_OPENMP)
+#pragma omp ordered
+#endif
+      total.add(block.strings);
+    }
+  }
+
+  const auto num_words = mapping.num_words;
+  auto hamiltonian = spin_op::empty();
+  if (std::abs(constant) > tolerance)
+    hamiltonian += constant * spin_op::identity();
+  for (std::size_t idx = 0; idx < total.strings.size(); ++idx) {
+    auto coefficient = total.strings.coefficients[idx];
+    if (std::abs(coefficient) <= tolerance)
+      continue;
+    if (std::abs(coefficient.imag()) <= tolerance)
+      coefficient = coefficient.real();
+    const auto *masks = total.strings[idx];
+    spin_op_term term(coefficient);
+    for (std::size_t qubit = 0; qubit < 2 * n; ++qubit) {
+      const auto bit = std::uint64_t(1) << (qubit % 64);
+      const bool x = masks[qubit / 64] & bit;
+      const bool z = masks[num_words + qubit / 64] & bit;
+      if (x && z)
+        term *= spin_op::y(qubit);
+      else if (x)
+        term *= spin_op::x(qubit);
+      else if (z)
+        term *= spin_op::z(qubit);
+    }
+    hamiltonian += term;
+  }
+  return hamiltonian;
+}
+} // namespace
+
+spin_op jordan_wigner(const one_body_integrals &one_body,
+                      const two_body_integals &two_body, double constant,
+                      double tolerance) {
+  return map_to_qubits(jordan_wigner_mapping(2 * one_body.shape[0]), one_body,
+                       two_body, constant, tolerance);
+}
+
+spin_op jordan_wigner(const molecular_hamiltonian &molecule,
+                      double tolerance) {
+  return jordan_wigner(molecule.one_body, molecule.two_body,
+                       molecule.nuclear_repulsion, tolerance);
+}
+
+spin_op bravyi_kitaev(const one_body_integrals &one_body,
+                      const two_body_integals &two_body, double constant,
+                      double tolerance) {
+  return map_to_qubits(bravyi_kitaev_mapping(2 * one_body.shape[0]), one_body,
+                       two_body, constant, tolerance);
+}
+
+spin_op bravyi_kitaev(const molecular_hamiltonian &molecule,
+                      double tolerance) {
+  return bravyi_kitaev(molecule.one_body, molecule.two_body,
+                       molecule.nuclear_repulsion, tolerance);
+}
+} // namespace cudaq
@@ -0,0 +1,45 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "cudaq/domains/chemistry/molecule.h"
+
+namespace cudaq {
+
+/// @brief Map the second quantized molecular Hamiltonian
+/// `constant + sum_pq h_pq a+_p a_q + 1/2 sum_pqrs h_pqrs a+_p a+_q a_r a_s`
+/// to qubits with the Jordan-Wigner transformation. The integrals are given
+/// over spatial orbitals, as in `molecular_hamiltonian`: the spin orbitals
+/// `2p` (alpha) and `2p + 1` (beta) of spatial orbital `p` are mapped to the
+/// qubits of the same index. The Pauli terms are generated directly from the
+/// integrals, concurrently over blocks of integrals if OpenMP is enabled, and
+/// the terms whose coefficient is below `tolerance` in magnitude are dropped.
+spin_op jordan_wigner(const one_body_integrals &one_body,
+                      const two_body_integals &two_body, double constant = 0.0,
+                      double tolerance = 1e-12);
+
+/// @brief Map the Hamiltonian of the given molecule to qubits with the
+/// Jordan-Wigner transformation, from its integrals and nuclear repulsion.
+spin_op jordan_wigner(const molecular_hamiltonian &molecule,
+                      double tolerance = 1e-12);
+
+/// @brief Map the second quantized molecular Hamiltonian to qubits with the
+/// Bravyi-Kitaev transformation. The arguments are the ones of
+/// `jordan_wigner`. The occupation and parity information is stored in the
+/// qubits following a Fenwick tree, as in OpenFermion's `bravyi_kitaev`, such
+/// that each mapped ladder operator acts on `O(log n)` qubits.
+spin_op bravyi_kitaev(const one_body_integrals &one_body,
+                      const two_body_integals &two_body, double constant = 0.0,
+                      double tolerance = 1e-12);
+
+/// @brief Map the Hamiltonian of the given molecule to qubits with the
+/// Bravyi-Kitaev transformation, from its integrals and nuclear repulsion.
+spin_op bravyi_kitaev(const molecular_hamiltonian &molecule,
+                      double tolerance = 1e-12);
+} // namespace cudaq
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#include "tapering.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace cudaq {
+namespace {
+
+using bit_vector = std::vector<std::uint64_t>;
+
+bool get_bit(const bit_vector &bits, std::size_t idx) {
+  return (bits[idx / 64] >> (idx % 64)) & 1;
+}
+
+void set_bit(bit_vector &bits, std::size_t idx) {
+  bits[idx / 64] |= std::uint64_t(1) << (idx % 64);
+}
+
+std::size_t num_qubits(const spin_op &op) {
+  std::size_t numQubits = 0;
+  for (const auto &term : op)
+    for (auto degree : term.degrees())
+      numQubits = std::max(numQubits, degree + 1);
+  return numQubits;
+}
+
+/// Multiplies the Pauli matrix `p` with `q` on the right, and returns the
+/// phase `k` of the product `i^k`.
+unsigned multiply(char &p, char q) {
+  if (q == 'I')
+    return 0;
+  if (p == 'I' || p == q) {
+    p = p == 'I' ? q : 'I';
+    return 0;
+  }
+  // XY = iZ, YZ = iX, ZX = iY, and the reverse orders give -i.
+  const char product = 'X' + 'Y' + 'Z' - p - q;
+  const bool cyclic = (p == 'X' && q == 'Y') || (p == 'Y' && q == 'Z') ||
+                      (p == 'Z' && q == 'X');
+  p = product;
+  return cyclic ? 1 : 3;
+}
+
+/// Whether the Pauli words of a product of Z operators and of a term commute.
+bool commutes(const std::string &generator, const std::string &word) {
+  bool result = true;
+  for (std::size_t q = 0; q < word.size(); ++q)
+    if (generator[q] == 'Z' && (word[q] == 'X' || word[q] == 'Y'))
+      result = !result;
+  return result;
+}
+} // namespace
+
+z2_symmetries find_z2_symmetries(const spin_op &op, std::size_t numQubits) {
+  z2_symmetries symmetries;
+  symmetries.num_qubits = std::max(numQubits, num_qubits(op));
+  const std::size_t n = symmetries.num_qubits;
+  const std::size_t numWords = (n + 63) / 64;
+
+  // A product of Z operators commutes with a term if it overlaps with an even
+  // number of its X and Y operators. The generators hence span the null space
+  // of the binary matrix whose rows are the X and Y positions of the terms,
+  // which is row reduced here. Each row is stored at its pivot, the lowest
+  // qubit it contains.
+  std::vector<bit_vector> rows(n);
+  std::vector<bool> isPivot(n, false);
+  for (const auto &term : op) {
+    bit_vector row(numWords, 0);
+    const auto word = term.get_pauli_word(n);
+    for (std::size_t q = 0; q < n; ++q)
+      if (word[q] == 'X' || word[q] == 'Y')
+        set_bit(row, q);
+    for (std::size_t q = 0; q < n; ++q) {
+      if (!get_bit(row, q))
+        continue;
+      if (!isPivot[q]) {
+        rows[q] = std::move(row);
+        isPivot[q] = true;
+        break;
+      }
+      for (std::size_t w = 0; w < numWords; ++w)
+        row[w] ^= rows[q][w];
+    }
+  }
+  // Back substitution into the reduced row echelon form
+  for (std::size_t c = 0; c < n; ++c) {
+    if (!isPivot[c])
+      continue;
+    for (std::size_t r = 0; r < c; ++r)
+      if (isPivot[r] && get_bit(rows[r], c))
+        for (std::size_t w = 0; w < numWords; ++w)
+          rows[r][w] ^= rows[c][w];
+  }
+
+  // Each free qubit gives a generator, which contains the free qubit, the
+  // pivots of the rows that contain it, and no other free qubit.
+  for (std::size_t f = 0; f < n; ++f) {
+    if (isPivot[f])
+      continue;
+    spin_op_term generator = spin_op::z(f);
+    for (std::size_t c = 0; c < f; ++c)
+      if (isPivot[c] && get_bit(rows[c], f))
+        generator *= spin_op::z(c);
+    symmetries.generators.push_back(std::move(generator));
+    symmetries.tapered_qubits.push_back(f);
+  }
+  return symmetries;
+}
+
+std::vector<int> get_z2_sector(const z2_symmetries &symmetries,
+                               const std::vector<bool> &basisState) {
+  std::vector<int> sector;
+  sector.reserve(symmetries.generators.size());
+  for (const auto &generator : symmetries.generators) {
+    int eigenvalue = 1;
+    for (auto degree : generator.degrees())
+      if (degree < basisState.size() && basisState[degree])
+        eigenvalue = -eigenvalue;
+    sector.push_back(eigenvalue);
+  }
+  return sector;
+}
+
+bool commutes_with(const spin_op &op, const z2_symmetries &symmetries) {
+  const auto n = std::max(symmetries.num_qubits, num_qubits(op));
+  for (const auto &generator : symmetries.generators) {
+    const auto generatorWord = generator.get_pauli_word(n);
+    for (const auto &term : op)
+      if (!commutes(generatorWord, term.get_pauli_word(n)))
+        return false;
+  }
+  return true;
+}
+
+spin_op taper(const spin_op &op, const z2_symmetries &symmetries,
+              const std::vector<int> &sector) {
+  const auto n = symmetries.num_qubits;
+  const auto numGenerators = symmetries.generators.size();
+  if (sector.size() != numGenerators ||
+      std::any_of(sector.begin(), sector.end(),
+                  [](int s) { return s != 1 && s != -1; }))
+    throw std::invalid_argument("The sector must contain an eigenvalue, 1 or "
+                                "-1, for each generator of the symmetries.");
+  if (num_qubits(op) > n)
+    throw std::invalid_argument(
+        "The operator acts on more qubits than its symmetries.");
+  std::vector<std::string> generators;
+  for (const auto &generator : symmetries.generators)
+    generators.push_back(generator.get_pauli_word(n));
+  std::vector<bool> isTapered(n, false);
+  for (auto q : symmetries.tapered_qubits)
+    isTapered[q] = true;
+
+  // i^k for the phase k accumulated by multiplying Pauli matrices
+  const std::complex<double> phases[4] = {{1., 0.}, {0., 1.}, {-1., 0.},
+                                          {0., -1.}};
+  std::vector<std::string> words;
+  std::vector<std::complex<double>> coefficients;
+  std::unordered_map<std::string, std::size_t> indices;
+  for (const auto &term : op) {
+    auto word = term.get_pauli_word(n);
+    auto coefficient = term.evaluate_coefficient();
+    for (std::size_t i = 0; i < numGenerators; ++i) {
+      const auto &generator = generators[i];
+      if (!commutes(generator, word))
+        throw std::invalid_argument(
+            "The operator does not commute with the Z2 symmetries.");
+      // (X_q + tau) P (X_q + tau) / 2 = -P X_q tau if P anticommutes with
+      // X_q, and P otherwise.
+      const auto qubit = symmetries.tapered_qubits[i];
+      if (word[qubit] != 'Z' && word[qubit] != 'Y')
+        continue;
+      unsigned phase = 2 + multiply(word[qubit], 'X');
+      for (std::size_t q = 0; q < n; ++q)
+        phase += multiply(word[q], generator[q]);
+      coefficient *= phases[phase % 4];
+    }
+    // The tapered qubits are now acted on by I or X, and X is replaced by
+    // the eigenvalue of the generator.
+    std::string reduced;
+    for (std::size_t i = 0; i < numGenerators; ++i)
+      if (word[symmetries.tapered_qubits[i]] == 'X')
+        coefficient *= sector[i];
+    for (std::size_t q = 0; q < n; ++q)
+      if (!isTapered[q])
+        reduced.push_back(word[q]);
+    auto [iter, inserted] = indices.try_emplace(reduced, words.size());
+    if (inserted) {
+      words.push_back(std::move(reduced));
+      coefficients.push_back(coefficient);
+    } else {
+      coefficients[iter->second] += coefficient;
+    }
+  }
+
+  auto tapered = spin_op::empty();
+  for (std::size_t idx = 0; idx < words.size(); ++idx) {
+    // Drop the terms that cancel out.
+    if (std::abs(coefficients[idx]) <= 1e-12)
+      continue;
+    spin_op_term term(coefficients[idx]);
+    for (std::size_t q = 0; q < words[idx].size(); ++q) {
+      if (words[idx][q] == 'X')
+        term *= spin_op::x(q);
+      else if (words[idx][q] == 'Y')
+        term *= spin_op::y(q);
+      else if (words[idx][q] == 'Z')
+        term *= spin_op::z(q);
+    }
+    tapered += term;
+  }
+  return tapered;
+}
+
+std::vector<bool> taper_basis_state(const z2_symmetries &symmetries,
+                                    const std::vector<bool> &basisState) {
+  std::vector<bool> isTapered(symmetries.num_qubits, false);
+  for (auto q : symmetries.tapered_qubits)
+    isTapered[q] = true;
+  std::vector<bool> reduced;
+  for (std::size_t q = 0; q < symmetries.num_qubits; ++q)
+    if (!isTapered[q])
+      reduced.push_back(q < basisState.size() && basisState[q]);
+  return reduced;
+}
+
+tapered_hamiltonian taper_hamiltonian(const spin_op &hamiltonian,
+                                      std::size_t numElectrons) {
+  tapered_hamiltonian result;
+  result.symmetries = find_z2_symmetries(hamiltonian);
+  std::vector<bool> hartreeFock(result.symmetries.num_qubits, false);
+  for (std::size_t q = 0; q < numElectrons; ++q)
+    hartreeFock[q] = true;
+  result.sector = get_z2_sector(result.symmetries, hartreeFock);
+  result.hamiltonian = taper(hamiltonian, result.symmetries, result.sector);
+  result.hartree_fock_state =
+      taper_basis_state(result.symmetries, hartreeFock);
+  return result;
+}
+
+tapered_hamiltonian taper_hamiltonian(const molecular_hamiltonian &molecule) {
+  return taper_hamiltonian(molecule.hamiltonian, molecule.n_electrons);
+}
+} // namespace cudaq
@@ -0,0 +1,75 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "cudaq/domains/chemistry/molecule.h"
+
+namespace cudaq {
+
+/// @brief The Z2 symmetries of a qubit operator: independent products of Pauli
+/// Z operators that commute with every term of the operator. Each generator
+/// acts on its tapered qubit, on which none of the other generators act.
+struct z2_symmetries {
+  /// @brief The number of qubits of the operator.
+  std::size_t num_qubits = 0;
+  /// @brief The generators of the symmetry group.
+  std::vector<spin_op_term> generators;
+  /// @brief For each generator, the qubit that tapering removes.
+  std::vector<std::size_t> tapered_qubits;
+};
+
+/// @brief Find the Z2 symmetries of `op`, over `numQubits` qubits or the
+/// qubits that `op` acts on if larger. Each generator allows removing one
+/// qubit: the tapered operator acts on `num_qubits - generators.size()`
+/// qubits.
+z2_symmetries find_z2_symmetries(const spin_op &op, std::size_t numQubits = 0);
+
+/// @brief Return the eigenvalue, `1` or `-1`, of each generator of the
+/// symmetries on the computational basis state whose qubit `i` is
+/// `basisState[i]`.
+std::vector<int> get_z2_sector(const z2_symmetries &symmetries,
+                               const std::vector<bool> &basisState);
+
+/// @brief Return whether every term of `op` commutes with the symmetries.
+bool commutes_with(const spin_op &op, const z2_symmetries &symmetries);
+
+/// @brief Taper `op`, which must commute with the symmetries, in the given
+/// sector of eigenvalues of their generators. The operator is transformed by
+/// the Clifford `U = prod_i (X_(q_i) + tau_i) / sqrt(2)`, which maps each
+/// generator `tau_i` to `X` on its tapered qubit `q_i`. That `X` is replaced
+/// by the eigenvalue of the sector, and the tapered qubits are removed. The
+/// remaining qubits are renumbered in order.
+spin_op taper(const spin_op &op, const z2_symmetries &symmetries,
+              const std::vector<int> &sector);
+
+/// @brief Return the computational basis state on the remaining qubits that
+/// corresponds to `basisState` after tapering in the sector of `basisState`.
+std::vector<bool> taper_basis_state(const z2_symmetries &symmetries,
+                                    const std::vector<bool> &basisState);
+
+/// @brief A molecular Hamiltonian tapered in the symmetry sector of its
+/// Hartree-Fock state.
+struct tapered_hamiltonian {
+  spin_op hamiltonian;
+  z2_symmetries symmetries;
+  std::vector<int> sector;
+  /// @brief The Hartree-Fock state on the remaining qubits.
+  std::vector<bool> hartree_fock_state;
+};
+
+/// @brief Taper the Jordan-Wigner mapped Hamiltonian of a molecule, in the
+/// sector of the Hartree-Fock state, in which the first `numElectrons`
+/// spin orbitals are occupied.
+tapered_hamiltonian taper_hamiltonian(const spin_op &hamiltonian,
+                                      std::size_t numElectrons);
+
+/// @brief Taper the Hamiltonian of the given molecule, which must not be
+/// restricted to an active space.
+tapered_hamiltonian taper_hamiltonian(const molecular_hamiltonian &molecule);
+} // namespace cudaq
@@ -9,8 +9,11 @@
 #pragma once
 
 #include "cudaq/builder/kernel_builder.h"
+#include "cudaq/domains/chemistry/tapering.h"
+#include "cudaq/kernels/givens_rotation.h"
 #include "cudaq/qis/qubit_qis.h"
 #include "cudaq/utils/cudaq_utils.h"
+#include <bit>
 
 namespace cudaq {
 
@@ -112,6 +115,217 @@ auto uccsd_num_parameters(std::size_t numElectrons, std::size_t numQubits) {
          doublesAlpha.size() + doublesBeta.size();
 }
 
+/// @brief Return the generator `G_k` of each excitation of the UCCSD ansatz,
+/// in the order of the parameters: `uccsd` applies `exp(i theta_k G_k)` for
+/// each parameter `theta_k`. The generators act on the Jordan-Wigner mapped
+/// spin orbitals.
+inline std::vector<spin_op> get_uccsd_generators(std::size_t numElectrons,
+                                                 std::size_t numQubits) {
+  auto [singlesAlpha, singlesBeta, doublesMixed, doublesAlpha, doublesBeta] =
+      get_uccsd_excitations(numElectrons, numQubits);
+  const auto pauli = [](char p, std::size_t q) -> spin_op_term {
+    return p == 'X' ? spin_op::x(q) : spin_op::y(q);
+  };
+  // Z on the qubits strictly between first and last
+  const auto parity = [](std::size_t first, std::size_t last) {
+    spin_op_term string = spin_op::identity();
+    for (std::size_t q = first + 1; q < last; ++q)
+      string *= spin_op::z(q);
+    return string;
+  };
+
+  std::vector<spin_op> generators;
+  // The two rotations of singleExcitation
+  for (const auto *singles : {&singlesAlpha, &singlesBeta})
+    for (const auto &single : *singles) {
+      const auto p = single[0], q = single[1];
+      generators.push_back(
+          -0.25 * pauli('Y', p) * parity(p, q) * pauli('X', q) +
+          0.25 * pauli('X', p) * parity(p, q) * pauli('Y', q));
+    }
+  // The eight rotations of doubleExcitation, on the qubits ordered as
+  // i < j < a < b, with their signs
+  const std::vector<std::pair<std::string, double>> rotations{
+      {"XXXY", 1.}, {"XXYX", 1.}, {"XYXX", -1.}, {"XYYY", 1.},
+      {"YXYY", 1.}, {"YXXX", -1.}, {"YYXY", -1.}, {"YYYX", -1.}};
+  for (const auto *doubles : {&doublesMixed, &doublesAlpha, &doublesBeta})
+    for (const auto &excitation : *doubles) {
+      auto occupied = std::minmax(excitation[0], excitation[1]);
+      auto virtuals = std::minmax(excitation[2], excitation[3]);
+      const double sign = (excitation[0] < excitation[1]) ==
+                                  (excitation[2] < excitation[3])
+                              ? 1.
+                              : -1.;
+      const auto [i, j] = occupied;
+      const auto [a, b] = virtuals;
+      auto generator = spin_op::empty();
+      for (const auto &[word, rotationSign] : rotations)
+        generator += (-sign * rotationSign / 16.) * pauli(word[0], i) *
+                     parity(i, j) * pauli(word[1], j) * pauli(word[2], a) *
+                     parity(a, b) * pauli(word[3], b);
+      generators.push_back(std::move(generator));
+    }
+  return generators;
+}
+
+/// @brief The Pauli rotations `exp(i coefficients[k] theta_(parameters[k])
+/// words[k])` of an ansatz on tapered qubits, see `tapered_uccsd`.
+struct pauli_rotations {
+  std::vector<double> coefficients;
+  std::vector<cudaq::pauli_word> words;
+  std::vector<std::size_t> parameters;
+};
+
+/// @brief Taper the UCCSD ansatz with the symmetries of a Hamiltonian, in the
+/// same sector. The rotations take the parameters of `uccsd`: applied to the
+/// tapered Hartree-Fock state, they prepare the tapered state of `uccsd` with
+/// the same parameters. The excitations that do not commute with the
+/// symmetries leave the sector, and are dropped: their parameters are unused.
+inline pauli_rotations taper_uccsd(std::size_t numElectrons,
+                                   const z2_symmetries &symmetries,
+                                   const std::vector<int> &sector) {
+  const auto numTaperedQubits =
+      symmetries.num_qubits - symmetries.tapered_qubits.size();
+  pauli_rotations rotations;
+  const auto generators =
+      get_uccsd_generators(numElectrons, symmetries.num_qubits);
+  for (std::size_t k = 0; k < generators.size(); ++k) {
+    if (!commutes_with(generators[k], symmetries))
+      continue;
+    for (const auto &term : taper(generators[k], symmetries, sector)) {
+      // Rotations about the identity are global phases.
+      if (term.is_identity())
+        continue;
+      rotations.coefficients.push_back(term.evaluate_coefficient().real());
+      rotations.words.emplace_back(term.get_pauli_word(numTaperedQubits));
+      rotations.parameters.push_back(k);
+    }
+  }
+  return rotations;
+}
+
+/// @overload
+inline pauli_rotations taper_uccsd(std::size_t numElectrons,
+                                   const tapered_hamiltonian &hamiltonian) {
+  return taper_uccsd(numElectrons, hamiltonian.symmetries, hamiltonian.sector);
+}
+
+/// @brief A gate of the low-depth UCCSD ansatz, see
+/// `get_low_depth_uccsd_gates`. The `ry` rotation of `q0` and the `givens`
+/// rotation of `q0` and `q1` are by the angle `coefficient *
+/// thetas[parameter]`.
+struct uccsd_gate {
+  enum kind { cx, cz, ry, givens };
+  kind op;
+  std::size_t q0;
+  std::size_t q1 = 0;
+  double coefficient = 0.;
+  std::size_t parameter = 0;
+};
+
+/// @brief Return the gates of the low-depth UCCSD ansatz, which applies the
+/// same unitary as `uccsd` for the same parameters with fewer two-qubit gates.
+///
+/// All the Pauli rotations of an excitation commute, and are applied together
+/// rather than one after the other. The Jordan-Wigner strings of the
+/// excitation are removed by a CNOT ladder, which computes their parity, and a
+/// CZ. The single excitations are then Givens rotations on their two qubits.
+/// The double excitations are rotations between `|1100>` and `|0011>` on their
+/// four qubits, applied by CNOTs and a rotation of one qubit controlled by the
+/// other three, decomposed into 8 CNOTs by a Gray code. The CNOTs and CZs that
+/// cancel between consecutive excitations, in particular the ladders over the
+/// same qubits, are not applied.
+inline std::vector<uccsd_gate>
+get_low_depth_uccsd_gates(std::size_t numElectrons, std::size_t numQubits) {
+  auto [singlesAlpha, singlesBeta, doublesMixed, doublesAlpha, doublesBeta] =
+      get_uccsd_excitations(numElectrons, numQubits);
+  std::vector<uccsd_gate> gates;
+  // Append a CNOT or CZ, or remove the same gate if no gate acted on its
+  // qubits since.
+  const auto append = [&](uccsd_gate::kind op, std::size_t q0,
+                          std::size_t q1) {
+    for (auto iter = gates.rbegin(); iter != gates.rend(); ++iter) {
+      const bool touches = iter->q0 == q0 || iter->q0 == q1 ||
+                           (iter->op != uccsd_gate::ry &&
+                            (iter->q1 == q0 || iter->q1 == q1));
+      if (!touches)
+        continue;
+      if (iter->op == op && iter->q0 == q0 && iter->q1 == q1) {
+        gates.erase(std::next(iter).base());
+        return;
+      }
+      break;
+    }
+    gates.push_back({op, q0, q1});
+  };
+  // The Jordan-Wigner string between the qubits `lo` and `hi` is removed by
+  // computing its parity into qubit `hi - 1` with a CNOT ladder, and applying
+  // a CZ with qubit `hi`.
+  const auto ladder = [&](std::size_t lo, std::size_t hi, bool undo) {
+    if (hi < lo + 2)
+      return;
+    if (!undo)
+      for (auto k = lo + 1; k + 1 < hi; ++k)
+        append(uccsd_gate::cx, k, k + 1);
+    else
+      for (auto k = hi - 1; k > lo + 1; --k)
+        append(uccsd_gate::cx, k - 1, k);
+  };
+  const auto string = [&](std::size_t lo, std::size_t hi) {
+    if (hi >= lo + 2)
+      append(uccsd_gate::cz, hi - 1, hi);
+  };
+
+  std::size_t parameter = 0;
+  for (const auto *singles : {&singlesAlpha, &singlesBeta})
+    for (const auto &single : *singles) {
+      const auto p = single[0], q = single[1];
+      ladder(p, q, false);
+      string(p, q);
+      gates.push_back({uccsd_gate::givens, p, q, 0.5, parameter++});
+      string(p, q);
+      ladder(p, q, true);
+    }
+  for (const auto *doubles : {&doublesMixed, &doublesAlpha, &doublesBeta})
+    for (const auto &excitation : *doubles) {
+      const auto [i, j] = std::minmax(excitation[0], excitation[1]);
+      const auto [a, b] = std::minmax(excitation[2], excitation[3]);
+      const double sign = (excitation[0] < excitation[1]) ==
+                                  (excitation[2] < excitation[3])
+                              ? 1.
+                              : -1.;
+      ladder(i, j, false);
+      ladder(a, b, false);
+      string(i, j);
+      string(a, b);
+      // Map |1100> and |0011> on the qubits i, j, a, b to the two states in
+      // which j, a, b are |010>, and rotate qubit i controlled on that state.
+      append(uccsd_gate::cx, i, j);
+      append(uccsd_gate::cx, a, b);
+      append(uccsd_gate::cx, i, a);
+      // The rotation by the angle c_s for each state s of the controls is
+      // applied as the rotations by (1/8) sum_s (-1)^(s.g) c_s, each followed
+      // by a CNOT from the control that changes in the Gray code g.
+      const std::size_t controls[3] = {j, a, b};
+      for (unsigned k = 0; k < 8; ++k) {
+        const unsigned gray = k ^ (k >> 1);
+        const unsigned next = ((k + 1) % 8) ^ (((k + 1) % 8) >> 1);
+        const double parity = (gray >> 1) & 1 ? -1. : 1.;
+        gates.push_back({uccsd_gate::ry, i, 0, -sign * parity / 8., parameter});
+        append(uccsd_gate::cx, controls[std::countr_zero(gray ^ next)], i);
+      }
+      ++parameter;
+      append(uccsd_gate::cx, i, a);
+      append(uccsd_gate::cx, a, b);
+      append(uccsd_gate::cx, i, j);
+      string(a, b);
+      string(i, j);
+      ladder(a, b, true);
+      ladder(i, j, true);
+    }
+  return gates;
+}
+
 __qpu__ void singleExcitation(cudaq::qview<> qubits, std::size_t pOcc,
                               std::size_t qVirt, double theta) {
   // Y_p X_q
@@ -595,6 +809,42 @@ __qpu__ void uccsd(cudaq::qview<> qubits, const std::vector<double> &thetas,
                      thetas[thetaCounter++]);
 }
 
+/// @brief The UCCSD ansatz on tapered qubits, with the rotations returned by
+/// `taper_uccsd` and the parameters of `uccsd`.
+__qpu__ void tapered_uccsd(cudaq::qview<> qubits,
+                           const std::vector<double> &thetas,
+                           const std::vector<double> &coefficients,
+                           const std::vector<cudaq::pauli_word> &words,
+                           const std::vector<std::size_t> &parameters) {
+  for (std::size_t k = 0; k < words.size(); k++)
+    exp_pauli(coefficients[k] * thetas[parameters[k]], qubits, words[k]);
+}
+
+/// @brief The low-depth UCCSD ansatz, with the gates returned by
+/// `get_low_depth_uccsd_gates`. It takes the same arguments as `uccsd`.
+__qpu__ void low_depth_uccsd(cudaq::qview<> qubits,
+                             const std::vector<double> &thetas,
+                             std::size_t numElectrons) {
+  for (const auto &gate :
+       get_low_depth_uccsd_gates(numElectrons, qubits.size())) {
+    const double angle = gate.coefficient * thetas[gate.parameter];
+    switch (gate.op) {
+    case uccsd_gate::cx:
+      cx(qubits[gate.q0], qubits[gate.q1]);
+      break;
+    case uccsd_gate::cz:
+      cz(qubits[gate.q0], qubits[gate.q1]);
+      break;
+    case uccsd_gate::ry:
+      ry(angle, qubits[gate.q0]);
+      break;
+    case uccsd_gate::givens:
+      givens_rotation(angle, qubits[gate.q0], qubits[gate.q1]);
+      break;
+    }
+  }
+}
+
 template <typename Kernel>
 void uccsd(Kernel &kernel, QuakeValue &qubits, QuakeValue &thetas,
            std::size_t numElectrons, std::size_t numQubits) {
@@ -640,4 +890,27 @@ void uccsd(Kernel &kernel, QuakeValue &qubits, QuakeValue &thetas,
   }
 }
 
+template <typename Kernel>
+void low_depth_uccsd(Kernel &kernel, QuakeValue &qubits, QuakeValue &thetas,
+                     std::size_t numElectrons, std::size_t numQubits) {
+  for (const auto &gate : get_low_depth_uccsd_gates(numElectrons, numQubits)) {
+    switch (gate.op) {
+    case uccsd_gate::cx:
+      kernel.template x<cudaq::ctrl>(qubits[gate.q0], qubits[gate.q1]);
+      break;
+    case uccsd_gate::cz:
+      kernel.template z<cudaq::ctrl>(qubits[gate.q0], qubits[gate.q1]);
+      break;
+    case uccsd_gate::ry:
+      kernel.ry(gate.coefficient * thetas[gate.parameter], qubits[gate.q0]);
+      break;
+    case uccsd_gate::givens:
+      builder::givens_rotation(kernel,
+                               gate.coefficient * thetas[gate.parameter],
+                               qubits[gate.q0], qubits[gate.q1]);
+      break;
+    }
+  }
+}
+
 } // namespace cudaq
@@ -157,6 +157,16 @@ public:
   /// in the first place.
   static bool remove_definition(const std::string &operator_id);
 
+  /// @brief Marks the operator with the given id as time-dependent, meaning
+  /// its matrix depends on state other than the dimensions and parameters
+  /// passed to its callback. By default, the matrix of a defined operator is
+  /// memoized and only recomputed for new dimensions or values of the
+  /// parameters in its descriptions (of any parameter if it has none); that
+  /// memoization is disabled for operators marked as time-dependent.
+  /// Throws if no operator with the given id has been defined.
+  static void set_time_dependent(const std::string &operator_id,
+                                 bool is_time_dependent = true);
+
   /// @brief Instantiates a custom operator.
   /// @param operator_id : The ID of the operator as specified when it was
   /// defined.
@@ -183,6 +193,10 @@ public:
   /// is defined for any dimension of that degree.
   const std::vector<std::int64_t> &get_expected_dimensions() const;
 
+  /// @brief Returns true if the operator was marked as time-dependent with
+  /// `set_time_dependent`.
+  bool is_time_dependent() const;
+
   // read-only properties
 
   const commutation_relations &commutation_group = this->group;
@@ -25,6 +25,18 @@ namespace cudaq {
 class spin_handler;
 enum class pauli;
 
+/// @brief The commutation relation required between the terms of a group when
+/// partitioning a spin operator with `group_commuting`.
+enum class grouping_strategy {
+  /// Terms act with the same Pauli operator on every qubit they have in
+  /// common. All terms of a group can be measured with a single circuit that
+  /// only appends single-qubit basis changes.
+  qubit_wise,
+  /// Terms commute as operators. Groups are larger, but measuring a group
+  /// jointly requires an entangling diagonalization circuit.
+  general
+};
+
 #define HANDLER_SPECIFIC_TEMPLATE(ConcreteTy)                                  \
   template <typename T = HandlerTy,                                            \
             std::enable_if_t<std::is_same<T, ConcreteTy>::value &&             \
@@ -64,6 +76,12 @@ private:
   // inserts a new term combining it with an existing one if possible
   void insert(product_op<HandlerTy> &&other);
   void insert(const product_op<HandlerTy> &other);
+  void insert(std::string &&term_id, product_op<HandlerTy> &&other);
+
+  // inserts the terms make_term(0), ..., make_term(count - 1) in this order;
+  // if parallel is true, the terms and their ids are constructed concurrently
+  template <typename TermFn>
+  void insert_terms(std::size_t count, const TermFn &make_term, bool parallel);
 
   void aggregate_terms();
 
@@ -802,6 +820,16 @@ public:
   HANDLER_SPECIFIC_TEMPLATE(spin_handler)
   sum_op(const std::vector<double> &input_vec);
 
+  /// @brief Partitions the terms into groups of mutually commuting terms.
+  /// Each term is greedily assigned to the first group it commutes with
+  /// according to the given strategy; identity terms commute with every group.
+  /// @param strategy The commutation relation required within a group.
+  /// @return A vector of sum_op<HandlerTy>, one per group, that together
+  /// contain each term of this operator exactly once.
+  HANDLER_SPECIFIC_TEMPLATE(spin_handler)
+  std::vector<sum_op<HandlerTy>> group_commuting(
+      grouping_strategy strategy = grouping_strategy::qubit_wise) const;
+
   HANDLER_SPECIFIC_TEMPLATE(spin_handler)
   static product_op<HandlerTy> from_word(const std::string &word);
 
@@ -827,6 +855,26 @@ public:
           {},
       bool invert_order = false) const;
 
+  /// @brief Return the sparse matrix representation of the operator.
+  /// The matrix is assembled row by row from the matrices of the elementary
+  /// operators, without creating the dense matrix of the operator.
+  /// By default, the matrix is ordered according to the convention (endianness)
+  /// used in CUDA-Q, and the ordering returned by `degrees`. See
+  /// the documentation for `degrees` for more detail.
+  /// @arg `dimensions` : A mapping that specifies the number of levels,
+  ///                      that is, the dimension of each degree of freedom
+  ///                      that the operator acts on. Example for two, 2-level
+  ///                      degrees of freedom: `{0:2, 1:2}`.
+  /// @arg `parameters` : A map of the parameter names to their concrete,
+  /// complex values.
+  /// @arg `invert_order`: if set to true, the ordering convention is reversed.
+  PROPERTY_AGNOSTIC_TEMPLATE(product_op<T>::supports_inplace_mult)
+  csr_spmatrix to_sparse_matrix(
+      std::unordered_map<std::size_t, std::int64_t> dimensions = {},
+      const std::unordered_map<std::string, std::complex<double>> &parameters =
+          {},
+      bool invert_order = false) const;
+
   /// @brief Return the multi-diagonal matrix representation of the operator.
   /// By default, the matrix is ordered according to the convention (endianness)
   /// used in CUDA-Q, and the ordering returned by `degrees`. See
@@ -1689,6 +1737,26 @@ public:
           {},
       bool invert_order = false) const;
 
+  /// @brief Return the sparse matrix representation of the operator.
+  /// The matrix is assembled row by row from the matrices of the elementary
+  /// operators, without creating the dense matrix of the operator.
+  /// By default, the matrix is ordered according to the convention (endianness)
+  /// used in CUDA-Q, and the ordering returned by `degrees`. See
+  /// the documentation for `degrees` for more detail.
+  /// @arg `dimensions` : A mapping that specifies the number of levels,
+  ///                      that is, the dimension of each degree of freedom
+  ///                      that the operator acts on. Example for two, 2-level
+  ///                      degrees of freedom: `{0:2, 1:2}`.
+  /// @arg `parameters` : A map of the parameter names to their concrete,
+  /// complex values.
+  /// @arg `invert_order`: if set to true, the ordering convention is reversed.
+  PROPERTY_AGNOSTIC_TEMPLATE(product_op<T>::supports_inplace_mult)
+  csr_spmatrix to_sparse_matrix(
+      std::unordered_map<std::size_t, std::int64_t> dimensions = {},
+      const std::unordered_map<std::string, std::complex<double>> &parameters =
+          {},
+      bool invert_order = false) const;
+
   /// @brief Return the multi-diagonal matrix representation of the operator.
   /// By default, the matrix is ordered according to the convention (endianness)
   /// used in CUDA-Q, and the ordering returned by `degrees`. See
@@ -1868,6 +1936,36 @@ public:
   /// @return Number of terms
   std::size_t num_terms() const { return m_terms.size(); }
 
+  /// @brief Return the sparse matrix of the super-operator acting on the
+  /// vectorized density matrix, without creating any dense matrix.
+  /// The density matrix is vectorized row by row (as `numpy.ravel` does), such
+  /// that `rho * B` maps to the matrix `I (x) B^T`, and `A * rho` to
+  /// `A (x) I`. The density matrix is defined on all degrees the
+  /// super-operator acts on, ordered as for `sum_op::to_sparse_matrix`.
+  /// @arg `dimensions` : A mapping that specifies the number of levels of each
+  /// degree of freedom.
+  /// @arg `parameters` : A map of the parameter names to their concrete,
+  /// complex values.
+  /// @arg `invert_order`: if set to true, the ordering convention is reversed.
+  csr_spmatrix to_sparse_matrix(
+      std::unordered_map<std::size_t, std::int64_t> dimensions = {},
+      const std::unordered_map<std::string, std::complex<double>> &parameters =
+          {},
+      bool invert_order = false) const;
+
+  /// @brief Return the sparse matrix of the Liouvillian of the Lindblad master
+  /// equation with the given Hamiltonian and collapse operators, i.e., of
+  /// `-i[H, rho] + sum_k (L_k rho L_k^dag - 1/2 {L_k^dag L_k, rho})`, acting
+  /// on the density matrix vectorized as for `to_sparse_matrix`.
+  static csr_spmatrix lindblad_sparse_matrix(
+      const cudaq::sum_op<cudaq::matrix_handler> &hamiltonian,
+      const std::vector<cudaq::sum_op<cudaq::matrix_handler>>
+          &collapse_operators,
+      std::unordered_map<std::size_t, std::int64_t> dimensions = {},
+      const std::unordered_map<std::string, std::complex<double>> &parameters =
+          {},
+      bool invert_order = false);
+
 private:
   /// @brief Construct a super-operator from a term
   /// @param term Super-operator term
@@ -187,61 +187,89 @@ void boson_handler::create_matrix(
     return tokens;
   };
 
-  auto map_state = [&tokenize](std::string encoding, std::int64_t old_state) {
-    if (encoding == "I")
-      return std::pair<double, std::int64_t>{1., old_state};
+  // Each term acts on a single degree and maps every level to at most one
+  // level; the entries of the matrix are hence the products of the non-zero
+  // entries of the terms. We compute these once per degree, dropping the
+  // levels that are quenched or mapped beyond the cutoff, and only visit the
+  // non-zero entries of the product.
+  struct level_map {
+    std::int64_t old_level;
+    std::int64_t new_level;
+    double value;
+  };
+  auto map_levels = [&tokenize](const std::string &encoding,
+                                std::int64_t dimension) {
+    std::vector<level_map> levels;
+    if (encoding == "I") {
+      levels.reserve(dimension);
+      for (std::int64_t level = 0; level < dimension; ++level)
+        levels.push_back({level, level, 1.});
+      return levels;
+    }
     auto ops = tokenize(encoding, '.');
     assert(ops.size() > 0);
-
-    auto it = ops.cbegin();
-    int additional_terms = std::stol(*it);
-    std::int64_t new_state = old_state + additional_terms;
-    if (new_state < 0)
-      return std::pair<double, std::int64_t>{0., old_state};
-
-    double value = 1.;
-    if (additional_terms > 0)
-      for (auto offset = additional_terms; offset > 0; --offset)
-        value *= std::sqrt(old_state + offset);
-    if (additional_terms < 0)
-      for (auto offset = -additional_terms; offset > 0; --offset)
-        value *= std::sqrt(new_state + offset);
-    while (++it != ops.cend())
-      value *= (new_state + std::stol(*it));
-    return std::pair<double, std::int64_t>{value, new_state};
+    int additional_terms = std::stol(ops[0]);
+    std::vector<std::int64_t> number_offsets;
+    number_offsets.reserve(ops.size() - 1);
+    for (std::size_t idx = 1; idx < ops.size(); ++idx)
+      number_offsets.push_back(std::stol(ops[idx]));
+
+    for (std::int64_t old_level = 0; old_level < dimension; ++old_level) {
+      std::int64_t new_level = old_level + additional_terms;
+      if (new_level < 0 || new_level >= dimension)
+        continue;
+      double value = 1.;
+      if (additional_terms > 0)
+        for (auto offset = additional_terms; offset > 0; --offset)
+          value *= std::sqrt(old_level + offset);
+      if (additional_terms < 0)
+        for (auto offset = -additional_terms; offset > 0; --offset)
+          value *= std::sqrt(new_level + offset);
+      for (auto offset : number_offsets)
+        value *= (new_level + offset);
+      if (value != 0.)
+        levels.push_back({old_level, new_level, value});
+    }
+    return levels;
   };
 
-  auto states = cudaq::detail::generate_all_states(dimensions);
-  if (states.size() == 0)
-    process_element(0, 0, 1.);
+  const auto nr_degrees = dimensions.size();
   std::vector<std::string> boson_terms = tokenize(boson_word, '_');
-  std::size_t old_state_idx = 0;
-  for (const auto &old_state : states) {
-    std::vector<std::int64_t> new_state(old_state.size(), 0);
-    std::complex<double> entry = 1.;
-    for (std::size_t degree = 0; degree < old_state.size(); ++degree) {
-      auto state = old_state[degree];
-      auto op =
-          boson_terms[invert_order ? old_state.size() - 1 - degree : degree];
-      auto mapped = map_state(op, state);
-      entry *= mapped.first;
-      if (mapped.second >= dimensions[degree])
-        entry = 0.;
-      else
-        new_state[degree] = mapped.second;
+  std::vector<std::vector<level_map>> level_maps;
+  level_maps.reserve(nr_degrees);
+  std::vector<std::size_t> strides(nr_degrees, 1);
+  for (std::size_t degree = 0; degree < nr_degrees; ++degree) {
+    const auto &op =
+        boson_terms[invert_order ? nr_degrees - 1 - degree : degree];
+    level_maps.push_back(map_levels(op, dimensions[degree]));
+    if (level_maps.back().empty())
+      return;
+    if (degree > 0)
+      strides[degree] = strides[degree - 1] * dimensions[degree - 1];
+  }
+
+  // iterate over the non-zero entries in the order of the old state, with
+  // degree 0 changing fastest
+  std::vector<std::size_t> positions(nr_degrees, 0);
+  while (true) {
+    std::size_t old_state_idx = 0, new_state_idx = 0;
+    double entry = 1.;
+    for (std::size_t degree = 0; degree < nr_degrees; ++degree) {
+      const auto &mapped = level_maps[degree][positions[degree]];
+      old_state_idx += mapped.old_level * strides[degree];
+      new_state_idx += mapped.new_level * strides[degree];
+      entry *= mapped.value;
     }
+    process_element(new_state_idx, old_state_idx, entry);
 
-    if (entry != 0.) {
-      auto new_state_idx = 0;
-      for (std::size_t idx = 0; idx < new_state.size(); ++idx) {
-        auto offset = 1;
-        for (std::size_t d = 0; d < idx; ++d)
-          offset *= dimensions[d];
-        new_state_idx += new_state[idx] * offset;
-      }
-      process_element(new_state_idx, old_state_idx, entry);
+    std::size_t degree = 0;
+    for (; degree < nr_degrees; ++degree) {
+      if (++positions[degree] < level_maps[degree].size())
+        break;
+      positions[degree] = 0;
     }
-    old_state_idx += 1;
+    if (degree == nr_degrees)
+      break;
   }
 }
 
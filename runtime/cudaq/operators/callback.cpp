@@ -8,16 +8,173 @@
 
 #include "callback.h"
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <cstring>
 #include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace cudaq {
 
+// time_function
+
+static void
+check_interpolation_points(const std::vector<double> &knots,
+                           const std::vector<std::complex<double>> &values) {
+  if (knots.empty())
+    throw std::invalid_argument(
+        "interpolation requires at least one interpolation point");
+  if (knots.size() != values.size())
+    throw std::invalid_argument(
+        "the number of values must match the number of interpolation points");
+  for (std::size_t i = 1; i < knots.size(); ++i)
+    if (!(knots[i] > knots[i - 1]))
+      throw std::invalid_argument(
+          "interpolation points must be strictly increasing");
+}
+
+time_function
+time_function::piecewise_linear(const std::vector<double> &knots,
+                                const std::vector<std::complex<double>> &values,
+                                const std::string &parameter) {
+  check_interpolation_points(knots, values);
+  time_function function;
+  function.kind = form::piecewise_linear;
+  function.parameter = parameter;
+  function.knots = knots;
+  function.values = values;
+  return function;
+}
+
+time_function
+time_function::cubic_spline(const std::vector<double> &knots,
+                            const std::vector<std::complex<double>> &values,
+                            const std::string &parameter) {
+  check_interpolation_points(knots, values);
+  time_function function;
+  function.kind = form::cubic_spline;
+  function.parameter = parameter;
+  function.knots = knots;
+  function.values = values;
+  // Solve the tridiagonal system of the second derivatives of the natural
+  // spline, which vanish at both ends.
+  const std::size_t n = knots.size();
+  function.second_derivatives.assign(n, 0.0);
+  if (n < 3)
+    return function;
+  std::vector<double> diag(n, 1.0), upper(n, 0.0);
+  std::vector<std::complex<double>> rhs(n, 0.0);
+  for (std::size_t i = 1; i + 1 < n; ++i) {
+    const double hPrev = knots[i] - knots[i - 1];
+    const double hNext = knots[i + 1] - knots[i];
+    diag[i] = 2.0 * (hPrev + hNext);
+    upper[i] = hNext;
+    rhs[i] = 6.0 * ((values[i + 1] - values[i]) / hNext -
+                    (values[i] - values[i - 1]) / hPrev);
+    // Forward elimination of the lower diagonal, `hPrev`.
+    const double factor = hPrev / diag[i - 1];
+    diag[i] -= factor * upper[i - 1];
+    rhs[i] -= factor * rhs[i - 1];
+  }
+  for (std::size_t i = n - 2; i > 0; --i)
+    function.second_derivatives[i] =
+        (rhs[i] - upper[i] * function.second_derivatives[i + 1]) / diag[i];
+  return function;
+}
+
+time_function time_function::sinusoid(std::complex<double> amplitude,
+                                      double frequency, double phase,
+                                      const std::string &parameter) {
+  time_function function;
+  function.kind = form::sinusoid;
+  function.parameter = parameter;
+  function.frequency = frequency;
+  function.phase = phase;
+  function.scale = amplitude;
+  return function;
+}
+
+std::complex<double> time_function::operator()(double x) const {
+  std::complex<double> value;
+  if (kind == form::sinusoid) {
+    value = std::sin(frequency * x + phase);
+  } else if (x <= knots.front()) {
+    value = values.front();
+  } else if (x >= knots.back()) {
+    value = values.back();
+  } else {
+    const std::size_t i =
+        std::upper_bound(knots.begin(), knots.end(), x) - knots.begin() - 1;
+    const double h = knots[i + 1] - knots[i];
+    const double a = (knots[i + 1] - x) / h;
+    const double b = (x - knots[i]) / h;
+    value = a * values[i] + b * values[i + 1];
+    if (kind == form::cubic_spline)
+      value += ((a * a * a - a) * second_derivatives[i] +
+                (b * b * b - b) * second_derivatives[i + 1]) *
+               (h * h / 6.0);
+  }
+  return scale * value + offset;
+}
+
+time_function time_function::conj() const {
+  time_function function = *this;
+  for (auto &value : function.values)
+    value = std::conj(value);
+  for (auto &value : function.second_derivatives)
+    value = std::conj(value);
+  function.scale = std::conj(scale);
+  function.offset = std::conj(offset);
+  return function;
+}
+
+time_function time_function::operator*(std::complex<double> other) const {
+  time_function function = *this;
+  function.scale *= other;
+  function.offset *= other;
+  return function;
+}
+
+time_function time_function::operator/(std::complex<double> other) const {
+  time_function function = *this;
+  function.scale /= other;
+  function.offset /= other;
+  return function;
+}
+
+time_function time_function::operator+(std::complex<double> other) const {
+  time_function function = *this;
+  function.offset += other;
+  return function;
+}
+
+time_function time_function::operator-(std::complex<double> other) const {
+  time_function function = *this;
+  function.offset -= other;
+  return function;
+}
+
 // scalar_callback
 
+scalar_callback::scalar_callback(const time_function &func)
+    : callback_func(
+          [func](const std::unordered_map<std::string, std::complex<double>>
+                     &parameters) {
+            auto it = parameters.find(func.parameter);
+            if (it == parameters.end())
+              throw std::runtime_error("missing value for parameter " +
+                                       func.parameter);
+            return func(it->second.real());
+          }),
+      function(func) {}
+
 std::complex<double> scalar_callback::operator()(
     const std::unordered_map<std::string, std::complex<double>> &parameters)
     const {
@@ -44,6 +201,91 @@ mdiag_sparse_matrix diag_matrix_callback::operator()(
 
 // Definition
 
+// Bounds the memory held on to by the matrix cache of a single definition;
+// larger matrices are not cached, and the least recently used matrix is evicted
+// once the cache holds the maximal number of entries.
+static constexpr std::size_t max_cached_matrices = 64;
+static constexpr std::size_t max_cached_matrix_size = 1 << 16;
+
+struct Definition::matrix_cache {
+  std::mutex mutex;
+  // Keys from the most to the least recently used.
+  std::list<std::string> recent;
+  using cached_matrix =
+      std::pair<complex_matrix, std::list<std::string>::iterator>;
+  std::unordered_map<std::string, cached_matrix> matrices;
+
+  std::optional<complex_matrix> find(const std::string &key) {
+    auto it = matrices.find(key);
+    if (it == matrices.end())
+      return std::nullopt;
+    recent.splice(recent.begin(), recent, it->second.second);
+    return it->second.first;
+  }
+
+  void insert(std::string key, const complex_matrix &matrix) {
+    if (matrices.count(key))
+      return;
+    if (matrices.size() >= max_cached_matrices) {
+      matrices.erase(recent.back());
+      recent.pop_back();
+    }
+    recent.push_front(key);
+    matrices.emplace(std::move(key), std::make_pair(matrix, recent.begin()));
+  }
+
+  void clear() {
+    recent.clear();
+    matrices.clear();
+  }
+
+  // The key includes the values of the parameters the generator declares. A
+  // generator that declares none may use any of them, so the key includes the
+  // values of all of them in that case. Parameters are sorted by name such that
+  // the key does not depend on the iteration order of the maps.
+  static std::string
+  make_key(const std::vector<std::int64_t> &relevant_dimensions,
+           const std::unordered_map<std::string, std::complex<double>>
+               &parameters,
+           const std::unordered_map<std::string, std::string>
+               &parameter_descriptions) {
+    std::vector<const std::pair<const std::string, std::complex<double>> *>
+        sorted_params;
+    if (parameter_descriptions.empty()) {
+      sorted_params.reserve(parameters.size());
+      for (const auto &entry : parameters)
+        sorted_params.push_back(&entry);
+    } else {
+      sorted_params.reserve(parameter_descriptions.size());
+      for (const auto &[name, description] : parameter_descriptions) {
+        auto it = parameters.find(name);
+        if (it != parameters.end())
+          sorted_params.push_back(&*it);
+      }
+    }
+    std::sort(sorted_params.begin(), sorted_params.end(),
+              [](auto *lhs, auto *rhs) { return lhs->first < rhs->first; });
+
+    auto append_bytes = [](std::string &key, const auto &value) {
+      char bytes[sizeof(value)];
+      std::memcpy(bytes, &value, sizeof(value));
+      key.append(bytes, sizeof(value));
+    };
+    std::string key;
+    append_bytes(key, relevant_dimensions.size());
+    for (auto dim : relevant_dimensions)
+      append_bytes(key, dim);
+    append_bytes(key, sorted_params.size());
+    for (const auto *entry : sorted_params) {
+      append_bytes(key, entry->first.size());
+      key += entry->first;
+      append_bytes(key, entry->second.real());
+      append_bytes(key, entry->second.imag());
+    }
+    return key;
+  }
+};
+
 Definition::Definition(
     std::string operator_id,
     const std::vector<std::int64_t> &expected_dimensions,
@@ -51,13 +293,15 @@ Definition::Definition(
     std::unordered_map<std::string, std::string> &&parameter_descriptions)
     : id(operator_id), generator(std::move(create)),
       parameter_descriptions(std::move(parameter_descriptions)),
-      required_dimensions(expected_dimensions) {}
+      required_dimensions(expected_dimensions),
+      cache(std::make_unique<matrix_cache>()) {}
 
 Definition::Definition(Definition &&def)
     : id(def.id), generator(std::move(def.generator)),
       diag_generator(std::move(def.diag_generator)),
       parameter_descriptions(std::move(def.parameter_descriptions)),
-      required_dimensions(std::move(def.expected_dimensions)) {}
+      required_dimensions(std::move(def.expected_dimensions)),
+      time_dependent(def.time_dependent), cache(std::move(def.cache)) {}
 
 Definition::Definition(
     std::string operator_id, const std::vector<int64_t> &expected_dimensions,
@@ -66,13 +310,38 @@ Definition::Definition(
     : id(operator_id), generator(std::move(create)),
       diag_generator(std::move(diag_create)),
       parameter_descriptions(std::move(parameter_descriptions)),
-      required_dimensions(std::move(expected_dimensions)) {}
+      required_dimensions(std::move(expected_dimensions)),
+      cache(std::make_unique<matrix_cache>()) {}
+
+void Definition::set_time_dependent(bool is_time_dependent) {
+  std::lock_guard<std::mutex> lock(this->cache->mutex);
+  this->time_dependent = is_time_dependent;
+  this->cache->clear();
+}
 
 complex_matrix Definition::generate_matrix(
     const std::vector<std::int64_t> &relevant_dimensions,
     const std::unordered_map<std::string, std::complex<double>> &parameters)
     const {
-  return generator(relevant_dimensions, parameters);
+  if (this->time_dependent)
+    return generator(relevant_dimensions, parameters);
+
+  auto key = matrix_cache::make_key(relevant_dimensions, parameters,
+                                    this->parameter_descriptions);
+  {
+    std::lock_guard<std::mutex> lock(this->cache->mutex);
+    if (auto matrix = this->cache->find(key))
+      return std::move(*matrix);
+  }
+
+  // The lock is not held while invoking the generator, since the generator may
+  // itself evaluate other matrix operators (or call into Python).
+  auto matrix = generator(relevant_dimensions, parameters);
+  if (matrix.rows() * matrix.cols() <= max_cached_matrix_size) {
+    std::lock_guard<std::mutex> lock(this->cache->mutex);
+    this->cache->insert(std::move(key), matrix);
+  }
+  return matrix;
 }
 
 mdiag_sparse_matrix Definition::generate_dia_matrix(
@@ -13,12 +13,69 @@
 
 #include <complex>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace cudaq {
 
+/// @brief A function of a single real parameter, typically the time of a
+/// schedule, given in a closed form rather than as user code.
+// The function evaluates to `scale * f(x) + offset`, where `x` is the real part
+// of the value of `parameter` and `f` is
+// - the piecewise-linear interpolation of `values` at the `knots`, or
+// - the natural cubic spline interpolation of `values` at the `knots`,
+//   both being constant beyond the first and last knots, or
+// - the sinusoid `sin(frequency * x + phase)`.
+// Since evaluating it does not call back into the host code, the dynamics
+// backend evaluates such coefficients on the device.
+struct time_function {
+  enum class form { piecewise_linear, cubic_spline, sinusoid };
+
+  form kind = form::piecewise_linear;
+  std::string parameter = "t";
+  // The strictly increasing interpolation points, and the values at them.
+  std::vector<double> knots;
+  std::vector<std::complex<double>> values;
+  // The second derivatives of the cubic spline at the knots.
+  std::vector<std::complex<double>> second_derivatives;
+  double frequency = 0.0;
+  double phase = 0.0;
+  std::complex<double> scale = 1.0;
+  std::complex<double> offset = 0.0;
+
+  /// @brief Linear interpolation of `values` at the `knots`.
+  static time_function
+  piecewise_linear(const std::vector<double> &knots,
+                   const std::vector<std::complex<double>> &values,
+                   const std::string &parameter = "t");
+
+  /// @brief Natural cubic spline interpolation of `values` at the `knots`.
+  static time_function
+  cubic_spline(const std::vector<double> &knots,
+               const std::vector<std::complex<double>> &values,
+               const std::string &parameter = "t");
+
+  /// @brief `amplitude * sin(frequency * x + phase)`.
+  static time_function sinusoid(std::complex<double> amplitude,
+                                double frequency, double phase = 0.0,
+                                const std::string &parameter = "t");
+
+  /// @brief Evaluates the function at `x`.
+  std::complex<double> operator()(double x) const;
+
+  /// @brief The complex conjugate of the function.
+  time_function conj() const;
+
+  // Affine maps of the function by a constant.
+  time_function operator*(std::complex<double> other) const;
+  time_function operator/(std::complex<double> other) const;
+  time_function operator+(std::complex<double> other) const;
+  time_function operator-(std::complex<double> other) const;
+};
+
 /// @brief A callback wrapper that encapsulates a user-provided function taking
 /// a set of complex parameters and returning a complex result.
 class scalar_callback {
@@ -28,6 +85,8 @@ private:
   std::function<std::complex<double>(
       const std::unordered_map<std::string, std::complex<double>> &)>
       callback_func;
+  // The closed form of the callback, if it was created from one.
+  std::optional<time_function> function;
 
 public:
   /// @brief Constructs a scalar callback from a callable object.
@@ -46,6 +105,10 @@ public:
     callback_func = std::forward<Callable>(callable);
   }
 
+  /// @brief Constructs a scalar callback evaluating a function of one of the
+  /// parameters.
+  scalar_callback(const time_function &function);
+
   /// @brief Default copy constructor for scalar_callback.
   /// Creates a new scalar_callback instance as a copy of an existing instance.
   scalar_callback(const scalar_callback &other) = default;
@@ -65,6 +128,12 @@ public:
   std::complex<double> operator()(
       const std::unordered_map<std::string, std::complex<double>> &parameters)
       const;
+
+  /// @brief The closed form of the callback, or nullptr if it was created
+  /// from a callable object.
+  const time_function *get_time_function() const {
+    return function ? &*function : nullptr;
+  }
 };
 
 class matrix_callback {
@@ -145,6 +214,13 @@ private:
   matrix_callback generator;
   std::optional<diag_matrix_callback> diag_generator;
   std::vector<std::int64_t> required_dimensions;
+  bool time_dependent = false;
+
+  // Matrices previously returned by the generator, keyed on the relevant
+  // dimensions and the values of the declared parameters they were generated
+  // for (of all parameters if none are declared).
+  struct matrix_cache;
+  std::unique_ptr<matrix_cache> cache;
 
 public:
   const std::vector<std::int64_t> &expected_dimensions =
@@ -162,6 +238,13 @@ public:
   Definition(Definition &&def);
   ~Definition();
 
+  /// @brief Marks the generator as depending on state other than the
+  /// dimensions and parameters passed to it (e.g. the current time). Matrices
+  /// for time-dependent definitions are regenerated on every evaluation;
+  /// otherwise they are memoized per dimensions and parameter values.
+  void set_time_dependent(bool is_time_dependent);
+  bool is_time_dependent() const { return time_dependent; }
+
   // To call the generator function
   complex_matrix
   generate_matrix(const std::vector<std::int64_t> &relevant_dimensions,
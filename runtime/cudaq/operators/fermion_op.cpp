@@ -187,17 +187,20 @@ void fermion_handler::create_matrix(
   auto dim = 1 << fermi_word.size();
   auto nr_deg = fermi_word.size();
 
+  // each state is mapped to at most one state; only the non-zero entries are
+  // processed, such that sparse matrices do not store explicit zeros
   for (std::size_t old_state = 0; old_state < dim; ++old_state) {
     std::size_t new_state = 0;
     std::complex<double> entry = 1.;
-    for (std::size_t degree = 0; degree < nr_deg; ++degree) {
+    for (std::size_t degree = 0; degree < nr_deg && entry != 0.; ++degree) {
       auto state = (old_state & (1 << degree)) >> degree;
       auto op = fermi_word[invert_order ? nr_deg - 1 - degree : degree];
       auto mapped = map_state(op, state);
       entry *= mapped.first;
       new_state |= (mapped.second << degree);
     }
-    process_element(new_state, old_state, entry);
+    if (entry != 0.)
+      process_element(new_state, old_state, entry);
   }
 }
 
@@ -206,14 +206,14 @@ EigenSparseMatrix create_sparse_matrix(
   return matrix;
 }
 
-cudaq::csr_spmatrix to_csr_spmatrix(const EigenSparseMatrix &matrix,
-                                    std::size_t estimated_num_entries) {
+cudaq::csr_spmatrix to_csr_spmatrix(const EigenSparseMatrix &matrix) {
   std::vector<std::complex<double>> values;
   std::vector<std::size_t> rows, cols;
-  values.reserve(estimated_num_entries);
-  rows.reserve(estimated_num_entries);
-  cols.reserve(estimated_num_entries);
-  for (std::size_t k = 0; k < matrix.outerSize(); ++k)
+  const std::size_t num_entries = matrix.nonZeros();
+  values.reserve(num_entries);
+  rows.reserve(num_entries);
+  cols.reserve(num_entries);
+  for (Eigen::Index k = 0; k < matrix.outerSize(); ++k)
     for (EigenSparseMatrix::InnerIterator it(matrix, k); it; ++it) {
       values.emplace_back(it.value());
       rows.emplace_back(it.row());
@@ -256,6 +256,20 @@ mdiag_sparse_matrix create_mdiag_sparse_matrix(
   return std::make_pair(std::move(diaData), std::move(offset));
 }
 
+void combine_entries(sparse_row &row) {
+  std::sort(row.begin(), row.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+  std::size_t size = 0;
+  for (std::size_t k = 0; k < row.size(); ++k) {
+    if (size > 0 && row[size - 1].first == row[k].first)
+      row[size - 1].second += row[k].second;
+    else
+      row[size++] = row[k];
+  }
+  row.resize(size);
+}
+
 void inplace_accumulate(mdiag_sparse_matrix &accumulated,
                         const mdiag_sparse_matrix &matrix) {
   auto &[acc_buffer, acc_offsets] = accumulated;
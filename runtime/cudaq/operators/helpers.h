@@ -103,8 +103,7 @@ EigenSparseMatrix create_sparse_matrix(
 
 /// Converts and Eigen sparse matrix to the `csr_spmatrix` format used in
 /// CUDA-Q.
-csr_spmatrix to_csr_spmatrix(const EigenSparseMatrix &matrix,
-                             std::size_t estimated_num_entries);
+csr_spmatrix to_csr_spmatrix(const EigenSparseMatrix &matrix);
 
 /// Helper function for multi-diagonal matrix creation.
 /// The matrix creation function should call its function argument for
@@ -115,6 +114,12 @@ mdiag_sparse_matrix create_mdiag_sparse_matrix(
                                                       std::complex<double>)> &)>
         &create);
 
+/// The non-zero entries of a row of a sparse matrix, as column and value.
+using sparse_row = std::vector<std::pair<std::size_t, std::complex<double>>>;
+
+/// Sorts the entries of a row by column and combines duplicate entries.
+void combine_entries(sparse_row &row);
+
 /// Add (in-place) a multi-diagonal matrix to another one
 void inplace_accumulate(mdiag_sparse_matrix &accumulated,
                         const mdiag_sparse_matrix &matrix);
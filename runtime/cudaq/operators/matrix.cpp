@@ -7,7 +7,9 @@
  ******************************************************************************/
 
 #include "cudaq/operators/matrix.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
 
@@ -15,44 +17,133 @@
 
 // tools for caching eigensolvers
 
-/// @brief Hash function for an cudaq::complex_matrix::EigenMatrix
+/// @brief Structural hash function for an cudaq::complex_matrix::EigenMatrix.
+/// Only the dimensions and a fixed number of evenly spaced elements are hashed,
+/// so that the cost of a lookup does not grow with the size of the matrix.
+/// Matrices with equal hashes are told apart by `complex_matrix_equal`.
 struct complex_matrix_hash {
+  static constexpr Eigen::Index sampled_elements = 64;
+
   std::size_t
   operator()(const cudaq::complex_matrix::EigenMatrix &matrix) const {
-    size_t seed = 0;
-    for (Eigen::Index i = 0; i < matrix.size(); ++i) {
+    auto combine = [](std::size_t seed, std::size_t value) {
+      return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    };
+    std::size_t seed = combine(std::hash<Eigen::Index>()(matrix.rows()),
+                               std::hash<Eigen::Index>()(matrix.cols()));
+    const Eigen::Index size = matrix.size();
+    const Eigen::Index step =
+        std::max<Eigen::Index>(1, size / sampled_elements);
+    for (Eigen::Index i = 0; i < size; i += step) {
       auto elem = *(matrix.data() + i);
-      seed ^= std::hash<double>()(elem.real()) +
-              std::hash<double>()(elem.imag()) + 0x9e3779b9 + (seed << 6) +
-              (seed >> 2);
+      seed = combine(seed, std::hash<double>()(elem.real()));
+      seed = combine(seed, std::hash<double>()(elem.imag()));
     }
     return seed;
   }
 };
 
-std::unordered_map<
-    cudaq::complex_matrix::EigenMatrix,
-    Eigen::SelfAdjointEigenSolver<cudaq::complex_matrix::EigenMatrix>,
-    complex_matrix_hash>
+/// @brief Equality of two cudaq::complex_matrix::EigenMatrix, which may have
+/// different dimensions.
+struct complex_matrix_equal {
+  bool operator()(const cudaq::complex_matrix::EigenMatrix &lhs,
+                  const cudaq::complex_matrix::EigenMatrix &rhs) const {
+    return lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols() && lhs == rhs;
+  }
+};
+
+using SelfAdjointEigenSolver =
+    Eigen::SelfAdjointEigenSolver<cudaq::complex_matrix::EigenMatrix>;
+using ComplexEigenSolver =
+    Eigen::ComplexEigenSolver<cudaq::complex_matrix::EigenMatrix>;
+
+std::unordered_map<cudaq::complex_matrix::EigenMatrix, SelfAdjointEigenSolver,
+                   complex_matrix_hash, complex_matrix_equal>
     selfAdjointEigenSolvers;
 
-std::unordered_map<
-    cudaq::complex_matrix::EigenMatrix,
-    Eigen::ComplexEigenSolver<cudaq::complex_matrix::EigenMatrix>,
-    complex_matrix_hash>
+std::unordered_map<cudaq::complex_matrix::EigenMatrix, ComplexEigenSolver,
+                   complex_matrix_hash, complex_matrix_equal>
     generalEigenSolvers;
 
 // matrix implementation
 
-inline cudaq::complex_matrix::value_type &
-access(cudaq::complex_matrix::value_type *p,
-       cudaq::complex_matrix::Dimensions sizes, std::size_t row,
-       std::size_t col, cudaq::complex_matrix::order internal_order) {
+template <typename T>
+inline T &access(T *p, cudaq::complex_matrix::Dimensions sizes, std::size_t row,
+                 std::size_t col, cudaq::complex_matrix::order internal_order) {
   return internal_order == cudaq::complex_matrix::order::row_major
              ? p[row * sizes.second + col]
              : p[col * sizes.first + row];
 }
 
+/// Computes `result = left * right` with Eigen's blocked matrix product. The
+/// data of a row major matrix is the data of its transpose in column major
+/// order, hence all operands can be mapped as column major matrices.
+static void gemm(const cudaq::complex_matrix::value_type *left,
+                 cudaq::complex_matrix::Dimensions left_sizes,
+                 cudaq::complex_matrix::order left_order,
+                 const cudaq::complex_matrix::value_type *right,
+                 cudaq::complex_matrix::Dimensions right_sizes,
+                 cudaq::complex_matrix::order right_order,
+                 cudaq::complex_matrix::value_type *result,
+                 cudaq::complex_matrix::order result_order) {
+  using ConstMap = Eigen::Map<const Eigen::MatrixXcd>;
+  using Map = Eigen::Map<Eigen::MatrixXcd>;
+  const auto m = left_sizes.first, k = left_sizes.second,
+             n = right_sizes.second;
+  const bool left_row = left_order == cudaq::complex_matrix::order::row_major;
+  const bool right_row =
+      right_order == cudaq::complex_matrix::order::row_major;
+  // `a` is either left or its transpose, and `b` is either right or its
+  // transpose.
+  ConstMap a(left, left_row ? k : m, left_row ? m : k);
+  ConstMap b(right, right_row ? n : k, right_row ? k : n);
+  if (result_order == cudaq::complex_matrix::order::column_major) {
+    Map c(result, m, n);
+    if (left_row && right_row)
+      c.noalias() = a.transpose() * b.transpose();
+    else if (left_row)
+      c.noalias() = a.transpose() * b;
+    else if (right_row)
+      c.noalias() = a * b.transpose();
+    else
+      c.noalias() = a * b;
+  } else {
+    // Compute the transpose of the result, `right^T * left^T`.
+    Map c(result, n, m);
+    if (left_row && right_row)
+      c.noalias() = b * a;
+    else if (left_row)
+      c.noalias() = b.transpose() * a;
+    else if (right_row)
+      c.noalias() = b * a.transpose();
+    else
+      c.noalias() = b.transpose() * a.transpose();
+  }
+}
+
+/// Computes the Kronecker product of `left` and `right` into `result`.
+static void kron(const cudaq::complex_matrix::value_type *left,
+                 cudaq::complex_matrix::Dimensions left_sizes,
+                 cudaq::complex_matrix::order left_order,
+                 const cudaq::complex_matrix::value_type *right,
+                 cudaq::complex_matrix::Dimensions right_sizes,
+                 cudaq::complex_matrix::order right_order,
+                 cudaq::complex_matrix::value_type *result,
+                 cudaq::complex_matrix::order result_order) {
+  cudaq::complex_matrix::Dimensions result_sizes{
+      left_sizes.first * right_sizes.first,
+      left_sizes.second * right_sizes.second};
+  for (std::size_t i = 0; i < left_sizes.first; i++)
+    for (std::size_t j = 0; j < left_sizes.second; j++) {
+      const auto factor = access(left, left_sizes, i, j, left_order);
+      for (std::size_t k = 0; k < right_sizes.first; k++)
+        for (std::size_t m = 0; m < right_sizes.second; m++)
+          access(result, result_sizes, right_sizes.first * i + k,
+                 right_sizes.second * j + m, result_order) =
+              factor * access(right, right_sizes, k, m, right_order);
+    }
+}
+
 cudaq::complex_matrix::complex_matrix(const cudaq::complex_matrix &other,
                                       order order)
     : dimensions{other.dimensions},
@@ -107,12 +198,11 @@ cudaq::complex_matrix::eigenvalues() const {
   if (map.isApprox(map.adjoint())) {
     auto iter = selfAdjointEigenSolvers.find(map);
     if (iter == selfAdjointEigenSolvers.end())
-      selfAdjointEigenSolvers.emplace(
-          map,
-          Eigen::SelfAdjointEigenSolver<cudaq::complex_matrix::EigenMatrix>(
-              map));
+      iter =
+          selfAdjointEigenSolvers.emplace(map, SelfAdjointEigenSolver(map))
+              .first;
 
-    auto eigs = selfAdjointEigenSolvers[map].eigenvalues();
+    auto eigs = iter->second.eigenvalues();
     std::vector<cudaq::complex_matrix::value_type> ret(eigs.size());
     Eigen::VectorXcd::Map(&ret[0], eigs.size()) = eigs;
     return ret;
@@ -121,11 +211,9 @@ cudaq::complex_matrix::eigenvalues() const {
   // This matrix is not self adjoint, use the ComplexEigenSolver
   auto iter = generalEigenSolvers.find(map);
   if (iter == generalEigenSolvers.end())
-    generalEigenSolvers.emplace(
-        map,
-        Eigen::ComplexEigenSolver<cudaq::complex_matrix::EigenMatrix>(map));
+    iter = generalEigenSolvers.emplace(map, ComplexEigenSolver(map)).first;
 
-  auto eigs = generalEigenSolvers[map].eigenvalues();
+  auto eigs = iter->second.eigenvalues();
   std::vector<cudaq::complex_matrix::value_type> ret(eigs.size());
   Eigen::VectorXcd::Map(&ret[0], eigs.size()) = eigs;
   return ret;
@@ -137,12 +225,11 @@ cudaq::complex_matrix cudaq::complex_matrix::eigenvectors() const {
   if (map.isApprox(map.adjoint())) {
     auto iter = selfAdjointEigenSolvers.find(map);
     if (iter == selfAdjointEigenSolvers.end())
-      selfAdjointEigenSolvers.emplace(
-          map,
-          Eigen::SelfAdjointEigenSolver<cudaq::complex_matrix::EigenMatrix>(
-              map));
+      iter =
+          selfAdjointEigenSolvers.emplace(map, SelfAdjointEigenSolver(map))
+              .first;
 
-    auto eigv = selfAdjointEigenSolvers[map].eigenvectors();
+    auto eigv = iter->second.eigenvectors();
     cudaq::complex_matrix copy(eigv.rows(), eigv.cols(), false);
     std::memcpy(copy.data, eigv.data(),
                 sizeof(cudaq::complex_matrix::value_type) * eigv.size());
@@ -152,11 +239,9 @@ cudaq::complex_matrix cudaq::complex_matrix::eigenvectors() const {
   // This matrix is not self adjoint, use the ComplexEigenSolver
   auto iter = generalEigenSolvers.find(map);
   if (iter == generalEigenSolvers.end())
-    generalEigenSolvers.emplace(
-        map,
-        Eigen::ComplexEigenSolver<cudaq::complex_matrix::EigenMatrix>(map));
+    iter = generalEigenSolvers.emplace(map, ComplexEigenSolver(map)).first;
 
-  auto eigv = generalEigenSolvers[map].eigenvectors();
+  auto eigv = iter->second.eigenvectors();
   cudaq::complex_matrix copy(eigv.rows(), eigv.cols(), false);
   std::memcpy(copy.data, eigv.data(),
               sizeof(cudaq::complex_matrix::value_type) * eigv.size());
@@ -170,17 +255,51 @@ cudaq::complex_matrix::operator*=(const cudaq::complex_matrix &right) {
 
   auto new_data = new cudaq::complex_matrix::value_type[rows() * right.cols()];
   cudaq::complex_matrix::Dimensions new_dims = {rows(), right.cols()};
-  for (std::size_t i = 0; i < rows(); i++)
-    for (std::size_t j = 0; j < right.cols(); j++)
-      for (std::size_t k = 0; k < cols(); k++)
-        access(new_data, new_dims, i, j, this->internal_order) +=
-            access(data, dimensions, i, k, this->internal_order) *
-            access(right.data, right.dimensions, k, j, right.internal_order);
+  gemm(data, dimensions, this->internal_order, right.data, right.dimensions,
+       right.internal_order, new_data, this->internal_order);
   swap(new_data);
   dimensions = new_dims;
   return *this;
 }
 
+void cudaq::multiply(const cudaq::complex_matrix &left,
+                     const cudaq::complex_matrix &right,
+                     cudaq::complex_matrix &result) {
+  if (left.cols() != right.rows())
+    throw std::runtime_error("matrix dimensions mismatch in multiply");
+  assert(&result != &left && &result != &right);
+
+  cudaq::complex_matrix::Dimensions new_dims = {left.rows(), right.cols()};
+  result.reserve(new_dims);
+  result.dimensions = new_dims;
+  gemm(left.data, left.dimensions, left.internal_order, right.data,
+       right.dimensions, right.internal_order, result.data,
+       result.internal_order);
+}
+
+std::vector<cudaq::complex_matrix>
+cudaq::batched_multiply(const std::vector<cudaq::complex_matrix> &lefts,
+                        const std::vector<cudaq::complex_matrix> &rights) {
+  if (lefts.size() != rights.size())
+    throw std::runtime_error("batch size mismatch in batched_multiply");
+  for (std::size_t i = 0; i < lefts.size(); ++i)
+    if (lefts[i].cols() != rights[i].rows())
+      throw std::runtime_error(
+          "matrix dimensions mismatch in batched_multiply at index " +
+          std::to_string(i));
+
+  std::vector<cudaq::complex_matrix> results(lefts.size());
+  const auto count = static_cast<std::int64_t>(lefts.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if (count > 1)
+#endif
+  for (std::int64_t i = 0; i < count; ++i) {
+    results[i].internal_order = lefts[i].internal_order;
+    multiply(lefts[i], rights[i], results[i]);
+  }
+  return results;
+}
+
 std::vector<cudaq::complex_matrix::value_type>
 cudaq::operator*(const cudaq::complex_matrix &matrix,
                  const std::vector<cudaq::complex_matrix::value_type> &vect) {
@@ -250,19 +369,44 @@ cudaq::complex_matrix::kronecker_inplace(const cudaq::complex_matrix &right) {
   Dimensions new_dim{rows() * right.rows(), cols() * right.cols()};
   auto new_data = new cudaq::complex_matrix::value_type[rows() * right.rows() *
                                                         cols() * right.cols()];
-  for (std::size_t i = 0; i < rows(); i++)
-    for (std::size_t k = 0; k < right.rows(); k++)
-      for (std::size_t j = 0; j < cols(); j++)
-        for (std::size_t m = 0; m < right.cols(); m++)
-          access(new_data, new_dim, right.rows() * i + k, right.cols() * j + m,
-                 this->internal_order) =
-              access(data, dimensions, i, j, this->internal_order) *
-              access(right.data, right.dimensions, k, m, right.internal_order);
+  kron(data, dimensions, this->internal_order, right.data, right.dimensions,
+       right.internal_order, new_data, this->internal_order);
   swap(new_data);
   dimensions = new_dim;
   return *this;
 }
 
+void cudaq::kronecker(const cudaq::complex_matrix &left,
+                      const cudaq::complex_matrix &right,
+                      cudaq::complex_matrix &result) {
+  assert(&result != &left && &result != &right);
+  cudaq::complex_matrix::Dimensions new_dim{left.rows() * right.rows(),
+                                            left.cols() * right.cols()};
+  result.reserve(new_dim);
+  result.dimensions = new_dim;
+  kron(left.data, left.dimensions, left.internal_order, right.data,
+       right.dimensions, right.internal_order, result.data,
+       result.internal_order);
+}
+
+std::vector<cudaq::complex_matrix>
+cudaq::batched_kronecker(const std::vector<cudaq::complex_matrix> &lefts,
+                         const std::vector<cudaq::complex_matrix> &rights) {
+  if (lefts.size() != rights.size())
+    throw std::runtime_error("batch size mismatch in batched_kronecker");
+
+  std::vector<cudaq::complex_matrix> results(lefts.size());
+  const auto count = static_cast<std::int64_t>(lefts.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if (count > 1)
+#endif
+  for (std::int64_t i = 0; i < count; ++i) {
+    results[i].internal_order = lefts[i].internal_order;
+    kronecker(lefts[i], rights[i], results[i]);
+  }
+  return results;
+}
+
 void cudaq::complex_matrix::check_size(std::size_t size,
                                        const Dimensions &dim) {
   if (size != get_size(dim))
@@ -338,10 +482,13 @@ cudaq::complex_matrix cudaq::complex_matrix::power(int powers) {
   if (rows() != cols())
     throw std::runtime_error("Matrix power expects a square matrix.");
   auto result = cudaq::complex_matrix::identity(rows());
+  cudaq::complex_matrix scratch(rows(), cols(), false, result.internal_order);
 
-  // Calculate the matrix power iteratively.
-  for (std::size_t i = 0; i < (std::size_t)powers; i++)
-    result = result * *this;
+  // Calculate the matrix power iteratively, alternating between two buffers.
+  for (std::size_t i = 0; i < (std::size_t)powers; i++) {
+    multiply(result, *this, scratch);
+    std::swap(result.data, scratch.data);
+  }
   return result;
 }
 
@@ -365,10 +512,16 @@ cudaq::complex_matrix cudaq::complex_matrix::exponential() {
   if (rows != columns)
     throw std::runtime_error("Matrix exponential expects a square matrix.");
   auto result = cudaq::complex_matrix(rows, columns, false);
-  // Taylor Series Approximation, fixed at 20 steps.
+  // Taylor Series Approximation, fixed at 20 steps. The powers are computed
+  // incrementally, alternating between two buffers.
   std::size_t taylor_steps = 20;
+  auto term = cudaq::complex_matrix::identity(rows);
+  cudaq::complex_matrix scratch(rows, columns, false, term.internal_order);
   for (std::size_t step = 0; step < taylor_steps; step++) {
-    auto term = this->power(step);
+    if (step > 0) {
+      multiply(term, *this, scratch);
+      std::swap(term.data, scratch.data);
+    }
     for (std::size_t i = 0; i < rows; i++) {
       for (std::size_t j = 0; j < columns; j++) {
         result[{i, j}] += term[{i, j}] / factorial(step);
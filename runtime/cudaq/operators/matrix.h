@@ -35,6 +35,15 @@ complex_matrix operator+(const complex_matrix &, const complex_matrix &);
 complex_matrix operator-(const complex_matrix &, const complex_matrix &);
 bool operator==(const complex_matrix &, const complex_matrix &);
 complex_matrix kronecker(const complex_matrix &, const complex_matrix &);
+void multiply(const complex_matrix &, const complex_matrix &, complex_matrix &);
+void kronecker(const complex_matrix &, const complex_matrix &,
+               complex_matrix &);
+std::vector<complex_matrix>
+batched_multiply(const std::vector<complex_matrix> &,
+                 const std::vector<complex_matrix> &);
+std::vector<complex_matrix>
+batched_kronecker(const std::vector<complex_matrix> &,
+                  const std::vector<complex_matrix> &);
 template <typename Iterable,
           typename T = typename std::iterator_traits<Iterable>::value_type>
 complex_matrix kronecker(Iterable begin, Iterable end);
@@ -89,16 +98,21 @@ public:
   }
 
   complex_matrix &operator=(const complex_matrix &other) {
+    if (this == &other)
+      return *this;
+    // Reuse the current allocation when it has the right size.
+    reserve(other.dimensions);
     dimensions = other.dimensions;
-    data = new value_type[get_size(other.dimensions)];
     std::copy(other.data, other.data + get_size(dimensions), data);
     internal_order = other.internal_order;
     return *this;
   }
 
   complex_matrix &operator=(complex_matrix &&other) {
+    if (this == &other)
+      return *this;
     dimensions = other.dimensions;
-    data = other.data;
+    swap(other.data);
     other.data = nullptr;
     internal_order = other.internal_order;
     return *this;
@@ -153,6 +167,31 @@ public:
                                   const complex_matrix &);
   complex_matrix &kronecker_inplace(const complex_matrix &);
 
+  /// Computes the product `left * right` into `result`. The data of `result`
+  /// is reused if it has the size of the product, and its order is kept.
+  /// `result` must not be one of the operands.
+  friend void multiply(const complex_matrix &left, const complex_matrix &right,
+                       complex_matrix &result);
+
+  /// Computes the Kronecker product of `left` and `right` into `result`. The
+  /// data of `result` is reused if it has the size of the product, and its
+  /// order is kept. `result` must not be one of the operands.
+  friend void kronecker(const complex_matrix &left,
+                        const complex_matrix &right, complex_matrix &result);
+
+  /// Computes the products `lefts[i] * rights[i]` of two equally long lists
+  /// of matrices. The products are computed in parallel if OpenMP is enabled.
+  friend std::vector<complex_matrix>
+  batched_multiply(const std::vector<complex_matrix> &lefts,
+                   const std::vector<complex_matrix> &rights);
+
+  /// Computes the Kronecker products of `lefts[i]` and `rights[i]` of two
+  /// equally long lists of matrices. The products are computed in parallel if
+  /// OpenMP is enabled.
+  friend std::vector<complex_matrix>
+  batched_kronecker(const std::vector<complex_matrix> &lefts,
+                    const std::vector<complex_matrix> &rights);
+
   /// Resets the matrix to all zero entries.
   /// Not needed after construction since the matrix will be initialized to
   /// zero.
@@ -231,6 +270,13 @@ private:
     data = new_data;
   }
 
+  /// Makes sure the data can hold a matrix of the given dimensions, keeping the
+  /// current allocation if it has the right size. The entries are unspecified.
+  void reserve(const Dimensions &dim) {
+    if (!data || get_size(dim) != get_size(dimensions))
+      swap(new complex_matrix::value_type[get_size(dim)]);
+  }
+
   void clear() {
     if (data)
       delete[] data;
@@ -258,8 +304,9 @@ complex_matrix kronecker(Iterable begin, Iterable end) {
 
 inline complex_matrix operator*(const complex_matrix &left,
                                 const complex_matrix &right) {
-  complex_matrix result = left;
-  result *= right;
+  complex_matrix result;
+  result.internal_order = left.internal_order;
+  multiply(left, right, result);
   return result;
 }
 
@@ -279,8 +326,9 @@ inline complex_matrix operator-(const complex_matrix &left,
 
 inline complex_matrix kronecker(const complex_matrix &left,
                                 const complex_matrix &right) {
-  complex_matrix result = left;
-  result.kronecker_inplace(right);
+  complex_matrix result;
+  result.internal_order = left.internal_order;
+  kronecker(left, right, result);
   return result;
 }
 
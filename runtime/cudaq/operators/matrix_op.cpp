@@ -92,6 +92,15 @@ bool matrix_handler::remove_definition(const std::string &operator_id) {
   return matrix_handler::defined_ops.erase(operator_id);
 }
 
+void matrix_handler::set_time_dependent(const std::string &operator_id,
+                                        bool is_time_dependent) {
+  auto it = matrix_handler::defined_ops.find(operator_id);
+  if (it == matrix_handler::defined_ops.end())
+    throw std::range_error("not matrix operator with the name '" + operator_id +
+                           "' has been defined");
+  it->second.set_time_dependent(is_time_dependent);
+}
+
 product_op<matrix_handler>
 matrix_handler::instantiate(std::string operator_id,
                             const std::vector<std::size_t> &degrees,
@@ -139,6 +148,12 @@ const std::vector<int64_t> &matrix_handler::get_expected_dimensions() const {
   return it->second.expected_dimensions;
 }
 
+bool matrix_handler::is_time_dependent() const {
+  auto it = matrix_handler::defined_ops.find(this->op_code);
+  assert(it != matrix_handler::defined_ops.end());
+  return it->second.is_time_dependent();
+}
+
 // private helpers
 
 std::string matrix_handler::canonical_form(
@@ -36,6 +36,10 @@ public:
   /// @return True if the operator is constant, false otherwise.
   bool is_constant() const;
 
+  /// @brief The closed form of the operator, or nullptr if it is a constant
+  /// or a callback created from a callable object.
+  const time_function *get_time_function() const;
+
   /// @brief A map that contains the documentation the parameters of
   /// the operator, if available. The operator may use parameters that
   /// are not represented in this dictionary.
@@ -62,6 +66,10 @@ public:
                   std::unordered_map<std::string, std::string>
                       &&parameter_descriptions = {});
 
+  /// @brief Constructs a scalar operator from the closed form of a function of
+  /// one of the parameters.
+  scalar_operator(const time_function &function);
+
   /// @brief Copy constructor.
   scalar_operator(const scalar_operator &other) = default;
 
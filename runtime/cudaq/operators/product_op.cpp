@@ -7,7 +7,9 @@
  ******************************************************************************/
 
 #include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <set>
 #include <type_traits>
@@ -386,6 +388,21 @@ std::string product_op<HandlerTy>::get_term_id() const {
   return term_id;
 }
 
+template <>
+std::string product_op<spin_handler>::get_term_id() const {
+  // Same as concatenating the unique ids of all operators, but written into a
+  // single buffer; term ids are computed for every term added to a sum.
+  std::string term_id;
+  term_id.reserve(4 * this->operators.size());
+  char digits[std::numeric_limits<std::size_t>::digits10 + 1];
+  for (const auto &op : this->operators) {
+    term_id += "IZXY"[op.op_code];
+    auto end = std::to_chars(digits, digits + sizeof(digits), op.degree).ptr;
+    term_id.append(digits, end);
+  }
+  return term_id;
+}
+
 template <typename HandlerTy>
 scalar_operator product_op<HandlerTy>::get_coefficient() const {
   return this->coefficient;
@@ -1492,8 +1509,18 @@ csr_spmatrix product_op<HandlerTy>::to_sparse_matrix(
   auto matrix = HandlerTy::to_sparse_matrix(terms[0].encoding,
                                             terms[0].relevant_dimensions,
                                             terms[0].coefficient, invert_order);
-  return cudaq::detail::to_csr_spmatrix(
-      matrix, 1ul << terms[0].relevant_dimensions.size());
+  return cudaq::detail::to_csr_spmatrix(matrix);
+}
+
+template <typename HandlerTy>
+PROPERTY_AGNOSTIC_TEMPLATE_DEFINITION(HandlerTy,
+                                      product_op<T>::supports_inplace_mult)
+csr_spmatrix product_op<HandlerTy>::to_sparse_matrix(
+    std::unordered_map<std::size_t, std::int64_t> dimensions,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool invert_order) const {
+  return sum_op<HandlerTy>(*this).to_sparse_matrix(std::move(dimensions),
+                                                   parameters, invert_order);
 }
 
 template <typename HandlerTy>
@@ -1532,6 +1559,10 @@ template csr_spmatrix product_op<boson_handler>::to_sparse_matrix(
     std::unordered_map<std::size_t, int64_t> dimensions,
     const std::unordered_map<std::string, std::complex<double>> &parameters,
     bool invert_order) const;
+template csr_spmatrix product_op<matrix_handler>::to_sparse_matrix(
+    std::unordered_map<std::size_t, int64_t> dimensions,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool invert_order) const;
 template mdiag_sparse_matrix product_op<spin_handler>::to_diagonal_matrix(
     std::unordered_map<std::size_t, std::int64_t> dimensions,
     const std::unordered_map<std::string, std::complex<double>> &parameters,
@@ -9,6 +9,7 @@
 #include "cudaq/operators.h"
 
 #include <iostream>
+#include <optional>
 #include <set>
 
 namespace cudaq {
@@ -46,6 +47,17 @@ scalar_operator::scalar_operator(
           std::move(create))),
       param_desc(std::move(paramater_descriptions)) {}
 
+scalar_operator::scalar_operator(const time_function &function)
+    : value(std::variant<std::complex<double>, scalar_callback>(
+          scalar_callback(function))),
+      param_desc({{function.parameter, ""}}) {}
+
+const time_function *scalar_operator::get_time_function() const {
+  if (std::holds_alternative<scalar_callback>(this->value))
+    return std::get<scalar_callback>(this->value).get_time_function();
+  return nullptr;
+}
+
 // evaluations
 
 std::complex<double> scalar_operator::evaluate(
@@ -109,6 +121,28 @@ scalar_operator scalar_operator::operator+() const & { return *this; }
 
 scalar_operator scalar_operator::operator+() && { return std::move(*this); }
 
+// The closed form of `self op other`, or of `other op self` if `reversed`, when
+// it is an affine map of the closed form of `self`.
+static std::optional<time_function> fold_constant(const scalar_operator &self,
+                                                  std::complex<double> other,
+                                                  char op, bool reversed) {
+  const auto *function = self.get_time_function();
+  if (!function)
+    return std::nullopt;
+  switch (op) {
+  case '*':
+    return *function * other;
+  case '+':
+    return *function + other;
+  case '-':
+    return reversed ? *function * -1. + other : *function - other;
+  case '/':
+    if (!reversed)
+      return *function / other;
+  }
+  return std::nullopt;
+}
+
 // right-hand arithmetics
 
 #define ARITHMETIC_OPERATIONS(op, otherTy)                                     \
@@ -117,6 +151,8 @@ scalar_operator scalar_operator::operator+() && { return std::move(*this); }
       return scalar_operator(std::get<std::complex<double>>(this->value)       \
                                  op other);                                    \
     }                                                                          \
+    if (auto function = fold_constant(*this, other, #op[0], false))            \
+      return scalar_operator(*function);                                       \
     auto newGenerator =                                                        \
         [other, generator = std::get<scalar_callback>(this->value)](           \
             const std::unordered_map<std::string, std::complex<double>>        \
@@ -141,6 +177,15 @@ ARITHMETIC_OPERATIONS(-, std::complex<double>);
       return scalar_operator(std::get<std::complex<double>>(                   \
           this->value) op std::get<std::complex<double>>(other.value));        \
     }                                                                          \
+    if (other.is_constant()) {                                                 \
+      if (auto function =                                                      \
+              fold_constant(*this, other.evaluate(), #op[0], false))           \
+        return scalar_operator(*function);                                     \
+    } else if (this->is_constant()) {                                          \
+      if (auto function =                                                      \
+              fold_constant(other, this->evaluate(), #op[0], true))            \
+        return scalar_operator(*function);                                     \
+    }                                                                          \
     auto newGenerator =                                                        \
         [other,                                                                \
          *this](const std::unordered_map<std::string, std::complex<double>>    \
@@ -161,6 +206,10 @@ ARITHMETIC_OPERATIONS_SCALAR_OPS(-);
       this->value = std::get<std::complex<double>>(this->value) op other;      \
       return *this;                                                            \
     }                                                                          \
+    if (auto function = fold_constant(*this, other, #op[0], false)) {          \
+      this->value = scalar_callback(*function);                                \
+      return *this;                                                            \
+    }                                                                          \
     auto newGenerator =                                                        \
         [other,                                                                \
          generator = std::move(std::get<scalar_callback>(this->value))](       \
@@ -188,6 +237,19 @@ ARITHMETIC_OPERATIONS_ASSIGNMENT(-, std::complex<double>);
           op std::get<std::complex<double>>(other.value);                      \
       return *this;                                                            \
     }                                                                          \
+    if (other.is_constant()) {                                                 \
+      if (auto function =                                                      \
+              fold_constant(*this, other.evaluate(), #op[0], false)) {         \
+        this->value = scalar_callback(*function);                              \
+        return *this;                                                          \
+      }                                                                        \
+    } else if (this->is_constant()) {                                          \
+      if (auto function =                                                      \
+              fold_constant(other, this->evaluate(), #op[0], true)) {          \
+        this->value = scalar_callback(*function);                              \
+        return *this;                                                          \
+      }                                                                        \
+    }                                                                          \
     auto newGenerator =                                                        \
         [other,                                                                \
          *this](const std::unordered_map<std::string, std::complex<double>>    \
@@ -231,6 +293,8 @@ ARITHMETIC_OPERATIONS_RVALUE(-, const scalar_operator &);
       return scalar_operator(                                                  \
           other op std::get<std::complex<double>>(self.value));                \
     }                                                                          \
+    if (auto function = fold_constant(self, other, #op[0], true))              \
+      return scalar_operator(*function);                                       \
     auto newGenerator =                                                        \
         [other, generator = std::get<scalar_callback>(self.value)](            \
             const std::unordered_map<std::string, std::complex<double>>        \
@@ -243,6 +307,10 @@ ARITHMETIC_OPERATIONS_RVALUE(-, const scalar_operator &);
       return scalar_operator(                                                  \
           other op std::get<std::complex<double>>(self.value));                \
     }                                                                          \
+    if (auto function = fold_constant(self, other, #op[0], true)) {            \
+      self.value = scalar_callback(*function);                                 \
+      return std::move(self);                                                  \
+    }                                                                          \
     auto newGenerator =                                                        \
         [other, generator = std::move(std::get<scalar_callback>(self.value))]( \
             const std::unordered_map<std::string, std::complex<double>>        \
@@ -6,8 +6,19 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 
+#pragma once
+
 #include "cudaq/operators.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
+#include <optional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace cudaq {
 class spin_op_reader {
@@ -59,4 +70,242 @@ public:
 #endif
   }
 };
+
+/// @brief The header of a packed spin operator.
+///
+/// The header is followed by the `num_terms` coefficients as
+/// `std::complex<double>`, then by the X bitmasks and finally by the Z
+/// bitmasks of all terms, each `words_per_term` 64-bit words long. Bit `q` of
+/// a term's masks encodes the Pauli acting on qubit `q`: X sets the X bit, Z
+/// the Z bit, and Y both. All sections are 8-byte aligned, so that a packed
+/// operator can be used in place, e.g., from a memory mapped file.
+struct packed_spin_op_header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t words_per_term;
+  std::uint64_t num_qubits;
+  std::uint64_t num_terms;
+};
+
+/// @brief A read-only view of a spin operator in the packed binary format.
+/// The view does not own, copy, or index the data; terms are decoded on
+/// access, and a `spin_op` is only built when requested with `to_spin_op`.
+class packed_spin_op_view {
+public:
+  static constexpr char format_magic[8] = "CUDAQPO";
+  static constexpr std::uint32_t format_version = 1;
+
+  /// @brief Pack the given operator. The coefficients of the terms must be
+  /// constant.
+  static std::vector<char> pack(const spin_op &op) {
+    std::size_t num_qubits = 0;
+    for (const auto &term : op)
+      for (const auto &p : term)
+        num_qubits = std::max(num_qubits, p.degrees()[0] + 1);
+    const std::size_t num_terms = op.num_terms();
+    const std::size_t words = (num_qubits + 63) / 64;
+
+    std::vector<char> data(size_in_bytes(num_terms, words));
+    packed_spin_op_header header{};
+    std::memcpy(header.magic, format_magic, sizeof(header.magic));
+    header.version = format_version;
+    header.words_per_term = words;
+    header.num_qubits = num_qubits;
+    header.num_terms = num_terms;
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    auto *coeffs = reinterpret_cast<std::complex<double> *>(
+        data.data() + sizeof(header));
+    auto *x_masks = reinterpret_cast<std::uint64_t *>(coeffs + num_terms);
+    auto *z_masks = x_masks + num_terms * words;
+    std::size_t idx = 0;
+    for (const auto &term : op) {
+      coeffs[idx] = term.evaluate_coefficient();
+      for (const auto &p : term) {
+        const auto qubit = p.degrees()[0];
+        const auto pauli = p.as_pauli();
+        const auto bit = std::uint64_t(1) << (qubit % 64);
+        if (pauli == pauli::X || pauli == pauli::Y)
+          x_masks[idx * words + qubit / 64] |= bit;
+        if (pauli == pauli::Z || pauli == pauli::Y)
+          z_masks[idx * words + qubit / 64] |= bit;
+      }
+      ++idx;
+    }
+    return data;
+  }
+
+  /// @brief Create a view of the packed operator in `data`, which must
+  /// outlive the view and be 8-byte aligned.
+  packed_spin_op_view(const void *data, std::size_t size) {
+    if (reinterpret_cast<std::uintptr_t>(data) % alignof(std::uint64_t))
+      throw std::runtime_error("packed spin_op data must be 8-byte aligned");
+    if (size < sizeof(packed_spin_op_header))
+      throw std::runtime_error("invalid packed spin_op - data is truncated");
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, format_magic, sizeof(format_magic)) != 0 ||
+        header.version != format_version)
+      throw std::runtime_error("invalid packed spin_op - unknown format");
+    if (header.words_per_term != (header.num_qubits + 63) / 64 ||
+        size != size_in_bytes(header.num_terms, header.words_per_term))
+      throw std::runtime_error(
+          "invalid packed spin_op - data size does not match its header");
+    coeffs = reinterpret_cast<const std::complex<double> *>(
+        static_cast<const char *>(data) + sizeof(header));
+    x_masks = reinterpret_cast<const std::uint64_t *>(coeffs + num_terms());
+    z_masks = x_masks + num_terms() * header.words_per_term;
+  }
+
+  std::size_t num_qubits() const { return header.num_qubits; }
+  std::size_t num_terms() const { return header.num_terms; }
+
+  std::complex<double> get_coefficient(std::size_t term) const {
+    return coeffs[term];
+  }
+
+  /// @brief Return the Pauli acting on the given qubit in the given term.
+  pauli get_pauli(std::size_t term, std::size_t qubit) const {
+    if (qubit >= num_qubits())
+      return pauli::I;
+    const auto word = term * header.words_per_term + qubit / 64;
+    const bool x = (x_masks[word] >> (qubit % 64)) & 1;
+    const bool z = (z_masks[word] >> (qubit % 64)) & 1;
+    return x ? (z ? pauli::Y : pauli::X) : (z ? pauli::Z : pauli::I);
+  }
+
+  /// @brief Return the X and Z bitmasks of the given term, each
+  /// `(num_qubits() + 63) / 64` words long.
+  std::pair<const std::uint64_t *, const std::uint64_t *>
+  get_masks(std::size_t term) const {
+    return {x_masks + term * header.words_per_term,
+            z_masks + term * header.words_per_term};
+  }
+
+  /// @brief Return the Pauli word of the given term, padded with identities
+  /// to `num_qubits()` qubits.
+  std::string get_pauli_word(std::size_t term) const {
+    std::string word(num_qubits(), 'I');
+    for (std::size_t qubit = 0; qubit < num_qubits(); ++qubit) {
+      const auto pauli = get_pauli(term, qubit);
+      if (pauli != pauli::I)
+        word[qubit] = pauli == pauli::X ? 'X' : pauli == pauli::Y ? 'Y' : 'Z';
+    }
+    return word;
+  }
+
+  /// @brief Build the given term as a spin_op term.
+  spin_op_term get_term(std::size_t term) const {
+    spin_op_term prod(get_coefficient(term));
+    for (std::size_t qubit = 0; qubit < num_qubits(); ++qubit) {
+      const auto pauli = get_pauli(term, qubit);
+      if (pauli == pauli::X)
+        prod *= spin_op::x(qubit);
+      else if (pauli == pauli::Y)
+        prod *= spin_op::y(qubit);
+      else if (pauli == pauli::Z)
+        prod *= spin_op::z(qubit);
+    }
+    return prod;
+  }
+
+  /// @brief Build the operator as a spin_op.
+  spin_op to_spin_op() const { return to_spin_op(0, num_terms()); }
+
+  /// @brief Build the terms with indices in `[first, last)` as a spin_op,
+  /// e.g., to process a large operator in chunks.
+  spin_op to_spin_op(std::size_t first, std::size_t last) const {
+    last = std::min(last, num_terms());
+    if (first >= last)
+      return spin_op::empty();
+    spin_op op(last - first);
+    for (std::size_t term = first; term < last; ++term)
+      op += get_term(term);
+    return op;
+  }
+
+private:
+  static std::size_t size_in_bytes(std::size_t num_terms, std::size_t words) {
+    return sizeof(packed_spin_op_header) +
+           num_terms * (sizeof(std::complex<double>) +
+                        2 * words * sizeof(std::uint64_t));
+  }
+
+  packed_spin_op_header header;
+  const std::complex<double> *coeffs = nullptr;
+  const std::uint64_t *x_masks = nullptr;
+  const std::uint64_t *z_masks = nullptr;
+};
+
+/// @brief A read-only memory mapping of a file holding a packed spin operator.
+class packed_spin_op_file {
+public:
+  /// @brief Write the given operator to `filename` in the packed format.
+  static void write(const spin_op &op, const std::string &filename) {
+    const auto data = packed_spin_op_view::pack(op);
+    const std::string tmp_filename = filename + ".tmp";
+    {
+      std::ofstream output(tmp_filename, std::ios::binary | std::ios::trunc);
+      output.write(data.data(), data.size());
+      if (!output)
+        throw std::runtime_error("unable to write " + tmp_filename);
+    }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+      throw_system_error("unable to move packed spin_op to", filename);
+  }
+
+  /// @brief Map the file at `filename` and validate its content.
+  explicit packed_spin_op_file(const std::string &filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw_system_error("unable to open", filename);
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      ::close(fd);
+      throw_system_error("unable to read", filename);
+    }
+    size = info.st_size;
+    if (size < sizeof(packed_spin_op_header)) {
+      ::close(fd);
+      throw std::runtime_error(filename + ": invalid packed spin_op - data is "
+                                          "truncated");
+    }
+    mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+      throw_system_error("unable to map", filename);
+    try {
+      op_view.emplace(mapped, size);
+    } catch (const std::exception &e) {
+      ::munmap(mapped, size);
+      throw std::runtime_error(filename + ": " + e.what());
+    }
+  }
+
+  packed_spin_op_file(const packed_spin_op_file &) = delete;
+  packed_spin_op_file &operator=(const packed_spin_op_file &) = delete;
+
+  ~packed_spin_op_file() { ::munmap(mapped, size); }
+
+  /// @brief The view of the mapped operator, valid for the lifetime of this
+  /// object.
+  const packed_spin_op_view &view() const { return *op_view; }
+
+private:
+  [[noreturn]] static void throw_system_error(const std::string &what,
+                                              const std::string &filename) {
+    throw std::runtime_error(what + " " + filename + ": " +
+                             std::strerror(errno));
+  }
+
+  void *mapped = MAP_FAILED;
+  std::size_t size = 0;
+  std::optional<packed_spin_op_view> op_view;
+};
+
+class packed_spin_op_reader : public spin_op_reader {
+public:
+  spin_op read(const std::string &data_filename) override {
+    return packed_spin_op_file(data_filename).view().to_spin_op();
+  }
+};
 } // namespace cudaq
@@ -11,12 +11,22 @@
 #include "evaluation.h"
 #include "helpers.h"
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <exception>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <optional>
 #include <set>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 namespace cudaq {
 
 #define PROPERTY_SPECIFIC_TEMPLATE_DEFINITION(HandlerTy, property)             \
@@ -59,6 +69,79 @@ void sum_op<HandlerTy>::insert(product_op<HandlerTy> &&other) {
   }
 }
 
+/// expects is_default to be false
+template <typename HandlerTy>
+void sum_op<HandlerTy>::insert(std::string &&term_id,
+                               product_op<HandlerTy> &&other) {
+  assert(!this->is_default);
+  auto [it, inserted] =
+      this->term_map.try_emplace(std::move(term_id), this->terms.size());
+  if (inserted) {
+    this->coefficients.push_back(std::move(other.coefficient));
+    this->terms.push_back(std::move(other.operators));
+  } else {
+    this->coefficients[it->second] += other.coefficient;
+  }
+}
+
+namespace {
+
+// Sums with fewer terms are always built sequentially.
+constexpr std::size_t min_parallel_terms = 1 << 12;
+// Number of terms that are constructed concurrently before inserting them.
+constexpr std::size_t parallel_block_size = 1 << 16;
+
+/// Coefficients that are not constant may hold callbacks into Python, which
+/// must not be copied or invoked concurrently.
+bool has_constant_coefficients(const std::vector<scalar_operator> &coeffs) {
+  return std::all_of(coeffs.cbegin(), coeffs.cend(),
+                     [](const scalar_operator &c) { return c.is_constant(); });
+}
+
+} // namespace
+
+/// expects is_default to be false
+template <typename HandlerTy>
+template <typename TermFn>
+void sum_op<HandlerTy>::insert_terms(std::size_t count,
+                                     const TermFn &make_term, bool parallel) {
+  assert(!this->is_default);
+#if defined(_OPENMP)
+  if (parallel && count >= min_parallel_terms) {
+    // Constructing the terms and computing their ids dominates the cost, and
+    // is done concurrently for each block of terms. The terms are then
+    // inserted sequentially in their original order, such that the result is
+    // identical to the one built sequentially, independent of the number of
+    // threads.
+    const auto block_size = std::min(count, parallel_block_size);
+    std::vector<std::optional<product_op<HandlerTy>>> block(block_size);
+    std::vector<std::string> ids(block_size);
+    for (std::size_t start = 0; start < count; start += block_size) {
+      const auto size = std::min(block_size, count - start);
+      std::exception_ptr error;
+#pragma omp parallel for
+      for (std::size_t k = 0; k < size; ++k) {
+        try {
+          block[k].emplace(make_term(start + k));
+          ids[k] = block[k]->get_term_id();
+        } catch (...) {
+#pragma omp critical
+          if (!error)
+            error = std::current_exception();
+        }
+      }
+      if (error)
+        std::rethrow_exception(error);
+      for (std::size_t k = 0; k < size; ++k)
+        this->insert(std::move(ids[k]), std::move(*block[k]));
+    }
+    return;
+  }
+#endif
+  for (std::size_t i = 0; i < count; ++i)
+    this->insert(make_term(i));
+}
+
 template <typename HandlerTy>
 void sum_op<HandlerTy>::aggregate_terms() {}
 
@@ -118,6 +201,9 @@ sum_op<HandlerTy>::transform(operator_arithmetics<EvalTy> arithmetics) const {
                                                                                \
   template void sum_op<HandlerTy>::insert(const product_op<HandlerTy> &other); \
                                                                                \
+  template void sum_op<HandlerTy>::insert(std::string &&term_id,               \
+                                          product_op<HandlerTy> &&other);      \
+                                                                               \
   template void sum_op<HandlerTy>::aggregate_terms(                            \
       product_op<HandlerTy> &&item2);                                          \
                                                                                \
@@ -818,6 +904,216 @@ sum_op<HandlerTy>::operator*(const product_op<HandlerTy> &other) const {
 SUM_ADDITION_PRODUCT(+)
 SUM_ADDITION_PRODUCT(-)
 
+namespace {
+
+/// Terms of a spin operator encoded as bit masks over a sorted list of
+/// degrees. Each term is stored as `3 * num_words` consecutive words in a
+/// single buffer: the degrees the term acts on (including identities), its X
+/// components, and its Z components (Y sets both).
+struct spin_term_masks {
+  std::size_t num_words = 0;
+  std::vector<std::uint64_t> masks;
+  std::vector<std::complex<double>> coefficients;
+
+  std::size_t size() const { return coefficients.size(); }
+  const std::uint64_t *operator[](std::size_t idx) const {
+    return masks.data() + 3 * num_words * idx;
+  }
+};
+
+spin_term_masks
+encode_spin_terms(const std::vector<std::vector<spin_handler>> &terms,
+                  const std::vector<scalar_operator> &coefficients,
+                  const std::vector<std::size_t> &degrees) {
+  spin_term_masks encoded;
+  encoded.num_words = (degrees.size() + 63) / 64;
+  const auto stride = 3 * encoded.num_words;
+  encoded.masks.resize(stride * terms.size(), 0);
+  encoded.coefficients.reserve(terms.size());
+  for (std::size_t i = 0; i < terms.size(); ++i) {
+    auto *support = encoded.masks.data() + stride * i;
+    auto *x = support + encoded.num_words;
+    auto *z = x + encoded.num_words;
+    for (const auto &op : terms[i]) {
+      std::size_t idx =
+          std::lower_bound(degrees.cbegin(), degrees.cend(), op.target(),
+                           operator_handler::canonical_order) -
+          degrees.cbegin();
+      const auto bit = std::uint64_t(1) << (idx % 64);
+      const auto p = op.as_pauli();
+      support[idx / 64] |= bit;
+      if (p == pauli::X || p == pauli::Y)
+        x[idx / 64] |= bit;
+      if (p == pauli::Z || p == pauli::Y)
+        z[idx / 64] |= bit;
+    }
+    encoded.coefficients.push_back(coefficients[i].evaluate());
+  }
+  return encoded;
+}
+
+std::vector<spin_handler>
+decode_spin_term(const std::uint64_t *masks, std::size_t num_words,
+                 const std::vector<std::size_t> &degrees) {
+  const auto *support = masks;
+  const auto *x = support + num_words;
+  const auto *z = x + num_words;
+  std::vector<spin_handler> ops;
+  for (std::size_t d = 0; d < degrees.size(); ++d) {
+    const auto bit = std::uint64_t(1) << (d % 64);
+    if (!(support[d / 64] & bit))
+      continue;
+    const bool has_x = x[d / 64] & bit, has_z = z[d / 64] & bit;
+    ops.emplace_back(has_x   ? (has_z ? pauli::Y : pauli::X)
+                     : has_z ? pauli::Z
+                             : pauli::I,
+                     degrees[d]);
+  }
+  return ops;
+}
+
+/// Accumulates spin terms encoded as bit masks, combining the coefficients of
+/// identical terms. The distinct terms are kept in the order in which they are
+/// first added, and are indexed by an open addressing hash table.
+class spin_term_accumulator {
+  static constexpr auto empty_slot = std::numeric_limits<std::size_t>::max();
+  std::size_t stride;
+  std::vector<std::size_t> slots;
+
+  std::size_t find_slot(const std::uint64_t *masks) const {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    for (std::size_t k = 0; k < stride; ++k) {
+      h ^= masks[k] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      h *= 0x100000001b3ULL;
+    }
+    std::size_t slot = h & (slots.size() - 1);
+    while (slots[slot] != empty_slot &&
+           !std::equal(masks, masks + stride, terms[slots[slot]]))
+      slot = (slot + 1) & (slots.size() - 1);
+    return slot;
+  }
+
+public:
+  spin_term_masks terms;
+
+  spin_term_accumulator(std::size_t num_words, std::size_t expected_size)
+      : stride(3 * num_words),
+        slots(std::bit_ceil(2 * expected_size + 2), empty_slot) {
+    terms.num_words = num_words;
+  }
+
+  void add(const std::uint64_t *masks, std::complex<double> coefficient) {
+    auto slot = find_slot(masks);
+    if (slots[slot] != empty_slot) {
+      terms.coefficients[slots[slot]] += coefficient;
+      return;
+    }
+    slots[slot] = terms.size();
+    terms.masks.insert(terms.masks.end(), masks, masks + stride);
+    terms.coefficients.push_back(coefficient);
+    if (2 * terms.size() > slots.size()) {
+      slots.assign(2 * slots.size(), empty_slot);
+      for (std::size_t idx = 0; idx < terms.size(); ++idx)
+        slots[find_slot(terms[idx])] = idx;
+    }
+  }
+};
+
+/// Multiplies the terms [begin, end) of lhs with each term of rhs, and adds
+/// the products to the given accumulator.
+void multiply_spin_terms(const spin_term_masks &lhs, std::size_t begin,
+                         std::size_t end, const spin_term_masks &rhs,
+                         spin_term_accumulator &products) {
+  const auto num_words = lhs.num_words;
+  // i^k for the phase k accumulated by multiplying Pauli matrices
+  const std::complex<double> phases[4] = {{1., 0.}, {0., 1.}, {-1., 0.},
+                                          {0., -1.}};
+  std::vector<std::uint64_t> product(3 * num_words);
+  for (std::size_t i = begin; i < end; ++i) {
+    const auto *a = lhs[i];
+    for (std::size_t j = 0; j < rhs.size(); ++j) {
+      const auto *b = rhs[j];
+      unsigned phase = 0;
+      for (std::size_t w = 0; w < num_words; ++w) {
+        const auto ax = a[num_words + w], az = a[2 * num_words + w];
+        const auto bx = b[num_words + w], bz = b[2 * num_words + w];
+        // ZX = iY, XY = iZ, YZ = iX, and the reverse orders give -i.
+        const auto plus = (~ax & az & bx & ~bz) | (ax & ~az & bx & bz) |
+                          (ax & az & ~bx & bz);
+        const auto minus = (ax & ~az & ~bx & bz) | (ax & az & bx & ~bz) |
+                           (~ax & az & bx & bz);
+        phase += std::popcount(plus) + 3 * std::popcount(minus);
+        product[w] = a[w] | b[w];
+        product[num_words + w] = ax ^ bx;
+        product[2 * num_words + w] = az ^ bz;
+      }
+      products.add(product.data(), lhs.coefficients[i] * rhs.coefficients[j] *
+                                       phases[phase % 4]);
+    }
+  }
+}
+
+/// Multiplies two sums of spin terms with constant coefficients, and returns
+/// the distinct product terms encoded over the sorted list of all degrees. The
+/// products are computed and aggregated on the bit masks, such that operators
+/// only need to be materialized for the distinct product terms.
+/// The terms of lhs are split into blocks of a fixed size, whose products are
+/// accumulated concurrently, and the partial sums are then merged in the order
+/// of the blocks. Neither the blocks nor the merge depend on the number of
+/// threads, and hence neither does the result. The distinct terms are in the
+/// order in which they are first produced when multiplying term by term.
+spin_term_masks
+multiply_spin_terms(const std::vector<std::vector<spin_handler>> &lhs_terms,
+                    const std::vector<scalar_operator> &lhs_coefficients,
+                    const std::vector<std::vector<spin_handler>> &rhs_terms,
+                    const std::vector<scalar_operator> &rhs_coefficients,
+                    std::vector<std::size_t> &degrees) {
+  degrees.clear();
+  for (const auto *terms : {&lhs_terms, &rhs_terms})
+    for (const auto &term : *terms)
+      for (const auto &op : term)
+        degrees.push_back(op.target());
+  std::sort(degrees.begin(), degrees.end(), operator_handler::canonical_order);
+  degrees.erase(std::unique(degrees.begin(), degrees.end()), degrees.end());
+
+  const auto lhs = encode_spin_terms(lhs_terms, lhs_coefficients, degrees);
+  const auto rhs = encode_spin_terms(rhs_terms, rhs_coefficients, degrees);
+  const auto block_size =
+      std::max<std::size_t>(1, parallel_block_size / std::max<std::size_t>(
+                                                         1, rhs.size()));
+  const auto num_blocks = (lhs.size() + block_size - 1) / block_size;
+  spin_term_accumulator products(lhs.num_words, lhs.size() + rhs.size());
+  if (num_blocks <= 1) {
+    multiply_spin_terms(lhs, 0, lhs.size(), rhs, products);
+    return std::move(products.terms);
+  }
+
+  // Blocks are processed in batches to bound the memory for partial sums.
+  std::size_t batch_size = 1;
+#if defined(_OPENMP)
+  batch_size = std::max(omp_get_max_threads(), 1);
+#endif
+  for (std::size_t first = 0; first < num_blocks; first += batch_size) {
+    const auto count = std::min(batch_size, num_blocks - first);
+    std::vector<std::optional<spin_term_accumulator>> partial(count);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if (count > 1)
+#endif
+    for (std::size_t b = 0; b < count; ++b) {
+      const auto begin = (first + b) * block_size;
+      const auto end = std::min(begin + block_size, lhs.size());
+      partial[b].emplace(lhs.num_words, end - begin + rhs.size());
+      multiply_spin_terms(lhs, begin, end, rhs, *partial[b]);
+    }
+    for (const auto &block : partial)
+      for (std::size_t idx = 0; idx < block->terms.size(); ++idx)
+        products.add(block->terms[idx], block->terms.coefficients[idx]);
+  }
+  return std::move(products.terms);
+}
+
+} // namespace
+
 template <typename HandlerTy>
 sum_op<HandlerTy>
 sum_op<HandlerTy>::operator*(const sum_op<HandlerTy> &other) const {
@@ -827,20 +1123,46 @@ sum_op<HandlerTy>::operator*(const sum_op<HandlerTy> &other) const {
     return other;
 
   sum_op<HandlerTy> sum(false); // the entire sum needs to be rebuilt
+  if constexpr (std::is_same<HandlerTy, spin_handler>::value) {
+    if (has_constant_coefficients(this->coefficients) &&
+        has_constant_coefficients(other.coefficients)) {
+      std::vector<std::size_t> degrees;
+      const auto products =
+          multiply_spin_terms(this->terms, this->coefficients, other.terms,
+                              other.coefficients, degrees);
+      sum.coefficients.reserve(products.size());
+      sum.term_map.reserve(products.size());
+      sum.terms.reserve(products.size());
+      sum.insert_terms(
+          products.size(),
+          [&](std::size_t idx) {
+            return product_op<HandlerTy>(
+                products.coefficients[idx],
+                decode_spin_term(products[idx], products.num_words, degrees));
+          },
+          true);
+      return sum;
+    }
+  }
   auto max_size = this->terms.size() * other.terms.size();
   sum.coefficients.reserve(max_size);
   sum.term_map.reserve(max_size);
   sum.terms.reserve(max_size);
-  for (auto i = 0; i < this->terms.size(); ++i) {
-    for (auto j = 0; j < other.terms.size(); ++j) {
-      auto max_size = this->terms[i].size() + other.terms[j].size();
-      product_op<HandlerTy> prod(this->coefficients[i] * other.coefficients[j],
-                                 this->terms[i], max_size);
-      for (HandlerTy op : other.terms[j])
-        prod.insert(std::move(op));
-      sum.insert(std::move(prod));
-    }
-  }
+  const auto num_rhs = other.terms.size();
+  sum.insert_terms(
+      max_size,
+      [&](std::size_t idx) {
+        const auto i = idx / num_rhs, j = idx % num_rhs;
+        auto max_size = this->terms[i].size() + other.terms[j].size();
+        product_op<HandlerTy> prod(
+            this->coefficients[i] * other.coefficients[j], this->terms[i],
+            max_size);
+        for (HandlerTy op : other.terms[j])
+          prod.insert(std::move(op));
+        return prod;
+      },
+      has_constant_coefficients(this->coefficients) &&
+          has_constant_coefficients(other.coefficients));
   return sum;
 }
 
@@ -851,10 +1173,13 @@ sum_op<HandlerTy>::operator*(const sum_op<HandlerTy> &other) const {
       const sum_op<HandlerTy> &other) const & {                                \
     sum_op<HandlerTy> sum(*this, this->is_default &&other.is_default,          \
                           this->terms.size() + other.terms.size());            \
-    for (auto i = 0; i < other.terms.size(); ++i) {                            \
-      product_op<HandlerTy> prod(op other.coefficients[i], other.terms[i]);    \
-      sum.insert(std::move(prod));                                             \
-    }                                                                          \
+    sum.insert_terms(                                                          \
+        other.terms.size(),                                                    \
+        [&](std::size_t i) {                                                   \
+          return product_op<HandlerTy>(op other.coefficients[i],               \
+                                       other.terms[i]);                        \
+        },                                                                     \
+        has_constant_coefficients(other.coefficients));                        \
     return sum;                                                                \
   }                                                                            \
                                                                                \
@@ -867,9 +1192,13 @@ sum_op<HandlerTy>::operator*(const sum_op<HandlerTy> &other) const {
     this->coefficients.reserve(max_size);                                      \
     this->term_map.reserve(max_size);                                          \
     this->terms.reserve(max_size);                                             \
-    for (auto i = 0; i < other.terms.size(); ++i)                              \
-      this->insert(                                                            \
-          product_op<HandlerTy>(op other.coefficients[i], other.terms[i]));    \
+    this->insert_terms(                                                        \
+        other.terms.size(),                                                    \
+        [&](std::size_t i) {                                                   \
+          return product_op<HandlerTy>(op other.coefficients[i],               \
+                                       other.terms[i]);                        \
+        },                                                                     \
+        has_constant_coefficients(other.coefficients));                        \
     return std::move(*this);                                                   \
   }                                                                            \
                                                                                \
@@ -878,11 +1207,13 @@ sum_op<HandlerTy>::operator*(const sum_op<HandlerTy> &other) const {
       const & {                                                                \
     sum_op<HandlerTy> sum(*this, this->is_default &&other.is_default,          \
                           this->terms.size() + other.terms.size());            \
-    for (auto i = 0; i < other.terms.size(); ++i) {                            \
-      product_op<HandlerTy> prod(op std::move(other.coefficients[i]),          \
-                                 std::move(other.terms[i]));                   \
-      sum.insert(std::move(prod));                                             \
-    }                                                                          \
+    sum.insert_terms(                                                          \
+        other.terms.size(),                                                    \
+        [&](std::size_t i) {                                                   \
+          return product_op<HandlerTy>(op std::move(other.coefficients[i]),    \
+                                       std::move(other.terms[i]));             \
+        },                                                                     \
+        has_constant_coefficients(other.coefficients));                        \
     return sum;                                                                \
   }                                                                            \
                                                                                \
@@ -895,9 +1226,13 @@ sum_op<HandlerTy>::operator*(const sum_op<HandlerTy> &other) const {
     this->coefficients.reserve(max_size);                                      \
     this->term_map.reserve(max_size);                                          \
     this->terms.reserve(max_size);                                             \
-    for (auto i = 0; i < other.terms.size(); ++i)                              \
-      this->insert(product_op<HandlerTy>(op std::move(other.coefficients[i]),  \
-                                         std::move(other.terms[i])));          \
+    this->insert_terms(                                                        \
+        other.terms.size(),                                                    \
+        [&](std::size_t i) {                                                   \
+          return product_op<HandlerTy>(op std::move(other.coefficients[i]),    \
+                                       std::move(other.terms[i]));             \
+        },                                                                     \
+        has_constant_coefficients(other.coefficients));                        \
     return std::move(*this);                                                   \
   }
 
@@ -1046,20 +1381,47 @@ sum_op<HandlerTy>::operator*=(const sum_op<HandlerTy> &other) {
   }
 
   sum_op<HandlerTy> sum(false); // the entire sum needs to be rebuilt
+  if constexpr (std::is_same<HandlerTy, spin_handler>::value) {
+    if (has_constant_coefficients(this->coefficients) &&
+        has_constant_coefficients(other.coefficients)) {
+      std::vector<std::size_t> degrees;
+      const auto products =
+          multiply_spin_terms(this->terms, this->coefficients, other.terms,
+                              other.coefficients, degrees);
+      sum.coefficients.reserve(products.size());
+      sum.term_map.reserve(products.size());
+      sum.terms.reserve(products.size());
+      sum.insert_terms(
+          products.size(),
+          [&](std::size_t idx) {
+            return product_op<HandlerTy>(
+                products.coefficients[idx],
+                decode_spin_term(products[idx], products.num_words, degrees));
+          },
+          true);
+      *this = std::move(sum);
+      return *this;
+    }
+  }
   auto max_size = this->terms.size() * other.terms.size();
   sum.coefficients.reserve(max_size);
   sum.term_map.reserve(max_size);
   sum.terms.reserve(max_size);
-  for (auto i = 0; i < this->terms.size(); ++i) {
-    for (auto j = 0; j < other.terms.size(); ++j) {
-      auto max_size = this->terms[i].size() + other.terms[j].size();
-      product_op<HandlerTy> prod(this->coefficients[i] * other.coefficients[j],
-                                 this->terms[i], max_size);
-      for (HandlerTy op : other.terms[j])
-        prod.insert(std::move(op));
-      sum.insert(std::move(prod));
-    }
-  }
+  const auto num_rhs = other.terms.size();
+  sum.insert_terms(
+      max_size,
+      [&](std::size_t idx) {
+        const auto i = idx / num_rhs, j = idx % num_rhs;
+        auto max_size = this->terms[i].size() + other.terms[j].size();
+        product_op<HandlerTy> prod(
+            this->coefficients[i] * other.coefficients[j], this->terms[i],
+            max_size);
+        for (HandlerTy op : other.terms[j])
+          prod.insert(std::move(op));
+        return prod;
+      },
+      has_constant_coefficients(this->coefficients) &&
+          has_constant_coefficients(other.coefficients));
   *this = std::move(sum);
   return *this;
 }
@@ -1075,9 +1437,13 @@ sum_op<HandlerTy>::operator*=(const sum_op<HandlerTy> &other) {
     this->coefficients.reserve(max_size);                                      \
     this->term_map.reserve(max_size);                                          \
     this->terms.reserve(max_size);                                             \
-    for (auto i = 0; i < other.terms.size(); ++i)                              \
-      this->insert(                                                            \
-          product_op<HandlerTy>(op other.coefficients[i], other.terms[i]));    \
+    this->insert_terms(                                                        \
+        other.terms.size(),                                                    \
+        [&](std::size_t i) {                                                   \
+          return product_op<HandlerTy>(op other.coefficients[i],               \
+                                       other.terms[i]);                        \
+        },                                                                     \
+        has_constant_coefficients(other.coefficients));                        \
     return *this;                                                              \
   }                                                                            \
                                                                                \
@@ -1090,9 +1456,13 @@ sum_op<HandlerTy>::operator*=(const sum_op<HandlerTy> &other) {
     this->coefficients.reserve(max_size);                                      \
     this->term_map.reserve(max_size);                                          \
     this->terms.reserve(max_size);                                             \
-    for (auto i = 0; i < other.terms.size(); ++i)                              \
-      this->insert(product_op<HandlerTy>(op std::move(other.coefficients[i]),  \
-                                         std::move(other.terms[i])));          \
+    this->insert_terms(                                                        \
+        other.terms.size(),                                                    \
+        [&](std::size_t i) {                                                   \
+          return product_op<HandlerTy>(op std::move(other.coefficients[i]),    \
+                                       std::move(other.terms[i]));             \
+        },                                                                     \
+        has_constant_coefficients(other.coefficients));                        \
     return *this;                                                              \
   }
 
@@ -1575,10 +1945,28 @@ sum_op<HandlerTy> &sum_op<HandlerTy>::trim(
   trimmed.term_map.reserve(this->terms.size());
   trimmed.terms.reserve(this->terms.size());
   trimmed.coefficients.reserve(this->coefficients.size());
-  for (const auto &prod : *this)
-    if (std::abs(prod.evaluate_coefficient(parameters)) > tol)
-      trimmed.insert(std::move(prod));
-  *this = trimmed;
+  // Evaluating the coefficients may invoke callbacks into Python, and is
+  // hence only done concurrently if all coefficients are constant.
+  const bool parallel = has_constant_coefficients(this->coefficients);
+  std::vector<char> keep(this->terms.size());
+#if defined(_OPENMP)
+#pragma omp parallel for if (parallel && keep.size() >= min_parallel_terms)
+#endif
+  for (std::size_t i = 0; i < keep.size(); ++i)
+    keep[i] = std::abs(this->coefficients[i].evaluate(parameters)) > tol;
+  std::vector<std::size_t> kept;
+  kept.reserve(keep.size());
+  for (std::size_t i = 0; i < keep.size(); ++i)
+    if (keep[i])
+      kept.push_back(i);
+  trimmed.insert_terms(
+      kept.size(),
+      [&](std::size_t i) {
+        return product_op<HandlerTy>(this->coefficients[kept[i]],
+                                     this->terms[kept[i]]);
+      },
+      parallel);
+  *this = std::move(trimmed);
   return *this;
 }
 
@@ -1595,8 +1983,14 @@ template <typename HandlerTy>
 sum_op<HandlerTy>
 sum_op<HandlerTy>::canonicalize(const sum_op<HandlerTy> &orig) {
   sum_op<HandlerTy> canonicalized(false);
-  for (auto &&prod : orig)
-    canonicalized.insert(prod.canonicalize());
+  canonicalized.insert_terms(
+      orig.terms.size(),
+      [&orig](std::size_t i) {
+        product_op<HandlerTy> prod(orig.coefficients[i], orig.terms[i]);
+        prod.canonicalize();
+        return prod;
+      },
+      has_constant_coefficients(orig.coefficients));
   return canonicalized;
 }
 
@@ -1622,10 +2016,16 @@ sum_op<HandlerTy>::canonicalize(const sum_op<HandlerTy> &orig,
         all_degrees.insert(op_degrees.cbegin(), op_degrees.cend());
       }
   }
+  const auto &canon_degrees = degrees.size() == 0 ? all_degrees : degrees;
   sum_op<HandlerTy> canonicalized(false);
-  for (auto &&prod : orig)
-    canonicalized.insert(
-        prod.canonicalize(degrees.size() == 0 ? all_degrees : degrees));
+  canonicalized.insert_terms(
+      orig.terms.size(),
+      [&](std::size_t i) {
+        product_op<HandlerTy> prod(orig.coefficients[i], orig.terms[i]);
+        prod.canonicalize(canon_degrees);
+        return prod;
+      },
+      has_constant_coefficients(orig.coefficients));
   return canonicalized;
 }
 
@@ -1829,6 +2229,67 @@ sum_op<HandlerTy> sum_op<HandlerTy>::random(std::size_t nQubits,
   return sum;
 }
 
+HANDLER_SPECIFIC_TEMPLATE_DEFINITION(spin_handler)
+std::vector<sum_op<HandlerTy>>
+sum_op<HandlerTy>::group_commuting(grouping_strategy strategy) const {
+  using pauli_map = std::map<std::size_t, pauli>;
+  // Two Pauli strings commute if and only if they anti-commute on an even
+  // number of qubits.
+  auto commute = [](const pauli_map &lhs, const pauli_map &rhs) {
+    bool commuting = true;
+    for (const auto &[target, p] : lhs) {
+      auto it = rhs.find(target);
+      if (it != rhs.end() && it->second != p)
+        commuting = !commuting;
+    }
+    return commuting;
+  };
+
+  std::vector<sum_op<HandlerTy>> groups;
+  // The Pauli measured on each qubit by each group (qubit-wise strategy), or
+  // the Pauli strings of the terms in each group (general strategy).
+  std::vector<pauli_map> group_bases;
+  std::vector<std::vector<pauli_map>> group_members;
+  for (std::size_t i = 0; i < this->terms.size(); ++i) {
+    pauli_map paulis;
+    for (const auto &op : this->terms[i])
+      if (op.as_pauli() != pauli::I)
+        paulis.emplace(op.target(), op.as_pauli());
+
+    std::size_t idx = 0;
+    for (; idx < groups.size(); ++idx) {
+      bool compatible;
+      if (strategy == grouping_strategy::qubit_wise) {
+        const auto &basis = group_bases[idx];
+        compatible = std::all_of(
+            paulis.cbegin(), paulis.cend(), [&basis](const auto &entry) {
+              auto it = basis.find(entry.first);
+              return it == basis.end() || it->second == entry.second;
+            });
+      } else {
+        const auto &members = group_members[idx];
+        compatible = std::all_of(
+            members.cbegin(), members.cend(),
+            [&](const pauli_map &member) { return commute(paulis, member); });
+      }
+      if (compatible)
+        break;
+    }
+
+    if (idx == groups.size()) {
+      groups.push_back(sum_op<HandlerTy>(false));
+      group_bases.emplace_back();
+      group_members.emplace_back();
+    }
+    groups[idx] += product_op<HandlerTy>(this->coefficients[i], this->terms[i]);
+    if (strategy == grouping_strategy::qubit_wise)
+      group_bases[idx].insert(paulis.cbegin(), paulis.cend());
+    else
+      group_members[idx].push_back(std::move(paulis));
+  }
+  return groups;
+}
+
 template <typename HandlerTy>
 PROPERTY_SPECIFIC_TEMPLATE_DEFINITION(HandlerTy,
                                       product_op<T>::supports_inplace_mult)
@@ -1845,17 +2306,230 @@ csr_spmatrix sum_op<HandlerTy>::to_sparse_matrix(
                            std::vector<std::size_t>, std::vector<std::size_t>>(
         {}, {}, {});
 
-  auto matrix = HandlerTy::to_sparse_matrix(
-      evaluated.terms[0].encoding, evaluated.terms[0].relevant_dimensions,
-      evaluated.terms[0].coefficient, invert_order);
-  for (auto i = 1; i < terms.size(); ++i)
-    matrix += HandlerTy::to_sparse_matrix(
+  auto term_matrix = [&evaluated, invert_order](std::size_t i) {
+    return HandlerTy::to_sparse_matrix(
         evaluated.terms[i].encoding, evaluated.terms[i].relevant_dimensions,
         evaluated.terms[i].coefficient, invert_order);
-  return cudaq::detail::to_csr_spmatrix(
-      matrix, 1ul << evaluated.terms[0].relevant_dimensions.size());
+  };
+  // Terms are summed in chunks of a fixed size, concurrently if OpenMP is
+  // available, and the partial sums are added in order, such that the result
+  // does not depend on the number of threads.
+  constexpr std::size_t terms_per_chunk = 64;
+  const auto num_terms = evaluated.terms.size();
+  const auto num_chunks = (num_terms + terms_per_chunk - 1) / terms_per_chunk;
+  auto chunk_sum = [&term_matrix, num_terms](std::size_t chunk) {
+    const auto begin = chunk * terms_per_chunk;
+    const auto end = std::min(begin + terms_per_chunk, num_terms);
+    auto matrix = term_matrix(begin);
+    for (auto i = begin + 1; i < end; ++i)
+      matrix += term_matrix(i);
+    return matrix;
+  };
+  auto matrix = chunk_sum(0);
+  // Chunks are processed in batches to bound the memory for partial sums.
+  std::size_t batch_size = 1;
+#if defined(_OPENMP)
+  batch_size = std::max(omp_get_max_threads(), 1);
+#endif
+  for (std::size_t first = 1; first < num_chunks; first += batch_size) {
+    const auto count = std::min(batch_size, num_chunks - first);
+    std::vector<std::optional<cudaq::detail::EigenSparseMatrix>> partial(count);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if (count > 1)
+#endif
+    for (std::size_t c = 0; c < count; ++c)
+      partial[c].emplace(chunk_sum(first + c));
+    for (const auto &partial_sum : partial)
+      matrix += *partial_sum;
+  }
+  return cudaq::detail::to_csr_spmatrix(matrix);
+}
+
+namespace {
+
+/// The matrix of an elementary operator embedded into the space of all
+/// degrees of freedom a sum acts on. The rows of the (dense) matrix of the
+/// operator are stored in compressed form, omitting zero entries.
+struct embedded_operator {
+  // strides in the full space and dimensions of the degrees of the operator
+  std::vector<std::size_t> strides;
+  std::vector<std::int64_t> dimensions;
+  // offset in the full space of each basis state of the operator
+  std::vector<std::size_t> offsets;
+  std::vector<std::size_t> row_starts;
+  std::vector<std::size_t> columns;
+  std::vector<std::complex<double>> values;
+
+  embedded_operator(
+      const std::vector<std::size_t> &degrees, const complex_matrix &matrix,
+      const std::unordered_map<std::size_t, std::int64_t> &all_dimensions,
+      const std::unordered_map<std::size_t, std::size_t> &all_strides) {
+    std::size_t local_dim = 1;
+    for (auto degree : degrees) {
+      strides.push_back(all_strides.at(degree));
+      dimensions.push_back(all_dimensions.at(degree));
+      local_dim *= dimensions.back();
+    }
+    if (matrix.rows() != local_dim || matrix.cols() != local_dim)
+      throw std::runtime_error("matrix dimensions do not match the dimensions "
+                               "of the degrees of freedom");
+    offsets.reserve(local_dim);
+    for (std::size_t state = 0; state < local_dim; ++state) {
+      std::size_t offset = 0, remainder = state;
+      for (std::size_t k = 0; k < strides.size(); ++k) {
+        offset += (remainder % dimensions[k]) * strides[k];
+        remainder /= dimensions[k];
+      }
+      offsets.push_back(offset);
+    }
+    row_starts.reserve(local_dim + 1);
+    row_starts.push_back(0);
+    for (std::size_t row = 0; row < local_dim; ++row) {
+      for (std::size_t col = 0; col < local_dim; ++col) {
+        auto value = matrix(row, col);
+        if (value != std::complex<double>(0.)) {
+          columns.push_back(col);
+          values.push_back(value);
+        }
+      }
+      row_starts.push_back(columns.size());
+    }
+  }
+
+  std::size_t local_state(std::size_t state) const {
+    std::size_t local = 0, local_stride = 1;
+    for (std::size_t k = 0; k < strides.size(); ++k) {
+      local += (state / strides[k]) % dimensions[k] * local_stride;
+      local_stride *= dimensions[k];
+    }
+    return local;
+  }
+};
+
+using cudaq::detail::combine_entries;
+using cudaq::detail::sparse_row;
+
+/// Appends the entries of the given row of the product of the given operators,
+/// scaled by the coefficient, to `row`. The row is computed by multiplying the
+/// unit row vector with each operator in turn.
+void append_row(std::size_t state, std::complex<double> coefficient,
+                const std::vector<const embedded_operator *> &factors,
+                sparse_row &row, sparse_row &current, sparse_row &next) {
+  current.assign(1, {state, coefficient});
+  for (const auto *op : factors) {
+    next.clear();
+    for (const auto &[col, value] : current) {
+      const auto local = op->local_state(col);
+      const auto base = col - op->offsets[local];
+      for (auto k = op->row_starts[local]; k < op->row_starts[local + 1]; ++k)
+        next.emplace_back(base + op->offsets[op->columns[k]],
+                          value * op->values[k]);
+    }
+    if (next.size() > 1)
+      combine_entries(next);
+    std::swap(current, next);
+  }
+  row.insert(row.end(), current.cbegin(), current.cend());
 }
 
+} // namespace
+
+template <typename HandlerTy>
+PROPERTY_AGNOSTIC_TEMPLATE_DEFINITION(HandlerTy,
+                                      product_op<T>::supports_inplace_mult)
+csr_spmatrix sum_op<HandlerTy>::to_sparse_matrix(
+    std::unordered_map<std::size_t, std::int64_t> dimensions,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool invert_order) const {
+  std::vector<std::complex<double>> values;
+  std::vector<std::size_t> rows, cols;
+  if (this->terms.size() == 0)
+    return std::make_tuple(values, rows, cols);
+
+  // Coefficients and the matrices of the elementary operators may invoke
+  // callbacks, and are evaluated sequentially. The matrix of each distinct
+  // operator is computed only once.
+  std::vector<std::complex<double>> coefficients;
+  std::vector<std::vector<std::size_t>> term_ops(this->terms.size());
+  std::unordered_map<std::string, std::size_t> op_indices;
+  std::vector<std::pair<std::vector<std::size_t>, complex_matrix>> op_matrices;
+  coefficients.reserve(this->terms.size());
+  for (std::size_t i = 0; i < this->terms.size(); ++i) {
+    coefficients.push_back(this->coefficients[i].evaluate(parameters));
+    for (const auto &op : this->terms[i]) {
+      auto [it, inserted] =
+          op_indices.try_emplace(op.unique_id(), op_matrices.size());
+      if (inserted)
+        op_matrices.emplace_back(op.degrees(),
+                                 op.to_matrix(dimensions, parameters));
+      term_ops[i].push_back(it->second);
+    }
+  }
+
+  // The first degree is the least significant one by convention.
+  auto degrees = this->degrees();
+  if (invert_order)
+    std::reverse(degrees.begin(), degrees.end());
+  std::unordered_map<std::size_t, std::size_t> strides;
+  std::size_t dim = 1;
+  for (auto degree : degrees) {
+    strides[degree] = dim;
+    dim *= dimensions.at(degree);
+  }
+  std::vector<embedded_operator> ops;
+  ops.reserve(op_matrices.size());
+  for (const auto &[op_degrees, matrix] : op_matrices)
+    ops.emplace_back(op_degrees, matrix, dimensions, strides);
+  std::vector<std::vector<const embedded_operator *>> factors;
+  factors.reserve(term_ops.size());
+  for (const auto &indices : term_ops) {
+    factors.emplace_back();
+    for (auto idx : indices)
+      factors.back().push_back(&ops[idx]);
+  }
+
+  // Each row is assembled from all terms independently of all other rows,
+  // such that rows can be assembled concurrently without affecting the result.
+  constexpr std::size_t rows_per_block = 1024;
+  const auto num_blocks = (dim + rows_per_block - 1) / rows_per_block;
+  std::vector<csr_spmatrix> blocks(num_blocks);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if (num_blocks > 1)
+#endif
+  for (std::size_t b = 0; b < num_blocks; ++b) {
+    auto &[block_values, block_rows, block_cols] = blocks[b];
+    sparse_row row, current, next;
+    for (auto r = b * rows_per_block;
+         r < std::min(dim, (b + 1) * rows_per_block); ++r) {
+      row.clear();
+      for (std::size_t i = 0; i < factors.size(); ++i)
+        append_row(r, coefficients[i], factors[i], row, current, next);
+      combine_entries(row);
+      for (const auto &[col, value] : row) {
+        if (value == std::complex<double>(0.))
+          continue;
+        block_values.push_back(value);
+        block_rows.push_back(r);
+        block_cols.push_back(col);
+      }
+    }
+  }
+
+  std::size_t nnz = 0;
+  for (const auto &block : blocks)
+    nnz += std::get<0>(block).size();
+  values.reserve(nnz);
+  rows.reserve(nnz);
+  cols.reserve(nnz);
+  for (auto &[block_values, block_rows, block_cols] : blocks) {
+    values.insert(values.end(), block_values.cbegin(), block_values.cend());
+    rows.insert(rows.end(), block_rows.cbegin(), block_rows.cend());
+    cols.insert(cols.end(), block_cols.cbegin(), block_cols.cend());
+  }
+  return std::make_tuple(std::move(values), std::move(rows), std::move(cols));
+}
+
+
 template <typename HandlerTy>
 PROPERTY_SPECIFIC_TEMPLATE_DEFINITION(HandlerTy,
                                       product_op<T>::supports_inplace_mult)
@@ -1914,6 +2588,8 @@ std::vector<double> sum_op<HandlerTy>::get_data_representation() const {
 
 template std::size_t sum_op<spin_handler>::num_qubits() const;
 template sum_op<spin_handler>::sum_op(const std::vector<double> &input_vec);
+template std::vector<sum_op<spin_handler>>
+sum_op<spin_handler>::group_commuting(grouping_strategy strategy) const;
 template product_op<spin_handler>
 sum_op<spin_handler>::from_word(const std::string &word);
 template sum_op<spin_handler> sum_op<spin_handler>::random(std::size_t nQubits,
@@ -1931,6 +2607,10 @@ template csr_spmatrix sum_op<boson_handler>::to_sparse_matrix(
     std::unordered_map<std::size_t, int64_t> dimensions,
     const std::unordered_map<std::string, std::complex<double>> &parameters,
     bool invert_order) const;
+template csr_spmatrix sum_op<matrix_handler>::to_sparse_matrix(
+    std::unordered_map<std::size_t, int64_t> dimensions,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool invert_order) const;
 template mdiag_sparse_matrix sum_op<spin_handler>::to_diagonal_matrix(
     std::unordered_map<std::size_t, std::int64_t> dimensions,
     const std::unordered_map<std::string, std::complex<double>> &parameters,
@@ -7,6 +7,177 @@
  ******************************************************************************/
 
 #include "cudaq/operators.h"
+#include "helpers.h"
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+/// A square sparse matrix stored by rows.
+struct sparse_rows {
+  std::vector<std::size_t> row_starts;
+  std::vector<std::size_t> columns;
+  std::vector<std::complex<double>> values;
+
+  /// Stores the given matrix, or its transpose, optionally conjugated.
+  sparse_rows(const cudaq::csr_spmatrix &matrix, std::size_t dim,
+              bool transpose = false, bool conjugate = false) {
+    const auto &[entries, rows, cols] = matrix;
+    const auto &outer = transpose ? cols : rows;
+    const auto &inner = transpose ? rows : cols;
+    row_starts.assign(dim + 1, 0);
+    for (auto row : outer)
+      ++row_starts[row + 1];
+    for (std::size_t row = 0; row < dim; ++row)
+      row_starts[row + 1] += row_starts[row];
+    columns.resize(entries.size());
+    values.resize(entries.size());
+    auto next = row_starts;
+    for (std::size_t k = 0; k < entries.size(); ++k) {
+      auto pos = next[outer[k]]++;
+      columns[pos] = inner[k];
+      values[pos] = conjugate ? std::conj(entries[k]) : entries[k];
+    }
+  }
+};
+
+/// A term `coefficient * left (x) right` of a super-operator acting on the
+/// density matrix vectorized row by row; a missing factor is the identity.
+struct liouvillian_term {
+  std::complex<double> coefficient;
+  const sparse_rows *left;
+  const sparse_rows *right;
+};
+
+/// Calls `process_entry` for each entry of the given row of the matrix, or of
+/// the identity if there is no matrix.
+template <typename Callable>
+void for_each_entry(const sparse_rows *matrix, std::size_t row,
+                    Callable &&process_entry) {
+  if (!matrix) {
+    process_entry(row, std::complex<double>(1.));
+    return;
+  }
+  for (auto k = matrix->row_starts[row]; k < matrix->row_starts[row + 1]; ++k)
+    process_entry(matrix->columns[k], matrix->values[k]);
+}
+
+/// Adds the degrees of the operator to `degrees`.
+template <typename OpTy>
+void insert_degrees(std::set<std::size_t> &degrees, const OpTy &op) {
+  auto op_degrees = op.degrees();
+  degrees.insert(op_degrees.cbegin(), op_degrees.cend());
+}
+
+/// Returns the dimension of the space spanned by the given degrees.
+std::size_t total_dimension(
+    const std::set<std::size_t> &degrees,
+    const std::unordered_map<std::size_t, std::int64_t> &dimensions) {
+  std::size_t dim = 1;
+  for (auto degree : degrees) {
+    auto it = dimensions.find(degree);
+    if (it == dimensions.end())
+      throw std::runtime_error("missing dimension for degree " +
+                               std::to_string(degree));
+    dim *= it->second;
+  }
+  return dim;
+}
+
+/// Returns the sparse matrix of the operator on all the given degrees, such
+/// that the matrices of all operators on the same degrees are consistent.
+cudaq::csr_spmatrix embedded_sparse_matrix(
+    const cudaq::sum_op<cudaq::matrix_handler> &op,
+    const std::set<std::size_t> &degrees,
+    const std::unordered_map<std::size_t, std::int64_t> &dimensions,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool invert_order) {
+  auto identity = cudaq::sum_op<cudaq::matrix_handler>::identity();
+  for (auto degree : degrees)
+    identity *= cudaq::sum_op<cudaq::matrix_handler>::identity(degree);
+  return (op * identity).to_sparse_matrix(dimensions, parameters, invert_order);
+}
+
+/// Returns `A^dag A` for the matrix `A`.
+cudaq::csr_spmatrix adjoint_product(const sparse_rows &matrix,
+                                    std::size_t dim) {
+  std::vector<cudaq::detail::sparse_row> rows(dim);
+  for (std::size_t row = 0; row < dim; ++row)
+    for_each_entry(&matrix, row, [&](std::size_t k, std::complex<double> a) {
+      for_each_entry(&matrix, row, [&](std::size_t l, std::complex<double> b) {
+        rows[k].emplace_back(l, std::conj(a) * b);
+      });
+    });
+  cudaq::csr_spmatrix product;
+  auto &[values, row_indices, col_indices] = product;
+  for (std::size_t row = 0; row < dim; ++row) {
+    cudaq::detail::combine_entries(rows[row]);
+    for (const auto &[col, value] : rows[row]) {
+      values.push_back(value);
+      row_indices.push_back(row);
+      col_indices.push_back(col);
+    }
+  }
+  return product;
+}
+
+/// Assembles the sparse matrix of the sum of the given terms, acting on the
+/// vectorized density matrix of dimension `dim`. The entry of row `i * dim + j`
+/// and column `k * dim + l` of a term is `left(i, k) * right(j, l)`.
+cudaq::csr_spmatrix assemble(const std::vector<liouvillian_term> &terms,
+                             std::size_t dim) {
+  // Each row is assembled from all terms independently of all other rows,
+  // such that rows can be assembled concurrently without affecting the result.
+  const auto vec_dim = dim * dim;
+  constexpr std::size_t rows_per_block = 1024;
+  const auto num_blocks = (vec_dim + rows_per_block - 1) / rows_per_block;
+  std::vector<cudaq::csr_spmatrix> blocks(num_blocks);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if (num_blocks > 1)
+#endif
+  for (std::size_t b = 0; b < num_blocks; ++b) {
+    auto &[block_values, block_rows, block_cols] = blocks[b];
+    cudaq::detail::sparse_row row;
+    for (auto r = b * rows_per_block;
+         r < std::min(vec_dim, (b + 1) * rows_per_block); ++r) {
+      row.clear();
+      for (const auto &term : terms)
+        for_each_entry(
+            term.left, r / dim, [&](std::size_t k, std::complex<double> a) {
+              for_each_entry(term.right, r % dim,
+                             [&](std::size_t l, std::complex<double> b) {
+                               row.emplace_back(k * dim + l,
+                                                term.coefficient * a * b);
+                             });
+            });
+      cudaq::detail::combine_entries(row);
+      for (const auto &[col, value] : row) {
+        if (value == std::complex<double>(0.))
+          continue;
+        block_values.push_back(value);
+        block_rows.push_back(r);
+        block_cols.push_back(col);
+      }
+    }
+  }
+
+  std::vector<std::complex<double>> values;
+  std::vector<std::size_t> rows, cols;
+  std::size_t nnz = 0;
+  for (const auto &block : blocks)
+    nnz += std::get<0>(block).size();
+  values.reserve(nnz);
+  rows.reserve(nnz);
+  cols.reserve(nnz);
+  for (auto &[block_values, block_rows, block_cols] : blocks) {
+    values.insert(values.end(), block_values.cbegin(), block_values.cend());
+    rows.insert(rows.end(), block_rows.cbegin(), block_rows.cend());
+    cols.insert(cols.end(), block_cols.cbegin(), block_cols.cend());
+  }
+  return std::make_tuple(std::move(values), std::move(rows), std::move(cols));
+}
+
+} // namespace
 
 namespace cudaq {
 super_op &super_op::operator+=(const super_op &superOp) {
@@ -72,6 +243,79 @@ super_op::const_iterator super_op::begin() const { return m_terms.cbegin(); }
 
 super_op::const_iterator super_op::end() const { return m_terms.cend(); }
 
+csr_spmatrix super_op::to_sparse_matrix(
+    std::unordered_map<std::size_t, std::int64_t> dimensions,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool invert_order) const {
+  std::set<std::size_t> degrees;
+  for (const auto &[left, right] : m_terms) {
+    if (left.has_value())
+      insert_degrees(degrees, *left);
+    if (right.has_value())
+      insert_degrees(degrees, *right);
+  }
+  const auto dim = total_dimension(degrees, dimensions);
+  auto matrix = [&](const product_op<matrix_handler> &op) {
+    return embedded_sparse_matrix(op, degrees, dimensions, parameters,
+                                  invert_order);
+  };
+
+  // `rho * B` is `I (x) B^T` on the vectorized density matrix
+  std::vector<sparse_rows> matrices;
+  matrices.reserve(2 * m_terms.size());
+  std::vector<liouvillian_term> terms;
+  terms.reserve(m_terms.size());
+  for (const auto &[left, right] : m_terms) {
+    liouvillian_term term{1., nullptr, nullptr};
+    if (left.has_value())
+      term.left = &matrices.emplace_back(matrix(*left), dim);
+    if (right.has_value())
+      term.right = &matrices.emplace_back(matrix(*right), dim,
+                                          /*transpose=*/true);
+    terms.push_back(term);
+  }
+  return assemble(terms, dim);
+}
+
+csr_spmatrix super_op::lindblad_sparse_matrix(
+    const sum_op<matrix_handler> &hamiltonian,
+    const std::vector<sum_op<matrix_handler>> &collapse_operators,
+    std::unordered_map<std::size_t, std::int64_t> dimensions,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool invert_order) {
+  std::set<std::size_t> degrees;
+  insert_degrees(degrees, hamiltonian);
+  for (const auto &op : collapse_operators)
+    insert_degrees(degrees, op);
+  const auto dim = total_dimension(degrees, dimensions);
+  auto matrix = [&](const sum_op<matrix_handler> &op) {
+    return embedded_sparse_matrix(op, degrees, dimensions, parameters,
+                                  invert_order);
+  };
+
+  std::vector<sparse_rows> matrices;
+  matrices.reserve(2 + 4 * collapse_operators.size());
+  std::vector<liouvillian_term> terms;
+  terms.reserve(2 + 3 * collapse_operators.size());
+  const std::complex<double> i(0., 1.);
+  // -i[H, rho] = -i H rho + i rho H
+  auto h = matrix(hamiltonian);
+  terms.push_back({-i, &matrices.emplace_back(h, dim), nullptr});
+  terms.push_back({i, nullptr, &matrices.emplace_back(h, dim, true)});
+  for (const auto &op : collapse_operators) {
+    // L rho L^dag - 1/2 L^dag L rho - 1/2 rho L^dag L, where `(L^dag)^T` is
+    // the conjugate of `L`
+    auto l = matrix(op);
+    const auto &l_rows = matrices.emplace_back(l, dim);
+    terms.push_back({1., &l_rows, &matrices.emplace_back(l, dim, false, true)});
+    auto l_dag_l = adjoint_product(l_rows, dim);
+    terms.push_back({-0.5, &matrices.emplace_back(l_dag_l, dim), nullptr});
+    terms.push_back(
+        {-0.5, nullptr, &matrices.emplace_back(l_dag_l, dim, true)});
+  }
+  return assemble(terms, dim);
+}
+
 super_op::super_op(term &&term) : m_terms({std::move(term)}) {}
 
 super_op::super_op(std::vector<term> &&terms) : m_terms(std::move(terms)) {}
@@ -8,5 +8,6 @@
 
 #pragma once
 
+#include "algorithms/optimizers/cmaes.h"
 #include "algorithms/optimizers/ensmallen/ensmallen.h"
 #include "algorithms/optimizers/nlopt/nlopt.h"
@@ -9,12 +9,17 @@
 #pragma once
 
 #include "common/SampleResult.h"
-#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <future>
-#include <queue>
+#include <memory>
+#include <new>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <utility>
 
 namespace cudaq {
 
@@ -22,40 +27,178 @@ namespace cudaq {
 /// to the execution queue. It is meant to wrap any
 /// Sampling or Observe task with an appropriate std::promise
 /// instance being provided and set.
-using QuantumTask = std::function<void()>;
+///
+/// A QuantumTask is a move-only callable. Unlike `std::function`, it accepts
+/// move-only functors, e.g., lambdas capturing a `std::promise`, without
+/// copy-wrapping them, and stores functors of up to `inlineSize` bytes inline
+/// rather than on the heap.
+class QuantumTask {
+public:
+  static constexpr std::size_t inlineSize = 96;
+
+  QuantumTask() = default;
+
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, QuantumTask> &&
+                std::is_invocable_r_v<void, std::decay_t<F> &>>>
+  QuantumTask(F &&f) {
+    using Functor = std::decay_t<F>;
+    if constexpr (fitsInline<Functor>) {
+      ::new (static_cast<void *>(buffer)) Functor(std::forward<F>(f));
+      ops = &inlineOps<Functor>;
+    } else {
+      ::new (static_cast<void *>(buffer)) Functor *(
+          new Functor(std::forward<F>(f)));
+      ops = &heapOps<Functor>;
+    }
+  }
+
+  QuantumTask(QuantumTask &&other) noexcept { moveFrom(other); }
+
+  QuantumTask &operator=(QuantumTask &&other) noexcept {
+    if (this != &other) {
+      reset();
+      moveFrom(other);
+    }
+    return *this;
+  }
+
+  QuantumTask(const QuantumTask &) = delete;
+  QuantumTask &operator=(const QuantumTask &) = delete;
+
+  ~QuantumTask() { reset(); }
+
+  /// Return true if this task holds a functor.
+  explicit operator bool() const { return ops != nullptr; }
+
+  /// Invoke the functor.
+  void operator()() {
+    if (!ops)
+      throw std::bad_function_call();
+    ops->invoke(buffer);
+  }
+
+private:
+  struct Operations {
+    void (*invoke)(void *);
+    /// Move-construct the functor at `dst` from `src`, and destroy `src`.
+    void (*relocate)(void *dst, void *src);
+    void (*destroy)(void *);
+  };
+
+  template <typename Functor>
+  static constexpr bool fitsInline =
+      sizeof(Functor) <= inlineSize &&
+      alignof(Functor) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<Functor>;
+
+  template <typename Functor>
+  static constexpr Operations inlineOps = {
+      [](void *f) { (*static_cast<Functor *>(f))(); },
+      [](void *dst, void *src) {
+        ::new (dst) Functor(std::move(*static_cast<Functor *>(src)));
+        static_cast<Functor *>(src)->~Functor();
+      },
+      [](void *f) { static_cast<Functor *>(f)->~Functor(); }};
+
+  template <typename Functor>
+  static constexpr Operations heapOps = {
+      [](void *f) { (**static_cast<Functor **>(f))(); },
+      [](void *dst, void *src) {
+        ::new (dst) Functor *(*static_cast<Functor **>(src));
+      },
+      [](void *f) { delete *static_cast<Functor **>(f); }};
+
+  void moveFrom(QuantumTask &other) {
+    ops = std::exchange(other.ops, nullptr);
+    if (ops)
+      ops->relocate(buffer, other.buffer);
+  }
+
+  void reset() {
+    if (ops)
+      std::exchange(ops, nullptr)->destroy(buffer);
+  }
+
+  alignas(std::max_align_t) unsigned char buffer[inlineSize];
+  const Operations *ops = nullptr;
+};
 
 /// The QuantumExecutionQueue provides a queue running on a
 /// separate thread from the main CUDA-Q host thread that clients
 /// can submit execution tasks to, and these tasks will be executed
 /// (asynchronously from the calling thread) in the order they are submitted.
+///
+/// The queue is a bounded, lock-free ring buffer with many producers and a
+/// single consumer, the execution thread. Producers claim slots with a
+/// compare-and-swap on the enqueue position, and each slot carries a sequence
+/// number that tells whether it is free or holds a task. When the ring is
+/// full, producers wait for the execution thread to free a slot
+/// (backpressure). Both sides block on C++20 atomic waits rather than on a
+/// mutex.
 class QuantumExecutionQueue {
 public:
+  /// The default number of tasks the queue holds, a power of two.
+  static constexpr std::size_t defaultCapacity = 1024;
+
   /// The Constructor
-  QuantumExecutionQueue();
+  explicit QuantumExecutionQueue(std::size_t capacity = defaultCapacity);
   /// The Destructor
   ~QuantumExecutionQueue();
 
-  /// Enqueue a Sampling task.
+  /// Enqueue a task, moving it into the queue. Blocks while the queue is
+  /// full.
   void enqueue(QuantumTask &task);
 
   /// Get id of the thread this queue executes on.
   std::thread::id getExecutionThreadId() const;
 
+  /// Return the number of tasks enqueued that have not completed yet,
+  /// including the task currently running.
+  std::size_t getNumPendingTasks() const;
+
 protected:
-  /// The mutex, used for locking when adding to the queue
-  std::mutex lock;
+  /// A slot of the ring buffer. A slot at ring index `i` is free for the
+  /// task at position `p = i (mod capacity)` when its sequence is `p`, and
+  /// holds that task when its sequence is `p + 1`.
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    QuantumTask task;
+  };
 
-  /// The thread this queue executes on
-  std::thread thread;
+  /// Try to move the task into the next free slot, return false if the
+  /// queue is full.
+  bool tryPush(QuantumTask &task);
+
+  /// Try to move the oldest task out of the queue, return false if empty.
+  bool tryPop(QuantumTask &task);
 
-  /// The execution queue
-  std::queue<QuantumTask> queue;
+  /// The ring buffer
+  std::unique_ptr<Slot[]> slots;
+  std::size_t mask;
 
-  /// The condition variable used for notifying listeners
-  std::condition_variable cv;
+  /// The next position to enqueue at, shared by all producers.
+  alignas(64) std::atomic<std::size_t> enqueuePosition = 0;
+
+  /// The next position to dequeue from, owned by the execution thread.
+  alignas(64) std::size_t dequeuePosition = 0;
+
+  /// Bumped on every enqueue, the execution thread waits on it when the
+  /// queue is empty.
+  alignas(64) std::atomic<std::uint32_t> enqueued = 0;
+
+  /// Bumped on every dequeue, producers wait on it when the queue is full.
+  alignas(64) std::atomic<std::uint32_t> dequeued = 0;
+
+  /// The number of tasks the execution thread has completed.
+  alignas(64) std::atomic<std::size_t> completed = 0;
 
   /// Should we quit this thread?
-  bool quit = false;
+  std::atomic<bool> quit = false;
+
+  /// The thread this queue executes on
+  std::thread thread;
 
   /// Main execution thread, loops until destruction,
   /// continuously pops tasks off the queue and executes them
@@ -7,54 +7,108 @@
  ******************************************************************************/
 
 #include "cudaq/platform/QuantumExecutionQueue.h"
+#include <stdexcept>
 
 namespace cudaq {
 
-QuantumExecutionQueue::QuantumExecutionQueue() : lock() {
+QuantumExecutionQueue::QuantumExecutionQueue(std::size_t capacity) {
+  if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+    throw std::invalid_argument(
+        "QuantumExecutionQueue capacity must be a power of two, got " +
+        std::to_string(capacity) + ".");
+  slots = std::make_unique<Slot[]>(capacity);
+  mask = capacity - 1;
+  for (std::size_t i = 0; i < capacity; ++i)
+    slots[i].sequence.store(i, std::memory_order_relaxed);
   thread = std::thread(&QuantumExecutionQueue::handler, this);
 }
 
 QuantumExecutionQueue::~QuantumExecutionQueue() {
-  std::unique_lock<std::mutex> l(lock);
-  quit = true;
-  cv.notify_all();
-  l.unlock();
+  quit.store(true, std::memory_order_release);
+  enqueued.fetch_add(1, std::memory_order_release);
+  enqueued.notify_one();
   if (thread.joinable()) {
     thread.join();
   }
 }
 
+bool QuantumExecutionQueue::tryPush(QuantumTask &task) {
+  auto position = enqueuePosition.load(std::memory_order_relaxed);
+  for (;;) {
+    auto &slot = slots[position & mask];
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::intptr_t>(sequence) -
+                      static_cast<std::intptr_t>(position);
+    if (diff == 0) {
+      // The slot is free, claim it.
+      if (enqueuePosition.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+        slot.task = std::move(task);
+        slot.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // The slot still holds the task from one lap earlier, i.e., full.
+      return false;
+    } else {
+      // Another producer claimed this position first.
+      position = enqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool QuantumExecutionQueue::tryPop(QuantumTask &task) {
+  auto &slot = slots[dequeuePosition & mask];
+  if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+    return false;
+  task = std::move(slot.task);
+  slot.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+  ++dequeuePosition;
+  dequeued.fetch_add(1, std::memory_order_release);
+  dequeued.notify_all();
+  return true;
+}
+
 void QuantumExecutionQueue::enqueue(QuantumTask &t) {
-  std::unique_lock<std::mutex> l(lock);
-  queue.push(t);
-  cv.notify_one();
-  return;
+  for (;;) {
+    const auto observed = dequeued.load(std::memory_order_acquire);
+    if (tryPush(t))
+      break;
+    // A task running on the execution thread cannot wait for that thread to
+    // free a slot, run the new task right away instead.
+    if (std::this_thread::get_id() == thread.get_id()) {
+      t();
+      return;
+    }
+    dequeued.wait(observed, std::memory_order_acquire);
+  }
+  enqueued.fetch_add(1, std::memory_order_release);
+  enqueued.notify_one();
 }
 
 std::thread::id QuantumExecutionQueue::getExecutionThreadId() const {
   return thread.get_id();
 }
 
-void QuantumExecutionQueue::handler(void) {
-  std::unique_lock<std::mutex> l(lock);
+std::size_t QuantumExecutionQueue::getNumPendingTasks() const {
+  const auto done = completed.load(std::memory_order_acquire);
+  const auto claimed = enqueuePosition.load(std::memory_order_acquire);
+  return claimed > done ? claimed - done : 0;
+}
 
-  do {
+void QuantumExecutionQueue::handler(void) {
+  QuantumTask op;
+  while (!quit.load(std::memory_order_acquire)) {
     // Wait until we have data or a quit signal
-    cv.wait(l, [this] { return (queue.size() || quit); });
-
-    // after wait, we own the lock
-    if (!quit && queue.size()) {
-
-      auto op = std::move(queue.front());
-      queue.pop();
-
-      // unlock now that we're done messing with the queue
-      l.unlock();
-
-      op();
-      l.lock();
+    const auto observed = enqueued.load(std::memory_order_acquire);
+    if (!tryPop(op)) {
+      enqueued.wait(observed, std::memory_order_acquire);
+      continue;
     }
-  } while (!quit);
+    op();
+    op = QuantumTask();
+    completed.fetch_add(1, std::memory_order_release);
+  }
 }
 
 } // namespace cudaq
@@ -8,6 +8,7 @@
 
 #include "common/ExecutionContext.h"
 #include "common/Logger.h"
+#include "common/Profiler.h"
 #include "common/RuntimeTarget.h"
 #include "common/Timing.h"
 #include "cudaq/Support/TargetConfigYaml.h"
@@ -40,6 +41,7 @@ public:
                void *args, std::uint64_t argsSize, std::uint64_t resultOffset,
                const std::vector<void *> &rawArgs) override {
     ScopedTraceWithContext(cudaq::TIMING_LAUNCH, "QPU::launchKernel");
+    cudaq::profiler::ScopedPhase phase(cudaq::profiler::Phase::launch, name);
     return kernelFunc(args, /*isRemote=*/false);
   }
 
@@ -47,23 +49,29 @@ public:
   void setExecutionContext(cudaq::ExecutionContext *context) override {
     ScopedTraceWithContext("DefaultPlatform::setExecutionContext",
                            context->name);
-    executionContext = context;
+    threadContext = context;
     if (noiseModel)
-      executionContext->noiseModel = noiseModel;
+      threadContext->noiseModel = noiseModel;
 
-    cudaq::getExecutionManager()->setExecutionContext(executionContext);
+    cudaq::getExecutionManager()->setExecutionContext(threadContext);
   }
 
   /// Overrides resetExecutionContext to forward to
   /// the ExecutionManager. Also handles observe post-processing
   void resetExecutionContext() override {
     ScopedTraceWithContext(
-        executionContext->name == "observe" ? cudaq::TIMING_OBSERVE : 0,
-        "DefaultPlatform::resetExecutionContext", executionContext->name);
-    handleObservation(executionContext);
+        threadContext->name == "observe" ? cudaq::TIMING_OBSERVE : 0,
+        "DefaultPlatform::resetExecutionContext", threadContext->name);
+    handleObservation(threadContext);
     cudaq::getExecutionManager()->resetExecutionContext();
-    executionContext = nullptr;
+    threadContext = nullptr;
   }
+
+private:
+  /// The execution context of the calling thread. Kernels may run on this QPU
+  /// from several threads at once, e.g., the shards of a local `run`, each
+  /// with its own execution manager and simulator.
+  static inline thread_local cudaq::ExecutionContext *threadContext = nullptr;
 };
 
 /// The DefaultQuantumPlatform is a quantum_platform that provides a single
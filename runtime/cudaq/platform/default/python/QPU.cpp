@@ -9,6 +9,7 @@
 #include "QPU.h"
 #include "common/ArgumentConversion.h"
 #include "common/Environment.h"
+#include "common/Profiler.h"
 #include "common/RuntimeMLIR.h"
 #include "cudaq/Optimizer/Builder/Intrinsics.h"
 #include "cudaq/Optimizer/Builder/Runtime.h"
@@ -21,6 +22,7 @@
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Target/LLVMIR/Export.h"
 #include "mlir/Transforms/Passes.h"
+#include "runtime/cudaq/platform/JITExecutionCache.h"
 
 using namespace mlir;
 
@@ -28,6 +30,8 @@ static void specializeKernel(const std::string &name, ModuleOp module,
                              const std::vector<void *> &rawArgs,
                              Type resultTy = {},
                              bool enablePythonCodegenDump = false) {
+  cudaq::profiler::ScopedPhase phase(
+      cudaq::profiler::Phase::argument_synthesis, name);
   PassManager pm(module.getContext());
   cudaq::opt::ArgumentConverter argCon(name, module);
   argCon.gen(name, module, rawArgs);
@@ -160,25 +164,49 @@ static void establishExecutionContext(ModuleOp module) {
   plat.set_exec_ctx(currentExecCtx);
 }
 
-static ExecutionEngine *alreadyBuiltJITCode() {
+static std::shared_ptr<ExecutionEngine> alreadyBuiltJITCode() {
   auto *currentExecCtx = cudaq::get_platform().get_exec_ctx();
-  if (!currentExecCtx || !currentExecCtx->allowJitEngineCaching)
+  if (!currentExecCtx || !currentExecCtx->allowJitEngineCaching ||
+      !currentExecCtx->jitEng)
     return {};
-  return reinterpret_cast<ExecutionEngine *>(currentExecCtx->jitEng);
+  return *reinterpret_cast<std::shared_ptr<ExecutionEngine> *>(
+      currentExecCtx->jitEng);
 }
 
 /// In a sample launch context, the (`JIT` compiled) execution engine may be
 /// cached so that it can be called many times in a loop without being
 /// recompiled. This exploits the fact that the arguments processed at the
 /// sample callsite are invariant by the definition of a `CUDA-Q` kernel.
-static bool cacheJITForPerformance(ExecutionEngine *jit) {
+static void
+cacheJITForPerformance(const std::shared_ptr<ExecutionEngine> &jit) {
   auto *currentExecCtx = cudaq::get_platform().get_exec_ctx();
-  if (currentExecCtx && currentExecCtx->allowJitEngineCaching) {
-    if (!currentExecCtx->jitEng)
-      currentExecCtx->jitEng = reinterpret_cast<void *>(jit);
-    return true;
+  if (currentExecCtx && currentExecCtx->allowJitEngineCaching &&
+      !currentExecCtx->jitEng)
+    currentExecCtx->jitEng = new std::shared_ptr<ExecutionEngine>(jit);
+}
+
+/// The estimated memory used by an engine on top of its code, e.g., by the
+/// LLVM JIT session and target machine.
+static constexpr std::size_t JIT_ENGINE_OVERHEAD_BYTES = 256 << 10;
+
+/// Return the engine for the specialized module, from the process-wide cache
+/// of engines or newly compiled. Modules are keyed by their text, which holds
+/// the synthesized arguments, and the size of the text estimates the memory
+/// used by the code of the engine.
+static std::shared_ptr<ExecutionEngine> getOrCreateJITEngine(ModuleOp module) {
+  std::string moduleText;
+  {
+    llvm::raw_string_ostream os(moduleText);
+    module.print(os);
   }
-  return false;
+  const auto hash = std::hash<std::string>{}(moduleText);
+  auto &jitCache = cudaq::getJITExecutionCache();
+  if (auto jit = jitCache.lookup(hash))
+    return jit;
+  std::shared_ptr<ExecutionEngine> jit(
+      cudaq::createQIRJITEngine(module, "qir:"));
+  jitCache.cache(hash, jit, JIT_ENGINE_OVERHEAD_BYTES + moduleText.size());
+  return jit;
 }
 
 namespace {
@@ -192,12 +220,13 @@ struct PythonLauncher : public cudaq::ModuleLauncher {
     // merging of modules mirrors the late binding and dynamic scoping of the
     // host language (Python).
     ScopedTraceWithContext(cudaq::TIMING_LAUNCH, "QPU::launchModule");
+    cudaq::profiler::ScopedPhase phase(cudaq::profiler::Phase::launch, name);
     const bool enablePythonCodegenDump =
         cudaq::getEnvBool("CUDAQ_PYTHON_CODEGEN_DUMP", false);
 
     std::string fullName = cudaq::runtime::cudaqGenPrefixName + name;
     cudaq::KernelThunkResultType result{nullptr, 0};
-    ExecutionEngine *jit = alreadyBuiltJITCode();
+    auto jit = alreadyBuiltJITCode();
     if (!jit) {
       // 1. Check that this call is sane.
       if (enablePythonCodegenDump)
@@ -226,7 +255,7 @@ struct PythonLauncher : public cudaq::ModuleLauncher {
                        enablePythonCodegenDump);
 
       // 4. Execute the code right here, right now.
-      jit = cudaq::createQIRJITEngine(module, "qir:");
+      jit = getOrCreateJITEngine(module);
     }
 
     if (resultTy) {
@@ -250,8 +279,7 @@ struct PythonLauncher : public cudaq::ModuleLauncher {
             "kernel disappeared underneath execution engine");
       reinterpret_cast<void (*)()>(*funcPtr)();
     }
-    if (!cacheJITForPerformance(jit))
-      delete jit;
+    cacheJITForPerformance(jit);
     // FIXME: actually handle results
     return result;
   }
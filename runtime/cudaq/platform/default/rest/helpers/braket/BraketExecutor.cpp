@@ -22,6 +22,11 @@
 #include <aws/s3-crt/model/PutPublicAccessBlockRequest.h>
 
 #include <aws/core/utils/ARN.h>
+#include <aws/core/utils/threading/Executor.h>
+
+#include <map>
+#include <mutex>
+#include <numeric>
 
 namespace {
 void tryCreateBucket(Aws::S3Crt::S3CrtClient &client, std::string const &region,
@@ -102,8 +107,58 @@ void tryCreateBucket(Aws::S3Crt::S3CrtClient &client, std::string const &region,
 } // namespace
 
 namespace cudaq {
+std::shared_ptr<BraketExecutor::ScopedApi>
+BraketExecutor::ScopedApi::acquire() {
+  static std::mutex mutex;
+  static std::weak_ptr<ScopedApi> instance;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto api = instance.lock();
+  if (!api) {
+    api = std::make_shared<ScopedApi>();
+    instance = api;
+  }
+  return api;
+}
+
+std::shared_ptr<BraketExecutor::Clients>
+BraketExecutor::Clients::acquire(const std::string &region,
+                                 std::size_t maxConcurrentRequests) {
+  static std::mutex mutex;
+  static std::map<std::pair<std::string, std::size_t>, std::weak_ptr<Clients>>
+      cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto &entry = cache[{region, maxConcurrentRequests}];
+  if (auto clients = entry.lock())
+    return clients;
+
+  auto clients = std::make_shared<Clients>();
+  clients->api = ScopedApi::acquire();
+
+  // Asynchronous requests of a client run on a bounded pool of threads.
+  Aws::Client::ClientConfiguration clientConfig;
+  clientConfig.verifySSL = false;
+  clientConfig.region = region;
+  clientConfig.maxConnections = maxConcurrentRequests;
+  clientConfig.executor =
+      std::make_shared<Aws::Utils::Threading::PooledThreadExecutor>(
+          maxConcurrentRequests);
+  // The CRT based S3 client downloads large objects as parts in parallel.
+  Aws::S3Crt::ClientConfiguration s3ClientConfig;
+  s3ClientConfig.verifySSL = false;
+  s3ClientConfig.region = region;
+  s3ClientConfig.executor =
+      std::make_shared<Aws::Utils::Threading::PooledThreadExecutor>(
+          maxConcurrentRequests);
+
+  clients->braket = std::make_unique<Aws::Braket::BraketClient>(clientConfig);
+  clients->sts = std::make_unique<Aws::STS::STSClient>(clientConfig);
+  clients->s3 = std::make_unique<Aws::S3Crt::S3CrtClient>(s3ClientConfig);
+  entry = clients;
+  return clients;
+}
+
 BraketExecutor::BraketExecutor()
-    : api(options), jobToken(std::getenv("AMZN_BRAKET_JOB_TOKEN")),
+    : api(ScopedApi::acquire()), jobToken(std::getenv("AMZN_BRAKET_JOB_TOKEN")),
       reservationArn(std::getenv("AMZN_BRAKET_RESERVATION_TIME_WINDOW_ARN")) {}
 
 /// @brief Set the server helper
@@ -124,29 +179,32 @@ void BraketExecutor::setServerHelper(ServerHelper *helper) {
     pollingInterval = std::chrono::milliseconds{pollingIntervalMs};
   }
 
-  Aws::Client::ClientConfiguration clientConfig;
-  clientConfig.verifySSL = false;
-  Aws::S3Crt::ClientConfiguration s3ClientConfig;
-  s3ClientConfig.verifySSL = false;
+  if (helper->getConfig().contains("max_concurrent_requests")) {
+    long maxRequests{
+        std::stol(helper->getConfig().at("max_concurrent_requests"))};
+    if (maxRequests <= 0) {
+      throw std::runtime_error(
+          "max_concurrent_requests must be a positive integer.");
+    }
+    maxConcurrentRequests = maxRequests;
+  }
+
+  const Aws::Client::ClientConfiguration defaultConfig;
   if (!region.empty()) {
-    if (region != clientConfig.region) {
+    if (region != defaultConfig.region)
       CUDAQ_INFO("Auto-routing to AWS region {}", region);
-      clientConfig.region = region;
-      s3ClientConfig.region = region;
-    }
   } else {
-    region = clientConfig.region;
+    region = defaultConfig.region;
   }
 
-  braketClientPtr = std::make_unique<Aws::Braket::BraketClient>(clientConfig);
-  stsClientPtr = std::make_unique<Aws::STS::STSClient>(clientConfig);
-  s3ClientPtr = std::make_unique<Aws::S3Crt::S3CrtClient>(s3ClientConfig);
+  clients = Clients::acquire(region, maxConcurrentRequests);
 
   defaultBucketFuture =
-      std::async(std::launch::async, [this, region, defaultBucket] {
+      std::async(std::launch::async, [clients = clients, region,
+                                      defaultBucket] {
         std::string bucketName = defaultBucket;
         if (bucketName.empty()) {
-          auto response = stsClientPtr->GetCallerIdentity();
+          auto response = clients->sts->GetCallerIdentity();
           if (response.IsSuccess()) {
             bucketName = fmt::format("amazon-braket-{}-{}", region,
                                      response.GetResult().GetAccount());
@@ -154,7 +212,7 @@ void BraketExecutor::setServerHelper(ServerHelper *helper) {
             throw std::runtime_error(response.GetError().GetMessage());
           }
         }
-        tryCreateBucket(*s3ClientPtr, region, bucketName);
+        tryCreateBucket(*clients->s3, region, bucketName);
         CUDAQ_INFO("Braket task results will use S3 bucket \"s3://{}\"",
                    bucketName);
         return bucketName;
@@ -219,72 +277,43 @@ BraketExecutor::execute(std::vector<KernelExecution> &codesToExecute,
     req.SetOutputS3Bucket(defaultBucket);
     req.SetOutputS3KeyPrefix(defaultPrefix);
 
-    createOutcomes.push_back(braketClientPtr->CreateQuantumTaskCallable(req));
+    createOutcomes.push_back(clients->braket->CreateQuantumTaskCallable(req));
   }
 
   return std::async(
       std::launch::async,
-      [this, codesToExecute, isObserve](
+      [this, clients = clients, codesToExecute, isObserve](
           std::vector<Aws::Braket::Model::CreateQuantumTaskOutcomeCallable>
               createOutcomes) {
-        std::vector<ExecutionResult> results;
+        const std::size_t numTasks = createOutcomes.size();
+        std::vector<std::string> taskArns;
         for (std::size_t i = 0; auto &outcome : createOutcomes) {
           auto createResponse = outcome.get();
           if (!createResponse.IsSuccess()) {
             throw std::runtime_error(createResponse.GetError().GetMessage());
           }
-          std::string taskArn = createResponse.GetResult().GetQuantumTaskArn();
+          auto &taskArn = taskArns.emplace_back(
+              createResponse.GetResult().GetQuantumTaskArn());
 
           CUDAQ_INFO("Created Braket quantum task {}", taskArn);
           setOutputNames(codesToExecute[i], taskArn);
+          i++;
+        }
 
-          Aws::Braket::Model::GetQuantumTaskRequest req;
-          req.SetQuantumTaskArn(taskArn);
-          auto getResponse = braketClientPtr->GetQuantumTask(req);
-          if (!getResponse.IsSuccess()) {
-            throw std::runtime_error(getResponse.GetError().GetMessage());
-          }
-          auto taskStatus = getResponse.GetResult().GetStatus();
-          while (
-              taskStatus != Aws::Braket::Model::QuantumTaskStatus::COMPLETED &&
-              taskStatus != Aws::Braket::Model::QuantumTaskStatus::FAILED &&
-              taskStatus != Aws::Braket::Model::QuantumTaskStatus::CANCELLED) {
-            std::this_thread::sleep_for(pollingInterval);
-
-            getResponse = braketClientPtr->GetQuantumTask(req);
-            if (!getResponse.IsSuccess()) {
-              throw std::runtime_error(getResponse.GetError().GetMessage());
-            }
-            taskStatus = getResponse.GetResult().GetStatus();
-          }
-
-          auto getResult = getResponse.GetResult();
-          if (taskStatus != Aws::Braket::Model::QuantumTaskStatus::COMPLETED) {
-            // Task terminated without results
-            throw std::runtime_error(
-                fmt::format("Braket task {} terminated without results. {}",
-                            taskArn, getResult.GetFailureReason()));
-          }
-
-          std::string outBucket = getResult.GetOutputS3Bucket();
-          std::string outPrefix = getResult.GetOutputS3Directory();
-
-          CUDAQ_INFO("Fetching braket quantum task {} results from "
-                     "s3://{}/{}/results.json",
-                     taskArn, outBucket, outPrefix);
-
-          Aws::S3Crt::Model::GetObjectRequest resultsJsonRequest;
-          resultsJsonRequest.SetBucket(outBucket);
-          resultsJsonRequest.SetKey(fmt::format("{}/results.json", outPrefix));
-          auto s3Response = s3ClientPtr->GetObject(resultsJsonRequest);
+        // The results of each task, in the order of the tasks.
+        std::vector<std::vector<ExecutionResult>> taskResults(numTasks);
+        auto collectResults = [&](std::size_t i,
+                                  Aws::S3Crt::Model::GetObjectOutcome
+                                      s3Response) {
           if (!s3Response.IsSuccess()) {
             throw std::runtime_error(s3Response.GetError().GetMessage());
           }
           auto resultsJson = nlohmann::json::parse(
               s3Response.GetResultWithOwnership().GetBody());
 
-          auto c = serverHelper->processResults(resultsJson, taskArn);
+          auto c = serverHelper->processResults(resultsJson, taskArns[i]);
 
+          auto &results = taskResults[i];
           if (isObserve) {
             // Use the job name instead of the global register.
             results.emplace_back(c.to_map(), codesToExecute[i].name);
@@ -296,9 +325,85 @@ BraketExecutor::execute(std::vector<KernelExecution> &codesToExecute,
               results.back().sequentialData = c.sequential_data(regName);
             }
           }
-          i++;
+        };
+
+        // Poll all the pending tasks at once, and start downloading the
+        // results of each task as soon as it completes. The downloads proceed
+        // concurrently while the other tasks are still being polled.
+        std::vector<std::size_t> polling(numTasks);
+        std::iota(polling.begin(), polling.end(), 0);
+        std::vector<
+            std::pair<std::size_t, Aws::S3Crt::Model::GetObjectOutcomeCallable>>
+            downloads;
+        while (!polling.empty() || !downloads.empty()) {
+          std::vector<Aws::Braket::Model::GetQuantumTaskOutcomeCallable>
+              getOutcomes;
+          for (auto i : polling) {
+            Aws::Braket::Model::GetQuantumTaskRequest req;
+            req.SetQuantumTaskArn(taskArns[i]);
+            getOutcomes.push_back(
+                clients->braket->GetQuantumTaskCallable(req));
+          }
+
+          std::vector<std::size_t> stillPolling;
+          for (std::size_t k = 0; k < polling.size(); ++k) {
+            const auto i = polling[k];
+            auto getResponse = getOutcomes[k].get();
+            if (!getResponse.IsSuccess()) {
+              throw std::runtime_error(getResponse.GetError().GetMessage());
+            }
+            const auto &getResult = getResponse.GetResult();
+            auto taskStatus = getResult.GetStatus();
+            if (taskStatus ==
+                    Aws::Braket::Model::QuantumTaskStatus::FAILED ||
+                taskStatus ==
+                    Aws::Braket::Model::QuantumTaskStatus::CANCELLED) {
+              // Task terminated without results
+              throw std::runtime_error(
+                  fmt::format("Braket task {} terminated without results. {}",
+                              taskArns[i], getResult.GetFailureReason()));
+            }
+            if (taskStatus !=
+                Aws::Braket::Model::QuantumTaskStatus::COMPLETED) {
+              stillPolling.push_back(i);
+              continue;
+            }
+
+            std::string outBucket = getResult.GetOutputS3Bucket();
+            std::string outPrefix = getResult.GetOutputS3Directory();
+
+            CUDAQ_INFO("Fetching braket quantum task {} results from "
+                       "s3://{}/{}/results.json",
+                       taskArns[i], outBucket, outPrefix);
+
+            Aws::S3Crt::Model::GetObjectRequest resultsJsonRequest;
+            resultsJsonRequest.SetBucket(outBucket);
+            resultsJsonRequest.SetKey(
+                fmt::format("{}/results.json", outPrefix));
+            downloads.emplace_back(
+                i, clients->s3->GetObjectCallable(resultsJsonRequest));
+          }
+          polling = std::move(stillPolling);
+
+          // Process the results that arrived. Once no task is pending, wait
+          // for the remaining downloads.
+          std::erase_if(downloads, [&](auto &download) {
+            if (!polling.empty() &&
+                download.second.wait_for(std::chrono::seconds(0)) !=
+                    std::future_status::ready)
+              return false;
+            collectResults(download.first, download.second.get());
+            return true;
+          });
+
+          if (!polling.empty())
+            std::this_thread::sleep_for(pollingInterval);
         }
 
+        std::vector<ExecutionResult> results;
+        for (auto &taskResult : taskResults)
+          std::move(taskResult.begin(), taskResult.end(),
+                    std::back_inserter(results));
         return sample_result(results);
       },
       std::move(createOutcomes));
@@ -208,27 +208,32 @@ void IQMServerHelper::initialize(BackendConfig config) {
 ServerJobPayload
 IQMServerHelper::createJob(std::vector<KernelExecution> &circuitCodes) {
   std::vector<ServerMessage> messages;
+  messages.reserve(circuitCodes.size());
+
+  // Apply the mapping derived from the dynamic quantum architecture. It is
+  // the same for all the circuits.
+  ServerMessage qubitMapping = ServerMessage::array();
+  for (auto &[key, value] : qubitNameMap) {
+    nlohmann::json singleQubitMapping;
+    singleQubitMapping["logical_name"] = "QB" + std::to_string(value + 1);
+    singleQubitMapping["physical_name"] = key;
+    qubitMapping.push_back(std::move(singleQubitMapping));
+  }
 
   // cuda-quantum expects every circuit to be a separate job,
   // so we cannot use the batch mode
   for (auto &circuitCode : circuitCodes) {
     ServerMessage message = ServerMessage::object();
-    message["qubit_mapping"] = ServerMessage::array();
+    message["qubit_mapping"] = qubitMapping;
     message["circuits"] = ServerMessage::array();
     message["shots"] = shots;
 
-    // Apply the mapping derived from the dynamic quantum architecture.
-    for (auto &[key, value] : qubitNameMap) {
-      nlohmann::json singleQubitMapping;
-      singleQubitMapping["logical_name"] = "QB" + std::to_string(value + 1);
-      singleQubitMapping["physical_name"] = key;
-      message["qubit_mapping"].push_back(singleQubitMapping);
-    }
-
+    // The circuits are moved rather than copied into the messages, since
+    // they are as large as the programs.
     ServerMessage yac = nlohmann::json::parse(circuitCode.code);
     yac["name"] = circuitCode.name;
-    message["circuits"].push_back(yac);
-    messages.push_back(message);
+    message["circuits"].push_back(std::move(yac));
+    messages.push_back(std::move(message));
   }
 
   // Get the headers
@@ -331,6 +331,7 @@ ServerJobPayload
 QuantinuumServerHelper::createJob(std::vector<KernelExecution> &circuitCodes) {
   // Just a placeholder for the job post URL path, headers, and messages
   std::vector<ServerMessage> messages;
+  messages.reserve(circuitCodes.size());
 
   // Get the tokens we need
   credentialsPath =
@@ -383,6 +384,44 @@ QuantinuumServerHelper::createJob(std::vector<KernelExecution> &circuitCodes) {
                gpuDecoderConfigId);
   }
 
+  // The backend configuration is the same for all the jobs, so it is built
+  // once and copied into each of them.
+  ServerMessage backendConfig = ServerMessage::object();
+  backendConfig["type"] = "QuantinuumConfig";
+  backendConfig["device_name"] = machine;
+  // On Helios devices, we need to specify max-cost and max-qubits unless it's
+  // a syntax checker
+  if (machine.starts_with("Helios") && !machine.ends_with("SC")) {
+    std::vector<std::string> errors;
+    if (!maxCost.has_value())
+      errors.push_back("Please specify maximum HQC cost "
+                       "(`--quantinuum-max-cost <val>` when compiling with "
+                       "nvq++ or `max_cost=<val>` in Python `set_target`)");
+    if (!maxQubits.has_value())
+      errors.push_back(
+          "Please specify maximum number of qubits (`--quantinuum-max-qubits "
+          "<val>` when compiling with nvq++ or `max_qubits=<val>` in Python "
+          "`set_target`)");
+    if (!errors.empty())
+      throw std::runtime_error(
+          fmt::format("Missing required configuration for device '{}': {}",
+                      machine, fmt::join(errors, "; ")));
+  }
+
+  if (maxCost.has_value())
+    backendConfig["max_cost"] = maxCost.value();
+
+  if (maxQubits.has_value()) {
+    backendConfig["compiler_options"] = ServerMessage::object();
+    backendConfig["compiler_options"]["max-qubits"] = maxQubits.value();
+  }
+
+  if (noisySim.has_value() && machine.ends_with("E"))
+    backendConfig["noisy_simulation"] = noisySim.value() ? "true" : "false";
+
+  if (!simulator.empty())
+    backendConfig["simulator"] = simulator;
+
   // Construct the job, one per circuit
   for (auto &circuitCode : circuitCodes) {
     // First create a QIR module, and then use its ID in the job
@@ -418,56 +457,14 @@ QuantinuumServerHelper::createJob(std::vector<KernelExecution> &circuitCodes) {
         "execute_job_definition";
     j["data"]["attributes"]["definition"]["language"] = "QIR 1.0";
     // Add backend configuration
-    j["data"]["attributes"]["definition"]["backend_config"] =
-        ServerMessage::object();
-    j["data"]["attributes"]["definition"]["backend_config"]["type"] =
-        "QuantinuumConfig";
-    j["data"]["attributes"]["definition"]["backend_config"]["device_name"] =
-        machine;
-    // On Helios devices, we need to specify max-cost and max-qubits unless it's
-    // a syntax checker
-    if (machine.starts_with("Helios") && !machine.ends_with("SC")) {
-      std::vector<std::string> errors;
-      if (!maxCost.has_value())
-        errors.push_back("Please specify maximum HQC cost "
-                         "(`--quantinuum-max-cost <val>` when compiling with "
-                         "nvq++ or `max_cost=<val>` in Python `set_target`)");
-      if (!maxQubits.has_value())
-        errors.push_back(
-            "Please specify maximum number of qubits (`--quantinuum-max-qubits "
-            "<val>` when compiling with nvq++ or `max_qubits=<val>` in Python "
-            "`set_target`)");
-      if (!errors.empty())
-        throw std::runtime_error(
-            fmt::format("Missing required configuration for device '{}': {}",
-                        machine, fmt::join(errors, "; ")));
-    }
-
-    if (maxCost.has_value())
-      j["data"]["attributes"]["definition"]["backend_config"]["max_cost"] =
-          maxCost.value();
-
-    if (maxQubits.has_value()) {
-      j["data"]["attributes"]["definition"]["backend_config"]
-       ["compiler_options"] = ServerMessage::object();
-      j["data"]["attributes"]["definition"]["backend_config"]
-       ["compiler_options"]["max-qubits"] = maxQubits.value();
-    }
-
-    if (noisySim.has_value() && machine.ends_with("E"))
-      j["data"]["attributes"]["definition"]["backend_config"]
-       ["noisy_simulation"] = noisySim.value() ? "true" : "false";
-
-    if (!simulator.empty())
-      j["data"]["attributes"]["definition"]["backend_config"]["simulator"] =
-          simulator;
+    j["data"]["attributes"]["definition"]["backend_config"] = backendConfig;
 
     // Add program items
     j["data"]["attributes"]["definition"]["items"] = ServerMessage::array();
     ServerMessage item = ServerMessage::object();
     item["program_id"] = programId;
     item["n_shots"] = shots;
-    j["data"]["attributes"]["definition"]["items"].push_back(item);
+    j["data"]["attributes"]["definition"]["items"].push_back(std::move(item));
     // Add relationships section
     j["data"]["relationships"] = ServerMessage::object();
     j["data"]["relationships"]["project"] = ServerMessage::object();
@@ -479,11 +476,11 @@ QuantinuumServerHelper::createJob(std::vector<KernelExecution> &circuitCodes) {
       j["data"]["attributes"]["definition"]["gpu_decoder_config_id"] =
           gpuDecoderConfigId;
     }
-    messages.push_back(j);
+    messages.push_back(std::move(j));
   }
   CUDAQ_INFO("Created job payload targeting {}", machine);
   // Return the payload with the correct endpoint
-  return std::make_tuple(baseUrl + jobsEndpoint, headers, messages);
+  return std::make_tuple(baseUrl + jobsEndpoint, headers, std::move(messages));
 }
 
 std::string QuantinuumServerHelper::extractJobId(ServerMessage &postResponse) {
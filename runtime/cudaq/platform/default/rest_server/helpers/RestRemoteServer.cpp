@@ -24,6 +24,7 @@
 #include "nvqir/CircuitSimulator.h"
 #include "server_impl/RestServer.h"
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/Support/Base64.h"
@@ -31,6 +32,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/SHA256.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -48,9 +50,12 @@
 #include "mlir/Target/LLVMIR/Export.h"
 #include "mlir/Tools/mlir-translate/Translation.h"
 #include "mlir/Transforms/Passes.h"
+#include <bit>
+#include <condition_variable>
 #include <cxxabi.h>
 #include <filesystem>
 #include <fstream>
+#include <list>
 #include <streambuf>
 
 extern "C" {
@@ -63,8 +68,63 @@ using namespace mlir;
 struct SimulatorHandle {
   std::string name;
   void *libHandle;
+  nvqir::CircuitSimulator *simulator;
 };
 
+// In-memory cache of the execution engines of the MLIR kernels, keyed by a
+// hash of the IR and of the pass pipeline, so that repeated requests for the
+// same code skip the pass pipeline and the code generation. Engines are evicted
+// in least recently used order beyond `capacity` entries.
+class ExecutionEngineCache {
+public:
+  explicit ExecutionEngineCache(std::size_t capacity) : capacity(capacity) {}
+
+  static std::string key(std::string_view ir,
+                         const std::vector<std::string> &passes) {
+    llvm::SHA256 hasher;
+    hasher.update(ir);
+    for (const auto &pass : passes) {
+      hasher.update(llvm::StringRef("\0", 1));
+      hasher.update(pass);
+    }
+    return llvm::toHex(hasher.final());
+  }
+
+  ExecutionEngine *lookup(const std::string &key) {
+    auto iter = index.find(key);
+    if (iter == index.end())
+      return nullptr;
+    entries.splice(entries.begin(), entries, iter->second);
+    return iter->second->second.get();
+  }
+
+  ExecutionEngine *insert(const std::string &key,
+                          std::unique_ptr<ExecutionEngine> engine) {
+    entries.emplace_front(key, std::move(engine));
+    index[key] = entries.begin();
+    if (entries.size() > capacity) {
+      index.erase(entries.back().first);
+      entries.pop_back();
+    }
+    return entries.front().second.get();
+  }
+
+  std::size_t capacity;
+
+private:
+  // Most recently used first.
+  std::list<std::pair<std::string, std::unique_ptr<ExecutionEngine>>> entries;
+  std::unordered_map<std::string, decltype(entries)::iterator> index;
+};
+
+// Number of kernels whose execution engines are kept between requests, from
+// `CUDAQ_QPUD_JIT_CACHE_ENTRIES` (default 16, 0 disables the cache).
+std::size_t getExecutionEngineCacheCapacity() {
+  if (auto *env = std::getenv("CUDAQ_QPUD_JIT_CACHE_ENTRIES"))
+    return std::max(0, std::atoi(env));
+  return 16;
+}
+
 // Implementation of llvm::cantFail which throws a C++ exception rather than
 // emits a signal/asserts.
 template <typename T>
@@ -97,8 +157,15 @@ class RemoteRestRuntimeServer : public cudaq::RemoteRuntimeServer {
     std::vector<std::string> passes;
   };
   std::unordered_map<std::size_t, CodeTransformInfo> m_codeTransform;
-  // Currently-loaded NVQIR simulator.
-  SimulatorHandle m_simHandle;
+  // NVQIR simulators loaded so far, which stay loaded (warm) so that requests
+  // alternating between backends do not reload and re-initialize them.
+  std::unordered_map<std::string, SimulatorHandle> m_simHandles;
+  // Name of the simulator of the last request.
+  std::string m_activeSimulator;
+  // Execution engines of recently requested MLIR kernels.
+  ExecutionEngineCache m_engineCache{getExecutionEngineCacheCapacity()};
+  // Execution engine of the last request if the cache is disabled.
+  std::unique_ptr<ExecutionEngine> m_uncachedEngine;
   // Default backend for initialization.
   // Note: we always need to preload a default backend on the server runtime
   // since cudaq runtime relies on that.
@@ -128,9 +195,9 @@ protected:
 
 public:
   RemoteRestRuntimeServer()
-      : cudaq::RemoteRuntimeServer(),
-        m_simHandle(DEFAULT_NVQIR_SIMULATION_BACKEND,
-                    loadNvqirSimLib(DEFAULT_NVQIR_SIMULATION_BACKEND)) {}
+      : cudaq::RemoteRuntimeServer() {
+    activateSimulator(DEFAULT_NVQIR_SIMULATION_BACKEND);
+  }
 
   virtual std::pair<int, int> version() const override {
     return std::make_pair(cudaq::RestRequest::REST_PAYLOAD_VERSION,
@@ -174,7 +241,14 @@ public:
 
           if (m_hasMpi)
             cudaq::mpi::broadcast(mutableReq, 0);
-          auto resultJs = processRequest(mutableReq);
+          // Raw state buffers are sent in the byte order of the server, which
+          // the binary wire format fixes to little-endian.
+          const bool binaryPayload =
+              std::endian::native == std::endian::little &&
+              cudaq::RestServer::acceptsMediaType(
+                  headers, cudaq::BinaryPayloadMediaType);
+          auto resultJs =
+              processRequest(mutableReq, /*forceLog=*/false, binaryPayload);
 
           return resultJs;
         });
@@ -219,14 +293,7 @@ public:
     // sampling is disabled. This is standard VQE/observe behavior.
     std::int64_t shots = *reinterpret_cast<std::int64_t *>(&io_context.shots);
 
-    // If we're changing the backend, load the new simulator library from file.
-    if (m_simHandle.name != backendSimName) {
-      if (m_simHandle.libHandle)
-        dlclose(m_simHandle.libHandle);
-
-      m_simHandle =
-          SimulatorHandle(backendSimName, loadNvqirSimLib(backendSimName));
-    }
+    activateSimulator(backendSimName);
 
     if (seed != 0)
       cudaq::set_random_seed(seed);
@@ -243,7 +310,7 @@ public:
       auto module = parseSourceFile<ModuleOp>(sourceMgr, m_mlirContext.get());
       if (!module)
         throw std::runtime_error("Failed to parse the input MLIR code");
-      auto engine = jitMlirCode(*module, requestInfo.passes);
+      auto *engine = getOrJitMlirCode(ir, *module, requestInfo.passes);
       const std::string entryPointFunc =
           std::string(cudaq::runtime::cudaqGenPrefixName) +
           std::string(kernelName);
@@ -272,6 +339,7 @@ public:
       bool requiresGrad = optimizer.requiresGradients();
       auto theSpin = *io_context.spin;
       assert(cudaq::spin_op::canonicalize(theSpin) == theSpin);
+      std::size_t iteration = 0;
 
       result = optimizer.optimize(n_params, [&](const std::vector<double> &x,
                                                 std::vector<double> &grad_vec) {
@@ -279,6 +347,7 @@ public:
                               : cudaq::observe(shots, fnWrapper, theSpin, x);
         if (requiresGrad)
           gradient->compute(x, grad_vec, theSpin, e);
+        CUDAQ_INFO("VQE iteration {}: <H> = {}", ++iteration, e);
         return e;
       });
     }
@@ -293,14 +362,7 @@ public:
                              void *kernelArgs, std::uint64_t argsSize,
                              std::size_t seed) override {
 
-    // If we're changing the backend, load the new simulator library from file.
-    if (m_simHandle.name != backendSimName) {
-      if (m_simHandle.libHandle)
-        dlclose(m_simHandle.libHandle);
-
-      m_simHandle =
-          SimulatorHandle(backendSimName, loadNvqirSimLib(backendSimName));
-    }
+    activateSimulator(backendSimName);
     if (seed != 0)
       cudaq::set_random_seed(seed);
     auto &platform = cudaq::get_platform();
@@ -487,6 +549,22 @@ protected:
     return uniqueJit;
   }
 
+  // Return the execution engine of `module`, parsed from `ir`, compiling it
+  // unless a previous request already did.
+  ExecutionEngine *getOrJitMlirCode(std::string_view ir, ModuleOp module,
+                                    const std::vector<std::string> &passes) {
+    if (m_engineCache.capacity == 0) {
+      m_uncachedEngine = jitMlirCode(module, passes);
+      return m_uncachedEngine.get();
+    }
+    const auto key = ExecutionEngineCache::key(ir, passes);
+    if (auto *engine = m_engineCache.lookup(key)) {
+      CUDAQ_INFO("Reusing the execution engine of a previous request.");
+      return engine;
+    }
+    return m_engineCache.insert(key, jitMlirCode(module, passes));
+  }
+
   void
   invokeMlirKernel(cudaq::ExecutionContext &io_context,
                    std::unique_ptr<MLIRContext> &contextPtr,
@@ -500,7 +578,7 @@ protected:
     auto module = parseSourceFile<ModuleOp>(sourceMgr, contextPtr.get());
     if (!module)
       throw std::runtime_error("Failed to parse the input MLIR code");
-    auto engine = jitMlirCode(*module, passes);
+    auto *engine = getOrJitMlirCode(irString, *module, passes);
     llvm::SmallVector<void *> returnArg;
     const std::string entryPointFunc =
         std::string(cudaq::runtime::cudaqGenPrefixName) + entryPointFn;
@@ -555,7 +633,7 @@ protected:
     }
   }
 
-  void *loadNvqirSimLib(const std::string &simulatorName) {
+  SimulatorHandle loadNvqirSimLib(const std::string &simulatorName) {
     const std::filesystem::path cudaqLibPath{cudaq::getCUDAQLibraryPath()};
 #if defined(__APPLE__) && defined(__MACH__)
     const auto libSuffix = "dylib";
@@ -575,13 +653,26 @@ protected:
     }
     auto *sim = cudaq::getUniquePluginInstance<nvqir::CircuitSimulator>(
         std::string("getCircuitSimulator"), simLibPath.c_str());
-    __nvqir__setCircuitSimulator(sim);
+    return SimulatorHandle{simulatorName, simLibHandle, sim};
+  }
 
-    return simLibHandle;
+  // Make `simulatorName` the simulator of the next executions, loading its
+  // library on first use.
+  void activateSimulator(const std::string &simulatorName) {
+    if (m_activeSimulator == simulatorName)
+      return;
+    auto iter = m_simHandles.find(simulatorName);
+    if (iter == m_simHandles.end())
+      iter = m_simHandles
+                 .emplace(simulatorName, loadNvqirSimLib(simulatorName))
+                 .first;
+    __nvqir__setCircuitSimulator(iter->second.simulator);
+    m_activeSimulator = simulatorName;
   }
 
   virtual json processRequest(const std::string &reqBody,
-                              bool forceLog = false) {
+                              bool forceLog = false,
+                              bool binaryPayload = false) {
     // Create a watchdog thread to kill the process if the request is taking too
     // long.
     std::mutex watchdogMutex;
@@ -620,6 +711,10 @@ protected:
       static std::size_t g_requestCounter = 0;
       auto requestJson = json::parse(reqBody);
       cudaq::RestRequest request(requestJson);
+      auto serializeContext = [&]() {
+        return binaryPayload ? cudaq::to_binary_json(request.executionContext)
+                             : json(request.executionContext);
+      };
 
       std::ostringstream os;
       os << "[RemoteRestRuntimeServer] Incoming job request from client "
@@ -673,7 +768,7 @@ protected:
             reqId, request.executionContext, request.simulator, codeStr,
             request.opt->gradient.get(), *request.opt->optimizer,
             *request.opt->optimizer_n_params, request.entryPoint, request.seed);
-        resultJson["executionContext"] = request.executionContext;
+        resultJson["executionContext"] = serializeContext();
       } else if (request.executionContext.name == "state-overlap") {
         if (!request.overlapKernel.has_value())
           throw std::runtime_error("Missing overlap kernel data.");
@@ -704,7 +799,7 @@ protected:
         request.executionContext.overlapResult =
             stateContext1.simulationState->overlap(
                 *stateContext2.simulationState);
-        resultJson["executionContext"] = request.executionContext;
+        resultJson["executionContext"] = serializeContext();
       } else {
         if (request.overlapKernel.has_value())
           throw std::runtime_error("Unexpected data: overlap kernel is "
@@ -735,7 +830,7 @@ protected:
           }
         }
 
-        resultJson["executionContext"] = request.executionContext;
+        resultJson["executionContext"] = serializeContext();
       }
       m_codeTransform.erase(reqId);
       return resultJson;
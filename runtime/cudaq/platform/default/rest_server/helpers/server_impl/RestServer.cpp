@@ -8,6 +8,7 @@
 
 #include "RestServer.h"
 #include <cxxabi.h>
+#include <strings.h>
 
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -52,6 +53,16 @@ void cudaq::RestServer::start() { m_impl->app.run(); }
 void cudaq::RestServer::stop() { m_impl->app.stop(); }
 cudaq::RestServer::~RestServer() = default;
 
+bool cudaq::RestServer::acceptsMediaType(
+    const std::unordered_multimap<std::string, std::string> &headers,
+    std::string_view mediaType) {
+  for (const auto &[k, v] : headers)
+    if (strcasecmp(k.c_str(), "Accept") == 0 &&
+        v.find(mediaType) != std::string::npos)
+      return true;
+  return false;
+}
+
 // Helper to invoke route handler: exceptions will be returned as 500 Internal
 // Server Error.
 static inline crow::response
@@ -62,7 +73,14 @@ invokeRouteHandler(const cudaq::RestServer::RouteHandler &handler,
     for (const auto &[k, v] : req.headers)
       headers.emplace(k, v);
 
-    return handler(req.body, headers).dump();
+    auto result = handler(req.body, headers);
+    if (cudaq::RestServer::acceptsMediaType(headers, "application/cbor")) {
+      const auto cbor = nlohmann::json::to_cbor(result);
+      crow::response response(std::string(cbor.begin(), cbor.end()));
+      response.set_header("Content-Type", "application/cbor");
+      return response;
+    }
+    return result.dump();
   } catch (std::exception &e) {
     const std::string errorMsg =
         std::string("Unhandled exception encountered: ") + e.what();
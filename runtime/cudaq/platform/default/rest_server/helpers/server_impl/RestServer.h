@@ -11,6 +11,8 @@
 #include "nlohmann/json.hpp"
 #include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace cudaq {
 /// Generic REST server interface
@@ -37,5 +39,11 @@ public:
   void stop();
   // Destructor
   ~RestServer();
+  // Return true if the `Accept` header of a request lists `mediaType`, in which
+  // case the response is encoded in that format. Besides JSON, only the CBOR
+  // binary format (`application/cbor`) is supported.
+  static bool acceptsMediaType(
+      const std::unordered_multimap<std::string, std::string> &headers,
+      std::string_view mediaType);
 };
 } // namespace cudaq
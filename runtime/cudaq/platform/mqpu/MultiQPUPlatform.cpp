@@ -24,10 +24,92 @@
 LLVM_INSTANTIATE_REGISTRY(cudaq::QPU::RegistryType)
 
 namespace {
+/// Parse a comma-separated list of relative QPU throughput weights for
+/// \p numQpus QPUs. A single weight applies to all QPUs.
+std::vector<double> parseQpuWeights(const std::string &weightsStr,
+                                    std::size_t numQpus,
+                                    const std::string &origin) {
+  std::vector<double> weights;
+  for (const auto &weightStr : cudaq::split(weightsStr, ',')) {
+    double weight = 0.0;
+    try {
+      weight = std::stod(weightStr);
+    } catch (...) {
+      throw std::runtime_error(fmt::format(
+          "Invalid QPU weight '{}' in {}, must be a number.", weightStr,
+          origin));
+    }
+    if (!(weight > 0.0))
+      throw std::runtime_error(fmt::format(
+          "Invalid QPU weight '{}' in {}, must be positive.", weightStr,
+          origin));
+    weights.push_back(weight);
+  }
+  if (weights.size() == 1)
+    weights.resize(numQpus, weights.front());
+  if (weights.size() != numQpus)
+    throw std::runtime_error(
+        fmt::format("Invalid number of QPU weights provided in {}: receiving "
+                    "{}, expecting {}.",
+                    origin, weights.size(), numQpus));
+  return weights;
+}
+
+/// Parse the number of QPUs to emulate on each GPU.
+int parseQpusPerGpu(const std::string &value, const std::string &origin) {
+  int qpusPerGpu = 0;
+  try {
+    qpusPerGpu = std::stoi(value);
+  } catch (...) {
+  }
+  if (qpusPerGpu < 1)
+    throw std::runtime_error(fmt::format(
+        "Invalid number of QPUs per GPU '{}' in {}, must be a positive "
+        "integer.",
+        value, origin));
+  return qpusPerGpu;
+}
+
 class MultiQPUQuantumPlatform : public cudaq::quantum_platform {
   std::vector<std::unique_ptr<cudaq::AutoLaunchRestServerProcess>>
       m_remoteServers;
 
+  /// The number of GPUs emulating QPUs, 0 if the QPUs are not GPU emulated.
+  int numGpus = 0;
+  /// The number of QPUs emulated on each GPU.
+  int numQpusPerGpu = 0;
+
+  /// Populate the platform with \p qpusPerGpu emulated QPUs on each GPU. QPU
+  /// `i` runs on GPU `i / qpusPerGpu`, with its own execution thread,
+  /// simulator and CUDA stream.
+  void addGpuQpus(int qpusPerGpu) {
+    // The relative throughput of each GPU is given by the user or,
+    // by default, by its number of streaming multiprocessors, so that
+    // tasks submitted to `cudaq::any_qpu` favor the faster GPUs of a
+    // heterogeneous node. QPUs sharing a GPU share its throughput.
+    const std::size_t numQpus = numGpus * qpusPerGpu;
+    std::vector<double> weights;
+    if (const char *weightsVal = std::getenv("CUDAQ_MQPU_WEIGHTS"))
+      weights = parseQpuWeights(weightsVal, numQpus,
+                                "CUDAQ_MQPU_WEIGHTS environment variable");
+
+    platformQPUs.clear();
+    numQpusPerGpu = qpusPerGpu;
+    for (std::size_t i = 0; i < numQpus; i++) {
+      const int device = i / qpusPerGpu;
+      platformQPUs.emplace_back(
+          cudaq::registry::get<cudaq::QPU>("GPUEmulatedQPU"));
+      platformQPUs.back()->setId(i);
+      platformQPUs.back()->setTargetBackend(fmt::format("device;{}", device));
+      if (!weights.empty()) {
+        platformQPUs.back()->setThroughputWeight(weights[i]);
+      } else if (const int numSMs =
+                     cudaq::getCudaDeviceMultiprocessorCount(device)) {
+        platformQPUs.back()->setThroughputWeight(double(numSMs) / qpusPerGpu);
+      }
+    }
+  }
+
 public:
   ~MultiQPUQuantumPlatform() {
     // Make sure that we clean up the client QPUs first before cleaning up the
@@ -60,12 +142,12 @@ public:
           throw std::runtime_error(
               "No GPUs available to instantiate platform.");
 
-        // Add a QPU for each GPU.
-        for (int i = 0; i < nDevices; i++) {
-          platformQPUs.emplace_back(
-              cudaq::registry::get<cudaq::QPU>("GPUEmulatedQPU"));
-          platformQPUs.back()->setId(i);
-        }
+        numGpus = nDevices;
+        int qpusPerGpu = 1;
+        if (const char *perGpuVal = std::getenv("CUDAQ_MQPU_QPUS_PER_GPU"))
+          qpusPerGpu = parseQpusPerGpu(
+              perGpuVal, "CUDAQ_MQPU_QPUS_PER_GPU environment variable");
+        addGpuQpus(qpusPerGpu);
       }
     }
   }
@@ -136,6 +218,14 @@ private:
       return "";
     };
 
+    // The number of QPUs emulated on each GPU may be set via the target.
+    const auto qpusPerGpuStr = getOpt(description, "qpus_per_gpu");
+    if (numGpus > 0 && !qpusPerGpuStr.empty()) {
+      const int qpusPerGpu = parseQpusPerGpu(qpusPerGpuStr, "target options");
+      if (qpusPerGpu != numQpusPerGpu)
+        addGpuQpus(qpusPerGpu);
+    }
+
     const auto qpuSubType = getQpuType(description);
     if (!qpuSubType.empty()) {
       const auto formatUrl = [](const std::string &url) -> std::string {
@@ -197,6 +287,15 @@ private:
               "Invalid number of remote backend simulators provided: "
               "receiving {}, expecting {}.",
               sims.size(), urls.size()));
+        // Each QPU fails over to the other servers when its own does not
+        // respond.
+        std::vector<std::string> endpoints;
+        for (const auto &url : urls)
+          endpoints.emplace_back(formatUrl(url));
+        const std::string endpointsConfig =
+            endpoints.size() > 1
+                ? fmt::format(";endpoints;{}", fmt::join(endpoints, ","))
+                : "";
         platformQPUs.clear();
         for (std::size_t qId = 0; qId < urls.size(); ++qId) {
           const auto simName = sims.size() == 1 ? sims.front() : sims[qId];
@@ -204,11 +303,22 @@ private:
           auto qpu = cudaq::registry::get<cudaq::QPU>("RemoteSimulatorQPU");
           qpu->setId(qId);
           const std::string configStr =
-              fmt::format("url;{};simulator;{}", formatUrl(urls[qId]), simName);
+              fmt::format("url;{};simulator;{}{}", endpoints[qId], simName,
+                          endpointsConfig);
           qpu->setTargetBackend(configStr);
           platformQPUs.emplace_back(std::move(qpu));
         }
       }
+
+      // Relative throughput weights of the QPUs, e.g., to mix servers on
+      // GPUs of different generations with CPU simulators.
+      const auto weightsStr = getOpt(description, "weights");
+      if (!weightsStr.empty()) {
+        const auto weights =
+            parseQpuWeights(weightsStr, platformQPUs.size(), "target options");
+        for (std::size_t qId = 0; qId < platformQPUs.size(); ++qId)
+          platformQPUs[qId]->setThroughputWeight(weights[qId]);
+      }
     }
   }
 };
@@ -22,15 +22,34 @@ namespace {
 
 /// @brief This QPU implementation enqueues kernel
 /// execution tasks and sets the CUDA GPU device that it
-/// represents. There is a GPUEmulatedQPU per available GPU.
+/// represents. There is at least one GPUEmulatedQPU per available GPU. Several
+/// GPUEmulatedQPUs may share a GPU: each one executes its tasks on its own
+/// thread, with its own simulator instance and CUDA stream, so that small
+/// independent kernels run concurrently on the device.
 class GPUEmulatedQPU : public cudaq::QPU {
 protected:
   std::map<std::size_t, cudaq::ExecutionContext *> contexts;
 
+  /// @brief The CUDA device of this QPU, defaults to the QPU id.
+  std::optional<int> deviceId;
+
+  int getDeviceId() const {
+    return deviceId.has_value() ? *deviceId : static_cast<int>(qpu_id);
+  }
+
 public:
   GPUEmulatedQPU() : QPU(){};
   GPUEmulatedQPU(std::size_t id) : QPU(id) {}
 
+  /// @brief The backend configuration is `device;<id>` to select the CUDA
+  /// device of this QPU.
+  void setTargetBackend(const std::string &backend) override {
+    auto parts = cudaq::split(backend, ';');
+    for (std::size_t i = 0; i + 1 < parts.size(); ++i)
+      if (parts[i] == "device")
+        deviceId = std::stoi(parts[i + 1]);
+  }
+
   void enqueue(cudaq::QuantumTask &task) override {
     // Note: enqueue is executed on the main thread, not the QPU execution
     // thread. Hence, do not set the CUDA device here.
@@ -42,14 +61,14 @@ public:
   launchKernel(const std::string &name, cudaq::KernelThunkType kernelFunc,
                void *args, std::uint64_t, std::uint64_t,
                const std::vector<void *> &rawArgs) override {
-    CUDAQ_INFO("QPU::launchKernel GPU {}", qpu_id);
-    cudaSetDevice(qpu_id);
+    CUDAQ_INFO("QPU::launchKernel QPU {} on GPU {}", qpu_id, getDeviceId());
+    cudaSetDevice(getDeviceId());
     return kernelFunc(args, /*differentMemorySpace=*/false);
   }
 
   /// Overrides setExecutionContext to forward it to the ExecutionManager
   void setExecutionContext(cudaq::ExecutionContext *context) override {
-    cudaSetDevice(qpu_id);
+    cudaSetDevice(getDeviceId());
 
     CUDAQ_INFO("MultiQPUPlatform::setExecutionContext QPU {}", qpu_id);
     auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
@@ -223,3 +223,14 @@ int cudaq::getCudaGetDeviceCount() {
   return 0;
 #endif
 }
+
+int cudaq::getCudaDeviceMultiprocessorCount(int deviceId) {
+#ifdef CUDAQ_ENABLE_CUDA
+  int count{0};
+  const auto status = cudaDeviceGetAttribute(
+      &count, cudaDevAttrMultiProcessorCount, deviceId);
+  return status != cudaSuccess ? 0 : count;
+#else
+  return 0;
+#endif
+}
@@ -33,4 +33,9 @@ private:
 // If CUDA is present, returns the actual number of GPU devices. Otherwise,
 // returns 0.
 int getCudaGetDeviceCount();
+
+// Helper to retrieve the number of streaming multiprocessors of a GPU, a proxy
+// of its relative simulation throughput. Returns 0 if CUDA is not present or
+// the device cannot be queried.
+int getCudaDeviceMultiprocessorCount(int deviceId);
 } // namespace cudaq
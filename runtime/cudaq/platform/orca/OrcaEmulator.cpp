@@ -0,0 +1,295 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "OrcaEmulator.h"
+#include "common/Logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using Complex = std::complex<double>;
+
+/// Matrices of at least this size have their permanents summed in parallel.
+/// Below it, spawning threads costs more than the `2^(n-1)` terms themselves,
+/// and the emulator parallelizes over samples instead.
+constexpr std::size_t parallelPermanentThreshold = 14;
+
+/// Glynn's formula restricted to the Gray code steps `[lo, hi)` of the
+/// square, row-major matrix @p a of size @p n.
+Complex glynnRange(const Complex *a, std::size_t n, std::uint64_t lo,
+                   std::uint64_t hi) {
+  // Row 0 always has a positive sign; bit `b` of the Gray code holds the sign
+  // of row `b + 1`.
+  std::uint64_t gray = lo ^ (lo >> 1);
+  std::vector<Complex> sums(a, a + n);
+  for (std::size_t i = 1; i < n; ++i) {
+    const double delta = (gray >> (i - 1)) & 1 ? -1. : 1.;
+    for (std::size_t j = 0; j < n; ++j)
+      sums[j] += delta * a[i * n + j];
+  }
+  double sign = std::popcount(gray) & 1 ? -1. : 1.;
+
+  Complex total = 0.;
+  for (std::uint64_t k = lo;;) {
+    Complex product = sign;
+    for (std::size_t j = 0; j < n; ++j)
+      product *= sums[j];
+    total += product;
+    if (++k == hi)
+      break;
+
+    // Moving to the next Gray code flips exactly one sign.
+    const int bit = std::countr_zero(k);
+    gray ^= std::uint64_t(1) << bit;
+    const double step = (gray >> bit) & 1 ? -2. : 2.;
+    const Complex *row = a + (bit + 1) * n;
+    for (std::size_t j = 0; j < n; ++j)
+      sums[j] += step * row[j];
+    sign = -sign;
+  }
+  return total;
+}
+
+/// Permanent of the square, row-major matrix @p a of size @p n.
+Complex glynnPermanent(const Complex *a, std::size_t n,
+                       std::size_t numThreads) {
+  if (n == 0)
+    return 1.;
+  if (n >= 64)
+    throw std::runtime_error("orca emulator: permanents of " +
+                             std::to_string(n) +
+                             "-photon matrices are not supported.");
+
+  const std::uint64_t numTerms = std::uint64_t(1) << (n - 1);
+  const double scale = std::ldexp(1., -static_cast<int>(n - 1));
+  if (n < parallelPermanentThreshold || numThreads <= 1)
+    return glynnRange(a, n, 0, numTerms) * scale;
+
+  numThreads = std::min<std::uint64_t>(numThreads, numTerms);
+  std::vector<Complex> partials(numThreads);
+  std::vector<std::thread> workers;
+  workers.reserve(numThreads);
+  const std::uint64_t block = numTerms / numThreads;
+  for (std::size_t t = 0; t < numThreads; ++t) {
+    const std::uint64_t lo = t * block;
+    const std::uint64_t hi = t + 1 == numThreads ? numTerms : lo + block;
+    workers.emplace_back(
+        [&, t, lo, hi]() { partials[t] = glynnRange(a, n, lo, hi); });
+  }
+  for (auto &worker : workers)
+    worker.join();
+  return std::accumulate(partials.begin(), partials.end(), Complex{0.}) *
+         scale;
+}
+
+std::size_t resolveThreads(std::size_t numThreads) {
+  if (numThreads > 0)
+    return numThreads;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Draw one output pattern with algorithm B of Clifford & Clifford. @p columns
+/// holds the `m x n` transfer matrix columns of the occupied input modes (one
+/// column per photon, row-major).
+std::vector<std::size_t> samplePattern(const std::vector<Complex> &columns,
+                                       std::size_t numModes,
+                                       std::size_t numPhotons,
+                                       std::size_t numThreads,
+                                       std::mt19937_64 &gen) {
+  // Uniformly permuting the photons makes the sequential marginals below
+  // exact.
+  std::vector<std::size_t> order(numPhotons);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), gen);
+  auto column = [&](std::size_t mode, std::size_t photon) {
+    return columns[mode * numPhotons + order[photon]];
+  };
+
+  std::vector<std::size_t> outputs;
+  outputs.reserve(numPhotons);
+  std::vector<Complex> minors(numPhotons);
+  std::vector<Complex> sub;
+  std::vector<double> weights(numModes);
+  for (std::size_t k = 1; k <= numPhotons; ++k) {
+    // Permanents of the (k-1) x (k-1) minors over the modes picked so far and
+    // the first k photons with photon `l` left out.
+    const std::size_t dim = k - 1;
+    sub.resize(dim * dim);
+    for (std::size_t l = 0; l < k; ++l) {
+      for (std::size_t i = 0; i < dim; ++i)
+        for (std::size_t j = 0, c = 0; j < k; ++j)
+          if (j != l)
+            sub[i * dim + c++] = column(outputs[i], j);
+      minors[l] = glynnPermanent(sub.data(), dim, numThreads);
+    }
+
+    // Laplace expansion along the newly added row gives the weight of every
+    // candidate output mode.
+    for (std::size_t mode = 0; mode < numModes; ++mode) {
+      Complex amplitude = 0.;
+      for (std::size_t l = 0; l < k; ++l)
+        amplitude += column(mode, l) * minors[l];
+      weights[mode] = std::norm(amplitude);
+    }
+    std::discrete_distribution<std::size_t> pick(weights.begin(),
+                                                 weights.end());
+    outputs.push_back(pick(gen));
+  }
+  return outputs;
+}
+
+std::string formatPattern(const std::vector<std::size_t> &outputs,
+                          std::size_t numModes) {
+  std::vector<std::size_t> counts(numModes, 0);
+  for (auto mode : outputs)
+    ++counts[mode];
+  std::string bits;
+  for (auto count : counts)
+    bits += std::to_string(count);
+  return bits;
+}
+
+} // namespace
+
+namespace cudaq::orca {
+
+complex_matrix interferometerUnitary(const TBIParameters &params) {
+  const std::size_t numModes = params.input_state.size();
+  std::size_t numBeamSplitters = 0;
+  for (auto loopLength : params.loop_lengths) {
+    if (loopLength == 0 || loopLength >= numModes)
+      throw std::runtime_error("orca emulator: loop length " +
+                               std::to_string(loopLength) +
+                               " is not valid for " + std::to_string(numModes) +
+                               " modes.");
+    numBeamSplitters += numModes - loopLength;
+  }
+  if (params.bs_angles.size() != numBeamSplitters)
+    throw std::runtime_error(
+        "orca emulator: expected " + std::to_string(numBeamSplitters) +
+        " beam splitter angles, got " +
+        std::to_string(params.bs_angles.size()) + ".");
+  if (!params.ps_angles.empty() && params.ps_angles.size() != numBeamSplitters)
+    throw std::runtime_error(
+        "orca emulator: expected " + std::to_string(numBeamSplitters) +
+        " phase shifter angles, got " +
+        std::to_string(params.ps_angles.size()) + ".");
+
+  // Each component only mixes two rows, so apply it in place rather than
+  // multiplying full matrices.
+  std::vector<Complex> u(numModes * numModes, 0.);
+  for (std::size_t i = 0; i < numModes; ++i)
+    u[i * numModes + i] = 1.;
+  std::size_t c = 0;
+  for (auto loopLength : params.loop_lengths) {
+    for (std::size_t i = 0; i < numModes - loopLength; ++i, ++c) {
+      const double t = std::cos(params.bs_angles[c]);
+      const double r = std::sin(params.bs_angles[c]);
+      Complex *first = &u[i * numModes];
+      Complex *second = &u[(i + loopLength) * numModes];
+      for (std::size_t j = 0; j < numModes; ++j) {
+        const Complex a = first[j];
+        const Complex b = second[j];
+        first[j] = t * a + r * b;
+        second[j] = t * b - r * a;
+      }
+      if (params.ps_angles.empty())
+        continue;
+      const Complex phase = std::polar(1., params.ps_angles[c]);
+      for (std::size_t j = 0; j < numModes; ++j)
+        first[j] *= phase;
+    }
+  }
+  return complex_matrix(u, {numModes, numModes});
+}
+
+std::complex<double> permanent(const complex_matrix &matrix,
+                               std::size_t numThreads) {
+  const std::size_t n = matrix.rows();
+  if (matrix.cols() != n)
+    throw std::runtime_error("orca emulator: the permanent requires a square "
+                             "matrix.");
+  std::vector<Complex> a(n * n);
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      a[i * n + j] = matrix(i, j);
+  return glynnPermanent(a.data(), n, resolveThreads(numThreads));
+}
+
+sample_result emulate(const TBIParameters &params, std::size_t seed) {
+  const auto u = interferometerUnitary(params);
+  const std::size_t numModes = params.input_state.size();
+  const std::size_t numShots = std::max(params.n_samples, 0);
+
+  // One column of the transfer matrix per input photon.
+  std::vector<std::size_t> sources;
+  for (std::size_t mode = 0; mode < numModes; ++mode)
+    sources.insert(sources.end(), params.input_state[mode], mode);
+  const std::size_t numPhotons = sources.size();
+  std::vector<Complex> columns(numModes * numPhotons);
+  for (std::size_t mode = 0; mode < numModes; ++mode)
+    for (std::size_t p = 0; p < numPhotons; ++p)
+      columns[mode * numPhotons + p] = u(mode, sources[p]);
+
+  // Small photon numbers are parallelized over samples, large ones within
+  // each permanent.
+  const std::size_t hardwareThreads = resolveThreads(0);
+  const bool parallelShots = numPhotons < parallelPermanentThreshold;
+  const std::size_t numWorkers =
+      parallelShots ? std::max<std::size_t>(
+                          1, std::min(hardwareThreads, numShots))
+                    : 1;
+  const std::size_t permanentThreads = parallelShots ? 1 : hardwareThreads;
+  CUDAQ_INFO("orca emulator: sampling {} photons in {} modes, {} shots on {} "
+             "threads",
+             numPhotons, numModes, numShots,
+             parallelShots ? numWorkers : permanentThreads);
+
+  const std::uint64_t baseSeed = seed == 0 ? std::random_device{}() : seed;
+  std::seed_seq seeds{static_cast<std::uint32_t>(baseSeed),
+                      static_cast<std::uint32_t>(baseSeed >> 32)};
+  std::vector<std::uint64_t> workerSeeds(numWorkers);
+  seeds.generate(workerSeeds.begin(), workerSeeds.end());
+
+  std::vector<CountsDictionary> partials(numWorkers);
+  auto work = [&](std::size_t worker) {
+    std::mt19937_64 gen(workerSeeds[worker]);
+    const std::size_t begin = worker * numShots / numWorkers;
+    const std::size_t end = (worker + 1) * numShots / numWorkers;
+    for (std::size_t shot = begin; shot < end; ++shot) {
+      auto outputs = samplePattern(columns, numModes, numPhotons,
+                                   permanentThreads, gen);
+      partials[worker][formatPattern(outputs, numModes)] += 1;
+    }
+  };
+  if (numWorkers == 1) {
+    work(0);
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(numWorkers);
+    for (std::size_t t = 0; t < numWorkers; ++t)
+      workers.emplace_back(work, t);
+    for (auto &worker : workers)
+      worker.join();
+  }
+
+  CountsDictionary counts;
+  for (auto &partial : partials)
+    for (auto &[bits, count] : partial)
+      counts[bits] += count;
+  return sample_result(ExecutionResult(counts));
+}
+
+} // namespace cudaq::orca
@@ -0,0 +1,43 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/SampleResult.h"
+#include "cudaq/operators/matrix.h"
+#include "orca_qpu.h"
+
+#include <complex>
+
+namespace cudaq::orca {
+
+/// @brief Return the `m x m` single-photon transfer matrix of the time-bin
+/// interferometer described by @p params, where `m` is the number of modes.
+/// Element `(i, j)` is the amplitude for a photon entering mode `j` to leave
+/// in mode `i`. Beam splitters and phase shifters are applied in the same
+/// order, and with the same conventions, as the `orca-photonics` target.
+complex_matrix interferometerUnitary(const TBIParameters &params);
+
+/// @brief Compute the permanent of the square matrix @p matrix with Glynn's
+/// formula, visiting the sign vectors in Gray code order so that every term
+/// costs `O(n)`. For large matrices the Gray code sequence is split into
+/// contiguous blocks that are summed on @p numThreads threads (`0` selects
+/// the hardware concurrency).
+std::complex<double> permanent(const complex_matrix &matrix,
+                               std::size_t numThreads = 0);
+
+/// @brief Draw `params.n_samples` exact boson sampling outcomes for the
+/// interferometer described by @p params. Samples are produced with the
+/// Clifford & Clifford algorithm (arXiv:1706.01260), which costs a handful
+/// of permanents of growing sub-matrices per sample instead of the full
+/// output distribution. Each outcome is reported as the concatenated photon
+/// counts of every mode, as the ORCA service does. A @p seed of `0` seeds the
+/// generator non-deterministically.
+sample_result emulate(const TBIParameters &params, std::size_t seed = 0);
+
+} // namespace cudaq::orca
@@ -91,4 +91,35 @@ async_sample_result sample_async(std::vector<std::size_t> &input_state,
   return runAsyncSampling(parameters, qpu_id);
 }
 
+std::vector<cudaq::sample_result>
+sample_batch(std::vector<std::size_t> &input_state,
+             std::vector<std::size_t> &loop_lengths,
+             const std::vector<std::vector<double>> &bs_angle_sets,
+             std::vector<double> &ps_angles, int n_samples,
+             std::size_t qpu_id) {
+  std::vector<async_sample_result> pending;
+  pending.reserve(bs_angle_sets.size());
+  for (const auto &bs_angles : bs_angle_sets) {
+    TBIParameters parameters{input_state, loop_lengths, bs_angles, ps_angles,
+                             n_samples};
+    pending.emplace_back(runAsyncSampling(parameters, qpu_id));
+  }
+
+  std::vector<cudaq::sample_result> results;
+  results.reserve(pending.size());
+  for (auto &result : pending)
+    results.emplace_back(result.get());
+  return results;
+}
+
+std::vector<cudaq::sample_result>
+sample_batch(std::vector<std::size_t> &input_state,
+             std::vector<std::size_t> &loop_lengths,
+             const std::vector<std::vector<double>> &bs_angle_sets,
+             int n_samples, std::size_t qpu_id) {
+  std::vector<double> ps_angles = {};
+  return sample_batch(input_state, loop_lengths, bs_angle_sets, ps_angles,
+                      n_samples, qpu_id);
+}
+
 } // namespace cudaq::orca
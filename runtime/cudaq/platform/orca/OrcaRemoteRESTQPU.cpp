@@ -7,7 +7,9 @@
  ******************************************************************************/
 
 #include "OrcaRemoteRESTQPU.h"
+#include "OrcaEmulator.h"
 #include "common/Logger.h"
+#include "cudaq.h"
 #include "llvm/Support/Base64.h"
 
 using namespace cudaq;
@@ -47,6 +49,10 @@ void cudaq::OrcaRemoteRESTQPU::setTargetBackend(const std::string &backend) {
     }
   }
 
+  // Turn on emulation mode if requested
+  auto iter = backendConfig.find("emulate");
+  emulate = iter != backendConfig.end() && iter->second == "true";
+
   /// Once we know the backend, we should search for the config file
   /// from there we can get the URL/PORT and other information used in the
   /// pipeline.
@@ -78,8 +84,17 @@ KernelThunkResultType cudaq::OrcaRemoteRESTQPU::launchKernelCommon(
 
   ctx->shots = shots;
 
+  // Emulated programs are sampled locally by the boson sampling emulator.
   details::future future;
-  future = executor->execute(params, kernelName);
+  if (emulate) {
+    // Fetch the thread-specific seed outside and then pass it inside.
+    std::size_t seed = cudaq::get_random_seed();
+    future = details::future(std::async(
+        std::launch::async,
+        [params, seed]() { return orca::emulate(params, seed); }));
+  } else {
+    future = executor->execute(params, kernelName);
+  }
 
   // Keep this asynchronous if requested
   if (ctx->asyncExec) {
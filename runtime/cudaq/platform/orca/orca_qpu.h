@@ -53,4 +53,21 @@ async_sample_result sample_async(std::vector<std::size_t> &input_state,
                                  std::vector<double> &bs_angles,
                                  int n_samples = 10000, std::size_t qpu_id = 0);
 
+/// @brief Sample the same interferometer once for every set of beam splitter
+/// angles in @p bs_angle_sets. All experiments are submitted before any result
+/// is awaited, so remote jobs are queued together and emulated ones run
+/// concurrently. Results are returned in the order of @p bs_angle_sets.
+std::vector<cudaq::sample_result>
+sample_batch(std::vector<std::size_t> &input_state,
+             std::vector<std::size_t> &loop_lengths,
+             const std::vector<std::vector<double>> &bs_angle_sets,
+             std::vector<double> &ps_angles, int n_samples = 10000,
+             std::size_t qpu_id = 0);
+
+std::vector<cudaq::sample_result>
+sample_batch(std::vector<std::size_t> &input_state,
+             std::vector<std::size_t> &loop_lengths,
+             const std::vector<std::vector<double>> &bs_angle_sets,
+             int n_samples = 10000, std::size_t qpu_id = 0);
+
 }; // namespace cudaq::orca
@@ -17,6 +17,24 @@ public:
   PasqalRemoteRESTQPU() : AnalogRemoteRESTQPU() {}
   PasqalRemoteRESTQPU(PasqalRemoteRESTQPU &&) = delete;
   virtual ~PasqalRemoteRESTQPU() = default;
+
+protected:
+  /// @brief Report the filled sites of emulated shots as Pasqal does: `1` for
+  /// an atom in the Rydberg state and `0` for an atom in the ground state.
+  cudaq::sample_result processEmulatedShots(
+      const std::vector<cudaq::ahs::ShotMeasurement> &shots) override {
+    cudaq::CountsDictionary counts;
+    for (const auto &shot : shots) {
+      const auto &pre = shot.shotResult.preSequence.value();
+      const auto &post = shot.shotResult.postSequence.value();
+      std::string bitString;
+      for (std::size_t i = 0; i < pre.size(); ++i)
+        if (pre[i])
+          bitString += post[i] ? '0' : '1';
+      counts[bitString]++;
+    }
+    return cudaq::sample_result(cudaq::ExecutionResult(counts));
+  }
 };
 } // namespace
 
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "QuantumExecutionQueue.h"
+#include "common/Environment.h"
 #include "common/Logger.h"
 #include "common/Registry.h"
 #include "common/ThunkInterface.h"
@@ -54,6 +55,10 @@ protected:
   /// @brief Noise model specified for QPU execution.
   const noise_model *noiseModel = nullptr;
 
+  /// @brief Relative throughput of this QPU with respect to the other QPUs of
+  /// the platform, used to route tasks that may run on any QPU.
+  double throughputWeight = 1.0;
+
   /// @brief Check if the current execution context is a `spin_op` observation
   /// and perform state-preparation circuit measurement based on the `spin_op`
   /// terms.
@@ -85,6 +90,31 @@ protected:
         auto [exp, data] = cudaq::measure(H);
         localContext->expectationValue = exp;
         localContext->result = data;
+      } else if (getEnvBool("CUDAQ_OBSERVE_GROUP_TERMS", true)) {
+        // Measure each group of qubit-wise commuting terms with a single
+        // basis change (and a single sampling pass if shots-based).
+        auto measuredTerms = cudaq::spin_op::empty();
+        for (const auto &term : H)
+          if (term.is_identity())
+            sum += term.evaluate_coefficient().real();
+          else
+            measuredTerms += term;
+
+        for (const auto &group : measuredTerms.group_commuting()) {
+          auto [exp, data] = cudaq::measure(group);
+          for (const auto &term : group) {
+            const auto termId = term.get_term_id();
+            const double termExp =
+                group.num_terms() == 1 ? exp : data.expectation(termId);
+            results.emplace_back(group.num_terms() == 1 ? data.to_map()
+                                                        : data.to_map(termId),
+                                 termId, termExp);
+            sum += term.evaluate_coefficient().real() * termExp;
+          }
+        }
+
+        localContext->expectationValue = sum;
+        localContext->result = cudaq::sample_result(sum, results);
       } else {
 
         // Loop over each term and compute coeff * <term>
@@ -129,6 +159,20 @@ public:
                            : std::thread::id();
   }
 
+  /// Get the number of tasks enqueued on this QPU that have not completed.
+  std::size_t getNumPendingTasks() const {
+    return execution_queue ? execution_queue->getNumPendingTasks() : 0;
+  }
+
+  /// Return false if this QPU cannot currently run tasks, e.g., if its remote
+  /// server does not respond, so that new tasks are sent to the other QPUs.
+  virtual bool isAvailable() const { return true; }
+
+  /// Set the relative throughput weight of this QPU.
+  void setThroughputWeight(double weight) { throughputWeight = weight; }
+  /// Get the relative throughput weight of this QPU.
+  double getThroughputWeight() const { return throughputWeight; }
+
   virtual void setNoiseModel(const noise_model *model) { noiseModel = model; }
   virtual const noise_model *getNoiseModel() { return noiseModel; }
 
@@ -12,6 +12,7 @@
 #include "common/RuntimeTarget.h"
 #include "cudaq/platform/qpu.h"
 #include "mlir/IR/BuiltinOps.h"
+#include <algorithm>
 #include <iostream>
 #include <shared_mutex>
 #include <string>
@@ -65,23 +66,59 @@ void quantum_platform::reset_noise(std::size_t qpu_id) {
   set_noise(nullptr, qpu_id);
 }
 
+void quantum_platform::set_qpu_weight(double weight, std::size_t qpu_id) {
+  validateQpuId(qpu_id);
+  if (!(weight > 0.0))
+    throw std::invalid_argument("QPU throughput weight must be positive, got " +
+                                std::to_string(weight) + ".");
+  platformQPUs[qpu_id]->setThroughputWeight(weight);
+}
+
+double quantum_platform::get_qpu_weight(std::size_t qpu_id) const {
+  validateQpuId(qpu_id);
+  return platformQPUs[qpu_id]->getThroughputWeight();
+}
+
+std::size_t quantum_platform::select_qpu() const {
+  validateQpuId(0);
+  // The expected completion time of a new task is the time to drain the
+  // pending tasks plus the new one, which scales as the inverse of the weight.
+  // The QPUs which are not available are only selected if none is.
+  const bool anyAvailable =
+      std::any_of(platformQPUs.begin(), platformQPUs.end(),
+                  [](const auto &qpu) { return qpu->isAvailable(); });
+  std::size_t best = 0;
+  double bestTime = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < platformQPUs.size(); ++i) {
+    const auto &qpu = platformQPUs[i];
+    if (anyAvailable && !qpu->isAvailable())
+      continue;
+    const double time = (qpu->getNumPendingTasks() + 1) /
+                        qpu->getThroughputWeight();
+    if (time < bestTime) {
+      best = i;
+      bestTime = time;
+    }
+  }
+  return best;
+}
+
 std::future<sample_result>
 quantum_platform::enqueueAsyncTask(const std::size_t qpu_id,
                                    KernelExecutionTask &task) {
   std::promise<sample_result> promise;
   auto f = promise.get_future();
-  QuantumTask wrapped = detail::make_copyable_function(
-      [p = std::move(promise), t = task]() mutable {
-        auto counts = t();
-        p.set_value(counts);
-      });
+  QuantumTask wrapped = [p = std::move(promise), t = task]() mutable {
+    auto counts = t();
+    p.set_value(counts);
+  };
 
   platformQPUs[qpu_id]->enqueue(wrapped);
   return f;
 }
 
 void quantum_platform::enqueueAsyncTask(const std::size_t qpu_id,
-                                        std::function<void()> &f) {
+                                        QuantumTask &f) {
   platformQPUs[qpu_id]->enqueue(f);
 }
 
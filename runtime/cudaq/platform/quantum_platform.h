@@ -13,6 +13,7 @@
 #include "common/NoiseModel.h"
 #include "common/ObserveResult.h"
 #include "common/ThunkInterface.h"
+#include "cudaq/platform/QuantumExecutionQueue.h"
 #include "cudaq/remote_capabilities.h"
 #include "cudaq/utils/cudaq_utils.h"
 #include "nvqpp_interface.h"
@@ -20,6 +21,7 @@
 #include <cxxabi.h>
 #include <functional>
 #include <future>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -52,6 +54,11 @@ using KernelExecutionTask = std::function<sample_result()>;
 /// a double expectation value.
 using ObserveTask = std::function<observe_result()>;
 
+/// Pass as the QPU id of an asynchronous task to let the platform route the
+/// task to the QPU expected to complete it first, see
+/// `quantum_platform::select_qpu`.
+inline constexpr std::size_t any_qpu = std::numeric_limits<std::size_t>::max();
+
 namespace detail {
 /// Temporary per-thread execution context storage.
 /// Will be removed when executionContext is eliminated.
@@ -142,12 +149,25 @@ public:
   /// @brief Turn off any noise models.
   void reset_noise(std::size_t qpu_id = 0);
 
+  /// @brief Set the relative throughput weight of @p qpu_id. A QPU with twice
+  /// the weight of another is expected to complete tasks twice as fast.
+  void set_qpu_weight(double weight, std::size_t qpu_id = 0);
+
+  /// @brief Return the relative throughput weight of @p qpu_id.
+  double get_qpu_weight(std::size_t qpu_id = 0) const;
+
+  /// @brief Return the id of the QPU expected to complete a newly enqueued
+  /// task first, i.e., the QPU with the fewest pending tasks per unit of
+  /// throughput weight. Ties go to the QPU with the lowest id.
+  std::size_t select_qpu() const;
+
   /// Enqueue an asynchronous sampling task.
   std::future<sample_result> enqueueAsyncTask(const std::size_t qpu_id,
                                               KernelExecutionTask &t);
 
-  /// @brief Enqueue a general task that runs on the specified QPU
-  void enqueueAsyncTask(const std::size_t qpu_id, std::function<void()> &f);
+  /// @brief Enqueue a general task that runs on the specified QPU. The task
+  /// is moved into the QPU's execution queue.
+  void enqueueAsyncTask(const std::size_t qpu_id, QuantumTask &f);
 
   /// @brief Launch a VQE operation on the platform.
   void launchVQE(const std::string kernelName, const void *kernelArgs,
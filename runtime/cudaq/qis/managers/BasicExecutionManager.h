@@ -11,10 +11,14 @@
 #include "cudaq/operators.h"
 #include "cudaq/qis/execution_manager.h"
 
+#include <array>
 #include <complex>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <queue>
+#include <set>
+#include <span>
 #include <stack>
 
 namespace cudaq {
@@ -34,15 +38,65 @@ protected:
     return executionContext && executionContext->name == "tracer";
   }
 
-  /// @brief An instruction is composed of a operation name,
-  /// a optional set of rotation parameters, control qudits,
-  /// target qudits, and an optional spin_op.
-  using Instruction = std::tuple<std::string, std::vector<double>,
-                                 std::vector<cudaq::QuditInfo>,
-                                 std::vector<cudaq::QuditInfo>, spin_op_term>;
+  /// @brief The gates that the execution managers dispatch to a dedicated code
+  /// path. All other operations, e.g. custom operations, are `custom` and are
+  /// identified by their name.
+  enum class GateKind : std::uint8_t {
+    h,
+    x,
+    y,
+    z,
+    s,
+    t,
+    sdg,
+    tdg,
+    rx,
+    ry,
+    rz,
+    r1,
+    u1,
+    u2,
+    u3,
+    swap,
+    exp_pauli,
+    custom
+  };
+
+  /// @brief An instruction is composed of a operation name, a optional set of
+  /// rotation parameters, control qudits, target qudits, and an optional
+  /// spin_op. The instruction is a view of the queued operation, valid for the
+  /// duration of the `executeInstruction` call.
+  struct Instruction {
+    std::string_view name;
+    GateKind kind;
+    std::span<const double> params;
+    std::span<const cudaq::QuditInfo> controls;
+    std::span<const cudaq::QuditInfo> targets;
+    const spin_op_term &op;
+  };
+
+  /// @brief A queued operation. The parameters, qudits and spin_op of the
+  /// operations are stored in arenas shared by all the queues, so that applying
+  /// a gate does not allocate once the arenas have grown to the size of the
+  /// largest queue. The operation refers to its data by offset, so that the
+  /// adjoint regions can reorder the queued operations without moving their
+  /// data.
+  struct QueuedInstruction {
+    std::string_view name;
+    GateKind kind;
+    std::uint32_t paramsBegin;
+    std::uint32_t numParams;
+    std::uint32_t controlsBegin;
+    std::uint32_t numControls;
+    std::uint32_t targetsBegin;
+    std::uint32_t numTargets;
+    /// @brief The index of the spin_op in `spinOpArena`, if it is not the
+    /// identity.
+    std::int32_t spinOp;
+  };
 
   /// @brief `typedef` for a queue of instructions
-  using InstructionQueue = std::vector<Instruction>;
+  using InstructionQueue = std::vector<QueuedInstruction>;
 
   /// @brief The current execution context, e.g. sampling or observation
   cudaq::ExecutionContext *executionContext = nullptr;
@@ -61,6 +115,60 @@ protected:
   /// qudit ids.
   std::vector<std::size_t> extraControlIds;
 
+  /// @brief The parameters of the queued operations.
+  std::vector<double> paramArena;
+
+  /// @brief The control and target qudits of the queued operations.
+  std::vector<cudaq::QuditInfo> quditArena;
+
+  /// @brief The spin_op of the queued operations that have one.
+  std::vector<spin_op_term> spinOpArena;
+
+  /// @brief The spin_op of the queued operations that do not have one.
+  const spin_op_term identityOp = cudaq::spin_op::identity();
+
+  /// @brief The names of the custom operations. A `std::set` keeps the names at
+  /// a fixed address, so that the queued operations can refer to them.
+  std::set<std::string, std::less<>> internedNames;
+
+  /// @brief Return the kind of the gate `gateName` and a view of its name that
+  /// outlives the queue.
+  std::pair<GateKind, std::string_view>
+  internGateName(std::string_view gateName) {
+    // The names of the gates, in the order of `GateKind`.
+    static constexpr std::array<std::string_view, 17> gateNames = {
+        "h",  "x",  "y",  "z",  "s",  "t",  "sdg",  "tdg",      "rx",
+        "ry", "rz", "r1", "u1", "u2", "u3", "swap", "exp_pauli"};
+    for (std::size_t i = 0; i < gateNames.size(); ++i)
+      if (gateNames[i] == gateName)
+        return {static_cast<GateKind>(i), gateNames[i]};
+    auto iter = internedNames.find(gateName);
+    if (iter == internedNames.end())
+      iter = internedNames.emplace(gateName).first;
+    return {GateKind::custom, *iter};
+  }
+
+  /// @brief Return the view of the queued operation `inst`.
+  Instruction getInstruction(const QueuedInstruction &inst) const {
+    return {inst.name,
+            inst.kind,
+            {paramArena.data() + inst.paramsBegin, inst.numParams},
+            {quditArena.data() + inst.controlsBegin, inst.numControls},
+            {quditArena.data() + inst.targetsBegin, inst.numTargets},
+            inst.spinOp < 0 ? identityOp : spinOpArena[inst.spinOp]};
+  }
+
+  /// @brief Clear the queue of operations, and the arenas once no adjoint
+  /// region refers to them.
+  void clearInstructionQueue() {
+    instructionQueue.clear();
+    if (!adjointQueueStack.empty())
+      return;
+    paramArena.clear();
+    quditArena.clear();
+    spinOpArena.clear();
+  }
+
   /// @brief Subtype-specific qudit allocation method
   virtual void allocateQudit(const QuditInfo &q) = 0;
 
@@ -103,7 +211,7 @@ public:
   void setExecutionContext(cudaq::ExecutionContext *_ctx) override {
     executionContext = _ctx;
     handleExecutionContextChanged();
-    instructionQueue.clear();
+    clearInstructionQueue();
   }
 
   void resetExecutionContext() override {
@@ -161,9 +269,7 @@ public:
                                   ? &instructionQueue
                                   : &(adjointQueueStack.back());
 
-    std::reverse(adjointQueue.begin(), adjointQueue.end());
-    for (auto &instruction : adjointQueue)
-      queue->push_back(instruction);
+    queue->insert(queue->end(), adjointQueue.rbegin(), adjointQueue.rend());
   }
 
   void startCtrlRegion(const std::vector<std::size_t> &controls) override {
@@ -175,32 +281,32 @@ public:
     extraControlIds.resize(extraControlIds.size() - n_controls);
   }
 
-  /// The goal for apply is to create a new element of the
-  /// instruction queue (a tuple).
+  /// The goal for apply is to create a new element of the instruction queue,
+  /// whose data is appended to the arenas.
   void apply(const std::string_view gateName, const std::vector<double> &params,
              const std::vector<cudaq::QuditInfo> &controls,
              const std::vector<cudaq::QuditInfo> &targets,
              bool isAdjoint = false,
              spin_op_term op = cudaq::spin_op::identity()) override {
-
-    // Make a copy of the name that we can mutate if necessary
-    std::string mutable_name(gateName);
-
-    // Make a copy of the parameters that we can mutate
-    std::vector<double> mutable_params = params;
-
-    // Create an array of controls, we will
-    // prepend any extra controls if in a control region
-    std::vector<cudaq::QuditInfo> mutable_controls;
+    auto [kind, name] = internGateName(gateName);
+
+    QueuedInstruction inst{name,
+                           kind,
+                           static_cast<std::uint32_t>(paramArena.size()),
+                           static_cast<std::uint32_t>(params.size()),
+                           static_cast<std::uint32_t>(quditArena.size()),
+                           static_cast<std::uint32_t>(extraControlIds.size() +
+                                                      controls.size()),
+                           0,
+                           static_cast<std::uint32_t>(targets.size()),
+                           -1};
+
+    // Prepend any extra controls if in a control region
     for (auto &e : extraControlIds)
-      mutable_controls.emplace_back(2, e);
-
-    for (auto &e : controls)
-      mutable_controls.push_back(e);
-
-    std::vector<cudaq::QuditInfo> mutable_targets;
-    for (auto &t : targets)
-      mutable_targets.push_back(t);
+      quditArena.emplace_back(2, e);
+    quditArena.insert(quditArena.end(), controls.begin(), controls.end());
+    inst.targetsBegin = static_cast<std::uint32_t>(quditArena.size());
+    quditArena.insert(quditArena.end(), targets.begin(), targets.end());
 
     // We need to check if we need take the adjoint of the operation. To do this
     // we use a logical XOR between `isAdjoint` and whether the size of
@@ -218,33 +324,36 @@ public:
     //
     bool evenAdjointStack = (adjointQueueStack.size() % 2) == 0;
     if (isAdjoint != !evenAdjointStack) {
-      if (gateName == "u3") {
-        mutable_params[0] = -1.0 * params[0];
-        mutable_params[1] = -1.0 * params[2];
-        mutable_params[2] = -1.0 * params[1];
-      } else if (gateName == "u2") {
-        mutable_params[0] = -1.0 * params[1] - M_PI;
-        mutable_params[1] = -1.0 * params[0] + M_PI;
+      if (kind == GateKind::u3) {
+        paramArena.push_back(-1.0 * params[0]);
+        paramArena.push_back(-1.0 * params[2]);
+        paramArena.push_back(-1.0 * params[1]);
+      } else if (kind == GateKind::u2) {
+        paramArena.push_back(-1.0 * params[1] - M_PI);
+        paramArena.push_back(-1.0 * params[0] + M_PI);
       } else {
-        for (std::size_t i = 0; i < params.size(); i++)
-          mutable_params[i] = -1.0 * params[i];
+        for (auto param : params)
+          paramArena.push_back(-1.0 * param);
       }
-      if (gateName == "t")
-        mutable_name = "tdg";
-      else if (gateName == "s")
-        mutable_name = "sdg";
+      if (kind == GateKind::t)
+        std::tie(inst.kind, inst.name) = internGateName("tdg");
+      else if (kind == GateKind::s)
+        std::tie(inst.kind, inst.name) = internGateName("sdg");
+    } else {
+      paramArena.insert(paramArena.end(), params.begin(), params.end());
     }
 
+    if (kind == GateKind::exp_pauli || !op.is_identity()) {
+      inst.spinOp = static_cast<std::int32_t>(spinOpArena.size());
+      spinOpArena.push_back(std::move(op));
+    }
+
+    // Add to the adjoint instruction queue, or to the instruction queue
     if (!adjointQueueStack.empty()) {
-      // Add to the adjoint instruction queue
-      adjointQueueStack.back().emplace_back(
-          mutable_name, mutable_params, mutable_controls, mutable_targets, op);
+      adjointQueueStack.back().push_back(inst);
       return;
     }
-
-    // Add to the instruction queue
-    instructionQueue.emplace_back(std::move(mutable_name), mutable_params,
-                                  mutable_controls, mutable_targets, op);
+    instructionQueue.push_back(inst);
   }
 
   void applyNoise(const kraus_channel &channel,
@@ -253,17 +362,20 @@ public:
   }
 
   void synchronize() override {
-    for (auto &instruction : instructionQueue) {
+    for (auto &queued : instructionQueue) {
+      auto instruction = getInstruction(queued);
       if (!isInTracerMode()) {
         executeInstruction(instruction);
         continue;
       }
 
-      auto &&[name, params, controls, targets, op] = instruction;
-      executionContext->kernelTrace.appendInstruction(name, params, controls,
-                                                      targets);
+      executionContext->kernelTrace.appendInstruction(
+          instruction.name,
+          {instruction.params.begin(), instruction.params.end()},
+          {instruction.controls.begin(), instruction.controls.end()},
+          {instruction.targets.begin(), instruction.targets.end()});
     }
-    instructionQueue.clear();
+    clearInstructionQueue();
   }
 
   int measure(const cudaq::QuditInfo &target,
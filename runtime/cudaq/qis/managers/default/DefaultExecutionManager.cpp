@@ -12,7 +12,6 @@
 #include "cudaq/qis/qudit.h"
 #include "cudaq/utils/cudaq_utils.h"
 #include "nvqir/CircuitSimulator.h"
-#include "llvm/ADT/StringSwitch.h"
 #include <span>
 
 namespace nvqir {
@@ -43,6 +42,10 @@ private:
     requestedAllocations.clear();
   }
 
+  /// @brief The target and control qubits of the instruction being executed.
+  std::vector<std::size_t> targetIds;
+  std::vector<std::size_t> controlIds;
+
 protected:
   void allocateQudit(const cudaq::QuditInfo &q) override {
     requestedAllocations.emplace_back(2, q.id);
@@ -165,60 +168,70 @@ protected:
     flushRequestedAllocations();
 
     // Get the data, create the Qubit* targets
-    auto [gateName, parameters, controls, targets, op] = instruction;
+    const auto &[gateName, kind, parameters, controls, targets, op] =
+        instruction;
 
-    // Map the Qudits to Qubits
-    std::vector<std::size_t> localT;
-    std::transform(targets.begin(), targets.end(), std::back_inserter(localT),
+    // Map the Qudits to Qubits, reusing the storage of the previous gate
+    targetIds.clear();
+    std::transform(targets.begin(), targets.end(),
+                   std::back_inserter(targetIds),
                    [](auto &&el) { return el.id; });
-    std::vector<std::size_t> localC;
-    std::transform(controls.begin(), controls.end(), std::back_inserter(localC),
+    controlIds.clear();
+    std::transform(controls.begin(), controls.end(),
+                   std::back_inserter(controlIds),
                    [](auto &&el) { return el.id; });
 
     // Apply the gate
-    llvm::StringSwitch<std::function<void()>>(gateName)
-        .Case("h", [&]() { simulator()->h(localC, localT[0]); })
-        .Case("x", [&]() { simulator()->x(localC, localT[0]); })
-        .Case("y", [&]() { simulator()->y(localC, localT[0]); })
-        .Case("z", [&]() { simulator()->z(localC, localT[0]); })
-        .Case("rx",
-              [&]() { simulator()->rx(parameters[0], localC, localT[0]); })
-        .Case("ry",
-              [&]() { simulator()->ry(parameters[0], localC, localT[0]); })
-        .Case("rz",
-              [&]() { simulator()->rz(parameters[0], localC, localT[0]); })
-        .Case("s", [&]() { simulator()->s(localC, localT[0]); })
-        .Case("t", [&]() { simulator()->t(localC, localT[0]); })
-        .Case("sdg", [&]() { simulator()->sdg(localC, localT[0]); })
-        .Case("tdg", [&]() { simulator()->tdg(localC, localT[0]); })
-        .Case("r1",
-              [&]() { simulator()->r1(parameters[0], localC, localT[0]); })
-        .Case("u1",
-              [&]() { simulator()->u1(parameters[0], localC, localT[0]); })
-        .Case("u3",
-              [&]() {
-                simulator()->u3(parameters[0], parameters[1], parameters[2],
-                                localC, localT[0]);
-              })
-        .Case("swap",
-              [&]() { simulator()->swap(localC, localT[0], localT[1]); })
-        .Case("exp_pauli",
-              [&]() {
-                simulator()->applyExpPauli(parameters[0], localC, localT, op);
-              })
-        .Default([&]() {
-          if (cudaq::customOpRegistry::getInstance().isOperationRegistered(
-                  gateName)) {
-            const auto &op =
-                cudaq::customOpRegistry::getInstance().getOperation(gateName);
-            auto data = op.unitary(parameters);
-            simulator()->applyCustomOperation(data, localC, localT, gateName);
-            return;
-          }
-          throw std::runtime_error("[DefaultExecutionManager] invalid gate "
-                                   "application requested " +
-                                   gateName + ".");
-        })();
+    switch (kind) {
+    case GateKind::h:
+      return simulator()->h(controlIds, targetIds[0]);
+    case GateKind::x:
+      return simulator()->x(controlIds, targetIds[0]);
+    case GateKind::y:
+      return simulator()->y(controlIds, targetIds[0]);
+    case GateKind::z:
+      return simulator()->z(controlIds, targetIds[0]);
+    case GateKind::rx:
+      return simulator()->rx(parameters[0], controlIds, targetIds[0]);
+    case GateKind::ry:
+      return simulator()->ry(parameters[0], controlIds, targetIds[0]);
+    case GateKind::rz:
+      return simulator()->rz(parameters[0], controlIds, targetIds[0]);
+    case GateKind::s:
+      return simulator()->s(controlIds, targetIds[0]);
+    case GateKind::t:
+      return simulator()->t(controlIds, targetIds[0]);
+    case GateKind::sdg:
+      return simulator()->sdg(controlIds, targetIds[0]);
+    case GateKind::tdg:
+      return simulator()->tdg(controlIds, targetIds[0]);
+    case GateKind::r1:
+      return simulator()->r1(parameters[0], controlIds, targetIds[0]);
+    case GateKind::u1:
+      return simulator()->u1(parameters[0], controlIds, targetIds[0]);
+    case GateKind::u3:
+      return simulator()->u3(parameters[0], parameters[1], parameters[2],
+                             controlIds, targetIds[0]);
+    case GateKind::swap:
+      return simulator()->swap(controlIds, targetIds[0], targetIds[1]);
+    case GateKind::exp_pauli:
+      return simulator()->applyExpPauli(parameters[0], controlIds, targetIds,
+                                        op);
+    default:
+      break;
+    }
+
+    std::string name(gateName);
+    if (cudaq::customOpRegistry::getInstance().isOperationRegistered(name)) {
+      auto unitary = cudaq::customOpRegistry::getInstance().getUnitary(
+          name, {parameters.begin(), parameters.end()});
+      simulator()->applyCachedCustomOperation(*unitary, controlIds, targetIds,
+                                              name);
+      return;
+    }
+    throw std::runtime_error("[DefaultExecutionManager] invalid gate "
+                             "application requested " +
+                             name + ".");
   }
 
   void applyNoise(const kraus_channel &channel,
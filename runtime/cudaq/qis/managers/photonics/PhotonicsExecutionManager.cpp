@@ -220,7 +220,7 @@ protected:
 
   /// @brief Method for executing instructions.
   void executeInstruction(const Instruction &instruction) override {
-    auto operation = instructions[std::get<0>(instruction)];
+    auto operation = instructions[std::string(instruction.name)];
     operation(instruction);
   }
 
@@ -355,7 +355,7 @@ public:
   PhotonicsExecutionManager() {
 
     instructions.emplace("create", [&](const Instruction &inst) {
-      auto &[gateName, params, controls, qudits, spin_op] = inst;
+      auto &[gateName, kind, params, controls, qudits, spin_op] = inst;
       auto target = qudits[0];
       int d = target.levels;
       qpp::cmat u{qpp::cmat::Zero(d, d)};
@@ -368,7 +368,7 @@ public:
     });
 
     instructions.emplace("annihilate", [&](const Instruction &inst) {
-      auto &[gateName, params, controls, qudits, spin_op] = inst;
+      auto &[gateName, kind, params, controls, qudits, spin_op] = inst;
       auto target = qudits[0];
       int d = target.levels;
       qpp::cmat u{qpp::cmat::Zero(d, d)};
@@ -381,7 +381,7 @@ public:
     });
 
     instructions.emplace("plus", [&](const Instruction &inst) {
-      auto &[gateName, params, controls, qudits, spin_op] = inst;
+      auto &[gateName, kind, params, controls, qudits, spin_op] = inst;
       auto target = qudits[0];
       int d = target.levels;
       qpp::cmat u{qpp::cmat::Zero(d, d)};
@@ -394,7 +394,7 @@ public:
     });
 
     instructions.emplace("beam_splitter", [&](const Instruction &inst) {
-      auto &[gateName, params, controls, qudits, spin_op] = inst;
+      auto &[gateName, kind, params, controls, qudits, spin_op] = inst;
       auto target1 = qudits[0];
       auto target2 = qudits[1];
       size_t d = target1.levels;
@@ -407,7 +407,7 @@ public:
     });
 
     instructions.emplace("phase_shift", [&](const Instruction &inst) {
-      auto &[gateName, params, controls, qudits, spin_op] = inst;
+      auto &[gateName, kind, params, controls, qudits, spin_op] = inst;
       auto target = qudits[0];
       size_t d = target.levels;
       const double phi = params[0];
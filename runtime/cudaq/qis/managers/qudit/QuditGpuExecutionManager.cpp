@@ -0,0 +1,404 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "QuditStateVector.h"
+#include "common/FmtCore.h"
+#include "common/Logger.h"
+#include "cudaq/qis/managers/BasicExecutionManager.h"
+#include "nvqir/Gates.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+namespace cudaq {
+
+std::size_t get_random_seed();
+
+/// @brief The `QuditGpuExecutionManager` simulates qudits of any number of
+/// levels on the GPU. The state vector is stored in a mixed-radix layout, see
+/// `QuditStateVector.h`, in which each allocated qudit is a new most
+/// significant digit. Gates on a single qudit, with any number of controls, are
+/// applied by a dedicated kernel, or by a kernel for diagonal gates when the
+/// gate matrix is diagonal, e.g., `phase_shift`. Gates on several qudits, e.g.,
+/// `beam_splitter`, are applied by a generic kernel.
+class QuditGpuExecutionManager : public cudaq::BasicExecutionManager {
+private:
+  /// @brief The device state vector, null when no qudit is allocated.
+  void *state = nullptr;
+
+  /// @brief The dimension of the state vector.
+  std::int64_t stateDimension = 1;
+
+  /// @brief The digit of each allocated qudit. The amplitudes of deallocated
+  /// qudits are kept until all the qudits are deallocated.
+  std::unordered_map<std::size_t, quditsv::Digit> digits;
+
+  /// @brief Qudits to be sampled
+  std::vector<cudaq::QuditInfo> sampleQudits;
+
+  /// @brief The last random seed set by the user.
+  std::size_t randomSeed = 0;
+
+  std::mt19937_64 randomEngine{std::random_device{}()};
+
+  /// @brief The gate matrix being built, reused across gates.
+  std::vector<std::complex<double>> matrix;
+
+  /// @brief Return the digit of qudit `q`.
+  quditsv::Digit getDigit(const cudaq::QuditInfo &q) const {
+    auto iter = digits.find(q.id);
+    if (iter == digits.end())
+      throw std::runtime_error(cudaq_fmt::format(
+          "[qudit-gpu] qudit {} is not allocated.", q.id));
+    return iter->second;
+  }
+
+  /// @brief Write the row-major matrix of the gate of `inst` to `matrix`.
+  void getGateMatrix(const Instruction &inst) {
+    const std::string name(inst.name);
+    std::int64_t dim = 1;
+    for (const auto &target : inst.targets)
+      dim *= target.levels;
+    matrix.assign(dim * dim, 0.0);
+
+    if (cudaq::customOpRegistry::getInstance().isOperationRegistered(name)) {
+      auto unitary = cudaq::customOpRegistry::getInstance().getUnitary(
+          name, {inst.params.begin(), inst.params.end()});
+      const auto &data = unitary->fp64;
+      if (static_cast<std::int64_t>(data.size()) != dim * dim)
+        throw std::runtime_error(cudaq_fmt::format(
+            "[qudit-gpu] custom operation {} has {} matrix elements, expected "
+            "{} for its targets.",
+            name, data.size(), dim * dim));
+      matrix.assign(data.begin(), data.end());
+      return;
+    }
+
+    const std::int64_t d = inst.targets[0].levels;
+    if (name == "create") {
+      matrix[(d - 1) * d + d - 1] = 1.0;
+      for (std::int64_t i = 1; i < d; ++i)
+        matrix[i * d + i - 1] = 1.0;
+    } else if (name == "annihilate") {
+      matrix[0] = 1.0;
+      for (std::int64_t i = 0; i < d - 1; ++i)
+        matrix[i * d + i + 1] = 1.0;
+    } else if (name == "plus") {
+      matrix[d - 1] = 1.0;
+      for (std::int64_t i = 1; i < d; ++i)
+        matrix[i * d + i - 1] = 1.0;
+    } else if (name == "phase_shift") {
+      const std::complex<double> i(0.0, 1.0);
+      for (std::int64_t n = 0; n < d; ++n)
+        matrix[n * d + n] = std::exp(static_cast<double>(n) * inst.params[0] *
+                                     i);
+    } else if (name == "beam_splitter") {
+      if (inst.targets.size() != 2 ||
+          inst.targets[1].levels != inst.targets[0].levels)
+        throw std::runtime_error("[qudit-gpu] beam_splitter expects two "
+                                 "qudits of the same levels.");
+      beamSplitter(inst.params[0], d);
+    } else if (std::all_of(inst.targets.begin(), inst.targets.end(),
+                           [](const auto &t) { return t.levels == 2; })) {
+      nvqir::getGateByName<double>(nvqir::getGateNameFromString(name),
+                                   inst.params, matrix);
+    } else {
+      throw std::runtime_error(cudaq_fmt::format(
+          "[qudit-gpu] invalid gate application requested {}.", name));
+    }
+  }
+
+  /// @brief Returns the factorial of n, for n up to 30
+  static double factorial(int n) {
+    if (n > 30)
+      throw std::invalid_argument("received invalid value, n <= 30");
+    double result = 1.;
+    for (int k = 2; k <= n; ++k)
+      result *= k;
+    return result;
+  }
+
+  /// @brief Computes a single element in the matrix representing a beam
+  /// splitter gate
+  static double beamSplitterElement(int N1, int N2, int n1, int n2,
+                                    double theta) {
+    const double t = std::cos(theta); // transmission coefficient
+    const double r = std::sin(theta); // reflection coefficient
+    double sum = 0;
+    for (int k = 0; k <= n1; ++k) {
+      const int l = N1 - k;
+      if (l < 0 || l > n2)
+        continue;
+      const double term1 = std::pow(r, n1 - k + l) * std::pow(t, n2 + k - l);
+      if (term1 == 0)
+        continue;
+      const double term2 =
+          std::pow(-1, l) * std::sqrt(factorial(n1) * factorial(n2) *
+                                      factorial(N1) * factorial(N2));
+      const double term3 =
+          factorial(k) * factorial(n1 - k) * factorial(l) * factorial(n2 - l);
+      sum += term1 * term2 / term3;
+    }
+    return sum;
+  }
+
+  /// @brief Write the beam splitter matrix on two qudits of `d` levels to
+  /// `matrix`, as the photonics execution manager does.
+  void beamSplitter(double theta, std::int64_t d) {
+    for (int n1 = 0; n1 < d; ++n1)
+      for (int n2 = 0; n2 < d; ++n2) {
+        const int nxx = n1 + n2;
+        const int nxd = std::min<int>(nxx + 1, d);
+        for (int N1 = 0; N1 < nxd; ++N1) {
+          const int N2 = nxx - N1;
+          if (N2 < nxd)
+            matrix[(n1 * d + n2) * d * d + N1 * d + N2] =
+                beamSplitterElement(N1, N2, n1, n2, theta);
+        }
+      }
+  }
+
+  /// @brief Draw a level of qudit `q` and collapse the state onto it.
+  std::int64_t measureAndCollapse(const cudaq::QuditInfo &q) {
+    const auto digit = getDigit(q);
+    const auto probabilities =
+        quditsv::marginalProbabilities(state, stateDimension, {digit});
+    std::discrete_distribution<std::int64_t> distribution(
+        probabilities.begin(), probabilities.end());
+    const auto level = distribution(randomEngine);
+    quditsv::collapse(state, stateDimension, digit, level,
+                      probabilities[level]);
+    return level;
+  }
+
+protected:
+  void allocateQudit(const cudaq::QuditInfo &q) override {
+    if (q.levels < 2 ||
+        static_cast<std::int64_t>(q.levels) > quditsv::maxLevels)
+      throw std::runtime_error(cudaq_fmt::format(
+          "[qudit-gpu] qudits of {} levels are not supported, expected 2 to "
+          "{} levels.",
+          q.levels, quditsv::maxLevels));
+    const std::int64_t newDimension = stateDimension * q.levels;
+    state = state ? quditsv::growState(state, stateDimension, newDimension)
+                  : quditsv::allocateState(newDimension);
+    digits[q.id] = {stateDimension, static_cast<std::int64_t>(q.levels)};
+    stateDimension = newDimension;
+    CUDAQ_INFO("Allocated qudit {}<{}>, state dimension {}", q.id, q.levels,
+               stateDimension);
+  }
+
+  void allocateQudits(const std::vector<cudaq::QuditInfo> &qudits) override {
+    for (auto &q : qudits)
+      allocateQudit(q);
+  }
+
+  /// @brief Initialize a single qudit, in |0> since it was just allocated, to
+  /// `data` by applying a matrix whose first column is `data`.
+  void initializeState(const std::vector<cudaq::QuditInfo> &targets,
+                       const void *data,
+                       simulation_precision precision) override {
+    if (targets.size() != 1)
+      throw std::runtime_error("[qudit-gpu] initializeState is only supported "
+                               "for a single qudit.");
+    const auto digit = getDigit(targets[0]);
+    matrix.assign(digit.levels * digit.levels, 0.0);
+    for (std::int64_t l = 0; l < digit.levels; ++l)
+      matrix[l * digit.levels] =
+          precision == simulation_precision::fp32
+              ? std::complex<double>(
+                    static_cast<const std::complex<float> *>(data)[l])
+              : static_cast<const std::complex<double> *>(data)[l];
+    quditsv::applySingleQudit(state, stateDimension, matrix.data(), digit, {});
+  }
+
+  void initializeState(const std::vector<QuditInfo> &targets,
+                       const SimulationState *state) override {
+    throw std::runtime_error("[qudit-gpu] initializeState from a state is not "
+                             "supported.");
+  }
+
+  void deallocateQudit(const cudaq::QuditInfo &q) override {
+    digits.erase(q.id);
+    if (!digits.empty() || !state)
+      return;
+    quditsv::freeState(state);
+    state = nullptr;
+    stateDimension = 1;
+  }
+
+  void deallocateQudits(const std::vector<cudaq::QuditInfo> &qudits) override {
+    for (auto &q : qudits)
+      deallocateQudit(q);
+  }
+
+  void handleExecutionContextChanged() override {
+    if (!executionContext)
+      throw std::runtime_error(
+          "Execution context is not set for the QuditGpuExecutionManager.");
+
+    if (!(executionContext->name == "sample" ||
+          executionContext->name == "tracer"))
+      throw std::runtime_error(executionContext->name +
+                               " is not supported on this target");
+
+    if (const auto seed = cudaq::get_random_seed();
+        seed != 0 && seed != randomSeed) {
+      randomSeed = seed;
+      randomEngine.seed(seed);
+    }
+  }
+
+  /// @brief Sample the measured qudits, or all the qudits if none was measured,
+  /// from their joint probabilities.
+  void handleExecutionContextEnded() override {
+    if (!executionContext || executionContext->name != "sample" || !state) {
+      sampleQudits.clear();
+      return;
+    }
+
+    if (sampleQudits.empty()) {
+      for (auto &[id, digit] : digits)
+        sampleQudits.emplace_back(digit.levels, id);
+      std::sort(sampleQudits.begin(), sampleQudits.end(),
+                [](const auto &a, const auto &b) { return a.id < b.id; });
+    }
+    std::vector<quditsv::Digit> sampled;
+    for (auto &q : sampleQudits)
+      sampled.push_back(getDigit(q));
+    const auto probabilities =
+        quditsv::marginalProbabilities(state, stateDimension, sampled);
+
+    CUDAQ_INFO("Sampling {} qudits", sampled.size());
+    std::discrete_distribution<std::int64_t> distribution(
+        probabilities.begin(), probabilities.end());
+    std::unordered_map<std::int64_t, std::size_t> outcomes;
+    for (std::size_t shot = 0; shot < executionContext->shots; ++shot)
+      ++outcomes[distribution(randomEngine)];
+
+    cudaq::ExecutionResult counts;
+    std::vector<std::int64_t> levels(sampled.size());
+    for (const auto &[outcome, count] : outcomes) {
+      auto rest = outcome;
+      for (std::size_t k = sampled.size(); k-- > 0;) {
+        levels[k] = rest % sampled[k].levels;
+        rest /= sampled[k].levels;
+      }
+      std::stringstream bitstring;
+      for (auto level : levels)
+        bitstring << level;
+      counts.appendResult(bitstring.str(), count);
+    }
+    executionContext->result.append(counts);
+    sampleQudits.clear();
+  }
+
+  void executeInstruction(const Instruction &instruction) override {
+    const auto &targets = instruction.targets;
+    if (targets.empty())
+      return;
+    if (static_cast<int>(instruction.controls.size()) > quditsv::maxControls)
+      throw std::runtime_error(cudaq_fmt::format(
+          "[qudit-gpu] {} has {} controls, at most {} are supported.",
+          instruction.name, instruction.controls.size(),
+          quditsv::maxControls));
+    quditsv::Controls controls;
+    for (const auto &control : instruction.controls)
+      controls.digits[controls.size++] = getDigit(control);
+
+    getGateMatrix(instruction);
+    CUDAQ_INFO("Applying {} on {} qudits with {} controls", instruction.name,
+               targets.size(), instruction.controls.size());
+    if (targets.size() == 1) {
+      const auto target = getDigit(targets[0]);
+      const std::int64_t d = target.levels;
+      bool isDiagonal = true;
+      for (std::int64_t r = 0; r < d && isDiagonal; ++r)
+        for (std::int64_t c = 0; c < d && isDiagonal; ++c)
+          isDiagonal = r == c || matrix[r * d + c] == 0.0;
+      if (!isDiagonal) {
+        quditsv::applySingleQudit(state, stateDimension, matrix.data(), target,
+                                  controls);
+        return;
+      }
+      for (std::int64_t n = 0; n < d; ++n)
+        matrix[n] = matrix[n * d + n];
+      quditsv::applyDiagonal(state, stateDimension, matrix.data(), target,
+                             controls);
+      return;
+    }
+
+    std::vector<quditsv::Digit> targetDigits;
+    std::int64_t gateDimension = 1;
+    for (const auto &target : targets) {
+      targetDigits.push_back(getDigit(target));
+      gateDimension *= target.levels;
+    }
+    if (static_cast<int>(targets.size()) > quditsv::maxTargets ||
+        gateDimension > quditsv::maxGateDimension)
+      throw std::runtime_error(cudaq_fmt::format(
+          "[qudit-gpu] {} acts on {} qudits of dimension {}, at most {} "
+          "qudits of dimension {} are supported.",
+          instruction.name, targets.size(), gateDimension,
+          quditsv::maxTargets, quditsv::maxGateDimension));
+    quditsv::applyMultiQudit(state, stateDimension, matrix.data(),
+                             targetDigits, controls);
+  }
+
+  int measureQudit(const cudaq::QuditInfo &q,
+                   const std::string &registerName) override {
+    if (executionContext && executionContext->name == "sample") {
+      sampleQudits.push_back(q);
+      return 0;
+    }
+
+    const auto level = measureAndCollapse(q);
+    CUDAQ_INFO("Measured qudit {} -> {}", q.id, level);
+    return level;
+  }
+
+  void measureSpinOp(const cudaq::spin_op &) override {
+    throw std::runtime_error("[qudit-gpu] spin_op observation is not "
+                             "supported.");
+  }
+
+  /// @brief Measure the qudit, and map the measured level to |0>.
+  void resetQudit(const cudaq::QuditInfo &q) override {
+    const auto level = measureAndCollapse(q);
+    if (level == 0)
+      return;
+    const auto digit = getDigit(q);
+    matrix.assign(digit.levels * digit.levels, 0.0);
+    for (std::int64_t l = 0; l < digit.levels; ++l)
+      matrix[l * digit.levels + l] = 1.0;
+    matrix[0] = matrix[level * digit.levels + level] = 0.0;
+    matrix[level] = matrix[level * digit.levels] = 1.0;
+    quditsv::applySingleQudit(state, stateDimension, matrix.data(), digit, {});
+  }
+
+public:
+  QuditGpuExecutionManager() = default;
+
+  virtual ~QuditGpuExecutionManager() {
+    if (state)
+      quditsv::freeState(state);
+  }
+
+  cudaq::SpinMeasureResult measure(const cudaq::spin_op &op) override {
+    throw std::runtime_error("spin_op observation (cudaq::observe()) is not "
+                             "supported for the qudit GPU simulator.");
+  }
+
+}; // QuditGpuExecutionManager
+
+} // namespace cudaq
+
+CUDAQ_REGISTER_EXECUTION_MANAGER(QuditGpuExecutionManager, qudit_gpu)
@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "QuditStateVector.h"
+#include "cuComplex.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#define HANDLE_CUDA_ERROR(x)                                                   \
+  {                                                                            \
+    const auto err = x;                                                        \
+    if (err != cudaSuccess)                                                    \
+      throw std::runtime_error(std::string("[qudit-gpu] ") +                   \
+                               cudaGetErrorString(err) + " in " +              \
+                               __FUNCTION__ + " (line " +                      \
+                               std::to_string(__LINE__) + ")");                \
+  }
+
+namespace cudaq::quditsv {
+
+namespace {
+
+constexpr int threadsPerBlock = 256;
+
+/// @brief The targets of a multi-qudit gate, by ascending stride.
+struct Targets {
+  int size = 0;
+  Digit digits[maxTargets];
+};
+
+/// @brief The matrix of the single-qudit gate being applied.
+__constant__ cuDoubleComplex singleQuditMatrix[maxLevels * maxLevels];
+
+/// @brief The phases of the diagonal gate being applied.
+__constant__ cuDoubleComplex diagonalPhases[maxLevels];
+
+/// @brief The offsets of the amplitudes of a multi-qudit gate from the first
+/// one of their group, in the order of the rows of the matrix.
+__constant__ std::int64_t multiQuditOffsets[maxGateDimension];
+
+/// @brief The matrix of the multi-qudit gate being applied. It is too large
+/// for constant memory, and is allocated on first use, until the state vector
+/// is freed.
+cuDoubleComplex *multiQuditMatrix = nullptr;
+
+std::int64_t numBlocks(std::int64_t numThreads) {
+  return (numThreads + threadsPerBlock - 1) / threadsPerBlock;
+}
+
+__device__ bool controlsActive(std::int64_t index, const Controls &controls) {
+  for (int c = 0; c < controls.size; ++c)
+    if ((index / controls.digits[c].stride) % controls.digits[c].levels != 1)
+      return false;
+  return true;
+}
+
+__global__ void setFirstElement(cuDoubleComplex *sv, std::int64_t dim) {
+  const std::int64_t i =
+      static_cast<std::int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i < dim)
+    sv[i] = make_cuDoubleComplex(i == 0 ? 1.0 : 0.0, 0.0);
+}
+
+__global__ void diagonalKernel(cuDoubleComplex *sv, std::int64_t dim,
+                               Digit target, Controls controls) {
+  const std::int64_t i =
+      static_cast<std::int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i >= dim || !controlsActive(i, controls))
+    return;
+  sv[i] = cuCmul(sv[i], diagonalPhases[(i / target.stride) % target.levels]);
+}
+
+/// @brief Each thread applies the matrix to one group of `target.levels`
+/// amplitudes.
+__global__ void singleQuditKernel(cuDoubleComplex *sv, std::int64_t numGroups,
+                                  Digit target, Controls controls) {
+  const std::int64_t g =
+      static_cast<std::int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (g >= numGroups)
+    return;
+  const std::int64_t stride = target.stride;
+  const std::int64_t base =
+      (g / stride) * stride * target.levels + g % stride;
+  if (!controlsActive(base, controls))
+    return;
+
+  const int d = target.levels;
+  cuDoubleComplex in[maxLevels];
+  for (int k = 0; k < d; ++k)
+    in[k] = sv[base + k * stride];
+  for (int r = 0; r < d; ++r) {
+    cuDoubleComplex acc = make_cuDoubleComplex(0.0, 0.0);
+    for (int c = 0; c < d; ++c)
+      acc = cuCadd(acc, cuCmul(singleQuditMatrix[r * d + c], in[c]));
+    sv[base + r * stride] = acc;
+  }
+}
+
+/// @brief Each thread applies the matrix to one group of `gateDim`
+/// amplitudes, whose index without the target digits is the thread index.
+__global__ void multiQuditKernel(cuDoubleComplex *sv, std::int64_t numGroups,
+                                 const cuDoubleComplex *__restrict__ matrix,
+                                 int gateDim, Targets targets,
+                                 Controls controls) {
+  const std::int64_t g =
+      static_cast<std::int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (g >= numGroups)
+    return;
+  // Insert the target digits, at 0, from the least significant one.
+  std::int64_t base = g;
+  for (int t = 0; t < targets.size; ++t) {
+    const std::int64_t stride = targets.digits[t].stride;
+    base = (base / stride) * stride * targets.digits[t].levels + base % stride;
+  }
+  if (!controlsActive(base, controls))
+    return;
+
+  cuDoubleComplex in[maxGateDimension];
+  for (int k = 0; k < gateDim; ++k)
+    in[k] = sv[base + multiQuditOffsets[k]];
+  for (int r = 0; r < gateDim; ++r) {
+    cuDoubleComplex acc = make_cuDoubleComplex(0.0, 0.0);
+    for (int c = 0; c < gateDim; ++c)
+      acc = cuCadd(acc, cuCmul(matrix[r * gateDim + c], in[c]));
+    sv[base + multiQuditOffsets[r]] = acc;
+  }
+}
+
+__global__ void marginalKernel(const cuDoubleComplex *sv, std::int64_t dim,
+                               const Digit *digits, int numDigits,
+                               double *probabilities) {
+  const std::int64_t i =
+      static_cast<std::int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i >= dim)
+    return;
+  const double p = sv[i].x * sv[i].x + sv[i].y * sv[i].y;
+  if (p == 0.0)
+    return;
+  std::int64_t index = 0;
+  for (int k = 0; k < numDigits; ++k)
+    index = index * digits[k].levels +
+            (i / digits[k].stride) % digits[k].levels;
+  atomicAdd(probabilities + index, p);
+}
+
+__global__ void collapseKernel(cuDoubleComplex *sv, std::int64_t dim,
+                               Digit digit, std::int64_t level, double scale) {
+  const std::int64_t i =
+      static_cast<std::int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i >= dim)
+    return;
+  if ((i / digit.stride) % digit.levels == level)
+    sv[i] = make_cuDoubleComplex(sv[i].x * scale, sv[i].y * scale);
+  else
+    sv[i] = make_cuDoubleComplex(0.0, 0.0);
+}
+
+} // namespace
+
+void *allocateState(std::int64_t dim) {
+  void *state = nullptr;
+  HANDLE_CUDA_ERROR(cudaMalloc(&state, dim * sizeof(cuDoubleComplex)));
+  setFirstElement<<<numBlocks(dim), threadsPerBlock>>>(
+      static_cast<cuDoubleComplex *>(state), dim);
+  HANDLE_CUDA_ERROR(cudaGetLastError());
+  return state;
+}
+
+void *growState(void *state, std::int64_t dim, std::int64_t newDim) {
+  // The new digits are the most significant ones, so the amplitudes of the
+  // old state are the first ones of the new state.
+  void *newState = nullptr;
+  HANDLE_CUDA_ERROR(cudaMalloc(&newState, newDim * sizeof(cuDoubleComplex)));
+  HANDLE_CUDA_ERROR(
+      cudaMemcpy(newState, state, dim * sizeof(cuDoubleComplex),
+                 cudaMemcpyDeviceToDevice));
+  HANDLE_CUDA_ERROR(
+      cudaMemset(static_cast<cuDoubleComplex *>(newState) + dim, 0,
+                 (newDim - dim) * sizeof(cuDoubleComplex)));
+  HANDLE_CUDA_ERROR(cudaFree(state));
+  return newState;
+}
+
+void freeState(void *state) {
+  // Also called at exit, when the CUDA runtime may already be unloaded, so the
+  // errors are ignored.
+  cudaFree(state);
+  if (multiQuditMatrix) {
+    cudaFree(multiQuditMatrix);
+    multiQuditMatrix = nullptr;
+  }
+}
+
+void applyDiagonal(void *state, std::int64_t dim,
+                   const std::complex<double> *phases, Digit target,
+                   const Controls &controls) {
+  HANDLE_CUDA_ERROR(cudaMemcpyToSymbol(
+      diagonalPhases, phases, target.levels * sizeof(cuDoubleComplex)));
+  diagonalKernel<<<numBlocks(dim), threadsPerBlock>>>(
+      static_cast<cuDoubleComplex *>(state), dim, target, controls);
+  HANDLE_CUDA_ERROR(cudaGetLastError());
+}
+
+void applySingleQudit(void *state, std::int64_t dim,
+                      const std::complex<double> *matrix, Digit target,
+                      const Controls &controls) {
+  HANDLE_CUDA_ERROR(cudaMemcpyToSymbol(
+      singleQuditMatrix, matrix,
+      target.levels * target.levels * sizeof(cuDoubleComplex)));
+  const std::int64_t numGroups = dim / target.levels;
+  singleQuditKernel<<<numBlocks(numGroups), threadsPerBlock>>>(
+      static_cast<cuDoubleComplex *>(state), numGroups, target, controls);
+  HANDLE_CUDA_ERROR(cudaGetLastError());
+}
+
+void applyMultiQudit(void *state, std::int64_t dim,
+                     const std::complex<double> *matrix,
+                     const std::vector<Digit> &targets,
+                     const Controls &controls) {
+  // The offset of row r of the matrix, whose first target is the most
+  // significant digit.
+  std::int64_t gateDim = 1;
+  for (const auto &target : targets)
+    gateDim *= target.levels;
+  std::vector<std::int64_t> offsets(gateDim);
+  for (std::int64_t r = 0; r < gateDim; ++r) {
+    std::int64_t rest = r;
+    for (auto iter = targets.rbegin(); iter != targets.rend(); ++iter) {
+      offsets[r] += (rest % iter->levels) * iter->stride;
+      rest /= iter->levels;
+    }
+  }
+  Targets sorted;
+  sorted.size = targets.size();
+  std::copy(targets.begin(), targets.end(), sorted.digits);
+  std::sort(sorted.digits, sorted.digits + sorted.size,
+            [](const Digit &a, const Digit &b) { return a.stride < b.stride; });
+
+  if (!multiQuditMatrix)
+    HANDLE_CUDA_ERROR(cudaMalloc(&multiQuditMatrix,
+                                 maxGateDimension * maxGateDimension *
+                                     sizeof(cuDoubleComplex)));
+  HANDLE_CUDA_ERROR(cudaMemcpy(multiQuditMatrix, matrix,
+                               gateDim * gateDim * sizeof(cuDoubleComplex),
+                               cudaMemcpyHostToDevice));
+  HANDLE_CUDA_ERROR(cudaMemcpyToSymbol(multiQuditOffsets, offsets.data(),
+                                       gateDim * sizeof(std::int64_t)));
+  const std::int64_t numGroups = dim / gateDim;
+  multiQuditKernel<<<numBlocks(numGroups), threadsPerBlock>>>(
+      static_cast<cuDoubleComplex *>(state), numGroups, multiQuditMatrix,
+      gateDim, sorted, controls);
+  HANDLE_CUDA_ERROR(cudaGetLastError());
+}
+
+std::vector<double> marginalProbabilities(const void *state, std::int64_t dim,
+                                          const std::vector<Digit> &digits) {
+  std::int64_t numOutcomes = 1;
+  for (const auto &digit : digits)
+    numOutcomes *= digit.levels;
+  Digit *deviceDigits = nullptr;
+  double *deviceProbabilities = nullptr;
+  HANDLE_CUDA_ERROR(cudaMalloc(&deviceDigits, digits.size() * sizeof(Digit)));
+  HANDLE_CUDA_ERROR(
+      cudaMalloc(&deviceProbabilities, numOutcomes * sizeof(double)));
+  HANDLE_CUDA_ERROR(cudaMemcpy(deviceDigits, digits.data(),
+                               digits.size() * sizeof(Digit),
+                               cudaMemcpyHostToDevice));
+  HANDLE_CUDA_ERROR(
+      cudaMemset(deviceProbabilities, 0, numOutcomes * sizeof(double)));
+  marginalKernel<<<numBlocks(dim), threadsPerBlock>>>(
+      static_cast<const cuDoubleComplex *>(state), dim, deviceDigits,
+      digits.size(), deviceProbabilities);
+  HANDLE_CUDA_ERROR(cudaGetLastError());
+
+  std::vector<double> probabilities(numOutcomes);
+  HANDLE_CUDA_ERROR(cudaMemcpy(probabilities.data(), deviceProbabilities,
+                               numOutcomes * sizeof(double),
+                               cudaMemcpyDeviceToHost));
+  HANDLE_CUDA_ERROR(cudaFree(deviceDigits));
+  HANDLE_CUDA_ERROR(cudaFree(deviceProbabilities));
+  return probabilities;
+}
+
+void collapse(void *state, std::int64_t dim, Digit digit, std::int64_t level,
+              double probability) {
+  collapseKernel<<<numBlocks(dim), threadsPerBlock>>>(
+      static_cast<cuDoubleComplex *>(state), dim, digit, level,
+      1.0 / std::sqrt(probability));
+  HANDLE_CUDA_ERROR(cudaGetLastError());
+}
+
+} // namespace cudaq::quditsv
@@ -0,0 +1,89 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+/// The device functions of the GPU qudit state vector. The state of qudits
+/// with levels d_0, d_1, ... is a vector of d_0 * d_1 * ... amplitudes in a
+/// mixed-radix layout: qudit k is a digit of the amplitude index, of stride
+/// d_0 * ... * d_{k-1}, so that the amplitude of the basis state |l_0 l_1 ...>
+/// is at index l_0 + l_1 * d_0 + .... Gates on a qudit act on groups of d_k
+/// amplitudes, `stride` apart.
+namespace cudaq::quditsv {
+
+/// @brief The largest number of levels of a qudit.
+constexpr std::int64_t maxLevels = 32;
+
+/// @brief The largest dimension of a gate on several qudits, i.e., the product
+/// of the levels of its targets.
+constexpr std::int64_t maxGateDimension = 64;
+
+/// @brief The largest number of targets of a gate.
+constexpr int maxTargets = 6;
+
+/// @brief The largest number of controls of a gate.
+constexpr int maxControls = 16;
+
+/// @brief A qudit, as a digit of the amplitude index.
+struct Digit {
+  std::int64_t stride;
+  std::int64_t levels;
+};
+
+/// @brief The controls of a gate, which is applied to the amplitudes where
+/// every control qudit is in |1>.
+struct Controls {
+  int size = 0;
+  Digit digits[maxControls];
+};
+
+/// @brief Allocate the state vector of dimension `dim`, in |0...0>.
+void *allocateState(std::int64_t dim);
+
+/// @brief Grow `state` from dimension `dim` to `newDim` by adding qudits as
+/// the most significant digits, in |0>. Frees `state` and returns the new
+/// state vector.
+void *growState(void *state, std::int64_t dim, std::int64_t newDim);
+
+/// @brief Free the state vector, along with the device matrix of the
+/// multi-qudit gates.
+void freeState(void *state);
+
+/// @brief Apply the diagonal gate of `target.levels` `phases` to `target`.
+void applyDiagonal(void *state, std::int64_t dim,
+                   const std::complex<double> *phases, Digit target,
+                   const Controls &controls);
+
+/// @brief Apply the row-major `target.levels` x `target.levels` matrix to
+/// `target`.
+void applySingleQudit(void *state, std::int64_t dim,
+                      const std::complex<double> *matrix, Digit target,
+                      const Controls &controls);
+
+/// @brief Apply the row-major matrix to `targets`, the first target being the
+/// most significant in the row and column indices of the matrix.
+void applyMultiQudit(void *state, std::int64_t dim,
+                     const std::complex<double> *matrix,
+                     const std::vector<Digit> &targets,
+                     const Controls &controls);
+
+/// @brief Return the probabilities of the basis states of `digits`, the first
+/// digit being the most significant in the index of the probabilities.
+std::vector<double> marginalProbabilities(const void *state, std::int64_t dim,
+                                          const std::vector<Digit> &digits);
+
+/// @brief Project `digit` onto `level`, of the given `probability`, and
+/// renormalize the state.
+void collapse(void *state, std::int64_t dim, Digit digit, std::int64_t level,
+              double probability);
+
+} // namespace cudaq::quditsv
@@ -106,6 +106,11 @@ bool RemoteSimulationState::isDeviceData() const {
   return state->isDeviceData();
 }
 
+int RemoteSimulationState::getDeviceId() const {
+  execute();
+  return state->getDeviceId();
+}
+
 void RemoteSimulationState::toHost(std::complex<double> *clientAllocatedData,
                                    std::size_t numElements) const {
   execute();
@@ -138,6 +138,9 @@ public:
   /// @brief Return true if this `SimulationState` wraps data on the GPU.
   bool isDeviceData() const override;
 
+  /// @brief Return the CUDA device holding the data of the state.
+  int getDeviceId() const override;
+
   /// @brief Transfer data from device to host, return the data
   /// to the pointer provided by the client. Clients must specify the number of
   /// elements.
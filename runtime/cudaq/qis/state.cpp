@@ -45,6 +45,8 @@ SimulationState::precision state::get_precision() const {
 
 bool state::is_on_gpu() const { return internal->isDeviceData(); }
 
+int state::get_device_id() const { return internal->getDeviceId(); }
+
 SimulationState::Tensor state::get_tensor(std::size_t tensorIdx) const {
   return internal->getTensor(tensorIdx);
 }
@@ -110,6 +112,23 @@ std::complex<double> state::overlap(const state &other) {
   return internal->overlap(*other.internal.get());
 }
 
+complex_matrix overlap_matrix(const std::vector<state> &bras,
+                              const std::vector<state> &kets) {
+  if (bras.empty() || kets.empty())
+    return complex_matrix(bras.size(), kets.size());
+
+  std::vector<SimulationState *> braStates, ketStates;
+  braStates.reserve(bras.size());
+  for (const auto &bra : bras)
+    braStates.push_back(bra.internal.get());
+  ketStates.reserve(kets.size());
+  for (const auto &ket : kets)
+    ketStates.push_back(ket.internal.get());
+  return complex_matrix(
+      braStates.front()->overlapMatrix(braStates, ketStates),
+      {bras.size(), kets.size()});
+}
+
 std::complex<double> state::amplitude(const std::vector<int> &basisState) {
   return internal->getAmplitude(basisState);
 }
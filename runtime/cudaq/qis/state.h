@@ -29,6 +29,8 @@ private:
   template <std::size_t>
   friend class qudit;
   friend class state_helper;
+  friend complex_matrix overlap_matrix(const std::vector<state> &,
+                                       const std::vector<state> &);
 
 public:
   /// @brief The constructor, takes the simulation data and owns it
@@ -133,6 +135,9 @@ public:
   /// @brief Return true if this a state on the GPU.
   bool is_on_gpu() const;
 
+  /// @brief Return the CUDA device holding the data of a state on the GPU.
+  int get_device_id() const;
+
   /// @brief Copy this state from device to
   template <typename ScalarType>
   void to_host(std::complex<ScalarType> *hostPtr,
@@ -143,6 +148,18 @@ public:
     internal->toHost(hostPtr, numElements);
   }
 
+  /// @brief Copy the `numElements` elements of this state from `offset`, in
+  /// the order of `to_host`, from device to host. Only this slice of the
+  /// state is transferred.
+  template <typename ScalarType>
+  void to_host(std::complex<ScalarType> *hostPtr, std::size_t offset,
+               std::size_t numElements) const {
+    if (!is_on_gpu())
+      throw std::runtime_error("to_host requested, but the state is already on "
+                               "host. Check with is_on_gpu() method.");
+    internal->toHostRange(hostPtr, offset, numElements);
+  }
+
   /// @brief Dump the state to standard out
   void dump() const;
 
@@ -172,6 +189,13 @@ private:
   state &initialize(const state_data &data);
 };
 
+/// @brief Compute the overlap of each of the `bras` with each of the `kets`, as
+/// `state::overlap` does. Element (i, j) of the returned matrix is the overlap
+/// of `bras[i]` with `kets[j]`. The overlaps are computed in a single batch
+/// when the simulator supports it, e.g., as a matrix product on the GPU.
+complex_matrix overlap_matrix(const std::vector<state> &bras,
+                              const std::vector<state> &kets);
+
 class state_helper {
 public:
   static SimulationState *getSimulationState(cudaq::state *state) {
@@ -12,7 +12,11 @@
 #include <cudaq.h>
 #include <functional>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cudaq {
@@ -37,6 +41,17 @@ private:
       value_function;
   std::size_t current_idx;
 
+  /// The values of the parameters at the time points evaluated so far, shared
+  /// by the copies of the schedule, so that the integrator, its time stepper
+  /// and the evolution loop do not evaluate the same callbacks again.
+  struct parameter_table {
+    std::mutex mutex;
+    std::map<double, std::unordered_map<std::string, std::complex<double>>>
+        values;
+  };
+  std::shared_ptr<parameter_table> parameter_values =
+      std::make_shared<parameter_table>();
+
   static std::vector<std::complex<double>>
   toComplex(const std::vector<double> &vec) {
     std::vector<std::complex<double>> result;
@@ -137,7 +152,20 @@ public:
   /// @brief Get the value function of the schedule.
   /// @return The value function of the schedule.
   const std::function<std::complex<double>(const std::string &,
-                                           const std::complex<double> &)>
+                                           const std::complex<double> &)> &
   get_value_function() const;
+
+  /// @brief Evaluate all the parameters at the given time points up front,
+  /// one parameter at a time over all of them, e.g., at the steps and the
+  /// sub-steps of an integrator, and record them for `get_parameter_values`.
+  /// @param times: The time points.
+  void precompute_parameters(const std::vector<double> &times) const;
+
+  /// @brief Get the values of all the parameters at the given time, recorded
+  /// by `precompute_parameters` or a previous call, or evaluated otherwise.
+  /// @param t: The time.
+  /// @return The value of each parameter at time `t`.
+  std::unordered_map<std::string, std::complex<double>>
+  get_parameter_values(double t) const;
 };
 } // namespace cudaq
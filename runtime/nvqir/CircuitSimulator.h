@@ -8,18 +8,34 @@
 
 #pragma once
 
+#include "DiagonalGateRun.h"
+#include "GateFusion.h"
+#include "GateQueue.h"
+#include "GlobalQubitScheduler.h"
+#include "MeasurementBranching.h"
+#include "StateCheckpoint.h"
 #include "Gates.h"
+#include "common/CustomOp.h"
 #include "common/Environment.h"
 #include "common/ExecutionContext.h"
 #include "common/Logger.h"
 #include "common/NoiseModel.h"
+#include "common/OutputRecord.h"
+#include "common/PerfCounters.h"
+#include "common/Profiler.h"
 #include "common/QuditIdTracker.h"
 #include "common/SampleResult.h"
 #include "common/Timing.h"
 #include "cudaq/host_config.h"
+#include <chrono>
 #include <cstdarg>
 #include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <optional>
 #include <queue>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -79,6 +95,27 @@ struct SummaryData {
   }
 };
 
+/// @brief Add the wall time of its lifetime to a performance counter, if any.
+class ScopedPerfTimer {
+public:
+  explicit ScopedPerfTimer(double *seconds) : seconds(seconds) {
+    if (seconds)
+      start = std::chrono::steady_clock::now();
+  }
+  ScopedPerfTimer(const ScopedPerfTimer &) = delete;
+  ScopedPerfTimer &operator=(const ScopedPerfTimer &) = delete;
+  ~ScopedPerfTimer() {
+    if (seconds)
+      *seconds += std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+  }
+
+private:
+  double *seconds;
+  std::chrono::steady_clock::time_point start;
+};
+
 /// @brief The CircuitSimulator defines a base class for all
 /// simulators that are available to CUDA-Q via the NVQIR library.
 /// This base class handles Qubit allocation and deallocation,
@@ -101,6 +138,57 @@ protected:
   /// sample() function.
   bool supportsBufferedSample = false;
 
+  /// @brief An "opt-in" way for simulators to tell the base class that noise
+  /// channels are simulated as quantum trajectories, i.e., a single Kraus
+  /// operator is drawn and applied per channel. When sampling a noisy kernel,
+  /// each execution then produces a single shot, and the kernel is re-executed
+  /// until the requested number of shots has been collected.
+  bool simulatesNoiseAsTrajectories = false;
+
+  /// @brief An "opt-in" way for simulators to tell the base class that queued
+  /// gates may be fused into dense multi-qubit matrices before being handed to
+  /// applyGate(). Simulators opting in must be able to apply arbitrary
+  /// (uncontrolled) matrices on up to `CUDAQ_GATE_FUSION_MAX_QUBITS` targets.
+  bool supportsGateFusion = false;
+
+  /// @brief An "opt-in" way for simulators to tell the base class that runs
+  /// of queued diagonal gates may be accumulated into a single phase function
+  /// of the basis states. Simulators opting in must override
+  /// applyDiagonalPhases().
+  bool supportsDiagonalGateRuns = false;
+
+  /// @brief An "opt-in" way for simulators to tell the base class that they
+  /// can compute the probability of a measurement outcome and collapse the
+  /// state onto a given outcome, so that measurements can follow the branches
+  /// of a `MeasurementBranching`.
+  bool supportsMeasurementBranching = false;
+
+  /// @brief An "opt-in" way for simulators to tell the base class that they
+  /// can drop the highest qubits of the state once these are deallocated, by
+  /// overriding removeQubitsFromState().
+  bool supportsStateCompaction = false;
+
+  /// @brief An "opt-in" way for simulators to tell the base class that exact
+  /// expectation values may be computed from the backward lightcone of each
+  /// observed term, on a state that only spans the qubits of the lightcone.
+  /// Simulators opting in must call measureOrFollowBranch() to measure or
+  /// reset qubits, so that these are rejected while the gates are recorded.
+  bool supportsLightconeObserve = false;
+
+  /// @brief An "opt-in" way for simulators to tell the base class that the
+  /// executions of a `sample` broadcast may be recorded and simulated as one
+  /// batch once the last execution on the QPU ends. Simulators opting in must
+  /// override sampleBatchedExecutions().
+  bool supportsBatchedSampling = false;
+
+  /// @brief An "opt-in" way for simulators to tell the base class that the
+  /// state vector may be checkpointed to (and restored from) a file, by
+  /// overriding getStateChunk() and setStateChunk().
+  bool supportsCheckpoints = false;
+
+  /// @brief The branching that measurements currently follow, if any.
+  MeasurementBranching *measurementBranching = nullptr;
+
 public:
   /// @brief The constructor
   CircuitSimulator() = default;
@@ -221,6 +309,75 @@ public:
     }
   }
 
+  /// @brief Apply the Pauli rotations of applyExpPauli() with the angles
+  /// `thetas` and the Pauli words `terms` on `qubitIds`, in order, e.g., a
+  /// layer of a Trotterized evolution. Subclasses may apply the whole sequence
+  /// at once. By default, each rotation is decomposed as in applyExpPauli(),
+  /// but the basis of a qubit is only changed when the next term acting on it
+  /// needs a different one.
+  virtual void
+  applyExpPauliBatch(const std::vector<double> &thetas,
+                     const std::vector<std::size_t> &qubitIds,
+                     const std::vector<cudaq::spin_op_term> &terms) {
+    if (thetas.size() != terms.size())
+      throw std::invalid_argument(
+          "exp_pauli batch requires one angle per Pauli word - got " +
+          std::to_string(thetas.size()) + " angles and " +
+          std::to_string(terms.size()) + " words");
+    flushGateQueue();
+    CUDAQ_INFO(" [CircuitSimulator decomposing] exp_pauli batch of {} terms",
+               terms.size());
+    // The basis each qubit is currently rotated to: X, Y, or I for none.
+    std::vector<cudaq::pauli> basis(qubitIds.size(), cudaq::pauli::I);
+    const auto changeBasis = [&](std::size_t idx, cudaq::pauli newBasis) {
+      const auto qId = qubitIds[idx];
+      if (basis[idx] == cudaq::pauli::X)
+        h(qId);
+      else if (basis[idx] == cudaq::pauli::Y)
+        rx(-M_PI_2, qId);
+      if (newBasis == cudaq::pauli::X)
+        h(qId);
+      else if (newBasis == cudaq::pauli::Y)
+        rx(M_PI_2, qId);
+      basis[idx] = newBasis;
+    };
+
+    for (std::size_t k = 0; k < terms.size(); ++k) {
+      const auto &term = terms[k];
+      // exp(i*theta*Id) is noop.
+      if (term.is_identity())
+        continue;
+      if (term.num_ops() != qubitIds.size())
+        throw std::runtime_error(
+            "incorrect number of qubits in exp_pauli - expecting " +
+            std::to_string(term.num_ops()) + " qubits");
+
+      std::vector<std::size_t> qubitSupport;
+      std::size_t idx = 0;
+      for (const auto &op : term) {
+        const auto pauli = op.as_pauli();
+        if (pauli != cudaq::pauli::I) {
+          qubitSupport.push_back(qubitIds[idx]);
+          const auto newBasis =
+              pauli == cudaq::pauli::Z ? cudaq::pauli::I : pauli;
+          if (basis[idx] != newBasis)
+            changeBasis(idx, newBasis);
+        }
+        ++idx;
+      }
+
+      for (std::size_t i = 0; i < qubitSupport.size() - 1; i++)
+        x({qubitSupport[i]}, qubitSupport[i + 1]);
+      rz(-2.0 * thetas[k], {}, qubitSupport.back());
+      for (std::size_t i = qubitSupport.size() - 1; i > 0; i--)
+        x({qubitSupport[i - 1]}, qubitSupport[i]);
+    }
+
+    for (std::size_t idx = 0; idx < qubitIds.size(); ++idx)
+      if (basis[idx] != cudaq::pauli::I)
+        changeBasis(idx, cudaq::pauli::I);
+  }
+
   /// @brief Compute the expected value of the given spin op
   /// with respect to the current state, <psi | H | psi>.
   virtual cudaq::observe_result observe(const cudaq::spin_op &term) = 0;
@@ -276,6 +433,17 @@ public:
                        const std::vector<std::size_t> &targets,
                        const std::string_view customUnitaryName = "") = 0;
 
+  /// @brief Apply a custom operation given by a unitary cached by the custom
+  /// operation registry, which holds the matrix in both precisions. By
+  /// default, this applies its double-precision matrix.
+  virtual void
+  applyCachedCustomOperation(const cudaq::cached_unitary &unitary,
+                             const std::vector<std::size_t> &controls,
+                             const std::vector<std::size_t> &targets,
+                             const std::string_view customUnitaryName = "") {
+    applyCustomOperation(unitary.fp64, controls, targets, customUnitaryName);
+  }
+
 #define CIRCUIT_SIMULATOR_ONE_QUBIT(NAME)                                      \
   void NAME(const std::size_t qubitIdx) {                                      \
     std::vector<std::size_t> tmp;                                              \
@@ -400,6 +568,29 @@ public:
   /// A string containing the output logging of a kernel launched with
   /// `cudaq::run()`.
   std::string outputLog;
+
+  /// @brief Return whether the measurements of kernels can follow the branches
+  /// of a `MeasurementBranching`. Replaying a branch requires the evolution of
+  /// the state between measurements to be deterministic, so noise must not be
+  /// simulated as trajectories.
+  bool canBranchMeasurements(bool hasNoise) const {
+    return supportsMeasurementBranching &&
+           !(hasNoise && simulatesNoiseAsTrajectories);
+  }
+
+  /// @brief Have the measurements follow the branches of `branching`, or be
+  /// drawn independently if null.
+  void setMeasurementBranching(MeasurementBranching *branching) {
+    measurementBranching = branching;
+  }
+
+  /// When set, the output of kernels is recorded in `outputRecords` instead of
+  /// being formatted into `outputLog`.
+  bool recordBinaryOutput = false;
+
+  /// The output records of a kernel launched with `cudaq::run()` on a local
+  /// simulator.
+  std::vector<cudaq::OutputRecord> outputRecords;
 };
 
 /// @brief The CircuitSimulatorBase is the type that is meant to
@@ -426,7 +617,8 @@ protected:
   cudaq::QuditIdTracker tracker;
 
   /// @brief The number of qubits that have been allocated on the simulator.
-  /// Never decreases (unless reset to 0) and may be more than getNumQubits().
+  /// Only decreases when the state is compacted or deallocated, and may be
+  /// more than getNumQubits().
   std::size_t nQubitsAllocated = 0;
 
   /// @brief The dimension of the multi-qubit state.
@@ -461,15 +653,117 @@ protected:
   static constexpr const char observeSamplingEnvVar[] =
       "CUDAQ_OBSERVE_FROM_SAMPLING";
 
+  /// @brief Environment variable name that sets the maximum number of qubits
+  /// a fused gate may act on. Gate fusion is disabled if unset or 0.
+  static constexpr const char gateFusionEnvVar[] =
+      "CUDAQ_GATE_FUSION_MAX_QUBITS";
+
+  /// @brief Environment variable name that enables accumulating the runs of
+  /// queued diagonal gates into a single phase function of the basis states.
+  static constexpr const char diagonalGateRunsEnvVar[] =
+      "CUDAQ_DIAGONAL_GATE_RUNS";
+
+  /// @brief Environment variable name that sets the minimum number of
+  /// deallocated qubits to drop from the state at once. State compaction is
+  /// disabled if 0.
+  static constexpr const char stateCompactionEnvVar[] =
+      "CUDAQ_STATE_COMPACTION_MIN_QUBITS";
+
+  /// @brief Environment variable name that enables computing the exact
+  /// expectation values of `observe` from the lightcone of each term.
+  static constexpr const char lightconeObserveEnvVar[] =
+      "CUDAQ_OBSERVE_LIGHTCONE";
+
+  /// @brief Environment variable name that disables the batched simulation of
+  /// the executions of a `sample` broadcast, on simulators supporting it.
+  static constexpr const char batchedSamplingEnvVar[] =
+      "CUDAQ_BATCHED_SAMPLING";
+
+  /// @brief Environment variable names for state vector checkpoints: the
+  /// file to checkpoint the state to, the number of gates between
+  /// checkpoints, and the checkpoint file to resume the simulation from.
+  static constexpr const char checkpointFileEnvVar[] = "CUDAQ_CHECKPOINT_FILE";
+  static constexpr const char checkpointIntervalEnvVar[] =
+      "CUDAQ_CHECKPOINT_INTERVAL";
+  static constexpr const char restoreCheckpointEnvVar[] =
+      "CUDAQ_RESTORE_CHECKPOINT";
+
+  /// @brief The state checkpoint file, checkpointing is disabled if empty.
+  std::string checkpointFile;
+
+  /// @brief The minimum number of gates between two checkpoints. The state
+  /// is checkpointed at the first gate queue flush past the interval.
+  std::size_t checkpointInterval = 100000;
+
+  /// @brief The number of gates at the last checkpoint.
+  std::size_t checkpointedGates = 0;
+
+  /// @brief The checkpoint the next simulation resumes from, if any.
+  std::unique_ptr<StateCheckpointFile> pendingRestore;
+
+  /// @brief True once the checkpoint environment variables were read.
+  bool checkpointSettingsRead = false;
+
+  /// @brief The number of gates enqueued since the state was allocated.
+  std::size_t numEnqueuedGates = 0;
+
+  /// @brief Upper bound on the gate fusion size, beyond which building the
+  /// dense fused matrix outweighs the saved state vector sweeps.
+  static constexpr std::size_t maxGateFusionQubits = 10;
+
+  /// @brief The maximum number of qubits a fused gate may act on. Zero
+  /// disables gate fusion.
+  std::size_t gateFusionMaxQubits = 0;
+
+  /// @brief Whether runs of diagonal gates are accumulated into a single
+  /// phase function.
+  bool accumulateDiagonalGates = false;
+
+  /// @brief The minimum number of deallocated qubits above the highest
+  /// allocated qubit for the state to be compacted. Compacting the state as
+  /// soon as one qubit is deallocated would reallocate it on each cycle of an
+  /// ancilla allocation loop. Zero disables state compaction.
+  std::size_t stateCompactionMinQubits = 4;
+
+  /// @brief The performance counters of the current execution, only set when
+  /// their collection was enabled as the execution context was set.
+  std::optional<cudaq::perf_counters> perfCounters;
+
+  /// @brief Return the performance counter `member`, or null if performance
+  /// counters are not collected.
+  double *perfTimer(double cudaq::perf_counters::*member) {
+    return perfCounters ? &(*perfCounters.*member) : nullptr;
+  }
+
+  /// @brief Count the noise channels of the noise model applied after the
+  /// operation `gateName`.
+  void countNoiseChannels(std::string_view gateName,
+                          const std::vector<std::size_t> &controls,
+                          const std::vector<std::size_t> &targets,
+                          const std::vector<double> &params) {
+    executionContext->noiseModel->for_each_channel(
+        gateName, targets, controls, params,
+        [&](const cudaq::kraus_channel &) { ++perfCounters->noise_channels; });
+  }
+
+  /// @brief True while the gates of a kernel under observation are recorded
+  /// to `lightconeTape` rather than applied, the state is then not allocated.
+  bool recordingLightcones = false;
+
+  /// @brief The number of queued gates to look ahead through when planning
+  /// the exchange of global and local qubits of a distributed state.
+  static constexpr std::size_t qubitExchangeLookahead = 1024;
+
   /// @brief A GateApplicationTask consists of a
   /// matrix describing the quantum operation, a set of
   /// possible control qubit indices, and a set of target indices.
   struct GateApplicationTask {
-    const std::string operationName;
-    const std::vector<std::complex<ScalarType>> matrix;
-    const std::vector<std::size_t> controls;
-    const std::vector<std::size_t> targets;
-    const std::vector<ScalarType> parameters;
+    std::string operationName;
+    std::vector<std::complex<ScalarType>> matrix;
+    std::vector<std::size_t> controls;
+    std::vector<std::size_t> targets;
+    std::vector<ScalarType> parameters;
+    GateApplicationTask() = default;
     GateApplicationTask(const std::string &name,
                         const std::vector<std::complex<ScalarType>> &m,
                         const std::vector<std::size_t> &c,
@@ -477,23 +771,65 @@ protected:
                         const std::vector<ScalarType> &params)
         : operationName(name), matrix(m), controls(c), targets(t),
           parameters(params) {}
+
+    /// @brief Overwrite the task, reusing the storage of its vectors.
+    void assign(std::string_view name,
+                std::span<const std::complex<ScalarType>> m,
+                std::span<const std::size_t> c, std::span<const std::size_t> t,
+                std::span<const ScalarType> params) {
+      operationName.assign(name);
+      matrix.assign(m.begin(), m.end());
+      controls.assign(c.begin(), c.end());
+      targets.assign(t.begin(), t.end());
+      parameters.assign(params.begin(), params.end());
+    }
   };
 
   /// @brief The current queue of operations to execute
-  std::queue<GateApplicationTask> gateQueue;
+  GateQueue<GateApplicationTask> gateQueue;
+
+  /// @brief The gates applied so far by the kernel under observation, while
+  /// `recordingLightcones`.
+  std::vector<GateApplicationTask> lightconeTape;
+
+  /// @brief A `sample` execution whose simulation is deferred to the batch of
+  /// the executions on this QPU: its gates, applied to the |0> state of
+  /// `numQubits` qubits, then the sampling of `sampleQubits`.
+  struct BatchedExecution {
+    std::vector<GateApplicationTask> gates;
+    std::size_t numQubits = 0;
+    std::vector<std::size_t> sampleQubits;
+    int shots = 0;
+  };
+
+  /// @brief True while the gates of a batched `sample` execution are kept in
+  /// the gate queue rather than applied. Any flush of the queue ends the
+  /// recording, the execution is then simulated on its own.
+  bool recordingBatchedExecution = false;
+
+  /// @brief The deferred executions of the current `sample` broadcast on this
+  /// QPU, in execution order.
+  std::vector<BatchedExecution> batchedExecutions;
+
+  /// @brief The matrix of the last parameterized or custom gate, whose storage
+  /// is reused from gate to gate.
+  std::vector<std::complex<ScalarType>> gateMatrix;
 
   /// @brief Get the name of the current circuit being executed.
   std::string getCircuitName() const { return currentCircuitName; }
 
   /// @brief Get the number of shots to execute (only valid if executionContext
   /// is set)
-  int getNumShotsToExec() const {
+  virtual int getNumShotsToExec() const {
     if (!executionContext)
       return 1;
     if (executionContext->hasConditionalsOnMeasureResults)
       return 1;
     if (executionContext->explicitMeasurements && !supportsBufferedSample)
       return 1;
+    if (simulatesNoiseAsTrajectories && executionContext->noiseModel &&
+        executionContext->name == "sample")
+      return 1;
     return static_cast<int>(executionContext->shots);
   }
 
@@ -519,8 +855,7 @@ protected:
   /// @brief Reset the qubit state back to dim = 0.
   void deallocateState() {
     deallocateStateImpl();
-    auto empty = std::queue<GateApplicationTask>{};
-    std::swap(gateQueue, empty);
+    clearGateQueue();
     nQubitsAllocated = 0;
     stateDimension = 0;
   }
@@ -529,6 +864,40 @@ protected:
   /// left as a task for concrete subtypes.
   virtual bool measureQubit(const std::size_t qubitIdx) = 0;
 
+  /// @brief Return the probability to measure the qubit in the |1> state,
+  /// without collapsing the state. Simulators that opt in to
+  /// `supportsMeasurementBranching` override this and `collapseQubit`.
+  virtual double getProbabilityOfOne(const std::size_t qubitIdx) {
+    throw std::runtime_error(
+        "Measurement branching is not supported on " + std::string(name()) +
+        " simulator.");
+  }
+
+  /// @brief Collapse the state onto the measurement `outcome` of the qubit,
+  /// whose probability is `probability`.
+  virtual void collapseQubit(const std::size_t qubitIdx, bool outcome,
+                             double probability) {
+    throw std::runtime_error(
+        "Measurement branching is not supported on " + std::string(name()) +
+        " simulator.");
+  }
+
+  /// @brief Measure the qubit and collapse the state. When the shots are
+  /// batched by branches, the outcome is the one of the current branch.
+  bool measureOrFollowBranch(const std::size_t qubitIdx) {
+    if (recordingLightcones)
+      throw std::runtime_error(
+          std::string("Measurements and resets are not supported in kernels "
+                      "observed from lightcones, unset ") +
+          lightconeObserveEnvVar + ".");
+    if (!measurementBranching)
+      return measureQubit(qubitIdx);
+    const double probOne = getProbabilityOfOne(qubitIdx);
+    const bool outcome = measurementBranching->measure(probOne);
+    collapseQubit(qubitIdx, outcome, outcome ? probOne : 1.0 - probOne);
+    return outcome;
+  }
+
   /// @brief Return true if this CircuitSimulator can
   /// handle <psi | H | psi> instead of NVQIR applying measure
   /// basis quantum gates to change to the Z basis and sample.
@@ -657,6 +1026,73 @@ protected:
                              "subclasses, override addQubitsToState.");
   }
 
+  /// @brief Remove the given number of highest qubits from the state. These
+  /// qubits are deallocated and in the |0> state. Simulators that opt in to
+  /// `supportsStateCompaction` override this.
+  virtual void removeQubitsFromState(std::size_t count) {
+    throw std::runtime_error("State compaction is not supported on " +
+                             std::string(name()) + " simulator.");
+  }
+
+  /// @brief Simulate and sample the given deferred `sample` executions, and
+  /// return their results in the same order. The state is deallocated when
+  /// this is called. Simulators that opt in to `supportsBatchedSampling`
+  /// override this.
+  virtual std::vector<cudaq::ExecutionResult>
+  sampleBatchedExecutions(std::vector<BatchedExecution> &executions) {
+    throw std::runtime_error("Batched sampling is not supported on " +
+                             std::string(name()) + " simulator.");
+  }
+
+  /// @brief Drop the deallocated qubits above the highest allocated qubit
+  /// from the state, once there are at least `stateCompactionMinQubits` of
+  /// them. Deallocated qubits are reset, hence these are all in |0>.
+  void compactState() {
+    tracker.trimRecycledIndices();
+    const auto numFree = nQubitsAllocated - tracker.numIndices();
+    if (!supportsStateCompaction || stateCompactionMinQubits == 0 ||
+        numFree < stateCompactionMinQubits)
+      return;
+
+    CUDAQ_INFO("Compacting the state by {} deallocated qubits.", numFree);
+    flushGateQueue();
+    removeQubitsFromState(numFree);
+    nQubitsAllocated -= numFree;
+    stateDimension = calculateStateDim(nQubitsAllocated);
+  }
+
+  /// @brief Return true if qubits are deallocated as soon as they are
+  /// released. Within most execution contexts, the state may still be read
+  /// once the kernel is executed, but the results of `cudaq::run()` only come
+  /// from the output log of its shots.
+  bool deallocatesQubits() const {
+    return !executionContext || executionContext->name == "run";
+  }
+
+  /// @brief Move the recorded gates and sample qubits of the current `sample`
+  /// execution to the batch of the QPU, its result is then deferred.
+  void deferBatchedExecution() {
+    auto &execution = batchedExecutions.emplace_back();
+    execution.gates.reserve(gateQueue.size());
+    for (; !gateQueue.empty(); gateQueue.pop())
+      execution.gates.push_back(std::move(gateQueue.front()));
+    execution.numQubits = nQubitsAllocated;
+    if (sampleQubits.empty()) {
+      sampleQubits.resize(getNumQubits());
+      std::iota(sampleQubits.begin(), sampleQubits.end(), 0);
+    }
+    std::sort(sampleQubits.begin(), sampleQubits.end());
+    sampleQubits.erase(std::unique(sampleQubits.begin(), sampleQubits.end()),
+                       sampleQubits.end());
+    execution.sampleQubits = std::move(sampleQubits);
+    execution.shots = getNumShotsToExec();
+    sampleQubits.clear();
+    registerNameToMeasuredQubit.clear();
+    currentCircuitName = "";
+    recordingBatchedExecution = false;
+    executionContext->resultDeferred = true;
+  }
+
   /// @brief Execute a sampling task with the current set of sample qubits.
   void flushAnySamplingTasks(bool force = false) {
     if (force && supportsBufferedSample &&
@@ -665,11 +1101,13 @@ protected:
       if (!sampleQubits.empty()) {
         // We have a few more qubits to be sampled. Call sample on the subclass,
         // but there is no need to save the results this time.
+        ScopedPerfTimer timer(perfTimer(&cudaq::perf_counters::sample_seconds));
         sample(sampleQubits, nShots);
         sampleQubits.clear();
       }
       // OK, now we're ready to grab the buffered sample results for the entire
       // execution context.
+      ScopedPerfTimer timer(perfTimer(&cudaq::perf_counters::sample_seconds));
       auto execResult = sample(sampleQubits, nShots);
       executionContext->result.append(execResult);
       return;
@@ -692,8 +1130,15 @@ protected:
     CUDAQ_INFO("Sampling the current state, with measure qubits = {}",
                sampleQubits);
 
+    // A mid-circuit sampling needs the state of a batched execution.
+    if (recordingBatchedExecution)
+      flushGateQueue();
+
     // Ask the subtype to sample the current state
-    auto execResult = sample(sampleQubits, getNumShotsToExec());
+    auto execResult = [&]() {
+      ScopedPerfTimer timer(perfTimer(&cudaq::perf_counters::sample_seconds));
+      return sample(sampleQubits, getNumShotsToExec());
+    }();
 
     if (registerNameToMeasuredQubit.empty()) {
       executionContext->result.append(execResult,
@@ -734,11 +1179,11 @@ protected:
   }
 
   /// @brief Add a new gate application task to the queue
-  void enqueueGate(const std::string name,
-                   const std::vector<std::complex<ScalarType>> &matrix,
-                   const std::vector<std::size_t> &controls,
-                   const std::vector<std::size_t> &targets,
-                   const std::vector<ScalarType> &params) {
+  void enqueueGate(std::string_view name,
+                   std::span<const std::complex<ScalarType>> matrix,
+                   std::span<const std::size_t> controls,
+                   std::span<const std::size_t> targets,
+                   std::span<const ScalarType> params) {
     if (isInTracerMode()) {
       std::vector<cudaq::QuditInfo> controlsInfo, targetsInfo;
       for (auto &c : controls)
@@ -746,14 +1191,7 @@ protected:
       for (auto &t : targets)
         targetsInfo.emplace_back(2, t);
 
-      std::vector<double> anglesProcessed;
-      if constexpr (std::is_same_v<ScalarType, double>)
-        anglesProcessed = params;
-      else {
-        for (auto &a : params)
-          anglesProcessed.push_back(static_cast<ScalarType>(a));
-      }
-
+      std::vector<double> anglesProcessed(params.begin(), params.end());
       executionContext->kernelTrace.appendInstruction(
           name, anglesProcessed, controlsInfo, targetsInfo);
       return;
@@ -770,9 +1208,20 @@ protected:
     }
     if (z_matrix_logging)
       cudaq::log("{}: matrix={}, controls={}, targets={}, params={}", name,
-                 matrix, controls, targets, params);
+                 std::vector(matrix.begin(), matrix.end()),
+                 std::vector(controls.begin(), controls.end()),
+                 std::vector(targets.begin(), targets.end()),
+                 std::vector(params.begin(), params.end()));
+
+    // Gates up to a pending checkpoint are already applied to its state.
+    if (pendingRestore) {
+      if (++numEnqueuedGates == pendingRestore->header().numGates)
+        restoreCheckpoint();
+      return;
+    }
 
-    gateQueue.emplace(name, matrix, controls, targets, params);
+    gateQueue.push().assign(name, matrix, controls, targets, params);
+    ++numEnqueuedGates;
   }
 
   /// @brief This pure virtual method is meant for subtypes
@@ -781,6 +1230,15 @@ protected:
   /// data representation.
   virtual void applyGate(const GateApplicationTask &task) = 0;
 
+  /// @brief Multiply the amplitude of each basis state `k` by the phase
+  /// `exp(i sum_j angles[j] (-1)^popcount(k & masks[j]))`, where bit `q` of a
+  /// mask stands for qubit `q`. Simulators setting `supportsDiagonalGateRuns`
+  /// must implement this.
+  virtual void applyDiagonalPhases(const std::vector<std::uint64_t> &masks,
+                                   const std::vector<double> &angles) {
+    throw std::runtime_error(name() + " does not support diagonal gate runs.");
+  }
+
   /// @brief Provide a base-class method that can be invoked
   /// after every gate application and will apply any noise
   /// channels after the gate invocation based on a user-provided noise
@@ -793,37 +1251,373 @@ protected:
     CUDAQ_WARN("Applying noise is not supported on {} simulator.", name());
   }
 
-  /// @brief Flush the gate queue, run all queued gate
-  /// application tasks.
-  void flushGateQueueImpl() override {
+  /// @brief The number of qubits of the state that are local to each device,
+  /// for simulators that distribute the state vector over several devices.
+  /// Gates target local qubits only, while the remaining (global) qubits
+  /// select the device. Distributed simulators override this, together with
+  /// `swapQubitPositions`, to have queued gates scheduled for fewer global
+  /// qubit exchanges. By default, all qubits are local.
+  virtual std::size_t getNumLocalQubits() const { return nQubitsAllocated; }
+
+  /// @brief Swap the given pairs of qubit positions of the state, in order,
+  /// e.g., with the batched distributed index bit swap of `custatevec`.
+  virtual void swapQubitPositions(
+      const std::vector<GlobalQubitScheduler::PositionSwap> &swaps) {
+    throw std::runtime_error(
+        "Swapping qubit positions is not supported on " + std::string(name()) +
+        " simulator.");
+  }
+
+  /// @brief Copy the `count` amplitudes of the state vector starting at
+  /// `offset` to the host buffer `dst`. State vector simulators override
+  /// this, together with `setStateChunk`, to support checkpoints.
+  virtual void getStateChunk(std::size_t offset, std::size_t count,
+                             std::complex<ScalarType> *dst) {
+    throw std::runtime_error("State checkpoints are not supported on " +
+                             std::string(name()) + " simulator.");
+  }
+
+  /// @brief Overwrite the `count` amplitudes of the state vector starting at
+  /// `offset` with those of the host buffer `src`.
+  virtual void setStateChunk(std::size_t offset, std::size_t count,
+                             const std::complex<ScalarType> *src) {
+    throw std::runtime_error("State checkpoints are not supported on " +
+                             std::string(name()) + " simulator.");
+  }
+
+  /// @brief Drop any queued gates, and restart the gate count.
+  void clearGateQueue() {
+    gateQueue.clear();
+    numEnqueuedGates = 0;
+    checkpointedGates = 0;
+  }
+
+  /// @brief Read the checkpoint environment variables. This is deferred to
+  /// the first qubit allocation, since the support of checkpoints is only
+  /// known once the subtype is constructed.
+  void readCheckpointSettings() {
+    checkpointSettingsRead = true;
+    for (const char *envVar : {checkpointFileEnvVar, restoreCheckpointEnvVar})
+      if (std::getenv(envVar) && !supportsCheckpoints)
+        throw std::runtime_error(cudaq_fmt::format(
+            "State checkpoints are not supported on {} simulator, unset {}.",
+            name(), envVar));
+    if (auto *checkpointEnvVal = std::getenv(checkpointFileEnvVar))
+      checkpointFile = checkpointEnvVal;
+    if (auto *intervalEnvVal = std::getenv(checkpointIntervalEnvVar)) {
+      char *end = nullptr;
+      const auto interval = std::strtoll(intervalEnvVal, &end, 10);
+      if (*intervalEnvVal == '\0' || *end != '\0' || interval <= 0)
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting a positive "
+            "number of gates, got '{}'.",
+            checkpointIntervalEnvVar, intervalEnvVal));
+      checkpointInterval = interval;
+    }
+    if (auto *restoreEnvVal = std::getenv(restoreCheckpointEnvVar)) {
+      pendingRestore = std::make_unique<StateCheckpointFile>(restoreEnvVal);
+      if (pendingRestore->header().numGates == 0)
+        pendingRestore.reset();
+    }
+  }
+
+  /// @brief Write the (flushed) state vector to the checkpoint file.
+  void writeCheckpoint() {
+    ScopedTraceWithContext("CircuitSimulator::writeCheckpoint",
+                           nQubitsAllocated, numEnqueuedGates);
+    using ComplexType = std::complex<ScalarType>;
+    StateCheckpointFile::write(
+        checkpointFile, sizeof(ComplexType), nQubitsAllocated,
+        numEnqueuedGates,
+        [this](std::size_t offset, std::size_t count, char *dst) {
+          getStateChunk(offset, count, reinterpret_cast<ComplexType *>(dst));
+        });
+    checkpointedGates = numEnqueuedGates;
+    CUDAQ_INFO("Checkpointed the state of {} qubits after {} gates to {}.",
+               nQubitsAllocated, numEnqueuedGates, checkpointFile);
+  }
+
+  /// @brief Load the state vector from the pending checkpoint, whose gates
+  /// have all been enqueued (and skipped).
+  void restoreCheckpoint() {
+    ScopedTraceWithContext("CircuitSimulator::restoreCheckpoint",
+                           nQubitsAllocated, numEnqueuedGates);
+    using ComplexType = std::complex<ScalarType>;
+    auto checkpoint = std::move(pendingRestore);
+    const auto &header = checkpoint->header();
+    if (header.numQubits != nQubitsAllocated ||
+        header.elementSize != sizeof(ComplexType))
+      throw std::runtime_error(cudaq_fmt::format(
+          "Unable to restore the state checkpoint: it holds {} qubits of {} "
+          "byte amplitudes, but the simulation has {} qubits of {} byte "
+          "amplitudes at that point.",
+          header.numQubits, header.elementSize, nQubitsAllocated,
+          sizeof(ComplexType)));
+    checkpoint->read([this](std::size_t offset, std::size_t count,
+                            const char *src) {
+      setStateChunk(offset, count, reinterpret_cast<const ComplexType *>(src));
+    });
+    checkpointedGates = numEnqueuedGates;
+    CUDAQ_INFO("Restored the state of {} qubits after {} gates.",
+               nQubitsAllocated, numEnqueuedGates);
+  }
+
+  /// @brief Throw if the simulation is still skipping the gates of a pending
+  /// checkpoint, since the given operation needs the actual state.
+  void checkNoPendingRestore(const char *operation) const {
+    if (pendingRestore)
+      throw std::runtime_error(cudaq_fmt::format(
+          "Unable to {} while resuming from a state checkpoint taken "
+          "after {} gates, only {} gates were reached.",
+          operation, pendingRestore->header().numGates, numEnqueuedGates));
+  }
+
+  /// @brief Return true if queued gates should be scheduled around global
+  /// qubit exchanges. Noise channels are applied on the qubits of each gate,
+  /// hence scheduling is disabled in the presence of a noise model.
+  bool shouldScheduleQubitExchanges() const {
+    return getNumLocalQubits() < nQubitsAllocated &&
+           !(executionContext && executionContext->noiseModel);
+  }
+
+  /// @brief Return true if the runs of diagonal gates in the queue should be
+  /// accumulated into phase functions. Noise channels are applied per gate,
+  /// hence this is disabled in the presence of a noise model.
+  bool shouldAccumulateDiagonalGates() const {
+    return supportsDiagonalGateRuns && accumulateDiagonalGates &&
+           !(executionContext && executionContext->noiseModel);
+  }
+
+  /// @brief Return true if gates in the queue should be fused before being
+  /// applied. Noise channels are applied per gate, hence fusion is disabled
+  /// in the presence of a noise model.
+  bool shouldFuseGates() const {
+    return supportsGateFusion && gateFusionMaxQubits > 1 &&
+           !(executionContext && executionContext->noiseModel);
+  }
+
+  /// @brief Apply a single gate application task, followed by any noise
+  /// channels associated with it.
+  void applyGateTask(const GateApplicationTask &task) {
+    if (isStateVectorSimulator() && summaryData.enabled)
+      summaryData.svGateUpdate(
+          task.controls.size(), task.targets.size(), stateDimension,
+          stateDimension * sizeof(std::complex<ScalarType>));
+    if (perfCounters) {
+      ++perfCounters->gates[task.operationName];
+      ++perfCounters->gates_by_arity[task.controls.size() +
+                                     task.targets.size()];
+      // Read and write of the amplitudes the gate acts on, similarly to the
+      // summary data.
+      if (isStateVectorSimulator())
+        perfCounters->bytes_moved +=
+            (2 * stateDimension * sizeof(std::complex<ScalarType>)) /
+            (1ULL << task.controls.size());
+    }
+    try {
+      ScopedPerfTimer timer(
+          perfTimer(&cudaq::perf_counters::apply_gate_seconds));
+      applyGate(task);
+    } catch (std::exception &e) {
+      gateQueue.clear();
+      throw std::runtime_error(std::string("Exception in applyGate: ") +
+                               e.what());
+    } catch (...) {
+      gateQueue.clear();
+      throw std::runtime_error("Unknown exception in applyGate");
+    }
+    if (executionContext && executionContext->noiseModel) {
+      std::vector<double> params(task.parameters.begin(),
+                                 task.parameters.end());
+      applyNoiseChannel(task.operationName, task.controls, task.targets,
+                        params);
+      if (perfCounters)
+        countNoiseChannels(task.operationName, task.controls, task.targets,
+                           params);
+    }
+  }
+
+  /// @brief Run all queued gate application tasks, merging runs of adjacent
+  /// gates whose combined support fits in `gateFusionMaxQubits` qubits into
+  /// a single dense gate.
+  void flushGateQueueWithFusion() {
+    GateFusionBlock<ScalarType> block(getQubitOrdering() ==
+                                      QubitOrdering::msb);
+    // Keep the first task of a block around, so that a block made up of a
+    // single gate is applied as is (e.g., to retain rotation fast paths).
+    std::optional<GateApplicationTask> firstTask;
+
+    const auto applyBlock = [&]() {
+      if (block.empty())
+        return;
+      if (block.size() == 1) {
+        applyGateTask(*firstTask);
+      } else {
+        CUDAQ_INFO("Applying {} fused gates on qubits {}", block.size(),
+                   block.getQubits());
+        applyGateTask(GateApplicationTask("fused", block.getMatrix(), {},
+                                          block.getQubits(), {}));
+      }
+      block.clear();
+      firstTask.reset();
+    };
+
     while (!gateQueue.empty()) {
       auto &next = gateQueue.front();
-      if (isStateVectorSimulator() && summaryData.enabled)
-        summaryData.svGateUpdate(
-            next.controls.size(), next.targets.size(), stateDimension,
-            stateDimension * sizeof(std::complex<ScalarType>));
-      try {
-        applyGate(next);
-      } catch (std::exception &e) {
-        while (!gateQueue.empty())
-          gateQueue.pop();
-        throw std::runtime_error(std::string("Exception in applyGate: ") +
-                                 e.what());
-      } catch (...) {
-        while (!gateQueue.empty())
-          gateQueue.pop();
-        throw std::runtime_error("Unknown exception in applyGate");
-      }
-      if (executionContext && executionContext->noiseModel) {
-        std::vector<double> params(next.parameters.begin(),
-                                   next.parameters.end());
-        applyNoiseChannel(next.operationName, next.controls, next.targets,
-                          params);
+      if (next.controls.size() + next.targets.size() > gateFusionMaxQubits) {
+        // Too large to be fused, apply the pending block and this gate.
+        applyBlock();
+        applyGateTask(next);
+      } else {
+        if (block.numQubitsWith(next.controls, next.targets) >
+            gateFusionMaxQubits)
+          applyBlock();
+        if (block.empty())
+          firstTask.emplace(next);
+        block.absorb(next.matrix, next.controls, next.targets);
       }
       gateQueue.pop();
     }
+    applyBlock();
+  }
+
+  /// @brief Apply the phase function of a run of diagonal gates.
+  void applyDiagonalRun(const DiagonalGateRun<ScalarType> &run) {
+    if (isStateVectorSimulator() && summaryData.enabled)
+      summaryData.svGateUpdate(
+          /*nControls=*/0, /*nTargets=*/1, stateDimension,
+          stateDimension * sizeof(std::complex<ScalarType>));
+    if (perfCounters) {
+      ++perfCounters->gates["diagonal"];
+      if (isStateVectorSimulator())
+        perfCounters->bytes_moved +=
+            2 * stateDimension * sizeof(std::complex<ScalarType>);
+    }
+    try {
+      ScopedPerfTimer timer(
+          perfTimer(&cudaq::perf_counters::apply_gate_seconds));
+      applyDiagonalPhases(run.getMasks(), run.getAngles());
+    } catch (std::exception &e) {
+      gateQueue.clear();
+      throw std::runtime_error(std::string("Exception in applyGate: ") +
+                               e.what());
+    }
+  }
+
+  /// @brief Run all queued gate application tasks, applying each maximal run
+  /// of adjacent diagonal gates, along with the CNOT, X and SWAP gates in
+  /// between, as a single phase function of the basis states. The CNOT, X and
+  /// SWAP gates of a run are applied after its phase function, unless they
+  /// make up the identity. Runs with a single diagonal gate are applied as
+  /// is.
+  void flushGateQueueWithDiagonalRuns() {
+    DiagonalGateRun<ScalarType> run(getQubitOrdering() == QubitOrdering::msb);
+    // The tasks of the current run are kept at the front of the queue until
+    // the run is applied.
+    std::size_t runSize = 0;
+
+    const auto applyRun = [&]() {
+      const bool accumulate = run.numDiagonalGates() > 1;
+      const bool applyPermutation = !accumulate || !run.isPermutationIdentity();
+      if (accumulate) {
+        CUDAQ_INFO("Applying {} diagonal gates as {} phase terms",
+                   run.numDiagonalGates(), run.getMasks().size());
+        applyDiagonalRun(run);
+      }
+      for (; runSize > 0; --runSize) {
+        const auto &task = gateQueue.front();
+        if (!accumulate || (applyPermutation &&
+                            DiagonalGateRun<ScalarType>::isPermutationGate(
+                                task.operationName)))
+          applyGateTask(task);
+        gateQueue.pop();
+      }
+      run.clear();
+    };
+
+    while (runSize < gateQueue.size()) {
+      const auto &next = gateQueue[runSize];
+      if (run.absorb(next.operationName, next.matrix, next.controls,
+                     next.targets)) {
+        ++runSize;
+      } else if (runSize > 0) {
+        // The next gate is reconsidered as the start of a new run.
+        applyRun();
+      } else {
+        applyGateTask(next);
+        gateQueue.pop();
+      }
+    }
+    applyRun();
+  }
+
+  /// @brief Run all queued gate application tasks on a distributed state,
+  /// exchanging global and local qubits in batches so that every gate targets
+  /// local qubits only. The qubits are returned to their own positions once
+  /// the queue is empty, for measurements and state accessors.
+  void flushGateQueueWithQubitExchanges() {
+    const std::size_t numTasks = gateQueue.size();
+    std::vector<std::vector<std::size_t>> targets;
+    targets.reserve(numTasks);
+    for (std::size_t i = 0; i < numTasks; ++i)
+      targets.push_back(gateQueue[i].targets);
+
+    GlobalQubitScheduler scheduler(nQubitsAllocated, getNumLocalQubits());
+    std::size_t numExchanges = 0;
+    for (std::size_t i = 0; i < numTasks; ++i) {
+      const auto swaps =
+          scheduler.planExchange(targets, i, qubitExchangeLookahead);
+      if (!swaps.empty()) {
+        swapQubitPositions(swaps);
+        ++numExchanges;
+      }
+      const auto &task = gateQueue[i];
+      applyGateTask(GateApplicationTask(
+          task.operationName, task.matrix, scheduler.positionsOf(task.controls),
+          scheduler.positionsOf(task.targets), task.parameters));
+    }
+    gateQueue.clear();
+    if (!scheduler.isIdentity())
+      swapQubitPositions(scheduler.planRestore());
+    CUDAQ_INFO("Applied {} gates with {} global qubit exchanges.", numTasks,
+               numExchanges);
+  }
+
+  /// @brief Flush the gate queue, run all queued gate
+  /// application tasks.
+  void flushGateQueueImpl() override {
+    // The execution needs its state, it is no longer part of the batch.
+    recordingBatchedExecution = false;
+    if (recordingLightcones) {
+      // The gates are only applied to the lightcones of the observed terms.
+      for (; !gateQueue.empty(); gateQueue.pop())
+        lightconeTape.push_back(gateQueue.front());
+      return;
+    }
+    std::optional<cudaq::profiler::ScopedPhase> phase;
+    if (cudaq::profiler::isEnabled() && !gateQueue.empty()) {
+      phase.emplace(cudaq::profiler::Phase::simulator_flush, name());
+      phase->addCounter("gates", gateQueue.size());
+    }
+    if (perfCounters && !gateQueue.empty())
+      ++perfCounters->flushes;
+    if (shouldScheduleQubitExchanges()) {
+      flushGateQueueWithQubitExchanges();
+    } else if (shouldAccumulateDiagonalGates()) {
+      flushGateQueueWithDiagonalRuns();
+    } else if (shouldFuseGates()) {
+      flushGateQueueWithFusion();
+    } else {
+      while (!gateQueue.empty()) {
+        applyGateTask(gateQueue.front());
+        gateQueue.pop();
+      }
+    }
     // For CUDA-based simulators, this calls cudaDeviceSynchronize()
     synchronize();
+    if (!checkpointFile.empty() && nQubitsAllocated > 0 &&
+        numEnqueuedGates >= checkpointedGates + checkpointInterval)
+      writeCheckpoint();
   }
 
   /// @brief Set the current state to the |0> state,
@@ -850,7 +1644,28 @@ protected:
 
 public:
   /// @brief The constructor
-  CircuitSimulatorBase() = default;
+  CircuitSimulatorBase() {
+    if (auto *fusionEnvVal = std::getenv(gateFusionEnvVar)) {
+      auto fusionSize = std::atoi(fusionEnvVal);
+      if (fusionSize < 0 ||
+          static_cast<std::size_t>(fusionSize) > maxGateFusionQubits)
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting an integer "
+            "value between 0 and {}, got '{}'.",
+            gateFusionEnvVar, maxGateFusionQubits, fusionEnvVal));
+      gateFusionMaxQubits = fusionSize;
+    }
+    accumulateDiagonalGates = cudaq::getEnvBool(diagonalGateRunsEnvVar, false);
+    if (auto *compactionEnvVal = std::getenv(stateCompactionEnvVar)) {
+      auto minQubits = std::atoi(compactionEnvVal);
+      if (minQubits < 0)
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting a "
+            "non-negative integer, got '{}'.",
+            stateCompactionEnvVar, compactionEnvVal));
+      stateCompactionMinQubits = minQubits;
+    }
+  }
   /// @brief The destructor
   virtual ~CircuitSimulatorBase() = default;
 
@@ -909,6 +1724,16 @@ public:
       }
     }
 
+    if (state != nullptr && recordingLightcones)
+      throw std::runtime_error(
+          std::string("Qubit initialization from a state is not supported in "
+                      "kernels observed from lightcones, unset ") +
+          lightconeObserveEnvVar + ".");
+
+    // Batched executions start from the |0> state.
+    if (state != nullptr)
+      recordingBatchedExecution = false;
+
     return allocateQubitsInternal(count, [this, state](std::size_t numAllocs) {
       addQubitsToState(numAllocs, state);
     });
@@ -924,6 +1749,12 @@ public:
     if (!isInTracerMode() && count != state->getNumQubits())
       throw std::invalid_argument("Dimension mismatch: the input state doesn't "
                                   "match the number of qubits");
+    if (recordingLightcones)
+      throw std::runtime_error(
+          std::string("Qubit initialization from a state is not supported in "
+                      "kernels observed from lightcones, unset ") +
+          lightconeObserveEnvVar + ".");
+    recordingBatchedExecution = false;
 
     return allocateQubitsInternal(count, [this, state](std::size_t numAllocs) {
       if (numAllocs != state->getNumQubits()) {
@@ -937,7 +1768,7 @@ public:
   }
 
   void deallocateQubits(const std::vector<std::size_t> &qubits) override {
-    if (executionContext) {
+    if (!deallocatesQubits()) {
       // Avoid deallocation as we may need to access the state after the
       // execution has completed.
       // TODO: reduce the cases where this is needed.
@@ -961,16 +1792,20 @@ public:
     }
 
     if (getNumQubits() == 0) {
-      if (isInBatchMode() && !isLastBatch()) {
+      // A shot of `cudaq::run()` keeps its state for the next allocations of
+      // the shot, the state is deallocated when the shot ends.
+      if ((isInBatchMode() && !isLastBatch()) || executionContext) {
         setToZeroState();
-        auto empty = std::queue<GateApplicationTask>{};
-        std::swap(gateQueue, empty);
+        clearGateQueue();
       } else {
         deallocateState();
       }
     } else {
+      // Reset the qubits, so that their indices can be recycled, and so that
+      // the state can drop them once they are the highest qubits.
       for (auto &q : qubits)
         resetQubit(q);
+      compactState();
     }
   }
 
@@ -980,14 +1815,35 @@ public:
     if (!executionContext)
       return;
 
+    // Defer the sampling of a batched execution to the last execution on the
+    // QPU, unless its result needs the processing of the mid-circuit
+    // measurements, the registers or the qubit mapping.
+    if (recordingBatchedExecution && midCircuitSampleResults.empty() &&
+        registerNameToMeasuredQubit.size() <= 1 &&
+        executionContext->reorderIdx.empty() && getNumQubits() > 0)
+      deferBatchedExecution();
+
     // Flush the queue if there are any gates to apply
     flushGateQueue();
 
+    // A checkpoint not reached by the end of the simulation belongs to a
+    // different circuit. Tear down as usual, then report it.
+    std::string restoreError;
+    if (pendingRestore) {
+      restoreError = cudaq_fmt::format(
+          "The simulation ended after {} gates, before reaching the state "
+          "checkpoint taken after {} gates.",
+          numEnqueuedGates, pendingRestore->header().numGates);
+      pendingRestore.reset();
+    }
+
     // Get the ExecutionContext name
     auto execContextName = executionContext->name;
 
     // If we are sampling...
-    if (execContextName == "sample") {
+    if (execContextName == "sample" && !executionContext->resultDeferred) {
+      cudaq::profiler::ScopedPhase phase(
+          cudaq::profiler::Phase::sample_conversion, currentCircuitName);
       // Sample the state over the specified number of shots
       if (sampleQubits.empty() && !executionContext->explicitMeasurements) {
         sampleQubits.resize(getNumQubits());
@@ -1056,16 +1912,29 @@ public:
       generateMSM();
     }
 
-    bool shouldSetToZero = isInBatchMode() && !isLastBatch();
+    if (perfCounters) {
+      executionContext->perfCounters = *perfCounters;
+      cudaq::set_last_perf_counters(*perfCounters);
+      perfCounters.reset();
+    }
+
+    bool shouldSetToZero =
+        isInBatchMode() && !isLastBatch() && !recordingLightcones;
+    auto *context = executionContext;
+    const bool sampleBatch = context->batchedSampling &&
+                             context->batchIteration + 1 ==
+                                 context->totalIterations &&
+                             !batchedExecutions.empty();
     executionContext = nullptr;
+    recordingLightcones = false;
+    lightconeTape.clear();
 
     // Reset the state if we've deallocated all qubits.
     if (shouldSetToZero) {
       CUDAQ_INFO("In batch mode currently, resetting simulator state to |0>");
       // Do not deallocate the state, but reset it to |0> to be reused
       setToZeroState();
-      auto empty = std::queue<GateApplicationTask>{};
-      std::swap(gateQueue, empty);
+      clearGateQueue();
     } else {
       CUDAQ_INFO("Deallocating simulator state.");
       // all qubits deallocated,
@@ -1073,14 +1942,45 @@ public:
     }
 
     tracker = {};
+    if (sampleBatch) {
+      // The batch is simulated once the state of the last execution is freed.
+      auto executions = std::move(batchedExecutions);
+      batchedExecutions.clear();
+      CUDAQ_INFO("Sampling a batch of {} deferred executions.",
+                 executions.size());
+      for (auto &result : sampleBatchedExecutions(executions))
+        context->deferredResults.emplace_back(std::move(result));
+    }
+    if (!restoreError.empty())
+      throw std::runtime_error(restoreError);
   }
 
   /// @brief Set the execution context
   void setExecutionContext(cudaq::ExecutionContext *context) override {
     executionContext = context;
-    executionContext->canHandleObserve = canHandleObserve();
+    lightconeTape.clear();
+    recordingLightcones = supportsLightconeObserve &&
+                          context->name == "observe" &&
+                          context->shots == static_cast<std::size_t>(-1) &&
+                          !context->noiseModel &&
+                          cudaq::getEnvBool(lightconeObserveEnvVar, false);
+    executionContext->canHandleObserve =
+        recordingLightcones || canHandleObserve();
+    // Executions left by an interrupted broadcast are dropped.
+    if (!context->batchedSampling || context->batchIteration == 0)
+      batchedExecutions.clear();
+    recordingBatchedExecution =
+        supportsBatchedSampling && context->batchedSampling &&
+        context->name == "sample" && context->totalIterations > 1 &&
+        !context->noiseModel && !context->explicitMeasurements &&
+        !context->hasConditionalsOnMeasureResults && !measurementBranching &&
+        checkpointFile.empty() && !pendingRestore &&
+        cudaq::getEnvBool(batchedSamplingEnvVar, true);
     currentCircuitName = context->kernelName;
     CUDAQ_INFO("Setting current circuit name to {}", currentCircuitName);
+    perfCounters.reset();
+    if (cudaq::perf_counters_enabled())
+      perfCounters.emplace();
   }
 
   /// @brief Return the current execution context
@@ -1096,7 +1996,8 @@ public:
     flushAnySamplingTasks();
     auto numRows = std::sqrt(matrix.size());
     auto numQubits = std::log2(numRows);
-    std::vector<std::complex<ScalarType>> actual;
+    auto &actual = gateMatrix;
+    actual.clear();
     if (numQubits > 1 && getQubitOrdering() != QubitOrdering::msb) {
       // Convert the matrix to LSB qubit ordering
       auto convertOrdering = [](std::size_t numQubits, std::size_t idx) {
@@ -1140,31 +2041,61 @@ public:
                 controls, targets, {});
   }
 
+  void applyCachedCustomOperation(const cudaq::cached_unitary &unitary,
+                                  const std::vector<std::size_t> &controls,
+                                  const std::vector<std::size_t> &targets,
+                                  const std::string_view customName) override {
+    // Multi-qubit matrices in LSB ordering need their rows and columns
+    // permuted first.
+    if (targets.size() > 1 && getQubitOrdering() != QubitOrdering::msb)
+      return applyCustomOperation(unitary.fp64, controls, targets, customName);
+    flushAnySamplingTasks();
+    // The matrix in the simulation precision is used as is.
+    const auto &matrix = unitary.get<ScalarType>();
+    CUDAQ_INFO(gateToString(customName.empty() ? "unknown op" : customName,
+                            controls, {}, targets) +
+                   " = {}",
+               unitary.fp64);
+    enqueueGate(customName.empty() ? "unknown op" : customName.data(), matrix,
+                controls, targets, {});
+  }
+
   template <typename QuantumOperation>
-  void enqueueQuantumOperation(const std::vector<ScalarType> &angles,
-                               const std::vector<std::size_t> &controls,
-                               const std::vector<std::size_t> &targets) {
+  void enqueueQuantumOperation(std::span<const ScalarType> angles,
+                               std::span<const std::size_t> controls,
+                               std::span<const std::size_t> targets) {
     flushAnySamplingTasks();
     QuantumOperation gate;
-    CUDAQ_INFO(gateToString(gate.name(), controls, angles, targets));
-    enqueueGate(gate.name(), gate.getGate(angles), controls, targets, angles);
+    CUDAQ_INFO(gateToString(gate.name(), {controls.begin(), controls.end()},
+                            {angles.begin(), angles.end()},
+                            {targets.begin(), targets.end()}));
+    if (angles.empty()) {
+      // The matrix of a constant gate is computed once, and shared by all its
+      // applications.
+      static const auto matrix =
+          getGateByName<ScalarType>(QuantumOperation::gateName);
+      enqueueGate(gate.name(), matrix, controls, targets, angles);
+      return;
+    }
+    getGateByName<ScalarType>(QuantumOperation::gateName, angles, gateMatrix);
+    enqueueGate(gate.name(), gateMatrix, controls, targets, angles);
   }
 
 #define CIRCUIT_SIMULATOR_ONE_QUBIT(NAME)                                      \
   using CircuitSimulator::NAME;                                                \
   void NAME(const std::vector<std::size_t> &controls,                          \
             const std::size_t qubitIdx) override {                             \
-    enqueueQuantumOperation<nvqir::NAME<ScalarType>>(                          \
-        {}, controls, std::vector<std::size_t>{qubitIdx});                     \
+    enqueueQuantumOperation<nvqir::NAME<ScalarType>>({}, controls,             \
+                                                     {&qubitIdx, 1});          \
   }
 
 #define CIRCUIT_SIMULATOR_ONE_QUBIT_ONE_PARAM(NAME)                            \
   using CircuitSimulator::NAME;                                                \
   void NAME(const double angle, const std::vector<std::size_t> &controls,      \
             const std::size_t qubitIdx) override {                             \
-    enqueueQuantumOperation<nvqir::NAME<ScalarType>>(                          \
-        {static_cast<ScalarType>(angle)}, controls,                            \
-        std::vector<std::size_t>{qubitIdx});                                   \
+    const ScalarType angles[] = {static_cast<ScalarType>(angle)};              \
+    enqueueQuantumOperation<nvqir::NAME<ScalarType>>(angles, controls,         \
+                                                     {&qubitIdx, 1});          \
   }
 
   /// @brief The X gate
@@ -1202,32 +2133,31 @@ public:
   void u2(const double phi, const double lambda,
           const std::vector<std::size_t> &controls,
           const std::size_t qubitIdx) override {
-    std::vector<ScalarType> tmp{static_cast<ScalarType>(phi),
-                                static_cast<ScalarType>(lambda)};
-
-    enqueueQuantumOperation<nvqir::u2<ScalarType>>(
-        tmp, controls, std::vector<std::size_t>{qubitIdx});
+    const ScalarType angles[] = {static_cast<ScalarType>(phi),
+                                 static_cast<ScalarType>(lambda)};
+    enqueueQuantumOperation<nvqir::u2<ScalarType>>(angles, controls,
+                                                   {&qubitIdx, 1});
   }
 
   using CircuitSimulator::u3;
   void u3(const double theta, const double phi, const double lambda,
           const std::vector<std::size_t> &controls,
           const std::size_t qubitIdx) override {
-    std::vector<ScalarType> tmp{static_cast<ScalarType>(theta),
-                                static_cast<ScalarType>(phi),
-                                static_cast<ScalarType>(lambda)};
-    enqueueQuantumOperation<nvqir::u3<ScalarType>>(
-        tmp, controls, std::vector<std::size_t>{qubitIdx});
+    const ScalarType angles[] = {static_cast<ScalarType>(theta),
+                                 static_cast<ScalarType>(phi),
+                                 static_cast<ScalarType>(lambda)};
+    enqueueQuantumOperation<nvqir::u3<ScalarType>>(angles, controls,
+                                                   {&qubitIdx, 1});
   }
 
   using CircuitSimulator::phased_rx;
   void phased_rx(const double phi, const double lambda,
                  const std::vector<std::size_t> &controls,
                  const std::size_t qubitIdx) override {
-    std::vector<ScalarType> tmp{static_cast<ScalarType>(phi),
-                                static_cast<ScalarType>(lambda)};
-    enqueueQuantumOperation<nvqir::phased_rx<ScalarType>>(
-        tmp, controls, std::vector<std::size_t>{qubitIdx});
+    const ScalarType angles[] = {static_cast<ScalarType>(phi),
+                                 static_cast<ScalarType>(lambda)};
+    enqueueQuantumOperation<nvqir::phased_rx<ScalarType>>(angles, controls,
+                                                          {&qubitIdx, 1});
   }
 
   using CircuitSimulator::swap;
@@ -1236,12 +2166,9 @@ public:
             const std::size_t tgtIdx) override {
     flushAnySamplingTasks();
     CUDAQ_INFO(gateToString("swap", ctrlBits, {}, {srcIdx, tgtIdx}));
-    std::vector<std::complex<ScalarType>> matrix{
-        {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0},
-        {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0},
-        {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}};
-    enqueueGate("swap", matrix, ctrlBits,
-                std::vector<std::size_t>{srcIdx, tgtIdx}, {});
+    static const auto matrix = getGateByName<ScalarType>(GateName::Swap);
+    const std::size_t targets[] = {srcIdx, tgtIdx};
+    enqueueGate("swap", matrix, ctrlBits, targets, {});
   }
 
   bool mz(const std::size_t qubitIdx) override { return mz(qubitIdx, ""); }
@@ -1256,14 +2183,20 @@ public:
   /// context, just measure, collapse, and return the bit.
   bool mz(const std::size_t qubitIdx,
           const std::string &registerName) override {
-    // Flush the Gate Queue
-    flushGateQueue();
+    checkNoPendingRestore("measure a qubit");
+    // Flush the Gate Queue, unless the gates are recorded for a batched
+    // execution, which only samples the final state.
+    if (!recordingBatchedExecution)
+      flushGateQueue();
 
     // Apply measurement noise (if any)
     // Note: gate noises are applied during flushGateQueue
-    if (executionContext && executionContext->noiseModel)
+    if (executionContext && executionContext->noiseModel) {
       applyNoiseChannel(/*gateName=*/"mz", /*controls=*/{},
                         /*targets=*/{qubitIdx}, /*params=*/{});
+      if (perfCounters)
+        countNoiseChannels("mz", {}, {qubitIdx}, {});
+    }
 
     // If sampling, just store the bit, do nothing else.
     if (handleBasicSampling(qubitIdx, registerName))
@@ -1272,8 +2205,9 @@ public:
     if (isInTracerMode())
       return true;
 
-    // Get the actual measurement from the subtype measureQubit implementation
-    auto measureResult = measureQubit(qubitIdx);
+    // Get the actual measurement from the subtype measureQubit implementation,
+    // or from the current measurement branch.
+    auto measureResult = measureOrFollowBranch(qubitIdx);
 
     // Return the result
     return measureResult;
@@ -1284,6 +2218,12 @@ public:
   // only the relative order of the target in the spin op is relevant.
   void measureSpinOp(const cudaq::spin_op &op) override {
     flushGateQueue();
+    ScopedPerfTimer timer(perfTimer(&cudaq::perf_counters::observe_seconds));
+
+    if (recordingLightcones) {
+      observeFromLightcones(executionContext->spin.value());
+      return;
+    }
 
     if (executionContext->canHandleObserve) {
       auto result = observe(executionContext->spin.value());
@@ -1292,10 +2232,10 @@ public:
       return;
     }
 
-    if (op.num_terms() != 1)
-      // more than one term needs to be directly supported by the backend
-      throw std::runtime_error(
-          "measuring a sum of spin operators is not supported");
+    if (op.num_terms() != 1) {
+      measureCommutingSpinOpTerms(op);
+      return;
+    }
 
     CUDAQ_INFO("Measure {}", op.to_string());
     std::vector<std::size_t> qubitsToMeasure;
@@ -1347,17 +2287,217 @@ public:
     }
   }
 
+protected:
+  /// @brief Simulate the backward lightcone of the `support` qubits in the
+  /// recorded gates, i.e., the gates acting on them, directly or through
+  /// later gates, on a state that only spans the qubits of the lightcone.
+  /// Then call `observe` with the index of each qubit in this state (that of
+  /// the qubits outside of the lightcone is unspecified).
+  template <typename Callable>
+  void simulateLightcone(const std::vector<std::size_t> &support,
+                         Callable &&observe) {
+    // Walk the gates backwards, growing the lightcone with the qubits of the
+    // gates acting on it.
+    std::vector<bool> inCone(
+        std::max(tracker.numIndices(), support.back() + 1));
+    for (auto qubit : support)
+      inCone[qubit] = true;
+    const auto actsOnCone = [&](const std::vector<std::size_t> &qubits) {
+      return std::any_of(qubits.begin(), qubits.end(),
+                         [&](std::size_t q) { return inCone[q]; });
+    };
+    std::vector<const GateApplicationTask *> coneGates;
+    for (auto iter = lightconeTape.rbegin(); iter != lightconeTape.rend();
+         ++iter) {
+      if (!actsOnCone(iter->controls) && !actsOnCone(iter->targets))
+        continue;
+      for (auto q : iter->controls)
+        inCone[q] = true;
+      for (auto q : iter->targets)
+        inCone[q] = true;
+      coneGates.push_back(&*iter);
+    }
+
+    // Number the qubits of the lightcone in increasing order.
+    std::vector<std::size_t> localIndex(inCone.size());
+    std::size_t numConeQubits = 0;
+    for (std::size_t q = 0; q < inCone.size(); ++q)
+      if (inCone[q])
+        localIndex[q] = numConeQubits++;
+    CUDAQ_INFO("Simulating a lightcone of {} gates on {} qubits.",
+               coneGates.size(), numConeQubits);
+
+    nQubitsAllocated = numConeQubits;
+    stateDimension = calculateStateDim(numConeQubits);
+    addQubitsToState(numConeQubits);
+    GateApplicationTask localTask;
+    for (auto iter = coneGates.rbegin(); iter != coneGates.rend(); ++iter) {
+      const auto &task = **iter;
+      localTask.assign(task.operationName, task.matrix, task.controls,
+                       task.targets, task.parameters);
+      for (auto &q : localTask.controls)
+        q = localIndex[q];
+      for (auto &q : localTask.targets)
+        q = localIndex[q];
+      applyGateTask(localTask);
+    }
+    observe(localIndex);
+    deallocateState();
+  }
+
+  /// @brief Compute the exact expectation value of `op` from the recorded
+  /// gates. Only the backward lightcone of the qubits a term measures affects
+  /// its expectation value, and terms with the same support share their
+  /// lightcone. The context result holds one register per term (named by the
+  /// term id).
+  void observeFromLightcones(const cudaq::spin_op &op) {
+    double sum = 0.0;
+    std::map<std::vector<std::size_t>, std::vector<cudaq::spin_op_term>>
+        termsBySupport;
+    for (const auto &term : op) {
+      if (term.is_identity()) {
+        sum += term.evaluate_coefficient().real();
+        continue;
+      }
+      std::vector<std::size_t> support;
+      for (const auto &p : term)
+        if (p.as_pauli() != cudaq::pauli::I)
+          support.push_back(p.target());
+      std::sort(support.begin(), support.end());
+      termsBySupport[support].push_back(term);
+    }
+
+    recordingLightcones = false;
+    std::vector<cudaq::ExecutionResult> results;
+    for (const auto &[support, terms] : termsBySupport)
+      simulateLightcone(support, [&](const std::vector<std::size_t> &index) {
+        for (const auto &term : terms) {
+          std::vector<std::size_t> qubitsToMeasure;
+          for (const auto &p : term) {
+            const auto pauli = p.as_pauli();
+            if (pauli == cudaq::pauli::I)
+              continue;
+            qubitsToMeasure.push_back(index[p.target()]);
+            if (pauli == cudaq::pauli::X)
+              h(index[p.target()]);
+            else if (pauli == cudaq::pauli::Y)
+              rx(M_PI_2, index[p.target()]);
+          }
+          flushGateQueue();
+          const double termExp =
+              sample(qubitsToMeasure, 0).expectationValue.value_or(0.0);
+          results.emplace_back(cudaq::CountsDictionary{}, term.get_term_id(),
+                               termExp);
+          sum += term.evaluate_coefficient().real() * termExp;
+
+          // Restore the state for the next term.
+          for (const auto &p : term) {
+            if (p.as_pauli() == cudaq::pauli::X)
+              h(index[p.target()]);
+            else if (p.as_pauli() == cudaq::pauli::Y)
+              rx(-M_PI_2, index[p.target()]);
+          }
+          flushGateQueue();
+        }
+      });
+    recordingLightcones = true;
+
+    executionContext->expectationValue = sum;
+    executionContext->result = cudaq::sample_result(sum, results);
+  }
+
+  /// @brief Measure all terms of `op`, which must be qubit-wise commuting,
+  /// with a single basis change. If shots-based, the union of the measured
+  /// qubits is sampled once and the counts of each term are marginalized from
+  /// these shots. The context result holds one register per term (named by the
+  /// term id), and the expectation value is the coefficient-weighted sum.
+  void measureCommutingSpinOpTerms(const cudaq::spin_op &op) {
+    CUDAQ_INFO("Measure qubit-wise commuting terms {}", op.to_string());
+    std::map<std::size_t, cudaq::pauli> basis;
+    for (const auto &term : op)
+      for (const auto &p : term) {
+        if (p.as_pauli() == cudaq::pauli::I)
+          continue;
+        auto [iter, inserted] = basis.emplace(p.target(), p.as_pauli());
+        if (!inserted && iter->second != p.as_pauli())
+          throw std::runtime_error("measuring a sum of spin operators is only "
+                                   "supported for qubit-wise commuting terms");
+      }
+
+    auto changeBasis = [&](bool reverse) {
+      for (auto &[target, pauli] : basis) {
+        if (pauli == cudaq::pauli::Y)
+          rx(!reverse ? M_PI_2 : -M_PI_2, target);
+        else if (pauli == cudaq::pauli::X)
+          h(target);
+      }
+      flushGateQueue();
+    };
+    changeBasis(false);
+
+    int shots = 0;
+    if (executionContext->shots > 0)
+      shots = executionContext->shots;
+
+    std::vector<std::size_t> allQubits;
+    for (auto &[target, pauli] : basis)
+      allQubits.push_back(target);
+    cudaq::ExecutionResult allShots;
+    if (shots > 0)
+      allShots = sample(allQubits, shots);
+
+    std::vector<cudaq::ExecutionResult> results;
+    double sum = 0.0;
+    for (const auto &term : op) {
+      std::vector<std::size_t> termQubits;
+      for (const auto &p : term)
+        if (p.as_pauli() != cudaq::pauli::I)
+          termQubits.push_back(p.target());
+
+      double termExp = 0.0;
+      cudaq::CountsDictionary termCounts;
+      if (shots > 0) {
+        // Position of each term qubit in the bit strings of `allShots`.
+        std::vector<std::size_t> positions;
+        for (auto q : termQubits)
+          positions.push_back(std::lower_bound(allQubits.begin(),
+                                               allQubits.end(), q) -
+                              allQubits.begin());
+        for (auto &[bits, count] : allShots.counts) {
+          std::string marginal;
+          for (auto pos : positions)
+            marginal += bits[pos];
+          termCounts[marginal] += count;
+          const bool even = cudaq::sample_result::has_even_parity(marginal);
+          termExp += (even ? 1.0 : -1.0) * count / shots;
+        }
+      } else {
+        termExp = sample(termQubits, 0).expectationValue.value_or(0.0);
+      }
+      results.emplace_back(termCounts, term.get_term_id(), termExp);
+      sum += term.evaluate_coefficient().real() * termExp;
+    }
+
+    executionContext->expectationValue = sum;
+    executionContext->result = cudaq::sample_result(sum, results);
+
+    changeBasis(true);
+  }
+
 private:
   template <std::invocable<std::size_t> Callable>
   std::vector<std::size_t> allocateQubitsInternal(std::size_t count,
                                                   Callable &&allocateQubits) {
+    if (!checkpointSettingsRead)
+      readCheckpointSettings();
     std::vector<std::size_t> qubits;
     for (std::size_t i = 0; i < count; i++)
       qubits.emplace_back(tracker.getNextIndex());
 
     // We only need to allocate new qubits if the number of qubits
     // requested is greater than the number of qubits already allocated.
-    if (getNumQubits() > nQubitsAllocated) {
+    // The state of the lightcones is only allocated on observation.
+    if (getNumQubits() > nQubitsAllocated && !recordingLightcones) {
       auto numAllocs = getNumQubits() - nQubitsAllocated;
 
       CUDAQ_INFO("Allocating {} new qubits.", numAllocs);
@@ -1375,6 +2515,10 @@ private:
           stateDimension = previousStateDimension;
           throw;
         }
+        if (cudaq::profiler::isEnabled() && isStateVectorSimulator())
+          cudaq::profiler::addCounter(
+              "bytes_allocated", (stateDimension - previousStateDimension) *
+                                     sizeof(std::complex<ScalarType>));
       }
 
       // May be that the state grows enough that we
@@ -0,0 +1,225 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nvqir {
+
+/// @brief A DiagonalGateRun accumulates a run of adjacent diagonal gates, such
+/// as the `rz` and controlled phase gates of a QAOA cost layer, along with the
+/// CNOT, X and SWAP gates in between, such as the CNOTs of the CNOT-RZ-CNOT
+/// decomposition of `rzz`. The run is equivalent to a phase function of the
+/// basis states it is applied to, followed by the permutation of the basis
+/// states made up by its CNOT, X and SWAP gates.
+///
+/// The phase of basis state `k` is the sum of Walsh terms
+/// `sum_j angles[j] * (-1)^popcount(k & masks[j])`, where bit `q` of a mask
+/// stands for qubit `q`. The value of each qubit is tracked as the parity of a
+/// set of qubits of the input basis state, possibly negated, so that diagonal
+/// gates following CNOTs contribute terms on these parities.
+///
+/// Gate matrices are row-major over the targets. With `msbOrdering` the first
+/// target maps to the most significant bit of the matrix index, otherwise the
+/// first target maps to the least significant bit.
+template <typename ScalarType>
+class DiagonalGateRun {
+public:
+  using ComplexType = std::complex<ScalarType>;
+
+  /// @brief The maximum number of qubits (controls and targets) of a diagonal
+  /// gate absorbed into a run, which contributes up to 2^n Walsh terms.
+  static constexpr std::size_t maxDiagonalGateQubits = 6;
+
+  explicit DiagonalGateRun(bool msbOrdering) : msbOrdering(msbOrdering) {}
+
+  /// @brief Return true if no gate has been absorbed into this run.
+  bool empty() const { return numGates == 0; }
+
+  /// @brief Return the number of gates absorbed into this run.
+  std::size_t size() const { return numGates; }
+
+  /// @brief Return the number of diagonal gates absorbed into this run.
+  std::size_t numDiagonalGates() const { return numDiagonal; }
+
+  /// @brief The qubit masks of the Walsh terms of the phase function.
+  const std::vector<std::uint64_t> &getMasks() const { return masks; }
+
+  /// @brief The angles of the Walsh terms of the phase function.
+  const std::vector<double> &getAngles() const { return angles; }
+
+  /// @brief Return true if the gate `name` is absorbed as part of the
+  /// permutation of the run, rather than of its phase function.
+  static bool isPermutationGate(std::string_view name) {
+    return name == "x" || name == "swap";
+  }
+
+  /// @brief Return true if the CNOT, X and SWAP gates of the run make up the
+  /// identity, as in CNOT-RZ-CNOT, so that the run is its phase function.
+  bool isPermutationIdentity() const {
+    for (const auto &[qubit, parity] : parities)
+      if (parity.mask != (std::uint64_t(1) << qubit) || parity.negated)
+        return false;
+    return true;
+  }
+
+  /// @brief Absorb the (controlled) gate `name` with the matrix `matrix` into
+  /// the run, and return true, if it is a CNOT, an X, a SWAP or a diagonal
+  /// gate. Otherwise, return false and leave the run unchanged.
+  bool absorb(std::string_view name, const std::vector<ComplexType> &matrix,
+              const std::vector<std::size_t> &controls,
+              const std::vector<std::size_t> &targets) {
+    for (const auto *qubits : {&controls, &targets})
+      for (auto q : *qubits)
+        if (q >= 64)
+          return false;
+
+    if (name == "x" && controls.size() <= 1 && targets.size() == 1) {
+      const Parity control =
+          controls.empty() ? Parity{0, true} : parityOf(controls[0]);
+      auto &target = trackedParity(targets[0]);
+      target.mask ^= control.mask;
+      target.negated ^= control.negated;
+      ++numGates;
+      return true;
+    }
+    if (name == "swap" && controls.empty() && targets.size() == 2) {
+      trackedParity(targets[0]);
+      trackedParity(targets[1]);
+      std::swap(parities.at(targets[0]), parities.at(targets[1]));
+      ++numGates;
+      return true;
+    }
+    if (isPermutationGate(name) ||
+        controls.size() + targets.size() > maxDiagonalGateQubits ||
+        !isDiagonal(matrix, targets.size()))
+      return false;
+
+    absorbDiagonal(matrix, controls, targets);
+    ++numGates;
+    ++numDiagonal;
+    return true;
+  }
+
+  /// @brief Reset the run to the empty state.
+  void clear() {
+    parities.clear();
+    masks.clear();
+    angles.clear();
+    termIndices.clear();
+    numGates = 0;
+    numDiagonal = 0;
+  }
+
+private:
+  /// @brief The value of a qubit, as the parity of the input qubits in
+  /// `mask`, negated if `negated` is set.
+  struct Parity {
+    std::uint64_t mask = 0;
+    bool negated = false;
+  };
+
+  /// @brief Return the parity qubit `q` currently holds.
+  Parity parityOf(std::size_t q) const {
+    auto iter = parities.find(q);
+    return iter == parities.end() ? Parity{std::uint64_t(1) << q, false}
+                                  : iter->second;
+  }
+
+  /// @brief Return the parity of qubit `q`, to be updated.
+  Parity &trackedParity(std::size_t q) {
+    return parities.try_emplace(q, Parity{std::uint64_t(1) << q, false})
+        .first->second;
+  }
+
+  static bool isDiagonal(const std::vector<ComplexType> &matrix,
+                         std::size_t numTargets) {
+    const std::size_t dim = 1ULL << numTargets;
+    if (matrix.size() != dim * dim)
+      return false;
+    for (std::size_t r = 0; r < dim; ++r)
+      for (std::size_t c = 0; c < dim; ++c)
+        if (r != c && matrix[r * dim + c] != ComplexType(0))
+          return false;
+    return true;
+  }
+
+  /// @brief Add the Walsh terms of the phases of a diagonal gate.
+  void absorbDiagonal(const std::vector<ComplexType> &matrix,
+                      const std::vector<std::size_t> &controls,
+                      const std::vector<std::size_t> &targets) {
+    // Bit i of an assignment of the gate qubits is the value of gateQubits[i].
+    std::vector<std::size_t> gateQubits(controls);
+    gateQubits.insert(gateQubits.end(), targets.begin(), targets.end());
+    const std::size_t numTargets = targets.size();
+    const std::size_t gateDim = 1ULL << numTargets;
+    const std::size_t dim = 1ULL << gateQubits.size();
+    const std::size_t controlBits = (1ULL << controls.size()) - 1;
+
+    std::vector<double> phases(dim, 0.0);
+    for (std::size_t b = 0; b < dim; ++b) {
+      if ((b & controlBits) != controlBits)
+        continue;
+      std::size_t row = 0;
+      for (std::size_t j = 0; j < numTargets; ++j)
+        if ((b >> (controls.size() + j)) & 1)
+          row |= 1ULL << (msbOrdering ? numTargets - 1 - j : j);
+      phases[b] = std::arg(std::complex<double>(matrix[row * gateDim + row]));
+    }
+
+    // Walsh-Hadamard transform of the phases, such that
+    // phases(b) = sum_S w_S (-1)^popcount(b & S).
+    for (std::size_t len = 1; len < dim; len <<= 1)
+      for (std::size_t i = 0; i < dim; i += 2 * len)
+        for (std::size_t j = i; j < i + len; ++j) {
+          const double a = phases[j];
+          phases[j] = a + phases[j + len];
+          phases[j + len] = a - phases[j + len];
+        }
+
+    for (std::size_t s = 0; s < dim; ++s) {
+      const double w = phases[s] / dim;
+      if (std::abs(w) < angleTolerance)
+        continue;
+      Parity term;
+      for (std::size_t i = 0; i < gateQubits.size(); ++i)
+        if ((s >> i) & 1) {
+          const auto parity = parityOf(gateQubits[i]);
+          term.mask ^= parity.mask;
+          term.negated ^= parity.negated;
+        }
+      auto [iter, inserted] = termIndices.try_emplace(term.mask, masks.size());
+      if (inserted) {
+        masks.push_back(term.mask);
+        angles.push_back(0.0);
+      }
+      angles[iter->second] += term.negated ? -w : w;
+    }
+  }
+
+  /// @brief Walsh terms with smaller angles are dropped.
+  static constexpr double angleTolerance = 1e-14;
+
+  bool msbOrdering;
+  /// @brief The parities of the qubits the permutation gates acted on.
+  std::unordered_map<std::size_t, Parity> parities;
+  std::vector<std::uint64_t> masks;
+  std::vector<double> angles;
+  std::unordered_map<std::uint64_t, std::size_t> termIndices;
+  std::size_t numGates = 0;
+  std::size_t numDiagonal = 0;
+};
+} // namespace nvqir
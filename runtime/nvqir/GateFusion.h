@@ -0,0 +1,194 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace nvqir {
+
+/// @brief A GateFusionBlock accumulates a run of adjacent gates acting on a
+/// small set of qubits into a single dense unitary. Controlled gates are
+/// absorbed by treating their control qubits as part of the block.
+///
+/// The fused matrix is stored row-major over the (sorted) block qubits. The
+/// mapping from block qubit position to matrix index bit follows the qubit
+/// ordering of the simulator the block is dispatched to: with `msbOrdering`
+/// the first qubit maps to the most significant bit (Kronecker order),
+/// otherwise the first qubit maps to the least significant bit.
+template <typename ScalarType>
+class GateFusionBlock {
+public:
+  using ComplexType = std::complex<ScalarType>;
+
+  explicit GateFusionBlock(bool msbOrdering) : msbOrdering(msbOrdering) {}
+
+  /// @brief Return true if no gate has been absorbed into this block.
+  bool empty() const { return numGates == 0; }
+
+  /// @brief Return the number of gates fused into this block.
+  std::size_t size() const { return numGates; }
+
+  /// @brief The sorted qubit indices the fused matrix acts on.
+  const std::vector<std::size_t> &getQubits() const { return qubits; }
+
+  /// @brief The fused row-major matrix.
+  const std::vector<ComplexType> &getMatrix() const { return matrix; }
+
+  /// @brief Return the number of qubits this block would span after absorbing
+  /// a gate on the given controls and targets.
+  std::size_t numQubitsWith(const std::vector<std::size_t> &controls,
+                            const std::vector<std::size_t> &targets) const {
+    std::size_t count = qubits.size();
+    auto isNew = [&](std::size_t q) {
+      return !std::binary_search(qubits.begin(), qubits.end(), q);
+    };
+    count += std::count_if(controls.begin(), controls.end(), isNew);
+    count += std::count_if(targets.begin(), targets.end(), isNew);
+    return count;
+  }
+
+  /// @brief Left-multiply the block by the (controlled) gate `gateMatrix`,
+  /// expanding the block to cover any new qubits first. `gateMatrix` is
+  /// row-major over `targets`, using the same ordering convention as the block.
+  void absorb(const std::vector<ComplexType> &gateMatrix,
+              const std::vector<std::size_t> &controls,
+              const std::vector<std::size_t> &targets) {
+    std::vector<std::size_t> newQubits = qubits;
+    newQubits.insert(newQubits.end(), controls.begin(), controls.end());
+    newQubits.insert(newQubits.end(), targets.begin(), targets.end());
+    std::sort(newQubits.begin(), newQubits.end());
+    newQubits.erase(std::unique(newQubits.begin(), newQubits.end()),
+                    newQubits.end());
+    if (newQubits != qubits)
+      expandTo(newQubits);
+
+    const std::size_t dim = 1ULL << qubits.size();
+    const std::size_t nTargets = targets.size();
+    const std::size_t gateDim = 1ULL << nTargets;
+
+    std::size_t controlMask = 0;
+    for (auto c : controls)
+      controlMask |= blockBit(c);
+
+    // Block index bit for each bit of the gate matrix index.
+    std::vector<std::size_t> targetBits(nTargets);
+    std::size_t targetMask = 0;
+    for (std::size_t j = 0; j < nTargets; ++j) {
+      const std::size_t gateBitPos = msbOrdering ? nTargets - 1 - j : j;
+      targetBits[gateBitPos] = blockBit(targets[j]);
+      targetMask |= targetBits[gateBitPos];
+    }
+
+    auto spread = [&](std::size_t k) {
+      std::size_t idx = 0;
+      for (std::size_t b = 0; b < nTargets; ++b)
+        if (k & (1ULL << b))
+          idx |= targetBits[b];
+      return idx;
+    };
+
+    std::vector<std::size_t> offsets(gateDim);
+    for (std::size_t k = 0; k < gateDim; ++k)
+      offsets[k] = spread(k);
+
+    // Apply the gate to every column of the block matrix.
+    std::vector<ComplexType> in(gateDim), out(gateDim);
+    for (std::size_t col = 0; col < dim; ++col) {
+      for (std::size_t base = 0; base < dim; ++base) {
+        if ((base & targetMask) || (base & controlMask) != controlMask)
+          continue;
+        for (std::size_t k = 0; k < gateDim; ++k)
+          in[k] = matrix[(base | offsets[k]) * dim + col];
+        for (std::size_t r = 0; r < gateDim; ++r) {
+          ComplexType acc = 0;
+          for (std::size_t k = 0; k < gateDim; ++k)
+            acc += gateMatrix[r * gateDim + k] * in[k];
+          out[r] = acc;
+        }
+        for (std::size_t k = 0; k < gateDim; ++k)
+          matrix[(base | offsets[k]) * dim + col] = out[k];
+      }
+    }
+    ++numGates;
+  }
+
+  /// @brief Reset the block to the empty state.
+  void clear() {
+    qubits.clear();
+    matrix.clear();
+    numGates = 0;
+  }
+
+private:
+  /// @brief Return the matrix index bit mask of block qubit `q`.
+  std::size_t blockBit(std::size_t q) const {
+    const std::size_t pos =
+        std::lower_bound(qubits.begin(), qubits.end(), q) - qubits.begin();
+    return 1ULL << (msbOrdering ? qubits.size() - 1 - pos : pos);
+  }
+
+  /// @brief Tensor the current block matrix with the identity on the qubits
+  /// in `newQubits` that are not yet part of the block.
+  void expandTo(const std::vector<std::size_t> &newQubits) {
+    const std::size_t newDim = 1ULL << newQubits.size();
+    std::vector<ComplexType> newMatrix(newDim * newDim, ComplexType(0));
+    if (qubits.empty()) {
+      for (std::size_t i = 0; i < newDim; ++i)
+        newMatrix[i * newDim + i] = 1;
+    } else {
+      const std::size_t oldDim = 1ULL << qubits.size();
+      const std::size_t nNew = newQubits.size();
+      // Matrix index bit of each old qubit in the new block, and the mask of
+      // the freshly added qubits.
+      std::vector<std::size_t> oldBits(qubits.size());
+      std::size_t newOnlyMask = newDim - 1;
+      for (std::size_t p = 0; p < qubits.size(); ++p) {
+        const std::size_t pos =
+            std::lower_bound(newQubits.begin(), newQubits.end(), qubits[p]) -
+            newQubits.begin();
+        const std::size_t oldBitPos = msbOrdering ? qubits.size() - 1 - p : p;
+        oldBits[oldBitPos] = 1ULL << (msbOrdering ? nNew - 1 - pos : pos);
+        newOnlyMask &= ~oldBits[oldBitPos];
+      }
+      auto spread = [&](std::size_t k) {
+        std::size_t idx = 0;
+        for (std::size_t b = 0; b < oldBits.size(); ++b)
+          if (k & (1ULL << b))
+            idx |= oldBits[b];
+        return idx;
+      };
+      std::vector<std::size_t> offsets(oldDim);
+      for (std::size_t k = 0; k < oldDim; ++k)
+        offsets[k] = spread(k);
+
+      // Enumerate all assignments of the new qubits; the old matrix is
+      // repeated along the diagonal of that subspace.
+      for (std::size_t rest = 0; rest < newDim; ++rest) {
+        if (rest & ~newOnlyMask)
+          continue;
+        for (std::size_t r = 0; r < oldDim; ++r)
+          for (std::size_t c = 0; c < oldDim; ++c)
+            newMatrix[(rest | offsets[r]) * newDim + (rest | offsets[c])] =
+                matrix[r * oldDim + c];
+      }
+    }
+    qubits = newQubits;
+    matrix = std::move(newMatrix);
+  }
+
+  bool msbOrdering;
+  std::vector<std::size_t> qubits;
+  std::vector<ComplexType> matrix;
+  std::size_t numGates = 0;
+};
+
+} // namespace nvqir
@@ -0,0 +1,67 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace nvqir {
+
+/// @brief A first-in first-out queue of gate application tasks, as a ring
+/// buffer of task slots that are recycled rather than destroyed. A popped
+/// task keeps the storage of its vectors, which the next task pushed in its
+/// slot overwrites, hence the queue stops allocating once it has held as many
+/// tasks as its longest run of queued gates.
+template <typename Task>
+class GateQueue {
+public:
+  bool empty() const { return count == 0; }
+
+  std::size_t size() const { return count; }
+
+  /// @brief Return the task at the front of the queue.
+  Task &front() { return slots[head]; }
+
+  /// @brief Return the `i`-th task from the front of the queue.
+  Task &operator[](std::size_t i) { return slots[(head + i) % slots.size()]; }
+
+  /// @brief Append a task to the queue, and return its slot. The slot holds
+  /// the task last queued in it, if any, to be overwritten by the caller.
+  Task &push() {
+    if (count == slots.size()) {
+      // Unroll the ring so that the new slot comes after the last task.
+      std::rotate(slots.begin(), slots.begin() + head, slots.end());
+      head = 0;
+      slots.emplace_back();
+    }
+    ++count;
+    return (*this)[count - 1];
+  }
+
+  /// @brief Remove the task at the front of the queue, keeping its slot.
+  void pop() {
+    --count;
+    head = count == 0 ? 0 : (head + 1) % slots.size();
+  }
+
+  /// @brief Remove all the tasks of the queue, keeping their slots.
+  void clear() {
+    head = 0;
+    count = 0;
+  }
+
+private:
+  std::vector<Task> slots;
+  /// @brief The slot of the task at the front of the queue.
+  std::size_t head = 0;
+  /// @brief The number of tasks in the queue.
+  std::size_t count = 0;
+};
+} // namespace nvqir
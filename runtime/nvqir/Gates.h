@@ -17,6 +17,7 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <span>
 #include <vector>
 
 namespace nvqir {
@@ -87,100 +88,133 @@ inline GateName getGateNameFromString(const std::string &name) {
 
   throw std::runtime_error("Invalid gate name provided: " + name);
 }
-/// @brief Given the gate name (an element of the GateName enum),
-/// return the matrix data, optionally parameterized by a rotation angle.
+/// @brief Given the gate name (an element of the GateName enum), write the
+/// matrix data, optionally parameterized by a rotation angle, to `matrix`.
+/// The storage of `matrix` is reused, so that a matrix written in place of the
+/// previous one does not allocate.
 template <typename Scalar>
-std::vector<std::complex<Scalar>>
-getGateByName(GateName name, const std::vector<Scalar> angles = {}) {
+void getGateByName(GateName name, std::span<const Scalar> angles,
+                   std::vector<std::complex<Scalar>> &matrix) {
   Scalar two = 2.;
   switch (name) {
   case (GateName::X):
-    return {{0., 0.}, {1.0, 0.}, {1.0, 0.0}, {0., 0.}};
+    matrix = {{0., 0.}, {1.0, 0.}, {1.0, 0.0}, {0., 0.}};
+    return;
   case (GateName::Y):
-    return {{0., 0.}, {0.0, -1.0}, {0.0, 1.0}, {0., 0.}};
+    matrix = {{0., 0.}, {0.0, -1.0}, {0.0, 1.0}, {0., 0.}};
+    return;
   case (GateName::Z):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {-1., 0.}};
+    matrix = {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {-1., 0.}};
+    return;
   case (GateName::H): {
     Scalar oneOverSqrt2 = 1 / std::sqrt(2.);
-    return {oneOverSqrt2, oneOverSqrt2, oneOverSqrt2, -oneOverSqrt2};
+    matrix = {oneOverSqrt2, oneOverSqrt2, oneOverSqrt2, -oneOverSqrt2};
+    return;
   }
   case (GateName::S):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., 1.}};
+    matrix = {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., 1.}};
+    return;
   case (GateName::Sdg):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., -1.}};
+    matrix = {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., -1.}};
+    return;
   case (GateName::T):
-    return {{1., 0.},
-            {0.0, 0.},
-            {0.0, 0.0},
-            std::exp(im<Scalar> * static_cast<Scalar>(M_PI_4))};
+    matrix = {{1., 0.},
+              {0.0, 0.},
+              {0.0, 0.0},
+              std::exp(im<Scalar> * static_cast<Scalar>(M_PI_4))};
+    return;
   case (GateName::Tdg):
-    return {{1., 0.},
-            {0.0, 0.},
-            {0.0, 0.0},
-            std::exp(-im<Scalar> * static_cast<Scalar>(M_PI_4))};
+    matrix = {{1., 0.},
+              {0.0, 0.},
+              {0.0, 0.0},
+              std::exp(-im<Scalar> * static_cast<Scalar>(M_PI_4))};
+    return;
   case (GateName::Rx): {
     auto angle = angles[0];
-    return {{std::cos(angle / two), 0.},
-            {0., -1 * std::sin(angle / two)},
-            {0, -1 * std::sin(angle / two)},
-            {std::cos(angle / two), 0.}};
+    matrix = {{std::cos(angle / two), 0.},
+              {0., -1 * std::sin(angle / two)},
+              {0, -1 * std::sin(angle / two)},
+              {std::cos(angle / two), 0.}};
+    return;
   }
   case (GateName::Ry): {
     auto angle = angles[0];
-    return {std::cos(angle / two), -std::sin(angle / two),
-            std::sin(angle / two), std::cos(angle / two)};
+    matrix = {std::cos(angle / two), -std::sin(angle / two),
+              std::sin(angle / two), std::cos(angle / two)};
+    return;
   }
   case (GateName::Rz): {
     auto angle = angles[0];
-    return {std::exp(-im<Scalar> * angle / two), 0, 0,
-            std::exp(im<Scalar> * angle / two)};
+    matrix = {std::exp(-im<Scalar> * angle / two), 0, 0,
+              std::exp(im<Scalar> * angle / two)};
+    return;
   }
   case (GateName::R1):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])};
+    matrix = {{1., 0.}, {0.0, 0.}, {0.0, 0.0},
+              std::exp(im<Scalar> * angles[0])};
+    return;
   case (GateName::U1):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])};
+    matrix = {{1., 0.}, {0.0, 0.}, {0.0, 0.0},
+              std::exp(im<Scalar> * angles[0])};
+    return;
   case (GateName::U2): {
     Scalar oneOverSqrt2 = 1 / std::sqrt(2.);
     auto phi = angles[0];
     auto lambda = angles[1];
-    return {{oneOverSqrt2, 0.},
-            -oneOverSqrt2 * std::exp(lambda * nvqir::im<Scalar>),
-            oneOverSqrt2 * std::exp(nvqir::im<Scalar> * phi),
-            oneOverSqrt2 * std::exp(nvqir::im<Scalar> * (phi + lambda))};
+    matrix = {{oneOverSqrt2, 0.},
+              -oneOverSqrt2 * std::exp(lambda * nvqir::im<Scalar>),
+              oneOverSqrt2 * std::exp(nvqir::im<Scalar> * phi),
+              oneOverSqrt2 * std::exp(nvqir::im<Scalar> * (phi + lambda))};
+    return;
   }
   case (GateName::U3): {
     auto theta = angles[0];
     auto phi = angles[1];
     auto lambda = angles[2];
-    return {{std::cos(theta / 2), 0.},
-            -std::exp(nvqir::im<Scalar> * lambda) * std::sin(theta / 2),
-            std::exp(nvqir::im<Scalar> * phi) * std::sin(theta / 2),
-            std::exp(nvqir::im<Scalar> * (phi + lambda)) * std::cos(theta / 2)};
+    matrix = {{std::cos(theta / 2), 0.},
+              -std::exp(nvqir::im<Scalar> * lambda) * std::sin(theta / 2),
+              std::exp(nvqir::im<Scalar> * phi) * std::sin(theta / 2),
+              std::exp(nvqir::im<Scalar> * (phi + lambda)) *
+                  std::cos(theta / 2)};
+    return;
   }
   case (GateName::PhasedRx): {
     Scalar two = 2.;
     auto phi = angles[0];
     auto lambda = angles[1];
-    return {{std::cos(phi / two), 0.},
-            -nvqir::im<Scalar> * std::exp(-nvqir::im<Scalar> * lambda) *
-                std::complex<Scalar>{std::sin(phi / two), 0.},
-            -nvqir::im<Scalar> * std::exp(nvqir::im<Scalar> * lambda) *
-                std::sin(phi / two),
-            std::cos(phi / two)};
+    matrix = {{std::cos(phi / two), 0.},
+              -nvqir::im<Scalar> * std::exp(-nvqir::im<Scalar> * lambda) *
+                  std::complex<Scalar>{std::sin(phi / two), 0.},
+              -nvqir::im<Scalar> * std::exp(nvqir::im<Scalar> * lambda) *
+                  std::sin(phi / two),
+              std::cos(phi / two)};
+    return;
   }
   case (GateName::Swap): {
     // The swap gate is a 4x4 matrix
-    return {1., 0., 0., 0., 0., 0., 1., 0., 0., 1., 0., 0., 0., 0., 0., 1.};
+    matrix = {1., 0., 0., 0., 0., 0., 1., 0., 0., 1., 0., 0., 0., 0., 0., 1.};
+    return;
   }
   }
 
   throw std::runtime_error("Invalid gate provided to getGateByName.");
 }
 
+/// @brief Given the gate name (an element of the GateName enum),
+/// return the matrix data, optionally parameterized by a rotation angle.
+template <typename Scalar>
+std::vector<std::complex<Scalar>>
+getGateByName(GateName name, const std::vector<Scalar> angles = {}) {
+  std::vector<std::complex<Scalar>> matrix;
+  getGateByName<Scalar>(name, std::span<const Scalar>(angles), matrix);
+  return matrix;
+}
+
 /// @brief The X operation as a type. Can instantiate and request
 /// its matrix data.
 template <typename ScalarType = double>
 struct x {
+  static constexpr GateName gateName = GateName::X;
   auto getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::X);
   }
@@ -190,6 +224,7 @@ struct x {
 /// The Y Gate
 template <typename ScalarType = double>
 struct y {
+  static constexpr GateName gateName = GateName::Y;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Y);
@@ -200,6 +235,7 @@ struct y {
 /// The Z Gate
 template <typename ScalarType = double>
 struct z {
+  static constexpr GateName gateName = GateName::Z;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Z);
@@ -210,6 +246,7 @@ struct z {
 /// The Hadamard Gate
 template <typename ScalarType = double>
 struct h {
+  static constexpr GateName gateName = GateName::H;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::H);
@@ -220,6 +257,7 @@ struct h {
 /// The S Gate
 template <typename ScalarType = double>
 struct s {
+  static constexpr GateName gateName = GateName::S;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::S);
@@ -230,6 +268,7 @@ struct s {
 /// The T Gate
 template <typename ScalarType = double>
 struct t {
+  static constexpr GateName gateName = GateName::T;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::T);
@@ -240,6 +279,7 @@ struct t {
 /// The `Sdg` (S†) Gate
 template <typename ScalarType = double>
 struct sdg {
+  static constexpr GateName gateName = GateName::Sdg;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Sdg);
@@ -250,6 +290,7 @@ struct sdg {
 /// The `Tdg` (T†) Gate
 template <typename ScalarType = double>
 struct tdg {
+  static constexpr GateName gateName = GateName::Tdg;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Tdg);
@@ -260,6 +301,7 @@ struct tdg {
 /// The RX Rotation Gate
 template <typename ScalarType = double>
 struct rx {
+  static constexpr GateName gateName = GateName::Rx;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::Rx, {angles[0]});
   }
@@ -269,6 +311,7 @@ struct rx {
 /// The RY Rotation Gate
 template <typename ScalarType = double>
 struct ry {
+  static constexpr GateName gateName = GateName::Ry;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::Ry, {angles[0]});
   }
@@ -278,6 +321,7 @@ struct ry {
 /// The RZ Rotation Gate
 template <typename ScalarType = double>
 struct rz {
+  static constexpr GateName gateName = GateName::Rz;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::Rz, {angles[0]});
   }
@@ -287,6 +331,7 @@ struct rz {
 /// @brief The R1 operation as a type. Arbitrary rotation about |1>
 template <typename ScalarType = double>
 struct r1 {
+  static constexpr GateName gateName = GateName::R1;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::R1, {angles[0]});
   }
@@ -297,6 +342,7 @@ struct r1 {
 /// (IBMs version)
 template <typename ScalarType = double>
 struct u1 {
+  static constexpr GateName gateName = GateName::U1;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::U1, {angles[0]});
   }
@@ -305,6 +351,7 @@ struct u1 {
 
 template <typename ScalarType = double>
 struct u2 {
+  static constexpr GateName gateName = GateName::U2;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::U2, {angles[0], angles[1]});
   }
@@ -313,6 +360,7 @@ struct u2 {
 
 template <typename ScalarType = double>
 struct u3 {
+  static constexpr GateName gateName = GateName::U3;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::U3,
                                      {angles[0], angles[1], angles[2]});
@@ -322,6 +370,7 @@ struct u3 {
 
 template <typename ScalarType = double>
 struct phased_rx {
+  static constexpr GateName gateName = GateName::PhasedRx;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::PhasedRx,
                                      {angles[0], angles[1]});
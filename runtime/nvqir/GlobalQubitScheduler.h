@@ -0,0 +1,154 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nvqir {
+
+/// @brief A GlobalQubitScheduler tracks the placement of the qubits of a
+/// state vector distributed over several devices, and plans the exchanges of
+/// global and local qubits ahead of the gates that need them.
+///
+/// The state is split on its most significant qubit positions: positions
+/// below `numLocalQubits` are local to each device, the other (global)
+/// positions select the device. Controls may sit on global positions, but
+/// gate targets must be local. Rather than swapping a global target in and
+/// out for every gate, the scheduler keeps a permutation of qubits to
+/// positions and, when a gate targets a global qubit, exchanges in one batch
+/// all the global qubits targeted soon, evicting the local qubits that are
+/// needed last.
+class GlobalQubitScheduler {
+public:
+  /// @brief A pair of qubit positions to swap.
+  using PositionSwap = std::pair<std::size_t, std::size_t>;
+
+  GlobalQubitScheduler(std::size_t numQubits, std::size_t numLocalQubits)
+      : numLocalQubits(numLocalQubits), positions(numQubits),
+        occupants(numQubits) {
+    std::iota(positions.begin(), positions.end(), 0);
+    std::iota(occupants.begin(), occupants.end(), 0);
+  }
+
+  /// @brief The position of the given qubit.
+  std::size_t position(std::size_t qubit) const { return positions[qubit]; }
+
+  /// @brief The positions of the given qubits.
+  std::vector<std::size_t>
+  positionsOf(const std::vector<std::size_t> &qubits) const {
+    std::vector<std::size_t> result(qubits.size());
+    for (std::size_t i = 0; i < qubits.size(); ++i)
+      result[i] = positions[qubits[i]];
+    return result;
+  }
+
+  /// @brief Return true if every qubit sits at its own position.
+  bool isIdentity() const {
+    for (std::size_t q = 0; q < positions.size(); ++q)
+      if (positions[q] != q)
+        return false;
+    return true;
+  }
+
+  /// @brief Plan the exchanges that bring the targets of gate `gate` local,
+  /// given the targets of all the queued gates. Global qubits targeted within
+  /// the next `lookahead` gates are exchanged in the same batch when they are
+  /// needed before the local qubit they displace. Returns the (local, global)
+  /// position pairs to swap, which are disjoint, and updates the placement
+  /// accordingly. Returns an empty list if the targets are already local.
+  std::vector<PositionSwap>
+  planExchange(const std::vector<std::vector<std::size_t>> &targets,
+               std::size_t gate, std::size_t lookahead) {
+    const auto &current = targets[gate];
+    if (current.size() > numLocalQubits)
+      throw std::runtime_error(
+          "Gate targets " + std::to_string(current.size()) +
+          " qubits, but only " + std::to_string(numLocalQubits) +
+          " qubits are local to a device.");
+    if (std::all_of(current.begin(), current.end(),
+                    [&](std::size_t q) { return isLocal(q); }))
+      return {};
+
+    // The next gate targeting each qubit within the lookahead window.
+    constexpr std::size_t never = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> nextUse(positions.size(), never);
+    const std::size_t end = std::min(targets.size(), gate + lookahead);
+    for (std::size_t g = end; g-- > gate;)
+      for (auto q : targets[g])
+        nextUse[q] = g;
+
+    // Global qubits to bring in, soonest first (the current targets come
+    // first), and local qubits to evict, latest first.
+    std::vector<std::size_t> incoming, outgoing;
+    for (std::size_t q = 0; q < positions.size(); ++q) {
+      if (!isLocal(q) && nextUse[q] != never)
+        incoming.push_back(q);
+      else if (isLocal(q) && nextUse[q] != gate)
+        outgoing.push_back(q);
+    }
+    std::stable_sort(incoming.begin(), incoming.end(),
+                     [&](std::size_t a, std::size_t b) {
+                       return nextUse[a] < nextUse[b];
+                     });
+    std::stable_sort(outgoing.begin(), outgoing.end(),
+                     [&](std::size_t a, std::size_t b) {
+                       return nextUse[a] > nextUse[b];
+                     });
+
+    std::vector<PositionSwap> swaps;
+    for (std::size_t i = 0; i < std::min(incoming.size(), outgoing.size());
+         ++i) {
+      const auto in = incoming[i];
+      const auto out = outgoing[i];
+      // Only the current targets are mandatory, others must pay off.
+      if (nextUse[in] != gate && nextUse[in] >= nextUse[out])
+        break;
+      swaps.emplace_back(positions[out], positions[in]);
+      swapPositions(positions[out], positions[in]);
+    }
+    return swaps;
+  }
+
+  /// @brief Plan the swaps that move every qubit back to its own position,
+  /// to be applied in order, and reset the placement.
+  std::vector<PositionSwap> planRestore() {
+    std::vector<PositionSwap> swaps;
+    for (std::size_t p = 0; p < occupants.size(); ++p)
+      if (occupants[p] != p) {
+        swaps.emplace_back(p, positions[p]);
+        swapPositions(p, positions[p]);
+      }
+    return swaps;
+  }
+
+private:
+  bool isLocal(std::size_t qubit) const {
+    return positions[qubit] < numLocalQubits;
+  }
+
+  void swapPositions(std::size_t a, std::size_t b) {
+    std::swap(occupants[a], occupants[b]);
+    positions[occupants[a]] = a;
+    positions[occupants[b]] = b;
+  }
+
+  std::size_t numLocalQubits;
+  /// The position of each qubit.
+  std::vector<std::size_t> positions;
+  /// The qubit at each position.
+  std::vector<std::size_t> occupants;
+};
+} // namespace nvqir
@@ -0,0 +1,101 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace nvqir {
+
+/// @brief Batches the shots of a kernel by the outcomes of its measurements.
+///
+/// The shots of a kernel whose evolution only depends on the outcomes of its
+/// measurements are the leaves of the tree of these outcomes. Rather than
+/// executing the kernel once per shot, each execution follows one branch of
+/// the tree and stands in for all the shots of its leaf: at each measurement,
+/// the shots of the branch are split between the two outcomes following their
+/// binomial distribution. The execution continues with the outcome that
+/// received the most shots, and the other outcome, if it received any, is
+/// left as a branch to replay later, by forcing the outcomes of its prefix.
+/// Kernels with a few measurements that feed forward thus need a handful of
+/// executions instead of one per shot.
+class MeasurementBranching {
+public:
+  MeasurementBranching(std::size_t shots, std::uint64_t seed) : engine(seed) {
+    if (shots > 0)
+      pending.push_back({{}, shots});
+  }
+
+  /// @brief Start the execution of the next leaf. Return false once all the
+  /// shots are assigned to a leaf.
+  bool nextLeaf() {
+    if (pending.empty())
+      return false;
+    auto branch = std::move(pending.back());
+    pending.pop_back();
+    outcomes = std::move(branch.first);
+    shots = branch.second;
+    position = 0;
+    leafShots.push_back(shots);
+    return true;
+  }
+
+  /// @brief Return the outcome of the next measurement of the current
+  /// execution, whose probability to be `1` is `probOne`.
+  bool measure(double probOne) {
+    if (position < outcomes.size())
+      return outcomes[position++];
+    std::binomial_distribution<std::size_t> distribution(
+        shots, std::clamp(probOne, 0.0, 1.0));
+    const std::size_t numOnes = distribution(engine);
+    const bool outcome = 2 * numOnes >= shots;
+    const std::size_t otherShots = outcome ? shots - numOnes : numOnes;
+    if (otherShots > 0) {
+      auto branch = outcomes;
+      branch.push_back(!outcome);
+      pending.push_back({std::move(branch), otherShots});
+    }
+    shots -= otherShots;
+    leafShots.back() = shots;
+    outcomes.push_back(outcome);
+    ++position;
+    return outcome;
+  }
+
+  /// @brief Return the number of shots of each leaf executed so far.
+  const std::vector<std::size_t> &getLeafShots() const { return leafShots; }
+
+  /// @brief Return the leaf of each shot, in a random order, so that the shots
+  /// of a leaf are not grouped together.
+  std::vector<std::size_t> getShotLeaves() {
+    std::vector<std::size_t> shotLeaves;
+    for (std::size_t leaf = 0; leaf < leafShots.size(); ++leaf)
+      shotLeaves.insert(shotLeaves.end(), leafShots[leaf], leaf);
+    std::shuffle(shotLeaves.begin(), shotLeaves.end(), engine);
+    return shotLeaves;
+  }
+
+private:
+  /// @brief The branches left to execute: the outcomes of the measurements
+  /// leading to them, and their number of shots.
+  std::vector<std::pair<std::vector<bool>, std::size_t>> pending;
+  /// @brief The outcomes of the measurements of the current execution.
+  std::vector<bool> outcomes;
+  /// @brief The number of measurements of the current execution so far.
+  std::size_t position = 0;
+  /// @brief The number of shots of the current branch.
+  std::size_t shots = 0;
+  std::vector<std::size_t> leafShots;
+  std::mt19937_64 engine;
+};
+} // namespace nvqir
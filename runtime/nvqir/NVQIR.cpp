@@ -171,6 +171,34 @@ std::size_t qubitToSizeT(Qubit *q) {
   return q->idx;
 }
 
+/// @brief The ids of the control qubits of the gate being applied. The entry
+/// points of the controlled gates reuse this buffer rather than allocating a
+/// vector per gate, since the simulator copies the controls it queues.
+static std::vector<std::size_t> &controlIdxsBuffer() {
+  thread_local std::vector<std::size_t> ctrlIdxs;
+  ctrlIdxs.clear();
+  return ctrlIdxs;
+}
+
+/// @brief Map a QIR Array pointer of control qubits to their ids, valid until
+/// the next controlled gate of this thread.
+const std::vector<std::size_t> &arrayToControlIdxs(Array *arr) {
+  assert(arr && "array must not be null");
+  auto &ctrlIdxs = controlIdxsBuffer();
+  const auto arrSize = arr->size();
+  for (std::size_t i = 0; i < arrSize; ++i)
+    ctrlIdxs.push_back(qubitToSizeT(*reinterpret_cast<Qubit **>((*arr)[i])));
+  return ctrlIdxs;
+}
+
+/// @brief Return the id of a single control qubit as the controls of a gate,
+/// valid until the next controlled gate of this thread.
+const std::vector<std::size_t> &qubitToControlIdxs(std::size_t qubitIdx) {
+  auto &ctrlIdxs = controlIdxsBuffer();
+  ctrlIdxs.push_back(qubitIdx);
+  return ctrlIdxs;
+}
+
 template <typename T>
 concept FloatType = std::is_same<T, float>::value;
 
@@ -245,11 +273,28 @@ void clearQirOutputLog() {
 using namespace nvqir;
 
 template <typename VAL>
-void quantumRTGenericRecordOutput(const char *type, VAL val,
+void quantumRTGenericRecordOutput(cudaq::OutputRecordType recordType,
+                                  const char *type, VAL val,
                                   const char *label) {
   auto *circuitSimulator = nvqir::getCircuitSimulatorInternal();
+  if (circuitSimulator->recordBinaryOutput) {
+    auto &record = circuitSimulator->outputRecords.emplace_back();
+    record.type = recordType;
+    if constexpr (std::is_floating_point_v<VAL>)
+      record.doubleValue = val;
+    else
+      record.intValue = static_cast<std::int64_t>(val);
+    if (label)
+      record.label = label;
+    return;
+  }
   std::ostringstream ss;
-  ss << "OUTPUT\t" << type << "\t" << val << '\t';
+  ss << "OUTPUT\t" << type << "\t";
+  if constexpr (std::is_same_v<VAL, bool>)
+    ss << (val ? "true" : "false");
+  else
+    ss << val;
+  ss << '\t';
   if (label)
     ss << label;
   ss << '\n';
@@ -302,6 +347,7 @@ void __quantum__rt__resetExecutionContext() {
   ScopedTraceWithContext("NVQIR::resetExecutionContext");
   CUDAQ_INFO("Resetting execution context.");
   nvqir::getCircuitSimulatorInternal()->resetExecutionContext();
+  nvqir::trimQIRObjectPools();
 }
 
 /// @brief QIR function for allocated a qubit array
@@ -415,8 +461,9 @@ void __quantum__rt__qubit_release_array(Array *arr) {
     nvqir::getCircuitSimulatorInternal()->deallocate(idxVal->idx);
     delete idxVal;
   }
-  delete arr;
+  // Untrack first, the pool may hand out the same address again.
   nvqir::ArrayTracker::getInstance().untrack(arr);
+  delete arr;
   return;
 }
 
@@ -449,36 +496,39 @@ void __quantum__rt__deallocate_all(const std::size_t numQubits,
 }
 
 void __quantum__rt__bool_record_output(bool val, const char *label) {
-  quantumRTGenericRecordOutput("BOOL", (val ? "true" : "false"), label);
+  quantumRTGenericRecordOutput(cudaq::OutputRecordType::BOOL, "BOOL", val,
+                               label);
 }
 
 void __quantum__rt__int_record_output(std::int64_t val, const char *label) {
-  quantumRTGenericRecordOutput("INT", val, label);
+  quantumRTGenericRecordOutput(cudaq::OutputRecordType::INT, "INT", val, label);
 }
 
 void __quantum__rt__double_record_output(double val, const char *label) {
-  quantumRTGenericRecordOutput("DOUBLE", val, label);
+  quantumRTGenericRecordOutput(cudaq::OutputRecordType::DOUBLE, "DOUBLE", val,
+                               label);
 }
 
 void __quantum__rt__tuple_record_output(std::uint64_t len, const char *label) {
-  quantumRTGenericRecordOutput("TUPLE", len, label);
+  quantumRTGenericRecordOutput(cudaq::OutputRecordType::TUPLE, "TUPLE", len,
+                               label);
 }
 
 void __quantum__rt__array_record_output(std::uint64_t len, const char *label) {
-  quantumRTGenericRecordOutput("ARRAY", len, label);
+  quantumRTGenericRecordOutput(cudaq::OutputRecordType::ARRAY, "ARRAY", len,
+                               label);
 }
 
 #define ONE_QUBIT_QIS_FUNCTION(GATENAME)                                       \
   void QIS_FUNCTION_NAME(GATENAME)(Qubit * qubit) {                            \
     auto targetIdx = qubitToSizeT(qubit);                                      \
-    ScopedTraceWithContext("NVQIR::" + std::string(#GATENAME), targetIdx);     \
+    ScopedTraceWithContext("NVQIR::" #GATENAME, targetIdx);                    \
     nvqir::getCircuitSimulatorInternal()->GATENAME(targetIdx);                 \
   }                                                                            \
   void QIS_FUNCTION_CTRL_NAME(GATENAME)(Array * ctrlQubits, Qubit * qubit) {   \
-    auto ctrlIdxs = arrayToVectorSizeT(ctrlQubits);                            \
+    const auto &ctrlIdxs = arrayToControlIdxs(ctrlQubits);                     \
     auto targetIdx = qubitToSizeT(qubit);                                      \
-    ScopedTraceWithContext("NVQIR::ctrl-" + std::string(#GATENAME), ctrlIdxs,  \
-                           targetIdx);                                         \
+    ScopedTraceWithContext("NVQIR::ctrl-" #GATENAME, ctrlIdxs, targetIdx);     \
     nvqir::getCircuitSimulatorInternal()->GATENAME(ctrlIdxs, targetIdx);       \
   }                                                                            \
   void QIS_FUNCTION_BODY_NAME(GATENAME)(Qubit * qubit) {                       \
@@ -507,8 +557,7 @@ void __quantum__qis__s__adj(Qubit *qubit) {
 #define ONE_QUBIT_PARAM_QIS_FUNCTION(GATENAME)                                 \
   void QIS_FUNCTION_NAME(GATENAME)(double param, Qubit *qubit) {               \
     auto targetIdx = qubitToSizeT(qubit);                                      \
-    ScopedTraceWithContext("NVQIR::" + std::string(#GATENAME), param,          \
-                           targetIdx);                                         \
+    ScopedTraceWithContext("NVQIR::" #GATENAME, param, targetIdx);             \
     nvqir::getCircuitSimulatorInternal()->GATENAME(param, targetIdx);          \
   }                                                                            \
   void QIS_FUNCTION_BODY_NAME(GATENAME)(double param, Qubit *qubit) {          \
@@ -516,10 +565,9 @@ void __quantum__qis__s__adj(Qubit *qubit) {
   }                                                                            \
   void QIS_FUNCTION_CTRL_NAME(GATENAME)(double param, Array *ctrlQubits,       \
                                         Qubit *qubit) {                        \
-    auto ctrlIdxs = arrayToVectorSizeT(ctrlQubits);                            \
+    const auto &ctrlIdxs = arrayToControlIdxs(ctrlQubits);                     \
     auto targetIdx = qubitToSizeT(qubit);                                      \
-    ScopedTraceWithContext("NVQIR::" + std::string(#GATENAME), param,          \
-                           ctrlIdxs, targetIdx);                               \
+    ScopedTraceWithContext("NVQIR::" #GATENAME, param, ctrlIdxs, targetIdx);   \
     nvqir::getCircuitSimulatorInternal()->GATENAME(param, ctrlIdxs,            \
                                                    targetIdx);                 \
   }
@@ -537,7 +585,7 @@ void __quantum__qis__swap(Qubit *q, Qubit *r) {
 }
 
 void __quantum__qis__swap__ctl(Array *ctrls, Qubit *q, Qubit *r) {
-  auto ctrlIdxs = arrayToVectorSizeT(ctrls);
+  const auto &ctrlIdxs = arrayToControlIdxs(ctrls);
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
   nvqir::getCircuitSimulatorInternal()->swap(ctrlIdxs, qI, rI);
@@ -550,8 +598,7 @@ void __quantum__qis__swap__body(Qubit *q, Qubit *r) {
 void __quantum__qis__cphase(double d, Qubit *q, Qubit *r) {
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
-  std::vector<std::size_t> ctrls{qI};
-  nvqir::getCircuitSimulatorInternal()->r1(d, ctrls, rI);
+  nvqir::getCircuitSimulatorInternal()->r1(d, qubitToControlIdxs(qI), rI);
 }
 
 void __quantum__qis__phased_rx(double theta, double phi, Qubit *q) {
@@ -579,7 +626,7 @@ void __quantum__qis__u3(double theta, double phi, double lambda, Qubit *q) {
 
 void __quantum__qis__u3__ctl(double theta, double phi, double lambda,
                              Array *ctrls, Qubit *q) {
-  auto ctrlIdxs = arrayToVectorSizeT(ctrls);
+  const auto &ctrlIdxs = arrayToControlIdxs(ctrls);
   auto qI = qubitToSizeT(q);
   nvqir::getCircuitSimulatorInternal()->u3(theta, phi, lambda, ctrlIdxs, qI);
 }
@@ -590,24 +637,21 @@ void __quantum__qis__cnot(Qubit *q, Qubit *r) {
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
   ScopedTraceWithContext("NVQIR::cnot", qI, rI);
-  std::vector<std::size_t> controls{qI};
-  nvqir::getCircuitSimulatorInternal()->x(controls, rI);
+  nvqir::getCircuitSimulatorInternal()->x(qubitToControlIdxs(qI), rI);
 }
 
 void __quantum__qis__cnot__body(Qubit *q, Qubit *r) {
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
   ScopedTraceWithContext("NVQIR::cnot", qI, rI);
-  std::vector<std::size_t> controls{qI};
-  nvqir::getCircuitSimulatorInternal()->x(controls, rI);
+  nvqir::getCircuitSimulatorInternal()->x(qubitToControlIdxs(qI), rI);
 }
 
 void __quantum__qis__cz__body(Qubit *q, Qubit *r) {
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
   ScopedTraceWithContext("NVQIR::cz", qI, rI);
-  std::vector<std::size_t> controls{qI};
-  nvqir::getCircuitSimulatorInternal()->z(controls, rI);
+  nvqir::getCircuitSimulatorInternal()->z(qubitToControlIdxs(qI), rI);
 }
 
 void __quantum__qis__reset(Qubit *q) {
@@ -688,6 +732,26 @@ void __quantum__qis__exp_pauli__body(double theta, Array *qubits,
   return __quantum__qis__exp_pauli(theta, qubits, pauliWord);
 }
 
+/// @brief Apply the `numTerms` Pauli rotations exp_pauli(thetas[k], qubits,
+/// pauliWords[k]) in order. The simulator applies them as a batch, e.g., one
+/// layer of a Trotterized evolution.
+void __quantum__qis__exp_pauli_batch(std::int64_t numTerms, double *thetas,
+                                     Array *qubits, char *pauliWords) {
+  struct CLikeString {
+    char *ptr = nullptr;
+    int64_t length = 0;
+  };
+  auto *castedStrings = reinterpret_cast<CLikeString *>(pauliWords);
+  std::vector<cudaq::spin_op_term> terms;
+  terms.reserve(numTerms);
+  for (std::int64_t k = 0; k < numTerms; ++k)
+    terms.emplace_back(cudaq::spin_op::from_word(
+        std::string(castedStrings[k].ptr, castedStrings[k].length)));
+  auto qubitsVec = arrayToVectorSizeT(qubits);
+  nvqir::getCircuitSimulatorInternal()->applyExpPauliBatch(
+      std::vector<double>(thetas, thetas + numTerms), qubitsVec, terms);
+}
+
 void __quantum__rt__result_record_output(Result *r, int8_t *name) {
   auto *ctx = nvqir::getCircuitSimulatorInternal()->getExecutionContext();
   if (ctx && ctx->name == "run") {
@@ -695,7 +759,8 @@ void __quantum__rt__result_record_output(Result *r, int8_t *name) {
     std::string regName(reinterpret_cast<const char *>(name));
     auto qI = qubitToSizeT(measRes2QB[r]);
     auto b = nvqir::getCircuitSimulatorInternal()->mz(qI, regName);
-    quantumRTGenericRecordOutput("RESULT", (b ? 1 : 0), regName.c_str());
+    quantumRTGenericRecordOutput(cudaq::OutputRecordType::RESULT, "RESULT",
+                                 (b ? 1 : 0), regName.c_str());
     return;
   }
 
@@ -939,10 +1004,7 @@ Result *__quantum__qis__measure__body(Array *pauli_arr, Array *qubits) {
   // Some backends may better handle the observe task.
   // Let's give them that opportunity.
   if (currentContext->canHandleObserve) {
-    circuitSimulator->flushGateQueue();
-    auto result = circuitSimulator->observe(currentContext->spin.value());
-    currentContext->expectationValue = result.expectation();
-    currentContext->result = result.raw_data();
+    circuitSimulator->measureSpinOp(currentContext->spin.value());
     return ResultZero;
   }
 
@@ -33,12 +33,16 @@ void nvqir::ArrayTracker::untrack(Array *arr) {
   if (arr == nullptr)
     return;
 
-  auto it = std::find(allocated_arrays.begin(), allocated_arrays.end(), arr);
+  // Arrays are mostly released shortly after they are created, e.g., slices
+  // in a loop, hence search from the most recently tracked ones.
+  auto it = std::find(allocated_arrays.rbegin(), allocated_arrays.rend(), arr);
   // Use nullptr to indicate untracked arrays (manually deleted outside) to
   // prevent vector shrink.
-  if (it != allocated_arrays.end())
+  if (it != allocated_arrays.rend()) {
     *it = nullptr;
-  else
+    while (!allocated_arrays.empty() && allocated_arrays.back() == nullptr)
+      allocated_arrays.pop_back();
+  } else
     CUDAQ_WARN("Attempting to untrack an Array that is not tracked.");
 }
 
@@ -52,40 +56,112 @@ void nvqir::ArrayTracker::clear() {
   allocated_arrays.clear();
 }
 
+namespace {
+// Each thread allocates its Arrays and Qubits from its own pools.
+nvqir::QIRBlockPool<sizeof(Array)> &arrayPool() {
+  static thread_local nvqir::QIRBlockPool<sizeof(Array)> pool;
+  return pool;
+}
+
+nvqir::QIRBlockPool<sizeof(Qubit)> &qubitPool() {
+  static thread_local nvqir::QIRBlockPool<sizeof(Qubit)> pool;
+  return pool;
+}
+} // namespace
+
+void nvqir::trimQIRObjectPools() {
+  arrayPool().trim();
+  qubitPool().trim();
+}
+
+void *Qubit::operator new(std::size_t size) {
+  if (size != sizeof(Qubit))
+    return ::operator new(size);
+  return qubitPool().allocate();
+}
+
+void Qubit::operator delete(void *ptr, std::size_t size) {
+  if (size != sizeof(Qubit))
+    return ::operator delete(ptr);
+  qubitPool().deallocate(ptr);
+}
+
+void *Array::operator new(std::size_t size) {
+  if (size != sizeof(Array))
+    return ::operator new(size);
+  return arrayPool().allocate();
+}
+
+void Array::operator delete(void *ptr, std::size_t size) {
+  if (size != sizeof(Array))
+    return ::operator delete(ptr);
+  arrayPool().deallocate(ptr);
+}
+
 int8_t *Array::operator[](std::size_t index) {
-  if (static_cast<uint64_t>(index * element_size_bytes) >= storage.size())
+  if (static_cast<uint64_t>(index * element_size_bytes) >= size_bytes)
     throw std::runtime_error(
         fmt::format("Provided index [{}] >= array size [{}]", index,
-                    storage.size() / element_size_bytes));
-  return &storage.at(index * element_size_bytes);
+                    size_bytes / element_size_bytes));
+  return storage + index * element_size_bytes;
+}
+
+void Array::reserve_bytes(std::size_t num_bytes) {
+  if (num_bytes <= capacity_bytes)
+    return;
+  const auto new_capacity = std::max(num_bytes, 2 * capacity_bytes);
+  auto *new_storage = new int8_t[new_capacity];
+  std::memcpy(new_storage, storage, size_bytes);
+  if (!is_inline())
+    delete[] storage;
+  storage = new_storage;
+  capacity_bytes = new_capacity;
 }
+
 // Ctors
 // Default items are pointers.
 Array::Array(std::size_t _nitems, int _item_size)
-    : element_size_bytes(_item_size),
-      // Initialized to zero
-      storage(_nitems * _item_size, 0) {
+    : element_size_bytes(_item_size), storage(inline_storage) {
   assert(element_size_bytes > 0);
+  reserve_bytes(_nitems * _item_size);
+  // Initialized to zero
+  size_bytes = _nitems * _item_size;
+  std::memset(storage, 0, size_bytes);
 };
 
 Array::Array(const Array &other)
-    : element_size_bytes(other.element_size_bytes), storage(other.storage) {}
+    : element_size_bytes(other.element_size_bytes), storage(inline_storage) {
+  reserve_bytes(other.size_bytes);
+  size_bytes = other.size_bytes;
+  std::memcpy(storage, other.storage, size_bytes);
+}
 
 void Array::append(const Array &other) {
   if (other.element_size_bytes != element_size_bytes) {
     throw std::runtime_error("Cannot append Arrays of different types.");
   }
 
-  storage.insert(storage.end(), other.storage.begin(), other.storage.end());
+  // `other` may be this array.
+  const auto other_size = other.size_bytes;
+  reserve_bytes(size_bytes + other_size);
+  std::memcpy(storage + size_bytes, other.storage, other_size);
+  size_bytes += other_size;
 }
 
-void Array::add_element() { storage.resize((1 + size()) * element_size_bytes); }
+void Array::add_element() {
+  reserve_bytes(size_bytes + element_size_bytes);
+  std::memset(storage + size_bytes, 0, element_size_bytes);
+  size_bytes += element_size_bytes;
+}
 
-std::size_t Array::size() const { return storage.size() / element_size_bytes; }
-void Array::clear() { storage.clear(); }
+std::size_t Array::size() const { return size_bytes / element_size_bytes; }
+void Array::clear() { size_bytes = 0; }
 int Array::element_size() const { return element_size_bytes; }
 
-Array::~Array() { clear(); }
+Array::~Array() {
+  if (!is_inline())
+    delete[] storage;
+}
 
 // Slice a range of qubits from an array.
 // Note: the qubits are referenced (copy pointers), not created new ones.
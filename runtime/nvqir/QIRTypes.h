@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <deque>
 #include <map>
 #include <memory>
@@ -36,18 +37,35 @@ struct Range {
 struct Qubit {
   Qubit(std::size_t i) : idx(i) {}
   std::size_t idx;
+
+  // Qubits are allocated from a thread-local pool (see `nvqir::QIRBlockPool`).
+  static void *operator new(std::size_t size);
+  static void operator delete(void *ptr, std::size_t size);
 };
 
 /// General 1D array
+// Arrays of up to `inline_capacity_bytes` bytes, e.g., registers or slices of
+// up to 8 qubits, keep their elements inline, and the Array objects themselves
+// are allocated from a thread-local pool, so that kernels creating and slicing
+// small registers in loops do not go through the heap for each of them.
 class Array {
 private:
+  static constexpr std::size_t inline_capacity_bytes = 8 * sizeof(int8_t *);
   const int element_size_bytes;
-  std::vector<int8_t> storage;
+  std::size_t size_bytes = 0;
+  std::size_t capacity_bytes = inline_capacity_bytes;
+  // Points to `inline_storage`, or to a heap buffer of `capacity_bytes`.
+  int8_t *storage;
+  alignas(std::max_align_t) int8_t inline_storage[inline_capacity_bytes];
   // Note: this currently is unused.
   // We should use this to track array references and clean arrays appropriately
   // (e.g., `__quantum__rt__array_update_reference_count`).
   std::atomic<int> ref_count;
 
+  bool is_inline() const { return storage == inline_storage; }
+  // Grow the storage to hold at least `num_bytes` bytes.
+  void reserve_bytes(std::size_t num_bytes);
+
 public:
   // Get the element pointer at given index
   int8_t *operator[](std::size_t index);
@@ -56,6 +74,7 @@ public:
   Array(std::size_t _nitems, int _item_size = sizeof(int8_t *));
 
   Array(const Array &other);
+  Array &operator=(const Array &) = delete;
 
   void append(const Array &other);
 
@@ -66,8 +85,56 @@ public:
   int element_size() const;
 
   ~Array();
+
+  static void *operator new(std::size_t size);
+  static void operator delete(void *ptr, std::size_t size);
 };
 
+namespace nvqir {
+/// @brief A thread-local pool of memory blocks of `BlockSize` bytes, from
+/// which the QIR Arrays and Qubits are allocated. Released blocks are kept for
+/// reuse, up to `maxRetainedBlocks` of them, and the retained blocks are
+/// returned to the heap by `trim`, when the execution context ends.
+// Each block is a separate heap allocation, so that a block may be released on
+// a different thread than the one it was allocated on.
+template <std::size_t BlockSize>
+class QIRBlockPool {
+public:
+  static constexpr std::size_t maxRetainedBlocks = 4096;
+
+  void *allocate() {
+    if (freeBlocks.empty())
+      return ::operator new(BlockSize);
+    void *block = freeBlocks.back();
+    freeBlocks.pop_back();
+    return block;
+  }
+
+  void deallocate(void *block) {
+    if (freeBlocks.size() >= maxRetainedBlocks) {
+      ::operator delete(block);
+      return;
+    }
+    freeBlocks.push_back(block);
+  }
+
+  void trim() {
+    for (void *block : freeBlocks)
+      ::operator delete(block);
+    freeBlocks.clear();
+  }
+
+  ~QIRBlockPool() { trim(); }
+
+private:
+  std::vector<void *> freeBlocks;
+};
+
+/// @brief Return the blocks retained by the QIR Array and Qubit pools of the
+/// calling thread to the heap.
+void trimQIRObjectPools();
+} // namespace nvqir
+
 /// Array Runtime Functions
 extern "C" {
 Array *__quantum__rt__array_create_1d(int32_t itemSizeInBytes,
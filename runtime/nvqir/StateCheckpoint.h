@@ -0,0 +1,228 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nvqir {
+
+/// @brief The header of a state vector checkpoint file.
+///
+/// The file holds the header, followed by the raw amplitudes of the state
+/// vector, in the simulator's own layout, starting at the page-aligned
+/// `dataOffset`. The amplitudes are streamed to and from the file in chunks
+/// through a shared memory mapping, so that neither writing nor restoring a
+/// checkpoint needs a host copy of the whole state, and restoring needs no
+/// parsing.
+struct StateCheckpointHeader {
+  char magic[8];
+  std::uint32_t version;
+  /// The size in bytes of one amplitude.
+  std::uint32_t elementSize;
+  std::uint64_t numQubits;
+  /// The number of gates applied to the state when it was checkpointed.
+  std::uint64_t numGates;
+  std::uint64_t dataOffset;
+};
+
+/// @brief A read-only memory mapping of a state vector checkpoint file.
+class StateCheckpointFile {
+public:
+  static constexpr char fileMagic[8] = "CUDAQSV";
+  static constexpr std::uint32_t fileVersion = 1;
+  static constexpr std::size_t dataOffset = 4096;
+  /// The size of the chunks amplitudes are streamed in.
+  static constexpr std::size_t chunkBytes = std::size_t(64) << 20;
+
+  /// @brief Write a checkpoint to `path`. `readChunk(offset, count, dst)`
+  /// must copy the `count` amplitudes starting at `offset` to `dst`, which
+  /// points into the mapped file. The file is written next to `path` first
+  /// and renamed once complete, so that an interrupted write never replaces
+  /// a valid checkpoint.
+  template <typename ChunkReader>
+  static void write(const std::string &path, std::uint32_t elementSize,
+                    std::uint64_t numQubits, std::uint64_t numGates,
+                    ChunkReader &&readChunk) {
+    const std::string tmpPath = path + ".tmp";
+    const std::size_t numElements = std::size_t(1) << numQubits;
+    const std::size_t fileSize = dataOffset + numElements * elementSize;
+    FileDescriptor fd(
+        ::open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+    if (fd.get() < 0)
+      throwSystemError("Unable to create state checkpoint", tmpPath);
+    // The incomplete file is removed if anything below throws.
+    TemporaryFile tmpFile(tmpPath);
+    if (::ftruncate(fd.get(), fileSize) != 0)
+      throwSystemError("Unable to size state checkpoint", tmpPath);
+    Mapping mapped(::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fd.get(), 0),
+                   fileSize);
+    if (mapped.get() == MAP_FAILED)
+      throwSystemError("Unable to map state checkpoint", tmpPath);
+
+    auto *bytes = static_cast<char *>(mapped.get());
+    StateCheckpointHeader header{};
+    std::memcpy(header.magic, fileMagic, sizeof(header.magic));
+    header.version = fileVersion;
+    header.elementSize = elementSize;
+    header.numQubits = numQubits;
+    header.numGates = numGates;
+    header.dataOffset = dataOffset;
+    std::memcpy(bytes, &header, sizeof(header));
+
+    const std::size_t chunkElements = chunkBytes / elementSize;
+    for (std::size_t offset = 0; offset < numElements;
+         offset += chunkElements) {
+      const auto count = std::min(chunkElements, numElements - offset);
+      char *dst = bytes + dataOffset + offset * elementSize;
+      readChunk(offset, count, dst);
+      // Start the write-back of the chunk while the next one is copied.
+      ::msync(dst, count * elementSize, MS_ASYNC);
+    }
+
+    if (::msync(mapped.get(), fileSize, MS_SYNC) != 0 ||
+        ::fsync(fd.get()) != 0)
+      throwSystemError("Unable to write state checkpoint", tmpPath);
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+      throwSystemError("Unable to move state checkpoint to", path);
+    tmpFile.release();
+  }
+
+  /// @brief Map the checkpoint file at `path` and validate its header.
+  explicit StateCheckpointFile(const std::string &path) {
+    FileDescriptor fd(::open(path.c_str(), O_RDONLY));
+    if (fd.get() < 0)
+      throwSystemError("Unable to open state checkpoint", path);
+    struct stat info;
+    if (::fstat(fd.get(), &info) != 0)
+      throwSystemError("Unable to read state checkpoint", path);
+    fileSize = info.st_size;
+    if (fileSize < sizeof(StateCheckpointHeader))
+      throw std::runtime_error("Invalid state checkpoint " + path +
+                               ": file is truncated.");
+    mapped = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd.get(), 0);
+    if (mapped == MAP_FAILED)
+      throwSystemError("Unable to map state checkpoint", path);
+    ::madvise(mapped, fileSize, MADV_SEQUENTIAL);
+
+    std::memcpy(&fileHeader, mapped, sizeof(fileHeader));
+    const char *error = nullptr;
+    if (std::memcmp(fileHeader.magic, fileMagic, sizeof(fileMagic)) != 0 ||
+        fileHeader.version != fileVersion)
+      error = "unknown file format";
+    else if (fileHeader.numQubits >= 64 || fileHeader.elementSize == 0 ||
+             fileHeader.dataOffset +
+                     (std::size_t(1) << fileHeader.numQubits) *
+                         fileHeader.elementSize !=
+                 fileSize)
+      error = "file size does not match its header";
+    if (error) {
+      ::munmap(mapped, fileSize);
+      throw std::runtime_error("Invalid state checkpoint " + path + ": " +
+                               error + ".");
+    }
+  }
+
+  StateCheckpointFile(const StateCheckpointFile &) = delete;
+  StateCheckpointFile &operator=(const StateCheckpointFile &) = delete;
+
+  ~StateCheckpointFile() { ::munmap(mapped, fileSize); }
+
+  const StateCheckpointHeader &header() const { return fileHeader; }
+
+  /// @brief Stream the amplitudes to `writeChunk(offset, count, src)`, with
+  /// `src` pointing into the mapped file. The pages of each chunk are
+  /// released once consumed.
+  template <typename ChunkWriter>
+  void read(ChunkWriter &&writeChunk) const {
+    const std::size_t elementSize = fileHeader.elementSize;
+    const std::size_t numElements = std::size_t(1) << fileHeader.numQubits;
+    const std::size_t chunkElements = chunkBytes / elementSize;
+    const char *bytes = static_cast<const char *>(mapped);
+    for (std::size_t offset = 0; offset < numElements;
+         offset += chunkElements) {
+      const auto count = std::min(chunkElements, numElements - offset);
+      const char *src = bytes + fileHeader.dataOffset + offset * elementSize;
+      writeChunk(offset, count, src);
+      ::madvise(const_cast<char *>(src), count * elementSize, MADV_DONTNEED);
+    }
+  }
+
+private:
+  /// @brief Closes a file descriptor on destruction.
+  class FileDescriptor {
+  public:
+    explicit FileDescriptor(int fd) : fd(fd) {}
+    FileDescriptor(const FileDescriptor &) = delete;
+    FileDescriptor &operator=(const FileDescriptor &) = delete;
+    ~FileDescriptor() {
+      if (fd >= 0)
+        ::close(fd);
+    }
+    int get() const { return fd; }
+
+  private:
+    int fd;
+  };
+
+  /// @brief Unmaps a memory mapping on destruction.
+  class Mapping {
+  public:
+    Mapping(void *address, std::size_t size) : address(address), size(size) {}
+    Mapping(const Mapping &) = delete;
+    Mapping &operator=(const Mapping &) = delete;
+    ~Mapping() {
+      if (address != MAP_FAILED)
+        ::munmap(address, size);
+    }
+    void *get() const { return address; }
+
+  private:
+    void *address;
+    std::size_t size;
+  };
+
+  /// @brief Removes a file on destruction, unless released.
+  class TemporaryFile {
+  public:
+    explicit TemporaryFile(std::string path) : path(std::move(path)) {}
+    TemporaryFile(const TemporaryFile &) = delete;
+    TemporaryFile &operator=(const TemporaryFile &) = delete;
+    ~TemporaryFile() {
+      if (!path.empty())
+        std::remove(path.c_str());
+    }
+    void release() { path.clear(); }
+
+  private:
+    std::string path;
+  };
+
+  [[noreturn]] static void throwSystemError(const std::string &what,
+                                            const std::string &path) {
+    throw std::runtime_error(what + " " + path + ": " +
+                             std::strerror(errno) + ".");
+  }
+
+  StateCheckpointHeader fileHeader;
+  void *mapped = nullptr;
+  std::size_t fileSize = 0;
+};
+} // namespace nvqir
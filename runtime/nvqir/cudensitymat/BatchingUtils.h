@@ -24,5 +24,10 @@ bool checkBatchingCompatibility(
 bool checkBatchingCompatibility(const std::vector<super_op> &listSuperOp);
 bool checkBatchingCompatibility(
     const std::vector<cudaq::matrix_handler> &elemOps);
+// Helper to determine the maximum number of batch members whose evolution
+// fits in the free device memory, counting the states stored for the results.
+std::size_t maxBatchSizeInDeviceMemory(const std::vector<int64_t> &dims,
+                                       bool isDensityMatrix,
+                                       std::size_t numStoredStates);
 } // namespace __internal__
 } // namespace cudaq
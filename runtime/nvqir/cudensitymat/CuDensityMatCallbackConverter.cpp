@@ -11,14 +11,100 @@
 #include "CuDensityMatUtils.h"
 #include "common/FmtCore.h"
 #include "common/Logger.h"
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <ranges>
 
+std::optional<cudensitymatWrappedScalarCallback_t>
+cudaq::dynamics::CuDensityMatOpConverter::wrapDeviceScalarCallback(
+    const std::vector<scalar_operator> &scalarOps,
+    const std::vector<std::string> &paramNames) {
+  if (!m_deviceCallbacks)
+    return std::nullopt;
+  std::vector<DeviceTimeFunction> functions;
+  std::vector<double> knots;
+  std::vector<double> values;
+  std::vector<double> secondDerivatives;
+  for (const auto &scalarOp : scalarOps) {
+    time_function function;
+    if (const auto *closedForm = scalarOp.get_time_function()) {
+      function = *closedForm;
+    } else if (scalarOp.is_constant() && !paramNames.empty()) {
+      // A constant member of the batch is a function with a single value.
+      function = time_function::piecewise_linear({0.0}, {scalarOp.evaluate()},
+                                                 paramNames.front());
+    } else {
+      return std::nullopt;
+    }
+    const auto paramIt =
+        std::find(paramNames.begin(), paramNames.end(), function.parameter);
+    // The parameter is not provided: leave it to the host callback to fail.
+    if (paramIt == paramNames.end())
+      return std::nullopt;
+    DeviceTimeFunction &deviceFunction = functions.emplace_back();
+    deviceFunction.kind = static_cast<int32_t>(function.kind);
+    deviceFunction.paramIdx = std::distance(paramNames.begin(), paramIt);
+    deviceFunction.firstKnot = knots.size();
+    deviceFunction.numKnots = function.knots.size();
+    deviceFunction.frequency = function.frequency;
+    deviceFunction.phase = function.phase;
+    deviceFunction.scale[0] = function.scale.real();
+    deviceFunction.scale[1] = function.scale.imag();
+    deviceFunction.offset[0] = function.offset.real();
+    deviceFunction.offset[1] = function.offset.imag();
+    knots.insert(knots.end(), function.knots.begin(), function.knots.end());
+    for (std::size_t i = 0; i < function.knots.size(); ++i) {
+      values.insert(values.end(),
+                    {function.values[i].real(), function.values[i].imag()});
+      const auto secondDerivative = function.second_derivatives.empty()
+                                        ? std::complex<double>(0.0)
+                                        : function.second_derivatives[i];
+      secondDerivatives.insert(
+          secondDerivatives.end(),
+          {secondDerivative.real(), secondDerivative.imag()});
+    }
+  }
+
+  CUDAQ_INFO("Evaluate {} scalar coefficient(s) on the device",
+             scalarOps.size());
+  DeviceTimeFunctions *storedFunctions = &m_deviceScalarCallbacks.emplace_back(
+      functions, knots, values, secondDerivatives);
+  using WrapperFuncType =
+      int32_t (*)(cudensitymatScalarCallback_t, double, int64_t, int32_t,
+                  const double[], cudaDataType_t, void *, cudaStream_t);
+  // For device callbacks, the parameters and the storage are device arrays and
+  // the values are computed by a kernel enqueued on the stream of the library.
+  auto wrapper = [](cudensitymatScalarCallback_t callback, double /*time*/,
+                    int64_t batchSize, int32_t numParams, const double params[],
+                    cudaDataType_t dataType, void *scalarStorage,
+                    cudaStream_t stream) -> int32_t {
+    try {
+      reinterpret_cast<DeviceTimeFunctions *>(callback)->evaluate(
+          batchSize, numParams, params, dataType, scalarStorage, stream);
+      return CUDENSITYMAT_STATUS_SUCCESS;
+    } catch (const std::exception &e) {
+      std::cerr << "Error in device scalar callback: " << e.what()
+                << std::endl;
+      return CUDENSITYMAT_STATUS_INTERNAL_ERROR;
+    }
+  };
+
+  cudensitymatWrappedScalarCallback_t wrappedCallback;
+  wrappedCallback.callback =
+      reinterpret_cast<cudensitymatScalarCallback_t>(storedFunctions);
+  wrappedCallback.device = CUDENSITYMAT_CALLBACK_DEVICE_GPU;
+  wrappedCallback.wrapper =
+      reinterpret_cast<void *>(static_cast<WrapperFuncType>(wrapper));
+  return wrappedCallback;
+}
+
 cudensitymatWrappedScalarCallback_t
 cudaq::dynamics::CuDensityMatOpConverter::wrapScalarCallback(
     const std::vector<scalar_operator> &scalarOps,
     const std::vector<std::string> &paramNames) {
+  if (auto deviceCallback = wrapDeviceScalarCallback(scalarOps, paramNames))
+    return *deviceCallback;
   m_scalarCallbacks.push_back(ScalarCallBackContext(scalarOps, paramNames));
   ScalarCallBackContext *storedCallbackContext = &m_scalarCallbacks.back();
   using WrapperFuncType =
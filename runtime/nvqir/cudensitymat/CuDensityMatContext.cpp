@@ -9,9 +9,13 @@
 #include "CuDensityMatContext.h"
 #include "CuDensityMatErrorHandling.h"
 #include "CuDensityMatUtils.h"
+#include "common/Environment.h"
+#include "common/FmtCore.h"
 #include "common/Logger.h"
 #include "cudaq.h"
 #include "cudaq/distributed/mpi_plugin.h"
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <mutex>
 
@@ -94,13 +98,20 @@ static cudaqDistributedCommunicator_t *getMpiCommWrapper() {
   return comm;
 }
 
+/// @brief Return true if the state of an evolution should be distributed
+/// across the MPI ranks.
+static bool isDistributionEnabled() {
+  return cudaq::mpi::is_initialized() &&
+         cudaq::getEnvBool("CUDAQ_DYNAMICS_DISTRIBUTED", true);
+}
+
 /// @brief Construct a new Context object for a specific device.
 /// @arg deviceId ID of the CUDA device.
 Context::Context(int deviceId) : m_deviceId(deviceId) {
   HANDLE_CUDA_ERROR(cudaSetDevice(deviceId));
   HANDLE_CUDM_ERROR(cudensitymatCreate(&m_cudmHandle));
 
-  if (cudaq::mpi::is_initialized()) {
+  if (isDistributionEnabled()) {
     cudaqDistributedInterface_t *mpiInterface = getMpiPluginInterface();
     cudaqDistributedCommunicator_t *comm = getMpiCommWrapper();
     cudaqDistributedCommunicator_t *dupComm = nullptr;
@@ -113,6 +124,8 @@ Context::Context(int deviceId) : m_deviceId(deviceId) {
     HANDLE_CUDM_ERROR(cudensitymatResetDistributedConfiguration(
         m_cudmHandle, CUDENSITYMAT_DISTRIBUTED_PROVIDER_MPI, dupComm->commPtr,
         dupComm->commSize));
+    m_distributedComm = dupComm;
+    m_gatherStates = cudaq::getEnvBool("CUDAQ_DYNAMICS_GATHER_STATES", false);
   }
   HANDLE_CUBLAS_ERROR(cublasCreate(&m_cublasHandle));
   m_opConverter = std::make_unique<CuDensityMatOpConverter>(m_cudmHandle);
@@ -121,11 +134,49 @@ Context::Context(int deviceId) : m_deviceId(deviceId) {
 bool Context::isDistributed() const { return getNumRanks() > 1; }
 
 int Context::getNumRanks() const {
-  return cudaq::mpi::is_initialized() ? cudaq::mpi::num_ranks() : 1;
+  return m_distributedComm ? cudaq::mpi::num_ranks() : 1;
 }
 
 int Context::getRank() const {
-  return cudaq::mpi::is_initialized() ? cudaq::mpi::rank() : 0;
+  return m_distributedComm ? cudaq::mpi::rank() : 0;
+}
+
+void Context::gatherToRoot(const std::complex<double> *localData,
+                           std::int64_t localSize, std::int64_t localOffset,
+                           std::complex<double> *globalData) const {
+  if (!m_distributedComm)
+    throw std::runtime_error("Gathering a distributed array requires the "
+                             "distributed mode of the dynamics target");
+  if (localSize > std::numeric_limits<int32_t>::max())
+    throw std::runtime_error(
+        fmt::format("The slice of a distributed array is too large to be "
+                    "gathered ({} elements)",
+                    localSize));
+  cudaqDistributedInterface_t *mpiInterface = getMpiPluginInterface();
+  constexpr int32_t offsetTag = 0;
+  constexpr int32_t dataTag = 1;
+  const int rank = getRank();
+  if (rank != 0) {
+    if (mpiInterface->Send(m_distributedComm, &localOffset, 1, INT_64, 0,
+                           offsetTag) != 0 ||
+        mpiInterface->Send(m_distributedComm, localData, localSize,
+                           DOUBLE_COMPLEX, 0, dataTag) != 0)
+      throw std::runtime_error(
+          fmt::format("Failed to send the slice of rank {} to rank 0", rank));
+    return;
+  }
+
+  // All the slices of a distributed state have the same size.
+  std::copy_n(localData, localSize, globalData + localOffset);
+  for (int source = 1; source < getNumRanks(); ++source) {
+    std::int64_t offset = 0;
+    if (mpiInterface->Recv(m_distributedComm, &offset, 1, INT_64, source,
+                           offsetTag) != 0 ||
+        mpiInterface->Recv(m_distributedComm, globalData + offset, localSize,
+                           DOUBLE_COMPLEX, source, dataTag) != 0)
+      throw std::runtime_error(fmt::format(
+          "Failed to receive the slice of rank {} on rank 0", source));
+  }
 }
 
 /// @brief Destroy the Context object and release resources.
@@ -8,8 +8,10 @@
 
 #pragma once
 #include "CuDensityMatOpConverter.h"
+#include "cudaq/distributed/distributed_capi.h"
 #include <cublas_v2.h>
 #include <cuda_runtime.h>
+#include <complex>
 #include <cudensitymat.h>
 
 namespace cudaq::dynamics {
@@ -49,6 +51,9 @@ public:
   int getDeviceId() const { return m_deviceId; }
 
   /// @brief Return true if running in distributed mode
+  // The state of an evolution is distributed across all the MPI ranks when MPI
+  // is initialized, unless disabled by `CUDAQ_DYNAMICS_DISTRIBUTED=OFF`, in
+  // which case every rank runs its own evolutions independently.
   bool isDistributed() const;
 
   /// @brief Return the total number of ranks in distributed mode
@@ -59,6 +64,27 @@ public:
   /// Always returns 0 if not in distributed mode
   int getRank() const;
 
+  /// @brief Return the communicator of the distributed mode
+  // This is a duplicate of the CUDA-Q MPI communicator, dedicated to the
+  // `dynamics` target. Returns nullptr if not in distributed mode.
+  const cudaqDistributedCommunicator_t *getDistributedComm() const {
+    return m_distributedComm;
+  }
+
+  /// @brief Return true if the states resulting from a distributed evolution
+  /// should be assembled on rank 0.
+  // Enabled with `CUDAQ_DYNAMICS_GATHER_STATES=ON`. Otherwise, every rank
+  // returns the slice of the states that it stores.
+  bool shouldGatherStates() const { return m_gatherStates; }
+
+  /// @brief Gather the slices of a distributed array on rank 0.
+  // Each rank provides the `localSize` elements it stores, starting at
+  // `localOffset` in the whole array, in host memory. On rank 0, `globalData`
+  // receives the whole array; it is not accessed on the other ranks.
+  void gatherToRoot(const std::complex<double> *localData,
+                    std::int64_t localSize, std::int64_t localOffset,
+                    std::complex<double> *globalData) const;
+
 private:
   /// @brief Construct a new Context object for a specific device.
   /// @param deviceId ID of the CUDA device.
@@ -70,5 +96,7 @@ private:
   int m_deviceId;
   void *m_scratchSpace{nullptr};
   std::size_t m_scratchSpaceSizeBytes{0};
+  cudaqDistributedCommunicator_t *m_distributedComm{nullptr};
+  bool m_gatherStates{false};
 };
 } // namespace cudaq::dynamics
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CuDensityMatErrorNorm.h"
+#include <stdexcept>
+#include <thrust/complex.h>
+#include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/transform_reduce.h>
+
+namespace {
+struct ScaledSquaredElement {
+  const thrust::complex<double> *y0;
+  const thrust::complex<double> *y1;
+  const thrust::complex<double> *terms[cudaq::dynamics::maxScaledNormTerms];
+  double coeffs[cudaq::dynamics::maxScaledNormTerms];
+  std::size_t numTerms;
+  double rtol;
+  double atol;
+
+  __device__ double operator()(std::size_t i) const {
+    thrust::complex<double> sum = 0.0;
+    for (std::size_t j = 0; j < numTerms; ++j)
+      sum += coeffs[j] * terms[j][i];
+    const double scale =
+        atol + rtol * fmax(thrust::abs(y0[i]), thrust::abs(y1[i]));
+    const double scaled = thrust::abs(sum) / scale;
+    return scaled * scaled;
+  }
+};
+} // namespace
+
+double cudaq::dynamics::scaledSquaredNorm(
+    std::size_t size, const void *y0, const void *y1,
+    const std::vector<const void *> &terms, const std::vector<double> &coeffs,
+    double rtol, double atol) {
+  if (terms.size() != coeffs.size() || terms.size() > maxScaledNormTerms)
+    throw std::invalid_argument("invalid terms of the scaled norm");
+
+  ScaledSquaredElement element;
+  element.y0 = static_cast<const thrust::complex<double> *>(y0);
+  element.y1 = static_cast<const thrust::complex<double> *>(y1);
+  element.numTerms = terms.size();
+  for (std::size_t j = 0; j < terms.size(); ++j) {
+    element.terms[j] = static_cast<const thrust::complex<double> *>(terms[j]);
+    element.coeffs[j] = coeffs[j];
+  }
+  element.rtol = rtol;
+  element.atol = atol;
+  return thrust::transform_reduce(
+      thrust::device, thrust::counting_iterator<std::size_t>(0),
+      thrust::counting_iterator<std::size_t>(size), element, 0.0,
+      thrust::plus<double>());
+}
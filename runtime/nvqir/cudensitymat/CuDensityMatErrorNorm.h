@@ -0,0 +1,27 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace cudaq::dynamics {
+// The maximum number of states combined by `scaledSquaredNorm`.
+inline constexpr std::size_t maxScaledNormTerms = 8;
+
+// Returns the sum over the `size` elements of the complex double device arrays
+// of |sum_j coeffs[j] * terms[j][i]|^2 / (atol + rtol * max(|y0[i]|,
+// |y1[i]|))^2.
+// The linear combination and the scaling are fused into a single reduction
+// kernel, so that no intermediate state is allocated and only the result is
+// copied back to the host.
+double scaledSquaredNorm(std::size_t size, const void *y0, const void *y1,
+                         const std::vector<const void *> &terms,
+                         const std::vector<double> &coeffs, double rtol,
+                         double atol);
+} // namespace cudaq::dynamics
@@ -9,11 +9,13 @@
 #include "BatchingUtils.h"
 #include "CuDensityMatContext.h"
 #include "CuDensityMatErrorHandling.h"
+#include "CuDensityMatEvolveSink.h"
 #include "CuDensityMatExpectation.h"
 #include "CuDensityMatState.h"
 #include "CuDensityMatTimeStepper.h"
 #include "CuDensityMatUtils.h"
 #include "common/FmtCore.h"
+#include "cudaq.h"
 #include "cudaq/algorithms/evolve_internal.h"
 #include "cudaq/algorithms/integrator.h"
 #include <iterator>
@@ -203,42 +205,151 @@ static CuDensityMatState *asCudmState(cudaq::state &cudaqState) {
   return cudmState;
 }
 
+// The state of a single evolution is sharded across the ranks in distributed
+// mode. If requested, the resulting states are assembled on rank 0, while the
+// other ranks keep their slices.
+static state gatherResultState(const state &resultState) {
+  auto *cudmState = asCudmState(const_cast<state &>(resultState));
+  if (!dynamics::Context::getCurrentContext()->shouldGatherStates() ||
+      !cudmState->isDistributedSlice())
+    return resultState;
+  auto gatheredState = CuDensityMatState::gatherToRoot(*cudmState);
+  return gatheredState ? state(gatheredState.release()) : resultState;
+}
+
+// Indices of the operator and of the initial state of each member of a batch
+// of evolutions. Operators and initial states of the same length are paired,
+// otherwise every operator evolves every initial state, in operator-major
+// order.
+static std::vector<std::pair<std::size_t, std::size_t>>
+getBatchMembers(std::size_t numOperators, std::size_t numStates) {
+  if (numStates == 0)
+    throw std::invalid_argument("No initial states provided for evolution.");
+  std::vector<std::pair<std::size_t, std::size_t>> members;
+  if (numOperators == numStates) {
+    for (std::size_t i = 0; i < numOperators; ++i)
+      members.emplace_back(i, i);
+    return members;
+  }
+  members.reserve(numOperators * numStates);
+  for (std::size_t i = 0; i < numOperators; ++i)
+    for (std::size_t j = 0; j < numStates; ++j)
+      members.emplace_back(i, j);
+  return members;
+}
+
+std::size_t maxBatchSizeInDeviceMemory(const std::vector<int64_t> &dims,
+                                       bool isDensityMatrix,
+                                       std::size_t numStoredStates) {
+  // Number of state-sized buffers held for each batch member during the
+  // evolution: the state itself, the integrator stages and temporaries, and
+  // the workspace of the operator action.
+  constexpr std::size_t numWorkingCopies = 12;
+  std::size_t stateSize = 1;
+  for (auto dim : dims)
+    stateSize *= dim;
+  if (isDensityMatrix)
+    stateSize *= stateSize;
+  const std::size_t bytesPerMember = stateSize *
+                                     sizeof(std::complex<double>) *
+                                     (numWorkingCopies + numStoredStates);
+  std::size_t freeMem = 0, totalMem = 0;
+  HANDLE_CUDA_ERROR(cudaMemGetInfo(&freeMem, &totalMem));
+  // Leave some room for the operators and the library workspaces.
+  const std::size_t membersPerDevice =
+      std::max<std::size_t>(1, freeMem / 10 * 9 / bytesPerMember);
+  // Distributed batched states are evenly partitioned across the ranks.
+  return membersPerDevice *
+         dynamics::Context::getCurrentContext()->getNumRanks();
+}
+
+static std::size_t getNumStoredStates(const schedule &schedule,
+                                      IntermediateResultSave storeResults) {
+  if (storeResults != IntermediateResultSave::All)
+    return 1;
+  return std::distance(schedule.begin(), schedule.end());
+}
+
+// Evaluate the parameters at all the steps of the schedule up front. The
+// copies of the schedule held by the integrator share these values.
+static void precomputeStepParameters(const schedule &schedule) {
+  std::vector<double> times;
+  for (const auto &step : schedule)
+    times.push_back(step.real());
+  schedule.precompute_parameters(times);
+}
+
+// If `jumps` is provided, the state of the integrator is the batch of
+// trajectories of a stochastic unravelling, and the expectation values are
+// averaged over the normalized trajectories.
 static evolve_result
 evolveSingleImpl(const std::vector<int64_t> &dims, const schedule &schedule,
                  base_integrator &integrator,
                  const std::vector<sum_op<cudaq::matrix_handler>> &observables,
-                 IntermediateResultSave storeIntermediateResults) {
+                 IntermediateResultSave storeIntermediateResults,
+                 const evolve_sink &sink, std::size_t batchIdx = 0,
+                 CuDensityMatQuantumJumps *jumps = nullptr) {
   LOG_API_TIME();
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
-  std::vector<CuDensityMatExpectation> expectations;
+  std::optional<dynamics::EvolveSinkPipeline> sinkPipeline;
+  if (sink)
+    sinkPipeline.emplace(sink);
   auto &opConverter =
       cudaq::dynamics::Context::getCurrentContext()->getOpConverter();
+  std::vector<cudensitymatOperator_t> observableOps;
   for (auto &obs : observables)
-    expectations.emplace_back(CuDensityMatExpectation(
-        handle, opConverter.convertToCudensitymatOperator({}, obs, dims)));
+    observableOps.emplace_back(
+        opConverter.convertToCudensitymatOperator({}, obs, dims));
+  CuDensityMatFusedExpectation expectations(handle, observableOps);
+
+  const auto resultState = [&](const state &currentState) {
+    if (!jumps)
+      return currentState;
+    return state(CuDensityMatQuantumJumps::normalized(
+                     *asCudmState(const_cast<state &>(currentState)))
+                     .release());
+  };
+  const auto computeExpectations = [&](const state &currentState,
+                                       double time) {
+    std::vector<double> expVals;
+    auto *cudmState = asCudmState(const_cast<state &>(currentState));
+    const auto batchSize = cudmState->getBatchSize();
+    for (const auto &expVal :
+         expectations.compute(cudmState->get_impl(), time, batchSize)) {
+      assert(expVal.size() == batchSize);
+      double sum = 0.0;
+      for (const auto &val : expVal)
+        sum += val.real();
+      expVals.emplace_back(sum / batchSize);
+    }
+    return expVals;
+  };
 
   std::vector<std::vector<double>> expectationVals;
   std::vector<cudaq::state> intermediateStates;
+  precomputeStepParameters(schedule);
+  std::size_t stepIdx = 0;
   for (const auto &step : schedule) {
     integrator.integrate(step.real());
     auto [t, currentState] = integrator.getState();
-    if (storeIntermediateResults != cudaq::IntermediateResultSave::None) {
-      std::vector<double> expVals;
-
-      for (auto &expectation : expectations) {
-        auto *cudmState = asCudmState(currentState);
-        expectation.prepare(cudmState->get_impl());
-        const auto expVal = expectation.compute(cudmState->get_impl(),
-                                                step.real(), /*batchSize=*/1);
-        assert(expVal.size() == 1);
-        expVals.emplace_back(expVal.front().real());
-      }
-      expectationVals.emplace_back(std::move(expVals));
+    if (jumps && jumps->apply(*asCudmState(currentState), t))
+      integrator.setState(currentState, t);
+    if (storeIntermediateResults != cudaq::IntermediateResultSave::None ||
+        sinkPipeline) {
+      const auto stepState = resultState(currentState);
+      auto expVals = computeExpectations(stepState, step.real());
+      if (sinkPipeline)
+        sinkPipeline->push(batchIdx, stepIdx, step.real(), stepState, expVals);
+      if (storeIntermediateResults != cudaq::IntermediateResultSave::None)
+        expectationVals.emplace_back(std::move(expVals));
       if (storeIntermediateResults == cudaq::IntermediateResultSave::All)
-        intermediateStates.emplace_back(currentState);
+        intermediateStates.emplace_back(gatherResultState(stepState));
     }
+    ++stepIdx;
   }
+  if (sinkPipeline)
+    sinkPipeline->finish();
 
   if (cudaq::details::should_log(cudaq::details::LogLevel::trace))
     cudaq::dynamics::dumpPerfTrace();
@@ -248,24 +359,59 @@ evolveSingleImpl(const std::vector<int64_t> &dims, const schedule &schedule,
   } else {
     // Only final state is needed
     auto [finalTime, finalState] = integrator.getState();
+    finalState = resultState(finalState);
 
     if (storeIntermediateResults ==
         cudaq::IntermediateResultSave::ExpectationValue)
-      return evolve_result({finalState}, expectationVals);
+      return evolve_result({gatherResultState(finalState)}, expectationVals);
 
-    std::vector<double> expVals;
-    auto *cudmState = asCudmState(finalState);
-    for (auto &expectation : expectations) {
-      expectation.prepare(cudmState->get_impl());
-      const auto expVal = expectation.compute(cudmState->get_impl(), finalTime,
-                                              /*batchSize=*/1);
-      assert(expVal.size() == 1);
-      expVals.emplace_back(expVal.front().real());
-    }
-    return evolve_result(finalState, expVals);
+    const auto expVals = computeExpectations(finalState, finalTime);
+    return evolve_result(gatherResultState(finalState), expVals);
   }
 }
 
+// Evolve `numTrajectories` quantum trajectories of the stochastic unravelling
+// of the master equation of an open system, as a batch of state vectors.
+static evolve_result evolveTrajectories(
+    const std::vector<int64_t> &dims,
+    const sum_op<cudaq::matrix_handler> &hamiltonian,
+    const std::vector<sum_op<cudaq::matrix_handler>> &collapseOperators,
+    const schedule &schedule, CuDensityMatState &initialState,
+    base_integrator &integrator,
+    const std::vector<sum_op<cudaq::matrix_handler>> &observables,
+    IntermediateResultSave storeIntermediateResults, int numTrajectories,
+    const evolve_sink &sink) {
+  if (numTrajectories < 1)
+    throw std::invalid_argument(fmt::format(
+        "Invalid number of shots ({}) for quantum trajectories.",
+        numTrajectories));
+  // Trajectories are independent, each rank may evolve its own with
+  // `CUDAQ_DYNAMICS_DISTRIBUTED=OFF`.
+  if (dynamics::Context::getCurrentContext()->isDistributed())
+    throw std::invalid_argument(
+        "Quantum trajectories are not supported in distributed mode.");
+  cudensitymatHandle_t handle =
+      dynamics::Context::getCurrentContext()->getHandle();
+  state trajectories =
+      numTrajectories == 1
+          ? state(CuDensityMatState::clone(initialState).release())
+          : state(CuDensityMatState::createBatchedState(
+                      handle,
+                      std::vector<CuDensityMatState *>(numTrajectories,
+                                                       &initialState),
+                      dims, /*createDensityState=*/false)
+                      .release());
+
+  SystemDynamics system(dims, hamiltonian, collapseOperators);
+  cudaq::integrator_helper::init_system_dynamics(integrator, system, schedule);
+  integrator.setState(trajectories, 0.0);
+  CuDensityMatQuantumJumps jumps(system, schedule, numTrajectories,
+                                 cudaq::get_random_seed());
+  return evolveSingleImpl(dims, schedule, integrator, observables,
+                          storeIntermediateResults, sink, /*batchIdx=*/0,
+                          &jumps);
+}
+
 /// @brief Evolve the system for a single time step.
 /// @param hamiltonian Hamiltonian operator.
 /// @param dimensionsMap Dimension of the system.
@@ -284,7 +430,8 @@ evolve_result evolveSingle(
     const std::vector<sum_op<cudaq::matrix_handler>> &collapseOperators,
     const std::vector<sum_op<cudaq::matrix_handler>> &observables,
     IntermediateResultSave storeIntermediateResults,
-    std::optional<int> shotsCount) {
+    std::optional<int> shotsCount,
+    const evolve_sink &sink) {
   LOG_API_TIME();
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
@@ -298,6 +445,15 @@ evolve_result evolveSingle(
   if (!cudmState->is_initialized())
     cudmState->initialize_cudm(handle, dims, /*batchSize=*/1);
 
+  // With a number of shots, an open system with a state vector is unravelled
+  // into as many quantum trajectories, evolved as a batch of state vectors.
+  if (shotsCount.has_value() && !collapseOperators.empty() &&
+      !cudmState->is_density_matrix())
+    return evolveTrajectories(dims, hamiltonian, collapseOperators, schedule,
+                              *cudmState, integrator, observables,
+                              storeIntermediateResults, shotsCount.value(),
+                              sink);
+
   state initial_State = [&]() {
     if (!collapseOperators.empty() && !cudmState->is_density_matrix())
       return state(new CuDensityMatState(cudmState->to_density_matrix()));
@@ -308,7 +464,7 @@ evolve_result evolveSingle(
   cudaq::integrator_helper::init_system_dynamics(integrator, system, schedule);
   integrator.setState(initial_State, 0.0);
   return evolveSingleImpl(dims, schedule, integrator, observables,
-                          storeIntermediateResults);
+                          storeIntermediateResults, sink);
 }
 
 /// @brief Evolve the system for a single time step.
@@ -329,21 +485,26 @@ evolve_result evolveSingle(
     const std::vector<sum_op<cudaq::matrix_handler>> &collapse_operators,
     const std::vector<sum_op<cudaq::matrix_handler>> &observables,
     IntermediateResultSave store_intermediate_results,
-    std::optional<int> shots_count) {
+    std::optional<int> shots_count,
+    const evolve_sink &sink) {
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
+  // Quantum trajectories evolve state vectors.
   auto cudmState = CuDensityMatState::createInitialState(
-      handle, initial_state, dimensions, collapse_operators.size() > 0);
+      handle, initial_state, dimensions,
+      collapse_operators.size() > 0 && !shots_count.has_value());
   return evolveSingle(
       hamiltonian, dimensions, schedule, state(cudmState.release()), integrator,
-      collapse_operators, observables, store_intermediate_results, shots_count);
+      collapse_operators, observables, store_intermediate_results, shots_count,
+      sink);
 }
 
 static std::vector<evolve_result>
 evolveBatchedImpl(const std::vector<int64_t> dims, const schedule &schedule,
                   std::size_t batchSize, base_integrator &integrator,
                   const std::vector<sum_op<cudaq::matrix_handler>> &observables,
-                  IntermediateResultSave storeIntermediateResults) {
+                  IntermediateResultSave storeIntermediateResults,
+                  const evolve_sink &sink, std::size_t batchOffset = 0) {
   LOG_API_TIME();
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
@@ -358,13 +519,13 @@ evolveBatchedImpl(const std::vector<int64_t> dims, const schedule &schedule,
         batchSize, dynamics::Context::getCurrentContext()->getNumRanks()));
   }
 
-  std::vector<CuDensityMatExpectation> expectations;
   auto &opConverter =
       cudaq::dynamics::Context::getCurrentContext()->getOpConverter();
-  for (auto &obs : observables) {
-    auto cudmObsOp = opConverter.convertToCudensitymatOperator({}, obs, dims);
-    expectations.emplace_back(CuDensityMatExpectation(handle, cudmObsOp));
-  }
+  std::vector<cudensitymatOperator_t> observableOps;
+  for (auto &obs : observables)
+    observableOps.emplace_back(
+        opConverter.convertToCudensitymatOperator({}, obs, dims));
+  CuDensityMatFusedExpectation expectations(handle, observableOps);
 
   // Helper to compute the state idx within the batch for distributed mode
   const auto getDistributedGlobalIdx = [](int localIdx, int batchSize) {
@@ -375,25 +536,30 @@ evolveBatchedImpl(const std::vector<int64_t> dims, const schedule &schedule,
     return mpiRank * statesPerRank + localIdx;
   };
 
+  std::optional<dynamics::EvolveSinkPipeline> sinkPipeline;
+  if (sink)
+    sinkPipeline.emplace(sink);
   std::vector<std::vector<std::vector<double>>> expectationVals(batchSize);
   std::vector<std::vector<cudaq::state>> intermediateStates(batchSize);
+  precomputeStepParameters(schedule);
+  std::size_t stepIdx = 0;
   for (const auto &step : schedule) {
     integrator.integrate(step.real());
     auto [t, currentState] = integrator.getState();
-    if (storeIntermediateResults != cudaq::IntermediateResultSave::None) {
+    if (storeIntermediateResults != cudaq::IntermediateResultSave::None ||
+        sinkPipeline) {
       auto *cudmState = asCudmState(currentState);
       std::vector<std::vector<double>> expVals(batchSize);
-      for (auto &expectation : expectations) {
-        expectation.prepare(cudmState->get_impl());
-        const auto expVal =
-            expectation.compute(cudmState->get_impl(), step.real(), batchSize);
+      for (const auto &expVal : expectations.compute(
+               cudmState->get_impl(), step.real(), batchSize)) {
         assert(expVal.size() == batchSize);
         for (int i = 0; i < expVal.size(); ++i) {
           expVals[i].emplace_back(expVal[i].real());
         }
       }
 
-      if (storeIntermediateResults == cudaq::IntermediateResultSave::All) {
+      if (sinkPipeline ||
+          storeIntermediateResults == cudaq::IntermediateResultSave::All) {
         auto states = CuDensityMatState::splitBatchedState(*cudmState);
         // In distributed mode, the split operation only returns the local
         // states held by this rank. The number of split states may be less than
@@ -401,25 +567,31 @@ evolveBatchedImpl(const std::vector<int64_t> dims, const schedule &schedule,
         assert(states.size() <= batchSize);
 
         const auto numLocalStates = states.size();
-        if (numLocalStates == batchSize) {
+        for (int i = 0; i < numLocalStates; ++i) {
           // Non-distributed mode: all states are local
-          for (int i = 0; i < batchSize; ++i) {
-            intermediateStates[i].emplace_back(states[i]);
-          }
-        } else {
-          for (int i = 0; i < numLocalStates; ++i) {
-            const auto globalIdx = getDistributedGlobalIdx(i, batchSize);
-            if (globalIdx < batchSize) {
-              intermediateStates[globalIdx].emplace_back(states[i]);
-            }
-          }
+          const auto globalIdx = numLocalStates == batchSize
+                                     ? i
+                                     : getDistributedGlobalIdx(i, batchSize);
+          if (globalIdx >= batchSize)
+            continue;
+          cudaq::state splitState(states[i]);
+          if (sinkPipeline)
+            sinkPipeline->push(batchOffset + globalIdx, stepIdx, step.real(),
+                               splitState, expVals[globalIdx]);
+          if (storeIntermediateResults == cudaq::IntermediateResultSave::All)
+            intermediateStates[globalIdx].emplace_back(splitState);
         }
       }
-      for (int i = 0; i < batchSize; ++i) {
-        expectationVals[i].emplace_back(expVals[i]);
+      if (storeIntermediateResults != cudaq::IntermediateResultSave::None) {
+        for (int i = 0; i < batchSize; ++i) {
+          expectationVals[i].emplace_back(expVals[i]);
+        }
       }
     }
+    ++stepIdx;
   }
+  if (sinkPipeline)
+    sinkPipeline->finish();
 
   if (storeIntermediateResults == cudaq::IntermediateResultSave::All) {
     std::vector<evolve_result> results;
@@ -484,10 +656,8 @@ evolveBatchedImpl(const std::vector<int64_t> dims, const schedule &schedule,
 
     // Compute final expectation values
     std::vector<std::vector<double>> expVals(batchSize);
-    for (auto &expectation : expectations) {
-      expectation.prepare(cudmState->get_impl());
-      const auto expVal =
-          expectation.compute(cudmState->get_impl(), finalTime, batchSize);
+    for (const auto &expVal :
+         expectations.compute(cudmState->get_impl(), finalTime, batchSize)) {
       assert(expVal.size() == batchSize);
       for (int i = 0; i < expVal.size(); ++i) {
         expVals[i].emplace_back(expVal[i].real());
@@ -505,7 +675,8 @@ std::vector<evolve_result> evolveBatched(
     const std::vector<sum_op<cudaq::matrix_handler>> &collapseOperators,
     const std::vector<sum_op<cudaq::matrix_handler>> &observables,
     IntermediateResultSave storeIntermediateResults,
-    std::optional<int> shotsCount) {
+    std::optional<int> shotsCount,
+    const evolve_sink &sink) {
   LOG_API_TIME();
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
@@ -518,13 +689,29 @@ std::vector<evolve_result> evolveBatched(
   for (auto &initialState : initialStates) {
     states.emplace_back(asCudmState(const_cast<state &>(initialState)));
   }
+  const auto maxBatchSize = maxBatchSizeInDeviceMemory(
+      dims, !collapseOperators.empty() || states[0]->is_density_matrix(),
+      getNumStoredStates(schedule, storeIntermediateResults));
+  if (initialStates.size() > maxBatchSize) {
+    CUDAQ_INFO("Splitting the evolution of {} initial states into batches of "
+               "{} to fit in device memory.",
+               initialStates.size(), maxBatchSize);
+    return evolveBatched(
+        std::vector<sum_op<cudaq::matrix_handler>>(initialStates.size(),
+                                                   hamiltonian),
+        dimensionsMap, schedule, initialStates, integrator,
+        std::vector<std::vector<sum_op<cudaq::matrix_handler>>>(
+            collapseOperators.empty() ? 0 : initialStates.size(),
+            collapseOperators),
+        observables, storeIntermediateResults, maxBatchSize, sink);
+  }
   auto batchedState = CuDensityMatState::createBatchedState(
       handle, states, dims, !collapseOperators.empty());
   SystemDynamics system(dims, hamiltonian, collapseOperators);
   cudaq::integrator_helper::init_system_dynamics(integrator, system, schedule);
   integrator.setState(cudaq::state(batchedState.release()), 0.0);
   return evolveBatchedImpl(dims, schedule, initialStates.size(), integrator,
-                           observables, storeIntermediateResults);
+                           observables, storeIntermediateResults, sink);
 }
 
 evolve_result
@@ -533,7 +720,8 @@ evolveSingle(const super_op &superOp, const cudaq::dimension_map &dimensionsMap,
              base_integrator &integrator,
              const std::vector<sum_op<cudaq::matrix_handler>> &observables,
              IntermediateResultSave storeIntermediateResults,
-             std::optional<int> shotsCount) {
+             std::optional<int> shotsCount,
+             const evolve_sink &sink) {
   LOG_API_TIME();
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
@@ -552,7 +740,7 @@ evolveSingle(const super_op &superOp, const cudaq::dimension_map &dimensionsMap,
   integrator.setState(initialState, 0.0);
 
   return evolveSingleImpl(dims, schedule, integrator, observables,
-                          storeIntermediateResults);
+                          storeIntermediateResults, sink);
 }
 
 evolve_result
@@ -561,7 +749,8 @@ evolveSingle(const super_op &superOp, const cudaq::dimension_map &dimensionsMap,
              base_integrator &integrator,
              const std::vector<sum_op<cudaq::matrix_handler>> &observables,
              IntermediateResultSave storeIntermediateResults,
-             std::optional<int> shotsCount) {
+             std::optional<int> shotsCount,
+             const evolve_sink &sink) {
   LOG_API_TIME();
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
@@ -576,7 +765,7 @@ evolveSingle(const super_op &superOp, const cudaq::dimension_map &dimensionsMap,
       handle, initial_state, dimensionsMap, has_right_apply);
   return evolveSingle(superOp, dimensionsMap, schedule,
                       state(cudmState.release()), integrator, observables,
-                      storeIntermediateResults, shotsCount);
+                      storeIntermediateResults, shotsCount, sink);
 }
 
 std::vector<evolve_result>
@@ -586,7 +775,8 @@ evolveBatched(const super_op &superOp,
               base_integrator &integrator,
               const std::vector<sum_op<cudaq::matrix_handler>> &observables,
               IntermediateResultSave storeIntermediateResults,
-              std::optional<int> shotsCount) {
+              std::optional<int> shotsCount,
+              const evolve_sink &sink) {
   LOG_API_TIME();
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
@@ -606,13 +796,25 @@ evolveBatched(const super_op &superOp,
     }
     return false;
   }();
+  const auto maxBatchSize = maxBatchSizeInDeviceMemory(
+      dims, has_right_apply || states[0]->is_density_matrix(),
+      getNumStoredStates(schedule, storeIntermediateResults));
+  if (initialStates.size() > maxBatchSize) {
+    CUDAQ_INFO("Splitting the evolution of {} initial states into batches of "
+               "{} to fit in device memory.",
+               initialStates.size(), maxBatchSize);
+    return evolveBatched(std::vector<super_op>(initialStates.size(), superOp),
+                         dimensionsMap, schedule, initialStates, integrator,
+                         observables, storeIntermediateResults, maxBatchSize,
+                         sink);
+  }
   auto batchedState = CuDensityMatState::createBatchedState(
       handle, states, dims, has_right_apply);
   cudaq::integrator_helper::init_system_dynamics(integrator, {superOp}, dims,
                                                  schedule);
   integrator.setState(cudaq::state(batchedState.release()), 0.0);
   return evolveBatchedImpl(dims, schedule, initialStates.size(), integrator,
-                           observables, storeIntermediateResults);
+                           observables, storeIntermediateResults, sink);
 }
 
 std::vector<evolve_result>
@@ -624,7 +826,8 @@ evolveBatched(const std::vector<sum_op<cudaq::matrix_handler>> &hamiltonians,
                   &collapse_operators,
               const std::vector<sum_op<cudaq::matrix_handler>> &observables,
               IntermediateResultSave store_intermediate_results,
-              std::optional<int> batch_size) {
+              std::optional<int> batch_size,
+              const evolve_sink &sink) {
   LOG_API_TIME();
 
   if (!collapse_operators.empty() &&
@@ -633,10 +836,8 @@ evolveBatched(const std::vector<sum_op<cudaq::matrix_handler>> &hamiltonians,
                              "number of collapse operators.");
   }
 
-  if (initial_states.size() != hamiltonians.size()) {
-    throw std::runtime_error(
-        "Number of initial states must match number of Hamiltonian operators.");
-  }
+  const auto members =
+      getBatchMembers(hamiltonians.size(), initial_states.size());
 
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
@@ -663,23 +864,32 @@ evolveBatched(const std::vector<sum_op<cudaq::matrix_handler>> &hamiltonians,
     }
   }
 
-  const auto batchSizeToRun =
-      canBeBatched ? std::min<int>(batch_size.value_or(hamiltonians.size()),
-                                   hamiltonians.size())
-                   : 1;
-  assert(batchSizeToRun <= hamiltonians.size());
-  std::unordered_map<std::string, std::complex<double>> params;
-  for (const auto &param : schedule.get_parameters()) {
-    params[param] = schedule.get_value_function()(param, 0.0);
-  }
+  const auto params = schedule.get_parameter_values(0.0);
   const bool isMasterEquation =
       !collapse_operators.empty() && !collapse_operators[0].empty();
+  // Unless the batch size is specified, run as many members at once as fit
+  // in device memory.
+  std::size_t batchSizeToRun = 1;
+  if (canBeBatched && batch_size.has_value()) {
+    batchSizeToRun = std::min<std::size_t>(batch_size.value(), members.size());
+  } else if (canBeBatched) {
+    const bool isDensityMatrix =
+        isMasterEquation ||
+        asCudmState(const_cast<state &>(initial_states[0]))
+            ->is_density_matrix();
+    batchSizeToRun = std::min(
+        members.size(),
+        maxBatchSizeInDeviceMemory(
+            dims, isDensityMatrix,
+            getNumStoredStates(schedule, store_intermediate_results)));
+  }
+  assert(batchSizeToRun <= members.size());
 
   // Run batched evolution up to the batch size and concatenate the results.
   std::vector<evolve_result> allResults;
-  allResults.reserve(hamiltonians.size());
-  // Split the input states into batches up to batchSizeToRun
-  for (std::size_t i = 0; i < hamiltonians.size(); i += batchSizeToRun) {
+  allResults.reserve(members.size());
+  // Split the batch members into batches up to batchSizeToRun
+  for (std::size_t i = 0; i < members.size(); i += batchSizeToRun) {
     std::vector<CuDensityMatState *> states;
     states.reserve(batchSizeToRun);
     std::vector<sum_op<cudaq::matrix_handler>> batchHamOps;
@@ -687,12 +897,14 @@ evolveBatched(const std::vector<sum_op<cudaq::matrix_handler>> &hamiltonians,
     std::vector<std::vector<sum_op<cudaq::matrix_handler>>> batchCollapseOps;
     batchCollapseOps.reserve(batchSizeToRun);
 
-    for (std::size_t j = i; j < i + batchSizeToRun && j < hamiltonians.size();
+    for (std::size_t j = i; j < i + batchSizeToRun && j < members.size();
          ++j) {
-      states.emplace_back(asCudmState(const_cast<state &>(initial_states[j])));
-      batchHamOps.emplace_back(hamiltonians[j]);
+      const auto [opIdx, stateIdx] = members[j];
+      states.emplace_back(
+          asCudmState(const_cast<state &>(initial_states[stateIdx])));
+      batchHamOps.emplace_back(hamiltonians[opIdx]);
       if (!collapse_operators.empty()) {
-        batchCollapseOps.emplace_back(collapse_operators[j]);
+        batchCollapseOps.emplace_back(collapse_operators[opIdx]);
       }
     }
     const bool isDensityMat = states[0]->is_density_matrix();
@@ -717,7 +929,7 @@ evolveBatched(const std::vector<sum_op<cudaq::matrix_handler>> &hamiltonians,
       integrator.setState(cudaq::state(batchedState.release()), 0.0);
       auto results =
           evolveBatchedImpl(dims, schedule, states.size(), integrator,
-                            observables, store_intermediate_results);
+                            observables, store_intermediate_results, sink, i);
       assert(results.size() == states.size());
       allResults.insert(allResults.end(),
                         std::make_move_iterator(results.begin()),
@@ -728,11 +940,11 @@ evolveBatched(const std::vector<sum_op<cudaq::matrix_handler>> &hamiltonians,
       state canonicalize_initial_state = [&]() {
         if (isMasterEquation && !states[0]->is_density_matrix())
           return state(new CuDensityMatState(states[0]->to_density_matrix()));
-        return initial_states[i];
+        return initial_states[members[i].second];
       }();
       integrator.setState(canonicalize_initial_state, 0.0);
       auto result = evolveSingleImpl(dims, schedule, integrator, observables,
-                                     store_intermediate_results);
+                                     store_intermediate_results, sink, i);
       allResults.emplace_back(std::move(result));
     }
   }
@@ -747,15 +959,13 @@ evolveBatched(const std::vector<super_op> &superOps,
               base_integrator &integrator,
               const std::vector<sum_op<cudaq::matrix_handler>> &observables,
               IntermediateResultSave store_intermediate_results,
-              std::optional<int> batch_size) {
+              std::optional<int> batch_size,
+              const evolve_sink &sink) {
   LOG_API_TIME();
   if (superOps.empty()) {
     throw std::runtime_error("No super operators provided for evolution.");
   }
-  if (initial_states.size() != superOps.size()) {
-    throw std::runtime_error(
-        "Number of initial states must match number of super operators.");
-  }
+  const auto members = getBatchMembers(superOps.size(), initial_states.size());
 
   cudensitymatHandle_t handle =
       dynamics::Context::getCurrentContext()->getHandle();
@@ -781,15 +991,7 @@ evolveBatched(const std::vector<super_op> &superOps,
     }
   }
 
-  const auto batchSizeToRun =
-      canBeBatched
-          ? std::min<int>(batch_size.value_or(superOps.size()), superOps.size())
-          : 1;
-  assert(batchSizeToRun <= superOps.size());
-  std::unordered_map<std::string, std::complex<double>> params;
-  for (const auto &param : schedule.get_parameters()) {
-    params[param] = schedule.get_value_function()(param, 0.0);
-  }
+  const auto params = schedule.get_parameter_values(0.0);
 
   const bool has_right_apply = [&]() {
     for (const auto &superOp : superOps) {
@@ -800,20 +1002,39 @@ evolveBatched(const std::vector<super_op> &superOps,
     }
     return false;
   }();
+  // Unless the batch size is specified, run as many members at once as fit
+  // in device memory.
+  std::size_t batchSizeToRun = 1;
+  if (canBeBatched && batch_size.has_value()) {
+    batchSizeToRun = std::min<std::size_t>(batch_size.value(), members.size());
+  } else if (canBeBatched) {
+    const bool isDensityMatrix =
+        has_right_apply ||
+        asCudmState(const_cast<state &>(initial_states[0]))
+            ->is_density_matrix();
+    batchSizeToRun = std::min(
+        members.size(),
+        maxBatchSizeInDeviceMemory(
+            dims, isDensityMatrix,
+            getNumStoredStates(schedule, store_intermediate_results)));
+  }
+  assert(batchSizeToRun <= members.size());
   // Run batched evolution up to the batch size and concatenate the results.
   std::vector<evolve_result> allResults;
-  allResults.reserve(superOps.size());
-  // Split the input states into batches up to batchSizeToRun
-  for (std::size_t i = 0; i < superOps.size(); i += batchSizeToRun) {
+  allResults.reserve(members.size());
+  // Split the batch members into batches up to batchSizeToRun
+  for (std::size_t i = 0; i < members.size(); i += batchSizeToRun) {
     std::vector<CuDensityMatState *> states;
     states.reserve(batchSizeToRun);
     std::vector<super_op> batchSuperOps;
     batchSuperOps.reserve(batchSizeToRun);
 
-    for (std::size_t j = i; j < i + batchSizeToRun && j < superOps.size();
+    for (std::size_t j = i; j < i + batchSizeToRun && j < members.size();
          ++j) {
-      states.emplace_back(asCudmState(const_cast<state &>(initial_states[j])));
-      batchSuperOps.emplace_back(superOps[j]);
+      const auto [opIdx, stateIdx] = members[j];
+      states.emplace_back(
+          asCudmState(const_cast<state &>(initial_states[stateIdx])));
+      batchSuperOps.emplace_back(superOps[opIdx]);
     }
     const bool isDensityMat = states[0]->is_density_matrix();
     const bool sameStateType = std::all_of(
@@ -836,7 +1057,7 @@ evolveBatched(const std::vector<super_op> &superOps,
       integrator.setState(cudaq::state(batchedState.release()), 0.0);
       auto results =
           evolveBatchedImpl(dims, schedule, states.size(), integrator,
-                            observables, store_intermediate_results);
+                            observables, store_intermediate_results, sink, i);
       assert(results.size() == states.size());
       allResults.insert(allResults.end(),
                         std::make_move_iterator(results.begin()),
@@ -848,12 +1069,12 @@ evolveBatched(const std::vector<super_op> &superOps,
       state canonicalize_initial_state = [&]() {
         if (has_right_apply && !states[0]->is_density_matrix())
           return state(new CuDensityMatState(states[0]->to_density_matrix()));
-        return initial_states[i];
+        return initial_states[members[i].second];
       }();
 
       integrator.setState(canonicalize_initial_state, 0.0);
       auto result = evolveSingleImpl(dims, schedule, integrator, observables,
-                                     store_intermediate_results);
+                                     store_intermediate_results, sink, i);
       allResults.emplace_back(std::move(result));
     }
   }
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CuDensityMatEvolveSink.h"
+#include "CuDensityMatErrorHandling.h"
+#include "CuDensityMatState.h"
+#include <algorithm>
+
+namespace cudaq::dynamics {
+EvolveSinkPipeline::EvolveSinkPipeline(evolve_sink sink,
+                                       std::size_t maxPending)
+    : m_sink(std::move(sink)),
+      m_maxPending(std::max<std::size_t>(1, maxPending)) {
+  HANDLE_CUDA_ERROR(cudaGetDevice(&m_deviceId));
+  // Non-blocking, so that the copies do not synchronize with the default
+  // stream used by the integration.
+  HANDLE_CUDA_ERROR(
+      cudaStreamCreateWithFlags(&m_stream, cudaStreamNonBlocking));
+  m_worker = std::thread([this]() { run(); });
+}
+
+EvolveSinkPipeline::~EvolveSinkPipeline() {
+  stop();
+  for (auto &[buffer, size] : m_freeBuffers)
+    cudaFreeHost(buffer);
+  cudaStreamDestroy(m_stream);
+}
+
+void EvolveSinkPipeline::push(std::size_t batchIdx, std::size_t stepIdx,
+                              double time, cudaq::state state,
+                              std::vector<double> expectationValues) {
+  std::unique_lock lock(m_mutex);
+  m_condition.wait(lock, [&]() { return m_numPending < m_maxPending; });
+  if (m_error)
+    return;
+
+  auto *cudmState = dynamic_cast<CuDensityMatState *>(
+      cudaq::state_helper::getSimulationState(&state));
+  if (!cudmState)
+    throw std::runtime_error("Invalid state.");
+  const auto size = cudmState->getLocalSize();
+  std::complex<double> *hostData = nullptr;
+  auto iter = std::find_if(m_freeBuffers.begin(), m_freeBuffers.end(),
+                           [size](const auto &buffer) {
+                             return buffer.second >= size;
+                           });
+  if (iter != m_freeBuffers.end()) {
+    hostData = iter->first;
+    m_freeBuffers.erase(iter);
+  } else {
+    HANDLE_CUDA_ERROR(
+        cudaMallocHost(&hostData, size * sizeof(std::complex<double>)));
+  }
+
+  // Order the copy after the computation of the state on the default stream.
+  cudaEvent_t computed, copied;
+  HANDLE_CUDA_ERROR(
+      cudaEventCreateWithFlags(&computed, cudaEventDisableTiming));
+  HANDLE_CUDA_ERROR(cudaEventCreateWithFlags(&copied, cudaEventDisableTiming));
+  HANDLE_CUDA_ERROR(cudaEventRecord(computed, 0));
+  HANDLE_CUDA_ERROR(cudaStreamWaitEvent(m_stream, computed, 0));
+  HANDLE_CUDA_ERROR(cudaMemcpyAsync(hostData, cudmState->get_device_pointer(),
+                                    size * sizeof(std::complex<double>),
+                                    cudaMemcpyDeviceToHost, m_stream));
+  HANDLE_CUDA_ERROR(cudaEventRecord(copied, m_stream));
+  HANDLE_CUDA_ERROR(cudaEventDestroy(computed));
+
+  evolve_step_result result;
+  result.batch_index = batchIdx;
+  result.step_index = stepIdx;
+  result.time = time;
+  result.expectation_values = std::move(expectationValues);
+  m_queue.push_back(PendingStep{std::move(result), std::move(state), hostData,
+                                size, copied});
+  ++m_numPending;
+  m_condition.notify_all();
+}
+
+void EvolveSinkPipeline::run() {
+  cudaSetDevice(m_deviceId);
+  std::unique_lock lock(m_mutex);
+  while (true) {
+    m_condition.wait(lock, [&]() { return m_stopping || !m_queue.empty(); });
+    if (m_queue.empty())
+      return;
+    auto step = std::move(m_queue.front());
+    m_queue.pop_front();
+    lock.unlock();
+
+    std::exception_ptr error;
+    try {
+      HANDLE_CUDA_ERROR(cudaEventSynchronize(step.copied));
+      step.result.state.assign(step.hostData, step.hostData + step.size);
+      // The device data is no longer needed.
+      step.state.reset();
+      if (m_sink)
+        m_sink(step.result);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    cudaEventDestroy(step.copied);
+
+    lock.lock();
+    m_freeBuffers.emplace_back(step.hostData, step.size);
+    if (error && !m_error)
+      m_error = error;
+    --m_numPending;
+    m_condition.notify_all();
+  }
+}
+
+void EvolveSinkPipeline::stop() {
+  {
+    std::scoped_lock lock(m_mutex);
+    if (m_stopping)
+      return;
+    m_stopping = true;
+  }
+  m_condition.notify_all();
+  if (m_worker.joinable())
+    m_worker.join();
+}
+
+void EvolveSinkPipeline::finish() {
+  stop();
+  if (m_error)
+    std::rethrow_exception(m_error);
+}
+} // namespace cudaq::dynamics
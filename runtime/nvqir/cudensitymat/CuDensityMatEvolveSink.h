@@ -0,0 +1,72 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/EvolveResult.h"
+#include <condition_variable>
+#include <cuda_runtime.h>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace cudaq::dynamics {
+/// @brief Delivers the results of the steps of an evolution to an
+/// `evolve_sink` without blocking the integration.
+// The state data is copied to pinned host memory on a dedicated stream, after
+// the work already submitted to the default stream, and the sink is called
+// from a worker thread once the copy is complete. At most `maxPending` steps
+// are in flight: their device states are only released after their copy.
+class EvolveSinkPipeline {
+public:
+  EvolveSinkPipeline(evolve_sink sink, std::size_t maxPending = 4);
+  EvolveSinkPipeline(const EvolveSinkPipeline &) = delete;
+  EvolveSinkPipeline &operator=(const EvolveSinkPipeline &) = delete;
+  ~EvolveSinkPipeline();
+
+  /// @brief Queue the results of a step for the sink.
+  // The state must not be modified after this call; the integrators return new
+  // states from `getState`.
+  void push(std::size_t batchIdx, std::size_t stepIdx, double time,
+            cudaq::state state, std::vector<double> expectationValues);
+
+  /// @brief Wait until all queued results have been delivered to the sink.
+  // Rethrows the first exception thrown by the sink.
+  void finish();
+
+private:
+  struct PendingStep {
+    evolve_step_result result;
+    // Keeps the device data alive until it has been copied.
+    std::optional<cudaq::state> state;
+    std::complex<double> *hostData;
+    std::size_t size;
+    cudaEvent_t copied;
+  };
+
+  void run();
+  void stop();
+
+  evolve_sink m_sink;
+  std::size_t m_maxPending;
+  int m_deviceId;
+  cudaStream_t m_stream{nullptr};
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<PendingStep> m_queue;
+  // Number of queued steps and of the step being delivered, if any.
+  std::size_t m_numPending = 0;
+  // Pinned host buffers, and their sizes, reused by the next copies.
+  std::vector<std::pair<std::complex<double> *, std::size_t>> m_freeBuffers;
+  std::exception_ptr m_error;
+  bool m_stopping = false;
+  std::thread m_worker;
+};
+} // namespace cudaq::dynamics
@@ -11,6 +11,7 @@
 #include "CuDensityMatErrorHandling.h"
 #include "CuDensityMatUtils.h"
 #include "common/Logger.h"
+#include <algorithm>
 namespace cudaq {
 CuDensityMatExpectation::CuDensityMatExpectation(cudensitymatHandle_t handle,
                                                  cudensitymatOperator_t op)
@@ -67,4 +68,96 @@ CuDensityMatExpectation::compute(cudensitymatState_t state, double time,
   cudaq::dynamics::destroyArrayGpu(expectationValue_d);
   return result;
 }
+
+CuDensityMatFusedExpectation::CuDensityMatFusedExpectation(
+    cudensitymatHandle_t handle, const std::vector<cudensitymatOperator_t> &ops)
+    : m_handle(handle) {
+  m_expectations.reserve(ops.size());
+  for (auto op : ops) {
+    cudensitymatExpectation_t expectation;
+    HANDLE_CUDM_ERROR(
+        cudensitymatCreateExpectation(m_handle, op, &expectation));
+    m_expectations.emplace_back(expectation);
+  }
+  HANDLE_CUDM_ERROR(cudensitymatCreateWorkspace(m_handle, &m_workspace));
+}
+
+CuDensityMatFusedExpectation::~CuDensityMatFusedExpectation() {
+  if (m_expectationValues_d)
+    cudaq::dynamics::destroyArrayGpu(m_expectationValues_d);
+  if (m_workspace)
+    cudensitymatDestroyWorkspace(m_workspace);
+  for (auto expectation : m_expectations)
+    cudensitymatDestroyExpectation(expectation);
+}
+
+void CuDensityMatFusedExpectation::prepare(cudensitymatState_t state) {
+  // The workspace descriptor holds the requirement of the last preparation,
+  // keep the largest one so that the shared buffer fits all the expectations.
+  m_scratchSize = 0;
+  for (auto expectation : m_expectations) {
+    HANDLE_CUDM_ERROR(cudensitymatExpectationPrepare(
+        m_handle, expectation, state, CUDENSITYMAT_COMPUTE_64F,
+        dynamics::Context::getRecommendedWorkSpaceLimit(), m_workspace, 0x0));
+    std::size_t requiredBufferSize = 0;
+    HANDLE_CUDM_ERROR(cudensitymatWorkspaceGetMemorySize(
+        m_handle, m_workspace, CUDENSITYMAT_MEMSPACE_DEVICE,
+        CUDENSITYMAT_WORKSPACE_SCRATCH, &requiredBufferSize));
+    m_scratchSize = std::max(m_scratchSize, requiredBufferSize);
+  }
+  m_prepared = true;
+}
+
+std::vector<std::vector<std::complex<double>>>
+CuDensityMatFusedExpectation::compute(cudensitymatState_t state, double time,
+                                      int64_t batchSize) {
+  if (m_expectations.empty())
+    return {};
+  if (!m_prepared)
+    prepare(state);
+
+  if (m_scratchSize > 0) {
+    void *workspaceBuffer =
+        dynamics::Context::getCurrentContext()->getScratchSpace(m_scratchSize);
+    HANDLE_CUDM_ERROR(cudensitymatWorkspaceSetMemory(
+        m_handle, m_workspace, CUDENSITYMAT_MEMSPACE_DEVICE,
+        CUDENSITYMAT_WORKSPACE_SCRATCH, workspaceBuffer, m_scratchSize));
+  }
+
+  // One slot per observable and batch member, reused across calls.
+  const std::size_t numValues = m_expectations.size() * batchSize;
+  if (numValues > m_bufferSize) {
+    if (m_expectationValues_d)
+      cudaq::dynamics::destroyArrayGpu(m_expectationValues_d);
+    m_expectationValues_d = cudaq::dynamics::createArrayGpu(
+        std::vector<std::complex<double>>(numValues, {0.0, 0.0}));
+    m_bufferSize = numValues;
+  } else {
+    HANDLE_CUDA_ERROR(cudaMemsetAsync(m_expectationValues_d, 0,
+                                      numValues * sizeof(std::complex<double>),
+                                      0x0));
+  }
+
+  {
+    cudaq::dynamics::PerfMetricScopeTimer metricTimer(
+        "cudensitymatExpectationCompute");
+    auto *expectationValues_d =
+        static_cast<std::complex<double> *>(m_expectationValues_d);
+    for (std::size_t i = 0; i < m_expectations.size(); ++i)
+      HANDLE_CUDM_ERROR(cudensitymatExpectationCompute(
+          m_handle, m_expectations[i], time, batchSize, 0, nullptr, state,
+          expectationValues_d + i * batchSize, m_workspace, 0x0));
+  }
+
+  std::vector<std::complex<double>> values(numValues);
+  HANDLE_CUDA_ERROR(cudaMemcpy(values.data(), m_expectationValues_d,
+                               numValues * sizeof(std::complex<double>),
+                               cudaMemcpyDefault));
+  std::vector<std::vector<std::complex<double>>> result;
+  result.reserve(m_expectations.size());
+  for (std::size_t i = 0; i < m_expectations.size(); ++i)
+    result.emplace_back(values.begin() + i * batchSize,
+                        values.begin() + (i + 1) * batchSize);
+  return result;
+}
 } // namespace cudaq
@@ -46,4 +46,55 @@ public:
                                             double time, int64_t batchSize);
 };
 
+/// @brief Expectation values of several observables, evaluated together.
+// All the expectations share a single workspace, sized for the most demanding
+// of them, and are computed on the same stream into a single device buffer,
+// which is copied to the host once per call to `compute`.
+class CuDensityMatFusedExpectation {
+  cudensitymatHandle_t m_handle{nullptr};
+  std::vector<cudensitymatExpectation_t> m_expectations;
+  cudensitymatWorkspaceDescriptor_t m_workspace{nullptr};
+  std::size_t m_scratchSize = 0;
+  bool m_prepared = false;
+  void *m_expectationValues_d = nullptr;
+  std::size_t m_bufferSize = 0;
+
+public:
+  CuDensityMatFusedExpectation(cudensitymatHandle_t handle,
+                               const std::vector<cudensitymatOperator_t> &ops);
+  /// @brief Deleted copy constructor
+  CuDensityMatFusedExpectation(const CuDensityMatFusedExpectation &) = delete;
+  /// @brief Deleted copy assignment
+  CuDensityMatFusedExpectation &
+  operator=(const CuDensityMatFusedExpectation &) = delete;
+  CuDensityMatFusedExpectation(CuDensityMatFusedExpectation &&src) {
+    std::swap(m_handle, src.m_handle);
+    std::swap(m_expectations, src.m_expectations);
+    std::swap(m_workspace, src.m_workspace);
+    std::swap(m_scratchSize, src.m_scratchSize);
+    std::swap(m_prepared, src.m_prepared);
+    std::swap(m_expectationValues_d, src.m_expectationValues_d);
+    std::swap(m_bufferSize, src.m_bufferSize);
+  }
+  ~CuDensityMatFusedExpectation();
+  /// @brief Prepare all the expectation operators for computation
+  /// @param state The state to compute the expectation values
+  void prepare(cudensitymatState_t state);
+
+  /// @brief Compute the expectation values of all the observables
+  // The expectations are prepared on the first call if `prepare` was not
+  // called before, the shape of the state must not change afterwards.
+  /// @param state The state to compute the expectation values (could be a
+  /// batched state)
+  /// @param time The time at which the expectation values are computed
+  /// @param batchSize The batched size of the input state
+  /// @return The expectation values, indexed by observable then by batch
+  /// member
+  std::vector<std::vector<std::complex<double>>>
+  compute(cudensitymatState_t state, double time, int64_t batchSize);
+
+  /// @brief Number of observables
+  std::size_t size() const { return m_expectations.size(); }
+};
+
 } // namespace cudaq
@@ -10,8 +10,10 @@
 #include "BatchingUtils.h"
 #include "CuDensityMatErrorHandling.h"
 #include "CuDensityMatUtils.h"
+#include "common/Environment.h"
 #include "common/FmtCore.h"
 #include "common/Logger.h"
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <ranges>
@@ -136,11 +138,15 @@ cudaq::dynamics::CuDensityMatOpConverter::CuDensityMatOpConverter(
       m_maxDiagonalsDiag = maxDiags.value();
     }
   }
+
+  m_cacheOperators = getEnvBool("CUDAQ_DYNAMICS_CACHE_OPERATORS", true);
+  m_deviceCallbacks = getEnvBool("CUDAQ_DYNAMICS_DEVICE_CALLBACKS", true);
 }
 
 void cudaq::dynamics::CuDensityMatOpConverter::clearCallbackContext() {
   m_scalarCallbacks.clear();
   m_tensorCallbacks.clear();
+  m_deviceScalarCallbacks.clear();
 }
 
 cudaq::dynamics::CuDensityMatOpConverter::~CuDensityMatOpConverter() {
@@ -228,8 +234,39 @@ cudaq::dynamics::CuDensityMatOpConverter::createElementaryOperator(
     return false;
   }();
 
+  // The tensor of a callback is updated at every evaluation, while the
+  // matrices of the other operators only depend on their dimensions, or on
+  // the parameters at the time of the conversion for operators that do not
+  // require them.
+  const bool isCallback = !parameters.empty() && isCallbackTensor;
+  std::string cacheKey;
+  if (m_cacheOperators && !isCallback &&
+      std::none_of(elemOps.begin(), elemOps.end(), [](const auto &op) {
+        return op.is_time_dependent();
+      })) {
+    bool allKnown = true;
+    for (const auto &elemOp : elemOps) {
+      const auto opName = elemOp.to_string(false);
+      allKnown &= std::find(g_knownNonParametricOps.begin(),
+                            g_knownNonParametricOps.end(),
+                            opName) != g_knownNonParametricOps.end();
+      cacheKey += opName + ";";
+    }
+    for (auto extent : subspaceExtents)
+      cacheKey += "|" + std::to_string(extent);
+    if (!allKnown) {
+      const std::map<std::string, std::complex<double>> sortedParameters(
+          parameters.begin(), parameters.end());
+      for (const auto &[name, value] : sortedParameters)
+        cacheKey += fmt::format("|{}={},{}", name, value.real(), value.imag());
+    }
+    auto iter = m_elementaryOperatorCache.find(cacheKey);
+    if (iter != m_elementaryOperatorCache.end())
+      return iter->second;
+  }
+
   // This is a callback
-  if (!parameters.empty() && isCallbackTensor) {
+  if (isCallback) {
     const std::map<std::string, std::complex<double>> sortedParameters(
         parameters.begin(), parameters.end());
     auto ks = std::views::keys(sortedParameters);
@@ -317,6 +354,8 @@ cudaq::dynamics::CuDensityMatOpConverter::createElementaryOperator(
   }
   m_elementaryOperators.emplace(cudmElemOp);
   m_deviceBuffers.emplace(elementaryMat_d);
+  if (!cacheKey.empty())
+    m_elementaryOperatorCache.emplace(cacheKey, cudmElemOp);
   return cudmElemOp;
 }
 
@@ -326,6 +365,28 @@ cudaq::dynamics::CuDensityMatOpConverter::createProductOperatorTerm(
     const std::vector<int64_t> &modeExtents,
     const std::vector<std::vector<std::size_t>> &degrees,
     const std::vector<std::vector<int>> &dualModalities) {
+  // A term made of cached elementary operators can be reused as is. Other
+  // elementary operators are never reused, so neither are their terms.
+  std::string cacheKey;
+  if (m_cacheOperators &&
+      std::all_of(elemOps.begin(), elemOps.end(), [&](auto elemOp) {
+        return std::any_of(
+            m_elementaryOperatorCache.begin(), m_elementaryOperatorCache.end(),
+            [&](const auto &entry) { return entry.second == elemOp; });
+      })) {
+    for (std::size_t i = 0; i < elemOps.size(); ++i) {
+      cacheKey += fmt::format("{};", static_cast<void *>(elemOps[i]));
+      if (i < degrees.size())
+        cacheKey += fmt::format("{}", fmt::join(degrees[i], ","));
+      if (i < dualModalities.size())
+        cacheKey += fmt::format("/{}", fmt::join(dualModalities[i], ","));
+      cacheKey += "|";
+    }
+    cacheKey += fmt::format("{}", fmt::join(modeExtents, ","));
+    auto iter = m_operatorTermCache.find(cacheKey);
+    if (iter != m_operatorTermCache.end())
+      return iter->second;
+  }
 
   cudensitymatOperatorTerm_t term;
   HANDLE_CUDM_ERROR(cudensitymatCreateOperatorTerm(
@@ -377,6 +438,8 @@ cudaq::dynamics::CuDensityMatOpConverter::createProductOperatorTerm(
       allDegrees.data(), allModeActionDuality.data(),
       make_cuDoubleComplex(1.0, 0.0), cudensitymatScalarCallbackNone,
       cudensitymatScalarGradientCallbackNone));
+  if (!cacheKey.empty())
+    m_operatorTermCache.emplace(cacheKey, term);
   return term;
 }
 
@@ -8,10 +8,12 @@
 
 #pragma once
 
+#include "CuDensityMatTimeFunction.h"
 #include "cudaq/operators.h"
 #include "cudaq/operators/matrix.h"
 #include <cudensitymat.h>
 #include <deque>
+#include <optional>
 #include <unordered_set>
 
 namespace cudaq::dynamics {
@@ -118,6 +120,11 @@ private:
   cudensitymatWrappedScalarCallback_t
   wrapScalarCallback(const std::vector<scalar_operator> &scalarOps,
                      const std::vector<std::string> &paramNames);
+  // A callback evaluated on the device, if all the coefficients are constants
+  // or closed-form functions of the parameters.
+  std::optional<cudensitymatWrappedScalarCallback_t>
+  wrapDeviceScalarCallback(const std::vector<scalar_operator> &scalarOps,
+                           const std::vector<std::string> &paramNames);
   cudensitymatWrappedTensorCallback_t
   wrapTensorCallback(const std::vector<matrix_handler> &matrixOps,
                      const std::vector<std::string> &paramNames,
@@ -148,7 +155,19 @@ private:
   std::unordered_set<cudensitymatOperatorTerm_t> m_operatorTerms;
   std::deque<ScalarCallBackContext> m_scalarCallbacks;
   std::deque<TensorCallBackContext> m_tensorCallbacks;
+  std::deque<DeviceTimeFunctions> m_deviceScalarCallbacks;
+  bool m_deviceCallbacks = true;
   int m_minDimensionDiag = 4;
   int m_maxDiagonalsDiag = 1;
+  // Elementary operators whose tensors do not depend on the time, and the
+  // product terms made of them, keyed on their structure and dimensions. They
+  // are reused by the next conversions, e.g., by every `evolve` call of a
+  // parameter sweep, which only re-attaches the coefficients and their
+  // callbacks to new operators.
+  bool m_cacheOperators = true;
+  std::unordered_map<std::string, cudensitymatElementaryOperator_t>
+      m_elementaryOperatorCache;
+  std::unordered_map<std::string, cudensitymatOperatorTerm_t>
+      m_operatorTermCache;
 };
 } // namespace cudaq::dynamics
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CuDensityMatOperatorAction.h"
+#include "CuDensityMatContext.h"
+#include "CuDensityMatErrorHandling.h"
+#include "CuDensityMatUtils.h"
+#include "common/FmtCore.h"
+#include <map>
+
+namespace cudaq {
+CuDensityMatOperatorAction::CuDensityMatOperatorAction(
+    cudensitymatHandle_t handle, cudensitymatOperator_t op)
+    : m_handle(handle), m_op(op) {
+  HANDLE_CUDM_ERROR(cudensitymatCreateWorkspace(m_handle, &m_workspace));
+}
+
+CuDensityMatOperatorAction::~CuDensityMatOperatorAction() {
+  if (m_workspace)
+    cudensitymatDestroyWorkspace(m_workspace);
+  if (m_params)
+    cudaq::dynamics::destroyArrayGpu(m_params);
+}
+
+void CuDensityMatOperatorAction::compute(
+    const CuDensityMatState &inputState, CuDensityMatState &outputState,
+    double time,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool synchronize) {
+  const auto size = inputState.getLocalSize();
+  const int64_t batchSize = inputState.getBatchSize();
+  if (outputState.getLocalSize() != size ||
+      outputState.getBatchSize() != static_cast<std::size_t>(batchSize))
+    throw std::invalid_argument(
+        fmt::format("Operator action requires an output state of size {} and "
+                    "batch size {}, got size {} and batch size {}.",
+                    size, batchSize, outputState.getLocalSize(),
+                    outputState.getBatchSize()));
+
+  if (size != m_preparedSize || batchSize != m_preparedBatchSize) {
+    cudaq::dynamics::PerfMetricScopeTimer metricTimer(
+        "cudensitymatOperatorPrepareAction");
+    HANDLE_CUDM_ERROR(cudensitymatOperatorPrepareAction(
+        m_handle, m_op, inputState.get_impl(), outputState.get_impl(),
+        CUDENSITYMAT_COMPUTE_64F,
+        dynamics::Context::getRecommendedWorkSpaceLimit(), m_workspace, 0x0));
+    HANDLE_CUDM_ERROR(cudensitymatWorkspaceGetMemorySize(
+        m_handle, m_workspace, CUDENSITYMAT_MEMSPACE_DEVICE,
+        CUDENSITYMAT_WORKSPACE_SCRATCH, &m_scratchSize));
+    m_preparedSize = size;
+    m_preparedBatchSize = batchSize;
+  }
+
+  // The scratch space is shared with the other computations of the context,
+  // which may have moved it since the last call.
+  if (m_scratchSize > 0)
+    HANDLE_CUDM_ERROR(cudensitymatWorkspaceSetMemory(
+        m_handle, m_workspace, CUDENSITYMAT_MEMSPACE_DEVICE,
+        CUDENSITYMAT_WORKSPACE_SCRATCH,
+        dynamics::Context::getCurrentContext()->getScratchSpace(m_scratchSize),
+        m_scratchSize));
+
+  // The parameters are passed in the order of their names, as an F-order 2d
+  // array of real values: params[numParams, batchSize].
+  std::map<std::string, std::complex<double>> sortedParameters(
+      parameters.begin(), parameters.end());
+  const auto numComplexParams = sortedParameters.size();
+  if (numComplexParams > 0) {
+    std::vector<std::complex<double>> paramValues;
+    paramValues.reserve(numComplexParams * batchSize);
+    for (int64_t i = 0; i < batchSize; ++i)
+      for (const auto &[name, value] : sortedParameters)
+        paramValues.emplace_back(value);
+    if (paramValues.size() > m_paramsCapacity) {
+      if (m_params)
+        cudaq::dynamics::destroyArrayGpu(m_params);
+      m_params =
+          static_cast<double *>(cudaq::dynamics::createArrayGpu(paramValues));
+      m_paramsCapacity = paramValues.size();
+    } else {
+      // The copy from pageable memory is staged before the call returns, and
+      // is ordered after the previous computations on the stream.
+      HANDLE_CUDA_ERROR(cudaMemcpyAsync(
+          m_params, paramValues.data(),
+          paramValues.size() * sizeof(std::complex<double>),
+          cudaMemcpyHostToDevice, 0x0));
+    }
+  }
+  {
+    cudaq::dynamics::PerfMetricScopeTimer metricTimer(
+        "cudensitymatOperatorComputeAction");
+    HANDLE_CUDM_ERROR(cudensitymatOperatorComputeAction(
+        m_handle, m_op, time, batchSize, numComplexParams * 2,
+        numComplexParams > 0 ? m_params : nullptr, inputState.get_impl(),
+        outputState.get_impl(), m_workspace, 0x0));
+    if (synchronize)
+      HANDLE_CUDA_ERROR(cudaDeviceSynchronize());
+  }
+}
+} // namespace cudaq
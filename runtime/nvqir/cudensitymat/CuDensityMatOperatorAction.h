@@ -0,0 +1,72 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "CuDensityMatState.h"
+#include <complex>
+#include <cudensitymat.h>
+#include <string>
+#include <unordered_map>
+
+namespace cudaq {
+
+/// @brief The action of an operator on a (batched) state, without forming the
+/// matrix of the operator.
+// The action is prepared for the shape of the first states it is computed on,
+// and its workspace is reused by the following computations on states of the
+// same shape, e.g., by the successive iterations of an iterative solver.
+class CuDensityMatOperatorAction {
+  cudensitymatHandle_t m_handle{nullptr};
+  cudensitymatOperator_t m_op{nullptr};
+  cudensitymatWorkspaceDescriptor_t m_workspace{nullptr};
+  std::size_t m_scratchSize = 0;
+  // The size and batch size of the states the action is prepared for.
+  std::size_t m_preparedSize = 0;
+  int64_t m_preparedBatchSize = 0;
+  // The device buffer of the parameter values, reused by the following
+  // computations with as many values.
+  double *m_params{nullptr};
+  std::size_t m_paramsCapacity = 0;
+
+public:
+  CuDensityMatOperatorAction(cudensitymatHandle_t handle,
+                             cudensitymatOperator_t op);
+  /// @brief Deleted copy constructor
+  CuDensityMatOperatorAction(const CuDensityMatOperatorAction &) = delete;
+  /// @brief Deleted copy assignment
+  CuDensityMatOperatorAction &
+  operator=(const CuDensityMatOperatorAction &) = delete;
+  CuDensityMatOperatorAction(CuDensityMatOperatorAction &&src) {
+    std::swap(m_handle, src.m_handle);
+    std::swap(m_op, src.m_op);
+    std::swap(m_workspace, src.m_workspace);
+    std::swap(m_scratchSize, src.m_scratchSize);
+    std::swap(m_preparedSize, src.m_preparedSize);
+    std::swap(m_preparedBatchSize, src.m_preparedBatchSize);
+    std::swap(m_params, src.m_params);
+    std::swap(m_paramsCapacity, src.m_paramsCapacity);
+  }
+  ~CuDensityMatOperatorAction();
+
+  /// @brief Add the action of the operator on `inputState` to `outputState`
+  /// @param inputState The (batched) state the operator acts on
+  /// @param outputState The state the result is accumulated in, of the same
+  /// shape as `inputState`
+  /// @param time The time at which the operator is evaluated
+  /// @param parameters The values of the parameters of the operator
+  /// @param synchronize If false, the computation is only enqueued on the
+  /// default stream, and the caller orders its use of `outputState` after it
+  void compute(const CuDensityMatState &inputState,
+               CuDensityMatState &outputState, double time,
+               const std::unordered_map<std::string, std::complex<double>>
+                   &parameters,
+               bool synchronize = true);
+};
+
+} // namespace cudaq
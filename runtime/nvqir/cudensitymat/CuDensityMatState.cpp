@@ -200,6 +200,22 @@ void CuDensityMatState::toHost(std::complex<float> *userData,
       "double-precision array.");
 }
 
+void CuDensityMatState::toHostRange(std::complex<double> *userData,
+                                    std::size_t offset,
+                                    std::size_t numElements) const {
+  if (offset > dimension || numElements > dimension - offset)
+    throw std::runtime_error(
+        fmt::format("Invalid range of {} elements from {} requested from a "
+                    "state of {} elements.",
+                    numElements, offset, dimension));
+
+  HANDLE_CUDA_ERROR(
+      cudaMemcpy(userData, static_cast<std::complex<double> *>(devicePtr) +
+                               offset,
+                 numElements * sizeof(std::complex<double>),
+                 cudaMemcpyDeviceToHost));
+}
+
 // Free the device data.
 void CuDensityMatState::destroyState() {
   if (cudmState) {
@@ -228,6 +244,37 @@ calculate_density_matrix_size(const std::vector<int64_t> &hilbertSpaceDims) {
   return vectorSize * vectorSize;
 }
 
+// The offset of the slice of a distributed state that is stored on this device
+// within the elements of the whole state.
+static int64_t getLocalStorageOffset(cudensitymatHandle_t handle,
+                                     cudensitymatState_t state) {
+  int32_t numComponents = 0;
+  HANDLE_CUDM_ERROR(
+      cudensitymatStateGetNumComponents(handle, state, &numComponents));
+  assert(numComponents == 1);
+  int32_t numModes{0};
+  int32_t stateComponentGlobalId{-1};
+  int32_t batchModeLocation{-1};
+  HANDLE_CUDM_ERROR(cudensitymatStateGetComponentNumModes(
+      handle, state, /*stateComponentLocalId=*/0, &stateComponentGlobalId,
+      &numModes, &batchModeLocation));
+  std::vector<int64_t> stateComponentModeExtents(numModes);
+  std::vector<int64_t> stateComponentModeOffsets(numModes);
+
+  HANDLE_CUDM_ERROR(cudensitymatStateGetComponentInfo(
+      handle, state, /*stateComponentLocalId=*/0, &stateComponentGlobalId,
+      &numModes, stateComponentModeExtents.data(),
+      stateComponentModeOffsets.data()));
+
+  int64_t startIdx = 0;
+  int64_t accumulatedIdx = 1;
+  for (int32_t i = 0; i < numModes; ++i) {
+    accumulatedIdx *= stateComponentModeExtents[i];
+    startIdx += (stateComponentModeOffsets[i] * accumulatedIdx);
+  }
+  return startIdx;
+}
+
 CuDensityMatState::CuDensityMatState(std::size_t size, void *ptr, bool borrowed)
     : devicePtr(ptr), dimension(size), borrowedData(borrowed),
       cudmHandle(dynamics::Context::getCurrentContext()->getHandle()) {
@@ -396,6 +443,47 @@ CuDensityMatState::clone(const CuDensityMatState &other) {
   return std::unique_ptr<CuDensityMatState>(state);
 }
 
+bool CuDensityMatState::isDistributedSlice() const {
+  if (!is_initialized() || batchSize != 1)
+    return false;
+  const std::size_t stateSize =
+      isDensityMatrix ? calculate_density_matrix_size(hilbertSpaceDims)
+                      : calculate_state_vector_size(hilbertSpaceDims);
+  return dimension < stateSize;
+}
+
+std::unique_ptr<CuDensityMatState>
+CuDensityMatState::gatherToRoot(const CuDensityMatState &distributedState) {
+  if (!distributedState.isDistributedSlice())
+    throw std::invalid_argument(
+        "Only a state distributed across the ranks can be gathered.");
+  const auto *context = dynamics::Context::getCurrentContext();
+  const std::size_t localSize = distributedState.dimension;
+  const std::size_t stateSize = localSize * context->getNumRanks();
+  std::vector<std::complex<double>> localData(localSize);
+  distributedState.toHost(localData.data(), localSize);
+  const int64_t localOffset = getLocalStorageOffset(
+      distributedState.cudmHandle, distributedState.cudmState);
+  std::vector<std::complex<double>> globalData(
+      context->getRank() == 0 ? stateSize : 0);
+  context->gatherToRoot(localData.data(), localSize, localOffset,
+                        globalData.data());
+  if (context->getRank() != 0)
+    return nullptr;
+
+  auto state = std::make_unique<CuDensityMatState>();
+  state->cudmHandle = distributedState.cudmHandle;
+  state->hilbertSpaceDims = distributedState.hilbertSpaceDims;
+  state->isDensityMatrix = distributedState.isDensityMatrix;
+  state->dimension = stateSize;
+  state->singleStateDimension = stateSize;
+  const std::size_t dataSize = stateSize * sizeof(std::complex<double>);
+  state->devicePtr = cudaq::dynamics::DeviceAllocator::allocate(dataSize);
+  HANDLE_CUDA_ERROR(cudaMemcpy(state->devicePtr, globalData.data(), dataSize,
+                               cudaMemcpyHostToDevice));
+  return state;
+}
+
 CuDensityMatState::CuDensityMatState(CuDensityMatState &&other) noexcept
     : isDensityMatrix(other.isDensityMatrix), dimension(other.dimension),
       devicePtr(other.devicePtr), cudmState(other.cudmState),
@@ -540,31 +628,8 @@ void CuDensityMatState::initialize_cudm(cudensitymatHandle_t handleToSet,
       storageSize / sizeof(std::complex<double>); // quantum state tensor volume
                                                   // (number of elements)
   if (stateVolume < dimension) {
-    int32_t numComponents = 0;
-    HANDLE_CUDM_ERROR(cudensitymatStateGetNumComponents(cudmHandle, cudmState,
-                                                        &numComponents));
-    assert(numComponents == 1);
-    int32_t numModes{0};
-    int32_t stateComponentGlobalId{-1};
-    int32_t batchModeLocation{-1};
-    HANDLE_CUDM_ERROR(cudensitymatStateGetComponentNumModes(
-        cudmHandle, cudmState, /*stateComponentLocalId=*/0,
-        &stateComponentGlobalId, &numModes, &batchModeLocation));
-    std::vector<int64_t> stateComponentModeExtents(numModes);
-    std::vector<int64_t> stateComponentModeOffsets(numModes);
-
-    HANDLE_CUDM_ERROR(cudensitymatStateGetComponentInfo(
-        cudmHandle, cudmState, /*stateComponentLocalId=*/0,
-        &stateComponentGlobalId, &numModes, stateComponentModeExtents.data(),
-        stateComponentModeOffsets.data()));
-
     dimension = stateVolume;
-    int64_t startIdx = 0;
-    int64_t accumulatedIdx = 1;
-    for (int32_t i = 0; i < numModes; ++i) {
-      accumulatedIdx *= stateComponentModeExtents[i];
-      startIdx += (stateComponentModeOffsets[i] * accumulatedIdx);
-    }
+    const int64_t startIdx = getLocalStorageOffset(cudmHandle, cudmState);
     if (startIdx > 0) {
       std::complex<double> *startPtr =
           static_cast<std::complex<double> *>(devicePtr) + startIdx;
@@ -113,6 +113,11 @@ public:
   // Copy the state device data to the user-provided host data pointer.
   void toHost(std::complex<float> *userData,
               std::size_t numElements) const override;
+
+  // Copy a range of the state device data to the user-provided host data
+  // pointer.
+  void toHostRange(std::complex<double> *userData, std::size_t offset,
+                   std::size_t numElements) const override;
   // Free the device data.
   void destroyState() override;
 
@@ -163,6 +168,20 @@ public:
   // Returns the batch size
   std::size_t getBatchSize() const { return batchSize; }
 
+  // Returns the number of elements stored on this device
+  std::size_t getLocalSize() const { return dimension; }
+
+  // Returns true if this is a single state whose elements are distributed
+  // across the ranks, i.e., only a slice of it is stored on this device.
+  bool isDistributedSlice() const;
+
+  // Assemble a distributed state on rank 0.
+  // Returns the whole state on rank 0 and nullptr on the other ranks. The
+  // assembled state holds the results of an evolution, it cannot be evolved
+  // further.
+  static std::unique_ptr<CuDensityMatState>
+  gatherToRoot(const CuDensityMatState &distributedState);
+
   // Initialize a state with cudensitymat
   void initialize_cudm(cudensitymatHandle_t handleToSet,
                        const std::vector<int64_t> &hilbertSpaceDims,
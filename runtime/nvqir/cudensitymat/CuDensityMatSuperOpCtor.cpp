@@ -62,6 +62,9 @@ computeDagger(const cudaq::matrix_handler &op) {
 cudaq::scalar_operator computeDagger(const cudaq::scalar_operator &scalar) {
   if (scalar.is_constant()) {
     return cudaq::scalar_operator(std::conj(scalar.evaluate()));
+  } else if (const auto *function = scalar.get_time_function()) {
+    // Keep the closed form, so that it can be evaluated on the device.
+    return cudaq::scalar_operator(function->conj());
   } else {
     return cudaq::scalar_operator(
         [scalar](
@@ -315,6 +318,25 @@ cudaq::dynamics::CuDensityMatOpConverter::constructLiouvillian(
       liouvillians.emplace_back(ham * std::complex<double>(0.0, -1.0));
     }
     return convertToCudensitymatOperator(parameters, liouvillians, modeExtents);
+  } else if (!isMasterEquation) {
+    // Stochastic unravelling of the master equation: the state vectors of the
+    // trajectories evolve under the non-Hermitian effective Hamiltonian
+    // `H - i/2 sum_k L_k^dag L_k`, i.e., `d|psi>/dt = (-iH - 1/2 sum_k L_k^dag
+    // L_k) |psi>`. The jumps are applied separately.
+    CUDAQ_INFO("Construct quantum trajectory Liouvillian");
+    if (collapseOperators.size() != batchSize)
+      throw std::invalid_argument(
+          "The number of collapse operator vectors must match the number of "
+          "Hamiltonians.");
+    std::vector<sum_op<cudaq::matrix_handler>> liouvillians;
+    liouvillians.reserve(batchSize);
+    for (std::size_t i = 0; i < batchSize; ++i) {
+      auto liouvillian = hamOperators[i] * std::complex<double>(0.0, -1.0);
+      for (const auto &collapseOp : collapseOperators[i])
+        liouvillian += -0.5 * computeDagger(collapseOp) * collapseOp;
+      liouvillians.emplace_back(std::move(liouvillian));
+    }
+    return convertToCudensitymatOperator(parameters, liouvillians, modeExtents);
   } else {
     CUDAQ_INFO("Construct density matrix Liouvillian");
     cudensitymatOperator_t liouvillian;
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CuDensityMatTimeFunction.h"
+#include <stdexcept>
+#include <string>
+#include <thrust/complex.h>
+
+namespace {
+void checkCudaError(cudaError_t error) {
+  if (error != cudaSuccess)
+    throw std::runtime_error(std::string("[dynamics] CUDA error: ") +
+                             cudaGetErrorString(error));
+}
+
+template <typename T>
+T *uploadArray(const std::vector<T> &data) {
+  if (data.empty())
+    return nullptr;
+  T *array = nullptr;
+  checkCudaError(cudaMalloc(&array, data.size() * sizeof(T)));
+  checkCudaError(cudaMemcpy(array, data.data(), data.size() * sizeof(T),
+                            cudaMemcpyHostToDevice));
+  return array;
+}
+
+__device__ thrust::complex<double>
+evaluateFunction(const cudaq::dynamics::DeviceTimeFunction &function,
+                 const double *knots, const thrust::complex<double> *values,
+                 const thrust::complex<double> *secondDerivatives, double x) {
+  thrust::complex<double> value;
+  if (function.kind == 2) {
+    value = sin(function.frequency * x + function.phase);
+  } else {
+    knots += function.firstKnot;
+    values += function.firstKnot;
+    secondDerivatives += function.firstKnot;
+    const int64_t last = function.numKnots - 1;
+    if (x <= knots[0]) {
+      value = values[0];
+    } else if (x >= knots[last]) {
+      value = values[last];
+    } else {
+      // Find the interval `knots[lo] <= x < knots[hi]`.
+      int64_t lo = 0;
+      int64_t hi = last;
+      while (hi - lo > 1) {
+        const int64_t mid = (lo + hi) / 2;
+        if (knots[mid] <= x)
+          lo = mid;
+        else
+          hi = mid;
+      }
+      const double h = knots[hi] - knots[lo];
+      const double a = (knots[hi] - x) / h;
+      const double b = (x - knots[lo]) / h;
+      value = a * values[lo] + b * values[hi];
+      if (function.kind == 1)
+        value += ((a * a * a - a) * secondDerivatives[lo] +
+                  (b * b * b - b) * secondDerivatives[hi]) *
+                 (h * h / 6.0);
+    }
+  }
+  return thrust::complex<double>(function.scale[0], function.scale[1]) *
+             value +
+         thrust::complex<double>(function.offset[0], function.offset[1]);
+}
+
+template <typename T>
+__global__ void
+evaluateFunctionsKernel(const cudaq::dynamics::DeviceTimeFunction *functions,
+                        const double *knots,
+                        const thrust::complex<double> *values,
+                        const thrust::complex<double> *secondDerivatives,
+                        int64_t batchSize, int32_t numParams,
+                        const double *params, thrust::complex<T> *storage) {
+  const int64_t i = blockIdx.x * static_cast<int64_t>(blockDim.x) + threadIdx.x;
+  if (i >= batchSize)
+    return;
+  const auto &function = functions[i];
+  // The parameters are an F-order array `params[numParams, batchSize]` of the
+  // real and imaginary parts of the complex parameters.
+  const double x = params[i * numParams + 2 * function.paramIdx];
+  storage[i] = thrust::complex<T>(
+      evaluateFunction(function, knots, values, secondDerivatives, x));
+}
+} // namespace
+
+cudaq::dynamics::DeviceTimeFunctions::DeviceTimeFunctions(
+    const std::vector<DeviceTimeFunction> &functions,
+    const std::vector<double> &knots, const std::vector<double> &values,
+    const std::vector<double> &secondDerivatives)
+    : m_size(functions.size()), m_functions(uploadArray(functions)),
+      m_knots(uploadArray(knots)), m_values(uploadArray(values)),
+      m_secondDerivatives(uploadArray(secondDerivatives)) {}
+
+cudaq::dynamics::DeviceTimeFunctions::~DeviceTimeFunctions() {
+  cudaFree(m_functions);
+  cudaFree(m_knots);
+  cudaFree(m_values);
+  cudaFree(m_secondDerivatives);
+}
+
+void cudaq::dynamics::DeviceTimeFunctions::evaluate(
+    int64_t batchSize, int32_t numParams, const double *params,
+    cudaDataType_t dataType, void *storage, cudaStream_t stream) const {
+  if (batchSize != static_cast<int64_t>(m_size))
+    throw std::runtime_error(
+        "[Internal Error] Invalid batch size encountered. Expected " +
+        std::to_string(m_size) + " but received " + std::to_string(batchSize) +
+        ".");
+  constexpr int blockSize = 128;
+  const int numBlocks = (batchSize + blockSize - 1) / blockSize;
+  const auto *values =
+      reinterpret_cast<const thrust::complex<double> *>(m_values);
+  const auto *secondDerivatives =
+      reinterpret_cast<const thrust::complex<double> *>(m_secondDerivatives);
+  if (dataType == CUDA_C_64F)
+    evaluateFunctionsKernel<<<numBlocks, blockSize, 0, stream>>>(
+        m_functions, m_knots, values, secondDerivatives, batchSize, numParams,
+        params, static_cast<thrust::complex<double> *>(storage));
+  else if (dataType == CUDA_C_32F)
+    evaluateFunctionsKernel<<<numBlocks, blockSize, 0, stream>>>(
+        m_functions, m_knots, values, secondDerivatives, batchSize, numParams,
+        params, static_cast<thrust::complex<float> *>(storage));
+  else
+    throw std::runtime_error("Invalid CUDA data type: " +
+                             std::to_string(dataType));
+  checkCudaError(cudaGetLastError());
+}
@@ -0,0 +1,62 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <cuda_runtime.h>
+#include <library_types.h>
+#include <vector>
+
+namespace cudaq::dynamics {
+// The device form of a `cudaq::time_function`. The interpolation points of all
+// the functions of a batch are stored contiguously, and the complex values as
+// pairs of doubles.
+struct DeviceTimeFunction {
+  // 0: piecewise-linear, 1: cubic spline, 2: sinusoid
+  int32_t kind = 0;
+  // The index of the argument of the function in the (complex) parameters
+  // passed to the callbacks.
+  int32_t paramIdx = 0;
+  int64_t firstKnot = 0;
+  int64_t numKnots = 0;
+  double frequency = 0.0;
+  double phase = 0.0;
+  double scale[2] = {1.0, 0.0};
+  double offset[2] = {0.0, 0.0};
+};
+
+// The functions of the coefficients of a batched operator term, in device
+// memory, evaluated by a kernel instead of a host callback.
+class DeviceTimeFunctions {
+public:
+  // `values` and `secondDerivatives` hold 2 doubles per interpolation point.
+  DeviceTimeFunctions(const std::vector<DeviceTimeFunction> &functions,
+                      const std::vector<double> &knots,
+                      const std::vector<double> &values,
+                      const std::vector<double> &secondDerivatives);
+  DeviceTimeFunctions(const DeviceTimeFunctions &) = delete;
+  DeviceTimeFunctions &operator=(const DeviceTimeFunctions &) = delete;
+  ~DeviceTimeFunctions();
+
+  std::size_t size() const { return m_size; }
+
+  // Writes the values of the functions to the device array `storage`, of
+  // `batchSize` complex elements of type `dataType`, on `stream`. `params` is
+  // the device array of the `numParams` real parameters of each batch member.
+  void evaluate(int64_t batchSize, int32_t numParams, const double *params,
+                cudaDataType_t dataType, void *storage,
+                cudaStream_t stream) const;
+
+private:
+  std::size_t m_size = 0;
+  DeviceTimeFunction *m_functions = nullptr;
+  double *m_knots = nullptr;
+  double *m_values = nullptr;
+  double *m_secondDerivatives = nullptr;
+};
+} // namespace cudaq::dynamics
@@ -10,12 +10,33 @@
 #include "CuDensityMatContext.h"
 #include "CuDensityMatErrorHandling.h"
 #include "CuDensityMatUtils.h"
-#include <map>
+#include "common/FmtCore.h"
 
 namespace cudaq {
 CuDensityMatTimeStepper::CuDensityMatTimeStepper(
     cudensitymatHandle_t handle, cudensitymatOperator_t liouvillian)
-    : m_handle(handle), m_liouvillian(liouvillian){};
+    : m_action(handle, liouvillian){};
+
+std::unique_ptr<CuDensityMatTimeStepper>
+CuDensityMatTimeStepper::create(const SystemDynamics &system,
+                                const schedule &schedule,
+                                const CuDensityMatState &state) {
+  const auto params = schedule.get_parameter_values(0.0);
+
+  auto liouvillian =
+      system.superOp.has_value()
+          ? dynamics::Context::getCurrentContext()
+                ->getOpConverter()
+                .constructLiouvillian({system.superOp.value()},
+                                      system.modeExtents, params)
+          : dynamics::Context::getCurrentContext()
+                ->getOpConverter()
+                .constructLiouvillian({system.hamiltonian},
+                                      {system.collapseOps}, system.modeExtents,
+                                      params, state.is_density_matrix());
+  return std::make_unique<CuDensityMatTimeStepper>(state.get_handle(),
+                                                   liouvillian);
+}
 
 state CuDensityMatTimeStepper::compute(
     const state &inputState, double t,
@@ -30,74 +51,138 @@ state CuDensityMatTimeStepper::compute(
   // Create a new state for the next step
   auto next_state = CuDensityMatState::zero_like(state);
   assert(next_state.getBatchSize() == state.getBatchSize());
-  computeImpl(state.get_impl(), next_state.get_impl(), t, parameters,
-              state.getBatchSize());
+  computeImpl(state, next_state, t, parameters);
   return cudaq::state(
       std::make_unique<CuDensityMatState>(std::move(next_state)).release());
 }
 
 void CuDensityMatTimeStepper::computeImpl(
-    cudensitymatState_t inState, cudensitymatState_t outState, double t,
+    const CuDensityMatState &inState, CuDensityMatState &outState, double t,
     const std::unordered_map<std::string, std::complex<double>> &parameters,
-    int64_t batchSize) {
-  // Prepare workspace
-  cudensitymatWorkspaceDescriptor_t workspace;
-  HANDLE_CUDM_ERROR(cudensitymatCreateWorkspace(m_handle, &workspace));
+    bool synchronize) {
+  m_action.compute(inState, outState, t, parameters, synchronize);
+}
 
-  {
-    cudaq::dynamics::PerfMetricScopeTimer metricTimer(
-        "cudensitymatOperatorPrepareAction");
-    // Prepare the operator for action
-    HANDLE_CUDM_ERROR(cudensitymatOperatorPrepareAction(
-        m_handle, m_liouvillian, inState, outState, CUDENSITYMAT_COMPUTE_64F,
-        dynamics::Context::getRecommendedWorkSpaceLimit(), workspace, 0x0));
-  }
+// The norm of each member of a batch of state vectors.
+static std::vector<double> memberNorms(const CuDensityMatState &state) {
+  const std::size_t numMembers = state.getBatchSize();
+  const std::size_t memberSize = state.getLocalSize() / numMembers;
+  const auto *data =
+      static_cast<const cuDoubleComplex *>(state.get_device_pointer());
+  std::vector<double> norms(numMembers);
+  for (std::size_t i = 0; i < numMembers; ++i)
+    HANDLE_CUBLAS_ERROR(cublasDznrm2(
+        dynamics::Context::getCurrentContext()->getCublasHandle(), memberSize,
+        data + i * memberSize, 1, &norms[i]));
+  return norms;
+}
 
-  // Query required workspace buffer size
-  std::size_t requiredBufferSize = 0;
-  HANDLE_CUDM_ERROR(cudensitymatWorkspaceGetMemorySize(
-      m_handle, workspace, CUDENSITYMAT_MEMSPACE_DEVICE,
-      CUDENSITYMAT_WORKSPACE_SCRATCH, &requiredBufferSize));
+CuDensityMatQuantumJumps::CuDensityMatQuantumJumps(const SystemDynamics &system,
+                                                   const schedule &schedule,
+                                                   std::size_t numTrajectories,
+                                                   std::size_t seed)
+    : m_schedule(schedule),
+      m_randomEngine(seed != 0 ? seed : std::random_device{}()) {
+  if (system.superOp.has_value() || system.collapseOps.size() != 1)
+    throw std::invalid_argument(
+        "Quantum trajectories require a single Hamiltonian and a list of "
+        "collapse operators.");
+  const auto params = schedule.get_parameter_values(0.0);
+  auto *context = dynamics::Context::getCurrentContext();
+  for (const auto &collapseOp : system.collapseOps.front())
+    m_collapseOps.emplace_back(std::make_unique<CuDensityMatTimeStepper>(
+        context->getHandle(),
+        context->getOpConverter().convertToCudensitymatOperator(
+            params, collapseOp, system.modeExtents)));
+  m_thresholds.resize(numTrajectories);
+  for (auto &threshold : m_thresholds)
+    threshold = m_uniform(m_randomEngine);
+}
 
-  void *workspaceBuffer = nullptr;
-  if (requiredBufferSize > 0) {
-    workspaceBuffer = dynamics::Context::getCurrentContext()->getScratchSpace(
-        requiredBufferSize);
+bool CuDensityMatQuantumJumps::apply(CuDensityMatState &state, double t) {
+  const std::size_t numMembers = state.getBatchSize();
+  if (numMembers != m_thresholds.size())
+    throw std::invalid_argument(
+        fmt::format("Expected a batch of {} trajectories, got {}.",
+                    m_thresholds.size(), numMembers));
+  const auto norms = memberNorms(state);
+  std::vector<std::size_t> jumping;
+  for (std::size_t i = 0; i < numMembers; ++i)
+    if (norms[i] * norms[i] < m_thresholds[i])
+      jumping.emplace_back(i);
+  if (jumping.empty())
+    return false;
 
-    // Attach workspace buffer
-    HANDLE_CUDM_ERROR(cudensitymatWorkspaceSetMemory(
-        m_handle, workspace, CUDENSITYMAT_MEMSPACE_DEVICE,
-        CUDENSITYMAT_WORKSPACE_SCRATCH, workspaceBuffer, requiredBufferSize));
-  }
+  const auto params = m_schedule.get_parameter_values(t);
+  const auto applyCollapseOp = [&](std::size_t k) {
+    auto collapsed = CuDensityMatState::zero_like(state);
+    m_collapseOps[k]->computeImpl(state, collapsed, t, params);
+    return collapsed;
+  };
 
-  // Apply the operator action
-  std::map<std::string, std::complex<double>> sortedParameters(
-      parameters.begin(), parameters.end());
-  const auto numComplexParams = sortedParameters.size();
-  std::vector<std::complex<double>> paramValues;
-  paramValues.reserve(numComplexParams * batchSize);
-  // Note: for batch, params is F-order 2d-array of user-defined real parameter
-  // values: params[numParams, batchSize].
-  for (int i = 0; i < batchSize; ++i) {
-    for (const auto &[k, v] : sortedParameters) {
-      paramValues.emplace_back(v);
+  // First, choose the collapse operator of each jump from the norms of all
+  // the collapsed states, so that only one collapsed batch is held at a time.
+  std::vector<std::vector<double>> collapsedNorms;
+  for (std::size_t k = 0; k < m_collapseOps.size(); ++k)
+    collapsedNorms.emplace_back(memberNorms(applyCollapseOp(k)));
+  std::vector<std::vector<std::size_t>> jumpsPerOp(m_collapseOps.size());
+  for (auto i : jumping) {
+    double totalWeight = 0.0;
+    for (const auto &opNorms : collapsedNorms)
+      totalWeight += opNorms[i] * opNorms[i];
+    m_thresholds[i] = m_uniform(m_randomEngine);
+    // No collapse operator can act on this state.
+    if (totalWeight <= 0.0)
+      continue;
+    double weight = m_uniform(m_randomEngine) * totalWeight;
+    std::size_t k = 0;
+    for (; k + 1 < collapsedNorms.size(); ++k) {
+      weight -= collapsedNorms[k][i] * collapsedNorms[k][i];
+      if (weight < 0.0)
+        break;
     }
-  }
-  double *param_d =
-      static_cast<double *>(cudaq::dynamics::createArrayGpu(paramValues));
-  HANDLE_CUDA_ERROR(cudaDeviceSynchronize());
-  {
-    cudaq::dynamics::PerfMetricScopeTimer metricTimer(
-        "cudensitymatOperatorComputeAction");
-    HANDLE_CUDM_ERROR(cudensitymatOperatorComputeAction(
-        m_handle, m_liouvillian, t, batchSize, numComplexParams * 2, param_d,
-        inState, outState, workspace, 0x0));
-    HANDLE_CUDA_ERROR(cudaDeviceSynchronize());
+    jumpsPerOp[k].emplace_back(i);
   }
 
-  // Cleanup
-  cudaq::dynamics::destroyArrayGpu(param_d);
-  HANDLE_CUDM_ERROR(cudensitymatDestroyWorkspace(workspace));
+  // Then, replace each jumping trajectory with its normalized collapsed state.
+  const std::size_t memberSize = state.getLocalSize() / numMembers;
+  const std::size_t memberSizeBytes = memberSize * sizeof(std::complex<double>);
+  auto *data = static_cast<cuDoubleComplex *>(state.get_device_pointer());
+  for (std::size_t k = 0; k < m_collapseOps.size(); ++k) {
+    if (jumpsPerOp[k].empty())
+      continue;
+    const auto collapsed = applyCollapseOp(k);
+    const auto *collapsedData =
+        static_cast<const cuDoubleComplex *>(collapsed.get_device_pointer());
+    for (auto i : jumpsPerOp[k]) {
+      HANDLE_CUDA_ERROR(cudaMemcpy(data + i * memberSize,
+                                   collapsedData + i * memberSize,
+                                   memberSizeBytes, cudaMemcpyDeviceToDevice));
+      const double scale = 1.0 / collapsedNorms[k][i];
+      HANDLE_CUBLAS_ERROR(cublasZdscal(
+          dynamics::Context::getCurrentContext()->getCublasHandle(), memberSize,
+          &scale, data + i * memberSize, 1));
+    }
+  }
+  return true;
 }
 
+std::unique_ptr<CuDensityMatState>
+CuDensityMatQuantumJumps::normalized(const CuDensityMatState &state) {
+  auto normalizedState = CuDensityMatState::clone(state);
+  const std::size_t numMembers = normalizedState->getBatchSize();
+  const std::size_t memberSize = normalizedState->getLocalSize() / numMembers;
+  auto *data =
+      static_cast<cuDoubleComplex *>(normalizedState->get_device_pointer());
+  const auto norms = memberNorms(*normalizedState);
+  for (std::size_t i = 0; i < numMembers; ++i) {
+    if (norms[i] <= 0.0)
+      continue;
+    const double scale = 1.0 / norms[i];
+    HANDLE_CUBLAS_ERROR(cublasZdscal(
+        dynamics::Context::getCurrentContext()->getCublasHandle(), memberSize,
+        &scale, data + i * memberSize, 1));
+  }
+  return normalizedState;
+}
 } // namespace cudaq
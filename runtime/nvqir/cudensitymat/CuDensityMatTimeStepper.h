@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include "CuDensityMatOperatorAction.h"
 #include "CuDensityMatState.h"
+#include "cudaq/algorithms/base_integrator.h"
 #include "cudaq/algorithms/base_time_stepper.h"
 #include <cudensitymat.h>
+#include <random>
 
 namespace cudaq {
 class CuDensityMatTimeStepper : public base_time_stepper {
@@ -18,16 +21,63 @@ public:
   explicit CuDensityMatTimeStepper(cudensitymatHandle_t handle,
                                    cudensitymatOperator_t liouvillian);
 
+  // Construct the time stepper of the Liouvillian of the system acting on
+  // `state`, with the parameters of the schedule at time 0.
+  static std::unique_ptr<CuDensityMatTimeStepper>
+  create(const SystemDynamics &system, const schedule &schedule,
+         const CuDensityMatState &state);
+
   state compute(const state &inputState, double t,
                 const std::unordered_map<std::string, std::complex<double>>
                     &parameters) override;
+  // Add the action of the Liouvillian on `inState` to `outState`. Unless
+  // `synchronize` is set, the computation is only enqueued on the default
+  // stream.
   void computeImpl(
-      cudensitymatState_t inState, cudensitymatState_t outState, double t,
+      const CuDensityMatState &inState, CuDensityMatState &outState, double t,
       const std::unordered_map<std::string, std::complex<double>> &parameters,
-      int64_t batchSize);
+      bool synchronize = true);
+
+private:
+  // The action is prepared once for the shape of the states, and reused by
+  // all the steps.
+  CuDensityMatOperatorAction m_action;
+};
+
+/// @brief Quantum jumps of the trajectories of the stochastic unravelling of a
+/// Lindblad master equation.
+// The trajectories are the members of a batch of state vectors, whose time
+// stepper evolves them under the non-Hermitian effective Hamiltonian
+// `H - i/2 sum_k L_k^dag L_k`, which decays their norm. A trajectory jumps as
+// soon as its squared norm drops below a uniformly distributed random
+// threshold: one of the collapse operators `L_k`, chosen with a probability
+// proportional to `|L_k psi|^2`, is applied to its state, which is then
+// normalized [Dalibard, Castin and Molmer, Wave-function approach to
+// dissipative processes in quantum optics, PRL 68, 580 (1992)]. Hence, jumps
+// are resolved in time up to the integration time points.
+class CuDensityMatQuantumJumps {
+public:
+  // The jumps of `numTrajectories` trajectories, drawn from a random engine
+  // seeded with `seed`, or with a random seed if 0.
+  CuDensityMatQuantumJumps(const SystemDynamics &system,
+                           const schedule &schedule,
+                           std::size_t numTrajectories, std::size_t seed);
+
+  // Apply the jumps of the trajectories of `state` at time `t`, in place.
+  // Returns true if any trajectory jumped.
+  bool apply(CuDensityMatState &state, double t);
+
+  // Return a copy of the trajectories of `state`, each normalized.
+  static std::unique_ptr<CuDensityMatState>
+  normalized(const CuDensityMatState &state);
 
 private:
-  cudensitymatHandle_t m_handle;
-  cudensitymatOperator_t m_liouvillian;
+  schedule m_schedule;
+  // The action of each collapse operator on the trajectories.
+  std::vector<std::unique_ptr<CuDensityMatTimeStepper>> m_collapseOps;
+  // The squared norm below which each trajectory jumps.
+  std::vector<double> m_thresholds;
+  std::mt19937_64 m_randomEngine;
+  std::uniform_real_distribution<double> m_uniform{0.0, 1.0};
 };
 } // namespace cudaq
@@ -0,0 +1,245 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CuDensityMatContext.h"
+#include "CuDensityMatErrorHandling.h"
+#include "CuDensityMatState.h"
+#include "CuDensityMatTimeStepper.h"
+#include "CuDensityMatUtils.h"
+#include "common/EigenDense.h"
+#include "common/FmtCore.h"
+#include "common/Logger.h"
+#include "cudaq.h"
+#include "cudaq/algorithms/integrator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+cudaq::CuDensityMatState *asCudmState(cudaq::state &cudaqState) {
+  auto *simState = cudaq::state_helper::getSimulationState(&cudaqState);
+  auto *castSimState = dynamic_cast<cudaq::CuDensityMatState *>(simState);
+  if (!castSimState)
+    throw std::runtime_error("Invalid state.");
+  return castSimState;
+}
+
+// Returns true if the operator does not depend on the schedule: its
+// coefficient is constant and its elementary operators neither take
+// parameters nor are marked as time-dependent.
+bool isTimeIndependent(const cudaq::product_op<cudaq::matrix_handler> &op) {
+  if (!op.get_coefficient().is_constant())
+    return false;
+  for (const auto &elementary : op)
+    if (elementary.is_time_dependent() ||
+        !elementary.get_parameter_descriptions().empty())
+      return false;
+  return true;
+}
+
+bool isTimeIndependent(const cudaq::SystemDynamics &system) {
+  if (system.superOp.has_value()) {
+    for (const auto &superOp : system.superOp.value())
+      for (const auto &[leftOp, rightOp] : superOp)
+        if ((leftOp.has_value() && !isTimeIndependent(leftOp.value())) ||
+            (rightOp.has_value() && !isTimeIndependent(rightOp.value())))
+          return false;
+    return true;
+  }
+  for (const auto &hamiltonian : system.hamiltonian)
+    for (const auto &term : hamiltonian)
+      if (!isTimeIndependent(term))
+        return false;
+  for (const auto &collapseOps : system.collapseOps)
+    for (const auto &collapseOp : collapseOps)
+      for (const auto &term : collapseOp)
+        if (!isTimeIndependent(term))
+          return false;
+  return true;
+}
+
+// The inner product <a|b> of the elements of two states, across all ranks of a
+// distributed state.
+std::complex<double> innerProduct(const cudaq::CuDensityMatState &a,
+                                  const cudaq::CuDensityMatState &b) {
+  cudaq::dynamics::PerfMetricScopeTimer metricTimer("cublasZdotc");
+  cuDoubleComplex result;
+  HANDLE_CUBLAS_ERROR(cublasZdotc(
+      cudaq::dynamics::Context::getCurrentContext()->getCublasHandle(),
+      a.getLocalSize(),
+      reinterpret_cast<const cuDoubleComplex *>(a.get_device_pointer()), 1,
+      reinterpret_cast<const cuDoubleComplex *>(b.get_device_pointer()), 1,
+      &result));
+  if (!cudaq::dynamics::Context::getCurrentContext()->isDistributed())
+    return {result.x, result.y};
+  return {cudaq::mpi::all_reduce(result.x, std::plus<double>()),
+          cudaq::mpi::all_reduce(result.y, std::plus<double>())};
+}
+
+double norm(const cudaq::CuDensityMatState &a) {
+  return std::sqrt(std::max(innerProduct(a, a).real(), 0.0));
+}
+
+// The exponential of a small dense matrix, by scaling and squaring of its
+// diagonal (6, 6) Pade approximant [Moler and Van Loan, Nineteen Dubious Ways
+// to Compute the Exponential of a Matrix, Method 3].
+Eigen::MatrixXcd expm(const Eigen::MatrixXcd &a) {
+  const double normInf = a.cwiseAbs().rowwise().sum().maxCoeff();
+  const int squarings =
+      normInf > 0.5 ? static_cast<int>(std::ceil(std::log2(normInf / 0.5)))
+                    : 0;
+  const Eigen::MatrixXcd x = a / std::ldexp(1.0, squarings);
+  constexpr int order = 6;
+  const auto identity = Eigen::MatrixXcd::Identity(a.rows(), a.cols());
+  Eigen::MatrixXcd power = identity;
+  Eigen::MatrixXcd numerator = identity;
+  Eigen::MatrixXcd denominator = identity;
+  double c = 1.0;
+  for (int k = 1; k <= order; ++k) {
+    c *= static_cast<double>(order - k + 1) / (k * (2 * order - k + 1));
+    power = x * power;
+    numerator += c * power;
+    denominator += (k % 2 ? -c : c) * power;
+  }
+  Eigen::MatrixXcd result = denominator.partialPivLu().solve(numerator);
+  for (int k = 0; k < squarings; ++k)
+    result = result * result;
+  return result;
+}
+} // namespace
+
+namespace cudaq {
+namespace integrators {
+
+krylov::krylov(double tolerance, int max_subspace_dim)
+    : m_tolerance(tolerance), m_maxSubspaceDim(max_subspace_dim) {
+  if (m_tolerance <= 0.0)
+    throw std::invalid_argument(
+        "krylov integrator requires a positive tolerance.");
+  if (m_maxSubspaceDim < 2)
+    throw std::invalid_argument(
+        "krylov integrator requires a subspace dimension of at least 2.");
+}
+
+std::shared_ptr<base_integrator> krylov::clone() {
+  auto clone = std::make_shared<cudaq::integrators::krylov>(m_tolerance,
+                                                             m_maxSubspaceDim);
+  clone->m_t = this->m_t;
+  clone->m_state = this->m_state;
+  clone->m_system = this->m_system;
+  clone->m_schedule = this->m_schedule;
+  return clone;
+}
+
+void krylov::setState(const cudaq::state &initial_state, double t0) {
+  auto *simState = cudaq::state_helper::getSimulationState(
+      const_cast<cudaq::state *>(&initial_state));
+  auto *cudmState = dynamic_cast<CuDensityMatState *>(simState);
+  if (!cudmState)
+    throw std::runtime_error("Invalid state.");
+  if (cudmState->getBatchSize() > 1)
+    throw std::invalid_argument(
+        "krylov integrator does not support batched states.");
+  m_state = std::make_shared<cudaq::state>(
+      CuDensityMatState::clone(*cudmState).release());
+  m_t = t0;
+}
+
+std::pair<double, cudaq::state> krylov::getState() {
+  auto &castSimState = *asCudmState(*m_state);
+  return std::make_pair(
+      m_t, cudaq::state(CuDensityMatState::clone(castSimState).release()));
+}
+
+void krylov::integrate(double targetTime) {
+  cudaq::dynamics::PerfMetricScopeTimer metricTimer("krylov::integrate");
+  std::unordered_map<std::string, std::complex<double>> params;
+  if (!m_stepper) {
+    if (!isTimeIndependent(m_system))
+      throw std::invalid_argument(
+          "krylov integrator requires a time-independent system: constant "
+          "coefficients and elementary operators without parameters.");
+    m_stepper = CuDensityMatTimeStepper::create(m_system, m_schedule,
+                                                *asCudmState(*m_state));
+  }
+  params = m_schedule.get_parameter_values(m_t);
+
+  const std::size_t maxDim = m_maxSubspaceDim;
+  while (m_t < targetTime) {
+    auto &y = *asCudmState(*m_state);
+    const double beta = norm(y);
+    if (beta == 0.0) {
+      m_t = targetTime;
+      break;
+    }
+
+    // Arnoldi iteration: `basis` is an orthonormal basis of the Krylov
+    // subspace and `hessenberg` the projection of the Liouvillian onto it.
+    double stepSize = targetTime - m_t;
+    std::vector<cudaq::state> basis;
+    basis.emplace_back(CuDensityMatState::clone(y).release());
+    *asCudmState(basis.front()) *= 1.0 / beta;
+    Eigen::MatrixXcd hessenberg = Eigen::MatrixXcd::Zero(maxDim, maxDim);
+    Eigen::MatrixXcd expH;
+    for (std::size_t j = 0; j < maxDim; ++j) {
+      auto next = m_stepper->compute(basis[j], m_t, params);
+      auto &nextState = *asCudmState(next);
+      for (std::size_t i = 0; i <= j; ++i) {
+        auto &basisState = *asCudmState(basis[i]);
+        hessenberg(i, j) = innerProduct(basisState, nextState);
+        nextState.accumulate_inplace(basisState, -hessenberg(i, j));
+      }
+      const double nextNorm = norm(nextState);
+      const std::size_t dim = j + 1;
+      const auto projection = hessenberg.topLeftCorner(dim, dim);
+      expH = expm(stepSize * projection);
+
+      // The subspace is invariant (happy breakdown): the step is exact.
+      if (nextNorm <= 1e-12 * std::max(projection.norm(), 1.0))
+        break;
+
+      // The residual error estimate of the step [Saad, Analysis of Some Krylov
+      // Subspace Approximations to the Matrix Exponential Operator].
+      const auto errorEstimate = [&]() {
+        return stepSize * nextNorm * std::abs(expH(dim - 1, 0));
+      };
+      if (errorEstimate() <= m_tolerance)
+        break;
+      if (dim == maxDim) {
+        // The error of a step is roughly proportional to its size to the power
+        // of the subspace dimension: shorten it, without applying the
+        // Liouvillian again.
+        while (errorEstimate() > m_tolerance) {
+          stepSize *= std::clamp(
+              0.9 * std::pow(m_tolerance / errorEstimate(), 1.0 / dim), 0.1,
+              0.9);
+          if (stepSize <= 16.0 * std::numeric_limits<double>::epsilon() *
+                              std::max(std::abs(m_t), 1.0))
+            throw std::runtime_error(fmt::format(
+                "krylov integrator step size underflow at time {}.", m_t));
+          expH = expm(stepSize * projection);
+        }
+        CUDAQ_DBG("krylov step shortened to {} at time {}", stepSize, m_t);
+        break;
+      }
+      nextState *= 1.0 / nextNorm;
+      basis.emplace_back(std::move(next));
+      hessenberg(dim, j) = nextNorm;
+    }
+
+    // y(t + h) = beta * V exp(h H) e_1
+    auto yNew = CuDensityMatState::clone(*asCudmState(basis.front()));
+    *yNew *= beta * expH(0, 0);
+    for (std::size_t i = 1; i < static_cast<std::size_t>(expH.rows()); ++i)
+      yNew->accumulate_inplace(*asCudmState(basis[i]), beta * expH(i, 0));
+    m_state = std::make_shared<cudaq::state>(yNew.release());
+    m_t += stepSize;
+  }
+}
+} // namespace integrators
+} // namespace cudaq
@@ -8,11 +8,29 @@
 
 #include "CuDensityMatContext.h"
 #include "CuDensityMatErrorHandling.h"
+#include "CuDensityMatErrorNorm.h"
 #include "CuDensityMatState.h"
 #include "CuDensityMatTimeStepper.h"
 #include "CuDensityMatUtils.h"
+#include "common/FmtCore.h"
 #include "common/Logger.h"
+#include "cudaq.h"
 #include "cudaq/algorithms/integrator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+cudaq::CuDensityMatState *asCudmState(cudaq::state &cudaqState) {
+  auto *simState = cudaq::state_helper::getSimulationState(&cudaqState);
+  auto *castSimState = dynamic_cast<cudaq::CuDensityMatState *>(simState);
+  if (!castSimState)
+    throw std::runtime_error("Invalid state.");
+  return castSimState;
+}
+} // namespace
+
 namespace cudaq {
 namespace integrators {
 
@@ -57,43 +75,31 @@ std::pair<double, cudaq::state> runge_kutta::getState() {
 
 void runge_kutta::integrate(double targetTime) {
   cudaq::dynamics::PerfMetricScopeTimer metricTimer("runge_kutta::integrate");
-  const auto asCudmState = [](cudaq::state &cudaqState) -> CuDensityMatState * {
-    auto *simState = cudaq::state_helper::getSimulationState(&cudaqState);
-    auto *castSimState = dynamic_cast<CuDensityMatState *>(simState);
-    if (!castSimState)
-      throw std::runtime_error("Invalid state.");
-    return castSimState;
-  };
   auto &castSimState = *asCudmState(*m_state);
   std::unordered_map<std::string, std::complex<double>> params;
-  if (!m_stepper) {
-    for (const auto &param : m_schedule.get_parameters()) {
-      params[param] = m_schedule.get_value_function()(param, 0.0);
-    }
-
-    auto liouvillian =
-        m_system.superOp.has_value()
-            ? cudaq::dynamics::Context::getCurrentContext()
-                  ->getOpConverter()
-                  .constructLiouvillian({m_system.superOp.value()},
-                                        m_system.modeExtents, params)
-            : cudaq::dynamics::Context::getCurrentContext()
-                  ->getOpConverter()
-                  .constructLiouvillian({m_system.hamiltonian},
-                                        {m_system.collapseOps},
-                                        m_system.modeExtents, params,
-                                        castSimState.is_density_matrix());
-    m_stepper = std::make_unique<CuDensityMatTimeStepper>(
-        castSimState.get_handle(), liouvillian);
+  if (!m_stepper)
+    m_stepper =
+        CuDensityMatTimeStepper::create(m_system, m_schedule, castSimState);
+  // The steps are fixed, so the parameters at all the stages of all the steps
+  // are evaluated up front.
+  std::vector<double> stageTimes;
+  for (double t = m_t; t < targetTime;) {
+    const double step_size =
+        std::min(m_dt.value_or(targetTime - t), targetTime - t);
+    stageTimes.push_back(t);
+    if (m_order > 1)
+      stageTimes.push_back(t + step_size / 2.0);
+    if (m_order > 2)
+      stageTimes.push_back(t + step_size);
+    t += step_size;
   }
+  m_schedule.precompute_parameters(stageTimes);
   while (m_t < targetTime) {
     const double step_size =
         std::min(m_dt.value_or(targetTime - m_t), targetTime - m_t);
     if (m_order == 1) {
       // Euler method (1st order)
-      for (const auto &param : m_schedule.get_parameters()) {
-        params[param] = m_schedule.get_value_function()(param, m_t);
-      }
+      params = m_schedule.get_parameter_values(m_t);
       auto k1State = m_stepper->compute(*m_state, m_t, params);
       auto &k1 = *asCudmState(k1State);
       k1 *= step_size;
@@ -102,9 +108,7 @@ void runge_kutta::integrate(double targetTime) {
       // Midpoint method (2nd order)
       // Standard formula: y_{n+1} = y_n + h * k2
       // where k1 = f(t, y_n), k2 = f(t + h/2, y_n + h/2 * k1)
-      for (const auto &param : m_schedule.get_parameters()) {
-        params[param] = m_schedule.get_value_function()(param, m_t);
-      }
+      params = m_schedule.get_parameter_values(m_t);
       auto k1State = m_stepper->compute(*m_state, m_t, params);
       auto &k1 = *asCudmState(k1State);
 
@@ -113,10 +117,7 @@ void runge_kutta::integrate(double targetTime) {
       rho_temp->accumulate_inplace(k1, step_size / 2.0);
 
       // Compute k2 at the midpoint
-      for (const auto &param : m_schedule.get_parameters()) {
-        params[param] =
-            m_schedule.get_value_function()(param, m_t + step_size / 2.0);
-      }
+      params = m_schedule.get_parameter_values(m_t + step_size / 2.0);
       auto k2State = m_stepper->compute(cudaq::state(rho_temp.release()),
                                         m_t + step_size / 2.0, params);
       auto &k2 = *asCudmState(k2State);
@@ -125,17 +126,12 @@ void runge_kutta::integrate(double targetTime) {
       castSimState.accumulate_inplace(k2, step_size);
     } else if (m_order == 4) {
       // Runge-Kutta method (4th order)
-      for (const auto &param : m_schedule.get_parameters()) {
-        params[param] = m_schedule.get_value_function()(param, m_t);
-      }
+      params = m_schedule.get_parameter_values(m_t);
       auto k1State = m_stepper->compute(*m_state, m_t, params);
       auto &k1 = *asCudmState(k1State);
       auto rho_temp = CuDensityMatState::clone(castSimState);
       rho_temp->accumulate_inplace(k1, step_size / 2); // y + h * k1/2
-      for (const auto &param : m_schedule.get_parameters()) {
-        params[param] =
-            m_schedule.get_value_function()(param, m_t + step_size / 2.0);
-      }
+      params = m_schedule.get_parameter_values(m_t + step_size / 2.0);
       auto k2State = m_stepper->compute(cudaq::state(rho_temp.release()),
                                         m_t + step_size / 2.0, params);
       auto &k2 = *asCudmState(k2State);
@@ -146,9 +142,7 @@ void runge_kutta::integrate(double targetTime) {
       auto &k3 = *asCudmState(k3State);
       auto rho_temp_3 = CuDensityMatState::clone(castSimState);
       rho_temp_3->accumulate_inplace(k3, step_size); // y + h * k3
-      for (const auto &param : m_schedule.get_parameters()) {
-        params[param] = m_schedule.get_value_function()(param, m_t + step_size);
-      }
+      params = m_schedule.get_parameter_values(m_t + step_size);
       auto k4State = m_stepper->compute(cudaq::state(rho_temp_3.release()),
                                         m_t + step_size, params);
       auto &k4 = *asCudmState(k4State);
@@ -165,5 +159,178 @@ void runge_kutta::integrate(double targetTime) {
     m_t += step_size;
   }
 }
+
+// The Butcher tableau of the Dormand-Prince 5(4) pair. The weights of the 5th
+// order solution are the coefficients of the last stage, which is evaluated at
+// the new state, first same as last.
+static constexpr std::size_t dopriStages = 7;
+static constexpr std::array<double, dopriStages> dopriC = {
+    0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0};
+static constexpr std::array<std::array<double, dopriStages - 1>, dopriStages>
+    dopriA = {{{},
+               {1.0 / 5.0},
+               {3.0 / 40.0, 9.0 / 40.0},
+               {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0},
+               {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0,
+                -212.0 / 729.0},
+               {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0,
+                -5103.0 / 18656.0},
+               {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0,
+                -2187.0 / 6784.0, 11.0 / 84.0}}};
+// The difference between the weights of the 5th and the 4th order solutions.
+static constexpr std::array<double, dopriStages> dopriE = {
+    71.0 / 57600.0,      0.0,          -71.0 / 16695.0, 71.0 / 1920.0,
+    -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0};
+
+dormand_prince::dormand_prince(double rtol, double atol,
+                               const std::optional<double> &max_step_size)
+    : m_rtol(rtol), m_atol(atol), m_maxDt(max_step_size) {
+  if (m_rtol < 0.0 || m_atol < 0.0 || (m_rtol == 0.0 && m_atol == 0.0))
+    throw std::invalid_argument("dormand_prince integrator requires "
+                                "non-negative tolerances, not both zero.");
+  if (m_maxDt.has_value() && m_maxDt.value() <= 0.0)
+    throw std::invalid_argument(
+        "dormand_prince integrator requires a positive max_step_size.");
+}
+
+std::shared_ptr<base_integrator> dormand_prince::clone() {
+  auto clone = std::make_shared<cudaq::integrators::dormand_prince>(
+      m_rtol, m_atol, m_maxDt);
+  clone->m_t = this->m_t;
+  clone->m_state = this->m_state;
+  clone->m_dt = this->m_dt;
+  clone->m_system = this->m_system;
+  clone->m_schedule = this->m_schedule;
+  return clone;
+}
+
+void dormand_prince::setState(const cudaq::state &initial_state, double t0) {
+  auto *simState = cudaq::state_helper::getSimulationState(
+      const_cast<cudaq::state *>(&initial_state));
+  auto *cudmState = dynamic_cast<CuDensityMatState *>(simState);
+  if (!cudmState)
+    throw std::runtime_error("Invalid state.");
+  m_state = std::make_shared<cudaq::state>(
+      CuDensityMatState::clone(*cudmState).release());
+  m_t = t0;
+  m_dt.reset();
+  m_derivative.reset();
+}
+
+std::pair<double, cudaq::state> dormand_prince::getState() {
+  auto &castSimState = *asCudmState(*m_state);
+  return std::make_pair(
+      m_t, cudaq::state(CuDensityMatState::clone(castSimState).release()));
+}
+
+void dormand_prince::integrate(double targetTime) {
+  cudaq::dynamics::PerfMetricScopeTimer metricTimer(
+      "dormand_prince::integrate");
+  std::unordered_map<std::string, std::complex<double>> params;
+  if (!m_stepper) {
+    m_stepper = CuDensityMatTimeStepper::create(m_system, m_schedule,
+                                                *asCudmState(*m_state));
+    m_derivative.reset();
+  }
+  const auto derivative = [&](const cudaq::state &state, double t) {
+    params = m_schedule.get_parameter_values(t);
+    return m_stepper->compute(state, t, params);
+  };
+  // The root-mean-square norm of `sum_j coeffs[j] * terms[j]` scaled by the
+  // tolerances, across all ranks of a distributed state.
+  const bool isDistributed =
+      cudaq::dynamics::Context::getCurrentContext()->isDistributed();
+  const auto scaledNorm = [&](CuDensityMatState &y0, CuDensityMatState &y1,
+                              const std::vector<const void *> &terms,
+                              const std::vector<double> &coeffs) {
+    double sum = cudaq::dynamics::scaledSquaredNorm(
+        y0.getLocalSize(), y0.get_device_pointer(), y1.get_device_pointer(),
+        terms, coeffs, m_rtol, m_atol);
+    double size = y0.getLocalSize();
+    if (isDistributed) {
+      sum = cudaq::mpi::all_reduce(sum, std::plus<double>());
+      size = cudaq::mpi::all_reduce(size, std::plus<double>());
+    }
+    return std::sqrt(sum / size);
+  };
+
+  if (!m_derivative)
+    m_derivative = std::make_shared<cudaq::state>(derivative(*m_state, m_t));
+  if (!m_dt) {
+    // Initial step size such that the explicit Euler step changes the state by
+    // about 1% of its scaled norm [Hairer, Norsett and Wanner, Solving Ordinary
+    // Differential Equations I, II.4].
+    auto &y = *asCudmState(*m_state);
+    const double d0 = scaledNorm(y, y, {y.get_device_pointer()}, {1.0});
+    const double d1 = scaledNorm(
+        y, y, {asCudmState(*m_derivative)->get_device_pointer()}, {1.0});
+    m_dt = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+  }
+
+  // Step size controller: the error of a step of size h is proportional to
+  // h^5, shrink or grow the step size toward an error of `safety`.
+  constexpr double safety = 0.9;
+  constexpr double minFactor = 0.2;
+  constexpr double maxFactor = 10.0;
+  while (m_t < targetTime) {
+    double maxStepSize = targetTime - m_t;
+    if (m_maxDt.has_value())
+      maxStepSize = std::min(maxStepSize, m_maxDt.value());
+    const double stepSize = std::min(m_dt.value(), maxStepSize);
+    if (stepSize <= 16.0 * std::numeric_limits<double>::epsilon() *
+                        std::max(std::abs(m_t), 1.0))
+      throw std::runtime_error(fmt::format(
+          "dormand_prince integrator step size underflow at time {}.", m_t));
+
+    auto &y = *asCudmState(*m_state);
+    std::vector<cudaq::state> stages{*m_derivative};
+    stages.reserve(dopriStages);
+    std::unique_ptr<CuDensityMatState> yNext;
+    for (std::size_t i = 1; i < dopriStages; ++i) {
+      yNext = CuDensityMatState::clone(y);
+      for (std::size_t j = 0; j < i; ++j)
+        if (dopriA[i][j] != 0.0)
+          yNext->accumulate_inplace(*asCudmState(stages[j]),
+                                    stepSize * dopriA[i][j]);
+      // The last stage is evaluated at the 5th order solution: keep it.
+      if (i + 1 < dopriStages) {
+        stages.emplace_back(derivative(cudaq::state(yNext.release()),
+                                       m_t + dopriC[i] * stepSize));
+      }
+    }
+    auto &yNew = *yNext;
+    cudaq::state newState(yNext.release());
+    stages.emplace_back(derivative(newState, m_t + stepSize));
+
+    std::vector<const void *> terms;
+    std::vector<double> coeffs;
+    for (std::size_t j = 0; j < dopriStages; ++j) {
+      if (dopriE[j] == 0.0)
+        continue;
+      terms.push_back(asCudmState(stages[j])->get_device_pointer());
+      coeffs.push_back(stepSize * dopriE[j]);
+    }
+    const double error = scaledNorm(y, yNew, terms, coeffs);
+    if (error <= 1.0) {
+      m_t += stepSize;
+      m_state = std::make_shared<cudaq::state>(newState);
+      m_derivative = std::make_shared<cudaq::state>(stages.back());
+      const double factor =
+          error == 0.0
+              ? maxFactor
+              : std::clamp(safety * std::pow(error, -0.2), minFactor,
+                           maxFactor);
+      // A step shortened to reach the target time does not shrink the next.
+      m_dt = std::max(stepSize < m_dt.value() ? m_dt.value() : 0.0,
+                      stepSize * factor);
+    } else {
+      CUDAQ_DBG("dormand_prince rejected step of size {} at time {} (error "
+                "{})",
+                stepSize, m_t, error);
+      m_dt = stepSize *
+             std::clamp(safety * std::pow(error, -0.2), minFactor, 1.0);
+    }
+  }
+}
 } // namespace integrators
 } // namespace cudaq
@@ -13,11 +13,14 @@
 #include "cuComplex.h"
 #include "custatevec.h"
 #include "device_launch_parameters.h"
-#include <bitset>
 #include <complex>
+#include <cstring>
+#include <deque>
 #include <iostream>
+#include <optional>
 #include <random>
 #include <set>
+#include <unordered_map>
 
 namespace {
 
@@ -52,18 +55,88 @@ protected:
   /// @brief The cuStateVec handle
   custatevecHandle_t handle = nullptr;
 
-  /// @brief Pointer to potentially needed extra memory
+  /// @brief The CUDA stream the simulator computes on. Simulators are
+  /// instantiated per thread, so the QPUs of a multi-QPU platform that share
+  /// a GPU overlap their work. The stream synchronizes with the legacy default
+  /// stream, which keeps the remaining default-stream operations ordered.
+  cudaStream_t computeStream = nullptr;
+
+  /// @brief Pointer to potentially needed extra memory. This buffer is only
+  /// ever grown, and reused across gate applications and expectation value
+  /// computations until the state is deallocated.
   void *extraWorkspace = nullptr;
 
-  /// @brief The size of the extra workspace
+  /// @brief The size of the extra workspace requested by the last operation
   size_t extraWorkspaceSizeInBytes = 0;
 
+  /// @brief The allocated capacity of the extra workspace
+  size_t extraWorkspaceCapacity = 0;
+
+  /// @brief Counter identifying the current contents of the state vector. It
+  /// is bumped by every operation that modifies the state, and used to detect
+  /// whether a cached sampler is still valid.
+  std::size_t stateVersion = 0;
+
+  /// @brief A custatevec sampler, along with its preprocessed workspace, kept
+  /// alive across sample() calls on an unchanged state.
+  struct SamplerCache {
+    custatevecSamplerDescriptor_t sampler = nullptr;
+    void *workspace = nullptr;
+    size_t workspaceSizeInBytes = 0;
+    std::size_t stateVersion = 0;
+    uint32_t maxShots = 0;
+  };
+  SamplerCache samplerCache;
+
+  /// @brief The Pauli-basis arrays custatevec computes the expectation values
+  /// of an observable with, kept across observe() calls on the same
+  /// observable, as in the iterations of a variational algorithm.
+  struct PauliBasisCache {
+    /// @brief The (canonical) observable the arrays are converted from.
+    std::optional<cudaq::spin_op> op;
+    // Stable holders of vectors since we need to send vectors of pointers to
+    // custatevec
+    std::deque<std::vector<custatevecPauli_t>> pauliOperatorsArrayHolder;
+    std::deque<std::vector<int32_t>> basisBitsArrayHolder;
+    std::vector<const custatevecPauli_t *> pauliOperatorsArray;
+    std::vector<const int32_t *> basisBitsArray;
+    std::vector<uint32_t> nBasisBitsArray;
+    std::vector<std::complex<double>> coeffs;
+    std::vector<std::string> termStrs;
+    /// @brief The X and Z bit masks of the terms, for double precision
+    /// accumulation.
+    std::vector<int64_t> xMasks;
+    std::vector<int64_t> zMasks;
+    /// @brief The number of X and Y operators of all terms.
+    std::size_t numBasisChanges = 0;
+  };
+  PauliBasisCache pauliBasisCache;
+
   custatevecComputeType_t cuStateVecComputeType = CUSTATEVEC_COMPUTE_64F;
   cudaDataType_t cuStateVecCudaDataType = CUDA_C_64F;
   std::random_device randomDevice;
   std::mt19937 randomEngine;
   bool ownsDeviceVector = true;
 
+  /// @brief The last execution context warned about ignoring its noise model.
+  const cudaq::ExecutionContext *noiseFreeWarnedContext = nullptr;
+
+  /// @brief Whether expectation values are accumulated in double precision,
+  /// rather than in the precision of the state (mixed-precision simulator).
+  bool useFp64Reductions = false;
+
+  /// @brief Whether device allocations are served from the stream-ordered
+  /// CUDA memory pool of the current device.
+  bool useMemPool = false;
+
+  /// @brief The memory pool used when `useMemPool` is set.
+  cudaMemPool_t memPool = nullptr;
+
+  /// @brief Number of bytes the memory pool may keep cached once the state
+  /// is deallocated. The default keeps the high-water mark of all
+  /// allocations, so that repeated executions never go back to the driver.
+  uint64_t memPoolReleaseThreshold = UINT64_MAX;
+
   /// @brief Generate a vector of random values
   std::vector<double> randomValues(uint64_t num_samples, double max_value) {
     std::vector<double> rs;
@@ -76,6 +149,194 @@ protected:
     return rs;
   }
 
+  /// @brief Allocate `sizeInBytes` bytes of device memory, from the memory
+  /// pool if enabled.
+  void *allocateDeviceMemory(size_t sizeInBytes) {
+    void *ptr = nullptr;
+    if (useMemPool)
+      HANDLE_CUDA_ERROR(cudaMallocAsync(&ptr, sizeInBytes, computeStream));
+    else
+      HANDLE_CUDA_ERROR(cudaMalloc(&ptr, sizeInBytes));
+    return ptr;
+  }
+
+  /// @brief Create the cuStateVec handle, bound to the compute stream.
+  void createHandle() {
+    HANDLE_ERROR(custatevecCreate(&handle));
+    HANDLE_ERROR(custatevecSetStream(handle, computeStream));
+  }
+
+  /// @brief Free device memory obtained from allocateDeviceMemory().
+  void freeDeviceMemory(void *ptr) {
+    if (useMemPool)
+      HANDLE_CUDA_ERROR(cudaFreeAsync(ptr, computeStream));
+    else
+      HANDLE_CUDA_ERROR(cudaFree(ptr));
+  }
+
+  /// @brief Size of the chunks in which large pageable host states are staged
+  /// into pinned memory for their transfer to the device.
+  static constexpr std::size_t hostStagingChunkBytes = 64ULL << 20;
+
+  /// @brief Copy `sizeInBytes` bytes of host state data to the device.
+  /// Pinned host memory is copied directly. Large pageable buffers are copied
+  /// through two pinned staging buffers on a dedicated stream, so that
+  /// filling one chunk on the host overlaps with the transfer of the other.
+  void copyHostStateToDevice(void *dst, const void *src, size_t sizeInBytes,
+                             const cudaPointerAttributes &srcAttributes) {
+    ScopedTraceWithContext("CuStateVecCircuitSimulator::copyHostStateToDevice",
+                           sizeInBytes);
+    if (srcAttributes.type == cudaMemoryTypeHost ||
+        sizeInBytes <= hostStagingChunkBytes) {
+      HANDLE_CUDA_ERROR(
+          cudaMemcpy(dst, src, sizeInBytes, cudaMemcpyHostToDevice));
+      return;
+    }
+
+    cudaStream_t stream;
+    HANDLE_CUDA_ERROR(cudaStreamCreate(&stream));
+    void *staging[2] = {nullptr, nullptr};
+    cudaEvent_t copied[2];
+    for (int b = 0; b < 2; ++b) {
+      HANDLE_CUDA_ERROR(cudaMallocHost(&staging[b], hostStagingChunkBytes));
+      HANDLE_CUDA_ERROR(
+          cudaEventCreateWithFlags(&copied[b], cudaEventDisableTiming));
+    }
+    for (size_t offset = 0, chunk = 0; offset < sizeInBytes;
+         offset += hostStagingChunkBytes, ++chunk) {
+      const int b = chunk % 2;
+      const size_t bytes =
+          std::min(hostStagingChunkBytes, sizeInBytes - offset);
+      // The staging buffer is free again once its previous chunk has landed.
+      if (chunk >= 2)
+        HANDLE_CUDA_ERROR(cudaEventSynchronize(copied[b]));
+      std::memcpy(staging[b], static_cast<const char *>(src) + offset, bytes);
+      HANDLE_CUDA_ERROR(cudaMemcpyAsync(static_cast<char *>(dst) + offset,
+                                        staging[b], bytes,
+                                        cudaMemcpyHostToDevice, stream));
+      HANDLE_CUDA_ERROR(cudaEventRecord(copied[b], stream));
+    }
+    HANDLE_CUDA_ERROR(cudaStreamSynchronize(stream));
+    for (int b = 0; b < 2; ++b) {
+      HANDLE_CUDA_ERROR(cudaEventDestroy(copied[b]));
+      HANDLE_CUDA_ERROR(cudaFreeHost(staging[b]));
+    }
+    HANDLE_CUDA_ERROR(cudaStreamDestroy(stream));
+  }
+
+  /// @brief Set up the default memory pool of the current device for state
+  /// vector and workspace allocations, unless disabled with
+  /// `CUDAQ_ENABLE_MEMPOOL`. The amount of memory the pool retains can be
+  /// capped with `CUDAQ_MEMPOOL_RELEASE_THRESHOLD_GB`.
+  void initializeMemPool() {
+    if (!cudaq::getEnvBool("CUDAQ_ENABLE_MEMPOOL", true)) {
+      CUDAQ_INFO("Mempool is disabled.");
+      return;
+    }
+    int device = 0;
+    HANDLE_CUDA_ERROR(cudaGetDevice(&device));
+    int supported = 0;
+    HANDLE_CUDA_ERROR(cudaDeviceGetAttribute(
+        &supported, cudaDevAttrMemoryPoolsSupported, device));
+    if (!supported) {
+      CUDAQ_INFO("Memory pools are unsupported on this GPU");
+      return;
+    }
+
+    if (auto *envVal = std::getenv("CUDAQ_MEMPOOL_RELEASE_THRESHOLD_GB")) {
+      std::string value(envVal);
+      std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+      if (value != "none") {
+        if (value.empty() ||
+            !std::all_of(value.begin(), value.end(), ::isdigit))
+          throw std::runtime_error(cudaq_fmt::format(
+              "Invalid CUDAQ_MEMPOOL_RELEASE_THRESHOLD_GB environment "
+              "variable ({}), must be a non-negative integer or NONE.",
+              envVal));
+        memPoolReleaseThreshold = std::stoull(value) << 30;
+      }
+    }
+
+    HANDLE_CUDA_ERROR(cudaDeviceGetDefaultMemPool(&memPool, device));
+    HANDLE_CUDA_ERROR(cudaMemPoolSetAttribute(
+        memPool, cudaMemPoolAttrReleaseThreshold, &memPoolReleaseThreshold));
+    useMemPool = true;
+    CUDAQ_INFO("Mempool is enabled (release threshold {} bytes).",
+               memPoolReleaseThreshold);
+  }
+
+  /// @brief Return an extra workspace of at least `sizeInBytes` bytes,
+  /// reallocating the pooled buffer only if it is too small.
+  void *getExtraWorkspace(size_t sizeInBytes) {
+    if (sizeInBytes > extraWorkspaceCapacity) {
+      if (extraWorkspace)
+        freeDeviceMemory(extraWorkspace);
+      extraWorkspace = allocateDeviceMemory(sizeInBytes);
+      extraWorkspaceCapacity = sizeInBytes;
+    }
+    return sizeInBytes > 0 ? extraWorkspace : nullptr;
+  }
+
+  /// @brief Release the pooled extra workspace.
+  void freeExtraWorkspace() {
+    if (extraWorkspace) {
+      freeDeviceMemory(extraWorkspace);
+      extraWorkspace = nullptr;
+    }
+    extraWorkspaceSizeInBytes = 0;
+    extraWorkspaceCapacity = 0;
+  }
+
+  /// @brief Destroy the cached sampler, if any. This must happen before the
+  /// custatevec handle is destroyed.
+  void destroySamplerCache() {
+    if (samplerCache.sampler)
+      HANDLE_ERROR(custatevecSamplerDestroy(samplerCache.sampler));
+    if (samplerCache.workspace)
+      freeDeviceMemory(samplerCache.workspace);
+    samplerCache = SamplerCache();
+  }
+
+  /// @brief Return a sampler for the current state that supports at least
+  /// `shots` shots. The sampler preprocessing only depends on the state (not
+  /// on the measured qubits), hence a cached sampler is reused as long as the
+  /// state has not changed since it was created.
+  custatevecSamplerDescriptor_t getSampler(uint32_t shots) {
+    if (samplerCache.sampler && samplerCache.stateVersion == stateVersion &&
+        samplerCache.maxShots >= shots) {
+      CUDAQ_INFO("Reusing cached custatevec sampler (state version {}).",
+                 stateVersion);
+      return samplerCache.sampler;
+    }
+
+    size_t workspaceSizeInBytes = 0;
+    custatevecSamplerDescriptor_t sampler;
+    HANDLE_ERROR(custatevecSamplerCreate(
+        handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
+        &sampler, shots, &workspaceSizeInBytes));
+    if (samplerCache.sampler)
+      HANDLE_ERROR(custatevecSamplerDestroy(samplerCache.sampler));
+    samplerCache.sampler = sampler;
+
+    // The preprocessed data lives in the workspace, so the sampler keeps its
+    // own buffer rather than sharing the pooled extra workspace.
+    if (workspaceSizeInBytes > samplerCache.workspaceSizeInBytes) {
+      if (samplerCache.workspace)
+        freeDeviceMemory(samplerCache.workspace);
+      samplerCache.workspace = allocateDeviceMemory(workspaceSizeInBytes);
+      samplerCache.workspaceSizeInBytes = workspaceSizeInBytes;
+    }
+
+    // Run the sampling preprocess step.
+    HANDLE_ERROR(custatevecSamplerPreprocess(
+        handle, sampler, workspaceSizeInBytes > 0 ? samplerCache.workspace
+                                                  : nullptr,
+        workspaceSizeInBytes));
+    samplerCache.stateVersion = stateVersion;
+    samplerCache.maxShots = shots;
+    return sampler;
+  }
+
   /// @brief Convert the pauli rotation gate name to a CUSTATEVEC_PAULI Type
   /// @param type
   /// @return
@@ -98,16 +359,14 @@ protected:
   void applyGateMatrix(const DataVector &matrix,
                        const std::vector<int> &controls,
                        const std::vector<int> &targets) {
+    auto localNQubitsAllocated =
+        stateDimension > 0 ? std::log2(stateDimension) : 0;
+
     HANDLE_ERROR(custatevecApplyMatrixGetWorkspaceSize(
-        handle, cuStateVecCudaDataType, nQubitsAllocated, matrix.data(),
+        handle, cuStateVecCudaDataType, localNQubitsAllocated, matrix.data(),
         cuStateVecCudaDataType, CUSTATEVEC_MATRIX_LAYOUT_ROW, 0, targets.size(),
         controls.size(), cuStateVecComputeType, &extraWorkspaceSizeInBytes));
-
-    if (extraWorkspaceSizeInBytes > 0)
-      HANDLE_CUDA_ERROR(cudaMalloc(&extraWorkspace, extraWorkspaceSizeInBytes));
-
-    auto localNQubitsAllocated =
-        stateDimension > 0 ? std::log2(stateDimension) : 0;
+    void *workspace = getExtraWorkspace(extraWorkspaceSizeInBytes);
 
     // apply gate
     HANDLE_ERROR(custatevecApplyMatrix(
@@ -115,11 +374,65 @@ protected:
         localNQubitsAllocated, matrix.data(), cuStateVecCudaDataType,
         CUSTATEVEC_MATRIX_LAYOUT_ROW, 0, targets.data(), targets.size(),
         controls.empty() ? nullptr : controls.data(), nullptr, controls.size(),
-        cuStateVecComputeType, extraWorkspace, extraWorkspaceSizeInBytes));
+        cuStateVecComputeType, workspace, extraWorkspaceSizeInBytes));
+    ++stateVersion;
+  }
 
-    if (extraWorkspace) {
-      HANDLE_CUDA_ERROR(cudaFree(extraWorkspace));
-      extraWorkspace = nullptr;
+  /// @brief Return true if the row-major `matrix` is the identity
+  static bool isIdentity(const std::vector<std::complex<double>> &matrix) {
+    const auto dim = static_cast<std::size_t>(std::sqrt(matrix.size()));
+    constexpr double tol = 1e-12;
+    for (std::size_t i = 0; i < dim; ++i)
+      for (std::size_t j = 0; j < dim; ++j)
+        if (std::abs(matrix[i * dim + j] - (i == j ? 1.0 : 0.0)) > tol)
+          return false;
+    return true;
+  }
+
+  /// @brief Apply a single trajectory of the given Kraus channel: one Kraus
+  /// operator `K_i` is drawn with probability `p_i = <psi|K_i^dag K_i|psi>`
+  /// and `K_i / sqrt(p_i)` is applied to the state.
+  void applyKrausTrajectory(const cudaq::kraus_channel &channel,
+                            const std::vector<std::size_t> &qubits) {
+    // Kraus operators use the MSB qubit ordering, custatevec the LSB one.
+    const std::vector<int> targets(qubits.rbegin(), qubits.rend());
+    if (channel.is_unitary_mixture()) {
+      // Branch probabilities do not depend on the state, and the frequent
+      // no-error branch can be skipped altogether.
+      std::discrete_distribution<std::size_t> distr(
+          channel.probabilities.begin(), channel.probabilities.end());
+      const auto &op = channel.unitary_ops[distr(randomEngine)];
+      if (!isIdentity(op))
+        applyGateMatrix(DataVector(op.begin(), op.end()), {}, targets);
+      return;
+    }
+
+    const std::vector<std::size_t> tgts(targets.begin(), targets.end());
+    const auto ops = channel.get_ops();
+    const double rand = randomValues(1, 1.0)[0];
+    double cumulative = 0.0;
+    for (std::size_t k = 0; k < ops.size(); ++k) {
+      const auto &op = ops[k];
+      const std::size_t dim = op.nRows;
+      // K^dag K, whose expectation value is the probability of this branch
+      DataVector kdk(dim * dim, 0.0);
+      for (std::size_t i = 0; i < dim; ++i)
+        for (std::size_t j = 0; j < dim; ++j)
+          for (std::size_t l = 0; l < dim; ++l)
+            kdk[i * dim + j] += DataType(std::conj(op.data[l * dim + i]) *
+                                         op.data[l * dim + j]);
+      const double prob = getExpectationFromOperatorMatrix(kdk.data(), tgts);
+      cumulative += prob;
+      // Rounding may leave the cumulative probability slightly below one, in
+      // which case the last branch with a non-zero probability is selected.
+      if ((rand < cumulative || k + 1 == ops.size()) && prob > 0.0) {
+        const ScalarType scale = 1.0 / std::sqrt(prob);
+        DataVector matrix(op.data.begin(), op.data.end());
+        for (auto &el : matrix)
+          el *= scale;
+        applyGateMatrix(matrix, {}, targets);
+        return;
+      }
     }
   }
 
@@ -138,6 +451,7 @@ protected:
         handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
         -0.5 * angle, pauli, targets, 1, controls32.data(), nullptr,
         controls32.size()));
+    ++stateVersion;
   }
 
   /// @brief Nice utility function to have to print the state vector contents on
@@ -157,6 +471,7 @@ protected:
                            count);
     if (count == 0)
       return;
+    ++stateVersion;
 
     // Cast the state, at this point an error would
     // have been thrown if it is not of the right floating point type
@@ -176,9 +491,9 @@ protected:
     // the allocation is much easier
     if (!deviceStateVector) {
       // Create the memory and the handle
-      HANDLE_CUDA_ERROR(cudaMalloc((void **)&deviceStateVector,
-                                   stateDimension * sizeof(CudaDataType)));
-      HANDLE_ERROR(custatevecCreate(&handle));
+      deviceStateVector =
+          allocateDeviceMemory(stateDimension * sizeof(CudaDataType));
+      createHandle();
       ownsDeviceVector = true;
       // If no state provided, initialize to the zero state
       if (state == nullptr) {
@@ -198,12 +513,8 @@ protected:
       }
 
       // First allocation, so just set the user provided data here
-      ScopedTraceWithContext(
-          "CuStateVecCircuitSimulator::addQubitsToState cudaMemcpy",
-          stateDimension * sizeof(CudaDataType));
-      HANDLE_CUDA_ERROR(cudaMemcpy(deviceStateVector, state,
-                                   stateDimension * sizeof(CudaDataType),
-                                   cudaMemcpyHostToDevice));
+      copyHostStateToDevice(deviceStateVector, state,
+                            stateDimension * sizeof(CudaDataType), attributes);
 
       return;
     }
@@ -212,16 +523,14 @@ protected:
     // kronecker product with existing state
 
     // Allocate new vector to place the kron prod result
-    void *newDeviceStateVector;
-    HANDLE_CUDA_ERROR(cudaMalloc((void **)&newDeviceStateVector,
-                                 stateDimension * sizeof(CudaDataType)));
+    void *newDeviceStateVector =
+        allocateDeviceMemory(stateDimension * sizeof(CudaDataType));
     HANDLE_CUDA_ERROR(cudaMemset(newDeviceStateVector, 0,
                                  stateDimension * sizeof(CudaDataType)));
     // Place the state data on device. Could be that
     // we just need the zero state, or the user could have provided one
-    void *otherState;
-    HANDLE_CUDA_ERROR(cudaMalloc((void **)&otherState,
-                                 (1UL << count) * sizeof(CudaDataType)));
+    void *otherState =
+        allocateDeviceMemory((1UL << count) * sizeof(CudaDataType));
     if (state == nullptr) {
       nvqir::initializeDeviceStateVector<CudaDataType>(
           n_blocks, threads_per_block, otherState, (1UL << count));
@@ -236,9 +545,8 @@ protected:
             "[CuStateVecCircuitSimulator] Incompatible host pointer");
       }
 
-      HANDLE_CUDA_ERROR(cudaMemcpy(otherState, state,
-                                   (1UL << count) * sizeof(CudaDataType),
-                                   cudaMemcpyHostToDevice));
+      copyHostStateToDevice(otherState, state,
+                            (1UL << count) * sizeof(CudaDataType), attributes);
     }
 
     {
@@ -251,8 +559,8 @@ protected:
       HANDLE_CUDA_ERROR(cudaGetLastError());
     }
     // Free the old vectors we don't need anymore.
-    HANDLE_CUDA_ERROR(cudaFree(deviceStateVector));
-    HANDLE_CUDA_ERROR(cudaFree(otherState));
+    freeDeviceMemory(deviceStateVector);
+    freeDeviceMemory(otherState);
     deviceStateVector = newDeviceStateVector;
   }
 
@@ -262,13 +570,14 @@ protected:
     if (!casted)
       throw std::invalid_argument(
           "[CuStateVecCircuitSimulator] Incompatible state input");
+    ++stateVersion;
 
     if (!deviceStateVector) {
       // Create the memory and the handle
-      HANDLE_CUDA_ERROR(cudaMalloc((void **)&deviceStateVector,
-                                   stateDimension * sizeof(CudaDataType)));
+      deviceStateVector =
+          allocateDeviceMemory(stateDimension * sizeof(CudaDataType));
       ownsDeviceVector = true;
-      HANDLE_ERROR(custatevecCreate(&handle));
+      createHandle();
       ScopedTraceWithContext(
           "CuStateVecCircuitSimulator::addQubitsToState cudaMemcpy");
       // First allocation, so just copy the user provided data (device mem) here
@@ -280,9 +589,8 @@ protected:
 
     // Expanding the state
     // Allocate new vector to place the kron prod result
-    void *newDeviceStateVector;
-    HANDLE_CUDA_ERROR(cudaMalloc((void **)&newDeviceStateVector,
-                                 stateDimension * sizeof(CudaDataType)));
+    void *newDeviceStateVector =
+        allocateDeviceMemory(stateDimension * sizeof(CudaDataType));
     HANDLE_CUDA_ERROR(cudaMemset(newDeviceStateVector, 0,
                                  stateDimension * sizeof(CudaDataType)));
     constexpr int32_t threads_per_block = 256;
@@ -300,52 +608,53 @@ protected:
     }
     // Free the old state we don't need anymore.
     // Note: the devicePtr of the input state is owned by the caller.
-    HANDLE_CUDA_ERROR(cudaFree(deviceStateVector));
+    freeDeviceMemory(deviceStateVector);
     deviceStateVector = newDeviceStateVector;
   }
 
   /// @brief Increase the state size by one qubit.
   void addQubitToState() override {
     ScopedTraceWithContext("CuStateVecCircuitSimulator::addQubitToState");
+    ++stateVersion;
     // Update the state vector
     if (!deviceStateVector) {
-      HANDLE_CUDA_ERROR(cudaMalloc((void **)&deviceStateVector,
-                                   stateDimension * sizeof(CudaDataType)));
+      deviceStateVector =
+          allocateDeviceMemory(stateDimension * sizeof(CudaDataType));
       constexpr int32_t threads_per_block = 256;
       uint32_t n_blocks =
           (stateDimension + threads_per_block - 1) / threads_per_block;
       nvqir::initializeDeviceStateVector<CudaDataType>(
           n_blocks, threads_per_block, deviceStateVector, stateDimension);
-      HANDLE_ERROR(custatevecCreate(&handle));
+      createHandle();
     } else {
       // Allocate new state..
-      void *newDeviceStateVector;
-      HANDLE_CUDA_ERROR(cudaMalloc((void **)&newDeviceStateVector,
-                                   stateDimension * sizeof(CudaDataType)));
+      void *newDeviceStateVector =
+          allocateDeviceMemory(stateDimension * sizeof(CudaDataType));
       constexpr int32_t threads_per_block = 256;
       uint32_t n_blocks =
           (stateDimension + threads_per_block - 1) / threads_per_block;
       nvqir::setFirstNElements<CudaDataType>(
           n_blocks, threads_per_block, newDeviceStateVector, deviceStateVector,
           previousStateDimension);
-      HANDLE_CUDA_ERROR(cudaFree(deviceStateVector));
+      freeDeviceMemory(deviceStateVector);
       deviceStateVector = newDeviceStateVector;
     }
   }
 
   /// @brief Reset the qubit state.
   void deallocateStateImpl() override {
+    destroySamplerCache();
     if (deviceStateVector)
       HANDLE_ERROR(custatevecDestroy(handle));
     if (deviceStateVector && ownsDeviceVector) {
-      HANDLE_CUDA_ERROR(cudaFree(deviceStateVector));
-    }
-    if (extraWorkspace) {
-      HANDLE_CUDA_ERROR(cudaFree(extraWorkspace));
-      extraWorkspace = nullptr;
+      freeDeviceMemory(deviceStateVector);
     }
+    freeExtraWorkspace();
     deviceStateVector = nullptr;
-    extraWorkspaceSizeInBytes = 0;
+    ++stateVersion;
+    // Only give memory back to the driver if the user capped the pool.
+    if (useMemPool && memPoolReleaseThreshold != UINT64_MAX)
+      HANDLE_CUDA_ERROR(cudaMemPoolTrimTo(memPool, memPoolReleaseThreshold));
   }
 
   /// @brief Apply the given GateApplicationTask
@@ -390,6 +699,148 @@ protected:
     nvqir::initializeDeviceStateVector<CudaDataType>(
         n_blocks, threads_per_block, deviceStateVector, stateDimension);
     HANDLE_CUDA_ERROR(cudaGetLastError());
+    ++stateVersion;
+  }
+
+  using BatchedExecution =
+      typename nvqir::CircuitSimulatorBase<ScalarType>::BatchedExecution;
+
+  /// @brief Return true if the two executions apply the same gates to the
+  /// same qubits, so that they can be simulated as one batch.
+  static bool haveSameCircuitStructure(const BatchedExecution &a,
+                                       const BatchedExecution &b) {
+    if (a.numQubits != b.numQubits || a.gates.size() != b.gates.size())
+      return false;
+    for (std::size_t g = 0; g < a.gates.size(); ++g)
+      if (a.gates[g].operationName != b.gates[g].operationName ||
+          a.gates[g].controls != b.gates[g].controls ||
+          a.gates[g].targets != b.gates[g].targets)
+        return false;
+    return true;
+  }
+
+  /// @brief Simulate the executions of the given batch, which share their
+  /// circuit structure, in one contiguous buffer of state vectors: each gate
+  /// is applied to all state vectors with one custatevecApplyMatrixBatched()
+  /// call, with the matrix of each execution. Each state vector is then
+  /// sampled in turn.
+  void sampleBatch(std::vector<BatchedExecution> &executions,
+                   const std::vector<std::size_t> &batch,
+                   std::vector<cudaq::ExecutionResult> &results) {
+    ScopedTraceWithContext("CuStateVecCircuitSimulator::sampleBatch",
+                           batch.size());
+    const auto &first = executions[batch.front()];
+    const uint32_t numStates = batch.size();
+    const std::size_t dim = 1ULL << first.numQubits;
+    auto *batchedStates = static_cast<CudaDataType *>(
+        allocateDeviceMemory(numStates * dim * sizeof(CudaDataType)));
+    createHandle();
+    constexpr int32_t threads_per_block = 256;
+    uint32_t n_blocks = (dim + threads_per_block - 1) / threads_per_block;
+    for (uint32_t s = 0; s < numStates; ++s)
+      nvqir::initializeDeviceStateVector<CudaDataType>(
+          n_blocks, threads_per_block, batchedStates + s * dim, dim);
+    HANDLE_CUDA_ERROR(cudaGetLastError());
+
+    DataVector matrices;
+    std::vector<int32_t> matrixIndices(numStates);
+    std::vector<int> controls, targets;
+    for (std::size_t g = 0; g < first.gates.size(); ++g) {
+      const auto &gate = first.gates[g];
+      controls.assign(gate.controls.begin(), gate.controls.end());
+      targets.assign(gate.targets.begin(), gate.targets.end());
+      // A gate with the same matrix in all executions is broadcast, the
+      // other ones are indexed by state vector.
+      const bool broadcast = std::all_of(
+          batch.begin(), batch.end(), [&](std::size_t e) {
+            return executions[e].gates[g].matrix == gate.matrix;
+          });
+      matrices.clear();
+      if (broadcast) {
+        matrices.assign(gate.matrix.begin(), gate.matrix.end());
+      } else {
+        for (uint32_t s = 0; s < numStates; ++s) {
+          const auto &matrix = executions[batch[s]].gates[g].matrix;
+          matrices.insert(matrices.end(), matrix.begin(), matrix.end());
+          matrixIndices[s] = s;
+        }
+      }
+      const auto mapType = broadcast
+                               ? CUSTATEVEC_MATRIX_MAP_TYPE_BROADCAST
+                               : CUSTATEVEC_MATRIX_MAP_TYPE_MATRIX_INDEXED;
+      const uint32_t numMatrices = broadcast ? 1 : numStates;
+      const int32_t *indices = broadcast ? nullptr : matrixIndices.data();
+      HANDLE_ERROR(custatevecApplyMatrixBatchedGetWorkspaceSize(
+          handle, cuStateVecCudaDataType, first.numQubits, numStates, dim,
+          mapType, indices, matrices.data(), cuStateVecCudaDataType,
+          CUSTATEVEC_MATRIX_LAYOUT_ROW, 0, numMatrices, targets.size(),
+          controls.size(), cuStateVecComputeType,
+          &extraWorkspaceSizeInBytes));
+      void *workspace = getExtraWorkspace(extraWorkspaceSizeInBytes);
+      HANDLE_ERROR(custatevecApplyMatrixBatched(
+          handle, batchedStates, cuStateVecCudaDataType, first.numQubits,
+          numStates, dim, mapType, indices, matrices.data(),
+          cuStateVecCudaDataType, CUSTATEVEC_MATRIX_LAYOUT_ROW, 0, numMatrices,
+          targets.data(), targets.size(),
+          controls.empty() ? nullptr : controls.data(), nullptr,
+          controls.size(), cuStateVecComputeType, workspace,
+          extraWorkspaceSizeInBytes));
+    }
+
+    // Each state vector is sampled through the regular sample(), on a state
+    // vector the simulator does not own.
+    deviceStateVector = batchedStates;
+    ownsDeviceVector = false;
+    nQubitsAllocated = first.numQubits;
+    stateDimension = dim;
+    for (uint32_t s = 0; s < numStates; ++s) {
+      auto &execution = executions[batch[s]];
+      deviceStateVector = batchedStates + s * dim;
+      ++stateVersion;
+      results[batch[s]] = sample(execution.sampleQubits, execution.shots);
+    }
+    deallocateStateImpl();
+    ownsDeviceVector = true;
+    nQubitsAllocated = 0;
+    stateDimension = 0;
+    freeDeviceMemory(batchedStates);
+  }
+
+  std::vector<cudaq::ExecutionResult>
+  sampleBatchedExecutions(std::vector<BatchedExecution> &executions) override {
+    ScopedTraceWithContext(
+        "CuStateVecCircuitSimulator::sampleBatchedExecutions",
+        executions.size());
+    std::vector<cudaq::ExecutionResult> results(executions.size());
+    std::size_t freeMemory = 0, totalMemory = 0;
+    HANDLE_CUDA_ERROR(cudaMemGetInfo(&freeMemory, &totalMemory));
+
+    // Group the executions by circuit structure, in batches whose state
+    // vectors take at most half of the free device memory.
+    std::vector<bool> batched(executions.size(), false);
+    for (std::size_t e = 0; e < executions.size(); ++e) {
+      if (batched[e])
+        continue;
+      const std::size_t stateBytes =
+          sizeof(CudaDataType) << executions[e].numQubits;
+      const std::size_t maxBatchSize =
+          std::max<std::size_t>(1, freeMemory / 2 / stateBytes);
+      std::vector<std::size_t> batch;
+      for (std::size_t other = e; other < executions.size(); ++other) {
+        if (batched[other] ||
+            !haveSameCircuitStructure(executions[e], executions[other]))
+          continue;
+        batched[other] = true;
+        batch.push_back(other);
+        if (batch.size() == maxBatchSize) {
+          sampleBatch(executions, batch, results);
+          batch.clear();
+        }
+      }
+      if (!batch.empty())
+        sampleBatch(executions, batch, results);
+    }
+    return results;
   }
 
 public:
@@ -399,24 +850,136 @@ public:
       cuStateVecComputeType = CUSTATEVEC_COMPUTE_32F;
       cuStateVecCudaDataType = CUDA_C_32F;
     }
+#ifdef __NVQIR_CUSTATEVEC_MIXED_PRECISION
+    useFp64Reductions = true;
+#endif
 
     // Populate the correct name so it is printed correctly during
     // deconstructor.
     summaryData.name = name();
+    // Fused gates are applied as dense matrices via custatevecApplyMatrix.
+    this->supportsGateFusion = true;
+    // Runs of diagonal gates are applied as a single phase kernel.
+    this->supportsDiagonalGateRuns = true;
+    // Noise is simulated by sampling one Kraus operator per channel.
+    this->simulatesNoiseAsTrajectories = true;
+    // The executions of a sample broadcast share a batched state buffer.
+    this->supportsBatchedSampling = true;
+    // The state vector is streamed to and from checkpoint files in chunks.
+    this->supportsCheckpoints = true;
 
     HANDLE_CUDA_ERROR(cudaFree(0));
+    HANDLE_CUDA_ERROR(cudaStreamCreate(&computeStream));
+    initializeMemPool();
     randomEngine = std::mt19937(randomDevice());
   }
 
   /// The destructor
-  virtual ~CuStateVecCircuitSimulator() = default;
+  virtual ~CuStateVecCircuitSimulator() {
+    // Simulators are destroyed at thread or program exit, when the CUDA
+    // context may already be gone, so errors are ignored.
+    if (computeStream)
+      cudaStreamDestroy(computeStream);
+  }
 
   void setRandomSeed(std::size_t randomSeed) override {
     randomEngine = std::mt19937(randomSeed);
   }
 
+  /// @brief Return true if noise channels are applied as trajectories in the
+  /// current execution context. A trajectory is a single random draw, which
+  /// only stands for the noisy circuit when the kernel is executed once per
+  /// shot, i.e., when sampling or running it. Other contexts, e.g., `observe`
+  /// or `get_state`, simulate the noise-free circuit, as they did before
+  /// trajectories were supported, with a warning.
+  bool shouldApplyTrajectories() {
+    if (!executionContext || executionContext->name == "sample" ||
+        executionContext->name == "run")
+      return true;
+    if (noiseFreeWarnedContext != executionContext) {
+      noiseFreeWarnedContext = executionContext;
+      CUDAQ_WARN("[custatevec] noise is only simulated when sampling or "
+                 "running kernels, ignoring the noise model in the '{}' "
+                 "context. Use the density-matrix backend for noisy {}.",
+                 executionContext->name, executionContext->name);
+    }
+    return false;
+  }
+
+  /// @brief Apply the noise channels registered for the given gate, sampling
+  /// a single Kraus operator per channel.
+  void applyNoiseChannel(const std::string_view gateName,
+                         const std::vector<std::size_t> &controls,
+                         const std::vector<std::size_t> &targets,
+                         const std::vector<double> &params) override {
+    if (!executionContext || !executionContext->noiseModel ||
+        !shouldApplyTrajectories())
+      return;
+    std::vector<std::size_t> qubits(controls.begin(), controls.end());
+    qubits.insert(qubits.end(), targets.begin(), targets.end());
+    executionContext->noiseModel->for_each_channel(
+        gateName, targets, controls, params,
+        [&](const cudaq::kraus_channel &channel) {
+          applyKrausTrajectory(channel, qubits);
+        });
+    executionContext->noiseModel->for_each_crosstalk_channel(
+        gateName, targets, controls,
+        [&](const cudaq::noise_model::crosstalk_channel &crosstalk,
+            const std::vector<std::size_t> &spectators) {
+          applyCrosstalkTrajectory(crosstalk, spectators);
+        });
+  }
+
+  /// @brief Apply a crosstalk channel to each of the spectator qubits, sampling
+  /// a single Kraus operator per spectator. The Pauli errors sampled for all
+  /// spectators of a Pauli channel are applied as one Pauli string.
+  void applyCrosstalkTrajectory(
+      const cudaq::noise_model::crosstalk_channel &crosstalk,
+      const std::vector<std::size_t> &spectators) {
+    if (crosstalk.paulis.empty()) {
+      for (auto qubit : spectators)
+        applyKrausTrajectory(crosstalk.channel, {qubit});
+      return;
+    }
+
+    const auto &probabilities = crosstalk.channel.probabilities;
+    std::discrete_distribution<std::size_t> distr(probabilities.begin(),
+                                                  probabilities.end());
+    std::vector<custatevecPauli_t> paulis;
+    std::vector<int> targets;
+    for (auto qubit : spectators) {
+      const char pauli = crosstalk.paulis[distr(randomEngine)];
+      if (pauli == 'I')
+        continue;
+      paulis.push_back(pauli == 'X'   ? CUSTATEVEC_PAULI_X
+                       : pauli == 'Y' ? CUSTATEVEC_PAULI_Y
+                                      : CUSTATEVEC_PAULI_Z);
+      targets.push_back(qubit);
+    }
+    if (paulis.empty())
+      return;
+    // exp(i pi/2 P) = i P, equal to P up to a global phase.
+    HANDLE_ERROR(custatevecApplyPauliRotation(
+        handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
+        M_PI_2, paulis.data(), targets.data(), targets.size(), nullptr,
+        nullptr, 0));
+    ++stateVersion;
+  }
+
+  void applyNoise(const cudaq::kraus_channel &channel,
+                  const std::vector<std::size_t> &qubits) override {
+    if (!shouldApplyTrajectories())
+      return;
+    flushGateQueue();
+    CUDAQ_INFO("[custatevec] apply kraus channel {}",
+               channel.get_type_name());
+    applyKrausTrajectory(channel, qubits);
+  }
+
   /// @brief Device synchronization
-  void synchronize() override { HANDLE_CUDA_ERROR(cudaDeviceSynchronize()); }
+  void synchronize() override {
+    HANDLE_CUDA_ERROR(cudaStreamSynchronize(computeStream));
+  }
 
   /// @brief Measure operation
   /// @param qubitIdx
@@ -429,6 +992,7 @@ public:
         handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
         &parity, basisBits, /*N Bits*/ 1, rand,
         CUSTATEVEC_COLLAPSE_NORMALIZE_AND_ZERO));
+    ++stateVersion;
     CUDAQ_INFO("Measured qubit {} -> {}", qubitIdx, parity);
     return parity == 1 ? true : false;
   }
@@ -445,6 +1009,7 @@ public:
         handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
         &parity, basisBits, /*N Bits*/ 1, rand,
         CUSTATEVEC_COLLAPSE_NORMALIZE_AND_ZERO));
+    ++stateVersion;
     if (parity) {
       x(qubitIdx);
     }
@@ -490,12 +1055,97 @@ public:
         handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
         theta, paulis.data(), targets.data(), targets.size(), controls.data(),
         nullptr, controls.size()));
+    ++stateVersion;
+  }
+
+  /// @brief Apply the phase function of a run of diagonal gates in a single
+  /// pass over the state, with the phase kernel of the diagonal Pauli
+  /// rotations.
+  void applyDiagonalPhases(const std::vector<std::uint64_t> &masks,
+                           const std::vector<double> &angles) override {
+    nvqir::applyDiagonalPauliRotations<ScalarType>(
+        deviceStateVector, stateDimension,
+        std::vector<int64_t>(masks.begin(), masks.end()), angles);
+    ++stateVersion;
+  }
+
+  /// @brief Apply the Pauli rotations of a batch in order. Since diagonal
+  /// (Z-only) rotations commute, each run of consecutive diagonal terms is
+  /// applied as a single phase multiplication, in one pass over the state;
+  /// the other terms go to custatevecApplyPauliRotation, which needs no basis
+  /// change.
+  void
+  applyExpPauliBatch(const std::vector<double> &thetas,
+                     const std::vector<std::size_t> &qubits,
+                     const std::vector<cudaq::spin_op_term> &terms) override {
+    if (this->isInTracerMode()) {
+      nvqir::CircuitSimulator::applyExpPauliBatch(thetas, qubits, terms);
+      return;
+    }
+    if (thetas.size() != terms.size())
+      throw std::invalid_argument(
+          "exp_pauli batch requires one angle per Pauli word - got " +
+          std::to_string(thetas.size()) + " angles and " +
+          std::to_string(terms.size()) + " words");
+    flushGateQueue();
+    CUDAQ_INFO(" [cusv] exp_pauli batch of {} terms", terms.size());
+
+    // The current run of diagonal terms, with the angles of terms with the
+    // same Z mask summed up.
+    std::vector<int64_t> zMasks;
+    std::vector<double> runThetas;
+    std::unordered_map<int64_t, std::size_t> runIndices;
+    const auto applyDiagonalRun = [&]() {
+      if (zMasks.empty())
+        return;
+      nvqir::applyDiagonalPauliRotations<ScalarType>(
+          deviceStateVector, stateDimension, zMasks, runThetas);
+      ++stateVersion;
+      zMasks.clear();
+      runThetas.clear();
+      runIndices.clear();
+    };
+
+    for (std::size_t k = 0; k < terms.size(); ++k) {
+      const auto &term = terms[k];
+      if (term.num_ops() != qubits.size())
+        throw std::runtime_error(
+            "incorrect number of qubits for exp_pauli - expecting " +
+            std::to_string(term.num_ops()) + " qubits");
+      bool isDiagonal = true;
+      int64_t zMask = 0;
+      std::size_t idx = 0;
+      for (const auto &op : term) {
+        const auto pauli = op.as_pauli();
+        if (pauli == cudaq::pauli::X || pauli == cudaq::pauli::Y)
+          isDiagonal = false;
+        else if (pauli == cudaq::pauli::Z)
+          zMask |= int64_t(1) << qubits[idx];
+        ++idx;
+      }
+      if (!isDiagonal) {
+        applyDiagonalRun();
+        applyExpPauli(thetas[k], {}, qubits, term);
+        continue;
+      }
+      // exp(i*theta*Id) is noop.
+      if (zMask == 0)
+        continue;
+      auto [iter, inserted] = runIndices.try_emplace(zMask, zMasks.size());
+      if (inserted) {
+        zMasks.push_back(zMask);
+        runThetas.push_back(thetas[k]);
+      } else {
+        runThetas[iter->second] += thetas[k];
+      }
+    }
+    applyDiagonalRun();
   }
 
   /// @brief Compute the operator expectation value, with respect to
   /// the current state vector, directly on GPU with the
   /// given the operator matrix and target qubit indices.
-  auto getExpectationFromOperatorMatrix(const std::complex<double> *matrix,
+  auto getExpectationFromOperatorMatrix(const DataType *matrix,
                                         const std::vector<std::size_t> &tgts) {
     // Convert the size_t tgts into ints
     std::vector<int> tgtsInt(tgts.size());
@@ -509,9 +1159,7 @@ public:
         handle, cuStateVecCudaDataType, nIndexBits, matrix,
         cuStateVecCudaDataType, CUSTATEVEC_MATRIX_LAYOUT_ROW, tgts.size(),
         cuStateVecComputeType, &extraWorkspaceSizeInBytes));
-
-    if (extraWorkspaceSizeInBytes > 0)
-      HANDLE_CUDA_ERROR(cudaMalloc(&extraWorkspace, extraWorkspaceSizeInBytes));
+    void *workspace = getExtraWorkspace(extraWorkspaceSizeInBytes);
 
     double expect;
 
@@ -520,60 +1168,68 @@ public:
         handle, deviceStateVector, cuStateVecCudaDataType, nIndexBits, &expect,
         CUDA_R_64F, nullptr, matrix, cuStateVecCudaDataType,
         CUSTATEVEC_MATRIX_LAYOUT_ROW, tgtsInt.data(), tgts.size(),
-        cuStateVecComputeType, extraWorkspace, extraWorkspaceSizeInBytes));
-
-    if (extraWorkspace) {
-      HANDLE_CUDA_ERROR(cudaFree(extraWorkspace));
-      extraWorkspace = nullptr;
-    }
+        cuStateVecComputeType, workspace, extraWorkspaceSizeInBytes));
 
     return expect;
   }
 
-  /// @brief We can compute Observe from the matrix for a
-  /// reasonable number of qubits, otherwise we should compute it
-  /// via sampling
-  bool canHandleObserve() override {
-    // Do not compute <H> from matrix if shots based sampling requested
-    // i.e., a valid shots count value was set.
-    // Note: -1 is also used to denote non-sampling execution. Hence, we need to
-    // check for this particular -1 value as being casted to an unsigned type.
-    if (executionContext && executionContext->shots > 0 &&
-        executionContext->shots != static_cast<std::size_t>(-1)) {
-      return false;
-    }
+  /// @brief Compute the expectation values of the given Pauli strings, with
+  /// double precision accumulation.
+  std::vector<double> computePauliExpectations(
+      const std::deque<std::vector<custatevecPauli_t>> &paulis,
+      const std::deque<std::vector<int32_t>> &basisBits) {
+    std::vector<int64_t> xMasks, zMasks;
+    computePauliMasks(paulis, basisBits, xMasks, zMasks);
+    return nvqir::pauliExpectations<ScalarType>(
+        deviceStateVector, stateDimension, xMasks, zMasks);
+  }
 
-    // If no shots requested (exact expectation calulation), don't use
-    // term-by-term observe as the default since
-    // `CuStateVecCircuitSimulator::observe` will do a batched expectation value
-    // calculation to compute all expectation values for all terms at once.
-    return !shouldObserveFromSampling(/*defaultConfig=*/false);
+  /// @brief Compute the X and Z bit masks (Y sets both) of the given Pauli
+  /// strings.
+  static void
+  computePauliMasks(const std::deque<std::vector<custatevecPauli_t>> &paulis,
+                    const std::deque<std::vector<int32_t>> &basisBits,
+                    std::vector<int64_t> &xMasks,
+                    std::vector<int64_t> &zMasks) {
+    xMasks.reserve(paulis.size());
+    zMasks.reserve(paulis.size());
+    auto bits = basisBits.begin();
+    for (const auto &pauliString : paulis) {
+      int64_t xMask = 0, zMask = 0;
+      for (std::size_t i = 0; i < pauliString.size(); ++i) {
+        const int64_t bit = int64_t(1) << (*bits)[i];
+        if (pauliString[i] == CUSTATEVEC_PAULI_X ||
+            pauliString[i] == CUSTATEVEC_PAULI_Y)
+          xMask |= bit;
+        if (pauliString[i] == CUSTATEVEC_PAULI_Z ||
+            pauliString[i] == CUSTATEVEC_PAULI_Y)
+          zMask |= bit;
+      }
+      xMasks.push_back(xMask);
+      zMasks.push_back(zMask);
+      ++bits;
+    }
   }
 
-  /// @brief Compute the expected value from the observable matrix.
-  cudaq::observe_result observe(const cudaq::spin_op &op) override {
-    // Use batched custatevecComputeExpectationsOnPauliBasis to compute all term
-    // expectation values in one go
-    uint32_t nPauliOperatorArrays = op.num_terms();
+  /// @brief Return the Pauli-basis arrays of `op`, converting them only if
+  /// `op` differs from the observable of the previous call. Comparing the
+  /// observables is much cheaper than converting them, and a cached
+  /// observable is known to be canonical.
+  const PauliBasisCache &getPauliBasis(const cudaq::spin_op &op) {
+    auto &cache = pauliBasisCache;
+    if (cache.op && *cache.op == op) {
+      CUDAQ_INFO("Reusing cached Pauli basis of {} terms.", op.num_terms());
+      return cache;
+    }
     assert(cudaq::spin_op::canonicalize(op) == op);
 
-    // custatevecComputeExpectationsOnPauliBasis will throw errors if
-    // nPauliOperatorArrays is 0, so catch that case early.
-    if (nPauliOperatorArrays == 0)
-      return cudaq::observe_result{};
-
-    // Stable holders of vectors since we need to send vectors of pointers to
-    // custatevec
-    std::deque<std::vector<custatevecPauli_t>> pauliOperatorsArrayHolder;
-    std::deque<std::vector<int32_t>> basisBitsArrayHolder;
-    std::vector<const custatevecPauli_t *> pauliOperatorsArray;
-    std::vector<const int32_t *> basisBitsArray;
-    std::vector<std::complex<double>> coeffs;
-    std::vector<uint32_t> nBasisBitsArray;
-    pauliOperatorsArray.reserve(nPauliOperatorArrays);
-    basisBitsArray.reserve(nPauliOperatorArrays);
-    coeffs.reserve(nPauliOperatorArrays);
-    nBasisBitsArray.reserve(nPauliOperatorArrays);
+    cache = PauliBasisCache();
+    const uint32_t nPauliOperatorArrays = op.num_terms();
+    cache.pauliOperatorsArray.reserve(nPauliOperatorArrays);
+    cache.basisBitsArray.reserve(nPauliOperatorArrays);
+    cache.nBasisBitsArray.reserve(nPauliOperatorArrays);
+    cache.coeffs.reserve(nPauliOperatorArrays);
+    cache.termStrs.reserve(nPauliOperatorArrays);
     // Helper to convert Pauli enums
     const auto cudaqToCustateVec = [](cudaq::pauli pauli) -> custatevecPauli_t {
       switch (pauli) {
@@ -590,10 +1246,8 @@ public:
     };
 
     // Contruct data to send on to custatevec
-    std::vector<std::string> termStrs;
-    termStrs.reserve(nPauliOperatorArrays);
     for (const auto &term : op) {
-      coeffs.emplace_back(term.evaluate_coefficient());
+      cache.coeffs.emplace_back(term.evaluate_coefficient());
       std::vector<custatevecPauli_t> paulis;
       std::vector<int32_t> idxs;
       paulis.reserve(term.num_ops());
@@ -605,30 +1259,77 @@ public:
           paulis.emplace_back(cudaqToCustateVec(pauli));
           idxs.emplace_back(target);
           // Only X and Y pauli's translate to applied gates
-          if (pauli != cudaq::pauli::Z) {
-            // One operation for applying the term
-            summaryData.svGateUpdate(/*nControls=*/0, /*nTargets=*/1,
-                                     stateDimension,
-                                     stateDimension * sizeof(DataType));
-            // And one operation for un-applying the term
-            summaryData.svGateUpdate(/*nControls=*/0, /*nTargets=*/1,
-                                     stateDimension,
-                                     stateDimension * sizeof(DataType));
-          }
+          if (pauli != cudaq::pauli::Z)
+            ++cache.numBasisChanges;
         }
       }
-      pauliOperatorsArrayHolder.emplace_back(std::move(paulis));
-      basisBitsArrayHolder.emplace_back(std::move(idxs));
-      pauliOperatorsArray.emplace_back(pauliOperatorsArrayHolder.back().data());
-      basisBitsArray.emplace_back(basisBitsArrayHolder.back().data());
-      nBasisBitsArray.emplace_back(pauliOperatorsArrayHolder.back().size());
-      termStrs.emplace_back(term.get_term_id());
+      cache.pauliOperatorsArrayHolder.emplace_back(std::move(paulis));
+      cache.basisBitsArrayHolder.emplace_back(std::move(idxs));
+      cache.pauliOperatorsArray.emplace_back(
+          cache.pauliOperatorsArrayHolder.back().data());
+      cache.basisBitsArray.emplace_back(
+          cache.basisBitsArrayHolder.back().data());
+      cache.nBasisBitsArray.emplace_back(
+          cache.pauliOperatorsArrayHolder.back().size());
+      cache.termStrs.emplace_back(term.get_term_id());
     }
+    computePauliMasks(cache.pauliOperatorsArrayHolder,
+                      cache.basisBitsArrayHolder, cache.xMasks, cache.zMasks);
+    cache.op = op;
+    return cache;
+  }
+
+  /// @brief We can compute Observe from the matrix for a
+  /// reasonable number of qubits, otherwise we should compute it
+  /// via sampling
+  bool canHandleObserve() override {
+    // Do not compute <H> from matrix if shots based sampling requested
+    // i.e., a valid shots count value was set.
+    // Note: -1 is also used to denote non-sampling execution. Hence, we need to
+    // check for this particular -1 value as being casted to an unsigned type.
+    if (executionContext && executionContext->shots > 0 &&
+        executionContext->shots != static_cast<std::size_t>(-1)) {
+      return false;
+    }
+
+    // If no shots requested (exact expectation calulation), don't use
+    // term-by-term observe as the default since
+    // `CuStateVecCircuitSimulator::observe` will do a batched expectation value
+    // calculation to compute all expectation values for all terms at once.
+    return !shouldObserveFromSampling(/*defaultConfig=*/false);
+  }
+
+  /// @brief Compute the expected value from the observable matrix.
+  cudaq::observe_result observe(const cudaq::spin_op &op) override {
+    // Use batched custatevecComputeExpectationsOnPauliBasis to compute all term
+    // expectation values in one go
+    uint32_t nPauliOperatorArrays = op.num_terms();
+
+    // custatevecComputeExpectationsOnPauliBasis will throw errors if
+    // nPauliOperatorArrays is 0, so catch that case early.
+    if (nPauliOperatorArrays == 0)
+      return cudaq::observe_result{};
+
+    const auto &basis = getPauliBasis(op);
+    // One operation for applying each X or Y operator, and one for
+    // un-applying it.
+    for (std::size_t i = 0; i < 2 * basis.numBasisChanges; ++i)
+      summaryData.svGateUpdate(/*nControls=*/0, /*nTargets=*/1,
+                               stateDimension,
+                               stateDimension * sizeof(DataType));
+    const auto &coeffs = basis.coeffs;
+    const auto &termStrs = basis.termStrs;
     std::vector<double> expectationValues(nPauliOperatorArrays);
-    HANDLE_ERROR(custatevecComputeExpectationsOnPauliBasis(
-        handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
-        expectationValues.data(), pauliOperatorsArray.data(),
-        nPauliOperatorArrays, basisBitsArray.data(), nBasisBitsArray.data()));
+    if (useFp64Reductions) {
+      expectationValues = nvqir::pauliExpectations<ScalarType>(
+          deviceStateVector, stateDimension, basis.xMasks, basis.zMasks);
+    } else {
+      HANDLE_ERROR(custatevecComputeExpectationsOnPauliBasis(
+          handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
+          expectationValues.data(), basis.pauliOperatorsArray.data(),
+          nPauliOperatorArrays, basis.basisBitsArray.data(),
+          basis.nBasisBitsArray.data()));
+    }
     std::complex<double> expVal = 0.0;
     std::vector<cudaq::ExecutionResult> results;
     results.reserve(nPauliOperatorArrays);
@@ -661,55 +1362,58 @@ public:
       const uint32_t nBasisBitsArray[] = {(uint32_t)measuredBits.size()};
       const int *basisBitsArray[] = {measuredBits32.data()};
       const custatevecPauli_t *pauliArray[] = {z_pauli.data()};
-      double expectationValues[1];
-      HANDLE_ERROR(custatevecComputeExpectationsOnPauliBasis(
-          handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
-          expectationValues, pauliArray, 1, basisBitsArray, nBasisBitsArray));
-      expVal = expectationValues[0];
+      if (useFp64Reductions) {
+        expVal = computePauliExpectations(
+            std::deque<std::vector<custatevecPauli_t>>{z_pauli},
+            std::deque<std::vector<int32_t>>{measuredBits32})[0];
+      } else {
+        double expectationValues[1];
+        HANDLE_ERROR(custatevecComputeExpectationsOnPauliBasis(
+            handle, deviceStateVector, cuStateVecCudaDataType,
+            nQubitsAllocated, expectationValues, pauliArray, 1, basisBitsArray,
+            nBasisBitsArray));
+        expVal = expectationValues[0];
+      }
       CUDAQ_INFO("Computed expectation value = {}", expVal);
       return cudaq::ExecutionResult{expVal};
     }
 
-    // Grab some random seed values and create the sampler
-    auto randomValues_ = randomValues(shots, 1.0);
-    custatevecSamplerDescriptor_t sampler;
-    HANDLE_ERROR(custatevecSamplerCreate(
-        handle, deviceStateVector, cuStateVecCudaDataType, nQubitsAllocated,
-        &sampler, shots, &extraWorkspaceSizeInBytes));
-    // allocate external workspace if necessary
-    if (extraWorkspaceSizeInBytes > 0)
-      HANDLE_CUDA_ERROR(cudaMalloc(&extraWorkspace, extraWorkspaceSizeInBytes));
-
-    // Run the sampling preprocess step.
-    HANDLE_ERROR(custatevecSamplerPreprocess(handle, sampler, extraWorkspace,
-                                             extraWorkspaceSizeInBytes));
-
-    // Sample!
-    std::vector<custatevecIndex_t> bitstrings0(shots);
+    // Generate the sorted random values on the device, which avoids a host
+    // sort and host buffers of the size of the shot count, and get a
+    // (possibly cached) sampler. The device generator is seeded from the
+    // engine, so that setRandomSeed() keeps the samples reproducible.
+    auto *deviceRandomValues = static_cast<double *>(
+        allocateDeviceMemory((shots + 1) * sizeof(double)));
+    nvqir::sortedUniformRandomValues(
+        deviceRandomValues, shots,
+        std::uniform_int_distribution<uint64_t>()(randomEngine));
+    auto sampler = getSampler(shots);
+
+    // Sample! The sampler reads the random values and writes the sampled
+    // indices in device memory.
+    auto *deviceBitstrings = static_cast<custatevecIndex_t *>(
+        allocateDeviceMemory(shots * sizeof(custatevecIndex_t)));
     HANDLE_ERROR(custatevecSamplerSample(
-        handle, sampler, bitstrings0.data(), measuredBits32.data(),
-        measuredBits32.size(), randomValues_.data(), shots,
+        handle, sampler, deviceBitstrings, measuredBits32.data(),
+        measuredBits32.size(), deviceRandomValues, shots,
         CUSTATEVEC_SAMPLER_OUTPUT_ASCENDING_ORDER));
 
-    if (extraWorkspace) {
-      HANDLE_CUDA_ERROR(cudaFree(extraWorkspace));
-      extraWorkspace = nullptr;
-    }
-
-    std::vector<std::string> sequentialData;
-    sequentialData.reserve(shots);
+    // The sampled indices already are bit-packed shots: bit i holds the
+    // outcome of measuredBits[i]. They are copied once, straight into the
+    // packed shots.
+    static_assert(sizeof(custatevecIndex_t) == sizeof(std::uint64_t));
+    cudaq::PackedShots packedShots(measuredBits.size());
+    packedShots.words.resize(shots);
+    HANDLE_CUDA_ERROR(cudaMemcpyAsync(
+        packedShots.words.data(), deviceBitstrings,
+        shots * sizeof(custatevecIndex_t), cudaMemcpyDeviceToHost,
+        computeStream));
+    HANDLE_CUDA_ERROR(cudaStreamSynchronize(computeStream));
+    freeDeviceMemory(deviceBitstrings);
+    freeDeviceMemory(deviceRandomValues);
 
     cudaq::ExecutionResult counts;
-
-    // We've sampled, convert the results to our ExecutionResult counts
-    for (int i = 0; i < shots; ++i) {
-      auto bitstring = std::bitset<64>(bitstrings0[i])
-                           .to_string()
-                           .erase(0, 64 - measuredBits.size());
-      std::reverse(bitstring.begin(), bitstring.end());
-      counts.appendResult(bitstring, 1);
-      sequentialData.push_back(std::move(bitstring));
-    }
+    counts.appendPackedResults(std::move(packedShots));
 
     // Compute the expectation value from the counts
     for (auto &kv : counts.counts) {
@@ -722,9 +1426,6 @@ public:
     }
 
     counts.expectationValue = expVal;
-
-    HANDLE_ERROR(custatevecSamplerDestroy(sampler));
-
     return counts;
   }
 
@@ -737,6 +1438,23 @@ public:
 
   bool isStateVectorSimulator() const override { return true; }
 
+  /// @brief Copy a chunk of the device state straight to (or from) the
+  /// mapped checkpoint file, without a host copy of the whole state.
+  void getStateChunk(std::size_t offset, std::size_t count,
+                     std::complex<ScalarType> *dst) override {
+    HANDLE_CUDA_ERROR(cudaMemcpy(
+        dst, reinterpret_cast<CudaDataType *>(deviceStateVector) + offset,
+        count * sizeof(CudaDataType), cudaMemcpyDeviceToHost));
+  }
+
+  void setStateChunk(std::size_t offset, std::size_t count,
+                     const std::complex<ScalarType> *src) override {
+    HANDLE_CUDA_ERROR(cudaMemcpy(
+        reinterpret_cast<CudaDataType *>(deviceStateVector) + offset, src,
+        count * sizeof(CudaDataType), cudaMemcpyHostToDevice));
+    ++stateVersion;
+  }
+
   std::string name() const override;
   NVQIR_SIMULATOR_CLONE_IMPL(CuStateVecCircuitSimulator<ScalarType>)
 };
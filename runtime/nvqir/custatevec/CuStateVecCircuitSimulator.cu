@@ -12,11 +12,19 @@
 #include "cuComplex.h"
 #include "device_launch_parameters.h"
 #include "CuStateVecCircuitSimulator.h"
+#include <curand_kernel.h>
 #include <thrust/complex.h>
 #include <thrust/device_ptr.h>
 #include <thrust/device_vector.h>
 #include <thrust/host_vector.h>
+#include <thrust/execution_policy.h>
+#include <thrust/for_each.h>
 #include <thrust/inner_product.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
 
 namespace nvqir {
 
@@ -242,4 +250,197 @@ innerProduct(void *devicePtr, void *otherPtr, std::size_t size, bool createDevic
 template complexValue<float> 
 innerProduct(void *devicePtr, void *otherPtr, std::size_t size, bool createDeviceAlloc);
 
+/// @brief Custom functor for an entry of `<psi|P|psi>`, without the phase of
+/// the Y operators, promoted to double precision.
+template <typename ScalarType>
+struct PauliStringEntry {
+  const thrust::complex<ScalarType> *sv;
+  int64_t xMask;
+  int64_t zMask;
+  __device__ thrust::complex<double> operator()(int64_t k) const {
+    const auto entry = thrust::conj(thrust::complex<double>(sv[k ^ xMask])) *
+                       thrust::complex<double>(sv[k]);
+    return (__popcll(k & zMask) & 1) ? -entry : entry;
+  }
+};
+
+template <typename ScalarType>
+std::vector<double> pauliExpectations(const void *devicePtr, std::size_t size,
+                                      const std::vector<int64_t> &xMasks,
+                                      const std::vector<int64_t> &zMasks) {
+  const auto *sv = reinterpret_cast<const thrust::complex<ScalarType> *>(
+      devicePtr);
+  std::vector<double> expVals(xMasks.size());
+  for (std::size_t i = 0; i < xMasks.size(); ++i) {
+    const thrust::complex<double> sum = thrust::transform_reduce(
+        thrust::device, thrust::counting_iterator<int64_t>(0),
+        thrust::counting_iterator<int64_t>(size),
+        PauliStringEntry<ScalarType>{sv, xMasks[i], zMasks[i]},
+        thrust::complex<double>(0.0), thrust::plus<thrust::complex<double>>());
+    // Y = iXZ: apply the phase i^(number of Y operators).
+    switch (__builtin_popcountll(xMasks[i] & zMasks[i]) % 4) {
+    case 0:
+      expVals[i] = sum.real();
+      break;
+    case 1:
+      expVals[i] = -sum.imag();
+      break;
+    case 2:
+      expVals[i] = -sum.real();
+      break;
+    default:
+      expVals[i] = sum.imag();
+    }
+  }
+  return expVals;
+}
+
+template std::vector<double>
+pauliExpectations<double>(const void *devicePtr, std::size_t size,
+                          const std::vector<int64_t> &xMasks,
+                          const std::vector<int64_t> &zMasks);
+
+template std::vector<double>
+pauliExpectations<float>(const void *devicePtr, std::size_t size,
+                         const std::vector<int64_t> &xMasks,
+                         const std::vector<int64_t> &zMasks);
+
+template <typename ScalarType>
+void scatterElements(void *deviceStateVector,
+                     const std::vector<int64_t> &indices,
+                     const std::vector<std::complex<double>> &values) {
+  thrust::host_vector<thrust::complex<ScalarType>> hostValues(values.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    hostValues[i] = thrust::complex<ScalarType>(values[i].real(),
+                                                values[i].imag());
+  thrust::device_vector<thrust::complex<ScalarType>> deviceValues(hostValues);
+  thrust::device_vector<int64_t> deviceIndices(indices.begin(), indices.end());
+  thrust::device_ptr<thrust::complex<ScalarType>> sv(
+      reinterpret_cast<thrust::complex<ScalarType> *>(deviceStateVector));
+  thrust::scatter(thrust::device, deviceValues.begin(), deviceValues.end(),
+                  deviceIndices.begin(), sv);
+}
+
+template void
+scatterElements<double>(void *deviceStateVector,
+                        const std::vector<int64_t> &indices,
+                        const std::vector<std::complex<double>> &values);
+
+template void
+scatterElements<float>(void *deviceStateVector,
+                       const std::vector<int64_t> &indices,
+                       const std::vector<std::complex<double>> &values);
+
+/// @brief Custom functor for the `i`-th diagonal element of an interleaved
+/// density matrix, whose row and column indices both equal `i`.
+template <typename ScalarType>
+struct DiagonalEntry {
+  const thrust::complex<ScalarType> *rho;
+  __device__ double operator()(int64_t i) const {
+    int64_t index = 0;
+    for (int bit = 0; (i >> bit) != 0; ++bit)
+      index |= ((i >> bit) & 1) << (2 * bit);
+    return rho[3 * index].real();
+  }
+};
+
+template <typename ScalarType>
+std::vector<double> densityMatrixDiagonal(const void *devicePtr,
+                                          std::size_t numQubits) {
+  const auto *rho = reinterpret_cast<const thrust::complex<ScalarType> *>(
+      devicePtr);
+  thrust::device_vector<double> diagonal(1ULL << numQubits);
+  thrust::transform(thrust::device, thrust::counting_iterator<int64_t>(0),
+                    thrust::counting_iterator<int64_t>(diagonal.size()),
+                    diagonal.begin(), DiagonalEntry<ScalarType>{rho});
+  std::vector<double> result(diagonal.size());
+  thrust::copy(diagonal.begin(), diagonal.end(), result.begin());
+  return result;
+}
+
+template std::vector<double>
+densityMatrixDiagonal<double>(const void *devicePtr, std::size_t numQubits);
+
+template std::vector<double>
+densityMatrixDiagonal<float>(const void *devicePtr, std::size_t numQubits);
+
+/// @brief Custom functor multiplying the amplitude of basis state `k` by the
+/// phase of the diagonal Pauli rotations exp(i theta_j Z...Z) with the given Z
+/// bit masks.
+template <typename ScalarType>
+struct DiagonalPauliPhase {
+  thrust::complex<ScalarType> *sv;
+  const int64_t *zMasks;
+  const double *thetas;
+  int64_t numTerms;
+  __device__ void operator()(int64_t k) const {
+    double angle = 0.0;
+    for (int64_t j = 0; j < numTerms; ++j)
+      angle += (__popcll(k & zMasks[j]) & 1) ? -thetas[j] : thetas[j];
+    double sinAngle, cosAngle;
+    sincos(angle, &sinAngle, &cosAngle);
+    sv[k] *= thrust::complex<ScalarType>(cosAngle, sinAngle);
+  }
+};
+
+template <typename ScalarType>
+void applyDiagonalPauliRotations(void *deviceStateVector, std::size_t size,
+                                 const std::vector<int64_t> &zMasks,
+                                 const std::vector<double> &thetas) {
+  thrust::device_vector<int64_t> deviceMasks(zMasks.begin(), zMasks.end());
+  thrust::device_vector<double> deviceThetas(thetas.begin(), thetas.end());
+  thrust::for_each(
+      thrust::device, thrust::counting_iterator<int64_t>(0),
+      thrust::counting_iterator<int64_t>(size),
+      DiagonalPauliPhase<ScalarType>{
+          reinterpret_cast<thrust::complex<ScalarType> *>(deviceStateVector),
+          thrust::raw_pointer_cast(deviceMasks.data()),
+          thrust::raw_pointer_cast(deviceThetas.data()),
+          static_cast<int64_t>(zMasks.size())});
+}
+
+template void
+applyDiagonalPauliRotations<double>(void *deviceStateVector, std::size_t size,
+                                    const std::vector<int64_t> &zMasks,
+                                    const std::vector<double> &thetas);
+
+template void
+applyDiagonalPauliRotations<float>(void *deviceStateVector, std::size_t size,
+                                   const std::vector<int64_t> &zMasks,
+                                   const std::vector<double> &thetas);
+
+/// @brief Kernel drawing `n` standard exponential variates. Variate `i` is
+/// the first draw of subsequence `i` of the counter-based Philox generator, so
+/// that the variates do not depend on the launch configuration.
+__global__ void cudaExponentialVariates(double *out, int64_t n,
+                                        uint64_t seed) {
+  int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i < n) {
+    curandStatePhilox4_32_10_t state;
+    curand_init(seed, i, 0, &state);
+    // curand_uniform_double draws from (0, 1], so the logarithm is finite.
+    out[i] = -log(curand_uniform_double(&state));
+  }
+}
+
+/// @brief Custom functor dividing by the value pointed to by `total`.
+struct DivideByTotal {
+  const double *total;
+  __device__ double operator()(double x) const { return x / *total; }
+};
+
+void sortedUniformRandomValues(double *deviceValues, std::size_t count,
+                               uint64_t seed) {
+  // The partial sums of `count + 1` exponential variates, normalized by their
+  // total, are distributed as the order statistics of `count` uniform
+  // variates in [0, 1): no sort is needed.
+  const int64_t n = count + 1;
+  constexpr int32_t threadsPerBlock = 256;
+  const uint32_t nBlocks = (n + threadsPerBlock - 1) / threadsPerBlock;
+  cudaExponentialVariates<<<nBlocks, threadsPerBlock>>>(deviceValues, n, seed);
+  thrust::inclusive_scan(thrust::device, deviceValues, deviceValues + n,
+                         deviceValues);
+  thrust::transform(thrust::device, deviceValues, deviceValues + count,
+                    deviceValues, DivideByTotal{deviceValues + count});
+}
 }
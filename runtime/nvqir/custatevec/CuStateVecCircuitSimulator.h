@@ -7,10 +7,12 @@
  ******************************************************************************/
 
 #pragma once
+#include <complex>
 #include <cstddef>
 #include <stdint.h>
 #include <thrust/complex.h>
 #include <thrust/device_ptr.h>
+#include <vector>
 
 namespace nvqir {
 
@@ -40,4 +42,40 @@ template <typename ScalarType>
 complexValue<ScalarType> innerProduct(void *devicePtr, void *otherPtr,
                                       std::size_t size, bool createDeviceAlloc);
 
+/// @brief Compute the expectation value of each of the Pauli strings given by
+/// their X and Z bit masks (Y sets both) on the state vector, accumulating in
+/// double precision regardless of the precision of the state.
+template <typename ScalarType>
+std::vector<double> pauliExpectations(const void *devicePtr, std::size_t size,
+                                      const std::vector<int64_t> &xMasks,
+                                      const std::vector<int64_t> &zMasks);
+
+/// @brief Set the elements of the device state vector at the given indices to
+/// the given values, leaving the other elements unchanged.
+template <typename ScalarType>
+void scatterElements(void *deviceStateVector,
+                     const std::vector<int64_t> &indices,
+                     const std::vector<std::complex<double>> &values);
+
+/// @brief Return the diagonal of the density matrix of `numQubits` qubits,
+/// stored as a vector of `2 * numQubits` index bits with the row bit of qubit
+/// `q` at bit `2q` and its column bit at bit `2q + 1`, in double precision.
+template <typename ScalarType>
+std::vector<double> densityMatrixDiagonal(const void *devicePtr,
+                                          std::size_t numQubits);
+
+/// @brief Apply the diagonal Pauli rotations exp(i thetas[j] Z...Z), where
+/// the Z operators of term `j` act on the bits set in `zMasks[j]`, to the
+/// state vector in a single pass, accumulating the phases in double precision.
+template <typename ScalarType>
+void applyDiagonalPauliRotations(void *deviceStateVector, std::size_t size,
+                                 const std::vector<int64_t> &zMasks,
+                                 const std::vector<double> &thetas);
+
+/// @brief Fill `deviceValues` with `count` uniform random values in [0, 1),
+/// sorted in ascending order, generated on the device from `seed`. The device
+/// buffer must hold `count + 1` values, the last of which is used as scratch.
+void sortedUniformRandomValues(double *deviceValues, std::size_t count,
+                               uint64_t seed);
+
 } // namespace nvqir
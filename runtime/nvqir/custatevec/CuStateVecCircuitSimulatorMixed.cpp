@@ -0,0 +1,22 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// Single-precision state vector, with expectation values accumulated in
+// double precision.
+#define __NVQIR_CUSTATEVEC_TOGGLE_CREATE
+#define __NVQIR_CUSTATEVEC_MIXED_PRECISION
+#include "CuStateVecCircuitSimulator.cpp"
+/// Register this Simulator with NVQIR.
+template <>
+std::string CuStateVecCircuitSimulator<float>::name() const {
+  return "custatevec-mixed";
+}
+NVQIR_REGISTER_SIMULATOR(CuStateVecCircuitSimulator<float>, custatevec_mixed)
+
+#undef __NVQIR_CUSTATEVEC_MIXED_PRECISION
+#undef __NVQIR_CUSTATEVEC_TOGGLE_CREATE
@@ -0,0 +1,389 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#define __NVQIR_CUSTATEVEC_TOGGLE_CREATE
+#include "CuStateVecCircuitSimulator.cpp"
+#include <bit>
+
+namespace {
+
+/// @brief The CuStateVecDensityMatrixSimulator simulates noisy circuits
+/// exactly on the GPU. The density matrix of `n` qubits is stored as a vector
+/// of `2n` index bits, the row bit of qubit `q` at bit `2q` and its column
+/// bit at bit `2q + 1`, so that a gate `U` is applied by cuStateVec as `U` on
+/// the row bits and `conj(U)` on the column bits. Kraus channels are applied
+/// in a single pass as their superoperator `sum_i K_i (x) conj(K_i)`, and all
+/// the channels attached to a gate are multiplied into one superoperator.
+class CuStateVecDensityMatrixSimulator
+    : public CuStateVecCircuitSimulator<double> {
+protected:
+  using Base = CuStateVecCircuitSimulator<double>;
+  using GateApplicationTask =
+      nvqir::CircuitSimulatorBase<double>::GateApplicationTask;
+
+  /// @brief Gates without controls on up to this many qubits are applied on
+  /// the row and column bits at once, as a single superoperator.
+  static constexpr std::size_t maxSuperoperatorGateQubits = 2;
+
+  /// @brief Return the row (or column) index bits of the given qubits.
+  static std::vector<int> indexBits(const std::vector<std::size_t> &qubits,
+                                    bool column) {
+    std::vector<int> bits;
+    bits.reserve(qubits.size());
+    for (auto q : qubits)
+      bits.push_back(static_cast<int>(2 * q + (column ? 1 : 0)));
+    return bits;
+  }
+
+  /// @brief Return the row bits of the given qubits followed by their column
+  /// bits, the targets of a superoperator on these qubits.
+  static std::vector<int>
+  superoperatorBits(const std::vector<std::size_t> &qubits) {
+    auto bits = indexBits(qubits, /*column=*/false);
+    const auto columnBits = indexBits(qubits, /*column=*/true);
+    bits.insert(bits.end(), columnBits.begin(), columnBits.end());
+    return bits;
+  }
+
+  /// @brief Add `op (x) conj(op)` to the superoperator `super` of dimension
+  /// `dim * dim`, where `op` is a row-major matrix of dimension `dim`. The
+  /// superoperator index of row `r` and column `c` is `r + c * dim`.
+  template <typename Matrix>
+  static void addSuperoperator(DataVector &super, const Matrix &op,
+                               std::size_t dim) {
+    const std::size_t superDim = dim * dim;
+    super.resize(superDim * superDim, 0.0);
+    for (std::size_t rOut = 0; rOut < dim; ++rOut)
+      for (std::size_t cOut = 0; cOut < dim; ++cOut)
+        for (std::size_t r = 0; r < dim; ++r)
+          for (std::size_t c = 0; c < dim; ++c)
+            super[(rOut + cOut * dim) * superDim + r + c * dim] +=
+                DataType(op[rOut * dim + r]) *
+                std::conj(DataType(op[cOut * dim + c]));
+  }
+
+  /// @brief Return the product `a * b` of two square row-major matrices.
+  static DataVector multiply(const DataVector &a, const DataVector &b) {
+    const auto dim = static_cast<std::size_t>(std::sqrt(a.size()));
+    DataVector product(dim * dim, 0.0);
+    for (std::size_t i = 0; i < dim; ++i)
+      for (std::size_t k = 0; k < dim; ++k)
+        for (std::size_t j = 0; j < dim; ++j)
+          product[i * dim + j] += a[i * dim + k] * b[k * dim + j];
+    return product;
+  }
+
+  /// @brief Apply the superoperator `super` on the given qubits, listed in
+  /// the MSB ordering of Kraus operators.
+  void applySuperoperator(const DataVector &super,
+                          const std::vector<std::size_t> &qubits) {
+    // Kraus operators use the MSB qubit ordering, custatevec the LSB one.
+    const std::vector<std::size_t> targets(qubits.rbegin(), qubits.rend());
+    applyGateMatrix(super, {}, superoperatorBits(targets));
+  }
+
+  /// @brief Return the superoperator of the given channel.
+  static DataVector superoperator(const cudaq::kraus_channel &channel) {
+    DataVector super;
+    for (const auto &op : channel.get_ops())
+      addSuperoperator(super, op.data, op.nRows);
+    return super;
+  }
+
+  /// @brief The density matrix is a vector of `2n` index bits.
+  std::size_t calculateStateDim(const std::size_t numQubits) override {
+    if (numQubits < 32)
+      return 1ULL << (2 * numQubits);
+    throw std::runtime_error("number of qubits exceeds maximum (31)");
+  }
+
+  /// @brief Increase the state size by the given number of qubits, in the
+  /// state `|psi><psi|` if `stateIn` holds the state vector `psi`.
+  void addQubitsToState(std::size_t count, const void *stateIn) override {
+    if (!stateIn) {
+      Base::addQubitsToState(2 * count, nullptr);
+      return;
+    }
+    const auto *psi = reinterpret_cast<const DataType *>(stateIn);
+    const std::size_t dim = 1ULL << count;
+    const auto interleave = [](std::size_t i, unsigned offset) {
+      std::size_t index = 0;
+      for (std::size_t bit = 0; (i >> bit) != 0; ++bit)
+        index |= ((i >> bit) & 1) << (2 * bit + offset);
+      return index;
+    };
+    DataVector rho(dim * dim);
+    for (std::size_t r = 0; r < dim; ++r)
+      for (std::size_t c = 0; c < dim; ++c)
+        rho[interleave(r, 0) | interleave(c, 1)] = psi[r] * std::conj(psi[c]);
+    Base::addQubitsToState(2 * count, rho.data());
+  }
+
+  void addQubitsToState(const cudaq::SimulationState &in_state) override {
+    throw std::runtime_error("The custatevec density matrix simulator does "
+                             "not support initialization of qubits from a "
+                             "simulation state.");
+  }
+
+  /// @brief Apply the gate as `U (x) conj(U)`, in one pass for small gates
+  /// without controls and as `U` on the row bits followed by `conj(U)` on the
+  /// column bits otherwise.
+  void applyGate(const GateApplicationTask &task) override {
+    if (task.controls.empty() &&
+        task.targets.size() <= maxSuperoperatorGateQubits) {
+      DataVector super;
+      addSuperoperator(super, task.matrix, 1ULL << task.targets.size());
+      applyGateMatrix(super, {}, superoperatorBits(task.targets));
+      return;
+    }
+    applyGateMatrix(task.matrix, indexBits(task.controls, /*column=*/false),
+                    indexBits(task.targets, /*column=*/false));
+    DataVector conjugate(task.matrix.size());
+    std::transform(task.matrix.begin(), task.matrix.end(), conjugate.begin(),
+                   [](const DataType &el) { return std::conj(el); });
+    applyGateMatrix(conjugate, indexBits(task.controls, /*column=*/true),
+                    indexBits(task.targets, /*column=*/true));
+  }
+
+  double getProbabilityOfOne(const std::size_t qubitIdx) override {
+    const auto diagonal = nvqir::densityMatrixDiagonal<double>(
+        deviceStateVector, nQubitsAllocated);
+    double probOne = 0.0;
+    for (std::size_t i = 0; i < diagonal.size(); ++i)
+      if ((i >> qubitIdx) & 1)
+        probOne += diagonal[i];
+    return probOne;
+  }
+
+  /// @brief Collapse the density matrix onto the measurement `outcome`, as
+  /// `P rho P / probability` for the projector `P` onto the outcome.
+  void collapseQubit(const std::size_t qubitIdx, bool outcome,
+                     double probability) override {
+    DataVector projector(16, 0.0);
+    const std::size_t index = outcome ? 3 : 0;
+    projector[index * 4 + index] = 1.0 / probability;
+    applyGateMatrix(projector, {}, superoperatorBits({qubitIdx}));
+  }
+
+public:
+  CuStateVecDensityMatrixSimulator() {
+    // The density matrix evolves deterministically under noise, which allows
+    // the shots to be batched by measurement branches.
+    this->simulatesNoiseAsTrajectories = false;
+    // The phase kernel of the state vector does not apply to the density
+    // matrix.
+    this->supportsDiagonalGateRuns = false;
+    // Neither do the batched state vectors of a sample broadcast.
+    this->supportsBatchedSampling = false;
+    // Nor do the state vector checkpoints.
+    this->supportsCheckpoints = false;
+    this->supportsMeasurementBranching = true;
+  }
+  virtual ~CuStateVecDensityMatrixSimulator() = default;
+
+  /// @brief Apply the noise channels registered for the given gate, as the
+  /// product of their superoperators.
+  void applyNoiseChannel(const std::string_view gateName,
+                         const std::vector<std::size_t> &controls,
+                         const std::vector<std::size_t> &targets,
+                         const std::vector<double> &params) override {
+    if (!executionContext || !executionContext->noiseModel)
+      return;
+    std::vector<std::size_t> qubits(controls.begin(), controls.end());
+    qubits.insert(qubits.end(), targets.begin(), targets.end());
+    DataVector super;
+    std::size_t numChannels = 0;
+    executionContext->noiseModel->for_each_channel(
+        gateName, targets, controls, params,
+        [&](const cudaq::kraus_channel &channel) {
+          if (channel.empty())
+            return;
+          auto channelSuper = superoperator(channel);
+          super = super.empty() ? std::move(channelSuper)
+                                : multiply(channelSuper, super);
+          ++numChannels;
+        });
+    if (!super.empty()) {
+      CUDAQ_INFO("[custatevec-dm] apply {} kraus channels of {} on {}",
+                 numChannels, gateName, qubits);
+      applySuperoperator(super, qubits);
+    }
+    executionContext->noiseModel->for_each_crosstalk_channel(
+        gateName, targets, controls,
+        [&](const cudaq::noise_model::crosstalk_channel &crosstalk,
+            const std::vector<std::size_t> &spectators) {
+          const auto channelSuper = superoperator(crosstalk.channel);
+          for (auto qubit : spectators)
+            applySuperoperator(channelSuper, {qubit});
+        });
+  }
+
+  void applyNoise(const cudaq::kraus_channel &channel,
+                  const std::vector<std::size_t> &qubits) override {
+    flushGateQueue();
+    CUDAQ_INFO("[custatevec-dm] apply kraus channel {}",
+               channel.get_type_name());
+    applySuperoperator(superoperator(channel), qubits);
+  }
+
+  bool measureQubit(const std::size_t qubitIdx) override {
+    const double probOne = getProbabilityOfOne(qubitIdx);
+    const bool outcome = randomValues(1, 1.0)[0] < probOne;
+    collapseQubit(qubitIdx, outcome, outcome ? probOne : 1.0 - probOne);
+    CUDAQ_INFO("Measured qubit {} -> {}", qubitIdx, outcome);
+    return outcome;
+  }
+
+  /// @brief Reset the qubit with the channel `{|0><0|, |0><1|}`, without
+  /// measuring it.
+  void resetQubit(const std::size_t qubitIdx) override {
+    flushGateQueue();
+    this->flushAnySamplingTasks();
+    DataVector super;
+    addSuperoperator(super, DataVector{1.0, 0.0, 0.0, 0.0}, 2);
+    addSuperoperator(super, DataVector{0.0, 1.0, 0.0, 0.0}, 2);
+    applySuperoperator(super, {qubitIdx});
+  }
+
+  /// @brief The phase kernel of the state-vector batch does not apply to the
+  /// density matrix, so the rotations of a batch are applied one by one.
+  void
+  applyExpPauliBatch(const std::vector<double> &thetas,
+                     const std::vector<std::size_t> &qubits,
+                     const std::vector<cudaq::spin_op_term> &terms) override {
+    if (this->isInTracerMode()) {
+      nvqir::CircuitSimulator::applyExpPauliBatch(thetas, qubits, terms);
+      return;
+    }
+    if (thetas.size() != terms.size())
+      throw std::invalid_argument(
+          "exp_pauli batch requires one angle per Pauli word - got " +
+          std::to_string(thetas.size()) + " angles and " +
+          std::to_string(terms.size()) + " words");
+    for (std::size_t k = 0; k < terms.size(); ++k)
+      applyExpPauli(thetas[k], {}, qubits, terms[k]);
+  }
+
+  /// @brief Apply `exp(i theta P)` on the row bits and its conjugate,
+  /// `exp(-i theta conj(P))`, on the column bits.
+  void applyExpPauli(double theta, const std::vector<std::size_t> &controlIds,
+                     const std::vector<std::size_t> &qubits,
+                     const cudaq::spin_op_term &term) override {
+    if (this->isInTracerMode()) {
+      nvqir::CircuitSimulator::applyExpPauli(theta, controlIds, qubits, term);
+      return;
+    }
+    flushGateQueue();
+    if (term.num_ops() != qubits.size())
+      throw std::runtime_error(
+          "incorrect number of qubits for exp_pauli - expecting " +
+          std::to_string(term.num_ops()) + " qubits");
+
+    std::vector<custatevecPauli_t> paulis;
+    std::size_t numY = 0;
+    for (const auto &op : term) {
+      auto pauli = op.as_pauli();
+      if (pauli == cudaq::pauli::I)
+        paulis.push_back(custatevecPauli_t::CUSTATEVEC_PAULI_I);
+      else if (pauli == cudaq::pauli::X)
+        paulis.push_back(custatevecPauli_t::CUSTATEVEC_PAULI_X);
+      else if (pauli == cudaq::pauli::Y)
+        paulis.push_back(custatevecPauli_t::CUSTATEVEC_PAULI_Y);
+      else
+        paulis.push_back(custatevecPauli_t::CUSTATEVEC_PAULI_Z);
+      numY += pauli == cudaq::pauli::Y;
+    }
+    // conj(Y) = -Y, while X and Z are real.
+    const double columnTheta = numY % 2 ? theta : -theta;
+    for (bool column : {false, true}) {
+      const auto targets = indexBits(qubits, column);
+      const auto controls = indexBits(controlIds, column);
+      HANDLE_ERROR(custatevecApplyPauliRotation(
+          handle, deviceStateVector, cuStateVecCudaDataType,
+          2 * nQubitsAllocated, column ? columnTheta : theta, paulis.data(),
+          targets.data(), targets.size(), controls.data(), nullptr,
+          controls.size()));
+    }
+    ++stateVersion;
+  }
+
+  /// @brief Expectation values are computed from the diagonal of the density
+  /// matrix, after the change of basis of each term.
+  bool canHandleObserve() override { return false; }
+
+  /// @brief Sample the given qubits from the diagonal of the density matrix.
+  /// Without shots, the exact expectation value of their parity is returned.
+  cudaq::ExecutionResult sample(const std::vector<std::size_t> &measuredBits,
+                                const int shots) override {
+    ScopedTraceWithContext(cudaq::TIMING_SAMPLE,
+                           "CuStateVecDensityMatrixSimulator::sample");
+    const auto diagonal = nvqir::densityMatrixDiagonal<double>(
+        deviceStateVector, nQubitsAllocated);
+    std::vector<double> marginal(1ULL << measuredBits.size(), 0.0);
+    for (std::size_t i = 0; i < diagonal.size(); ++i) {
+      std::size_t outcome = 0;
+      for (std::size_t b = 0; b < measuredBits.size(); ++b)
+        outcome |= ((i >> measuredBits[b]) & 1) << b;
+      marginal[outcome] += diagonal[i];
+    }
+
+    double expVal = 0.0;
+    if (shots < 1) {
+      for (std::size_t k = 0; k < marginal.size(); ++k)
+        expVal += std::popcount(k) % 2 ? -marginal[k] : marginal[k];
+      CUDAQ_INFO("Computed expectation value = {}", expVal);
+      return cudaq::ExecutionResult{expVal};
+    }
+
+    // Bit i of each packed shot holds the outcome of measuredBits[i].
+    std::discrete_distribution<std::uint64_t> distr(marginal.begin(),
+                                                    marginal.end());
+    cudaq::PackedShots packedShots(measuredBits.size());
+    packedShots.words.resize(shots);
+    for (auto &word : packedShots.words)
+      word = distr(randomEngine);
+
+    cudaq::ExecutionResult counts;
+    counts.appendPackedResults(std::move(packedShots));
+
+    // Compute the expectation value from the counts
+    for (auto &kv : counts.counts) {
+      auto par = cudaq::sample_result::has_even_parity(kv.first);
+      auto p = kv.second / (double)shots;
+      if (!par) {
+        p = -p;
+      }
+      expVal += p;
+    }
+
+    counts.expectationValue = expVal;
+    return counts;
+  }
+
+  std::unique_ptr<cudaq::SimulationState> getSimulationState() override {
+    throw std::runtime_error("The custatevec density matrix simulator does "
+                             "not support state retrieval, use the "
+                             "density-matrix-cpu target instead.");
+  }
+
+  bool isStateVectorSimulator() const override { return false; }
+
+  NVQIR_SIMULATOR_CLONE_IMPL(CuStateVecDensityMatrixSimulator)
+};
+} // namespace
+
+/// The state vector simulator only serves as the base of the density matrix
+/// simulator in this library.
+template <>
+std::string CuStateVecCircuitSimulator<double>::name() const {
+  return "custatevec-dm";
+}
+/// Register this Simulator with NVQIR.
+NVQIR_REGISTER_SIMULATOR(CuStateVecDensityMatrixSimulator, custatevec_dm)
+
+#undef __NVQIR_CUSTATEVEC_TOGGLE_CREATE
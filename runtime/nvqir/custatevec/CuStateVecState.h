@@ -11,6 +11,7 @@
 #include "common/SimulationState.h"
 #include "common/cudaq_fmt.h"
 
+#include <cublas_v2.h>
 #include <thrust/complex.h>
 #include <thrust/device_ptr.h>
 #include <thrust/device_vector.h>
@@ -37,6 +38,16 @@
     }                                                                          \
   };
 
+#define HANDLE_CUBLAS_ERROR(x)                                                 \
+  {                                                                            \
+    const auto err = x;                                                        \
+    if (err != CUBLAS_STATUS_SUCCESS) {                                        \
+      throw std::runtime_error(                                                \
+          cudaq_fmt::format("[custatevec] cublas error {} in {} (line {})",    \
+                            static_cast<int>(err), __FUNCTION__, __LINE__));   \
+    }                                                                          \
+  };
+
 namespace cudaq {
 
 /// @brief CusvState provides an implementation of `SimulationState` that
@@ -78,6 +89,15 @@ private:
         cudaMemcpyDeviceToHost));
   }
 
+  /// @brief Check that the range of elements is within the state.
+  void checkRange(std::size_t offset, std::size_t numElements) const {
+    if (offset > size || numElements > size - offset)
+      throw std::runtime_error(cudaq_fmt::format(
+          "[custatevec-state] invalid range of {} elements from {} requested "
+          "from a state of {} elements.",
+          numElements, offset, size));
+  }
+
   /// @brief Return true if the given pointer is a GPU device pointer
   bool isDevicePointer(void *ptr) const {
     cudaPointerAttributes attributes;
@@ -158,6 +178,111 @@ public:
     }
   }
 
+  /// @brief Compute all the overlaps with a single matrix product: the state
+  /// vectors are packed as the columns of a matrix of bras and a matrix of
+  /// kets, and `bras^H kets` is computed with cuBLAS. States that do not all
+  /// fit on the device at once are packed and multiplied in tiles. States of
+  /// another type, precision, dimension or device are overlapped pair by pair.
+  std::vector<std::complex<double>>
+  overlapMatrix(const std::vector<SimulationState *> &bras,
+                const std::vector<SimulationState *> &kets) override {
+    std::vector<const CusvState *> braStates, ketStates;
+    const auto castStates = [&](const std::vector<SimulationState *> &states,
+                                std::vector<const CusvState *> &cast) {
+      for (auto *state : states) {
+        const auto *cusvState = dynamic_cast<const CusvState *>(state);
+        if (!cusvState || cusvState->size != size ||
+            cusvState->getDeviceId() != getDeviceId())
+          return false;
+        cast.push_back(cusvState);
+      }
+      return true;
+    };
+    if (!castStates(bras, braStates) || !castStates(kets, ketStates))
+      return SimulationState::overlapMatrix(bras, kets);
+
+    checkAndSetDevice();
+    using CudaDataType =
+        std::conditional_t<std::is_same_v<ScalarType, float>, cuFloatComplex,
+                           cuDoubleComplex>;
+    const std::size_t numBras = braStates.size(), numKets = ketStates.size();
+    const std::size_t vectorBytes = size * sizeof(CudaDataType);
+
+    // Tile the states so that the packed tiles use at most half of the free
+    // device memory.
+    std::size_t freeBytes = 0, totalBytes = 0;
+    HANDLE_CUDA_ERROR(cudaMemGetInfo(&freeBytes, &totalBytes));
+    const std::size_t resultBytes = numBras * numKets * sizeof(CudaDataType);
+    const std::size_t tileSize = std::max<std::size_t>(
+        1, (freeBytes > 2 * resultBytes ? freeBytes / 2 - resultBytes : 0) /
+               (2 * vectorBytes));
+    const std::size_t braTileSize = std::min(tileSize, numBras);
+    const std::size_t ketTileSize = std::min(tileSize, numKets);
+    CUDAQ_INFO("[custatevec-state] computing {} x {} overlaps in tiles of {} "
+               "x {} states.",
+               numBras, numKets, braTileSize, ketTileSize);
+
+    CudaDataType *packedBras = nullptr, *packedKets = nullptr,
+                 *deviceOverlaps = nullptr;
+    HANDLE_CUDA_ERROR(cudaMalloc((void **)&packedBras,
+                                 braTileSize * vectorBytes));
+    HANDLE_CUDA_ERROR(cudaMalloc((void **)&packedKets,
+                                 ketTileSize * vectorBytes));
+    HANDLE_CUDA_ERROR(cudaMalloc((void **)&deviceOverlaps, resultBytes));
+    cublasHandle_t handle;
+    HANDLE_CUBLAS_ERROR(cublasCreate(&handle));
+
+    const auto pack = [&](const std::vector<const CusvState *> &states,
+                          std::size_t begin, std::size_t end,
+                          CudaDataType *packed) {
+      for (std::size_t i = begin; i < end; ++i)
+        HANDLE_CUDA_ERROR(cudaMemcpyAsync(packed + (i - begin) * size,
+                                          states[i]->devicePtr, vectorBytes,
+                                          cudaMemcpyDeviceToDevice));
+    };
+    const CudaDataType one{1.0, 0.0}, zero{0.0, 0.0};
+    // The overlaps are computed as the column-major `numBras` x `numKets`
+    // matrix `bras^H kets`.
+    for (std::size_t braBegin = 0; braBegin < numBras;
+         braBegin += braTileSize) {
+      const std::size_t braEnd = std::min(numBras, braBegin + braTileSize);
+      pack(braStates, braBegin, braEnd, packedBras);
+      for (std::size_t ketBegin = 0; ketBegin < numKets;
+           ketBegin += ketTileSize) {
+        const std::size_t ketEnd = std::min(numKets, ketBegin + ketTileSize);
+        if (ketTileSize < numKets || braBegin == 0)
+          pack(ketStates, ketBegin, ketEnd, packedKets);
+        auto *tile = deviceOverlaps + braBegin + ketBegin * numBras;
+        const int m = braEnd - braBegin, n = ketEnd - ketBegin, k = size;
+        if constexpr (std::is_same_v<ScalarType, float>) {
+          HANDLE_CUBLAS_ERROR(cublasCgemm(handle, CUBLAS_OP_C, CUBLAS_OP_N, m,
+                                          n, k, &one, packedBras, k,
+                                          packedKets, k, &zero, tile,
+                                          numBras));
+        } else {
+          HANDLE_CUBLAS_ERROR(cublasZgemm(handle, CUBLAS_OP_C, CUBLAS_OP_N, m,
+                                          n, k, &one, packedBras, k,
+                                          packedKets, k, &zero, tile,
+                                          numBras));
+        }
+      }
+    }
+
+    std::vector<std::complex<ScalarType>> columnMajor(numBras * numKets);
+    HANDLE_CUDA_ERROR(cudaMemcpy(columnMajor.data(), deviceOverlaps,
+                                 resultBytes, cudaMemcpyDeviceToHost));
+    HANDLE_CUBLAS_ERROR(cublasDestroy(handle));
+    HANDLE_CUDA_ERROR(cudaFree(packedBras));
+    HANDLE_CUDA_ERROR(cudaFree(packedKets));
+    HANDLE_CUDA_ERROR(cudaFree(deviceOverlaps));
+
+    std::vector<std::complex<double>> overlaps(numBras * numKets);
+    for (std::size_t i = 0; i < numBras; ++i)
+      for (std::size_t j = 0; j < numKets; ++j)
+        overlaps[i * numKets + j] = std::abs(columnMajor[i + j * numBras]);
+    return overlaps;
+  }
+
   std::complex<double>
   getAmplitude(const std::vector<int> &basisState) override {
     if (getNumQubits() != basisState.size())
@@ -196,6 +321,8 @@ public:
   /// @brief This state is GPU device data, always return true.
   bool isDeviceData() const override { return true; }
 
+  int getDeviceId() const override { return deviceFromPointer(devicePtr); }
+
   /// @brief Return the device pointer
   const void *getDevicePointer() const { return devicePtr; }
 
@@ -216,6 +343,27 @@ public:
     return std::make_unique<CusvState<ScalarType>>(size, ptr, weOwnTheData);
   }
 
+  std::unique_ptr<SimulationState>
+  createFromSparseData(const cudaq::sparse_state_data &data) override {
+    const std::size_t dim = validateSparseData(data);
+    std::complex<ScalarType> *ptr = nullptr;
+    HANDLE_CUDA_ERROR(
+        cudaMalloc((void **)&ptr, dim * sizeof(std::complex<ScalarType>)));
+    HANDLE_CUDA_ERROR(
+        cudaMemset(ptr, 0, dim * sizeof(std::complex<ScalarType>)));
+    std::vector<int64_t> indices;
+    std::vector<std::complex<double>> values;
+    indices.reserve(data.amplitudes.size());
+    values.reserve(data.amplitudes.size());
+    for (const auto &[index, amplitude] : data.amplitudes) {
+      indices.push_back(index);
+      values.push_back(amplitude);
+    }
+    if (!indices.empty())
+      nvqir::scatterElements<ScalarType>(ptr, indices, values);
+    return std::make_unique<CusvState<ScalarType>>(dim, ptr, true);
+  }
+
   /// @brief Return the tensor at the given index. Throws
   /// for an invalid tensor index.
   Tensor getTensor(std::size_t tensorIdx = 0) const override {
@@ -281,6 +429,30 @@ public:
     return;
   }
 
+  /// @brief Copy a range of the state device data to the user-provided host
+  /// data pointer.
+  void toHostRange(std::complex<double> *userData, std::size_t offset,
+                   std::size_t numElements) const override {
+    if constexpr (std::is_same_v<ScalarType, float>)
+      throw std::runtime_error("simulation precision is FP32 but toHostRange "
+                               "requested with FP64 host buffer.");
+    checkRange(offset, numElements);
+    extractValues(reinterpret_cast<std::complex<ScalarType> *>(userData),
+                  offset, offset + numElements);
+  }
+
+  /// @brief Copy a range of the state device data to the user-provided host
+  /// data pointer.
+  void toHostRange(std::complex<float> *userData, std::size_t offset,
+                   std::size_t numElements) const override {
+    if constexpr (std::is_same_v<ScalarType, double>)
+      throw std::runtime_error("simulation precision is FP64 but toHostRange "
+                               "requested with FP32 host buffer.");
+    checkRange(offset, numElements);
+    extractValues(reinterpret_cast<std::complex<ScalarType> *>(userData),
+                  offset, offset + numElements);
+  }
+
   /// @brief Free the device data.
   void destroyState() override {
     if (!ownsDevicePtr)
@@ -0,0 +1,246 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/EigenDense.h"
+#include "cudaq/operators.h"
+#include "tensornet_state.h"
+#include "timing_utils.h"
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+
+namespace nvqir {
+
+/// @brief Left and right environments of a factorized MPS, used to evaluate
+/// the expectation values of many Pauli product terms.
+///
+/// The left environment `L[i]` is the contraction of `<psi|` and `|psi>`
+/// over sites `0, ..., i - 1`, and the right environment `R[i]` the one over
+/// sites `i, ..., N - 1`. Both are computed once, in a left-to-right and a
+/// right-to-left sweep. The expectation value of a term supported on sites
+/// `a, ..., b` is then obtained by transferring `L[a]` through sites `a` to
+/// `b` only, and closing it with `R[b + 1]`. A local Hamiltonian hence costs
+/// O(N) site contractions in total, instead of O(N) per term.
+template <typename ScalarType>
+class MPSEnvironments {
+  using Matrix =
+      Eigen::Matrix<std::complex<ScalarType>, Eigen::Dynamic, Eigen::Dynamic>;
+  using SiteMatrix = Eigen::Map<const Matrix, 0, Eigen::OuterStride<>>;
+  using PauliMatrix = std::array<std::complex<ScalarType>, 4>;
+
+  /// Host copy of the site tensors, as (left bond, physical, right bond)
+  /// column-major arrays.
+  std::vector<std::vector<std::complex<ScalarType>>> m_sites;
+  std::vector<std::pair<int64_t, int64_t>> m_bonds;
+  std::vector<Matrix> m_left;
+  std::vector<Matrix> m_right;
+
+  /// Max number of elements of the matrices of a batch of shots in `sample`.
+  static constexpr std::size_t g_maxSampleBatchElements = 1 << 22;
+
+  /// @brief The matrix `A^s` of the given site, for physical index `s`.
+  SiteMatrix siteMatrix(std::size_t site, int s) const {
+    const auto [leftBond, rightBond] = m_bonds[site];
+    return SiteMatrix(m_sites[site].data() + s * leftBond, leftBond, rightBond,
+                      Eigen::OuterStride<>(2 * leftBond));
+  }
+
+  /// @brief Transfer a left environment through the given site, with the
+  /// (row-major) single-qubit operator `op` acting on it.
+  Matrix transferLeft(const Matrix &env, std::size_t site,
+                      const PauliMatrix &op) const {
+    const auto rightBond = m_bonds[site].second;
+    Matrix result = Matrix::Zero(rightBond, rightBond);
+    for (int s = 0; s < 2; ++s) {
+      const Matrix envA = siteMatrix(site, s).adjoint() * env;
+      for (int t = 0; t < 2; ++t)
+        if (op[2 * s + t] != std::complex<ScalarType>(0.0))
+          result.noalias() += op[2 * s + t] * (envA * siteMatrix(site, t));
+    }
+    return result;
+  }
+
+  /// @brief Transfer a right environment through the given site.
+  Matrix transferRight(const Matrix &env, std::size_t site) const {
+    const auto leftBond = m_bonds[site].first;
+    Matrix result = Matrix::Zero(leftBond, leftBond);
+    for (int s = 0; s < 2; ++s) {
+      const auto a = siteMatrix(site, s);
+      result.noalias() += a.conjugate() * env * a.transpose();
+    }
+    return result;
+  }
+
+  static PauliMatrix pauliMatrix(cudaq::pauli pauli) {
+    switch (pauli) {
+    case cudaq::pauli::I:
+      return {1.0, 0.0, 0.0, 1.0};
+    case cudaq::pauli::X:
+      return {0.0, 1.0, 1.0, 0.0};
+    case cudaq::pauli::Y:
+      return {0.0, std::complex<ScalarType>(0.0, -1.0),
+              std::complex<ScalarType>(0.0, 1.0), 0.0};
+    case cudaq::pauli::Z:
+      return {1.0, 0.0, 0.0, -1.0};
+    }
+    __builtin_unreachable();
+  }
+
+public:
+  /// @brief Copy the given (device) MPS tensors, in qubit order, to the host
+  /// and compute all left and right environments.
+  MPSEnvironments(const std::vector<MPSTensor> &mpsTensors) {
+    LOG_API_TIME();
+    const std::size_t numSites = mpsTensors.size();
+    m_sites.resize(numSites);
+    m_bonds.resize(numSites);
+    for (std::size_t i = 0; i < numSites; ++i) {
+      const auto &extents = mpsTensors[i].extents;
+      // The boundary tensors only have one bond.
+      const int64_t leftBond = i == 0 ? 1 : extents.front();
+      const int64_t rightBond = i == numSites - 1 ? 1 : extents.back();
+      m_bonds[i] = {leftBond, rightBond};
+      m_sites[i].resize(leftBond * 2 * rightBond);
+      HANDLE_CUDA_ERROR(cudaMemcpy(
+          m_sites[i].data(), mpsTensors[i].deviceData,
+          m_sites[i].size() * sizeof(std::complex<ScalarType>),
+          cudaMemcpyDeviceToHost));
+    }
+
+    const auto identity = pauliMatrix(cudaq::pauli::I);
+    m_left.resize(numSites + 1);
+    m_left[0] = Matrix::Ones(1, 1);
+    for (std::size_t i = 0; i < numSites; ++i)
+      m_left[i + 1] = transferLeft(m_left[i], i, identity);
+    m_right.resize(numSites + 1);
+    m_right[numSites] = Matrix::Ones(1, 1);
+    for (std::size_t i = numSites; i-- > 0;)
+      m_right[i] = transferRight(m_right[i + 1], i);
+  }
+
+  /// @brief Draw shots of the given sites (in this order in the bit strings)
+  /// by perfect sampling of the MPS.
+  ///
+  /// The sites are sampled from left to right, each from its probabilities
+  /// conditioned on the outcomes already drawn, which are given by the
+  /// contraction of the drawn outcomes with the right environment of the
+  /// next site. A batch of shots is swept along the chain at once, so that
+  /// each site costs a few matrix products per batch. Sites right of the last
+  /// measured one are traced out by its right environment. The outcomes of the
+  /// unmeasured sites left of it are drawn as well, then discarded, which
+  /// samples the marginal distribution of the measured sites exactly.
+  std::unordered_map<std::string, std::size_t>
+  sample(const std::vector<int32_t> &measuredSites, std::size_t shots,
+         std::mt19937 &randomEngine) const {
+    LOG_API_TIME();
+    std::unordered_map<std::string, std::size_t> counts;
+    if (measuredSites.empty()) {
+      counts.emplace(std::string{}, shots);
+      return counts;
+    }
+    const std::size_t lastSite =
+        *std::max_element(measuredSites.begin(), measuredSites.end());
+    if (lastSite >= m_sites.size())
+      throw std::runtime_error("Cannot sample qubit " +
+                               std::to_string(lastSite) +
+                               ", which is outside of the state.");
+    // Position of each site in the bit strings, if it is measured.
+    std::vector<int64_t> positions(lastSite + 1, -1);
+    for (std::size_t i = 0; i < measuredSites.size(); ++i)
+      positions[measuredSites[i]] = i;
+
+    int64_t maxBond = 1;
+    for (const auto &bonds : m_bonds)
+      maxBond = std::max(maxBond, bonds.second);
+    const std::size_t batchSize =
+        std::max<std::size_t>(1, g_maxSampleBatchElements / maxBond);
+    std::uniform_real_distribution<ScalarType> uniform(0.0, 1.0);
+    std::vector<std::string> bitStrings;
+    for (std::size_t first = 0; first < shots; first += batchSize) {
+      const std::size_t batch = std::min(batchSize, shots - first);
+      bitStrings.assign(batch, std::string(measuredSites.size(), '0'));
+      // One row per shot: the contraction of the sites left of the current
+      // one with the outcomes drawn for them, normalized.
+      Matrix left = Matrix::Ones(batch, 1);
+      for (std::size_t site = 0; site <= lastSite; ++site) {
+        std::array<Matrix, 2> next;
+        std::array<Eigen::Vector<ScalarType, Eigen::Dynamic>, 2> probs;
+        for (int s = 0; s < 2; ++s) {
+          next[s] = left * siteMatrix(site, s);
+          probs[s] = (next[s].conjugate() * m_right[site + 1])
+                         .cwiseProduct(next[s])
+                         .rowwise()
+                         .sum()
+                         .real();
+        }
+        left.resize(batch, m_bonds[site].second);
+        for (std::size_t shot = 0; shot < batch; ++shot) {
+          const ScalarType prob0 = std::max<ScalarType>(probs[0](shot), 0.0);
+          const ScalarType prob1 = std::max<ScalarType>(probs[1](shot), 0.0);
+          const int s = uniform(randomEngine) * (prob0 + prob1) < prob0 ? 0 : 1;
+          const ScalarType prob = s == 0 ? prob0 : prob1;
+          left.row(shot) = next[s].row(shot);
+          if (prob > 0.0)
+            left.row(shot) /= std::sqrt(prob);
+          if (s == 1 && positions[site] >= 0)
+            bitStrings[shot][positions[site]] = '1';
+        }
+      }
+      for (const auto &bitString : bitStrings)
+        ++counts[bitString];
+    }
+    return counts;
+  }
+
+  /// @brief The squared norm `<psi|psi>` of the MPS.
+  ScalarType normSquared() const { return m_left.back()(0, 0).real(); }
+
+  /// @brief Compute the expectation value of each of the given product terms.
+  /// Like `TensorNetState::computeExpVals`, the values are not normalized by
+  /// the norm of the state.
+  std::vector<std::complex<ScalarType>>
+  computeExpVals(const std::vector<cudaq::spin_op_term> &product_terms) const {
+    LOG_API_TIME();
+    std::vector<std::complex<ScalarType>> allExpVals;
+    allExpVals.reserve(product_terms.size());
+    for (const auto &prod : product_terms) {
+      assert(prod.is_canonicalized());
+      const std::complex<double> coeff = prod.evaluate_coefficient();
+      std::vector<std::pair<std::size_t, cudaq::pauli>> paulis;
+      for (const auto &p : prod)
+        if (p.as_pauli() != cudaq::pauli::I)
+          paulis.emplace_back(p.target(), p.as_pauli());
+      if (paulis.empty()) {
+        allExpVals.emplace_back(coeff);
+        continue;
+      }
+      // Canonical terms are ordered by target.
+      const std::size_t first = paulis.front().first;
+      const std::size_t last = paulis.back().first;
+      if (last >= m_sites.size())
+        throw std::runtime_error("Observable term " + prod.to_string() +
+                                 " acts on a qubit outside of the state.");
+      Matrix env = m_left[first];
+      auto next = paulis.begin();
+      for (std::size_t site = first; site <= last; ++site) {
+        auto pauli = cudaq::pauli::I;
+        if (next->first == site)
+          pauli = (next++)->second;
+        env = transferLeft(env, site, pauliMatrix(pauli));
+      }
+      const std::complex<ScalarType> expVal =
+          env.cwiseProduct(m_right[last + 1]).sum();
+      allExpVals.emplace_back(
+          expVal * std::complex<ScalarType>(coeff.real(), coeff.imag()));
+    }
+    return allExpVals;
+  }
+};
+} // namespace nvqir
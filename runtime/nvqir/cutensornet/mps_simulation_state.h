@@ -28,7 +28,23 @@ struct MPSSettings {
   cutensornetTensorSVDAlgo_t svdAlgo = CUTENSORNET_TENSOR_SVD_ALGO_GESVDJ;
   // Optional gauge option
   std::optional<cutensornetStateMPSGaugeOption_t> gaugeOption;
+  // Optional budget for the truncation error (1 - fidelity) of the whole MPS.
+  // When set, the bond dimensions adapt to it, up to `maxBond`.
+  std::optional<double> truncationErrorBudget;
   MPSSettings();
+
+  /// @brief The discarded weight cutoff of the next truncation of an MPS over
+  /// the given number of qubits, whose previous truncations already discarded
+  /// `discardedWeight`. The truncation gets what is left of the budget; since
+  /// the MPS factorization applies one cutoff to all of its bonds, that is
+  /// shared among them. Zero if no budget is set, or none is left.
+  double discardedWeightCutoff(std::size_t numQubits,
+                               double discardedWeight) const {
+    if (!truncationErrorBudget.has_value() || numQubits < 2)
+      return 0.0;
+    const double remaining = truncationErrorBudget.value() - discardedWeight;
+    return remaining > 0.0 ? remaining / (numQubits - 1) : 0.0;
+  }
 };
 
 template <typename ScalarType = double>
@@ -50,6 +66,13 @@ public:
 
   std::complex<double> overlap(const cudaq::SimulationState &other) override;
 
+  /// @brief Compute all the overlaps of MPS states by contracting the
+  /// transfer matrices of all the pairs site by site, with batched matrix
+  /// products.
+  std::vector<std::complex<double>>
+  overlapMatrix(const std::vector<cudaq::SimulationState *> &bras,
+                const std::vector<cudaq::SimulationState *> &kets) override;
+
   std::complex<double>
   getAmplitude(const std::vector<int> &basisState) override;
   std::size_t getNumQubits() const override;
@@ -118,6 +118,26 @@ private:
   void applyKrausChannel(const std::vector<int32_t> &qubits,
                          const cudaq::kraus_channel &channel);
 
+  // Helper to compute the expectation value of an observable with the cached
+  // contraction, if the tensor network structure allows it.
+  std::optional<std::complex<ScalarType>>
+  computeCachedExpVal(const cudaq::spin_op &ham);
+
+  /// An expectation value contraction that has been prepared (path-optimized)
+  /// for a given tensor network structure and observable.
+  struct CachedExpectation {
+    std::size_t key = 0;
+    // The observable, compared on lookup along with the structure of the
+    // state, since the key is only a hash of both.
+    std::string observable;
+    // Mutable clone of the state the contraction was prepared for.
+    std::unique_ptr<TensorNetState<ScalarType>> state;
+    std::unique_ptr<TensorNetworkSpinOp<ScalarType>> spinOp;
+    cutensornetStateExpectation_t expectation = nullptr;
+    cutensornetWorkspaceDescriptor_t workDesc = nullptr;
+    ~CachedExpectation();
+  };
+
 protected:
   cutensornetHandle_t m_cutnHandle;
   std::unique_ptr<TensorNetState<ScalarType>> m_state;
@@ -141,6 +161,15 @@ protected:
   //   simplification, e.g., when the spin op is sparse (only acting on a few
   //   qubits).
   bool m_reuseContractionPathObserve = false;
+
+  // Flag to enable caching the prepared expectation value contraction across
+  // executions.
+  //   Default is off (no caching).
+  //   If the next execution has the same tensor network structure (e.g., only
+  //   gate angles changed) and observable, the cached contraction is updated
+  //   with the new gate data and computed without path finding.
+  bool m_cacheContractionObserve = false;
+  std::unique_ptr<CachedExpectation> m_cachedExpectation;
 };
 
 } // end namespace nvqir
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "mps_environments.h"
 #include "mps_simulation_state.h"
 #include "simulator_cutensornet.h"
 #include <charconv>
@@ -18,6 +19,11 @@ template <typename ScalarType = double>
 class SimulatorMPS : public SimulatorTensorNetBase<ScalarType> {
   MPSSettings m_settings;
   std::vector<MPSTensor> m_mpsTensors_d;
+  // Version of the tensor network that `m_mpsTensors_d` is the factorization
+  // of, if any.
+  std::optional<std::uint64_t> m_factorizedVersion;
+  // Sample noiseless states from the cached MPS environments.
+  bool m_perfectSampling = true;
 
 public:
   using GateApplicationTask =
@@ -28,20 +34,120 @@ public:
   using SimulatorTensorNetBase<ScalarType>::m_state;
   using SimulatorTensorNetBase<ScalarType>::scratchPad;
   using SimulatorTensorNetBase<ScalarType>::m_randomEngine;
-  SimulatorMPS() : SimulatorTensorNetBase<ScalarType>() {}
+  SimulatorMPS() : SimulatorTensorNetBase<ScalarType>() {
+    // The cached observe contraction is for the exact (non-MPS) tensor
+    // network.
+    this->m_cacheContractionObserve = false;
+    m_perfectSampling = cudaq::getEnvBool("CUDAQ_MPS_PERFECT_SAMPLING", true);
+  }
 
-  virtual void prepareQubitTensorState() override {
-    LOG_API_TIME();
-    // Clean up previously factorized MPS tensors
+  // Max bond dimension whereby observables are evaluated with cached MPS
+  // environments, which are contracted on the host.
+  static constexpr int64_t g_maxBondForCachedEnvironments = 256;
+
+  /// @brief Whether the expectation values of the factorized MPS tensors
+  /// should be computed from cached environments.
+  bool useCachedEnvironments() const {
+    return m_settings.maxBond <= g_maxBondForCachedEnvironments &&
+           m_state->getNumQubits() > 1;
+  }
+
+  /// @brief The discarded weight cutoff of the next truncation of the state,
+  /// given what its previous truncations discarded.
+  double discardedWeightCutoff() const {
+    return m_settings.discardedWeightCutoff(m_state->getNumQubits(),
+                                            m_state->m_discardedWeight);
+  }
+
+  /// @brief The truncation error of the MPS tensors factorized from the
+  /// state, if their environments can be contracted on the host.
+  std::optional<double>
+  computeTruncationError(const std::vector<MPSTensor> &tensors) const {
+    if (tensors.size() <= 1)
+      return 0.0;
+    if (!useCachedEnvironments())
+      return std::nullopt;
+    const MPSEnvironments<ScalarType> environments(tensors);
+    return std::max(0.0,
+                    1.0 - static_cast<double>(environments.normSquared()));
+  }
+
+  /// @brief The weight discarded so far by the MPS tensors factorized from the
+  /// state, which a new state is initialized from. Without host environments,
+  /// the truncation is assumed to have discarded all the weight it was given.
+  double discardedWeightOf(const std::vector<MPSTensor> &tensors) const {
+    if (!m_settings.truncationErrorBudget.has_value())
+      return 0.0;
+    if (auto truncationError = computeTruncationError(tensors))
+      return *truncationError;
+    return std::min(1.0, m_state->m_discardedWeight +
+                             discardedWeightCutoff() *
+                                 (m_state->getNumQubits() - 1));
+  }
+
+  /// @brief Compute the expectation value of each term on the factorized MPS
+  /// tensors.
+  std::vector<std::complex<ScalarType>>
+  computeExpVals(const std::vector<cudaq::spin_op_term> &terms) {
+    if (useCachedEnvironments())
+      return MPSEnvironments<ScalarType>(m_mpsTensors_d).computeExpVals(terms);
+    // We run a single trajectory for MPS as the final MPS form depends on the
+    // randomly-selected noise op.
+    return m_state->computeExpVals(terms, 1);
+  }
+
+  /// @brief True if `m_mpsTensors_d` is the factorization of the current
+  /// state. Factorizations of networks with noise channels are never reused,
+  /// since each of them samples a new noise trajectory.
+  bool hasFactorizedState() const {
+    return m_state && m_factorizedVersion == m_state->getVersion() &&
+           !m_state->m_hasNoiseChannel;
+  }
+
+  /// @brief Free the factorized MPS tensors.
+  void clearFactorizedState() {
     for (auto &tensor : m_mpsTensors_d) {
       HANDLE_CUDA_ERROR(cudaFree(tensor.deviceData));
     }
     m_mpsTensors_d.clear();
-    // Factorize the state:
-    if (m_state->getNumQubits() > 1)
-      m_mpsTensors_d = m_state->factorizeMPS(
-          m_settings.maxBond, m_settings.absCutoff, m_settings.relCutoff,
-          m_settings.svdAlgo, m_settings.gaugeOption);
+    m_factorizedVersion.reset();
+  }
+
+  virtual void prepareQubitTensorState() override {
+    LOG_API_TIME();
+    // All the queries on the same state (e.g., `observe` then `sample`) share
+    // a single factorization.
+    if (!hasFactorizedState()) {
+      // Clean up previously factorized MPS tensors
+      clearFactorizedState();
+      // Factorize the state:
+      if (m_state->getNumQubits() > 1)
+        m_mpsTensors_d = m_state->factorizeMPS(
+            m_settings.maxBond, m_settings.absCutoff, m_settings.relCutoff,
+            m_settings.svdAlgo, m_settings.gaugeOption,
+            discardedWeightCutoff());
+      m_factorizedVersion = m_state->getVersion();
+    }
+    if (m_settings.truncationErrorBudget.has_value() && this->executionContext)
+      reportTruncationError();
+  }
+
+  /// @brief Record the truncation error of the factorized MPS tensors in the
+  /// execution context.
+  /// Note: singular values are not renormalized upon truncation, so that the
+  /// norm of the factorized MPS of a normalized state is the fidelity of the
+  /// truncation.
+  void reportTruncationError() {
+    const auto truncationError = computeTruncationError(m_mpsTensors_d);
+    if (!truncationError) {
+      CUDAQ_INFO("MPS truncation error not computed for a maximum bond "
+                 "dimension above {}.",
+                 g_maxBondForCachedEnvironments);
+      return;
+    }
+    CUDAQ_INFO("MPS truncation error: {} (budget {}).", *truncationError,
+               m_settings.truncationErrorBudget.value());
+    this->executionContext->truncationError = *truncationError;
   }
 
   virtual std::size_t calculateStateDim(const std::size_t numQubits) override {
@@ -84,7 +190,8 @@ public:
       // Factor the existing state
       auto tensors = m_state->factorizeMPS(
           m_settings.maxBond, m_settings.absCutoff, m_settings.relCutoff,
-          m_settings.svdAlgo, m_settings.gaugeOption);
+          m_settings.svdAlgo, m_settings.gaugeOption, discardedWeightCutoff());
+      const double discardedWeight = discardedWeightOf(tensors);
       // The right most MPS tensor needs to have one more extra leg (no longer
       // the boundary tensor).
       tensors.back().extents.emplace_back(1);
@@ -109,6 +216,8 @@ public:
       }
       m_state = TensorNetState<ScalarType>::createFromMpsTensors(
           tensors, scratchPad, m_cutnHandle, m_randomEngine);
+      // The truncation errors of the new state build on that of its tensors.
+      m_state->m_discardedWeight = discardedWeight;
     }
   }
 
@@ -200,6 +309,25 @@ public:
                                                       op);
   }
 
+  /// @brief Apply the rotations of a batch one by one, so that the two-qubit
+  /// ones are applied directly as above.
+  void
+  applyExpPauliBatch(const std::vector<double> &thetas,
+                     const std::vector<std::size_t> &qubitIds,
+                     const std::vector<cudaq::spin_op_term> &terms) override {
+    if (this->isInTracerMode()) {
+      nvqir::CircuitSimulator::applyExpPauliBatch(thetas, qubitIds, terms);
+      return;
+    }
+    if (thetas.size() != terms.size())
+      throw std::invalid_argument(
+          "exp_pauli batch requires one angle per Pauli word - got " +
+          std::to_string(thetas.size()) + " angles and " +
+          std::to_string(terms.size()) + " words");
+    for (std::size_t k = 0; k < terms.size(); ++k)
+      applyExpPauli(thetas[k], {}, qubitIds, terms[k]);
+  }
+
   // Helper to compute expectation value from a bit string distribution
   static double computeExpValFromDistribution(
       const std::unordered_map<std::string, std::size_t> &distribution,
@@ -220,32 +348,79 @@ public:
   // Set up the MPS factorization before trajectory simulation run loop.
   // We only need to do cutensornetStateFinalizeMPS once
   void setUpFactorizeForTrajectoryRuns() {
-    for (auto &tensor : m_mpsTensors_d) {
-      HANDLE_CUDA_ERROR(cudaFree(tensor.deviceData));
-    }
+    clearFactorizedState();
 
     if (m_state->hasGeneralChannelApplied() && m_state->getNumQubits() <= 1)
       throw std::runtime_error(
           "MPS noisy simulation currently does not support the case where "
           "number of qubit is equal to 1");
-    m_mpsTensors_d.clear();
     m_mpsTensors_d = m_state->setupMPSFactorize(
         m_settings.maxBond, m_settings.absCutoff, m_settings.relCutoff,
-        m_settings.svdAlgo, m_settings.gaugeOption);
+        m_settings.svdAlgo, m_settings.gaugeOption, discardedWeightCutoff());
+  }
+
+  /// @brief Sample the shots in batches of the same noise trajectory, each
+  /// with a single MPS factorization.
+  cudaq::ExecutionResult
+  sampleBatchedTrajectories(const std::vector<int32_t> &measuredBitIds,
+                            const int shots) {
+    LOG_API_TIME();
+    cudaq::ExecutionResult counts;
+    const auto trajectories = m_state->sampleTrajectories(shots);
+    CUDAQ_INFO("Sampling {} shots from {} distinct noise trajectories.", shots,
+               trajectories.size());
+    for (const auto &[trajectory, numShots] : trajectories) {
+      auto trajectoryState = TensorNetState<ScalarType>::createFromOpTensors(
+          m_state->getNumQubits(), m_state->getTrajectoryOps(trajectory),
+          this->scratchPad, this->m_cutnHandle, this->m_randomEngine);
+      std::vector<MPSTensor> mpsTensors;
+      if (trajectoryState->getNumQubits() > 1)
+        mpsTensors = trajectoryState->factorizeMPS(
+            m_settings.maxBond, m_settings.absCutoff, m_settings.relCutoff,
+            m_settings.svdAlgo, m_settings.gaugeOption,
+            discardedWeightCutoff());
+      const auto samples = trajectoryState->sample(measuredBitIds, numShots,
+                                                   requireCacheWorkspace());
+      for (const auto &[bitString, count] : samples)
+        counts.appendResult(bitString, count);
+      for (auto &tensor : mpsTensors)
+        HANDLE_CUDA_ERROR(cudaFree(tensor.deviceData));
+    }
+    counts.expectationValue =
+        computeExpValFromDistribution(counts.counts, shots);
+    return counts;
   }
 
   /// @brief Sample a subset of qubits
   cudaq::ExecutionResult sample(const std::vector<std::size_t> &measuredBits,
                                 const int shots) override {
+    std::vector<int32_t> measuredBitIds(measuredBits.begin(),
+                                        measuredBits.end());
+    // The trajectories of unitary mixture channels are sampled ahead of the
+    // factorization, so that shots which share one also share its MPS.
+    if (shots >= 1 && m_state->canBatchTrajectories())
+      return sampleBatchedTrajectories(measuredBitIds, shots);
+
     const bool hasNoise =
         this->executionContext && this->executionContext->noiseModel;
+    if (!hasNoise && shots >= 1 && m_perfectSampling &&
+        !m_state->m_hasNoiseChannel) {
+      prepareQubitTensorState();
+      if (useCachedEnvironments()) {
+        LOG_API_TIME();
+        const MPSEnvironments<ScalarType> environments(m_mpsTensors_d);
+        cudaq::ExecutionResult counts(
+            environments.sample(measuredBitIds, shots, m_randomEngine));
+        counts.expectationValue =
+            computeExpValFromDistribution(counts.counts, shots);
+        return counts;
+      }
+    }
     if (!hasNoise || shots < 1)
       return SimulatorTensorNetBase<ScalarType>::sample(measuredBits, shots);
 
     LOG_API_TIME();
     cudaq::ExecutionResult counts;
-    std::vector<int32_t> measuredBitIds(measuredBits.begin(),
-                                        measuredBits.end());
 
     setUpFactorizeForTrajectoryRuns();
     std::map<std::vector<int64_t>, std::pair<cutensornetStateSampler_t,
@@ -310,13 +485,19 @@ public:
     LOG_API_TIME();
     const bool hasNoise =
         this->executionContext && this->executionContext->noiseModel;
-    // If no noise, just use base class implementation.
-    if (!hasNoise)
+    // If no noise and the MPS is too large for cached environments, just use
+    // base class implementation.
+    if (!hasNoise && !useCachedEnvironments())
       return SimulatorTensorNetBase<ScalarType>::observe(ham);
 
-    setUpFactorizeForTrajectoryRuns();
+    if (hasNoise)
+      setUpFactorizeForTrajectoryRuns();
+    else
+      prepareQubitTensorState();
+    // Without noise, a single exact evaluation suffices.
     const std::size_t numObserveTrajectories =
-        this->executionContext->numberTrajectories.has_value()
+        !hasNoise ? 1
+        : this->executionContext->numberTrajectories.has_value()
             ? this->executionContext->numberTrajectories.value()
             : TensorNetState<ScalarType>::g_numberTrajectoriesForObserve;
 
@@ -326,10 +507,9 @@ public:
     for (std::size_t i = 0; i < numObserveTrajectories; ++i) {
       // As the Kraus operator sampling may change the MPS state, we need to
       // re-compute the factorization in each trajectory.
-      m_state->computeMPSFactorize(m_mpsTensors_d);
-      // We run a single trajectory for MPS as the final MPS form depends on the
-      // randomly-selected noise op.
-      const auto trajTermExpVals = m_state->computeExpVals(terms, 1);
+      if (hasNoise)
+        m_state->computeMPSFactorize(m_mpsTensors_d);
+      const auto trajTermExpVals = computeExpVals(terms);
 
       for (std::size_t idx = 0; idx < terms.size(); ++idx) {
         termExpVals[idx] += (trajTermExpVals[idx] /
@@ -380,7 +560,9 @@ public:
       if (!ptr) {
         auto tensors = m_state->factorizeMPS(
             m_settings.maxBond, m_settings.absCutoff, m_settings.relCutoff,
-            m_settings.svdAlgo, m_settings.gaugeOption);
+            m_settings.svdAlgo, m_settings.gaugeOption,
+            discardedWeightCutoff());
+        const double discardedWeight = discardedWeightOf(tensors);
         // The right most MPS tensor needs to have one more extra leg (no longer
         // the boundary tensor).
         tensors.back().extents.emplace_back(1);
@@ -399,6 +581,7 @@ public:
         }
         m_state = TensorNetState<ScalarType>::createFromMpsTensors(
             tensors, scratchPad, m_cutnHandle, m_randomEngine);
+        m_state->m_discardedWeight = discardedWeight;
       } else {
         // Non-zero state needs to be factorized and appended.
         auto [state, mpsTensors] =
@@ -409,7 +592,9 @@ public:
                 m_settings.maxBond, m_randomEngine);
         auto tensors = m_state->factorizeMPS(
             m_settings.maxBond, m_settings.absCutoff, m_settings.relCutoff,
-            m_settings.svdAlgo, m_settings.gaugeOption);
+            m_settings.svdAlgo, m_settings.gaugeOption,
+            discardedWeightCutoff());
+        const double discardedWeight = discardedWeightOf(tensors);
         // Adjust the extents of the last tensor in the original state
         tensors.back().extents.emplace_back(1);
 
@@ -421,6 +606,7 @@ public:
         tensors.insert(tensors.end(), mpsTensors.begin(), mpsTensors.end());
         m_state = TensorNetState<ScalarType>::createFromMpsTensors(
             tensors, scratchPad, m_cutnHandle, m_randomEngine);
+        m_state->m_discardedWeight = discardedWeight;
       }
     }
   }
@@ -434,9 +620,18 @@ public:
           m_cutnHandle, m_randomEngine);
 
     if (m_state->getNumQubits() > 1) {
-      std::vector<MPSTensor> tensors = m_state->factorizeMPS(
-          m_settings.maxBond, m_settings.absCutoff, m_settings.relCutoff,
-          m_settings.svdAlgo, m_settings.gaugeOption);
+      // Hand the factorization over to the state if there is one already.
+      std::vector<MPSTensor> tensors;
+      if (hasFactorizedState()) {
+        tensors = std::move(m_mpsTensors_d);
+        m_mpsTensors_d.clear();
+        m_factorizedVersion.reset();
+      } else {
+        tensors = m_state->factorizeMPS(
+            m_settings.maxBond, m_settings.absCutoff, m_settings.relCutoff,
+            m_settings.svdAlgo, m_settings.gaugeOption,
+            discardedWeightCutoff());
+      }
       return std::make_unique<MPSSimulationState<ScalarType>>(
           std::move(m_state), tensors, scratchPad, m_cutnHandle,
           m_randomEngine);
@@ -14,6 +14,8 @@
 #include "cutensornet.h"
 #include "tensornet_utils.h"
 #include "timing_utils.h"
+#include <atomic>
+#include <map>
 #include <optional>
 #include <span>
 #include <unordered_map>
@@ -49,6 +51,8 @@ struct AppliedTensorOp {
   std::vector<int32_t> controlQubitIds;
   bool isAdjoint = false;
   bool isUnitary = false;
+  /// Id of the tensor operator in the `cutensornetState_t`.
+  std::int64_t tensorId = InvalidTensorIndexValue;
 
   /// Constructor for gate/projector operations.
   AppliedTensorOp(void *dataPtr, const std::vector<int32_t> &targetQubits,
@@ -102,6 +106,22 @@ protected:
   // True if deterministic path-finding is to be used
   static bool m_deterministic;
   bool m_hasNoiseChannel = false;
+  // True if the state was initialized from MPS tensors, which are not tracked
+  // as tensor ops.
+  bool m_initializedFromMps = false;
+  // Weight of the singular values discarded by the truncations of the MPS
+  // tensors the state was initialized from, if any.
+  double m_discardedWeight = 0.0;
+  // True if the data of the tensor ops may be updated after they were applied.
+  bool m_mutableTensorOps = false;
+  // Version of the tensor network, unique to each state and each modification
+  // of it, so that the results derived from the network can be cached.
+  std::uint64_t m_version = nextVersion();
+
+  static std::uint64_t nextVersion() {
+    static std::atomic<std::uint64_t> counter{0};
+    return ++counter;
+  }
 
 public:
   // The number of hyper samples used in the tensor network contraction path
@@ -192,6 +212,12 @@ public:
   getStateVector(const std::vector<int32_t> &projectedModes = {},
                  const std::vector<int64_t> &projectedModeValues = {});
 
+  /// @brief Compute the amplitudes of the given basis states, with a single
+  /// prepared contraction. Basis states are given as one value (0 or 1) per
+  /// qubit.
+  std::vector<DataType>
+  getAmplitudes(const std::vector<std::vector<int>> &basisStates);
+
   /// @brief Compute the reduce density matrix on a set of qubits
   ///
   /// The order of the specified qubits (`cutensornet` open state modes) will be
@@ -202,10 +228,13 @@ public:
   /// Returns MPS tensors in GPU device memory.
   /// Note: the caller assumes the ownership of these pointers, thus needs to
   /// clean them up properly (with cudaFree).
+  /// A non-zero `discardedWeightCutoff` additionally truncates each bond to
+  /// the fewest singular values whose discarded weight stays below it.
   std::vector<MPSTensor>
   factorizeMPS(int64_t maxExtent, double absCutoff, double relCutoff,
                cutensornetTensorSVDAlgo_t algo,
-               const std::optional<cutensornetStateMPSGaugeOption_t> &gauge);
+               const std::optional<cutensornetStateMPSGaugeOption_t> &gauge,
+               double discardedWeightCutoff = 0.0);
 
   /// @brief Compute the expectation value of an observable
   /// @param product_terms the terms of the observable (operator sum)
@@ -219,6 +248,67 @@ public:
   DataType computeExpVal(cutensornetNetworkOperator_t tensorNetworkOperator,
                          const std::optional<std::size_t> &numberTrajectories);
 
+  /// @brief Create and prepare (i.e., find the contraction path of) the
+  /// expectation value of a given `cutensornetNetworkOperator_t`.
+  /// Note: the caller assumes the ownership of the returned objects.
+  std::pair<cutensornetStateExpectation_t, cutensornetWorkspaceDescriptor_t>
+  prepareExpectation(cutensornetNetworkOperator_t tensorNetworkOperator);
+
+  /// @brief Compute a prepared expectation value.
+  DataType
+  executeExpectation(cutensornetStateExpectation_t tensorNetworkExpectation,
+                     cutensornetWorkspaceDescriptor_t workDesc,
+                     const std::optional<std::size_t> &numberTrajectories);
+
+  /// @brief Hash of the structure of the tensor network, i.e., of the qubit
+  /// operands of every tensor op, but not of their data. Returns nothing if
+  /// the state is not built from tensor ops only, e.g., has noise channels.
+  std::optional<std::size_t> getStructureHash() const;
+
+  /// @brief Return true if the tensor network has the same structure as the
+  /// one of `other`, i.e., its tensor ops act on the same qubit operands.
+  bool hasSameStructure(const TensorNetState &other) const;
+
+  /// @brief Clone the state with mutable tensor ops, so that their data can
+  /// be updated with `updateTensorOps`.
+  std::unique_ptr<TensorNetState> cloneMutable() const;
+
+  /// @brief Update the data of the tensor ops to those of another state with
+  /// the same structure.
+  void updateTensorOps(const TensorNetState &other);
+
+  /// @brief Update the data of the tensor ops to those of a list of tensor ops
+  /// with the same structure.
+  void updateTensorOps(const std::vector<AppliedTensorOp> &ops);
+
+  /// @brief True if the state has noise channels which are all unitary
+  /// mixtures, hence whose noise trajectories can be sampled ahead of the
+  /// contraction.
+  bool canBatchTrajectories() const;
+
+  /// @brief Sample the noise trajectories of a number of shots, i.e., pick one
+  /// of the unitary ops of every noise channel for each shot. Returns the
+  /// number of shots of each distinct trajectory, keyed by the indices of the
+  /// ops picked for the channels, in order.
+  std::map<std::vector<std::size_t>, std::size_t>
+  sampleTrajectories(std::size_t shots) const;
+
+  /// @brief Return the tensor ops of a noise trajectory, i.e., with every noise
+  /// channel replaced by the unitary op picked for it.
+  std::vector<AppliedTensorOp>
+  getTrajectoryOps(const std::vector<std::size_t> &trajectory) const;
+
+  /// @brief Perform measurement sampling on the quantum state, contracting the
+  /// network once per distinct noise trajectory for all the shots sharing it
+  /// rather than once per shot.
+  std::unordered_map<std::string, size_t>
+  sampleBatchedTrajectories(const std::vector<int32_t> &measuredBitIds,
+                            int32_t shots, bool enableCacheWorkspace);
+
+  /// @brief Version of the tensor network, which changes whenever a tensor op
+  /// is applied or updated.
+  std::uint64_t getVersion() const { return m_version; }
+
   /// @brief Number of qubits that this state represents.
   std::size_t getNumQubits() const { return m_numQubits; }
 
@@ -249,6 +339,33 @@ private:
   friend class SimulatorTensorNet;
   template <typename ScalarTy>
   friend class TensorNetSimulationState;
+  /// Max number of qubits left open (i.e., not projected) when computing a
+  /// batch of amplitudes.
+  static constexpr std::size_t g_maxOpenModesForAmplitudes = 10;
+
+  /// Internal method to create a state with mutable tensor ops from a list of
+  /// tensor ops (gates and projectors only).
+  std::unique_ptr<TensorNetState>
+  createMutable(const std::vector<AppliedTensorOp> &ops) const;
+
+  /// Internal method to create and prepare a state amplitudes accessor.
+  /// Note: the caller assumes the ownership of the returned objects.
+  std::pair<cutensornetStateAccessor_t, cutensornetWorkspaceDescriptor_t>
+  prepareAccessor(const std::vector<int32_t> &projectedModes);
+
+  /// Max number of qubits of the supports whose terms are evaluated from
+  /// their reduced density matrix in `computeExpVals`.
+  static constexpr std::size_t g_maxRdmQubitsForExpVals = 6;
+  /// Min number of terms sharing a support for them to be evaluated from its
+  /// reduced density matrix, which costs a contraction of its own.
+  static constexpr std::size_t g_minTermsPerRdmForExpVals = 3;
+
+  /// Internal method to compute the expectation values of the terms which
+  /// share their support with enough other terms, from the reduced density
+  /// matrix of the support. The values of the other terms are left empty.
+  std::vector<std::optional<std::complex<ScalarType>>>
+  computeExpValsFromRDMs(const std::vector<cudaq::spin_op_term> &product_terms);
+
   /// Internal method to contract the tensor network.
   /// Returns device memory pointer and size (number of elements).
   std::pair<void *, std::size_t> contractStateVectorInternal(
@@ -262,7 +379,8 @@ private:
   std::vector<MPSTensor> setupMPSFactorize(
       int64_t maxExtent, double absCutoff, double relCutoff,
       cutensornetTensorSVDAlgo_t algo,
-      const std::optional<cutensornetStateMPSGaugeOption_t> &gauge);
+      const std::optional<cutensornetStateMPSGaugeOption_t> &gauge,
+      double discardedWeightCutoff = 0.0);
   void computeMPSFactorize(std::vector<MPSTensor> &mpsTensors);
 
   /// Internal methods for sampling
@@ -8,6 +8,7 @@
 
 #pragma once
 #include "cutensornet.h"
+#include <cublas_v2.h>
 #include <complex>
 #include <random>
 #include <vector>
@@ -33,6 +34,16 @@
     }                                                                          \
   }
 
+#define HANDLE_CUBLAS_ERROR(x)                                                 \
+  {                                                                            \
+    const auto err = x;                                                        \
+    if (err != CUBLAS_STATUS_SUCCESS) {                                        \
+      printf("cuBLAS error %d in line %d\n", static_cast<int>(err), __LINE__); \
+      fflush(stdout);                                                          \
+      std::abort();                                                            \
+    }                                                                          \
+  }
+
 /// @brief Allocate and initialize device memory according to the input host
 /// data.
 template <typename T>
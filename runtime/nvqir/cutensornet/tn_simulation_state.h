@@ -42,6 +42,8 @@ public:
 
   std::complex<double>
   getAmplitude(const std::vector<int> &basisState) override;
+  std::vector<std::complex<double>>
+  getAmplitudes(const std::vector<std::vector<int>> &basisStates) override;
   std::size_t getNumQubits() const override;
   void dump(std::ostream &) const override;
   cudaq::SimulationState::precision getPrecision() const override {
@@ -85,6 +87,9 @@ public:
   friend class SimulatorTensorNet;
 
 protected:
+  // Check that the given basis state is valid for this state.
+  void checkBasisState(const std::vector<int> &basisState) const;
+
   std::unique_ptr<TensorNetState<ScalarType>> m_state;
   ScratchDeviceMem &scratchPad;
   cutensornetHandle_t m_cutnHandle;
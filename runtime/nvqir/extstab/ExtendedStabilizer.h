@@ -0,0 +1,657 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace nvqir::extstab {
+
+using complex = std::complex<double>;
+
+/// @brief A Clifford gate of the stabilizer decomposition of a circuit.
+struct CliffordGate {
+  enum Kind { H, S, Sdg, X, Y, Z, CX, CZ };
+  Kind kind;
+  std::size_t q0;
+  /// The target of CX, or the second qubit of CZ.
+  std::size_t q1 = 0;
+};
+
+/// @brief A linear combination of Clifford circuits, each applied in order.
+struct CliffordSum {
+  struct Term {
+    complex coefficient;
+    std::vector<CliffordGate> gates;
+  };
+  std::vector<Term> terms;
+
+  /// @brief The single circuit `gates`.
+  static CliffordSum of(std::vector<CliffordGate> gates,
+                        complex coefficient = 1.) {
+    return CliffordSum{{{coefficient, std::move(gates)}}};
+  }
+
+  /// @brief The operator `second * first`, i.e., `first` then `second`.
+  static CliffordSum then(const CliffordSum &first,
+                          const CliffordSum &second) {
+    CliffordSum product;
+    product.terms.reserve(first.terms.size() * second.terms.size());
+    for (const auto &a : first.terms)
+      for (const auto &b : second.terms) {
+        auto &term = product.terms.emplace_back(
+            CliffordSum::Term{a.coefficient * b.coefficient, a.gates});
+        term.gates.insert(term.gates.end(), b.gates.begin(), b.gates.end());
+      }
+    return product;
+  }
+};
+
+/// @brief Tolerance under which angles are snapped to Clifford angles and
+/// amplitudes are treated as zero.
+inline constexpr double tolerance = 1e-9;
+
+/// @brief Decompose the phase gate `diag(1, e^{i phi})` on `q`. Multiples of
+/// pi/2 are powers of S, any other angle is the sum
+/// `(1 + e^{i phi}) / 2 I + (1 - e^{i phi}) / 2 Z`.
+inline CliffordSum phaseGate(double phi, std::size_t q) {
+  const double quarterTurns = phi / (M_PI / 2);
+  const double rounded = std::round(quarterTurns);
+  if (std::abs(quarterTurns - rounded) < tolerance) {
+    const int k = ((static_cast<long long>(rounded) % 4) + 4) % 4;
+    std::vector<CliffordGate> gates;
+    if (k == 2)
+      gates.push_back({CliffordGate::Z, q});
+    else if (k != 0)
+      gates.push_back({k == 1 ? CliffordGate::S : CliffordGate::Sdg, q});
+    return CliffordSum::of(std::move(gates));
+  }
+  const complex phase = std::polar(1., phi);
+  return CliffordSum{
+      {{(1. + phase) / 2., {}}, {(1. - phase) / 2., {{CliffordGate::Z, q}}}}};
+}
+
+/// @brief Decompose the single-qubit unitary `matrix` (row-major) on `q` as
+/// `e^{i alpha} R1(phi) Ry(theta) R1(lambda)`, with
+/// `Ry(theta) = e^{-i theta / 2} S H R1(theta) H Sdg`.
+inline CliffordSum singleQubitGate(const std::vector<complex> &matrix,
+                                   std::size_t q) {
+  const double c = std::abs(matrix[0]), s = std::abs(matrix[2]);
+  const double theta = 2 * std::atan2(s, c);
+  double alpha, phi = 0, lambda;
+  if (s < tolerance) {
+    alpha = std::arg(matrix[0]);
+    lambda = std::arg(matrix[3]) - alpha;
+  } else if (c < tolerance) {
+    alpha = std::arg(matrix[2]);
+    lambda = std::arg(-matrix[1]) - alpha;
+  } else {
+    alpha = std::arg(matrix[0]);
+    phi = std::arg(matrix[2]) - alpha;
+    lambda = std::arg(-matrix[1]) - alpha;
+  }
+
+  CliffordSum gate = phaseGate(lambda, q);
+  if (theta > tolerance) {
+    auto ry = CliffordSum::then(
+        CliffordSum::of({{CliffordGate::Sdg, q}, {CliffordGate::H, q}},
+                        std::polar(1., -theta / 2)),
+        phaseGate(theta, q));
+    ry = CliffordSum::then(
+        ry, CliffordSum::of({{CliffordGate::H, q}, {CliffordGate::S, q}}));
+    gate = CliffordSum::then(gate, ry);
+  }
+  gate = CliffordSum::then(gate, phaseGate(phi, q));
+  for (auto &term : gate.terms)
+    term.coefficient *= std::polar(1., alpha);
+  return gate;
+}
+
+/// @brief Add the controls `controls` to `gate`, expanding
+/// `C^k U = (I + Z_c) / 2 + (I - Z_c) / 2 C^{k-1} U` on the first control `c`.
+inline CliffordSum controlled(const CliffordSum &gate,
+                              std::span<const std::size_t> controls) {
+  if (controls.empty())
+    return gate;
+  const auto inner = controlled(gate, controls.subspan(1));
+  const CliffordGate z{CliffordGate::Z, controls[0]};
+  CliffordSum sum{{{0.5, {}}, {0.5, {z}}}};
+  for (const auto &term : inner.terms) {
+    sum.terms.push_back({0.5 * term.coefficient, term.gates});
+    auto &projected =
+        sum.terms.emplace_back(CliffordSum::Term{-0.5 * term.coefficient, {z}});
+    projected.gates.insert(projected.gates.end(), term.gates.begin(),
+                           term.gates.end());
+  }
+  return sum;
+}
+
+/// @brief The stabilizer state `omega U_C U_H |s>` in the CH-form of Bravyi
+/// et al. (arXiv:1808.00128): `U_C` is a Clifford circuit of S, CZ and CX
+/// gates, stored through `U_C^dagger Z_p U_C = Z^{G_p}` and
+/// `U_C^dagger X_p U_C = i^{gamma_p} X^{F_p} Z^{M_p}`, `U_H` is a layer of
+/// Hadamards on the qubits set in `v` and `s` a basis state. Unlike a
+/// stabilizer tableau, the form keeps track of the global phase `omega`, so
+/// that sums of stabilizer states are well defined. Bit rows are packed in
+/// 64-bit words, and qubit `j` is bit `j % 64` of word `j / 64`.
+class CHForm {
+public:
+  using Bits = std::vector<std::uint64_t>;
+
+  explicit CHForm(std::size_t numQubits) { addQubits(numQubits); }
+
+  std::size_t numQubits() const { return n; }
+
+  /// @brief The factor `omega`, whose squared magnitude is the weight of the
+  /// state in a sum.
+  complex coefficient() const { return omega; }
+  void scale(complex factor) { omega *= factor; }
+  void addToCoefficient(complex term) { omega += term; }
+
+  /// @brief Append `count` qubits in the |0> state.
+  void addQubits(std::size_t count) {
+    const std::size_t newN = n + count;
+    const std::size_t newWords = (newN + 63) / 64;
+    auto grow = [&](Bits &rows, bool identity) {
+      Bits grown(newN * newWords, 0);
+      for (std::size_t p = 0; p < n; ++p)
+        std::copy_n(&rows[p * words], words, &grown[p * newWords]);
+      if (identity)
+        for (std::size_t p = n; p < newN; ++p)
+          grown[p * newWords + p / 64] |= bit(p);
+      rows = std::move(grown);
+    };
+    grow(F, true);
+    grow(G, true);
+    grow(M, false);
+    gamma.resize(newN, 0);
+    v.resize(newWords, 0);
+    s.resize(newWords, 0);
+    n = newN;
+    words = newWords;
+  }
+
+  void apply(const CliffordGate &gate) {
+    switch (gate.kind) {
+    case CliffordGate::H:
+      return applyH(gate.q0);
+    case CliffordGate::S:
+      return applyS(gate.q0, false);
+    case CliffordGate::Sdg:
+      return applyS(gate.q0, true);
+    case CliffordGate::X:
+      return applyX(gate.q0);
+    case CliffordGate::Y:
+      applyZ(gate.q0);
+      applyX(gate.q0);
+      omega *= complex(0, 1);
+      return;
+    case CliffordGate::Z:
+      return applyZ(gate.q0);
+    case CliffordGate::CX:
+      return applyCX(gate.q0, gate.q1);
+    case CliffordGate::CZ:
+      return applyCZ(gate.q0, gate.q1);
+    }
+  }
+
+  /// @brief Project qubit `q` onto |outcome>, without renormalizing. Return
+  /// false if the projection vanishes.
+  bool project(std::size_t q, bool outcome) {
+    Bits u = s;
+    const int sign = applyZ(q, u);
+    if (u == s)
+      return (sign < 0) == outcome;
+    superpose(s, 0.5, u, outcome ? -0.5 * sign : 0.5 * sign);
+    return true;
+  }
+
+  /// @brief The amplitude `<x|omega U_C U_H|s>` of the packed basis state `x`.
+  complex amplitude(const Bits &x) const {
+    Bits t(words, 0), m(words, 0);
+    unsigned exponent = 0;
+    for (std::size_t p = 0; p < n; ++p) {
+      if (!(x[p / 64] & bit(p)))
+        continue;
+      exponent += gamma[p] + 2 * parity(m.data(), row(F, p));
+      xorInto(t.data(), row(F, p));
+      xorInto(m.data(), row(M, p));
+    }
+    // <x|U_C = i^{-exponent} <t|, and <t|U_H|s> vanishes unless t and s agree
+    // outside of the Hadamard layer.
+    unsigned hadamards = 0;
+    bool negative = false;
+    for (std::size_t w = 0; w < words; ++w) {
+      if ((t[w] ^ s[w]) & ~v[w])
+        return 0.;
+      hadamards += std::popcount(v[w]);
+      negative ^= std::popcount(t[w] & s[w] & v[w]) & 1;
+    }
+    const complex phase = powerOfI((4 - exponent % 4) + (negative ? 2 : 0));
+    return omega * phase * std::pow(2., -0.5 * hadamards);
+  }
+
+  /// @brief The probability `|<x|U_C U_H|s>|^2` of every basis state in the
+  /// support of the (normalized) state.
+  double supportProbability() const {
+    unsigned hadamards = 0;
+    for (auto w : v)
+      hadamards += std::popcount(w);
+    return std::ldexp(1., -static_cast<int>(hadamards));
+  }
+
+  /// @brief Draw a basis state from the (uniform) distribution of the state,
+  /// `x = G t` with `t` equal to `s` outside of the Hadamard layer.
+  template <typename Rng>
+  void sample(Rng &rng, Bits &x) const {
+    Bits t(words);
+    for (std::size_t w = 0; w < words; ++w)
+      t[w] = (s[w] & ~v[w]) | (rng() & v[w]);
+    x.assign(words, 0);
+    for (std::size_t p = 0; p < n; ++p)
+      if (parity(t.data(), row(G, p)))
+        x[p / 64] |= bit(p);
+  }
+
+  /// @brief A key identifying the state up to `omega`, so that equal terms of
+  /// a sum can be merged.
+  std::string key() const {
+    std::string key;
+    auto append = [&](const Bits &bits) {
+      key.append(reinterpret_cast<const char *>(bits.data()),
+                 bits.size() * sizeof(std::uint64_t));
+    };
+    append(F);
+    append(G);
+    append(M);
+    append(v);
+    append(s);
+    key.append(gamma.begin(), gamma.end());
+    return key;
+  }
+
+private:
+  std::size_t n = 0;
+  std::size_t words = 0;
+  Bits F, G, M;
+  std::vector<char> gamma;
+  Bits v, s;
+  complex omega = 1.;
+
+  static std::uint64_t bit(std::size_t j) {
+    return std::uint64_t(1) << (j % 64);
+  }
+  static complex powerOfI(unsigned k) {
+    static constexpr double re[] = {1, 0, -1, 0}, im[] = {0, 1, 0, -1};
+    return {re[k % 4], im[k % 4]};
+  }
+
+  std::uint64_t *row(Bits &rows, std::size_t p) { return &rows[p * words]; }
+  const std::uint64_t *row(const Bits &rows, std::size_t p) const {
+    return &rows[p * words];
+  }
+  bool get(const Bits &rows, std::size_t p, std::size_t j) const {
+    return rows[p * words + j / 64] & bit(j);
+  }
+  void flip(Bits &rows, std::size_t p, std::size_t j) {
+    rows[p * words + j / 64] ^= bit(j);
+  }
+  void xorInto(std::uint64_t *dst, const std::uint64_t *src) const {
+    for (std::size_t w = 0; w < words; ++w)
+      dst[w] ^= src[w];
+  }
+  bool parity(const std::uint64_t *a, const std::uint64_t *b) const {
+    std::uint64_t acc = 0;
+    for (std::size_t w = 0; w < words; ++w)
+      acc ^= a[w] & b[w];
+    return std::popcount(acc) & 1;
+  }
+
+  // Left multiplication, `U_C <- V U_C`, by C-type gates.
+
+  void applyS(std::size_t q, bool adjoint) {
+    xorInto(row(M, q), row(G, q));
+    gamma[q] = (gamma[q] + (adjoint ? 1 : 3)) % 4;
+  }
+
+  void applyCZ(std::size_t a, std::size_t b) {
+    xorInto(row(M, a), row(G, b));
+    xorInto(row(M, b), row(G, a));
+  }
+
+  void applyCX(std::size_t c, std::size_t t) {
+    gamma[c] = (gamma[c] + gamma[t] + 2 * parity(row(M, c), row(F, t))) % 4;
+    xorInto(row(G, t), row(G, c));
+    xorInto(row(F, c), row(F, t));
+    xorInto(row(M, c), row(M, t));
+  }
+
+  // Right multiplication, `U_C <- U_C V`.
+
+  void rightS(std::size_t q) {
+    for (std::size_t p = 0; p < n; ++p)
+      if (get(F, p, q)) {
+        flip(M, p, q);
+        gamma[p] = (gamma[p] + 3) % 4;
+      }
+  }
+
+  void rightCZ(std::size_t a, std::size_t b) {
+    for (std::size_t p = 0; p < n; ++p) {
+      const bool fa = get(F, p, a), fb = get(F, p, b);
+      if (fa)
+        flip(M, p, b);
+      if (fb)
+        flip(M, p, a);
+      if (fa && fb)
+        gamma[p] = (gamma[p] + 2) % 4;
+    }
+  }
+
+  void rightCX(std::size_t c, std::size_t t) {
+    for (std::size_t p = 0; p < n; ++p) {
+      if (get(G, p, t))
+        flip(G, p, c);
+      if (get(F, p, c))
+        flip(F, p, t);
+      if (get(M, p, t))
+        flip(M, p, c);
+    }
+  }
+
+  /// @brief `U_C U_H (Z_q-image) |s> = sign U_C U_H |out>`, return the sign.
+  int applyZ(std::size_t q, Bits &out) const {
+    const std::uint64_t *g = row(G, q);
+    std::uint64_t acc = 0;
+    for (std::size_t w = 0; w < words; ++w) {
+      acc ^= g[w] & ~v[w] & s[w];
+      out[w] = s[w] ^ (g[w] & v[w]);
+    }
+    return std::popcount(acc) & 1 ? -1 : 1;
+  }
+
+  /// @brief `U_C U_H (X_q-image) |s> = phase U_C U_H |out>`.
+  complex applyX(std::size_t q, Bits &out) const {
+    const std::uint64_t *f = row(F, q), *m = row(M, q);
+    std::uint64_t acc = 0;
+    for (std::size_t w = 0; w < words; ++w) {
+      // Hadamards exchange the X and Z parts inside of the layer.
+      const std::uint64_t z = (m[w] & ~v[w]) | (f[w] & v[w]);
+      acc ^= (f[w] & m[w] & v[w]) ^ (z & s[w]);
+      out[w] = s[w] ^ ((f[w] & ~v[w]) | (m[w] & v[w]));
+    }
+    return powerOfI(gamma[q] + (std::popcount(acc) & 1 ? 2 : 0));
+  }
+
+  void applyZ(std::size_t q) {
+    Bits out(words);
+    omega *= applyZ(q, out);
+    s = std::move(out);
+  }
+
+  void applyX(std::size_t q) {
+    Bits out(words);
+    omega *= applyX(q, out);
+    s = std::move(out);
+  }
+
+  /// @brief `H_q = (X_q + Z_q) / sqrt(2)`.
+  void applyH(std::size_t q) {
+    Bits t(words), u(words);
+    const complex a = applyX(q, t) * M_SQRT1_2;
+    const complex b = applyZ(q, u) * M_SQRT1_2;
+    superpose(t, a, u, b);
+  }
+
+  /// @brief Replace the state by `omega U_C U_H (a |t> + b |u>)`, where `b / a`
+  /// is a power of i (Proposition 4 of Bravyi et al.).
+  void superpose(Bits t, complex a, Bits u, complex b) {
+    if (t == u) {
+      omega *= a + b;
+      s = std::move(t);
+      return;
+    }
+
+    // Reduce the difference of t and u to a single pivot qubit q with gates
+    // W acting on basis states, W U_H = U_H W', and absorb W' into U_C.
+    Bits diff(words), outside(words), inside(words);
+    bool anyOutside = false;
+    for (std::size_t w = 0; w < words; ++w) {
+      diff[w] = t[w] ^ u[w];
+      outside[w] = diff[w] & ~v[w];
+      inside[w] = diff[w] & v[w];
+      anyOutside |= outside[w] != 0;
+    }
+    const Bits &pivots = anyOutside ? outside : inside;
+    std::size_t q = 0;
+    while (!(pivots[q / 64] & bit(q)))
+      ++q;
+    for (std::size_t j = 0; j < n; ++j) {
+      if (j == q || !(diff[j / 64] & bit(j)))
+        continue;
+      const bool inLayer = v[j / 64] & bit(j);
+      if (anyOutside && !inLayer)
+        rightCX(q, j);
+      else if (anyOutside)
+        rightCZ(q, j);
+      else
+        rightCX(j, q);
+      // Flip j where q is set, after which t and u agree on j.
+      if (t[q / 64] & bit(q))
+        t[j / 64] ^= bit(j);
+      if (u[q / 64] & bit(q))
+        u[j / 64] ^= bit(j);
+    }
+
+    // The pivot qubit holds H^{v_q} (a |t_q> + b |u_q>) = lambda S^k H^h |0>
+    // or lambda |bit>.
+    const bool tq = t[q / 64] & bit(q);
+    complex local[2];
+    local[tq] = a;
+    local[!tq] = b;
+    if (v[q / 64] & bit(q)) {
+      const complex zero = (local[0] + local[1]) * M_SQRT1_2;
+      local[1] = (local[0] - local[1]) * M_SQRT1_2;
+      local[0] = zero;
+    }
+    s = std::move(t);
+    if (std::abs(local[1]) < tolerance) {
+      omega *= local[0];
+      v[q / 64] &= ~bit(q);
+      s[q / 64] &= ~bit(q);
+    } else if (std::abs(local[0]) < tolerance) {
+      omega *= local[1];
+      v[q / 64] &= ~bit(q);
+      s[q / 64] |= bit(q);
+    } else {
+      const complex ratio = local[1] / local[0];
+      const int k = ((static_cast<int>(std::lround(std::arg(ratio) /
+                                                   (M_PI / 2))) %
+                      4) +
+                     4) %
+                    4;
+      for (int i = 0; i < k; ++i)
+        rightS(q);
+      omega *= local[0] * M_SQRT2;
+      v[q / 64] |= bit(q);
+      s[q / 64] &= ~bit(q);
+    }
+  }
+};
+
+/// @brief A quantum state as a linear combination of stabilizer states, whose
+/// number of terms is exponential in the number of non-Clifford gates only.
+class StabilizerSum {
+public:
+  explicit StabilizerSum(std::size_t numQubits)
+      : terms{CHForm(numQubits)}, numQubits(numQubits) {}
+
+  std::size_t size() const { return terms.size(); }
+  const std::vector<CHForm> &getTerms() const { return terms; }
+
+  void addQubits(std::size_t count) {
+    for (auto &term : terms)
+      term.addQubits(count);
+    numQubits += count;
+  }
+
+  /// @brief Apply the operator `op` to every term. Sums of several circuits
+  /// multiply the number of terms, after which equal terms are merged and
+  /// vanishing ones dropped.
+  void apply(const CliffordSum &op, std::size_t maxTerms) {
+    if (op.terms.size() == 1) {
+      for (auto &term : terms) {
+        for (const auto &gate : op.terms[0].gates)
+          term.apply(gate);
+        term.scale(op.terms[0].coefficient);
+      }
+      return;
+    }
+    std::vector<CHForm> expanded;
+    expanded.reserve(terms.size() * op.terms.size());
+    for (const auto &term : terms)
+      for (const auto &opTerm : op.terms) {
+        if (std::abs(opTerm.coefficient) < tolerance)
+          continue;
+        auto &copy = expanded.emplace_back(term);
+        for (const auto &gate : opTerm.gates)
+          copy.apply(gate);
+        copy.scale(opTerm.coefficient);
+      }
+    terms = std::move(expanded);
+    merge();
+    if (terms.size() > maxTerms)
+      throw std::runtime_error(
+          "The stabilizer decomposition has " + std::to_string(terms.size()) +
+          " terms, more than the maximum of " + std::to_string(maxTerms) + ".");
+  }
+
+  /// @brief Project qubit `q` onto |outcome>, without renormalizing.
+  void project(std::size_t q, bool outcome) {
+    std::vector<CHForm> projected;
+    projected.reserve(terms.size());
+    for (auto &term : terms)
+      if (term.project(q, outcome))
+        projected.push_back(std::move(term));
+    terms = std::move(projected);
+    merge();
+    if (terms.empty())
+      throw std::runtime_error("Projection onto a zero-probability outcome.");
+  }
+
+  /// @brief The amplitude `<x|psi>` and the sum of the squared magnitudes of
+  /// the amplitudes of every term.
+  std::pair<complex, double> amplitude(const CHForm::Bits &x) const {
+    double re = 0, im = 0, weight = 0;
+    const std::int64_t numTerms = terms.size();
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : re, im, weight) if (numTerms > 256)
+#endif
+    for (std::int64_t i = 0; i < numTerms; ++i) {
+      const complex a = terms[i].amplitude(x);
+      re += a.real();
+      im += a.imag();
+      weight += std::norm(a);
+    }
+    return {{re, im}, weight};
+  }
+
+  /// @brief Draw `count` basis states from `|<x|psi>|^2` with an independence
+  /// Metropolis-Hastings chain, whose proposals pick a term with probability
+  /// proportional to its weight and then a basis state from its (uniform)
+  /// distribution. With a single term, every proposal is accepted and the
+  /// samples are exact. The first `mixingSteps` states are discarded.
+  template <typename Rng>
+  std::vector<CHForm::Bits> sample(std::size_t count, std::size_t mixingSteps,
+                                   Rng &rng) const {
+    std::vector<double> weights;
+    weights.reserve(terms.size());
+    for (const auto &term : terms)
+      weights.push_back(std::norm(term.coefficient()));
+    std::discrete_distribution<std::size_t> pickTerm(weights.begin(),
+                                                     weights.end());
+    std::uniform_real_distribution<double> uniform(0., 1.);
+
+    CHForm::Bits x, proposal;
+    double p = 0, q = 0;
+    auto propose = [&]() {
+      terms[pickTerm(rng)].sample(rng, proposal);
+      const auto [amplitude, weight] = this->amplitude(proposal);
+      return std::pair{std::norm(amplitude), weight};
+    };
+    // Start from a basis state of nonzero probability.
+    for (std::size_t attempt = 0; p <= 0; ++attempt) {
+      if (attempt == 1000)
+        throw std::runtime_error("Failed to find a basis state of nonzero "
+                                 "probability to sample from.");
+      std::tie(p, q) = propose();
+      x = proposal;
+    }
+
+    std::vector<CHForm::Bits> samples;
+    samples.reserve(count);
+    const bool exact = terms.size() == 1;
+    for (std::size_t step = 0; samples.size() < count; ++step) {
+      if (step > 0 || exact) {
+        const auto [pNew, qNew] = propose();
+        // Accept with probability min(1, p' q / (p q')).
+        if (exact || pNew * q >= uniform(rng) * p * qNew) {
+          x = proposal;
+          p = pNew;
+          q = qNew;
+        }
+      }
+      if (exact || step >= mixingSteps)
+        samples.push_back(x);
+    }
+    return samples;
+  }
+
+private:
+  std::vector<CHForm> terms;
+  std::size_t numQubits;
+
+  /// @brief Merge equal terms, drop the ones that are negligible next to the
+  /// largest one, and rescale so that the largest coefficient has magnitude
+  /// 1. The state is only defined up to normalization, and rescaling keeps
+  /// repeated projections from underflowing.
+  void merge() {
+    std::unordered_map<std::string, std::size_t> index;
+    std::vector<CHForm> merged;
+    merged.reserve(terms.size());
+    for (auto &term : terms) {
+      auto [iter, inserted] = index.try_emplace(term.key(), merged.size());
+      if (inserted)
+        merged.push_back(std::move(term));
+      else
+        merged[iter->second].addToCoefficient(term.coefficient());
+    }
+    double largest = 0;
+    for (const auto &term : merged)
+      largest = std::max(largest, std::abs(term.coefficient()));
+    terms.clear();
+    for (auto &term : merged)
+      if (std::abs(term.coefficient()) > tolerance * largest) {
+        term.scale(1. / largest);
+        terms.push_back(std::move(term));
+      }
+  }
+};
+
+} // namespace nvqir::extstab
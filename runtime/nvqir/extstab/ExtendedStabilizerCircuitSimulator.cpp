@@ -0,0 +1,255 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "ExtendedStabilizer.h"
+#include "common/FmtCore.h"
+#include "nvqir/CircuitSimulator.h"
+
+using namespace cudaq;
+
+namespace nvqir {
+
+/// @brief The ExtendedStabilizerCircuitSimulator simulates circuits with few
+/// non-Clifford gates by keeping the state as a linear combination of
+/// stabilizer states. Clifford gates are applied to every term; each
+/// non-Clifford gate is decomposed into a sum of Clifford circuits, e.g. a T
+/// gate into two, and multiplies the number of terms accordingly. The cost
+/// is linear in the number of terms, so exponential in the number of
+/// non-Clifford gates only, and polynomial in the number of qubits.
+/// Measurements are sampled with a Metropolis-Hastings chain over basis
+/// states, which is exact when the state is a single stabilizer state.
+class ExtendedStabilizerCircuitSimulator
+    : public nvqir::CircuitSimulatorBase<double> {
+protected:
+  /// @brief Environment variable names of the simulator options.
+  static constexpr const char mixingTimeEnvVar[] =
+      "CUDAQ_EXTENDED_STABILIZER_MIXING_TIME";
+  static constexpr const char maxTermsEnvVar[] =
+      "CUDAQ_EXTENDED_STABILIZER_MAX_TERMS";
+
+  /// @brief The number of chain steps discarded before the first sample.
+  std::size_t mixingTime = 500;
+
+  /// @brief The maximum number of terms of the state, beyond which gate
+  /// application throws rather than exhausting memory.
+  std::size_t maxTerms = 1 << 16;
+
+  /// @brief The number of samples expectation values are estimated from when
+  /// no shots are requested.
+  static constexpr std::size_t numExpectationSamples = 10000;
+
+  /// @brief The state, as a sum of stabilizer states.
+  std::unique_ptr<extstab::StabilizerSum> state;
+
+  std::mt19937_64 randomEngine{std::random_device{}()};
+
+  /// @brief Return the Pauli `kind` on `target` controlled by `controls`.
+  /// The last control is applied as a Clifford CX, CY or CZ, the others are
+  /// expanded into projectors.
+  static extstab::CliffordSum
+  controlledPauli(extstab::CliffordGate::Kind kind,
+                  std::span<const std::size_t> controls, std::size_t target) {
+    using extstab::CliffordGate;
+    if (controls.empty())
+      return extstab::CliffordSum::of({{kind, target}});
+    const std::size_t control = controls.back();
+    extstab::CliffordSum gate;
+    if (kind == CliffordGate::X)
+      gate = extstab::CliffordSum::of({{CliffordGate::CX, control, target}});
+    else if (kind == CliffordGate::Z)
+      gate = extstab::CliffordSum::of({{CliffordGate::CZ, control, target}});
+    else
+      gate = extstab::CliffordSum::of({{CliffordGate::Sdg, target},
+                                       {CliffordGate::CX, control, target},
+                                       {CliffordGate::S, target}});
+    return extstab::controlled(gate, controls.first(controls.size() - 1));
+  }
+
+  /// @brief Decompose the gate of `task` into a sum of Clifford circuits.
+  static extstab::CliffordSum decompose(const GateApplicationTask &task) {
+    using extstab::CliffordGate;
+    const auto &name = task.operationName;
+    const auto &controls = task.controls;
+    if (name == "swap" && task.targets.size() == 2) {
+      // SWAP = CX(b, a) CX(a, b) CX(b, a), of which only the middle gate
+      // carries the controls.
+      const auto a = task.targets[0], b = task.targets[1];
+      const auto outer = extstab::CliffordSum::of({{CliffordGate::CX, b, a}});
+      std::vector<std::size_t> innerControls(controls);
+      innerControls.push_back(a);
+      return extstab::CliffordSum::then(
+          extstab::CliffordSum::then(
+              outer, controlledPauli(CliffordGate::X, innerControls, b)),
+          outer);
+    }
+    if (task.targets.size() != 1)
+      throw std::runtime_error(cudaq_fmt::format(
+          "Gate {} acts on {} target qubits, the extended stabilizer "
+          "simulator supports single-qubit gates (with any number of "
+          "controls) and swap.",
+          name, task.targets.size()));
+
+    const auto target = task.targets[0];
+    if (name == "x")
+      return controlledPauli(CliffordGate::X, controls, target);
+    if (name == "y")
+      return controlledPauli(CliffordGate::Y, controls, target);
+    if (name == "z")
+      return controlledPauli(CliffordGate::Z, controls, target);
+    if (name == "h")
+      return extstab::controlled(
+          extstab::CliffordSum::of({{CliffordGate::H, target}}), controls);
+    if (name == "s" && controls.empty())
+      return extstab::CliffordSum::of({{CliffordGate::S, target}});
+    if (name == "sdg" && controls.empty())
+      return extstab::CliffordSum::of({{CliffordGate::Sdg, target}});
+    // Any other gate, e.g., T and rotations, from its matrix. Clifford
+    // angles do not branch.
+    return extstab::controlled(extstab::singleQubitGate(task.matrix, target),
+                               controls);
+  }
+
+  /// @brief Return whether `qubit` is set in the packed basis state `bits`.
+  static bool isSet(const extstab::CHForm::Bits &bits, std::size_t qubit) {
+    return (bits[qubit / 64] >> (qubit % 64)) & 1;
+  }
+
+  void addQubitToState() override { addQubitsToState(1); }
+
+  void addQubitsToState(std::size_t count,
+                        const void *stateDataIn = nullptr) override {
+    if (stateDataIn)
+      throw std::runtime_error("The extended stabilizer simulator does not "
+                               "support initialization of qubits from state "
+                               "data.");
+    if (!state)
+      state = std::make_unique<extstab::StabilizerSum>(count);
+    else
+      state->addQubits(count);
+  }
+
+  void deallocateStateImpl() override { state.reset(); }
+
+  void applyGate(const GateApplicationTask &task) override {
+    const std::size_t numTerms = state->size();
+    state->apply(decompose(task), maxTerms);
+    if (state->size() != numTerms)
+      CUDAQ_INFO("Gate {} changed the number of stabilizer terms from {} to "
+                 "{}.",
+                 task.operationName, numTerms, state->size());
+  }
+
+  void setToZeroState() override {
+    state = std::make_unique<extstab::StabilizerSum>(nQubitsAllocated);
+  }
+
+  /// @brief Override the calculateStateDim because this is not a state vector
+  /// simulator.
+  std::size_t calculateStateDim(const std::size_t numQubits) override {
+    return 0;
+  }
+
+  /// @brief Draw the outcome from a single sample of the state, and project
+  /// every term onto it.
+  bool measureQubit(const std::size_t index) override {
+    const auto samples = state->sample(1, mixingTime, randomEngine);
+    const bool outcome = isSet(samples[0], index);
+    state->project(index, outcome);
+    CUDAQ_INFO("Measured qubit {} -> {}", index, outcome);
+    return outcome;
+  }
+
+public:
+  ExtendedStabilizerCircuitSimulator() {
+    // Populate the correct name so it is printed correctly during
+    // deconstructor.
+    summaryData.name = name();
+    if (auto *mixingTimeEnvVal = std::getenv(mixingTimeEnvVar)) {
+      const auto value = std::atoll(mixingTimeEnvVal);
+      if (value < 0 || (value == 0 && std::string(mixingTimeEnvVal) != "0"))
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting a "
+            "non-negative integer, got '{}'.",
+            mixingTimeEnvVar, mixingTimeEnvVal));
+      mixingTime = value;
+    }
+    if (auto *maxTermsEnvVal = std::getenv(maxTermsEnvVar)) {
+      const auto value = std::atoll(maxTermsEnvVal);
+      if (value <= 0)
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting a positive "
+            "integer, got '{}'.",
+            maxTermsEnvVar, maxTermsEnvVal));
+      maxTerms = value;
+    }
+  }
+  virtual ~ExtendedStabilizerCircuitSimulator() = default;
+
+  void setRandomSeed(std::size_t seed) override {
+    randomEngine = std::mt19937_64(seed);
+  }
+
+  bool canHandleObserve() override { return false; }
+
+  void resetQubit(const std::size_t index) override {
+    flushGateQueue();
+    flushAnySamplingTasks();
+    if (measureQubit(index))
+      state->apply(
+          extstab::CliffordSum::of({{extstab::CliffordGate::X, index}}),
+          maxTerms);
+  }
+
+  /// @brief Sample the given qubits. Without shots, the expectation value of
+  /// their parity is estimated from `numExpectationSamples` samples.
+  cudaq::ExecutionResult sample(const std::vector<std::size_t> &qubits,
+                                const int shots) override {
+    if (!state)
+      throw std::runtime_error("The extended stabilizer simulator state is "
+                               "not initialized. Cannot sample from "
+                               "uninitialized state.");
+    const std::size_t numSamples = shots < 1 ? numExpectationSamples : shots;
+    const auto samples = state->sample(numSamples, mixingTime, randomEngine);
+    CUDAQ_INFO("Drew {} samples from a sum of {} stabilizer states.",
+               numSamples, state->size());
+
+    std::unordered_map<std::string, std::size_t> counts;
+    std::string bits(qubits.size(), '0');
+    double expectation = 0.;
+    for (const auto &sample : samples) {
+      bool odd = false;
+      for (std::size_t i = 0; i < qubits.size(); ++i) {
+        const bool bit = isSet(sample, qubits[i]);
+        bits[i] = bit ? '1' : '0';
+        odd ^= bit;
+      }
+      expectation += odd ? -1. : 1.;
+      if (shots > 0)
+        ++counts[bits];
+    }
+    expectation /= numSamples;
+    if (shots < 1)
+      return cudaq::ExecutionResult{{}, expectation};
+
+    cudaq::ExecutionResult result;
+    for (const auto &[bitstring, count] : counts)
+      result.appendResult(bitstring, count);
+    result.expectationValue = expectation;
+    return result;
+  }
+
+  bool isStateVectorSimulator() const override { return false; }
+
+  std::string name() const override { return "extstab"; }
+  NVQIR_SIMULATOR_CLONE_IMPL(ExtendedStabilizerCircuitSimulator)
+};
+
+} // namespace nvqir
+
+/// Register this Simulator with NVQIR.
+NVQIR_REGISTER_SIMULATOR(nvqir::ExtendedStabilizerCircuitSimulator, extstab)
@@ -0,0 +1,328 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// Heisenberg-picture propagation of observables as sums of Pauli strings.
+/// A Pauli string on `n` qubits is stored as two bitmasks of `n` bits, `x`
+/// then `z`, each packed in 64-bit words: qubit `q` holds I (x=0, z=0),
+/// X (1, 0), Z (0, 1) or Y (1, 1). Coefficients are real, since conjugating a
+/// Hermitian observable by a unitary keeps it Hermitian.
+///
+/// Gates are described as in the rest of NVQIR: row-major matrices where the
+/// first qubit of a gate maps to the most significant bit of the matrix index.
+namespace nvqir::pauliprop {
+
+using complex = std::complex<double>;
+
+/// @brief Thresholds under which propagated terms are dropped.
+struct Truncation {
+  /// Terms whose coefficient magnitude is below this are dropped. Zero only
+  /// drops the terms that cancel out exactly.
+  double minCoefficient = 0.0;
+  /// Terms acting non-trivially on more qubits than this are dropped. Zero
+  /// disables weight truncation.
+  std::size_t maxWeight = 0;
+};
+
+/// @brief The action of a `k`-qubit gate `G` on the Pauli strings of its
+/// qubits under Heisenberg conjugation, `P -> G^dagger P G`. A local Pauli
+/// string is encoded as `x | (z << k)`, with bit `k - 1 - j` of each mask
+/// standing for the `j`-th qubit of the gate.
+class TransferMap {
+public:
+  struct Entry {
+    std::uint32_t code;
+    double coefficient;
+  };
+
+  /// @brief Gates on more qubits than this are rejected, the map of a `k`
+  /// qubit gate has `16^k` coefficients.
+  static constexpr std::size_t maxQubits = 4;
+
+  /// @brief Build the map of the `2^k x 2^k` unitary `matrix`.
+  TransferMap(const std::vector<complex> &matrix, std::size_t numQubits)
+      : k(numQubits) {
+    if (k > maxQubits)
+      throw std::runtime_error(
+          "Pauli propagation supports gates on at most " +
+          std::to_string(maxQubits) + " qubits, including controls; got " +
+          std::to_string(k) + ".");
+    const std::size_t dim = std::size_t(1) << k;
+    const std::size_t numCodes = dim * dim;
+    if (matrix.size() != numCodes)
+      throw std::runtime_error("Invalid gate matrix size for Pauli "
+                               "propagation.");
+
+    offsets.reserve(numCodes + 1);
+    offsets.push_back(0);
+    std::vector<complex> pg(numCodes), m(numCodes);
+    for (std::uint32_t p = 0; p < numCodes; ++p) {
+      // (P G)(r, c) = phase_P(r ^ x) G(r ^ x, c)
+      const std::size_t xp = p & (dim - 1);
+      for (std::size_t r = 0; r < dim; ++r) {
+        const complex phase = pauliPhase(p, r ^ xp);
+        for (std::size_t c = 0; c < dim; ++c)
+          pg[r * dim + c] = phase * matrix[(r ^ xp) * dim + c];
+      }
+      // M = G^dagger (P G)
+      for (std::size_t r = 0; r < dim; ++r)
+        for (std::size_t c = 0; c < dim; ++c) {
+          complex sum = 0.;
+          for (std::size_t s = 0; s < dim; ++s)
+            sum += std::conj(matrix[s * dim + r]) * pg[s * dim + c];
+          m[r * dim + c] = sum;
+        }
+      // Expand M in the Pauli basis, c_Q = Tr(Q M) / 2^k.
+      for (std::uint32_t q = 0; q < numCodes; ++q) {
+        const std::size_t xq = q & (dim - 1);
+        complex trace = 0.;
+        for (std::size_t a = 0; a < dim; ++a)
+          trace += pauliPhase(q, a) * m[a * dim + (a ^ xq)];
+        const double coefficient = trace.real() / dim;
+        if (std::abs(coefficient) > coefficientTolerance)
+          entries.push_back({q, coefficient});
+      }
+      if (entries.size() - offsets.back() != 1)
+        branching = true;
+      offsets.push_back(entries.size());
+    }
+  }
+
+  std::size_t numQubits() const { return k; }
+
+  /// @brief Return the terms the local Pauli string `code` is mapped to.
+  std::span<const Entry> image(std::uint32_t code) const {
+    return {entries.data() + offsets[code],
+            entries.data() + offsets[code + 1]};
+  }
+
+  /// @brief True if some Pauli string is mapped to a sum of several strings,
+  /// i.e., the gate is not a Clifford gate.
+  bool isBranching() const { return branching; }
+
+private:
+  /// Coefficients of the expansion below this are rounding errors.
+  static constexpr double coefficientTolerance = 1e-12;
+
+  /// @brief Return `phase` such that `P |a> = phase |a ^ x>` for the local
+  /// Pauli string `code = x | (z << k)`, with `Y = i X Z`.
+  complex pauliPhase(std::uint32_t code, std::size_t a) const {
+    const std::size_t dim = std::size_t(1) << k;
+    const std::size_t x = code & (dim - 1);
+    const std::size_t z = code >> k;
+    static constexpr complex powersOfI[] = {
+        {1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+    const int power = std::popcount(x & z) + 2 * std::popcount(a & z);
+    return powersOfI[power % 4];
+  }
+
+  std::size_t k;
+  std::vector<std::size_t> offsets;
+  std::vector<Entry> entries;
+  bool branching = false;
+};
+
+/// @brief A real linear combination of Pauli strings on `numQubits` qubits.
+class PauliSum {
+public:
+  explicit PauliSum(std::size_t numQubits)
+      : numQubits(numQubits), numWords((numQubits + 63) / 64),
+        stride(2 * numWords) {}
+
+  /// @brief Add `coefficient` times the Pauli string `paulis`, whose `q`-th
+  /// character ('I', 'X', 'Y' or 'Z') acts on qubit `q`. Duplicates are only
+  /// merged by the next branching conjugation.
+  void addTerm(std::string_view paulis, double coefficient) {
+    if (paulis.size() > numQubits)
+      throw std::runtime_error("Pauli string is wider than the Pauli sum.");
+    const std::size_t offset = bits.size();
+    bits.resize(offset + stride, 0);
+    for (std::size_t q = 0; q < paulis.size(); ++q) {
+      const char p = paulis[q];
+      const std::uint64_t mask = std::uint64_t(1) << (q % 64);
+      if (p == 'X' || p == 'Y')
+        bits[offset + q / 64] |= mask;
+      if (p == 'Z' || p == 'Y')
+        bits[offset + numWords + q / 64] |= mask;
+      if (p != 'I' && p != 'X' && p != 'Y' && p != 'Z')
+        throw std::runtime_error(std::string("Invalid Pauli '") + p + "'.");
+    }
+    coefficients.push_back(coefficient);
+  }
+
+  std::size_t size() const { return coefficients.size(); }
+
+  /// @brief Conjugate every term by a gate on `qubits` (in the order of the
+  /// gate matrix) with transfer map `map`, then drop the terms that fall
+  /// under `truncation`. Terms are expanded in parallel chunks.
+  void conjugate(const std::vector<std::size_t> &qubits, const TransferMap &map,
+                 const Truncation &truncation) {
+    const std::size_t k = qubits.size();
+    std::vector<std::size_t> words(k);
+    std::vector<std::uint64_t> masks(k);
+    for (std::size_t j = 0; j < k; ++j) {
+      words[j] = qubits[j] / 64;
+      masks[j] = std::uint64_t(1) << (qubits[j] % 64);
+    }
+
+    const std::size_t numTerms = size();
+    if (numTerms == 0)
+      return;
+    const std::size_t numChunks = (numTerms + chunkSize - 1) / chunkSize;
+    std::vector<std::vector<std::uint64_t>> chunkBits(numChunks);
+    std::vector<std::vector<double>> chunkCoefficients(numChunks);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if (numChunks > 1)
+#endif
+    for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+      auto &outBits = chunkBits[chunk];
+      auto &outCoefficients = chunkCoefficients[chunk];
+      const std::size_t end = std::min(numTerms, (chunk + 1) * chunkSize);
+      for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+        const std::uint64_t *term = &bits[i * stride];
+        std::uint32_t code = 0;
+        for (std::size_t j = 0; j < k; ++j) {
+          const std::size_t bit = k - 1 - j;
+          if (term[words[j]] & masks[j])
+            code |= 1u << bit;
+          if (term[numWords + words[j]] & masks[j])
+            code |= 1u << (bit + k);
+        }
+        for (const auto &entry : map.image(code)) {
+          const double coefficient = coefficients[i] * entry.coefficient;
+          if (std::abs(coefficient) < truncation.minCoefficient)
+            continue;
+          const std::size_t offset = outBits.size();
+          outBits.insert(outBits.end(), term, term + stride);
+          std::uint64_t *image = &outBits[offset];
+          for (std::size_t j = 0; j < k; ++j) {
+            const std::size_t bit = k - 1 - j;
+            setBit(image[words[j]], masks[j], (entry.code >> bit) & 1);
+            setBit(image[numWords + words[j]], masks[j],
+                   (entry.code >> (bit + k)) & 1);
+          }
+          if (truncation.maxWeight > 0 && code != entry.code &&
+              weight(image) > truncation.maxWeight) {
+            outBits.resize(offset);
+            continue;
+          }
+          outCoefficients.push_back(coefficient);
+        }
+      }
+    }
+
+    if (numChunks == 1) {
+      bits = std::move(chunkBits[0]);
+      coefficients = std::move(chunkCoefficients[0]);
+    } else {
+      bits.clear();
+      coefficients.clear();
+      for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+        bits.insert(bits.end(), chunkBits[chunk].begin(),
+                    chunkBits[chunk].end());
+        coefficients.insert(coefficients.end(),
+                            chunkCoefficients[chunk].begin(),
+                            chunkCoefficients[chunk].end());
+      }
+    }
+
+    // Clifford gates permute the Pauli strings, so only branching gates can
+    // produce duplicates.
+    if (map.isBranching())
+      mergeDuplicates(truncation.minCoefficient);
+  }
+
+  /// @brief Return the expectation value of the sum on `|0...0>`, to which
+  /// only the strings made of I and Z contribute.
+  double expectationOnZeroState() const {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < size(); ++i) {
+      const std::uint64_t *term = &bits[i * stride];
+      bool diagonal = true;
+      for (std::size_t w = 0; w < numWords && diagonal; ++w)
+        diagonal = term[w] == 0;
+      if (diagonal)
+        sum += coefficients[i];
+    }
+    return sum;
+  }
+
+private:
+  /// The number of terms expanded by one task.
+  static constexpr std::size_t chunkSize = 4096;
+
+  static void setBit(std::uint64_t &word, std::uint64_t mask, bool value) {
+    word = value ? word | mask : word & ~mask;
+  }
+
+  std::size_t weight(const std::uint64_t *term) const {
+    std::size_t count = 0;
+    for (std::size_t w = 0; w < numWords; ++w)
+      count += std::popcount(term[w] | term[numWords + w]);
+    return count;
+  }
+
+  /// @brief Sum the coefficients of equal strings, compacting the storage in
+  /// place, and drop the sums under `minCoefficient` or cancelling out.
+  void mergeDuplicates(double minCoefficient) {
+    const std::size_t numBytes = stride * sizeof(std::uint64_t);
+    std::unordered_map<std::string_view, std::size_t> index;
+    index.reserve(size());
+    std::size_t numUnique = 0;
+    for (std::size_t i = 0; i < size(); ++i) {
+      // Unique strings are compacted before `i`, so the keys stay valid.
+      if (numUnique != i)
+        std::copy_n(&bits[i * stride], stride, &bits[numUnique * stride]);
+      std::string_view key(
+          reinterpret_cast<const char *>(&bits[numUnique * stride]),
+          numBytes);
+      auto [iter, inserted] = index.try_emplace(key, numUnique);
+      if (!inserted) {
+        coefficients[iter->second] += coefficients[i];
+        continue;
+      }
+      coefficients[numUnique++] = coefficients[i];
+    }
+
+    std::size_t numKept = 0;
+    for (std::size_t i = 0; i < numUnique; ++i) {
+      if (coefficients[i] == 0.0 ||
+          std::abs(coefficients[i]) < minCoefficient)
+        continue;
+      if (numKept != i) {
+        std::copy_n(&bits[i * stride], stride, &bits[numKept * stride]);
+        coefficients[numKept] = coefficients[i];
+      }
+      ++numKept;
+    }
+    bits.resize(numKept * stride);
+    coefficients.resize(numKept);
+  }
+
+  std::size_t numQubits;
+  std::size_t numWords;
+  std::size_t stride;
+  std::vector<std::uint64_t> bits;
+  std::vector<double> coefficients;
+};
+
+} // namespace nvqir::pauliprop
@@ -0,0 +1,207 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PauliPropagation.h"
+#include "common/FmtCore.h"
+#include "nvqir/CircuitSimulator.h"
+
+using namespace cudaq;
+
+namespace nvqir {
+
+/// @brief The PauliPropagationCircuitSimulator computes exact `observe`
+/// expectation values in the Heisenberg picture: the gates of the kernel are
+/// recorded, and on observation the spin operator is conjugated backwards
+/// through them as a sum of Pauli strings, whose expectation value on |0...0>
+/// is then read off. Clifford gates map each string to a single string, so
+/// the cost grows with the number of non-Clifford gates and the support of
+/// the observable rather than with the number of qubits. Sums that grow too
+/// large may be truncated by coefficient and by weight.
+class PauliPropagationCircuitSimulator
+    : public nvqir::CircuitSimulatorBase<double> {
+protected:
+  /// @brief Environment variable names of the truncation thresholds.
+  static constexpr const char minCoefficientEnvVar[] =
+      "CUDAQ_PAULI_PROPAGATION_MIN_COEFFICIENT";
+  static constexpr const char maxWeightEnvVar[] =
+      "CUDAQ_PAULI_PROPAGATION_MAX_WEIGHT";
+
+  /// @brief The maximum number of transfer maps to keep, beyond which the
+  /// cache is cleared.
+  static constexpr std::size_t maxCachedTransferMaps = 1024;
+
+  /// @brief The gates applied since the qubits were allocated.
+  std::vector<GateApplicationTask> tape;
+
+  /// @brief The thresholds under which propagated terms are dropped.
+  pauliprop::Truncation truncation;
+
+  /// @brief Transfer maps of the gates seen so far, keyed by their number of
+  /// controls and matrix, so that repeated gates are only expanded once.
+  std::unordered_map<std::string, pauliprop::TransferMap> transferMaps;
+
+  /// @brief Return the transfer map of `task`, with the controls as the
+  /// leading qubits of the gate.
+  const pauliprop::TransferMap &
+  getTransferMap(const GateApplicationTask &task) {
+    const std::size_t numControls = task.controls.size();
+    std::string key(reinterpret_cast<const char *>(&numControls),
+                    sizeof(numControls));
+    key.append(reinterpret_cast<const char *>(task.matrix.data()),
+               task.matrix.size() * sizeof(task.matrix[0]));
+    if (auto iter = transferMaps.find(key); iter != transferMaps.end())
+      return iter->second;
+
+    const std::size_t numQubits = numControls + task.targets.size();
+    if (numQubits > pauliprop::TransferMap::maxQubits)
+      throw std::runtime_error(cudaq_fmt::format(
+          "Gate {} acts on {} qubits (including controls), the Pauli "
+          "propagation simulator supports at most {}.",
+          task.operationName, numQubits, pauliprop::TransferMap::maxQubits));
+    const std::size_t dim = 1ULL << numQubits;
+    const std::size_t targetDim = 1ULL << task.targets.size();
+    const std::size_t controlMask = dim - targetDim;
+    std::vector<pauliprop::complex> matrix(dim * dim, 0.0);
+    for (std::size_t i = 0; i < controlMask; ++i)
+      matrix[i * dim + i] = 1.0;
+    for (std::size_t r = 0; r < targetDim; ++r)
+      for (std::size_t c = 0; c < targetDim; ++c)
+        matrix[(controlMask | r) * dim + (controlMask | c)] =
+            task.matrix[r * targetDim + c];
+
+    if (transferMaps.size() >= maxCachedTransferMaps)
+      transferMaps.clear();
+    return transferMaps.try_emplace(key, matrix, numQubits).first->second;
+  }
+
+  void addQubitToState() override {}
+
+  void addQubitsToState(std::size_t count,
+                        const void *state = nullptr) override {
+    if (state)
+      throw std::runtime_error("The Pauli propagation simulator does not "
+                               "support initialization of qubits from state "
+                               "data.");
+  }
+
+  void deallocateStateImpl() override { tape.clear(); }
+
+  /// @brief Record the gate, gates are only applied to the observable.
+  void applyGate(const GateApplicationTask &task) override {
+    tape.push_back(task);
+  }
+
+  void setToZeroState() override { tape.clear(); }
+
+  /// @brief Override the calculateStateDim because this is not a state vector
+  /// simulator.
+  std::size_t calculateStateDim(const std::size_t numQubits) override {
+    return 0;
+  }
+
+  bool measureQubit(const std::size_t index) override {
+    throw std::runtime_error("The Pauli propagation simulator only supports "
+                             "observe, qubits cannot be measured.");
+  }
+
+public:
+  PauliPropagationCircuitSimulator() {
+    // Populate the correct name so it is printed correctly during
+    // deconstructor.
+    summaryData.name = name();
+    if (auto *minCoefficientEnvVal = std::getenv(minCoefficientEnvVar)) {
+      char *end = nullptr;
+      const double minCoefficient = std::strtod(minCoefficientEnvVal, &end);
+      if (*minCoefficientEnvVal == '\0' || *end != '\0' || minCoefficient < 0)
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting a "
+            "non-negative number, got '{}'.",
+            minCoefficientEnvVar, minCoefficientEnvVal));
+      truncation.minCoefficient = minCoefficient;
+    }
+    if (auto *maxWeightEnvVal = std::getenv(maxWeightEnvVar)) {
+      const int maxWeight = std::atoi(maxWeightEnvVal);
+      if (maxWeight < 0)
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting a "
+            "non-negative integer, got '{}'.",
+            maxWeightEnvVar, maxWeightEnvVal));
+      truncation.maxWeight = maxWeight;
+    }
+  }
+  virtual ~PauliPropagationCircuitSimulator() = default;
+
+  /// @brief Expectation values are always computed exactly (up to
+  /// truncation), whether or not shots were requested.
+  bool canHandleObserve() override { return true; }
+
+  cudaq::observe_result observe(const cudaq::spin_op &op) override {
+    flushGateQueue();
+
+    std::size_t numQubits = nQubitsAllocated;
+    for (auto degree : op.degrees())
+      numQubits = std::max(numQubits, degree + 1);
+    for (const auto &task : tape) {
+      for (auto q : task.controls)
+        numQubits = std::max(numQubits, q + 1);
+      for (auto q : task.targets)
+        numQubits = std::max(numQubits, q + 1);
+    }
+    pauliprop::PauliSum sum(numQubits);
+    std::string paulis;
+    for (const auto &term : op) {
+      paulis.assign(numQubits, 'I');
+      for (const auto &p : term) {
+        const auto pauli = p.as_pauli();
+        paulis[p.target()] = pauli == cudaq::pauli::X   ? 'X'
+                             : pauli == cudaq::pauli::Y ? 'Y'
+                             : pauli == cudaq::pauli::Z ? 'Z'
+                                                        : 'I';
+      }
+      sum.addTerm(paulis, term.evaluate_coefficient().real());
+    }
+
+    // O -> G^dagger O G, from the last gate to the first.
+    std::vector<std::size_t> qubits;
+    std::size_t maxTerms = sum.size();
+    for (auto iter = tape.rbegin(); iter != tape.rend(); ++iter) {
+      qubits = iter->controls;
+      qubits.insert(qubits.end(), iter->targets.begin(), iter->targets.end());
+      sum.conjugate(qubits, getTransferMap(*iter), truncation);
+      maxTerms = std::max(maxTerms, sum.size());
+    }
+    CUDAQ_INFO("Propagated {} terms through {} gates, with at most {} terms.",
+               op.num_terms(), tape.size(), maxTerms);
+
+    const double ee = sum.expectationOnZeroState();
+    return cudaq::observe_result(
+        ee, op,
+        cudaq::sample_result(cudaq::ExecutionResult({}, op.to_string(), ee)));
+  }
+
+  void resetQubit(const std::size_t index) override {
+    throw std::runtime_error("The Pauli propagation simulator only supports "
+                             "observe, qubits cannot be reset.");
+  }
+
+  cudaq::ExecutionResult sample(const std::vector<std::size_t> &qubits,
+                                const int shots) override {
+    throw std::runtime_error("The Pauli propagation simulator only supports "
+                             "observe, kernels cannot be sampled.");
+  }
+
+  bool isStateVectorSimulator() const override { return false; }
+
+  std::string name() const override { return "pauliprop"; }
+  NVQIR_SIMULATOR_CLONE_IMPL(PauliPropagationCircuitSimulator)
+};
+
+} // namespace nvqir
+
+/// Register this Simulator with NVQIR.
+NVQIR_REGISTER_SIMULATOR(nvqir::PauliPropagationCircuitSimulator, pauliprop)
@@ -0,0 +1,115 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace nvqir {
+
+/// @brief A Walker alias table of a discrete distribution, from which each
+/// sample is drawn in constant time with a single random number, whatever the
+/// number of outcomes (Vose's construction, in linear time).
+class AliasTable {
+public:
+  /// @brief Build the table of the distribution proportional to `weights`.
+  explicit AliasTable(const std::vector<double> &weights)
+      : columns(weights.size()) {
+    const std::size_t size = weights.size();
+    double total = 0.0;
+    for (auto weight : weights)
+      total += weight;
+    if (size == 0 || !(total > 0.0))
+      throw std::invalid_argument(
+          "AliasTable requires weights with a positive sum.");
+
+    // Split the outcomes by whether their scaled weight is below the mean,
+    // then fill the column of each small outcome with a large one.
+    std::vector<double> scaled(size);
+    std::vector<std::uint64_t> small, large;
+    for (std::size_t i = 0; i < size; ++i) {
+      scaled[i] = weights[i] * size / total;
+      (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+      const auto s = small.back();
+      const auto l = large.back();
+      small.pop_back();
+      columns[s] = {scaled[s], l};
+      scaled[l] -= 1.0 - scaled[s];
+      if (scaled[l] < 1.0) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+    // The columns left are full, up to rounding.
+    for (auto i : large)
+      columns[i] = {1.0, i};
+    for (auto i : small)
+      columns[i] = {1.0, i};
+  }
+
+  /// @brief Return the number of outcomes.
+  std::size_t size() const { return columns.size(); }
+
+  /// @brief Draw an outcome from the 64 random bits `bits`: the high 53 bits
+  /// give a uniform value whose integer part, once scaled by the number of
+  /// outcomes, picks a column, and whose fractional part picks the outcome of
+  /// the column or its alias.
+  std::uint64_t draw(std::uint64_t bits) const {
+    const double u = (bits >> 11) * 0x1.0p-53 * columns.size();
+    const auto column = std::min<std::uint64_t>(u, columns.size() - 1);
+    return (u - column) < columns[column].threshold ? column
+                                                    : columns[column].alias;
+  }
+
+  /// @brief Draw `count` outcomes. Each fixed-size block of draws uses its own
+  /// engine, seeded from `engine` in order, so that the draws run in parallel
+  /// and do not depend on the number of threads.
+  template <typename Engine>
+  std::vector<std::uint64_t> sample(std::size_t count, Engine &engine) const {
+    constexpr std::size_t blockSize = 1ULL << 16;
+    const std::size_t numBlocks = (count + blockSize - 1) / blockSize;
+    std::vector<std::uint64_t> seeds(numBlocks);
+    for (auto &seed : seeds) {
+      seed = static_cast<std::uint64_t>(engine()) << 32;
+      seed ^= engine();
+    }
+    std::vector<std::uint64_t> outcomes(count);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if (numBlocks > 1)
+#endif
+    for (std::size_t b = 0; b < numBlocks; ++b) {
+      std::mt19937_64 blockEngine(seeds[b]);
+      const std::size_t end = std::min(count, (b + 1) * blockSize);
+      for (std::size_t i = b * blockSize; i < end; ++i)
+        outcomes[i] = draw(blockEngine());
+    }
+    return outcomes;
+  }
+
+private:
+  /// The probability, in a column, of its own outcome over its alias. Both are
+  /// stored together so that a draw reads a single cache line.
+  struct Column {
+    double threshold;
+    std::uint64_t alias;
+  };
+  std::vector<Column> columns;
+};
+
+} // namespace nvqir
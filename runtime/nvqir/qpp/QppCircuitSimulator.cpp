@@ -6,16 +6,24 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 
+#include "AliasTable.h"
+#include "StateVectorKernels.h"
 #include "common/FmtCore.h"
 #include "nvqir/CircuitSimulator.h"
 #include "nvqir/Gates.h"
 
 #include <bit>
+#include <cstdlib>
 #include <iostream>
 #include <qpp.h>
+#include <random>
 #include <set>
 #include <span>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 using namespace cudaq;
 
 namespace nvqir {
@@ -108,6 +116,14 @@ struct QppState : public cudaq::SimulationState {
         reinterpret_cast<std::complex<double> *>(ptr), size));
   }
 
+  std::unique_ptr<SimulationState>
+  createFromSparseData(const sparse_state_data &data) override {
+    qpp::ket k = qpp::ket::Zero(validateSparseData(data));
+    for (const auto &[index, amplitude] : data.amplitudes)
+      k[index] = amplitude;
+    return std::make_unique<QppState>(std::move(k));
+  }
+
   void dump(std::ostream &os) const override { os << state << "\n"; }
 
   precision getPrecision() const override {
@@ -129,6 +145,100 @@ protected:
   /// The QPP state representation (qpp::ket or qpp::cmat)
   StateType state;
 
+  /// @brief Environment variable name that sets the number of OpenMP threads
+  /// used by this backend. Defaults to the OpenMP runtime setting.
+  static constexpr const char numThreadsEnvVar[] = "CUDAQ_QPP_NUM_THREADS";
+
+  /// @brief The random number generator of the measurements. It belongs to
+  /// this simulator, rather than being the one shared by Q++, so that the
+  /// simulators of different threads can measure concurrently.
+  std::mt19937 randomEngine{std::random_device{}()};
+
+  /// @brief Sum `term(i)` for all `i` below `size` in parallel. Partial sums
+  /// are taken over fixed-size blocks and accumulated serially, so that the
+  /// result does not depend on the number of threads.
+  template <typename Term>
+  static double parallelSum(std::size_t size, Term &&term) {
+    constexpr std::size_t blockSize = 1ULL << 12;
+    const std::size_t numBlocks = (size + blockSize - 1) / blockSize;
+    std::vector<double> partials(numBlocks, 0.0);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if (numBlocks > 1)
+#endif
+    for (std::size_t b = 0; b < numBlocks; ++b) {
+      const std::size_t end = std::min(size, (b + 1) * blockSize);
+      double acc = 0.0;
+      for (std::size_t i = b * blockSize; i < end; ++i)
+        acc += term(i);
+      partials[b] = acc;
+    }
+    return std::accumulate(partials.begin(), partials.end(), 0.0);
+  }
+
+  /// @brief Return the |0...0> state vector of dimension `dim`. The amplitudes
+  /// are initialized in parallel with a static schedule, so that on NUMA hosts
+  /// the memory pages are first touched by, and thus placed close to, the
+  /// threads that later update them with the same schedule.
+  static qpp::ket zeroState(std::size_t dim) {
+    qpp::ket zero(dim);
+    auto *data = zero.data();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (std::size_t i = 0; i < dim; ++i)
+      data[i] = 0.0;
+    data[0] = 1.0;
+    return zero;
+  }
+
+  /// @brief Return the probability to measure the qubit with the given
+  /// (CUDA-Q) index in the |1> state.
+  double getProbabilityOfOne(const std::size_t index) override {
+    const std::size_t mask = 1ULL << index;
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      auto *data = state.data();
+      return parallelSum(state.size(), [&](std::size_t i) {
+        return (i & mask) ? std::norm(data[i]) : 0.0;
+      });
+    } else {
+      double probOne = 0.0;
+      for (std::size_t i = 0; i < static_cast<std::size_t>(state.rows()); ++i)
+        if (i & mask)
+          probOne += state(i, i).real();
+      return probOne;
+    }
+  }
+
+  /// @brief Collapse the state in place onto the measurement `result` of the
+  /// qubit with the given (CUDA-Q) index, whose probability is `probability`.
+  void collapseQubit(const std::size_t index, bool result,
+                     double probability) override {
+    const std::size_t mask = 1ULL << index;
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      const std::size_t dim = state.size();
+      auto *data = state.data();
+      const double scale = 1.0 / std::sqrt(probability);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for (std::size_t i = 0; i < dim; ++i)
+        data[i] =
+            (static_cast<bool>(i & mask) == result) ? data[i] * scale : 0.0;
+    } else {
+      const std::size_t dim = state.rows();
+      const double scale = 1.0 / probability;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for (std::size_t j = 0; j < dim; ++j)
+        for (std::size_t i = 0; i < dim; ++i)
+          state(i, j) = (static_cast<bool>(i & mask) == result &&
+                         static_cast<bool>(j & mask) == result)
+                            ? state(i, j) * scale
+                            : 0.0;
+    }
+  }
+
   /// @brief Convert internal qubit index to Q++ qubit index.
   ///
   /// In Q++, qubits are indexed from left to right, and thus q0 is the leftmost
@@ -144,6 +254,127 @@ protected:
     return std::log2(stateDimension) - qubitIndex - 1;
   }
 
+  /// @brief Return the probability of each outcome of the measurement of the
+  /// given (CUDA-Q) qubits, where bit `b` of an outcome is the result of
+  /// `qubits[b]`. Like `parallelSum`, the result does not depend on the number
+  /// of threads.
+  std::vector<double>
+  getMarginalProbabilities(const std::vector<std::size_t> &qubits) {
+    const std::size_t numOutcomes = 1ULL << qubits.size();
+    const std::size_t dim = stateDimension;
+    const auto probability = [&](std::size_t i) {
+      if constexpr (std::is_same_v<StateType, qpp::ket>)
+        return std::norm(state.data()[i]);
+      else
+        return state(i, i).real();
+    };
+    std::size_t measuredMask = 0;
+    for (auto q : qubits)
+      measuredMask |= 1ULL << q;
+    const std::size_t unmeasuredMask = (dim - 1) & ~measuredMask;
+    std::vector<double> marginal(numOutcomes, 0.0);
+
+    constexpr std::size_t minOutcomesPerThread = 64;
+    if (numOutcomes >= minOutcomesPerThread) {
+      // Enough outcomes to sum each one on its own thread, over the subsets of
+      // the unmeasured bits.
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+      for (std::size_t outcome = 0; outcome < numOutcomes; ++outcome) {
+        std::size_t base = 0;
+        for (std::size_t b = 0; b < qubits.size(); ++b)
+          base |= ((outcome >> b) & 1) << qubits[b];
+        // A qubit measured twice has the same result both times.
+        bool consistent = true;
+        for (std::size_t b = 0; b < qubits.size(); ++b)
+          consistent &= ((base >> qubits[b]) & 1) == ((outcome >> b) & 1);
+        if (!consistent)
+          continue;
+        double acc = 0.0;
+        std::size_t rest = 0;
+        do {
+          acc += probability(base | rest);
+          rest = (rest - unmeasuredMask) & unmeasuredMask;
+        } while (rest != 0);
+        marginal[outcome] = acc;
+      }
+      return marginal;
+    }
+
+    // Few outcomes: accumulate them over fixed-size blocks of the state.
+    constexpr std::size_t blockSize = 1ULL << 12;
+    const std::size_t numBlocks = (dim + blockSize - 1) / blockSize;
+    std::vector<double> partials(numBlocks * numOutcomes, 0.0);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if (numBlocks > 1)
+#endif
+    for (std::size_t blk = 0; blk < numBlocks; ++blk) {
+      auto *partial = partials.data() + blk * numOutcomes;
+      const std::size_t end = std::min(dim, (blk + 1) * blockSize);
+      for (std::size_t i = blk * blockSize; i < end; ++i) {
+        std::size_t outcome = 0;
+        for (std::size_t b = 0; b < qubits.size(); ++b)
+          outcome |= ((i >> qubits[b]) & 1) << b;
+        partial[outcome] += probability(i);
+      }
+    }
+    for (std::size_t blk = 0; blk < numBlocks; ++blk)
+      for (std::size_t outcome = 0; outcome < numOutcomes; ++outcome)
+        marginal[outcome] += partials[blk * numOutcomes + outcome];
+    return marginal;
+  }
+
+  /// @brief Return the expectation value of each Pauli string
+  /// i^numYs[t] X(xMasks[t]) Z(zMasks[t]), i.e., the sum over `i` of
+  /// rho(i, i ^ x) (-1)^popcount(i & z) times the phase i^numYs[t]. The terms
+  /// are accumulated together over fixed-size blocks of the state, so that
+  /// the state is read once for all the terms of a block, and like
+  /// `parallelSum` the result does not depend on the number of threads.
+  std::vector<double>
+  getPauliExpectations(const std::vector<std::size_t> &xMasks,
+                       const std::vector<std::size_t> &zMasks,
+                       const std::vector<std::size_t> &numYs) {
+    const std::size_t numTerms = xMasks.size();
+    const std::size_t dim = stateDimension;
+    const auto element = [&](std::size_t i, std::size_t x) {
+      if constexpr (std::is_same_v<StateType, qpp::ket>)
+        return state.data()[i] * std::conj(state.data()[i ^ x]);
+      else
+        return state(i, i ^ x);
+    };
+    constexpr std::size_t blockSize = 1ULL << 12;
+    const std::size_t numBlocks = (dim + blockSize - 1) / blockSize;
+    std::vector<double> partials(numBlocks * numTerms, 0.0);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if (numBlocks > 1)
+#endif
+    for (std::size_t blk = 0; blk < numBlocks; ++blk) {
+      const std::size_t begin = blk * blockSize;
+      const std::size_t end = std::min(dim, begin + blockSize);
+      for (std::size_t t = 0; t < numTerms; ++t) {
+        // The expectation value is real, so only the component of the sum
+        // which the phase rotates onto the real axis is needed.
+        const std::size_t x = xMasks[t], z = zMasks[t];
+        const bool imaginary = numYs[t] % 2;
+        double acc = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto value = element(i, x);
+          const double part = imaginary ? value.imag() : value.real();
+          acc += std::popcount(i & z) % 2 ? -part : part;
+        }
+        // i^1 and i^2 negate the real part taken, i^3 and i^0 do not.
+        partials[blk * numTerms + t] =
+            (numYs[t] == 1 || numYs[t] == 2) ? -acc : acc;
+      }
+    }
+    std::vector<double> expectationValues(numTerms, 0.0);
+    for (std::size_t blk = 0; blk < numBlocks; ++blk)
+      for (std::size_t t = 0; t < numTerms; ++t)
+        expectationValues[t] += partials[blk * numTerms + t];
+    return expectationValues;
+  }
+
   /// @brief Compute the expectation value <Z...Z> over the given qubit indices.
   double calculateExpectationValue(const std::vector<std::size_t> &qubits) {
     std::size_t bitmask = 0;
@@ -153,26 +384,16 @@ protected:
       return std::popcount(x & bitmask) % 2 == 0;
     };
 
-    std::vector<double> result;
     if constexpr (std::is_same_v<StateType, qpp::ket>) {
-      result.resize(stateDimension);
-#if defined(_OPENMP)
-#pragma omp parallel for
-#endif
-      for (std::size_t i = 0; i < stateDimension; ++i)
-        result[i] = (hasEvenParity(i) ? 1.0 : -1.0) * std::norm(state[i]);
-    } else if constexpr (std::is_same_v<StateType, qpp::cmat>) {
+      return parallelSum(stateDimension, [&](std::size_t i) {
+        return (hasEvenParity(i) ? 1.0 : -1.0) * std::norm(state[i]);
+      });
+    } else {
       Eigen::VectorXcd diag = state.diagonal();
-      result.resize(state.rows());
-#if defined(_OPENMP)
-#pragma omp parallel for
-#endif
-      for (Eigen::Index i = 0; i < state.rows(); ++i)
-        result[i] = hasEvenParity(i) ? diag(i).real() : -diag(i).real();
+      return parallelSum(state.rows(), [&](std::size_t i) {
+        return hasEvenParity(i) ? diag(i).real() : -diag(i).real();
+      });
     }
-
-    // Accumulate outside the for loop to ensure repeatability
-    return std::accumulate(result.begin(), result.end(), 0.0);
   }
 
   qpp::cmat toQppMatrix(const std::vector<std::complex<double>> &data,
@@ -202,10 +423,9 @@ protected:
 
     if (state.size() == 0) {
       // If this is the first time, allocate the state
-      if (stateData == nullptr) {
-        state = qpp::ket::Zero(stateDimension);
-        state(0) = 1.0;
-      } else
+      if (stateData == nullptr)
+        state = zeroState(stateDimension);
+      else
         state = qpp::ket::Map(stateData, stateDimension);
       return;
     }
@@ -235,6 +455,17 @@ protected:
       state = qpp::kron(casted->state, state);
   }
 
+  /// @brief Drop the highest qubits, in |0>, from the state. The state index
+  /// bits of these qubits are its most significant bits, so the state is
+  /// truncated to its leading block.
+  void removeQubitsFromState(std::size_t count) override {
+    const auto dim = static_cast<Eigen::Index>(state.rows() >> count);
+    if constexpr (std::is_same_v<StateType, qpp::ket>)
+      state.conservativeResize(dim);
+    else
+      state.conservativeResize(dim, dim);
+  }
+
   /// @brief Reset the qubit state.
   void deallocateStateImpl() override {
     StateType tmp;
@@ -260,33 +491,26 @@ protected:
     state = qpp::applyCTRL(state, matrix, controls, targets);
   }
 
-  /// @brief Set the current state back to the |0> state.
-  void setToZeroState() override {
-    state = qpp::ket::Zero(stateDimension);
-    state(0) = 1.0;
+  /// @brief Apply the phase function of a run of diagonal gates in place. Bit
+  /// `q` of an amplitude index is the value of qubit `q`, so the masks apply
+  /// as they are.
+  void applyDiagonalPhases(const std::vector<std::uint64_t> &masks,
+                           const std::vector<double> &angles) override {
+    nvqir::simd::applyWalshPhases(state.data(), state.size(), masks, angles);
   }
 
+  /// @brief Set the current state back to the |0> state.
+  void setToZeroState() override { state = zeroState(stateDimension); }
+
   /// @brief Measure the qubit and return the result. Collapse the
   /// state vector.
   bool measureQubit(const std::size_t index) override {
-    const auto qubitIdx = convertQubitIndex(index);
-    // If here, then we care about the result bit, so compute it.
-    const auto measurement_tuple =
-        qpp::measure(state, qpp::cmat::Identity(2, 2), {qubitIdx},
-                     /*qudit dimension=*/2, /*destructive measmt=*/false);
-    const auto measurement_result = std::get<qpp::RES>(measurement_tuple);
-    const auto &post_meas_states = std::get<qpp::ST>(measurement_tuple);
-    const auto &collapsed_state = post_meas_states[measurement_result];
-    if constexpr (std::is_same_v<StateType, qpp::ket>) {
-      state = Eigen::Map<const StateType>(collapsed_state.data(),
-                                          collapsed_state.size());
-    } else {
-      state = Eigen::Map<const StateType>(collapsed_state.data(),
-                                          collapsed_state.rows(),
-                                          collapsed_state.cols());
-    }
-    CUDAQ_INFO("Measured qubit {} -> {}", qubitIdx, measurement_result);
-    return measurement_result == 1 ? true : false;
+    const double probOne = getProbabilityOfOne(index);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    const bool result = dist(randomEngine) < probOne;
+    collapseQubit(index, result, result ? probOne : 1.0 - probOne);
+    CUDAQ_INFO("Measured qubit {} -> {}", index, result);
+    return result;
   }
 
   QubitOrdering getQubitOrdering() const override { return QubitOrdering::msb; }
@@ -296,11 +520,32 @@ public:
     // Populate the correct name so it is printed correctly during
     // deconstructor.
     summaryData.name = name();
+    // Fused gates are applied as dense matrices via qpp::apply.
+    supportsGateFusion = std::is_same_v<StateType, qpp::ket>;
+    supportsDiagonalGateRuns = std::is_same_v<StateType, qpp::ket>;
+    supportsMeasurementBranching = true;
+    supportsStateCompaction = true;
+    supportsLightconeObserve = std::is_same_v<StateType, qpp::ket>;
+    supportsCheckpoints = std::is_same_v<StateType, qpp::ket>;
+    if (auto *numThreadsEnvVal = std::getenv(numThreadsEnvVar)) {
+      const int numThreads = std::atoi(numThreadsEnvVal);
+      if (numThreads < 1)
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting a positive "
+            "integer, got '{}'.",
+            numThreadsEnvVar, numThreadsEnvVal));
+#if defined(_OPENMP)
+      // Simulator instances are thread-local, and this only sets the number
+      // of threads for parallel regions started from the current thread.
+      omp_set_num_threads(numThreads);
+#endif
+    }
   }
   virtual ~QppCircuitSimulator() = default;
 
   void setRandomSeed(std::size_t seed) override {
     qpp::RandomDevices::get_instance().get_prng().seed(seed);
+    randomEngine.seed(seed);
   }
 
   bool canHandleObserve() override {
@@ -310,32 +555,60 @@ public:
       return false;
     }
 
-    return !shouldObserveFromSampling();
+    // If no shots are requested, compute the expectation values of all the
+    // terms at once from the state by default, rather than term by term.
+    return !shouldObserveFromSampling(/*defaultConfig=*/false);
   }
 
+  /// @brief Compute the exact expectation value of each term of `op` from the
+  /// state, without copying it, and their weighted sum.
   cudaq::observe_result observe(const cudaq::spin_op &op) override {
     assert(cudaq::spin_op::canonicalize(op) == op);
     flushGateQueue();
 
-    // The op is on the following target bits.
-    auto targets = op.degrees();
-
-    // Get the matrix as an Eigen matrix
-    auto matrix = op.to_matrix();
-    qpp::cmat asEigen = matrix.as_eigen();
-
-    // Compute the expected value
-    double ee = 0.0;
-    if constexpr (std::is_same_v<StateType, qpp::ket>) {
-      qpp::ket k = qpp::apply(state, asEigen, targets, 2);
-      ee = state.dot(k).real();
-    } else {
-      ee = qpp::apply(asEigen, state, targets).trace().real();
+    // Term `t` is the Pauli string i^numYs[t] X(xMasks[t]) Z(zMasks[t]), where
+    // X(m) and Z(m) act on the qubits whose bits are set in `m`.
+    const std::size_t numQubits = std::log2(stateDimension);
+    std::vector<std::size_t> xMasks, zMasks, numYs;
+    std::vector<std::complex<double>> coeffs;
+    std::vector<std::string> termStrs;
+    for (const auto &term : op) {
+      std::size_t xMask = 0, zMask = 0, numY = 0;
+      for (const auto &p : term) {
+        const auto pauli = p.as_pauli();
+        if (pauli == cudaq::pauli::I)
+          continue;
+        if (p.target() >= numQubits)
+          throw std::runtime_error(cudaq_fmt::format(
+              "[qpp] observe: the operator acts on qubit {} of a state of {} "
+              "qubits.",
+              p.target(), numQubits));
+        const std::size_t bit = 1ULL << p.target();
+        if (pauli != cudaq::pauli::Z)
+          xMask |= bit;
+        if (pauli != cudaq::pauli::X)
+          zMask |= bit;
+        if (pauli == cudaq::pauli::Y)
+          ++numY;
+      }
+      xMasks.push_back(xMask);
+      zMasks.push_back(zMask);
+      numYs.push_back(numY % 4);
+      coeffs.push_back(term.evaluate_coefficient());
+      termStrs.push_back(term.get_term_id());
     }
 
-    return cudaq::observe_result(
-        ee, op,
-        cudaq::sample_result(cudaq::ExecutionResult({}, op.to_string(), ee)));
+    const auto expectationValues = getPauliExpectations(xMasks, zMasks, numYs);
+    std::complex<double> expVal = 0.0;
+    std::vector<cudaq::ExecutionResult> results;
+    results.reserve(expectationValues.size());
+    for (std::size_t t = 0; t < expectationValues.size(); ++t) {
+      expVal += coeffs[t] * expectationValues[t];
+      results.emplace_back(
+          cudaq::ExecutionResult({}, termStrs[t], expectationValues[t]));
+    }
+    cudaq::sample_result perTermData(expVal.real(), results);
+    return cudaq::observe_result(expVal.real(), op, perTermData);
   }
 
   /// @brief Reset the qubit
@@ -343,6 +616,21 @@ public:
   void resetQubit(const std::size_t index) override {
     flushGateQueue();
     flushAnySamplingTasks();
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      // Measure, and flip the qubit back to |0> if needed.
+      if (measureOrFollowBranch(index)) {
+        const std::size_t mask = 1ULL << index;
+        const std::size_t dim = state.size();
+        auto *data = state.data();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+        for (std::size_t i = 0; i < dim; ++i)
+          if (i & mask)
+            std::swap(data[i], data[i ^ mask]);
+      }
+      return;
+    }
     const auto qubitIdx = convertQubitIndex(index);
     state = qpp::reset(state, {qubitIdx});
   }
@@ -356,37 +644,25 @@ public:
       return cudaq::ExecutionResult{{}, expectationValue};
     }
 
-    std::vector<std::size_t> measuredBits;
-    for (auto index : qubits) {
-      measuredBits.push_back(convertQubitIndex(index));
-    }
-
-    auto sampleResult = qpp::sample(shots, state, measuredBits, 2);
-    // Convert to what we expect
-    std::stringstream bitstream;
+    // Draw all the shots at once from the marginal distribution of the
+    // measured qubits. Bit `b` of each packed shot is the result of
+    // `qubits[b]`.
+    const AliasTable outcomes(getMarginalProbabilities(qubits));
+    cudaq::PackedShots packedShots(qubits.size());
+    packedShots.words = outcomes.sample(shots, randomEngine);
     cudaq::ExecutionResult counts;
+    if (qubits.empty())
+      counts.appendResult("", shots);
+    else
+      counts.appendPackedResults(std::move(packedShots));
 
     // Expectation value from the counts
     double expVal = 0.0;
-    for (auto [result, count] : sampleResult) {
-      // Push back each term in the vector of bits to the bitstring.
-      for (const auto &bit : result) {
-        bitstream << bit;
-      }
-
-      // Add to the sample result
-      // in mid-circ sampling mode this will append 1 bitstring
-      auto bitstring = bitstream.str();
-      counts.appendResult(bitstring, count);
-      auto par = cudaq::sample_result::has_even_parity(bitstring);
+    for (const auto &[bitstring, count] : counts.counts) {
       auto p = count / (double)shots;
-      if (!par) {
+      if (!cudaq::sample_result::has_even_parity(bitstring))
         p = -p;
-      }
       expVal += p;
-      // Reset the state.
-      bitstream.str("");
-      bitstream.clear();
     }
 
     counts.expectationValue = expVal;
@@ -402,6 +678,22 @@ public:
     return std::is_same_v<StateType, qpp::ket>;
   }
 
+  void getStateChunk(std::size_t offset, std::size_t count,
+                     std::complex<double> *dst) override {
+    if constexpr (!std::is_same_v<StateType, qpp::ket>)
+      return CircuitSimulatorBase::getStateChunk(offset, count, dst);
+    else
+      std::copy_n(state.data() + offset, count, dst);
+  }
+
+  void setStateChunk(std::size_t offset, std::size_t count,
+                     const std::complex<double> *src) override {
+    if constexpr (!std::is_same_v<StateType, qpp::ket>)
+      return CircuitSimulatorBase::setStateChunk(offset, count, src);
+    else
+      std::copy_n(src, count, state.data() + offset);
+  }
+
   std::string name() const override { return "qpp"; }
   NVQIR_SIMULATOR_CLONE_IMPL(QppCircuitSimulator<StateType>)
 };
@@ -10,6 +10,10 @@
 
 #include "QppCircuitSimulator.cpp"
 
+#include <array>
+#include <optional>
+#include <string_view>
+
 using namespace cudaq;
 
 namespace {
@@ -144,6 +148,17 @@ struct QppDmState : public cudaq::SimulationState {
     return std::make_unique<QppDmState>(std::move(dm));
   }
 
+  std::unique_ptr<SimulationState>
+  createFromSparseData(const sparse_state_data &data) override {
+    // rho = |psi><psi| only has nonzero entries between nonzero amplitudes.
+    const std::size_t dim = validateSparseData(data);
+    qpp::cmat dm = qpp::cmat::Zero(dim, dim);
+    for (const auto &[row, rowAmplitude] : data.amplitudes)
+      for (const auto &[col, colAmplitude] : data.amplitudes)
+        dm(row, col) += rowAmplitude * std::conj(colAmplitude);
+    return std::make_unique<QppDmState>(std::move(dm));
+  }
+
   void dump(std::ostream &os) const override { os << state << std::endl; }
 
   precision getPrecision() const override {
@@ -156,6 +171,179 @@ struct QppDmState : public cudaq::SimulationState {
   }
 };
 
+/// @brief A channel of the form rho -> sum_P w_P P rho P^dagger, where the sum
+/// runs over the Pauli strings P on `numQubits` qubits. The weight of the
+/// Pauli string with X component `x` and Z component `z` is stored at index
+/// `(x << numQubits) | z`, where bit `j` of `x` (`z`) is set if the string acts
+/// with X or Y (Z or Y) on the j-th qubit the channel is applied to.
+struct PauliChannel {
+  std::size_t numQubits = 0;
+  std::vector<double> weights;
+
+  PauliChannel(std::size_t numQubits)
+      : numQubits(numQubits), weights(1ULL << (2 * numQubits), 0.) {}
+
+  void setWeight(std::string_view paulis, double weight) {
+    std::size_t x = 0, z = 0;
+    for (std::size_t j = 0; j < paulis.size(); ++j) {
+      if (paulis[j] == 'X' || paulis[j] == 'Y')
+        x |= 1ULL << j;
+      if (paulis[j] == 'Z' || paulis[j] == 'Y')
+        z |= 1ULL << j;
+    }
+    weights[(x << numQubits) | z] = weight;
+  }
+};
+
+/// @brief Return the Pauli channel equivalent to the given Kraus channel if its
+/// noise type identifies it as a mixture of Pauli conjugations.
+std::optional<PauliChannel>
+getPauliChannel(const cudaq::kraus_channel &channel) {
+  auto hasShape = [&](std::size_t numParams, std::size_t numOps,
+                      std::size_t dim) {
+    return channel.parameters.size() == numParams &&
+           channel.size() == numOps && channel.dimension() == dim;
+  };
+  const auto &p = channel.parameters;
+  switch (channel.noise_type) {
+  case cudaq::noise_model_type::bit_flip_channel:
+  case cudaq::noise_model_type::x_error:
+  case cudaq::noise_model_type::phase_flip_channel:
+  case cudaq::noise_model_type::z_error:
+  case cudaq::noise_model_type::y_error: {
+    if (!hasShape(1, 2, 2))
+      return std::nullopt;
+    auto type = channel.noise_type;
+    std::string_view error = "Z";
+    if (type == cudaq::noise_model_type::bit_flip_channel ||
+        type == cudaq::noise_model_type::x_error)
+      error = "X";
+    else if (type == cudaq::noise_model_type::y_error)
+      error = "Y";
+    PauliChannel pauli(1);
+    pauli.setWeight("I", 1. - p[0]);
+    pauli.setWeight(error, p[0]);
+    return pauli;
+  }
+  case cudaq::noise_model_type::depolarization_channel:
+  case cudaq::noise_model_type::depolarization1:
+  case cudaq::noise_model_type::pauli1: {
+    bool isPauli1 = channel.noise_type == cudaq::noise_model_type::pauli1;
+    if (!hasShape(isPauli1 ? 3 : 1, 4, 2))
+      return std::nullopt;
+    PauliChannel pauli(1);
+    std::vector<double> probs =
+        isPauli1 ? p : std::vector<double>(3, p[0] / 3.);
+    pauli.setWeight(
+        "I", isPauli1 ? std::max(1. - probs[0] - probs[1] - probs[2], 0.)
+                      : 1. - p[0]);
+    pauli.setWeight("X", probs[0]);
+    pauli.setWeight("Y", probs[1]);
+    pauli.setWeight("Z", probs[2]);
+    return pauli;
+  }
+  case cudaq::noise_model_type::depolarization2:
+  case cudaq::noise_model_type::pauli2: {
+    bool isPauli2 = channel.noise_type == cudaq::noise_model_type::pauli2;
+    if (!hasShape(isPauli2 ? 15 : 1, 16, 4))
+      return std::nullopt;
+    // Same order as the Kraus operators of the pauli2 channel; the first
+    // letter acts on the first qubit.
+    static constexpr const char *paulis[] = {"IX", "IY", "IZ", "XI", "XX",
+                                             "XY", "XZ", "YI", "YX", "YY",
+                                             "YZ", "ZI", "ZX", "ZY", "ZZ"};
+    PauliChannel pauli(2);
+    double sum = 0.;
+    for (std::size_t i = 0; i < 15; ++i) {
+      double prob = isPauli2 ? p[i] : p[0] / 15.;
+      pauli.setWeight(paulis[i], prob);
+      sum += prob;
+    }
+    pauli.setWeight("II", isPauli2 ? std::max(1. - sum, 0.) : 1. - p[0]);
+    return pauli;
+  }
+  default:
+    return std::nullopt;
+  }
+}
+
+/// @brief Apply the Pauli channel in place to the density matrix `state`,
+/// where the j-th qubit of the channel is the (qpp-ordered) qubit at index
+/// `qubits[j]`.
+///
+/// Conjugating with a Pauli string with X component `x` and Z component `z`
+/// maps the entry (r, c) of the density matrix to the entry (r ^ x, c ^ x) and
+/// multiplies it by (-1)^popcount((r ^ c) & z). Hence, each entry of the
+/// result is a combination of the 2^numQubits entries within the same block of
+/// rows and columns that only differ in the bits of the channel qubits. The
+/// coefficients only depend on x and on r ^ c restricted to these bits, and
+/// are precomputed to avoid any per-entry loop over Pauli strings.
+void applyPauliChannel(qpp::cmat &state, const PauliChannel &channel,
+                       const std::vector<std::size_t> &qubits) {
+  const std::size_t numQubits = channel.numQubits;
+  const std::size_t blockDim = 1ULL << numQubits;
+  const std::size_t dim = state.rows();
+  const std::size_t numQppQubits = std::log2(dim);
+
+  // Bit in the row/column index for each channel qubit.
+  std::vector<std::size_t> bits;
+  for (auto q : qubits)
+    bits.push_back(numQppQubits - q - 1);
+  std::vector<std::size_t> sortedBits(bits);
+  std::sort(sortedBits.begin(), sortedBits.end());
+  std::vector<std::size_t> offsets(blockDim, 0);
+  for (std::size_t l = 0; l < blockDim; ++l)
+    for (std::size_t j = 0; j < numQubits; ++j)
+      if (l & (1ULL << j))
+        offsets[l] |= 1ULL << bits[j];
+
+  // coefficients[x * blockDim + s] = sum_z w(x, z) (-1)^popcount(s & z)
+  std::vector<double> coefficients(blockDim * blockDim, 0.);
+  for (std::size_t x = 0; x < blockDim; ++x)
+    for (std::size_t s = 0; s < blockDim; ++s)
+      for (std::size_t z = 0; z < blockDim; ++z) {
+        double weight = channel.weights[(x << numQubits) | z];
+        coefficients[x * blockDim + s] +=
+            std::popcount(s & z) % 2 ? -weight : weight;
+      }
+
+  auto blockStart = [&sortedBits](std::size_t k) {
+    for (auto b : sortedBits) {
+      const std::size_t lowMask = (1ULL << b) - 1;
+      k = (k & lowMask) | ((k & ~lowMask) << 1);
+    }
+    return k;
+  };
+
+  auto *data = state.data();
+  const std::size_t numBlocks = dim >> numQubits;
+  const bool parallel = numBlocks * numBlocks >= (1ULL << 12);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if (parallel)
+#endif
+  for (std::size_t cb = 0; cb < numBlocks; ++cb) {
+    const std::size_t col = blockStart(cb);
+    // Channels act on at most two qubits, i.e., blocks of at most 4 x 4.
+    std::array<std::complex<double>, 16> block;
+    for (std::size_t rb = 0; rb < numBlocks; ++rb) {
+      const std::size_t row = blockStart(rb);
+      // qpp::cmat is column-major
+      for (std::size_t r = 0; r < blockDim; ++r)
+        for (std::size_t c = 0; c < blockDim; ++c)
+          block[r * blockDim + c] =
+              data[row + offsets[r] + (col + offsets[c]) * dim];
+      for (std::size_t r = 0; r < blockDim; ++r)
+        for (std::size_t c = 0; c < blockDim; ++c) {
+          std::complex<double> value = 0.;
+          for (std::size_t x = 0; x < blockDim; ++x)
+            value += coefficients[x * blockDim + (r ^ c)] *
+                     block[(r ^ x) * blockDim + (c ^ x)];
+          data[row + offsets[r] + (col + offsets[c]) * dim] = value;
+        }
+    }
+  }
+}
+
 /// @brief The QppNoiseCircuitSimulator further specializes the
 /// QppCircuitSimulator to use a density matrix representation of the state.
 /// This class directly enables a simple noise modeling capability for CUDA-Q.
@@ -178,43 +366,56 @@ protected:
     if (!executionContext->noiseModel)
       return;
 
-    // Get the name as a string
-    std::string gName(gateName);
-    std::vector<std::size_t> qubits{controls.begin(), controls.end()};
-    qubits.insert(qubits.end(), targets.begin(), targets.end());
     std::vector<std::size_t> casted_qubits;
-    for (auto index : qubits) {
+    for (auto index : controls)
+      casted_qubits.push_back(convertQubitIndex(index));
+    for (auto index : targets)
       casted_qubits.push_back(convertQubitIndex(index));
-    }
 
-    // Get the Kraus channels specified for this gate and qubits
-    auto krausChannels = executionContext->noiseModel->get_channels(
-        gName, targets, controls, params);
+    // Apply the Kraus channels specified for this gate and qubits
+    executionContext->noiseModel->for_each_channel(
+        gateName, targets, controls, params,
+        [&](const cudaq::kraus_channel &channel) {
+          CUDAQ_INFO("Applying kraus channel {} to qubits {}, {}",
+                     channel.get_type_name(), controls, targets);
+          applyKrausChannel(channel, casted_qubits);
+        });
+    executionContext->noiseModel->for_each_crosstalk_channel(
+        gateName, targets, controls,
+        [&](const cudaq::noise_model::crosstalk_channel &crosstalk,
+            const std::vector<std::size_t> &spectators) {
+          CUDAQ_INFO("Applying crosstalk kraus channel {} to qubits {}",
+                     crosstalk.channel.get_type_name(), spectators);
+          for (auto qubit : spectators)
+            applyKrausChannel(crosstalk.channel, {convertQubitIndex(qubit)});
+        });
+  }
 
-    // If none, do nothing
-    if (krausChannels.empty())
+  /// @brief Apply K rho Kdag for the Kraus operators K of the given channel,
+  /// where the qubits are given in qpp ordering.
+  void applyKrausChannel(const cudaq::kraus_channel &channel,
+                         const std::vector<std::size_t> &casted_qubits) {
+    // Pauli channels are applied directly as a mix of Pauli conjugations
+    if (auto pauli = getPauliChannel(channel);
+        pauli && pauli->numQubits == casted_qubits.size()) {
+      applyPauliChannel(state, *pauli, casted_qubits);
       return;
-
-    CUDAQ_INFO("Applying {} kraus channels to qubits {}", krausChannels.size(),
-               qubits);
-
-    for (auto &channel : krausChannels) {
-      // Map our kraus ops to the qpp::cmat
-      std::vector<qpp::cmat> K;
-      auto ops = channel.get_ops();
-      std::transform(ops.begin(), ops.end(), std::back_inserter(K),
-                     [&](auto &el) {
-                       // Note: Kraus channel flattened matrix data is
-                       // **row-major**.
-                       return Eigen::Map<
-                           Eigen::Matrix<std::complex<double>, Eigen::Dynamic,
-                                         Eigen::Dynamic, Eigen::RowMajor>>(
-                           el.data.data(), el.nRows, el.nCols);
-                     });
-
-      // Apply K rho Kdag
-      state = qpp::apply(state, K, casted_qubits);
     }
+
+    // Map our kraus ops to the qpp::cmat
+    std::vector<qpp::cmat> K;
+    auto ops = channel.get_ops();
+    std::transform(
+        ops.begin(), ops.end(), std::back_inserter(K), [&](auto &el) {
+          // Note: Kraus channel flattened matrix data is
+          // **row-major**.
+          return Eigen::Map<Eigen::Matrix<std::complex<double>, Eigen::Dynamic,
+                                          Eigen::Dynamic, Eigen::RowMajor>>(
+              el.data.data(), el.nRows, el.nCols);
+        });
+
+    // Apply K rho Kdag
+    state = qpp::apply(state, K, casted_qubits);
   }
 
   /// @brief This simulator supports all noise channels
@@ -231,20 +432,7 @@ protected:
     for (auto index : qubits) {
       casted_qubits.push_back(convertQubitIndex(index));
     }
-    // Map our kraus ops to the qpp::cmat
-    std::vector<qpp::cmat> K;
-    auto ops = channel.get_ops();
-    std::transform(
-        ops.begin(), ops.end(), std::back_inserter(K), [&](auto &el) {
-          // Note: Kraus channel flattened matrix data is
-          // **row-major**.
-          return Eigen::Map<Eigen::Matrix<std::complex<double>, Eigen::Dynamic,
-                                          Eigen::Dynamic, Eigen::RowMajor>>(
-              el.data.data(), el.nRows, el.nCols);
-        });
-
-    // Apply K rho Kdag
-    state = qpp::apply(state, K, casted_qubits);
+    applyKrausChannel(channel, casted_qubits);
   }
 
   /// @brief Grow the density matrix by one qubit.
@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#define __NVQIR_QPP_TOGGLE_CREATE
+
+#include "QppCircuitSimulator.cpp"
+#include "StateVectorKernels.h"
+
+namespace {
+
+/// @brief The SimdCircuitSimulator is a CPU state-vector simulator that reuses
+/// the QppCircuitSimulator state handling (allocation, measurement, sampling,
+/// observe) but applies gates in place with kernels specialized for the gate
+/// structure (diagonal, permutation, single-qubit dense), using AVX2 when the
+/// host CPU supports it.
+class SimdCircuitSimulator : public nvqir::QppCircuitSimulator<qpp::ket> {
+protected:
+  void applyGate(const GateApplicationTask &task) override {
+    // The kernels index qubits the same way CUDA-Q does (qubit `q` is bit
+    // `q` of the amplitude index), so no index conversion is needed.
+    nvqir::simd::applyGate(state.data(), state.size(), task.matrix,
+                           task.controls, task.targets);
+  }
+
+  void applyDiagonalPhases(const std::vector<std::uint64_t> &masks,
+                           const std::vector<double> &angles) override {
+    nvqir::simd::applyWalshPhases(state.data(), state.size(), masks, angles);
+  }
+
+public:
+  SimdCircuitSimulator() { summaryData.name = name(); }
+  virtual ~SimdCircuitSimulator() = default;
+
+  std::string name() const override { return "simd"; }
+  NVQIR_SIMULATOR_CLONE_IMPL(SimdCircuitSimulator)
+};
+
+} // namespace
+
+/// Register this Simulator with NVQIR.
+NVQIR_REGISTER_SIMULATOR(SimdCircuitSimulator, simd)
+#undef __NVQIR_QPP_TOGGLE_CREATE
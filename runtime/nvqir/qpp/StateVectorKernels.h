@@ -0,0 +1,370 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NVQIR_SIMD_HAS_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+/// The kernels in this file update a state vector in place, where bit `q` of
+/// an amplitude index is the value of qubit `q`. Gate matrices are row-major,
+/// and the first target qubit of a gate maps to the most significant bit of
+/// the matrix index (i.e., the qubit ordering of the qpp backend).
+namespace nvqir::simd {
+
+using complex = std::complex<double>;
+
+/// @brief The structure of a gate matrix, used to pick a specialized kernel.
+enum class GateKind {
+  /// Only the diagonal is non-zero, e.g., Z, S, T, R1, Rz.
+  diagonal,
+  /// Exactly one non-zero element per row and column, e.g., X, Y, SWAP.
+  permutation,
+  /// Anything else.
+  dense
+};
+
+/// @brief Classify the `dim x dim` row-major `matrix`.
+inline GateKind classifyGate(const std::vector<complex> &matrix,
+                             std::size_t dim) {
+  bool isDiagonal = true;
+  bool isPermutation = true;
+  std::vector<bool> columnUsed(dim, false);
+  for (std::size_t r = 0; r < dim; ++r) {
+    std::size_t nonZeros = 0;
+    for (std::size_t c = 0; c < dim; ++c) {
+      if (matrix[r * dim + c] == complex(0.0, 0.0))
+        continue;
+      ++nonZeros;
+      if (r != c)
+        isDiagonal = false;
+      if (columnUsed[c])
+        isPermutation = false;
+      columnUsed[c] = true;
+    }
+    if (nonZeros != 1)
+      isPermutation = isDiagonal = false;
+  }
+  if (isDiagonal)
+    return GateKind::diagonal;
+  return isPermutation ? GateKind::permutation : GateKind::dense;
+}
+
+/// @brief Insert a zero bit at each of the (ascending) `sortedBits` positions
+/// of `k`.
+inline std::size_t insertZeroBits(std::size_t k,
+                                  const std::vector<std::size_t> &sortedBits) {
+  for (auto b : sortedBits) {
+    const std::size_t lowMask = (1ULL << b) - 1;
+    k = (k & lowMask) | ((k & ~lowMask) << 1);
+  }
+  return k;
+}
+
+/// @brief Precomputed indexing data for a (controlled) gate: the base index of
+/// every amplitude group is obtained by inserting zeros at the gate qubits and
+/// setting the control bits, and the members of a group are found by adding
+/// `offsets` to the base index.
+struct GateIndexing {
+  std::vector<std::size_t> sortedBits;
+  std::vector<std::size_t> offsets;
+  std::size_t controlMask = 0;
+  std::size_t numGroups = 0;
+
+  GateIndexing(std::size_t dim, const std::vector<std::size_t> &controls,
+               const std::vector<std::size_t> &targets) {
+    const std::size_t nTargets = targets.size();
+    for (auto c : controls)
+      controlMask |= 1ULL << c;
+    sortedBits = controls;
+    sortedBits.insert(sortedBits.end(), targets.begin(), targets.end());
+    std::sort(sortedBits.begin(), sortedBits.end());
+    numGroups = dim >> sortedBits.size();
+    offsets.assign(1ULL << nTargets, 0);
+    for (std::size_t r = 0; r < offsets.size(); ++r)
+      for (std::size_t j = 0; j < nTargets; ++j)
+        if (r & (1ULL << (nTargets - 1 - j)))
+          offsets[r] |= 1ULL << targets[j];
+  }
+
+  std::size_t base(std::size_t k) const {
+    return insertZeroBits(k, sortedBits) | controlMask;
+  }
+
+  /// @brief Return true if consecutive groups have consecutive base indices
+  /// (in pairs), which is what the vectorized kernels rely on.
+  bool pairsAreContiguous() const {
+    return sortedBits.front() != 0 && numGroups % 2 == 0;
+  }
+};
+
+/// @brief Minimum number of amplitude groups for which gate application is
+/// split across OpenMP threads.
+constexpr std::size_t parallelGroupThreshold = 1ULL << 14;
+
+/// @brief Portable kernel for a (controlled) single-qubit dense gate.
+inline void applySingleQubitDenseScalar(complex *state,
+                                        const GateIndexing &idx,
+                                        const complex *m) {
+  const std::size_t stride = idx.offsets[1];
+  const std::size_t numGroups = idx.numGroups;
+#if defined(_OPENMP)
+#pragma omp parallel for if (numGroups >= parallelGroupThreshold)
+#endif
+  for (std::size_t k = 0; k < numGroups; ++k) {
+    const std::size_t i = idx.base(k);
+    const complex a0 = state[i];
+    const complex a1 = state[i + stride];
+    state[i] = m[0] * a0 + m[1] * a1;
+    state[i + stride] = m[2] * a0 + m[3] * a1;
+  }
+}
+
+#ifdef NVQIR_SIMD_HAS_AVX2_KERNELS
+/// @brief Multiply the two complex numbers packed in `a` by the complex
+/// scalar given by its broadcast real part `re` and imaginary part `im`.
+__attribute__((target("avx2,fma"))) inline __m256d
+complexMulAvx2(__m256d re, __m256d im, __m256d a) {
+  const __m256d swapped = _mm256_permute_pd(a, 0b0101);
+  return _mm256_fmaddsub_pd(re, a, _mm256_mul_pd(im, swapped));
+}
+
+/// @brief AVX2 kernel for a (controlled) single-qubit dense gate. Processes two
+/// amplitude groups per iteration; requires `idx.pairsAreContiguous()`.
+__attribute__((target("avx2,fma"))) inline void
+applySingleQubitDenseAvx2(complex *state, const GateIndexing &idx,
+                          const complex *m) {
+  const std::size_t stride = idx.offsets[1];
+  const std::size_t numPairs = idx.numGroups / 2;
+  double *data = reinterpret_cast<double *>(state);
+  const __m256d m00r = _mm256_set1_pd(m[0].real());
+  const __m256d m00i = _mm256_set1_pd(m[0].imag());
+  const __m256d m01r = _mm256_set1_pd(m[1].real());
+  const __m256d m01i = _mm256_set1_pd(m[1].imag());
+  const __m256d m10r = _mm256_set1_pd(m[2].real());
+  const __m256d m10i = _mm256_set1_pd(m[2].imag());
+  const __m256d m11r = _mm256_set1_pd(m[3].real());
+  const __m256d m11i = _mm256_set1_pd(m[3].imag());
+#if defined(_OPENMP)
+#pragma omp parallel for if (numPairs >= parallelGroupThreshold)
+#endif
+  for (std::size_t p = 0; p < numPairs; ++p) {
+    const std::size_t i = idx.base(2 * p);
+    double *lo = data + 2 * i;
+    double *hi = data + 2 * (i + stride);
+    const __m256d a0 = _mm256_loadu_pd(lo);
+    const __m256d a1 = _mm256_loadu_pd(hi);
+    const __m256d out0 = _mm256_add_pd(complexMulAvx2(m00r, m00i, a0),
+                                       complexMulAvx2(m01r, m01i, a1));
+    const __m256d out1 = _mm256_add_pd(complexMulAvx2(m10r, m10i, a0),
+                                       complexMulAvx2(m11r, m11i, a1));
+    _mm256_storeu_pd(lo, out0);
+    _mm256_storeu_pd(hi, out1);
+  }
+}
+
+/// @brief AVX2 kernel for a (controlled) single-qubit diagonal gate whose
+/// first diagonal element is one, e.g., a phase gate. Only the amplitudes with
+/// the target bit set are touched. Requires `idx.pairsAreContiguous()`.
+__attribute__((target("avx2,fma"))) inline void
+applySingleQubitPhaseAvx2(complex *state, const GateIndexing &idx,
+                          complex phase) {
+  const std::size_t stride = idx.offsets[1];
+  const std::size_t numPairs = idx.numGroups / 2;
+  double *data = reinterpret_cast<double *>(state);
+  const __m256d re = _mm256_set1_pd(phase.real());
+  const __m256d im = _mm256_set1_pd(phase.imag());
+#if defined(_OPENMP)
+#pragma omp parallel for if (numPairs >= parallelGroupThreshold)
+#endif
+  for (std::size_t p = 0; p < numPairs; ++p) {
+    double *hi = data + 2 * (idx.base(2 * p) + stride);
+    _mm256_storeu_pd(hi, complexMulAvx2(re, im, _mm256_loadu_pd(hi)));
+  }
+}
+
+/// @brief Return true if the AVX2 kernels can be used on this CPU.
+inline bool hasAvx2() {
+  static const bool supported =
+      __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  return supported;
+}
+#endif
+
+/// @brief Apply a (controlled) single-qubit dense gate.
+inline void applySingleQubitDense(complex *state, const GateIndexing &idx,
+                                  const complex *m) {
+#ifdef NVQIR_SIMD_HAS_AVX2_KERNELS
+  if (hasAvx2() && idx.pairsAreContiguous())
+    return applySingleQubitDenseAvx2(state, idx, m);
+#endif
+  applySingleQubitDenseScalar(state, idx, m);
+}
+
+/// @brief Apply a (controlled) diagonal gate with the given diagonal.
+inline void applyDiagonal(complex *state, const GateIndexing &idx,
+                          const std::vector<complex> &diagonal) {
+  const std::size_t numGroups = idx.numGroups;
+  if (diagonal.size() == 2 && diagonal[0] == complex(1.0, 0.0)) {
+#ifdef NVQIR_SIMD_HAS_AVX2_KERNELS
+    if (hasAvx2() && idx.pairsAreContiguous())
+      return applySingleQubitPhaseAvx2(state, idx, diagonal[1]);
+#endif
+    const std::size_t stride = idx.offsets[1];
+    const complex phase = diagonal[1];
+#if defined(_OPENMP)
+#pragma omp parallel for if (numGroups >= parallelGroupThreshold)
+#endif
+    for (std::size_t k = 0; k < numGroups; ++k)
+      state[idx.base(k) + stride] *= phase;
+    return;
+  }
+
+  const std::size_t gateDim = diagonal.size();
+#if defined(_OPENMP)
+#pragma omp parallel for if (numGroups >= parallelGroupThreshold)
+#endif
+  for (std::size_t k = 0; k < numGroups; ++k) {
+    const std::size_t i = idx.base(k);
+    for (std::size_t r = 0; r < gateDim; ++r)
+      state[i + idx.offsets[r]] *= diagonal[r];
+  }
+}
+
+/// @brief Apply a (controlled) permutation gate, which maps the amplitude in
+/// row `source[r]` of each group to row `r`, multiplied by `phases[r]`.
+inline void applyPermutation(complex *state, const GateIndexing &idx,
+                             const std::vector<std::size_t> &source,
+                             const std::vector<complex> &phases) {
+  const std::size_t numGroups = idx.numGroups;
+  const std::size_t gateDim = source.size();
+  const bool isX = gateDim == 2 && phases[0] == complex(1.0, 0.0) &&
+                   phases[1] == complex(1.0, 0.0);
+  if (isX) {
+    // Pure bit flip: swap the two halves of every group.
+    const std::size_t stride = idx.offsets[1];
+#if defined(_OPENMP)
+#pragma omp parallel for if (numGroups >= parallelGroupThreshold)
+#endif
+    for (std::size_t k = 0; k < numGroups; ++k) {
+      const std::size_t i = idx.base(k);
+      std::swap(state[i], state[i + stride]);
+    }
+    return;
+  }
+
+#if defined(_OPENMP)
+#pragma omp parallel if (numGroups >= parallelGroupThreshold)
+#endif
+  {
+    std::vector<complex> in(gateDim);
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for (std::size_t k = 0; k < numGroups; ++k) {
+      const std::size_t i = idx.base(k);
+      for (std::size_t r = 0; r < gateDim; ++r)
+        in[r] = state[i + idx.offsets[r]];
+      for (std::size_t r = 0; r < gateDim; ++r)
+        state[i + idx.offsets[r]] = phases[r] * in[source[r]];
+    }
+  }
+}
+
+/// @brief Apply a (controlled) dense gate on any number of targets.
+inline void applyDense(complex *state, const GateIndexing &idx,
+                       const std::vector<complex> &matrix) {
+  const std::size_t gateDim = idx.offsets.size();
+  if (gateDim == 2)
+    return applySingleQubitDense(state, idx, matrix.data());
+
+  const std::size_t numGroups = idx.numGroups;
+#if defined(_OPENMP)
+#pragma omp parallel if (numGroups >= parallelGroupThreshold)
+#endif
+  {
+    std::vector<complex> in(gateDim);
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for (std::size_t k = 0; k < numGroups; ++k) {
+      const std::size_t i = idx.base(k);
+      for (std::size_t c = 0; c < gateDim; ++c)
+        in[c] = state[i + idx.offsets[c]];
+      for (std::size_t r = 0; r < gateDim; ++r) {
+        complex acc = 0.0;
+        const complex *row = matrix.data() + r * gateDim;
+        for (std::size_t c = 0; c < gateDim; ++c)
+          acc += row[c] * in[c];
+        state[i + idx.offsets[r]] = acc;
+      }
+    }
+  }
+}
+
+/// @brief Multiply the amplitude of each basis state `k` of the state vector
+/// of dimension `dim` by `exp(i sum_j angles[j] (-1)^popcount(k & masks[j]))`.
+inline void applyWalshPhases(complex *state, std::size_t dim,
+                             const std::vector<std::uint64_t> &masks,
+                             const std::vector<double> &angles) {
+  const std::size_t numTerms = masks.size();
+#if defined(_OPENMP)
+#pragma omp parallel for if (dim >= parallelGroupThreshold)
+#endif
+  for (std::size_t k = 0; k < dim; ++k) {
+    double angle = 0.0;
+    for (std::size_t j = 0; j < numTerms; ++j)
+      angle += (__builtin_popcountll(k & masks[j]) & 1) ? -angles[j]
+                                                         : angles[j];
+    state[k] *= std::polar(1.0, angle);
+  }
+}
+
+/// @brief Apply the (controlled) gate `matrix` to the state vector of
+/// dimension `dim`, choosing the kernel from the structure of the matrix.
+inline void applyGate(complex *state, std::size_t dim,
+                      const std::vector<complex> &matrix,
+                      const std::vector<std::size_t> &controls,
+                      const std::vector<std::size_t> &targets) {
+  const GateIndexing idx(dim, controls, targets);
+  const std::size_t gateDim = idx.offsets.size();
+  switch (classifyGate(matrix, gateDim)) {
+  case GateKind::diagonal: {
+    std::vector<complex> diagonal(gateDim);
+    for (std::size_t r = 0; r < gateDim; ++r)
+      diagonal[r] = matrix[r * gateDim + r];
+    applyDiagonal(state, idx, diagonal);
+    return;
+  }
+  case GateKind::permutation: {
+    std::vector<std::size_t> source(gateDim);
+    std::vector<complex> phases(gateDim);
+    for (std::size_t r = 0; r < gateDim; ++r)
+      for (std::size_t c = 0; c < gateDim; ++c)
+        if (matrix[r * gateDim + c] != complex(0.0, 0.0)) {
+          source[r] = c;
+          phases[r] = matrix[r * gateDim + c];
+        }
+    applyPermutation(state, idx, source, phases);
+    return;
+  }
+  case GateKind::dense:
+    applyDense(state, idx, matrix);
+    return;
+  }
+}
+
+} // namespace nvqir::simd
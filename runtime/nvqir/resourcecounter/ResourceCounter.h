@@ -19,13 +19,40 @@ protected:
   cudaq::Resources resourceCounts;
   std::function<bool()> choice;
 
+  /// @brief Run of identical gates that is not counted in `resourceCounts`
+  /// yet. Circuits being estimated are dominated by long runs of the same
+  /// gate, e.g., from loops, which are then counted in bulk.
+  struct PendingRun {
+    std::string name;
+    cudaq::Resources::GateKindId gate = 0;
+    std::size_t nControls = 0;
+    std::size_t count = 0;
+  } pending;
+
+  /// @brief Count the pending run of gates in `resourceCounts`.
+  void flushPendingRun() {
+    if (pending.count)
+      resourceCounts.appendInstruction(pending.gate, pending.nControls,
+                                       pending.count);
+    pending.count = 0;
+  }
+
   /// @brief Grow the state vector by one qubit.
   void addQubitToState() override { resourceCounts.addQubit(); }
 
   void applyGate(const GateApplicationTask &task) override {
     CUDAQ_INFO("Applying {} with {} controls", task.operationName,
                task.controls.size());
-    resourceCounts.appendInstruction(task.operationName, task.controls.size());
+    if (pending.count && pending.nControls == task.controls.size() &&
+        pending.name == task.operationName) {
+      ++pending.count;
+      return;
+    }
+    flushPendingRun();
+    pending.name = task.operationName;
+    pending.gate = resourceCounts.internGate(task.operationName);
+    pending.nControls = task.controls.size();
+    pending.count = 1;
   }
 
   /// @brief Measure the qubit and return the result. Collapse the
@@ -54,6 +81,7 @@ public:
   /// @brief Reset the qubit
   /// @param index 0-based index of qubit to reset
   void resetQubit(const std::size_t index) override {
+    flushPendingRun();
     resourceCounts.appendInstruction("reset", 0);
   }
 
@@ -69,7 +97,10 @@ public:
 
   void deallocateStateImpl() override {}
 
-  void setToZeroState() override { resourceCounts.clear(); }
+  void setToZeroState() override {
+    pending.count = 0;
+    resourceCounts.clear();
+  }
 
   void setExecutionContext(cudaq::ExecutionContext *context) override {
     if (context->name != "resource-count")
@@ -79,7 +110,10 @@ public:
     this->CircuitSimulatorBase::setExecutionContext(context);
   }
 
-  cudaq::Resources *getResourceCounts() { return &this->resourceCounts; }
+  cudaq::Resources *getResourceCounts() {
+    flushPendingRun();
+    return &this->resourceCounts;
+  }
 
   void setChoiceFunction(std::function<bool()> choice) {
     assert(choice);
@@ -9,6 +9,7 @@
 #include "common/FmtCore.h"
 #include "nvqir/CircuitSimulator.h"
 #include "stim.h"
+#include <exception>
 
 using namespace cudaq;
 
@@ -46,9 +47,41 @@ protected:
   /// @brief Stim Tableau simulator (noiseless)
   std::unique_ptr<stim::TableauSimulator<W>> tableau;
 
+  /// @brief A Clifford operation applied to the Tableau simulator.
+  struct TableauOp {
+    std::string gateName;
+    std::vector<std::uint32_t> targets;
+    bool operator==(const TableauOp &) const = default;
+  };
+
+  /// @brief The operations applied to the Tableau simulator in this execution.
+  std::vector<TableauOp> tableauOps;
+
+  /// @brief The random number generator the Tableau simulator of this
+  /// execution was created with. Together with `tableauOps`, it determines
+  /// the noiseless reference measurement record.
+  std::mt19937_64 tableauRng;
+
+  /// @brief The Tableau operations, random number generator and resulting
+  /// measurement record of the previous execution. Repeated executions of the
+  /// same Clifford circuit, e.g., with a different noise model or number of
+  /// shots, reuse the cached reference instead of re-simulating the tableau.
+  std::vector<TableauOp> cachedTableauOps;
+  std::mt19937_64 cachedTableauRng;
+  std::vector<bool> cachedMeasurementRecord;
+
+  /// @brief Whether the operations of this execution have so far matched the
+  /// cached ones, in which case `tableau` has not been created yet.
+  bool replayingCachedTableau = false;
+
   /// @brief Stim Frame/Flip simulator (used to generate multiple shots)
   std::unique_ptr<stim::FrameSimulator<W>> sampleSim;
 
+  /// @brief Additional Frame/Flip simulators when the shots are sharded
+  /// across threads. `sampleSim` simulates the first shard, and each of these
+  /// the following ones, with its own random number generator.
+  std::vector<std::unique_ptr<stim::FrameSimulator<W>>> shardSims;
+
   /// @brief Error counter for MSM generation. This is only used for "msm" and
   /// "msm_size" execution contexts.
   std::size_t msm_err_count = 0;
@@ -61,6 +94,60 @@ protected:
   /// for speed)
   bool is_msm_mode = false;
 
+  /// @brief Environment variable name that sets the maximum number of shots
+  /// simulated by a single execution of a sampled kernel.
+  static constexpr const char maxBatchSizeEnvVar[] =
+      "CUDAQ_STIM_MAX_BATCH_SIZE";
+
+  /// @brief The maximum number of shots simulated at once. Larger requests
+  /// are served in chunks of this size, one kernel execution per chunk, which
+  /// bounds the memory used by the frame simulator's measurement record.
+  std::size_t maxBatchSize = 1 << 20;
+
+  /// @brief Environment variable name that sets the number of threads, each
+  /// with its own frame simulator, that the shots of a sampled kernel are
+  /// sharded across.
+  static constexpr const char numThreadsEnvVar[] = "CUDAQ_STIM_NUM_THREADS";
+
+  /// @brief The number of shards the shots are split into. Shards hold at
+  /// least `minShotsPerShard` shots, so small batches use fewer threads.
+  std::size_t numShards = 1;
+  static constexpr std::size_t minShotsPerShard = 1024;
+
+  /// @brief Apply `func` to every frame simulator, in parallel when the shots
+  /// are sharded.
+  template <typename Func>
+  void forEachSampleSim(Func &&func) {
+    if (shardSims.empty()) {
+      func(*sampleSim);
+      return;
+    }
+    std::exception_ptr error;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(shardSims.size() + 1)
+#endif
+    for (std::size_t i = 0; i <= shardSims.size(); ++i) {
+      try {
+        func(i == 0 ? *sampleSim : *shardSims[i - 1]);
+      } catch (...) {
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+        error = std::current_exception();
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  /// @brief The total number of shots simulated by the frame simulators.
+  std::size_t getNumSampleShots() const {
+    std::size_t numShots = sampleSim ? sampleSim->batch_size : 0;
+    for (const auto &sim : shardSims)
+      numShots += sim->batch_size;
+    return numShots;
+  }
+
   std::optional<StimNoiseType>
   isValidStimNoiseChannel(const kraus_channel &channel) const {
 
@@ -151,6 +238,35 @@ protected:
   /// @brief Grow the state vector by one qubit.
   void addQubitToState() override { addQubitsToState(1); }
 
+  /// @brief Pack bits [`firstBit`, `lastBit`) of the first `numShots` rows of
+  /// the shot-major bit table `table`, copying whole words at a time.
+  static cudaq::PackedShots packShots(const stim::simd_bit_table<W> &table,
+                                      std::size_t numShots,
+                                      std::size_t firstBit,
+                                      std::size_t lastBit) {
+    cudaq::PackedShots shots(lastBit - firstBit);
+    const std::size_t wordsPerShot = shots.wordsPerShot();
+    const std::size_t shift = firstBit % 64;
+    const std::size_t tailBits = shots.numBits % 64;
+    const std::uint64_t tailMask =
+        tailBits == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << tailBits) - 1;
+    shots.words.resize(numShots * wordsPerShot);
+    for (std::size_t shot = 0; shot < numShots; shot++) {
+      const auto row = table[shot];
+      const std::uint64_t *in = row.u64 + firstBit / 64;
+      const std::size_t numInWords = row.num_u64_padded() - firstBit / 64;
+      std::uint64_t *out = shots.words.data() + shot * wordsPerShot;
+      for (std::size_t w = 0; w < wordsPerShot; w++) {
+        std::uint64_t word = in[w] >> shift;
+        if (shift != 0 && w + 1 < numInWords)
+          word |= in[w + 1] << (64 - shift);
+        out[w] = word;
+      }
+      out[wordsPerShot - 1] &= tailMask;
+    }
+    return shots;
+  }
+
   /// @brief Get the batch size to use for the Stim simulator.
   std::size_t getBatchSize() {
     // Default to single shot
@@ -158,7 +274,11 @@ protected:
     auto *executionContext = getExecutionContext();
     if (executionContext && executionContext->name == "sample" &&
         !executionContext->hasConditionalsOnMeasureResults)
-      batch_size = executionContext->shots;
+      batch_size = std::min(
+          executionContext->shots -
+              std::min(executionContext->shotsCompleted,
+                       executionContext->shots),
+          maxBatchSize);
     else if (executionContext && executionContext->name == "msm")
       batch_size =
           executionContext->msm_dimensions.value_or(std::make_pair(1, 1))
@@ -183,19 +303,13 @@ protected:
 
     // Now it's msmSample[error_mechanism_index][measure_idx]
     msmSample = msmSample.transposed();
-    CountsDictionary counts;
-    std::vector<std::string> sequentialData;
-    sequentialData.reserve(num_cols);
-    for (std::size_t shot = 0; shot < num_cols; shot++) {
-      std::string aShot(num_measurements, '0');
-      for (std::size_t b = 0; b < num_measurements; b++)
-        aShot[b] = msmSample[shot][b] ? '1' : '0';
-      counts[aShot]++;
-      sequentialData.push_back(std::move(aShot));
-    }
-    ExecutionResult result(counts);
-    result.sequentialData = std::move(sequentialData);
-    executionContext->result = result;
+    ExecutionResult result;
+    if (num_measurements == 0)
+      result.appendResult("", num_cols);
+    else
+      result.appendPackedResults(
+          packShots(msmSample, num_cols, 0, num_measurements));
+    executionContext->result = std::move(result);
   }
 
   /// @brief Override the default sized allocation of qubits
@@ -206,14 +320,21 @@ protected:
       throw std::runtime_error("The Stim simulator does not support "
                                "initialization of qubits from state data.");
 
-    if (!tableau) {
-      CUDAQ_INFO("Creating new Stim Tableau simulator");
+    if (!tableau && !replayingCachedTableau) {
       // Bump the randomEngine before cloning and giving to the Tableau
       // simulator.
       randomEngine.discard(
           std::uniform_int_distribution<int>(1, 30)(randomEngine));
-      tableau = std::make_unique<stim::TableauSimulator<W>>(
-          std::mt19937_64(randomEngine), /*num_qubits=*/0, /*sign_bias=*/+0);
+      if (!cachedTableauOps.empty()) {
+        CUDAQ_INFO("Deferring Stim Tableau simulator creation while the "
+                   "circuit matches the cached one");
+        replayingCachedTableau = true;
+      } else {
+        CUDAQ_INFO("Creating new Stim Tableau simulator");
+        tableauRng = randomEngine;
+        tableau = std::make_unique<stim::TableauSimulator<W>>(
+            std::mt19937_64(tableauRng), /*num_qubits=*/0, /*sign_bias=*/+0);
+      }
     }
     if (!sampleSim) {
       is_msm_mode = executionContext && executionContext->name == "msm";
@@ -236,32 +357,110 @@ protected:
       circuit_stats.num_measurements = anticipated_num_measurements;
 
       auto batch_size = getBatchSize();
-      CUDAQ_INFO("Creating new Stim frame simulator with batch size {}",
-                 batch_size);
+      // Split the shots in shards of whole SIMD words. Measurements of the
+      // MSM mode refer to a single simulator, hence it is never sharded.
+      std::size_t shards =
+          is_msm_mode ? 1
+                      : std::clamp<std::size_t>(batch_size / minShotsPerShard,
+                                                1, numShards);
+      std::size_t shardSize = batch_size;
+      if (shards > 1) {
+        shardSize = (batch_size + shards * W - 1) / (shards * W) * W;
+        shards = (batch_size + shardSize - 1) / shardSize;
+      }
+      CUDAQ_INFO("Creating new Stim frame simulator with batch size {} in {} "
+                 "shard(s)",
+                 batch_size, shards);
       // Bump the randomEngine before cloning and giving to the sample
       // simulator.
       randomEngine.discard(
           std::uniform_int_distribution<int>(1, 30)(randomEngine));
       sampleSim = std::make_unique<stim::FrameSimulator<W>>(
           circuit_stats, stim::FrameSimulatorMode::STORE_MEASUREMENTS_TO_MEMORY,
-          batch_size, std::mt19937_64(randomEngine));
+          shardSize, std::mt19937_64(randomEngine));
       if (is_msm_mode) {
         sampleSim->guarantee_anticommutation_via_frame_randomization = false;
       }
       sampleSim->reset_all();
+      // The other shards draw their seeds from the top-level engine, which
+      // keeps them independent of each other and reproducible.
+      for (std::size_t i = 1; i < shards; ++i) {
+        const auto size = std::min(shardSize, batch_size - i * shardSize);
+        shardSims.push_back(std::make_unique<stim::FrameSimulator<W>>(
+            circuit_stats,
+            stim::FrameSimulatorMode::STORE_MEASUREMENTS_TO_MEMORY, size,
+            std::mt19937_64(randomEngine())));
+        shardSims.back()->reset_all();
+      }
       msm_err_count = 0;
       msm_id_counter = 0;
     }
   }
 
+  /// @brief Create the Tableau simulator of an execution that no longer
+  /// matches the cached circuit, by re-simulating the matching prefix with the
+  /// cached random number generator. This reproduces the reference outcomes
+  /// already handed out.
+  void materializeTableau() {
+    CUDAQ_INFO("Circuit diverged from the cached one after {} operations, "
+               "creating new Stim Tableau simulator",
+               tableauOps.size());
+    replayingCachedTableau = false;
+    tableauRng = cachedTableauRng;
+    tableau = std::make_unique<stim::TableauSimulator<W>>(
+        std::mt19937_64(tableauRng), /*num_qubits=*/0, /*sign_bias=*/+0);
+    stim::Circuit prefix;
+    for (const auto &op : tableauOps)
+      prefix.safe_append_u(op.gateName, op.targets);
+    tableau->safe_do_circuit(prefix);
+  }
+
+  /// @brief Apply the given operation to the Tableau simulator, unless it
+  /// matches the next operation of the cached circuit.
+  void applyOpToTableau(const std::string &gate_name,
+                        const std::vector<uint32_t> &targets,
+                        const stim::Circuit &circuit) {
+    TableauOp op{gate_name, targets};
+    if (replayingCachedTableau) {
+      if (tableauOps.size() < cachedTableauOps.size() &&
+          cachedTableauOps[tableauOps.size()] == op) {
+        tableauOps.push_back(std::move(op));
+        return;
+      }
+      materializeTableau();
+    }
+    tableau->safe_do_circuit(circuit);
+    tableauOps.push_back(std::move(op));
+  }
+
+  /// @brief Return the noiseless reference measurement record of this
+  /// execution.
+  std::vector<bool> getReferenceRecord() const {
+    if (replayingCachedTableau)
+      return std::vector<bool>(cachedMeasurementRecord.begin(),
+                               cachedMeasurementRecord.begin() +
+                                   num_measurements);
+    return tableau->measurement_record.storage;
+  }
+
   /// @brief Reset the qubit state.
   void deallocateStateImpl() override {
+    // Keep the circuit of this execution as the reference for the next one,
+    // unless it matched (a prefix of) the cached circuit.
+    if (tableau) {
+      cachedTableauOps = std::move(tableauOps);
+      cachedTableauRng = tableauRng;
+      cachedMeasurementRecord = tableau->measurement_record.storage;
+    }
+    tableauOps.clear();
+    replayingCachedTableau = false;
     tableau.reset();
     // Update the randomEngine so that future invocations will use the updated
     // RNG state.
     if (sampleSim)
       randomEngine = std::move(sampleSim->rng);
     sampleSim.reset();
+    shardSims.clear();
     num_measurements = 0;
     msm_err_count = 0;
     msm_id_counter = 0;
@@ -276,8 +475,10 @@ protected:
     stim::Circuit tempCircuit;
     CUDAQ_INFO("Calling applyOpToSims {} - {}", gate_name, targets);
     tempCircuit.safe_append_u(gate_name, targets);
-    tableau->safe_do_circuit(tempCircuit);
-    sampleSim->safe_do_circuit(tempCircuit);
+    applyOpToTableau(gate_name, targets, tempCircuit);
+    forEachSampleSim([&](stim::FrameSimulator<W> &sim) {
+      sim.safe_do_circuit(tempCircuit);
+    });
   }
 
   /// @brief Apply the noise channel on \p qubits
@@ -293,9 +494,6 @@ protected:
     if (!executionContext->noiseModel)
       return;
 
-    // Get the name as a string
-    std::string gName(gateName);
-
     // Cast size_t to uint32_t
     std::vector<std::uint32_t> stimTargets;
     stimTargets.reserve(controls.size() + targets.size());
@@ -304,19 +502,33 @@ protected:
     for (auto q : targets)
       stimTargets.push_back(static_cast<std::uint32_t>(q));
 
-    // Get the Kraus channels specified for this gate and qubits
-    auto krausChannels = executionContext->noiseModel->get_channels(
-        gName, targets, controls, params);
-
-    // If none, do nothing
-    if (krausChannels.empty())
-      return;
-
-    CUDAQ_INFO("Applying {} kraus channels to qubits {}", krausChannels.size(),
-               stimTargets);
-
-    for (auto &channel : krausChannels)
-      applyNoise(channel, stimTargets);
+    // Apply the Kraus channels specified for this gate and qubits
+    executionContext->noiseModel->for_each_channel(
+        gateName, targets, controls, params,
+        [&](const cudaq::kraus_channel &channel) {
+          CUDAQ_INFO("Applying kraus channel {} to qubits {}",
+                     channel.get_type_name(), stimTargets);
+          applyNoise(channel, stimTargets);
+        });
+
+    // The crosstalk channel of all spectators is applied as one instruction,
+    // except for measurement syndrome matrices, which need one error
+    // mechanism per spectator.
+    executionContext->noiseModel->for_each_crosstalk_channel(
+        gateName, targets, controls,
+        [&](const cudaq::noise_model::crosstalk_channel &crosstalk,
+            const std::vector<std::size_t> &spectators) {
+          CUDAQ_INFO("Applying crosstalk kraus channel {} to qubits {}",
+                     crosstalk.channel.get_type_name(), spectators);
+          std::vector<std::uint32_t> stimSpectators(spectators.begin(),
+                                                    spectators.end());
+          if (!is_msm_mode) {
+            applyNoise(crosstalk.channel, stimSpectators);
+            return;
+          }
+          for (auto qubit : stimSpectators)
+            applyNoise(crosstalk.channel, std::vector<std::uint32_t>{qubit});
+        });
   }
 
   bool isValidNoiseChannel(const cudaq::noise_model_type &type) const override {
@@ -373,9 +585,11 @@ protected:
         stim::Circuit noiseOps;
         noiseOps.safe_append_u(res.value().stim_name, qubits,
                                channel.parameters);
-        // Only apply the noise operations to the sample simulator (not the
+        // Only apply the noise operations to the sample simulators (not the
         // Tableau simulator).
-        sampleSim->safe_do_circuit(noiseOps);
+        forEachSampleSim([&](stim::FrameSimulator<W> &sim) {
+          sim.safe_do_circuit(noiseOps);
+        });
 
         // Increment the error count by the number of mechanisms
         msm_err_count += res->params.size();
@@ -440,8 +654,10 @@ protected:
     num_measurements++;
 
     // Get the tableau bit that was just generated.
-    const std::vector<bool> &v = tableau->measurement_record.storage;
-    const bool tableauBit = *v.crbegin();
+    const bool tableauBit =
+        replayingCachedTableau
+            ? cachedMeasurementRecord[num_measurements - 1]
+            : *tableau->measurement_record.storage.crbegin();
 
     // Get the mid-circuit sample to be XOR-ed with tableauBit.
     bool sampleSimBit =
@@ -464,15 +680,44 @@ public:
     // simulator knows how to buffer the results across multiple sample()
     // invocations.
     supportsBufferedSample = true;
+    if (auto *numThreadsEnvVal = std::getenv(numThreadsEnvVar)) {
+      const int numThreads = std::atoi(numThreadsEnvVal);
+      if (numThreads < 1)
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting a positive "
+            "integer, got '{}'.",
+            numThreadsEnvVar, numThreadsEnvVal));
+      numShards = numThreads;
+    }
+    if (auto *batchSizeEnvVal = std::getenv(maxBatchSizeEnvVar)) {
+      auto batchSize = std::atoll(batchSizeEnvVal);
+      if (batchSize <= 0)
+        throw std::runtime_error(cudaq_fmt::format(
+            "Invalid {} environment variable setting. Expecting a positive "
+            "integer value, got '{}'.",
+            maxBatchSizeEnvVar, batchSizeEnvVal));
+      maxBatchSize = batchSize;
+    }
   }
   virtual ~StimCircuitSimulator() = default;
 
   void setRandomSeed(std::size_t seed) override {
     randomEngine = std::mt19937_64(seed);
+    // Results after seeding must not depend on earlier executions.
+    cachedTableauOps.clear();
+    cachedMeasurementRecord.clear();
   }
 
   bool canHandleObserve() override { return false; }
 
+  /// @brief Sampled kernels produce at most one batch of shots per execution.
+  int getNumShotsToExec() const override {
+    const int nShots = CircuitSimulatorBase::getNumShotsToExec();
+    if (!sampleSim)
+      return nShots;
+    return std::min(nShots, static_cast<int>(getNumSampleShots()));
+  }
+
   /// @brief Reset the qubit
   /// @param index 0-based index of qubit to reset
   void resetQubit(const std::size_t index) override {
@@ -501,7 +746,7 @@ public:
     if (!sampleSim)
       throw std::runtime_error("Stim simulator state is not initialized. "
                                "Cannot sample from uninitialized state.");
-    assert(shots <= sampleSim->batch_size);
+    assert(shots <= getNumSampleShots());
     std::vector<std::uint32_t> stimTargetQubits(qubits.begin(), qubits.end());
     applyOpToSims("M", stimTargetQubits);
     num_measurements += stimTargetQubits.size();
@@ -510,26 +755,12 @@ public:
       return cudaq::ExecutionResult();
 
     // Generate a reference sample
-    const std::vector<bool> &v = tableau->measurement_record.storage;
+    const std::vector<bool> v = getReferenceRecord();
     stim::simd_bits<W> ref(v.size());
     for (size_t k = 0; k < v.size(); k++)
       ref[k] ^= v[k];
 
-    // Now XOR results on a per-shot basis
-    stim::simd_bit_table<W> sample = sampleSim->m_record.storage;
-    auto nShots = sampleSim->batch_size;
-
-    // This is a slightly modified version of `sample_batch_measurements`, where
-    // we already have the `sample` from the frame simulator. It also places the
-    // `sample` in a layout amenable to the order of the loops below (shot
-    // major).
-    sample = sample.transposed();
-    if (ref.not_zero())
-      for (size_t s = 0; s < nShots; s++)
-        sample[s].word_range_ref(0, ref.num_simd_words) ^= ref;
-
     size_t bits_per_sample = num_measurements;
-    std::vector<std::string> sequentialData;
     // Only retain the final "qubits.size()" measurements. All other
     // measurements were mid-circuit measurements that have been previously
     // accounted for and saved.
@@ -537,17 +768,43 @@ public:
     std::size_t first_bit_to_save = executionContext->explicitMeasurements
                                         ? 0
                                         : bits_per_sample - qubits.size();
-    CountsDictionary counts;
-    sequentialData.reserve(shots);
-    for (std::size_t shot = 0; shot < shots; shot++) {
-      std::string aShot(bits_per_sample - first_bit_to_save, '0');
-      for (std::size_t b = first_bit_to_save; b < bits_per_sample; b++)
-        aShot[b - first_bit_to_save] = sample[shot][b] ? '1' : '0';
-      counts[aShot]++;
-      sequentialData.push_back(std::move(aShot));
+    ExecutionResult result;
+    if (bits_per_sample == first_bit_to_save) {
+      result.appendResult("", shots);
+      return result;
+    }
+
+    // Now XOR results on a per-shot basis, and copy the shots straight from
+    // the bit table of every shard; bit strings are only created once per
+    // distinct outcome, or on request.
+    std::vector<stim::FrameSimulator<W> *> sims{sampleSim.get()};
+    std::vector<std::size_t> firstShots{0};
+    for (auto &sim : shardSims) {
+      firstShots.push_back(firstShots.back() + sims.back()->batch_size);
+      sims.push_back(sim.get());
+    }
+    std::vector<cudaq::PackedShots> shardShots(sims.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if (sims.size() > 1)                \
+    num_threads(sims.size())
+#endif
+    for (std::size_t i = 0; i < sims.size(); ++i) {
+      const std::size_t first = std::min<std::size_t>(firstShots[i], shots);
+      const std::size_t nShots =
+          std::min<std::size_t>(sims[i]->batch_size, shots - first);
+      // This is a slightly modified version of `sample_batch_measurements`,
+      // where we already have the `sample` from the frame simulator. It also
+      // places the `sample` in a layout amenable to the packing below (shot
+      // major).
+      stim::simd_bit_table<W> sample = sims[i]->m_record.storage.transposed();
+      if (ref.not_zero())
+        for (size_t s = 0; s < nShots; s++)
+          sample[s].word_range_ref(0, ref.num_simd_words) ^= ref;
+      shardShots[i] =
+          packShots(sample, nShots, first_bit_to_save, bits_per_sample);
     }
-    ExecutionResult result(counts);
-    result.sequentialData = std::move(sequentialData);
+    for (auto &packed : shardShots)
+      result.appendPackedResults(std::move(packed));
     return result;
   }
 
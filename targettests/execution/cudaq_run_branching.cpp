@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// clang-format off
+// RUN: nvq++ %s -o %t && CUDAQ_RUN_BRANCH_BATCHING=1 %t | FileCheck %s
+// RUN: nvq++ --target density-matrix-cpu %s -o %t && CUDAQ_RUN_BRANCH_BATCHING=1 %t | FileCheck %s
+// RUN: nvq++ %s -o %t && CUDAQ_RUN_BRANCH_BATCHING=1 CUDAQ_RUN_NUM_THREADS=4 %t | FileCheck %s
+// clang-format on
+
+#include <cudaq.h>
+
+// Teleport |1> and return the two mid-circuit measurements along with the
+// measurement of the teleported qubit.
+__qpu__ int teleport() {
+  cudaq::qvector q(3);
+  x(q[0]);
+  h(q[1]);
+  cx(q[1], q[2]);
+  cx(q[0], q[1]);
+  h(q[0]);
+  auto m0 = mz(q[0]);
+  auto m1 = mz(q[1]);
+  if (m1)
+    x(q[2]);
+  if (m0)
+    z(q[2]);
+  return 4 * m0 + 2 * m1 + mz(q[2]);
+}
+
+int main() {
+  constexpr std::size_t shots = 1000;
+  cudaq::set_random_seed(13);
+  auto results = cudaq::run(shots, teleport);
+  std::size_t counts[4] = {0, 0, 0, 0};
+  bool teleported = results.size() == shots;
+  for (auto result : results) {
+    teleported = teleported && (result & 1);
+    counts[result >> 1]++;
+  }
+  // The four Bell measurement outcomes are equally likely.
+  bool uniform = true;
+  for (auto count : counts)
+    uniform = uniform && count > 150 && count < 350;
+  if (teleported && uniform)
+    printf("success!\n");
+  else
+    printf("FAILED! %lu %lu %lu %lu\n", counts[0], counts[1], counts[2],
+           counts[3]);
+
+  // The shots of consecutive branches are shuffled.
+  std::size_t changes = 0;
+  for (std::size_t i = 1; i < results.size(); ++i)
+    if (results[i] != results[i - 1])
+      changes++;
+  printf("%s\n", changes > shots / 2 ? "shuffled" : "FAILED! not shuffled");
+
+  cudaq::set_random_seed(17);
+  auto first = cudaq::run(shots, teleport);
+  cudaq::set_random_seed(18);
+  cudaq::run(shots, teleport);
+  cudaq::set_random_seed(17);
+  auto second = cudaq::run(shots, teleport);
+  printf("%s\n", first == second ? "reproducible" : "FAILED! not reproducible");
+  return 0;
+}
+
+// CHECK: success!
+// CHECK: shuffled
+// CHECK: reproducible
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// clang-format off
+// RUN: nvq++ %s -o %t && CUDAQ_RUN_NUM_THREADS=4 %t | FileCheck %s
+// RUN: nvq++ --target density-matrix-cpu %s -o %t && CUDAQ_RUN_NUM_THREADS=4 %t | FileCheck %s
+// clang-format on
+
+#include <cudaq.h>
+
+__qpu__ int ghz(int count) {
+  int result = 0;
+  cudaq::qvector v(count);
+  h(v[0]);
+  for (int i = 0; i < count - 1; i++)
+    cx(v[i], v[i + 1]);
+  for (int i = 0; i < count; i++)
+    if (mz(v[i]))
+      result += 1;
+  return result;
+}
+
+int main() {
+  constexpr int numQubits = 3;
+  constexpr std::size_t shots = 1000;
+  cudaq::set_random_seed(13);
+  auto results = cudaq::run(shots, ghz, numQubits);
+  std::size_t zeros = 0, ones = 0;
+  for (auto result : results) {
+    if (result == 0)
+      zeros++;
+    else if (result == numQubits)
+      ones++;
+  }
+  if (results.size() == shots && zeros + ones == shots && zeros > 0 &&
+      ones > 0)
+    printf("success!\n");
+  else
+    printf("FAILED! %lu shots, %lu zeros, %lu ones\n", results.size(), zeros,
+           ones);
+
+  // The sharded run is reproducible with the same seed.
+  cudaq::set_random_seed(17);
+  auto first = cudaq::run(shots, ghz, numQubits);
+  cudaq::set_random_seed(18);
+  cudaq::run(shots, ghz, numQubits);
+  cudaq::set_random_seed(17);
+  auto second = cudaq::run(shots, ghz, numQubits);
+  printf("%s\n", first == second ? "reproducible" : "FAILED! not reproducible");
+  return 0;
+}
+
+// CHECK: success!
+// CHECK: reproducible
@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include <cudaq.h>
+
+// RUN: nvq++ --target opt-test --target-option dep-analysis,qpp %s -o %t && %t | FileCheck %s
+
+// The ancilla is released in the |1> state, and `b` may be mapped onto the
+// same physical qubit. It must start in the |0> state nonetheless.
+struct run_test {
+  __qpu__ auto operator()() {
+    cudaq::qubit q;
+    x(q);
+
+    {
+      cudaq::qubit ancilla;
+      x<cudaq::ctrl>(q, ancilla);
+    }
+
+    cudaq::qubit b;
+    x<cudaq::ctrl>(q, b);
+
+    bool result = mz(b);
+
+    return result;
+  }
+};
+
+int main() {
+  bool result = run_test{}();
+  printf("Result = %b\n", result);
+  return 0;
+}
+
+// CHECK: Result = 1
@@ -0,0 +1,131 @@
+// ========================================================================== //
+// Copyright (c) 2026 NVIDIA Corporation & Affiliates.                        //
+// All rights reserved.                                                       //
+//                                                                            //
+// This source code and the accompanying materials are made available under   //
+// the terms of the Apache License 2.0 which accompanies this distribution.   //
+// ========================================================================== //
+
+// RUN: cudaq-lsp-server --incremental --lit-test < %s | FileCheck %s
+
+{"jsonrpc":"2.0","id":0,"method":"initialize","params":{"processId":123,"rootUri":"test","capabilities":{},"trace":"off"}}
+// CHECK:      "id": 0,
+// CHECK-NEXT: "jsonrpc": "2.0",
+// CHECK-NEXT: "result": {
+// CHECK-NEXT:   "capabilities": {
+// CHECK-NEXT:     "textDocumentSync": {
+// CHECK-NEXT:       "change": 2,
+// CHECK-NEXT:       "openClose": true
+// CHECK-NEXT:     }
+// CHECK-NEXT:   },
+// CHECK-NEXT:   "serverInfo": {
+// CHECK-NEXT:     "name": "cudaq-lsp-server"
+// -----
+// The second function returns a value from a function without results.
+{"jsonrpc":"2.0","method":"textDocument/didOpen","params":{"textDocument":{
+  "uri":"test:///foo.mlir",
+  "languageId":"mlir",
+  "version":1,
+  "text":"func.func @good() {\n  return\n}\nfunc.func @bad() {\n  %0 = arith.constant 1 : i32\n  return %0 : i32\n}\n"
+}}}
+// CHECK:      "method": "textDocument/publishDiagnostics",
+// CHECK-NEXT: "params": {
+// CHECK-NEXT:   "diagnostics": [
+// CHECK-NEXT:     {
+// CHECK-NEXT:       "message": "'func.return' op has 1 operands, but enclosing function (@bad) returns 0",
+// CHECK-NEXT:       "range": {
+// CHECK-NEXT:         "end": {
+// CHECK-NEXT:           "character": 8,
+// CHECK-NEXT:           "line": 5
+// CHECK-NEXT:         },
+// CHECK-NEXT:         "start": {
+// CHECK-NEXT:           "character": 2,
+// CHECK-NEXT:           "line": 5
+// CHECK-NEXT:         }
+// CHECK-NEXT:       },
+// CHECK-NEXT:       "severity": 1,
+// CHECK-NEXT:       "source": "cudaq-lsp-server"
+// CHECK-NEXT:     }
+// CHECK-NEXT:   ],
+// CHECK-NEXT:   "uri": "test:///foo.mlir",
+// CHECK-NEXT:   "version": 1
+// -----
+// A function inserted above the others moves the (reused) diagnostic of the
+// unchanged function down.
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{
+  "textDocument":{"uri":"test:///foo.mlir","version":2},
+  "contentChanges":[{
+    "range":{"start":{"line":0,"character":0},"end":{"line":0,"character":0}},
+    "text":"func.func @other() {\n  return\n}\n"
+  }]
+}}
+// CHECK:      "method": "textDocument/publishDiagnostics",
+// CHECK-NEXT: "params": {
+// CHECK-NEXT:   "diagnostics": [
+// CHECK-NEXT:     {
+// CHECK-NEXT:       "message": "'func.return' op has 1 operands, but enclosing function (@bad) returns 0",
+// CHECK-NEXT:       "range": {
+// CHECK-NEXT:         "end": {
+// CHECK-NEXT:           "character": 8,
+// CHECK-NEXT:           "line": 8
+// CHECK-NEXT:         },
+// CHECK-NEXT:         "start": {
+// CHECK-NEXT:           "character": 2,
+// CHECK-NEXT:           "line": 8
+// CHECK-NEXT:         }
+// CHECK-NEXT:       },
+// CHECK-NEXT:       "severity": 1,
+// CHECK-NEXT:       "source": "cudaq-lsp-server"
+// CHECK-NEXT:     }
+// CHECK-NEXT:   ],
+// CHECK-NEXT:   "uri": "test:///foo.mlir",
+// CHECK-NEXT:   "version": 2
+// -----
+// Fixing the return of the second function clears its diagnostic.
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{
+  "textDocument":{"uri":"test:///foo.mlir","version":3},
+  "contentChanges":[{
+    "range":{"start":{"line":8,"character":2},"end":{"line":8,"character":17}},
+    "text":"return"
+  }]
+}}
+// CHECK:      "method": "textDocument/publishDiagnostics",
+// CHECK-NEXT: "params": {
+// CHECK-NEXT:   "diagnostics": [],
+// CHECK-NEXT:   "uri": "test:///foo.mlir",
+// CHECK-NEXT:   "version": 3
+// -----
+// A syntax error is reported at its location within the edited function.
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{
+  "textDocument":{"uri":"test:///foo.mlir","version":4},
+  "contentChanges":[{
+    "range":{"start":{"line":4,"character":2},"end":{"line":4,"character":2}},
+    "text":"%1 = arith.constant : i32\n  "
+  }]
+}}
+// CHECK:      "method": "textDocument/publishDiagnostics",
+// CHECK-NEXT: "params": {
+// CHECK-NEXT:   "diagnostics": [
+// CHECK-NEXT:     {
+// CHECK-NEXT:       "message": "expected attribute value",
+// CHECK:            "start": {
+// CHECK-NEXT:         "character": 22,
+// CHECK-NEXT:         "line": 4
+// CHECK:        "uri": "test:///foo.mlir",
+// CHECK-NEXT:   "version": 4
+// -----
+{"jsonrpc":"2.0","method":"textDocument/didClose","params":{
+  "textDocument":{"uri":"test:///foo.mlir"}
+}}
+// CHECK:      "method": "textDocument/publishDiagnostics",
+// CHECK-NEXT: "params": {
+// CHECK-NEXT:   "diagnostics": [],
+// CHECK-NEXT:   "uri": "test:///foo.mlir"
+// CHECK-NEXT: }
+// -----
+{"jsonrpc":"2.0","id":1,"method":"shutdown"}
+// CHECK:      "id": 1,
+// CHECK-NEXT: "jsonrpc": "2.0",
+// CHECK-NEXT: "result": null
+// -----
+{"jsonrpc":"2.0","method":"exit"}
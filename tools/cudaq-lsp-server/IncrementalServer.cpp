@@ -0,0 +1,835 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "IncrementalServer.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/DialectRegistry.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/IR/Verifier.h"
+#include "mlir/Parser/Parser.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace mlir;
+namespace json = llvm::json;
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Text positions
+//===----------------------------------------------------------------------===//
+
+/// The byte offsets of the lines of a text.
+class LineTable {
+public:
+  explicit LineTable(llvm::StringRef text) : text(text) {
+    starts.push_back(0);
+    for (std::size_t i = 0; i < text.size(); ++i)
+      if (text[i] == '\n')
+        starts.push_back(i + 1);
+  }
+
+  std::size_t numLines() const { return starts.size(); }
+
+  /// The text of line `line`, without its line break.
+  llvm::StringRef line(std::size_t line) const {
+    if (line >= starts.size())
+      return {};
+    const auto end =
+        line + 1 < starts.size() ? starts[line + 1] - 1 : text.size();
+    return text.slice(starts[line], end).rtrim('\r');
+  }
+
+  /// The text of the lines [first, first + count), with their line breaks.
+  llvm::StringRef lines(std::size_t first, std::size_t count) const {
+    if (first >= starts.size())
+      return {};
+    const auto end =
+        first + count < starts.size() ? starts[first + count] : text.size();
+    return text.slice(starts[first], end);
+  }
+
+  /// The byte offset of an LSP position, whose character is counted in UTF-16
+  /// code units.
+  std::size_t offset(std::size_t line, std::size_t character) const {
+    if (line >= starts.size())
+      return text.size();
+    return starts[line] + byteColumn(this->line(line), character);
+  }
+
+  /// The byte column of the UTF-16 column `character` of `line`.
+  static std::size_t byteColumn(llvm::StringRef line, std::size_t character) {
+    std::size_t byte = 0;
+    while (byte < line.size() && character > 0) {
+      const auto length = utf8Length(line[byte]);
+      // Characters outside of the BMP take two UTF-16 code units.
+      character -= std::min<std::size_t>(character, length == 4 ? 2 : 1);
+      byte += length;
+    }
+    return std::min(byte, line.size());
+  }
+
+  /// The UTF-16 column of the byte column `byte` of `line`.
+  static std::size_t utf16Column(llvm::StringRef line, std::size_t byte) {
+    std::size_t character = 0;
+    for (std::size_t i = 0; i < std::min(byte, line.size());) {
+      const auto length = utf8Length(line[i]);
+      character += length == 4 ? 2 : 1;
+      i += length;
+    }
+    return character;
+  }
+
+private:
+  static std::size_t utf8Length(char lead) {
+    const auto byte = static_cast<unsigned char>(lead);
+    if (byte >= 0xF0)
+      return 4;
+    if (byte >= 0xE0)
+      return 3;
+    if (byte >= 0xC0)
+      return 2;
+    return 1;
+  }
+
+  llvm::StringRef text;
+  std::vector<std::size_t> starts;
+};
+
+//===----------------------------------------------------------------------===//
+// Document layout
+//===----------------------------------------------------------------------===//
+
+/// The marker splitting a document into independent modules, as in the inputs
+/// of `cudaq-opt --split-input-file`.
+constexpr llvm::StringLiteral splitMarker = "// -----";
+
+/// The top-level operations of a document, and the alias definitions of each
+/// of its splits, which are parsed along with these operations.
+struct DocumentLayout {
+  struct Segment {
+    std::size_t firstLine;
+    std::size_t numLines;
+    std::size_t split;
+  };
+  struct Header {
+    std::string text;
+    /// The document line of each line of `text`.
+    std::vector<std::size_t> lines;
+  };
+  std::vector<Segment> segments;
+  std::vector<Header> headers;
+};
+
+/// Return the change of bracket nesting over `line`, ignoring the brackets in
+/// string literals and comments.
+int bracketDelta(llvm::StringRef line) {
+  int delta = 0;
+  bool inString = false;
+  for (std::size_t i = 0; i < line.size(); ++i) {
+    const char c = line[i];
+    if (inString) {
+      if (c == '\\')
+        ++i;
+      else if (c == '"')
+        inString = false;
+      continue;
+    }
+    if (c == '"')
+      inString = true;
+    else if (c == '/' && i + 1 < line.size() && line[i + 1] == '/')
+      break;
+    else if (c == '{' || c == '(' || c == '[')
+      ++delta;
+    else if (c == '}' || c == ')' || c == ']')
+      --delta;
+  }
+  return delta;
+}
+
+/// Split a document into its top-level operations, that is the operations of
+/// the body of its module, or the operations at the top of the file when they
+/// are not wrapped in a module. The scan only tracks the nesting of brackets,
+/// so that it is linear in the size of the document and tolerates invalid
+/// code, which is reported when the operations are parsed.
+DocumentLayout scanDocument(const LineTable &lines) {
+  DocumentLayout layout;
+  layout.headers.emplace_back();
+  int depth = 0;
+  // The nesting depth of the top-level operations: 1 within a module.
+  int segmentDepth = 0;
+  bool inModuleHeader = false;
+  bool inAlias = false;
+  std::optional<std::size_t> current;
+
+  for (std::size_t i = 0; i < lines.numLines(); ++i) {
+    const auto line = lines.line(i);
+    const auto trimmed = line.trim();
+    if (trimmed == splitMarker) {
+      layout.headers.emplace_back();
+      depth = segmentDepth = 0;
+      inModuleHeader = inAlias = false;
+      current.reset();
+      continue;
+    }
+    const int startDepth = depth;
+    depth = std::max(0, depth + bracketDelta(line));
+    auto &header = layout.headers.back();
+
+    if (inAlias) {
+      header.text.append(line.str()).push_back('\n');
+      header.lines.push_back(i);
+      inAlias = depth > 0;
+      continue;
+    }
+    if (inModuleHeader) {
+      // Wait for the attributes of the module to end and its body to open.
+      if (trimmed.ends_with("{")) {
+        inModuleHeader = false;
+        segmentDepth = depth;
+      }
+      continue;
+    }
+    if (startDepth > segmentDepth) {
+      // The continuation of the current operation, e.g., its body.
+      if (current) {
+        auto &segment = layout.segments[*current];
+        segment.numLines = i - segment.firstLine + 1;
+      }
+      continue;
+    }
+    if (trimmed.empty() || trimmed.starts_with("//"))
+      continue;
+
+    current.reset();
+    if (segmentDepth == 1 && trimmed.starts_with("}")) {
+      // The end of the module.
+      segmentDepth = 0;
+      continue;
+    }
+    if (segmentDepth == 0 &&
+        (trimmed.starts_with("#") || trimmed.starts_with("!"))) {
+      header.text.append(line.str()).push_back('\n');
+      header.lines.push_back(i);
+      inAlias = depth > 0;
+      continue;
+    }
+    if (segmentDepth == 0 && (trimmed == "module" ||
+                              trimmed.starts_with("module ") ||
+                              trimmed.starts_with("module{"))) {
+      if (depth == 0)
+        continue;
+      if (trimmed.ends_with("{"))
+        segmentDepth = depth;
+      else
+        inModuleHeader = true;
+      continue;
+    }
+    // Dialect resources (`{-# ... #-}`) are only checked by the verification
+    // of the whole document.
+    if (trimmed.starts_with("{-#"))
+      continue;
+
+    current = layout.segments.size();
+    layout.segments.push_back({i, 1, layout.headers.size() - 1});
+  }
+  return layout;
+}
+
+//===----------------------------------------------------------------------===//
+// Parsing and verification
+//===----------------------------------------------------------------------===//
+
+/// A diagnostic of a parsed buffer. `line` and `column` are 0-based, in bytes,
+/// and unset if the location of the diagnostic is not in the buffer.
+struct BufferDiagnostic {
+  std::optional<std::size_t> line;
+  std::size_t column = 0;
+  int severity = 1;
+  std::string message;
+};
+
+constexpr llvm::StringLiteral bufferName = "cudaq-lsp-buffer";
+
+int toLspSeverity(DiagnosticSeverity severity) {
+  switch (severity) {
+  case DiagnosticSeverity::Error:
+    return 1;
+  case DiagnosticSeverity::Warning:
+    return 2;
+  case DiagnosticSeverity::Note:
+  case DiagnosticSeverity::Remark:
+    return 3;
+  }
+  return 1;
+}
+
+std::unique_ptr<MLIRContext>
+createContext(const DialectRegistry &registry) {
+  auto context =
+      std::make_unique<MLIRContext>(registry, MLIRContext::Threading::DISABLED);
+  context->allowUnregisteredDialects();
+  return context;
+}
+
+/// Collect the diagnostics emitted while parsing `source` in `context`.
+struct DiagnosticCollector {
+  DiagnosticCollector(MLIRContext &context, llvm::StringRef source)
+      : handler(&context, [this](Diagnostic &diag) {
+          BufferDiagnostic result;
+          result.severity = toLspSeverity(diag.getSeverity());
+          result.message = diag.str();
+          auto loc = dyn_cast<FileLineColLoc>(LocationAttr(diag.getLocation()));
+          if (loc && loc.getFilename().getValue() == bufferName) {
+            result.line = loc.getLine() > 0 ? loc.getLine() - 1 : 0;
+            result.column = loc.getColumn() > 0 ? loc.getColumn() - 1 : 0;
+          }
+          diagnostics.push_back(std::move(result));
+          return success();
+        }) {
+    sourceMgr.AddNewSourceBuffer(
+        llvm::MemoryBuffer::getMemBuffer(source, bufferName,
+                                         /*RequiresNullTerminator=*/false),
+        llvm::SMLoc());
+  }
+
+  llvm::SourceMgr sourceMgr;
+  std::vector<BufferDiagnostic> diagnostics;
+  ScopedDiagnosticHandler handler;
+};
+
+/// Parse the top-level operations of `source` and verify each of them, but
+/// not the symbol uses between them, which need the whole module.
+std::vector<BufferDiagnostic> parseAndVerifyOperations(MLIRContext &context,
+                                                       llvm::StringRef source) {
+  DiagnosticCollector collector(context, source);
+  Block block;
+  ParserConfig config(&context, /*verifyAfterParse=*/false);
+  if (succeeded(parseSourceFile(collector.sourceMgr, &block, config)))
+    for (Operation &op : block)
+      (void)verify(&op);
+  return std::move(collector.diagnostics);
+}
+
+/// Parse and verify the module `source`, one top-level operation at a time,
+/// and then the symbol uses between them. Return std::nullopt if `cancelled`
+/// is raised before the verification is complete.
+std::optional<std::vector<BufferDiagnostic>>
+parseAndVerifyModule(MLIRContext &context, llvm::StringRef source,
+                     const std::atomic<bool> &cancelled) {
+  DiagnosticCollector collector(context, source);
+  ParserConfig config(&context, /*verifyAfterParse=*/false);
+  auto module = parseSourceFile<ModuleOp>(collector.sourceMgr, config);
+  if (!module)
+    return std::move(collector.diagnostics);
+  for (Operation &op : *module->getBody()) {
+    if (cancelled)
+      return std::nullopt;
+    (void)verify(&op);
+  }
+  if (cancelled)
+    return std::nullopt;
+  (void)detail::verifySymbolTable(*module);
+  return std::move(collector.diagnostics);
+}
+
+/// A diagnostic of a document, at a byte column of a line.
+struct DocumentDiagnostic {
+  std::size_t line;
+  std::size_t column;
+  int severity;
+  std::string message;
+};
+
+json::Value toJSON(const DocumentDiagnostic &diagnostic,
+                   const LineTable &lines) {
+  const auto text = lines.line(diagnostic.line);
+  // Underline the token at the location of the diagnostic.
+  auto end = text.find_first_of(" \t,:()[]{}<>", diagnostic.column + 1);
+  end = std::min(end, text.size());
+  auto position = [&](std::size_t column) {
+    return json::Object{
+        {"line", static_cast<int64_t>(diagnostic.line)},
+        {"character",
+         static_cast<int64_t>(LineTable::utf16Column(text, column))}};
+  };
+  return json::Object{
+      {"range", json::Object{{"start", position(diagnostic.column)},
+                             {"end", position(end)}}},
+      {"severity", diagnostic.severity},
+      {"source", "cudaq-lsp-server"},
+      {"message", diagnostic.message}};
+}
+
+json::Array toJSON(const std::vector<DocumentDiagnostic> &diagnostics,
+                   const LineTable &lines) {
+  json::Array result;
+  for (const auto &diagnostic : diagnostics)
+    result.push_back(toJSON(diagnostic, lines));
+  return result;
+}
+
+//===----------------------------------------------------------------------===//
+// Documents
+//===----------------------------------------------------------------------===//
+
+/// An open document, and the diagnostics of its top-level operations, by the
+/// text they were parsed from.
+class Document {
+public:
+  Document(const DialectRegistry &registry, std::string contents,
+           int64_t version)
+      : registry(registry), contents(std::move(contents)), version(version),
+        context(createContext(registry)) {}
+
+  const std::string &getContents() const { return contents; }
+  int64_t getVersion() const { return version; }
+
+  /// Apply the `contentChanges` of a `textDocument/didChange` notification.
+  void update(const json::Array &changes, int64_t newVersion) {
+    for (const auto &change : changes) {
+      const auto *object = change.getAsObject();
+      if (!object)
+        continue;
+      auto text = object->getString("text");
+      if (!text)
+        continue;
+      const auto *range = object->getObject("range");
+      if (!range) {
+        contents = text->str();
+        continue;
+      }
+      LineTable lines(contents);
+      auto offset = [&](const char *key) {
+        const auto *position = range->getObject(key);
+        if (!position)
+          return contents.size();
+        return lines.offset(position->getInteger("line").value_or(0),
+                            position->getInteger("character").value_or(0));
+      };
+      const auto start = offset("start");
+      const auto end = std::max(start, offset("end"));
+      contents.replace(start, end - start, text->str());
+    }
+    version = newVersion;
+  }
+
+  /// Return the diagnostics of the document, re-analyzing only the top-level
+  /// operations whose text, or the aliases they see, changed.
+  json::Array analyze() {
+    // Uniqued attributes and types are never released by a context.
+    if (numParses > maxParsesPerContext) {
+      context = createContext(registry);
+      numParses = 0;
+    }
+
+    const LineTable lines(contents);
+    const auto layout = scanDocument(lines);
+    // Keyed on the parsed text itself, so that a hash collision cannot
+    // return the diagnostics of another unit.
+    std::unordered_map<std::string, std::vector<BufferDiagnostic>> analyzed;
+    auto diagnosticsOf =
+        [&](std::string unit) -> const std::vector<BufferDiagnostic> & {
+      if (auto iter = analyzed.find(unit); iter != analyzed.end())
+        return iter->second;
+      if (auto iter = cache.find(unit); iter != cache.end())
+        return analyzed.emplace(std::move(unit), std::move(iter->second))
+            .first->second;
+      ++numParses;
+      auto diagnostics = parseAndVerifyOperations(*context, unit);
+      return analyzed.emplace(std::move(unit), std::move(diagnostics))
+          .first->second;
+    };
+
+    std::vector<DocumentDiagnostic> result;
+    auto addDiagnostic = [&](const BufferDiagnostic &diagnostic,
+                             std::size_t line, std::size_t column) {
+      result.push_back(
+          {line, column, diagnostic.severity, diagnostic.message});
+    };
+    for (const auto &header : layout.headers) {
+      if (header.lines.empty())
+        continue;
+      for (const auto &diagnostic : diagnosticsOf(header.text)) {
+        if (diagnostic.line && *diagnostic.line < header.lines.size())
+          addDiagnostic(diagnostic, header.lines[*diagnostic.line],
+                        diagnostic.column);
+        else
+          addDiagnostic(diagnostic, header.lines.front(), 0);
+      }
+    }
+    for (const auto &segment : layout.segments) {
+      const auto &header = layout.headers[segment.split];
+      const auto text = lines.lines(segment.firstLine, segment.numLines);
+      for (const auto &diagnostic : diagnosticsOf(header.text + text.str())) {
+        // The diagnostics of the aliases are reported with the aliases.
+        if (diagnostic.line && *diagnostic.line < header.lines.size())
+          continue;
+        const auto line =
+            diagnostic.line ? *diagnostic.line - header.lines.size() : 0;
+        if (line < segment.numLines)
+          addDiagnostic(diagnostic, segment.firstLine + line,
+                        diagnostic.line ? diagnostic.column : 0);
+        else
+          addDiagnostic(diagnostic, segment.firstLine, 0);
+      }
+    }
+    cache = std::move(analyzed);
+    return toJSON(result, lines);
+  }
+
+private:
+  static constexpr std::size_t maxParsesPerContext = 10000;
+
+  const DialectRegistry &registry;
+  std::string contents;
+  int64_t version;
+  std::unique_ptr<MLIRContext> context;
+  std::size_t numParses = 0;
+  std::unordered_map<std::string, std::vector<BufferDiagnostic>> cache;
+};
+
+//===----------------------------------------------------------------------===//
+// Background verification
+//===----------------------------------------------------------------------===//
+
+/// Verify whole documents on a worker thread, once their edits pause.
+class BackgroundVerifier {
+public:
+  using PublishFn =
+      std::function<void(const std::string &, int64_t, json::Array)>;
+
+  BackgroundVerifier(const DialectRegistry &registry, PublishFn publish)
+      : registry(registry), publish(std::move(publish)),
+        worker([this] { run(); }) {}
+
+  ~BackgroundVerifier() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+      cancelled = true;
+    }
+    wakeUp.notify_all();
+    worker.join();
+  }
+
+  /// Schedule the verification of version `version` of a document. This
+  /// supersedes, and cancels, the verification of its previous versions.
+  void schedule(const std::string &uri, std::string contents,
+                int64_t version) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      latestVersions[uri] = version;
+      pending[uri] = {version, std::move(contents)};
+      if (running == uri)
+        cancelled = true;
+      ++numEdits;
+    }
+    wakeUp.notify_all();
+  }
+
+  /// Drop the pending verification of a closed document.
+  void close(const std::string &uri) {
+    std::lock_guard<std::mutex> lock(mutex);
+    latestVersions.erase(uri);
+    pending.erase(uri);
+    if (running == uri)
+      cancelled = true;
+  }
+
+private:
+  struct Job {
+    int64_t version;
+    std::string contents;
+  };
+
+  static constexpr std::chrono::milliseconds debounceDelay{300};
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      wakeUp.wait(lock, [&] { return stopping || !pending.empty(); });
+      if (stopping)
+        return;
+      // Wait for the edits to pause.
+      for (auto edits = numEdits;
+           wakeUp.wait_for(lock, debounceDelay,
+                           [&] { return stopping || numEdits != edits; });
+           edits = numEdits)
+        if (stopping)
+          return;
+      if (pending.empty())
+        continue;
+
+      auto node = pending.extract(pending.begin());
+      const auto &uri = node.key();
+      const auto job = std::move(node.mapped());
+      running = uri;
+      cancelled = false;
+      lock.unlock();
+      auto diagnostics = verify(job.contents);
+      lock.lock();
+      running.clear();
+      auto latest = latestVersions.find(uri);
+      if (!diagnostics || cancelled || latest == latestVersions.end() ||
+          latest->second != job.version)
+        continue;
+      // Published under the lock, so that it cannot overwrite the diagnostics
+      // of a newer version.
+      publish(uri, job.version, std::move(*diagnostics));
+    }
+  }
+
+  /// Verify each split of `contents` as a whole module.
+  std::optional<json::Array> verify(const std::string &contents) {
+    const LineTable lines(contents);
+    std::vector<DocumentDiagnostic> result;
+    std::size_t firstLine = 0;
+    for (std::size_t i = 0; i <= lines.numLines(); ++i) {
+      if (i < lines.numLines() && lines.line(i).trim() != splitMarker)
+        continue;
+      // A fresh context releases the attributes and types of the module.
+      auto context = createContext(registry);
+      auto diagnostics = parseAndVerifyModule(
+          *context, lines.lines(firstLine, i - firstLine), cancelled);
+      if (!diagnostics)
+        return std::nullopt;
+      for (auto &diagnostic : *diagnostics)
+        result.push_back({firstLine + diagnostic.line.value_or(0),
+                          diagnostic.column, diagnostic.severity,
+                          std::move(diagnostic.message)});
+      firstLine = i + 1;
+    }
+    return toJSON(result, lines);
+  }
+
+  const DialectRegistry &registry;
+  PublishFn publish;
+  std::mutex mutex;
+  std::condition_variable wakeUp;
+  std::map<std::string, Job> pending;
+  std::map<std::string, int64_t> latestVersions;
+  std::string running;
+  std::atomic<bool> cancelled = false;
+  std::size_t numEdits = 0;
+  bool stopping = false;
+  // Last, so that the worker starts once the other members are initialized.
+  std::thread worker;
+};
+
+//===----------------------------------------------------------------------===//
+// Server
+//===----------------------------------------------------------------------===//
+
+/// Read a message of the LSP base protocol, or return std::nullopt at the end
+/// of the input.
+std::optional<std::string> readMessage(std::istream &in) {
+  std::size_t contentLength = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    llvm::StringRef header = llvm::StringRef(line).rtrim('\r');
+    if (header.empty()) {
+      if (contentLength > 0)
+        break;
+      continue;
+    }
+    if (header.consume_front_insensitive("content-length:"))
+      (void)header.trim().getAsInteger(10, contentLength);
+  }
+  if (!in || contentLength == 0)
+    return std::nullopt;
+  std::string content(contentLength, '\0');
+  in.read(content.data(), contentLength);
+  if (static_cast<std::size_t>(in.gcount()) != contentLength)
+    return std::nullopt;
+  return content;
+}
+
+/// Read a message delimited by a `// -----` line, as in the lit tests of the
+/// MLIR language servers, skipping the other comment lines. Return
+/// std::nullopt at the end of the input.
+std::optional<std::string> readDelimitedMessage(std::istream &in) {
+  std::string content;
+  std::string line;
+  while (std::getline(in, line)) {
+    const auto trimmed = llvm::StringRef(line).trim();
+    if (trimmed == splitMarker && !llvm::StringRef(content).trim().empty())
+      return content;
+    if (!trimmed.starts_with("//"))
+      content.append(line).push_back('\n');
+  }
+  if (llvm::StringRef(content).trim().empty())
+    return std::nullopt;
+  return content;
+}
+
+class IncrementalServer {
+public:
+  IncrementalServer(const DialectRegistry &registry, bool litTest)
+      : registry(registry), litTest(litTest),
+        verifier(registry,
+                 [this](const std::string &uri, int64_t version,
+                        json::Array diagnostics) {
+                   publishDiagnostics(uri, version, std::move(diagnostics));
+                 }) {}
+
+  int run() {
+    while (auto content = litTest ? readDelimitedMessage(std::cin)
+                                  : readMessage(std::cin)) {
+      auto message = json::parse(*content);
+      if (!message) {
+        llvm::consumeError(message.takeError());
+        send(json::Object{
+            {"jsonrpc", "2.0"},
+            {"id", nullptr},
+            {"error", json::Object{{"code", -32700},
+                                   {"message", "Parse error"}}}});
+        continue;
+      }
+      if (auto *object = message->getAsObject())
+        if (handleMessage(*object))
+          return shutdownRequested ? 0 : 1;
+    }
+    return 1;
+  }
+
+private:
+  /// Handle a request or notification, and return true on `exit`.
+  bool handleMessage(const json::Object &message) {
+    const auto method = message.getString("method").value_or("");
+    const auto *id = message.get("id");
+    const auto *params = message.getObject("params");
+
+    if (method == "exit")
+      return true;
+    if (id) {
+      if (method == "initialize")
+        reply(*id, json::Object{
+                       {"capabilities",
+                        json::Object{{"textDocumentSync",
+                                      json::Object{{"openClose", true},
+                                                   // Incremental changes.
+                                                   {"change", 2}}}}},
+                       {"serverInfo",
+                        json::Object{{"name", "cudaq-lsp-server"}}}});
+      else if (method == "shutdown") {
+        shutdownRequested = true;
+        reply(*id, nullptr);
+      } else if (!method.empty())
+        send(json::Object{
+            {"jsonrpc", "2.0"},
+            {"id", *id},
+            {"error", json::Object{{"code", -32601},
+                                   {"message", "Method not found: " +
+                                                   method.str()}}}});
+      return false;
+    }
+    if (!params)
+      return false;
+
+    const auto *textDocument = params->getObject("textDocument");
+    if (!textDocument)
+      return false;
+    const auto uri = textDocument->getString("uri");
+    if (!uri)
+      return false;
+    const auto version = textDocument->getInteger("version").value_or(0);
+    if (method == "textDocument/didOpen") {
+      auto &document = documents[uri->str()];
+      document = std::make_unique<Document>(
+          registry, textDocument->getString("text").value_or("").str(),
+          version);
+      analyze(uri->str(), *document);
+    } else if (method == "textDocument/didChange") {
+      auto iter = documents.find(uri->str());
+      const auto *changes = params->getArray("contentChanges");
+      if (iter == documents.end() || !changes)
+        return false;
+      iter->second->update(*changes, version);
+      analyze(uri->str(), *iter->second);
+    } else if (method == "textDocument/didClose") {
+      documents.erase(uri->str());
+      verifier.close(uri->str());
+      publishDiagnostics(uri->str(), std::nullopt, json::Array());
+    }
+    return false;
+  }
+
+  void analyze(const std::string &uri, Document &document) {
+    auto diagnostics = document.analyze();
+    // Scheduling the verification first makes it drop the result of any
+    // previous version, which must not overwrite these diagnostics.
+    verifier.schedule(uri, document.getContents(), document.getVersion());
+    publishDiagnostics(uri, document.getVersion(), std::move(diagnostics));
+  }
+
+  void publishDiagnostics(const std::string &uri,
+                          std::optional<int64_t> version,
+                          json::Array diagnostics) {
+    json::Object params{{"uri", uri}, {"diagnostics", std::move(diagnostics)}};
+    if (version)
+      params["version"] = *version;
+    send(json::Object{{"jsonrpc", "2.0"},
+                      {"method", "textDocument/publishDiagnostics"},
+                      {"params", std::move(params)}});
+  }
+
+  void reply(const json::Value &id, json::Value result) {
+    send(json::Object{
+        {"jsonrpc", "2.0"}, {"id", id}, {"result", std::move(result)}});
+  }
+
+  void send(json::Value message) {
+    std::string content;
+    llvm::raw_string_ostream os(content);
+    // Lit tests check the messages line by line.
+    if (litTest)
+      os << llvm::formatv("{0:2}", message);
+    else
+      os << message;
+    os.flush();
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::cout << "Content-Length: " << content.size() << "\r\n\r\n"
+              << content << std::flush;
+  }
+
+  const DialectRegistry &registry;
+  const bool litTest;
+  std::mutex outputMutex;
+  std::map<std::string, std::unique_ptr<Document>> documents;
+  bool shutdownRequested = false;
+  // Last, so that its worker is stopped before the other members go away.
+  BackgroundVerifier verifier;
+};
+
+} // namespace
+
+int cudaq::lsp::runIncrementalServer(const DialectRegistry &registry,
+                                     bool litTest) {
+  IncrementalServer server(registry, litTest);
+  return server.run();
+}
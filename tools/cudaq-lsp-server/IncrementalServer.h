@@ -0,0 +1,35 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+namespace mlir {
+class DialectRegistry;
+}
+
+namespace cudaq::lsp {
+
+/// @brief Run a language server over stdin and stdout that publishes the
+/// diagnostics of Quake/MLIR documents, and re-analyzes only the top-level
+/// operations (e.g., the functions) a change touches.
+///
+/// Each top-level operation is parsed and verified on its own, together with
+/// the alias definitions of the document, and the diagnostics of the unchanged
+/// ones are reused. The whole document, including the symbol uses between
+/// functions, is then verified on a background thread once the edits pause,
+/// and that verification is abandoned as soon as a new edit comes in.
+///
+/// Unlike the default server, this server only provides diagnostics, as
+/// needed for large generated modules.
+///
+/// With `litTest`, the messages are read delimited by `// -----` lines rather
+/// than by their content length, and written pretty-printed, for lit tests.
+int runIncrementalServer(const mlir::DialectRegistry &registry,
+                         bool litTest = false);
+
+} // namespace cudaq::lsp
@@ -6,11 +6,14 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 
+#include "IncrementalServer.h"
 #include "cudaq/Optimizer/InitAllDialects.h"
+#include "llvm/ADT/StringRef.h"
 #include "mlir/IR/Dialect.h"
 #include "mlir/IR/MLIRContext.h"
 #include "mlir/InitAllDialects.h"
 #include "mlir/Tools/mlir-lsp-server/MlirLspServerMain.h"
+#include <algorithm>
 
 using namespace mlir;
 
@@ -18,5 +21,15 @@ int main(int argc, char **argv) {
   DialectRegistry registry;
   mlir::registerAllDialects(registry);
   cudaq::registerAllDialects(registry);
+
+  // `--incremental` selects the diagnostics-only server for large modules. It
+  // is handled here, since MlirLspServerMain rejects unknown options.
+  auto hasOption = [&](llvm::StringRef name) {
+    return std::any_of(argv + 1, argv + argc, [&](const char *arg) {
+      return llvm::StringRef(arg).ltrim('-') == name;
+    });
+  };
+  if (hasOption("incremental"))
+    return cudaq::lsp::runIncrementalServer(registry, hasOption("lit-test"));
   return failed(MlirLspServerMain(argc, argv, registry));
 }
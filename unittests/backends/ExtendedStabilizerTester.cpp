@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "ExtendedStabilizer.h"
+#include <gtest/gtest.h>
+#include <map>
+
+using namespace nvqir::extstab;
+
+namespace {
+
+/// Reference implementation: apply the single-qubit gate `matrix` on `target`
+/// with `controls` to a dense state, qubit `j` being bit `j` of the index.
+void applyReference(std::vector<complex> &state,
+                    const std::vector<complex> &matrix,
+                    const std::vector<std::size_t> &controls,
+                    std::size_t target) {
+  for (std::size_t i = 0; i < state.size(); ++i) {
+    if ((i >> target) & 1 ||
+        !std::all_of(controls.begin(), controls.end(),
+                     [&](std::size_t c) { return (i >> c) & 1; }))
+      continue;
+    const std::size_t j = i | (1ULL << target);
+    const complex a = state[i], b = state[j];
+    state[i] = matrix[0] * a + matrix[1] * b;
+    state[j] = matrix[2] * a + matrix[3] * b;
+  }
+}
+
+/// The fidelity of the two (unnormalized) states.
+double fidelity(const StabilizerSum &sum, const std::vector<complex> &state) {
+  complex overlap = 0.;
+  double norm = 0., sumNorm = 0.;
+  for (std::size_t i = 0; i < state.size(); ++i) {
+    const complex a = sum.amplitude({i}).first;
+    overlap += std::conj(state[i]) * a;
+    norm += std::norm(state[i]);
+    sumNorm += std::norm(a);
+  }
+  return std::abs(overlap) / std::sqrt(norm * sumNorm);
+}
+
+} // namespace
+
+TEST(ExtendedStabilizerTester, checkCliffordState) {
+  // (|000> + i |111>) / sqrt(2) is a single stabilizer state.
+  StabilizerSum sum(3);
+  sum.apply(CliffordSum::of({{CliffordGate::H, 0},
+                             {CliffordGate::S, 0},
+                             {CliffordGate::CX, 0, 1},
+                             {CliffordGate::CX, 1, 2}}),
+            1);
+  EXPECT_EQ(sum.size(), 1);
+  EXPECT_NEAR(std::abs(sum.amplitude({0b000}).first - M_SQRT1_2), 0., 1e-12);
+  EXPECT_NEAR(std::abs(sum.amplitude({0b111}).first - complex(0, M_SQRT1_2)),
+              0., 1e-12);
+  EXPECT_NEAR(std::abs(sum.amplitude({0b101}).first), 0., 1e-12);
+
+  // Samples of a single stabilizer state are exact.
+  std::mt19937_64 rng(13);
+  for (const auto &x : sum.sample(100, 0, rng))
+    EXPECT_TRUE(x[0] == 0b000 || x[0] == 0b111);
+}
+
+TEST(ExtendedStabilizerTester, checkRandomCircuits) {
+  constexpr std::size_t numQubits = 4;
+  const std::vector<complex> hadamard{M_SQRT1_2, M_SQRT1_2, M_SQRT1_2,
+                                      -M_SQRT1_2};
+  std::mt19937_64 rng(7);
+  std::uniform_real_distribution<double> angle(0., 2 * M_PI);
+  for (int trial = 0; trial < 50; ++trial) {
+    StabilizerSum sum(numQubits);
+    std::vector<complex> state(1ULL << numQubits, 0.);
+    state[0] = 1.;
+    for (int gate = 0; gate < 30; ++gate) {
+      const std::size_t target = rng() % numQubits;
+      std::vector<std::size_t> controls;
+      for (std::size_t q = 0; q < numQubits; ++q)
+        if (q != target && controls.size() < trial % 3 && rng() % 2)
+          controls.push_back(q);
+      std::vector<complex> matrix = hadamard;
+      if (gate % 2) {
+        // A random (generally non-Clifford) unitary.
+        const double theta = angle(rng), phi = angle(rng), lambda = angle(rng);
+        matrix = {std::cos(theta / 2), -std::polar(std::sin(theta / 2), lambda),
+                  std::polar(std::sin(theta / 2), phi),
+                  std::polar(std::cos(theta / 2), phi + lambda)};
+      }
+      applyReference(state, matrix, controls, target);
+      sum.apply(controlled(singleQubitGate(matrix, target), controls),
+                1 << 20);
+    }
+    EXPECT_NEAR(fidelity(sum, state), 1., 1e-9);
+
+    // Projections are not renormalized, which the fidelity ignores.
+    const std::size_t qubit = trial % numQubits;
+    double probOne = 0.;
+    for (std::size_t i = 0; i < state.size(); ++i)
+      if ((i >> qubit) & 1)
+        probOne += std::norm(state[i]);
+    const bool outcome = probOne > 0.5;
+    for (std::size_t i = 0; i < state.size(); ++i)
+      if (((i >> qubit) & 1) != outcome)
+        state[i] = 0.;
+    sum.project(qubit, outcome);
+    EXPECT_NEAR(fidelity(sum, state), 1., 1e-9);
+  }
+}
+
+TEST(ExtendedStabilizerTester, checkTGateBranches) {
+  // T = diag(1, e^{i pi / 4}) splits each term in two, while multiples of
+  // pi / 2 are Clifford, and terms equal up to their coefficient are merged.
+  StabilizerSum sum(2);
+  sum.apply(CliffordSum::of({{CliffordGate::H, 0}, {CliffordGate::H, 1}}), 1);
+  sum.apply(phaseGate(M_PI / 4, 0), 2);
+  EXPECT_EQ(sum.size(), 2);
+  sum.apply(phaseGate(M_PI / 2, 0), 2);
+  EXPECT_EQ(sum.size(), 2);
+  sum.apply(phaseGate(0.1, 0), 2);
+  EXPECT_EQ(sum.size(), 2);
+  EXPECT_ANY_THROW(sum.apply(phaseGate(M_PI / 4, 1), 3));
+}
+
+TEST(ExtendedStabilizerTester, checkSamplingDistribution) {
+  // H T H on qubit 0 of a 3-qubit GHZ-like state gives
+  // P(0) = cos^2(pi / 8) on qubit 0, which then sets the other qubits.
+  StabilizerSum sum(3);
+  sum.apply(CliffordSum::of({{CliffordGate::H, 0}}), 1);
+  sum.apply(phaseGate(M_PI / 4, 0), 2);
+  sum.apply(CliffordSum::of({{CliffordGate::H, 0},
+                             {CliffordGate::CX, 0, 1},
+                             {CliffordGate::CX, 0, 2}}),
+            2);
+  std::mt19937_64 rng(11);
+  constexpr std::size_t numSamples = 20000;
+  std::map<std::uint64_t, std::size_t> counts;
+  for (const auto &x : sum.sample(numSamples, 100, rng))
+    ++counts[x[0]];
+  EXPECT_EQ(counts.size(), 2);
+  EXPECT_NEAR(static_cast<double>(counts[0b000]) / numSamples,
+              std::pow(std::cos(M_PI / 8), 2), 0.02);
+}
+
+CUDAQ_TEST(ExtendedStabilizerTester, checkWideSample) {
+  // A GHZ state on far more qubits than a state vector could hold, rotated
+  // by a few T gates on its first qubit.
+  auto kernel = [](int n) __qpu__ {
+    cudaq::qvector q(n);
+    h(q[0]);
+    t(q[0]);
+    h(q[0]);
+    for (int i = 0; i < n - 1; ++i)
+      x<cudaq::ctrl>(q[i], q[i + 1]);
+    mz(q);
+  };
+  constexpr int numQubits = 120;
+  cudaq::set_random_seed(13);
+  auto counts = cudaq::sample(5000, kernel, numQubits);
+  EXPECT_EQ(counts.size(), 2);
+  EXPECT_NEAR(counts.probability(std::string(numQubits, '0')),
+              std::pow(std::cos(M_PI / 8), 2), 0.03);
+
+  auto toffoli = []() __qpu__ {
+    cudaq::qvector q(3);
+    x(q[0]);
+    x(q[1]);
+    x<cudaq::ctrl>(q[0], q[1], q[2]);
+    mz(q);
+  };
+  counts = cudaq::sample(100, toffoli);
+  EXPECT_EQ(counts.size(), 1);
+  EXPECT_EQ(counts.most_probable(), "111");
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "PauliPropagation.h"
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace nvqir::pauliprop;
+
+namespace {
+
+const std::vector<complex> hadamard{M_SQRT1_2, M_SQRT1_2, M_SQRT1_2,
+                                    -M_SQRT1_2};
+const std::vector<complex> cnot{1, 0, 0, 0, 0, 1, 0, 0,
+                                0, 0, 0, 1, 0, 0, 1, 0};
+
+std::vector<complex> rx(double theta) {
+  const complex c = std::cos(theta / 2), s{0, -std::sin(theta / 2)};
+  return {c, s, s, c};
+}
+
+} // namespace
+
+TEST(PauliPropagationTester, checkCliffordDoesNotBranch) {
+  TransferMap h(hadamard, 1), cx(cnot, 2);
+  EXPECT_FALSE(h.isBranching());
+  EXPECT_FALSE(cx.isBranching());
+  EXPECT_TRUE(TransferMap(rx(0.3), 1).isBranching());
+
+  // On the Bell state (H 0; CX 0 1), Z_0 Z_1 propagates back to Z_1, whose
+  // expectation value is 1, and Z_1 to X_0 Z_1, whose expectation value is 0.
+  PauliSum sum(2);
+  sum.addTerm("ZZ", 0.5);
+  sum.addTerm("IZ", 2.);
+  sum.conjugate({0, 1}, cx, {});
+  sum.conjugate({0}, h, {});
+  EXPECT_EQ(sum.size(), 2);
+  EXPECT_NEAR(sum.expectationOnZeroState(), 0.5, 1e-12);
+}
+
+TEST(PauliPropagationTester, checkRotation) {
+  for (double theta : {0., 0.3, 1.2, M_PI}) {
+    PauliSum sum(1);
+    sum.addTerm("Z", 1.);
+    sum.conjugate({0}, TransferMap(rx(theta), 1), {});
+    EXPECT_NEAR(sum.expectationOnZeroState(), std::cos(theta), 1e-12);
+  }
+}
+
+TEST(PauliPropagationTester, checkTruncation) {
+  // Z_1 grows into Z_0 Z_1 through a CNOT, beyond a maximum weight of 1.
+  const TransferMap cx(cnot, 2);
+  PauliSum heavy(2);
+  heavy.addTerm("IZ", 1.);
+  heavy.conjugate({0, 1}, cx, {0., 1});
+  EXPECT_EQ(heavy.size(), 0);
+
+  // Rx rotations on both qubits split Z_0 Z_1 into four terms, with
+  // coefficients cos^2 ~ 0.58, cos sin ~ 0.49 (twice) and sin^2 ~ 0.42.
+  const TransferMap rotation(rx(0.7), 1);
+  PauliSum full(2), large(2);
+  for (auto *sum : {&full, &large}) {
+    sum->addTerm("ZZ", 1.);
+    sum->conjugate({0}, rotation, {});
+  }
+  full.conjugate({1}, rotation, {});
+  large.conjugate({1}, rotation, {0.5, 0});
+  EXPECT_EQ(full.size(), 4);
+  EXPECT_EQ(large.size(), 1);
+  EXPECT_NEAR(full.expectationOnZeroState(), std::pow(std::cos(0.7), 2),
+              1e-12);
+  EXPECT_NEAR(large.expectationOnZeroState(), std::pow(std::cos(0.7), 2),
+              1e-12);
+}
+
+TEST(PauliPropagationTester, checkWideSum) {
+  // Strings span several 64-bit words. Z_0 Z_64 Z_129 reduces to Z_0 through
+  // the CNOTs, which a final H turns into X_0.
+  constexpr std::size_t numQubits = 130;
+  PauliSum sum(numQubits);
+  std::string paulis(numQubits, 'I');
+  paulis[0] = paulis[64] = paulis[129] = 'Z';
+  sum.addTerm(paulis, 1.);
+  const TransferMap cx(cnot, 2);
+  PauliSum rotated = sum;
+  for (auto *s : {&sum, &rotated}) {
+    s->conjugate({129, 64}, cx, {});
+    s->conjugate({64, 0}, cx, {});
+  }
+  EXPECT_NEAR(sum.expectationOnZeroState(), 1., 1e-12);
+  rotated.conjugate({0}, TransferMap(hadamard, 1), {});
+  EXPECT_EQ(rotated.size(), 1);
+  EXPECT_NEAR(rotated.expectationOnZeroState(), 0., 1e-12);
+}
+
+CUDAQ_TEST(PauliPropagationTester, checkObserve) {
+  auto kernel = [](double theta, int n) __qpu__ {
+    cudaq::qvector q(n);
+    h(q[0]);
+    for (int i = 0; i < n - 1; ++i)
+      x<cudaq::ctrl>(q[i], q[i + 1]);
+    rx(theta, q[n - 1]);
+  };
+
+  // Far too wide for a state vector.
+  constexpr int numQubits = 200;
+  const double theta = 0.4;
+  auto op = cudaq::spin_op::z(0) * cudaq::spin_op::z(numQubits - 1) +
+            0.5 * cudaq::spin_op::x(3);
+  auto result = cudaq::observe(kernel, op, theta, numQubits);
+  EXPECT_NEAR(result.expectation(), std::cos(theta), 1e-9);
+
+  // Shots do not change the value.
+  result = cudaq::observe(1000, kernel, op, theta, numQubits);
+  EXPECT_NEAR(result.expectation(), std::cos(theta), 1e-9);
+
+  auto sampled = [](double theta, int n) __qpu__ {
+    cudaq::qvector q(n);
+    rx(theta, q[0]);
+    mz(q);
+  };
+  EXPECT_ANY_THROW(cudaq::sample(sampled, theta, 2));
+}
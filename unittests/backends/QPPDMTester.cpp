@@ -121,3 +121,50 @@ CUDAQ_TEST(QPPTester, checkDensityOrderingBug) {
     EXPECT_EQ(0, qppBackend.mz(q3));
   }
 }
+
+// The Pauli channels are applied without going through their Kraus operators;
+// check that the result matches the Kraus sum.
+CUDAQ_TEST(QPPTester, checkPauliChannelFastPath) {
+  const int numQubits = 3;
+  qpp::cmat random = qpp::rand<qpp::cmat>(1 << numQubits, 1 << numQubits);
+  qpp::cmat rho = random * random.adjoint();
+  rho /= rho.trace();
+
+  std::vector<cudaq::kraus_channel> channels = {
+      cudaq::bit_flip_channel(0.1),
+      cudaq::phase_flip_channel(0.2),
+      cudaq::x_error(0.15),
+      cudaq::y_error(0.3),
+      cudaq::z_error(0.05),
+      cudaq::depolarization_channel(0.4),
+      cudaq::depolarization1(0.7),
+      cudaq::pauli1(std::vector<cudaq::real>{0.1, 0.2, 0.3}),
+      cudaq::depolarization2(0.3),
+      cudaq::pauli2(std::vector<cudaq::real>{0.01, 0.02, 0.03, 0.04, 0.05,
+                                             0.06, 0.07, 0.08, 0.09, 0.1, 0.011,
+                                             0.012, 0.013, 0.014, 0.015})};
+  for (auto &channel : channels) {
+    auto pauli = getPauliChannel(channel);
+    ASSERT_TRUE(pauli.has_value()) << channel.get_type_name();
+    std::vector<std::vector<std::size_t>> targetSets = {{0}, {1}, {2}};
+    if (pauli->numQubits == 2)
+      targetSets = {{0, 1}, {2, 0}, {1, 2}};
+
+    std::vector<qpp::cmat> krausOps;
+    for (auto &op : channel.get_ops())
+      krausOps.push_back(
+          Eigen::Map<Eigen::Matrix<std::complex<double>, Eigen::Dynamic,
+                                   Eigen::Dynamic, Eigen::RowMajor>>(
+              op.data.data(), op.nRows, op.nCols));
+    for (auto &targets : targetSets) {
+      qpp::cmat expected = qpp::apply(rho, krausOps, targets);
+      qpp::cmat got = rho;
+      applyPauliChannel(got, *pauli, targets);
+      EXPECT_NEAR((expected - got).norm(), 0., 1e-12)
+          << channel.get_type_name();
+    }
+  }
+
+  EXPECT_FALSE(getPauliChannel(cudaq::amplitude_damping_channel(0.1)));
+  EXPECT_FALSE(getPauliChannel(cudaq::phase_damping(0.1)));
+}
@@ -1228,3 +1228,295 @@ CUDAQ_TEST(QPPTester, checkReset) {
     EXPECT_EQ(1, qppBackend.mz(q1));
   }
 }
+
+// Checks that fusing gates into dense blocks yields the same state as applying
+// the gates one by one.
+CUDAQ_TEST(QPPTester, checkGateFusion) {
+  auto applyCircuit = [](QppSimulator &qppBackend) {
+    auto q = qppBackend.allocateQubits(5);
+    for (std::size_t layer = 0; layer < 3; ++layer) {
+      for (std::size_t i = 0; i < q.size(); ++i) {
+        qppBackend.h(q[i]);
+        qppBackend.ry(0.1 * (i + 1) + layer, q[i]);
+      }
+      for (std::size_t i = 0; i + 1 < q.size(); ++i)
+        qppBackend.x({q[i]}, q[i + 1]);
+      qppBackend.u3(0.3, 0.5, 0.7, {q[0], q[2]}, q[4]);
+      qppBackend.swap(q[1], q[3]);
+      qppBackend.rz(0.25 * layer, q[2]);
+      qppBackend.t(q[3]);
+    }
+    // Non-symmetric two-qubit custom operation to check matrix ordering.
+    std::vector<std::complex<double>> matrix(16, 0.0);
+    matrix[0] = 1.0;
+    matrix[1 * 4 + 3] = 1.0;
+    matrix[2 * 4 + 1] = 1.0;
+    matrix[3 * 4 + 2] = 1.0;
+    qppBackend.applyCustomOperation(matrix, {}, {q[0], q[3]}, "perm");
+    qppBackend.rx(0.9, q[1]);
+  };
+
+  QppSimulator reference;
+  applyCircuit(reference);
+  qpp::ket want_state = reference.getStateVector();
+
+  for (std::size_t maxQubits : {2, 3, 4, 5}) {
+    QppSimulator fused;
+    fused.setGateFusionMaxQubits(maxQubits);
+    applyCircuit(fused);
+    qpp::ket got_state = fused.getStateVector();
+    EXPECT_EQ_KETS(want_state, got_state);
+  }
+}
+
+CUDAQ_TEST(QPPTester, checkDiagonalGateRuns) {
+  auto applyCircuit = [](QppSimulator &qppBackend) {
+    auto q = qppBackend.allocateQubits(5);
+    for (std::size_t i = 0; i < q.size(); ++i)
+      qppBackend.h(q[i]);
+    for (std::size_t layer = 0; layer < 2; ++layer) {
+      // QAOA cost layer, with rzz as CNOT-RZ-CNOT.
+      for (std::size_t i = 0; i < q.size(); ++i) {
+        const auto j = (i + 2) % q.size();
+        qppBackend.x({q[i]}, q[j]);
+        qppBackend.rz(0.3 * (i + 1) + layer, q[j]);
+        qppBackend.x({q[i]}, q[j]);
+      }
+      qppBackend.rz(0.7, {q[0]}, q[3]);
+      qppBackend.r1(0.4, {q[1], q[2]}, q[4]);
+      qppBackend.t(q[2]);
+      qppBackend.s(q[0]);
+      // Mixer layer, which ends the runs.
+      for (std::size_t i = 0; i < q.size(); ++i)
+        qppBackend.rx(0.2 * (i + 1), q[i]);
+    }
+    // A run whose CNOT, X and SWAP gates do not cancel out.
+    qppBackend.x({q[0]}, q[1]);
+    qppBackend.z(q[1]);
+    qppBackend.x(q[2]);
+    qppBackend.rz(0.9, q[2]);
+    qppBackend.swap(q[3], q[4]);
+    qppBackend.rz(0.5, {q[1]}, q[3]);
+    // A non-symmetric diagonal custom operation to check matrix ordering.
+    std::vector<std::complex<double>> matrix(16, 0.0);
+    for (std::size_t r = 0; r < 4; ++r)
+      matrix[r * 4 + r] = std::polar(1.0, 0.3 * r * r);
+    qppBackend.applyCustomOperation(matrix, {}, {q[0], q[3]}, "phases");
+    qppBackend.h(q[4]);
+  };
+
+  QppSimulator reference;
+  applyCircuit(reference);
+  qpp::ket want_state = reference.getStateVector();
+
+  QppSimulator accumulated;
+  accumulated.setAccumulateDiagonalGates(true);
+  applyCircuit(accumulated);
+  qpp::ket got_state = accumulated.getStateVector();
+  EXPECT_EQ_KETS(want_state, got_state);
+}
+
+CUDAQ_TEST(QPPTester, checkGlobalQubitExchanges) {
+  auto applyCircuit = [](QppSimulator &qppBackend) {
+    auto q = qppBackend.allocateQubits(6);
+    for (std::size_t layer = 0; layer < 4; ++layer) {
+      for (std::size_t i = 0; i < q.size(); ++i) {
+        qppBackend.h(q[i]);
+        qppBackend.ry(0.1 * (i + 1) + layer, q[i]);
+      }
+      for (std::size_t i = 0; i + 1 < q.size(); ++i)
+        qppBackend.x({q[i]}, q[i + 1]);
+      qppBackend.u3(0.3, 0.5, 0.7, {q[5]}, q[0]);
+      qppBackend.swap(q[1], q[4]);
+      qppBackend.rz(0.25 * layer, q[5]);
+    }
+    return qppBackend.getStateVector();
+  };
+
+  QppSimulator reference;
+  qpp::ket want_state = applyCircuit(reference);
+  EXPECT_EQ(reference.numQubitExchanges, 0);
+
+  for (std::size_t numLocalQubits : {2, 3, 5}) {
+    QppSimulator distributed;
+    distributed.setNumLocalQubits(numLocalQubits);
+    qpp::ket got_state = applyCircuit(distributed);
+    EXPECT_EQ_KETS(want_state, got_state);
+    // All 80 gates target local qubits, with exchanges batched across gates.
+    EXPECT_EQ(distributed.numGlobalTargets, 0);
+    EXPECT_GT(distributed.numQubitExchanges, 0);
+    EXPECT_LE(distributed.numQubitExchanges, 40);
+  }
+}
+
+CUDAQ_TEST(QPPTester, checkStateCheckpointRestore) {
+  const std::string checkpointFile =
+      testing::TempDir() + "qpp_state_checkpoint.bin";
+  auto applyLayers = [](QppSimulator &qppBackend,
+                        const std::vector<std::size_t> &q, std::size_t begin,
+                        std::size_t end) {
+    for (std::size_t layer = begin; layer < end; ++layer) {
+      for (std::size_t i = 0; i < q.size(); ++i)
+        qppBackend.ry(0.2 * (i + 1) + layer, q[i]);
+      for (std::size_t i = 0; i + 1 < q.size(); ++i)
+        qppBackend.x({q[i]}, q[i + 1]);
+      // Flush at every layer boundary (9 gates), as a measurement would.
+      qppBackend.flushGateQueue();
+    }
+  };
+
+  qpp::ket want_state;
+  setenv("CUDAQ_CHECKPOINT_FILE", checkpointFile.c_str(), 1);
+  setenv("CUDAQ_CHECKPOINT_INTERVAL", "20", 1);
+  {
+    // The state is checkpointed after 27 gates, and not again at 36.
+    QppSimulator qppBackend;
+    auto q = qppBackend.allocateQubits(5);
+    applyLayers(qppBackend, q, 0, 3);
+    want_state = qppBackend.getStateVector();
+    applyLayers(qppBackend, q, 3, 4);
+  }
+  unsetenv("CUDAQ_CHECKPOINT_FILE");
+  unsetenv("CUDAQ_CHECKPOINT_INTERVAL");
+
+  setenv("CUDAQ_RESTORE_CHECKPOINT", checkpointFile.c_str(), 1);
+  {
+    // The gates up to the checkpoint are skipped, whatever they are.
+    QppSimulator qppBackend;
+    auto q = qppBackend.allocateQubits(5);
+    for (std::size_t i = 0; i < 27; ++i)
+      qppBackend.h(q[i % 5]);
+    qpp::ket got_state = qppBackend.getStateVector();
+    EXPECT_EQ_KETS(want_state, got_state);
+  }
+  {
+    QppSimulator qppBackend;
+    auto q = qppBackend.allocateQubits(5);
+    applyLayers(qppBackend, q, 0, 1);
+    EXPECT_ANY_THROW(qppBackend.mz(q[0]));
+  }
+  {
+    QppSimulator qppBackend;
+    auto q = qppBackend.allocateQubits(4);
+    EXPECT_ANY_THROW(applyLayers(qppBackend, q, 0, 4));
+  }
+  unsetenv("CUDAQ_RESTORE_CHECKPOINT");
+  std::remove(checkpointFile.c_str());
+}
+
+// Checks that measuring a qubit collapses and renormalizes the state.
+CUDAQ_TEST(QPPTester, checkMeasureCollapse) {
+  for (std::size_t seed = 1; seed <= 8; ++seed) {
+    QppSimulator qppBackend;
+    qppBackend.setRandomSeed(seed);
+    auto q0 = qppBackend.allocateQubit();
+    auto q1 = qppBackend.allocateQubit();
+    auto q2 = qppBackend.allocateQubit();
+    qppBackend.h(q0);
+    qppBackend.x({q0}, q1);
+    qppBackend.h(q2);
+    const bool result = qppBackend.mz(q1);
+
+    // The GHZ-like pair collapses, q2 stays in |+>.
+    const std::size_t pair = result ? 0b011 : 0b000;
+    qpp::ket want_state = qpp::ket::Zero(8);
+    want_state(pair) = M_SQRT1_2;
+    want_state(pair | 0b100) = M_SQRT1_2;
+    qpp::ket got_state = qppBackend.getStateVector();
+    EXPECT_EQ_KETS(want_state, got_state);
+    EXPECT_EQ(result, qppBackend.mz(q0));
+  }
+}
+
+CUDAQ_TEST(QPPTester, checkNumThreadsEnvVar) {
+  setenv("CUDAQ_QPP_NUM_THREADS", "0", 1);
+  EXPECT_ANY_THROW({ QppSimulator qppBackend; });
+  setenv("CUDAQ_QPP_NUM_THREADS", "2", 1);
+  {
+    QppSimulator qppBackend;
+    auto q = qppBackend.allocateQubits(2);
+    qppBackend.x(q[0]);
+    EXPECT_EQ(qppBackend.getSampledBitString({0, 1}), "10");
+  }
+  unsetenv("CUDAQ_QPP_NUM_THREADS");
+}
+
+// Checks that the alias table draws outcomes with their probabilities and
+// reproducibly for a given seed.
+CUDAQ_TEST(QPPTester, checkAliasTable) {
+  const std::vector<double> weights = {0.1, 0.0, 0.5, 0.2, 0.2};
+  AliasTable table(weights);
+  EXPECT_EQ(table.size(), weights.size());
+  std::mt19937 engine(5);
+  const std::size_t shots = 200000;
+  const auto outcomes = table.sample(shots, engine);
+  ASSERT_EQ(outcomes.size(), shots);
+  std::vector<std::size_t> counts(weights.size(), 0);
+  for (auto outcome : outcomes)
+    ++counts[outcome];
+  for (std::size_t i = 0; i < weights.size(); ++i)
+    EXPECT_NEAR(counts[i] / (double)shots, weights[i], 0.01);
+  EXPECT_EQ(counts[1], 0);
+
+  std::mt19937 sameEngine(5);
+  EXPECT_EQ(table.sample(shots, sameEngine), outcomes);
+  EXPECT_ANY_THROW(AliasTable({0.0, 0.0}));
+}
+
+// Checks that sampling draws the shots from the marginal distribution of the
+// measured qubits, in the order they are given.
+CUDAQ_TEST(QPPTester, checkSampleMarginal) {
+  QppSimulator qppBackend;
+  qppBackend.setRandomSeed(13);
+  auto q = qppBackend.allocateQubits(3);
+  // q0 is |1>, q1 is |+> and q2 is Ry(pi/3)|0>, i.e., 1 with probability 1/4.
+  qppBackend.x(q[0]);
+  qppBackend.h(q[1]);
+  qppBackend.ry(M_PI / 3, q[2]);
+  qppBackend.getStateVector();
+
+  const int shots = 100000;
+  auto result = qppBackend.sample({2, 0}, shots);
+  EXPECT_EQ(result.counts.size(), 2);
+  EXPECT_EQ(result.counts["01"] + result.counts["11"], shots);
+  EXPECT_NEAR(result.counts["11"] / (double)shots, 0.25, 0.01);
+  EXPECT_NEAR(result.expectationValue.value(), -0.5, 0.02);
+  EXPECT_EQ(result.getSequentialData().size(), shots);
+
+  result = qppBackend.sample({1}, shots);
+  EXPECT_NEAR(result.counts["1"] / (double)shots, 0.5, 0.01);
+}
+
+// Checks the exact expectation value of each term of a spin operator, and of
+// their sum, computed from the state.
+CUDAQ_TEST(QPPTester, checkObservePauliTerms) {
+  QppSimulator qppBackend;
+  auto q = qppBackend.allocateQubits(3);
+  // A Bell pair on q0 and q1, and q2 in |+>.
+  qppBackend.h(q[0]);
+  qppBackend.x({q[0]}, q[1]);
+  qppBackend.h(q[2]);
+
+  using cudaq::spin_op;
+  const auto xx = spin_op::x(0) * spin_op::x(1);
+  const auto yy = spin_op::y(0) * spin_op::y(1);
+  const auto zz = spin_op::z(0) * spin_op::z(1);
+  auto op = spin_op::canonicalize(2.0 * xx + 3.0 * yy - zz +
+                                  0.5 * spin_op::x(2) + spin_op::z(0) +
+                                  spin_op::y(2));
+  auto result = qppBackend.observe(op);
+  EXPECT_NEAR(result.expectation(), 2.0 - 3.0 - 1.0 + 0.5, 1e-12);
+  EXPECT_NEAR(result.expectation(xx), 1.0, 1e-12);
+  EXPECT_NEAR(result.expectation(yy), -1.0, 1e-12);
+  EXPECT_NEAR(result.expectation(zz), 1.0, 1e-12);
+  EXPECT_NEAR(result.expectation(spin_op::x(2)), 1.0, 1e-12);
+  EXPECT_NEAR(result.expectation(spin_op::z(0)), 0.0, 1e-12);
+  EXPECT_NEAR(result.expectation(spin_op::y(2)), 0.0, 1e-12);
+
+  // The state is left as it was.
+  qpp::ket want_state = qpp::ket::Zero(8);
+  want_state(0b000) = want_state(0b011) = 0.5;
+  want_state(0b100) = want_state(0b111) = 0.5;
+  qpp::ket got_state = qppBackend.getStateVector();
+  EXPECT_EQ_KETS(want_state, got_state);
+}
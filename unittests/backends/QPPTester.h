@@ -30,8 +30,50 @@ public:
     return sampleResults.begin()->first;
   }
 
+  void setGateFusionMaxQubits(std::size_t maxQubits) {
+    this->gateFusionMaxQubits = maxQubits;
+  }
+
+  void setAccumulateDiagonalGates(bool accumulate) {
+    this->accumulateDiagonalGates = accumulate;
+  }
+
+  void setNumLocalQubits(std::size_t numQubits) { numLocalQubits = numQubits; }
+
   auto getStateVector() {
     this->flushGateQueue();
     return this->state;
   }
+
+  /// The number of gates applied with a target on a global qubit.
+  std::size_t numGlobalTargets = 0;
+  /// The number of batches of qubit position swaps.
+  std::size_t numQubitExchanges = 0;
+
+protected:
+  using GateApplicationTask = typename Simulator::GateApplicationTask;
+
+  std::size_t getNumLocalQubits() const override {
+    return numLocalQubits ? numLocalQubits : this->nQubitsAllocated;
+  }
+
+  void swapQubitPositions(
+      const std::vector<std::pair<std::size_t, std::size_t>> &swaps) override {
+    ++numQubitExchanges;
+    const std::vector<std::complex<double>> swapMatrix{1, 0, 0, 0, 0, 0, 1, 0,
+                                                       0, 1, 0, 0, 0, 0, 0, 1};
+    for (auto [a, b] : swaps)
+      Simulator::applyGate(GateApplicationTask("swap", swapMatrix, {}, {a, b},
+                                               {}));
+  }
+
+  void applyGate(const GateApplicationTask &task) override {
+    for (auto target : task.targets)
+      if (target >= getNumLocalQubits())
+        ++numGlobalTargets;
+    Simulator::applyGate(task);
+  }
+
+private:
+  std::size_t numLocalQubits = 0;
 };
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "StateVectorKernels.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace nvqir::simd;
+
+namespace {
+
+/// Reference implementation: apply the gate by looping over every amplitude.
+std::vector<complex> applyReference(std::vector<complex> state,
+                                    const std::vector<complex> &matrix,
+                                    const std::vector<std::size_t> &controls,
+                                    const std::vector<std::size_t> &targets) {
+  const std::size_t nTargets = targets.size();
+  const std::size_t gateDim = 1ULL << nTargets;
+  std::vector<complex> result = state;
+  for (std::size_t i = 0; i < state.size(); ++i) {
+    if (!std::all_of(controls.begin(), controls.end(),
+                     [&](std::size_t c) { return (i >> c) & 1; }))
+      continue;
+    std::size_t row = 0, base = i;
+    for (std::size_t j = 0; j < nTargets; ++j) {
+      if ((i >> targets[j]) & 1)
+        row |= 1ULL << (nTargets - 1 - j);
+      base &= ~(1ULL << targets[j]);
+    }
+    complex acc = 0.0;
+    for (std::size_t c = 0; c < gateDim; ++c) {
+      std::size_t idx = base;
+      for (std::size_t j = 0; j < nTargets; ++j)
+        if (c & (1ULL << (nTargets - 1 - j)))
+          idx |= 1ULL << targets[j];
+      acc += matrix[row * gateDim + c] * state[idx];
+    }
+    result[i] = acc;
+  }
+  return result;
+}
+
+std::vector<complex> randomState(std::size_t dim, std::mt19937 &gen) {
+  std::normal_distribution<double> dist;
+  std::vector<complex> state(dim);
+  for (auto &a : state)
+    a = complex(dist(gen), dist(gen));
+  return state;
+}
+
+void checkGate(const std::vector<complex> &matrix,
+               const std::vector<std::size_t> &controls,
+               const std::vector<std::size_t> &targets, std::mt19937 &gen) {
+  const std::size_t dim = 1ULL << 6;
+  auto state = randomState(dim, gen);
+  auto expected = applyReference(state, matrix, controls, targets);
+  applyGate(state.data(), dim, matrix, controls, targets);
+  for (std::size_t i = 0; i < dim; ++i)
+    EXPECT_NEAR(std::abs(state[i] - expected[i]), 0.0, 1e-12);
+}
+
+} // namespace
+
+CUDAQ_TEST(SimdKernelsTester, checkClassifyGate) {
+  const complex i(0.0, 1.0);
+  EXPECT_EQ(classifyGate({1., 0., 0., -1.}, 2), GateKind::diagonal);
+  EXPECT_EQ(classifyGate({0., 1., 1., 0.}, 2), GateKind::permutation);
+  EXPECT_EQ(classifyGate({0., -i, i, 0.}, 2), GateKind::permutation);
+  EXPECT_EQ(classifyGate({M_SQRT1_2, M_SQRT1_2, M_SQRT1_2, -M_SQRT1_2}, 2),
+            GateKind::dense);
+  // SWAP
+  EXPECT_EQ(classifyGate({1., 0., 0., 0., 0., 0., 1., 0., 0., 1., 0., 0., 0.,
+                          0., 0., 1.},
+                         4),
+            GateKind::permutation);
+}
+
+CUDAQ_TEST(SimdKernelsTester, checkAgainstReference) {
+  std::mt19937 gen(13);
+  const complex i(0.0, 1.0);
+  const std::vector<complex> h = {M_SQRT1_2, M_SQRT1_2, M_SQRT1_2,
+                                  -M_SQRT1_2};
+  const std::vector<complex> x = {0., 1., 1., 0.};
+  const std::vector<complex> y = {0., -i, i, 0.};
+  const std::vector<complex> t = {1., 0., 0., std::exp(i * M_PI / 4.)};
+  const std::vector<complex> rzLike = {std::exp(-i * 0.3), 0., 0.,
+                                       std::exp(i * 0.3)};
+  const std::vector<complex> swap = {1., 0., 0., 0., 0., 0., 1., 0.,
+                                     0., 1., 0., 0., 0., 0., 0., 1.};
+  std::vector<complex> dense2(16);
+  for (auto &m : dense2)
+    m = complex(std::normal_distribution<double>()(gen), 0.5);
+
+  // Cover targets and controls on the lowest qubit, which take the scalar
+  // paths, as well as higher qubits, which take the vectorized paths.
+  for (const auto &gate : {h, x, y, t, rzLike}) {
+    for (std::size_t q = 0; q < 6; ++q) {
+      checkGate(gate, {}, {q}, gen);
+      checkGate(gate, {(q + 1) % 6}, {q}, gen);
+      checkGate(gate, {(q + 2) % 6, (q + 4) % 6}, {q}, gen);
+    }
+  }
+  for (const auto &gate : {swap, dense2}) {
+    checkGate(gate, {}, {0, 3}, gen);
+    checkGate(gate, {}, {4, 1}, gen);
+    checkGate(gate, {2}, {5, 0}, gen);
+    checkGate(gate, {0, 5}, {3, 1}, gen);
+  }
+}
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "common/AnalogEmulator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <gtest/gtest.h>
+
+namespace {
+// Program driving the atoms at the given sites with a constant Rabi frequency
+// for the given duration.
+cudaq::ahs::Program
+constantDrive(const std::vector<std::vector<double>> &sites, double omega,
+              double duration) {
+  cudaq::ahs::Program program;
+  program.setup.ahs_register.sites = sites;
+  program.setup.ahs_register.filling = std::vector<int>(sites.size(), 1);
+  cudaq::ahs::DrivingField drive;
+  drive.amplitude.time_series =
+      cudaq::ahs::TimeSeries({{omega, 0.0}, {omega, duration}});
+  drive.phase.time_series =
+      cudaq::ahs::TimeSeries({{0.0, 0.0}, {0.0, duration}});
+  drive.detuning.time_series =
+      cudaq::ahs::TimeSeries({{0.0, 0.0}, {0.0, duration}});
+  program.hamiltonian.drivingFields = {drive};
+  return program;
+}
+} // namespace
+
+CUDAQ_TEST(AnalogEmulatorTester, checkRabiOscillation) {
+  const double omega = 1e7;
+  cudaq::ahs::LocalEmulator emulator(
+      constantDrive({{0.0, 0.0}}, omega, M_PI / omega));
+  EXPECT_EQ(emulator.dimension(), 2);
+  const auto state = emulator.evolve();
+  EXPECT_NEAR(std::norm(state[1]), 1.0, 1e-8);
+
+  const auto shots = emulator.sample(10, 13);
+  EXPECT_EQ(shots.size(), 10);
+  for (const auto &shot : shots) {
+    EXPECT_EQ(shot.shotMetadata.shotStatus, "Success");
+    EXPECT_EQ(shot.shotResult.preSequence.value(), std::vector<int>{1});
+    EXPECT_EQ(shot.shotResult.postSequence.value(), std::vector<int>{0});
+  }
+}
+
+CUDAQ_TEST(AnalogEmulatorTester, checkBlockade) {
+  // Two atoms 4 micrometers apart are blockaded: they oscillate together
+  // between the ground state and the symmetric single excitation, with a Rabi
+  // frequency enhanced by sqrt(2).
+  const double omega = 1e7;
+  const double duration = M_PI / (std::sqrt(2.0) * omega);
+  const std::vector<std::vector<double>> sites = {{0.0, 0.0}, {4e-6, 0.0}};
+  cudaq::ahs::LocalEmulator blockaded(constantDrive(sites, omega, duration));
+  EXPECT_EQ(blockaded.dimension(), 3);
+  EXPECT_EQ(blockaded.basis(), (std::vector<std::uint64_t>{0, 1, 2}));
+  auto state = blockaded.evolve();
+  EXPECT_NEAR(std::norm(state[1]) + std::norm(state[2]), 1.0, 1e-3);
+
+  // Same in the full Hilbert space
+  cudaq::ahs::LocalEmulator full(constantDrive(sites, omega, duration),
+                                 std::numeric_limits<double>::infinity());
+  EXPECT_EQ(full.dimension(), 4);
+  state = full.evolve();
+  EXPECT_NEAR(std::norm(state[1]) + std::norm(state[2]), 1.0, 1e-3);
+  EXPECT_LT(std::norm(state[3]), 1e-3);
+}
+
+CUDAQ_TEST(AnalogEmulatorTester, checkAdiabaticSweep) {
+  // Sweep of the detuning across a chain of atoms with nearest neighbors in
+  // blockade: the final state approaches the antiferromagnetic order.
+  const std::size_t numAtoms = 9;
+  std::vector<std::vector<double>> sites;
+  for (std::size_t i = 0; i < numAtoms; ++i)
+    sites.push_back({5.5e-6 * i, 0.0});
+  cudaq::ahs::Program program;
+  program.setup.ahs_register.sites = sites;
+  program.setup.ahs_register.filling = std::vector<int>(numAtoms, 1);
+  cudaq::ahs::DrivingField drive;
+  drive.amplitude.time_series = cudaq::ahs::TimeSeries(
+      {{0.0, 0.0}, {1.58e7, 0.3e-6}, {1.58e7, 3.7e-6}, {0.0, 4e-6}});
+  drive.phase.time_series = cudaq::ahs::TimeSeries({{0.0, 0.0}, {0.0, 4e-6}});
+  drive.detuning.time_series = cudaq::ahs::TimeSeries(
+      {{-1.6e7, 0.0}, {-1.6e7, 0.3e-6}, {1.6e7, 3.7e-6}, {1.6e7, 4e-6}});
+  program.hamiltonian.drivingFields = {drive};
+
+  cudaq::ahs::LocalEmulator blockaded(program);
+  cudaq::ahs::LocalEmulator full(program,
+                                 std::numeric_limits<double>::infinity());
+  // Independent sets of a chain of 9 atoms: Fibonacci(11)
+  EXPECT_EQ(blockaded.dimension(), 89);
+  EXPECT_EQ(full.dimension(), 512);
+
+  const auto blockadedState = blockaded.evolve();
+  const auto fullState = full.evolve();
+  const std::uint64_t ordered = 0b101010101;
+  const auto &basis = blockaded.basis();
+  const auto index =
+      std::lower_bound(basis.begin(), basis.end(), ordered) - basis.begin();
+  EXPECT_GT(std::norm(fullState[ordered]), 0.5);
+  EXPECT_NEAR(std::norm(blockadedState[index]), std::norm(fullState[ordered]),
+              0.02);
+}
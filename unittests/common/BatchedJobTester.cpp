@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/Executor.h"
+#include "MockHttpServer.h"
+#include <gtest/gtest.h>
+
+using namespace cudaq;
+using test::MockHttpServer;
+
+namespace {
+// The helper of a mock server running several circuits per job. The code of a
+// circuit is the bit string it measures on every shot, and the counts of the
+// circuits of a job are returned in a list.
+class BatchServerHelper : public ServerHelper {
+  std::string url;
+  std::size_t maxCircuitsPerJob = 1;
+
+public:
+  const std::string name() const override { return "batch_mock"; }
+
+  void initialize(BackendConfig config) override {
+    backendConfig = std::move(config);
+    url = backendConfig["url"];
+    maxCircuitsPerJob = std::stoul(backendConfig["max_circuits"]);
+  }
+
+  RestHeaders getHeaders() override {
+    return {{"Content-Type", "application/json"}};
+  }
+
+  ServerJobPayload
+  createJob(std::vector<KernelExecution> &circuitCodes) override {
+    std::vector<ServerMessage> jobs;
+    for (auto &code : circuitCodes) {
+      std::vector<KernelExecution> circuit{code};
+      jobs.push_back(std::get<2>(createBatchJob(circuit)).front());
+    }
+    return {url + "/job", getHeaders(), jobs};
+  }
+
+  std::size_t getMaxCircuitsPerJob() override { return maxCircuitsPerJob; }
+
+  ServerJobPayload
+  createBatchJob(std::vector<KernelExecution> &circuitCodes) override {
+    ServerMessage job;
+    job["shots"] = shots;
+    job["circuits"] = nlohmann::json::array();
+    for (auto &code : circuitCodes)
+      job["circuits"].push_back(code.code);
+    return {url + "/job", getHeaders(), std::vector<ServerMessage>{job}};
+  }
+
+  std::string extractJobId(ServerMessage &postResponse) override {
+    return postResponse.at("id");
+  }
+
+  std::string constructGetJobPath(ServerMessage &postResponse) override {
+    auto jobId = extractJobId(postResponse);
+    return constructGetJobPath(jobId);
+  }
+
+  std::string constructGetJobPath(std::string &jobId) override {
+    return url + "/job/" + jobId;
+  }
+
+  bool jobIsDone(ServerMessage &getJobResponse) override {
+    return getJobResponse.at("status") == "done";
+  }
+
+  sample_result processResults(ServerMessage &getJobResponse,
+                               std::string &jobId) override {
+    return processBatchResults(getJobResponse, jobId).at(0);
+  }
+
+  std::vector<sample_result>
+  processBatchResults(ServerMessage &getJobResponse,
+                      std::string &jobId) override {
+    std::vector<sample_result> results;
+    for (auto &counts : getJobResponse.at("counts"))
+      results.emplace_back(ExecutionResult(counts.get<CountsDictionary>()));
+    return results;
+  }
+};
+
+// A server returning the counts of a job on its second status request. With
+// `dropLastResult`, the last circuit of each job goes missing.
+struct BatchedJobTester : public ::testing::Test {
+  std::mutex mutex;
+  std::vector<std::vector<std::string>> jobs;
+  bool dropLastResult = false;
+
+  MockHttpServer server{[this](const MockHttpServer::Request &request) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    if (request.method == "POST" && request.path == "/job") {
+      auto job = nlohmann::json::parse(request.body);
+      jobs.push_back(job.at("circuits").get<std::vector<std::string>>());
+      nlohmann::json response{{"id", std::to_string(jobs.size() - 1)}};
+      return MockHttpServer::Response{200, response.dump()};
+    }
+    if (request.method != "GET" || request.path.rfind("/job/", 0) != 0)
+      return MockHttpServer::Response{404, "Not found"};
+    const auto &circuits = jobs.at(std::stoul(request.path.substr(5)));
+    if (request.count == 1)
+      return MockHttpServer::Response{200, R"({"status": "running"})"};
+    nlohmann::json response{{"status", "done"},
+                            {"counts", nlohmann::json::array()}};
+    for (std::size_t i = 0; i + dropLastResult < circuits.size(); ++i)
+      response["counts"].push_back({{circuits[i], 100}});
+    return MockHttpServer::Response{200, response.dump()};
+  }};
+
+  BatchServerHelper helper;
+  Executor executor;
+
+  // The circuits of the term groups of an `observe` call.
+  std::vector<KernelExecution> codes;
+
+  void SetUp() override {
+    nlohmann::json outputNames = nlohmann::json::object();
+    std::vector<std::size_t> reorderIdx;
+    for (std::string bits : {"00", "01", "10", "11", "01"}) {
+      std::string name = "term" + std::to_string(codes.size());
+      codes.emplace_back(name, bits, outputNames, reorderIdx);
+    }
+    executor.setServerHelper(&helper);
+    executor.setShots(100);
+  }
+
+  sample_result execute(std::size_t maxCircuitsPerJob) {
+    helper.initialize({{"url", server.url()},
+                       {"max_circuits", std::to_string(maxCircuitsPerJob)}});
+    helper.setShots(100);
+    return executor
+        .execute(codes, details::ExecutionContextType::observe)
+        .get();
+  }
+
+  // Check that each circuit got the counts of its own bit string.
+  void checkResults(sample_result &result) {
+    for (auto &code : codes) {
+      auto counts = result.to_map(code.name);
+      ASSERT_EQ(counts.size(), 1) << code.name;
+      EXPECT_EQ(counts.begin()->first, code.code) << code.name;
+      EXPECT_EQ(counts.begin()->second, 100) << code.name;
+    }
+  }
+};
+} // namespace
+
+CUDAQ_REGISTER_TYPE(cudaq::ServerHelper, BatchServerHelper, batch_mock)
+
+TEST_F(BatchedJobTester, checkBatches) {
+  auto result = execute(2);
+  // The 5 circuits fit in 3 jobs, in submission order.
+  std::vector<std::vector<std::string>> expected{
+      {"00", "01"}, {"10", "11"}, {"01"}};
+  EXPECT_EQ(jobs, expected);
+  EXPECT_EQ(server.getNumRequests("/job"), 3);
+  checkResults(result);
+}
+
+TEST_F(BatchedJobTester, checkSingleBatch) {
+  auto result = execute(10);
+  ASSERT_EQ(jobs.size(), 1);
+  EXPECT_EQ(jobs[0].size(), codes.size());
+  checkResults(result);
+}
+
+TEST_F(BatchedJobTester, checkOneCircuitPerJob) {
+  auto result = execute(1);
+  EXPECT_EQ(jobs.size(), codes.size());
+  for (auto &circuits : jobs)
+    EXPECT_EQ(circuits.size(), 1);
+  checkResults(result);
+}
+
+TEST_F(BatchedJobTester, checkMissingResults) {
+  dropLastResult = true;
+  try {
+    execute(2);
+    FAIL() << "Expected a missing result to fail.";
+  } catch (const std::exception &e) {
+    EXPECT_NE(std::string(e.what()).find("returned 1 results for 2 circuits"),
+              std::string::npos)
+        << e.what();
+  }
+}
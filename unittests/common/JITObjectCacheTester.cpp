@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/JITObjectCache.h"
+#include "TemporaryDirectoryTester.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace cudaq;
+
+namespace {
+class JITObjectCacheTester : public test::TemporaryDirectoryTester {
+protected:
+  JITObjectCacheTester() : TemporaryDirectoryTester("jit-cache") {}
+
+  std::uint64_t directorySize() {
+    std::uint64_t size = 0;
+    std::error_code ec;
+    for (llvm::sys::fs::directory_iterator it(directory, ec), end;
+         it != end && !ec; it.increment(ec)) {
+      llvm::sys::fs::file_status status;
+      if (!llvm::sys::fs::status(it->path(), status))
+        size += status.getSize();
+    }
+    return size;
+  }
+
+  llvm::LLVMContext context;
+};
+} // namespace
+
+TEST_F(JITObjectCacheTester, checkStoreAndLoad) {
+  llvm::Module module(JITObjectCache::moduleIdentifier("kernel IR"), context);
+  const std::string object = "object file contents";
+  {
+    JITObjectCache cache(directory, 1 << 20);
+    EXPECT_EQ(cache.getObject(&module), nullptr);
+    cache.notifyObjectCompiled(
+        &module, llvm::MemoryBufferRef(object, module.getModuleIdentifier()));
+  }
+
+  // A new cache, e.g., in another process, finds the entry.
+  JITObjectCache cache(directory, 1 << 20);
+  auto buffer = cache.getObject(&module);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(buffer->getBuffer().str(), object);
+
+  // Other contents hash to another entry.
+  llvm::Module other(JITObjectCache::moduleIdentifier("other IR"), context);
+  EXPECT_EQ(cache.getObject(&other), nullptr);
+}
+
+TEST_F(JITObjectCacheTester, checkIgnoresUnkeyedModules) {
+  llvm::Module module("Platform", context);
+  JITObjectCache cache(directory, 1 << 20);
+  cache.notifyObjectCompiled(&module,
+                             llvm::MemoryBufferRef("object", "Platform"));
+  EXPECT_EQ(cache.getObject(&module), nullptr);
+  EXPECT_EQ(directorySize(), 0);
+}
+
+TEST_F(JITObjectCacheTester, checkPruneToSizeLimit) {
+  const std::string object(4096, 'x');
+  JITObjectCache cache(directory, 3 * object.size());
+  for (int i = 0; i < 8; ++i) {
+    llvm::Module module(JITObjectCache::moduleIdentifier(std::to_string(i)),
+                        context);
+    cache.notifyObjectCompiled(
+        &module, llvm::MemoryBufferRef(object, module.getModuleIdentifier()));
+  }
+  // Stores only prune once per interval, force another pass.
+  llvm::sys::fs::remove(getPath("llvmcache.timestamp"));
+  cache.prune();
+  EXPECT_LE(directorySize(), 3 * object.size());
+}
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/JobPoller.h"
+#include "MockHttpServer.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace cudaq;
+using namespace std::chrono_literals;
+using test::MockHttpServer;
+
+namespace {
+// Jobs whose status is `/job/<n>`, running for their first n requests.
+struct JobPollerTester : public ::testing::Test {
+  MockHttpServer server{[](const MockHttpServer::Request &request) {
+    const auto &path = request.path;
+    if (path == "/error")
+      return MockHttpServer::Response{500, "Internal error"};
+    if (path == "/invalid")
+      return MockHttpServer::Response{200, "not json"};
+    if (path.rfind("/job/", 0) != 0)
+      return MockHttpServer::Response{404, "Not found"};
+    std::size_t numRunning = std::stoul(path.substr(5));
+    nlohmann::json status{
+        {"status", request.count > numRunning ? "done" : "running"},
+        {"polls", request.count}};
+    return MockHttpServer::Response{200, status.dump()};
+  }};
+
+  JobPoller::Request makeRequest(const std::string &path) {
+    JobPoller::Request request;
+    request.url = server.url(path);
+    request.isDone = [](nlohmann::json &status) {
+      return status["status"] == "done";
+    };
+    request.nextInterval = [](nlohmann::json &) { return 1ms; };
+    return request;
+  }
+};
+
+std::string getErrorMessage(std::future<nlohmann::json> &result) {
+  try {
+    result.get();
+  } catch (const std::exception &e) {
+    return e.what();
+  }
+  return "";
+}
+} // namespace
+
+TEST_F(JobPollerTester, checkCompletion) {
+  JobPoller poller;
+  auto result = poller.poll(makeRequest("/job/3"));
+  auto status = result.get();
+  EXPECT_EQ(status["status"], "done");
+  EXPECT_EQ(status["polls"], 4);
+  EXPECT_EQ(server.getNumRequests("/job/3"), 4);
+  EXPECT_EQ(poller.getNumPending(), 0);
+}
+
+TEST_F(JobPollerTester, checkManyJobs) {
+  JobPoller poller;
+  std::vector<std::future<nlohmann::json>> results;
+  for (std::size_t i = 0; i < 20; ++i)
+    results.push_back(poller.poll(makeRequest("/job/" + std::to_string(i))));
+  for (std::size_t i = 0; i < results.size(); ++i)
+    EXPECT_EQ(results[i].get()["polls"], i + 1);
+  EXPECT_EQ(poller.getNumPending(), 0);
+}
+
+TEST_F(JobPollerTester, checkCallback) {
+  JobPoller poller;
+  std::promise<std::pair<nlohmann::json, std::exception_ptr>> done;
+  poller.poll(makeRequest("/job/1"),
+              [&](nlohmann::json status, std::exception_ptr error) {
+                done.set_value({std::move(status), error});
+              });
+  auto [status, error] = done.get_future().get();
+  EXPECT_FALSE(error);
+  EXPECT_EQ(status["polls"], 2);
+}
+
+TEST_F(JobPollerTester, checkHttpError) {
+  JobPoller poller;
+  auto result = poller.poll(makeRequest("/error"));
+  auto message = getErrorMessage(result);
+  EXPECT_NE(message.find("HTTP GET Error - status code 500"),
+            std::string::npos);
+  EXPECT_NE(message.find("Internal error"), std::string::npos);
+  EXPECT_EQ(server.getNumRequests("/error"), 1);
+  EXPECT_EQ(poller.getNumPending(), 0);
+}
+
+TEST_F(JobPollerTester, checkConnectionError) {
+  JobPoller poller;
+  // Nothing listens on the port of a server that was shut down.
+  std::string url;
+  {
+    MockHttpServer closed{[](const MockHttpServer::Request &) {
+      return MockHttpServer::Response{200, "{}"};
+    }};
+    url = closed.url("/job/0");
+  }
+  auto request = makeRequest("/job/0");
+  request.url = url;
+  auto result = poller.poll(std::move(request));
+  EXPECT_NE(getErrorMessage(result).find("HTTP GET Error - status code 0"),
+            std::string::npos);
+}
+
+TEST_F(JobPollerTester, checkInvalidResponse) {
+  JobPoller poller;
+  auto result = poller.poll(makeRequest("/invalid"));
+  EXPECT_THROW(result.get(), nlohmann::json::parse_error);
+  EXPECT_EQ(poller.getNumPending(), 0);
+}
+
+TEST_F(JobPollerTester, checkStatusError) {
+  JobPoller poller;
+  auto request = makeRequest("/job/5");
+  request.isDone = [](nlohmann::json &status) -> bool {
+    if (status["polls"] == 2)
+      throw std::runtime_error("Job failed.");
+    return false;
+  };
+  auto result = poller.poll(std::move(request));
+  EXPECT_EQ(getErrorMessage(result), "Job failed.");
+  EXPECT_EQ(server.getNumRequests("/job/5"), 2);
+}
+
+TEST_F(JobPollerTester, checkShutdown) {
+  std::future<nlohmann::json> waiting, inFlight;
+  {
+    JobPoller poller;
+    // A job polled again only after the poller is shut down, and one whose
+    // first request is submitted just before.
+    auto request = makeRequest("/job/100");
+    request.nextInterval = [](nlohmann::json &) { return 1h; };
+    waiting = poller.poll(std::move(request));
+    while (server.getNumRequests("/job/100") == 0)
+      std::this_thread::sleep_for(1ms);
+    inFlight = poller.poll(makeRequest("/job/100"));
+    EXPECT_EQ(poller.getNumPending(), 2);
+  }
+  for (auto *result : {&waiting, &inFlight})
+    EXPECT_EQ(getErrorMessage(*result),
+              "The job poller was shut down before the job was done.");
+}
+
+TEST(JobPollerBackoffTester, checkGrowth) {
+  JobPoller::Backoff backoff(10ms);
+  EXPECT_EQ(backoff.next(1ms), 1ms);
+  EXPECT_EQ(backoff.next(1ms), 1500us);
+  EXPECT_EQ(backoff.next(1ms), 2250us);
+  for (int i = 0; i < 10; ++i)
+    backoff.next(1ms);
+  EXPECT_EQ(backoff.next(1ms), 10ms);
+  // A job at the front of the queue counts as running.
+  EXPECT_EQ(backoff.next(1ms, 0), 10ms);
+}
+
+TEST(JobPollerBackoffTester, checkNoMinimumInterval) {
+  JobPoller::Backoff backoff(10ms);
+  EXPECT_EQ(backoff.next(0us), 100us);
+  EXPECT_EQ(backoff.next(0us), 150us);
+}
+
+TEST(JobPollerBackoffTester, checkHints) {
+  JobPoller::Backoff backoff(10ms);
+  backoff.next(1ms);
+  backoff.next(1ms);
+  EXPECT_EQ(backoff.next(1ms, std::nullopt, 8ms), 4ms);
+  // The growth restarts from the minimum interval after a hint.
+  EXPECT_EQ(backoff.next(1ms), 1500us);
+  EXPECT_EQ(backoff.next(1ms, 3), 4ms);
+  EXPECT_EQ(backoff.next(1ms), 1500us);
+}
+
+TEST(JobPollerBackoffTester, checkBounds) {
+  JobPoller::Backoff backoff(10ms);
+  EXPECT_EQ(backoff.next(1ms, 100), 10ms);
+  EXPECT_EQ(backoff.next(1ms, std::nullopt, 1h), 10ms);
+  EXPECT_EQ(backoff.next(1ms, std::nullopt, 1us), 1ms);
+  // The minimum interval of the server takes precedence over the maximum.
+  EXPECT_EQ(backoff.next(20ms), 20ms);
+  EXPECT_EQ(backoff.next(20ms, 3), 20ms);
+}
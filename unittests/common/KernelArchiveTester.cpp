@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/KernelArchive.h"
+#include "TemporaryDirectoryTester.h"
+#include <string>
+
+using namespace cudaq;
+
+namespace {
+class KernelArchiveTester : public test::TemporaryDirectoryTester {
+protected:
+  KernelArchiveTester() : TemporaryDirectoryTester("kernel-archive") {}
+
+  void SetUp() override {
+    TemporaryDirectoryTester::SetUp();
+    file = getPath("kernels.json");
+  }
+
+  static std::vector<KernelExecution> makeCodes() {
+    std::string name = "kernel";
+    std::string code = "OPENQASM 2.0;";
+    nlohmann::json outputNames = {{"0", "r"}};
+    std::vector<std::size_t> reorderIdx = {1, 0};
+    return {KernelExecution(name, code, outputNames, reorderIdx)};
+  }
+
+  std::string file;
+};
+} // namespace
+
+TEST_F(KernelArchiveTester, checkRecordAndLoad) {
+  {
+    KernelArchive archive(file, "quantinuum", /*record=*/true);
+    EXPECT_EQ(archive.size(), 0);
+    EXPECT_FALSE(archive.lookup("key"));
+    archive.add("key", makeCodes());
+    EXPECT_EQ(archive.size(), 1);
+  }
+  KernelArchive archive(file, "quantinuum", /*record=*/false);
+  EXPECT_EQ(archive.size(), 1);
+  auto codes = archive.lookup("key");
+  ASSERT_TRUE(codes);
+  ASSERT_EQ(codes->size(), 1);
+  EXPECT_EQ(codes->front().name, "kernel");
+  EXPECT_EQ(codes->front().code, "OPENQASM 2.0;");
+  EXPECT_EQ(codes->front().output_names, makeCodes().front().output_names);
+  EXPECT_EQ(codes->front().mapping_reorder_idx,
+            (std::vector<std::size_t>{1, 0}));
+  EXPECT_FALSE(archive.lookup("other key"));
+}
+
+TEST_F(KernelArchiveTester, checkNotRecording) {
+  KernelArchive archive(file, "quantinuum", /*record=*/false);
+  archive.add("key", makeCodes());
+  EXPECT_EQ(archive.size(), 0);
+  EXPECT_FALSE(llvm::sys::fs::exists(file));
+}
+
+TEST_F(KernelArchiveTester, checkOtherTarget) {
+  KernelArchive(file, "quantinuum", /*record=*/true).add("key", makeCodes());
+  KernelArchive archive(file, "ionq", /*record=*/false);
+  EXPECT_EQ(archive.size(), 0);
+  EXPECT_FALSE(archive.lookup("key"));
+}
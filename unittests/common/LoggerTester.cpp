@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// Remove the messages below warn of this file at compile time.
+#define CUDAQ_LOG_ACTIVE_LEVEL 3
+#include "common/Logger.h"
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <unistd.h>
+
+using namespace cudaq;
+using details::LogLevel;
+
+namespace {
+// Restore the default level after each test.
+struct LoggerTester : public ::testing::Test {
+  void TearDown() override { details::setLogLevel(LogLevel::warn); }
+};
+} // namespace
+
+TEST_F(LoggerTester, checkCompileTimeLevel) {
+  details::setLogLevel(LogLevel::trace);
+  int numEvaluated = 0;
+  auto argument = [&] { return ++numEvaluated; };
+  // The arguments of removed messages are not evaluated, whatever the level.
+  CUDAQ_INFO("removed message {}", argument());
+  CUDAQ_DBG("removed message {}", argument());
+  EXPECT_EQ(numEvaluated, 0);
+  testing::internal::CaptureStdout();
+  CUDAQ_WARN("kept message {}", argument());
+  EXPECT_EQ(numEvaluated, 1);
+  EXPECT_NE(testing::internal::GetCapturedStdout().find("kept message 1"),
+            std::string::npos);
+}
+
+TEST_F(LoggerTester, checkRuntimeLevel) {
+  EXPECT_TRUE(details::should_log(LogLevel::warn));
+  EXPECT_FALSE(details::should_log(LogLevel::info));
+
+  details::setLogLevel(LogLevel::info);
+  EXPECT_TRUE(details::should_log(LogLevel::info));
+  EXPECT_FALSE(details::should_log(LogLevel::debug));
+  testing::internal::CaptureStdout();
+  cudaq::info("shown message {}", 1);
+  details::setLogLevel(LogLevel::warn);
+  cudaq::info("hidden message {}", 2);
+  auto output = testing::internal::GetCapturedStdout();
+  EXPECT_NE(output.find("shown message 1"), std::string::npos);
+  EXPECT_EQ(output.find("hidden message 2"), std::string::npos);
+
+  details::setLogLevel(LogLevel::trace);
+  EXPECT_TRUE(details::should_log(LogLevel::trace));
+}
+
+TEST_F(LoggerTester, checkAsync) {
+  // The logger is configured at startup, so the messages are logged by a new
+  // process with the asynchronous logger, and checked once it exited.
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+  const std::string logFile =
+      "cudaq-async-log-" + std::to_string(getpid()) + ".txt";
+  setenv("CUDAQ_LOG_ASYNC", "1", 1);
+  setenv("CUDAQ_LOG_FILE", logFile.c_str(), 1);
+  setenv("CUDAQ_LOG_LEVEL", "info", 1);
+  constexpr int numThreads = 4;
+  constexpr int numMessages = 100;
+  EXPECT_EXIT(
+      {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t)
+          threads.emplace_back([t] {
+            for (int i = 0; i < numMessages; ++i)
+              cudaq::info("thread {} message {}", t, i);
+          });
+        for (auto &thread : threads)
+          thread.join();
+        // The queued messages are written at exit.
+        std::exit(0);
+      },
+      ::testing::ExitedWithCode(0), "");
+  unsetenv("CUDAQ_LOG_ASYNC");
+  unsetenv("CUDAQ_LOG_FILE");
+  unsetenv("CUDAQ_LOG_LEVEL");
+
+  std::set<std::string> messages;
+  std::ifstream file(logFile);
+  for (std::string line; std::getline(file, line);)
+    if (auto pos = line.find("thread "); pos != std::string::npos)
+      messages.insert(line.substr(pos));
+  std::remove(logFile.c_str());
+  EXPECT_EQ(messages.size(), numThreads * numMessages);
+  EXPECT_TRUE(messages.count("thread 0 message 0"));
+  EXPECT_TRUE(messages.count("thread 3 message 99"));
+}
@@ -64,3 +64,110 @@ CUDAQ_TEST(MeasureCountsTester, checkMeasureCountsSerialize) {
 
   EXPECT_TRUE(mm == mc);
 }
+
+CUDAQ_TEST(MeasureCountsTester, checkPackedResults) {
+  // Shots "10", "01", "01", "11" (bit i of the packed word is character i).
+  ExecutionResult r;
+  r.appendPackedResults(PackedShots(2, {0b01, 0b10, 0b10, 0b11}));
+  EXPECT_EQ(4, r.getNumSequentialShots());
+  EXPECT_TRUE(r.sequentialData.empty());
+
+  cudaq::sample_result mc(r);
+  EXPECT_EQ(3, mc.size());
+  EXPECT_EQ(1, mc.count("10"));
+  EXPECT_EQ(2, mc.count("01"));
+  EXPECT_EQ(1, mc.count("11"));
+  std::vector<std::string> expected{"10", "01", "01", "11"};
+  EXPECT_EQ(expected, mc.sequential_data());
+
+  // Packed results over multiple words per shot.
+  PackedShots wide(70);
+  std::vector<std::uint64_t> shot{1ULL, 1ULL << 5};
+  wide.append(shot.data());
+  ExecutionResult w;
+  w.appendPackedResults(std::move(wide));
+  std::string expectedWide(70, '0');
+  expectedWide[0] = '1';
+  expectedWide[69] = '1';
+  EXPECT_EQ(1, w.counts[expectedWide]);
+  EXPECT_EQ(std::vector<std::string>{expectedWide}, w.getSequentialData());
+
+  // The packed shots are exposed as is.
+  const auto &packed = mc.packed_sequential_data();
+  EXPECT_EQ(2, packed.numBits);
+  EXPECT_EQ((std::vector<std::uint64_t>{0b01, 0b10, 0b10, 0b11}),
+            packed.words);
+
+  ExecutionResult strings;
+  strings.appendResult("01", 1);
+  cudaq::sample_result fromStrings(strings);
+  EXPECT_ANY_THROW(fromStrings.packed_sequential_data());
+}
+
+CUDAQ_TEST(MeasureCountsTester, checkPackedResultsConcatenate) {
+  ExecutionResult first;
+  first.appendPackedResults(PackedShots(1, {0, 1, 1}));
+  ExecutionResult second;
+  second.appendPackedResults(PackedShots(2, {0b10, 0b11, 0b00}));
+
+  cudaq::sample_result mc;
+  mc.append(first, /*concatenate=*/true);
+  mc.append(second, /*concatenate=*/true);
+  std::vector<std::string> expected{"001", "111", "100"};
+  EXPECT_EQ(expected, mc.sequential_data());
+  EXPECT_EQ(1, mc.count("001"));
+  EXPECT_EQ(1, mc.count("111"));
+  EXPECT_EQ(1, mc.count("100"));
+
+  // Reorder works on the packed data as well.
+  mc.reorder({2, 1, 0});
+  std::vector<std::string> reordered{"100", "111", "001"};
+  EXPECT_EQ(reordered, mc.sequential_data());
+  EXPECT_EQ(1, mc.count("100"));
+
+  // Mixing packed and string based results.
+  ExecutionResult strings;
+  strings.appendResult("010", 1);
+  cudaq::sample_result other(strings);
+  mc += other;
+  std::vector<std::string> merged{"100", "111", "001", "010"};
+  EXPECT_EQ(merged, mc.sequential_data());
+}
+
+CUDAQ_TEST(MeasureCountsTester, checkMarginal) {
+  ExecutionResult result;
+  result.appendResult("0110", 3);
+  result.appendResult("1110", 2);
+  result.appendResult("0011", 1);
+  cudaq::sample_result mc(result);
+
+  auto marginal = mc.get_marginal({2, 1});
+  EXPECT_EQ(2, marginal.size());
+  EXPECT_EQ(5, marginal.count("11"));
+  EXPECT_EQ(1, marginal.count("01"));
+
+  // Repeated indices repeat the bit.
+  auto repeated = mc.get_marginal({0, 0});
+  EXPECT_EQ(2, repeated.count("11"));
+  EXPECT_EQ(4, repeated.count("00"));
+  EXPECT_ANY_THROW(mc.get_marginal({4}));
+
+  // Outcomes beyond 64 bits.
+  std::string wide(70, '0');
+  wide[3] = '1';
+  wide[69] = '1';
+  ExecutionResult wideResult;
+  wideResult.appendResult(wide, 2);
+  cudaq::sample_result wideCounts(wideResult);
+  EXPECT_EQ(2, wideCounts.get_marginal({3, 10}).count("10"));
+  EXPECT_EQ(2, wideCounts.get_marginal({69, 68}).count("01"));
+
+  // Merging adds the counts of the same outcomes.
+  ExecutionResult more;
+  more.appendResult("0110", 1);
+  more.appendResult("1111", 4);
+  mc += cudaq::sample_result(more);
+  EXPECT_EQ(4, mc.count("0110"));
+  EXPECT_EQ(4, mc.count("1111"));
+  EXPECT_EQ(10, mc.get_marginal({1}).count("1"));
+}
@@ -0,0 +1,161 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+#include <arpa/inet.h>
+#include <atomic>
+#include <cctype>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace cudaq::test {
+
+/// @brief A minimal HTTP server on the loopback interface, for testing REST
+/// clients without a remote server. Each request is answered with the status
+/// code and JSON body returned by the handler, one connection at a time.
+class MockHttpServer {
+public:
+  struct Request {
+    std::string method;
+    std::string path;
+    std::string body;
+    /// The number of requests received for `path` so far, this one included.
+    std::size_t count = 0;
+  };
+  using Response = std::pair<int, std::string>;
+  using Handler = std::function<Response(const Request &)>;
+
+  explicit MockHttpServer(Handler handler) : handler(std::move(handler)) {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    if (fd < 0 || bind(fd, (sockaddr *)&address, length) != 0 ||
+        listen(fd, 64) != 0 ||
+        getsockname(fd, (sockaddr *)&address, &length) != 0)
+      throw std::runtime_error("Unable to start the mock HTTP server.");
+    port = ntohs(address.sin_port);
+    worker = std::thread([this] { run(); });
+  }
+
+  ~MockHttpServer() {
+    stop = true;
+    worker.join();
+    close(fd);
+  }
+
+  MockHttpServer(const MockHttpServer &) = delete;
+  MockHttpServer &operator=(const MockHttpServer &) = delete;
+
+  /// @brief Return the URL of `path` on this server.
+  std::string url(const std::string &path = "") const {
+    return "http://127.0.0.1:" + std::to_string(port) + path;
+  }
+
+  /// @brief Return the number of requests received for `path`.
+  std::size_t getNumRequests(const std::string &path) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    return numRequests[path];
+  }
+
+private:
+  void run() {
+    while (!stop) {
+      pollfd listening{fd, POLLIN, 0};
+      if (::poll(&listening, 1, 10) <= 0)
+        continue;
+      int connection = accept(fd, nullptr, nullptr);
+      if (connection < 0)
+        continue;
+      serve(connection);
+      close(connection);
+    }
+  }
+
+  void serve(int connection) {
+    std::string message;
+    char buffer[4096];
+    std::size_t headerEnd;
+    while ((headerEnd = message.find("\r\n\r\n")) == std::string::npos)
+      if (!receive(connection, message, buffer, sizeof(buffer)))
+        return;
+
+    // The request line is `<method> <path> HTTP/1.1`.
+    Request request;
+    auto pathBegin = message.find(' ') + 1;
+    auto pathEnd = message.find(' ', pathBegin);
+    request.method = message.substr(0, pathBegin - 1);
+    request.path = message.substr(pathBegin, pathEnd - pathBegin);
+
+    std::size_t contentLength = 0;
+    for (auto begin = message.find("\r\n") + 2; begin < headerEnd;) {
+      auto end = message.find("\r\n", begin);
+      auto line = message.substr(begin, end - begin);
+      begin = end + 2;
+      auto colon = line.find(':');
+      if (colon == std::string::npos)
+        continue;
+      auto name = line.substr(0, colon);
+      for (auto &c : name)
+        c = std::tolower(c);
+      if (name == "content-length")
+        contentLength = std::stoul(line.substr(colon + 1));
+    }
+    while (message.size() < headerEnd + 4 + contentLength)
+      if (!receive(connection, message, buffer, sizeof(buffer)))
+        return;
+    request.body = message.substr(headerEnd + 4, contentLength);
+
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+      request.count = ++numRequests[request.path];
+    }
+    auto [status, body] = handler(request);
+    auto response = "HTTP/1.1 " + std::to_string(status) +
+                    " Mock\r\nContent-Type: application/json\r\n"
+                    "Content-Length: " +
+                    std::to_string(body.size()) +
+                    "\r\nConnection: close\r\n\r\n" + body;
+    for (std::size_t sent = 0; sent < response.size();) {
+      auto count =
+          write(connection, response.data() + sent, response.size() - sent);
+      if (count <= 0)
+        return;
+      sent += count;
+    }
+  }
+
+  static bool receive(int connection, std::string &message, char *buffer,
+                      std::size_t size) {
+    auto count = read(connection, buffer, size);
+    if (count <= 0)
+      return false;
+    message.append(buffer, count);
+    return true;
+  }
+
+  Handler handler;
+  int fd = -1;
+  std::uint16_t port = 0;
+  std::atomic<bool> stop = false;
+  std::mutex mutex;
+  std::map<std::string, std::size_t> numRequests;
+  std::thread worker;
+};
+
+} // namespace cudaq::test
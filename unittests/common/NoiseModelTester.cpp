@@ -111,3 +111,87 @@ CUDAQ_TEST(NoiseModelTester, checkUnitaryDetection) {
   }
 }
 #endif
+
+CUDAQ_TEST(NoiseModelTester, checkChannelLookup) {
+  cudaq::noise_model noise;
+  EXPECT_TRUE(noise.empty());
+  noise.add_channel("x", {0, 1}, depolarization2(0.1));
+  noise.add_all_qubit_channel("x", depolarization2(0.2), /*numControls=*/1);
+  noise.add_all_qubit_channel("x", bit_flip_channel(0.3));
+  noise.add_channel("x", [](const auto &qubits, const auto &params) {
+    if (qubits.size() == 1)
+      return kraus_channel(phase_flip_channel(0.4));
+    return kraus_channel();
+  });
+  EXPECT_FALSE(noise.empty());
+
+  // Qubit-specific channels come first, followed by the all-qubit channels
+  // and the channel returned by the callback.
+  auto channels = noise.get_channels("x", {1}, {0});
+  ASSERT_EQ(channels.size(), 2);
+  EXPECT_EQ(channels[0].parameters, std::vector<double>{0.1});
+  EXPECT_EQ(channels[1].parameters, std::vector<double>{0.2});
+
+  std::vector<noise_model_type> types;
+  noise.for_each_channel("x", {1}, {}, {}, [&](const kraus_channel &channel) {
+    types.push_back(channel.noise_type);
+  });
+  EXPECT_EQ(types, (std::vector<noise_model_type>{
+                       noise_model_type::bit_flip_channel,
+                       noise_model_type::phase_flip_channel}));
+
+  EXPECT_EQ(noise.get_channels("x", {1}, {2}).size(), 1);
+  EXPECT_TRUE(noise.get_channels("x", {0}, {1, 2}).empty());
+  EXPECT_TRUE(noise.get_channels("h", {0}).empty());
+
+  // Only one callback can be defined per operation.
+  EXPECT_ANY_THROW(noise.add_channel(
+      "x", [](const auto &, const auto &) { return kraus_channel(); }));
+}
+
+CUDAQ_TEST(NoiseModelTester, checkCrosstalkChannel) {
+  // Path 0 -- 1 -- 2 -- 3, plus 1 -- 4
+  const noise_model::coupling_map couplingMap{{0, 1}, {1, 2}, {2, 3}, {1, 4}};
+  noise_model noise;
+  noise.add_crosstalk_channel("cx", couplingMap, depolarization_channel(0.1));
+  noise.add_crosstalk_channel("h", couplingMap, amplitude_damping_channel(.2));
+  EXPECT_ANY_THROW(noise.add_crosstalk_channel("cx", couplingMap,
+                                               depolarization2(0.1)));
+
+  const auto spectatorsOf = [&](std::string_view op,
+                                const std::vector<std::size_t> &targets,
+                                const std::vector<std::size_t> &controls) {
+    std::vector<std::vector<std::size_t>> result;
+    noise.for_each_crosstalk_channel(
+        op, targets, controls,
+        [&](const noise_model::crosstalk_channel &crosstalk,
+            const std::vector<std::size_t> &spectators) {
+          result.push_back(spectators);
+        });
+    return result;
+  };
+  using Spectators = std::vector<std::vector<std::size_t>>;
+  EXPECT_EQ(spectatorsOf("x", {2}, {1}), (Spectators{{0, 3, 4}}));
+  EXPECT_EQ(spectatorsOf("x", {1}, {2}), (Spectators{{0, 3, 4}}));
+  // Operands that are not coupled
+  EXPECT_EQ(spectatorsOf("x", {3}, {0}), (Spectators{{1, 2}}));
+  // Only the operation with the given number of controls is noisy.
+  EXPECT_TRUE(spectatorsOf("x", {1}, {}).empty());
+  EXPECT_EQ(spectatorsOf("h", {4}, {}), (Spectators{{1}}));
+  // Qubits outside of the coupling map have no spectators.
+  EXPECT_TRUE(spectatorsOf("h", {7}, {}).empty());
+
+  // Pauli channels are tagged with the Pauli of each branch.
+  noise.for_each_crosstalk_channel(
+      "x", {2}, {1},
+      [&](const noise_model::crosstalk_channel &crosstalk,
+          const std::vector<std::size_t> &) {
+        EXPECT_EQ(crosstalk.paulis, "IXYZ");
+      });
+  noise.for_each_crosstalk_channel(
+      "h", {2}, {},
+      [&](const noise_model::crosstalk_channel &crosstalk,
+          const std::vector<std::size_t> &) {
+        EXPECT_TRUE(crosstalk.paulis.empty());
+      });
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/Profiler.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace cudaq::profiler;
+
+namespace {
+struct ProfilerTester : public ::testing::Test {
+  void SetUp() override {
+    clear();
+    setEnabled(true);
+  }
+  void TearDown() override {
+    setEnabled(false);
+    clear();
+  }
+};
+} // namespace
+
+TEST_F(ProfilerTester, checkNestedPhases) {
+  {
+    ScopedPhase launch(Phase::launch, "kernel");
+    {
+      ScopedPhase flush(Phase::simulator_flush);
+      flush.addCounter("gates", 3);
+      addCounter("gates", 2);
+    }
+    addCounter("bytes_allocated", 64);
+  }
+  auto events = getEvents();
+  ASSERT_EQ(events.size(), 2);
+  // Events are in completion order, the inner phase first.
+  EXPECT_EQ(events[0].phase, Phase::simulator_flush);
+  EXPECT_EQ(events[0].depth, 1);
+  EXPECT_EQ(events[0].counters.at("gates"), 5);
+  EXPECT_EQ(events[1].phase, Phase::launch);
+  EXPECT_EQ(events[1].name, "kernel");
+  EXPECT_EQ(events[1].depth, 0);
+  EXPECT_EQ(events[1].counters.at("bytes_allocated"), 64);
+  EXPECT_FALSE(events[1].counters.count("gates"));
+  EXPECT_LE(events[1].startNs, events[0].startNs);
+  EXPECT_GE(events[1].durationNs, events[0].durationNs);
+}
+
+TEST_F(ProfilerTester, checkDisabled) {
+  setEnabled(false);
+  {
+    ScopedPhase launch(Phase::launch);
+    addCounter("gates", 1);
+  }
+  EXPECT_TRUE(getEvents().empty());
+}
+
+TEST_F(ProfilerTester, checkThreads) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back([] {
+      for (int j = 0; j < 100; ++j) {
+        ScopedPhase phase(Phase::jit_passes);
+        addCounter("passes", 1);
+      }
+    });
+  for (auto &t : threads)
+    t.join();
+  auto events = getEvents();
+  ASSERT_EQ(events.size(), 400);
+  for (const auto &event : events) {
+    EXPECT_EQ(event.depth, 0);
+    EXPECT_EQ(event.counters.at("passes"), 1);
+  }
+}
+
+TEST_F(ProfilerTester, checkChromeTrace) {
+  {
+    ScopedPhase phase(Phase::sample_conversion, "a \"quoted\" name");
+    phase.addCounter("shots", 1000);
+  }
+  auto trace = toChromeTrace();
+  EXPECT_NE(trace.find("\"traceEvents\":["), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"a \\\"quoted\\\" name\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"cat\":\"sample_conversion\""), std::string::npos);
+  EXPECT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(trace.find("\"args\":{\"shots\":1000}"), std::string::npos);
+}
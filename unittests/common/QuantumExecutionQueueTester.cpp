@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cudaq/platform/QuantumExecutionQueue.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace cudaq;
+
+TEST(QuantumExecutionQueueTester, checkMoveOnlyTasks) {
+  // Move-only functors are accepted as is, small ones stored inline.
+  auto value = std::make_unique<int>(42);
+  int result = 0;
+  QuantumTask task = [&result, value = std::move(value)]() {
+    result = *value;
+  };
+  QuantumTask moved = std::move(task);
+  EXPECT_FALSE(task);
+  moved();
+  EXPECT_EQ(result, 42);
+
+  struct LargeFunctor {
+    char data[2 * QuantumTask::inlineSize] = {};
+    int *count;
+    void operator()() { ++*count; }
+  };
+  int count = 0;
+  QuantumTask large = LargeFunctor{{}, &count};
+  QuantumTask largeMoved = std::move(large);
+  largeMoved();
+  EXPECT_EQ(count, 1);
+  EXPECT_THROW(large(), std::bad_function_call);
+}
+
+TEST(QuantumExecutionQueueTester, checkManyProducers) {
+  // A small queue exercises the backpressure on producers. Tasks of each
+  // producer run in submission order.
+  constexpr int numProducers = 8;
+  constexpr int numTasks = 5000;
+  std::vector<std::vector<int>> executed(numProducers);
+  {
+    QuantumExecutionQueue queue(4);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; p++)
+      producers.emplace_back([&, p]() {
+        for (int i = 0; i < numTasks; i++) {
+          QuantumTask task = [&executed, p, i]() {
+            executed[p].push_back(i);
+          };
+          queue.enqueue(task);
+        }
+      });
+    for (auto &producer : producers)
+      producer.join();
+
+    std::promise<void> promise;
+    auto done = promise.get_future();
+    QuantumTask last = [p = std::move(promise)]() mutable { p.set_value(); };
+    queue.enqueue(last);
+    done.wait();
+  }
+  for (const auto &tasks : executed) {
+    ASSERT_EQ(tasks.size(), numTasks);
+    for (int i = 0; i < numTasks; i++)
+      EXPECT_EQ(tasks[i], i);
+  }
+}
+
+TEST(QuantumExecutionQueueTester, checkEnqueueFromExecutionThread) {
+  // Tasks running on the execution thread may enqueue more tasks than the
+  // queue holds without deadlocking.
+  std::atomic<int> count = 0;
+  QuantumExecutionQueue queue(2);
+  std::promise<void> promise;
+  auto done = promise.get_future();
+  QuantumTask outer = [&, p = std::move(promise)]() mutable {
+    for (int i = 0; i < 10; i++) {
+      QuantumTask inner = [&count]() { ++count; };
+      queue.enqueue(inner);
+    }
+    QuantumTask last = [p = std::move(p)]() mutable { p.set_value(); };
+    queue.enqueue(last);
+  };
+  queue.enqueue(outer);
+  done.wait();
+
+  // Tasks that did not fit were run right away, the others are still queued.
+  std::promise<void> flushPromise;
+  auto flushed = flushPromise.get_future();
+  QuantumTask flush = [p = std::move(flushPromise)]() mutable {
+    p.set_value();
+  };
+  queue.enqueue(flush);
+  flushed.wait();
+  EXPECT_EQ(count, 10);
+  EXPECT_THROW(QuantumExecutionQueue(3), std::invalid_argument);
+}
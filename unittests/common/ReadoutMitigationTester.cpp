@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cudaq/algorithms/readout_mitigation.h"
+#include <cmath>
+#include <gtest/gtest.h>
+
+namespace {
+const cudaq::readout_calibration calibration{{0.02, 0.05, 0.03},
+                                             {0.04, 0.08, 0.06}};
+
+/// Return the counts of `numShots` shots of the GHZ distribution read with the
+/// errors of `calibration`.
+cudaq::sample_result noisyGhzCounts(std::size_t numShots) {
+  cudaq::CountsDictionary counts;
+  for (std::size_t read = 0; read < 8; ++read) {
+    double prob = 0.0;
+    for (std::size_t state : {0, 7}) {
+      double p = 0.5;
+      for (std::size_t q = 0; q < 3; ++q) {
+        const bool r = (read >> q) & 1, s = (state >> q) & 1;
+        const double flip = s ? calibration.prob_0_given_1[q]
+                              : calibration.prob_1_given_0[q];
+        p *= r == s ? 1.0 - flip : flip;
+      }
+      prob += p;
+    }
+    std::string bits;
+    for (std::size_t q = 0; q < 3; ++q)
+      bits += (read >> q) & 1 ? '1' : '0';
+    counts[bits] = std::llround(prob * numShots);
+  }
+  return cudaq::sample_result(cudaq::ExecutionResult{counts});
+}
+} // namespace
+
+TEST(ReadoutMitigationTester, checkCalibrationFromCounts) {
+  cudaq::sample_result zeros(
+      cudaq::ExecutionResult{{{"00", 90}, {"10", 6}, {"01", 4}}});
+  cudaq::sample_result ones(cudaq::ExecutionResult{{{"11", 80}, {"01", 20}}});
+  auto fitted = cudaq::readout_calibration::from_counts(zeros, ones);
+  ASSERT_EQ(fitted.num_bits(), 2);
+  EXPECT_NEAR(fitted.prob_1_given_0[0], 0.06, 1e-12);
+  EXPECT_NEAR(fitted.prob_1_given_0[1], 0.04, 1e-12);
+  EXPECT_NEAR(fitted.prob_0_given_1[0], 0.2, 1e-12);
+  EXPECT_NEAR(fitted.prob_0_given_1[1], 0.0, 1e-12);
+}
+
+TEST(ReadoutMitigationTester, checkMitigation) {
+  auto counts = noisyGhzCounts(1000000);
+  for (auto method : {cudaq::readout_mitigation_method::least_squares,
+                      cudaq::readout_mitigation_method::iterative_bayesian}) {
+    cudaq::readout_mitigation_options options;
+    options.method = method;
+    options.max_iterations = 1000;
+    auto mitigated = cudaq::mitigate_readout(counts, calibration, options);
+    ASSERT_EQ(mitigated.size(), 8);
+    double total = 0.0;
+    for (auto &[bits, prob] : mitigated) {
+      const double expected = bits == "000" || bits == "111" ? 0.5 : 0.0;
+      EXPECT_NEAR(prob, expected, 1e-3) << bits;
+      total += prob;
+    }
+    EXPECT_NEAR(total, 1.0, 1e-6);
+  }
+
+  // Only coupling bit strings a single bit flip apart still removes most of
+  // the readout errors.
+  cudaq::readout_mitigation_options options;
+  options.max_hamming_distance = 1;
+  auto mitigated = cudaq::mitigate_readout(counts, calibration, options);
+  EXPECT_NEAR(mitigated["000"] + mitigated["111"], 1.0, 2e-2);
+
+  EXPECT_THROW(cudaq::mitigate_readout(counts, {{0.6}, {0.5}}),
+               std::runtime_error);
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/RemoteEndpointPool.h"
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+
+using namespace cudaq;
+
+namespace {
+// A pool of 3 endpoints whose health checks fail for the URLs in `down`.
+struct RemoteEndpointPoolTester : public ::testing::Test {
+  std::set<std::string> down;
+  std::size_t numChecks = 0;
+  RemoteEndpointPool pool{{"a", "b", "c"},
+                          [this](const std::string &url) {
+                            ++numChecks;
+                            return !down.count(url);
+                          },
+                          std::chrono::milliseconds(50)};
+};
+} // namespace
+
+TEST_F(RemoteEndpointPoolTester, checkPreferred) {
+  EXPECT_EQ(pool.acquire(1), 1);
+  EXPECT_EQ(pool.acquire(1), 1);
+  EXPECT_EQ(pool.getNumInFlight(1), 2);
+  EXPECT_TRUE(pool.release(1));
+  EXPECT_TRUE(pool.release(1));
+  EXPECT_EQ(pool.getNumInFlight(1), 0);
+  EXPECT_EQ(numChecks, 0);
+}
+
+TEST_F(RemoteEndpointPoolTester, checkRequestFailure) {
+  // A request failing on a healthy endpoint is not failed over.
+  EXPECT_EQ(pool.acquire(0), 0);
+  EXPECT_TRUE(pool.release(0, /*failed=*/true));
+  EXPECT_EQ(numChecks, 1);
+  EXPECT_TRUE(pool.isAvailable(0));
+}
+
+TEST_F(RemoteEndpointPoolTester, checkFailover) {
+  auto busy = pool.acquire(1);
+  ASSERT_EQ(busy, 1);
+  down.insert("a");
+  EXPECT_EQ(pool.acquire(0), 0);
+  EXPECT_FALSE(pool.release(0, /*failed=*/true));
+  EXPECT_FALSE(pool.isAvailable(0));
+  // The failed over request goes to the endpoint with the fewest requests in
+  // flight.
+  EXPECT_EQ(pool.acquire(0, {0}), 2);
+  EXPECT_TRUE(pool.release(2));
+  // The unhealthy endpoint is not checked again before the retry interval.
+  const auto checks = numChecks;
+  EXPECT_EQ(pool.acquire(0), 2);
+  EXPECT_TRUE(pool.release(2));
+  EXPECT_EQ(numChecks, checks);
+  // It is used again once it recovers.
+  down.clear();
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  EXPECT_TRUE(pool.isAvailable(0));
+  EXPECT_EQ(pool.acquire(0), 0);
+  EXPECT_EQ(numChecks, checks + 1);
+  EXPECT_TRUE(pool.release(0));
+  EXPECT_TRUE(pool.release(*busy));
+}
+
+TEST_F(RemoteEndpointPoolTester, checkAllDown) {
+  down = {"a", "b", "c"};
+  for (std::size_t i = 0; i < pool.size(); ++i) {
+    EXPECT_EQ(pool.acquire(i), i);
+    EXPECT_FALSE(pool.release(i, /*failed=*/true));
+  }
+  EXPECT_EQ(pool.acquire(0), std::nullopt);
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  EXPECT_EQ(pool.acquire(0), std::nullopt);
+  EXPECT_EQ(numChecks, 6);
+}
+
+TEST_F(RemoteEndpointPoolTester, checkShared) {
+  auto healthCheck = [](const std::string &) { return true; };
+  auto pool0 = RemoteEndpointPool::getShared({"x", "y"}, healthCheck,
+                                             std::chrono::milliseconds(50));
+  auto pool1 = RemoteEndpointPool::getShared({"x", "y"}, healthCheck,
+                                             std::chrono::milliseconds(50));
+  auto pool2 = RemoteEndpointPool::getShared({"x", "z"}, healthCheck,
+                                             std::chrono::milliseconds(50));
+  EXPECT_EQ(pool0, pool1);
+  EXPECT_NE(pool0, pool2);
+  EXPECT_EQ(pool0->size(), 2);
+  EXPECT_EQ(pool2->getUrl(1), "z");
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/ResultCache.h"
+#include "TemporaryDirectoryTester.h"
+#include <string>
+
+using namespace cudaq;
+
+namespace {
+class ResultCacheTester : public test::TemporaryDirectoryTester {
+protected:
+  ResultCacheTester() : TemporaryDirectoryTester("result-cache") {}
+
+  static sample_result makeResult() {
+    ExecutionResult global({{"00", 3}, {"11", 1}});
+    global.sequentialData = {"00", "11", "00", "00"};
+    ExecutionResult reg({{"1", 4}}, "r");
+    return sample_result(std::vector<ExecutionResult>{global, reg});
+  }
+};
+} // namespace
+
+TEST_F(ResultCacheTester, checkStoreAndLoad) {
+  const auto key = ResultCache::key("job payload");
+  EXPECT_EQ(key, ResultCache::key("job payload"));
+  EXPECT_NE(key, ResultCache::key("other job payload"));
+  {
+    ResultCache cache(directory, std::chrono::seconds(0));
+    EXPECT_FALSE(cache.load(key).has_value());
+    cache.store(key, makeResult());
+  }
+
+  // A new cache, e.g., in another process, finds the entry.
+  ResultCache cache(directory, std::chrono::seconds(0));
+  auto loaded = cache.load(key);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->count("00"), 3);
+  EXPECT_EQ(loaded->count("11"), 1);
+  EXPECT_EQ(loaded->sequential_data(),
+            (std::vector<std::string>{"00", "11", "00", "00"}));
+  EXPECT_EQ(loaded->count("1", "r"), 4);
+  EXPECT_FALSE(cache.load(ResultCache::key("other job payload")).has_value());
+}
+
+TEST_F(ResultCacheTester, checkExpirationAndBypass) {
+  const auto key = ResultCache::key("job payload");
+  ResultCache(directory, std::chrono::seconds(0)).store(key, makeResult());
+
+  // The entry is older than the time to live.
+  int fd;
+  ASSERT_FALSE(llvm::sys::fs::openFileForWrite(getPath(key + ".json"), fd,
+                                               llvm::sys::fs::CD_OpenExisting));
+  ASSERT_FALSE(llvm::sys::fs::setLastAccessAndModificationTime(
+      fd, std::chrono::system_clock::now() - std::chrono::hours(2)));
+  llvm::sys::fs::closeFile(fd);
+  EXPECT_FALSE(ResultCache(directory, std::chrono::hours(1)).load(key));
+  EXPECT_TRUE(ResultCache(directory, std::chrono::hours(3)).load(key));
+
+  // Bypassing ignores the entry, but storing refreshes it.
+  ResultCache bypassed(directory, std::chrono::hours(1), /*bypass=*/true);
+  EXPECT_FALSE(bypassed.load(key));
+  bypassed.store(key, makeResult());
+  EXPECT_TRUE(ResultCache(directory, std::chrono::hours(1)).load(key));
+}
@@ -0,0 +1,47 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace cudaq::test {
+
+/// @brief Fixture of the tests of on-disk stores (e.g., caches and archives).
+/// Each test gets a new empty directory, removed with its contents after the
+/// test.
+class TemporaryDirectoryTester : public ::testing::Test {
+protected:
+  /// @brief The name of the directory starts with `prefix`.
+  explicit TemporaryDirectoryTester(std::string prefix)
+      : prefix(std::move(prefix)) {}
+
+  void SetUp() override {
+    llvm::SmallString<128> path;
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory(prefix, path));
+    directory = path.str().str();
+  }
+
+  void TearDown() override { llvm::sys::fs::remove_directories(directory); }
+
+  /// @brief Return the path of the file `name` in the directory.
+  std::string getPath(const std::string &name) const {
+    llvm::SmallString<256> path(directory);
+    llvm::sys::path::append(path, name);
+    return path.str().str();
+  }
+
+  std::string directory;
+
+private:
+  std::string prefix;
+};
+
+} // namespace cudaq::test
@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "CUDAQTestUtils.h"
+#include <algorithm>
 #include <random>
 
 #include "cudaq/algorithm.h"
@@ -85,6 +86,65 @@ CUDAQ_TEST(H2MoleculeTester, checkHamiltonian) {
   }
 }
 
+CUDAQ_TEST(H2MoleculeTester, checkQubitMappings) {
+  cudaq::molecular_geometry geometry{{"H", {0., 0., 0.}},
+                                     {"H", {0., 0., .7474}}};
+  auto molecule = cudaq::create_molecule(geometry, "sto-3g", 1, 0);
+
+  // Jordan-Wigner reproduces the Hamiltonian mapped by OpenFermion.
+  auto jw = cudaq::jordan_wigner(molecule);
+  auto diff = jw - molecule.hamiltonian;
+  diff.trim(1e-6);
+  EXPECT_EQ(0, diff.num_terms());
+
+  // Bravyi-Kitaev gives a different, but isospectral, operator.
+  auto bk = cudaq::bravyi_kitaev(molecule);
+  EXPECT_NE(jw.to_string(), bk.to_string());
+  EXPECT_NEAR(-1.137, bk.to_matrix().minimal_eigenvalue().real(), 1e-3);
+  auto jwEigenvalues = jw.to_matrix().eigenvalues();
+  auto bkEigenvalues = bk.to_matrix().eigenvalues();
+  auto byRealPart = [](auto a, auto b) { return a.real() < b.real(); };
+  std::sort(jwEigenvalues.begin(), jwEigenvalues.end(), byRealPart);
+  std::sort(bkEigenvalues.begin(), bkEigenvalues.end(), byRealPart);
+  ASSERT_EQ(jwEigenvalues.size(), bkEigenvalues.size());
+  for (std::size_t i = 0; i < jwEigenvalues.size(); ++i)
+    EXPECT_NEAR(jwEigenvalues[i].real(), bkEigenvalues[i].real(), 1e-9);
+}
+
+CUDAQ_TEST(QubitMappingTester, checkHopping) {
+  // h_01 = h_10 = 1 over two spatial orbitals, no two-body terms
+  cudaq::one_body_integrals oneBody({2, 2});
+  cudaq::two_body_integals twoBody({2, 2, 2, 2});
+  for (std::size_t p = 0; p < 2; ++p)
+    for (std::size_t q = 0; q < 2; ++q) {
+      oneBody(p, q) = p == q ? 0.0 : 1.0;
+      for (std::size_t r = 0; r < 2; ++r)
+        for (std::size_t s = 0; s < 2; ++s)
+          twoBody(p, q, r, s) = 0.0;
+    }
+
+  auto jw = cudaq::jordan_wigner(oneBody, twoBody);
+  cudaq::spin_op expected =
+      0.5 * cudaq::spin_op::x(0) * cudaq::spin_op::z(1) * cudaq::spin_op::x(2) +
+      0.5 * cudaq::spin_op::y(0) * cudaq::spin_op::z(1) * cudaq::spin_op::y(2) +
+      0.5 * cudaq::spin_op::x(1) * cudaq::spin_op::z(2) * cudaq::spin_op::x(3) +
+      0.5 * cudaq::spin_op::y(1) * cudaq::spin_op::z(2) * cudaq::spin_op::y(3);
+  auto diff = jw - expected;
+  diff.trim(1e-12);
+  EXPECT_EQ(0, diff.num_terms());
+
+  // Bravyi-Kitaev is isospectral, up to the added constant.
+  auto bk = cudaq::bravyi_kitaev(oneBody, twoBody, 0.5);
+  auto bkEigenvalues = bk.to_matrix().eigenvalues();
+  auto jwEigenvalues = jw.to_matrix().eigenvalues();
+  auto byRealPart = [](auto a, auto b) { return a.real() < b.real(); };
+  std::sort(jwEigenvalues.begin(), jwEigenvalues.end(), byRealPart);
+  std::sort(bkEigenvalues.begin(), bkEigenvalues.end(), byRealPart);
+  ASSERT_EQ(jwEigenvalues.size(), bkEigenvalues.size());
+  for (std::size_t i = 0; i < jwEigenvalues.size(); ++i)
+    EXPECT_NEAR(jwEigenvalues[i].real() + 0.5, bkEigenvalues[i].real(), 1e-9);
+}
+
 CUDAQ_TEST(H2MoleculeTester, checkExpPauli) {
   auto kernel = [](double theta) __qpu__ {
     cudaq::qvector q(4);
@@ -175,6 +235,94 @@ CUDAQ_TEST(H2MoleculeTester, checkUCCSD) {
   }
 }
 
+CUDAQ_TEST(H2MoleculeTester, checkTapering) {
+  cudaq::molecular_geometry geometry{{"H", {0., 0., 0.}},
+                                     {"H", {0., 0., .7474}}};
+  auto molecule = cudaq::create_molecule(geometry, "sto-3g", 1, 0);
+
+  // The parities of the spin up and down electrons and the reflection
+  // symmetry of the molecule leave a single qubit.
+  auto tapered = cudaq::taper_hamiltonian(molecule);
+  EXPECT_EQ(3, tapered.symmetries.generators.size());
+  EXPECT_EQ(std::vector<bool>{true}, tapered.hartree_fock_state);
+  EXPECT_NEAR(-1.137,
+              tapered.hamiltonian.to_matrix().minimal_eigenvalue().real(),
+              1e-3);
+
+  auto ansatz = [](std::vector<double> thetas, std::size_t numQubits,
+                   std::size_t numElectrons) __qpu__ {
+    cudaq::qvector q(numQubits);
+    for (std::size_t i = 0; i < numElectrons; i++)
+      x(q[i]);
+    cudaq::uccsd(q, thetas, numElectrons);
+  };
+  auto taperedAnsatz = [](std::vector<double> thetas,
+                          std::vector<double> coefficients,
+                          std::vector<cudaq::pauli_word> words,
+                          std::vector<std::size_t> parameters) __qpu__ {
+    cudaq::qvector q(1);
+    x(q[0]);
+    cudaq::tapered_uccsd(q, thetas, coefficients, words, parameters);
+  };
+
+  // The single excitations break the reflection symmetry: only the double
+  // excitation remains.
+  auto rotations = cudaq::taper_uccsd(molecule.n_electrons, tapered);
+  const auto numQubits = 2 * molecule.n_orbitals;
+  const auto numParams =
+      cudaq::uccsd_num_parameters(molecule.n_electrons, numQubits);
+  std::vector<double> thetas(numParams, 0.0);
+  for (auto parameter : rotations.parameters)
+    thetas[parameter] = 0.3;
+  EXPECT_EQ(std::vector<std::size_t>(rotations.parameters.size(),
+                                     numParams - 1),
+            rotations.parameters);
+  double energy = cudaq::observe(ansatz, molecule.hamiltonian, thetas,
+                                 numQubits, molecule.n_electrons);
+  double taperedEnergy =
+      cudaq::observe(taperedAnsatz, tapered.hamiltonian, thetas,
+                     rotations.coefficients, rotations.words,
+                     rotations.parameters);
+  EXPECT_NEAR(energy, taperedEnergy, 1e-9);
+
+  cudaq::optimizers::cobyla optimizer;
+  auto [e, opt] =
+      optimizer.optimize(numParams, [&](std::vector<double> x) -> double {
+        return cudaq::observe(taperedAnsatz, tapered.hamiltonian, x,
+                              rotations.coefficients, rotations.words,
+                              rotations.parameters);
+      });
+  EXPECT_NEAR(-1.137, e, 1e-3);
+}
+
+CUDAQ_TEST(UCCSDTester, checkLowDepth) {
+  const std::size_t numQubits = 8, numElectrons = 4;
+  auto ansatz = [](std::vector<double> thetas, std::size_t numQubits,
+                   std::size_t numElectrons) __qpu__ {
+    cudaq::qvector q(numQubits);
+    for (std::size_t i = 0; i < numElectrons; i++)
+      x(q[i]);
+    cudaq::uccsd(q, thetas, numElectrons);
+  };
+  auto lowDepthAnsatz = [](std::vector<double> thetas, std::size_t numQubits,
+                           std::size_t numElectrons) __qpu__ {
+    cudaq::qvector q(numQubits);
+    for (std::size_t i = 0; i < numElectrons; i++)
+      x(q[i]);
+    cudaq::low_depth_uccsd(q, thetas, numElectrons);
+  };
+
+  const auto numParams = cudaq::uccsd_num_parameters(numElectrons, numQubits);
+  std::vector<double> thetas(numParams);
+  for (std::size_t i = 0; i < numParams; i++)
+    thetas[i] = 0.1 * i - 0.8;
+  auto state = cudaq::get_state(ansatz, thetas, numQubits, numElectrons);
+  auto lowDepthState =
+      cudaq::get_state(lowDepthAnsatz, thetas, numQubits, numElectrons);
+  EXPECT_NEAR(1.0, state.overlap(lowDepthState).real(), 1e-9);
+  EXPECT_NEAR(0.0, state.overlap(lowDepthState).imag(), 1e-9);
+}
+
 CUDAQ_TEST(H2MoleculeTester, checkHWE) {
 
   cudaq::molecular_geometry geometry{{"H", {0., 0., 0.}},
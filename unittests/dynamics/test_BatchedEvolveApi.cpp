@@ -500,3 +500,44 @@ TEST(BatchedEvolveAPITester, checkBatchSizeCheckSuperOperator) {
                       /*batchSize*/ 1));
   }
 }
+
+TEST(BatchedEvolveAPITester, checkHamiltonianInitialStateProduct) {
+  const cudaq::dimension_map dims = {{0, 2}};
+  const std::vector<double> frequencies = {0.1, 0.2};
+  std::vector<cudaq::product_op<cudaq::matrix_handler>> hamiltonians;
+  for (auto frequency : frequencies)
+    hamiltonians.emplace_back(2.0 * M_PI * frequency * cudaq::spin_op::x(0));
+  constexpr int numSteps = 10;
+  cudaq::schedule schedule(cudaq::linspace(0.0, 1.0, numSteps), {"t"});
+  // Different numbers of Hamiltonians and initial states: every Hamiltonian
+  // evolves every initial state.
+  const std::vector<double> signs = {1.0, -1.0, 1.0};
+  std::vector<cudaq::state> initialStates;
+  for (auto sign : signs)
+    initialStates.emplace_back(cudaq::state::from_data(
+        sign > 0.0 ? std::vector<std::complex<double>>{1.0, 0.0}
+                   : std::vector<std::complex<double>>{0.0, 1.0}));
+  cudaq::integrators::runge_kutta integrator(4, 0.01);
+  std::vector<decltype(cudaq::spin_op::z(0))> observables{
+      cudaq::spin_op::z(0)};
+  auto results = cudaq::evolve(
+      hamiltonians, dims, schedule, initialStates, integrator, {}, observables,
+      cudaq::IntermediateResultSave::ExpectationValue);
+  EXPECT_EQ(results.size(), frequencies.size() * signs.size());
+  for (std::size_t i = 0; i < frequencies.size(); ++i) {
+    for (std::size_t j = 0; j < signs.size(); ++j) {
+      const auto &result = results[i * signs.size() + j];
+      EXPECT_TRUE(result.expectation_values.has_value());
+      EXPECT_EQ(result.expectation_values.value().size(), numSteps);
+      int count = 0;
+      for (const auto &t : schedule) {
+        const auto &expVals = result.expectation_values.value()[count++];
+        EXPECT_EQ(expVals.size(), 1);
+        EXPECT_NEAR((double)expVals[0],
+                    signs[j] * std::cos(2 * 2.0 * M_PI * frequencies[i] *
+                                        t.real()),
+                    1e-3);
+      }
+    }
+  }
+}
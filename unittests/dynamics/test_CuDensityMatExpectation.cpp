@@ -226,3 +226,45 @@ TEST_F(CuDensityMatExpectationTest, checkBatchedState2) {
     }
   }
 }
+
+TEST_F(CuDensityMatExpectationTest, checkFusedCompute) {
+  const std::vector<int64_t> dims = {2, 10};
+  // Number operators of the qubit and of the cavity, and their product
+  std::vector<cudensitymatOperator_t> cudmOps;
+  for (const auto &op :
+       {cudaq::matrix_op::number(0), cudaq::matrix_op::number(1),
+        cudaq::matrix_op::number(0) * cudaq::matrix_op::number(1)})
+    cudmOps.emplace_back(cudaq::dynamics::Context::getCurrentContext()
+                             ->getOpConverter()
+                             .convertToCudensitymatOperator({}, op, dims));
+
+  CuDensityMatFusedExpectation expectations(handle_, cudmOps);
+  EXPECT_EQ(expectations.size(), cudmOps.size());
+
+  const int numStates = 4;
+  std::vector<CuDensityMatState> initialStates;
+  for (int i = 0; i < numStates; ++i) {
+    // The qubit is excited for the odd states, the cavity holds `i` photons.
+    std::vector<std::complex<double>> psi0_(dims[0] * dims[1], 0.0);
+    psi0_[i * dims[0] + i % 2] = 1.0;
+    initialStates.emplace_back(CuDensityMatState(
+        psi0_.size(), cudaq::dynamics::createArrayGpu(psi0_)));
+  }
+  std::vector<CuDensityMatState *> initialStatePtrs;
+  for (auto &state : initialStates)
+    initialStatePtrs.emplace_back(&state);
+  auto batchedState = CuDensityMatState::createBatchedState(
+      handle_, initialStatePtrs, dims, false);
+
+  // The workspace and the result buffer are reused across calls.
+  for (int test = 0; test < 3; ++test) {
+    const auto expVals = expectations.compute(batchedState->get_impl(), 0.0,
+                                              /*batchSize=*/numStates);
+    ASSERT_EQ(expVals.size(), cudmOps.size());
+    for (int i = 0; i < numStates; ++i) {
+      EXPECT_NEAR(std::abs(expVals[0][i] - 1.0 * (i % 2)), 0.0, 1e-12);
+      EXPECT_NEAR(std::abs(expVals[1][i] - 1.0 * i), 0.0, 1e-12);
+      EXPECT_NEAR(std::abs(expVals[2][i] - 1.0 * (i % 2) * i), 0.0, 1e-12);
+    }
+  }
+}
@@ -126,6 +126,23 @@ TEST_F(CuDensityMatStateTest, DestructorCleansUp) {
   });
 }
 
+TEST_F(CuDensityMatStateTest, ToHostRange) {
+  stateVectorData = {{1.0, 0.0}, {0.0, 2.0}, {3.0, 0.0}, {0.0, 4.0}};
+  CuDensityMatState state(stateVectorData.size(),
+                          cudaq::dynamics::createArrayGpu(stateVectorData));
+  std::vector<std::complex<double>> slice(2);
+  state.toHostRange(slice.data(), 1, slice.size());
+  EXPECT_EQ(slice[0], stateVectorData[1]);
+  EXPECT_EQ(slice[1], stateVectorData[2]);
+
+  std::vector<std::complex<double>> all(stateVectorData.size());
+  state.toHostRange(all.data(), 0, all.size());
+  EXPECT_EQ(all, stateVectorData);
+
+  EXPECT_THROW(state.toHostRange(slice.data(), 3, slice.size()),
+               std::runtime_error);
+}
+
 TEST_F(CuDensityMatStateTest, InitializeWithEmptyRawData) {
   std::vector<std::complex<double>> emptyData;
 
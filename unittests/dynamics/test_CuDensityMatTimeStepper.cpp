@@ -198,6 +198,44 @@ TEST_F(CuDensityMatTimeStepperTest, CheckScalarCallback) {
   HANDLE_CUDM_ERROR(cudensitymatDestroyOperator(cudmOp));
 }
 
+TEST_F(CuDensityMatTimeStepperTest, CheckDeviceScalarCallback) {
+  const std::vector<std::complex<double>> initialState = {
+      {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}};
+  const std::vector<int64_t> dims = {4};
+  auto inputState = cudaq::state::from_data(initialState);
+  auto *simState = cudaq::state_helper::getSimulationState(&inputState);
+  auto *castSimState = dynamic_cast<CuDensityMatState *>(simState);
+  EXPECT_TRUE(castSimState != nullptr);
+  castSimState->initialize_cudm(handle_, dims, /*batchSize=*/1);
+  const std::string paramName = "alpha";
+  const std::complex<double> paramValue{1.5, 0.0};
+  std::unordered_map<std::string, std::complex<double>> params{
+      {paramName, paramValue}};
+
+  // The coefficient has a closed form, hence is evaluated on the device.
+  const auto function = cudaq::time_function::piecewise_linear(
+      {0.0, 1.0, 2.0}, {0.0, std::complex<double>(2.0, 1.0), 4.0}, paramName);
+  cudaq::product_op<cudaq::matrix_handler> op_t =
+      2.0 * cudaq::scalar_operator(function) * cudaq::boson_op::create(0);
+  ASSERT_NE(op_t.get_coefficient().get_time_function(), nullptr);
+  cudaq::sum_op<cudaq::matrix_handler> op(op_t);
+  auto cudmOp = cudaq::dynamics::Context::getCurrentContext()
+                    ->getOpConverter()
+                    .convertToCudensitymatOperator(params, op, dims);
+  auto time_stepper =
+      std::make_unique<CuDensityMatTimeStepper>(handle_, cudmOp);
+  auto outputState = time_stepper->compute(inputState, 1.0, params);
+  std::vector<std::complex<double>> outputStateVec(4);
+  outputState.to_host(outputStateVec.data(), outputStateVec.size());
+  const std::vector<std::complex<double>> expectedOutputState = {
+      {0.0, 0.0}, 2.0 * function(paramValue.real()), {0.0, 0.0}, {0.0, 0.0}};
+
+  for (std::size_t i = 0; i < expectedOutputState.size(); ++i) {
+    EXPECT_TRUE(std::abs(expectedOutputState[i] - outputStateVec[i]) < 1e-12);
+  }
+  HANDLE_CUDM_ERROR(cudensitymatDestroyOperator(cudmOp));
+}
+
 TEST_F(CuDensityMatTimeStepperTest, CheckTensorCallback) {
   const std::vector<std::complex<double>> initialState = {{1.0, 0.0},
                                                           {1.0, 0.0}};
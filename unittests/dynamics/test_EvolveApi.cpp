@@ -569,3 +569,48 @@ TEST(EvolveAPITester, checkCallbackTensorOp) {
     EXPECT_NEAR((double)expVals[0], theoryResults[count++], 1e-3);
   }
 }
+
+TEST(EvolveAPITester, checkSink) {
+  const cudaq::dimension_map dims = {{0, 2}};
+  auto ham = 2.0 * M_PI * 0.1 * cudaq::spin_op::x(0);
+  constexpr int numSteps = 10;
+  cudaq::schedule schedule(cudaq::linspace(0.0, 1.0, numSteps), {"t"});
+  auto initialState =
+      cudaq::state::from_data(std::vector<std::complex<double>>{1.0, 0.0});
+  cudaq::integrators::runge_kutta integrator(4, 0.001);
+  std::vector<cudaq::evolve_step_result> steps;
+  const cudaq::evolve_sink sink = [&](const cudaq::evolve_step_result &step) {
+    steps.emplace_back(step);
+  };
+  auto result = cudaq::evolve(ham, dims, schedule, initialState, integrator, {},
+                              {cudaq::spin_op::z(0)},
+                              cudaq::IntermediateResultSave::None,
+                              std::nullopt, sink);
+  // Only the final results are stored, but all of them are streamed.
+  EXPECT_EQ(result.expectation_values.value().size(), 1);
+  EXPECT_EQ(steps.size(), numSteps);
+  int count = 0;
+  for (const auto &t : schedule) {
+    const auto &step = steps[count];
+    EXPECT_EQ(step.batch_index, 0);
+    EXPECT_EQ(step.step_index, count++);
+    EXPECT_NEAR(step.time, t.real(), 1e-12);
+    EXPECT_EQ(step.expectation_values.size(), 1);
+    EXPECT_NEAR(step.expectation_values[0],
+                std::cos(2 * 2.0 * M_PI * 0.1 * t.real()), 1e-3);
+    // The Z expectation value computed from the streamed state data.
+    ASSERT_EQ(step.state.size(), 2);
+    EXPECT_NEAR(std::norm(step.state[0]) - std::norm(step.state[1]),
+                step.expectation_values[0], 1e-9);
+  }
+
+  // Only keep the last steps.
+  cudaq::ring_buffer_sink lastSteps(3);
+  cudaq::evolve(ham, dims, schedule, initialState, integrator, {},
+                {cudaq::spin_op::z(0)}, cudaq::IntermediateResultSave::None,
+                std::nullopt, lastSteps);
+  const auto kept = lastSteps.get_results();
+  ASSERT_EQ(kept.size(), 3);
+  for (std::size_t i = 0; i < kept.size(); ++i)
+    EXPECT_EQ(kept[i].step_index, numSteps - 3 + i);
+}
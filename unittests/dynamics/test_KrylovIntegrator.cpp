@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CuDensityMatState.h"
+#include "CuDensityMatUtils.h"
+#include "cudaq/algorithms/integrator.h"
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace cudaq;
+
+namespace {
+cudaq::schedule makeSchedule(double tFinal, std::size_t numDataPoints) {
+  std::vector<std::complex<double>> steps;
+  for (double t : cudaq::linspace(0.0, tFinal, numDataPoints)) {
+    steps.emplace_back(t, 0.0);
+  }
+  return cudaq::schedule(
+      steps, {"t"},
+      [](const std::string &, const std::complex<double> &val) { return val; });
+}
+} // namespace
+
+class KrylovIntegratorTest : public ::testing::Test {
+protected:
+  cudensitymatHandle_t handle_;
+
+  void SetUp() override { HANDLE_CUDM_ERROR(cudensitymatCreate(&handle_)); }
+
+  void TearDown() override { HANDLE_CUDM_ERROR(cudensitymatDestroy(handle_)); }
+
+  cudaq::state initialState(const std::vector<int64_t> &dims) {
+    const std::vector<std::complex<double>> initialStateVec = {{1.0, 0.0},
+                                                               {0.0, 0.0}};
+    auto state = cudaq::state::from_data(initialStateVec);
+    auto *castSimState = dynamic_cast<CuDensityMatState *>(
+        cudaq::state_helper::getSimulationState(&state));
+    EXPECT_TRUE(castSimState != nullptr);
+    castSimState->initialize_cudm(handle_, dims, /*batchSize=*/1);
+    return state;
+  }
+};
+
+TEST_F(KrylovIntegratorTest, CheckEvolve) {
+  const std::vector<int64_t> dims = {2};
+  const double omega = 2.0 * M_PI * 0.1;
+  cudaq::product_op<cudaq::matrix_handler> ham1 = omega * cudaq::spin_op::x(0);
+  SystemDynamics system(dims, cudaq::sum_op<cudaq::matrix_handler>(ham1));
+  constexpr std::size_t numDataPoints = 11;
+
+  cudaq::integrators::krylov integrator(1e-12);
+  integrator.setState(initialState(dims), 0.0);
+  cudaq::integrator_helper::init_system_dynamics(
+      integrator, system, makeSchedule(numDataPoints - 1, numDataPoints));
+  std::vector<std::complex<double>> outputStateVec(2);
+  for (std::size_t i = 1; i < numDataPoints; ++i) {
+    integrator.integrate(i);
+    auto [t, state] = integrator.getState();
+    EXPECT_NEAR(t, i, 1e-12);
+    state.to_host(outputStateVec.data(), outputStateVec.size());
+    // The Krylov subspace of a qubit is exact: only rounding errors remain.
+    EXPECT_NEAR(outputStateVec[0].real(), std::cos(omega * t), 1e-10);
+    EXPECT_NEAR(std::norm(outputStateVec[0]) + std::norm(outputStateVec[1]),
+                1.0, 1e-10);
+  }
+}
+
+TEST_F(KrylovIntegratorTest, RejectTimeDependentSystem) {
+  const std::vector<int64_t> dims = {2};
+  auto coefficient = cudaq::scalar_operator(
+      [](const std::unordered_map<std::string, std::complex<double>> &params) {
+        return std::cos(params.at("t"));
+      });
+  cudaq::product_op<cudaq::matrix_handler> ham1 =
+      coefficient * cudaq::spin_op::x(0);
+  SystemDynamics system(dims, cudaq::sum_op<cudaq::matrix_handler>(ham1));
+
+  cudaq::integrators::krylov integrator;
+  integrator.setState(initialState(dims), 0.0);
+  cudaq::integrator_helper::init_system_dynamics(integrator, system,
+                                                 makeSchedule(1.0, 11));
+  EXPECT_THROW(integrator.integrate(0.1), std::invalid_argument);
+}
+
+TEST_F(KrylovIntegratorTest, InvalidArguments) {
+  EXPECT_THROW(cudaq::integrators::krylov(0.0), std::invalid_argument);
+  EXPECT_THROW(cudaq::integrators::krylov(1e-10, 1), std::invalid_argument);
+}
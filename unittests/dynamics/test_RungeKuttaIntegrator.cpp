@@ -275,3 +275,93 @@ TEST_F(RungeKuttaIntegratorTest, AccuracyComparison) {
   EXPECT_LT(error_order2, 0.01)
       << "Order 2 error too large for a proper 2nd-order method";
 }
+
+// The adaptive integrator reaches every scheduled time point exactly and its
+// accuracy follows the requested tolerances.
+TEST_F(RungeKuttaIntegratorTest, DormandPrinceTolerance) {
+  const std::vector<std::complex<double>> initialStateVec = {{1.0, 0.0},
+                                                             {0.0, 0.0}};
+  const std::vector<int64_t> dims = {2};
+  const double omega = 2.0 * M_PI * 0.1;
+  auto spin_op_x = cudaq::spin_op::x(0);
+  cudaq::product_op<cudaq::matrix_handler> ham1 = omega * spin_op_x;
+  cudaq::sum_op<cudaq::matrix_handler> ham(ham1);
+  SystemDynamics system(dims, ham);
+  constexpr std::size_t numDataPoints = 11;
+
+  for (double tol : {1e-4, 1e-8}) {
+    cudaq::integrators::dormand_prince integrator(tol, tol);
+    auto initialState = cudaq::state::from_data(initialStateVec);
+    auto *simState = cudaq::state_helper::getSimulationState(&initialState);
+    auto *castSimState = dynamic_cast<CuDensityMatState *>(simState);
+    ASSERT_TRUE(castSimState != nullptr);
+    castSimState->initialize_cudm(handle_, dims, /*batchSize=*/1);
+    integrator.setState(initialState, 0.0);
+    std::vector<std::complex<double>> steps;
+    for (double t : cudaq::linspace(0.0, 1.0 * (numDataPoints - 1),
+                                    numDataPoints)) {
+      steps.emplace_back(t, 0.0);
+    }
+    cudaq::schedule schedule(
+        steps, {"t"}, [](const std::string &, const std::complex<double> &val) {
+          return val;
+        });
+    cudaq::integrator_helper::init_system_dynamics(integrator, system,
+                                                   schedule);
+    std::vector<std::complex<double>> outputStateVec(2);
+    for (std::size_t i = 1; i < numDataPoints; ++i) {
+      integrator.integrate(i);
+      auto [t, state] = integrator.getState();
+      EXPECT_NEAR(t, i, 1e-12);
+      state.to_host(outputStateVec.data(), outputStateVec.size());
+      // Analytical results: the global error is within a few multiples of the
+      // local tolerance for this smooth problem.
+      EXPECT_NEAR(outputStateVec[0].real(), std::cos(omega * t), 100 * tol);
+      EXPECT_NEAR(std::norm(outputStateVec[0]) + std::norm(outputStateVec[1]),
+                  1.0, 100 * tol);
+    }
+  }
+}
+
+TEST_F(RungeKuttaIntegratorTest, DormandPrinceInvalidTolerance) {
+  EXPECT_THROW(cudaq::integrators::dormand_prince(0.0, 0.0),
+               std::invalid_argument);
+  EXPECT_THROW(cudaq::integrators::dormand_prince(-1e-6, 1e-8),
+               std::invalid_argument);
+  EXPECT_THROW(cudaq::integrators::dormand_prince(1e-6, 1e-8, 0.0),
+               std::invalid_argument);
+}
+
+TEST_F(RungeKuttaIntegratorTest, ParametersEvaluatedOncePerStage) {
+  const std::vector<int64_t> dims = {2};
+  auto ham = cudaq::sum_op<cudaq::matrix_handler>(
+      cudaq::scalar_operator(
+          [](const cudaq::parameter_map &params) { return params.at("t"); }) *
+      cudaq::spin_op::x(0));
+  SystemDynamics system(dims, ham);
+  cudaq::integrators::runge_kutta integrator(4, 0.25);
+  auto initialState = cudaq::state::from_data(
+      std::vector<std::complex<double>>{{1.0, 0.0}, {0.0, 0.0}});
+  auto *castSimState = dynamic_cast<CuDensityMatState *>(
+      cudaq::state_helper::getSimulationState(&initialState));
+  ASSERT_TRUE(castSimState != nullptr);
+  castSimState->initialize_cudm(handle_, dims, /*batchSize=*/1);
+  integrator.setState(initialState, 0.0);
+
+  std::size_t numCalls = 0;
+  cudaq::schedule schedule(
+      {0.0, 1.0, 2.0}, {"t"},
+      [&](const std::string &, const std::complex<double> &t) {
+        ++numCalls;
+        return t;
+      });
+  cudaq::integrator_helper::init_system_dynamics(integrator, system, schedule);
+  integrator.integrate(1.0);
+  integrator.integrate(2.0);
+  // The stages of the steps of 0.25 are at the multiples of 0.125, and the
+  // end of a step is the start of the next one.
+  EXPECT_EQ(numCalls, 17u);
+  EXPECT_EQ(schedule.get_parameter_values(0.125).at("t"),
+            std::complex<double>(0.125));
+  EXPECT_EQ(numCalls, 17u);
+}
@@ -1594,3 +1594,97 @@ CUDAQ_TEST(BuilderTester, checkExplicitMeasurements) {
     }
   }
 }
+
+CUDAQ_TEST(BuilderTester, checkSampleStream) {
+  auto kernel = cudaq::make_kernel();
+  auto q = kernel.qalloc(3);
+  kernel.h(q[0]);
+  kernel.x<cudaq::ctrl>(q[0], q[1]);
+  kernel.x<cudaq::ctrl>(q[1], q[2]);
+  kernel.mz(q);
+
+  cudaq::sample_stream_options options{.shots = 1000, .chunk_shots = 300};
+  std::vector<std::size_t> chunkSizes;
+  std::size_t ones = 0;
+  auto counts = cudaq::sample_stream(
+      options,
+      [&](const cudaq::PackedShots &shots) {
+        chunkSizes.push_back(shots.size());
+        EXPECT_EQ(shots.numBits, 3);
+        for (std::size_t s = 0; s < shots.size(); ++s) {
+          EXPECT_TRUE(shots.to_string(s) == "000" ||
+                      shots.to_string(s) == "111");
+          ones += shots.bit(s, 0);
+        }
+      },
+      kernel);
+  EXPECT_EQ(chunkSizes, (std::vector<std::size_t>{300, 300, 300, 100}));
+  EXPECT_EQ(counts.get_total_shots(), 1000);
+  EXPECT_EQ(counts.count("111"), ones);
+  EXPECT_EQ(counts.count("000") + counts.count("111"), 1000);
+  EXPECT_TRUE(counts.sequential_data().empty());
+
+  // Only keep the counts.
+  auto histogram = cudaq::sample_stream(options, {}, kernel);
+  EXPECT_EQ(histogram.get_total_shots(), 1000);
+  EXPECT_EQ(histogram.size(), 2);
+
+  options.chunk_shots = 0;
+  EXPECT_ANY_THROW(cudaq::sample_stream(options, {}, kernel));
+}
+
+CUDAQ_TEST(BuilderTester, checkAppendGates) {
+  auto kernel = cudaq::make_kernel();
+  auto q = kernel.qalloc(3);
+  std::vector<cudaq::builder_gate> gates{
+      {"h", {}, {}, {0}}, {"x", {}, {0}, {1}}, {"x", {}, {1}, {2}}};
+  // A full turn around X and back again leaves the state unchanged.
+  for (std::size_t i = 0; i < 3; ++i) {
+    gates.push_back({"rx", {M_PI}, {}, {i}});
+    gates.push_back({"rx", {M_PI}, {}, {i}, true});
+  }
+  gates.push_back({"swap", {}, {}, {0, 2}});
+  kernel.append_gates(q, gates);
+  kernel.mz(q);
+  auto counts = cudaq::sample(kernel);
+  EXPECT_EQ(counts.size(), 2);
+  EXPECT_EQ(counts.count("000") + counts.count("111"), 1000);
+
+  EXPECT_ANY_THROW(kernel.append_gates(q, {{"foo", {}, {}, {0}}}));
+  EXPECT_ANY_THROW(kernel.append_gates(q, {{"rx", {}, {}, {0}}}));
+  EXPECT_ANY_THROW(kernel.append_gates(q, {{"h", {}, {}, {3}}}));
+}
+
+CUDAQ_TEST(BuilderTester, checkRebuiltKernels) {
+  auto build = [](bool flip) {
+    auto kernel = cudaq::make_kernel<double>();
+    auto &theta = kernel.getArguments()[0];
+    auto q = kernel.qalloc(2);
+    if (flip)
+      kernel.x(q[1]);
+    kernel.ry(theta, q[0]);
+    kernel.x<cudaq::ctrl>(q[0], q[1]);
+    kernel.mz(q);
+    return kernel;
+  };
+  // Kernels rebuilt with the same structure share their compiled code, but
+  // run with their own arguments.
+  auto first = build(false);
+  auto counts = cudaq::sample(first, 0.);
+  EXPECT_EQ(counts.count("00"), 1000);
+  auto second = build(false);
+  counts = cudaq::sample(second, M_PI);
+  EXPECT_EQ(counts.count("11"), 1000);
+  auto other = build(true);
+  counts = cudaq::sample(other, 0.);
+  EXPECT_EQ(counts.count("01"), 1000);
+
+  // Changing a rebuilt kernel does not change the other one.
+  auto q = second.qalloc();
+  second.x(q);
+  second.mz(q);
+  counts = cudaq::sample(second, 0.);
+  EXPECT_EQ(counts.count("001"), 1000);
+  counts = cudaq::sample(first, M_PI);
+  EXPECT_EQ(counts.count("11"), 1000);
+}
@@ -112,3 +112,25 @@ CUDAQ_TEST(LatexDrawTester, checkOps) {
   EXPECT_EQ(expected_str.size(), produced_str.size());
   EXPECT_EQ(expected_str, produced_str);
 }
+
+CUDAQ_TEST(DrawTester, checkTraceCache) {
+  cudaq::__internal__::clearTraceCache();
+  auto rotation = [](double angle, int n) __qpu__ {
+    cudaq::qvector q(n);
+    rx(angle, q[n - 1]);
+  };
+
+  // The trace of a stateless kernel is cached per argument values.
+  const auto first = cudaq::contrib::draw(rotation, 0.5, 2);
+  std::size_t argsHash = 0;
+  cudaq::__internal__::hashTraceArgument(argsHash, 0.5);
+  cudaq::__internal__::hashTraceArgument(argsHash, 2);
+  auto cached = cudaq::__internal__::getCachedTrace(
+      typeid(decltype(rotation)).name(), argsHash);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cudaq::__internal__::draw(*cached), first);
+  EXPECT_EQ(cudaq::contrib::draw(rotation, 0.5, 2), first);
+  EXPECT_NE(cudaq::contrib::draw(rotation, 0.5, 3), first);
+  EXPECT_NE(cudaq::contrib::draw(rotation, 0.25, 2), first);
+  cudaq::__internal__::clearTraceCache();
+}
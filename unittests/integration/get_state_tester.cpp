@@ -169,6 +169,67 @@ CUDAQ_TEST(GetStateTester, checkOverlapFromHostVector) {
 }
 #endif
 
+#ifdef CUDAQ_BACKEND_TENSORNET
+CUDAQ_TEST(GetStateTester, checkBatchedAmplitudes) {
+  // Too large to be contracted into a state vector.
+  constexpr int numQubits = 40;
+  auto ghz = [](int n) __qpu__ {
+    cudaq::qvector q(n);
+    h(q[0]);
+    for (int i = 0; i < n - 1; ++i)
+      x<cudaq::ctrl>(q[i], q[i + 1]);
+  };
+  auto state = cudaq::get_state(ghz, numQubits);
+  const std::vector<int> zeros(numQubits, 0);
+  const std::vector<int> ones(numQubits, 1);
+
+  // Basis states that differ on all qubits.
+  auto oneFlipped = zeros;
+  oneFlipped[numQubits / 2] = 1;
+  auto amplitudes = state.amplitudes({zeros, ones, oneFlipped});
+  EXPECT_EQ(amplitudes.size(), 3);
+  EXPECT_NEAR(M_SQRT1_2, amplitudes[0].real(), 1e-3);
+  EXPECT_NEAR(M_SQRT1_2, amplitudes[1].real(), 1e-3);
+  EXPECT_NEAR(0.0, std::abs(amplitudes[2]), 1e-3);
+
+  // Basis states that only differ on a few qubits.
+  auto twoFlipped = ones;
+  twoFlipped[0] = 0;
+  twoFlipped[numQubits - 1] = 0;
+  auto oneZero = ones;
+  oneZero[5] = 0;
+  amplitudes = state.amplitudes({twoFlipped, ones, oneZero});
+  EXPECT_EQ(amplitudes.size(), 3);
+  EXPECT_NEAR(0.0, std::abs(amplitudes[0]), 1e-3);
+  EXPECT_NEAR(M_SQRT1_2, amplitudes[1].real(), 1e-3);
+  EXPECT_NEAR(0.0, std::abs(amplitudes[2]), 1e-3);
+  EXPECT_NEAR(M_SQRT1_2, state.amplitude(ones).real(), 1e-3);
+}
+#endif
+
+CUDAQ_TEST(GetStateTester, checkFromSparseData) {
+  constexpr std::size_t numQubits = 5;
+  cudaq::sparse_state_data sparseData{
+      numQubits, {{0b00000, M_SQRT1_2}, {0b10110, {0., M_SQRT1_2}}}};
+  auto sparseState = cudaq::state::from_data(sparseData);
+  EXPECT_EQ(numQubits, sparseState.get_num_qubits());
+
+  std::vector<std::complex<cudaq::real>> hostStateData(1 << numQubits);
+  hostStateData[0b00000] = M_SQRT1_2;
+  hostStateData[0b10110] = {0., M_SQRT1_2};
+  auto hostState = cudaq::state::from_data(hostStateData);
+  EXPECT_NEAR(1.0, std::abs(sparseState.overlap(hostState)), 1e-3);
+#ifndef CUDAQ_BACKEND_DM
+  EXPECT_NEAR(M_SQRT1_2, sparseState.amplitude({0, 1, 1, 0, 1}).imag(), 1e-3);
+  EXPECT_NEAR(0.0, std::abs(sparseState.amplitude({1, 1, 1, 0, 1})), 1e-3);
+#endif
+
+  cudaq::sparse_state_data outOfRange{2, {{4, 1.}}};
+  EXPECT_ANY_THROW(cudaq::state::from_data(outOfRange));
+  cudaq::sparse_state_data repeated{2, {{1, M_SQRT1_2}, {1, M_SQRT1_2}}};
+  EXPECT_ANY_THROW(cudaq::state::from_data(repeated));
+}
+
 CUDAQ_TEST(GetStateTester, checkKron) {
   auto force_kron = [](const std::vector<std::complex<cudaq::real>> &vec)
                         __qpu__ {
@@ -110,3 +110,75 @@ CUDAQ_TEST(GHZSampleTester, checkBroadcastRepeatability) {
   EXPECT_EQ(allCounts1, allCounts2); // these should match
   EXPECT_NE(allCounts1, allCounts3); // these should NOT match
 }
+
+CUDAQ_TEST(GHZSampleTester, checkBroadcastParameters) {
+  // The executions share their gate sequence, but not their gate matrices, so
+  // that simulators batching them must keep each result with its arguments.
+  auto kernel = [](double theta) __qpu__ {
+    cudaq::qvector q(3);
+    ry(theta, q[0]);
+    x<cudaq::ctrl>(q[0], q[1]);
+    x(q[2]);
+    mz(q);
+  };
+  std::vector<double> thetas{0., M_PI / 3., M_PI / 2., 2. * M_PI / 3., M_PI};
+
+  for (const char *batched : {"1", "0"}) {
+    setenv("CUDAQ_BATCHED_SAMPLING", batched, 1);
+    cudaq::set_random_seed(13);
+    auto allCounts = cudaq::sample(4000, kernel, cudaq::make_argset(thetas));
+    ASSERT_EQ(allCounts.size(), thetas.size());
+    for (std::size_t i = 0; i < thetas.size(); ++i) {
+      EXPECT_EQ(allCounts[i].get_total_shots(), 4000);
+      const double probOne = std::pow(std::sin(thetas[i] / 2.), 2);
+      EXPECT_NEAR(allCounts[i].probability("111"), probOne, .05);
+      EXPECT_NEAR(allCounts[i].probability("001"), 1. - probOne, .05);
+    }
+  }
+  unsetenv("CUDAQ_BATCHED_SAMPLING");
+}
+
+CUDAQ_TEST(GHZSampleTester, checkPerfCounters) {
+  cudaq::set_perf_counters_enabled(true);
+  auto counts = cudaq::sample(ghz{}, 5);
+  cudaq::set_perf_counters_enabled(false);
+  EXPECT_EQ(counts.size(), 2);
+
+  auto counters = cudaq::get_perf_counters();
+  EXPECT_EQ(counters.gates["h"], 1);
+  EXPECT_EQ(counters.gates["x"], 4);
+  EXPECT_EQ(counters.gates_by_arity[1], 1);
+  EXPECT_EQ(counters.gates_by_arity[2], 4);
+  EXPECT_GE(counters.flushes, 1);
+  EXPECT_EQ(counters.noise_channels, 0);
+  EXPECT_GT(counters.sample_seconds, 0.);
+
+  // Counters are not collected while disabled.
+  cudaq::sample(ghz{}, 3);
+  EXPECT_EQ(cudaq::get_perf_counters().gates["x"], 4);
+}
+
+CUDAQ_TEST(GHZSampleTester, checkMeasureSubset) {
+  // Only some of the qubits are measured, with unmeasured qubits between and
+  // after them.
+  auto kernel = []() __qpu__ {
+    cudaq::qvector q(5);
+    x(q[0]);
+    h(q[1]);
+    x<cudaq::ctrl>(q[1], q[2]);
+    x<cudaq::ctrl>(q[2], q[4]);
+    mz(q[1]);
+    mz(q[4]);
+  };
+
+  cudaq::set_random_seed(13);
+  auto counts = cudaq::sample(2000, kernel);
+  counts.dump();
+  std::size_t counter = 0;
+  for (auto &[bits, count] : counts) {
+    counter += count;
+    EXPECT_TRUE(bits == "00" || bits == "11");
+  }
+  EXPECT_EQ(counter, 2000);
+  EXPECT_NEAR(counts.probability("11"), .5, .05);
+}
@@ -8,6 +8,7 @@
 
 #include "CUDAQTestUtils.h"
 #include <cudaq/algorithm.h>
+#include <cudaq/algorithms/gradients/adjoint.h>
 #include <cudaq/algorithms/gradients/central_difference.h>
 #include <cudaq/optimizers.h>
 
@@ -77,6 +78,92 @@ CUDAQ_TEST(GradientTester, checkSimple) {
   EXPECT_NEAR(-2.0453, opt_val, 1e-3);
 }
 
+CUDAQ_TEST(GradientTester, checkAdjoint) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+  cudaq::spin_op h3 = h + 9.625 - 9.625 * cudaq::spin_op::z(2) -
+                      3.913119 * cudaq::spin_op::x(1) * cudaq::spin_op::x(2) -
+                      3.913119 * cudaq::spin_op::y(1) * cudaq::spin_op::y(2);
+  auto argsMapper = [](std::vector<double> x) {
+    return std::make_tuple(x[0], x[1]);
+  };
+
+  // The adjoint gradient matches the central difference, the angle of the
+  // second `ry` on qubit 1 depending on the negated parameter.
+  cudaq::gradients::adjoint adjoint(deuteron_n3_ansatz{}, argsMapper);
+  cudaq::gradients::central_difference reference(deuteron_n3_ansatz{},
+                                                 argsMapper);
+  for (const auto &x : {std::vector<double>{0.1, 0.2},
+                        std::vector<double>{-0.7, 1.3}}) {
+    double e = cudaq::observe(deuteron_n3_ansatz{}, h3, x[0], x[1]);
+    std::vector<double> dx(2), expected(2);
+    adjoint.compute(x, dx, h3, e);
+    reference.compute(x, expected, h3, e);
+    EXPECT_NEAR(dx[0], expected[0], 1e-4);
+    EXPECT_NEAR(dx[1], expected[1], 1e-4);
+  }
+
+  cudaq::optimizers::lbfgs optimizer_lbfgs;
+  optimizer_lbfgs.max_line_search_trials = 3;
+  auto [opt_val, optp] = optimizer_lbfgs.optimize(
+      2, [&](const std::vector<double> &x, std::vector<double> &grad_vec) {
+        double e = cudaq::observe(deuteron_n3_ansatz{}, h3, x[0], x[1]);
+        adjoint.compute(x, grad_vec, h3, e);
+        return e;
+      });
+  EXPECT_NEAR(-2.0453, opt_val, 1e-3);
+}
+
+struct deuteron_n3_extended {
+  void operator()(double x0, double x1, double theta,
+                  cudaq::pauli_word word) __qpu__ {
+    cudaq::qvector q(3);
+    x(q[0]);
+    ry(x0, q[1]);
+    ry(x1, q[2]);
+    x<cudaq::ctrl>(q[2], q[0]);
+    x<cudaq::ctrl>(q[0], q[1]);
+    ry(-x0, q[1]);
+    x<cudaq::ctrl>(q[0], q[1]);
+    x<cudaq::ctrl>(q[1], q[0]);
+    exp_pauli(theta, q, word);
+  }
+};
+
+CUDAQ_TEST(GradientTester, checkPoolGradients) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+  cudaq::spin_op h3 = h + 9.625 - 9.625 * cudaq::spin_op::z(2) -
+                      3.913119 * cudaq::spin_op::x(1) * cudaq::spin_op::x(2) -
+                      3.913119 * cudaq::spin_op::y(1) * cudaq::spin_op::y(2);
+
+  // The gradient of each pool operator matches the central difference of the
+  // ansatz extended with its exponential.
+  const std::vector<std::string> words = {"XYI", "IXY", "YZX", "ZZZ"};
+  std::vector<cudaq::spin_op> pool;
+  for (const auto &word : words)
+    pool.emplace_back(cudaq::spin_op::from_word(word));
+  const double x0 = 0.3, x1 = -0.2;
+  const auto gradients =
+      cudaq::pool_gradients(deuteron_n3_ansatz{}, h3, pool, x0, x1);
+  ASSERT_EQ(gradients.size(), pool.size());
+  const double step = 1e-4;
+  for (std::size_t k = 0; k < words.size(); ++k) {
+    const cudaq::pauli_word word(words[k]);
+    const double plus =
+        cudaq::observe(deuteron_n3_extended{}, h3, x0, x1, step, word);
+    const double minus =
+        cudaq::observe(deuteron_n3_extended{}, h3, x0, x1, -step, word);
+    EXPECT_NEAR(gradients[k], (plus - minus) / (2 * step), 1e-4);
+  }
+  // `ZZZ` commutes with every term of h3.
+  EXPECT_NEAR(gradients[3], 0.0, 1e-9);
+}
+
 #endif
 
 #endif
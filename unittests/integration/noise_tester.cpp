@@ -8,6 +8,7 @@
 
 #include "CUDAQTestUtils.h"
 #include <cudaq/algorithm.h>
+#include <cudaq/algorithms/sample_detectors.h>
 #include <set>
 #include <stdio.h>
 
@@ -259,6 +260,23 @@ CUDAQ_TEST(NoiseTest, checkAmplitudeDamping) {
   cudaq::unset_noise(); // clear for subsequent tests
 }
 
+CUDAQ_TEST(NoiseTest, checkPerfCountersNoiseChannels) {
+  cudaq::depolarization_channel depol(.1);
+  cudaq::noise_model noise;
+  noise.add_channel<cudaq::types::x>({0}, depol);
+  noise.add_channel<cudaq::types::x>({1}, depol);
+  cudaq::set_noise(noise);
+
+  cudaq::set_perf_counters_enabled(true);
+  cudaq::sample(xOp2{});
+  cudaq::set_perf_counters_enabled(false);
+  cudaq::unset_noise(); // clear for subsequent tests
+
+  auto counters = cudaq::get_perf_counters();
+  EXPECT_EQ(counters.gates["x"], 2);
+  EXPECT_EQ(counters.noise_channels, 2);
+}
+
 #endif
 
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET_MPS)
@@ -701,6 +719,27 @@ CUDAQ_TEST(NoiseTest, checkAllQubitChannel) {
   EXPECT_EQ(totalShots, shots);
 }
 
+struct cnotSpectators {
+  void operator()() __qpu__ {
+    cudaq::qarray<4> q;
+    x<cudaq::ctrl>(q[1], q[2]);
+  }
+};
+
+CUDAQ_TEST(NoiseTest, checkCrosstalkChannel) {
+  cudaq::set_random_seed(13);
+  cudaq::bit_flip_channel bf(1.);
+  cudaq::noise_model noise;
+  // Path 0 -- 1 -- 2 -- 3
+  noise.add_crosstalk_channel("cx", {{0, 1}, {1, 2}, {2, 3}}, bf);
+  const std::size_t shots = 252;
+  auto counts =
+      cudaq::sample({.shots = shots, .noise = noise}, cnotSpectators{});
+  EXPECT_EQ(1, counts.size());
+  // Only the spectators of the CNOT, q[0] and q[3], are flipped.
+  EXPECT_NEAR(counts.probability("1001"), 1., .1);
+}
+
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
 // Stim does not support arbitrary cudaq::kraus_op specification.
@@ -1165,3 +1204,138 @@ CUDAQ_TEST(NoiseTest, checkNoiseChannelStateReconstruction) {
 #endif
 
 #endif
+
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_CUSTATEVEC_FP32)
+
+CUDAQ_TEST(NoiseTest, checkTrajectorySampling) {
+  struct xMeasure {
+    void operator()() __qpu__ {
+      cudaq::qubit q;
+      x(q);
+      mz(q);
+    }
+  };
+
+  cudaq::set_random_seed(13);
+  constexpr std::size_t shots = 2000;
+  {
+    // Unitary mixture: the flip probability is state independent.
+    cudaq::noise_model noise;
+    noise.add_channel<cudaq::types::x>({0}, cudaq::bit_flip_channel(.2));
+    auto counts = cudaq::sample({.shots = shots, .noise = noise}, xMeasure{});
+    EXPECT_EQ(counts.get_total_shots(), shots);
+    EXPECT_NEAR(counts.probability("0"), .2, .05);
+  }
+  {
+    // General Kraus channel: branch probabilities depend on the state.
+    cudaq::noise_model noise;
+    noise.add_channel<cudaq::types::x>({0},
+                                       cudaq::amplitude_damping_channel(.3));
+    auto counts = cudaq::sample({.shots = shots, .noise = noise}, xMeasure{});
+    EXPECT_EQ(counts.get_total_shots(), shots);
+    EXPECT_NEAR(counts.probability("0"), .3, .05);
+  }
+  {
+    // Trajectories are only simulated when sampling: a single trajectory is
+    // not the expectation value of the noisy circuit, so the state vector
+    // backend observes the noise-free circuit, while the density-matrix one
+    // observes the exact noisy value.
+    auto xOnly = []() __qpu__ {
+      cudaq::qubit q;
+      x(q);
+    };
+    cudaq::noise_model noise;
+    noise.add_channel<cudaq::types::x>({0}, cudaq::bit_flip_channel(.2));
+    cudaq::set_noise(noise);
+    const double expVal = cudaq::observe(xOnly, cudaq::spin_op::z(0));
+    cudaq::unset_noise();
+#if defined(CUDAQ_BACKEND_DM)
+    EXPECT_NEAR(expVal, -.6, 1e-6);
+#else
+    EXPECT_NEAR(expVal, -1., 1e-6);
+#endif
+  }
+}
+
+#endif
+
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM)
+
+CUDAQ_TEST(NoiseTest, checkDetectorSampling) {
+  struct parityCheck {
+    void operator()() __qpu__ {
+      cudaq::qvector q(3);
+      x<cudaq::ctrl>(q[0], q[2]);
+      x<cudaq::ctrl>(q[1], q[2]);
+      mz(q[2]);
+      // A noisy data qubit flip after the parity check
+      x(q[0]);
+      mz(q[0]);
+      mz(q[1]);
+    }
+  };
+
+  cudaq::set_random_seed(13);
+  cudaq::detector_sampling_options options;
+  options.shots = 1000;
+  options.chunk_size = 300;
+  options.noise.add_channel<cudaq::types::x>({0},
+                                             cudaq::bit_flip_channel(.1));
+  // The parity check disagrees with the data qubits iff q[0] was flipped.
+  options.detectors = {{0, 1, 2}};
+  options.observables = {{1}};
+
+  std::vector<std::size_t> firstShots;
+  std::size_t numShots = 0;
+  std::size_t numEvents = 0;
+  cudaq::sample_detectors(
+      options,
+      [&](const cudaq::detector_samples &chunk) {
+        firstShots.push_back(chunk.first_shot);
+        EXPECT_EQ(chunk.detection_events.numBits, 1);
+        EXPECT_EQ(chunk.observable_flips.numBits, 1);
+        EXPECT_EQ(chunk.detection_events.words, chunk.observable_flips.words);
+        numShots += chunk.detection_events.size();
+        for (std::size_t s = 0; s < chunk.detection_events.size(); ++s)
+          numEvents += chunk.detection_events.bit(s, 0);
+      },
+      parityCheck{});
+  EXPECT_EQ((std::vector<std::size_t>{0, 300, 600, 900}), firstShots);
+  EXPECT_EQ(numShots, 1000);
+  EXPECT_NEAR(numEvents / 1000., .1, .04);
+
+  options.detectors = {{3}};
+  EXPECT_ANY_THROW(cudaq::sample_detectors(
+      options, [](const cudaq::detector_samples &) {}, parityCheck{}));
+}
+
+#endif
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+
+CUDAQ_TEST(NoiseTest, checkBatchedTrajectories) {
+  // On the tensor network backends, the shots which share a noise trajectory
+  // are sampled from a single contraction. Check that the batching preserves
+  // the statistics of independent bit flips.
+  auto kernel = []() __qpu__ {
+    cudaq::qvector q(4);
+    x(q);
+    mz(q);
+  };
+
+  cudaq::set_random_seed(13);
+  cudaq::noise_model noise;
+  for (std::size_t i = 0; i < 4; ++i)
+    noise.add_channel<cudaq::types::x>({i}, cudaq::bit_flip_channel(.2));
+  const std::size_t shots = 2000;
+  auto counts = cudaq::sample({.shots = shots, .noise = noise}, kernel);
+  counts.dump();
+  std::size_t totalShots = 0;
+  for (auto &[bitstr, count] : counts)
+    totalShots += count;
+  EXPECT_EQ(totalShots, shots);
+  EXPECT_NEAR(counts.probability("1111"), .8 * .8 * .8 * .8, .05);
+  EXPECT_NEAR(counts.probability("0000"), .2 * .2 * .2 * .2, .01);
+  EXPECT_NEAR(counts.probability("0111"), .2 * .8 * .8 * .8, .03);
+}
+
+#endif
@@ -162,4 +162,116 @@ CUDAQ_TEST(ObserveResult, checkObserveWithIdentityLarge) {
   EXPECT_NEAR(expVal.expectation(), -0.416147, 1e-3);
 }
 #endif
+// Qubit-wise commuting terms are measured together; check that the per-term
+// results match measuring every term separately.
+CUDAQ_TEST(ObserveResult, checkGroupedTerms) {
+  using cudaq::spin_op;
+  spin_op h = 1.5 + spin_op::x(0) * spin_op::x(1) + 0.5 * spin_op::x(2) -
+              spin_op::y(0) * spin_op::y(1) + 0.25 * spin_op::z(0) -
+              0.75 * spin_op::z(1) * spin_op::z(2) +
+              spin_op::x(0) * spin_op::z(2);
+
+  auto ansatz = [](double theta) __qpu__ {
+    cudaq::qvector q(3);
+    x(q[0]);
+    ry(theta, q[1]);
+    rx(0.3, q[2]);
+    x<cudaq::ctrl>(q[1], q[0]);
+    h(q[2]);
+  };
+
+  setenv("CUDAQ_OBSERVE_GROUP_TERMS", "0", 1);
+  auto separate = cudaq::observe(ansatz, h, 0.59);
+  unsetenv("CUDAQ_OBSERVE_GROUP_TERMS");
+  auto grouped = cudaq::observe(ansatz, h, 0.59);
+  EXPECT_NEAR(grouped.expectation(), separate.expectation(), 1e-9);
+  for (const auto &term : h)
+    if (!term.is_identity())
+      EXPECT_NEAR(grouped.expectation(term), separate.expectation(term), 1e-9);
+
+  // With shots, every term is still estimated from all the shots.
+  const int shots = 1000;
+  auto withShots = cudaq::observe(shots, ansatz, h, 0.59);
+  EXPECT_NEAR(withShots.expectation(), separate.expectation(), 0.3);
+  for (const auto &term : h) {
+    if (term.is_identity())
+      continue;
+    std::size_t totalShots = 0;
+    for (auto &[bits, count] : withShots.counts(term)) {
+      EXPECT_EQ(bits.size(), term.num_ops());
+      totalShots += count;
+    }
+    EXPECT_EQ(totalShots, shots);
+  }
+}
+
+// Exact expectation values computed from the lightcone of each term match
+// those computed from the whole state.
+CUDAQ_TEST(ObserveResult, checkLightcones) {
+  using cudaq::spin_op;
+  spin_op h = 0.5 + spin_op::z(0) + spin_op::x(3) * spin_op::x(4) -
+              0.5 * spin_op::y(7) * spin_op::z(8) +
+              0.25 * spin_op::z(11) * spin_op::z(4);
+
+  auto ansatz = [](double theta) __qpu__ {
+    cudaq::qvector q(12);
+    for (int layer = 0; layer < 2; ++layer) {
+      for (std::size_t i = 0; i < q.size(); ++i)
+        ry(theta * (i + 1), q[i]);
+      for (std::size_t i = layer; i + 1 < q.size(); i += 2)
+        x<cudaq::ctrl>(q[i], q[i + 1]);
+    }
+  };
+
+  auto full = cudaq::observe(ansatz, h, 0.37);
+  setenv("CUDAQ_OBSERVE_LIGHTCONE", "1", 1);
+  auto lightcones = cudaq::observe(ansatz, h, 0.37);
+  unsetenv("CUDAQ_OBSERVE_LIGHTCONE");
+  EXPECT_NEAR(lightcones.expectation(), full.expectation(), 1e-9);
+  for (const auto &term : h)
+    if (!term.is_identity())
+      EXPECT_NEAR(lightcones.expectation(term), full.expectation(term), 1e-9);
+}
+// Shots are allocated to the groups of terms in proportion to their estimated
+// standard deviation.
+CUDAQ_TEST(ObserveResult, checkAdaptiveShots) {
+  using cudaq::spin_op;
+  spin_op h = 5.907 - 2.1433 * spin_op::x(0) * spin_op::x(1) -
+              2.1433 * spin_op::y(0) * spin_op::y(1) +
+              .21829 * spin_op::z(0) - 6.125 * spin_op::z(1);
+  const double exact = cudaq::observe(deuteron_n3_ansatz{}, h, 0.59, 0.0);
+
+  cudaq::observe_options options;
+  options.shots = 100;
+  options.target_error = 0.05;
+  auto result = cudaq::observe(options, deuteron_n3_ansatz{}, h, 0.59, 0.0);
+  EXPECT_NEAR(result.expectation(), exact, 0.25);
+
+  // The `Z0 Z1` group, dominated by `-6.125 Z1`, has a larger deviation than
+  // the `X0X1` one, and every group gets at least the pilot shots.
+  auto totalShots = [&](const cudaq::spin_op_term &term) {
+    std::size_t total = 0;
+    for (auto &[bits, count] : result.counts(term))
+      total += count;
+    return total;
+  };
+  const auto xx = *(spin_op::x(0) * spin_op::x(1)).begin();
+  const auto z1 = *spin_op::z(1).begin();
+  EXPECT_GE(totalShots(xx), 100);
+  EXPECT_GT(totalShots(z1), totalShots(xx));
+
+  options.shots = 0;
+  EXPECT_THROW(cudaq::observe(options, deuteron_n3_ansatz{}, h, 0.59, 0.0),
+               std::invalid_argument);
+}
+// A packed operator is observed chunk by chunk without building a spin_op.
+CUDAQ_TEST(ObserveResult, checkPackedOperator) {
+  auto h = cudaq::spin_op::random(3, 10, /*seed=*/13);
+  const double exact = cudaq::observe(deuteron_n3_ansatz{}, h, 0.59, 0.3);
+
+  auto data = cudaq::packed_spin_op_view::pack(h);
+  cudaq::packed_spin_op_view packed(data.data(), data.size());
+  auto result = cudaq::observe(deuteron_n3_ansatz{}, packed, 0.59, 0.3);
+  EXPECT_NEAR(result.expectation(), exact, 1e-9);
+}
 #endif
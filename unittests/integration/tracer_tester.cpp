@@ -102,3 +102,71 @@ CUDAQ_TEST(TracerTester, checkLargeTrace) {
   auto totalOps = resources.count();
   EXPECT_EQ(totalOps, numLayers * numQubits * 1.5);
 }
+
+CUDAQ_TEST(TracerTester, checkRepeatedGatesAndMerge) {
+
+  auto repeated = [](int n) __qpu__ {
+    cudaq::qvector q(2);
+    for (int i = 0; i < n; i++)
+      h(q[0]);
+    for (int i = 0; i < n; i++)
+      x<cudaq::ctrl>(q[0], q[1]);
+    x(q[1]);
+    h(q[0]);
+  };
+
+  auto resources = cudaq::estimate_resources(repeated, 100);
+  EXPECT_EQ(101, resources.count("h"));
+  EXPECT_EQ(100, resources.count_controls("x", 1));
+  EXPECT_EQ(1, resources.count_controls("x", 0));
+  EXPECT_EQ(202, resources.count());
+
+  // Combine counts gathered separately, e.g., by several threads
+  auto other = cudaq::estimate_resources(repeated, 10);
+  resources.merge(other);
+  EXPECT_EQ(112, resources.count("h"));
+  EXPECT_EQ(111, resources.count("x"));
+  EXPECT_EQ(224, resources.count());
+}
+
+CUDAQ_TEST(TracerTester, checkBranchStatistics) {
+
+  auto feedback = []() __qpu__ {
+    cudaq::qvector q(2);
+    h(q[0]);
+    if (mz(q[0])) {
+      x(q[1]);
+      if (mz(q[1]))
+        h(q[1]);
+    }
+  };
+
+  cudaq::branch_exploration_options options;
+  options.enumerate = true;
+  options.num_threads = 4;
+  auto statistics = cudaq::estimate_resource_statistics(options, feedback);
+  statistics.dump();
+
+  // Branches: 0 (p = 1/2), 10 (p = 1/4) and 11 (p = 1/4)
+  EXPECT_EQ(3, statistics.num_branches());
+  EXPECT_EQ(2, statistics.max_count("h"));
+  EXPECT_EQ(3, statistics.max_count());
+  EXPECT_NEAR(0.5, statistics.mean_count("x"), 1e-12);
+  EXPECT_NEAR(1.75, statistics.mean_count(), 1e-12);
+  auto distribution = statistics.count_distribution();
+  EXPECT_NEAR(0.5, distribution[1], 1e-12);
+  EXPECT_NEAR(0.25, distribution[2], 1e-12);
+  EXPECT_NEAR(0.25, distribution[3], 1e-12);
+
+  // Enumerating more branches than allowed is an error
+  options.num_branches = 2;
+  EXPECT_ANY_THROW(cudaq::estimate_resource_statistics(options, feedback));
+
+  // Sampled branches
+  cudaq::branch_exploration_options sampling;
+  sampling.num_branches = 64;
+  auto sampled = cudaq::estimate_resource_statistics(sampling, feedback);
+  EXPECT_EQ(64, sampled.num_branches());
+  EXPECT_LE(sampled.max_count(), 3);
+  EXPECT_GE(sampled.mean_count(), 1.);
+}
@@ -127,6 +127,35 @@ CUDAQ_TEST_F(VQETester, checkSpsa) {
   EXPECT_NEAR(opt_val, -1.1371, 1e-3);
 }
 
+CUDAQ_TEST_F(VQETester, checkCmaes) {
+  printf("Run with cmaes\n");
+  cudaq::optimizers::cmaes opt;
+  opt.seed = 13;
+  opt.f_tol = 1e-8;
+  auto [opt_val, opt_params] = cudaq::vqe(ansatz_compute_action{}, *H, opt, 1);
+  EXPECT_NEAR(opt_val, -1.1371, 1e-3);
+
+  // The candidates of each iteration are evaluated together.
+  std::size_t numBatches = 0, numEvals = 0;
+  auto sphere = [](const std::vector<double> &x) {
+    return (x[0] - 1) * (x[0] - 1) + (x[1] + 2) * (x[1] + 2);
+  };
+  auto [val, params] = opt.optimize(
+      2, cudaq::optimizable_function(
+             sphere, [&](const std::vector<std::vector<double>> &xs) {
+               ++numBatches;
+               std::vector<double> values;
+               for (const auto &x : xs)
+                 values.push_back(sphere(x));
+               numEvals += xs.size();
+               return values;
+             }));
+  EXPECT_NEAR(val, 0.0, 1e-6);
+  EXPECT_NEAR(params[0], 1.0, 1e-2);
+  EXPECT_NEAR(params[1], -2.0, 1e-2);
+  EXPECT_GT(numEvals, numBatches);
+}
+
 CUDAQ_TEST_F(VQETester, checkDifferentArgStructure) {
   cudaq::optimizers::cobyla c_opt;
   auto argMapper = [](std::vector<double> x) { return std::make_tuple(x[0]); };
@@ -244,6 +244,45 @@ TEST(MPITester, checkCommSplit) {
   EXPECT_EQ(size, 1);
 }
 
+TEST(MPITester, checkNonBlockingCollectives) {
+  auto *mpiPlugin = cudaq::mpi::getMpiPlugin();
+  EXPECT_TRUE(mpiPlugin != nullptr);
+  cudaqDistributedInterface_t *mpiInterface = mpiPlugin->get();
+  EXPECT_TRUE(mpiInterface != nullptr);
+  if (mpiInterface->version < 2)
+    GTEST_SKIP() << "The MPI plugin has no non-blocking collectives.";
+  cudaqDistributedCommunicator_t *comm = mpiPlugin->getComm();
+  const auto rank = cudaq::mpi::rank();
+  const auto nRanks = cudaq::mpi::num_ranks();
+  void *request = nullptr;
+  EXPECT_EQ(mpiInterface->CreateRequest(&request), 0);
+
+  const double localVal = rank + 1;
+  double sum = 0.0;
+  EXPECT_EQ(mpiInterface->IAllreduce(comm, &localVal, &sum, 1, FLOAT_64, SUM,
+                                     request),
+            0);
+  int32_t completed = 0;
+  while (!completed)
+    EXPECT_EQ(mpiInterface->TestRequest(request, &completed), 0);
+  EXPECT_EQ(sum, nRanks * (nRanks + 1) / 2.0);
+
+  // In place, with a null send buffer.
+  std::vector<double> gathered(nRanks, 0.0);
+  gathered[rank] = 10.0 * rank;
+  EXPECT_EQ(mpiInterface->IAllgather(comm, nullptr, gathered.data(), 1,
+                                     FLOAT_64, request),
+            0);
+  EXPECT_EQ(mpiInterface->WaitRequest(request), 0);
+  for (int i = 0; i < nRanks; ++i)
+    EXPECT_EQ(gathered[i], 10.0 * i);
+  EXPECT_EQ(mpiInterface->DestroyRequest(request), 0);
+
+  int32_t deviceBuffers = -1;
+  EXPECT_EQ(mpiInterface->DeviceBufferSupport(&deviceBuffers), 0);
+  EXPECT_TRUE(deviceBuffers == 0 || deviceBuffers == 1);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   cudaq::mpi::initialize();
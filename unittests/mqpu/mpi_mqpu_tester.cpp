@@ -38,3 +38,37 @@ TEST(MPIObserveTester, checkSimple) {
     printf("Get energy directly as double %lf\n", result);
   }
 }
+
+TEST(MPIObserveTester, checkCostBalancedTerms) {
+  using cudaq::spin_op;
+  spin_op h = 1.5 + spin_op::x(0) * spin_op::x(1) + 0.5 * spin_op::x(2) -
+              spin_op::y(0) * spin_op::y(1) + 0.25 * spin_op::z(0) -
+              0.75 * spin_op::z(1) * spin_op::z(2) +
+              spin_op::x(0) * spin_op::z(2) + spin_op::y(1) * spin_op::y(2);
+  h.canonicalize();
+
+  // Each chunk is the one built along with all the others, and the chunks
+  // cover the terms.
+  for (int shots : {-1, 100}) {
+    auto chunks = cudaq::details::distributeCommutingGroups(h, 3, shots);
+    auto all = spin_op::empty();
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+      auto chunk = cudaq::details::commutingGroupsChunk(h, 3, i, shots);
+      EXPECT_EQ(chunk, chunks[i]);
+      all += chunk;
+    }
+    EXPECT_EQ(all.num_terms(), h.num_terms());
+  }
+
+  auto ansatz = [](double theta) __qpu__ {
+    cudaq::qvector q(3);
+    x(q[0]);
+    ry(theta, q[1]);
+    rx(0.3, q[2]);
+    x<cudaq::ctrl>(q[1], q[0]);
+  };
+
+  double exact = cudaq::observe(ansatz, h, 0.59);
+  double result = cudaq::observe<cudaq::parallel::mpi>(ansatz, h, 0.59);
+  EXPECT_NEAR(result, exact, 1e-6);
+}
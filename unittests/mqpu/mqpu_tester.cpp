@@ -29,6 +29,48 @@ TEST(MQPUTester, checkSimple) {
   printf("Get energy directly as double %.16lf\n", result);
 }
 
+TEST(MQPUTester, checkBroadcastUnevenCosts) {
+  // Argument sets of very different costs are claimed by the QPUs
+  // dynamically, the results must still be in argument order.
+  auto kernel = [](int nQubits) __qpu__ {
+    cudaq::qvector q(nQubits);
+    for (int layer = 0; layer < nQubits; layer++)
+      for (int i = 0; i < nQubits; i++)
+        rx(M_PI, q[i]);
+    x(q[0]);
+  };
+  std::vector<int> sizes;
+  for (int i = 0; i < 24; i++)
+    sizes.push_back(i % 3 == 0 ? 14 : 1 + i % 4);
+  auto results = cudaq::sample(100, kernel, cudaq::make_argset(sizes));
+  ASSERT_EQ(results.size(), sizes.size());
+  for (std::size_t i = 0; i < sizes.size(); i++) {
+    // An even number of X layers cancels out, an odd one flips all qubits.
+    std::string expected(sizes[i], sizes[i] % 2 ? '1' : '0');
+    expected[0] = expected[0] == '1' ? '0' : '1';
+    EXPECT_EQ(results[i].most_probable(), expected);
+  }
+}
+
+TEST(MQPUTester, checkObserveWithShots) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+
+  auto ansatz = [](double theta) __qpu__ {
+    cudaq::qubit q, r;
+    x(q);
+    ry(theta, r);
+    x<cudaq::ctrl>(r, q);
+  };
+
+  // With shots, the terms are spread over several chunks per QPU.
+  auto result =
+      cudaq::observe<cudaq::parallel::thread>(100000, ansatz, h, 0.59);
+  EXPECT_NEAR(result.expectation(), -1.7487, 5e-2);
+}
+
 TEST(MQPUTester, checkLarge) {
 
   // This will warm up the GPUs, we don't time this
@@ -126,3 +168,30 @@ TEST(MQPUTester, checkAsyncWithKernelBuilder) {
     EXPECT_NEAR(std::abs(gotState[1] - expectedState[1]), 0.0, 1e-6);
   }
 }
+
+TEST(MQPUTester, checkAnyQpuWeighted) {
+  auto &platform = cudaq::get_platform();
+  const auto numQpus = platform.num_qpus();
+  std::vector<double> weights;
+  for (std::size_t i = 0; i < numQpus; i++) {
+    weights.push_back(platform.get_qpu_weight(i));
+    platform.set_qpu_weight(i == 0 ? 4.0 : 1.0, i);
+  }
+  EXPECT_THROW(platform.set_qpu_weight(0.0, 0), std::invalid_argument);
+  // With no pending tasks, the QPU with the highest weight is selected.
+  EXPECT_EQ(platform.select_qpu(), 0);
+
+  auto kernel = [](int nQubits) __qpu__ {
+    cudaq::qvector q(nQubits);
+    x(q);
+    mz(q);
+  };
+  std::vector<cudaq::async_sample_result> futures;
+  for (int i = 0; i < 16; i++)
+    futures.emplace_back(cudaq::sample_async(cudaq::any_qpu, kernel, 4));
+  for (auto &f : futures)
+    EXPECT_EQ(f.get().most_probable(), "1111");
+
+  for (std::size_t i = 0; i < numQpus; i++)
+    platform.set_qpu_weight(weights[i], i);
+}
@@ -957,3 +957,59 @@ TEST(OperatorExpressions, checkMultiDiagConversionBoson) {
     }
   }
 }
+
+TEST(OperatorExpressions, checkBosonOpsSparseMatrix) {
+  auto to_dense = [](const cudaq::csr_spmatrix &sparse, std::size_t dim) {
+    const auto &[values, rows, cols] = sparse;
+    cudaq::complex_matrix matrix(dim, dim);
+    for (std::size_t i = 0; i < values.size(); ++i)
+      matrix[{rows[i], cols[i]}] += values[i];
+    return matrix;
+  };
+
+  cudaq::dimension_map dimensions = {{0, 12}, {1, 3}, {2, 17}};
+  std::vector<cudaq::boson_op> ops = {
+      cudaq::boson_op::create(0) * cudaq::boson_op::create(0) *
+          cudaq::boson_op::annihilate(2),
+      cudaq::boson_op::number(1) * cudaq::boson_op::annihilate(1) +
+          2. * cudaq::boson_op::position(2) * cudaq::boson_op::momentum(0),
+      cudaq::boson_op::create(0) * cudaq::boson_op::annihilate(1) *
+              cudaq::boson_op::number(2) -
+          cudaq::boson_op::identity(1),
+  };
+  for (const auto &op : ops) {
+    std::size_t dim = 1;
+    for (auto degree : op.degrees())
+      dim *= dimensions[degree];
+    for (bool invert_order : {false, true}) {
+      utils::checkEqual(
+          to_dense(op.to_sparse_matrix(dimensions, {}, invert_order), dim),
+          op.to_matrix(dimensions, {}, invert_order));
+      for (const auto &term : op) {
+        std::size_t term_dim = 1;
+        for (auto degree : term.degrees())
+          term_dim *= dimensions[degree];
+        utils::checkEqual(
+            to_dense(term.to_sparse_matrix(dimensions, {}, invert_order),
+                     term_dim),
+            term.to_matrix(dimensions, {}, invert_order));
+      }
+    }
+  }
+
+  // Only the entries within the cutoff are stored.
+  {
+    auto op = cudaq::boson_op::create(0) * cudaq::boson_op::create(0) *
+              cudaq::boson_op::annihilate(1);
+    const auto &[values, rows, cols] = op.to_sparse_matrix(dimensions);
+    EXPECT_EQ(values.size(), (12ul - 2) * (3 - 1));
+    for (const auto &value : values)
+      EXPECT_NE(value, std::complex<double>(0.));
+  }
+  {
+    // the number operator vanishes on the ground state
+    auto op = cudaq::boson_op::number(0);
+    const auto &[values, rows, cols] = op.to_sparse_matrix(dimensions);
+    EXPECT_EQ(values.size(), 11ul);
+  }
+}
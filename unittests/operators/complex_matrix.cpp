@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cudaq/operators/matrix.h"
+#include "utils.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+cudaq::complex_matrix
+make_matrix(std::size_t rows, std::size_t cols,
+            cudaq::complex_matrix::order order, double offset) {
+  cudaq::complex_matrix matrix(rows, cols, false, order);
+  for (std::size_t i = 0; i < rows; i++)
+    for (std::size_t j = 0; j < cols; j++)
+      matrix(i, j) = {offset + i + 0.5 * j, offset * i - j};
+  return matrix;
+}
+
+cudaq::complex_matrix naive_product(const cudaq::complex_matrix &left,
+                                    const cudaq::complex_matrix &right) {
+  cudaq::complex_matrix result(left.rows(), right.cols());
+  for (std::size_t i = 0; i < left.rows(); i++)
+    for (std::size_t j = 0; j < right.cols(); j++)
+      for (std::size_t k = 0; k < left.cols(); k++)
+        result(i, j) += left(i, k) * right(k, j);
+  return result;
+}
+
+} // namespace
+
+TEST(ComplexMatrixTest, checkProductOrders) {
+  const std::vector<cudaq::complex_matrix::order> orders = {
+      cudaq::complex_matrix::order::row_major,
+      cudaq::complex_matrix::order::column_major};
+  for (auto left_order : orders)
+    for (auto right_order : orders)
+      for (auto result_order : orders) {
+        auto left = make_matrix(3, 4, left_order, 1.);
+        auto right = make_matrix(4, 2, right_order, -2.);
+        auto expected = naive_product(left, right);
+
+        cudaq::complex_matrix result(1, 1, true, result_order);
+        cudaq::multiply(left, right, result);
+        utils::checkEqual(expected, result);
+        utils::checkEqual(expected, left * right);
+
+        left *= right;
+        utils::checkEqual(expected, left);
+      }
+}
+
+TEST(ComplexMatrixTest, checkKroneckerOrders) {
+  const std::vector<cudaq::complex_matrix::order> orders = {
+      cudaq::complex_matrix::order::row_major,
+      cudaq::complex_matrix::order::column_major};
+  for (auto left_order : orders)
+    for (auto right_order : orders) {
+      auto left = make_matrix(2, 3, left_order, 1.);
+      auto right = make_matrix(3, 2, right_order, 0.5);
+      cudaq::complex_matrix expected(6, 6);
+      for (std::size_t i = 0; i < 2; i++)
+        for (std::size_t j = 0; j < 3; j++)
+          for (std::size_t k = 0; k < 3; k++)
+            for (std::size_t m = 0; m < 2; m++)
+              expected(3 * i + k, 2 * j + m) = left(i, j) * right(k, m);
+
+      utils::checkEqual(expected, cudaq::kronecker(left, right));
+      cudaq::complex_matrix result(6, 6, false,
+                                   cudaq::complex_matrix::order::column_major);
+      cudaq::kronecker(left, right, result);
+      utils::checkEqual(expected, result);
+    }
+}
+
+TEST(ComplexMatrixTest, checkBatched) {
+  std::vector<cudaq::complex_matrix> lefts, rights;
+  for (std::size_t i = 0; i < 5; i++) {
+    const auto order = i % 2 ? cudaq::complex_matrix::order::row_major
+                             : cudaq::complex_matrix::order::column_major;
+    lefts.push_back(make_matrix(i + 1, 3, order, i));
+    rights.push_back(make_matrix(3, 2, order, -1. * i));
+  }
+
+  auto products = cudaq::batched_multiply(lefts, rights);
+  auto krons = cudaq::batched_kronecker(lefts, rights);
+  ASSERT_EQ(products.size(), lefts.size());
+  ASSERT_EQ(krons.size(), lefts.size());
+  for (std::size_t i = 0; i < lefts.size(); i++) {
+    utils::checkEqual(naive_product(lefts[i], rights[i]), products[i]);
+    utils::checkEqual(cudaq::kronecker(lefts[i], rights[i]), krons[i]);
+  }
+
+  rights.pop_back();
+  EXPECT_THROW(cudaq::batched_multiply(lefts, rights), std::runtime_error);
+  EXPECT_THROW(cudaq::batched_kronecker(lefts, rights), std::runtime_error);
+}
+
+TEST(ComplexMatrixTest, checkPowerAndExponential) {
+  auto matrix = make_matrix(3, 3, cudaq::complex_matrix::order::row_major, 0.1);
+  utils::checkEqual(matrix * matrix * matrix, matrix.power(3));
+
+  cudaq::complex_matrix diagonal(2, 2);
+  diagonal(0, 0) = 1.;
+  diagonal(1, 1) = std::complex<double>(0., M_PI);
+  auto exponential = diagonal.exponential();
+  EXPECT_NEAR(std::abs(exponential(0, 0) - std::exp(1.)), 0., 1e-8);
+  EXPECT_NEAR(std::abs(exponential(1, 1) + 1.), 0., 1e-8);
+  EXPECT_NEAR(std::abs(exponential(0, 1)), 0., 1e-8);
+}
+
+TEST(ComplexMatrixTest, checkEigenvalueCache) {
+  // Matrices that only differ in elements skipped by the structural hash must
+  // still have their own eigenvalues.
+  const std::size_t size = 16;
+  cudaq::complex_matrix first(size, size), second(size, size);
+  for (std::size_t i = 0; i < size; i++) {
+    first(i, i) = static_cast<double>(i);
+    second(i, i) = static_cast<double>(i);
+  }
+  second(size - 1, size - 1) = -1.;
+
+  EXPECT_NEAR(first.minimal_eigenvalue().real(), 0., 1e-8);
+  EXPECT_NEAR(second.minimal_eigenvalue().real(), -1., 1e-8);
+  EXPECT_NEAR(first.minimal_eigenvalue().real(), 0., 1e-8);
+}
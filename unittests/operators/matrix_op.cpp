@@ -786,3 +786,169 @@ TEST(OperatorExpressions, checkMatrixOpsParameterVerification) {
   ASSERT_NO_THROW((squeeze * displace).to_matrix(dimensions, parameters));
   ASSERT_NO_THROW((squeeze + displace).to_matrix(dimensions, parameters));
 }
+
+TEST(OperatorExpressions, checkMatrixOpsSparseMatrix) {
+  auto to_dense = [](const cudaq::csr_spmatrix &sparse, std::size_t dim) {
+    const auto &[values, rows, cols] = sparse;
+    cudaq::complex_matrix matrix(dim, dim);
+    for (std::size_t i = 0; i < values.size(); ++i)
+      matrix[{rows[i], cols[i]}] += values[i];
+    return matrix;
+  };
+
+  {
+    auto func = [](const std::vector<int64_t> &dimensions,
+                   const std::unordered_map<std::string, std::complex<double>>
+                       &parameters) {
+      return parameters.at("scale") *
+             cudaq::kronecker(utils::position_matrix(dimensions[1]),
+                              utils::annihilate_matrix(dimensions[0]));
+    };
+    cudaq::matrix_handler::define("custom_sparse_op", {-1, -1}, func);
+  }
+
+  std::unordered_map<std::string, std::complex<double>> parameters = {
+      {"scale", 0.5}, {"displacement", 0.25}};
+  cudaq::dimension_map dimensions = {{0, 3}, {1, 2}, {2, 4}, {4, 2}};
+  auto custom = cudaq::matrix_handler::instantiate("custom_sparse_op", {0, 2});
+  std::vector<cudaq::matrix_op> ops = {
+      cudaq::matrix_op::number(1) * cudaq::matrix_op::parity(4),
+      custom * cudaq::matrix_op::momentum(1) + 2. * cudaq::matrix_op::number(0),
+      cudaq::matrix_op::displace(2) * custom -
+          cudaq::matrix_op::position(2) * cudaq::matrix_op::position(2) +
+          cudaq::spin_op::x(4) * cudaq::spin_op::y(1),
+      cudaq::matrix_op::identity(0) * 3. + cudaq::matrix_op::position(2),
+  };
+  auto get_dimension = [&dimensions](const std::vector<std::size_t> &degrees) {
+    std::size_t dim = 1;
+    for (auto degree : degrees)
+      dim *= dimensions[degree];
+    return dim;
+  };
+  for (const auto &op : ops) {
+    for (bool invert_order : {false, true}) {
+      utils::checkEqual(
+          to_dense(op.to_sparse_matrix(dimensions, parameters, invert_order),
+                   get_dimension(op.degrees())),
+          op.to_matrix(dimensions, parameters, invert_order));
+      for (const auto &term : op)
+        utils::checkEqual(
+            to_dense(
+                term.to_sparse_matrix(dimensions, parameters, invert_order),
+                get_dimension(term.degrees())),
+            term.to_matrix(dimensions, parameters, invert_order));
+    }
+  }
+
+  ASSERT_ANY_THROW(cudaq::matrix_op::number(5).to_sparse_matrix(dimensions));
+}
+
+TEST(OperatorExpressions, checkMatrixOpsMemoizedDefinitions) {
+  std::size_t num_calls = 0;
+  {
+    auto func = [&num_calls](
+                    const std::vector<int64_t> &dimensions,
+                    const std::unordered_map<std::string, std::complex<double>>
+                        &parameters) {
+      ++num_calls;
+      return parameters.at("scale") * utils::annihilate_matrix(dimensions[0]);
+    };
+    cudaq::matrix_handler::define("custom_memoized_op", {-1}, func);
+  }
+
+  auto op = cudaq::matrix_handler::instantiate("custom_memoized_op", {0});
+  cudaq::dimension_map dimensions = {{0, 3}};
+  std::unordered_map<std::string, std::complex<double>> parameters = {
+      {"scale", 0.5}, {"t", 1.}};
+  auto expected = 0.5 * utils::annihilate_matrix(3);
+
+  utils::checkEqual(op.to_matrix(dimensions, parameters), expected);
+  utils::checkEqual(op.to_matrix(dimensions, parameters), expected);
+  utils::checkEqual((op * op).to_matrix(dimensions, parameters),
+                    expected * expected);
+  ASSERT_EQ(num_calls, 1);
+
+  // New parameter values and new dimensions require a new matrix.
+  parameters["t"] = 2.;
+  utils::checkEqual(op.to_matrix(dimensions, parameters), expected);
+  ASSERT_EQ(num_calls, 2);
+  dimensions[0] = 4;
+  utils::checkEqual(op.to_matrix(dimensions, parameters),
+                    0.5 * utils::annihilate_matrix(4));
+  ASSERT_EQ(num_calls, 3);
+
+  // Time-dependent definitions are evaluated every time.
+  cudaq::matrix_handler::set_time_dependent("custom_memoized_op");
+  op.to_matrix(dimensions, parameters);
+  op.to_matrix(dimensions, parameters);
+  ASSERT_EQ(num_calls, 5);
+  cudaq::matrix_handler::set_time_dependent("custom_memoized_op", false);
+  op.to_matrix(dimensions, parameters);
+  op.to_matrix(dimensions, parameters);
+  ASSERT_EQ(num_calls, 6);
+
+  // Redefining an operator discards its memoized matrices.
+  cudaq::matrix_handler::remove_definition("custom_memoized_op");
+  {
+    auto func = [&num_calls](
+                    const std::vector<int64_t> &dimensions,
+                    const std::unordered_map<std::string, std::complex<double>>
+                        &parameters) {
+      ++num_calls;
+      return utils::annihilate_matrix(dimensions[0]);
+    };
+    cudaq::matrix_handler::define("custom_memoized_op", {-1}, func);
+  }
+  utils::checkEqual(op.to_matrix(dimensions, parameters),
+                    utils::annihilate_matrix(4));
+  ASSERT_EQ(num_calls, 7);
+  cudaq::matrix_handler::remove_definition("custom_memoized_op");
+
+  ASSERT_ANY_THROW(cudaq::matrix_handler::set_time_dependent("undefined_op"));
+}
+
+TEST(OperatorExpressions, checkMatrixOpsMemoizedByDeclaredParameters) {
+  std::size_t num_calls = 0;
+  {
+    auto func = [&num_calls](
+                    const std::vector<int64_t> &dimensions,
+                    const std::unordered_map<std::string, std::complex<double>>
+                        &parameters) {
+      ++num_calls;
+      return parameters.at("scale") * utils::annihilate_matrix(dimensions[0]);
+    };
+    cudaq::matrix_handler::define("custom_declared_op", {-1}, func,
+                                  {{"scale", "scaling factor"}});
+  }
+
+  auto op = cudaq::matrix_handler::instantiate("custom_declared_op", {0});
+  cudaq::dimension_map dimensions = {{0, 3}};
+  std::unordered_map<std::string, std::complex<double>> parameters = {
+      {"scale", 0.5}};
+
+  // Parameters that are not declared, such as the time, do not require a new
+  // matrix.
+  for (int step = 0; step < 10; ++step) {
+    parameters["t"] = 0.1 * step;
+    utils::checkEqual(op.to_matrix(dimensions, parameters),
+                      0.5 * utils::annihilate_matrix(3));
+  }
+  ASSERT_EQ(num_calls, 1);
+
+  // The least recently used matrices are evicted one at a time.
+  for (int i = 1; i <= 64; ++i) {
+    parameters["scale"] = i;
+    op.to_matrix(dimensions, parameters);
+  }
+  ASSERT_EQ(num_calls, 65);
+  parameters["scale"] = 64;
+  op.to_matrix(dimensions, parameters);
+  ASSERT_EQ(num_calls, 65);
+  parameters["scale"] = 0.5;
+  op.to_matrix(dimensions, parameters);
+  ASSERT_EQ(num_calls, 66);
+  parameters["scale"] = 2;
+  op.to_matrix(dimensions, parameters);
+  ASSERT_EQ(num_calls, 66);
+  cudaq::matrix_handler::remove_definition("custom_declared_op");
+}
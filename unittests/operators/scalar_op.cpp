@@ -869,3 +869,70 @@ TEST(OperatorExpressions, checkScalarOpsFromFunctions) {
     utils::checkEqual(sum_res.to_matrix(dims, params), sum_want);
   }
 }
+
+TEST(OperatorExpressions, checkScalarOpsTimeFunctions) {
+  auto at = [](double t) {
+    return cudaq::parameter_map{{"t", std::complex<double>(t)}};
+  };
+
+  // Piecewise-linear interpolation, constant beyond the knots.
+  {
+    auto ramp = cudaq::scalar_operator(cudaq::time_function::piecewise_linear(
+        {0.0, 1.0, 3.0}, {0.0, 2.0, std::complex<double>(2.0, 4.0)}));
+    ASSERT_NE(ramp.get_time_function(), nullptr);
+    EXPECT_FALSE(ramp.is_constant());
+    EXPECT_NEAR(std::abs(ramp.evaluate(at(-1.0))), 0.0, 1e-12);
+    EXPECT_NEAR(std::abs(ramp.evaluate(at(0.5)) - 1.0), 0.0, 1e-12);
+    EXPECT_NEAR(
+        std::abs(ramp.evaluate(at(2.0)) - std::complex<double>(2.0, 2.0)), 0.0,
+        1e-12);
+    EXPECT_NEAR(
+        std::abs(ramp.evaluate(at(5.0)) - std::complex<double>(2.0, 4.0)), 0.0,
+        1e-12);
+    EXPECT_THROW(ramp.evaluate(), std::runtime_error);
+  }
+
+  // A natural cubic spline interpolates the knots and is exact for lines.
+  {
+    std::vector<double> knots{0.0, 0.5, 1.5, 2.0, 3.0};
+    std::vector<std::complex<double>> values;
+    for (auto knot : knots)
+      values.emplace_back(2.0 * knot - 1.0);
+    auto spline = cudaq::scalar_operator(
+        cudaq::time_function::cubic_spline(knots, values));
+    for (double t : {0.0, 0.25, 1.0, 1.7, 2.5, 3.0})
+      EXPECT_NEAR(std::abs(spline.evaluate(at(t)) - (2.0 * t - 1.0)), 0.0,
+                  1e-12);
+    auto sine = cudaq::time_function::cubic_spline(
+        {0.0, 1.0, 2.0, 3.0}, {0.0, std::sin(1.0), std::sin(2.0), 0.0});
+    EXPECT_NEAR(std::abs(sine(2.0) - std::sin(2.0)), 0.0, 1e-12);
+  }
+
+  // The closed form is kept through affine maps by constants, and sinusoids
+  // may depend on any parameter.
+  {
+    auto drive = cudaq::scalar_operator(
+        cudaq::time_function::sinusoid(0.5, 2.0, 0.25, "tau"));
+    auto scaled = 3.0 - 2.0 * drive * cudaq::scalar_operator(1.0) + 1.0;
+    ASSERT_NE(scaled.get_time_function(), nullptr);
+    scaled /= std::complex<double>(0.0, 1.0);
+    ASSERT_NE(scaled.get_time_function(), nullptr);
+    cudaq::parameter_map params{{"tau", 0.3}};
+    const auto want =
+        (3.0 - 2.0 * 0.5 * std::sin(2.0 * 0.3 + 0.25) + 1.0) /
+        std::complex<double>(0.0, 1.0);
+    EXPECT_NEAR(std::abs(scaled.evaluate(params) - want), 0.0, 1e-12);
+    EXPECT_NEAR(std::abs(cudaq::scalar_operator(
+                             scaled.get_time_function()->conj())
+                             .evaluate(params) -
+                         std::conj(want)),
+                0.0, 1e-12);
+    // Dividing by the function is not an affine map.
+    EXPECT_EQ((1.0 / drive).get_time_function(), nullptr);
+  }
+
+  EXPECT_THROW(cudaq::time_function::piecewise_linear({1.0, 0.0}, {0.0, 1.0}),
+               std::invalid_argument);
+  EXPECT_THROW(cudaq::time_function::cubic_spline({0.0, 1.0}, {0.0}),
+               std::invalid_argument);
+}
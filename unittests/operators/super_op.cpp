@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cudaq/operators.h"
+#include "utils.h"
+#include <gtest/gtest.h>
+
+namespace {
+// Applies the sparse matrix of a super-operator to the density matrix
+// vectorized row by row.
+cudaq::complex_matrix apply_super_op(const cudaq::csr_spmatrix &matrix,
+                                     const cudaq::complex_matrix &rho) {
+  const auto &[values, rows, cols] = matrix;
+  const auto dim = rho.rows();
+  cudaq::complex_matrix result(dim, dim);
+  for (std::size_t k = 0; k < values.size(); ++k)
+    result[{rows[k] / dim, rows[k] % dim}] +=
+        values[k] * rho[{cols[k] / dim, cols[k] % dim}];
+  return result;
+}
+
+cudaq::complex_matrix test_density_matrix(std::size_t dim) {
+  cudaq::complex_matrix rho(dim, dim);
+  for (std::size_t i = 0; i < dim; ++i)
+    for (std::size_t j = 0; j < dim; ++j)
+      rho[{i, j}] = {1. + i + 0.5 * j, 0.25 * i - 0.75 * j};
+  return rho;
+}
+} // namespace
+
+TEST(OperatorExpressions, checkSuperOpSparseMatrix) {
+  cudaq::dimension_map dimensions = {{0, 3}, {1, 2}};
+  std::unordered_map<std::string, std::complex<double>> parameters = {
+      {"displacement", 0.3}};
+  auto a = cudaq::matrix_op::number(0) * cudaq::matrix_op::position(1);
+  auto b = cudaq::matrix_op::momentum(0) * cudaq::matrix_op::parity(1);
+  auto c = cudaq::matrix_op::displace(0) * cudaq::matrix_op::identity(1);
+  auto A = a.to_matrix(dimensions);
+  auto B = b.to_matrix(dimensions);
+  auto C = c.to_matrix(dimensions, parameters);
+  auto rho = test_density_matrix(6);
+
+  auto op = cudaq::super_op::left_multiply(a);
+  op += cudaq::super_op::right_multiply(b);
+  op += cudaq::super_op::left_right_multiply(c, a);
+  utils::checkEqual(
+      apply_super_op(op.to_sparse_matrix(dimensions, parameters), rho),
+      A * rho + rho * B + C * rho * A);
+
+  // Operators that do not act on all degrees are embedded.
+  auto embedded = cudaq::super_op::left_multiply(cudaq::matrix_op::number(0));
+  embedded += cudaq::super_op::right_multiply(cudaq::matrix_op::position(1));
+  auto N = (cudaq::matrix_op::number(0) * cudaq::matrix_op::identity(1))
+               .to_matrix(dimensions);
+  auto X = (cudaq::matrix_op::identity(0) * cudaq::matrix_op::position(1))
+               .to_matrix(dimensions);
+  utils::checkEqual(apply_super_op(embedded.to_sparse_matrix(dimensions), rho),
+                    N * rho + rho * X);
+
+  EXPECT_ANY_THROW(op.to_sparse_matrix({{0, 3}}, parameters));
+}
+
+TEST(OperatorExpressions, checkLindbladSparseMatrix) {
+  cudaq::dimension_map dimensions = {{0, 4}, {1, 2}};
+  cudaq::sum_op<cudaq::matrix_handler> hamiltonian =
+      cudaq::matrix_op::number(0) * cudaq::matrix_op::position(1) +
+      0.5 * cudaq::matrix_op::momentum(0) * cudaq::matrix_op::identity(1);
+  std::vector<cudaq::sum_op<cudaq::matrix_handler>> collapse_operators = {
+      cudaq::matrix_op::position(0) * cudaq::matrix_op::number(1),
+      0.1 * cudaq::matrix_op::momentum(0) * cudaq::matrix_op::parity(1)};
+
+  auto rho = test_density_matrix(8);
+  const std::complex<double> i(0., 1.);
+  auto H = hamiltonian.to_matrix(dimensions);
+  auto expected = -i * (H * rho - rho * H);
+  for (const auto &op : collapse_operators) {
+    auto L = op.to_matrix(dimensions);
+    auto L_dag = L;
+    L_dag = L_dag.adjoint();
+    auto L_dag_L = L_dag * L;
+    expected += L * rho * L_dag - 0.5 * (L_dag_L * rho + rho * L_dag_L);
+  }
+  utils::checkEqual(
+      apply_super_op(cudaq::super_op::lindblad_sparse_matrix(
+                         hamiltonian, collapse_operators, dimensions),
+                     rho),
+      expected);
+}
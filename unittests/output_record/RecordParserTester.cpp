@@ -858,3 +858,143 @@ CUDAQ_TEST(ParserTester, checkResultTypeWithArray) {
   buffer = nullptr;
   origBuffer = nullptr;
 }
+
+CUDAQ_TEST(ParserTester, checkBinaryRecords) {
+  auto makeRecord = [](cudaq::OutputRecordType type, std::int64_t intValue,
+                       double doubleValue, const std::string &label) {
+    cudaq::OutputRecord record{type};
+    record.intValue = intValue;
+    record.doubleValue = doubleValue;
+    record.label = label;
+    return record;
+  };
+  using cudaq::OutputRecordType;
+  {
+    const std::vector<cudaq::OutputRecord> records = {
+        makeRecord(OutputRecordType::ARRAY, 2, 0., "array<i32 x 2>"),
+        makeRecord(OutputRecordType::INT, -13, 0., "[1]"),
+        makeRecord(OutputRecordType::INT, 42, 0., "[0]"),
+        makeRecord(OutputRecordType::ARRAY, 2, 0., "array<i32 x 2>"),
+        makeRecord(OutputRecordType::INT, 7, 0., "[0]"),
+        makeRecord(OutputRecordType::INT, 8, 0., "[1]")};
+    cudaq::RecordLogParser parser;
+    parser.parse(records);
+    auto *origBuffer = parser.getBufferPtr();
+    std::size_t bufferSize = parser.getBufferSize();
+    char *buffer = static_cast<char *>(malloc(bufferSize));
+    std::memcpy(buffer, origBuffer, bufferSize);
+    cudaq::details::RunResultSpan span = {buffer, bufferSize};
+    std::vector<std::vector<int>> results = {
+        reinterpret_cast<std::vector<int> *>(span.data),
+        reinterpret_cast<std::vector<int> *>(span.data + span.lengthInBytes)};
+    EXPECT_EQ(2, results.size());
+    EXPECT_EQ((std::vector<int>{42, -13}), results[0]);
+    EXPECT_EQ((std::vector<int>{7, 8}), results[1]);
+    free(buffer);
+  }
+  {
+    const std::vector<cudaq::OutputRecord> records = {
+        makeRecord(OutputRecordType::TUPLE, 2, 0., "tuple<i64, f64>"),
+        makeRecord(OutputRecordType::INT, 37, 0., ".0"),
+        makeRecord(OutputRecordType::DOUBLE, 0, 3.1416, ".1")};
+    std::pair<std::size_t, std::vector<std::size_t>> layout = {16, {0, 8}};
+    cudaq::RecordLogParser parser(layout);
+    parser.parse(records);
+    EXPECT_EQ(16, parser.getBufferSize());
+    struct MyTuple {
+      std::int64_t i64Val;
+      double f64Val;
+    };
+    MyTuple tuple;
+    std::memcpy(&tuple, parser.getBufferPtr(), sizeof(tuple));
+    EXPECT_EQ(37, tuple.i64Val);
+    EXPECT_EQ(3.1416, tuple.f64Val);
+  }
+  {
+    const std::vector<cudaq::OutputRecord> records = {
+        makeRecord(OutputRecordType::BOOL, 1, 0., "i1"),
+        makeRecord(OutputRecordType::INT, 5, 0., ""),
+        makeRecord(OutputRecordType::DOUBLE, 0, 0.5, "f32")};
+    cudaq::RecordLogParser parser;
+    parser.parse(records);
+    EXPECT_EQ(sizeof(bool) + sizeof(std::int32_t) + sizeof(float),
+              parser.getBufferSize());
+    char *buffer = static_cast<char *>(parser.getBufferPtr());
+    bool boolVal;
+    std::int32_t intVal;
+    float floatVal;
+    std::memcpy(&boolVal, buffer, sizeof(bool));
+    std::memcpy(&intVal, buffer + sizeof(bool), sizeof(intVal));
+    std::memcpy(&floatVal, buffer + sizeof(bool) + sizeof(intVal),
+                sizeof(floatVal));
+    EXPECT_TRUE(boolVal);
+    EXPECT_EQ(5, intVal);
+    EXPECT_EQ(0.5f, floatVal);
+  }
+}
+
+CUDAQ_TEST(ParserTester, checkPackedBoolArray) {
+  // 70 booleans packed into two records, element `i` of a record's range is
+  // bit `i - begin` of its value.
+  const std::string shot = "START\n"
+                           "OUTPUT\tARRAY\t70\tarray<i1 x 70>\n"
+                           "OUTPUT\tINT\t-9223372036854775803\t[0:64]\n"
+                           "OUTPUT\tINT\t34\t[64:70]\n"
+                           "END\t0\n";
+  const std::string log = "HEADER\tschema_name\tlabeled\n" + shot + shot;
+  std::vector<bool> expected(70, false);
+  expected[0] = expected[2] = expected[63] = expected[65] = expected[69] = true;
+  {
+    cudaq::RecordLogParser parser;
+    parser.parse(log);
+    cudaq::details::RunResultSpan span = {
+        static_cast<char *>(parser.getBufferPtr()), parser.getBufferSize()};
+    std::vector<std::vector<bool>> results = {
+        reinterpret_cast<std::vector<bool> *>(span.data),
+        reinterpret_cast<std::vector<bool> *>(span.data + span.lengthInBytes)};
+    EXPECT_EQ(2, results.size());
+    EXPECT_EQ(expected, results[0]);
+    EXPECT_EQ(expected, results[1]);
+  }
+  {
+    cudaq::OutputRecord array{cudaq::OutputRecordType::ARRAY, 70};
+    array.label = "array<i1 x 70>";
+    cudaq::OutputRecord low{cudaq::OutputRecordType::INT,
+                            std::numeric_limits<std::int64_t>::min() + 5};
+    low.label = "[0:64]";
+    cudaq::OutputRecord high{cudaq::OutputRecordType::INT, 34};
+    high.label = "[64:70]";
+    cudaq::RecordLogParser parser;
+    parser.parse(std::vector<cudaq::OutputRecord>{array, high, low});
+    auto *result = reinterpret_cast<std::vector<bool> *>(parser.getBufferPtr());
+    EXPECT_EQ(expected, *result);
+  }
+  {
+    // The range must fit in the array
+    const std::string bad = "OUTPUT\tARRAY\t4\tarray<i1 x 4>\n"
+                            "OUTPUT\tINT\t3\t[0:5]\n";
+    cudaq::RecordLogParser parser;
+    EXPECT_ANY_THROW(parser.parse(bad));
+  }
+}
+
+CUDAQ_TEST(ParserTester, checkReleaseBuffer) {
+  std::string log;
+  for (int i = 0; i < 1000; ++i)
+    log += "OUTPUT\tINT\t" + std::to_string(i) + "\ti64\n";
+  cudaq::RecordLogParser parser;
+  parser.parse(log);
+  const auto *origBuffer = parser.getBufferPtr();
+  std::size_t bufferSize = parser.getBufferSize();
+  EXPECT_EQ(1000 * sizeof(std::int64_t), bufferSize);
+  // The span takes the ownership of the buffer of the parser, without a copy.
+  cudaq::details::RunResultSpan span = {parser.releaseBuffer(), bufferSize};
+  EXPECT_EQ(origBuffer, span.data);
+  EXPECT_EQ(nullptr, parser.getBufferPtr());
+  EXPECT_EQ(0, parser.getBufferSize());
+  std::vector<std::int64_t> results;
+  cudaq::details::resultSpanToVectorViaOwnership(results, span);
+  EXPECT_EQ(1000, results.size());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, results[i]);
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "cudaq/platform/orca/OrcaEmulator.h"
+
+#include <numeric>
+
+TEST(OrcaEmulatorTester, checkPermanent) {
+  // The permanent of the all-ones matrix is n!.
+  for (std::size_t n : {1, 4, 15}) {
+    cudaq::complex_matrix ones(n, n);
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+        ones(i, j) = 1.;
+    const double factorial = std::tgamma(n + 1.);
+    EXPECT_NEAR(1.0, cudaq::orca::permanent(ones).real() / factorial, 1e-9);
+    EXPECT_NEAR(1.0, cudaq::orca::permanent(ones, 3).real() / factorial, 1e-9);
+  }
+
+  std::vector<std::complex<double>> entries{1., 2., {0., 3.}, 4.};
+  cudaq::complex_matrix m(entries, {2, 2});
+  auto value = cudaq::orca::permanent(m);
+  EXPECT_NEAR(4.0, value.real(), 1e-12);
+  EXPECT_NEAR(6.0, value.imag(), 1e-12);
+}
+
+TEST(OrcaEmulatorTester, checkUnitary) {
+  std::vector<std::size_t> input_state{1, 0, 1, 0, 1, 0};
+  std::vector<std::size_t> loop_lengths{1, 2};
+  std::vector<double> bs_angles(9), ps_angles(9);
+  std::iota(bs_angles.begin(), bs_angles.end(), 0.3);
+  std::iota(ps_angles.begin(), ps_angles.end(), 0.1);
+  cudaq::orca::TBIParameters params{input_state, loop_lengths, bs_angles,
+                                    ps_angles, 100};
+  auto u = cudaq::orca::interferometerUnitary(params);
+  ASSERT_EQ(6, u.rows());
+  for (std::size_t i = 0; i < 6; ++i)
+    for (std::size_t j = 0; j < 6; ++j) {
+      std::complex<double> dot = 0.;
+      for (std::size_t k = 0; k < 6; ++k)
+        dot += std::conj(u(k, i)) * u(k, j);
+      EXPECT_NEAR(i == j ? 1. : 0., std::abs(dot), 1e-12);
+    }
+
+  params.bs_angles.pop_back();
+  EXPECT_ANY_THROW(cudaq::orca::interferometerUnitary(params));
+}
+
+TEST(OrcaEmulatorTester, checkHongOuMandel) {
+  // Two photons on a balanced beam splitter always leave together.
+  std::vector<std::size_t> input_state{1, 1};
+  std::vector<std::size_t> loop_lengths{1};
+  std::vector<double> bs_angles{M_PI / 4};
+  cudaq::orca::TBIParameters params{input_state, loop_lengths, bs_angles,
+                                    {}, 2000};
+  auto counts = cudaq::orca::emulate(params, 13);
+  EXPECT_EQ(0, counts.count("11"));
+  EXPECT_EQ(2000, counts.count("20") + counts.count("02"));
+  EXPECT_NEAR(0.5, counts.probability("20"), 0.05);
+}
+
+TEST(OrcaEmulatorTester, checkSampling) {
+  std::vector<std::size_t> input_state{1, 0, 1, 0, 1, 0, 1, 0};
+  std::vector<std::size_t> loop_lengths{1, 1};
+  std::vector<double> bs_angles(14);
+  for (std::size_t i = 0; i < bs_angles.size(); ++i)
+    bs_angles[i] = M_PI / 3 - i * (M_PI / 6) / 13;
+  cudaq::orca::TBIParameters params{input_state, loop_lengths, bs_angles,
+                                    {}, 1000};
+
+  auto counts = cudaq::orca::emulate(params, 7);
+  std::size_t total = 0;
+  for (auto &[bits, count] : counts) {
+    ASSERT_EQ(8, bits.size());
+    std::size_t photons = 0;
+    for (auto c : bits)
+      photons += c - '0';
+    EXPECT_EQ(4, photons);
+    total += count;
+  }
+  EXPECT_EQ(1000, total);
+
+  // A fixed seed reproduces the same samples.
+  auto again = cudaq::orca::emulate(params, 7);
+  EXPECT_EQ(counts.to_map(), again.to_map());
+}
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "cudaq.h"
+#include "cudaq/photonics.h"
+#include "cudaq/qis/execution_manager.h"
+
+extern "C" {
+cudaq::ExecutionManager *getRegisteredExecutionManager_qudit_gpu();
+}
+
+class QuditGpuTester : public ::testing::Test {
+protected:
+  void SetUp() override {
+    cudaq::setExecutionManagerInternal(
+        getRegisteredExecutionManager_qudit_gpu());
+  }
+  void TearDown() override { cudaq::resetExecutionManagerInternal(); }
+};
+
+TEST_F(QuditGpuTester, checkSimple) {
+
+  struct test {
+    auto operator()() __qpu__ {
+      cudaq::qvector<3> qumodes(2);
+      create(qumodes[0]);
+      create(qumodes[1]);
+      create(qumodes[1]);
+      return mz(qumodes);
+    }
+  };
+
+  struct test2 {
+    void operator()() __qpu__ {
+      cudaq::qvector<3> qumodes(2);
+      create(qumodes[0]);
+      create(qumodes[1]);
+      create(qumodes[1]);
+      mz(qumodes);
+    }
+  };
+
+  auto res = test{}();
+  EXPECT_EQ(res[0], 1);
+  EXPECT_EQ(res[1], 2);
+
+  auto counts = cudaq::sample(test2{});
+  EXPECT_EQ(counts.size(), 1);
+  EXPECT_EQ(counts.count("12"), 1000);
+}
+
+TEST_F(QuditGpuTester, checkMixedLevels) {
+
+  struct test {
+    void operator()() __qpu__ {
+      cudaq::qudit<3> a;
+      cudaq::qudit<5> b;
+      cudaq::qudit<2> c;
+      plus(a);
+      plus(b);
+      plus(b);
+      plus(b);
+      annihilate(b);
+      create(c);
+      mz(a);
+      mz(b);
+      mz(c);
+    }
+  };
+
+  auto counts = cudaq::sample(test{});
+  EXPECT_EQ(counts.size(), 1);
+  EXPECT_EQ(counts.count("121"), 1000);
+}
+
+TEST_F(QuditGpuTester, checkHOM) {
+
+  struct HOM {
+    // Hong–Ou–Mandel effect
+    auto operator()(double theta) __qpu__ {
+      cudaq::qvector<3> qumodes(2); // |00>
+      create(qumodes[0]);
+      create(qumodes[1]); // setting to  |11>
+      beam_splitter(qumodes[0], qumodes[1], theta);
+      mz(qumodes);
+    }
+  };
+
+  auto counts = cudaq::sample(HOM{}, M_PI / 4);
+  EXPECT_EQ(counts.size(), 2);
+  EXPECT_EQ(counts.count("02") + counts.count("20"), 1000);
+
+  auto counts2 = cudaq::sample(HOM{}, M_PI / 6);
+  EXPECT_EQ(counts2.size(), 3);
+}
+
+TEST_F(QuditGpuTester, checkMZI) {
+
+  struct MZI {
+    // Mach-Zendher Interferometer
+    auto operator()() __qpu__ {
+      cudaq::qvector<3> qumodes(2); // |00>
+      create(qumodes[0]);           // setting to  |10>
+
+      beam_splitter(qumodes[0], qumodes[1], M_PI / 4);
+      phase_shift(qumodes[0], M_PI / 3);
+
+      beam_splitter(qumodes[0], qumodes[1], M_PI / 4);
+      phase_shift(qumodes[0], M_PI / 3);
+
+      mz(qumodes);
+    }
+  };
+
+  cudaq::set_random_seed(13);
+  std::size_t shots = 1000000;
+  auto counts = cudaq::sample(shots, MZI{});
+  EXPECT_NEAR(double(counts.count("10")) / shots, cos(M_PI / 3) * cos(M_PI / 3),
+              1e-3);
+}
@@ -62,6 +62,8 @@ Result *__quantum__qis__measure__body(Array *basis, Array *qubits);
 Result *__quantum__rt__result_get_one();
 Result *__quantum__rt__result_get_zero();
 void __quantum__qis__exp__body(Array *paulis, double angle, Array *qubits);
+void __quantum__qis__exp_pauli_batch(std::int64_t numTerms, double *thetas,
+                                     Array *qubits, char *pauliWords);
 // Utility function used by MLIRGen to map Qubit*... controls to Array*
 void invokeWithControlQubits(const std::size_t nControls,
                              void (*QISFunction)(Array *, Qubit *), ...);
@@ -106,6 +108,7 @@ Array *__quantum__rt__array_slice(Array *array, int32_t dim,
                                   int64_t range_end);
 Array *__quantum__rt__array_slice_1d(Array *array, int64_t range_start,
                                      int64_t range_step, int64_t range_end);
+Array *__quantum__rt__array_concatenate(Array *head, Array *tail);
 }
 
 CUDAQ_TEST(NVQIRTester, checkSimple) {
@@ -126,6 +129,35 @@ CUDAQ_TEST(NVQIRTester, checkSimple) {
   __quantum__rt__finalize();
 }
 
+CUDAQ_TEST(NVQIRTester, checkArraySlicesInLoop) {
+  __quantum__rt__initialize(0, nullptr);
+  auto qubits = __quantum__rt__qubit_allocate_array(5);
+  auto qubitAt = [](Array *array, int64_t idx) {
+    return *reinterpret_cast<Qubit **>(
+        __quantum__rt__array_get_element_ptr_1d(array, idx));
+  };
+  // The arrays released in an iteration are reused by the next one, and the
+  // concatenations grow beyond the inline storage of small arrays.
+  for (int i = 0; i < 100; ++i) {
+    auto reversed = __quantum__rt__array_slice_1d(qubits, -1, -1, 0);
+    auto twice = __quantum__rt__array_concatenate(qubits, reversed);
+    auto fourTimes = __quantum__rt__array_concatenate(twice, twice);
+    EXPECT_EQ(__quantum__rt__array_get_size_1d(fourTimes), 20);
+    for (int64_t j = 0; j < 5; ++j) {
+      EXPECT_EQ(qubitAt(reversed, j), qubitAt(qubits, 4 - j));
+      EXPECT_EQ(qubitAt(fourTimes, 10 + j), qubitAt(qubits, j));
+      EXPECT_EQ(qubitAt(fourTimes, 19 - j), qubitAt(qubits, j));
+    }
+    __quantum__rt__array_release(fourTimes);
+    __quantum__rt__array_release(twice);
+    __quantum__rt__array_release(reversed);
+  }
+  __quantum__qis__x(qubitAt(qubits, 3));
+  EXPECT_EQ(*__quantum__qis__mz(qubitAt(qubits, 3)), 1);
+  __quantum__rt__qubit_release_array(qubits);
+  __quantum__rt__finalize();
+}
+
 // Stim does not support many of the gates used in these tests.
 #ifndef CUDAQ_BACKEND_STIM
 
@@ -304,6 +336,27 @@ CUDAQ_TEST(NVQIRTester, checkQubitReset) {
   __quantum__rt__qubit_release_array(qubits);
 }
 
+CUDAQ_TEST(NVQIRTester, checkAncillaRecyclingInRun) {
+  // Within a shot of `cudaq::run()`, released ancillas are recycled rather
+  // than growing the state by 5 qubits per iteration.
+  __quantum__rt__initialize(0, nullptr);
+  cudaq::ExecutionContext ctx("run", 1);
+  __quantum__rt__setExecutionContext(&ctx);
+  Qubit *data = __quantum__rt__qubit_allocate();
+  __quantum__qis__x(data);
+  for (int i = 0; i < 100; ++i) {
+    auto ancillas = __quantum__rt__qubit_allocate_array(5);
+    Qubit *ancilla = *reinterpret_cast<Qubit **>(
+        __quantum__rt__array_get_element_ptr_1d(ancillas, i % 5));
+    __quantum__qis__cnot(data, ancilla);
+    EXPECT_EQ(*__quantum__qis__mz(ancilla), 1);
+    __quantum__rt__qubit_release_array(ancillas);
+  }
+  EXPECT_EQ(*__quantum__qis__mz(data), 1);
+  __quantum__rt__qubit_release(data);
+  __quantum__rt__resetExecutionContext();
+}
+
 Qubit *extract_qubit(Array *a, int idx) {
   auto q_raw_ptr = __quantum__rt__array_get_element_ptr_1d(a, idx);
   return *reinterpret_cast<Qubit **>(q_raw_ptr);
@@ -592,6 +645,53 @@ CUDAQ_TEST(NVQIRTester, checkQubitAllocationFromRetrievedStateExpand) {
   __quantum__rt__finalize();
 }
 
+CUDAQ_TEST(NVQIRTester, checkExpPauliBatch) {
+  __quantum__rt__initialize(0, nullptr);
+  auto qubits = __quantum__rt__qubit_allocate_array(2);
+  Qubit *q0 = *reinterpret_cast<Qubit **>(
+      __quantum__rt__array_get_element_ptr_1d(qubits, 0));
+  Qubit *q1 = *reinterpret_cast<Qubit **>(
+      __quantum__rt__array_get_element_ptr_1d(qubits, 1));
+
+  struct CLikeString {
+    const char *ptr;
+    int64_t length;
+  };
+  const auto applyBatch = [&](std::vector<double> thetas,
+                              const std::vector<std::string> &words) {
+    std::vector<CLikeString> strings;
+    for (const auto &word : words)
+      strings.push_back({word.data(), static_cast<int64_t>(word.size())});
+    __quantum__qis__exp_pauli_batch(thetas.size(), thetas.data(), qubits,
+                                    reinterpret_cast<char *>(strings.data()));
+  };
+
+  // exp(i pi/2 XX) = i XX, followed by diagonal rotations that cancel out.
+  applyBatch({M_PI_2, 0.3, -0.3}, {"XX", "ZZ", "ZZ"});
+  EXPECT_EQ(*__quantum__qis__mz(q0), 1);
+  EXPECT_EQ(*__quantum__qis__mz(q1), 1);
+
+  // A run of diagonal rotations: exp(i pi/2 ZI) = i ZI maps |+0> to |-0>,
+  // up to the phase of IZ.
+  __quantum__qis__reset(q0);
+  __quantum__qis__reset(q1);
+  __quantum__qis__h(q0);
+  applyBatch({M_PI_4, M_PI_4, 0.7}, {"ZI", "ZI", "IZ"});
+  __quantum__qis__h(q0);
+  EXPECT_EQ(*__quantum__qis__mz(q0), 1);
+  EXPECT_EQ(*__quantum__qis__mz(q1), 0);
+
+  // Terms sharing their basis change: exp(i pi/2 YX) = i YX.
+  __quantum__qis__reset(q0);
+  __quantum__qis__reset(q1);
+  applyBatch({M_PI_4, M_PI_4, 0.0}, {"YX", "YX", "II"});
+  EXPECT_EQ(*__quantum__qis__mz(q0), 1);
+  EXPECT_EQ(*__quantum__qis__mz(q1), 1);
+
+  __quantum__rt__qubit_release_array(qubits);
+  __quantum__rt__finalize();
+}
+
 #endif
 
 #ifdef CUDAQ_BACKEND_DM
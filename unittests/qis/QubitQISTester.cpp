@@ -568,6 +568,31 @@ CUDAQ_TEST(CustomUnitaryTester, checkParameterized) {
   }
 }
 
+CUDAQ_TEST(CustomUnitaryTester, checkUnitaryCache) {
+  auto &registry = cudaq::customOpRegistry::getInstance();
+  auto first = registry.getUnitary("CustomU3", {M_PI, M_PI, M_PI_2});
+  auto second = registry.getUnitary("CustomU3", {M_PI, M_PI, M_PI_2});
+  // Same parameters resolve to the same cached matrix
+  EXPECT_EQ(first.get(), second.get());
+  auto other = registry.getUnitary("CustomU3", {M_PI_2, 0., M_PI});
+  EXPECT_NE(first.get(), other.get());
+
+  ASSERT_EQ(first->fp32.size(), first->fp64.size());
+  for (std::size_t i = 0; i < first->fp64.size(); ++i) {
+    EXPECT_NEAR(first->fp32[i].real(), first->fp64[i].real(), 1e-6);
+    EXPECT_NEAR(first->fp32[i].imag(), first->fp64[i].imag(), 1e-6);
+  }
+
+  // Repeated application goes through the cache
+  auto kernel = []() {
+    cudaq::qubit q;
+    for (int i = 0; i < 11; ++i)
+      CustomU3(M_PI, M_PI, M_PI_2, q);
+  };
+  auto counts = cudaq::sample(kernel);
+  EXPECT_EQ(counts.count("1"), 1000);
+}
+
 CUDAQ_TEST(CustomUnitaryTester, checkMultiQubitOps) {
   {
     // Test swap operation
@@ -85,7 +85,7 @@ protected:
   }
 
   void executeInstruction(const Instruction &instruction) override {
-    auto operation = instructions[std::get<0>(instruction)];
+    auto operation = instructions[std::string(instruction.name)];
     operation(instruction);
   }
 
@@ -117,7 +117,7 @@ public:
     instructions.emplace("plusGate", [&](const Instruction &inst) {
       qpp::cmat u(3, 3);
       u << 0, 0, 1, 1, 0, 0, 0, 1, 0;
-      auto &[gateName, params, controls, qudits, op] = inst;
+      auto &[gateName, kind, params, controls, qudits, op] = inst;
       auto target = qudits[0];
       CUDAQ_INFO("Applying plusGate on {}<{}>", target.id, target.levels);
       state = qpp::apply(state, u, {target.id}, target.levels);
@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "cudaq/operators.h"
+#include "cudaq/operators/serialization.h"
 #include "utils.h"
 #include <gtest/gtest.h>
 
@@ -201,6 +202,72 @@ TEST(SpinOpTester, checkMultiplication) {
   }
 }
 
+TEST(SpinOpTester, checkSumMultiplication) {
+  // Sums of spin operators with constant coefficients are multiplied on a
+  // bit-packed representation; check against multiplying term by term.
+  for (unsigned int seed = 0; seed < 10; ++seed) {
+    // Include terms on more than 64 qubits and on non-contiguous degrees.
+    auto lhs = cudaq::spin_op::random(5, 12, seed) +
+               cudaq::spin_op::random(70, 3, seed) +
+               std::complex<double>(0., 2.) * cudaq::spin_op::y(100) +
+               cudaq::spin_op::i(2) * cudaq::spin_op::x(3);
+    auto rhs = cudaq::spin_op::random(6, 9, seed + 100) +
+               cudaq::spin_op::random(70, 3, seed + 100) -
+               0.5 * cudaq::spin_op::x(100) * cudaq::spin_op::z(1);
+
+    auto expected = cudaq::spin_op::empty();
+    for (const auto &lhs_term : lhs)
+      for (const auto &rhs_term : rhs)
+        expected += lhs_term * rhs_term;
+
+    EXPECT_EQ(lhs * rhs, expected);
+    auto product = lhs;
+    product *= rhs;
+    EXPECT_EQ(product, expected);
+  }
+}
+
+TEST(SpinOpTester, checkLargeSumArithmetic) {
+  // Sums with many terms are built block by block (concurrently if OpenMP is
+  // enabled); check against building them term by term. All coefficients are
+  // small integers, such that the order of summation does not matter.
+  auto lhs = cudaq::spin_op::random(8, 400, 1);
+  auto rhs = cudaq::spin_op::random(8, 300, 2);
+  auto expected = cudaq::spin_op::empty();
+  for (const auto &lhs_term : lhs)
+    for (const auto &rhs_term : rhs)
+      expected += lhs_term * rhs_term;
+  auto product = lhs * rhs;
+  EXPECT_EQ(product, expected);
+  std::size_t idx = 0;
+  for (const auto &term : product)
+    EXPECT_EQ(term.get_term_id(), expected[idx++].get_term_id());
+
+  auto a = cudaq::spin_op::random(12, 6000, 3);
+  auto r = cudaq::spin_op::random(12, 6000, 4);
+  auto b = r + a;
+  auto sum = a;
+  for (const auto &term : b)
+    sum -= term;
+  auto difference = a - b;
+  EXPECT_EQ(difference, sum);
+  a -= b;
+  EXPECT_EQ(a, sum);
+  EXPECT_EQ(a.trim(), -r);
+
+  std::set<std::size_t> degrees;
+  for (std::size_t d = 0; d < 16; ++d)
+    degrees.insert(d);
+  auto canonicalized = cudaq::spin_op::empty();
+  for (const auto &term : b)
+    canonicalized += cudaq::spin_op_term::canonicalize(term, degrees);
+  EXPECT_EQ(cudaq::spin_op::canonicalize(b, degrees), canonicalized);
+  canonicalized = cudaq::spin_op::empty();
+  for (const auto &term : b)
+    canonicalized += cudaq::spin_op_term::canonicalize(term);
+  EXPECT_EQ(b.canonicalize(), canonicalized);
+}
+
 TEST(SpinOpTester, canBuildDeuteron) {
   auto H = 5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
            2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
@@ -225,6 +292,19 @@ TEST(SpinOpTester, checkGetSparseMatrix) {
   }
 }
 
+TEST(SpinOpTester, checkGetSparseMatrixManyTerms) {
+  // Sums with many terms are converted in chunks of terms.
+  auto H = cudaq::spin_op::random(6, 300, 7);
+  auto matrix = H.to_matrix();
+  auto [values, rows, cols] = H.to_sparse_matrix();
+  cudaq::complex_matrix sparse(matrix.rows(), matrix.cols());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    sparse[{rows[i], cols[i]}] += values[i];
+  for (std::size_t i = 0; i < matrix.rows(); ++i)
+    for (std::size_t j = 0; j < matrix.cols(); ++j)
+      EXPECT_NEAR(std::abs(matrix[{i, j}] - sparse[{i, j}]), 0., 1e-12);
+}
+
 TEST(SpinOpTester, checkGetMatrix) {
   auto H = 5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
            2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
@@ -312,6 +392,40 @@ TEST(SpinOpTester, checkDistributeTerms) {
   EXPECT_EQ(distributed[1].num_terms(), 2);
 }
 
+TEST(SpinOpTester, checkGroupCommuting) {
+  auto H = 5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+           2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+           .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+
+  // Qubit-wise: {I, X0X1}, {Y0Y1}, {Z0, Z1}
+  auto qubitWise = H.group_commuting();
+  EXPECT_EQ(qubitWise.size(), 3);
+  EXPECT_EQ(qubitWise[0].num_terms(), 2);
+  EXPECT_EQ(qubitWise[1].num_terms(), 1);
+  EXPECT_EQ(qubitWise[2].num_terms(), 2);
+
+  // General: {I, X0X1, Y0Y1}, {Z0, Z1}, since X0X1 and Y0Y1 anti-commute on
+  // two qubits, whereas Z0 and Z1 anti-commute with X0X1 on a single qubit.
+  auto general = H.group_commuting(cudaq::grouping_strategy::general);
+  EXPECT_EQ(general.size(), 2);
+  EXPECT_EQ(general[0].num_terms(), 3);
+  EXPECT_EQ(general[1].num_terms(), 2);
+
+  // Every term is assigned to exactly one group, and the terms within each
+  // group commute.
+  for (const auto &groups : {qubitWise, general}) {
+    auto sum = cudaq::spin_op::empty();
+    for (const auto &group : groups) {
+      sum += group;
+      for (const auto &lhs : group)
+        for (const auto &rhs : group)
+          utils::checkEqual((lhs * rhs).to_matrix({{0, 2}, {1, 2}}),
+                            (rhs * lhs).to_matrix({{0, 2}, {1, 2}}));
+    }
+    EXPECT_EQ(sum, H);
+  }
+}
+
 TEST(SpinOpTester, checkMultiDiagConversionSpin) {
   for (auto &H : {cudaq::spin_op::i(0), cudaq::spin_op::x(0),
                   cudaq::spin_op::y(0), cudaq::spin_op::z(0)}) {
@@ -379,3 +493,38 @@ TEST(SpinOpTester, checkMultiDiagConversionSpin) {
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
+
+TEST(SpinOpTester, checkPackedSerialization) {
+  auto H = 5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+           2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+           .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(70);
+
+  auto data = cudaq::packed_spin_op_view::pack(H);
+  cudaq::packed_spin_op_view view(data.data(), data.size());
+  EXPECT_EQ(view.num_qubits(), 71);
+  EXPECT_EQ(view.num_terms(), H.num_terms());
+  EXPECT_EQ(view.to_spin_op(), H);
+  EXPECT_EQ(view.to_spin_op(0, 2) + view.to_spin_op(2, 10), H);
+  EXPECT_EQ(view.to_spin_op(5, 10), cudaq::spin_op::empty());
+
+  std::size_t idx = 0;
+  for (const auto &term : H) {
+    EXPECT_EQ(view.get_coefficient(idx), term.evaluate_coefficient());
+    EXPECT_EQ(view.get_term(idx), term);
+    ++idx;
+  }
+
+  auto filename = testing::TempDir() + "packed_spin_op.bin";
+  cudaq::packed_spin_op_file::write(H, filename);
+  {
+    cudaq::packed_spin_op_file file(filename);
+    EXPECT_EQ(file.view().to_spin_op(), H);
+  }
+  cudaq::packed_spin_op_reader reader;
+  EXPECT_EQ(reader.read(filename), H);
+  std::remove(filename.c_str());
+
+  data.resize(data.size() - 8);
+  EXPECT_THROW(cudaq::packed_spin_op_view(data.data(), data.size()),
+               std::runtime_error);
+}
@@ -163,6 +163,21 @@ TEST(UtilsTester, JsonSerDesOptimizer) {
     json j2(*test_opt_round_trip);
     EXPECT_EQ(j.dump(), j2.dump());
   }
+
+  {
+    cudaq::optimizers::cmaes test_opt;
+    test_opt.population_size = 12;
+    test_opt.sigma = 0.25;
+    json j(test_opt);
+    std::cout << j.dump() << '\n';
+    EXPECT_EQ(j.dump(), "{\"population_size\":12,\"sigma\":0.25}");
+    EXPECT_EQ(json(cudaq::get_optimizer_type(test_opt)).dump(), "\"CMAES\"");
+
+    auto test_opt_round_trip =
+        make_optimizer_from_json(j, cudaq::get_optimizer_type(test_opt));
+    json j2(*test_opt_round_trip);
+    EXPECT_EQ(j.dump(), j2.dump());
+  }
 }
 
 TEST(UtilsTester, JsonSerDesGradient) {
@@ -208,4 +223,72 @@ TEST(UtilsTester, JsonSerDesGradient) {
     json j2(*test_grad_round_trip);
     EXPECT_EQ(j.dump(), j2.dump());
   }
+
+  {
+    cudaq::gradients::adjoint grad;
+    grad.step = 0.04;
+    json j(grad);
+    std::cout << j.dump() << '\n';
+    EXPECT_EQ(j.dump(), "{\"step\":0.04}");
+    EXPECT_EQ(json(cudaq::get_gradient_type(grad)).dump(), "\"ADJOINT\"");
+
+    auto test_grad_round_trip =
+        make_gradient_from_json(j, cudaq::get_gradient_type(grad));
+    json j2(*test_grad_round_trip);
+    EXPECT_EQ(j.dump(), j2.dump());
+  }
+}
+
+namespace {
+struct custom_gradient : public cudaq::gradient {
+  void compute(const std::vector<double> &x, std::vector<double> &dx,
+               const cudaq::spin_op &h, double funcAtX) override {}
+  std::vector<double>
+  compute(const std::vector<double> &x,
+          const std::function<double(std::vector<double>)> &func,
+          double funcAtX) override {
+    return {};
+  }
+  std::unique_ptr<cudaq::gradient> clone() override {
+    return std::make_unique<custom_gradient>();
+  }
+};
+} // namespace
+
+TEST(UtilsTester, JsonSerDesUnsupportedGradient) {
+  // Gradients without a serialization are not replaced by another type.
+  custom_gradient grad;
+  EXPECT_THROW(cudaq::get_gradient_type(grad), std::invalid_argument);
+}
+
+TEST(UtilsTester, BinarySerDesState) {
+  // State vectors are carried as raw buffers in the binary wire format, and
+  // are restored the same as from JSON arrays.
+  std::vector<std::complex<double>> amplitudes(1 << 4);
+  for (std::size_t i = 0; i < amplitudes.size(); ++i)
+    amplitudes[i] = {0.25 * std::cos(0.1 * i), 0.25 * std::sin(0.1 * i)};
+  cudaq::ExecutionContext context("extract-state");
+  context.simulationState =
+      cudaq::get_simulator()->createStateFromData(amplitudes);
+
+  const auto cbor = json::to_cbor(cudaq::to_binary_json(context));
+  const json text = context;
+  EXPECT_LT(cbor.size(), text.dump().size());
+
+  auto binaryJson = json::from_cbor(cbor);
+  EXPECT_TRUE(binaryJson["simulationData"]["data"].is_binary());
+  for (const auto &j : {binaryJson, text}) {
+    cudaq::ExecutionContext restored("extract-state");
+    j.get_to(restored);
+    ASSERT_TRUE(restored.simulationState);
+    ASSERT_EQ(restored.simulationState->getNumQubits(), 4);
+    for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+      std::vector<int> bits(4);
+      for (std::size_t q = 0; q < 4; ++q)
+        bits[q] = (i >> q) & 1;
+      EXPECT_NEAR(std::abs(restored.simulationState->getAmplitude(bits) -
+                           context.simulationState->getAmplitude(bits)),
+                  0.0, 1e-12);
+    }
+  }
 }